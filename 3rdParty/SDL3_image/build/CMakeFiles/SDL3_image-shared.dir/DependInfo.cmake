@@ -0,0 +1,45 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/3rdParty/SDL3_image/src/IMG.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_WIC.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_WIC.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_WIC.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_avif.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_avif.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_avif.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_bmp.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_bmp.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_bmp.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_gif.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_gif.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_gif.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_jpg.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_jpg.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_jpg.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_jxl.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_jxl.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_jxl.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_lbm.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_lbm.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_lbm.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_pcx.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_pcx.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_pcx.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_png.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_png.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_png.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_pnm.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_pnm.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_pnm.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_qoi.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_qoi.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_qoi.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_stb.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_stb.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_stb.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_svg.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_svg.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_svg.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_tga.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_tga.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_tga.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_tif.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_tif.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_tif.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_webp.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_webp.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_webp.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_xcf.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_xcf.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_xcf.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_xpm.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_xpm.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_xpm.c.o.d"
+  "/root/repo/3rdParty/SDL3_image/src/IMG_xv.c" "CMakeFiles/SDL3_image-shared.dir/src/IMG_xv.c.o" "gcc" "CMakeFiles/SDL3_image-shared.dir/src/IMG_xv.c.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/3rdParty/SDL3_image/build/libSDL3_image.so" "/root/repo/3rdParty/SDL3_image/build/libSDL3_image.so.0.2.4"
+  "/root/repo/3rdParty/SDL3_image/build/libSDL3_image.so.0" "/root/repo/3rdParty/SDL3_image/build/libSDL3_image.so.0.2.4"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,51 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_WIC.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_WIC.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_avif.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_avif.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_bmp.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_bmp.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_gif.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_gif.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_jpg.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_jpg.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_jxl.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_jxl.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_lbm.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_lbm.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_pcx.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_pcx.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_png.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_png.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_pnm.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_pnm.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_qoi.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_qoi.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_stb.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_stb.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_svg.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_svg.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_tga.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_tga.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_tif.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_tif.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_webp.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_webp.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_xcf.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_xcf.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_xpm.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_xpm.c.o.d"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_xv.c.o"
+  "CMakeFiles/SDL3_image-shared.dir/src/IMG_xv.c.o.d"
+  "libSDL3_image.pdb"
+  "libSDL3_image.so"
+  "libSDL3_image.so.0"
+  "libSDL3_image.so.0.2.4"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/SDL3_image-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
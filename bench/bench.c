@@ -0,0 +1,906 @@
+/**
+ * @file bench.c
+ * @brief Micro-bancs d'essai du Modèle (`make bench`).
+ *
+ * Chaque banc part d'un scénario figé (vague complète, fin de vague, 100 balles,
+ * tout au maximum) et mesure un noyau : `model_update` (aussi piloté par le
+ * bot, cf. bot.h, et en virgule fixe), `model_step_batch` sur
+ * plusieurs mondes, le tir d'une balle, la passe de collisions, l'aller-retour
+ * de sauvegarde, la compaction des entités (entity_pack.h), un retour en
+ * arrière de la coopération en réseau (rollback.h), l'empreinte d'état
+ * calculée à chaque tick (statehash.h), les deux broad phases
+ * de collision.h sur un essaim de balles, le test d'une balle contre les
+ * pièces du vaisseau amiral (BVH de bvh.h ou boucle), l'avance d'une réserve
+ * de particules d'explosion (particles.h, côté Vue), et le 99e centile d'un
+ * tick de `model_update` dans chaque scénario de pire cas de stress.h (pool
+ * plein, balles dans la vague, bunkers sous le feu, OVNI et explosions).
+ * Les mesures sont prises par lots ; la remise en état entre deux lots (copie
+ * du scénario) n'est pas chronométrée. Chaque banc est répété BENCH_REPEATS
+ * fois : le rapport donne la moyenne, l'écart-type relatif et le meilleur
+ * passage, en ns par opération.
+ *
+ * @code
+ * make bench                   # ~1 million d'opérations par banc (10 millions pour le tir)
+ * ./space_invaders_bench 0.1   # 10 fois moins (essai rapide)
+ * make bench-check             # Compare à la référence de la machine (bench/baseline.jsonl)
+ * @endcode
+ *
+ * Le programme est compilé avec les mêmes options que le jeu : les chiffres
+ * comparent deux versions du code, pas deux réglages du compilateur.
+ */
+
+#include "results.h"
+
+#include "bot.h"
+#include "bvh.h"
+#include "collision.h"
+#include "common.h"
+#include "entity_pack.h"
+#include "model.h"
+#include "particles.h"
+#include "rollback.h"
+#include "save.h"
+#include "statehash.h"
+#include "stress.h"
+#include "utils.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. CONSTANTES & TYPES
+// ============================================================================
+
+#define BENCH_REPEATS 10        ///< Passages par banc (moyenne et écart-type).
+#define BENCH_SEED 42           ///< Graine du générateur (scénarios reproductibles).
+#define BENCH_UPDATE_TICKS 50   ///< Ticks par lot avant de repartir du scénario.
+#define BENCH_COLLISION_BATCH 1000 ///< Passes de collisions par lot.
+#define BENCH_WORLDS 256        ///< Mondes avancés ensemble (model_step_batch).
+#define BENCH_PARTICLES 50000   ///< Particules vivantes maintenues (banc des particules).
+#define BENCH_SWARM_BULLETS 4096 ///< Balles de l'essaim (banc des broad phases).
+#define BENCH_BOSS_PROBES 1024  ///< Boîtes de balles testées contre le vaisseau amiral.
+#define BENCH_WORST_CENTILE 99  ///< Centile des ticks de pire cas rapporté.
+#define BENCH_SPARSE_KEEP 12    ///< Une balle sur BENCH_SPARSE_KEEP reste en vol (pool clairsemé).
+
+/**
+ * @brief Résultat d'un banc, en nanosecondes par opération.
+ */
+typedef struct
+{
+    double mean;   ///< Moyenne des passages.
+    double stddev; ///< Écart-type des passages.
+    double min;    ///< Meilleur passage.
+} BenchResult;
+
+static double scale = 1.0; ///< Facteur appliqué au nombre d'opérations (argument).
+static BenchRecord record;  ///< Résultats de l'exécution (--json).
+
+// ============================================================================
+//                          2. SCÉNARIOS
+// ============================================================================
+
+/**
+ * @brief Partie neuve, lancée par les commandes du menu (comme headless.c).
+ *
+ * Les vies sont gonflées : un lot ne doit pas finir en STATE_GAME_OVER.
+ */
+static GameModel *scenario_full_wave(void)
+{
+    GameModel *model = model_init();
+    model_rng_seed(model, BENCH_SEED);
+    model->sim.state = STATE_MENU;
+    model->ui.menu_selection = 0; // "JOUER"
+    model_handle_input(model, CMD_RETURN);
+    model->sim.lives = 1000;
+    return model;
+}
+
+/**
+ * @brief Niveau 10, il ne reste que les 5 aliens de la rangée du bas à droite.
+ */
+static GameModel *scenario_late_wave(void)
+{
+    GameModel *model = scenario_full_wave();
+    model->sim.level = 10;
+    model->sim.formation.alive_mask = 0;
+    for (int i = FORMATION_SIZE - 5; i < FORMATION_SIZE; i++)
+        model->sim.formation.alive_mask |= 1ULL << i;
+    model_rebuild_indexes(model);
+    return model;
+}
+
+/**
+ * @brief La i-ème balle d'un remplissage est au joueur : une sur MODEL_PLAYER_BULLET_SHARE,
+ * tant que son camp a de la place (les deux camps finissent pleins).
+ */
+static bool player_turn(const GameModel *model, int i)
+{
+    return i % MODEL_PLAYER_BULLET_SHARE == 0 && i / MODEL_PLAYER_BULLET_SHARE < model->sim.bullets.player_slots;
+}
+
+/**
+ * @brief Remplit le pool : balles du joueur en bas qui montent, balles ennemies en haut qui descendent.
+ */
+static void fill_bullets(GameModel *model)
+{
+    for (int i = 0; i < MAX_BULLETS; i++)
+    {
+        float x = (float)(i * GAME_WIDTH) / MAX_BULLETS;
+        if (player_turn(model, i))
+            model_spawn_bullet(model, x, GAME_HEIGHT - 5.0f - (i % 10), -BULLET_SPEED, ENTITY_BULLET_PLAYER);
+        else
+            model_spawn_bullet(model, x, 12.0f + (i % 10), BULLET_SPEED * 0.6f, ENTITY_BULLET_ENEMY);
+    }
+}
+
+/**
+ * @brief Vague complète et MAX_BULLETS balles en vol.
+ */
+static GameModel *scenario_bullets(void)
+{
+    GameModel *model = scenario_full_wave();
+    fill_bullets(model);
+    return model;
+}
+
+/**
+ * @brief Vague complète, bloc [0, MAX_BULLETS) déjà utilisé, une balle sur BENCH_SPARSE_KEEP encore en vol.
+ *
+ * Le cas courant d'une partie : high_water ne redescend qu'au changement de
+ * niveau, le bloc est surtout fait de slots libres.
+ */
+static GameModel *scenario_sparse(void)
+{
+    GameModel *model = scenario_bullets();
+    const short *live;
+    int n = model_get_live_bullets(model, &live);
+    short kept[MAX_BULLETS];
+    memcpy(kept, live, (size_t)n * sizeof(short));
+    for (int k = 0; k < n; k++)
+        if (k % BENCH_SPARSE_KEEP)
+            model->sim.bullets.y[kept[k]] = -2.0f * GAME_HEIGHT; // Sortie d'écran au tick suivant
+    model_update(model, 1.0 / TARGET_FPS);
+    return model;
+}
+
+/**
+ * @brief Tout au maximum : vague complète, pool plein, OVNI en vol, niveau élevé.
+ */
+static GameModel *scenario_stress(void)
+{
+    GameModel *model = scenario_bullets();
+    model->sim.level = 20;
+    model->sim.ufo.active = true;
+    model->sim.ufo.hasSpawnedThisLevel = true;
+    model->sim.ufo.type = ENTITY_UFO;
+    model->sim.ufo.width = UFO_WIDTH;
+    model->sim.ufo.height = UFO_HEIGHT;
+    model->sim.ufo.x = 0.0f;
+    model->sim.ufo.y = 4.0f;
+    model->sim.ufo.dx = 15.0f;
+    model_rebuild_indexes(model); // Cadence de tir du niveau 20
+    return model;
+}
+
+// ============================================================================
+//                          3. MESURE & RAPPORT
+// ============================================================================
+
+/**
+ * @brief Opérations d'un passage : `ops` au total sur les BENCH_REPEATS passages, fois le facteur.
+ */
+static long scaled(long ops)
+{
+    long n = (long)(ops * scale / BENCH_REPEATS);
+    return n > 0 ? n : 1;
+}
+
+/**
+ * @brief Moyenne, écart-type et minimum des passages (ns par opération).
+ */
+static BenchResult summarize(const double *samples, int n)
+{
+    BenchResult r = {0.0, 0.0, samples[0]};
+    for (int i = 0; i < n; i++)
+    {
+        r.mean += samples[i];
+        if (samples[i] < r.min)
+            r.min = samples[i];
+    }
+    r.mean /= n;
+    for (int i = 0; i < n; i++)
+        r.stddev += (samples[i] - r.mean) * (samples[i] - r.mean);
+    r.stddev = sqrt(r.stddev / (n > 1 ? n - 1 : 1));
+    return r;
+}
+
+/**
+ * @brief Affiche une ligne du rapport et la range sous la clé `key`.
+ */
+static void report(const char *name, const char *key, const double *samples, long ops)
+{
+    BenchResult r = summarize(samples, BENCH_REPEATS);
+    bench_record_add(&record, key, r.mean, r.stddev, r.min);
+    printf("  %-28s %10.1f ns/op  +/- %5.1f %%  (min %9.1f)  %9ld ops\n", name, r.mean,
+           r.mean > 0.0 ? 100.0 * r.stddev / r.mean : 0.0, r.min, ops * BENCH_REPEATS);
+}
+
+// ============================================================================
+//                          4. BANCS
+// ============================================================================
+
+/** @brief Un tick : model_update ou model_update_reference. */
+typedef void (*UpdateFn)(GameModel *model, double dt);
+
+/**
+ * @brief `update` depuis un scénario, par lots de BENCH_UPDATE_TICKS ticks.
+ */
+static void bench_update(const char *name, const char *key, GameModel *scenario, UpdateFn update)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    long batches = (scaled(1000000) + BENCH_UPDATE_TICKS - 1) / BENCH_UPDATE_TICKS;
+    GameModel *model = model_clone(scenario);
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double elapsed = 0.0;
+        for (long b = 0; b < batches; b++)
+        {
+            model_copy(model, scenario);
+            double t0 = utils_get_time();
+            for (int t = 0; t < BENCH_UPDATE_TICKS; t++)
+                update(model, dt);
+            elapsed += utils_get_time() - t0;
+        }
+        samples[r] = elapsed * 1e9 / (double)(batches * BENCH_UPDATE_TICKS);
+    }
+    report(name, key, samples, batches * BENCH_UPDATE_TICKS);
+    model_free(model);
+}
+
+/**
+ * @brief Comparaison de deux durées (qsort).
+ */
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Un tick depuis un scénario de pire cas (stress.h) : commande de tir maintenu, puis model_update.
+ *
+ * Le scénario ne dure qu'un tick (les balles touchent, les explosions
+ * finissent) : chaque tick repart d'une copie non chronométrée et se mesure
+ * seul. Un passage donne le BENCH_WORST_CENTILE-ième centile de ses ticks ;
+ * le rapport résume ces centiles et affiche le tick le plus long.
+ */
+static void bench_worst(StressScenario s)
+{
+    static const char *const keys[STRESS_COUNT] = {
+        [STRESS_POOL_FULL] = "worst_pool_full", [STRESS_FORMATION] = "worst_formation",
+        [STRESS_SHIELDS] = "worst_shields",     [STRESS_UFO] = "worst_ufo",
+        [STRESS_ALL] = "worst_all",
+    };
+    const double dt = 1.0 / TARGET_FPS;
+    long ticks = scaled(200000);
+    GameModel *scenario = scenario_full_wave();
+    stress_build(scenario, s);
+    GameModel *model = model_clone(scenario);
+    double *ticks_ns = malloc((size_t)ticks * sizeof(double));
+    double samples[BENCH_REPEATS];
+    double worst = 0.0;
+
+    for (int r = 0; r < BENCH_REPEATS && ticks_ns; r++)
+    {
+        for (long t = 0; t < ticks; t++)
+        {
+            model_copy(model, scenario);
+            double t0 = utils_get_time();
+            model_handle_input(model, stress_command());
+            model_update(model, dt);
+            ticks_ns[t] = (utils_get_time() - t0) * 1e9;
+        }
+        qsort(ticks_ns, (size_t)ticks, sizeof(double), compare_double);
+        samples[r] = ticks_ns[(ticks - 1) * BENCH_WORST_CENTILE / 100];
+        if (ticks_ns[ticks - 1] > worst)
+            worst = ticks_ns[ticks - 1];
+    }
+    if (ticks_ns)
+    {
+        char name[48];
+        snprintf(name, sizeof(name), "model_update p%d (%s)", BENCH_WORST_CENTILE, stress_name(s));
+        report(name, keys[s], samples, ticks);
+        printf("  %-28s %10.1f ns\n", "  pire tick", worst);
+    }
+    free(ticks_ns);
+    model_free(model);
+    model_free(scenario);
+}
+
+/**
+ * @brief Retour en arrière de ROLLBACK_MAX_FRAMES ticks, en coopération et en virgule fixe.
+ *
+ * Une opération : ROLLBACK_MAX_FRAMES ticks joués avec l'entrée du second
+ * joueur prédite, puis son arrivée, qui contredit la prédiction dès le
+ * premier tick : restauration et resimulation de toute la fenêtre, plus le
+ * tick suivant. C'est le pire cas qu'une image de la boucle doit absorber.
+ */
+static void bench_rollback(const GameModel *scenario)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    long ops = scaled(20000);
+    GameModel *model = model_clone(scenario);
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double elapsed = 0.0;
+        for (long i = 0; i < ops; i++)
+        {
+            model_copy(model, scenario);
+            model->sim.fixed_point = true;
+            model_set_coop(model, true);
+            Rollback rb;
+            if (!rollback_init(&rb, model, dt))
+                break;
+            double t0 = utils_get_time();
+            for (uint32_t t = 0; t < ROLLBACK_MAX_FRAMES; t++)
+            {
+                rollback_add_input(&rb, 0, t, INPUT_LEFT | INPUT_FIRE);
+                rollback_advance(&rb);
+            }
+            rollback_add_input(&rb, 0, ROLLBACK_MAX_FRAMES, INPUT_LEFT | INPUT_FIRE);
+            for (uint32_t t = 0; t < ROLLBACK_MAX_FRAMES; t++)
+                rollback_add_input(&rb, 1, t, INPUT_RIGHT | INPUT_FIRE);
+            rollback_advance(&rb);
+            elapsed += utils_get_time() - t0;
+            rollback_free(&rb);
+        }
+        samples[r] = elapsed * 1e9 / (double)ops;
+    }
+    report("rollback (10 ticks resimulés)", "rollback_max", samples, ops);
+    model_free(model);
+}
+
+/**
+ * @brief Ticks joués par le bot (niveau difficile) depuis un scénario : décision, puis model_update.
+ *
+ * Contrairement aux scénarios figés, le vaisseau se déplace, tire et esquive :
+ * les tirs du joueur, les impacts et les explosions sont dans la mesure.
+ */
+static void bench_bot(GameModel *scenario)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    long batches = (scaled(1000000) + BENCH_UPDATE_TICKS - 1) / BENCH_UPDATE_TICKS;
+    GameModel *model = model_clone(scenario);
+    BotConfig cfg;
+    bot_preset(&cfg, BOT_LEVEL_HARD);
+    Bot bot;
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double elapsed = 0.0;
+        for (long b = 0; b < batches; b++)
+        {
+            model_copy(model, scenario);
+            bot_init(&bot, &cfg, BENCH_SEED);
+            double t0 = utils_get_time();
+            for (int t = 0; t < BENCH_UPDATE_TICKS; t++)
+            {
+                model_handle_input(model, command_held(bot_decide(&bot, model)));
+                model_update(model, dt);
+            }
+            elapsed += utils_get_time() - t0;
+        }
+        samples[r] = elapsed * 1e9 / (double)(batches * BENCH_UPDATE_TICKS);
+    }
+    report("model_update (bot)", "update_bot", samples, batches * BENCH_UPDATE_TICKS);
+    model_free(model);
+}
+
+/**
+ * @brief BENCH_WORLDS mondes (graines distinctes) : une boucle de model_update, puis model_step_batch.
+ *
+ * Même travail dans les deux cas ; le rapport donne le coût d'un tick d'un monde.
+ */
+static void bench_worlds(GameModel *scenario)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    long batches = (scaled(1000000) + BENCH_WORLDS * BENCH_UPDATE_TICKS - 1) / (BENCH_WORLDS * BENCH_UPDATE_TICKS);
+    GameModel *start[BENCH_WORLDS], *worlds[BENCH_WORLDS];
+    for (int w = 0; w < BENCH_WORLDS; w++)
+    {
+        start[w] = model_clone(scenario);
+        model_rng_seed(start[w], BENCH_SEED + (uint64_t)w);
+        worlds[w] = model_clone(start[w]);
+    }
+
+    for (int batched = 0; batched < 2; batched++)
+    {
+        double samples[BENCH_REPEATS];
+        for (int r = 0; r < BENCH_REPEATS; r++)
+        {
+            double elapsed = 0.0;
+            for (long b = 0; b < batches; b++)
+            {
+                for (int w = 0; w < BENCH_WORLDS; w++)
+                    model_copy(worlds[w], start[w]);
+                double t0 = utils_get_time();
+                for (int t = 0; t < BENCH_UPDATE_TICKS; t++)
+                {
+                    if (batched)
+                        model_step_batch(worlds, NULL, BENCH_WORLDS, dt);
+                    else
+                        for (int w = 0; w < BENCH_WORLDS; w++)
+                            model_update(worlds[w], dt);
+                }
+                elapsed += utils_get_time() - t0;
+            }
+            samples[r] = elapsed * 1e9 / (double)(batches * BENCH_WORLDS * BENCH_UPDATE_TICKS);
+        }
+        long ops = batches * BENCH_WORLDS * BENCH_UPDATE_TICKS;
+        if (batched)
+            report("model_step_batch (x256, vague)", "step_batch", samples, ops);
+        else
+            report("model_update (x256, vague)", "update_worlds", samples, ops);
+    }
+
+    for (int w = 0; w < BENCH_WORLDS; w++)
+    {
+        model_free(start[w]);
+        model_free(worlds[w]);
+    }
+}
+
+/**
+ * @brief Tir d'une balle : chaque lot remplit un pool vide (MAX_BULLETS tirs).
+ */
+static void bench_spawn(GameModel *scenario)
+{
+    long batches = (scaled(10000000) + MAX_BULLETS - 1) / MAX_BULLETS;
+    GameModel *model = model_clone(scenario);
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double elapsed = 0.0;
+        for (long b = 0; b < batches; b++)
+        {
+            model_copy(model, scenario); // Pool vide, comme au départ
+            double t0 = utils_get_time();
+            for (int i = 0; i < MAX_BULLETS; i++)
+                model_spawn_bullet(model, (float)i, 25.0f, player_turn(model, i) ? -BULLET_SPEED : BULLET_SPEED,
+                                   player_turn(model, i) ? ENTITY_BULLET_PLAYER : ENTITY_BULLET_ENEMY);
+            elapsed += utils_get_time() - t0;
+        }
+        samples[r] = elapsed * 1e9 / (double)(batches * MAX_BULLETS);
+    }
+    report("spawn_bullet", "spawn_bullet", samples, batches * MAX_BULLETS);
+    model_free(model);
+}
+
+/**
+ * @brief Passe de collisions de model_update (balles contre boucliers, OVNI et joueur).
+ */
+static void bench_collisions(const GameModel *model)
+{
+    const BulletPool *p = &model->sim.bullets;
+    int n = p->high_water;
+    AabbBox shield_boxes[MAX_SHIELDS];
+    for (int s = 0; s < MAX_SHIELDS; s++)
+        shield_boxes[s] = (AabbBox){model->sim.shields[s].x, model->sim.shields[s].y,
+                                    model->sim.shields[s].width, model->sim.shields[s].height};
+    AabbBox ufo_box = {model->sim.ufo.x, model->sim.ufo.y, model->sim.ufo.width, model->sim.ufo.height};
+    AabbBox player_box = {model->sim.player.x, model->sim.player.y, model->sim.player.width, model->sim.player.height};
+
+    uint64_t shield_hits[MAX_SHIELDS][BULLET_MASK_WORDS(MAX_BULLETS)];
+    uint64_t ufo_hits[BULLET_MASK_WORDS(MAX_BULLETS)];
+    uint64_t player_hits[BULLET_MASK_WORDS(MAX_BULLETS)];
+    uint64_t sink = 0; // Empêche le compilateur d'écarter les passes
+    long batches = (scaled(1000000) + BENCH_COLLISION_BATCH - 1) / BENCH_COLLISION_BATCH;
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double elapsed = 0.0;
+        for (long b = 0; b < batches; b++)
+        {
+            double t0 = utils_get_time();
+            for (int k = 0; k < BENCH_COLLISION_BATCH; k++)
+            {
+                collision_many_vs_many(p->x, p->y, BULLET_WIDTH, BULLET_HEIGHT, n,
+                                       shield_boxes, MAX_SHIELDS, &shield_hits[0][0], BULLET_MASK_WORDS(MAX_BULLETS));
+                collision_box_vs_many(&ufo_box, p->x, p->y, BULLET_WIDTH, BULLET_HEIGHT, n, ufo_hits);
+                collision_box_vs_many(&player_box, p->x, p->y, BULLET_WIDTH, BULLET_HEIGHT, n, player_hits);
+                sink += shield_hits[0][0] ^ ufo_hits[0] ^ player_hits[0];
+            }
+            elapsed += utils_get_time() - t0;
+        }
+        samples[r] = elapsed * 1e9 / (double)(batches * BENCH_COLLISION_BATCH);
+    }
+    report("collisions (100 balles)", "collisions", samples, batches * BENCH_COLLISION_BATCH);
+    if (sink == 1) // Jamais vrai en pratique : garde `sink` observable
+        printf("  (masques : %llu)\n", (unsigned long long)sink);
+}
+
+/**
+ * @brief Essaim : BENCH_SWARM_BULLETS balles sous un bloc serré de MAX_ENEMIES cibles.
+ *
+ * Les balles montent ou descendent sur des colonnes tirées au hasard au-dessus
+ * du bloc ; celles qui sortent du terrain reviennent de l'autre bord sur une
+ * nouvelle colonne (une balle réutilisée).
+ */
+static void swarm_scene(Entity *targets, float *xs, float *ys, float *dys)
+{
+    memset(targets, 0, MAX_ENEMIES * sizeof(Entity));
+    for (int t = 0; t < MAX_ENEMIES; t++)
+        targets[t] = (Entity){.x = 25.0f + (t % 10) * 5.0f, .y = 10.0f + (t / 10) * 4.0f,
+                              .width = 4.0f, .height = 3.0f, .active = true};
+    for (int i = 0; i < BENCH_SWARM_BULLETS; i++)
+    {
+        xs[i] = 20.0f + 60.0f * (float)rand() / RAND_MAX;
+        ys[i] = (float)GAME_HEIGHT * (float)rand() / RAND_MAX;
+        dys[i] = (i & 1 ? 1.0f : -1.0f) * (30.0f + 30.0f * (float)rand() / RAND_MAX);
+    }
+}
+
+/**
+ * @brief Couples balle / cible d'un essaim, par la grille puis par tri et balayage (ns par tick).
+ *
+ * Le déplacement des balles entre deux ticks n'est pas chronométré ; le tri
+ * de la liste balayée l'est (sweep_update fait partie de la requête).
+ */
+static void bench_broad_phase(void)
+{
+    static const BroadPhase kinds[] = {BROAD_PHASE_GRID, BROAD_PHASE_SWEEP};
+    static const char *const names[] = {"broad phase grille (essaim)", "broad phase balayage (essaim)"};
+    static const char *const keys[] = {"broad_grid", "broad_sweep"};
+    static Entity targets[MAX_ENEMIES];
+    static float xs[BENCH_SWARM_BULLETS], ys[BENCH_SWARM_BULLETS], dys[BENCH_SWARM_BULLETS];
+    static short live[BENCH_SWARM_BULLETS], order[2 * BENCH_SWARM_BULLETS];
+    static uint64_t active[COLLISION_MASK_WORDS(BENCH_SWARM_BULLETS)], member[COLLISION_MASK_WORDS(BENCH_SWARM_BULLETS)];
+    static CollisionPair pairs[BENCH_SWARM_BULLETS];
+    static BroadPhaseState bp;
+
+    for (int i = 0; i < BENCH_SWARM_BULLETS; i++)
+        live[i] = (short)i;
+    memset(active, 0xFF, sizeof(active));
+    long ticks = scaled(2000);
+    const float step = 1.0f / TARGET_FPS;
+    uint64_t sink = 0;
+
+    for (int k = 0; k < 2; k++)
+    {
+        double samples[BENCH_REPEATS];
+        for (int r = 0; r < BENCH_REPEATS; r++)
+        {
+            srand(BENCH_SEED);
+            swarm_scene(targets, xs, ys, dys);
+            broad_phase_init(&bp, kinds[k], order, member, BENCH_SWARM_BULLETS);
+            double elapsed = 0.0;
+            for (long t = 0; t < ticks; t++)
+            {
+                for (int i = 0; i < BENCH_SWARM_BULLETS; i++)
+                {
+                    ys[i] += dys[i] * step;
+                    if (ys[i] >= 0.0f && ys[i] < GAME_HEIGHT)
+                        continue;
+                    ys[i] = (ys[i] < 0.0f) ? GAME_HEIGHT - 1.0f : 0.0f;
+                    xs[i] = 20.0f + 60.0f * (float)rand() / RAND_MAX;
+                }
+                double t0 = utils_get_time();
+                int n = broad_phase_pairs(&bp, xs, ys, BULLET_WIDTH, BULLET_HEIGHT, live, BENCH_SWARM_BULLETS,
+                                          active, targets, MAX_ENEMIES, pairs, BENCH_SWARM_BULLETS);
+                elapsed += utils_get_time() - t0;
+                sink += (uint64_t)n;
+            }
+            samples[r] = elapsed * 1e9 / (double)ticks;
+        }
+        report(names[k], keys[k], samples, ticks);
+    }
+    if (sink == 1) // Jamais vrai en pratique : garde `sink` observable
+        printf("  (couples : %llu)\n", (unsigned long long)sink);
+}
+
+/**
+ * @brief Une balle contre BOSS_MAX_PARTS pièces : requête dans le BVH, puis boucle sur les pièces (ns par balle).
+ *
+ * Pièces rangées comme la coque du vaisseau amiral (BOSS_COLS par rangée),
+ * un quart détruites ; les balles sont tirées dans la largeur du terrain, sur
+ * la hauteur de la coque et un peu au-delà (la plupart ne touchent rien).
+ */
+static void bench_boss_bvh(void)
+{
+    static const char *const names[] = {"pièces du vaisseau amiral (BVH)", "pièces du vaisseau amiral (boucle)"};
+    static const char *const keys[] = {"boss_bvh", "boss_flat"};
+    BvhBox parts[BOSS_MAX_PARTS], probes[BENCH_BOSS_PROBES];
+    bool alive[BOSS_MAX_PARTS];
+    Bvh bvh;
+
+    srand(BENCH_SEED);
+    for (int k = 0; k < BOSS_MAX_PARTS; k++)
+    {
+        float x = (float)(k % BOSS_COLS * BOSS_PART_WIDTH), y = (float)(k / BOSS_COLS * BOSS_PART_HEIGHT);
+        parts[k] = (BvhBox){x, y, x + BOSS_PART_WIDTH, y + BOSS_PART_HEIGHT};
+    }
+    bvh_build(&bvh, parts, BOSS_MAX_PARTS);
+    for (int k = 0; k < BOSS_MAX_PARTS; k++)
+        if (!(alive[k] = rand() % 4 != 0))
+            bvh_set_leaf(&bvh, k, BVH_EMPTY);
+    float depth = (float)((BOSS_MAX_PARTS + BOSS_COLS - 1) / BOSS_COLS * BOSS_PART_HEIGHT);
+    for (int i = 0; i < BENCH_BOSS_PROBES; i++)
+    {
+        float x = (float)GAME_WIDTH * (float)rand() / RAND_MAX - BOSS_COLS * BOSS_PART_WIDTH / 2.0f;
+        float y = 2.0f * depth * (float)rand() / RAND_MAX - depth / 2.0f;
+        probes[i] = (BvhBox){x, y, x + BULLET_WIDTH, y + BULLET_HEIGHT};
+    }
+
+    long ops = scaled(1000000);
+    uint64_t sink = 0;
+    int8_t found[BOSS_MAX_PARTS];
+    for (int m = 0; m < 2; m++)
+    {
+        double samples[BENCH_REPEATS];
+        for (int r = 0; r < BENCH_REPEATS; r++)
+        {
+            double t0 = utils_get_time();
+            for (long i = 0; i < ops; i++)
+            {
+                BvhBox b = probes[i & (BENCH_BOSS_PROBES - 1)];
+                if (m == 0)
+                    sink += (uint64_t)bvh_query(&bvh, b, found, BOSS_MAX_PARTS);
+                else
+                    for (int k = 0; k < BOSS_MAX_PARTS; k++)
+                        sink += alive[k] && bvh_overlap(parts[k], b);
+            }
+            samples[r] = (utils_get_time() - t0) * 1e9 / (double)ops;
+        }
+        report(names[m], keys[m], samples, ops);
+    }
+    if (sink == 1) // Jamais vrai en pratique : garde `sink` observable
+        printf("  (pièces : %llu)\n", (unsigned long long)sink);
+}
+
+/**
+ * @brief Aller-retour de sauvegarde : save_encode puis save_decode dans un second modèle.
+ */
+static void bench_save(const GameModel *model)
+{
+    GameModel *copy = model_clone(model);
+    static uint8_t buf[SAVE_MAX_SIZE];
+    long ops = scaled(100000);
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = utils_get_time();
+        for (long i = 0; i < ops; i++)
+        {
+            size_t len = save_encode(model, buf, sizeof(buf));
+            if (!save_decode(copy, buf, len))
+            {
+                fprintf(stderr, "[ERREUR] Aller-retour de sauvegarde invalide\n");
+                exit(1);
+            }
+        }
+        samples[r] = (utils_get_time() - t0) * 1e9 / (double)ops;
+    }
+    report("sauvegarde (aller-retour)", "save_roundtrip", samples, ops);
+    model_free(copy);
+}
+
+/**
+ * @brief Empreinte d'état chaînée (statehash_model), comme à chaque tick d'un enregistrement.
+ */
+static void bench_state_hash(const GameModel *model)
+{
+    long ops = scaled(1000000);
+    uint64_t chain = 0;
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = utils_get_time();
+        for (long i = 0; i < ops; i++)
+            chain = statehash_model(model, chain);
+        samples[r] = (utils_get_time() - t0) * 1e9 / (double)ops;
+    }
+    report("empreinte d'état (maximum)", "state_hash", samples, ops);
+    if (chain == 1) // Jamais vrai en pratique : garde `chain` observable
+        printf("  (chaîne : %llx)\n", (unsigned long long)chain);
+}
+
+/**
+ * @brief Origine de la vague une minute plus tard (model_formation_at) : un segment par rebond.
+ *
+ * Simuler la même minute coûte TARGET_FPS × 60 ticks de model_update.
+ */
+static void bench_formation_seek(const GameModel *model)
+{
+    long ops = scaled(1000000);
+    float sum = 0.0f;
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = utils_get_time();
+        for (long i = 0; i < ops; i++)
+        {
+            float x, y;
+            model_formation_at(model, TARGET_FPS * 60 + (int)(i & 63), &x, &y);
+            sum += x;
+        }
+        samples[r] = (utils_get_time() - t0) * 1e9 / (double)ops;
+    }
+    report("vague dans 60 s (segments)", "formation_seek", samples, ops);
+    if (sum == 1.0f) // Jamais vrai en pratique : garde `sum` observable
+        printf("  (somme : %f)\n", sum);
+}
+
+/**
+ * @brief Compaction de l'image (model_pack_entities) : joueur, vague, balles, OVNI.
+ */
+static void bench_pack(const GameModel *model)
+{
+    int cap = PACK_FRAME_MAX(model->sim.bullets.capacity);
+    PackedEntity *out = malloc((size_t)cap * sizeof(PackedEntity));
+    long ops = scaled(1000000);
+    long sink = 0;
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = utils_get_time();
+        for (long i = 0; i < ops; i++)
+            sink += model_pack_entities(model, out, cap);
+        samples[r] = (utils_get_time() - t0) * 1e9 / (double)ops;
+    }
+    report("model_pack_entities (maximum)", "pack_entities", samples, ops);
+    if (sink == 1) // Jamais vrai en pratique : garde `sink` observable
+        printf("  (entités : %ld)\n", sink);
+    free(out);
+}
+
+/**
+ * @brief Avance de BENCH_PARTICLES particules (particles_update), en ns par particule.
+ *
+ * Chaque frame de 1 / TARGET_FPS intègre, estompe et retire les mortes ; la
+ * réserve est ensuite complétée par des gerbes (non chronométrées), comme
+ * pendant une vague d'explosions soutenue.
+ */
+static void bench_particles(void)
+{
+    ParticlePool pool;
+    if (!particles_init(&pool, BENCH_PARTICLES))
+        return;
+    long frames = (scaled(100000000) + BENCH_PARTICLES - 1) / BENCH_PARTICLES;
+    double samples[BENCH_REPEATS];
+    long stepped = 0;
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double elapsed = 0.0;
+        stepped = 0;
+        for (long f = 0; f < frames; f++)
+        {
+            while (pool.count < BENCH_PARTICLES)
+                particles_burst(&pool, 50.0f, 25.0f, 64, 0xFF8040, 30.0f, 0.8f);
+            stepped += pool.count;
+            double t0 = utils_get_time();
+            particles_update(&pool, 1.0f / TARGET_FPS);
+            elapsed += utils_get_time() - t0;
+        }
+        samples[r] = elapsed * 1e9 / (double)stepped;
+    }
+    report("particules (50 000 vivantes)", "particles_step", samples, stepped);
+    particles_free(&pool);
+}
+
+/**
+ * @brief Paire de sondes du profileur (profiler_begin / profiler_end), sans le cumul.
+ *
+ * utils_fast_ns lit le compteur du processeur quand il est calibré ; sinon,
+ * comme utils_now_ns, l'horloge monotone du système.
+ */
+static void bench_clock_probe(void)
+{
+    utils_fast_clock_init();
+    long ops = scaled(10000000);
+    uint64_t sink = 0;
+    double samples[BENCH_REPEATS];
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = utils_get_time();
+        for (long i = 0; i < ops; i++)
+        {
+            uint64_t start = utils_fast_ns();
+            sink += utils_fast_ns() - start;
+        }
+        samples[r] = (utils_get_time() - t0) * 1e9 / (double)ops;
+    }
+    report("sonde du profileur (2 lectures)", "clock_probe", samples, ops);
+    if (sink == 1) // Jamais vrai en pratique : garde `sink` observable
+        printf("  (cumul : %llu)\n", (unsigned long long)sink);
+}
+
+// ============================================================================
+//                          5. POINT D'ENTRÉE
+// ============================================================================
+
+/**
+ * @brief Lance tous les bancs.
+ *
+ * Usage : `space_invaders_bench [facteur] [--json=fichier]` : le facteur
+ * multiplie le nombre d'opérations, `--json` ajoute les résultats au fichier
+ * (une ligne, cf. results.h).
+ */
+int main(int argc, char *argv[])
+{
+    const char *json = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--json=", 7) == 0)
+            json = argv[i] + 7;
+        else if ((scale = atof(argv[i])) <= 0.0)
+        {
+            fprintf(stderr, "Usage : %s [facteur > 0] [--json=fichier]\n", argv[0]);
+            return 1;
+        }
+    }
+    bench_record_init(&record, scale);
+
+    GameModel *full = scenario_full_wave();
+    GameModel *late = scenario_late_wave();
+    GameModel *bullets = scenario_bullets();
+    GameModel *sparse = scenario_sparse();
+    GameModel *stress = scenario_stress();
+
+    printf("Bancs d'essai (%d passages, facteur %.2f)\n", BENCH_REPEATS, scale);
+    bench_update("model_update (vague pleine)", "update_full_wave", full, model_update);
+    bench_update("model_update (fin de vague)", "update_late_wave", late, model_update);
+    bench_update("model_update (100 balles)", "update_bullets", bullets, model_update);
+    bench_update("  référence (100 balles)", "update_bullets_reference", bullets, model_update_reference);
+    bench_update("model_update (pool clairsemé)", "update_sparse", sparse, model_update);
+    bench_update("  référence (pool clairsemé)", "update_sparse_reference", sparse, model_update_reference);
+    bench_update("model_update (maximum)", "update_stress", stress, model_update);
+    stress->sim.fixed_point = true; // Scénario maximum, physique entière (model_set_fixed_point)
+    bench_update("model_update (virgule fixe)", "update_stress_fixed", stress, model_update);
+    bench_update("  référence (virgule fixe)", "update_stress_fixed_reference", stress, model_update_reference);
+    stress->sim.fixed_point = false;
+    for (StressScenario s = STRESS_POOL_FULL; s < STRESS_COUNT; s++)
+        bench_worst(s);
+    bench_bot(full);
+    bench_rollback(full);
+    bench_worlds(full);
+    bench_spawn(full);
+    bench_collisions(bullets);
+    bench_broad_phase();
+    bench_boss_bvh();
+    bench_save(stress);
+    bench_state_hash(stress);
+    bench_formation_seek(full);
+    bench_pack(stress);
+    bench_particles();
+    bench_clock_probe();
+
+    model_free(full);
+    model_free(late);
+    model_free(bullets);
+    model_free(sparse);
+    model_free(stress);
+
+    if (json)
+    {
+        if (!bench_record_append(&record, json))
+            return 1;
+        printf("Résultats ajoutés à %s (version %s, machine %s)\n", json, record.git, record.machine);
+    }
+    return 0;
+}
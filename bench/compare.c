@@ -0,0 +1,75 @@
+/**
+ * @file compare.c
+ * @brief Compare la dernière exécution des bancs à la référence de la même machine.
+ *
+ * @code
+ * space_invaders_bench_compare bench/baseline.jsonl bench/results.jsonl 10
+ * @endcode
+ *
+ * Pour chaque métrique, le meilleur passage (min) est comparé à celui de la
+ * dernière référence enregistrée pour cette machine : c'est la valeur la moins
+ * sensible au bruit (interruptions, autres processus). Une métrique plus lente
+ * que la référence de plus du seuil (en %) est signalée, et le programme
+ * sort en erreur : `make bench-check` échoue comme un test.
+ */
+
+#include "results.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COMPARE_DEFAULT_THRESHOLD 10.0 ///< Ralentissement toléré par défaut (%).
+
+/**
+ * @brief Affiche le tableau des écarts et renvoie 1 si une métrique a régressé.
+ *
+ * Usage : `space_invaders_bench_compare <reference.jsonl> <resultats.jsonl> [seuil_%]`.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s <reference.jsonl> <resultats.jsonl> [seuil_%%]\n", argv[0]);
+        return 2;
+    }
+    double threshold = argc > 3 ? atof(argv[3]) : COMPARE_DEFAULT_THRESHOLD;
+
+    BenchRecord cur, ref;
+    if (!bench_record_load_last(argv[2], NULL, &cur))
+    {
+        fprintf(stderr, "[ERREUR] Aucun résultat lisible dans %s\n", argv[2]);
+        return 2;
+    }
+    if (!bench_record_load_last(argv[1], cur.machine, &ref))
+    {
+        printf("Aucune référence pour la machine %s dans %s : comparaison ignorée.\n", cur.machine, argv[1]);
+        printf("(make bench-baseline en enregistre une.)\n");
+        return 0;
+    }
+
+    printf("Référence %s -> version %s (machine %s, seuil %.0f %%)\n", ref.git, cur.git, cur.machine, threshold);
+    int regressions = 0;
+    for (int i = 0; i < cur.count; i++)
+    {
+        const BenchMetric *m = &cur.metrics[i];
+        const BenchMetric *r = bench_record_find(&ref, m->name);
+        if (!r || r->min <= 0.0)
+        {
+            printf("  %-24s %10.1f ns/op  (nouvelle métrique)\n", m->name, m->min);
+            continue;
+        }
+        double delta = 100.0 * (m->min - r->min) / r->min;
+        bool slower = delta > threshold;
+        regressions += slower;
+        printf("  %-24s %10.1f -> %10.1f ns/op  %+6.1f %%%s\n", m->name, r->min, m->min, delta,
+               slower ? "  REGRESSION" : "");
+    }
+
+    if (regressions > 0)
+    {
+        printf("%d métrique(s) plus lente(s) que la référence de plus de %.0f %%.\n", regressions, threshold);
+        return 1;
+    }
+    printf("Aucune régression.\n");
+    return 0;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file results.c
+ * @brief Écriture et relecture des résultats de bancs d'essai (POSIX).
+ *
+ * Le format étant produit ici même, la relecture ne gère que lui : clés dans
+ * l'ordre d'écriture, sans espaces ni échappements.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour gethostname).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "results.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. HELPERS
+// ============================================================================
+
+/**
+ * @brief Copie une chaîne en écartant ce qui casserait la ligne JSON.
+ */
+static void copy_clean(char *dst, size_t cap, const char *src)
+{
+    size_t n = 0;
+    for (; *src && n + 1 < cap; src++)
+    {
+        char c = *src;
+        if (c == '"' || c == '\\' || c == '\n' || (unsigned char)c < 0x20)
+            continue;
+        dst[n++] = c;
+    }
+    dst[n] = '\0';
+}
+
+/**
+ * @brief Identifiant de la machine (variable d'environnement, machine-id ou nom d'hôte).
+ */
+static void read_machine(char *out, size_t cap)
+{
+    const char *env = getenv("SPACE_INVADERS_BENCH_MACHINE");
+    if (env && env[0])
+    {
+        copy_clean(out, cap, env);
+        return;
+    }
+
+    char buf[64] = {0};
+    FILE *f = fopen("/etc/machine-id", "r");
+    if (f)
+    {
+        if (fgets(buf, sizeof(buf), f))
+            buf[strcspn(buf, "\n")] = '\0';
+        fclose(f);
+    }
+    if (!buf[0] && gethostname(buf, sizeof(buf) - 1) != 0)
+        buf[0] = '\0';
+    copy_clean(out, cap, buf[0] ? buf : "inconnue");
+}
+
+/**
+ * @brief Modèle du processeur, d'après /proc/cpuinfo (vide si indisponible).
+ */
+static void read_cpu(char *out, size_t cap)
+{
+    out[0] = '\0';
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (!f)
+        return;
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        char *colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) == 0 && colon)
+        {
+            const char *value = colon + 1;
+            while (*value == ' ' || *value == '\t')
+                value++;
+            copy_clean(out, cap, value);
+            break;
+        }
+    }
+    fclose(f);
+}
+
+/**
+ * @brief Lit la chaîne associée à `key` ("clé":"valeur").
+ */
+static bool parse_string(const char *line, const char *key, char *out, size_t cap)
+{
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":\"", key);
+    const char *p = strstr(line, pattern);
+    if (!p)
+        return false;
+    p += strlen(pattern);
+    const char *end = strchr(p, '"');
+    if (!end)
+        return false;
+    size_t n = (size_t)(end - p) < cap - 1 ? (size_t)(end - p) : cap - 1;
+    memcpy(out, p, n);
+    out[n] = '\0';
+    return true;
+}
+
+/**
+ * @brief Lit le nombre associé à `key` ("clé":nombre).
+ */
+static bool parse_number(const char *line, const char *key, double *out)
+{
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *p = strstr(line, pattern);
+    return p && sscanf(p + strlen(pattern), "%lf", out) == 1;
+}
+
+/**
+ * @brief Décode une ligne de résultats.
+ */
+static bool parse_record(const char *line, BenchRecord *rec)
+{
+    memset(rec, 0, sizeof(*rec));
+    double time = 0.0;
+    if (!parse_string(line, "git", rec->git, sizeof(rec->git)) ||
+        !parse_string(line, "machine", rec->machine, sizeof(rec->machine)) ||
+        !parse_number(line, "time", &time) || !parse_number(line, "scale", &rec->scale))
+        return false;
+    parse_string(line, "cpu", rec->cpu, sizeof(rec->cpu));
+    rec->time = (long long)time;
+
+    const char *p = strstr(line, "\"metrics\":{");
+    if (!p)
+        return false;
+    p += strlen("\"metrics\":{");
+    while (*p == '"' && rec->count < BENCH_MAX_METRICS)
+    {
+        BenchMetric *m = &rec->metrics[rec->count];
+        const char *end = strchr(p + 1, '"');
+        if (!end || (size_t)(end - p - 1) >= sizeof(m->name))
+            return false;
+        memcpy(m->name, p + 1, (size_t)(end - p - 1));
+        m->name[end - p - 1] = '\0';
+        int used = 0;
+        if (sscanf(end, "\":{\"mean\":%lf,\"stddev\":%lf,\"min\":%lf}%n", &m->mean, &m->stddev, &m->min, &used) != 3 ||
+            used == 0)
+            return false;
+        rec->count++;
+        p = end + used;
+        if (*p == ',')
+            p++;
+    }
+    return true;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Prépare un enregistrement vide pour la machine courante.
+ */
+void bench_record_init(BenchRecord *rec, double scale)
+{
+    memset(rec, 0, sizeof(*rec));
+    const char *git = getenv("SPACE_INVADERS_BENCH_GIT"); // Fourni par le Makefile (git describe)
+    copy_clean(rec->git, sizeof(rec->git), git && git[0] ? git : "inconnue");
+    read_machine(rec->machine, sizeof(rec->machine));
+    read_cpu(rec->cpu, sizeof(rec->cpu));
+    rec->time = (long long)time(NULL);
+    rec->scale = scale;
+}
+
+/**
+ * @brief Ajoute une métrique.
+ */
+void bench_record_add(BenchRecord *rec, const char *name, double mean, double stddev, double min)
+{
+    if (rec->count >= BENCH_MAX_METRICS)
+        return;
+    BenchMetric *m = &rec->metrics[rec->count++];
+    copy_clean(m->name, sizeof(m->name), name);
+    m->mean = mean;
+    m->stddev = stddev;
+    m->min = min;
+}
+
+/**
+ * @brief Cherche une métrique par son nom.
+ */
+const BenchMetric *bench_record_find(const BenchRecord *rec, const char *name)
+{
+    for (int i = 0; i < rec->count; i++)
+        if (strcmp(rec->metrics[i].name, name) == 0)
+            return &rec->metrics[i];
+    return NULL;
+}
+
+/**
+ * @brief Ajoute l'enregistrement en fin de fichier.
+ */
+bool bench_record_append(const BenchRecord *rec, const char *path)
+{
+    FILE *f = fopen(path, "a");
+    if (!f)
+    {
+        fprintf(stderr, "[ERREUR] Impossible d'ouvrir %s\n", path);
+        return false;
+    }
+    fprintf(f, "{\"git\":\"%s\",\"machine\":\"%s\",\"cpu\":\"%s\",\"time\":%lld,\"scale\":%.2f,\"metrics\":{",
+            rec->git, rec->machine, rec->cpu, rec->time, rec->scale);
+    for (int i = 0; i < rec->count; i++)
+    {
+        const BenchMetric *m = &rec->metrics[i];
+        fprintf(f, "%s\"%s\":{\"mean\":%.1f,\"stddev\":%.1f,\"min\":%.1f}", i ? "," : "", m->name, m->mean,
+                m->stddev, m->min);
+    }
+    fprintf(f, "}}\n");
+    return fclose(f) == 0;
+}
+
+/**
+ * @brief Relit la dernière ligne valide (de la machine demandée, si précisée).
+ */
+bool bench_record_load_last(const char *path, const char *machine, BenchRecord *rec)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+
+    char line[BENCH_LINE_MAX];
+    BenchRecord cur;
+    bool found = false;
+    while (fgets(line, sizeof(line), f))
+    {
+        if (parse_record(line, &cur) && (!machine || strcmp(cur.machine, machine) == 0))
+        {
+            *rec = cur;
+            found = true;
+        }
+    }
+    fclose(f);
+    return found;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file results.h
+ * @brief Format des résultats de bancs d'essai (une ligne JSON par exécution).
+ *
+ * Chaque exécution de `space_invaders_bench --json=fichier` ajoute une ligne :
+ *
+ * @code
+ * {"git":"68c73dc","machine":"5f2a…","cpu":"…","time":1760000000,"scale":1.00,
+ *  "metrics":{"update_full_wave":{"mean":210.9,"stddev":7.6,"min":203.3},…}}
+ * @endcode
+ *
+ * Les valeurs sont en ns par opération. `machine` identifie la machine
+ * (SPACE_INVADERS_BENCH_MACHINE, sinon /etc/machine-id, sinon le nom d'hôte) :
+ * on ne compare que des mesures prises au même endroit.
+ */
+
+#ifndef BENCH_RESULTS_H
+#define BENCH_RESULTS_H
+
+#include <stdbool.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Résultats */
+///@{
+#define BENCH_MAX_METRICS 48   ///< Métriques par exécution au plus.
+#define BENCH_LINE_MAX 8192    ///< Longueur maximale d'une ligne de résultats.
+///@}
+
+/**
+ * @brief Une métrique : un banc résumé sur ses passages (ns par opération).
+ */
+typedef struct
+{
+    char name[48]; ///< Clé stable (ex: "update_full_wave").
+    double mean;   ///< Moyenne des passages.
+    double stddev; ///< Écart-type des passages.
+    double min;    ///< Meilleur passage (valeur comparée).
+} BenchMetric;
+
+/**
+ * @brief Une exécution complète des bancs.
+ */
+typedef struct
+{
+    char git[48];      ///< Version du code (SPACE_INVADERS_BENCH_GIT : git describe, "-dirty" si modifié).
+    char machine[64];  ///< Identifiant de la machine.
+    char cpu[96];      ///< Modèle du processeur (information).
+    long long time;    ///< Date de l'exécution (secondes depuis 1970).
+    double scale;      ///< Facteur du nombre d'opérations.
+    int count;         ///< Métriques remplies.
+    BenchMetric metrics[BENCH_MAX_METRICS]; ///< Résultats.
+} BenchRecord;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Prépare un enregistrement vide : version, machine, processeur et date courants.
+ */
+void bench_record_init(BenchRecord *rec, double scale);
+
+/**
+ * @brief Ajoute une métrique (ignorée au-delà de BENCH_MAX_METRICS).
+ */
+void bench_record_add(BenchRecord *rec, const char *name, double mean, double stddev, double min);
+
+/**
+ * @brief Cherche une métrique par son nom.
+ * @return La métrique, ou NULL si absente.
+ */
+const BenchMetric *bench_record_find(const BenchRecord *rec, const char *name);
+
+/**
+ * @brief Ajoute l'enregistrement en fin de fichier (une ligne JSON).
+ * @return false si le fichier n'a pas pu être écrit.
+ */
+bool bench_record_append(const BenchRecord *rec, const char *path);
+
+/**
+ * @brief Relit la dernière ligne d'un fichier, éventuellement pour une machine donnée.
+ *
+ * @param machine Identifiant recherché, ou NULL pour la dernière ligne quelle qu'elle soit.
+ * @return false si le fichier est absent ou ne contient aucune ligne correspondante.
+ */
+bool bench_record_load_last(const char *path, const char *machine, BenchRecord *rec);
+
+#endif // BENCH_RESULTS_H
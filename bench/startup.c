@@ -0,0 +1,239 @@
+/**
+ * @file startup.c
+ * @brief Banc de démarrage (`make bench-startup`) : de main() au menu, puis à la première image jouable.
+ *
+ * @code
+ * space_invaders_bench_startup ./space_invaders 5 bench/startup.jsonl assets assets.pak ./space_invaders
+ * @endcode
+ *
+ * Le jeu est lancé en SDL avec SPACE_INVADERS_STARTUP_BENCH=1 : il s'arrête à
+ * la première image jouable et écrit son bilan (cf. startup.h). Chaque série
+ * est lancée deux fois :
+ * - à froid : le cache de pages est vidé avant chaque lancement
+ *   (/proc/sys/vm/drop_caches, réservé à root), sinon les fichiers donnés
+ *   après le fichier de résultats en sont retirés un à un (posix_fadvise) :
+ *   ressources, archive, exécutable, bibliothèques SDL ;
+ * - à chaud : après un lancement non compté qui remplit le cache.
+ *
+ * Chaque clé du bilan devient une métrique "cold_<clé>" ou "warm_<clé>", en
+ * ns par démarrage, ajoutée au fichier de résultats dans le format des bancs
+ * (results.h) : `space_invaders_bench_compare` la compare à une référence.
+ */
+
+/** @def _XOPEN_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 et XSI (popen, setenv, posix_fadvise, sync).
+ */
+#define _XOPEN_SOURCE 600
+
+#include "results.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define STARTUP_MAX_RUNS 50 ///< Lancements par série au plus.
+#define STARTUP_KEYS 8      ///< Clés du bilan (deux séries : 16 métriques, BENCH_MAX_METRICS).
+
+/** @brief Clés lues dans la ligne "[DEMARRAGE]" du jeu, jalons d'abord. */
+static const char *const keys[STARTUP_KEYS] = {"menu_frame", "playable_frame", "model_init", "sdl_init",
+                                               "fonts",      "textures",       "images",     "audio"};
+
+/**
+ * @brief Une série de lancements : millisecondes par clé et par lancement.
+ */
+typedef struct
+{
+    int runs;                                  ///< Lancements réussis.
+    double ms[STARTUP_KEYS][STARTUP_MAX_RUNS]; ///< Valeurs relevées.
+} StartupSeries;
+
+// ============================================================================
+//                          1. HELPERS
+// ============================================================================
+
+/**
+ * @brief Retire un fichier (ou un dossier, récursivement) du cache de pages.
+ * @return Fichiers traités.
+ */
+static int evict_path(const char *path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return 0; // Archive absente, par exemple
+    if (S_ISDIR(st.st_mode))
+    {
+        DIR *dir = opendir(path);
+        if (!dir)
+            return 0;
+        int count = 0;
+        struct dirent *e;
+        while ((e = readdir(dir)) != NULL)
+        {
+            if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+                continue;
+            char child[1024];
+            snprintf(child, sizeof(child), "%s/%s", path, e->d_name);
+            count += evict_path(child);
+        }
+        closedir(dir);
+        return count;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+    fdatasync(fd); // Des pages modifiées ne seraient pas retirées
+    int ok = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return ok;
+}
+
+/**
+ * @brief Vide le cache avant un lancement à froid.
+ * @return true si tout le cache a été vidé (false : seulement les chemins donnés).
+ */
+static bool drop_caches(char *const paths[], int count)
+{
+    sync();
+    FILE *f = fopen("/proc/sys/vm/drop_caches", "w");
+    if (f)
+    {
+        bool ok = fputs("3\n", f) >= 0;
+        if (fclose(f) == 0 && ok)
+            return true;
+    }
+    for (int i = 0; i < count; i++)
+        evict_path(paths[i]);
+    return false;
+}
+
+/**
+ * @brief Lance le jeu une fois et relève son bilan.
+ * @return false si le jeu n'a pas atteint d'image jouable.
+ */
+static bool run_once(const char *game, double out[STARTUP_KEYS])
+{
+    char cmd[1100];
+    snprintf(cmd, sizeof(cmd), "'%s' sdl 2>/dev/null", game);
+    FILE *p = popen(cmd, "r");
+    if (!p)
+        return false;
+    char line[BENCH_LINE_MAX];
+    bool found = false;
+    for (int k = 0; k < STARTUP_KEYS; k++)
+        out[k] = -1.0;
+    while (fgets(line, sizeof(line), p))
+    {
+        if (strncmp(line, "[DEMARRAGE]", 11) != 0)
+            continue;
+        found = true;
+        for (int k = 0; k < STARTUP_KEYS; k++)
+        {
+            char pattern[64];
+            snprintf(pattern, sizeof(pattern), " %s=", keys[k]);
+            const char *at = strstr(line, pattern);
+            if (at)
+                out[k] = atof(at + strlen(pattern));
+        }
+    }
+    pclose(p);
+    return found && out[1] >= 0.0; // Jalon "playable_frame" atteint
+}
+
+/**
+ * @brief Lance une série.
+ */
+static bool run_series(const char *game, int runs, bool cold, char *const paths[], int count, StartupSeries *s)
+{
+    memset(s, 0, sizeof(*s));
+    double values[STARTUP_KEYS];
+    if (!cold)
+        run_once(game, values); // Remplit le cache, non compté
+    for (int r = 0; r < runs; r++)
+    {
+        if (cold && !drop_caches(paths, count) && r == 0)
+            printf("(cache de pages réservé à root : %d chemin(s) retirés un à un)\n", count);
+        if (!run_once(game, values))
+        {
+            fprintf(stderr, "[ERREUR] Lancement %d : pas d'image jouable (affichage disponible ?)\n", r + 1);
+            return false;
+        }
+        for (int k = 0; k < STARTUP_KEYS; k++)
+            s->ms[k][r] = values[k] < 0.0 ? 0.0 : values[k];
+        s->runs++;
+    }
+    return true;
+}
+
+/**
+ * @brief Résume une série dans l'enregistrement (ns par démarrage) et l'affiche.
+ */
+static void add_series(BenchRecord *rec, const char *prefix, const StartupSeries *s)
+{
+    for (int k = 0; k < STARTUP_KEYS; k++)
+    {
+        double sum = 0.0, min = s->ms[k][0];
+        for (int r = 0; r < s->runs; r++)
+        {
+            sum += s->ms[k][r];
+            if (s->ms[k][r] < min)
+                min = s->ms[k][r];
+        }
+        double mean = sum / s->runs, var = 0.0;
+        for (int r = 0; r < s->runs; r++)
+            var += (s->ms[k][r] - mean) * (s->ms[k][r] - mean);
+        double stddev = sqrt(var / s->runs);
+        char name[48];
+        snprintf(name, sizeof(name), "%s_%s", prefix, keys[k]);
+        bench_record_add(rec, name, mean * 1e6, stddev * 1e6, min * 1e6);
+        printf("  %-22s %8.1f ms  (min %8.1f, écart %5.1f)\n", name, mean, min, stddev);
+    }
+}
+
+// ============================================================================
+//                          2. POINT D'ENTRÉE
+// ============================================================================
+
+/**
+ * @brief Séries à froid puis à chaud, ajoutées au fichier de résultats.
+ *
+ * Usage : `space_invaders_bench_startup <jeu> <lancements> <resultats.jsonl> [chemins à évincer...]`.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "Usage : %s <jeu> <lancements> <resultats.jsonl> [chemins à évincer...]\n", argv[0]);
+        return 2;
+    }
+    int runs = atoi(argv[2]);
+    if (runs < 1 || runs > STARTUP_MAX_RUNS)
+    {
+        fprintf(stderr, "[ERREUR] Lancements : de 1 à %d attendus\n", STARTUP_MAX_RUNS);
+        return 2;
+    }
+    setenv("SPACE_INVADERS_STARTUP_BENCH", "1", 1);
+
+    static StartupSeries cold, warm;
+    printf("Démarrage de %s : %d lancement(s) à froid, %d à chaud\n", argv[1], runs, runs);
+    if (!run_series(argv[1], runs, true, argv + 4, argc - 4, &cold) ||
+        !run_series(argv[1], runs, false, argv + 4, argc - 4, &warm))
+        return 1;
+
+    BenchRecord rec;
+    bench_record_init(&rec, 1.0);
+    add_series(&rec, "cold", &cold);
+    add_series(&rec, "warm", &warm);
+    if (!bench_record_append(&rec, argv[3]))
+        return 1;
+    printf("Résultats ajoutés à %s\n", argv[3]);
+    return 0;
+}
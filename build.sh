@@ -32,7 +32,7 @@ then
     cd $INIT_PATH/3rdParty/SDL3_image/
     mkdir build
     cd build
-    cmake .. -DSDL3_DIR=../SDL3/build
+    cmake .. -DSDL3_DIR=../SDL3/build -DSDLIMAGE_PNG=ON # Miniatures des sauvegardes relues en PNG
     make -j
 fi
 
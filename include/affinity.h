@@ -0,0 +1,77 @@
+/**
+ * @file affinity.h
+ * @brief Placement des threads du jeu : cœurs réservés et priorité temps réel.
+ *
+ * Sur une borne partagée (mises à jour, envoi des journaux), le
+ * planificateur peut faire attendre la simulation ou le rendu derrière un
+ * processus d'arrière-plan : ce sont les pics de latence des images en
+ * retard. Chaque thread du jeu peut donc être fixé sur un ensemble de cœurs
+ * et demander l'ordonnancement SCHED_FIFO, par variables d'environnement :
+ *
+ * - `SPACE_INVADERS_CPU_<RÔLE>=0-1,3` : cœurs autorisés (liste et plages) ;
+ * - `SPACE_INVADERS_RT_<RÔLE>=N` : SCHED_FIFO de priorité N (1 à 99).
+ *
+ * Rôles : SIM (thread de simulation, SPACE_INVADERS_SIM_THREAD=1), RENDER
+ * (thread principal : rendu, et simulation dans la boucle classique), INPUT
+ * (thread d'entrée ncurses, SPACE_INVADERS_INPUT_THREAD=1) et AUDIO (thread
+ * du périphérique audio SDL).
+ *
+ * Rien n'est fatal : les cœurs hors de ceux permis au processus sont
+ * ignorés ; sans le droit au temps réel (CAP_SYS_NICE, RLIMIT_RTPRIO), la
+ * priorité est ramenée à la limite permise, puis remplacée par la meilleure
+ * valeur de nice que RLIMIT_NICE autorise, puis laissée telle quelle. Le
+ * réglage obtenu est journalisé au démarrage de chaque thread configuré.
+ *
+ * @code
+ * static void *sim_main(void *arg)
+ * {
+ *     affinity_apply(THREAD_ROLE_SIM); // Premier appel du thread
+ *     ...
+ * }
+ * @endcode
+ */
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <stdbool.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define AFFINITY_NICE_FALLBACK (-10) ///< nice visé quand SCHED_FIFO est refusé.
+
+/**
+ * @brief Thread du jeu, et suffixe de ses variables d'environnement.
+ */
+typedef enum
+{
+    THREAD_ROLE_SIM,    ///< Thread de simulation (SPACE_INVADERS_CPU_SIM, SPACE_INVADERS_RT_SIM).
+    THREAD_ROLE_RENDER, ///< Thread principal (SPACE_INVADERS_CPU_RENDER, SPACE_INVADERS_RT_RENDER).
+    THREAD_ROLE_INPUT,  ///< Thread d'entrée ncurses (SPACE_INVADERS_CPU_INPUT, SPACE_INVADERS_RT_INPUT).
+    THREAD_ROLE_AUDIO,  ///< Thread audio SDL (SPACE_INVADERS_CPU_AUDIO, SPACE_INVADERS_RT_AUDIO).
+    THREAD_ROLE_COUNT
+} ThreadRole;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Un placement ou une priorité est demandé pour ce rôle.
+ *
+ * Permet de ne pas installer de point d'accroche (callback audio) inutile.
+ */
+bool affinity_configured(ThreadRole role);
+
+/**
+ * @brief Applique au thread appelant le réglage de son rôle, et journalise le résultat.
+ *
+ * Sans effet si rien n'est demandé pour ce rôle.
+ *
+ * @return true si tout ce qui était demandé a été obtenu.
+ */
+bool affinity_apply(ThreadRole role);
+
+#endif // AFFINITY_H
@@ -0,0 +1,122 @@
+/**
+ * @file asset_pack.h
+ * @brief Archive des ressources : toutes les images, polices et sons en un fichier.
+ *
+ * Au démarrage, la Vue SDL ouvrait une quarantaine de fichiers dans `assets/`.
+ * `./space_invaders pack` les range dans une seule archive (`assets.pak`,
+ * `make pack`) que le jeu projette en mémoire (mmap) d'un seul appel :
+ *
+ * @code
+ * AssetPackHeader | AssetEntry[count] (triées par nom) | blocs alignés sur ASSET_PACK_ALIGN
+ * @endcode
+ *
+ * Les images y sont déjà décodées en ARGB8888 (le premier format de texture
+ * des renderers SDL, qui n'ont donc rien à convertir), la couleur clé
+ * (noir) convertie en transparence : la Vue en fait des surfaces sans copie
+ * ni conversion. Polices et sons sont copiés tels quels et lus en mémoire.
+ * L'archive est écrite dans l'ordre des octets de la machine qui la produit.
+ *
+ * Si l'archive est absente ou illisible, la Vue lit les fichiers un à un.
+ */
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Archive des ressources */
+///@{
+#define ASSET_PACK_PATH "assets.pak" ///< Archive cherchée par défaut (SPACE_INVADERS_ASSETS pour une autre).
+#define ASSET_PACK_MAGIC "SIPK"      ///< Signature en tête de fichier.
+#define ASSET_PACK_VERSION 1         ///< Version du format.
+#define ASSET_PACK_ALIGN 64          ///< Alignement des blocs (une ligne de cache).
+#define ASSET_PACK_MAX_ENTRIES 128   ///< Fichiers d'une archive au plus.
+#define ASSET_NAME_MAX 64            ///< Chemin d'une ressource (ex: "assets/aliens/alien_A1.bmp").
+///@}
+
+/**
+ * @brief Nature d'une ressource.
+ */
+typedef enum
+{
+    ASSET_RAW = 0,   ///< Octets du fichier d'origine (police, son).
+    ASSET_PIXELS = 1 ///< Image décodée (largeur, hauteur, pas, format).
+} AssetKind;
+
+/**
+ * @brief En-tête de l'archive.
+ */
+typedef struct
+{
+    char magic[4];    ///< ASSET_PACK_MAGIC.
+    uint32_t version; ///< ASSET_PACK_VERSION.
+    uint32_t count;   ///< Entrées de la table.
+    uint32_t reserved;
+} AssetPackHeader;
+
+/**
+ * @brief Une entrée de la table des matières.
+ */
+typedef struct
+{
+    char name[ASSET_NAME_MAX]; ///< Chemin d'origine, relatif au dossier du jeu.
+    uint64_t offset;           ///< Début du bloc depuis le début du fichier.
+    uint32_t size;             ///< Taille du bloc (octets).
+    uint32_t kind;             ///< AssetKind.
+    uint32_t width, height;    ///< Dimensions (ASSET_PIXELS).
+    uint32_t pitch;            ///< Octets par ligne (ASSET_PIXELS).
+    uint32_t format;           ///< Format SDL des pixels (ASSET_PIXELS).
+} AssetEntry;
+
+/**
+ * @brief Archive ouverte (projection en lecture seule).
+ */
+typedef struct
+{
+    const uint8_t *base;       ///< Début de la projection (NULL : pas d'archive).
+    size_t size;               ///< Taille projetée.
+    const AssetEntry *entries; ///< Table des matières, triée par nom.
+    uint32_t count;            ///< Entrées.
+} AssetPack;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Projette une archive en mémoire et vérifie sa table.
+ * @return false si le fichier est absent, tronqué ou d'une autre version.
+ */
+bool asset_pack_open(AssetPack *pack, const char *path);
+
+/**
+ * @brief Cherche une ressource par son chemin (recherche dichotomique).
+ *
+ * @param data Reçoit l'adresse du bloc (valide jusqu'à asset_pack_close).
+ * @return L'entrée, ou NULL si l'archive est fermée ou ne la contient pas.
+ */
+const AssetEntry *asset_pack_find(const AssetPack *pack, const char *name, const void **data);
+
+/**
+ * @brief Libère la projection.
+ */
+void asset_pack_close(AssetPack *pack);
+
+/**
+ * @brief Construit une archive à partir des sous-dossiers de `assets/`.
+ *
+ * Les images (.bmp, .png) sont décodées par SDL_image ; les autres fichiers
+ * sont copiés. Les aperçus (`assets/preview/`) ne sont pas repris.
+ *
+ * @param path Archive à écrire (remplacée d'un coup, via un fichier temporaire).
+ * @return Le nombre de ressources écrites, ou -1 en cas d'erreur.
+ */
+int asset_pack_build(const char *path);
+
+#endif // ASSET_PACK_H
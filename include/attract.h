@@ -0,0 +1,112 @@
+/**
+ * @file attract.h
+ * @brief Démo d'accueil : un enregistrement fourni rejoué derrière le menu principal.
+ *
+ * Comme sur une borne d'arcade, le menu principal laissé au repos
+ * ATTRACT_IDLE_S secondes se met à montrer une partie : un enregistrement
+ * du dossier ATTRACT_DIR (replay.h), rejoué sur un modèle à part, au
+ * rythme réel, pendant que le menu reste affiché par-dessus. Le modèle du
+ * joueur n'est jamais touché : la démo n'a ni son, ni sauvegarde, ni
+ * enregistrement.
+ *
+ * Le rejeu ne coûte que ses ticks (quelques microsecondes chacun) : la
+ * simulation est déterministe, l'enregistrement ne porte que les
+ * commandes. Le début de l'enregistrement (menus) passe sans être montré ;
+ * à la fin de la partie rejouée (Game Over, fin du fichier), la démo
+ * enchaîne sur l'enregistrement suivant. Une entrée du joueur, ou la sortie
+ * du menu principal, arrête la démo et relance l'attente.
+ *
+ * Au premier départ, chaque enregistrement du dossier est rejoué une fois
+ * par replay_verify : seuls les valides sont montrés, un fichier sans
+ * empreintes ou d'une simulation antérieure est écarté.
+ *
+ * SPACE_INVADERS_ATTRACT=<secondes> change l'attente (0 : pas de démo),
+ * SPACE_INVADERS_ATTRACT_DIR le dossier des enregistrements.
+ *
+ * @code
+ * Attract attract;
+ * attract_init(&attract, utils_get_time());
+ * ...
+ * attract_wake(&attract, t);                      // À chaque entrée du joueur
+ * const GameModel *demo = attract_frame(&attract, model, utils_get_time());
+ * if (demo)
+ *     draw_world(demo);                           // Puis le menu par-dessus
+ * ...
+ * attract_free(&attract);
+ * @endcode
+ */
+
+#ifndef ATTRACT_H
+#define ATTRACT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+#include "replay.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Démo d'accueil */
+///@{
+#define ATTRACT_IDLE_S 30.0          ///< Repos au menu principal avant la démo (secondes).
+#define ATTRACT_DIR "assets/demos"   ///< Dossier des enregistrements fournis.
+#define ATTRACT_SKIP_FRAMES 100000   ///< Frames enregistrées passées au plus pour atteindre la partie.
+#define ATTRACT_MAX_LAG_S 0.25       ///< Retard au-delà duquel l'horloge de la démo repart de maintenant.
+///@}
+
+/**
+ * @brief Démo d'accueil : attente, liste des enregistrements et rejeu en cours.
+ */
+typedef struct
+{
+    double idle_s;         ///< Repos avant la démo (0 : coupée).
+    const char *dir;       ///< Dossier des enregistrements.
+    char **paths;          ///< Enregistrements trouvés (lus au premier départ).
+    int count;             ///< Nombre d'enregistrements.
+    int next;              ///< Prochain enregistrement à jouer.
+    bool listed;           ///< Dossier déjà parcouru.
+    double idle_since;     ///< Dernière entrée, ou arrivée au menu principal.
+    GameModel *demo;       ///< Modèle de la démo (NULL : pas de démo en cours).
+    ReplayCursor *cursor;  ///< Lecture de l'enregistrement en cours.
+    int hz;                ///< Fréquence de simulation de l'enregistrement.
+    double start;          ///< Instant qui correspond au tick 0 de la partie rejouée.
+    uint64_t ticks;        ///< Ticks rejoués depuis le début de la partie.
+    uint64_t shown;        ///< Démos montrées depuis le lancement.
+} Attract;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lit la configuration (environnement) ; l'attente part de `now`.
+ */
+void attract_init(Attract *a, double now);
+
+/**
+ * @brief Avance la démo jusqu'à `now`, la lance après le repos ou l'arrête hors du menu principal.
+ *
+ * @param model Modèle du joueur (seul son état est lu).
+ * @return Le modèle de la démo à dessiner derrière le menu, ou NULL.
+ */
+const GameModel *attract_frame(Attract *a, const GameModel *model, double now);
+
+/**
+ * @brief Entrée du joueur : arrête la démo et relance l'attente.
+ */
+void attract_wake(Attract *a, double now);
+
+/**
+ * @brief Une démo est en cours.
+ */
+bool attract_active(const Attract *a);
+
+/**
+ * @brief Arrête la démo et libère la liste des enregistrements.
+ */
+void attract_free(Attract *a);
+
+#endif // ATTRACT_H
@@ -0,0 +1,85 @@
+/**
+ * @file autosave.h
+ * @brief Sauvegarde automatique incrémentale (journal + points de reprise).
+ *
+ * Pendant une partie, la progression est écrite dans `sauvegardes/autosave.jnl` :
+ * - un **point de reprise** (sauvegarde complète, cf. save.h) au début de chaque
+ *   niveau et toutes les AUTOSAVE_CHECKPOINT_EVERY entrées ;
+ * - entre deux, toutes les AUTOSAVE_PERIOD secondes, un **delta** de quelques
+ *   dizaines d'octets (score, vies, aliens tués, santé des boucliers) ajouté en
+ *   fin de journal.
+ *
+ * Chaque enregistrement est encadré `[type u8 | taille u32 | CRC32 u32 | données]` :
+ * une écriture interrompue par un crash est simplement ignorée à la reprise.
+ * Toutes les écritures passent par le thread de save_writer.h, sans attente.
+ *
+ * La reprise (menu "Charger", entrée "autosave.jnl") restaure le dernier point
+ * de reprise puis applique les deltas qui le suivent.
+ */
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include <stdbool.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define AUTOSAVE_FILE "autosave.jnl"   ///< Nom du journal dans le dossier des sauvegardes.
+#define AUTOSAVE_PERIOD 5.0            ///< Secondes de jeu entre deux entrées du journal.
+#define AUTOSAVE_CHECKPOINT_EVERY 12   ///< Entrées du journal entre deux points de reprise.
+
+/**
+ * @brief État de l'autosave d'une session (tenu par la boucle de jeu).
+ */
+typedef struct
+{
+    bool enabled;         ///< false : aucune écriture (ex: sessions headless).
+    bool running;         ///< Une partie est en cours et journalisée.
+    bool need_checkpoint; ///< Le prochain enregistrement doit être un point de reprise.
+    int level;            ///< Niveau du dernier point de reprise.
+    int entries;          ///< Entrées écrites depuis le dernier point de reprise.
+    double timer;         ///< Temps de jeu depuis la dernière entrée.
+} Autosave;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise l'état de l'autosave.
+ * @param enabled true pour journaliser les parties.
+ */
+void autosave_init(Autosave *autosave, bool enabled);
+
+/**
+ * @brief À appeler après chaque model_update : écrit les entrées dues.
+ *
+ * Ne bloque jamais : si le thread d'écriture est occupé, l'entrée est
+ * retentée au tick suivant. Le journal est supprimé en fin de partie.
+ *
+ * @param dt Pas de temps simulé (secondes).
+ */
+void autosave_update(Autosave *autosave, const GameModel *model, double dt);
+
+/**
+ * @brief Restaure une partie depuis un journal (point de reprise + deltas).
+ *
+ * @param path Chemin du journal.
+ * @return false (modèle intact) si aucun point de reprise valide n'est trouvé.
+ */
+bool autosave_recover(GameModel *model, const char *path);
+
+/**
+ * @brief Lit les métadonnées du journal (pour le menu "Charger").
+ *
+ * @param path Chemin du journal.
+ * @param entry Reçoit nom, date, niveau et score du dernier état journalisé.
+ * @return false si le journal est absent ou illisible.
+ */
+bool autosave_describe(const char *path, SaveIndexEntry *entry);
+
+#endif // AUTOSAVE_H
@@ -0,0 +1,161 @@
+/**
+ * @file bot.h
+ * @brief Joueur automatique (Bot) pour les tests d'endurance et les bancs.
+ *
+ * Un script rejoué en boucle (headless.h) tire souvent dans le vide et ne
+ * fuit jamais : les chemins de tir, d'impact et de mort restent peu visités.
+ * Le bot lit le Modèle comme le ferait un joueur :
+ * 1. Esquive : parmi rester, aller à gauche ou à droite, il garde le choix
+ *    qu'aucune balle ennemie n'atteindra dans l'horizon d'esquive.
+ * 2. Cible : l'alien le plus bas de chaque colonne (ou l'OVNI), visé à sa
+ *    position au moment où la balle l'atteindra.
+ * 3. Tir : dès que `player.shoot_timer` est écoulé et la cible alignée.
+ *
+ * Les réglages de difficulté (BotConfig) dégradent les trois étapes : délai
+ * de réaction, horizon et marge d'esquive, tolérance de visée, tirs manqués.
+ * Le bot a son propre générateur : il ne touche pas à celui du Modèle, et
+ * une même graine donne la même partie.
+ *
+ * Avec `plan_ticks` > 0 (niveau BOT_LEVEL_PLANNER), la décision passe ensuite
+ * par une **simulation en avant** : pour chacune des BOT_PLAN_ACTIONS touches
+ * possibles, l'état simulé est recopié (model_copy_sim) dans un modèle de
+ * travail, la touche y est tenue BOT_PLAN_HOLD ticks, puis un bot difficile
+ * joue jusqu'à `plan_ticks` ticks (déroulé Monte-Carlo). Le bot garde la
+ * touche au meilleur bilan : points marqués, moins BOT_PLAN_LIFE_COST par
+ * vie perdue. La décision de l'heuristique est évaluée en premier et gagne
+ * les égalités : un planificateur coupé par son budget (`plan_budget_us`
+ * par décision) retombe sur elle. Chaque tick simulé compte pour un nœud
+ * (bot_plan_rate). Le budget en temps rend la décision dépendante de la
+ * machine : une partie n'est rejouable à l'identique par sa graine que sans
+ * coupure (`plan_cutoffs` nul) ; un enregistrement, lui, l'est toujours.
+ *
+ * @code
+ * Bot bot = {0};
+ * BotConfig cfg;
+ * bot_preset(&cfg, BOT_LEVEL_NORMAL);
+ * bot_init(&bot, &cfg, seed);
+ * while (model->sim.state == STATE_PLAYING)
+ * {
+ *     model_handle_input(model, command_held(bot_decide(&bot, model)));
+ *     model_update(model, 1.0 / TARGET_FPS);
+ * }
+ * bot_free(&bot);
+ * @endcode
+ */
+
+#ifndef BOT_H
+#define BOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Niveaux prédéfinis (bot_preset) */
+///@{
+#define BOT_LEVEL_EASY 0   ///< Réagit lentement, esquive tard, manque un tir sur trois.
+#define BOT_LEVEL_NORMAL 1 ///< Joueur moyen.
+#define BOT_LEVEL_HARD 2   ///< Réaction à chaque tick, esquive au plus juste, aucun tir manqué.
+#define BOT_LEVEL_PLANNER 3 ///< Difficile, chaque décision vérifiée par simulation en avant.
+#define BOT_LEVEL_COUNT 4  ///< Nombre de niveaux.
+///@}
+
+/** @name Planificateur (simulation en avant) */
+///@{
+#define BOT_PLAN_ACTIONS 6         ///< Touches candidates : immobile, gauche, droite, chacune avec ou sans tir.
+#define BOT_PLAN_HOLD 8            ///< Ticks pendant lesquels la touche candidate est tenue avant le déroulé.
+#define BOT_PLAN_LIFE_COST 1000    ///< Pénalité d'une vie perdue pendant le déroulé (en points).
+#define BOT_PLAN_CHECK_TICKS 16    ///< Ticks simulés entre deux lectures de l'horloge du budget.
+///@}
+
+/**
+ * @brief Réglages de difficulté.
+ */
+typedef struct
+{
+    int reaction_ticks;  ///< Ticks entre deux décisions (la précédente est maintenue entre-temps).
+    float dodge_horizon; ///< Secondes d'anticipation des balles ennemies (0 : aucune esquive).
+    float dodge_margin;  ///< Marge latérale autour du vaisseau pour juger une balle dangereuse.
+    float aim_slack;     ///< Écart toléré entre le tir et la cible avant de tirer.
+    int miss_percent;    ///< Chance (%) de renoncer à un tir aligné.
+    int plan_ticks;      ///< Ticks simulés par déroulé du planificateur (0 : heuristique seule).
+    int plan_budget_us;  ///< Temps de planification par décision (µs, 0 : sans limite).
+} BotConfig;
+
+/**
+ * @brief État d'un bot (un par partie).
+ *
+ * Sans planificateur, aucune allocation. Avec, le modèle de travail est
+ * alloué à la première décision et gardé d'une partie à l'autre : la
+ * structure doit être mise à zéro avant le premier bot_init, et rendue par
+ * bot_free.
+ */
+typedef struct
+{
+    BotConfig cfg;  ///< Difficulté.
+    uint64_t rng;   ///< Générateur propre (tirs manqués), indépendant du Modèle.
+    int wait;       ///< Ticks restants avant la prochaine décision.
+    unsigned held;  ///< Dernière décision (masque INPUT_*).
+    float target_x; ///< Position visée du vaisseau (dernière décision).
+    GameModel *scratch;      ///< Modèle de travail des déroulés (NULL : pas encore alloué).
+    uint64_t plan_nodes;     ///< Ticks simulés par le planificateur, toutes décisions.
+    uint64_t plan_ns;        ///< Temps passé à planifier.
+    uint32_t plan_decisions; ///< Décisions planifiées.
+    uint32_t plan_cutoffs;   ///< Décisions coupées par le budget avant d'avoir évalué toutes les touches.
+} Bot;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Remplit les réglages d'un niveau prédéfini.
+ * @param level BOT_LEVEL_EASY à BOT_LEVEL_HARD (ramené dans l'intervalle).
+ */
+void bot_preset(BotConfig *cfg, int level);
+
+/**
+ * @brief Prépare un bot (à refaire pour chaque partie ; modèle de travail et compteurs du planificateur gardés).
+ * @param seed Graine de son générateur (même graine, même partie = mêmes décisions).
+ */
+void bot_init(Bot *bot, const BotConfig *cfg, uint64_t seed);
+
+/**
+ * @brief Libère le modèle de travail du planificateur (bot inutilisable ensuite sans bot_init).
+ */
+void bot_free(Bot *bot);
+
+/**
+ * @brief Débit du planificateur : ticks simulés par seconde de planification (0 sans planification).
+ */
+double bot_plan_rate(const Bot *bot);
+
+/**
+ * @brief Choisit les touches à maintenir pour le prochain tick.
+ *
+ * Ne modifie pas le Modèle. Hors de STATE_PLAYING, renvoie 0.
+ *
+ * @return Combinaison de INPUT_LEFT, INPUT_RIGHT et INPUT_FIRE (pour command_held).
+ */
+unsigned bot_decide(Bot *bot, const GameModel *model);
+
+/**
+ * @brief Branche le bot sur une Vue : `out` est une copie de `view` dont get_input
+ * lit d'abord la Vue (fermeture, pause, menus), puis ajoute la décision du bot en jeu.
+ *
+ * Le bot de la Vue est unique (get_input n'a pas de contexte) : un seul branchement par processus.
+ */
+void bot_attach_view(ViewInterface *out, const ViewInterface *view, const BotConfig *cfg, uint64_t seed);
+
+/**
+ * @brief Contrat get_input (view_interface.h) du bot seul, sans Vue : dépose sa décision datée.
+ * Utilise le bot de bot_attach_view (niveau normal s'il n'a pas été branché).
+ */
+void bot_get_input(GameModel *model, CommandQueue *queue);
+
+#endif // BOT_H
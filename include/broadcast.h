@@ -0,0 +1,193 @@
+/**
+ * @file broadcast.h
+ * @brief Diffusion d'une partie aux spectateurs, par un relais qui ne simule rien.
+ *
+ * Plutôt que des images (net.h), la partie diffuse ce qu'un enregistrement
+ * garde (replay.h) : les commandes appliquées et les ticks qui les suivent.
+ * Chaque spectateur simule lui-même la partie à partir de ce flux ; le
+ * serveur de jeu passe donc en virgule fixe (model_set_fixed_point), pour
+ * que toutes les machines obtiennent le même état, au bit près.
+ *
+ * Le flux est découpé en paquets DATA numérotés, un tous les
+ * BROADCAST_SEND_EVERY ticks. Tous les BROADCAST_KEY_EVERY paquets, la
+ * source prend une **image clé** (save_encode_snapshot) : l'état au début
+ * d'un paquet. Un spectateur qui arrive part de la dernière image clé, puis
+ * rejoue les paquets qui la suivent jusqu'au direct.
+ *
+ * Source, relais et spectateurs parlent le même protocole : un relais est
+ * l'abonné de sa source et la source de ses abonnés. Il garde les derniers
+ * paquets et la dernière image clé, et recopie chaque paquet à tous ses
+ * abonnés (un relais peut donc s'abonner à un autre relais).
+ *
+ * Tout passe par UDP. Chaque paquet commence par `"SI" | version u8 | type u8`.
+ *
+ * @code
+ * abonné -> amont  HELLO                                  (abonnement ; réponse : l'image clé courante)
+ *                  NEED   prochain paquet attendu u32 | drapeaux u8 | reçus après lui u64
+ *                                                         (accusé, demande des paquets manquants, présence)
+ *                  BYE                                    (départ)
+ * amont -> abonné  DATA   numéro u32 | tick u32 | n u8 | événements u8 × n
+ *                  KEY    numéro u32 | tick u32 | empreinte u32 | drapeaux u8 | balles u16
+ *                         | taille u32 | position u32 | fragment
+ *                  SYNC   numéro u32 | empreinte u32      (nouvelle image clé, à chaque abonné)
+ * @endcode
+ *
+ * Un événement est une commande (octet < 0x80, appliquée par
+ * model_dispatch_command), BROADCAST_EV_MENU (retour au menu imposé par le
+ * serveur), ou `0x80 | k` : k ticks de model_update. Un abonné n'applique les
+ * paquets que dans l'ordre ; après un trou, il renvoie NEED avec le masque
+ * des paquets suivants déjà reçus, et l'amont répète les autres, au plus
+ * BROADCAST_RESEND_MAX (l'image clé si le paquet demandé est sorti de son
+ * historique). SYNC donne l'empreinte (save_fingerprint)
+ * de l'état au début du paquet `numéro` : un spectateur qui y arrive avec une
+ * autre empreinte repart de l'image clé.
+ *
+ * @code
+ * ./space_invaders server 7777 0 42 7779          # partie jouée sur 7777, diffusée sur 7779
+ * ./space_invaders relay 127.0.0.1 7779 7780      # relais : s'abonne à 7779, sert sur 7780
+ * ./space_invaders watch 192.168.1.20 7780 sdl    # spectateur
+ * @endcode
+ */
+
+#ifndef BROADCAST_H
+#define BROADCAST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Protocole */
+///@{
+#define BROADCAST_DEFAULT_PORT 7779       ///< Port UDP par défaut (source et relais).
+#define BROADCAST_VERSION 1               ///< Version du protocole (paquets d'une autre version ignorés).
+#define BROADCAST_SEND_EVERY 3            ///< Ticks par paquet DATA (20 paquets/s à 60 Hz).
+#define BROADCAST_KEY_EVERY 200           ///< Paquets DATA entre deux images clés (10 s).
+#define BROADCAST_HISTORY 1024            ///< Paquets DATA gardés par la source et chaque relais (51 s).
+#define BROADCAST_RESEND_MAX 64           ///< Paquets répétés au plus par NEED.
+#define BROADCAST_MAX_SUBSCRIBERS 512     ///< Abonnés d'une source ou d'un relais, au plus.
+#define BROADCAST_EVENTS_MAX 200          ///< Octets d'événements par paquet DATA, au plus.
+#define BROADCAST_FRAGMENT 1024           ///< Octets d'image clé par paquet KEY.
+#define BROADCAST_TIMEOUT 5.0             ///< Silence (s) au-delà duquel un abonné ou l'amont est considéré parti.
+///@}
+
+/** @name Événements du flux */
+///@{
+#define BROADCAST_EV_MENU 0x7F  ///< Retour au menu principal imposé par le serveur.
+#define BROADCAST_EV_TICKS 0x80 ///< `BROADCAST_EV_TICKS | k` : k ticks (1 à 127).
+///@}
+
+/**
+ * @brief Nœud de diffusion : la source (serveur de jeu) ou un relais.
+ */
+typedef struct Broadcast Broadcast;
+
+/**
+ * @brief Bilan d'une session (source, relais ou spectateur).
+ */
+typedef struct
+{
+    double elapsed;          ///< Durée (s).
+    long long packets;       ///< Paquets DATA produits (source), relayés (relais) ou appliqués (spectateur).
+    long long keyframes;     ///< Images clés prises (source), reçues (relais, spectateur).
+    long long resent;        ///< Paquets DATA répétés après un NEED.
+    long long keys_sent;     ///< Images clés envoyées à des abonnés.
+    long long bytes_sent;    ///< Octets UDP envoyés, en-têtes IP/UDP exclus.
+    long long bytes_recv;    ///< Octets UDP reçus.
+    long long rejected;      ///< Paquets ignorés (mal formés, hors d'ordre, abonnés en trop).
+    int subscribers;         ///< Abonnés à la fin.
+    int max_subscribers;     ///< Abonnés simultanés au plus.
+    long long ticks;         ///< Ticks simulés (spectateur).
+    long long checks;        ///< Empreintes comparées (spectateur).
+    long long desyncs;       ///< Empreintes différentes (spectateur).
+    double cpu;              ///< Temps processeur (s).
+    uint32_t fingerprint;    ///< Empreinte finale (spectateur).
+} BroadcastStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre la diffusion d'une partie et prend sa première image clé.
+ *
+ * La partie doit être en virgule fixe (sim.fixed_point) pour que les
+ * spectateurs la simulent à l'identique.
+ *
+ * Les fonctions de la source sont sans effet sur une diffusion NULL :
+ * l'appelant n'a pas à tester si elle est ouverte.
+ *
+ * @param port Port UDP d'écoute des abonnés.
+ * @return NULL si le socket n'a pas pu être ouvert.
+ */
+Broadcast *broadcast_open(int port, const GameModel *model);
+
+/**
+ * @brief Ajoute au flux une commande appliquée à la partie.
+ */
+void broadcast_command(Broadcast *b, GameCommand cmd);
+
+/**
+ * @brief Ajoute au flux un retour au menu principal (hors commande).
+ */
+void broadcast_menu(Broadcast *b);
+
+/**
+ * @brief Compte un tick simulé ; tous les BROADCAST_SEND_EVERY ticks, envoie le paquet DATA.
+ *
+ * @param model État après le tick (image clé tous les BROADCAST_KEY_EVERY paquets).
+ */
+void broadcast_tick(Broadcast *b, const GameModel *model);
+
+/**
+ * @brief Traite les demandes des abonnés en attente, sans bloquer.
+ */
+void broadcast_poll(Broadcast *b);
+
+/**
+ * @brief Ferme la diffusion.
+ *
+ * @param out Bilan (peut être NULL).
+ */
+void broadcast_close(Broadcast *b, BroadcastStats *out);
+
+/**
+ * @brief Fait tourner un relais jusqu'à SIGINT ou au bout de `seconds`.
+ *
+ * @param host Source (ou relais) à laquelle s'abonner.
+ * @param upstream_port Son port.
+ * @param port Port UDP d'écoute des abonnés.
+ * @param seconds Durée (0 : jusqu'à SIGINT).
+ * @param out Bilan (peut être NULL).
+ * @return false si l'amont est introuvable ou si le port est indisponible.
+ */
+bool broadcast_run_relay(const char *host, int upstream_port, int port, double seconds, BroadcastStats *out);
+
+/**
+ * @brief Regarde une partie diffusée jusqu'à CMD_EXIT.
+ *
+ * Le spectateur simule le flux avec un tampon de deux paquets (2 ×
+ * BROADCAST_SEND_EVERY ticks) ; un retard plus grand (arrivée, trou comblé)
+ * est rattrapé d'un coup, son coupé.
+ *
+ * @param view Vue déjà initialisée (NULL : sans Vue).
+ * @param seconds Durée (0 : jusqu'à CMD_EXIT ou au silence de l'amont).
+ * @param out Bilan (peut être NULL).
+ * @return false si l'amont est introuvable ou n'a jamais envoyé d'image clé.
+ */
+bool broadcast_run_spectator(const char *host, int port, const ViewInterface *view, double seconds,
+                             BroadcastStats *out);
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ *
+ * @param label Préfixe des lignes ("DIFFUSION", "RELAIS" ou "SPECTATEUR").
+ */
+void broadcast_print_stats(const BroadcastStats *stats, const char *label);
+
+#endif // BROADCAST_H
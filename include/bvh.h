@@ -0,0 +1,126 @@
+/**
+ * @file bvh.h
+ * @brief Hiérarchie de volumes englobants (BVH) : les pièces d'une cible composée, testées en O(log n).
+ *
+ * Une cible faite de dizaines de pièces (le vaisseau amiral des vagues
+ * `boss`) ne se teste pas pièce par pièce : ses boîtes sont rangées dans un
+ * arbre binaire dont chaque nœud englobe ses deux enfants. Une requête ne
+ * descend que dans les nœuds que la boîte cherchée chevauche, si bien
+ * qu'une balle coûte la profondeur de l'arbre (6 niveaux pour 48 pièces),
+ * pas le nombre de pièces.
+ *
+ * L'arbre est construit une fois (coupe médiane sur l'axe le plus long),
+ * puis seulement remis à jour : une pièce détruite ou déplacée change sa
+ * feuille, et bvh_set_leaf refait les boîtes de ses seuls ancêtres, en
+ * s'arrêtant au premier qui ne change pas. Une feuille vide (BVH_EMPTY) ne
+ * chevauche rien, et un sous-arbre entièrement détruit n'est plus visité.
+ * Les boîtes sont relatives à l'origine de la cible : la déplacer d'un bloc
+ * ne touche pas l'arbre, c'est la requête qui est translatée.
+ *
+ * Tout tient dans la structure, avec des index sur un octet (aucune
+ * allocation, copies et instantanés bruts, comme le registre de ecs.h).
+ *
+ * @code
+ * BvhBox parts[n];                                 // Boîtes relatives à l'origine
+ * bvh_build(&bvh, parts, n);
+ * ...
+ * bvh_set_leaf(&bvh, k, BVH_EMPTY);                // La pièce k est détruite
+ * int8_t hits[BVH_MAX_LEAVES];
+ * int m = bvh_query(&bvh, (BvhBox){bx - ox, by - oy, bx - ox + 1, by - oy + 1}, hits, BVH_MAX_LEAVES);
+ * @endcode
+ */
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <float.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Hiérarchie de volumes englobants */
+///@{
+#define BVH_MAX_LEAVES 48                     ///< Feuilles au plus (une par pièce).
+#define BVH_MAX_NODES (2 * BVH_MAX_LEAVES - 1) ///< Nœuds d'un arbre binaire complet (index sur un octet).
+#define BVH_MAX_DEPTH 16                      ///< Pile d'une requête (coupe médiane : 7 niveaux au plus).
+///@}
+
+/**
+ * @brief Boîte par ses coins (min, max), pratique pour les unions.
+ */
+typedef struct
+{
+    float x0, y0; ///< Coin haut-gauche.
+    float x1, y1; ///< Coin bas-droit (exclu).
+} BvhBox;
+
+/** @brief Boîte vide : neutre pour l'union, ne chevauche rien. */
+#define BVH_EMPTY ((BvhBox){FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX})
+
+/**
+ * @brief Nœud de l'arbre : une feuille (une pièce) ou deux enfants côte à côte.
+ */
+typedef struct
+{
+    BvhBox box;    ///< Union des boîtes du sous-arbre.
+    int8_t child;  ///< Premier enfant (le second suit) ; 0 pour une feuille (la racine n'est l'enfant de personne).
+    int8_t leaf;   ///< Pièce d'une feuille (-1 pour un nœud interne).
+    int8_t parent; ///< Parent (-1 pour la racine).
+} BvhNode;
+
+/**
+ * @brief Arbre d'au plus BVH_MAX_LEAVES pièces.
+ */
+typedef struct
+{
+    BvhNode nodes[BVH_MAX_NODES];      ///< Nœuds, la racine en 0.
+    int8_t leaf_node[BVH_MAX_LEAVES];  ///< Feuille de chaque pièce.
+    int8_t count;                      ///< Nœuds utilisés (0 : arbre vide).
+    int8_t leaves;                     ///< Pièces rangées.
+    uint32_t refits;                   ///< Ancêtres refaits par bvh_set_leaf (statistiques).
+} Bvh;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Construit l'arbre de `n` boîtes (coupe médiane sur l'axe le plus long de leurs centres).
+ *
+ * Même entrée, même arbre : la construction ne dépend que des boîtes et de leur ordre.
+ *
+ * @param n Nombre de boîtes, ramené à BVH_MAX_LEAVES.
+ */
+void bvh_build(Bvh *bvh, const BvhBox *boxes, int n);
+
+/**
+ * @brief Change la boîte d'une pièce (BVH_EMPTY : détruite), puis refait ses ancêtres jusqu'au premier inchangé.
+ */
+void bvh_set_leaf(Bvh *bvh, int leaf, BvhBox box);
+
+/**
+ * @brief Boîte de toute la cible (vide si toutes les pièces sont vides).
+ */
+BvhBox bvh_bounds(const Bvh *bvh);
+
+/**
+ * @brief Pièces dont la boîte chevauche `box` (intervalles ouverts, comme les tests AABB du jeu).
+ *
+ * @param out Reçoit les pièces, dans l'ordre de l'arbre.
+ * @param max_out Capacité de `out`.
+ * @return Le nombre de pièces écrites.
+ */
+int bvh_query(const Bvh *bvh, BvhBox box, int8_t *out, int max_out);
+
+/**
+ * @brief Deux boîtes se chevauchent (une boîte vide ne chevauche rien).
+ */
+static inline bool bvh_overlap(BvhBox a, BvhBox b)
+{
+    return a.x0 < b.x1 && a.x1 > b.x0 && a.y0 < b.y1 && a.y1 > b.y0;
+}
+
+#endif // BVH_H
@@ -0,0 +1,104 @@
+/**
+ * @file capture.h
+ * @brief Capture vidéo de la partie : images relues par la Vue SDL, encodées sur un thread dédié.
+ *
+ * Pour enregistrer un match sur la borne même, la Vue SDL (SPACE_INVADERS_CAPTURE)
+ * copie chaque image composée dans un anneau de CAPTURE_STAGING textures
+ * cibles, côté GPU, sans attendre. Une texture n'est relue que lorsque
+ * l'anneau revient sur elle, CAPTURE_STAGING images plus tard, au début
+ * d'une image : le GPU en a fini avec elle depuis longtemps et la relecture
+ * ne l'attend pas. La surface relue est confiée à ce module.
+ *
+ * Un seul thread d'encodage convertit les pixels en YUV 4:2:0 et les écrit
+ * au format YUV4MPEG2 (`.y4m`, lu tel quel par ffmpeg ou mpv ; un tube nommé
+ * le compresse à la volée). La file entre la Vue et ce thread est sans
+ * verrou (spsc.h) : la Vue n'attend jamais. Quand l'encodeur prend du
+ * retard, la file est pleine et la Vue ne relit même plus : l'image est
+ * perdue et comptée (capture_dropped). La vidéo saute alors ces images.
+ *
+ * @code
+ * capture_open("match.y4m", 640, 384, 60);
+ * if (capture_ready())
+ *     capture_submit(SDL_RenderReadPixels(renderer, NULL)); // Surface libérée par le module
+ * else
+ *     ... image perdue (capture_drop) ...
+ * capture_close();
+ * @endcode
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <SDL3/SDL.h>
+
+// ============================================================================
+//                          CONSTANTES
+// ============================================================================
+
+/** @name Capture vidéo */
+///@{
+#define CAPTURE_STAGING 3          ///< Textures cibles de l'anneau GPU (latence de relecture, en images).
+#define CAPTURE_QUEUE 8            ///< Images relues en attente d'encodage au plus (puissance de 2).
+#define CAPTURE_DEFAULT_SCALE 0.5f ///< Taille des images capturées par rapport à la fenêtre logique.
+///@}
+
+/**
+ * @brief Bilan d'une capture.
+ */
+typedef struct
+{
+    uint64_t written; ///< Images écrites.
+    uint64_t dropped; ///< Images perdues (encodeur en retard, ou écriture impossible).
+    double encode_s;  ///< Temps passé à convertir et écrire (thread d'encodage).
+} CaptureStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre le fichier vidéo et démarre le thread d'encodage.
+ *
+ * @param w, h Taille des images (arrondie au pair inférieur pour le 4:2:0).
+ * @param fps Cadence annoncée dans l'en-tête.
+ * @return false si le fichier ou le thread n'ont pas pu être créés.
+ */
+bool capture_open(const char *path, int w, int h, int fps);
+
+/**
+ * @brief Indique si la capture est ouverte et que l'encodeur peut prendre une image de plus.
+ *
+ * Sans attendre : la Vue ne relit une image que si elle sera prise.
+ */
+bool capture_ready(void);
+
+/**
+ * @brief Confie une image relue à l'encodeur, sans attendre.
+ *
+ * La surface appartient ensuite au module, qui la libère, y compris en cas de refus.
+ *
+ * @return false si la capture est fermée, la surface absente ou la file pleine (image comptée perdue).
+ */
+bool capture_submit(SDL_Surface *surface);
+
+/**
+ * @brief Compte une image perdue sans l'avoir relue (capture_ready faux).
+ */
+void capture_drop(void);
+
+/**
+ * @brief Images perdues jusqu'ici.
+ */
+uint64_t capture_dropped(void);
+
+/**
+ * @brief Encode les images en attente, arrête le thread et ferme le fichier.
+ *
+ * @param stats Reçoit le bilan (peut être NULL).
+ */
+void capture_close(CaptureStats *stats);
+
+#endif // CAPTURE_H
@@ -0,0 +1,184 @@
+/**
+ * @file codec.h
+ * @brief Compression LZ par blocs pour les flux enregistrés (rejeux, instantanés),
+ * et deltas d'octets entre deux états.
+ *
+ * Le codec suit le principe de LZ4 : chaque séquence est un jeton (longueur
+ * des littéraux sur 4 bits, longueur de la copie sur 4 bits), les littéraux,
+ * puis une distance u16 vers une copie d'au moins 4 octets déjà décodés. Pas de
+ * codage entropique : la décompression ne fait que des copies, sans table.
+ *
+ * Un flux compressé est découpé en blocs indépendants d'au plus
+ * CODEC_BLOCK_SIZE octets décompressés :
+ *
+ * @code
+ * Bloc : taille décompressée u32 | taille stockée u32 (bit 31 : bloc non compressé) | données
+ * @endcode
+ *
+ * Le lecteur ne garde en mémoire qu'un bloc à la fois, dans un buffer de taille
+ * fixe, quelle que soit la taille du fichier. Un début de bloc est un point de
+ * reprise : on peut y repositionner la lecture sans rien décoder avant.
+ */
+
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define CODEC_BLOCK_SIZE 16384       ///< Taille maximale d'un bloc décompressé (octets).
+#define CODEC_BLOCK_HEADER_SIZE 8    ///< Taille de l'en-tête d'un bloc.
+#define CODEC_BLOCK_STORED 0x80000000u ///< Bit de la taille stockée : bloc gardé tel quel.
+
+/** @brief Taille maximale d'un bloc compressé de `n` octets (pire cas : que des littéraux). */
+#define CODEC_BOUND(n) ((n) + (n) / 255 + 16)
+
+/** @brief Taille maximale d'un delta (codec_diff) entre deux buffers de `n` octets. */
+#define CODEC_DIFF_BOUND(n) (2 * (n) + 16)
+
+/**
+ * @brief Écriture d'un flux, compressé par blocs ou brut.
+ */
+typedef struct
+{
+    FILE *file;                                    ///< Fichier de sortie.
+    bool compress;                                 ///< false : octets écrits tels quels.
+    size_t len;                                    ///< Octets en attente dans le bloc.
+    uint8_t block[CODEC_BLOCK_SIZE];               ///< Bloc en cours (décompressé).
+    uint8_t packed[CODEC_BOUND(CODEC_BLOCK_SIZE)]; ///< Bloc compressé avant écriture.
+} CodecWriter;
+
+/**
+ * @brief Lecture d'un flux, un bloc à la fois.
+ */
+typedef struct
+{
+    FILE *file;                                    ///< Fichier source.
+    bool compressed;                               ///< Flux découpé en blocs compressés.
+    long end;                                      ///< Fin du flux dans le fichier (-1 : fin du fichier).
+    long block_offset;                             ///< Position du bloc courant dans le fichier.
+    long next_offset;                              ///< Position du bloc suivant.
+    size_t len;                                    ///< Octets décodés dans le bloc courant.
+    size_t pos;                                    ///< Octets déjà lus dans le bloc courant.
+    bool error;                                    ///< Bloc tronqué ou invalide rencontré.
+    uint8_t block[CODEC_BLOCK_SIZE];               ///< Bloc courant (décompressé).
+    uint8_t packed[CODEC_BOUND(CODEC_BLOCK_SIZE)]; ///< Bloc compressé lu du disque.
+} CodecReader;
+
+// ============================================================================
+//                          API PUBLIQUE : BLOCS
+// ============================================================================
+
+/**
+ * @brief Compresse un bloc.
+ *
+ * @param src Données (au plus CODEC_BLOCK_SIZE octets).
+ * @param dst Destination (CODEC_BOUND(n) octets suffisent toujours).
+ * @return Taille compressée, ou 0 si `dst` est trop petit.
+ */
+size_t codec_compress(const uint8_t *src, size_t n, uint8_t *dst, size_t cap);
+
+/**
+ * @brief Décompresse un bloc produit par codec_compress.
+ *
+ * Toutes les longueurs et distances sont vérifiées : une entrée corrompue
+ * ne peut ni lire ni écrire hors des buffers.
+ *
+ * @param out Reçoit la taille décompressée.
+ * @return false si les données sont invalides ou dépassent `cap`.
+ */
+bool codec_decompress(const uint8_t *src, size_t n, uint8_t *dst, size_t cap, size_t *out);
+
+// ============================================================================
+//                          API PUBLIQUE : FLUX
+// ============================================================================
+
+/**
+ * @brief Prépare l'écriture d'un flux à la position courante du fichier.
+ * @param compress false pour écrire les octets tels quels (aucun bloc).
+ */
+void codec_writer_init(CodecWriter *w, FILE *file, bool compress);
+
+/** @brief Ajoute des octets au flux. */
+void codec_writer_write(CodecWriter *w, const void *data, size_t n);
+
+/** @brief Ajoute un octet au flux. */
+void codec_writer_putc(CodecWriter *w, uint8_t byte);
+
+/** @brief Termine le bloc en cours et l'écrit. */
+void codec_writer_flush(CodecWriter *w);
+
+/**
+ * @brief Termine le bloc en cours et renvoie la position du prochain octet.
+ *
+ * La position renvoyée est un point de reprise valable pour codec_reader_seek.
+ *
+ * @return Position dans le fichier, ou -1 si elle est inconnue.
+ */
+long codec_writer_mark(CodecWriter *w);
+
+/**
+ * @brief Prépare la lecture d'un flux.
+ *
+ * @param start Position du premier octet du flux dans le fichier.
+ * @param end Position de fin du flux (-1 : jusqu'à la fin du fichier).
+ */
+void codec_reader_init(CodecReader *r, FILE *file, bool compressed, long start, long end);
+
+/**
+ * @brief Lit jusqu'à `n` octets du flux.
+ * @return Le nombre d'octets lus (moins que `n` en fin de flux).
+ */
+size_t codec_reader_read(CodecReader *r, void *dst, size_t n);
+
+/**
+ * @brief Lit un octet du flux.
+ * @return L'octet, ou -1 en fin de flux.
+ */
+int codec_reader_getc(CodecReader *r);
+
+/**
+ * @brief Position du prochain octet, si c'est un point de reprise.
+ * @return Position dans le fichier, ou -1 au milieu d'un bloc compressé.
+ */
+long codec_reader_mark(const CodecReader *r);
+
+/**
+ * @brief Repositionne la lecture sur un point de reprise (cf. codec_writer_mark).
+ * @return false si le fichier ne peut pas être repositionné.
+ */
+bool codec_reader_seek(CodecReader *r, long offset);
+
+// ============================================================================
+//                          API PUBLIQUE : DELTAS
+// ============================================================================
+
+/**
+ * @brief Encode les octets qui diffèrent entre deux buffers de `n` octets.
+ *
+ * Format : suite de `[saut varint | longueur varint | octets]`, chaque saut
+ * étant compté depuis la fin de la plage précédente ; deux plages séparées de
+ * moins de 8 octets identiques sont fusionnées.
+ *
+ * @param buf Destination (CODEC_DIFF_BOUND(n) octets suffisent toujours).
+ * @param len Reçoit la taille du delta (0 si les buffers sont identiques).
+ * @return false si `buf` est trop petit.
+ */
+bool codec_diff(const void *from, const void *to, size_t n, uint8_t *buf, size_t cap, size_t *len);
+
+/**
+ * @brief Applique à `dst` (`n` octets) un delta produit par codec_diff depuis ce même contenu.
+ *
+ * Le delta est d'abord validé en entier : s'il déborde, `dst` reste intact.
+ *
+ * @return false si le delta est invalide.
+ */
+bool codec_apply_diff(void *dst, size_t n, const uint8_t *diff, size_t len);
+
+#endif // CODEC_H
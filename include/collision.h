@@ -0,0 +1,281 @@
+/**
+ * @file collision.h
+ * @brief Structures d'accélération pour la détection de collisions (Broad Phase).
+ *
+ * Tester chaque balle contre chaque ennemi coûte O(balles × ennemis) par tick.
+ * Ce module fournit une grille uniforme posée sur le terrain logique
+ * (GAME_WIDTH × GAME_HEIGHT) : chaque entité est rangée dans les cellules
+ * qu'elle recouvre, et une balle ne teste que les entités de ses propres cellules.
+ *
+ * Le test fin (AABB exact) reste à la charge de l'appelant (Narrow Phase).
+ *
+ * Il fournit aussi les tests AABB "par lots" (une boîte contre N, N contre M)
+ * qui remplacent les copies du test AABB dispersées dans model_update.
+ *
+ * Un second broad phase, par tri et balayage sur X (Sweep and Prune), sert les
+ * scènes où les balles se comptent par milliers et s'agglutinent sous les cibles :
+ * une cellule de la grille y contient alors des centaines de balles, alors que
+ * le balayage ne compare que les intervalles X qui se chevauchent. Les deux
+ * répondent à la même requête (broad_phase_pairs) et se comparent au banc.
+ *
+ * @note Les aliens de la vague classique n'en ont plus besoin : leur grille rigide
+ * permet un calcul direct de la case touchée (voir Formation dans model.h).
+ * La grille reste l'outil générique pour les entités qui se déplacent librement.
+ */
+
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "model.h"
+
+// ============================================================================
+//                          GRILLE UNIFORME
+// ============================================================================
+
+/** @name Dimensions de la Grille
+ * Une cellule de 10×10 unités logiques contient au plus 2 colonnes × 2 rangées
+ * d'aliens (4×3 + 2 d'espacement), ce qui garde les listes de candidats très courtes
+ * tout en limitant le coût de reconstruction (50 cellules seulement).
+ */
+///@{
+#define GRID_CELL_SIZE 10                                               ///< Côté d'une cellule (unités logiques).
+#define GRID_COLS ((GAME_WIDTH + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)  ///< Nombre de colonnes (10).
+#define GRID_ROWS ((GAME_HEIGHT + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE) ///< Nombre de lignes (5).
+#define GRID_CELLS (GRID_COLS * GRID_ROWS)                              ///< Nombre total de cellules.
+#define GRID_MAX_ITEMS (MAX_ENEMIES * 4)                                ///< Un alien recouvre au plus 2×2 cellules.
+///@}
+
+/**
+ * @brief Nombre de requêtes par tick traitées en force brute avant de construire la grille.
+ * Avec une poignée de tirs, parcourir les 60 aliens coûte moins cher que de
+ * reconstruire la grille : celle-ci n'est bâtie qu'au-delà de ce seuil.
+ */
+#define GRID_LAZY_THRESHOLD 4
+
+/**
+ * @brief Grille uniforme au format "compact" (Counting Sort).
+ *
+ * Les indices des entités de la cellule `c` sont stockés dans
+ * `items[cell_start[c] .. cell_start[c + 1] - 1]`. Aucune allocation dynamique :
+ * la grille est reconstruite en deux passes linéaires à chaque tick.
+ */
+typedef struct
+{
+    short cell_start[GRID_CELLS + 1]; ///< Début de chaque cellule dans `items` (+1 sentinelle).
+    short items[GRID_MAX_ITEMS];      ///< Indices des entités, regroupés par cellule.
+    int count;                        ///< Nombre d'entrées utilisées dans `items`.
+} CollisionGrid;
+
+/**
+ * @brief Boîte englobante alignée sur les axes (coin haut-gauche + taille).
+ */
+typedef struct
+{
+    float x; ///< Position X (coin haut-gauche).
+    float y; ///< Position Y (coin haut-gauche).
+    float w; ///< Largeur.
+    float h; ///< Hauteur.
+} AabbBox;
+
+/** @brief Nombre de mots 64 bits d'un masque de n éléments. */
+#define COLLISION_MASK_WORDS(n) (((n) + 63) / 64)
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Vide la grille (aucune entité).
+ */
+void grid_clear(CollisionGrid *grid);
+
+/**
+ * @brief Reconstruit la grille à partir d'un tableau d'entités.
+ *
+ * Seules les entités actives et non explosées sont rangées : ce sont les seules
+ * qu'une balle peut encore toucher.
+ *
+ * @param grid La grille à remplir.
+ * @param entities Le tableau d'entités (ex: model->enemies).
+ * @param n Nombre d'entités dans le tableau.
+ */
+void grid_build(CollisionGrid *grid, const Entity *entities, int n);
+
+/**
+ * @brief Liste les entités candidates recouvrant une boîte donnée.
+ *
+ * Une entité peut apparaître plusieurs fois si elle partage plusieurs cellules
+ * avec la boîte : le résultat est un sur-ensemble, à filtrer par un test AABB exact.
+ *
+ * @param out Tableau recevant les indices candidats.
+ * @param max_out Capacité de `out`.
+ * @return Le nombre d'indices écrits dans `out`.
+ */
+int grid_query(const CollisionGrid *grid, float x, float y, float w, float h, short *out, int max_out);
+
+/**
+ * @brief Teste une boîte contre N boîtes de même taille (SoA), en SIMD.
+ *
+ * @param box La boîte de référence (ex: le joueur, l'OVNI).
+ * @param xs, ys Positions des N boîtes (ex: BulletPool.x / .y).
+ * @param w, h Taille commune des N boîtes.
+ * @param hits Masque de sortie (COLLISION_MASK_WORDS(n) mots), remis à zéro ici.
+ */
+void collision_box_vs_many(const AabbBox *box, const float *xs, const float *ys,
+                           float w, float h, int n, uint64_t *hits);
+
+/**
+ * @brief Teste N boîtes de même taille (SoA) contre M boîtes quelconques.
+ *
+ * La ligne j de `hits` (mots `hits[j * words .. (j + 1) * words - 1]`) reçoit
+ * le masque des N boîtes qui chevauchent `boxes[j]`.
+ *
+ * @param words Nombre de mots par ligne (>= COLLISION_MASK_WORDS(n)).
+ */
+void collision_many_vs_many(const float *xs, const float *ys, float w, float h, int n,
+                            const AabbBox *boxes, int m, uint64_t *hits, int words);
+
+/**
+ * @brief Boîte balayée par une boîte w × h qui vient de se déplacer verticalement de `move`.
+ *
+ * Elle couvre l'ancienne position (y - move), la nouvelle (y) et tout l'entre-deux.
+ */
+AabbBox collision_swept_box(float x, float y, float w, float h, float move);
+
+/**
+ * @brief Variante balayée de collision_many_vs_many (segment contre boîte).
+ *
+ * La boîte i a parcouru `dys[i] * step` verticalement pendant le tick : c'est
+ * sa boîte balayée (collision_swept_box) qui est testée contre les M boîtes,
+ * si bien qu'un déplacement plus grand qu'une cible ne la traverse plus.
+ *
+ * Le test n'est pas vectorisé : seules les boîtes dont le bit est à 1 dans
+ * `active` sont testées, son coût suit les boîtes vivantes et non la taille
+ * du bloc.
+ *
+ * @param dys Vitesses verticales des N boîtes.
+ * @param step Durée du tick (secondes).
+ * @param active Boîtes à tester (COLLISION_MASK_WORDS(n) mots, bits au-delà de n ignorés).
+ */
+void collision_sweep_vs_many(const float *xs, const float *ys, const float *dys, float step, float w, float h,
+                             int n, const uint64_t *active, const AabbBox *boxes, int m, uint64_t *hits, int words);
+
+// ============================================================================
+//                          TRI ET BALAYAGE (SWEEP AND PRUNE)
+// ============================================================================
+
+/**
+ * @brief Broad phase utilisé par broad_phase_pairs.
+ */
+typedef enum
+{
+    BROAD_PHASE_GRID,  ///< Grille uniforme : une requête grid_query par balle.
+    BROAD_PHASE_SWEEP, ///< Balles et cibles triées sur X, balayées en une passe.
+} BroadPhase;
+
+/**
+ * @brief Couple qui se chevauche : une balle, une cible.
+ */
+typedef struct
+{
+    short bullet; ///< Index de la balle (dans les tableaux SoA).
+    short target; ///< Index de la cible (dans le tableau d'entités).
+} CollisionPair;
+
+/**
+ * @brief Balles triées par x croissant, gardées d'un tick à l'autre.
+ *
+ * Les balles se déplacent verticalement : l'ordre sur X d'un tick est encore
+ * celui du suivant, à quelques balles près (réutilisées ailleurs, nouvelles),
+ * et la remise en ordre reste quasi linéaire. Le stockage est fourni par
+ * l'appelant (aucune allocation).
+ */
+typedef struct
+{
+    short *order;     ///< Index des balles par x croissant (`2 * capacity` cases, la moitié haute de travail).
+    uint64_t *member; ///< Masque des index présents dans `order` (COLLISION_MASK_WORDS(capacity) mots).
+    int count;        ///< Balles dans `order`.
+    int capacity;     ///< Index de balle maximal + 1.
+    long moves;       ///< Balles replacées par la dernière mise à jour (0 : l'ordre tenait encore).
+} SweepList;
+
+/**
+ * @brief État d'un broad phase : la grille ou les listes triées, selon `kind`.
+ */
+typedef struct
+{
+    BroadPhase kind;                ///< Méthode utilisée.
+    CollisionGrid grid;             ///< BROAD_PHASE_GRID : cibles rangées par cellule.
+    SweepList bullets;              ///< BROAD_PHASE_SWEEP : balles triées sur X.
+    AabbBox boxes[MAX_ENEMIES];     ///< BROAD_PHASE_SWEEP : cibles touchables, par x croissant.
+    short box_target[MAX_ENEMIES];  ///< Index de l'entité de chaque boîte.
+    int box_count;                  ///< Boîtes utilisées.
+} BroadPhaseState;
+
+/**
+ * @brief Prépare une liste vide.
+ *
+ * @param order Tableau de `2 * capacity` index.
+ * @param member Masque de COLLISION_MASK_WORDS(capacity) mots.
+ */
+void sweep_init(SweepList *list, short *order, uint64_t *member, int capacity);
+
+/**
+ * @brief Met la liste à jour : retire les balles mortes, replace les déplacées, ajoute les nouvelles.
+ *
+ * @param xs Positions X des balles.
+ * @param live Index des balles vivantes (ex: BulletPool.live.items).
+ * @param n_live Nombre de balles vivantes.
+ * @param active Masque des balles vivantes (ex: BulletPool.active).
+ */
+void sweep_update(SweepList *list, const float *xs, const short *live, int n_live, const uint64_t *active);
+
+/**
+ * @brief Apparie des balles de types différents qui se chevauchent (interception), chacune au plus une fois.
+ *
+ * Chaque balle de type `probe` encore libre, dans l'ordre de la liste, prend
+ * la première balle libre d'un autre type qui la chevauche. Le coût suit le
+ * nombre de balles `probe` et de voisines à moins de `w` sur X, pas le carré
+ * du nombre de balles.
+ *
+ * @param list Liste à jour (sweep_update).
+ * @param xs, ys, w, h Balles (SoA, taille commune).
+ * @param type Type de chaque balle (ex: BulletPool.type).
+ * @param probe Type des balles qui cherchent un partenaire (le moins nombreux, ex: ENTITY_BULLET_PLAYER).
+ * @param unpaired Masque des balles disponibles (COLLISION_MASK_WORDS(capacity) mots), les appariées y sont effacées.
+ * @param out Couples trouvés (`bullet` : la balle `probe`, `target` : l'autre).
+ * @param max_out Capacité de `out`.
+ * @return Le nombre de couples écrits dans `out`.
+ */
+int sweep_cross_pairs(const SweepList *list, const float *xs, const float *ys, float w, float h,
+                      const EntityType *type, EntityType probe, uint64_t *unpaired, CollisionPair *out, int max_out);
+
+/**
+ * @brief Prépare un broad phase.
+ *
+ * @param order, member, capacity Stockage de la liste triée (cf. sweep_init), inutilisé par la grille.
+ */
+void broad_phase_init(BroadPhaseState *bp, BroadPhase kind, short *order, uint64_t *member, int capacity);
+
+/**
+ * @brief Liste les couples balle / cible qui se chevauchent (AABB exact), chacun une fois.
+ *
+ * Seules les cibles actives et non explosées comptent (comme grid_build), au
+ * plus MAX_ENEMIES. L'ordre des couples dépend de la méthode.
+ *
+ * @param xs, ys, w, h Balles (SoA, taille commune).
+ * @param live, n_live, active Balles vivantes (cf. sweep_update).
+ * @param targets, n_targets Cibles.
+ * @param out Couples trouvés.
+ * @param max_out Capacité de `out`.
+ * @return Le nombre de couples écrits dans `out`.
+ */
+int broad_phase_pairs(BroadPhaseState *bp, const float *xs, const float *ys, float w, float h,
+                      const short *live, int n_live, const uint64_t *active,
+                      const Entity *targets, int n_targets, CollisionPair *out, int max_out);
+
+#endif // COLLISION_H
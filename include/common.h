@@ -36,9 +36,9 @@
 // ============================================================================
 
 /**
- * @name Tableaux Statiques
- * Tailles maximales pour éviter les allocations dynamiques (malloc)
- * durant la boucle de jeu principale.
+ * @name Capacités des Pools
+ * Tailles fixées à model_init (arène du modèle) pour éviter les allocations
+ * dynamiques (malloc) durant la boucle de jeu principale.
  */
 ///@{
 
@@ -47,8 +47,8 @@
  */
 #define MAX_ENEMIES 60
 
-/** * @brief Nombre maximum de projectiles à l'écran.
- * Cumule les tirs du joueur et ceux des ennemis.
+/** * @brief Nombre de projectiles à l'écran par défaut.
+ * Cumule les tirs du joueur et ceux des ennemis (`--bullets=N` pour changer).
  */
 #define MAX_BULLETS 100
 
@@ -72,6 +72,21 @@
  */
 #define FRAME_DELAY (1000 / TARGET_FPS)
 
+/** @brief Attente maximale d'une entrée au repos (s) : au-delà, une image est redessinée.
+ * Égale au plafond du temps rattrapé par frame : aucun tick de menu n'est perdu.
+ */
+#define IDLE_WAIT_S 0.25
+
+/** @brief Images sans entrée avant le passage au repos (le temps que l'effet d'une touche s'affiche). */
+#define IDLE_GRACE_FRAMES 8
+
+/** @brief Échelle de temps normale, en millièmes (`--time-scale`, SPACE_INVADERS_TIME_SCALE). */
+#define TIME_SCALE_NORMAL 1000
+
+/** @brief Échelles de temps permises, en millièmes : ralenti au vingtième, accéléré seize fois. */
+#define TIME_SCALE_MIN 50
+#define TIME_SCALE_MAX 16000
+
 ///@}
 
 #endif // COMMON_H
\ No newline at end of file
@@ -12,6 +12,8 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
 
+#include <stdbool.h>
+
 // ============================================================================
 //                          SIGNAUX DU CONTRÔLEUR
 // ============================================================================
@@ -48,6 +50,165 @@ typedef enum
     CMD_BACKSPACE, ///< Effacer un caractère (Correction lors de la sauvegarde).
     ///@}
 
+    /** @name État maintenu (partie) */
+    ///@{
+    CMD_HELD = 0x40,                 ///< Base : `CMD_HELD | INPUT_*` donne les touches de jeu maintenues.
+    CMD_HELD_LAST = CMD_HELD | 0x07, ///< Toutes les touches maintenues (dernière valeur de la plage).
+    CMD_HELD_P2 = 0x48,                    ///< Base des touches maintenues du second joueur (coopération).
+    CMD_HELD_P2_LAST = CMD_HELD_P2 | 0x07, ///< Dernière valeur de la plage du second joueur.
+    ///@}
+
 } GameCommand;
 
+/** @name Touches de jeu maintenues (masque de CMD_HELD) */
+///@{
+#define INPUT_LEFT 0x01  ///< Déplacement à gauche.
+#define INPUT_RIGHT 0x02 ///< Déplacement à droite.
+#define INPUT_FIRE 0x04  ///< Tir.
+#define INPUT_MASK 0x07  ///< Tous les bits.
+///@}
+
+/**
+ * @brief Construit la commande d'un état maintenu.
+ *
+ * Une seule commande exprime plusieurs touches à la fois (se déplacer en
+ * tirant) : le Modèle l'applique en entier au même tick.
+ *
+ * @param bits Combinaison de INPUT_LEFT, INPUT_RIGHT et INPUT_FIRE.
+ */
+GameCommand command_held(unsigned bits);
+
+/**
+ * @brief Indique si une commande est un état maintenu.
+ * @param bits Reçoit le masque INPUT_* (peut être NULL).
+ */
+bool command_is_held(GameCommand cmd, unsigned *bits);
+
+/**
+ * @brief Construit la commande d'un état maintenu du second joueur (coopération).
+ */
+GameCommand command_held_p2(unsigned bits);
+
+/**
+ * @brief Indique si une commande est un état maintenu du second joueur.
+ * @param bits Reçoit le masque INPUT_* (peut être NULL).
+ */
+bool command_is_held_p2(GameCommand cmd, unsigned *bits);
+
+// ============================================================================
+//                          MANETTE
+// ============================================================================
+
+/** @name Manette */
+///@{
+#define PAD_AXIS_MAX 32767     ///< Amplitude d'un axe analogique.
+#define PAD_DEADZONE 8000      ///< Zone morte par défaut du stick (sur PAD_AXIS_MAX, environ 25 %).
+#define PAD_DEADZONE_RELEASE 2 ///< Diviseur du seuil de relâche (hystérésis : pas de va-et-vient au bord).
+#define PAD_RUMBLE_MS 180      ///< Durée de la vibration quand le vaisseau est touché.
+#define PAD_PLAYERS 2          ///< Manettes ouvertes à la fois (une par vaisseau, coopération locale).
+///@}
+
+/**
+ * @brief État d'une manette, mis à jour événement par événement.
+ *
+ * La Vue ne lit jamais l'état de la manette une fois par image : elle
+ * passe chaque événement (bouton, axe) à pad_button ou pad_axis, qui
+ * disent si les touches de jeu maintenues (INPUT_*) ont changé. La Vue
+ * dépose alors command_held à l'instant de l'événement : un appui entre
+ * deux images atteint le tick qui le couvre, comme au clavier.
+ *
+ * Le stick horizontal passe par une zone morte avec hystérésis : il
+ * s'enclenche au-delà de `deadzone` et ne se relâche qu'en deçà de
+ * `deadzone / PAD_DEADZONE_RELEASE`.
+ */
+typedef struct
+{
+    int deadzone;     ///< Zone morte du stick (0 à PAD_AXIS_MAX).
+    unsigned buttons; ///< INPUT_* tenus par les boutons (croix, A).
+    unsigned stick;   ///< INPUT_LEFT ou INPUT_RIGHT tenu par le stick (0 : au centre).
+    int lives;        ///< Vies vues au dernier pad_hit (-1 : pas encore vues).
+} PadState;
+
+/**
+ * @brief Prépare une manette au repos.
+ * @param deadzone Zone morte du stick (hors bornes : PAD_DEADZONE).
+ */
+void pad_init(PadState *pad, int deadzone);
+
+/**
+ * @brief Applique un appui ou un relâchement d'un bouton de jeu.
+ * @param bit INPUT_LEFT, INPUT_RIGHT ou INPUT_FIRE.
+ * @return true si les touches maintenues ont changé.
+ */
+bool pad_button(PadState *pad, unsigned bit, bool down);
+
+/**
+ * @brief Applique une nouvelle valeur du stick horizontal.
+ * @param value Position, de -PAD_AXIS_MAX-1 (gauche) à PAD_AXIS_MAX (droite).
+ * @return true si les touches maintenues ont changé.
+ */
+bool pad_axis(PadState *pad, int value);
+
+/**
+ * @brief Touches de jeu maintenues par la manette (masque INPUT_*).
+ */
+unsigned pad_held(const PadState *pad);
+
+/**
+ * @brief Indique si le vaisseau vient d'être touché (vies en baisse depuis l'appel précédent).
+ *
+ * La Vue y répond par une vibration de PAD_RUMBLE_MS.
+ */
+bool pad_hit(PadState *pad, int lives);
+
+// ============================================================================
+//                          FILE DES COMMANDES
+// ============================================================================
+
+#define COMMAND_QUEUE_SIZE 64 ///< Commandes en attente au plus entre deux lectures.
+
+/**
+ * @brief Commande datée (instant de l'appui, horloge de utils_get_time).
+ */
+typedef struct
+{
+    GameCommand cmd; ///< Commande lue par la Vue.
+    double time;     ///< Instant de l'événement d'origine (secondes).
+} TimedCommand;
+
+/**
+ * @brief File circulaire bornée des commandes lues par la Vue.
+ *
+ * La Vue y dépose tous les événements d'une lecture, dans l'ordre ; la boucle
+ * de jeu les applique au tick qui couvre leur instant. Pleine, la file
+ * abandonne les nouvelles commandes (compteur `dropped`).
+ */
+typedef struct
+{
+    TimedCommand items[COMMAND_QUEUE_SIZE]; ///< Commandes en attente.
+    int head;                               ///< Indice de la plus ancienne.
+    int count;                              ///< Nombre de commandes en attente.
+    unsigned dropped;                       ///< Commandes perdues (file pleine).
+} CommandQueue;
+
+/**
+ * @brief Vide la file (et son compteur de pertes).
+ */
+void command_queue_clear(CommandQueue *q);
+
+/**
+ * @brief Ajoute une commande en fin de file.
+ * @return false si la file est pleine (commande abandonnée).
+ */
+bool command_queue_push(CommandQueue *q, GameCommand cmd, double time);
+
+/**
+ * @brief Retire la plus ancienne commande si elle date d'avant `until`.
+ *
+ * @param until Instant limite (inclus) ; une valeur infinie vide la file.
+ * @param cmd Reçoit la commande retirée.
+ * @return false si la file est vide ou sa tête plus récente que `until`.
+ */
+bool command_queue_pop(CommandQueue *q, double until, GameCommand *cmd);
+
 #endif // CONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file coop.h
+ * @brief Coopération à deux en réseau, par prédiction et retour en arrière (rollback.h).
+ *
+ * Contrairement au mode serveur (net.h), rien ne fait autorité : chaque
+ * machine simule la même partie en virgule fixe (model_set_fixed_point), avec
+ * la même graine, et seules les touches (3 bits par tick) transitent. Une
+ * entrée locale est appliquée COOP_INPUT_DELAY ticks plus tard ; celle de
+ * l'autre joueur est prédite jusqu'à son arrivée, et une erreur de prédiction
+ * se corrige par une resimulation des ticks concernés, dans la même image.
+ *
+ * Tout passe par UDP. Chaque paquet commence par `"SI" | version u8 | type u8`.
+ *
+ * @code
+ * JOIN   (invité -> hôte, répété jusqu'à START)
+ * START  graine u64                                           (hôte -> invité, en réponse à chaque JOIN)
+ * INPUT  1er tick u32 | n u8 | touches u8 × n | entrées reçues u32 | tick u32 | avance i16
+ *        | tick vérifié u32 | empreinte u64                    (dans les deux sens, à chaque image)
+ * BYE                                                         (départ)
+ * @endcode
+ *
+ * Chaque INPUT répète toutes les entrées que l'autre n'a pas accusées. Les
+ * deux machines comparent leur empreinte (statehash_model) d'un état définitif
+ * tous les COOP_CHECK_EVERY ticks : une différence signale une désynchronisation.
+ * Celle qui a de l'avance saute de temps en temps un tick pour attendre l'autre.
+ *
+ * @code
+ * ./space_invaders coop host 7778 sdl
+ * ./space_invaders coop join 192.168.1.20 7778 sdl
+ * @endcode
+ */
+
+#ifndef COOP_H
+#define COOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Réglages */
+///@{
+#define COOP_DEFAULT_PORT 7778 ///< Port UDP par défaut.
+#define COOP_VERSION 2         ///< Version du protocole.
+#define COOP_INPUT_DELAY 2     ///< Ticks entre une entrée locale et son application.
+#define COOP_CHECK_EVERY 15    ///< Ticks entre deux comparaisons d'empreinte.
+#define COOP_TIMEOUT 5.0       ///< Silence (s) au-delà duquel l'autre joueur est considéré parti.
+///@}
+
+/**
+ * @brief Paramètres d'une session.
+ */
+typedef struct
+{
+    const char *host;          ///< Hôte à rejoindre (NULL : on héberge).
+    int port;                  ///< Port UDP (écoute ou destination).
+    uint64_t seed;             ///< Graine de la partie (hôte ; l'invité reçoit la sienne).
+    const ViewInterface *view; ///< Vue déjà initialisée (NULL : sans Vue, entrées de `script`).
+    const char *script;        ///< Script du joueur sans Vue (NULL : HEADLESS_DEFAULT_SCRIPT).
+    double seconds;            ///< Durée (0 : jusqu'au Game Over, à CMD_EXIT ou au départ de l'autre).
+    double lag;                ///< Latence simulée de chaque paquet envoyé (s), pour les essais.
+} CoopConfig;
+
+/**
+ * @brief Bilan d'une session.
+ */
+typedef struct
+{
+    double elapsed;        ///< Durée (s).
+    long long ticks;       ///< Ticks simulés (hors resimulation).
+    long long rollbacks;   ///< Retours en arrière.
+    long long resimulated; ///< Ticks resimulés.
+    int max_depth;         ///< Plus long retour en arrière (ticks).
+    long long stalls;      ///< Images sans tick : attente de l'autre joueur (fenêtre pleine ou avance).
+    long long checks;      ///< Empreintes comparées.
+    long long desyncs;     ///< Empreintes différentes.
+    long long bytes_sent;  ///< Octets UDP envoyés.
+    long long bytes_recv;  ///< Octets UDP reçus.
+    int score;             ///< Score au dernier état définitif.
+    int level;             ///< Niveau au dernier état définitif.
+    uint32_t fingerprint;  ///< Empreinte du dernier état définitif.
+    uint32_t final_tick;   ///< Tick de cet état.
+} CoopStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Héberge ou rejoint une partie, et la joue jusqu'à sa fin.
+ *
+ * @param out Bilan (peut être NULL).
+ * @return false si le socket n'a pas pu être ouvert ou si l'autre joueur n'est jamais venu.
+ */
+bool coop_run(const CoopConfig *cfg, CoopStats *out);
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ */
+void coop_print_stats(const CoopStats *stats);
+
+#endif // COOP_H
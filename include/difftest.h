@@ -0,0 +1,108 @@
+/**
+ * @file difftest.h
+ * @brief Test différentiel : model_update contre model_update_reference, tick par tick.
+ *
+ * Chaque optimisation de la section F de model_update (chemins spécialisés,
+ * noyaux SIMD, masques de collisions, tests répartis sur les workers,
+ * recherche de l'alien touché par sa case, BVH du vaisseau amiral, caches
+ * de la vague tenus à jour impact par impact) doit laisser la partie
+ * inchangée, bit à bit. Ce mode fait avancer deux modèles
+ * de la même graine avec les mêmes entrées, l'un par le chemin optimisé,
+ * l'autre par le chemin de référence, et compare leurs empreintes d'état
+ * (statehash_model) à chaque tick. À la première différence, il s'arrête
+ * et liste les champs qui diffèrent (au plus DIFFTEST_MAX_FIELDS lignes) :
+ * `bullets[37].y`, `formation.alive_mask`...
+ *
+ * Les entrées viennent du script de headless.h ou du bot (`--bot=N`), décidé
+ * sur le modèle optimisé et envoyé aux deux. Les options qui changent le
+ * modèle (`--bullets=N`, `--fixed`, `--swept`, `--endless`, vagues de
+ * SPACE_INVADERS_WAVES...) s'appliquent aux deux : un essaim de balles met
+ * à l'épreuve les chemins parallèles.
+ *
+ * @code
+ * ./space_invaders difftest 36000 0x1234 --bot=2 --bullets=1024
+ * @endcode
+ */
+
+#ifndef DIFFTEST_H
+#define DIFFTEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bot.h"
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Test différentiel */
+///@{
+#define DIFFTEST_DEFAULT_TICKS (TARGET_FPS * 60 * 10) ///< 10 minutes de jeu.
+#define DIFFTEST_MAX_FIELDS 32                        ///< Champs différents listés au plus.
+///@}
+
+/**
+ * @brief Paramètres d'une session.
+ */
+typedef struct
+{
+    long max_ticks;       ///< Ticks simulés au plus.
+    uint64_t seed;        ///< Graine des deux modèles.
+    const char *script;   ///< Entrées scriptées (cf. HEADLESS_DEFAULT_SCRIPT), si pas de bot.
+    const BotConfig *bot; ///< Joueur automatique (NULL : script).
+} DiffTestConfig;
+
+/**
+ * @brief Bilan d'une session.
+ */
+typedef struct
+{
+    long ticks;          ///< Ticks comparés.
+    long diverged_tick;  ///< Premier tick divergent (-1 : aucun).
+    uint64_t hash_ref;   ///< Empreinte du modèle de référence au dernier tick comparé.
+    uint64_t hash_opt;   ///< Empreinte du modèle optimisé au dernier tick comparé.
+    int fields;          ///< Champs différents au tick divergent.
+    int games;           ///< Parties lancées (relances après Game Over).
+    double ref_seconds;  ///< Temps passé dans model_update_reference.
+    double opt_seconds;  ///< Temps passé dans model_update.
+} DiffTestResult;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Configuration par défaut (DIFFTEST_DEFAULT_TICKS, graine et script de headless.h, sans bot).
+ */
+void difftest_default_config(DiffTestConfig *cfg);
+
+/**
+ * @brief Fait avancer les deux chemins en parallèle et s'arrête à la première divergence.
+ *
+ * Les champs divergents sont alors listés sur la sortie standard (difftest_diff).
+ *
+ * @return false si un modèle n'a pas pu être créé.
+ */
+bool difftest_run(const DiffTestConfig *cfg, DiffTestResult *out);
+
+/**
+ * @brief Liste les champs simulés qui diffèrent entre deux modèles ("nom : ref != opt").
+ *
+ * Les flottants sont comparés bit à bit. Les balles ne sont comparées que
+ * sur les slots occupés dans l'un des deux modèles.
+ *
+ * @param out Sortie des lignes (NULL : compte seulement).
+ * @param max_lines Lignes écrites au plus (les suivantes sont comptées).
+ * @return Nombre de champs différents.
+ */
+int difftest_diff(const GameModel *ref, const GameModel *opt, FILE *out, int max_lines);
+
+/**
+ * @brief Affiche le bilan sur la sortie standard.
+ */
+void difftest_print(const DiffTestResult *r);
+
+#endif // DIFFTEST_H
@@ -0,0 +1,178 @@
+/**
+ * @file ecs.h
+ * @brief Registre de composants : entités par identifiant, composants en tableaux denses.
+ *
+ * Les acteurs historiques (vaisseaux, vague, balles, OVNI, boucliers) ont
+ * chacun leur structure et leurs boucles. Un nouveau genre d'entité (bonus,
+ * ennemi isolé...) vit plutôt ici : une entité n'est qu'un identifiant, et
+ * chaque composant (position, vitesse, type, durée de vie) un jeu de tableaux
+ * denses, sans trou, de ses seules entités. Un système parcourt le plus petit
+ * des ensembles qu'il demande : son coût suit le nombre d'entités concernées,
+ * pas la capacité du registre.
+ *
+ * Chaque ensemble est un "sparse set" : `dense` liste les entités qui ont le
+ * composant, dans l'ordre de ses tableaux, et `sparse` donne la place de
+ * chaque entité dans `dense` (-1 : absente). Ajout et retrait sont en O(1),
+ * le retrait déplaçant la dernière case dans le trou.
+ *
+ * Les identifiants sont repris par une pile de libres, comme les slots des
+ * balles ; leur génération change à chaque destruction, si bien qu'un
+ * identifiant gardé après la mort de son entité ne désigne jamais la
+ * suivante. La capacité est fixe : tous les tableaux tiennent dans la
+ * structure (aucune allocation ni câblage, copies et instantanés bruts), avec
+ * des index sur un octet pour que chaque instantané du rollback reste petit.
+ *
+ * @code
+ * EcsEntity id = ecs_create(w);
+ * int p = ecs_add(w, id, ECS_POSITION);
+ * w->x[p] = 10.0f;
+ * w->y[p] = 20.0f;
+ * w->dy[ecs_add(w, id, ECS_VELOCITY)] = 30.0f;
+ *
+ * short ids[ECS_MAX_ENTITIES];
+ * int n = ecs_query(w, ECS_BIT(ECS_POSITION) | ECS_BIT(ECS_VELOCITY), ids);
+ * for (int k = 0; k < n; k++)
+ *     w->y[ecs_slot(w, ids[k], ECS_POSITION)] += w->dy[ecs_slot(w, ids[k], ECS_VELOCITY)] * dt;
+ * @endcode
+ */
+
+#ifndef ECS_H
+#define ECS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Registre de composants */
+///@{
+#define ECS_MAX_ENTITIES 32  ///< Entités simultanées au plus, par modèle (index sur 7 bits : 127 au plus).
+#define ECS_NONE 0           ///< Identifiant nul (aucune génération valide ne vaut 0).
+#define ECS_ALIVE (1u << 31) ///< Bit du masque d'une entité vivante (une entité nue n'a que lui).
+///@}
+
+/**
+ * @brief Composants connus du registre (un ensemble dense par composant).
+ */
+typedef enum
+{
+    ECS_POSITION, ///< Coin haut-gauche (x, y), unités logiques.
+    ECS_VELOCITY, ///< Vitesse (dx, dy), unités par seconde.
+    ECS_KIND,     ///< Type d'entité (EntityType) : hitbox, points, couleur (entity_type.h).
+    ECS_LIFETIME, ///< Secondes à vivre ; l'entité est détruite à 0.
+    ECS_COMPONENT_COUNT
+} EcsComponent;
+
+/** @brief Bit d'un composant dans un masque. */
+#define ECS_BIT(c) (1u << (c))
+
+/** @brief Masque de composants (un bit par EcsComponent). */
+typedef uint32_t EcsMask;
+
+/**
+ * @brief Identifiant d'entité : index (8 bits de poids faible) et génération (8 bits de poids fort).
+ */
+typedef uint16_t EcsEntity;
+
+/**
+ * @brief Ensemble dense d'un composant.
+ */
+typedef struct
+{
+    int8_t dense[ECS_MAX_ENTITIES];  ///< Index des entités qui ont le composant, [0, count).
+    int8_t sparse[ECS_MAX_ENTITIES]; ///< Place de chaque index dans dense (-1 : absent).
+    int count;                       ///< Entités de l'ensemble.
+} EcsSet;
+
+/**
+ * @brief Le registre : entités, ensembles et données des composants.
+ *
+ * Les tableaux de données sont rangés comme le `dense` de leur composant :
+ * `x[p]` est la position de l'entité `sets[ECS_POSITION].dense[p]`.
+ */
+typedef struct
+{
+    EcsMask mask[ECS_MAX_ENTITIES];       ///< Composants de chaque index, plus ECS_ALIVE (0 : index libre).
+    uint8_t generation[ECS_MAX_ENTITIES]; ///< Génération de chaque index (jamais 0 après ecs_clear).
+    int8_t free_ids[ECS_MAX_ENTITIES];    ///< Pile des index libres.
+    int free_count;                       ///< Hauteur de la pile.
+    int alive;                            ///< Entités vivantes.
+    int dropped;                          ///< Créations refusées, registre plein.
+    EcsSet sets[ECS_COMPONENT_COUNT];     ///< Un ensemble par composant.
+
+    float x[ECS_MAX_ENTITIES], y[ECS_MAX_ENTITIES];   ///< ECS_POSITION.
+    float dx[ECS_MAX_ENTITIES], dy[ECS_MAX_ENTITIES]; ///< ECS_VELOCITY.
+    uint8_t kind[ECS_MAX_ENTITIES];                   ///< ECS_KIND (EntityType).
+    float lifetime[ECS_MAX_ENTITIES];                 ///< ECS_LIFETIME.
+} EcsWorld;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Vide le registre : plus aucune entité, pile des libres pleine (générations gardées).
+ */
+void ecs_clear(EcsWorld *w);
+
+/**
+ * @brief Crée une entité sans composant.
+ *
+ * @return Son identifiant, ou ECS_NONE si le registre est plein (compté dans `dropped`).
+ */
+EcsEntity ecs_create(EcsWorld *w);
+
+/**
+ * @brief Détruit une entité et retire tous ses composants (sans effet si elle est déjà morte).
+ */
+void ecs_destroy(EcsWorld *w, EcsEntity e);
+
+/**
+ * @brief Vrai si l'identifiant désigne une entité vivante.
+ */
+bool ecs_alive(const EcsWorld *w, EcsEntity e);
+
+/**
+ * @brief Identifiant courant de l'index `i` (celui d'une entité vivante, pour ecs_query).
+ */
+EcsEntity ecs_entity(const EcsWorld *w, int i);
+
+/**
+ * @brief Ajoute un composant à une entité, données à zéro.
+ *
+ * @return Sa place dans les tableaux du composant (la place existante s'il y
+ *         était déjà), ou -1 si l'entité est morte.
+ */
+int ecs_add(EcsWorld *w, EcsEntity e, EcsComponent c);
+
+/**
+ * @brief Retire un composant d'une entité (la dernière place de l'ensemble comble le trou).
+ */
+void ecs_remove(EcsWorld *w, EcsEntity e, EcsComponent c);
+
+/**
+ * @brief Place d'un composant d'une entité, ou -1 (entité morte ou sans ce composant).
+ */
+int ecs_get(const EcsWorld *w, EcsEntity e, EcsComponent c);
+
+/**
+ * @brief Place d'un composant de l'index `i`, sans contrôle de génération (-1 : absent).
+ */
+static inline int ecs_slot(const EcsWorld *w, int i, EcsComponent c)
+{
+    return w->sets[c].sparse[i];
+}
+
+/**
+ * @brief Index des entités qui ont tous les composants de `mask`.
+ *
+ * Parcourt le plus petit des ensembles demandés, dans l'ordre de son `dense`.
+ *
+ * @param out ECS_MAX_ENTITIES cases au moins.
+ * @return Nombre d'index écrits (toutes les entités vivantes si `mask` vaut 0).
+ */
+int ecs_query(const EcsWorld *w, EcsMask mask, short *out);
+
+#endif // ECS_H
@@ -0,0 +1,96 @@
+/**
+ * @file entity_pack.h
+ * @brief Format compact des entités (6 octets) pour les instantanés et les paquets réseau.
+ *
+ * Une Entity fait 52 octets : largeur et hauteur en `int` (constantes pour un
+ * type donné), trois drapeaux en `bool`, le type en `int`, vitesses et timers.
+ * Pour transmettre ou archiver ce qui est à l'écran, seuls comptent la
+ * position, le type et quelques drapeaux :
+ *
+ * @code
+ * PackedEntity (6 octets) : x i16 Q10.6 | y i16 Q10.6 | type u8 | drapeaux u8
+ * @endcode
+ *
+ * Les coordonnées sont en virgule fixe Q10.6 (1/64 d'unité logique, de -512 à
+ * 511) : largement assez pour le terrain de 100 × 50. Largeur et hauteur se
+ * déduisent du type (entity_type_width, entity_type_height, cf. entity_type.h). La simulation,
+ * elle, reste en flottants : le format ne sert qu'à l'export.
+ */
+
+#ifndef ENTITY_PACK_H
+#define ENTITY_PACK_H
+
+#include <stdint.h>
+
+#include "entity_type.h"
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Virgule fixe Q10.6 */
+///@{
+#define PACK_FRAC_BITS 6                       ///< Bits de la partie fractionnaire.
+#define PACK_SCALE (1 << PACK_FRAC_BITS)       ///< Unités Q10.6 par unité logique (64).
+///@}
+
+/** @name Drapeaux d'une entité compacte */
+///@{
+#define PACK_FLAG_ACTIVE 0x01    ///< Entité présente.
+#define PACK_FLAG_EXPLODING 0x02 ///< Animation d'explosion en cours.
+#define PACK_FLAG_FRAME 0x0C     ///< Sprite d'animation (0 à 3), sur deux bits.
+#define PACK_FRAME_SHIFT 2       ///< Décalage du sprite dans les drapeaux.
+///@}
+
+/**
+ * @brief Entité compacte : position Q10.6, type et drapeaux.
+ */
+typedef struct
+{
+    int16_t x;     ///< Position X (coin haut-gauche), Q10.6.
+    int16_t y;     ///< Position Y (coin haut-gauche), Q10.6.
+    uint8_t type;  ///< EntityType.
+    uint8_t flags; ///< Combinaison de PACK_FLAG_*.
+} PackedEntity;
+
+/** @brief Entités d'une image au plus : joueur, vague, balles (capacité du pool), OVNI. */
+#define PACK_FRAME_MAX(bullets) (1 + FORMATION_SIZE + (bullets) + 1)
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Coordonnée logique vers Q10.6 (arrondie au 1/64 le plus proche, bornée à int16).
+ */
+int16_t entity_pack_coord(float v);
+
+/**
+ * @brief Coordonnée Q10.6 vers coordonnée logique (exacte).
+ */
+float entity_unpack_coord(int16_t v);
+
+/**
+ * @brief Compacte une entité (position arrondie au 1/64 le plus proche).
+ */
+void entity_pack(const Entity *e, PackedEntity *out);
+
+/**
+ * @brief Reconstitue une entité : position, type, dimensions du type, drapeaux ;
+ * vitesses et timers à zéro.
+ */
+void entity_unpack(const PackedEntity *p, Entity *out);
+
+/**
+ * @brief Compacte tout ce qui est à l'écran : joueur, aliens (vivants ou en
+ * explosion), balles dans l'ordre de la liste active, puis OVNI.
+ *
+ * Lit directement les pools SoA, sans passer par des Entity.
+ *
+ * @param cap Capacité de `out` (PACK_FRAME_MAX de la capacité du pool suffit).
+ * @return Nombre d'entités écrites (au plus `cap`).
+ */
+int model_pack_entities(const GameModel *model, PackedEntity *out, int cap);
+
+#endif // ENTITY_PACK_H
@@ -0,0 +1,60 @@
+/**
+ * @file entity_type.h
+ * @brief Table des types d'entités : hitbox, points, sprite, couleur, explosion.
+ *
+ * Tout ce qui ne dépend que du type d'une entité tient dans une ligne de
+ * `entity_types`, indexée par EntityType. Le Modèle y lit points et durée
+ * d'explosion au moment d'un impact, les Vues le sprite et la couleur : un
+ * nouveau type d'ennemi est une ligne de plus, sans nouvelle branche.
+ *
+ * @code
+ * const EntityTypeInfo *info = &entity_types[e->type];
+ * model->sim.score += info->points;
+ * SpriteId s = SPRITE_ENEMY_1A + 2 * info->sprite + frame; // Vue SDL
+ * @endcode
+ */
+
+#ifndef ENTITY_TYPE_H
+#define ENTITY_TYPE_H
+
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/**
+ * @brief Données constantes d'un type d'entité.
+ */
+typedef struct
+{
+    uint8_t width;        ///< Largeur de la hitbox (unités logiques).
+    uint8_t height;       ///< Hauteur de la hitbox.
+    uint16_t points;      ///< Points rapportés quand le joueur la détruit (0 : aucun).
+    uint8_t sprite;       ///< Rang du sprite parmi ceux de sa famille (aliens : 0 à 2 ; balles : joueur 0, alien 1).
+    uint8_t ansi_color;   ///< Couleur de terminal (numérotation ANSI : 1 rouge, 2 vert, 3 jaune... 7 blanc).
+    uint32_t color;       ///< Teinte 0xRRGGBB (Vue SDL).
+    float explode_time;   ///< Durée de l'explosion (s), 0 si le type n'explose pas.
+    char glyph;           ///< Caractère de la Vue texte pour une entité du registre (0 : '*', cf. ecs.h).
+} EntityTypeInfo;
+
+/** @brief Une ligne par EntityType. */
+extern const EntityTypeInfo entity_types[ENTITY_TYPE_COUNT];
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Largeur de la hitbox d'un type (0 pour un type inconnu).
+ */
+int entity_type_width(EntityType type);
+
+/**
+ * @brief Hauteur de la hitbox d'un type (0 pour un type inconnu).
+ */
+int entity_type_height(EntityType type);
+
+#endif // ENTITY_TYPE_H
@@ -0,0 +1,147 @@
+/**
+ * @file env.h
+ * @brief Environnement d'apprentissage par renforcement autour du Modèle.
+ *
+ * API C stable pour piloter des parties depuis un agent : remise à zéro par
+ * graine, pas d'une action, observation compacte. Une action est un masque
+ * de touches maintenues (INPUT_LEFT, INPUT_RIGHT, INPUT_FIRE, cf.
+ * controller.h), appliqué pendant un tick de 1/TARGET_FPS s.
+ *
+ * @code
+ * Env *env = env_create();
+ * uint8_t obs[ENV_OBS_SIZE];
+ * env_reset(env, 42);
+ * for (;;)
+ * {
+ *     env_observe(env, obs);
+ *     EnvStep r = env_step(env, policy(obs)); // INPUT_LEFT | INPUT_FIRE ...
+ *     if (r.done)
+ *         env_reset(env, next_seed++);
+ * }
+ * env_free(env);
+ * @endcode
+ *
+ * Chaque environnement possède son modèle : plusieurs peuvent tourner sur
+ * des threads différents. Les variantes `_many` avancent ou observent N
+ * environnements d'un appel (model_step_batch). Aucune fonction n'alloue,
+ * sauf env_create.
+ */
+
+#ifndef ENV_H
+#define ENV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Observation en grille */
+///@{
+#define ENV_OBS_WIDTH GAME_WIDTH                     ///< Colonnes de la grille (une par unité logique).
+#define ENV_OBS_HEIGHT GAME_HEIGHT                   ///< Rangées de la grille.
+#define ENV_OBS_SIZE (ENV_OBS_WIDTH * ENV_OBS_HEIGHT) ///< Octets d'une observation (rangée par rangée).
+#define ENV_MAX_ENTITIES (1 + MAX_ENEMIES + MAX_BULLETS + MAX_SHIELDS + 1) ///< Entités listées au plus (pool par défaut).
+///@}
+
+/**
+ * @brief Contenu d'une case de la grille (ou nature d'une entité listée).
+ *
+ * Quand deux boîtes se chevauchent, la plus grande valeur l'emporte.
+ */
+typedef enum
+{
+    ENV_CELL_EMPTY = 0,         ///< Case vide.
+    ENV_CELL_SHIELD = 1,        ///< Bouclier.
+    ENV_CELL_ENEMY = 2,         ///< Alien vivant.
+    ENV_CELL_UFO = 3,           ///< OVNI.
+    ENV_CELL_PLAYER = 4,        ///< Vaisseau du joueur.
+    ENV_CELL_PLAYER_BULLET = 5, ///< Tir du joueur.
+    ENV_CELL_ENEMY_BULLET = 6   ///< Tir ennemi.
+} EnvCell;
+
+/**
+ * @brief Une entité de l'observation en liste.
+ */
+typedef struct
+{
+    uint8_t kind;  ///< EnvCell.
+    uint8_t value; ///< Bouclier : points de vie ; alien : type (1 à 3) ; sinon 0.
+    float x, y;    ///< Coin haut-gauche (coordonnées logiques).
+} EnvEntity;
+
+/**
+ * @brief Résultat d'un pas.
+ */
+typedef struct
+{
+    float reward; ///< Points marqués pendant le pas.
+    bool done;    ///< Partie terminée (Game Over) : appeler env_reset.
+} EnvStep;
+
+/** @brief Environnement opaque (un modèle et son état de départ). */
+typedef struct Env Env;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Alloue un environnement (capacité des balles : celle de model_set_bullet_capacity).
+ * @return NULL si l'allocation échoue.
+ */
+Env *env_create(void);
+
+/**
+ * @brief Libère un environnement (NULL accepté).
+ */
+void env_free(Env *env);
+
+/**
+ * @brief Commence une partie neuve, entièrement déterminée par `seed`.
+ */
+void env_reset(Env *env, uint64_t seed);
+
+/**
+ * @brief Applique une action pendant un tick.
+ *
+ * @param action Combinaison de INPUT_LEFT, INPUT_RIGHT et INPUT_FIRE.
+ */
+EnvStep env_step(Env *env, unsigned action);
+
+/**
+ * @brief Écrit la grille d'occupation (ENV_OBS_SIZE octets, valeurs EnvCell) dans `buffer`.
+ */
+void env_observe(const Env *env, uint8_t *buffer);
+
+/**
+ * @brief Écrit la liste des entités (joueur, aliens vivants, balles, boucliers, OVNI).
+ *
+ * @param cap Capacité de `out` (ENV_MAX_ENTITIES suffit avec le pool par défaut).
+ * @return Nombre d'entités écrites (au plus `cap`).
+ */
+int env_observe_entities(const Env *env, EnvEntity *out, int cap);
+
+/**
+ * @brief env_step sur N environnements, d'un seul appel de model_step_batch par lot.
+ *
+ * @param actions Une action par environnement.
+ * @param out Un résultat par environnement.
+ */
+void env_step_many(Env **envs, const unsigned *actions, int n, EnvStep *out);
+
+/**
+ * @brief env_observe sur N environnements : N grilles consécutives dans `buffer`.
+ */
+void env_observe_many(Env *const *envs, int n, uint8_t *buffer);
+
+/**
+ * @brief Modèle simulé (lecture seule : rendu, débogage).
+ */
+const GameModel *env_model(const Env *env);
+
+#endif // ENV_H
@@ -0,0 +1,184 @@
+/**
+ * @file flightrec.h
+ * @brief Enregistreur de vol : les dernières secondes de jeu en mémoire, vidées sur incident.
+ *
+ * L'enregistreur garde, dans un anneau de taille fixe, les FLIGHT_FRAMES
+ * dernières frames de la session : commande lue, nombre de ticks simulés,
+ * état du générateur après la frame et durées de l'image (frame complète et
+ * travail). Toutes les FLIGHT_SNAPSHOT_FRAMES frames en partie, il encode en
+ * plus un instantané du modèle (save_encode_snapshot) dans l'un de ses
+ * FLIGHT_SNAPSHOTS tampons, alloués une fois au démarrage.
+ *
+ * Sur un incident, il écrit dans `sauvegardes/` un enregistrement partiel
+ * (`vol-<date>-<n>.rpl`, cf. REPLAY_FLAG_PARTIAL) : le plus ancien instantané
+ * encore couvert par l'anneau, puis toutes les frames qui le suivent. Il se
+ * rejoue sans Vue comme tout enregistrement (`./space_invaders replay`).
+ * Un rapport texte à côté (`.txt`) liste les frames, leurs durées et l'état
+ * du générateur ; hors crash, il finit par l'état du générateur et
+ * l'empreinte du modèle au vidage, que le rejeu retrouve au bit près
+ * (`RNG final`, `Empreinte`).
+ *
+ * Trois déclencheurs :
+ * - une image plus longue que le seuil (SPACE_INVADERS_FLIGHT_HITCH_MS,
+ *   FLIGHT_HITCH_MS par défaut, 0 : jamais), au plus une fois toutes les
+ *   FLIGHT_SNAPSHOT_FRAMES frames ;
+ * - un signal fatal (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) : le vidage
+ *   est écrit, puis le signal reprend son effet par défaut ;
+ * - une touche (F9), par flight_request_dump.
+ *
+ * Une frame coûte quelques écritures dans l'anneau, sans appel ni
+ * allocation ; seul l'instantané périodique encode le modèle. L'enregistreur
+ * est actif par défaut (SPACE_INVADERS_FLIGHT=0 le coupe). Le vidage porte
+ * la fréquence de simulation relevée par flight_init : fixer celle-ci
+ * (model_set_tick_rate) avant.
+ *
+ * @code
+ * flight_record_command(fr, model, cmd);  // Avant model_dispatch_command
+ * model_dispatch_command(model, cmd);
+ * flight_record_tick_begin(fr);
+ * model_update(model, dt);
+ * flight_record_tick(fr);
+ * flight_record_timing(fr, model, frame_s, work_s); // Fin d'image : seuil et touche
+ * @endcode
+ */
+
+#ifndef FLIGHTREC_H
+#define FLIGHTREC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "controller.h"
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Enregistreur de vol */
+///@{
+#define FLIGHT_FRAMES 4096                                     ///< Frames gardées (environ 68 s à TARGET_FPS).
+#define FLIGHT_SNAPSHOTS 4                                     ///< Tampons d'instantané (le plus ancien est vidé).
+#define FLIGHT_SNAPSHOT_FRAMES (FLIGHT_FRAMES / FLIGHT_SNAPSHOTS) ///< Frames entre deux instantanés.
+#define FLIGHT_HITCH_MS 250                                    ///< Seuil d'image lente par défaut (ms).
+#define FLIGHT_MAX_DUMPS 8                                     ///< Vidages au plus par session.
+///@}
+
+/**
+ * @brief Une frame de l'anneau (24 octets).
+ */
+typedef struct
+{
+    uint64_t rng;     ///< État du générateur après la frame.
+    float frame_ms;   ///< Durée de l'image où la frame s'est close.
+    float work_ms;    ///< Travail de cette image (hors attente).
+    uint8_t cmd;      ///< Commande (GameCommand).
+    uint8_t updates;  ///< Ticks simulés après elle.
+} FlightFrame;
+
+/**
+ * @brief Instantané encodé, avec la frame à laquelle il a été pris.
+ */
+typedef struct
+{
+    uint8_t *data;  ///< Tampon (alloué à flight_init).
+    size_t size;    ///< Octets encodés (0 : vide ou en cours d'écriture).
+    uint64_t frame; ///< Frames closes avant lui.
+} FlightSnapshot;
+
+/**
+ * @brief L'enregistreur : anneau des frames, instantanés, déclencheurs.
+ */
+typedef struct
+{
+    bool active;                               ///< Enregistrement en cours.
+    FlightFrame ring[FLIGHT_FRAMES];           ///< Dernières frames closes (indice : frame % FLIGHT_FRAMES).
+    uint64_t frames;                           ///< Frames closes depuis le début de la session.
+    bool open;                                 ///< Une commande attend encore ses ticks.
+    uint8_t open_cmd;                          ///< Cette commande.
+    int open_updates;                          ///< Ticks simulés depuis.
+    bool in_tick;                              ///< Un model_update est en cours (repris au vidage d'un crash).
+    float frame_ms;                            ///< Durée de la dernière image mesurée.
+    float work_ms;                             ///< Travail de la dernière image mesurée.
+    FlightSnapshot snapshots[FLIGHT_SNAPSHOTS]; ///< Instantanés, pris à tour de rôle.
+    size_t snapshot_cap;                       ///< Capacité de chaque tampon.
+    int next_slot;                             ///< Prochain tampon à remplir.
+    uint64_t next_snapshot;                    ///< Frame à partir de laquelle prendre le prochain.
+    uint64_t seed;                             ///< Graine de la session (vidage sans instantané).
+    uint32_t flags;                            ///< Physique de la session (replay_session_flags).
+    int hz;                                    ///< Fréquence de simulation de la session (model_tick_rate).
+    float hitch_ms;                            ///< Seuil d'image lente (0 : jamais).
+    uint64_t next_hitch;                       ///< Frame à partir de laquelle un nouveau vidage est permis.
+    int dumps;                                 ///< Vidages écrits.
+    char last_dump[96];                        ///< Chemin du dernier (rappelé par flight_close).
+} FlightRecorder;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Prépare l'enregistreur au début d'une session et installe les signaux.
+ *
+ * Lit SPACE_INVADERS_FLIGHT et SPACE_INVADERS_FLIGHT_HITCH_MS, alloue les
+ * tampons d'instantané à la capacité du modèle (pool de balles).
+ *
+ * @param model Modèle au début de la session (graine, physique).
+ * @return false si l'enregistreur est coupé ou si l'allocation échoue (inactif).
+ */
+bool flight_init(FlightRecorder *fr, const GameModel *model);
+
+/**
+ * @brief Ferme la frame précédente et ouvre celle de `cmd`, avant son model_dispatch_command.
+ *
+ * Prend l'instantané dû à cette limite de frame (en partie seulement).
+ */
+void flight_record_command(FlightRecorder *fr, const GameModel *model, GameCommand cmd);
+
+/**
+ * @brief Signale le début d'un model_update.
+ */
+static inline void flight_record_tick_begin(FlightRecorder *fr)
+{
+    fr->in_tick = true;
+}
+
+/**
+ * @brief Compte un tick simulé après la dernière commande.
+ */
+static inline void flight_record_tick(FlightRecorder *fr)
+{
+    fr->in_tick = false;
+    fr->open_updates++;
+}
+
+/**
+ * @brief Fin d'image : note ses durées, vide l'anneau sur une image lente ou à la demande.
+ */
+void flight_record_timing(FlightRecorder *fr, const GameModel *model, double frame_s, double work_s);
+
+/**
+ * @brief Demande un vidage à la prochaine fin d'image (touche F9 ; tout thread).
+ */
+void flight_request_dump(void);
+
+/**
+ * @brief Écrit l'enregistrement partiel et son rapport dans `sauvegardes/`.
+ *
+ * @param model État courant, fin de la dernière frame (NULL après un crash : état inconnu).
+ * @param reason Cause, reprise dans le rapport ("touche", "image lente", "signal 11"...).
+ * @return false si l'enregistreur est inactif, si l'anneau ne couvre plus
+ *         aucun point de départ, ou si le fichier n'a pas pu être créé.
+ */
+bool flight_dump(FlightRecorder *fr, const GameModel *model, const char *reason);
+
+/**
+ * @brief Arrête l'enregistrement, rend les signaux et libère les tampons.
+ *
+ * Rappelle sur la sortie standard les vidages de la session (aucun message
+ * pendant la partie : la Vue occupe le terminal).
+ */
+void flight_close(FlightRecorder *fr);
+
+#endif // FLIGHTREC_H
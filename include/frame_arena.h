@@ -0,0 +1,103 @@
+/**
+ * @file frame_arena.h
+ * @brief Arène d'image : mémoire des données qui ne vivent que le temps d'une image.
+ *
+ * Une image a besoin de mémoire passagère : mise en forme des chaînes trop
+ * longues pour une GlyphRun, texte formaté, tampon des différences envoyé
+ * au terminal. Plutôt qu'un malloc (ou un realloc qui grandit) par besoin,
+ * chaque Vue garde un bloc unique découpé à la suite, sans libération
+ * individuelle : frame_arena_reset, au début de `render`, rend tout d'un
+ * coup. Un découpage ne coûte qu'une addition.
+ *
+ * La taille est fixée à l'ouverture (ou agrandie entre deux images par
+ * frame_arena_reserve, quand la grille d'une Vue texte grandit) : la
+ * mémoire d'une image est bornée. Au-delà, frame_arena_alloc rend NULL et
+ * le dépassement est compté ; l'appelant se replie sur son chemin habituel.
+ * Le pic d'utilisation reste mesurable (panneau F3, bilan à la fermeture).
+ *
+ * @code
+ * FrameArena frame;
+ * frame_arena_init(&frame, FRAME_ARENA_BYTES);
+ * ...
+ * frame_arena_reset(&frame);                       // Début de l'image
+ * char *line = frame_arena_printf(&frame, "Score %d", score);
+ * int16_t *x = frame_arena_alloc(&frame, n * sizeof(int16_t));
+ * ...
+ * frame_arena_free(&frame);
+ * @endcode
+ */
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Arène d'image */
+///@{
+#define FRAME_ARENA_ALIGN 16            ///< Alignement de chaque découpage.
+#define FRAME_ARENA_BYTES (64u << 10)   ///< Taille par défaut (Vue SDL).
+///@}
+
+/**
+ * @brief Bloc découpé à la suite, rendu en entier à chaque image.
+ */
+typedef struct
+{
+    uint8_t *base;      ///< Début du bloc (NULL : pas de bloc, tout découpage échoue).
+    size_t capacity;    ///< Taille du bloc.
+    size_t used;        ///< Octets découpés depuis le début de l'image.
+    size_t last;        ///< Octets découpés par l'image précédente.
+    size_t peak;        ///< Plus grande utilisation sur une image.
+    uint64_t frames;    ///< Images commencées (frame_arena_reset).
+    uint64_t overflows; ///< Découpages refusés, bloc plein.
+} FrameArena;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Alloue le bloc (mémoire de jeu, cf. workset.h).
+ * @return false si l'allocation échoue (l'arène reste vide et utilisable).
+ */
+bool frame_arena_init(FrameArena *a, size_t bytes);
+
+/**
+ * @brief Agrandit le bloc s'il est plus petit que `bytes`, en début d'image seulement.
+ * @return false si l'allocation échoue ou si l'image a déjà découpé (bloc inchangé).
+ */
+bool frame_arena_reserve(FrameArena *a, size_t bytes);
+
+/**
+ * @brief Commence une image : tout le bloc redevient libre, l'utilisation de la précédente est notée.
+ */
+void frame_arena_reset(FrameArena *a);
+
+/**
+ * @brief Découpe `bytes` octets alignés sur FRAME_ARENA_ALIGN (non initialisés).
+ * @return NULL si le bloc est plein (dépassement compté).
+ */
+void *frame_arena_alloc(FrameArena *a, size_t bytes);
+
+/**
+ * @brief Formate une chaîne dans l'arène, à sa longueur exacte.
+ * @return La chaîne, ou NULL si elle n'entre pas.
+ */
+char *frame_arena_vprintf(FrameArena *a, const char *fmt, va_list args);
+
+/** @brief frame_arena_vprintf à arguments variables. */
+char *frame_arena_printf(FrameArena *a, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Rend le bloc et remet l'arène à zéro.
+ */
+void frame_arena_free(FrameArena *a);
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,107 @@
+/**
+ * @file gputime.h
+ * @brief Durée des images côté GPU (PROF_GPU), relevée sans attente quelques images plus tard.
+ *
+ * Le profileur (profiler.h) ne voit que le CPU : le temps passé dans
+ * SDL_RenderPresent peut aussi bien attendre le GPU que la synchronisation
+ * verticale. Ce module mesure ce que le GPU fait de chaque image, pour
+ * distinguer un jeu limité par le remplissage d'un jeu limité par le CPU.
+ * Chaque mesure entre dans la phase PROF_GPU du profileur : panneau F3,
+ * résumé de sortie et ligne "GPU" des traces.
+ *
+ * Selon le pilote du renderer :
+ * - opengl (ARB_timer_query) et opengles2 (EXT_disjoint_timer_query) : deux
+ *   horodatages du GPU (glQueryCounter) encadrent chaque envoi de commandes
+ *   de l'image : avant chaque changement de cible de rendu (gputime_flush)
+ *   et avant la présentation. La somme des lots donne le temps d'exécution
+ *   du GPU, sans ses attentes du CPU entre deux lots ;
+ * - gpu (SDL_GPU, sans requêtes d'horodatage) : une barrière (fence) soumise
+ *   après la présentation signale la fin de l'image sur le GPU ; un thread
+ *   l'attend et date ce signal. La durée va du début de la présentation
+ *   (ou de la fin de l'image précédente, si elle est plus tardive) au signal :
+ *   une borne haute, attente de l'écran comprise ;
+ * - autres pilotes (software, direct3d...) : aucune mesure.
+ *
+ * Les résultats sont relus GPUTIME_LATENCY images plus tard au plus. Si les
+ * GPUTIME_LATENCY emplacements sont tous en vol (GPU très en retard),
+ * l'image n'est pas mesurée : le rendu n'attend jamais une mesure. Profileur
+ * coupé, rien n'est envoyé au GPU.
+ *
+ * @code
+ * gputime_open(renderer);
+ * // À chaque image :
+ * gputime_frame_begin();
+ * ... dessin (gputime_flush() avant chaque SDL_SetRenderTarget) ...
+ * gputime_frame_end();
+ * SDL_RenderPresent(renderer);
+ * gputime_presented();
+ * @endcode
+ */
+
+#ifndef GPUTIME_H
+#define GPUTIME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <SDL3/SDL.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Mesure du GPU */
+///@{
+#define GPUTIME_LATENCY 4     ///< Images en vol au plus (requêtes ou barrières pas encore lues).
+#define GPUTIME_SEGMENTS 8    ///< Lots de commandes horodatés par image (au-delà, non comptés).
+#define GPUTIME_CALIBRATE 240 ///< Images entre deux recalages de l'horloge GPU sur utils_fast_ns (OpenGL).
+///@}
+
+/**
+ * @brief Bilan des mesures.
+ */
+typedef struct
+{
+    const char *method; ///< "horodatages GL", "barrieres SDL_GPU", ou NULL sans mesure.
+    uint64_t measured;  ///< Images mesurées.
+    uint64_t skipped;   ///< Images non mesurées (emplacements en vol, ou résultats invalidés).
+} GpuTimeStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Choisit la méthode de mesure selon le pilote du renderer.
+ * @return false si le pilote ne permet aucune mesure.
+ */
+bool gputime_open(SDL_Renderer *renderer);
+
+/**
+ * @brief Début d'une image : relit les mesures prêtes et réserve un emplacement.
+ */
+void gputime_frame_begin(void);
+
+/**
+ * @brief Envoie au GPU les commandes en attente, horodatées (avant un changement de cible de rendu).
+ */
+void gputime_flush(void);
+
+/**
+ * @brief Fin de l'image, juste avant SDL_RenderPresent : dernier lot horodaté.
+ */
+void gputime_frame_end(void);
+
+/**
+ * @brief Après SDL_RenderPresent : barrière de fin d'image (SDL_GPU).
+ */
+void gputime_presented(void);
+
+/**
+ * @brief Arrête les mesures (attend les barrières en vol) et libère les requêtes.
+ *
+ * @param out Reçoit le bilan (peut être NULL).
+ */
+void gputime_close(GpuTimeStats *out);
+
+#endif // GPUTIME_H
@@ -0,0 +1,108 @@
+/**
+ * @file headless.h
+ * @brief Pilote de simulation sans affichage (Mode Headless).
+ *
+ * Ce module fait tourner le Modèle sans aucune ViewInterface : pas de fenêtre,
+ * pas de terminal, pas de pause (sleep) entre deux frames. La simulation avance
+ * aussi vite que le CPU le permet, avec un pas de temps fixe identique au jeu réel.
+ *
+ * Les entrées du joueur proviennent d'un "script" de commandes rejoué en boucle,
+ * ou du joueur automatique (bot.h) qui vise, tire et esquive.
+ * C'est la fondation des benchmarks, des tests de non-régression et des replays.
+ */
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bot.h"
+#include "model.h"
+
+// ============================================================================
+//                          CONFIGURATION
+// ============================================================================
+
+/** @brief Nombre de ticks simulés par défaut (10 minutes de jeu à 60 Hz). */
+#define HEADLESS_DEFAULT_TICKS (TARGET_FPS * 60 * 10)
+
+/**
+ * @brief Script d'entrées par défaut.
+ * Chaque caractère correspond à un tick : 'L' (Gauche), 'R' (Droite),
+ * 'S' (Tir), '.' (Aucune action). Le script est rejoué en boucle.
+ */
+#define HEADLESS_DEFAULT_SCRIPT "LLLLLLLLSS........RRRRRRRRSS........"
+
+/**
+ * @brief Paramètres d'une session headless.
+ */
+typedef struct
+{
+    long max_ticks;         ///< Nombre maximum de ticks à simuler.
+    const char *script;     ///< Séquence de commandes (voir HEADLESS_DEFAULT_SCRIPT).
+    bool stop_on_game_over; ///< Si true, la session s'arrête au premier Game Over.
+    uint64_t seed;          ///< Graine du générateur du modèle (même graine = même partie).
+    const BotConfig *bot;   ///< Joueur automatique à la place du script (NULL : script, cf. bot.h).
+    int stop_level;         ///< Si > 0, la session s'arrête dès que ce niveau est atteint.
+} HeadlessConfig;
+
+/**
+ * @brief Résultats d'une session headless.
+ */
+typedef struct
+{
+    long ticks;           ///< Nombre de ticks effectivement simulés.
+    double elapsed;       ///< Temps réel écoulé (secondes).
+    double steps_per_sec; ///< Débit de simulation (ticks / seconde réelle).
+    int score;            ///< Score final.
+    int level;            ///< Niveau atteint.
+    int games_played;     ///< Nombre de parties lancées (relances après Game Over).
+    int dropped_bullets[BULLET_SIDES]; ///< Tirs perdus faute de slot libre dans le camp (toutes parties confondues).
+    int bullet_capacity;  ///< Capacité du pool de balles (model_set_bullet_capacity).
+    int player_slots;     ///< Slots réservés au joueur (model_set_player_bullets).
+    uint64_t seed;        ///< Graine utilisée (pour rejouer la session).
+    bool bot;             ///< Entrées du bot (sinon du script).
+    bool fixed_point;     ///< Physique en virgule fixe (model_set_fixed_point).
+    bool endless;         ///< Vague sans fin (model_set_endless).
+    bool coop;            ///< Deux vaisseaux (model_set_local_coop ; le second n'a pas d'entrées).
+    uint32_t fingerprint; ///< Empreinte de l'état final (save_fingerprint).
+    uint64_t plan_nodes;     ///< Ticks simulés par le planificateur du bot (0 : pas de planification).
+    double plan_rate;        ///< Débit du planificateur (ticks simulés / seconde de planification).
+    uint32_t plan_decisions; ///< Décisions planifiées.
+    uint32_t plan_cutoffs;   ///< Décisions arrêtées par le budget avant la dernière touche candidate.
+} HeadlessStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise une configuration avec les valeurs par défaut.
+ */
+void headless_default_config(HeadlessConfig *cfg);
+
+/**
+ * @brief Traduit un caractère de script en commande abstraite.
+ * @return La GameCommand correspondante (CMD_NONE si inconnu).
+ */
+GameCommand headless_script_command(char c);
+
+/**
+ * @brief Lance une session de simulation sans affichage.
+ *
+ * Démarre une partie depuis le menu, puis enchaîne `model_update` au pas fixe
+ * `1.0 / TARGET_FPS` en injectant les commandes du script, sans jamais dormir.
+ *
+ * @param model Le modèle à simuler (doit sortir de model_init).
+ * @param cfg Paramètres de la session.
+ * @param out Statistiques remplies en fin de session (peut être NULL).
+ */
+void headless_run(GameModel *model, const HeadlessConfig *cfg, HeadlessStats *out);
+
+/**
+ * @brief Affiche un résumé des statistiques sur la sortie standard.
+ */
+void headless_print_stats(const HeadlessStats *stats);
+
+#endif // HEADLESS_H
@@ -0,0 +1,98 @@
+/**
+ * @file highscore.h
+ * @brief Table des meilleurs scores persistante (top HIGHSCORE_COUNT).
+ *
+ * La table vit en mémoire dans le modèle, triée du meilleur au moins bon
+ * score : l'insertion en fin de partie est une recherche dichotomique suivie
+ * d'un décalage, et le rang est connu immédiatement, sans accès disque.
+ *
+ * Sur disque, `sauvegardes/highscores.tab` est un fichier d'enregistrements
+ * de taille fixe :
+ *
+ * @code
+ * En-tête (12 octets) : "SIHS" | version u16 | nombre u16 | CRC32 u32
+ * Entrées (16 octets) : score i32 | niveau i32 | horodatage i64
+ * @endcode
+ *
+ * Il est lu une fois au lancement et réécrit atomiquement (fichier temporaire
+ * puis rename, par le thread de save_writer.h) après chaque nouveau record :
+ * un crash laisse l'ancienne table ou la nouvelle, jamais un mélange.
+ */
+
+#ifndef HIGHSCORE_H
+#define HIGHSCORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define HIGHSCORE_FILE "highscores.tab" ///< Nom de la table dans le dossier des sauvegardes.
+#define HIGHSCORE_COUNT 10              ///< Nombre de scores conservés.
+#define HIGHSCORE_VERSION 1             ///< Version du format.
+
+/**
+ * @brief Un score de la table.
+ */
+typedef struct
+{
+    int score;         ///< Score final de la partie.
+    int level;         ///< Niveau atteint.
+    int64_t timestamp; ///< Date de la partie (secondes depuis l'epoch).
+} HighscoreEntry;
+
+/**
+ * @brief Table des meilleurs scores, triée par score décroissant.
+ */
+typedef struct
+{
+    HighscoreEntry entries[HIGHSCORE_COUNT]; ///< Scores, du meilleur au moins bon.
+    int count;                               ///< Entrées utilisées.
+    bool dirty;                              ///< Modifiée depuis la dernière écriture.
+} HighscoreTable;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Charge la table depuis le disque.
+ *
+ * Un fichier absent, tronqué ou corrompu (CRC) donne une table vide.
+ *
+ * @param dir Dossier des sauvegardes.
+ * @return true si un fichier valide a été lu.
+ */
+bool highscore_load(HighscoreTable *table, const char *dir);
+
+/**
+ * @brief Insère un score à sa place (recherche dichotomique).
+ *
+ * À score égal, le plus ancien reste devant. Le dernier score sort de la
+ * table quand elle est pleine.
+ *
+ * @param timestamp Date de la partie.
+ * @return Le rang obtenu (1 = meilleur score), ou 0 si le score n'entre pas dans la table.
+ */
+int highscore_insert(HighscoreTable *table, int score, int level, int64_t timestamp);
+
+/**
+ * @brief Rang qu'obtiendrait un score, sans modifier la table.
+ * @return Le rang (1 = meilleur), ou 0 s'il n'entrerait pas dans la table.
+ */
+int highscore_rank(const HighscoreTable *table, int score);
+
+/**
+ * @brief Demande la réécriture de la table si elle a changé.
+ *
+ * Ne bloque jamais : si le thread d'écriture est occupé, la demande est
+ * retentée à l'appel suivant (à faire à chaque frame).
+ *
+ * @param dir Dossier des sauvegardes.
+ */
+void highscore_flush(HighscoreTable *table, const char *dir);
+
+#endif // HIGHSCORE_H
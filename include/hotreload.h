@@ -0,0 +1,106 @@
+/**
+ * @file hotreload.h
+ * @brief Rechargement à chaud : surveillance d'un dossier (inotify), décodage des fichiers modifiés sur un thread.
+ *
+ * Mode de développement. Un thread surveille un dossier et ses
+ * sous-dossiers ; quand un fichier y est réécrit (ou remplacé par un
+ * renommage, comme le font la plupart des éditeurs), il attend que le
+ * dossier soit calme HOTRELOAD_SETTLE_MS, puis décode chaque fichier touché
+ * une seule fois par l'opération `decode` de l'appelant. Le résultat attend
+ * dans une file que le thread principal le récupère entre deux images
+ * (hotreload_take) pour l'échanger avec la ressource en place : seul ce
+ * fichier est relu et renvoyé à la carte graphique ou au mixeur.
+ *
+ * Le module ne sait rien des ressources : `decode` décide du sens d'un
+ * chemin (NULL : fichier sans intérêt), `discard` libère un résultat jamais
+ * récupéré (remplacé par un plus récent, ou arrêt).
+ *
+ * Sous Linux seulement (inotify) ; ailleurs, hotreload_start renvoie false.
+ */
+
+#ifndef HOTRELOAD_H
+#define HOTRELOAD_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Rechargement à chaud */
+///@{
+#define HOTRELOAD_PATH_MAX 256  ///< Longueur maximale d'un chemin surveillé.
+#define HOTRELOAD_MAX_DIRS 64   ///< Dossiers surveillés au plus (racine comprise).
+#define HOTRELOAD_PENDING 32    ///< Fichiers modifiés en attente de décodage (distincts).
+#define HOTRELOAD_READY 32      ///< Résultats en attente du thread principal.
+#define HOTRELOAD_SETTLE_MS 60  ///< Calme requis avant de décoder (écritures en plusieurs fois).
+///@}
+
+/**
+ * @brief Opérations de l'appelant, appelées depuis le thread de surveillance.
+ */
+typedef struct
+{
+    void *(*decode)(const char *path, void *user);  ///< Décode un fichier modifié (NULL : rien à recharger).
+    void (*discard)(void *data, void *user);        ///< Libère un résultat jamais récupéré.
+    void (*notify)(void *user);                     ///< Signale un résultat prêt (réveil de la boucle ; optionnel).
+    void *user;                                     ///< Contexte passé aux opérations.
+} HotReloadOps;
+
+/**
+ * @brief Un fichier décodé, prêt à être échangé.
+ */
+typedef struct
+{
+    char path[HOTRELOAD_PATH_MAX]; ///< Chemin du fichier (racine comprise, ex. "assets/aliens/alien_A1.bmp").
+    void *data;                    ///< Résultat de `decode`.
+} HotReloadItem;
+
+/**
+ * @brief Surveillance en cours : dossiers, fichiers en attente, résultats et statistiques.
+ */
+typedef struct
+{
+    bool active;                                         ///< Thread lancé.
+    int fd;                                              ///< Descripteur inotify.
+    pthread_t thread;                                    ///< Thread de surveillance et de décodage.
+    int stop;                                            ///< Arrêt demandé (atomique).
+    HotReloadOps ops;                                    ///< Opérations de l'appelant.
+    int wds[HOTRELOAD_MAX_DIRS];                         ///< Surveillance de chaque dossier.
+    char dirs[HOTRELOAD_MAX_DIRS][HOTRELOAD_PATH_MAX];   ///< Chemin de chaque dossier surveillé.
+    int dir_count;                                       ///< Dossiers surveillés.
+    char pending[HOTRELOAD_PENDING][HOTRELOAD_PATH_MAX]; ///< Fichiers modifiés, pas encore décodés (thread).
+    int pending_count;                                   ///< Entrées de `pending`.
+    pthread_mutex_t lock;                                ///< Protège `ready`.
+    HotReloadItem ready[HOTRELOAD_READY];                ///< Résultats décodés, pas encore récupérés.
+    int ready_count;                                     ///< Entrées de `ready`.
+    uint64_t changes;                                    ///< Écritures de fichiers vues.
+    uint64_t decoded;                                    ///< Fichiers décodés.
+    uint64_t ignored;                                    ///< Fichiers sans intérêt pour l'appelant.
+    uint64_t superseded;                                 ///< Résultats remplacés avant d'être récupérés.
+} HotReload;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Surveille `root` et ses sous-dossiers, puis lance le thread.
+ * @return false si inotify est indisponible ou le thread n'a pas pu être lancé.
+ */
+bool hotreload_start(HotReload *hot, const char *root, const HotReloadOps *ops);
+
+/**
+ * @brief Récupère les fichiers décodés depuis l'appel précédent (thread principal, entre deux images).
+ * @return Le nombre d'entrées écrites dans `out` (au plus `max`).
+ */
+int hotreload_take(HotReload *hot, HotReloadItem *out, int max);
+
+/**
+ * @brief Arrête le thread, libère les résultats non récupérés et affiche le bilan.
+ */
+void hotreload_stop(HotReload *hot);
+
+#endif // HOTRELOAD_H
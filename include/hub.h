@@ -0,0 +1,166 @@
+/**
+ * @file hub.h
+ * @brief Serveur multi-parties : des milliers de parties en temps réel dans un seul processus.
+ *
+ * Le serveur réseau (net.h) fait tourner une partie sur son thread, à son
+ * échéance. Ici, chaque partie est une entrée d'un tableau : son modèle
+ * (structure et arène des pools, un seul bloc découpé dans la mémoire de
+ * jeu, cf. workset.h), son échéance et sa file de commandes. Aucune n'a de
+ * thread à elle :
+ *
+ * - une roue temporelle (HUB_WHEEL_SLOTS cases de HUB_SLOT_NS) range chaque
+ *   partie dans la case de son prochain tick ; le thread de la roue verse
+ *   chaque case échue dans la file des parties prêtes ;
+ * - un nombre fixe de threads de calcul prend les parties prêtes par lots
+ *   (HUB_BATCH), avance chacune d'un tick, puis la remet dans la roue à
+ *   l'échéance suivante (avance exacte d'une période, sans dérive).
+ *
+ * Les échéances de départ sont réparties sur toute la période : les ticks
+ * de N parties ne tombent pas tous à la même milliseconde. Le modèle ne
+ * garde aucun état global en jeu et ne quitte jamais le processus (fin de
+ * partie, "Quitter" : retour au menu) : une partie ne touche que son bloc.
+ *
+ * Avec `--bot=N`, une partie sans joueur est jouée par un bot (bot.h) et
+ * relancée à chaque Game Over : de quoi charger le serveur sans clients. Le
+ * premier client d'une partie (net_run_hub, `client --match=N`) en prend la
+ * main. Le bilan donne le retard des ticks sur leur échéance (maximum, 99e
+ * centile) : le serveur tient sa charge tant qu'il reste sous la période.
+ *
+ * @code
+ * ./space_invaders hub 5000 60 16 --bot=1        # 5 000 parties, 60 s, 16 threads
+ * ./space_invaders hub 5000 0 16 7777            # En ligne, port UDP 7777, jusqu'à Ctrl+C
+ * ./space_invaders client 127.0.0.1 7777 sdl --match=42
+ * @endcode
+ */
+
+#ifndef HUB_H
+#define HUB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bot.h"
+#include "controller.h"
+#include "netframe.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Serveur multi-parties */
+///@{
+#define HUB_MAX_MATCHES 65536    ///< Parties au plus.
+#define HUB_MAX_THREADS 64       ///< Threads de calcul au plus.
+#define HUB_WHEEL_SLOTS 64       ///< Cases de la roue (puissance de 2, plus d'une période).
+#define HUB_SLOT_NS 1000000ULL   ///< Durée d'une case (1 ms) : les parties d'une case partent ensemble.
+#define HUB_BATCH 16             ///< Parties prises d'un coup par un thread de calcul.
+#define HUB_COMMAND_RING 64      ///< Commandes en attente par partie (puissance de 2).
+#define HUB_MAX_LAG_NS 250000000ULL ///< Retard au-delà duquel l'échéance repart de maintenant (ticks sautés).
+#define HUB_LATE_BUCKETS 24      ///< Histogramme des retards : case b, moins de 2^b µs.
+///@}
+
+/**
+ * @brief Réglages du serveur.
+ */
+typedef struct
+{
+    int matches;          ///< Parties hébergées (1 à HUB_MAX_MATCHES).
+    int threads;          ///< Threads de calcul (0 : un par cœur).
+    uint64_t seed;        ///< Graine de la partie 0 (partie i : seed + i).
+    const BotConfig *bot; ///< Bot des parties sans joueur (NULL : elles attendent au menu).
+} HubConfig;
+
+/**
+ * @brief Bilan d'une session.
+ */
+typedef struct
+{
+    double elapsed;                          ///< Durée (s).
+    int matches;                             ///< Parties hébergées.
+    int threads;                             ///< Threads de calcul.
+    long long ticks;                         ///< Ticks joués, toutes parties.
+    long long skipped;                       ///< Ticks abandonnés après un retard de plus de HUB_MAX_LAG_NS.
+    long long late;                          ///< Ticks partis plus d'une période après leur échéance.
+    long long commands;                      ///< Commandes de joueurs appliquées.
+    long long dropped;                       ///< Commandes perdues (file d'une partie pleine).
+    long long games;                         ///< Parties relancées par les bots.
+    int watched;                             ///< Parties suivies par au moins un client.
+    double step_us;                          ///< Durée moyenne d'un tick (µs).
+    double lateness_max_us;                  ///< Plus grand retard sur l'échéance (µs).
+    long long late_hist[HUB_LATE_BUCKETS];   ///< Retards, par puissance de 2 de µs.
+} HubStats;
+
+/** @brief Serveur opaque (parties, roue, threads). */
+typedef struct Hub Hub;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Alloue les parties (un modèle chacune, graine seed + i), au menu ou lancées par leur bot.
+ *
+ * À appeler après workset_init pour que les modèles soient découpés dans la mémoire de jeu.
+ *
+ * @return NULL si une allocation échoue ou si `matches` est hors bornes.
+ */
+Hub *hub_create(const HubConfig *cfg);
+
+/**
+ * @brief Lance le thread de la roue et les threads de calcul.
+ * @return false si un thread n'a pas pu être créé (rien ne tourne alors).
+ */
+bool hub_start(Hub *hub);
+
+/**
+ * @brief Attend `seconds` secondes (0 : jusqu'à SIGINT), sans réseau.
+ */
+void hub_wait(Hub *hub, double seconds);
+
+/**
+ * @brief Arrête les threads et remplit le bilan (peut être NULL).
+ */
+void hub_stop(Hub *hub, HubStats *out);
+
+/**
+ * @brief Libère les parties (NULL accepté ; threads déjà arrêtés).
+ */
+void hub_free(Hub *hub);
+
+/**
+ * @brief Nombre de parties.
+ */
+int hub_matches(const Hub *hub);
+
+/**
+ * @brief Transmet une commande de joueur à une partie (un seul thread producteur : le réseau).
+ *
+ * La première commande retire la partie à son bot.
+ *
+ * @return false si la file de la partie est pleine (commande perdue).
+ */
+bool hub_push_command(Hub *hub, int match, GameCommand cmd);
+
+/**
+ * @brief Demande les images réseau d'une partie (capturées tous les NET_SEND_EVERY ticks).
+ *
+ * Alloue à la première demande ses tampons d'images (thread réseau seul).
+ *
+ * @return false si l'allocation échoue.
+ */
+bool hub_watch(Hub *hub, int match);
+
+/**
+ * @brief Dernière image publiée d'une partie suivie (thread réseau seul).
+ *
+ * @param tick Reçoit son tick (numérotation propre à la partie).
+ * @return NULL si la partie n'est pas suivie ou n'a encore rien publié.
+ */
+const NetFrame *hub_frame(Hub *hub, int match, uint32_t *tick);
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ */
+void hub_print_stats(const HubStats *stats);
+
+#endif // HUB_H
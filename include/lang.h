@@ -0,0 +1,168 @@
+/**
+ * @file lang.h
+ * @brief Table des chaînes de l'interface : un identifiant par texte, traduction chargée au démarrage.
+ *
+ * Les Vues ne contiennent plus de littéraux : elles demandent lang_get(STR_...).
+ * Chaque entrée a une clé (son nom sans le préfixe STR_) et un texte par
+ * défaut, en français. Un fichier de langue (SPACE_INVADERS_LANG) remplace
+ * tout ou partie des textes :
+ *
+ * @code
+ * # assets/lang/en.lang
+ * MENU_PLAY = PLAY
+ * FINAL_SCORE = Final score: %d
+ * @endcode
+ *
+ * Un texte traduit doit garder les mêmes conversions printf que le texte
+ * par défaut, dans le même ordre (les Vues le passent tel quel à snprintf).
+ * Les Vues texte (ncurses, ANSI, web) lisent la chaîne directement ; la Vue
+ * SDL en garde une forme pré-calculée (glyphes et positions dans l'atlas),
+ * refaite seulement quand lang_generation() change.
+ */
+
+#ifndef LANG_H
+#define LANG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define LANG_ERROR_LEN 128 ///< Longueur d'un message d'erreur de chargement.
+
+/**
+ * @brief Toutes les chaînes : X(identifiant, texte par défaut).
+ *
+ * Les entrées TXT_ sont les variantes des Vues texte, plus courtes ou
+ * encadrées pour la grille de caractères.
+ */
+#define LANG_STRINGS(X)                                                \
+    X(TITLE, "SPACE INVADERS")                                         \
+    X(MENU_PLAY, "JOUER")                                              \
+    X(MENU_TUTORIAL, "TUTORIEL")                                       \
+    X(MENU_LOAD, "CHARGER")                                            \
+    X(MENU_VOLUME, "VOLUME")                                           \
+    X(MENU_QUIT, "QUITTER")                                            \
+    X(VOLUME_MUTED, "VOLUME: [MUTE]")                                  \
+    X(VOLUME_BAR, "VOLUME: [%s] %d%%")                                 \
+    X(PAUSE, "PAUSE")                                                  \
+    X(PAUSE_RESUME, "REPRENDRE")                                       \
+    X(PAUSE_SAVE_QUIT, "SAUVEGARDER ET QUITTER")                       \
+    X(PAUSE_QUIT_NOSAVE, "QUITTER SANS SAUVEGARDER")                   \
+    X(SOUND_OFF, "SON: OFF")                                           \
+    X(SOUND_LEVEL, "SON: < %d%% >")                                    \
+    X(GAME_OVER, "GAME OVER")                                          \
+    X(FINAL_SCORE, "Score Final: %d")                                  \
+    X(NEW_RECORD, "NOUVEAU RECORD ! Rang %d/%d")                       \
+    X(BEST_SCORE, "Meilleur score: %d")                                \
+    X(SAVE, "SAUVEGARDER")                                             \
+    X(REPLAY, "REJOUER")                                               \
+    X(RETRY_LEVEL, "REESSAYER LE NIVEAU %d")                           \
+    X(CONFIRM_YES, "OUI, QUITTER")                                     \
+    X(CONFIRM_NO, "NON, RETOUR")                                       \
+    X(QUIT_WARNING, "ATTENTION !")                                     \
+    X(QUIT_UNSAVED, "Progression non sauvegardee !")                   \
+    X(QUIT_ASK, "Voulez-vous quitter le jeu ?")                        \
+    X(QUIT_CONFIRM, "Confirmer ?")                                     \
+    X(SAVE_SELECT, "CHOISIR L'EMPLACEMENT")                            \
+    X(SAVE_NEW, "CREER NOUVELLE")                                      \
+    X(LOAD_TITLE, "CHARGER UNE PARTIE")                                \
+    X(LOAD_SCANNING, "RECHERCHE DES SAUVEGARDES...")                   \
+    X(LOAD_NONE, "AUCUNE SAUVEGARDE TROUVE")                           \
+    X(SAVE_NAME, "NOM DE LA SAUVEGARDE :")                             \
+    X(SAVE_NAME_HINT, "(Entree: Valider)")                             \
+    X(OVERWRITE_EXISTS, "CE FICHIER EXISTE DEJA !")                    \
+    X(OVERWRITE_FILE, "Fichier : '%s.dat'")                            \
+    X(OVERWRITE_REPLACE, "ECRASER L'ANCIEN")                           \
+    X(OVERWRITE_COPY, "CREER UNE COPIE (1..)")                         \
+    X(SAVING, "SAUVEGARDE EN COURS...")                                \
+    X(SAVE_DONE, "SAUVEGARDE REUSSIE !")                               \
+    X(SAVE_RETURNING, "Retour au menu principal...")                   \
+    X(TUTO_TITLE, "COMMENT JOUER ?")                                   \
+    X(TUTO_MOVE, "Fleches : Se Deplacer")                              \
+    X(TUTO_FIRE, "Espace : Tirer")                                     \
+    X(TUTO_BACK, "(Appuyez sur Entree pour retour)")                   \
+    X(POINTS, "= %d PTS")                                              \
+    X(POINTS_UFO, "= %d PTS + ???")                                    \
+    X(PAGE, "PAGE %d/%d")                                              \
+    X(HUD, "SCORE: %d   NIVEAU: %d%s%s")                               \
+    X(HUD_RAPID, "   RAPIDE")                                          \
+    X(HUD_SPREAD, "   TRIPLE")                                         \
+    X(TXT_TITLE, "=== SPACE INVADERS ===")                             \
+    X(TXT_VOLUME_NA, "VOLUME (N/A)")                                   \
+    X(TXT_LOAD_TITLE, "=== CHARGER ===")                               \
+    X(TXT_LOAD_SCANNING, "Recherche des sauvegardes...")               \
+    X(TXT_LOAD_NONE, "Aucune sauvegarde trouvé.")                      \
+    X(TXT_TUTO_TITLE, "=== TABLEAU DES POINTS ===")                    \
+    X(TXT_TUTO_MOVE, "FLECHES : Deplacer")                             \
+    X(TXT_TUTO_FIRE, "ESPACE  : Tirer")                                \
+    X(TXT_TUTO_BACK, "[ ENTREE POUR RETOUR ]")                         \
+    X(TXT_SCORE, "SCORE: %d")                                          \
+    X(TXT_LIVES, "VIES: %d")                                           \
+    X(TXT_LEVEL, "LVL: %d")                                            \
+    X(TXT_RAPID, "RAPIDE ")                                            \
+    X(TXT_SPREAD, "TRIPLE")                                            \
+    X(TXT_PAUSE, "=== PAUSE ===")                                      \
+    X(TXT_GAME_OVER, "!!! GAME OVER !!!")                              \
+    X(TXT_FINAL_SCORE, "SCORE FINAL: %d")                              \
+    X(TXT_NEW_RECORD, "NOUVEAU RECORD ! RANG %d/%d")                   \
+    X(TXT_BEST_SCORE, "MEILLEUR SCORE: %d")                            \
+    X(TXT_SAVE_SCORE, "SAUVEGARDER SCORE")                             \
+    X(TXT_SAVE_SELECT, "=== CHOISIR EMPLACEMENT ===")                  \
+    X(TXT_SAVE_NEW, "[ + ]  NOUVELLE SAUVEGARDE")                      \
+    X(TXT_NO_FILES, "(Aucun fichier existant)")                        \
+    X(TXT_FILE, "FICHIER : %s")                                        \
+    X(TXT_SAVE_SELECT_HINT, "[ENTREE] Valider   [ECHAP] Retour")       \
+    X(TXT_SAVE_NAME, "NOM DE SAUVEGARDE :")                            \
+    X(TXT_SAVE_NAME_HINT, "(Lettres/Chiffres - ENTREE Valider)")       \
+    X(TXT_QUIT_ASK, "VOULEZ-VOUS QUITTER ?")                           \
+    X(TXT_YES, "OUI")                                                  \
+    X(TXT_NO, "NON")                                                   \
+    X(TXT_OVERWRITE_REPLACE, "ECRASER")                                \
+    X(TXT_OVERWRITE_COPY, "CREER COPIE (1..)")                         \
+    X(TXT_TOO_SMALL, "FENETRE TROP PETITE !")
+
+/**
+ * @brief Identifiant d'une chaîne de l'interface.
+ */
+typedef enum
+{
+#define LANG_ENUM(id, text) STR_##id,
+    LANG_STRINGS(LANG_ENUM)
+#undef LANG_ENUM
+        STR_COUNT
+} StringId;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Texte courant d'une chaîne (traduction chargée, ou texte par défaut).
+ *
+ * Le pointeur reste valide jusqu'au prochain lang_load.
+ */
+const char *lang_get(StringId id);
+
+/**
+ * @brief Charge un fichier de langue : lignes `CLE = texte`, `#` pour un commentaire.
+ *
+ * Les clés absentes gardent leur texte par défaut. À appeler avant
+ * l'initialisation des Vues (la table est partagée, en lecture seule).
+ *
+ * @param err Reçoit le message d'erreur (ex: "ligne 4 : clé inconnue MENU_PLAYY").
+ * @return false (table inchangée) si le fichier est illisible ou invalide.
+ */
+bool lang_load(const char *path, char *err, size_t err_cap);
+
+/**
+ * @brief Compteur incrémenté à chaque lang_load réussi (1 pour la table par défaut).
+ *
+ * Une Vue qui met en forme ou en cache des chaînes les refait quand il change.
+ */
+uint32_t lang_generation(void);
+
+#endif // LANG_H
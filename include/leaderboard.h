@@ -0,0 +1,114 @@
+/**
+ * @file leaderboard.h
+ * @brief Client du classement en ligne : file durable des parties finies, envoi par lots en arrière-plan.
+ *
+ * À chaque partie finie (passage au Game Over ou à la victoire), la boucle
+ * de jeu ajoute un enregistrement de LEADERBOARD_RECORD_SIZE octets (score,
+ * niveau, graine, physique de la session, empreinte de l'état final) à la
+ * fin de `sauvegardes/leaderboard.q` : un seul write() sur un fichier ouvert
+ * en ajout, quelques microsecondes, sans jamais attendre le réseau ni le
+ * disque. L'enregistrement est dans le cache du système dès le retour : un
+ * plantage du jeu ne le perd pas ; le thread d'envoi le force sur le disque
+ * (fdatasync) dans les LEADERBOARD_POLL_MS qui suivent, contre une coupure
+ * de courant.
+ *
+ * Le thread d'envoi (SPACE_INVADERS_LEADERBOARD=hôte:port[/chemin]) relit les
+ * enregistrements pas encore acceptés et les poste par lots d'au plus
+ * LEADERBOARD_BATCH lignes CSV (HTTP/1.0, une connexion par lot). Une réponse
+ * 2xx fait avancer le compteur d'acceptés de l'en-tête du fichier. Un échec
+ * (réseau coupé, serveur absent, refus) espace les tentatives : 1 s, puis le
+ * double à chaque échec, jusqu'à LEADERBOARD_BACKOFF_MAX_S. Une borne restée
+ * hors ligne des jours envoie donc tout son retard en quelques requêtes dès
+ * le retour du réseau. Le serveur reçoit chaque partie au moins une fois
+ * (une réponse perdue fait renvoyer le lot) : la graine et l'empreinte
+ * permettent d'écarter les doublons et de vérifier la partie par rejeu.
+ *
+ * Fichier (petit-boutiste) :
+ *
+ * @code
+ * En-tête (16 octets) : "SILB" | version u16 | taille d'enregistrement u16 | acceptés u64
+ * Enregistrement (40 octets) : horodatage i64 | graine u64 | empreinte u64 | score i32
+ *                              | niveau i32 | drapeaux u32 | CRC32 u32 (des 36 octets précédents)
+ * @endcode
+ *
+ * Au démarrage, une fin d'enregistrement tronquée (plantage pendant
+ * l'écriture) est coupée, et le fichier est vidé si tout a été accepté.
+ */
+
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name File du classement */
+///@{
+#define LEADERBOARD_FILE "leaderboard.q" ///< Nom de la file dans le dossier des sauvegardes.
+#define LEADERBOARD_MAGIC "SILB"         ///< Signature de l'en-tête.
+#define LEADERBOARD_VERSION 1            ///< Version du format.
+#define LEADERBOARD_HEADER_SIZE 16       ///< En-tête du fichier.
+#define LEADERBOARD_RECORD_SIZE 40       ///< Une partie sur le disque.
+#define LEADERBOARD_BATCH 1000           ///< Parties envoyées par requête au plus.
+#define LEADERBOARD_POLL_MS 100          ///< Réveil du thread d'envoi (écriture sur le disque, nouvelles parties).
+#define LEADERBOARD_TIMEOUT_MS 3000      ///< Connexion, envoi et réponse : au-delà, tentative échouée.
+#define LEADERBOARD_BACKOFF_MAX_S 300    ///< Attente maximale entre deux tentatives.
+#define LEADERBOARD_DEFAULT_PATH "/scores" ///< Chemin de la requête si l'adresse n'en donne pas.
+///@}
+
+/**
+ * @brief Bilan de la file.
+ */
+typedef struct
+{
+    uint64_t records;    ///< Parties dans le fichier.
+    uint64_t acked;      ///< Parties acceptées par le serveur.
+    uint64_t submitted;  ///< Parties ajoutées pendant la session.
+    uint64_t uploads;    ///< Lots acceptés pendant la session.
+    uint64_t failures;   ///< Tentatives échouées pendant la session.
+    double append_max_us; ///< Ajout le plus long (boucle de jeu), en microsecondes.
+} LeaderboardStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre (ou crée) la file et démarre le thread d'envoi.
+ *
+ * @param dir Dossier des sauvegardes.
+ * @param server "hôte:port[/chemin]" (NULL : file tenue sans envoi).
+ * @return false si le fichier n'est pas une file valide ou ne peut pas être créé.
+ */
+bool leaderboard_open(const char *dir, const char *server);
+
+/**
+ * @brief Ajoute la partie finie du modèle à la file (boucle de jeu, sans attente).
+ * @return false si la file est fermée ou l'écriture a échoué.
+ */
+bool leaderboard_submit(const GameModel *model);
+
+/**
+ * @brief Bilan courant de la file ouverte.
+ */
+void leaderboard_stats(LeaderboardStats *out);
+
+/**
+ * @brief Arrête le thread d'envoi (au plus une tentative en cours), force la file sur le disque et la ferme.
+ *
+ * @param out Reçoit le bilan (peut être NULL).
+ */
+void leaderboard_close(LeaderboardStats *out);
+
+/**
+ * @brief Lit l'état d'une file sans l'ouvrir en écriture (outil en ligne de commande).
+ * @return false si le fichier est absent ou invalide.
+ */
+bool leaderboard_status(const char *dir, LeaderboardStats *out);
+
+#endif // LEADERBOARD_H
@@ -0,0 +1,99 @@
+/**
+ * @file logger.h
+ * @brief Journal des messages du jeu, écrit par un thread d'arrière-plan.
+ *
+ * printf sur la boucle de jeu peut bloquer : stdout redirigé vers un tube
+ * lent, ou terminal partagé avec la Vue ncurses (dont il abîme l'écran).
+ * logger_write formate le message dans un enregistrement de taille fixe
+ * (LOG_RECORD_TEXT octets, tronqué au-delà) d'un anneau sans verrou à
+ * plusieurs producteurs : chaque emplacement porte un numéro de séquence,
+ * un producteur le réserve par compare-and-swap sur la position
+ * d'écriture, puis le publie en avançant ce numéro. Aucun appel ne
+ * bloque : anneau plein, le message est compté dans `logger_dropped` et
+ * perdu. Un thread vide l'anneau toutes les LOG_FLUSH_MS millisecondes.
+ *
+ * Niveaux : LOG_INFO et LOG_DEBUG vont sur stdout, LOG_WARN et LOG_ERROR sur
+ * stderr ; SPACE_INVADERS_LOG_LEVEL (debug, info, warn, error) fixe le
+ * seuil (info par défaut). logger_redirect envoie tous les niveaux dans un
+ * fichier, datés en secondes depuis le lancement : les Vues texte le font
+ * d'elles-mêmes (`sauvegardes/space_invaders.log`), SPACE_INVADERS_LOG=fichier
+ * l'impose.
+ *
+ * Sans thread (outils en ligne de commande, ou avant logger_start), un
+ * message est écrit aussitôt, comme par printf.
+ *
+ * @code
+ * logger_start();
+ * logger_write(LOG_INFO, "[SYSTEM] Chargement reussi : %s\n", path); // Tout thread
+ * logger_stop(); // Vide l'anneau, signale les messages perdus
+ * @endcode
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Journal */
+///@{
+#define LOG_RING 256                 ///< Enregistrements de l'anneau (puissance de 2).
+#define LOG_RECORD_TEXT 192          ///< Texte d'un enregistrement, zéro final compris.
+#define LOG_FLUSH_MS 10              ///< Intervalle de vidage du thread d'écriture.
+#define LOG_FILE "space_invaders.log" ///< Journal des Vues texte, dans le dossier des sauvegardes.
+///@}
+
+/**
+ * @brief Niveau d'un message.
+ */
+typedef enum
+{
+    LOG_DEBUG, ///< Détail de mise au point (masqué par défaut).
+    LOG_INFO,  ///< Déroulement normal (chargement, sauvegarde...).
+    LOG_WARN,  ///< Anomalie sans conséquence pour la partie.
+    LOG_ERROR, ///< Échec d'une opération.
+    LOG_LEVEL_COUNT
+} LogLevel;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lance le thread d'écriture ; les messages passent ensuite par l'anneau.
+ *
+ * Lit SPACE_INVADERS_LOG_LEVEL et SPACE_INVADERS_LOG.
+ *
+ * @return false si le thread n'a pas pu être créé (les messages restent écrits aussitôt).
+ */
+bool logger_start(void);
+
+/**
+ * @brief Journalise un message au format printf (tout thread, sans blocage une fois lancé).
+ */
+void logger_write(LogLevel level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Envoie les messages suivants dans un fichier (ajout en fin), ou de nouveau sur stdout/stderr.
+ *
+ * Les messages déjà dans l'anneau suivent la nouvelle destination.
+ *
+ * @param path Fichier, ou NULL pour revenir au terminal. SPACE_INVADERS_LOG, s'il est fixé, l'emporte.
+ */
+void logger_redirect(const char *path);
+
+/**
+ * @brief Messages perdus depuis le lancement (anneau plein).
+ */
+uint64_t logger_dropped(void);
+
+/**
+ * @brief Écrit les messages restants, arrête le thread et signale les messages perdus.
+ */
+void logger_stop(void);
+
+#endif // LOGGER_H
@@ -0,0 +1,95 @@
+/**
+ * @file membudget.h
+ * @brief Mémoire des ressources de la Vue SDL par sous-système, et plafonds configurables.
+ *
+ * La Vue garde des textures (planche des sprites, fonds plein écran, atlas
+ * de police, calques mis en cache), des copies en mémoire (planches des
+ * atlas) et des sons décodés en PCM. Chaque catégorie est comptée en octets
+ * (largeur x hauteur x octets par pixel, durée x taille d'une trame), à
+ * l'ouverture et dans le panneau de performances (F3).
+ *
+ * Un plafond par catégorie se règle en Mo avec
+ * SPACE_INVADERS_BUDGET_<CATÉGORIE> (SPRITES, BACKGROUNDS, TEXT, LAYERS,
+ * AUDIO). Au-delà, la Vue se replie sur moins : fonds divisés par deux en
+ * largeur et en hauteur jusqu'à tenir, calques à une échelle plus basse,
+ * sons qui ne tiennent plus laissés muets. Sprites et texte ne sont pas
+ * réduits : leur dépassement est seulement signalé.
+ *
+ * @code
+ * MemBudget mem;
+ * membudget_init(&mem);                          // Plafonds lus dans l'environnement
+ * int halvings = membudget_fit(&mem, MEM_BACKGROUNDS, used, bytes, 3);
+ * char line[128];
+ * membudget_format(&mem, line, sizeof(line));
+ * @endcode
+ */
+
+#ifndef MEMBUDGET_H
+#define MEMBUDGET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/**
+ * @brief Sous-systèmes comptés.
+ */
+typedef enum
+{
+    MEM_SPRITES,        ///< Planche des sprites.
+    MEM_BACKGROUNDS,    ///< Fonds plein écran (menus, jeu).
+    MEM_TEXT,           ///< Atlas de police (texture et copie en mémoire), cache de chaînes.
+    MEM_LAYERS,         ///< Calques et cibles de rendu (écran figé, monde, HUD, vague, miniatures...).
+    MEM_AUDIO,          ///< Sons résidents (PCM décodé ; la musique, lue en flux, n'y est pas).
+    MEM_CATEGORY_COUNT
+} MemCategory;
+
+/**
+ * @brief Octets en place et plafonds, par catégorie.
+ */
+typedef struct
+{
+    uint64_t bytes[MEM_CATEGORY_COUNT];   ///< Octets comptés.
+    uint64_t budget[MEM_CATEGORY_COUNT];  ///< Plafond en octets (0 : aucun).
+    uint32_t reduced[MEM_CATEGORY_COUNT]; ///< Ressources réduites ou écartées pour tenir le plafond.
+} MemBudget;
+
+// ============================================================================
+//                          API
+// ============================================================================
+
+/**
+ * @brief Remet les compteurs à zéro et lit les plafonds (SPACE_INVADERS_BUDGET_<CATÉGORIE>, en Mo).
+ */
+void membudget_init(MemBudget *mem);
+
+/**
+ * @brief Nom court d'une catégorie (journal, panneau).
+ */
+const char *membudget_name(MemCategory cat);
+
+/**
+ * @brief Divisions par deux (de chaque côté) qu'il faut à une image pour tenir dans le plafond.
+ *
+ * Chaque division divise `bytes` par quatre.
+ *
+ * @param used Octets déjà pris dans la catégorie (sans l'image).
+ * @param max_halvings Divisions permises au plus.
+ * @return 0 sans plafond ou si l'image tient telle quelle, -1 si elle ne tient pas même réduite.
+ */
+int membudget_fit(const MemBudget *mem, MemCategory cat, uint64_t used, uint64_t bytes, int max_halvings);
+
+/**
+ * @brief Total toutes catégories.
+ */
+uint64_t membudget_total(const MemBudget *mem);
+
+/**
+ * @brief Écrit une ligne de bilan ("sprites 0.4 Mo, fonds 11.3/8 Mo, ...").
+ */
+void membudget_format(const MemBudget *mem, char *out, size_t cap);
+
+#endif // MEMBUDGET_H
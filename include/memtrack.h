@@ -0,0 +1,61 @@
+/**
+ * @file memtrack.h
+ * @brief Compteur d'allocations de SDL (et de SDL_image, SDL_ttf, SDL_mixer).
+ *
+ * Les bibliothèques SDL allouent toutes par SDL_malloc : SDL_SetMemoryFunctions
+ * permet d'y glisser des fonctions qui comptent chaque appel avant de le
+ * confier à l'allocateur d'origine. On mesure ainsi le coût du démarrage de
+ * la Vue (textures, polices, sons) et, surtout, les allocations de chaque
+ * image : en partie, le chemin de rendu ne devrait plus en faire aucune.
+ *
+ * Les compteurs sont atomiques (les threads audio allouent aussi). Les octets
+ * vivants sont déduits de la taille réelle des blocs (malloc_usable_size,
+ * glibc) ; ailleurs, seuls les nombres d'appels sont comptés.
+ */
+
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          TYPES
+// ============================================================================
+
+/**
+ * @brief Compteurs cumulés depuis memtrack_install.
+ */
+typedef struct
+{
+    uint64_t allocs;     ///< Appels malloc / calloc / realloc (hors libération).
+    uint64_t frees;      ///< Blocs libérés.
+    int64_t live_bytes;  ///< Octets alloués et pas encore libérés.
+    int64_t peak_bytes;  ///< Maximum atteint par live_bytes.
+} MemtrackStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Installe les fonctions de comptage dans SDL.
+ *
+ * À appeler avant toute autre fonction SDL : un bloc alloué avant reste
+ * libérable, mais ses octets ne sont pas comptés.
+ *
+ * @return false si SDL a refusé les fonctions.
+ */
+bool memtrack_install(void);
+
+/**
+ * @brief Indique si les fonctions de comptage sont en place.
+ */
+bool memtrack_installed(void);
+
+/**
+ * @brief Lit les compteurs (instantané, sans verrou).
+ */
+void memtrack_stats(MemtrackStats *out);
+
+#endif // MEMTRACK_H
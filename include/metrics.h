@@ -0,0 +1,122 @@
+/**
+ * @file metrics.h
+ * @brief Métriques de flotte : compteurs et histogrammes exportés en StatsD ou au format texte Prometheus.
+ *
+ * Quelques mesures de santé d'un poste de jeu, agrégées sur toute la
+ * session : durée des images (PROF_FRAME, reprise de la sonde du
+ * profileur), images lentes (au-delà de METRICS_HITCH_S, ou de
+ * SPACE_INVADERS_HITCH_MS), temps de démarrage jusqu'à la première image,
+ * durée d'écriture des sauvegardes, parties lancées.
+ *
+ * La boucle de jeu ne fait que des additions atomiques relâchées, sans
+ * verrou ni appel système : un histogramme est un tableau de compteurs à
+ * bornes fixes (METRICS_BOUND_COUNT bornes). Éteintes (par défaut), les métriques
+ * ne coûtent qu'un test.
+ *
+ * Un thread d'arrière-plan les publie :
+ * - en StatsD (SPACE_INVADERS_STATSD=hôte:port) : toutes les
+ *   METRICS_FLUSH_S secondes, un datagramme UDP avec les compteurs de
+ *   l'intervalle (`|c`), les percentiles des histogrammes sur l'intervalle
+ *   et le temps de démarrage (`|g`, en millisecondes) ;
+ * - en Prometheus (SPACE_INVADERS_METRICS_PORT=port) : un point
+ *   `GET /metrics` en HTTP, qui rend les totaux de la session au format
+ *   texte (compteurs `_total`, histogrammes `_bucket`/`_sum`/`_count` en
+ *   secondes).
+ *
+ * @code
+ * metrics_start(getenv("SPACE_INVADERS_STATSD"), port);
+ * metrics_observe(METRIC_FRAME, frame_time);  // Tout thread
+ * metrics_count(METRIC_GAMES, 1);
+ * metrics_stop();
+ * @endcode
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Métriques */
+///@{
+#define METRICS_PREFIX "space_invaders"   ///< Préfixe des noms exportés.
+#define METRICS_FLUSH_S 10                ///< Intervalle des envois StatsD (s).
+#define METRICS_HITCH_S (2.0 / TARGET_FPS) ///< Image lente par défaut : deux pas de simulation.
+#define METRICS_BOUND_COUNT 20            ///< Bornes des histogrammes, de 1 ms à 1 s (plus une classe au-delà).
+///@}
+
+/**
+ * @brief Compteurs (totaux de la session).
+ */
+typedef enum
+{
+    METRIC_SESSIONS,      ///< Lancements du jeu interactif (1 par processus, plus 1 par redémarrage en kiosque).
+    METRIC_GAMES,         ///< Parties lancées (nouvelle partie ou chargement).
+    METRIC_HITCHES,       ///< Images au-delà du seuil d'image lente.
+    METRIC_SAVES,         ///< Sauvegardes du joueur écrites.
+    METRIC_SAVE_FAILURES, ///< Sauvegardes du joueur en échec.
+    METRIC_COUNTER_COUNT
+} MetricCounter;
+
+/**
+ * @brief Histogrammes (durées en secondes).
+ */
+typedef enum
+{
+    METRIC_FRAME, ///< Intervalle entre deux images.
+    METRIC_SAVE,  ///< Écriture d'une sauvegarde du joueur (fichier, fsync, index).
+    METRIC_HISTOGRAM_COUNT
+} MetricHistogram;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Active les métriques et lance le thread d'export.
+ *
+ * @param statsd Destination StatsD "hôte:port" (NULL ou vide : aucune).
+ * @param prometheus_port Port TCP du point `/metrics` (0 : aucun).
+ * @return false si aucun export n'a pu être ouvert (métriques éteintes).
+ */
+bool metrics_start(const char *statsd, int prometheus_port);
+
+/**
+ * @brief Indique si les métriques sont actives.
+ */
+bool metrics_enabled(void);
+
+/**
+ * @brief Ajoute `n` à un compteur (tout thread).
+ */
+void metrics_count(MetricCounter counter, uint32_t n);
+
+/**
+ * @brief Range une durée dans un histogramme (tout thread).
+ *
+ * Une observation de METRIC_FRAME au-delà du seuil compte aussi une image lente.
+ */
+void metrics_observe(MetricHistogram histogram, double seconds);
+
+/**
+ * @brief Fixe le temps de démarrage (lancement jusqu'à la première image affichée).
+ */
+void metrics_set_startup(double seconds);
+
+/**
+ * @brief Fixe le seuil d'image lente (s).
+ */
+void metrics_set_hitch_budget(double seconds);
+
+/**
+ * @brief Envoie un dernier datagramme StatsD, arrête le thread et ferme les sockets.
+ */
+void metrics_stop(void);
+
+#endif // METRICS_H
@@ -0,0 +1,88 @@
+/**
+ * @file mirror.h
+ * @brief Vue miroir : une seconde Vue, en lecture seule, qui suit la partie de la Vue principale.
+ *
+ * La Vue principale (SDL) garde les entrées et l'affichage de la borne ;
+ * un observateur (ncurses ou ANSI, dans le terminal qui a lancé le jeu,
+ * par exemple une session SSH) dessine la même partie sur son propre
+ * thread, à sa propre cadence (MIRROR_DEFAULT_HZ, ou
+ * SPACE_INVADERS_MIRROR_HZ).
+ *
+ * La boucle de jeu publie l'état affiché dans un passage d'instantanés
+ * (snapring.h) dont chaque emplacement est un modèle complet : une copie
+ * (model_copy) au plus à la cadence de l'observateur, sans verrou ni
+ * allocation. L'observateur prend toujours le plus récent ; s'il est lent,
+ * il saute des états, la Vue principale n'attend jamais. Il ne lit aucune
+ * entrée et ne joue aucun son.
+ *
+ * @code
+ * static MirrorView mirror;
+ * mirror_start(&mirror, &view_ansi, model, 20);  // Vue ouverte sur son thread
+ * mirror_publish(&mirror, model);                // Boucle de jeu, après le rendu
+ * mirror_stop(&mirror);
+ * @endcode
+ */
+
+#ifndef MIRROR_H
+#define MIRROR_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+#include "snapring.h"
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define MIRROR_DEFAULT_HZ 20 ///< Cadence de l'observateur par défaut (images/s).
+
+/**
+ * @brief Un observateur : sa Vue, son thread et les états qui lui sont publiés.
+ */
+typedef struct
+{
+    bool active;                 ///< Observateur lancé.
+    const ViewInterface *view;   ///< Vue de l'observateur (init et close sur son thread).
+    double period;               ///< Intervalle entre deux images de l'observateur (s).
+    SnapRing ring;               ///< États publiés (boucle de jeu -> observateur).
+    uint8_t *storage;            ///< SNAPRING_SLOTS modèles complets.
+    size_t size;                 ///< Taille d'un emplacement (block_size arrondi).
+    uint32_t seq;                ///< Numéro du dernier état publié (boucle de jeu).
+    double next;                 ///< Prochaine publication (boucle de jeu).
+    pthread_t thread;            ///< Thread de l'observateur.
+    int ready;                   ///< Vue ouverte : 1, échec : -1, en cours : 0 (atomique).
+    int stop;                    ///< Arrêt demandé (atomique).
+    uint64_t rendered;           ///< Images dessinées (thread de l'observateur).
+} MirrorView;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lance l'observateur : ouvre sa Vue sur son thread et lui publie l'état courant.
+ *
+ * @param model Modèle de la partie (dimensionne les emplacements).
+ * @param hz Cadence de l'observateur (images/s).
+ * @return false si la mémoire, le thread ou la Vue n'ont pas pu être obtenus (observateur inactif).
+ */
+bool mirror_start(MirrorView *mirror, const ViewInterface *view, const GameModel *model, int hz);
+
+/**
+ * @brief Publie l'état à afficher, au plus à la cadence de l'observateur (boucle de jeu uniquement).
+ *
+ * Sans effet si l'observateur est inactif.
+ */
+void mirror_publish(MirrorView *mirror, const GameModel *model);
+
+/**
+ * @brief Arrête l'observateur, ferme sa Vue et affiche son bilan.
+ */
+void mirror_stop(MirrorView *mirror);
+
+#endif // MIRROR_H
@@ -13,6 +13,7 @@
 #define MODEL_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -26,15 +27,23 @@
 #include <dirent.h> // Pour lire les dossiers sous Linux/Mac
 #endif
 
+#include "bvh.h"        // Pièces du vaisseau amiral (vagues `boss`)
 #include "common.h"     // Dimensions globales et FPS
 #include "controller.h" // Commandes abstraites (GameCommand)
+#include "ecs.h"        // Registre de composants (nouveaux genres d'entités)
+#include "save_index.h" // Métadonnées des sauvegardes (menu "Charger")
+#include "highscore.h"  // Table des meilleurs scores
+#include "params.h"     // Paramètres d'équilibrage (réglables à chaud)
+#include "spsc.h"       // File des événements audio
+#include "timeline.h"   // Transitions scriptées (fondus, changement d'état)
 
 // ============================================================================
 //                        CONSTANTES DE GAMEPLAY (ÉQUILIBRAGE)
 // ============================================================================
 
 /** @name Physique & Vitesses
- * Les vitesses sont exprimées en unités logiques par seconde.
+ * Les vitesses sont exprimées en unités logiques par seconde. Ce sont les
+ * valeurs par défaut de `SimState::params` (params.h), seules lues en jeu.
  */
 ///@{
 #define PLAYER_SPEED 40.0f     ///< Vitesse de déplacement horizontal du joueur.
@@ -55,10 +64,100 @@
 #define BULLET_HEIGHT 1 ///< Hauteur d'un tir.
 ///@}
 
+/** @name Formation des Envahisseurs
+ * La vague est une grille rigide : tous les aliens vivants se déplacent ensemble.
+ * La position d'un alien se déduit donc de l'origine de la formation et de son index.
+ */
+///@{
+#define FORMATION_ROWS 5                                 ///< Rangées de la grille d'une vague.
+#define FORMATION_COLS 11                                ///< Colonnes de la grille d'une vague.
+#define FORMATION_SIZE (FORMATION_ROWS * FORMATION_COLS) ///< Cases de la grille (55).
+#define FORMATION_START_X 5.0f                           ///< Origine X par défaut au début d'un niveau.
+#define FORMATION_START_Y 7.0f                           ///< Origine Y par défaut au début d'un niveau.
+#define FORMATION_STEP_X (ENEMY_WIDTH + 2)               ///< Pas horizontal par défaut entre deux colonnes.
+#define FORMATION_STEP_Y (ENEMY_HEIGHT + 2)              ///< Pas vertical par défaut entre deux rangées.
+///@}
+
+/** @name Vague sans fin (model_set_endless) */
+///@{
+#define ENDLESS_STREAM_SPEED 4.0f         ///< Descente des rangées qui entrent par le haut (unités par seconde).
+#define ENDLESS_ROWS_PER_LEVEL FORMATION_ROWS ///< Rangées entrées pour passer au niveau suivant.
+#define ENDLESS_DENSITY_BASE 50           ///< Chance (%) qu'une case d'une rangée neuve soit occupée, au niveau 0.
+#define ENDLESS_DENSITY_PER_LEVEL 5       ///< Chance ajoutée à chaque niveau (plafonnée à 100 %).
+///@}
+
+/** @brief Nombre de mots 64 bits d'un masque couvrant `n` balles. */
+#define BULLET_MASK_WORDS(n) (((n) + 63) / 64)
+
+/** @name Capacités des pools
+ * Les tableaux des pools sont découpés dans une arène allouée avec le modèle
+ * (un seul bloc, dimensionné par model_init) : la boucle de jeu n'alloue rien.
+ */
+///@{
+#define MODEL_MAX_BULLET_CAPACITY 32767 ///< Plus grande capacité du pool de balles (index en `short`).
+#define MODEL_PLAYER_BULLET_SHARE 3     ///< Part des slots réservée aux tirs du joueur par défaut (1 / 3).
+#define MODEL_ARENA_ALIGN 64            ///< Alignement de chaque tableau de l'arène (une ligne de cache).
+///@}
+
+/**
+ * @brief Balles vivantes à partir desquelles les tests de la section F se répartissent sur les workers (workers.h).
+ * En deçà, réveiller les threads coûte plus que les tests eux-mêmes.
+ */
+#define MODEL_PARALLEL_BULLETS 2048
+
+/**
+ * @name Tests de collision par lots (section F3)
+ *
+ * Les lots testent chaque cible contre tout le bloc [0, high_water), slots
+ * libres compris ; la liste des balles vivantes ne teste que les balles. En
+ * deçà de MODEL_BATCH_HITS_MIN balles, ou d'une balle vivante pour
+ * MODEL_BATCH_HITS_DENSITY slots, la liste l'emporte (mesuré : pools pleins
+ * de 8 à 2000 balles, puis vidés d'un slot sur 2 à 16).
+ */
+///@{
+#define MODEL_BATCH_HITS_MIN 24    ///< Balles vivantes à partir desquelles les lots peuvent servir.
+#define MODEL_BATCH_HITS_DENSITY 3 ///< Slots du bloc par balle vivante au-delà desquels la liste sert.
+///@}
+
+/** @name Pas groupé (model_step_batch) */
+///@{
+#define MODEL_BATCH_LANES 4096 ///< Slots de balles intégrés par appel du noyau, tous mondes confondus.
+#define MODEL_BATCH_WORLDS 256 ///< Mondes rangés au plus dans les tranches avant intégration.
+#define MODEL_BATCH_SLICE 1024 ///< Slots intégrés par tâche quand l'intégration est répartie (multiple de 64).
+#define MODEL_PARALLEL_WORLDS 64 ///< Mondes à partir desquels model_step_batch se répartit sur les workers.
+///@}
+
+/** @name Physique déterministe (model_set_fixed_point)
+ * Positions, vitesses et timers passent par des entiers Q16.16 à chaque tick,
+ * avec une durée de tick fixe : mêmes entrées, mêmes états, bit à bit, quels
+ * que soient le compilateur, le processeur ou les noyaux SIMD. Les valeurs
+ * restent rangées en `float` : sous 256 unités, un Q16.16 y tient exactement.
+ * La durée du tick est arrondie par excès : un délai (cadence de tir,
+ * invulnérabilité) ne dure jamais un tick de plus qu'en flottants.
+ */
+///@{
+#define MODEL_FIXED_SHIFT 16                      ///< Bits de la partie fractionnaire.
+#define MODEL_FIXED_ONE (1 << MODEL_FIXED_SHIFT) ///< Une unité logique (ou une seconde).
+#define MODEL_FIXED_TICK ((MODEL_FIXED_ONE + TARGET_FPS - 1) / TARGET_FPS) ///< Durée d'un tick, arrondie par excès (1093, soit 1/59,96 s).
+///@}
+
+/** @name Fréquence de simulation (model_set_tick_rate) */
+///@{
+#define MODEL_TICK_RATE_MIN 10  ///< Ticks par seconde au plus lent.
+#define MODEL_TICK_RATE_MAX 500 ///< Ticks par seconde au plus rapide.
+///@}
+
 /** @name Système de Sauvegarde */
 ///@{
-#define MAX_SAVE_FILES 10   ///< Nombre maximum de fichiers affichés dans le menu "Charger".
-#define MAX_FILENAME_LEN 32 ///< Taille maximale du nom d'un fichier (ex: "Partie1").
+#define MAX_SAVE_FILES 64     ///< Nombre maximum de sauvegardes listées (les plus récentes).
+#define SAVE_MENU_PAGE_SIZE 8 ///< Sauvegardes affichées par page dans les menus.
+#define MAX_FILENAME_LEN 32   ///< Taille maximale du nom d'un fichier (ex: "Partie1").
+///@}
+
+/** @name Départs de niveau (Game Over : « réessayer le niveau ») */
+///@{
+#define MODEL_LEVEL_STARTS 2          ///< Départs de niveau gardés en mémoire (anneau).
+#define MODEL_LEVEL_START_BYTES 2048  ///< Taille maximale d'un départ encodé (au-delà : pas mémorisé).
 ///@}
 
 /** @name Configuration du Jeu */
@@ -68,12 +167,50 @@
 #define MAX_LIVES_NORMAL 3   ///< Nombre de vies données au début d'une nouvelle partie.
 ///@}
 
+/** @name Bonus (vagues `drops`, cf. wave.h)
+ * Un alien abattu lâche parfois un bonus, entité du registre (ecs.h) qui
+ * tombe jusqu'au bas de l'écran : le vaisseau qui le touche le ramasse.
+ */
+///@{
+#define POWERUP_WIDTH 3            ///< Largeur d'un bonus.
+#define POWERUP_HEIGHT 2           ///< Hauteur d'un bonus.
+#define POWERUP_SPEED 12.0f        ///< Vitesse de chute d'un bonus.
+#define POWERUP_TIME 8.0f          ///< Durée du tir rapide et du tir triple (s).
+#define POWERUP_RAPID_RELOAD 0.2f  ///< Rechargement sous tir rapide (0,5 s sinon).
+#define POWERUP_SPREAD_OFFSET 3.0f ///< Écart des tirs latéraux du tir triple.
+///@}
+
+/** @name Boucliers en bitmap (model_set_shield_bitmap)
+ * Chaque bunker de 8 × 6 unités est une grille d'occupation de 32 × 24
+ * cellules (4 par unité), une ligne par mot de 32 bits (bit k : colonne k,
+ * depuis la gauche). Un tir teste les cellules sous sa hitbox et creuse un
+ * cratère autour du point d'impact ; il traverse les parties déjà détruites.
+ */
+///@{
+#define SHIELD_BITMAP_SCALE 4                          ///< Cellules par unité logique.
+#define SHIELD_BITMAP_COLS 32                          ///< Colonnes (8 unités, un mot par ligne).
+#define SHIELD_BITMAP_ROWS 24                          ///< Lignes (6 unités).
+///@}
+
 /** @name Configuration OVNI (Bonus) */
 ///@{
-#define UFO_POINTS 60   ///< Score de base gagné en détruisant l'OVNI (peut être randomisé).
-#define UFO_SPEED 10.0f ///< Vitesse de déplacement latéral de l'OVNI.
-#define UFO_WIDTH 4     ///< Largeur logique de l'OVNI.
-#define UFO_HEIGHT 2    ///< Hauteur logique de l'OVNI.
+#define UFO_POINTS 60      ///< Score de base gagné en détruisant l'OVNI (peut être randomisé).
+#define UFO_SPEED 10.0f    ///< Vitesse de déplacement latéral de l'OVNI.
+#define UFO_SPAWN_ODDS 500 ///< L'OVNI a une chance sur autant d'apparaître à chaque tick.
+#define UFO_WIDTH 4        ///< Largeur logique de l'OVNI.
+#define UFO_HEIGHT 2       ///< Hauteur logique de l'OVNI.
+///@}
+
+/** @name Vaisseau amiral (vagues `boss`, cf. wave.h) */
+///@{
+#define BOSS_MAX_PARTS BVH_MAX_LEAVES ///< Pièces au plus (une feuille du BVH chacune).
+#define BOSS_COLS 12                  ///< Pièces des deux rangées du haut ; chaque rangée suivante en perd deux.
+#define BOSS_PART_WIDTH 4             ///< Largeur d'une pièce.
+#define BOSS_PART_HEIGHT 2            ///< Hauteur d'une pièce.
+#define BOSS_PART_HEALTH 2            ///< Impacts pour détruire une pièce de la coque.
+#define BOSS_BRIDGE_HEALTH 4          ///< Impacts pour détruire une pièce de la rangée du haut (le pont).
+#define BOSS_START_Y 6.0f             ///< Altitude du haut de la coque.
+#define BOSS_SPEED 6.0f               ///< Vitesse latérale, intact (doublée quand il ne reste qu'une pièce).
 ///@}
 
 // ============================================================================
@@ -87,13 +224,18 @@
  */
 typedef enum
 {
-    ENTITY_PLAYER,        ///< Le Vaisseau du joueur.
-    ENTITY_BULLET_PLAYER, ///< Projectile tiré par le joueur (monte vers le haut).
-    ENTITY_BULLET_ENEMY,  ///< Projectile tiré par un ennemi (descend vers le bas).
-    ENTITY_ENEMY_TYPE_1,  ///< Ennemi rangée du bas (Pieuvre) - Rapporte 10 pts.
-    ENTITY_ENEMY_TYPE_2,  ///< Ennemi rangée du milieu (Crabe) - Rapporte 20 pts.
-    ENTITY_ENEMY_TYPE_3,  ///< Ennemi rangée du haut (Calamar) - Rapporte 40 pts.
-    ENTITY_UFO            ///< Soucoupe bonus mystère (apparitions aléatoires).
+    ENTITY_PLAYER,         ///< Le Vaisseau du joueur.
+    ENTITY_BULLET_PLAYER,  ///< Projectile tiré par le joueur (monte vers le haut).
+    ENTITY_BULLET_ENEMY,   ///< Projectile tiré par un ennemi (descend vers le bas).
+    ENTITY_ENEMY_TYPE_1,   ///< Ennemi rangée du bas (Pieuvre) - Rapporte 10 pts.
+    ENTITY_ENEMY_TYPE_2,   ///< Ennemi rangée du milieu (Crabe) - Rapporte 20 pts.
+    ENTITY_ENEMY_TYPE_3,   ///< Ennemi rangée du haut (Calamar) - Rapporte 30 pts.
+    ENTITY_UFO,            ///< Soucoupe bonus mystère (apparitions aléatoires).
+    ENTITY_POWERUP_RAPID,  ///< Bonus tir rapide (registre, vagues `drops`).
+    ENTITY_POWERUP_SPREAD, ///< Bonus tir triple (registre, vagues `drops`).
+    ENTITY_POWERUP_REPAIR, ///< Bonus réparation des boucliers (registre, vagues `drops`).
+    ENTITY_BOSS_PART,      ///< Pièce du vaisseau amiral (vagues `boss`).
+    ENTITY_TYPE_COUNT      ///< Nombre de types (taille de entity_types, cf. entity_type.h).
 } EntityType;
 
 /**
@@ -114,6 +256,7 @@ typedef enum
     STATE_LOAD_MENU,         ///< Menu listant les fichiers .dat disponibles.
     STATE_OVERWRITE_CONFIRM, ///< Pop-up "Fichier existant : Écraser ou Copier ?".
     STATE_SAVE_SELECT,       ///< Menu intermédiaire "Nouvelle Sauvegarde" vs "Écraser".
+    STATE_SAVING,            ///< Écriture de la sauvegarde en cours (thread d'arrière-plan).
     STATE_SAVE_SUCCESS       ///< Message temporaire "Sauvegarde Réussie !".
 } GameStateEnum;
 
@@ -138,17 +281,162 @@ typedef struct
     EntityType type; ///< Catégorie de l'entité.
 
     // Gameplay
-    float shoot_timer; ///< Temps restant avant de pouvoir tirer à nouveau (Cooldown).
+    int shoot_timer; ///< Ticks restants avant de pouvoir tirer à nouveau (Cooldown).
 
     // Animation
-    float anim_timer; ///< Timer interne pour alterner les sprites.
+    int anim_timer;  ///< Ticks écoulés depuis le dernier changement de sprite.
     int anim_frame;   ///< Index du sprite d'animation (ex: 0=Bras levés, 1=Bras baissés).
 
     // État Explosion
     bool exploding;      ///< True si l'entité est en train de mourir.
-    float explode_timer; ///< Durée restante de l'animation d'explosion.
+    int explode_timer;   ///< Ticks restants de l'animation d'explosion.
 } Entity;
 
+/**
+ * @brief Liste compacte des index occupés d'un pool.
+ *
+ * `items[0 .. count-1]` contient les index vivants, dans un ordre quelconque.
+ * `pos[i]` donne la place de l'index i dans `items` : le retrait se fait en O(1)
+ * en échangeant avec le dernier élément (swap-remove). Les boucles de mise à jour
+ * et de rendu ne parcourent ainsi que les objets vivants.
+ * Les deux tableaux (autant de cases que le pool) sont dans l'arène du modèle.
+ */
+typedef struct
+{
+    short *items; ///< Index occupés.
+    short *pos;   ///< Position de chaque index dans `items`.
+    int count;    ///< Nombre d'index occupés.
+} ActiveList;
+
+/** @name Camps du pool de balles (index de `free_count` et `dropped_spawns`) */
+///@{
+#define BULLET_SIDE_PLAYER 0 ///< Tirs du joueur : slots [0, player_slots).
+#define BULLET_SIDE_ENEMY 1  ///< Tirs ennemis : slots [player_slots, capacity).
+#define BULLET_SIDES 2       ///< Nombre de camps.
+///@}
+
+/**
+ * @brief Pool de projectiles au format "Structure of Arrays" (SoA).
+ *
+ * Chaque champ est un tableau dense : les passes de déplacement et de nettoyage
+ * ne parcourent que `y`, `dy` et le masque `active`, sans charger les timers
+ * d'animation. La hitbox est fixe (BULLET_WIDTH × BULLET_HEIGHT).
+ * Les slots sont partagés en deux camps de tailles fixées à model_init : les
+ * tirs du joueur en bas du pool, les tirs ennemis au-dessus. Un camp plein ne
+ * prend rien à l'autre (une salve ennemie ne fait plus perdre de tir au
+ * joueur), et les tests de collision de chaque camp portent sur son bloc seul.
+ * Chaque camp empile ses slots libres dans `free_slots` (la pile du joueur à
+ * partir de 0, celle des ennemis à partir de `player_slots`) : tirer et
+ * libérer coûtent O(1).
+ * Les Vues passent par model_get_bullet() pour obtenir une Entity classique.
+ * Les tableaux (`capacity` cases) pointent dans l'arène du modèle.
+ */
+typedef struct
+{
+    // Données chaudes (parcourues à chaque tick)
+    float *x;             ///< Positions X (coin haut-gauche).
+    float *y;             ///< Positions Y (coin haut-gauche).
+    float *dy;            ///< Vitesses verticales (- monte, + descend).
+    uint64_t *active;     ///< Bit i à 1 : le slot i est occupé (`mask_words` mots).
+
+    // Données froides
+    EntityType *type;     ///< ENTITY_BULLET_PLAYER ou ENTITY_BULLET_ENEMY.
+    int *anim_timer;      ///< Ticks écoulés dans la frame d'animation courante.
+    int *anim_frame;      ///< Frame d'animation (0 à 3).
+
+    // Allocation
+    short *free_slots;    ///< Piles des index libres des deux camps (sommet = prochain tir).
+    int capacity;         ///< Nombre de slots (choisi à model_init).
+    int player_slots;     ///< Slots du joueur, en bas du pool (les ennemis ont le reste).
+    int mask_words;       ///< BULLET_MASK_WORDS(capacity).
+    int free_count[BULLET_SIDES];     ///< Nombre d'index dans la pile de chaque camp.
+    int dropped_spawns[BULLET_SIDES]; ///< Tirs perdus faute de slot libre dans le camp (dimensionnement).
+    int high_water;       ///< 1 + plus grand index alloué (borne des passes SIMD).
+    int player_high;      ///< 1 + plus grand index alloué au joueur (borne de ses tests).
+    ActiveList live;      ///< Slots occupés (parcours dense).
+
+    // Interceptions (vagues `intercept`, cf. wave.h) : slots vivants triés sur X (SweepList, collision.h)
+    short *sweep_order;     ///< Index par x croissant (`2 * capacity` cases, la moitié haute de travail).
+    uint64_t *sweep_member; ///< Bit i à 1 : le slot i est dans `sweep_order` (`mask_words` mots).
+    int sweep_count;        ///< Index dans `sweep_order`.
+} BulletPool;
+
+/**
+ * @brief Créneau de la roue des explosions : les aliens qui finissent d'exploser ensemble.
+ *
+ * Les aliens touchés au même tick avec la même durée partagent un seul timer :
+ * un tick n'avance que quelques créneaux, jamais un timer par alien.
+ */
+typedef struct
+{
+    uint64_t mask; ///< Aliens du créneau (bits de Formation.dying_mask).
+    int timer;     ///< Ticks restants de leur animation d'explosion.
+} ExplosionSlot;
+
+/**
+ * @brief Pool d'envahisseurs au format SoA.
+ *
+ * L'état vivant/explosé est porté par les masques de la Formation ; les positions
+ * ne sont stockées que pour les aliens en cours d'explosion (figées à l'impact).
+ * Les tableaux (MAX_ENEMIES cases) pointent dans l'arène du modèle.
+ */
+typedef struct
+{
+    float *x;             ///< Position X figée (valide si explosion en cours).
+    float *y;             ///< Position Y figée (valide si explosion en cours).
+    EntityType *type;     ///< Type d'alien (ENTITY_ENEMY_TYPE_1 à 3).
+    ActiveList live;      ///< Aliens à afficher (vivants ou en explosion).
+    ExplosionSlot explosions[FORMATION_SIZE]; ///< Roue des explosions, par ordre d'impact (un alien au moins par créneau).
+    int explosion_count;  ///< Créneaux occupés.
+} EnemyPool;
+
+/**
+ * @brief État collectif de la vague d'envahisseurs.
+ *
+ * L'alien d'index `i` (rangée `i / FORMATION_COLS`, colonne `i % FORMATION_COLS`)
+ * se trouve en `origin + (col * step_x, row * step_y)`. Forme, espacement,
+ * vitesse et cadence de tir viennent de la vague du niveau (wave.h).
+ * Déplacer la vague revient à déplacer l'origine : une seule écriture par tick.
+ * La boîte englobante se déduit de l'origine et des colonnes extrêmes en cache.
+ * Un alien touché fige sa position dans l'EnemyPool le temps de son explosion.
+ */
+typedef struct
+{
+    float origin_x;      ///< Position X de la colonne 0 (coords logiques).
+    float origin_y;      ///< Position Y de la rangée 0 (coords logiques).
+    uint64_t alive_mask; ///< Bit i à 1 : l'alien i est vivant (actif et non explosé).
+    uint64_t dying_mask; ///< Bit i à 1 : l'alien i joue son animation d'explosion.
+
+    // Constantes de la vague du niveau (WaveSpec), recopiées par init_enemies
+    float step_x;        ///< Pas horizontal entre deux colonnes.
+    float step_y;        ///< Pas vertical entre deux rangées.
+    int size;            ///< Aliens au début de la vague.
+    float speed;         ///< Multiplicateur de vitesse au départ.
+    float speedup;       ///< Gain de vitesse quand toute la vague est tombée.
+    int fire_chance;     ///< Cadence de tir ennemi (% des ticks à TARGET_FPS), pour ce niveau.
+    bool intercept;      ///< Les tirs du joueur et des aliens s'annulent quand ils se croisent.
+    int drop_chance;     ///< Chance qu'un alien abattu lâche un bonus (%).
+
+    // Caches maintenus à chaque impact (évitent de rescanner la vague à chaque tick)
+    int alive_count; ///< Nombre de bits à 1 dans alive_mask.
+    int min_col;     ///< Colonne vivante la plus à gauche (-1 si vague vide).
+    int max_col;     ///< Colonne vivante la plus à droite (-1 si vague vide).
+    int8_t bottom[FORMATION_COLS]; ///< Index de l'alien vivant le plus bas de chaque colonne (-1 : colonne vide).
+
+    // Segment de trajectoire en cours (sim.formation_path) : entre deux rebonds,
+    // origin_x = path_x0 + path_ticks × pas d'un tick à path_rate
+    float path_x0;    ///< Origine X au début du segment.
+    float path_rate;  ///< Vitesse signée du segment (unités par seconde).
+    int path_ticks;   ///< Ticks de marche depuis le début du segment (-1 : aucun segment).
+    int path_edge;    ///< Tick du segment où la vague touche son bord (calculé à l'ouverture).
+    int path_min_col; ///< Colonne vivante la plus à gauche à l'ouverture.
+    int path_max_col; ///< Colonne vivante la plus à droite à l'ouverture.
+
+    // Vague sans fin (sim.endless) : rangées neuves entrées par le haut
+    float stream_lag; ///< Hauteur que la vague doit encore descendre (rangées entrées, pas encore en place).
+    int stream_rows;  ///< Rangées entrées depuis le début du niveau.
+} Formation;
+
 /**
  * @brief Entité Spéciale : L'OVNI (Mystery Ship).
  * Séparé car il a des règles d'apparition uniques.
@@ -163,10 +451,36 @@ typedef struct
     bool active;              ///< Est-il visible à l'écran ?
     bool hasSpawnedThisLevel; ///< Sécurité pour limiter à 1 OVNI par niveau.
     bool exploding;           ///< En cours d'explosion.
-    float explode_timer;      ///< Timer explosion.
+    int explode_timer;        ///< Ticks restants de l'explosion.
     EntityType type;          ///< Toujours ENTITY_UFO.
 } Ufo;
 
+/**
+ * @brief Entité Spéciale : le vaisseau amiral, fait de pièces destructibles (vagues `boss`).
+ *
+ * Chaque pièce a sa boîte (BOSS_PART_WIDTH × BOSS_PART_HEIGHT, à sa case de
+ * la coque) et ses points de vie ; le vaisseau disparaît avec sa dernière
+ * pièce. Les balles ne testent pas les pièces une à une : elles passent par
+ * le BVH des pièces, en coordonnées relatives à (x, y), que le déplacement
+ * du vaisseau ne touche pas. Seule la destruction d'une pièce le remet à
+ * jour (bvh_set_leaf). Cases et BVH se déduisent de `parts` et de
+ * `alive_mask` (model_rebuild_indexes) : ni sauvegardés, ni hachés.
+ */
+typedef struct
+{
+    bool active;                   ///< En jeu (au moins une pièce intacte).
+    float x;                       ///< Position X du coin haut-gauche de la coque.
+    float y;                       ///< Position Y du coin haut-gauche de la coque.
+    float width;                   ///< Largeur de la coque intacte (rebonds sur les bords).
+    float dx;                      ///< Vitesse latérale signée.
+    int parts;                     ///< Pièces au début de la vague (1 à BOSS_MAX_PARTS).
+    uint64_t alive_mask;           ///< Bit k à 1 : la pièce k est intacte.
+    int8_t health[BOSS_MAX_PARTS]; ///< Impacts restants de chaque pièce.
+    uint8_t col[BOSS_MAX_PARTS];   ///< Colonne de chaque pièce dans la coque.
+    uint8_t row[BOSS_MAX_PARTS];   ///< Rangée de chaque pièce (0 : le pont, en haut).
+    Bvh bvh;                       ///< Boîtes des pièces intactes, relatives à (x, y).
+} Boss;
+
 /**
  * @brief Entité Spéciale : Bouclier (Bunker).
  * Objet statique destructible pixel par pixel (ou par niveau de dégradation).
@@ -179,33 +493,119 @@ typedef struct
     float height; ///< Hauteur du bouclier.
     int health;   ///< Points de vie (0 à 10). Détermine le sprite "abîmé".
     bool active;  ///< True tant que health > 0.
+    uint32_t bits[SHIELD_BITMAP_ROWS]; ///< Cellules intactes (mode bitmap ; health en suit la proportion).
 } Shield;
 
 /**
- * @brief Système de drapeaux (Flags) Audio.
- * Pattern "Fire-and-Forget" : Le Modèle demande un son (true), la Vue le joue et reset (false).
+ * @brief Sons ponctuels que le Modèle peut demander.
+ */
+typedef enum
+{
+    AUDIO_SHOOT,            ///< Tir du joueur.
+    AUDIO_INVADER_KILLED,   ///< Mort d'un alien ou de l'OVNI.
+    AUDIO_PLAYER_EXPLOSION, ///< Mort du joueur.
+    AUDIO_SELECT,           ///< "Bip" de menu.
+    AUDIO_GAME_OVER,        ///< Jingle défaite.
+    AUDIO_LEVEL_UP,         ///< Jingle niveau suivant.
+    AUDIO_BEAT,             ///< Rythme "Cœur" des aliens : AUDIO_BEAT + note (0 à 3).
+    AUDIO_SOUND_COUNT = AUDIO_BEAT + 4 ///< Nombre de sons.
+} AudioSound;
+
+/**
+ * @brief Un son demandé, tel qu'il arrive à la Vue.
  */
 typedef struct
 {
-    // SFX (Sons ponctuels)
-    bool play_shoot;            ///< Demande de bruit de tir.
-    bool play_invader_killed;   ///< Demande de bruit de mort alien.
-    bool play_player_explosion; ///< Demande de bruit de mort joueur.
-    bool play_select_sound;     ///< Demande de "Bip" menu.
-    bool play_game_over;        ///< Demande de jingle défaite.
-    bool play_level_up;         ///< Demande de jingle niveau suivant.
-
-    // Musique / Ambiance
-    bool play_beat;   ///< Trigger pour le rythme "Cœur" des aliens qui accélère.
+    AudioSound sound; ///< Son à jouer.
+    float pan;        ///< Position stéréo (-1 : gauche, 0 : centre, 1 : droite), d'après le x de l'émetteur.
+    float gain;       ///< Volume relatif (0 à 1).
+} AudioEvent;
+
+/**
+ * @brief État audio du Modèle.
+ *
+ * Chaque son ponctuel est un AudioEvent déposé dans la file SPSC de la Vue
+ * (deux morts au même tick font deux sons, rien n'attend le prochain rendu).
+ * Le Modèle n'en est que le producteur, depuis le thread qui le fait avancer :
+ * il n'a jamais besoin d'écrire dans l'état qu'on dessine. Sans file (mode
+ * headless, rejeu sans Vue), les sons sont ignorés.
+ */
+typedef struct
+{
+    SpscRing *events; ///< File d'événements de la Vue (NULL : aucun son).
     int beat_index;   ///< Note actuelle du rythme (0, 1, 2, 3).
     bool ufo_loopING; ///< État continu : L'OVNI est présent (Son moteur en boucle).
 } SoundState;
 
 /**
- * @brief Structure Principale (God Object).
- * Contient l'intégralité des données du jeu. C'est ce bloc mémoire qui est
- * écrit sur le disque lors d'une sauvegarde (Serialization).
+ * @brief Événements de jeu journalisés (télémétrie, cf. telemetry.h).
+ */
+typedef enum
+{
+    TELEMETRY_GAME_START, ///< Partie lancée (kind : 0 nouvelle partie, 1 chargement, 2 niveau réessayé).
+    TELEMETRY_SHOT,       ///< Tir du joueur (kind : balles tirées).
+    TELEMETRY_KILL,       ///< Alien abattu (kind : EntityType de l'alien).
+    TELEMETRY_UFO_SPAWN,  ///< Apparition de l'OVNI.
+    TELEMETRY_UFO_KILL,   ///< OVNI abattu.
+    TELEMETRY_DEATH,      ///< Vaisseau touché (lives : vies restantes).
+    TELEMETRY_LEVEL_UP,   ///< Vague terminée (level : nouveau niveau).
+    TELEMETRY_GAME_OVER,  ///< Plus de vies.
+    TELEMETRY_EVENT_COUNT
+} TelemetryEventType;
+
+/**
+ * @brief Un événement de jeu, daté du tick de la session (16 octets).
+ */
+typedef struct
+{
+    uint32_t tick;  ///< Ticks simulés depuis le branchement de la file.
+    uint8_t type;   ///< TelemetryEventType.
+    uint8_t kind;   ///< Précision selon le type.
+    uint8_t level;  ///< Niveau au moment de l'événement.
+    uint8_t lives;  ///< Vies restantes.
+    int16_t x;      ///< Abscisse de l'événement (unités de jeu).
+    int16_t y;      ///< Ordonnée de l'événement (unités de jeu).
+    int32_t score;  ///< Score après l'événement.
+} TelemetryEvent;
+
+/**
+ * @brief Sortie de télémétrie du Modèle.
+ *
+ * Comme les sons, chaque événement part dans une file SPSC dont le Modèle
+ * est le seul producteur ; sans file (par défaut), rien n'est émis et le
+ * tick n'avance pas. Une file pleine perd l'événement (SpscRing::dropped).
+ */
+typedef struct
+{
+    SpscRing *events; ///< File du journal (NULL : aucune télémétrie).
+    uint32_t tick;    ///< Ticks simulés depuis le branchement.
+} TelemetryState;
+
+/**
+ * @brief Générateur pseudo-aléatoire propre à un modèle (PCG32).
+ *
+ * Remplace `rand()` : l'état vit dans le GameModel, donc deux parties lancées
+ * avec la même graine se déroulent à l'identique, et plusieurs modèles peuvent
+ * tourner en parallèle sans se perturber (ni verrou global de la libc).
+ */
+typedef struct
+{
+    uint64_t state; ///< État interne.
+    uint64_t inc;   ///< Incrément (toujours impair), dérivé de la graine.
+    uint64_t seed;  ///< Graine d'origine (rejouabilité, sauvegardes).
+} ModelRng;
+
+/** @brief Graine utilisée par model_init (parties reproductibles par défaut). */
+#define MODEL_RNG_DEFAULT_SEED 0x5EED1A7E5ULL
+
+/**
+ * @brief État simulé (partie chaude du modèle).
  *
+ * Tout ce dont dépend la suite de la simulation : machine à états, acteurs,
+ * pools avec leurs listes actives, stats, IA de la vague, timers, générateur.
+ * Les passes de model_update ne lisent et n'écrivent que ce bloc (et l'arène
+ * des pools) ; les menus, la saisie, la liste des fichiers et l'audio sont
+ * dans UiState. Un instantané (ModelSnapshot) en est une copie brute.
  */
 typedef struct
 {
@@ -213,12 +613,16 @@ typedef struct
     GameStateEnum state;          ///< État courant.
     GameStateEnum previous_state; ///< État précédent (pour retour après Pause).
 
-    // --- Les Acteurs (Tableaux statiques pour éviter malloc en jeu) ---
+    // --- Les Acteurs (tableaux dans l'arène : aucun malloc en jeu) ---
     Entity player;               ///< Le Joueur.
-    Entity enemies[MAX_ENEMIES]; ///< Le tableau des envahisseurs.
-    Entity bullets[MAX_BULLETS]; ///< Le pool de projectiles.
+    Entity player2;              ///< Le second joueur (coopération, cf. model_set_coop ; inactif en solo).
+    EnemyPool enemies;           ///< Les envahisseurs (SoA).
+    Formation formation;         ///< Origine et masques de vie de la vague.
+    BulletPool bullets;          ///< Le pool de projectiles (SoA).
     Ufo ufo;                     ///< L'OVNI bonus.
+    Boss boss;                   ///< Le vaisseau amiral (vagues `boss` ; inactif sinon).
     Shield shields[MAX_SHIELDS]; ///< Les bunkers.
+    EcsWorld ecs;                ///< Registre des autres genres d'entités (cf. ecs.h).
 
     // --- Stats Partie ---
     int score;            ///< Score actuel.
@@ -234,40 +638,302 @@ typedef struct
 
     // --- Animation Globale ---
     int animation_frame;   ///< Frame globale (0/1) synchronisant tous les aliens.
-    float animation_timer; ///< Timer pour battre la mesure de l'animation.
+    int animation_timer;   ///< Ticks écoulés depuis le dernier battement de l'animation.
 
     // --- Timers Divers ---
-    float game_over_timer;    ///< Bloque les inputs quelques secondes après la mort.
-    float hit_timer;          ///< Temps d'invulnérabilité après un impact.
-    float save_success_timer; ///< Temps d'affichage du message de succès sauvegarde.
+    int game_over_timer;    ///< Ticks écoulés depuis la fin de partie.
+    int hit_timer;          ///< Ticks d'invulnérabilité restants après un impact.
+    Timeline transition;    ///< Enchaînement en cours (sortie du message de sauvegarde, du Game Over).
 
+    // --- Bonus (partagés en coopération) ---
+    int rapid_timer;  ///< Ticks de tir rapide restants.
+    int spread_timer; ///< Ticks de tir triple restants.
+
+    // --- Aléatoire ---
+    ModelRng rng; ///< Générateur de la simulation (apparitions, tirs ennemis).
+
+    // --- Tirs Ennemis ---
+    bool fire_scheduled; ///< Tirs planifiés (loi exponentielle) ; false : tirage à chaque tick (anciennes sessions).
+    float fire_timer;    ///< Secondes avant le prochain tir planifié.
+
+    // --- Physique ---
+    bool fixed_point; ///< Ticks en virgule fixe Q16.16, `dt` ignoré (model_set_fixed_point).
+    bool shield_bitmap; ///< Boucliers érodés cellule par cellule (model_set_shield_bitmap).
+    bool swept_bullets; ///< Collisions des balles sur tout leur trajet du tick (model_set_swept_bullets).
+    bool exact_timers;  ///< Durées arrondies au tick ; false : ticks de l'ancien décompte flottant (anciennes sessions).
+    bool formation_path; ///< Vague en segments (tick du rebond calculé d'avance) ; false : pas à pas (anciennes sessions).
+    bool level_retry;    ///< Départs de niveau mémorisés, option « réessayer » au Game Over ; false : anciennes sessions.
+    bool endless;        ///< Vague sans fin : rangées recyclées en continu, jamais de nouvelle vague (model_set_endless).
+    double tick_dt;     ///< Durée du dernier tick simulé (conversions secondes <-> ticks).
+    SimParams params;   ///< Vitesses, descente, OVNI et cadence de tir (params.h ; réglables à chaud).
+
+    // --- Coopération ---
+    bool coop; ///< Deux vaisseaux, vies et score partagés (model_set_coop).
+} SimState;
+
+/**
+ * @brief Domaines des compteurs de génération (UiState::gen).
+ *
+ * Chaque modification d'un domaine lui donne une nouvelle valeur, tirée d'une
+ * horloge commune à tous les modèles du processus (model_touch) : deux
+ * valeurs égales désignent toujours le même contenu, même d'un modèle à sa
+ * copie (triple buffer, interpolation). Une Vue qui garde la valeur du
+ * domaine déjà dessiné sait d'une comparaison si elle peut sauter son travail.
+ * Les écritures en bloc de l'état simulé (chargement, restauration, rollback)
+ * renouvellent tous les domaines (model_touch_all).
+ */
+typedef enum
+{
+    MODEL_GEN_ANY,       ///< Toute modification (compteur global, renouvelé avec chaque domaine).
+    MODEL_GEN_HUD,       ///< Score, vies, niveau.
+    MODEL_GEN_MENU,      ///< État, sélection, volume, saisie, liste des sauvegardes.
+    MODEL_GEN_FORMATION, ///< Positions, morts et explosions des aliens.
+    MODEL_GEN_SHIELDS,   ///< Boucliers.
+    MODEL_GEN_BULLETS,   ///< Balles (positions, apparitions, retraits).
+    MODEL_GEN_COUNT
+} ModelGen;
+
+/**
+ * @brief Départ de niveau mémorisé : l'état compact (save_encode_level_start) juste après init_enemies.
+ */
+typedef struct
+{
+    int level;                              ///< Niveau commencé.
+    uint16_t len;                           ///< Octets de `data` (0 : case vide).
+    uint8_t data[MODEL_LEVEL_START_BYTES];  ///< Instantané encodé, sans les départs eux-mêmes.
+} LevelStart;
+
+/**
+ * @brief Options de l'écran de Game Over (model_game_over_options).
+ */
+typedef enum
+{
+    GAME_OVER_RETRY,  ///< Reprendre au début du niveau perdu (model_retry_level).
+    GAME_OVER_SAVE,   ///< Sauvegarder.
+    GAME_OVER_REPLAY, ///< Nouvelle partie.
+    GAME_OVER_QUIT,   ///< Quitter.
+    GAME_OVER_OPTION_COUNT
+} GameOverOption;
+
+/**
+ * @brief Interface, fichiers et audio (partie froide du modèle).
+ *
+ * Lu et écrit par les menus (model_handle_input) et les Vues ; la simulation
+ * n'y touche que pour émettre les sons (et leur état continu), classer le
+ * score au Game Over et demander la sortie après le message de sauvegarde.
+ */
+typedef struct
+{
     // --- Interface & Menus ---
     int menu_selection;                  ///< Index de l'élément sélectionné (0, 1, 2...).
     char input_buffer[MAX_FILENAME_LEN]; ///< Buffer stockant ce que le joueur tape (Sauvegarde).
 
     // --- Système de Fichiers ---
-    char save_files[MAX_SAVE_FILES][256]; ///< Cache des noms de fichiers trouvés dans /saves.
-    int save_file_count;                  ///< Nombre de fichiers valides trouvés.
-    char current_filename[64];            ///< Nom du fichier actuellement chargé (pour écrasement rapide).
-    bool pending_quit;                    ///< Flag demandant la fermeture propre de la boucle principale.
+    SaveIndexEntry save_files[MAX_SAVE_FILES]; ///< Sauvegardes listées (index), de la plus récente à la plus ancienne.
+    int save_file_count;                       ///< Nombre de sauvegardes listées.
+    bool save_scan_pending;                    ///< Liste encore en lecture en fond (model_scan_saves).
+    char current_filename[SAVE_NAME_LEN];      ///< Nom du fichier de la dernière sauvegarde lancée (miniature de la Vue SDL).
+    bool pending_quit;                         ///< Flag demandant la fermeture propre de la boucle principale (menus "Quitter", fin de sauvegarde).
+
+    // --- Meilleurs Scores ---
+    HighscoreTable highscores; ///< Top des scores (chargé au lancement par la boucle de jeu).
+    int highscore_rank;        ///< Rang de la dernière partie terminée (0 : hors classement).
 
     // --- Audio ---
-    SoundState sounds; ///< État des demandes sonores.
+    SoundState sounds; ///< Sortie audio et état continu (boucle OVNI).
     int volume;        ///< Volume global (0-100).
     bool is_muted;     ///< Mode muet.
+
+    // --- Énergie ---
+    int power_mode; ///< Mode d'énergie courant (PowerMode, power.h), posé à chaque image par la boucle de jeu.
+
+    // --- Départs de niveau (hors état simulé : ni haché, ni rembobiné) ---
+    LevelStart level_starts[MODEL_LEVEL_STARTS]; ///< Anneau des derniers départs de niveau.
+    int level_start_head;                        ///< Prochaine case écrite.
+
+    // --- Télémétrie ---
+    TelemetryState telemetry; ///< Journal des événements de jeu (telemetry.h).
+
+    // --- Générations ---
+    uint64_t gen[MODEL_GEN_COUNT]; ///< Dernière modification de chaque domaine (ModelGen, jamais 0).
+} UiState;
+
+/**
+ * @brief Structure Principale : état simulé, puis interface.
+ * C'est ce bloc mémoire qui est écrit sur le disque lors d'une sauvegarde (Serialization).
+ *
+ * Les tableaux des pools suivent la structure dans la même allocation
+ * (l'arène, `block_size` octets en tout) : copier un modèle passe donc par
+ * model_clone() ou model_copy(), qui recâblent les pointeurs des pools ;
+ * model_copy_sim() ne recopie que `sim` et l'arène.
+ */
+typedef struct
+{
+    SimState sim;      ///< Partie simulée (chaude).
+    UiState ui;        ///< Menus, fichiers, meilleurs scores, audio (froide).
+    size_t block_size; ///< Taille de l'allocation : structure puis arène des pools.
 } GameModel;
 
+/**
+ * @brief Instantané : état simulé suivi d'une copie de l'arène des pools.
+ *
+ * Alloué par model_snapshot_create() pour une capacité donnée. Le bloc ne
+ * contient aucun pointeur : model_diff compare ses octets tels quels.
+ */
+typedef struct
+{
+    SimState state;    ///< Partie simulée (pointeurs des pools à NULL).
+    uint8_t arrays[];  ///< Tableaux des pools, dans l'ordre de l'arène.
+} ModelSnapshot;
+
 // ============================================================================
 //                          PROTOTYPES PUBLICS (API)
 // ============================================================================
 
+/**
+ * @brief Choisit la capacité du pool de balles des prochains model_init.
+ *
+ * @param capacity Nombre de slots, de 2 à MODEL_MAX_BULLET_CAPACITY (MAX_BULLETS par défaut).
+ * @return false (capacité inchangée) si elle est hors bornes.
+ */
+bool model_set_bullet_capacity(int capacity);
+
+/**
+ * @brief Choisit la part des slots réservée aux tirs du joueur des prochains model_init.
+ *
+ * @param slots Slots du joueur (0 : capacité / MODEL_PLAYER_BULLET_SHARE), ramenés
+ *              à model_init entre 1 et capacité - 1 (un slot au moins pour chaque camp).
+ * @return false (réglage inchangé) si `slots` est hors bornes.
+ */
+bool model_set_player_bullets(int slots);
+
+/**
+ * @brief Taille du bloc d'un modèle créé maintenant (structure et arène, cf. `block_size`).
+ *
+ * Sert à dimensionner la mémoire de la boucle de jeu (workset_init) une fois
+ * la capacité choisie.
+ */
+size_t model_block_bytes(void);
+
+/**
+ * @brief Active la physique déterministe (virgule fixe) pour les prochains model_init.
+ *
+ * Chaque tick dure alors MODEL_FIXED_TICK, quel que soit le `dt` passé à
+ * model_update, et les balles sont intégrées par une boucle entière plutôt
+ * que par les noyaux SIMD. Les parties diffèrent légèrement de celles en
+ * flottants (arrondis) : un enregistrement garde le mode dans son en-tête.
+ */
+void model_set_fixed_point(bool on);
+
+/**
+ * @brief Active les boucliers en bitmap (érosion cellule par cellule) pour les prochains model_init.
+ *
+ * Sans ce mode, le premier impact n'importe où sur un bunker lui retire un
+ * point de vie. En mode bitmap, seul un tir qui rencontre une cellule intacte
+ * est arrêté ; il creuse un cratère, et `health` suit la part de cellules
+ * restantes (les Vues et les bots qui ne lisent que `health` continuent de
+ * fonctionner). Le mode est gardé par les sauvegardes et les enregistrements.
+ */
+void model_set_shield_bitmap(bool on);
+
+/**
+ * @brief Active les collisions balayées des balles pour les prochains model_init.
+ *
+ * Une balle est d'ordinaire testée à sa seule position de fin de tick : au-delà
+ * d'un déplacement de BULLET_HEIGHT par tick (simulation sous TARGET_FPS, ou
+ * balles plus rapides), elle peut traverser un alien sans le toucher. En mode
+ * balayé, chaque balle est testée sur le segment parcouru pendant le tick
+ * (sa boîte étirée de l'ancienne à la nouvelle position), et elle touche la
+ * première cible rencontrée dans le sens du tir. Les cibles sont prises à leur
+ * position de fin de tick. Le mode est gardé par les enregistrements.
+ */
+void model_set_swept_bullets(bool on);
+
+/**
+ * @brief Choisit la vague sans fin pour les prochains model_init.
+ *
+ * La vague n'est plus jamais reconstruite : dès que la rangée du bas est
+ * vide, la grille glisse d'une rangée et une rangée tirée au sort (cases et
+ * type, densité croissante avec le niveau) entre par le haut, puis descend
+ * à ENDLESS_STREAM_SPEED jusqu'à sa place. Les cases vidées sont réutilisées
+ * sur place : la mémoire ne dépend pas du niveau. Le niveau monte toutes les
+ * ENDLESS_ROWS_PER_LEVEL rangées, sans transition (cadence de tir de la
+ * table des vagues, espacement de la première vague pour toute la partie).
+ * Les départs de niveau ne sont pas mémorisés à chaque passage : « réessayer »
+ * reprend au début de la partie. Le mode est gardé par les sauvegardes et
+ * les enregistrements.
+ */
+void model_set_endless(bool on);
+
+/**
+ * @brief Choisit la coopération locale pour les prochains model_init.
+ *
+ * Chaque modèle part en coopération (model_set_coop) : les deux vaisseaux
+ * jouent sur la même machine, le second aux commandes `CMD_HELD_P2`, que la
+ * Vue tire de la seconde manette ou de ses touches (cf. view_sdl.h). Le mode
+ * est gardé par les sauvegardes (bloc du second joueur) et les
+ * enregistrements (REPLAY_FLAG_COOP).
+ */
+void model_set_local_coop(bool on);
+
+/**
+ * @brief Cellules intactes d'un bouclier sous un rectangle logique (mode bitmap).
+ *
+ * @return Leur nombre (0 si le rectangle tombe hors du bouclier).
+ */
+int model_shield_cells(const Shield *shield, float x, float y, float w, float h);
+
+/**
+ * @brief Passe un modèle en coopération à deux vaisseaux (ou le ramène en solo).
+ *
+ * Le second vaisseau ne répond qu'aux commandes `CMD_HELD_P2 | INPUT_*`.
+ * Les deux joueurs partagent score, vies et invulnérabilité : un impact sur
+ * l'un ou l'autre coûte une vie. Les vaisseaux sont replacés (au tiers et aux
+ * deux tiers de l'écran), comme à chaque nouvelle partie.
+ */
+void model_set_coop(GameModel *model, bool coop);
+
 /**
  * @brief Initialise le modèle (Constructeur).
- * Alloue la structure et configure les valeurs par défaut (Niveau 1, Score 0).
+ * Alloue la structure et son arène en un bloc, puis configure les valeurs
+ * par défaut (Niveau 1, Score 0).
  * @return Un pointeur vers le nouveau GameModel.
  */
 GameModel *model_init(void);
 
+/**
+ * @brief Alloue une copie complète d'un modèle (même capacité, même état).
+ * @return La copie (à libérer par model_free), ou NULL si l'allocation échoue.
+ */
+GameModel *model_clone(const GameModel *model);
+
+/**
+ * @brief Recopie `src` dans `dst`, deux modèles de même capacité (aucune allocation).
+ *
+ * Remplace `memcpy(dst, src, sizeof(GameModel))` : les pointeurs des pools de
+ * `dst` sont recâblés sur sa propre arène.
+ */
+void model_copy(GameModel *dst, const GameModel *src);
+
+/**
+ * @brief Recopie seulement l'état simulé (`sim` et l'arène) ; `dst->ui` reste intact.
+ *
+ * Pour un état qui ne sert qu'à la simulation ou à l'interpolation : les
+ * menus, la liste des sauvegardes et les meilleurs scores ne sont pas recopiés.
+ */
+void model_copy_sim(GameModel *dst, const GameModel *src);
+
+/**
+ * @brief Ramène le modèle à l'accueil, comme après model_init, sans rien libérer ni réallouer.
+ *
+ * La partie en cours (score, vies, balles, entités, transition) est effacée
+ * et `pending_quit` retombe ; réglages, meilleurs scores, liste des
+ * sauvegardes et branchements (audio, télémétrie) sont gardés. La Vue, qui
+ * n'est pas touchée, garde ses textures et ses sons : c'est le redémarrage
+ * à chaud d'une borne entre deux joueurs (`--kiosk`).
+ */
+void model_restart(GameModel *model);
+
 /**
  * @brief Libère la mémoire (Destructeur).
  */
@@ -279,30 +945,399 @@ void model_free(GameModel *model);
  */
 void model_update(GameModel *model, double dt);
 
+/**
+ * @brief Même tick que model_update, par le chemin le plus simple (test différentiel, cf. difftest.h).
+ *
+ * Sections A à E communes, sur des caches de la vague refaits depuis son
+ * masque de vie ; balles prises slot par slot et impacts testés balle par
+ * balle contre chaque alien et chaque cible, sans chemin spécialisé, noyau
+ * SIMD, masque de collisions, workers, case calculée ni BVH. Un état égal
+ * doit en sortir, bit à bit.
+ */
+void model_update_reference(GameModel *model, double dt);
+
+/**
+ * @brief Avance `n` mondes indépendants d'un tick (entraînement, balayages d'équilibrage).
+ *
+ * Équivaut, bit à bit, à `model_handle_input(models[i], cmds[i])` puis
+ * `model_update(models[i], dt)` pour chaque monde ; les balles de tous les
+ * mondes sont intégrées par un même appel du noyau SIMD (tranches SoA de
+ * MODEL_BATCH_LANES slots sur la pile, aucune allocation).
+ *
+ * @param cmds Une commande par monde, ou NULL (aucune commande).
+ */
+void model_step_batch(GameModel **models, const GameCommand *cmds, int n, double dt);
+
 /**
  * @brief Traite une commande abstraite (Input).
  */
 void model_handle_input(GameModel *model, GameCommand cmd);
 
+/**
+ * @brief Applique à un vaisseau une commande de jeu du joueur 1, comme model_handle_input en STATE_PLAYING.
+ *
+ * Seule la vitesse (`dx`) change : CMD_HELD (gauche et droite ensemble
+ * s'annulent), CMD_MOVE_LEFT/RIGHT, CMD_NONE (arrêt). Le vaisseau peut être
+ * une copie hors du modèle (prédiction d'un client réseau, cf. netpredict.h).
+ *
+ * @return true si la commande demande un tir (CMD_SHOOT, tir maintenu).
+ */
+bool model_ship_command(const GameModel *model, Entity *ship, GameCommand cmd);
+
+/**
+ * @brief Déplacement d'un vaisseau pendant un tick : section C de model_update, seule.
+ *
+ * `x` avance de `dx` (pendant `dt`, ou d'un tick MODEL_FIXED_TICK si `fixed`)
+ * puis reste dans l'aire de jeu. Même calcul, bit à bit, que model_update :
+ * rejoué hors du modèle, il donne la position qu'aura le vaisseau du serveur.
+ *
+ * @param fixed Physique en virgule fixe (sim.fixed_point du modèle simulé).
+ */
+void model_step_ship(Entity *ship, bool fixed, double dt);
+
+/**
+ * @brief Traite une commande venant de la Vue, y compris CMD_EXIT.
+ *
+ * CMD_EXIT ouvre la confirmation "Voulez-vous quitter ?" ; un second CMD_EXIT
+ * pendant cette confirmation demande l'arrêt immédiat. Utilisée par la boucle
+ * de jeu et par le mode replay, pour que les deux suivent le même chemin.
+ * Le Modèle ne quitte jamais le processus : les menus "Quitter" lèvent
+ * `pending_quit`, et c'est l'appelant qui décide.
+ *
+ * @return false si la commande demande de quitter immédiatement (second CMD_EXIT ou menu "Quitter").
+ */
+bool model_dispatch_command(GameModel *model, GameCommand cmd);
+
+/**
+ * @brief Renouvelle la génération d'un domaine (et le compteur global MODEL_GEN_ANY).
+ *
+ * Appelée par le Modèle à chaque modification ; thread-safe (horloge atomique).
+ */
+void model_touch(GameModel *model, ModelGen domain);
+
+/**
+ * @brief Renouvelle tous les domaines : à appeler après avoir écrit l'état simulé en bloc.
+ */
+void model_touch_all(GameModel *model);
+
 /**
  * @brief Accesseur lecture seule pour le joueur.
  * Permet à la Vue de savoir où dessiner le joueur sans risquer de le modifier.
  */
 const Entity *model_get_player(const GameModel *model);
 
+/**
+ * @brief Position X courante d'un ennemi.
+ * Les aliens vivants ne stockent pas leur position : elle est déduite de la formation.
+ */
+float model_get_enemy_x(const GameModel *model, int i);
+
+/**
+ * @brief Position Y courante d'un ennemi (voir model_get_enemy_x).
+ */
+float model_get_enemy_y(const GameModel *model, int i);
+
+/**
+ * @brief Origine de la vague dans `ticks` ticks de jeu, si aucun alien n'est abattu d'ici là.
+ *
+ * La trajectoire est une suite de segments à vitesse constante séparés par
+ * les rebonds : le tick de chaque rebond se calcule directement, sans simuler
+ * les ticks intermédiaires. Le coût suit le nombre de rebonds, pas `ticks`.
+ * Exacte en sessions à sim.formation_path (à l'arrondi près sinon).
+ */
+void model_formation_at(const GameModel *model, int ticks, float *x, float *y);
+
+/**
+ * @brief Ticks d'explosion restants d'un alien (0 s'il n'explose pas).
+ */
+int model_get_enemy_explode_timer(const GameModel *model, int i);
+
+/**
+ * @brief Reconstitue un ennemi sous forme d'Entity (lecture seule, pour les Vues).
+ * @param out Entity remplie si l'ennemi est actif (vivant ou en explosion).
+ * @return false si le slot est vide.
+ */
+bool model_get_enemy(const GameModel *model, int i, Entity *out);
+
+/**
+ * @brief Reconstitue une pièce du vaisseau amiral sous forme d'Entity (lecture seule, pour les Vues).
+ * @param out Entity remplie si la pièce est intacte.
+ * @return false si la pièce est détruite ou si le vaisseau n'est pas en jeu.
+ */
+bool model_get_boss_part(const GameModel *model, int k, Entity *out);
+
+/**
+ * @brief Reconstitue une balle sous forme d'Entity (lecture seule, pour les Vues).
+ * @param out Entity remplie si le slot est occupé.
+ * @return false si le slot est libre.
+ */
+bool model_get_bullet(const GameModel *model, int i, Entity *out);
+
+/**
+ * @brief Trajectoire d'une balle au pas fixe du jeu (1 / TARGET_FPS), telle que model_update la simule.
+ *
+ * Une balle file en ligne droite et change de sprite à intervalle régulier :
+ * de quoi prédire sa position et son sprite bien des ticks à l'avance (netframe.h).
+ *
+ * @param step Déplacement vertical par tick, en Q16.16 (MODEL_FIXED_ONE par unité).
+ * @param anim_ticks Ticks entre deux sprites.
+ * @param anim_phase Ticks écoulés depuis le dernier changement de sprite.
+ * @return false si le slot est libre.
+ */
+bool model_get_bullet_motion(const GameModel *model, int i, int32_t *step, int *anim_ticks, int *anim_phase);
+
+// --- Timers ---
+
+/**
+ * @brief Fixe la fréquence de simulation (ticks par seconde), indépendante de l'affichage.
+ *
+ * Les durées de jeu sont en secondes : à 30 comme à 120 Hz, la partie va à la
+ * même vitesse, seul le grain des ticks change. À appeler avant le premier
+ * tick (la durée du tick sert aussi aux conversions des timers) ; le pas passé
+ * ensuite à model_update doit être 1.0 / hz. Sans effet en virgule fixe, dont
+ * le tick reste MODEL_FIXED_TICK.
+ *
+ * @param hz Fréquence, ramenée entre MODEL_TICK_RATE_MIN et MODEL_TICK_RATE_MAX.
+ */
+void model_set_tick_rate(GameModel *model, int hz);
+
+/**
+ * @brief Fréquence de simulation courante (TARGET_FPS en virgule fixe).
+ */
+int model_tick_rate(const GameModel *model);
+
+/**
+ * @brief Ticks d'un décompte qui part de `seconds` (timer lu dans une sauvegarde, un paquet réseau).
+ *
+ * Virgule fixe : ⌈Q16.16 / MODEL_FIXED_TICK⌉. Flottants : durée arrondie au
+ * tick de sim.tick_dt ; sans sim.exact_timers, le nombre de pas flottants que
+ * mettait l'ancien timer à passer sous zéro.
+ */
+int model_countdown_ticks(const GameModel *model, float seconds);
+
+/**
+ * @brief Secondes d'un décompte de `ticks` : le milieu du dernier tick (model_countdown_ticks les retrouve).
+ */
+float model_countdown_seconds(const GameModel *model, int ticks);
+
+/**
+ * @brief Ticks écoulés correspondant à `seconds` (timer qui compte vers le haut), au plus proche.
+ */
+int model_elapsed_ticks(const GameModel *model, float seconds);
+
+/**
+ * @brief Secondes de `ticks` ticks écoulés.
+ */
+float model_elapsed_seconds(const GameModel *model, int ticks);
+
+/**
+ * @brief Liste compacte des ennemis à afficher (vivants ou en explosion).
+ * @param indices Reçoit un pointeur vers les index (valide jusqu'au prochain model_update).
+ * @return Le nombre d'index.
+ */
+int model_get_live_enemies(const GameModel *model, const short **indices);
+
+/**
+ * @brief Liste compacte des balles actives (voir model_get_live_enemies).
+ */
+int model_get_live_bullets(const GameModel *model, const short **indices);
+
+/**
+ * @brief Indique qu'aucun tick ne changera l'état tant qu'aucune commande n'arrive.
+ *
+ * Vrai dans les menus figés (principal, tutoriel, chargement, choix de
+ * l'emplacement, pause, confirmation de sortie), sauf pendant la lecture des
+ * sauvegardes en fond : la boucle de jeu peut alors attendre une entrée au
+ * lieu de redessiner à 60 Hz (cf. ViewInterface::wait_input).
+ */
+bool model_is_idle(const GameModel *model);
+
+/**
+ * @brief Options de l'écran de Game Over, dans l'ordre d'affichage (index = menu_selection).
+ *
+ * « Réessayer le niveau » vient en tête quand un départ de niveau est
+ * mémorisé (model_retry_level) ; sinon la liste commence à GAME_OVER_SAVE.
+ *
+ * @return Nombre d'options écrites dans `out`.
+ */
+int model_game_over_options(const GameModel *model, GameOverOption out[GAME_OVER_OPTION_COUNT]);
+
+/**
+ * @brief Niveau que « réessayer » reprendrait au Game Over (0 : aucun départ mémorisé).
+ *
+ * Chaque niveau commencé (nouvelle partie, vague suivante) encode l'état
+ * compact de son premier tick dans un petit anneau en mémoire. Au Game Over,
+ * « réessayer » restaure le plus récent, au niveau courant ou avant, en
+ * quelques microsecondes : ni fichier, ni passage par le menu. Les
+ * instantanés de rejeu portent l'anneau : un rejeu repris en cours de route
+ * réessaie comme la session.
+ */
+int model_retry_level(const GameModel *model);
+
+// --- Audio ---
+
+/**
+ * @brief Branche le Modèle sur la file d'événements audio d'une Vue.
+ *
+ * Le thread qui fait avancer le modèle devient le seul producteur de la file.
+ *
+ * @param events File fournie par la Vue, ou NULL pour ignorer les sons.
+ */
+void model_set_audio_sink(GameModel *model, SpscRing *events);
+
+// --- Télémétrie ---
+
+/**
+ * @brief Branche le Modèle sur la file d'un journal de télémétrie (cf. telemetry.h).
+ *
+ * Remet le tick de la session à 0. Comme pour l'audio, le thread qui fait
+ * avancer le modèle devient le seul producteur de la file.
+ *
+ * @param events File du journal, ou NULL pour ne plus rien émettre.
+ */
+void model_set_telemetry_sink(GameModel *model, SpscRing *events);
+
+// --- Générateur Aléatoire ---
+
+/**
+ * @brief (Ré)initialise le générateur du modèle à partir d'une graine.
+ */
+void model_rng_seed(GameModel *model, uint64_t seed);
+
+/**
+ * @brief Tire un entier 32 bits uniforme.
+ */
+uint32_t model_rng_next(GameModel *model);
+
+/**
+ * @brief Tire un entier dans [0, bound) (bound > 0).
+ * Réduction par multiplication (sans division), biais négligeable pour de petites bornes.
+ */
+uint32_t model_rng_below(GameModel *model, uint32_t bound);
+
+// --- Instantanés de Simulation ---
+
+/**
+ * @brief Alloue un instantané (vide) à la capacité d'un modèle.
+ * @return L'instantané (à libérer par model_snapshot_free), ou NULL.
+ */
+ModelSnapshot *model_snapshot_create(const GameModel *model);
+
+/**
+ * @brief Libère un instantané (NULL accepté).
+ */
+void model_snapshot_free(ModelSnapshot *snap);
+
+/**
+ * @brief Taille en octets d'un instantané (état et tableaux des pools).
+ */
+size_t model_snapshot_size(const ModelSnapshot *snap);
+
+/**
+ * @brief Taille maximale d'un delta produit par model_diff depuis `snap`.
+ */
+size_t model_diff_max_size(const ModelSnapshot *snap);
+
+/**
+ * @brief Copie la partie simulée du modèle dans un instantané préalloué.
+ * @return false si l'instantané a été créé pour une autre capacité.
+ */
+bool model_snapshot(const GameModel *model, ModelSnapshot *snap);
+
+/**
+ * @brief Restaure la partie simulée du modèle (menus, fichiers et audio intacts).
+ * @return false (modèle intact) si l'instantané vient d'une autre capacité.
+ */
+bool model_restore(GameModel *model, const ModelSnapshot *snap);
+
+/**
+ * @brief Encode les octets qui diffèrent entre deux instantanés.
+ *
+ * Format : suite de `[saut varint | longueur varint | octets]`, chaque saut
+ * étant compté depuis la fin de la plage précédente. Deux instantanés à un
+ * tick d'écart ne diffèrent que de quelques dizaines d'octets.
+ *
+ * @param buf Destination (model_diff_max_size octets suffisent toujours).
+ * @param len Reçoit la taille du delta (0 si les instantanés sont identiques).
+ * @return false si `buf` est trop petit ou si les capacités diffèrent.
+ */
+bool model_diff(const ModelSnapshot *from, const ModelSnapshot *to, uint8_t *buf, size_t cap, size_t *len);
+
+/**
+ * @brief Applique à `snap` un delta produit par model_diff depuis ce même instantané.
+ * @return false (instantané intact) si le delta est invalide.
+ */
+bool model_apply_diff(ModelSnapshot *snap, const uint8_t *diff, size_t len);
+
 // --- Gestion des Sauvegardes ---
 
 /**
- * @brief Scanne le dossier de sauvegarde.
- * Remplit `model->save_files` avec les noms des fichiers .dat trouvés.
+ * @brief Vide les tableaux du pool d'ennemis (avant de décoder une vague).
+ */
+void model_clear_enemies(GameModel *model);
+
+/**
+ * @brief Range un alien déjà marqué dans dying_mask dans la roue des explosions (décodage d'une vague).
+ *
+ * @param timer Ticks d'explosion restants.
+ */
+void model_add_enemy_explosion(GameModel *model, int i, int timer);
+
+/**
+ * @brief Ajoute un bonus qui tombe depuis (x, y) (décodage d'une sauvegarde).
+ *
+ * @param kind ENTITY_POWERUP_RAPID, ENTITY_POWERUP_SPREAD ou ENTITY_POWERUP_REPAIR.
+ * @return false si le registre est plein.
+ */
+bool model_add_powerup(GameModel *model, float x, float y, EntityType kind);
+
+/**
+ * @brief Vide les tableaux du pool de balles (avant de décoder ses balles).
+ * La pile des slots libres est reconstruite par model_rebuild_indexes.
+ */
+void model_clear_bullets(GameModel *model);
+
+/**
+ * @brief Active une balle décodée dans le bloc de son camp et l'ajoute en fin de liste active.
+ *
+ * Les appels successifs donnent l'ordre de résolution. Seuls l'index, le bit
+ * d'activité et le type sont posés : le décodeur remplit le reste du slot.
+ *
+ * @param slot Index souhaité (celui de l'émetteur), gardé s'il est libre et dans
+ *             le bloc du camp ; sinon (ou -1) le premier slot libre du camp.
+ * @return L'index de la balle, ou -1 si le camp est plein.
+ */
+int model_restore_bullet(GameModel *model, int slot, EntityType type);
+
+/**
+ * @brief Reconstruit listes actives, piles des slots libres et caches de la vague
+ * à partir des bits d'activité et des masques (après un décodage de sauvegarde).
+ * Les cases et le BVH du vaisseau amiral sont refaits depuis `parts` et `alive_mask`.
+ */
+void model_rebuild_indexes(GameModel *model);
+
+/**
+ * @brief Active une balle, comme un tir en jeu (pool plein : tir perdu).
+ * Sert à composer des scénarios hors partie (bancs d'essai de bench/).
+ *
+ * @param dy Vitesse verticale (- monte, + descend).
+ */
+void model_spawn_bullet(GameModel *model, float x, float y, float dy, EntityType type);
+
+/**
+ * @brief Lance la lecture de la liste des sauvegardes en fond (cf. save_index_scan_start).
+ * `model->ui.save_files` (nom, date, niveau, score, triée par récence) se remplit
+ * ensuite au fil des ticks, jusqu'à ce que `ui.save_scan_pending` repasse à false.
  */
 void model_scan_saves(GameModel *model);
 
 /**
- * @brief Sauvegarde binaire.
- * Ecrit l'intégralité de la structure `GameModel` dans un fichier.
+ * @brief Sauvegarde binaire (asynchrone).
+ * Encode l'état de jeu et confie l'écriture au thread de save_writer.h ;
+ * `model_update` passe en STATE_SAVE_SUCCESS une fois le fichier durable.
+ * @return false si la sauvegarde n'a pas pu être lancée.
  */
-void model_save_named(const GameModel *model, const char *filename);
+bool model_save_named(const GameModel *model, const char *filename);
 
 /**
  * @brief Chargement binaire.
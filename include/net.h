@@ -0,0 +1,153 @@
+/**
+ * @file net.h
+ * @brief Mode réseau : un serveur fait autorité, des clients affichent et prédisent leur vaisseau.
+ *
+ * Le serveur simule seul la partie, au pas fixe du jeu et en temps réel. Les
+ * clients (Vue SDL, ncurses ou sans Vue) lui envoient leurs commandes et
+ * dessinent les images qu'il diffuse (netframe.h), interpolées à travers un
+ * tampon de gigue ; seul le vaisseau du joueur est simulé en avance, puis
+ * recalé sur chaque image (netpredict.h).
+ *
+ * Tout passe par UDP. Chaque paquet commence par `"SI" | version u8 | type u8`.
+ *
+ * @code
+ * client -> serveur  HELLO  partie u32                          (connexion, répétée jusqu'à la première image)
+ *                    INPUT  image reçue u32 | 1re commande u32 | n u8 | commandes u8 × n
+ *                    BYE                                        (départ)
+ * serveur -> client  SNAP   tick u32 | tick de base u32 | commandes reçues u32 | rôle u8 | delta
+ * @endcode
+ *
+ * Une image n'est envoyée que tous les NET_SEND_EVERY ticks, sous forme de delta
+ * (codec_diff) depuis la dernière image que le client a accusée ; base 0 : image
+ * complète (delta depuis une image nulle), quand le client n'a encore rien accusé
+ * ou que son accusé est sorti de l'historique. Une image perdue n'est jamais
+ * renvoyée : la suivante repart de la dernière base accusée.
+ *
+ * Les commandes sont numérotées ; chaque INPUT répète toutes celles que le
+ * serveur n'a pas encore accusées, une perte ne coûte donc qu'un aller-retour.
+ * Seul le premier client connecté joue, les suivants regardent ; au départ du
+ * joueur, le plus ancien spectateur prend la main.
+ *
+ * Des deux côtés, un thread réseau lit le socket par rafales bornées et
+ * décode sur place, dans des emplacements réservés d'avance ; la simulation
+ * du serveur et le rendu du client n'en prennent que l'image complète la plus
+ * récente (snapring.h), sans verrou ni allocation. Un afflux de paquets ne
+ * ralentit donc jamais le pas du jeu.
+ *
+ * @code
+ * ./space_invaders server 7777 600        # 10 minutes sur le port 7777
+ * ./space_invaders client 127.0.0.1 7777 sdl
+ * @endcode
+ */
+
+#ifndef NET_H
+#define NET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hub.h"
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Protocole */
+///@{
+#define NET_DEFAULT_PORT 7777 ///< Port UDP par défaut.
+#define NET_VERSION 2         ///< Version du protocole (paquets d'une autre version ignorés).
+#define NET_MAX_CLIENTS 8     ///< Clients simultanés au plus (joueur compris).
+#define NET_SEND_EVERY 3      ///< Ticks entre deux images (20 images/s à 60 Hz).
+#define NET_HISTORY 32        ///< Images gardées des deux côtés comme bases de delta (1,6 s).
+#define NET_INPUT_WINDOW 32   ///< Commandes non accusées gardées par le client.
+#define NET_TIMEOUT 5.0       ///< Silence (s) au-delà duquel l'autre côté est considéré parti.
+#define NET_HUB_MATCH_CLIENTS 4 ///< Clients d'une partie du serveur multi-parties (joueur compris).
+///@}
+
+/** @name Rôle d'un client (octet `rôle` de SNAP) */
+///@{
+#define NET_ROLE_SPECTATOR 0 ///< Regarde : ses commandes sont ignorées.
+#define NET_ROLE_PLAYER 1    ///< Joue : ses commandes pilotent la partie.
+///@}
+
+/**
+ * @brief Bilan d'une session (serveur ou client).
+ */
+typedef struct
+{
+    double elapsed;           ///< Durée de la session (s).
+    long long ticks;          ///< Ticks simulés (serveur).
+    long long snapshots;      ///< Images envoyées (serveur) ou appliquées (client).
+    long long keyframes;      ///< Dont images complètes.
+    long long bytes;          ///< Octets UDP envoyés (serveur) ou reçus (client), en-têtes IP/UDP exclus.
+    long long commands;       ///< Commandes appliquées (serveur) ou envoyées (client).
+    long long rejected;       ///< Paquets ignorés (mal formés, base inconnue, image invalide).
+    long long skipped;        ///< Images remplacées par la suivante avant d'être prises par l'autre thread.
+    long long dropped;        ///< Commandes perdues entre les deux threads (file pleine).
+    int clients;              ///< Clients vus au total (serveur).
+    double rtt;               ///< Aller-retour estimé en fin de session (client, s).
+    long long underruns;      ///< Rendus sans image au-delà de l'instant dessiné (client, tampon de gigue).
+    long long corrections;    ///< Images qui ont corrigé le vaisseau prédit (client).
+    double correction_avg;    ///< Écart moyen de ces corrections (unités).
+    double correction_max;    ///< Plus grand écart corrigé en douceur (unités).
+} NetStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Fait tourner le serveur jusqu'à SIGINT ou au bout de `seconds`.
+ *
+ * Le menu "Quitter" et la double confirmation de sortie du joueur ne ferment
+ * pas le serveur : la partie revient au menu principal.
+ *
+ * @param port Port UDP d'écoute.
+ * @param seconds Durée (0 : jusqu'à SIGINT).
+ * @param seed Graine de la partie.
+ * @param broadcast_port Port de diffusion aux spectateurs (broadcast.h ; 0 : aucune). La partie passe
+ *                       alors en virgule fixe.
+ * @param out Bilan (peut être NULL).
+ * @return false si un socket n'a pas pu être ouvert ou si le pool de balles dépasse NET_MAX_BULLETS.
+ */
+bool net_run_server(int port, double seconds, uint64_t seed, int broadcast_port, NetStats *out);
+
+/**
+ * @brief Sert les parties d'un serveur multi-parties (hub.h) jusqu'à SIGINT ou au bout de `seconds`.
+ *
+ * Même protocole que net_run_server ; le champ `partie` de HELLO choisit la
+ * partie (NET_HUB_MATCH_CLIENTS clients chacune, le premier joue). Un seul
+ * thread, l'appelant, lit le socket et envoie les images que les threads de
+ * calcul publient ; les clients sont retrouvés par adresse dans une table
+ * de hachage. Environ 50 Ko par partie suivie (historique des images).
+ *
+ * @param hub Serveur déjà lancé (hub_start).
+ * @param port Port UDP d'écoute.
+ * @param seconds Durée (0 : jusqu'à SIGINT).
+ * @param out Bilan du réseau (peut être NULL).
+ * @return false si le socket n'a pas pu être ouvert.
+ */
+bool net_run_hub(Hub *hub, int port, double seconds, NetStats *out);
+
+/**
+ * @brief Se connecte à un serveur et affiche ses images jusqu'à CMD_EXIT.
+ *
+ * @param match Partie demandée à un serveur multi-parties (0 pour le serveur à une partie).
+ * @param view Vue d'affichage déjà initialisée (NULL : sans Vue, le client joue `script`, cf. headless.h).
+ * @param script Script d'entrées du client sans Vue (NULL : HEADLESS_DEFAULT_SCRIPT).
+ * @param seconds Durée (0 : jusqu'à CMD_EXIT ou au silence du serveur).
+ * @param out Bilan (peut être NULL).
+ * @return false si le serveur est introuvable ou n'a jamais répondu.
+ */
+bool net_run_client(const char *host, int port, int match, const ViewInterface *view, const char *script,
+                    double seconds, NetStats *out);
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ *
+ * @param label Préfixe des lignes ("SERVEUR" ou "CLIENT").
+ */
+void net_print_stats(const NetStats *stats, const char *label);
+
+#endif // NET_H
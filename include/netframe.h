@@ -0,0 +1,130 @@
+/**
+ * @file netframe.h
+ * @brief Image réseau : tout ce qu'une Vue dessine, dans un buffer de taille fixe.
+ *
+ * Un client d'affichage (cf. net.h) n'a pas besoin de l'état simulé complet
+ * (générateur, vitesses, timers internes) : il lui faut ce que lisent les Vues.
+ * Une image le range dans un ordre fixe, en petit-boutiste, les positions en
+ * Q10.6 (entity_pack.h) :
+ *
+ * @code
+ * tick u32 | état u8 | état précédent u8 | sélection u8 | vies u8 | score u32 | niveau u16
+ * drapeaux u8 | invulnérabilité u16 (1/256 s) | ticks par sprite de balle u8
+ * joueur x,y i16 | OVNI x,y i16 | origine x,y i16 | pas x,y i16
+ * aliens vivants u64 | aliens en explosion u64
+ * types des aliens u8 × 55 | positions figées x i16 × 55, y i16 × 55
+ * santé des boucliers u8 × MAX_SHIELDS
+ * balles : [x i16 | y i16 | tick u16 | pas i32 | type u8 | sprite u8] × NET_MAX_BULLETS (sprite à 0 : slot libre)
+ * @endcode
+ *
+ * Les aliens vivants ne sont pas listés : leur position se déduit de l'origine
+ * de la formation, comme dans le Modèle ; les boucliers, immobiles, ne
+ * transmettent que leur santé. Une balle n'est pas transmise par sa position
+ * mais par sa **fiche de tir** (NetBullet) : position, sprite et tick
+ * d'origine, pas par tick (Q16.16). Le client en déduit la position et le
+ * sprite de chaque image ; l'encodeur (NetEncoder) garde la fiche tant
+ * qu'elle prédit la position au 1/64 près, et n'en refait une qu'au tir ou
+ * quand la trajectoire a dévié. Les balles gardent leur slot : d'une image à
+ * la suivante, une balle en vol ne change aucun octet, et un delta (codec_diff)
+ * ne contient plus que ce qui change vraiment (tirs, impacts, formation).
+ */
+
+#ifndef NETFRAME_H
+#define NETFRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define NET_MAX_BULLETS MAX_BULLETS ///< Slots de balles transmis (capacité du pool du serveur, au plus).
+
+/** @name Drapeaux d'une image */
+///@{
+#define NETF_ANIM_FRAME 0x01    ///< Frame globale des aliens (animation_frame).
+#define NETF_PLAYER 0x02        ///< Vaisseau présent.
+#define NETF_UFO 0x04           ///< OVNI en vol.
+#define NETF_UFO_EXPLODING 0x08 ///< OVNI en explosion.
+///@}
+
+/** @name Octet `sprite` d'une fiche de tir */
+///@{
+#define NETB_USED 0x80        ///< Slot occupé.
+#define NETB_FRAME 0x30       ///< Sprite au tick de la fiche (0 à 3), sur deux bits.
+#define NETB_FRAME_SHIFT 4    ///< Décalage du sprite.
+#define NETB_PHASE 0x0F       ///< Ticks écoulés depuis le changement de sprite précédent.
+#define NETB_MAX_AGE 30000    ///< Âge (ticks) au-delà duquel la fiche est refaite (tick sur 16 bits).
+///@}
+
+/** @brief Taille d'une fiche de tir (octets). */
+#define NET_BULLET_SIZE 12
+
+/** @brief Taille d'une image (octets) : en-tête (18), 8 coordonnées, 2 masques, aliens, boucliers, balles. */
+#define NET_FRAME_SIZE (18 + 8 * 2 + 2 * 8 + FORMATION_SIZE * 5 + MAX_SHIELDS + NET_MAX_BULLETS * NET_BULLET_SIZE)
+
+/**
+ * @brief Fiche de tir : de quoi prédire une balle d'image en image.
+ */
+typedef struct
+{
+    int16_t x;      ///< Position X, Q10.6 (constante).
+    int16_t y;      ///< Position Y au tick de la fiche, Q10.6.
+    uint16_t tick;  ///< Tick de la fiche (16 bits de poids faible).
+    int32_t step;   ///< Déplacement vertical par tick, Q16.16.
+    uint8_t type;   ///< EntityType.
+    uint8_t sprite; ///< NETB_USED | sprite << NETB_FRAME_SHIFT | phase (0 : slot libre).
+} NetBullet;
+
+/**
+ * @brief Mémoire de l'encodeur : la fiche en cours de chaque slot, d'une image à la suivante.
+ */
+typedef struct
+{
+    NetBullet bullets[NET_MAX_BULLETS]; ///< Fiches de la dernière image capturée.
+    long long records;                  ///< Fiches refaites (tirs et trajectoires corrigées).
+} NetEncoder;
+
+/**
+ * @brief Image sérialisée (comparée et transmise octet par octet).
+ */
+typedef struct
+{
+    uint8_t bytes[NET_FRAME_SIZE]; ///< Champs dans l'ordre du format.
+} NetFrame;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Capture l'image d'un modèle.
+ *
+ * Les balles des slots au-delà de NET_MAX_BULLETS ne sont pas transmises.
+ *
+ * @param tick Numéro de tick du serveur (identifie l'image).
+ * @param enc Fiches de l'image précédente, mises à jour (zéro au départ ; NULL : une fiche neuve par
+ *            balle, images plus chères en delta).
+ */
+void netframe_capture(NetFrame *out, const GameModel *model, uint32_t tick, NetEncoder *enc);
+
+/**
+ * @brief Numéro de tick d'une image.
+ */
+uint32_t netframe_tick(const NetFrame *frame);
+
+/**
+ * @brief Recopie une image dans un modèle d'affichage (jamais simulé ensuite).
+ *
+ * Les champs sont d'abord tous validés (états, types, bornes) ; les listes
+ * actives et les caches de la vague sont ensuite reconstruits. Vitesses et
+ * timers non transmis restent à zéro : le modèle ne sert qu'au rendu.
+ *
+ * @return false (modèle intact) si l'image est invalide.
+ */
+bool netframe_apply(const NetFrame *frame, GameModel *model);
+
+#endif // NETFRAME_H
@@ -0,0 +1,162 @@
+/**
+ * @file netpredict.h
+ * @brief Client réseau : tampon de gigue, interpolation des images et prédiction du vaisseau local.
+ *
+ * Dessiner chaque image du serveur dès son arrivée fait hésiter tout ce qui
+ * bouge au rythme de la gigue du réseau, et le vaisseau du joueur ne réagit
+ * qu'un aller-retour après la touche. Le client sépare donc deux horloges :
+ *
+ * - les entités distantes (vague, OVNI, balles) sont dessinées à
+ *   NET_INTERP_DELAY dans le passé du serveur, interpolées entre les deux
+ *   images du tampon de gigue (NetJitter) qui encadrent cet instant : une
+ *   image en retard ou perdue est absorbée sans à-coup ;
+ * - le vaisseau local est prédit dans le présent (NetPredict) : chaque
+ *   commande est appliquée aussitôt, au pas de la simulation
+ *   (model_ship_command, model_step_ship : le calcul même du serveur). À
+ *   chaque image reçue, la position qui fait autorité est reprise et les
+ *   ticks que le serveur n'a pas encore vus (un aller-retour) sont rejoués
+ *   par-dessus. L'écart avec la prédiction précédente, s'il y en a un, est
+ *   résorbé en quelques ticks au lieu d'un saut.
+ *
+ * @code
+ * net_jitter_push(&jitter, frame, received);            // Image reçue (instant d'arrivée)
+ * net_predict_reconcile(&predict, latest, player, rtt); // Position qui fait autorité + ticks rejoués
+ * net_predict_command(&predict, model, cmd);            // Commande locale : effet immédiat
+ * net_predict_advance(&predict, model, now);            // Ticks locaux jusqu'à maintenant
+ * net_jitter_sample(&jitter, now, &from, &to, &alpha);  // Paire d'images à interpoler
+ * @endcode
+ */
+
+#ifndef NETPREDICT_H
+#define NETPREDICT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+#include "netframe.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Tampon de gigue */
+///@{
+#define NET_INTERP_DELAY 0.1     ///< Retard du rendu des entités distantes sur l'horloge du serveur (s) : deux images.
+#define NET_JITTER_FRAMES 8      ///< Images gardées (0,4 s à 20 images/s).
+#define NET_CLOCK_SMOOTHING 0.05 ///< Part de l'écart rattrapée quand une image arrive plus tard que l'horloge estimée.
+///@}
+
+/** @name Prédiction du vaisseau local */
+///@{
+#define NET_PREDICT_HISTORY 64   ///< Ticks locaux gardés pour être rejoués (aller-retour de 1 s au plus).
+#define NET_PREDICT_SNAP 8.0f    ///< Écart (unités) corrigé d'un coup : vaisseau replacé (vie perdue, niveau).
+#define NET_PREDICT_DECAY 0.8f   ///< Part de l'écart de correction encore affichée au tick suivant.
+///@}
+
+/**
+ * @brief Images reçues, dans l'ordre des ticks, et horloge du serveur estimée.
+ *
+ * L'horloge est l'écart `tick / TARGET_FPS - arrivée` le plus favorable
+ * observé : une image arrivée tôt le relève aussitôt, des images durablement
+ * plus lentes le font redescendre peu à peu (NET_CLOCK_SMOOTHING).
+ */
+typedef struct
+{
+    NetFrame frames[NET_JITTER_FRAMES]; ///< Images (file circulaire, la plus ancienne à `first`).
+    uint32_t ticks[NET_JITTER_FRAMES];  ///< Tick de chaque image.
+    int first, count;                   ///< Position de la plus ancienne, nombre d'images.
+    double offset;                      ///< Horloge du serveur moins horloge locale (s).
+    bool synced;                        ///< `offset` estimé (une image reçue au moins).
+    long long underruns;                ///< Rendus sans image au-delà de l'instant dessiné (le rendu attend).
+} NetJitter;
+
+/**
+ * @brief Vaisseau local prédit, et vitesses des derniers ticks locaux pour les rejouer.
+ */
+typedef struct
+{
+    Entity ship;                   ///< Vaisseau prédit (position au dernier tick local, vitesse courante).
+    float dx[NET_PREDICT_HISTORY]; ///< Vitesse appliquée à chaque tick local (file circulaire).
+    uint32_t ticks;                ///< Ticks locaux simulés.
+    double clock;                  ///< Instant du prochain tick local (0 : horloge pas encore lancée).
+    float error;                   ///< Part de la dernière correction encore affichée (unités).
+    bool active;                   ///< Vaisseau local prédit (partie en cours, rôle de joueur).
+    long long corrections;         ///< Images reçues qui ont corrigé la prédiction.
+    double error_sum;              ///< Somme des écarts corrigés (unités).
+    float error_max;               ///< Plus grand écart corrigé sans replacement (unités).
+} NetPredict;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Vide le tampon de gigue.
+ */
+void net_jitter_init(NetJitter *jitter);
+
+/**
+ * @brief Ajoute une image reçue (tick croissant) et recale l'horloge du serveur.
+ *
+ * La plus ancienne image est retirée si le tampon est plein.
+ *
+ * @param received Instant d'arrivée (horloge de utils_get_time).
+ */
+void net_jitter_push(NetJitter *jitter, const NetFrame *frame, double received);
+
+/**
+ * @brief Paire d'images qui encadre l'instant à dessiner (NET_INTERP_DELAY avant l'horloge du serveur).
+ *
+ * Au-delà de la dernière image, la dernière est rendue seule (`alpha` à 0) ;
+ * avant la première, la première.
+ *
+ * @param from Reçoit l'image de départ.
+ * @param to Reçoit l'image d'arrivée (égale à `from` hors d'un intervalle).
+ * @param alpha Reçoit la position entre les deux (0 à 1).
+ * @return false si le tampon est vide.
+ */
+bool net_jitter_sample(NetJitter *jitter, double now, const NetFrame **from, const NetFrame **to, float *alpha);
+
+/**
+ * @brief Dernière image reçue (NULL : aucune).
+ */
+const NetFrame *net_jitter_latest(const NetJitter *jitter);
+
+/**
+ * @brief Prépare une prédiction inactive.
+ */
+void net_predict_init(NetPredict *predict);
+
+/**
+ * @brief Applique une commande locale au vaisseau prédit (vitesse seule, cf. model_ship_command).
+ *
+ * @param model Modèle d'affichage (vitesse du vaisseau).
+ */
+void net_predict_command(NetPredict *predict, const GameModel *model, GameCommand cmd);
+
+/**
+ * @brief Simule les ticks locaux écoulés jusqu'à `now`, au pas de TARGET_FPS.
+ *
+ * @param model Modèle d'affichage (virgule fixe ou non).
+ */
+void net_predict_advance(NetPredict *predict, const GameModel *model, double now);
+
+/**
+ * @brief Reprend la position d'une image du serveur et rejoue par-dessus les ticks qu'il n'a pas vus.
+ *
+ * Hors partie, ou pour un spectateur, la prédiction s'arrête et le vaisseau
+ * suit l'image telle quelle.
+ *
+ * @param latest Modèle de la dernière image reçue.
+ * @param player Le client pilote la partie (rôle NET_ROLE_PLAYER).
+ * @param rtt Aller-retour estimé (s) : les ticks locaux de cette durée sont rejoués.
+ */
+void net_predict_reconcile(NetPredict *predict, const GameModel *latest, bool player, double rtt);
+
+/**
+ * @brief Abscisse à dessiner : prédiction, plus ce qui reste de la dernière correction.
+ */
+float net_predict_x(const NetPredict *predict);
+
+#endif // NETPREDICT_H
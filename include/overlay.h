@@ -0,0 +1,142 @@
+/**
+ * @file overlay.h
+ * @brief Image du jeu en mémoire partagée : scène, score et mesures, lisibles par d'autres processus.
+ *
+ * Un habillage de diffusion (OBS) ou un inspecteur de test veut l'état du
+ * jeu en direct sans s'y accrocher. Avec SPACE_INVADERS_OVERLAY=fichier (de
+ * préférence sous /dev/shm), la boucle de jeu y publie, après chaque rendu,
+ * la liste d'affichage de scene.h, le score et les mesures du profileur
+ * (dernière durée et moyenne de chaque phase, compteurs de la frame).
+ *
+ * Le bloc porte un compteur de version à la manière d'un seqlock, comme
+ * celui de params.h mais dans l'autre sens : le jeu est le seul écrivain.
+ * Il rend la version impaire, copie l'image, puis la rend paire ; il
+ * n'attend jamais personne. Un lecteur copie l'image et recommence si la
+ * version était impaire ou a changé entre-temps : il peut lire à la cadence
+ * qu'il veut, ou plus du tout, sans que le jeu ne le sache. Les lecteurs
+ * projettent le fichier en lecture seule.
+ *
+ * La scène n'est reconstruite qu'à un nouvel état (scene_update) ; entre
+ * deux, une publication ne recopie que l'en-tête, les mesures et les
+ * éléments valides (quelques kilo-octets).
+ *
+ * @code
+ * overlay_open("/dev/shm/space_invaders.overlay"); // Jeu
+ * overlay_publish(model);                          // Après chaque rendu
+ *
+ * OverlayReader r;                                 // Autre processus
+ * overlay_attach(&r, "/dev/shm/space_invaders.overlay");
+ * OverlayFrame *f = malloc(sizeof(OverlayFrame));
+ * if (overlay_read(&r, f)) ...
+ * @endcode
+ */
+
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+#include "profiler.h"
+#include "scene.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Bloc partagé */
+///@{
+#define OVERLAY_MAGIC 0x4C52564Fu ///< "OVRL" en petit-boutiste : en-tête du bloc.
+#define OVERLAY_READ_TRIES 64     ///< Copies tentées par overlay_read avant d'abandonner.
+///@}
+
+/**
+ * @brief Une image publiée.
+ */
+typedef struct
+{
+    uint64_t frame;                         ///< Publications depuis l'ouverture (1 : la première).
+    uint64_t gen;                           ///< Génération de l'état (change à chaque tick ou modification).
+    int32_t state;                          ///< GameStateEnum.
+    int32_t score;                          ///< Score.
+    int32_t lives;                          ///< Vies.
+    int32_t level;                          ///< Niveau.
+    float frame_ms[PROF_PHASE_COUNT];       ///< Dernière mesure de chaque phase (ms ; 0 sans sonde).
+    float avg_ms[PROF_PHASE_COUNT];         ///< Moyenne de la session de chaque phase (ms).
+    uint32_t counters[PROF_COUNTER_COUNT];  ///< Compteurs de la dernière frame terminée.
+    int32_t first[SCENE_KIND_COUNT + 1];    ///< Premier élément de chaque genre (cf. SceneList).
+    int32_t count;                          ///< Éléments valides.
+    SceneItem items[SCENE_MAX_ITEMS];       ///< Éléments, dans l'ordre de dessin (seuls les `count` premiers sont écrits).
+} OverlayFrame;
+
+/**
+ * @brief Bloc projeté en mémoire partagée.
+ */
+typedef struct
+{
+    uint32_t magic;     ///< OVERLAY_MAGIC.
+    uint32_t size;      ///< sizeof(OverlayFrame) (un bloc d'une autre version est refusé).
+    uint32_t version;   ///< Pair : image stable ; impair : écriture en cours.
+    uint32_t pad;       ///< Alignement.
+    OverlayFrame frame; ///< Dernière image publiée.
+} OverlayBlock;
+
+/**
+ * @brief Un lecteur : le bloc projeté en lecture seule.
+ */
+typedef struct
+{
+    const OverlayBlock *block; ///< Bloc (NULL : non attaché).
+    uint64_t retries;          ///< Copies reprises (écriture en cours pendant la copie).
+    uint64_t misses;           ///< Lectures abandonnées après OVERLAY_READ_TRIES copies.
+} OverlayReader;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Crée (ou remet à zéro) le bloc et le projette pour les publications du jeu.
+ * @return false si le fichier ne peut pas être créé ou projeté.
+ */
+bool overlay_open(const char *path);
+
+/**
+ * @brief Publie l'état affiché et les mesures de la frame (boucle de jeu, après le rendu).
+ *
+ * Sans bloc ouvert, ne fait rien. N'attend jamais : les lecteurs ne sont pas consultés.
+ */
+void overlay_publish(const GameModel *model);
+
+/**
+ * @brief Images publiées depuis overlay_open.
+ */
+uint64_t overlay_published(void);
+
+/**
+ * @brief Rend la projection du jeu (le fichier reste pour les lecteurs).
+ */
+void overlay_close(void);
+
+/**
+ * @brief Projette un bloc en lecture seule (côté lecteur).
+ * @return false si le fichier n'existe pas ou n'est pas un bloc d'image.
+ */
+bool overlay_attach(OverlayReader *reader, const char *path);
+
+/**
+ * @brief Copie stable de la dernière image.
+ *
+ * @param out Reçoit l'image (seuls les `count` premiers éléments sont copiés).
+ * @return false si aucune image n'est encore publiée ou si l'écrivain a
+ *         réécrit le bloc pendant OVERLAY_READ_TRIES copies de suite.
+ */
+bool overlay_read(OverlayReader *reader, OverlayFrame *out);
+
+/**
+ * @brief Rend la projection du lecteur.
+ */
+void overlay_detach(OverlayReader *reader);
+
+#endif // OVERLAY_H
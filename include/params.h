@@ -0,0 +1,148 @@
+/**
+ * @file params.h
+ * @brief Paramètres d'équilibrage lus par model_update, réglables à chaud par un bloc partagé.
+ *
+ * Les vitesses, la descente de la vague, l'apparition de l'OVNI et la
+ * cadence de tir ennemie ne sont plus lues dans les `#define` de model.h
+ * (qui restent les valeurs par défaut) mais dans `SimState::params` : une
+ * partie peut les changer sans recompiler ni relancer.
+ *
+ * Pour l'équilibrage en direct, le jeu projette un petit fichier
+ * (SPACE_INVADERS_PARAMS, de préférence sous /dev/shm : mémoire partagée)
+ * qu'un outil externe modifie, `space_invaders params` par exemple. Le
+ * bloc porte un compteur de version à la manière d'un seqlock : l'écrivain
+ * le rend impair, écrit les valeurs, puis le rend pair. Le jeu le lit une
+ * fois par tick, entre deux model_update (params_live_poll) : une version
+ * inchangée ne coûte qu'une lecture atomique, une version impaire ou qui
+ * change pendant la copie est reprise au tick suivant. Aucun verrou, ni
+ * côté jeu ni côté outil.
+ *
+ * Les paramètres font partie de l'état simulé : copiés avec lui (rollback,
+ * planificateur), sauvegardés et hachés dès qu'ils diffèrent des valeurs
+ * par défaut. Un enregistrement ne garde pas leurs changements en cours de
+ * partie : il ne se rejoue plus, et sa vérification le signale.
+ *
+ * @code
+ * params_live_open("/dev/shm/space_invaders.params"); // Créé aux valeurs par défaut s'il n'existe pas
+ * ...
+ * params_live_poll(&model->sim.params);              // Avant chaque model_update
+ * @endcode
+ *
+ * @code
+ * ./space_invaders params /dev/shm/space_invaders.params player_speed=55 fire_percent=150
+ * @endcode
+ */
+
+#ifndef PARAMS_H
+#define PARAMS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Bloc partagé */
+///@{
+#define PARAMS_MAGIC 0x4D524150u ///< "PARM" en petit-boutiste : en-tête du bloc.
+#define PARAMS_TEXT_MAX 512      ///< Taille suffisante pour params_format.
+///@}
+
+/**
+ * @brief Paramètres d'équilibrage d'une partie.
+ */
+typedef struct
+{
+    float player_speed;   ///< Vitesse du vaisseau (PLAYER_SPEED).
+    float bullet_speed;   ///< Vitesse des balles du joueur (BULLET_SPEED ; celles des aliens en font 60 %).
+    float enemy_speed;    ///< Vitesse de base de la vague (ENEMY_SPEED_BASE).
+    float enemy_drop;     ///< Descente de la vague à chaque bord (ENEMY_DROP_HEIGHT).
+    float ufo_speed;      ///< Vitesse de l'OVNI (UFO_SPEED).
+    int32_t ufo_odds;     ///< L'OVNI a une chance sur `ufo_odds` d'apparaître à chaque tick (UFO_SPAWN_ODDS).
+    int32_t fire_percent; ///< Cadence de tir des aliens, en % de celle de la vague (100).
+} SimParams;
+
+/**
+ * @brief Bloc projeté en mémoire partagée.
+ */
+typedef struct
+{
+    uint32_t magic;   ///< PARAMS_MAGIC.
+    uint32_t size;    ///< sizeof(SimParams) (un bloc d'une autre version est refusé).
+    uint32_t version; ///< Pair : valeurs stables ; impair : écriture en cours.
+    uint32_t pad;     ///< Alignement.
+    SimParams values; ///< Valeurs publiées.
+} ParamsBlock;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Valeurs par défaut (les constantes de model.h).
+ */
+void params_default(SimParams *p);
+
+/**
+ * @brief Indique si les paramètres sont ceux par défaut (ni sauvegardés, ni hachés).
+ */
+bool params_is_default(const SimParams *p);
+
+/**
+ * @brief Vérifie que chaque paramètre est dans sa plage (cf. params_set).
+ */
+bool params_valid(const SimParams *p);
+
+/**
+ * @brief Applique une affectation `cle=valeur` (player_speed, bullet_speed, enemy_speed, enemy_drop,
+ *        ufo_speed, ufo_odds, fire_percent).
+ * @return false si la clé est inconnue ou la valeur hors plage (paramètres inchangés).
+ */
+bool params_set(SimParams *p, const char *assignment);
+
+/**
+ * @brief Écrit les paramètres, une affectation `cle=valeur` par ligne.
+ * @return La longueur écrite (tronquée à `cap`).
+ */
+int params_format(const SimParams *p, char *out, size_t cap);
+
+/**
+ * @brief Projette le bloc partagé (créé aux valeurs par défaut s'il est absent ou vide).
+ * @return false si le fichier ne peut pas être ouvert ou n'est pas un bloc de paramètres.
+ */
+bool params_live_open(const char *path);
+
+/**
+ * @brief Nouvelles valeurs publiées depuis le dernier appel, recopiées si elles sont stables et valides.
+ *
+ * Sans bloc ouvert, ne fait rien. Des valeurs hors plage sont ignorées
+ * jusqu'à la version suivante (comptées dans params_live_rejected).
+ *
+ * @return true si `p` a changé.
+ */
+bool params_live_poll(SimParams *p);
+
+/**
+ * @brief Publie de nouvelles valeurs dans le bloc ouvert (côté outil).
+ */
+void params_live_publish(const SimParams *p);
+
+/**
+ * @brief Dernières valeurs publiées (attend la fin d'une écriture en cours).
+ * @return false sans bloc ouvert.
+ */
+bool params_live_read(SimParams *out);
+
+/**
+ * @brief Versions ignorées car hors plage.
+ */
+uint64_t params_live_rejected(void);
+
+/**
+ * @brief Rend la projection.
+ */
+void params_live_close(void);
+
+#endif // PARAMS_H
@@ -0,0 +1,118 @@
+/**
+ * @file particles.h
+ * @brief Particules d'explosion : réserve de capacité fixe, rangée en SoA.
+ *
+ * Chaque mort (alien, OVNI, vaisseau) projette une gerbe de particules qui
+ * retombent sous la gravité et s'effacent. Les champs sont rangés en
+ * tableaux parallèles alloués une fois : l'intégration, le fondu et le
+ * repérage des particules mortes passent par un seul noyau vectorisé
+ * (simd_particle_step), puis les mortes sont retirées par échange avec la
+ * dernière. Aucune allocation après particles_init.
+ *
+ * Effet purement visuel : la réserve ne touche pas au Modèle et tire ses
+ * directions de son propre générateur, le déroulement d'une partie (et donc
+ * replays, sauvegardes, réseau) n'en dépend pas.
+ *
+ * Le coût suit le nombre de particules vivantes : quand une frame dépasse
+ * son budget, particles_pace réduit la taille des gerbes suivantes, puis la
+ * rétablit peu à peu quand les frames repassent sous le budget.
+ *
+ * @code
+ * ParticlePool pool;
+ * particles_init(&pool, PARTICLE_CAPACITY);
+ * particles_burst(&pool, x, y, 48, 0xFF8040, 20.0f, 0.6f);
+ * particles_update(&pool, dt);           // Une fois par frame
+ * particles_pace(&pool, frame_time, 1.25 / TARGET_FPS); // Marge pour la vsync
+ * particles_free(&pool);
+ * @endcode
+ */
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Réserve de particules */
+///@{
+#define PARTICLE_CAPACITY 65536      ///< Particules vivantes au plus (réserve de la Vue SDL).
+#define PARTICLE_GRAVITY 40.0f       ///< Accélération vers le bas (unités logiques / s²).
+#define PARTICLE_SCALE_MIN 0.05f     ///< Fraction minimale des gerbes gardée quand le budget est dépassé.
+#define PARTICLE_SCALE_RECOVER 0.02f ///< Fraction rendue par frame sous le budget.
+///@}
+
+/**
+ * @brief Réserve de particules (tableaux parallèles, un bloc alloué).
+ *
+ * Les particules vivantes occupent [0, count) : pas de slot libre au milieu.
+ */
+typedef struct
+{
+    float *x, *y;      ///< Position (unités logiques du jeu).
+    float *vx, *vy;    ///< Vitesse (unités / s).
+    float *life;       ///< Temps restant (s) ; morte à 0.
+    float *inv_life;   ///< Inverse de la durée initiale (fondu).
+    float *alpha;      ///< Opacité de 1 à 0, calculée par particles_update.
+    uint32_t *color;   ///< Teinte 0xRRGGBB.
+    uint64_t *dead;    ///< Masque de travail (⌈capacity / 64⌉ mots).
+    void *block;       ///< Bloc alloué (NULL : réserve indisponible).
+    int count;         ///< Particules vivantes.
+    int capacity;      ///< Taille des tableaux (multiple de 64).
+    float spawn_scale; ///< Fraction des gerbes réellement émise (1 : tout).
+    uint32_t rng;      ///< Générateur xorshift32 des directions et durées.
+    uint64_t spawned;  ///< Particules émises depuis particles_init.
+    uint64_t dropped;  ///< Particules demandées mais non émises (plafond ou budget).
+} ParticlePool;
+
+// ============================================================================
+//                          API
+// ============================================================================
+
+/**
+ * @brief Alloue la réserve (capacité arrondie au multiple de 64 supérieur).
+ * @return false si l'allocation échoue (la réserve reste vide et utilisable).
+ */
+bool particles_init(ParticlePool *pool, int capacity);
+
+/**
+ * @brief Libère la réserve.
+ */
+void particles_free(ParticlePool *pool);
+
+/**
+ * @brief Projette une gerbe de particules depuis un point.
+ *
+ * `count` est d'abord multiplié par `spawn_scale`, puis borné par la place
+ * restante. Directions uniformes, vitesses dans [speed / 4, speed], durées
+ * dans [life / 2, life].
+ *
+ * @param color Teinte 0xRRGGBB (cf. EntityTypeInfo.color).
+ * @return Nombre de particules émises.
+ */
+int particles_burst(ParticlePool *pool, float x, float y, int count, uint32_t color, float speed, float life);
+
+/**
+ * @brief Avance toutes les particules de `dt` secondes et retire les mortes.
+ */
+void particles_update(ParticlePool *pool, float dt);
+
+/**
+ * @brief Ajuste la taille des gerbes d'après la durée de la dernière frame.
+ *
+ * Au-delà du budget, `spawn_scale` est divisé par deux (jusqu'à
+ * PARTICLE_SCALE_MIN) ; dans le budget, il remonte de PARTICLE_SCALE_RECOVER.
+ * Avec la synchronisation verticale, une frame dure au moins une période
+ * d'écran : le budget passé doit laisser une marge au-dessus de celle-ci.
+ */
+void particles_pace(ParticlePool *pool, double frame_time, double budget);
+
+/**
+ * @brief Retire toutes les particules (changement d'écran, nouvelle partie).
+ */
+void particles_clear(ParticlePool *pool);
+
+#endif // PARTICLES_H
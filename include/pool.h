@@ -0,0 +1,129 @@
+/**
+ * @file pool.h
+ * @brief Parties headless en parallèle : pool de threads à vol de tâches.
+ *
+ * Pour évaluer un changement de difficulté sur des dizaines de milliers de
+ * parties, chaque tâche est une partie indépendante : une graine (partie
+ * scriptée, cf. headless.h) ou un fichier d'enregistrement (cf. replay.h).
+ *
+ * Les tâches sont d'abord réparties en tranches égales, une par thread.
+ * Un thread consomme sa tranche par le début ; vide, il vole la moitié de
+ * la tranche restante d'un autre thread (par la fin). Chaque thread possède
+ * ses modèles (et donc leur générateur) et son résumé partiel : seules les
+ * bornes des tranches sont partagées, chacune sous son propre verrou. Les
+ * résumés sont fusionnés à la fin.
+ *
+ * @code
+ * ./space_invaders pool 100000            # 100 000 graines, un thread par cœur
+ * ./space_invaders pool 100000 16 36000   # 16 threads, 10 minutes de jeu au plus par partie
+ * ./space_invaders pool replay a.rpl b.rpl
+ * ./space_invaders pool verify soumissions/ 32  # classement en ligne : enregistrements à valider
+ * @endcode
+ *
+ * En vérification, chaque enregistrement est rejoué par replay_verify : ses
+ * empreintes d'état et le résultat qu'il annonce sont comparés au rejeu, et
+ * le bilan liste les parties invalides. Le rejeu n'a ni Vue ni attente :
+ * une partie de 10 minutes (36 000 ticks) coûte le temps de ses model_update.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bot.h"
+#include "replay.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Pool de threads */
+///@{
+#define POOL_MAX_THREADS 256 ///< Threads au plus (au-delà : ramené à cette valeur).
+#define POOL_LEVELS 16       ///< Niveaux détaillés dans le résumé (le dernier compte aussi les suivants).
+///@}
+
+/**
+ * @brief Verdict d'un enregistrement vérifié.
+ */
+typedef struct
+{
+    ReplayVerdict verdict; ///< Jugement de replay_verify.
+    int claimed_score;     ///< Score annoncé par le fichier.
+    int score;             ///< Score obtenu au rejeu.
+    uint64_t desync_tick;  ///< Fin de la première fenêtre divergente (0 : aucune).
+} PoolVerdict;
+
+/**
+ * @brief Travail à répartir.
+ */
+typedef struct
+{
+    int threads;                  ///< Threads (0 : un par cœur en ligne).
+    long games;                   ///< Parties scriptées (graines first_seed, first_seed + 1, ...).
+    uint64_t first_seed;          ///< Graine de la première partie.
+    long max_ticks;               ///< Ticks au plus par partie (au-delà : partie non terminée).
+    const char *script;           ///< Script d'entrées (NULL : HEADLESS_DEFAULT_SCRIPT).
+    const BotConfig *bot;         ///< Joueur automatique à la place du script (NULL : script).
+    const char *const *replays;   ///< Enregistrements à rejouer à la place des graines (NULL : graines).
+    int replay_count;             ///< Nombre d'enregistrements.
+    int stop_level;               ///< Niveau qui termine une partie scriptée (0 : Game Over ou max_ticks).
+    PoolVerdict *verdicts;        ///< Un par enregistrement : vérification (replay_verify) au lieu d'un simple rejeu (NULL : rejeu).
+} PoolConfig;
+
+/**
+ * @brief Résultats agrégés (un résumé partiel par thread, fusionnés à la fin).
+ */
+typedef struct
+{
+    long games;                   ///< Parties jouées jusqu'au bout ou jusqu'à max_ticks.
+    long unfinished;              ///< Parties arrêtées par max_ticks (ou fin d'enregistrement) avant le Game Over ou stop_level.
+    long failed;                  ///< Tâches impossibles (modèle non alloué, enregistrement invalide).
+    long invalid;                 ///< Enregistrements vérifiés non valides (cfg->verdicts), illisibles compris.
+    long long ticks;              ///< Ticks simulés, toutes parties confondues.
+    double score_sum;             ///< Somme des scores.
+    double score_sq_sum;          ///< Somme des carrés des scores (écart-type).
+    long long level_sum;          ///< Somme des niveaux atteints.
+    int score_min, score_max;     ///< Scores extrêmes.
+    long best_job;                ///< Tâche du meilleur score (graine : first_seed + best_job).
+    long levels[POOL_LEVELS];     ///< Parties par niveau atteint (1 à POOL_LEVELS, puis au-delà).
+    int threads;                  ///< Threads lancés.
+    double elapsed;               ///< Temps réel (secondes).
+} PoolSummary;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Joue toutes les tâches sur le pool, puis fusionne les résultats.
+ *
+ * Les vagues (wave_load) et la capacité des balles (model_set_bullet_capacity)
+ * doivent être fixées avant : les threads ne font que les lire.
+ *
+ * @return false si aucun thread n'a pu être lancé.
+ */
+bool pool_run(const PoolConfig *cfg, PoolSummary *out);
+
+/**
+ * @brief Chemins des fichiers `.rpl` d'un dossier, triés par nom.
+ *
+ * @param count Reçoit le nombre de chemins.
+ * @return Le tableau (à libérer avec pool_free_replays), ou NULL si le dossier
+ *         est illisible ou si la mémoire manque.
+ */
+char **pool_list_replays(const char *dir, int *count);
+
+/**
+ * @brief Libère une liste obtenue par pool_list_replays.
+ */
+void pool_free_replays(char **paths, int count);
+
+/**
+ * @brief Affiche le résumé sur la sortie standard (et, en vérification, les parties invalides).
+ */
+void pool_print_summary(const PoolConfig *cfg, const PoolSummary *summary);
+
+#endif // POOL_H
@@ -0,0 +1,108 @@
+/**
+ * @file power.h
+ * @brief Régulateur d'énergie : allège l'affichage sur batterie ou quand la machine chauffe.
+ *
+ * Sur une console portable, tenir TARGET_FPS images par seconde avec tous
+ * les effets vide la batterie et fait chauffer le processeur, qui finit par
+ * baisser sa fréquence tout seul, en pleine partie. Le régulateur relit
+ * toutes les POWER_POLL_S secondes la source d'alimentation
+ * (SDL_GetPowerInfo) et, sous Linux, la température la plus haute des zones
+ * thermiques (/sys/class/thermal). Sur batterie, ou au-delà de POWER_HOT_C
+ * (jusqu'à redescendre sous POWER_COOL_C), il passe en mode économe :
+ *
+ * - la boucle de jeu n'affiche plus que POWER_SAVER_HZ images par seconde ;
+ *   la simulation garde son tick fixe (plusieurs ticks par image, interpolés) ;
+ * - la Vue SDL reste au moins au niveau de qualité QUALITY_NO_BACKGROUND
+ *   (ni particules, ni tremblement, ni fond, image ou étoiles) ;
+ * - au repos des menus, l'attente d'une entrée dure POWER_IDLE_WAIT_S.
+ *
+ * Le mode courant est affiché par le panneau de performances (F3).
+ * SPACE_INVADERS_POWER=0 coupe le régulateur ; "batterie" ou "chauffe"
+ * imposent un mode (essais sur une machine de bureau).
+ *
+ * @code
+ * PowerGovernor power;
+ * power_init(&power);
+ * // À chaque image :
+ * if (power_update(&power, utils_get_time()))
+ *     utils_pacer_set_rate(&pacer, power_render_hz(power.mode, render_hz));
+ * @endcode
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdbool.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Régulateur d'énergie */
+///@{
+#define POWER_POLL_S 2.0         ///< Intervalle entre deux lectures de l'alimentation et des températures.
+#define POWER_HOT_C 80           ///< Température (°C) au-delà de laquelle la machine chauffe.
+#define POWER_COOL_C 70          ///< Température (°C) sous laquelle elle est refroidie.
+#define POWER_THERMAL_ZONES 32   ///< Zones thermiques lues au plus.
+#define POWER_SAVER_HZ 30        ///< Images par seconde au plus en mode économe.
+#define POWER_IDLE_WAIT_S 1.0    ///< Attente d'une entrée au repos des menus en mode économe (IDLE_WAIT_S sinon).
+///@}
+
+/**
+ * @brief Modes d'énergie.
+ */
+typedef enum
+{
+    POWER_MAINS,   ///< Secteur (ou alimentation inconnue) : cadence et effets complets.
+    POWER_BATTERY, ///< Sur batterie : mode économe.
+    POWER_HOT,     ///< Machine trop chaude : mode économe jusqu'au refroidissement.
+    POWER_MODE_COUNT
+} PowerMode;
+
+/**
+ * @brief État du régulateur.
+ */
+typedef struct
+{
+    int mode;         ///< Mode courant (PowerMode).
+    bool automatic;   ///< false : mode fixé (ou régulateur coupé), jamais relu.
+    bool hot;         ///< Au-delà de POWER_HOT_C, pas encore redescendu sous POWER_COOL_C.
+    double next_poll; ///< Date de la prochaine lecture (utils_get_time).
+    int battery;      ///< Charge de la batterie en % (-1 : inconnue).
+    int temp_c;       ///< Température la plus haute lue en °C (-1 : aucune zone).
+    int changes;      ///< Changements de mode depuis le lancement.
+} PowerGovernor;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise le régulateur selon SPACE_INVADERS_POWER et lit l'état courant.
+ */
+void power_init(PowerGovernor *p);
+
+/**
+ * @brief Relit l'alimentation et les températures si POWER_POLL_S secondes sont passées.
+ *
+ * @param now Date courante (utils_get_time).
+ * @return true si le mode a changé.
+ */
+bool power_update(PowerGovernor *p, double now);
+
+/**
+ * @brief Vrai en mode économe (batterie ou chauffe).
+ */
+bool power_saving(int mode);
+
+/**
+ * @brief Cadence d'affichage d'un mode, à partir de la cadence nominale.
+ */
+int power_render_hz(int mode, int nominal_hz);
+
+/**
+ * @brief Nom lisible d'un mode (panneau de performances, journal).
+ */
+const char *power_name(int mode);
+
+#endif // POWER_H
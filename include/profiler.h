@@ -0,0 +1,288 @@
+/**
+ * @file profiler.h
+ * @brief Profileur de frames : durée de chaque phase de la boucle de jeu.
+ *
+ * Des sondes encadrent les phases de la boucle (entrées, mises à jour, rendu,
+ * attente) et les sections de model_update. Chaque mesure alimente deux
+ * agrégats par phase :
+ * - une fenêtre glissante des PROFILER_WINDOW dernières mesures (min, moyenne,
+ *   p99 récents, et la courbe des dernières frames) ;
+ * - un histogramme logarithmique de toute la session (8 classes par
+ *   puissance de 2, soit ~12 % de précision), résumé à la sortie.
+ *
+ * Désactivé, une sonde ne coûte qu'un test : model_update reste aussi rapide
+ * en headless. Activé, elle lit l'horloge rapide (utils_fast_ns : compteur
+ * matériel étalonné, quelques nanosecondes) et ne manipule que des
+ * nanosecondes entières. Chaque phase n'est mesurée que par un seul thread
+ * (la simulation sur son thread, les entrées et le rendu sur le thread
+ * principal).
+ *
+ * @code
+ * uint64_t t = profiler_begin();
+ * view->render(model);
+ * profiler_end(PROF_RENDER, t);
+ * @endcode
+ *
+ * Une trace peut aussi être ouverte (profiler_trace_open) : chaque mesure y
+ * devient un événement daté (début, durée, thread) dans une file circulaire
+ * allouée d'avance, sans allocation ni écriture disque pendant la partie.
+ * profiler_trace_flush l'écrit au format JSON `trace_event` de Chrome,
+ * lisible dans chrome://tracing ou ui.perfetto.dev.
+ *
+ * Le guet des images lentes (profiler_hitch_open) se sert de la même file :
+ * une frame (PROF_FRAME) au-delà du budget est notée avec son contexte
+ * (compteurs de la frame, valeurs données par profiler_hitch_context), puis,
+ * PROFILER_HITCH_WINDOW secondes plus tard, la tranche de trace qui l'entoure
+ * est écrite dans son propre fichier, `<préfixe>-<n>.json`. Les images lentes
+ * de la même tranche y figurent toutes, sur une ligne "Guet" du chronogramme.
+ *
+ * @code
+ * profiler_record(PROF_FRAME, frame_ns);
+ * if (profiler_hitch_detected())
+ *     profiler_hitch_context("balles", model->sim.bullets.live.count);
+ * @endcode
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define PROFILER_WINDOW 256  ///< Mesures récentes conservées par phase.
+#define PROFILER_BUCKETS 280 ///< Classes de l'histogramme (jusqu'à ~68 s).
+#define PROFILER_TRACE_EVENTS 65536 ///< Événements de trace conservés (~10 par frame : ~100 s à 60 Hz).
+#define PROFILER_HITCH_WINDOW 1.0   ///< Trace écrite de part et d'autre d'une image lente (s).
+#define PROFILER_HITCH_MARKS 8      ///< Images lentes notées au plus par tranche.
+#define PROFILER_HITCH_CONTEXT 8    ///< Valeurs de contexte au plus par image lente.
+#define PROFILER_HITCH_MAX 16       ///< Tranches écrites au plus par session.
+
+/**
+ * @brief Phases mesurées.
+ */
+typedef enum
+{
+    PROF_FRAME,             ///< Intervalle entre deux débuts de frame.
+    PROF_WORK,              ///< Frame sans l'attente (entrées, simulation, rendu).
+    PROF_INPUT,             ///< view->get_input et distribution des commandes.
+    PROF_UPDATE,            ///< Un appel à model_update.
+    PROF_UPDATE_TIMERS,     ///< model_update : timers, animation et joueur.
+    PROF_UPDATE_UFO,        ///< model_update : OVNI.
+    PROF_UPDATE_ENTITIES,   ///< model_update : systèmes du registre de composants (ecs.h).
+    PROF_UPDATE_ENEMIES,    ///< model_update : explosions et déplacement de la formation.
+    PROF_UPDATE_ENEMY_FIRE, ///< model_update : tirs ennemis.
+    PROF_UPDATE_BULLETS,    ///< model_update : balles et collisions.
+    PROF_RENDER,            ///< view->render.
+    PROF_SLEEP,             ///< Attente de la frame suivante (régulateur ou vsync).
+    PROF_GPU,               ///< Exécution d'une image par le GPU (gputime.h), lue quelques frames plus tard.
+    PROF_PHASE_COUNT
+} ProfilerPhase;
+
+/**
+ * @brief Compteurs par frame (remis à zéro par profiler_frame_end).
+ */
+typedef enum
+{
+    PROF_COUNT_TICKS,      ///< Pas de simulation de la frame (boucle à accumulateur).
+    PROF_COUNT_DRAW_CALLS, ///< Appels de dessin envoyés au renderer (SDL).
+    PROF_COUNT_UPLOADS,    ///< Textures créées pendant le rendu (SDL).
+    PROF_COUNT_TERM_BYTES, ///< Octets envoyés au terminal, estimation (ncurses).
+    PROF_COUNT_ALLOCS,     ///< Allocations SDL de la frame hors pilote, tous threads (memtrack.h).
+    PROF_COUNT_DRIVER_ALLOCS, ///< Allocations du pilote à l'envoi des commandes (présentation, cible).
+    PROF_COUNT_SHIELD_ROWS, ///< Lignes de boucliers en bitmap envoyées aux textures (SDL).
+    PROF_COUNT_MIXER_CALLS, ///< Appels au mixeur qui changent son état (SDL_mixer).
+    PROF_COUNTER_COUNT
+} ProfilerCounter;
+
+/**
+ * @brief Statistiques d'une phase, en secondes.
+ */
+typedef struct
+{
+    uint64_t count; ///< Mesures prises en compte.
+    double min;     ///< Plus courte.
+    double avg;     ///< Moyenne.
+    double p99;     ///< 99e centile.
+    double max;     ///< Plus longue.
+} ProfilerStats;
+
+/**
+ * @brief Mesures d'une phase.
+ */
+typedef struct
+{
+    float window[PROFILER_WINDOW];      ///< Dernières mesures (s), circulaire.
+    uint32_t next;                      ///< Prochain emplacement de la fenêtre.
+    uint64_t count;                     ///< Mesures de la session.
+    double sum;                         ///< Somme des mesures (s).
+    double min, max;                    ///< Extrêmes de la session (s).
+    uint32_t buckets[PROFILER_BUCKETS]; ///< Histogramme de la session.
+} ProfilerPhaseData;
+
+/**
+ * @brief Un événement de la trace : une mesure, datée.
+ *
+ * `seq` vaut l'index d'écriture + 1 une fois l'événement complet (0 pendant
+ * l'écriture) : la lecture écarte ainsi un emplacement en cours de réécriture.
+ */
+typedef struct
+{
+    uint64_t start;    ///< Début (utils_fast_ns).
+    uint32_t duration; ///< Durée (ns, plafonnée à ~4 s).
+    uint8_t phase;  ///< ProfilerPhase.
+    uint8_t tid;    ///< 1 : thread principal, 2 : autre (simulation), 4 : GPU (PROF_GPU).
+    uint32_t seq;   ///< Numéro de l'événement + 1 (0 : incomplet).
+} ProfilerTraceEvent;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Active ou coupe les sondes (coupées au démarrage) ; la première activation étalonne l'horloge rapide.
+ */
+void profiler_enable(bool enabled);
+
+/**
+ * @brief Indique si les sondes sont actives.
+ */
+bool profiler_enabled(void);
+
+/**
+ * @brief Début d'une mesure.
+ * @return L'instant courant (utils_fast_ns), ou 0 si le profileur est coupé.
+ */
+uint64_t profiler_begin(void);
+
+/**
+ * @brief Fin d'une mesure commencée par profiler_begin.
+ *
+ * Le retour sert de début à la section suivante : des sections consécutives
+ * ne lisent l'horloge qu'une fois chacune.
+ *
+ * @return L'instant courant, ou 0 si le profileur est coupé.
+ */
+uint64_t profiler_end(ProfilerPhase phase, uint64_t start);
+
+/**
+ * @brief Clôt une section et ouvre la suivante, sans appel si la mesure n'a pas commencé.
+ *
+ * Pour les boucles chaudes (model_update) : profiler_begin renvoie 0 quand
+ * le profileur est coupé, chaque section ne coûte alors qu'une comparaison.
+ */
+#define PROFILER_LAP(phase, t) ((t) > 0 ? profiler_end((phase), (t)) : 0)
+
+/**
+ * @brief Ajoute une durée déjà mesurée (ex: intervalle de la boucle de jeu).
+ *
+ * @param ns Durée en nanosecondes.
+ */
+void profiler_record(ProfilerPhase phase, uint64_t ns);
+
+/**
+ * @brief Ajoute une mesure datée après coup, sur sa propre ligne de la trace (ex: PROF_GPU).
+ *
+ * @param start Début (horloge de utils_fast_ns).
+ * @param ns Durée en nanosecondes.
+ */
+void profiler_record_span(ProfilerPhase phase, uint64_t start, uint64_t ns);
+
+/**
+ * @brief Ajoute `n` au compteur de la frame en cours.
+ */
+void profiler_count(ProfilerCounter counter, uint32_t n);
+
+/**
+ * @brief Valeur d'un compteur sur la dernière frame terminée.
+ */
+uint32_t profiler_counter(ProfilerCounter counter);
+
+/**
+ * @brief Termine la frame : ses compteurs deviennent ceux de profiler_counter.
+ */
+void profiler_frame_end(void);
+
+/**
+ * @brief Statistiques d'une phase.
+ *
+ * @param window Reçoit celles des PROFILER_WINDOW dernières mesures (peut être NULL).
+ * @param session Reçoit celles de toute la session, p99 par l'histogramme (peut être NULL).
+ */
+void profiler_stats(ProfilerPhase phase, ProfilerStats *window, ProfilerStats *session);
+
+/**
+ * @brief Mesures brutes d'une phase (lecture seule, ex: courbe des frames).
+ */
+const ProfilerPhaseData *profiler_phase(ProfilerPhase phase);
+
+/**
+ * @brief Nom lisible d'une phase.
+ */
+const char *profiler_phase_name(ProfilerPhase phase);
+
+/**
+ * @brief Affiche le résumé de la session (min/moyenne/p99/max par phase).
+ *
+ * Ne fait rien si aucune mesure n'a été prise.
+ */
+void profiler_report(void);
+
+/**
+ * @brief Commence à enregistrer la trace (et active les sondes).
+ *
+ * À appeler depuis le thread principal : les événements des autres threads
+ * sont rangés sur une seconde ligne du chronogramme.
+ *
+ * @param path Fichier JSON écrit par profiler_trace_flush.
+ */
+void profiler_trace_open(const char *path);
+
+/**
+ * @brief Indique si une trace est en cours.
+ */
+bool profiler_trace_active(void);
+
+/**
+ * @brief Écrit les PROFILER_TRACE_EVENTS derniers événements dans le fichier de la trace.
+ *
+ * Le fichier est réécrit à chaque appel (touche de capture, puis sortie) ;
+ * l'enregistrement continue pendant l'écriture.
+ *
+ * @return Nombre d'événements écrits, 0 si aucune trace n'est ouverte ou en cas d'erreur.
+ */
+size_t profiler_trace_flush(void);
+
+/**
+ * @brief Guette les frames plus longues que `budget_s` (et active les sondes et la file de trace).
+ *
+ * À appeler depuis le thread principal, comme profiler_trace_open.
+ *
+ * @param prefix Début du nom des tranches écrites (`<prefix>-1.json`, ...).
+ */
+void profiler_hitch_open(double budget_s, const char *prefix);
+
+/**
+ * @brief Vrai juste après la mesure PROF_FRAME d'une image lente, jusqu'à profiler_frame_end.
+ */
+bool profiler_hitch_detected(void);
+
+/**
+ * @brief Ajoute une valeur au contexte de l'image lente qui vient d'être détectée.
+ *
+ * @param key Nom de la valeur (chaîne statique, gardée telle quelle jusqu'à l'écriture).
+ */
+void profiler_hitch_context(const char *key, long value);
+
+/**
+ * @brief Écrit la tranche en attente sans attendre la fin de sa fenêtre (sortie du jeu).
+ *
+ * @return Nombre de tranches écrites pendant la session.
+ */
+int profiler_hitch_flush(void);
+
+#endif // PROFILER_H
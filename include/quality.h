@@ -0,0 +1,128 @@
+/**
+ * @file quality.h
+ * @brief Régulateur de qualité : baisse les effets quand les frames dépassent leur budget.
+ *
+ * Le régulateur relit la fenêtre glissante du profileur (PROF_FRAME et
+ * PROF_WORK, cf. profiler.h) toutes les QUALITY_SAMPLES frames. Au-dessus du
+ * budget de 1/TARGET_FPS s, il descend d'un niveau ; chaque niveau coupe un
+ * effet de plus, du moins visible au plus coûteux en remplissage :
+ * particules, tremblement, fond texturé, puis résolution interne.
+ *
+ * Il remonte quand la marge revient, après un délai qui double à chaque
+ * remontée aussitôt annulée : une machine à la limite du budget ne
+ * clignote pas d'un niveau à l'autre.
+ *
+ * Avec la synchronisation verticale, l'attente de l'écran est comptée dans le
+ * rendu : seule la cadence des frames (PROF_FRAME) fait alors foi.
+ *
+ * @code
+ * QualityGovernor q;
+ * quality_init(&q, QUALITY_AUTO);
+ * // À chaque image, après le rendu :
+ * if (quality_update(&q, vsync))
+ *     apply(q.level);
+ * @endcode
+ *
+ * Le profileur coupé (SPACE_INVADERS_PROFILE=0), le niveau ne bouge plus.
+ *
+ * Le mode d'énergie (power.h) impose un plancher et une cadence plus basse
+ * (quality_constrain) : le régulateur ne remonte pas sous le plancher et
+ * mesure les frames contre le budget de cette cadence.
+ */
+
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Régulateur de qualité */
+///@{
+#define QUALITY_SAMPLES 30      ///< Frames par évaluation (et moyennées par elle).
+#define QUALITY_OVER_RATIO 0.90 ///< Travail au-delà de cette part du budget : trop lent (sans vsync).
+#define QUALITY_LATE_RATIO 1.10 ///< Cadence au-delà de cette part du budget : frames en retard.
+#define QUALITY_IDLE_RATIO 0.50 ///< Travail sous cette part du budget : marge suffisante (sans vsync).
+#define QUALITY_DOWN_EVALS 2    ///< Évaluations lentes consécutives avant de descendre.
+#define QUALITY_UP_EVALS 4      ///< Évaluations avec marge avant de remonter (au départ).
+#define QUALITY_UP_EVALS_MAX 64 ///< Plafond du délai de remontée (~32 s).
+#define QUALITY_AUTO (-1)       ///< Niveau initial : réglage automatique à partir de QUALITY_FULL.
+///@}
+
+/**
+ * @brief Niveaux de qualité, cumulatifs : chacun coupe aussi les effets des précédents.
+ */
+typedef enum
+{
+    QUALITY_FULL,          ///< Tous les effets.
+    QUALITY_NO_PARTICLES,  ///< Sans particules d'explosion.
+    QUALITY_NO_SHAKE,      ///< Sans tremblement de l'écran.
+    QUALITY_NO_BACKGROUND, ///< Fond uni au lieu de l'image de fond.
+    QUALITY_LOWRES,        ///< Cible interne basse résolution (LOWRES_WIDTH).
+    QUALITY_LEVEL_COUNT
+} QualityLevel;
+
+/**
+ * @brief État du régulateur.
+ */
+typedef struct
+{
+    int level;          ///< Niveau courant (QualityLevel).
+    bool automatic;     ///< false : niveau fixé, jamais évalué.
+    int fixed;          ///< Niveau fixé demandé (sans régulation).
+    int floor;          ///< Niveau minimal imposé (quality_constrain).
+    double budget;      ///< Durée visée d'une frame (s) : 1/TARGET_FPS, ou celle de la cadence imposée.
+    uint64_t seen;      ///< Mesures PROF_FRAME au moment de la dernière évaluation.
+    int over;           ///< Évaluations lentes consécutives.
+    int good;           ///< Évaluations avec marge consécutives.
+    int up_evals;       ///< Évaluations avec marge exigées pour remonter.
+    int since_up;       ///< Évaluations depuis la dernière remontée (-1 : aucune récente).
+    float frame_ms;     ///< Cadence moyenne de la dernière évaluation (ms).
+    float work_ms;      ///< Travail moyen de la dernière évaluation (ms).
+} QualityGovernor;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise le régulateur.
+ *
+ * @param level QUALITY_AUTO, ou un niveau fixe (borné à [0, QUALITY_LEVEL_COUNT - 1]).
+ */
+void quality_init(QualityGovernor *q, int level);
+
+/**
+ * @brief Lit le niveau demandé par SPACE_INVADERS_QUALITY ("auto" ou absent, sinon 0 à 4).
+ */
+int quality_from_env(void);
+
+/**
+ * @brief Évalue les dernières frames si QUALITY_SAMPLES nouvelles mesures sont arrivées.
+ *
+ * @param vsync La présentation attend l'écran (le travail mesuré inclut cette attente).
+ * @return true si le niveau a changé.
+ */
+bool quality_update(QualityGovernor *q, bool vsync);
+
+/**
+ * @brief Impose un niveau minimal et la cadence d'affichage visée.
+ *
+ * Un niveau fixé revient à sa valeur quand le plancher redescend ; un
+ * niveau automatique remonte de lui-même, à son rythme.
+ *
+ * @param floor Niveau minimal (QUALITY_FULL : aucun).
+ * @param hz Images par seconde visées.
+ * @return true si le niveau a changé.
+ */
+bool quality_constrain(QualityGovernor *q, int floor, int hz);
+
+/**
+ * @brief Nom lisible d'un niveau (panneau de performances).
+ */
+const char *quality_name(int level);
+
+#endif // QUALITY_H
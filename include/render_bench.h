@@ -0,0 +1,108 @@
+/**
+ * @file render_bench.h
+ * @brief Banc de rendu : une scène fixe rejouée dans une Vue, sans attente.
+ *
+ * Le Modèle avance comme en mode headless (graine et script d'entrées fixes),
+ * et chaque tick est dessiné par `view->render`, aussitôt, sans régulateur ni
+ * synchronisation verticale. Seul le rendu est chronométré : une régression
+ * de la Vue se distingue ainsi d'une régression de la simulation.
+ *
+ * - SDL : fenêtre hors écran (pilote vidéo "offscreen" si SDL_VIDEODRIVER
+ *   n'est pas défini), vsync coupée ;
+ * - ncurses : la Vue écrit dans un pseudo-terminal de RENDER_BENCH_COLS x
+ *   RENDER_BENCH_ROWS vidé par un thread, qui compte les octets réellement
+ *   envoyés ; la cadence adaptative est coupée.
+ *
+ * Avec un scénario de pire cas (stress.h, `--stress=nom`), chaque image
+ * repart du scénario composé au lancement : la commande de tir maintenu et
+ * le tick qui suit ne sont pas chronométrés, seul le dessin de cet état l'est.
+ *
+ * Les compteurs par image viennent du profileur (profiler.h) : appels de
+ * dessin, textures de texte créées et allocations (SDL, memtrack.h), octets
+ * du terminal (ncurses). Passé RENDER_BENCH_WARMUP images, une image de
+ * partie (STATE_PLAYING) ne doit plus rien allouer : le banc échoue sinon.
+ */
+
+#ifndef RENDER_BENCH_H
+#define RENDER_BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "stress.h"
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONFIGURATION
+// ============================================================================
+
+/** @name Banc de rendu */
+///@{
+#define RENDER_BENCH_DEFAULT_FRAMES 3000 ///< Images dessinées par défaut (50 s de jeu).
+#define RENDER_BENCH_COLS 120            ///< Largeur du pseudo-terminal (ncurses).
+#define RENDER_BENCH_ROWS 40             ///< Hauteur du pseudo-terminal (ncurses).
+#define RENDER_BENCH_WARMUP 120          ///< Images d'échauffement (caches, chargement audio).
+///@}
+
+/**
+ * @brief Paramètres d'un banc de rendu.
+ */
+typedef struct
+{
+    const ViewInterface *view; ///< Vue mesurée.
+    bool pty;                  ///< Rediriger la Vue vers un pseudo-terminal (ncurses).
+    long frames;               ///< Images à dessiner.
+    const char *script;        ///< Entrées rejouées en boucle (cf. HEADLESS_DEFAULT_SCRIPT).
+    uint64_t seed;             ///< Graine du modèle (même graine = même scène).
+    StressScenario stress;     ///< Scénario de pire cas redessiné à chaque image (STRESS_NONE : le script).
+} RenderBenchConfig;
+
+/**
+ * @brief Résultats d'un banc de rendu (moyennes par image).
+ */
+typedef struct
+{
+    long frames;           ///< Images dessinées.
+    double elapsed;        ///< Temps passé dans view->render (s).
+    double fps;            ///< Images par seconde de rendu seul.
+    double avg_ms;         ///< Durée moyenne d'une image (ms).
+    double p99_ms;         ///< 99e centile (ms).
+    double max_ms;         ///< Image la plus longue (ms).
+    double draw_calls;     ///< Appels de dessin par image (SDL).
+    double uploads;        ///< Textures de texte créées par image (SDL).
+    double term_bytes;     ///< Octets reçus par le pseudo-terminal par image (ncurses).
+    double term_estimate;  ///< Octets par image estimés par la Vue (ncurses).
+    bool allocs_tracked;   ///< Allocations comptées (Vue SDL, memtrack installé).
+    uint64_t startup_allocs; ///< Allocations jusqu'à la première image (init de la Vue).
+    double allocs;         ///< Allocations par image, sur tout le banc.
+    double driver_allocs;  ///< Allocations du pilote par image (SDL_RenderPresent, changement de cible).
+    long steady_frames;    ///< Images de partie après l'échauffement.
+    uint64_t steady_allocs; ///< Allocations pendant ces images (0 attendu).
+    double live_kib;       ///< Mémoire SDL vivante en fin de banc (Kio).
+} RenderBenchStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise une configuration avec les valeurs par défaut (Vue à choisir).
+ */
+void render_bench_default_config(RenderBenchConfig *cfg);
+
+/**
+ * @brief Ouvre la Vue, dessine la scène, ferme la Vue.
+ *
+ * @param model Le modèle qui porte la scène (doit sortir de model_init).
+ * @param out Statistiques remplies en fin de banc.
+ * @return false si la Vue ou le pseudo-terminal n'ont pas pu être ouverts
+ *         (une allocation en partie se lit dans `out->steady_allocs`).
+ */
+bool render_bench_run(GameModel *model, const RenderBenchConfig *cfg, RenderBenchStats *out);
+
+/**
+ * @brief Affiche le résumé sur la sortie standard.
+ */
+void render_bench_print_stats(const RenderBenchConfig *cfg, const RenderBenchStats *stats);
+
+#endif // RENDER_BENCH_H
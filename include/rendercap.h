@@ -0,0 +1,200 @@
+/**
+ * @file rendercap.h
+ * @brief Enregistrement des commandes de rendu de la Vue SDL, et leur rejeu chronométré.
+ *
+ * Pour un rapport de performance à un fabricant de GPU ou de pilote, ce qui
+ * compte est la suite exacte des appels au renderer, pas le jeu. Avec
+ * SPACE_INVADERS_RENDER_CAPTURE=fichier, chaque appel de view_sdl.c au
+ * renderer (création et envoi de textures, cibles, couleurs, modes de
+ * mélange, rectangles, géométrie, présentation) est écrit dans un flux
+ * compressé (codec.h), avec la durée de chaque image d'origine.
+ *
+ * `space_invaders render-replay fichier` rejoue ce flux dans sa propre
+ * fenêtre, sans synchronisation verticale, aussi vite que le pilote le
+ * permet, et compare les durées des images à celles de l'enregistrement.
+ * Le fichier ne contient aucune ressource du jeu : les textures sont
+ * recréées à la même taille et au même format, et chaque envoi de pixels
+ * (images, texte, boucliers) est rejoué avec un motif de même taille. La
+ * charge est donc la même pour le pilote ; seul le contenu des images
+ * diffère.
+ *
+ * Les appels passent par les relais ci-dessous : view_sdl.c définit
+ * RENDERCAP_INTERPOSE avant d'inclure ce fichier, et ses appels SDL_xxx
+ * deviennent rendercap_xxx. Sans enregistrement en cours, un relais ne
+ * coûte qu'un test avant l'appel SDL. Une texture reçoit un identifiant à
+ * sa création (propriété SDL de la texture) ; le rejeu en tient la table.
+ *
+ * @code
+ * rendercap_open("bug.sirc", renderer); // Avant la première texture
+ * ... rendu habituel, appels relayés ...
+ * rendercap_close(&stats);
+ *
+ * RendercapReport rep;                  // Outil de rejeu
+ * if (rendercap_play("bug.sirc", 10, NULL, &rep))
+ *     rendercap_print_report(&rep);
+ * @endcode
+ */
+
+#ifndef RENDERCAP_H
+#define RENDERCAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <SDL3/SDL.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Fichier de commandes */
+///@{
+#define RENDERCAP_MAGIC "SIRC"     ///< En-tête du fichier.
+#define RENDERCAP_VERSION 1        ///< Version du format.
+#define RENDERCAP_HEADER_SIZE 32   ///< Octets de l'en-tête (non compressé).
+#define RENDERCAP_MAX_ITEMS 262144 ///< Sommets, indices, rectangles ou points d'une commande au plus (rejeu).
+///@}
+
+/**
+ * @brief Bilan d'un enregistrement.
+ */
+typedef struct
+{
+    uint64_t frames;   ///< Images présentées.
+    uint64_t commands; ///< Commandes écrites.
+    uint64_t textures; ///< Textures créées.
+    uint64_t bytes;    ///< Taille du fichier.
+} RendercapStats;
+
+/**
+ * @brief Bilan d'un rejeu.
+ */
+typedef struct
+{
+    char driver[16];       ///< Pilote de l'enregistrement.
+    char played_on[16];    ///< Pilote du rejeu.
+    int width, height;     ///< Taille de sortie enregistrée.
+    int loops;             ///< Passes jouées.
+    uint64_t frames;       ///< Images par passe.
+    uint64_t commands;     ///< Commandes par passe.
+    uint64_t textures;     ///< Textures créées par passe.
+    double upload_mb;      ///< Pixels envoyés par passe (Mo).
+    double orig_avg_ms;    ///< Durée moyenne d'une image à l'enregistrement.
+    double orig_p99_ms;    ///< 99e centile à l'enregistrement.
+    double orig_max_ms;    ///< Pire image à l'enregistrement.
+    double avg_ms;         ///< Durée moyenne d'une image rejouée (toutes passes).
+    double p99_ms;         ///< 99e centile rejoué.
+    double max_ms;         ///< Pire image rejouée.
+    uint64_t slowest;      ///< Image rejouée la plus lente (numéro dans la passe, à partir de 1).
+    double total_s;        ///< Durée du rejeu.
+} RendercapReport;
+
+// ============================================================================
+//                          API PUBLIQUE : ENREGISTREMENT
+// ============================================================================
+
+/**
+ * @brief Crée le fichier de commandes et commence l'enregistrement.
+ *
+ * À appeler avant la création de la première texture : une texture créée
+ * avant n'a pas d'identifiant et ses commandes ne sont pas écrites.
+ *
+ * @return false si le fichier ne peut pas être créé.
+ */
+bool rendercap_open(const char *path, SDL_Renderer *renderer);
+
+/**
+ * @brief Indique si un enregistrement est en cours.
+ */
+bool rendercap_active(void);
+
+/**
+ * @brief Termine le flux et ferme le fichier.
+ *
+ * @param stats Reçoit le bilan (peut être NULL).
+ */
+void rendercap_close(RendercapStats *stats);
+
+// ============================================================================
+//                          API PUBLIQUE : REJEU
+// ============================================================================
+
+/**
+ * @brief Rejoue un fichier de commandes dans une fenêtre dédiée, sans synchronisation verticale.
+ *
+ * Les textures sont recréées au début de chaque passe. La durée d'une
+ * image rejouée va d'une présentation à la suivante.
+ *
+ * @param loops Nombre de passes (au moins 1).
+ * @param driver Pilote SDL_Renderer (NULL : celui de l'enregistrement s'il existe, sinon le choix de SDL).
+ * @return false si le fichier est absent, invalide ou tronqué, ou si la fenêtre ne peut pas être créée.
+ */
+bool rendercap_play(const char *path, int loops, const char *driver, RendercapReport *report);
+
+/**
+ * @brief Affiche le bilan d'un rejeu (sortie standard).
+ */
+void rendercap_print_report(const RendercapReport *report);
+
+// ============================================================================
+//                          RELAIS DES APPELS AU RENDERER
+// ============================================================================
+
+/** @name Relais (mêmes paramètres que les fonctions SDL) */
+///@{
+SDL_Texture *rendercap_create_texture(SDL_Renderer *r, SDL_PixelFormat format, SDL_TextureAccess access, int w, int h);
+SDL_Texture *rendercap_create_texture_from_surface(SDL_Renderer *r, SDL_Surface *surface);
+bool rendercap_update_texture(SDL_Texture *t, const SDL_Rect *rect, const void *pixels, int pitch);
+void rendercap_destroy_texture(SDL_Texture *t);
+bool rendercap_set_texture_blend_mode(SDL_Texture *t, SDL_BlendMode mode);
+bool rendercap_set_texture_scale_mode(SDL_Texture *t, SDL_ScaleMode mode);
+bool rendercap_set_texture_color_mod(SDL_Texture *t, Uint8 r, Uint8 g, Uint8 b);
+bool rendercap_set_texture_alpha_mod(SDL_Texture *t, Uint8 a);
+bool rendercap_set_render_target(SDL_Renderer *r, SDL_Texture *t);
+bool rendercap_set_render_logical_presentation(SDL_Renderer *r, int w, int h, SDL_RendererLogicalPresentation mode);
+bool rendercap_set_render_draw_color(SDL_Renderer *r, Uint8 red, Uint8 g, Uint8 b, Uint8 a);
+bool rendercap_set_render_draw_blend_mode(SDL_Renderer *r, SDL_BlendMode mode);
+bool rendercap_render_clear(SDL_Renderer *r);
+bool rendercap_render_fill_rect(SDL_Renderer *r, const SDL_FRect *rect);
+bool rendercap_render_fill_rects(SDL_Renderer *r, const SDL_FRect *rects, int count);
+bool rendercap_render_rect(SDL_Renderer *r, const SDL_FRect *rect);
+bool rendercap_render_line(SDL_Renderer *r, float x1, float y1, float x2, float y2);
+bool rendercap_render_points(SDL_Renderer *r, const SDL_FPoint *points, int count);
+bool rendercap_render_texture(SDL_Renderer *r, SDL_Texture *t, const SDL_FRect *src, const SDL_FRect *dst);
+bool rendercap_render_geometry(SDL_Renderer *r, SDL_Texture *t, const SDL_Vertex *vertices, int num_vertices,
+                               const int *indices, int num_indices);
+SDL_Surface *rendercap_render_read_pixels(SDL_Renderer *r, const SDL_Rect *rect);
+bool rendercap_flush_renderer(SDL_Renderer *r);
+bool rendercap_render_present(SDL_Renderer *r);
+///@}
+
+#ifdef RENDERCAP_INTERPOSE
+/** @name Appels SDL du fichier includeur remplacés par leurs relais */
+///@{
+#define SDL_CreateTexture rendercap_create_texture
+#define SDL_CreateTextureFromSurface rendercap_create_texture_from_surface
+#define SDL_UpdateTexture rendercap_update_texture
+#define SDL_DestroyTexture rendercap_destroy_texture
+#define SDL_SetTextureBlendMode rendercap_set_texture_blend_mode
+#define SDL_SetTextureScaleMode rendercap_set_texture_scale_mode
+#define SDL_SetTextureColorMod rendercap_set_texture_color_mod
+#define SDL_SetTextureAlphaMod rendercap_set_texture_alpha_mod
+#define SDL_SetRenderTarget rendercap_set_render_target
+#define SDL_SetRenderLogicalPresentation rendercap_set_render_logical_presentation
+#define SDL_SetRenderDrawColor rendercap_set_render_draw_color
+#define SDL_SetRenderDrawBlendMode rendercap_set_render_draw_blend_mode
+#define SDL_RenderClear rendercap_render_clear
+#define SDL_RenderFillRect rendercap_render_fill_rect
+#define SDL_RenderFillRects rendercap_render_fill_rects
+#define SDL_RenderRect rendercap_render_rect
+#define SDL_RenderLine rendercap_render_line
+#define SDL_RenderPoints rendercap_render_points
+#define SDL_RenderTexture rendercap_render_texture
+#define SDL_RenderGeometry rendercap_render_geometry
+#define SDL_RenderReadPixels rendercap_render_read_pixels
+#define SDL_FlushRenderer rendercap_flush_renderer
+#define SDL_RenderPresent rendercap_render_present
+///@}
+#endif
+
+#endif // RENDERCAP_H
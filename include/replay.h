@@ -0,0 +1,363 @@
+/**
+ * @file replay.h
+ * @brief Enregistrement des entrées et rejeu déterministe d'une session.
+ *
+ * Avec un générateur seedé dans le modèle, une partie est entièrement
+ * déterminée par sa graine et, pour chaque frame de la boucle de jeu, la
+ * commande lue par la Vue et le nombre de `model_update` qui ont suivi.
+ * Le fichier ne stocke que cela, compressé par plages (RLE) :
+ *
+ * @code
+ * En-tête (20 octets) : "SIRP" | version u16 | ticks/s u16 | graine u64 | drapeaux u32
+ * Plages              : [commande u8 | ticks par frame u8 | répétitions varint]...
+ * @endcode
+ *
+ * Le champ ticks/s est la fréquence de simulation de la session
+ * (model_set_tick_rate, entre MODEL_TICK_RATE_MIN et MODEL_TICK_RATE_MAX) :
+ * le rejeu simule au même pas. Les fichiers antérieurs portent tous TARGET_FPS.
+ *
+ * Une partie de 20 minutes tient en quelques Ko. Depuis la version 2, le
+ * fichier contient aussi un **instantané** complet du modèle (cf.
+ * save_encode_snapshot) toutes les REPLAY_SNAPSHOT_TICKS en partie, et se
+ * termine par un index des instantanés :
+ *
+ * @code
+ * Instantané : 0xFF | frame u64 | tick u64 | taille u32 | sauvegarde + bloc SESS
+ * Index      : 0xFE | nombre u32 | [frame u64 | tick u64 | position u64]...
+ * Fin        : "SIDX" | position de l'index u64
+ * @endcode
+ *
+ * Avec REPLAY_FLAG_COMPRESSED, tout ce qui suit l'en-tête jusqu'à l'index est
+ * compressé par blocs (cf. codec.h) ; chaque instantané ouvre un nouveau bloc,
+ * et sa position dans l'index est celle de ce bloc. Le lecteur ne décode qu'un
+ * bloc à la fois : un enregistrement n'est jamais chargé en entier.
+ *
+ * Aller à un instant donné restaure l'instantané qui le précède puis simule au
+ * plus REPLAY_SNAPSHOT_TICKS ticks. Sans index (session interrompue par un
+ * crash), les instantanés sont retrouvés par un parcours du fichier ; les
+ * fichiers de version 1 se rejouent depuis le début.
+ *
+ * Le rejeu (`./space_invaders replay <fichier> [vue] [vitesse] [début]`) tourne
+ * sans Vue à pleine vitesse par défaut, ou s'affiche dans une Vue en vitesse
+ * x1, x2, x8 ou maximale : les frames intermédiaires sont simulées sans rendu.
+ *
+ * Avec REPLAY_FLAG_HASHES, le flux porte aussi une **empreinte d'état**
+ * (statehash.h) tous les REPLAY_HASH_TICKS ticks : la chaîne des empreintes
+ * de chacun des ticks de la fenêtre écoulée.
+ *
+ * @code
+ * Empreinte : 0xFD | fin de fenêtre / REPLAY_HASH_TICKS varint | chaîne u64
+ * @endcode
+ *
+ * Le rejeu refait la même chaîne et compare : une différence situe la
+ * première divergence (non-déterminisme, build différent, entrées
+ * trafiquées) à la fenêtre près. SPACE_INVADERS_HASH_TRACE=<fichier>
+ * écrit en plus l'empreinte de chaque tick rejoué : deux traces
+ * comparées (diff) donnent le tick exact. Après un saut à un instantané,
+ * la vérification reprend à la première fenêtre entière.
+ *
+ * Ces flux se terminent par le **résultat** de la session, juste avant l'index :
+ *
+ * @code
+ * Résultat : 0xFC | ticks u64 | score u32 | niveau u32 | chaîne u64
+ * @endcode
+ *
+ * La chaîne y couvre les ticks de la dernière fenêtre, incomplète : avec elle,
+ * chaque tick de la session est vérifié. replay_verify rejoue un fichier et
+ * compare score, niveau et durée annoncés à ceux qu'il obtient (classements
+ * en ligne : `./space_invaders pool verify <dossier>`, cf. pool.h).
+ *
+ * Avec REPLAY_FLAG_PARTIAL (vidages de l'enregistreur de vol, flightrec.h),
+ * le flux commence par un instantané en frame 0 : le rejeu le restaure avant
+ * la première frame, la session ne part pas de la graine.
+ *
+ * @note Le texte tapé au clavier (nom de sauvegarde) est saisi par la Vue et
+ * n'est pas enregistré ; une session qui charge une sauvegarde suppose que le
+ * fichier existe encore au rejeu.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "codec.h"
+#include "model.h"
+#include "view_interface.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define REPLAY_MAGIC "SIRP" ///< Signature en tête de fichier.
+#define REPLAY_VERSION 2    ///< Version courante du format (instantanés + index).
+#define REPLAY_SNAPSHOT_TICKS (TARGET_FPS * 30) ///< Ticks de jeu entre deux instantanés.
+#define REPLAY_HASH_TICKS (TARGET_FPS * 2)      ///< Ticks couverts par une empreinte d'état enregistrée.
+#define REPLAY_SPEED_MAX 0  ///< Vitesse de rejeu : aussi vite que possible.
+#define REPLAY_FLAG_COMPRESSED 0x01 ///< Drapeau d'en-tête : flux des frames compressé par blocs.
+#define REPLAY_FLAG_FIXED 0x02      ///< Drapeau d'en-tête : session en physique virgule fixe (model_set_fixed_point).
+#define REPLAY_FLAG_SHIELDS 0x04    ///< Drapeau d'en-tête : boucliers en bitmap (model_set_shield_bitmap).
+#define REPLAY_FLAG_SWEPT 0x08      ///< Drapeau d'en-tête : collisions balayées des balles (model_set_swept_bullets).
+#define REPLAY_FLAG_FIRE 0x10       ///< Drapeau d'en-tête : tirs ennemis planifiés (absent : tirage à chaque tick).
+#define REPLAY_FLAG_PARTIAL 0x20    ///< Drapeau d'en-tête : le flux part d'un instantané (frame 0), pas de model_init.
+#define REPLAY_FLAG_TICKS 0x40      ///< Drapeau d'en-tête : timers arrondis au tick (absent : ticks de l'ancien décompte flottant).
+#define REPLAY_FLAG_HASHES 0x80     ///< Drapeau d'en-tête : empreintes d'état dans le flux (tous les REPLAY_HASH_TICKS ticks).
+#define REPLAY_FLAG_PATH 0x100      ///< Drapeau d'en-tête : vague en segments (absent : déplacement pas à pas).
+#define REPLAY_FLAG_RETRY 0x200     ///< Drapeau d'en-tête : départs de niveau mémorisés, « réessayer » au Game Over.
+#define REPLAY_FLAG_ENDLESS 0x400   ///< Drapeau d'en-tête : vague sans fin (model_set_endless).
+#define REPLAY_FLAG_COOP 0x800      ///< Drapeau d'en-tête : deux vaisseaux (model_set_coop), commandes CMD_HELD_P2 dans le flux.
+
+/**
+ * @brief Entrée de l'index des instantanés.
+ */
+typedef struct
+{
+    uint64_t frame;  ///< Frames rejouées avant l'instantané.
+    uint64_t tick;   ///< Ticks simulés avant l'instantané.
+    uint64_t offset; ///< Position de l'enregistrement dans le fichier.
+} ReplaySnapshot;
+
+/**
+ * @brief Enregistreur d'une session (une plage en cours, écrite quand elle change).
+ */
+typedef struct
+{
+    FILE *file;        ///< Fichier de sortie (NULL si inactif).
+    CodecWriter out;   ///< Flux des frames et instantanés (compressé ou brut).
+    uint8_t cmd;       ///< Commande de la plage en cours.
+    uint8_t updates;   ///< Ticks par frame de la plage en cours.
+    uint32_t count;    ///< Longueur de la plage en cours (0 : aucune).
+    uint64_t frames;   ///< Frames enregistrées.
+    uint64_t ticks;    ///< Ticks simulés depuis le début de la session.
+    uint64_t next_snapshot;     ///< Tick à partir duquel prendre le prochain instantané.
+    ReplaySnapshot *snapshots;  ///< Index des instantanés écrits (écrit à la fermeture).
+    uint32_t snapshot_count;    ///< Instantanés écrits.
+    uint32_t snapshot_cap;      ///< Capacité de l'index.
+    bool open;                  ///< Une commande appliquée attend encore ses ticks (replay_record_command).
+    GameCommand open_cmd;       ///< Cette commande.
+    int open_updates;           ///< Ticks simulés depuis cette commande.
+    bool hashes;                ///< Empreintes d'état dans le flux (REPLAY_FLAG_HASHES).
+    uint64_t hash;              ///< Chaîne des empreintes depuis la dernière écrite.
+    int score;                  ///< Score après le dernier tick (résultat écrit à la fermeture).
+    int level;                  ///< Niveau après le dernier tick.
+} ReplayRecorder;
+
+/**
+ * @brief Options de lecture d'un enregistrement.
+ */
+typedef struct
+{
+    const ViewInterface *view; ///< Vue d'affichage, ou NULL pour un rejeu sans Vue.
+    int speed;                 ///< Frames enregistrées par frame affichée (REPLAY_SPEED_MAX : illimité).
+    double start_s;            ///< Instant de départ (secondes de jeu).
+    FILE *hash_trace;          ///< Reçoit « tick empreinte » pour chaque tick rejoué (NULL : rien).
+} ReplayOptions;
+
+/**
+ * @brief Résultat d'un rejeu.
+ */
+typedef struct
+{
+    uint64_t seed;        ///< Graine de la session.
+    uint64_t frames;      ///< Frames rejouées.
+    uint64_t ticks;       ///< Appels à model_update.
+    int hz;               ///< Fréquence de simulation de la session (ticks par seconde).
+    double elapsed_s;     ///< Temps réel du rejeu.
+    int score;            ///< Score final.
+    int level;            ///< Niveau final.
+    int lives;            ///< Vies finales.
+    GameStateEnum state;  ///< État final du modèle.
+    bool quit;            ///< La session s'est terminée par une sortie (CMD_EXIT confirmé).
+    bool interrupted;     ///< Lecture arrêtée avant la fin par l'utilisateur.
+    uint32_t snapshots;   ///< Instantanés présents dans le fichier.
+    uint64_t seek_tick;   ///< Tick de l'instantané restauré (0 : depuis le début).
+    uint64_t seek_ticks;  ///< Ticks simulés ensuite pour atteindre l'instant demandé.
+    bool fixed_point;     ///< Session en virgule fixe (REPLAY_FLAG_FIXED).
+    bool shield_bitmap;   ///< Boucliers en bitmap (REPLAY_FLAG_SHIELDS).
+    bool swept_bullets;   ///< Collisions balayées (REPLAY_FLAG_SWEPT).
+    bool endless;         ///< Vague sans fin (REPLAY_FLAG_ENDLESS).
+    bool coop;            ///< Deux vaisseaux (REPLAY_FLAG_COOP).
+    bool fire_scheduled;  ///< Tirs ennemis planifiés (REPLAY_FLAG_FIRE).
+    bool partial;         ///< Départ d'un instantané (REPLAY_FLAG_PARTIAL).
+    uint64_t rng_state;   ///< État final du générateur (à comparer au rapport d'un vidage).
+    uint32_t fingerprint; ///< Empreinte de l'état final (save_fingerprint).
+    bool hashed;          ///< Le flux porte des empreintes d'état (REPLAY_FLAG_HASHES).
+    uint32_t hash_checks; ///< Empreintes d'état comparées.
+    uint32_t hash_mismatches; ///< Empreintes d'état différentes.
+    uint64_t desync_tick; ///< Fin de la première fenêtre divergente (0 : aucune).
+    bool claimed;         ///< Le flux se termine par le résultat de la session.
+    uint64_t claimed_ticks; ///< Ticks annoncés.
+    int claimed_score;    ///< Score annoncé.
+    int claimed_level;    ///< Niveau annoncé.
+} ReplayStats;
+
+/**
+ * @brief Verdict de replay_verify.
+ */
+typedef enum
+{
+    REPLAY_VALID,        ///< Rejoué au bit près, résultat annoncé retrouvé.
+    REPLAY_UNREADABLE,   ///< Fichier absent, tronqué ou invalide.
+    REPLAY_UNVERIFIABLE, ///< Sans empreintes ou sans résultat (ancien format, vidage, session coupée).
+    REPLAY_DESYNC,       ///< Une empreinte d'état diffère de celle du rejeu.
+    REPLAY_WRONG_RESULT  ///< Score, niveau ou durée différents de ceux annoncés.
+} ReplayVerdict;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre un fichier d'enregistrement et écrit son en-tête.
+ *
+ * La boucle de jeu le ferme en fin de session (replay_record_close) ; un hook
+ * atexit le ferme aussi si le programme sort sans y passer.
+ *
+ * Le flux porte des empreintes d'état (REPLAY_FLAG_HASHES), calculées par
+ * replay_record_tick.
+ *
+ * @param model Modèle au début de la session : sa graine, sa fréquence de
+ *              simulation (model_tick_rate), sa physique (REPLAY_FLAG_FIXED), ses boucliers (REPLAY_FLAG_SHIELDS), ses collisions
+ *              (REPLAY_FLAG_SWEPT), ses tirs ennemis (REPLAY_FLAG_FIRE), sa vague (REPLAY_FLAG_PATH, REPLAY_FLAG_ENDLESS),
+ *              son Game Over (REPLAY_FLAG_RETRY) et ses vaisseaux (REPLAY_FLAG_COOP) vont dans l'en-tête.
+ * @param compress true pour compresser le flux par blocs (REPLAY_FLAG_COMPRESSED).
+ * @return false si le fichier n'a pas pu être créé.
+ */
+bool replay_record_open(ReplayRecorder *rec, const char *path, const GameModel *model, bool compress);
+
+/**
+ * @brief Ouvre un enregistrement écrit d'un bloc, sans compression ni hook atexit.
+ *
+ * Pour un vidage (flightrec.h) : les frames suivent par replay_record_raw, et
+ * aucun instantané n'est pris en cours de route.
+ *
+ * @param seed Graine de la session.
+ * @param flags Drapeaux de la session (replay_session_flags).
+ * @param hz Fréquence de simulation de la session (model_tick_rate).
+ * @param snapshot Instantané de départ (save_encode_snapshot), ou NULL pour
+ *                 un rejeu depuis model_init ; sinon REPLAY_FLAG_PARTIAL.
+ * @param size Taille de l'instantané.
+ * @return false si le fichier n'a pas pu être créé.
+ */
+bool replay_record_open_at(ReplayRecorder *rec, const char *path, uint64_t seed, uint32_t flags, int hz,
+                           const uint8_t *snapshot, size_t size);
+
+/**
+ * @brief Drapeaux d'en-tête de la physique d'un modèle (REPLAY_FLAG_FIXED, _SHIELDS, _SWEPT, _FIRE, _TICKS, _PATH, _RETRY, _ENDLESS, _COOP).
+ */
+uint32_t replay_session_flags(const GameModel *model);
+
+/**
+ * @brief Ajoute une frame au flux, sans jamais d'instantané.
+ */
+void replay_record_raw(ReplayRecorder *rec, GameCommand cmd, int updates);
+
+/**
+ * @brief Enregistre une frame : la commande lue puis le nombre de ticks simulés.
+ *
+ * Écrit un instantané de `model` (état après la frame) dès que
+ * REPLAY_SNAPSHOT_TICKS ticks se sont écoulés depuis le précédent, à la
+ * première frame en partie (STATE_PLAYING).
+ */
+void replay_record_frame(ReplayRecorder *rec, const GameModel *model, GameCommand cmd, int updates);
+
+/**
+ * @brief Enregistre une commande, juste avant de l'appliquer au modèle, sans ses ticks.
+ *
+ * Pour une boucle qui répartit ses commandes entre les ticks : la frame de
+ * la commande précédente est close ici, avec les ticks comptés depuis par
+ * replay_record_tick. Le rejeu refait ainsi exactement les mêmes appels.
+ * L'instantané éventuel de cette frame voit donc l'état d'avant la nouvelle
+ * commande, celui d'où le rejeu repart.
+ */
+void replay_record_command(ReplayRecorder *rec, const GameModel *model, GameCommand cmd);
+
+/**
+ * @brief Compte un tick simulé, et chaîne l'empreinte de l'état qu'il a produit.
+ *
+ * À appeler après chaque model_update de la session, qu'elle enregistre ses
+ * frames par replay_record_command ou par replay_record_frame. Tous les
+ * REPLAY_HASH_TICKS ticks, la chaîne est écrite dans le flux puis repart de 0.
+ */
+void replay_record_tick(ReplayRecorder *rec, const GameModel *model);
+
+/**
+ * @brief Écrit la dernière plage, l'index des instantanés, et ferme le fichier.
+ */
+void replay_record_close(ReplayRecorder *rec);
+
+/**
+ * @brief Rejoue un enregistrement sur un modèle fraîchement initialisé.
+ *
+ * Avec `opt->start_s > 0`, le rejeu commence à l'instantané précédant cet
+ * instant, puis simule sans rendu jusqu'à lui. Avec une Vue, chaque frame
+ * affichée fait avancer `opt->speed` frames enregistrées (ou, en vitesse
+ * maximale, autant que possible en un pas de 1/TARGET_FPS s) ; Échap ou P
+ * arrête la lecture (CMD_PAUSE ou CMD_EXIT).
+ *
+ * @param model Modèle issu de model_init (la graine est prise dans le fichier).
+ * @param opt Options de lecture (NULL : sans Vue, depuis le début).
+ * @return false si le fichier est absent ou invalide.
+ */
+bool replay_play(GameModel *model, const char *path, const ReplayOptions *opt, ReplayStats *stats);
+
+/** @brief Lecture pas à pas d'un enregistrement (opaque). */
+typedef struct ReplayCursor ReplayCursor;
+
+/**
+ * @brief Ouvre un enregistrement pour le rejouer frame par frame, au rythme de l'appelant.
+ *
+ * Le modèle reçoit la physique, la fréquence et la graine de l'enregistrement,
+ * comme avec replay_play ; sans Vue, sans empreintes vérifiées.
+ *
+ * @param model Modèle issu de model_init.
+ * @return NULL si le fichier est absent ou invalide.
+ */
+ReplayCursor *replay_cursor_open(GameModel *model, const char *path);
+
+/**
+ * @brief Rejoue la frame enregistrée suivante (commande, puis ses ticks).
+ *
+ * @param ticks Reçoit le nombre de model_update faits.
+ * @return false en fin d'enregistrement ou si la session s'y est terminée.
+ */
+bool replay_cursor_step(ReplayCursor *cur, GameModel *model, int *ticks);
+
+/**
+ * @brief Fréquence de simulation de l'enregistrement (ticks par seconde).
+ */
+int replay_cursor_hz(const ReplayCursor *cur);
+
+/**
+ * @brief Ferme l'enregistrement (NULL accepté).
+ */
+void replay_cursor_close(ReplayCursor *cur);
+
+/**
+ * @brief Rejoue un enregistrement en entier, sans Vue, à pleine vitesse.
+ */
+bool replay_run(GameModel *model, const char *path, ReplayStats *stats);
+
+/**
+ * @brief Rejoue un enregistrement en entier, sans Vue, et juge le résultat qu'il annonce.
+ *
+ * Sûr depuis plusieurs threads, chacun avec son modèle (cf. pool.h).
+ *
+ * @param model Modèle issu de model_init.
+ * @param stats Reçoit le bilan du rejeu (résultat annoncé compris).
+ */
+ReplayVerdict replay_verify(GameModel *model, const char *path, ReplayStats *stats);
+
+/**
+ * @brief Libellé court d'un verdict (rapports).
+ */
+const char *replay_verdict_label(ReplayVerdict verdict);
+
+/**
+ * @brief Affiche le résultat d'un rejeu sur la sortie standard.
+ */
+void replay_print_stats(const ReplayStats *stats);
+
+#endif // REPLAY_H
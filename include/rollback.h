@@ -0,0 +1,120 @@
+/**
+ * @file rollback.h
+ * @brief Prédiction et retour en arrière (rollback) pour deux joueurs en coopération.
+ *
+ * Chaque machine simule la même partie (même graine, virgule fixe). Les
+ * touches (masque INPUT_*) de chaque joueur sont datées par tick. Quand
+ * celles de l'autre joueur ne sont pas encore arrivées, la simulation avance
+ * quand même en les prédisant : ce sont les dernières reçues.
+ *
+ * L'état au début de chaque tick récent est gardé (model_copy_sim, sans
+ * allocation). Quand une entrée arrive et contredit la prédiction, on
+ * restaure l'état du tick concerné et on resimule jusqu'au tick courant,
+ * avant l'image suivante. Au-delà de ROLLBACK_MAX_FRAMES ticks d'avance sur
+ * l'autre joueur, la simulation attend.
+ *
+ * @code
+ * rollback_add_input(&rb, local, rb.tick + delai, touches); // Entrée locale, en avance
+ * rollback_add_input(&rb, distant, tick, touches);          // Reçue du réseau, parfois en retard
+ * rollback_advance(&rb);                                    // Corrige au besoin, puis simule un tick
+ * @endcode
+ */
+
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Fenêtres */
+///@{
+#define ROLLBACK_MAX_FRAMES 10  ///< Ticks prédits au plus (au-delà, la simulation attend l'autre joueur).
+#define ROLLBACK_STATES 16      ///< États gardés (au moins ROLLBACK_MAX_FRAMES + 1).
+#define ROLLBACK_INPUT_RING 64  ///< Entrées gardées par joueur (délai local et fenêtre de prédiction).
+///@}
+
+/**
+ * @brief Session de rollback : l'état courant, l'historique et les entrées des deux joueurs.
+ */
+typedef struct
+{
+    GameModel *model;                          ///< État au début du tick `tick` (celui que la Vue dessine).
+    GameModel *states[ROLLBACK_STATES];        ///< État au début de chaque tick récent (indice : tick % ROLLBACK_STATES).
+    uint8_t input[2][ROLLBACK_INPUT_RING];     ///< Touches reçues, par joueur et par tick.
+    uint8_t used[2][ROLLBACK_INPUT_RING];      ///< Touches simulées (reçues ou prédites).
+    uint32_t known[2];                         ///< Entrées connues : ticks [0, known[p]) de chaque joueur.
+    uint32_t tick;                             ///< Prochain tick à simuler.
+    uint32_t rewind;                           ///< Plus ancien tick mal prédit (ROLLBACK_NONE : aucun).
+    double dt;                                 ///< Pas de simulation.
+
+    // --- Statistiques ---
+    long long rollbacks;   ///< Retours en arrière.
+    long long resimulated; ///< Ticks resimulés.
+    int max_depth;         ///< Plus long retour en arrière (ticks).
+    long long stalls;      ///< Images sans tick (trop d'avance sur l'autre joueur).
+} Rollback;
+
+#define ROLLBACK_NONE UINT32_MAX ///< Valeur de `rewind` sans erreur de prédiction.
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Prépare une session sur un modèle (gardé par l'appelant) et alloue l'historique.
+ *
+ * @return false si l'allocation échoue (rien n'est alors alloué).
+ */
+bool rollback_init(Rollback *rb, GameModel *model, double dt);
+
+/**
+ * @brief Libère l'historique (le modèle reste à l'appelant).
+ */
+void rollback_free(Rollback *rb);
+
+/**
+ * @brief Ajoute l'entrée d'un joueur pour un tick.
+ *
+ * Les entrées d'un joueur arrivent dans l'ordre : seule `tick == known[player]`
+ * est prise (une répétition est ignorée). Si le tick est déjà simulé avec une
+ * autre prédiction, le prochain rollback_advance y revient.
+ *
+ * @param bits Masque INPUT_*.
+ * @return true si l'entrée est nouvelle et acceptée.
+ */
+bool rollback_add_input(Rollback *rb, int player, uint32_t tick, uint8_t bits);
+
+/**
+ * @brief Touches d'un joueur pour un tick : reçues, sinon prédites (les dernières reçues).
+ */
+uint8_t rollback_input(const Rollback *rb, int player, uint32_t tick);
+
+/**
+ * @brief Corrige les erreurs de prédiction, puis simule un tick.
+ *
+ * Le son est coupé pendant la resimulation : il a déjà été joué une fois.
+ *
+ * @return false (aucun tick simulé) si la simulation a trop d'avance sur un joueur.
+ */
+bool rollback_advance(Rollback *rb);
+
+/**
+ * @brief Premier tick dont les entrées ne sont pas toutes connues.
+ *
+ * Les états des ticks précédents sont définitifs : les deux machines y ont
+ * la même empreinte (save_fingerprint).
+ */
+uint32_t rollback_confirmed(const Rollback *rb);
+
+/**
+ * @brief État définitif au début de `tick` (NULL s'il n'est pas encore définitif ou plus gardé).
+ */
+const GameModel *rollback_state(const Rollback *rb, uint32_t tick);
+
+#endif // ROLLBACK_H
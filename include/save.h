@@ -0,0 +1,172 @@
+/**
+ * @file save.h
+ * @brief Format de sauvegarde binaire versionné (Sérialisation).
+ *
+ * Au lieu de recopier le GameModel brut (menus, cache de fichiers, pointeurs
+ * implicites de mise en page...), on n'écrit que l'état de jeu, champ par champ,
+ * dans un ordre d'octets fixe (little-endian) :
+ *
+ * @code
+ * En-tête (16 octets) : "SINV" | version u16 | réservé u16 | taille u32 | CRC32 u32
+ * Charge utile        : suite de blocs  [tag 4 octets | taille u32 | données]
+ * @endcode
+ *
+ * Les blocs inconnus sont ignorés (compatibilité ascendante) ; un changement
+ * incompatible incrémente SAVE_VERSION. Le chargement est un décodage validé :
+ * en-tête, taille, CRC et bornes de chaque champ sont vérifiés avant d'écraser
+ * quoi que ce soit dans le modèle.
+ *
+ * Les timers, comptés en ticks par le modèle, sont écrits en secondes
+ * (model_countdown_seconds, model_elapsed_seconds) : une sauvegarde ne
+ * dépend pas de la fréquence de simulation qui l'a produite.
+ */
+
+#ifndef SAVE_H
+#define SAVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES DU FORMAT
+// ============================================================================
+
+#define SAVE_MAGIC "SINV"     ///< Signature en tête de fichier.
+#define SAVE_VERSION 1        ///< Version courante du format.
+#define SAVE_HEADER_SIZE 16   ///< Taille de l'en-tête (octets).
+#define SAVE_BULLET_SIZE 18   ///< Octets d'une balle dans le bloc des balles.
+#define SAVE_MAX_SIZE (8192 + MODEL_MAX_BULLET_CAPACITY * SAVE_BULLET_SIZE + MODEL_LEVEL_STARTS * (MODEL_LEVEL_START_BYTES + 6)) ///< Taille maximale d'une sauvegarde ou d'un instantané (pool de balles le plus grand, départs de niveau).
+#define SAVE_DELTA_MAX_SIZE 64 ///< Taille maximale d'un delta d'autosave (octets).
+
+/**
+ * @brief Fichier de sauvegarde projeté en mémoire (lecture seule, sans copie).
+ */
+typedef struct
+{
+    const uint8_t *data; ///< Début de la projection (NULL si vide).
+    size_t len;          ///< Taille du fichier.
+} SaveMapping;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Encode l'état de jeu dans un buffer.
+ *
+ * @param model Le modèle à sérialiser.
+ * @param buf Buffer de destination.
+ * @param cap Capacité du buffer (SAVE_MAX_SIZE suffit toujours).
+ * @return Le nombre d'octets écrits, ou 0 si le buffer est trop petit.
+ */
+size_t save_encode(const GameModel *model, uint8_t *buf, size_t cap);
+
+/**
+ * @brief Décode une sauvegarde et restaure l'état de jeu dans le modèle.
+ *
+ * Seul l'état de jeu est remplacé : menus, volume et liste des fichiers restent
+ * ceux de la session courante. Le buffer est d'abord validé en place, puis
+ * décodé directement dans le modèle (ni copie, ni allocation). En cas
+ * d'erreur, le modèle n'est pas modifié.
+ *
+ * @param model Le modèle à restaurer.
+ * @param buf Données lues depuis le disque.
+ * @param len Taille des données.
+ * @return true si la sauvegarde est valide et a été appliquée.
+ */
+bool save_decode(GameModel *model, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Encode un instantané complet (état de jeu + session) pour le rejeu.
+ *
+ * Même format qu'une sauvegarde, avec un bloc SESS en plus (état courant et
+ * précédent, sélection de menu, timers) : un rejeu peut repartir exactement
+ * de ce point. Les départs de niveau mémorisés suivent (bloc LVLS).
+ * save_decode ignore ces deux blocs.
+ *
+ * @return Le nombre d'octets écrits, ou 0 si le buffer est trop petit.
+ */
+size_t save_encode_snapshot(const GameModel *model, uint8_t *buf, size_t cap);
+
+/**
+ * @brief Encode un départ de niveau (UiState::level_starts) : l'instantané sans bloc LVLS.
+ *
+ * save_decode_snapshot le restaure ; les départs déjà mémorisés, absents de
+ * ses octets, restent alors en place.
+ *
+ * @return Le nombre d'octets écrits, ou 0 si le buffer est trop petit.
+ */
+size_t save_encode_level_start(const GameModel *model, uint8_t *buf, size_t cap);
+
+/**
+ * @brief Empreinte de l'état : CRC32 de save_encode_snapshot, sans les départs de niveau.
+ *
+ * Deux exécutions (machines, compilateurs, noyaux SIMD) qui terminent sur la
+ * même empreinte ont produit le même état, au bit près.
+ *
+ * @return 0 si l'allocation du tampon échoue.
+ */
+uint32_t save_fingerprint(const GameModel *model);
+
+/**
+ * @brief Restaure un instantané produit par save_encode_snapshot.
+ *
+ * @return false (modèle intact) si l'instantané est invalide ou sans bloc SESS.
+ */
+bool save_decode_snapshot(GameModel *model, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Valide une sauvegarde et en extrait niveau et score, sans toucher à un modèle.
+ *
+ * @param level Reçoit le niveau (peut être NULL).
+ * @param score Reçoit le score (peut être NULL).
+ * @return false si l'en-tête, le CRC ou le bloc de stats est invalide.
+ */
+bool save_read_summary(const uint8_t *buf, size_t len, int *level, int *score);
+
+/**
+ * @brief CRC32 (polynôme IEEE 802.3) d'un bloc mémoire.
+ */
+uint32_t save_crc32(const uint8_t *data, size_t len);
+
+/**
+ * @brief Encode la progression compacte (niveau, score, vies, aliens vivants,
+ * santé des boucliers) pour le journal d'autosave.
+ *
+ * @return Le nombre d'octets écrits (au plus SAVE_DELTA_MAX_SIZE), ou 0 si le buffer est trop petit.
+ */
+size_t save_encode_delta(const GameModel *model, uint8_t *buf, size_t cap);
+
+/**
+ * @brief Applique un delta au modèle restauré depuis un point de reprise.
+ *
+ * Le delta doit appartenir au même niveau et ne peut que retirer des aliens.
+ * Positions, balles, OVNI et cellules des boucliers en bitmap (hors bunkers
+ * détruits) restent ceux du point de reprise.
+ *
+ * @return false (modèle intact) si le delta est invalide ou incompatible.
+ */
+bool save_apply_delta(GameModel *model, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Projette un fichier de sauvegarde en mémoire (mmap, lecture seule).
+ *
+ * Les fichiers vides ou plus gros que SAVE_MAX_SIZE sont refusés d'emblée.
+ * Le contenu n'est pas validé : passer la projection à save_decode ou
+ * save_read_summary.
+ *
+ * @param path Chemin du fichier.
+ * @param out Reçoit la projection (à libérer avec save_unmap_file).
+ * @return false si le fichier est introuvable, de taille invalide ou non projetable.
+ */
+bool save_map_file(const char *path, SaveMapping *out);
+
+/**
+ * @brief Libère une projection obtenue par save_map_file.
+ */
+void save_unmap_file(SaveMapping *map);
+
+#endif // SAVE_H
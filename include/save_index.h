@@ -0,0 +1,126 @@
+/**
+ * @file save_index.h
+ * @brief Index du dossier de sauvegardes (métadonnées sans ouvrir chaque fichier).
+ *
+ * Le fichier texte `index.txt` du dossier de sauvegardes contient une ligne par
+ * sauvegarde :
+ *
+ * @code
+ * horodatage <TAB> niveau <TAB> score <TAB> taille <TAB> nom
+ * @endcode
+ *
+ * Il est mis à jour (réécriture atomique) à chaque sauvegarde réussie. Le menu
+ * "Charger" ne lit que ce fichier, en fond (save_index_scan_start) ; s'il est
+ * absent, il est reconstruit une fois en parcourant le dossier : métadonnées
+ * et contenus de toutes les sauvegardes sont lus en un lot (batchio.h).
+ *
+ * La Vue SDL range une miniature de la partie à côté de chaque sauvegarde
+ * (save_index_thumbnail) ; l'index n'en dépend pas : une miniature absente
+ * n'est simplement pas affichée.
+ */
+
+#ifndef SAVE_INDEX_H
+#define SAVE_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define SAVE_INDEX_FILE "index.txt" ///< Nom du fichier d'index dans le dossier.
+#define SAVE_NAME_LEN 64            ///< Taille maximale d'un nom de fichier (ex: "partie(1).dat").
+#define SAVE_THUMBNAIL_EXT ".png"   ///< Miniature rangée à côté de chaque sauvegarde (ex: "partie1.png").
+
+/**
+ * @brief Métadonnées d'une sauvegarde.
+ */
+typedef struct
+{
+    char name[SAVE_NAME_LEN]; ///< Nom du fichier (ex: "partie1.dat").
+    int64_t timestamp;        ///< Date d'écriture (secondes depuis l'epoch).
+    int level;                ///< Niveau atteint.
+    int score;                ///< Score au moment de la sauvegarde.
+    uint32_t size;            ///< Taille du fichier (octets).
+} SaveIndexEntry;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lit l'index, trié de la sauvegarde la plus récente à la plus ancienne.
+ *
+ * Au-delà de `cap` entrées, seules les plus récentes sont gardées.
+ *
+ * @param dir Dossier des sauvegardes.
+ * @param out Tableau de sortie.
+ * @param cap Capacité du tableau.
+ * @return Le nombre d'entrées lues, ou -1 si l'index n'existe pas.
+ */
+int save_index_read(const char *dir, SaveIndexEntry *out, int cap);
+
+/**
+ * @brief Ajoute ou remplace (même nom) une entrée, puis réécrit l'index atomiquement.
+ * @return false si l'index n'a pas pu être écrit.
+ */
+bool save_index_update(const char *dir, const SaveIndexEntry *entry);
+
+/**
+ * @brief Reconstruit l'index en parcourant le dossier (fichiers "*.dat" valides).
+ *
+ * Chemin lent, utilisé seulement quand l'index manque : chaque fichier est lu
+ * pour en extraire niveau et score (tous ensemble, cf. batchio_load).
+ *
+ * @return Le nombre d'entrées placées dans `out` (les plus récentes), ou -1 si
+ * le dossier est illisible.
+ */
+int save_index_rebuild(const char *dir, SaveIndexEntry *out, int cap);
+
+/**
+ * @brief Lance la lecture de la liste sur un thread : l'index, ou le dossier s'il manque.
+ *
+ * Une recherche précédente encore en cours est abandonnée. Sans index, la
+ * liste arrive en une fois, quand le lot de lectures du dossier est complet
+ * (statx et lectures de tous les fichiers ensemble, cf. batchio.h). L'index
+ * est réécrit juste avant, comme par save_index_rebuild.
+ *
+ * @param cap Entrées rendues au plus (les plus récentes).
+ * @return false si la mémoire manque (aucune recherche lancée).
+ */
+bool save_index_scan_start(const char *dir, int cap);
+
+/**
+ * @brief Relève l'avancement de la recherche, sans bloquer.
+ *
+ * @param out Reçoit la liste courante, si elle a changé depuis l'appel précédent.
+ * @param done Reçoit true quand la liste est définitive.
+ * @return Le nombre d'entrées copiées, ou -1 si rien n'a changé.
+ */
+int save_index_scan_poll(SaveIndexEntry *out, int cap, bool *done);
+
+/**
+ * @brief Nom d'une copie de sauvegarde qui n'écrase rien : "base(N).dat".
+ *
+ * N suit le plus grand suffixe déjà présent dans le dossier (1 s'il n'y en
+ * a pas), relevé en un seul parcours des noms : aucun fichier n'est ouvert,
+ * quel que soit le nombre de copies. Un numéro libéré par une suppression
+ * n'est pas réutilisé.
+ *
+ * @return false si le nom ne tient pas dans `size` octets.
+ */
+bool save_index_copy_name(const char *dir, const char *base, char *out, size_t size);
+
+/**
+ * @brief Formate une entrée pour les menus (ex: "partie1.dat  NIV 3  1230 PTS  14/10 18:05").
+ */
+void save_index_describe(const SaveIndexEntry *entry, char *buf, size_t size);
+
+/**
+ * @brief Chemin de la miniature d'une sauvegarde (ex: "sauvegardes/partie1.png" pour "partie1.dat").
+ */
+void save_index_thumbnail(const char *dir, const char *name, char *buf, size_t size);
+
+#endif // SAVE_INDEX_H
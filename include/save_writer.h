@@ -0,0 +1,97 @@
+/**
+ * @file save_writer.h
+ * @brief Écriture des sauvegardes en arrière-plan (Thread dédié).
+ *
+ * La boucle de jeu ne touche jamais au disque : elle encode l'état dans un
+ * buffer (cf. save.h) et le confie à ce module. Un thread unique écrit le
+ * fichier temporaire "<nom>.tmp", le synchronise (fsync) puis le renomme
+ * atomiquement : un fichier de sauvegarde est toujours soit l'ancien, soit
+ * le nouveau, jamais un mélange des deux. L'index du dossier (save_index.h)
+ * est ensuite mis à jour.
+ *
+ * Le résultat est relevé par sondage (save_writer_poll) depuis la boucle de jeu.
+ */
+
+#ifndef SAVE_WRITER_H
+#define SAVE_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          TYPES
+// ============================================================================
+
+/**
+ * @brief État de la dernière écriture demandée.
+ */
+typedef enum
+{
+    SAVE_WRITER_IDLE,    ///< Aucune écriture en cours ni résultat en attente.
+    SAVE_WRITER_BUSY,    ///< Écriture en cours.
+    SAVE_WRITER_DONE,    ///< Dernière écriture terminée et durable sur le disque.
+    SAVE_WRITER_FAILED   ///< Dernière écriture échouée (l'ancien fichier est intact).
+} SaveWriterStatus;
+
+/**
+ * @brief Nature d'une demande d'écriture.
+ */
+typedef enum
+{
+    SAVE_WRITE_SAVE,    ///< Sauvegarde du joueur : écriture atomique, index mis à jour, résultat rapporté.
+    SAVE_WRITE_REPLACE, ///< Écriture atomique silencieuse (ex: point de reprise de l'autosave).
+    SAVE_WRITE_APPEND,  ///< Ajout en fin de fichier, synchronisé (ex: journal de l'autosave).
+    SAVE_WRITE_DELETE   ///< Suppression du fichier.
+} SaveWriteMode;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Confie une sauvegarde au thread d'écriture (démarré au premier appel).
+ *
+ * Les données sont copiées : le buffer peut être réutilisé dès le retour.
+ * Si une écriture est déjà en cours, l'appel attend qu'elle se termine.
+ *
+ * @param dir Dossier de destination (créé s'il n'existe pas).
+ * @param filename Nom du fichier dans ce dossier.
+ * @param data Sauvegarde encodée.
+ * @param len Taille des données (au plus SAVE_MAX_SIZE).
+ * @return false si la demande n'a pas pu être prise en compte.
+ */
+bool save_writer_submit(const char *dir, const char *filename, const uint8_t *data, size_t len);
+
+/**
+ * @brief Confie une écriture de fond au thread, sans jamais attendre.
+ *
+ * Si une écriture est déjà en cours, la demande est refusée : l'appelant
+ * réessaiera plus tard (l'autosave ne doit jamais ralentir une frame).
+ * Le résultat n'est pas rapporté par save_writer_poll.
+ *
+ * @param mode SAVE_WRITE_REPLACE, SAVE_WRITE_APPEND ou SAVE_WRITE_DELETE.
+ * @return false si le thread est occupé ou la demande invalide.
+ */
+bool save_writer_try_submit(SaveWriteMode mode, const char *dir, const char *filename,
+                            const uint8_t *data, size_t len);
+
+/**
+ * @brief Relève l'état de la dernière sauvegarde du joueur, sans bloquer.
+ *
+ * Un résultat DONE ou FAILED n'est rendu qu'une fois : l'état repasse ensuite à IDLE.
+ *
+ * @param path Si non NULL, reçoit le chemin du fichier concerné.
+ * @param path_size Taille du buffer `path`.
+ */
+SaveWriterStatus save_writer_poll(char *path, size_t path_size);
+
+/**
+ * @brief Attend la fin de l'écriture en cours et arrête le thread.
+ *
+ * Appelée automatiquement à la sortie du programme (atexit) : une sauvegarde
+ * demandée juste avant de quitter n'est jamais perdue.
+ */
+void save_writer_shutdown(void);
+
+#endif // SAVE_WRITER_H
@@ -0,0 +1,145 @@
+/**
+ * @file scene.h
+ * @brief Extraction de la scène : une liste d'affichage compacte, commune à toutes les Vues.
+ *
+ * Chaque Vue parcourait le Modèle et en redéduisait les mêmes faits : quel
+ * sprite pour quel type et quelle image d'animation, explosion ou non,
+ * degré d'usure des boucliers, clignotement du vaisseau touché. Ici, le
+ * parcours et l'aiguillage par type ne se font qu'une fois : scene_build
+ * range chaque élément visible du monde de jeu dans un SceneItem (genre,
+ * position, image, teinte), et les Vues (SDL, ncurses, ANSI, web) ne font
+ * plus que traduire ces éléments en sprites ou en caractères.
+ *
+ * La liste garde, pour chaque élément, sa position au tick précédent :
+ * une Vue interpolée (scene_lerp) n'a plus besoin du modèle précédent, et
+ * une Vue en grille de caractères ignore simplement ces champs. Elle ne
+ * dépend que des deux états qu'on lui donne : scene_update ne la
+ * reconstruit que si l'un d'eux a changé, une fois par tick au plus quel
+ * que soit le nombre d'images dessinées entre deux ticks.
+ *
+ * @code
+ * static SceneList scene;
+ * scene_update(&scene, model, prev);
+ * for (int i = 0; i < scene.count; i++)
+ * {
+ *     const SceneItem *it = &scene.items[i];
+ *     float x = scene_lerp(it->px, it->x, alpha);
+ *     ...
+ * }
+ * @endcode
+ */
+
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "ecs.h"
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define SCENE_MAX_ITEMS (2 + MAX_ENEMIES + 1 + ECS_MAX_ENTITIES + BOSS_MAX_PARTS + MAX_SHIELDS + MAX_BULLETS) ///< Éléments au plus (tout le monde de jeu à la fois).
+#define SCENE_INTERP_MAX_STEP 5.0f ///< Déplacement par tick au-delà duquel un élément n'est pas interpolé.
+#define SCENE_TINT_NONE 0xFFFFFFu  ///< Teinte neutre : sprite dessiné tel quel.
+
+/**
+ * @brief Genre d'un élément, dans l'ordre de dessin.
+ */
+typedef enum
+{
+    SCENE_SHIP,    ///< Vaisseau ; `index` : joueur (0 ou 1).
+    SCENE_ENEMY,   ///< Alien ; `frame` : 2 * rang du sprite + image d'animation.
+    SCENE_UFO,     ///< Soucoupe.
+    SCENE_ENTITY,  ///< Entité du registre (ecs.h) ou pièce du vaisseau amiral : rectangle plein de la teinte de son type.
+    SCENE_SHIELD,  ///< Bouclier ; `index` : rang dans sim.shields, `frame` : usure de 0 (intact) à 9.
+    SCENE_BULLET,  ///< Balle ; `frame` : 4 * rang du sprite + image d'animation.
+    SCENE_KIND_COUNT
+} SceneKind;
+
+/** @name Drapeaux d'un élément */
+///@{
+#define SCENE_EXPLODING 0x01 ///< Alien ou soucoupe en explosion, vaisseau touché.
+///@}
+
+/**
+ * @brief Un élément à dessiner (36 octets).
+ *
+ * Pour un vaisseau touché, `frame` vaut (int)(hit_timer en secondes * 10) % 4 : son bit
+ * de poids faible alterne l'image d'explosion tous les dixièmes de seconde
+ * (Vue SDL), son bit de poids fort fait clignoter le vaisseau tous les
+ * cinquièmes (Vues texte).
+ */
+typedef struct
+{
+    float x, y;     ///< Position au tick courant (unités logiques).
+    float px, py;   ///< Position au tick précédent (égale à x, y sans interpolation).
+    float w, h;     ///< Taille (unités logiques).
+    uint32_t tint;  ///< Teinte 0xRRGGBB (SCENE_TINT_NONE pour un sprite tel quel).
+    uint8_t kind;   ///< SceneKind.
+    uint8_t type;   ///< EntityType (couleur de terminal, caractère du registre ; sans objet pour un bouclier).
+    uint8_t frame;  ///< Image : sens selon le genre (cf. SceneKind).
+    uint8_t flags;  ///< SCENE_EXPLODING...
+    uint8_t index;  ///< Rang dans son genre : joueur (vaisseau), bouclier.
+} SceneItem;
+
+/**
+ * @brief Liste d'affichage d'un état du jeu.
+ */
+typedef struct
+{
+    SceneItem items[SCENE_MAX_ITEMS]; ///< Éléments, dans l'ordre de dessin.
+    int count;                        ///< Éléments valides.
+    int first[SCENE_KIND_COUNT + 1];  ///< Premier élément de chaque genre (les genres sont contigus).
+    const GameModel *model;           ///< État extrait (clé de scene_update, jamais déréférencé ensuite).
+    const GameModel *prev;            ///< État précédent extrait (NULL : aucun).
+    uint64_t gen, prev_gen;           ///< Générations MODEL_GEN_ANY de ces deux états.
+    uint64_t builds;                  ///< Extractions effectuées (statistiques).
+} SceneList;
+
+// ============================================================================
+//                          API
+// ============================================================================
+
+/**
+ * @brief Extrait le monde de jeu de `model` dans `scene`.
+ *
+ * `prev` (peut être NULL) n'est retenu que s'il appartient à la même partie
+ * et au même niveau : les champs px, py en viennent, sinon ils valent x, y.
+ * Les aliens vivants suivent l'origine de la vague ; ceux qui explosent
+ * restent figés.
+ */
+void scene_build(SceneList *scene, const GameModel *model, const GameModel *prev);
+
+/**
+ * @brief Reconstruit `scene` seulement si `model` ou `prev` a changé depuis la dernière extraction.
+ * @return true si la liste a été reconstruite.
+ */
+bool scene_update(SceneList *scene, const GameModel *model, const GameModel *prev);
+
+/**
+ * @brief Oublie la dernière extraction (la suivante reconstruit la liste).
+ */
+void scene_invalidate(SceneList *scene);
+
+/**
+ * @brief Position interpolée entre le tick précédent et le tick courant.
+ *
+ * Un déplacement de plus de SCENE_INTERP_MAX_STEP (téléportation, réapparition)
+ * n'est pas interpolé.
+ *
+ * @param alpha Fraction du pas écoulée (0 à 1).
+ */
+static inline float scene_lerp(float prev, float cur, float alpha)
+{
+    float d = cur - prev;
+    if (d > SCENE_INTERP_MAX_STEP || d < -SCENE_INTERP_MAX_STEP)
+        return cur;
+    return prev + alpha * d;
+}
+
+#endif // SCENE_H
@@ -0,0 +1,62 @@
+/**
+ * @file sdf.h
+ * @brief Champs de distance signée (SDF) : une image de glyphe, toutes les tailles.
+ *
+ * Un glyphe rastérisé une fois (couverture 0 à 255) devient un champ de
+ * distance : chaque case garde la distance signée au bord du tracé, sur
+ * `spread` pixels de part et d'autre, codée en 0 à 255 (SDF_EDGE : sur le
+ * bord, au-dessus : à l'intérieur). Contrairement à la couverture, ce champ
+ * se rééchantillonne sans flou ni crénelage : sdf_resample en tire la
+ * couverture à n'importe quelle échelle, d'un seuil adouci sur un pixel de
+ * sortie.
+ *
+ * Le module ne dépend d'aucune bibliothèque : il travaille sur des plans
+ * de 8 bits, dans des images à `step` octets par pixel (1 pour un plan
+ * seul, 4 pour le canal alpha d'une image ARGB8888).
+ */
+
+#ifndef SDF_H
+#define SDF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES
+// ============================================================================
+
+#define SDF_EDGE 128 ///< Valeur du champ sur le bord du tracé.
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Champ de distance d'une image de couverture.
+ *
+ * Le champ mesure (w + 2 * spread) × (h + 2 * spread) : la couverture y est
+ * centrée, avec `spread` pixels de marge pour la distance extérieure. Calcul
+ * en deux passes (propagation du plus proche point du bord, 8 voisins) ;
+ * les pixels partiellement couverts placent le bord à la sous-précision.
+ *
+ * @param coverage Premier octet de couverture ; `pitch` octets par ligne, `step` par pixel.
+ * @param field Premier octet du champ ; `fpitch` octets par ligne, `fstep` par pixel.
+ * @return false si la mémoire de travail n'a pas pu être allouée (champ non écrit).
+ */
+bool sdf_generate(const uint8_t *coverage, int w, int h, int pitch, int step, int spread,
+                  uint8_t *field, int fpitch, int fstep);
+
+/**
+ * @brief Couverture d'un glyphe à l'échelle `scale`, tirée de son champ.
+ *
+ * Le pixel de sortie (x, y) échantillonne (bilinéaire) le champ au point
+ * `spread + (x + 0.5) / scale - 0.5` ; la distance, ramenée en pixels de
+ * sortie, donne la couverture par un seuil linéaire sur un pixel.
+ *
+ * @param field Champ (sdf_generate), de `fw` × `fh` cases.
+ * @param coverage Couverture écrite, `w` × `h` pixels.
+ */
+void sdf_resample(const uint8_t *field, int fw, int fh, int fpitch, int fstep, int spread, float scale,
+                  uint8_t *coverage, int w, int h, int pitch, int step);
+
+#endif // SDF_H
@@ -0,0 +1,160 @@
+/**
+ * @file sim_thread.h
+ * @brief Simulation sur un thread dédié, découplée du rendu (triple buffer).
+ *
+ * Dans la boucle classique (main.c), un SDL_RenderPresent lent (vsync,
+ * compositeur) retarde directement la lecture des entrées et la physique.
+ * Dans ce mode, le thread de simulation avance à pas fixe (1 / model_tick_rate)
+ * et publie après chaque pas une copie du modèle dans un triple buffer :
+ *
+ * @code
+ * Simulation --écrit--> [arrière] --publie--> [en attente] --prend--> [avant] --> Vue
+ * @endcode
+ *
+ * La Vue dessine toujours le dernier état publié, sans jamais bloquer la
+ * simulation (seul un échange de pointeurs se fait sous verrou). Les
+ * commandes remontent par une file : elles sont toutes appliquées, dans
+ * l'ordre, au pas suivant.
+ *
+ * Les sons ne passent pas par ces copies : le thread de simulation les dépose
+ * directement dans la file audio de la Vue (SoundState), aucun n'est donc
+ * perdu quand le rendu saute un état.
+ */
+
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include "autosave.h"
+#include "controller.h"
+#include "flightrec.h"
+#include "model.h"
+#include "replay.h"
+#include "suspend.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define SIM_COMMAND_QUEUE 64 ///< Commandes en attente au plus entre deux pas.
+#define SIM_FRAME_COUNT 3    ///< Buffers d'état (triple buffer).
+
+/**
+ * @brief Commande transmise au thread de simulation.
+ */
+typedef struct
+{
+    GameCommand cmd;                ///< Commande lue par la Vue.
+    uint32_t text_seq;              ///< Numéro de la saisie jointe (0 : aucune).
+    char text[MAX_FILENAME_LEN];    ///< Nouveau contenu de input_buffer (si text_seq).
+} SimCommand;
+
+/**
+ * @brief Un état publié : copie du modèle et numéro de la dernière saisie appliquée.
+ */
+typedef struct
+{
+    GameModel *model;  ///< Copie complète (model_clone au lancement, model_copy à chaque pas).
+    uint32_t text_seq; ///< Dernière saisie appliquée avant cette copie.
+} SimFrame;
+
+/**
+ * @brief Thread de simulation et ses échanges avec la Vue.
+ */
+typedef struct
+{
+    GameModel *model;         ///< Modèle possédé par le thread pendant la partie.
+    Autosave *autosave;       ///< Journal d'autosave (mis à jour à chaque pas).
+    ReplayRecorder *recorder; ///< Enregistrement des entrées (peut être inactif).
+    FlightRecorder *flight;   ///< Enregistreur de vol (peut être inactif).
+    Suspend *suspend;         ///< Mise en veille sur disque (peut être inactive).
+    bool kiosk;               ///< "Quitter" ramène à l'accueil (model_restart) au lieu de finir la partie.
+    uint32_t time_scale;      ///< Échelle de temps en millièmes (TIME_SCALE_NORMAL : temps réel).
+
+    pthread_t thread;      ///< Thread de simulation.
+    pthread_mutex_t lock;  ///< Protège la file, les index du triple buffer et les drapeaux.
+    bool started;          ///< Thread lancé.
+    bool stop;             ///< Arrêt demandé par la Vue.
+    bool finished;         ///< La partie est terminée (pending_quit hors kiosque, mise en veille ou sortie forcée).
+    bool force_exit;       ///< Second CMD_EXIT pendant la confirmation.
+
+    SimCommand queue[SIM_COMMAND_QUEUE]; ///< File circulaire des commandes.
+    int head, count;                     ///< Début et longueur de la file.
+    uint32_t text_seq;                   ///< Dernière saisie appliquée au modèle.
+    GameCommand last_cmd;                ///< Dernière commande appliquée (répétée si la file est vide).
+
+    uint32_t sent_seq;                 ///< Dernière saisie envoyée (thread de la Vue).
+    char sent_text[MAX_FILENAME_LEN];  ///< Contenu de cette saisie (thread de la Vue).
+
+    SimFrame frames[SIM_FRAME_COUNT]; ///< Triple buffer.
+    int back;           ///< Buffer en écriture (thread de simulation).
+    int pending;        ///< Dernier état publié.
+    int front;          ///< Buffer affiché (thread de la Vue).
+    bool fresh;         ///< `pending` n'a pas encore été pris par la Vue.
+
+    uint64_t ticks;     ///< Pas de simulation effectués.
+    uint64_t published; ///< États publiés.
+    uint64_t skipped;   ///< États remplacés avant d'avoir été affichés.
+    uint64_t late;      ///< Pas rattrapés en retard (plus d'un pas de décalage).
+} SimThread;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lance la simulation sur son propre thread.
+ *
+ * À partir de cet appel, seul le thread de simulation touche à `model` ;
+ * la Vue ne lit que les états rendus par sim_thread_acquire.
+ *
+ * @param recorder Enregistrement des entrées (fichier non ouvert : ignoré).
+ * @param flight Enregistreur de vol (inactif : ignoré), mené par le thread de simulation.
+ * @param suspend Mise en veille (inactive : ignorée), publiée après chaque pas ; un signal arrête le thread.
+ * @param kiosk true : un "Quitter" ramène le modèle à l'accueil (model_restart), seule une sortie forcée arrête.
+ * @param time_scale Échelle de temps en millièmes : l'échéance avance de dt * 1000 / time_scale par pas.
+ * @return false si le thread ou les copies du modèle n'ont pas pu être créés.
+ */
+bool sim_thread_start(SimThread *sim, GameModel *model, Autosave *autosave, ReplayRecorder *recorder,
+                      FlightRecorder *flight, Suspend *suspend, bool kiosk, uint32_t time_scale);
+
+/**
+ * @brief Renvoie le dernier état publié, à dessiner.
+ *
+ * Le buffer renvoyé appartient à la Vue jusqu'à l'appel suivant : elle peut
+ * y modifier input_buffer (cf. sim_thread_push).
+ */
+GameModel *sim_thread_acquire(SimThread *sim);
+
+/**
+ * @brief Transmet une commande au prochain pas de simulation.
+ *
+ * Si la file est pleine (simulation figée), la commande est abandonnée.
+ *
+ * @param text Nouveau contenu de input_buffer si la Vue l'a modifié, sinon NULL.
+ */
+void sim_thread_push(SimThread *sim, GameCommand cmd, const char *text);
+
+/**
+ * @brief Remet dans l'état affiché la dernière saisie envoyée mais pas encore appliquée.
+ *
+ * À appeler avant view->get_input : sans cela, une touche tapée sur un état
+ * publié avant la précédente l'écraserait.
+ */
+void sim_thread_prepare_input(SimThread *sim, GameModel *front);
+
+/**
+ * @brief Indique si la partie est terminée.
+ * @param force_exit Reçoit true si la sortie immédiate a été demandée (peut être NULL).
+ */
+bool sim_thread_finished(SimThread *sim, bool *force_exit);
+
+/**
+ * @brief Arrête le thread et rend le modèle au thread appelant.
+ */
+void sim_thread_stop(SimThread *sim);
+
+#endif // SIM_THREAD_H
@@ -0,0 +1,93 @@
+/**
+ * @file simd.h
+ * @brief Noyaux vectorisés (SIMD) pour les boucles chaudes de la simulation.
+ *
+ * Chaque noyau existe en plusieurs versions (AVX2, SSE2, NEON, scalaire).
+ * La meilleure version supportée par le CPU est choisie au premier appel
+ * (détection à l'exécution) : un même binaire tourne partout.
+ *
+ * Toutes les versions produisent des résultats identiques bit à bit à la version
+ * scalaire : le choix du backend ne change jamais le déroulement d'une partie.
+ *
+ * La variable d'environnement `SPACE_INVADERS_SIMD` (scalar, sse2, avx2, neon)
+ * force un backend, pour comparer ou déboguer.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+
+// ============================================================================
+//                          NOYAU : BALLES
+// ============================================================================
+
+/** @brief Période d'animation des balles (secondes par frame). */
+#define BULLET_ANIM_PERIOD 0.1f
+
+/** @brief Altitude sous laquelle une balle est considérée hors écran (haut). */
+#define BULLET_CULL_TOP -10.0f
+
+/**
+ * @brief Intègre un bloc contigu de balles et calcule leur masque de sortie d'écran.
+ *
+ * Pour chaque slot i de [0, n) :
+ * - `y[i] += dy[i] * dt` ;
+ * - `anim_timer[i]` avance d'un tick ; à `anim_ticks` (BULLET_ANIM_PERIOD
+ *   en ticks, cf. model.c), remise à 0 et passage à la frame suivante (4 frames) ;
+ * - bit i de `cull` mis à 1 si `y[i] < BULLET_CULL_TOP || y[i] > GAME_HEIGHT`.
+ *
+ * Les slots libres sont traités comme les autres (pas de branche) :
+ * c'est à l'appelant de croiser `cull` avec son masque d'activité.
+ *
+ * Le calcul est tout en float, pas de temps compris (`(float)dt`) : ce n'est
+ * pas l'ancien `b->y += b->dy * dt` en double, dont l'arrondi diffère
+ * environ une fois sur cent pas. Les empreintes des enregistrements faits
+ * avant le passage des balles en SoA ne se retrouvent donc plus au rejeu.
+ *
+ * @param dt Pas de temps, déjà arrondi en float par l'appelant.
+ * @param cull Masque de sortie (⌈n / 64⌉ mots), remis à zéro par l'appelant.
+ */
+void simd_bullet_step(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                      int n, float dt, uint64_t *cull);
+
+// ============================================================================
+//                          NOYAU : COLLISIONS AABB
+// ============================================================================
+
+/**
+ * @brief Teste une boîte contre N boîtes de même taille stockées en SoA.
+ *
+ * Le bit i de `hits` passe à 1 si la boîte (xs[i], ys[i], w, h) chevauche
+ * la boîte (bx, by, bw, bh). Comparaisons strictes : des bords qui se touchent ne comptent pas.
+ *
+ * @param hits Masque de sortie (⌈n / 64⌉ mots), remis à zéro par l'appelant.
+ */
+void simd_aabb_hits(float bx, float by, float bw, float bh,
+                    const float *xs, const float *ys, float w, float h,
+                    int n, uint64_t *hits);
+
+// ============================================================================
+//                          NOYAU : PARTICULES
+// ============================================================================
+
+/**
+ * @brief Intègre un bloc contigu de particules, calcule leur opacité et leur masque de mort.
+ *
+ * Pour chaque particule i de [0, n) :
+ * - `vy[i] += gravity * dt`, puis `x[i] += vx[i] * dt` et `y[i] += vy[i] * dt` ;
+ * - `life[i] -= dt` et `alpha[i] = life[i] * inv_life[i]` (fondu linéaire de 1 à 0) ;
+ * - bit i de `dead` mis à 1 si `life[i] <= 0`.
+ *
+ * @param dead Masque de sortie (⌈n / 64⌉ mots), remis à zéro par l'appelant.
+ */
+void simd_particle_step(float *x, float *y, const float *vx, float *vy,
+                        float *life, const float *inv_life, float *alpha,
+                        int n, float dt, float gravity, uint64_t *dead);
+
+/**
+ * @brief Nom du backend sélectionné ("avx2", "sse2", "neon" ou "scalar").
+ */
+const char *simd_backend_name(void);
+
+#endif // SIMD_H
@@ -0,0 +1,80 @@
+/**
+ * @file snapring.h
+ * @brief Passage sans verrou du dernier instantané d'un thread à un autre.
+ *
+ * Un producteur (thread réseau ou de simulation) remplit des instantanés de
+ * taille fixe, un consommateur ne veut que le plus récent. Les trois
+ * emplacements, fournis par l'appelant, tournent entre trois rôles :
+ * celui qu'écrit le producteur, celui que lit le consommateur, et le dernier
+ * publié, échangé atomiquement (barrières acquire/release). Personne
+ * n'attend jamais : le producteur écrit toujours en place, sans allouer, et
+ * un instantané pas encore pris est remplacé par le suivant (compteur
+ * `overwritten`).
+ *
+ * Chaque instantané publié porte un numéro de séquence (non nul) : le
+ * consommateur sait s'il est nouveau, et combien il en a manqué.
+ *
+ * @code
+ * NetFrame *f = snapring_write_slot(&ring);  // Producteur : écrit en place...
+ * snapring_publish(&ring, tick);             // ...puis publie
+ * const NetFrame *last = snapring_acquire(&ring, &seq); // Consommateur : le plus récent
+ * @endcode
+ */
+
+#ifndef SNAPRING_H
+#define SNAPRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SNAPRING_SLOTS 3 ///< Emplacements : écriture, lecture, dernier publié.
+
+/**
+ * @brief Passage d'instantanés sur un tableau fourni par l'appelant.
+ */
+typedef struct
+{
+    uint8_t *slots;                 ///< Stockage (SNAPRING_SLOTS * size octets).
+    size_t size;                    ///< Taille d'un instantané (octets).
+    uint32_t seq[SNAPRING_SLOTS];   ///< Numéro de l'instantané de chaque emplacement (0 : vide).
+    uint32_t back;                  ///< Emplacement en écriture (producteur).
+    uint32_t front;                 ///< Emplacement en lecture (consommateur).
+    uint32_t middle;                ///< Dernier publié | SNAPRING_FRESH s'il n'a pas été pris (atomique).
+    uint32_t published;             ///< Instantanés publiés (producteur).
+    uint32_t overwritten;           ///< Publiés puis remplacés avant d'être pris (producteur).
+} SnapRing;
+
+/**
+ * @brief Prépare un passage vide.
+ *
+ * @param storage Tableau de SNAPRING_SLOTS instantanés, qui doit survivre au passage.
+ * @param size Taille d'un instantané (sizeof).
+ */
+void snapring_init(SnapRing *ring, void *storage, size_t size);
+
+/**
+ * @brief Emplacement à remplir (thread producteur uniquement).
+ *
+ * Le même jusqu'à snapring_publish : un instantané abandonné (paquet
+ * invalide) est simplement réécrit au suivant.
+ */
+void *snapring_write_slot(SnapRing *ring);
+
+/**
+ * @brief Publie l'emplacement rempli (thread producteur uniquement).
+ *
+ * @param seq Numéro de l'instantané (non nul).
+ */
+void snapring_publish(SnapRing *ring, uint32_t seq);
+
+/**
+ * @brief Prend le plus récent instantané publié (thread consommateur uniquement).
+ *
+ * L'instantané rendu reste valide et intact jusqu'au prochain appel.
+ *
+ * @param seq Reçoit son numéro.
+ * @return NULL si rien n'a encore été publié.
+ */
+const void *snapring_acquire(SnapRing *ring, uint32_t *seq);
+
+#endif // SNAPRING_H
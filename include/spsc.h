@@ -0,0 +1,59 @@
+/**
+ * @file spsc.h
+ * @brief File circulaire sans verrou, un producteur et un consommateur (SPSC).
+ *
+ * Un thread ne fait qu'ajouter, un autre ne fait que retirer : chacun
+ * n'écrit que son propre index, publié avec une barrière release et lu par
+ * l'autre avec une barrière acquire. Aucun appel ne bloque ; pleine, la file
+ * refuse l'élément (compteur `dropped`, propre au producteur).
+ *
+ * Les éléments sont copiés (memcpy) : la file sert pour tout type de taille fixe.
+ */
+
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief File SPSC sur un tableau fourni par l'appelant.
+ */
+typedef struct
+{
+    uint8_t *items;     ///< Stockage (capacity * size octets).
+    size_t size;        ///< Taille d'un élément (octets).
+    uint32_t capacity;  ///< Nombre d'emplacements (puissance de 2).
+    uint32_t head;      ///< Prochain élément à retirer (écrit par le consommateur).
+    uint32_t tail;      ///< Prochain emplacement libre (écrit par le producteur).
+    uint32_t dropped;   ///< Éléments refusés, file pleine (écrit par le producteur).
+} SpscRing;
+
+/**
+ * @brief Prépare une file vide.
+ *
+ * @param storage Tableau d'au moins `capacity` éléments, qui doit survivre à la file.
+ * @param size Taille d'un élément (sizeof).
+ * @param capacity Nombre d'emplacements : une puissance de 2.
+ */
+void spsc_init(SpscRing *ring, void *storage, size_t size, uint32_t capacity);
+
+/**
+ * @brief Ajoute un élément (thread producteur uniquement).
+ * @return false si la file est pleine.
+ */
+bool spsc_push(SpscRing *ring, const void *item);
+
+/**
+ * @brief Retire le plus ancien élément (thread consommateur uniquement).
+ * @return false si la file est vide.
+ */
+bool spsc_pop(SpscRing *ring, void *item);
+
+/**
+ * @brief Indique que la file est vide, sans rien retirer (thread consommateur uniquement).
+ */
+bool spsc_empty(SpscRing *ring);
+
+#endif // SPSC_H
@@ -0,0 +1,70 @@
+/**
+ * @file starfield.h
+ * @brief Champ d'étoiles procédural à défilement parallaxe (fond de jeu sans image).
+ *
+ * Quelques centaines de points, rangés en SoA par plan, du plus lointain
+ * (lent, nombreux) au plus proche (rapide, rares). Un seul noyau les fait
+ * descendre à la vitesse de leur plan et ramène en haut, à une abscisse
+ * nouvelle, ceux qui sortent par le bas. Aucune allocation : les tableaux
+ * sont dans la structure.
+ *
+ * Remplace l'image de fond plein écran de la Vue SDL avec
+ * SPACE_INVADERS_STARFIELD=1 : ni texture à garder en mémoire vidéo, ni
+ * remplissage de toute la fenêtre à chaque image (un appel de points par
+ * plan). Effet purement visuel, avec son propre générateur : le Modèle n'en
+ * dépend pas.
+ *
+ * @code
+ * StarField sf;
+ * starfield_init(&sf, WIN_WIDTH, WIN_HEIGHT, 0x5EEDu);
+ * starfield_update(&sf, dt);                // Une fois par image, en partie
+ * for (int l = 0; l < STARFIELD_LAYERS; l++)
+ *     draw_points(&sf, sf.first[l], sf.first[l + 1]); // Une couleur par plan
+ * @endcode
+ */
+
+#ifndef STARFIELD_H
+#define STARFIELD_H
+
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Champ d'étoiles */
+///@{
+#define STARFIELD_LAYERS 3  ///< Plans de parallaxe.
+#define STARFIELD_STARS 320 ///< Étoiles en tout, tous plans confondus.
+///@}
+
+/**
+ * @brief Étoiles, en tableaux parallèles ; le plan l occupe [first[l], first[l + 1]).
+ */
+typedef struct
+{
+    float x[STARFIELD_STARS];         ///< Abscisse (pixels).
+    float y[STARFIELD_STARS];         ///< Ordonnée (pixels).
+    float speed[STARFIELD_STARS];     ///< Vitesse de descente (pixels / s).
+    int first[STARFIELD_LAYERS + 1];  ///< Première étoile de chaque plan (lointain d'abord).
+    float width, height;              ///< Zone couverte (pixels).
+    uint32_t rng;                     ///< Générateur xorshift32 des abscisses.
+} StarField;
+
+// ============================================================================
+//                          API
+// ============================================================================
+
+/**
+ * @brief Sème les étoiles sur toute la zone, plan par plan.
+ *
+ * @param seed Graine du générateur (0 : remplacée par une constante).
+ */
+void starfield_init(StarField *sf, float width, float height, uint32_t seed);
+
+/**
+ * @brief Fait descendre toutes les étoiles de `dt` secondes ; celles qui sortent repartent d'en haut.
+ */
+void starfield_update(StarField *sf, float dt);
+
+#endif // STARFIELD_H
@@ -0,0 +1,92 @@
+/**
+ * @file startup.h
+ * @brief Chronométrage du démarrage : de main() au menu affiché, puis à la première image jouable.
+ *
+ * Deux jalons sont datés depuis l'entrée dans main() :
+ * - la première image présentée (le menu) ;
+ * - la première image jouable : images du jeu et sons chargés en fond sont
+ *   branchés, une partie lancée à cette image démarre sans attente.
+ *
+ * Entre les deux, chaque étape ajoute sa durée à une phase : modèle (mémoire
+ * de la boucle de jeu et GameModel), SDL (bibliothèques, fenêtre, renderer),
+ * polices, textures (envois au GPU et cibles de rendu, sur le thread de
+ * rendu), images (décodage en fond) et audio (périphérique et sons, en fond).
+ * Les phases de fond recouvrent les autres : leur somme dépasse les jalons.
+ *
+ * Avec SPACE_INVADERS_STARTUP_BENCH=1, la boucle de jeu s'arrête dès la
+ * première image jouable (ou après STARTUP_BENCH_TIMEOUT_S) et le bilan est
+ * écrit sur la sortie standard, sur une ligne lue par `make bench-startup`
+ * (bench/startup.c) :
+ *
+ * @code
+ * [DEMARRAGE] menu_frame=182.4 playable_frame=240.9 model_init=3.1 sdl_init=95.0 ...
+ * @endcode
+ */
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <stdbool.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Démarrage */
+///@{
+#define STARTUP_BENCH_TIMEOUT_S 30.0 ///< Arrêt du banc si l'image jouable tarde (jalon absent du bilan).
+///@}
+
+/**
+ * @brief Phases du démarrage (durées cumulées).
+ */
+typedef enum
+{
+    STARTUP_MODEL,    ///< workset_init et model_init.
+    STARTUP_SDL,      ///< SDL_Init, TTF_Init, MIX_Init, fenêtre et renderer.
+    STARTUP_FONTS,    ///< Police et atlas de glyphes.
+    STARTUP_TEXTURES, ///< Fonds et atlas envoyés au GPU, cibles de rendu (thread de rendu).
+    STARTUP_IMAGES,   ///< Décodage des images du jeu (thread de fond).
+    STARTUP_AUDIO,    ///< Périphérique audio et décodage des sons (thread de fond).
+    STARTUP_PHASE_COUNT
+} StartupPhase;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Origine des mesures : à appeler en tout début de main().
+ */
+void startup_begin(void);
+
+/**
+ * @brief Ajoute une durée à une phase.
+ *
+ * @param seconds Durée en secondes.
+ */
+void startup_add(StartupPhase phase, double seconds);
+
+/**
+ * @brief Après chaque image présentée, tant que startup_playable() est faux.
+ *
+ * @param playable Images du jeu et audio branchés.
+ */
+void startup_frame(bool playable);
+
+/**
+ * @brief Vrai une fois la première image jouable présentée.
+ */
+bool startup_playable(void);
+
+/**
+ * @brief Banc de démarrage (SPACE_INVADERS_STARTUP_BENCH=1) arrivé au bout : la boucle de jeu s'arrête.
+ */
+bool startup_bench_done(void);
+
+/**
+ * @brief Écrit le bilan sur la sortie standard (banc de démarrage seulement).
+ */
+void startup_report(void);
+
+#endif // STARTUP_H
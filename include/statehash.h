@@ -0,0 +1,89 @@
+/**
+ * @file statehash.h
+ * @brief Empreinte rapide de l'état simulé (xxHash64), calculable à chaque tick.
+ *
+ * save_fingerprint encode tout un instantané avant d'en prendre le CRC32 :
+ * exact, mais trop cher pour chaque tick. Ici, les champs qui décident de la
+ * suite de la partie (machine à états, acteurs, balles actives, vague,
+ * boucliers, registre, timers, générateur) sont recopiés dans un petit tampon
+ * de mots little-endian, dans un ordre fixe, puis hachés par xxHash64 : pas
+ * d'octet de remplissage ni de pointeur, et la même valeur sur toute machine.
+ * Les balles sont prises dans l'ordre de leurs slots, les entités du registre
+ * dans l'ordre de leurs index : deux états égaux ont la même empreinte, quel
+ * que soit l'ordre de leurs listes actives.
+ *
+ * Chaîner les empreintes (la précédente sert de graine à la suivante) résume
+ * une suite de ticks en une valeur : un état qui diverge un seul tick, puis
+ * reconverge, change quand même la chaîne.
+ *
+ * @code
+ * uint64_t chain = 0;
+ * for (int t = 0; t < 120; t++)
+ * {
+ *     model_update(model, dt);
+ *     chain = statehash_model(model, chain);
+ * }
+ * @endcode
+ */
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/**
+ * @brief Hachage xxHash64 incrémental (données fournies par morceaux).
+ */
+typedef struct
+{
+    uint64_t acc[4];  ///< Accumulateurs des bandes de 32 octets.
+    uint64_t seed;    ///< Graine.
+    uint64_t total;   ///< Octets reçus.
+    uint8_t mem[32];  ///< Début de bande en attente.
+    uint32_t pending; ///< Octets dans `mem`.
+} StateHash;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Prépare un hachage.
+ */
+void statehash_init(StateHash *h, uint64_t seed);
+
+/**
+ * @brief Ajoute `len` octets au hachage.
+ */
+void statehash_update(StateHash *h, const void *data, size_t len);
+
+/**
+ * @brief Empreinte des octets reçus (le hachage peut continuer ensuite).
+ */
+uint64_t statehash_digest(const StateHash *h);
+
+/**
+ * @brief xxHash64 d'un bloc en un appel (identique à init, update, digest).
+ */
+uint64_t statehash_bytes(const void *data, size_t len, uint64_t seed);
+
+/**
+ * @brief Empreinte de l'état simulé du modèle.
+ *
+ * Menus, saisie, audio, télémétrie et durée du dernier tick n'y entrent pas.
+ * Le coût suit le nombre de balles actives : environ une microseconde en
+ * release avec MAX_BULLETS balles en vol, une douzaine de fois moins que
+ * save_fingerprint (banc `state_hash`).
+ *
+ * @param seed 0, ou l'empreinte précédente pour chaîner les ticks.
+ */
+uint64_t statehash_model(const GameModel *model, uint64_t seed);
+
+#endif // STATEHASH_H
@@ -0,0 +1,85 @@
+/**
+ * @file stress.h
+ * @brief Scénarios de pire cas : des états de partie construits aux limites configurées.
+ *
+ * Une partie réelle passe rarement par les cas pathologiques du Modèle. Ces
+ * scénarios les composent directement, pool de balles plein (capacité
+ * choisie par model_set_bullet_capacity, partage de model_set_player_bullets) :
+ *
+ * - `pool-full` : chaque slot occupé, le joueur tire sous tir triple et la
+ *   vague tire aussitôt : tous les tirs du tick sont perdus (`dropped_spawns`) ;
+ * - `formation` : toutes les balles dans la boîte de la vague, une au moins
+ *   dans chaque alien vivant ;
+ * - `shields` : toutes les balles dans les bunkers, des deux côtés ;
+ * - `ufo` : OVNI en vol touché, la moitié de la vague en explosion (un
+ *   créneau par alien, durées toutes différentes), l'autre moitié touchée
+ *   au même tick, registre des bonus plein ;
+ * - `all` : tout cela à la fois, les balles réparties entre vague, bunkers et OVNI.
+ *
+ * Le tick qui suit la construction est le plus cher que ces situations
+ * puissent produire ; les bancs repartent donc du scénario à chaque tick
+ * (bench/bench.c : centiles de model_update, render_bench.h : `--stress`).
+ *
+ * @code
+ * ./space_invaders bench-render sdl 3000 --stress=all
+ * @endcode
+ */
+
+#ifndef STRESS_H
+#define STRESS_H
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Scénarios de pire cas */
+///@{
+#define STRESS_LEVEL 20 ///< Niveau des scénarios (cadence de tir et vitesse de la vague les plus hautes).
+///@}
+
+/**
+ * @brief Les scénarios.
+ */
+typedef enum
+{
+    STRESS_NONE,          ///< Aucun (partie ordinaire).
+    STRESS_POOL_FULL,     ///< Pool plein, tirs perdus des deux camps.
+    STRESS_FORMATION,     ///< Balles dans la vague.
+    STRESS_SHIELDS,       ///< Balles dans tous les bunkers.
+    STRESS_UFO,           ///< OVNI touché, explosions et bonus au maximum.
+    STRESS_ALL,           ///< Tous les précédents à la fois.
+    STRESS_COUNT          ///< Nombre de valeurs.
+} StressScenario;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Nom court d'un scénario ("pool-full", "formation"...), "none" pour STRESS_NONE.
+ */
+const char *stress_name(StressScenario s);
+
+/**
+ * @brief Scénario d'après son nom court.
+ * @return STRESS_NONE si le nom est inconnu.
+ */
+StressScenario stress_parse(const char *name);
+
+/**
+ * @brief Compose un scénario dans une partie en cours (STATE_PLAYING).
+ *
+ * Les balles en vol sont remplacées et le niveau passe à STRESS_LEVEL ; la
+ * vague garde ses aliens vivants (`ufo` et `all` en détruisent la moitié).
+ * Les vies ne changent pas. Sans effet pour STRESS_NONE.
+ */
+void stress_build(GameModel *model, StressScenario s);
+
+/**
+ * @brief Commande à envoyer avant chaque tick d'un scénario : tir maintenu, vaisseau vers la gauche.
+ */
+GameCommand stress_command(void);
+
+#endif // STRESS_H
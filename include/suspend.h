@@ -0,0 +1,111 @@
+/**
+ * @file suspend.h
+ * @brief Mise en veille sur disque : la partie survit à SIGTERM et SIGHUP.
+ *
+ * Une borne éteinte, ou une session fermée par son gestionnaire, reçoit
+ * SIGTERM (SIGHUP pour un terminal qui se ferme) : sans rien faire, la
+ * partie en cours est perdue. Une sauvegarde classique n'est pas possible à
+ * ce moment-là : encoder le modèle, fopen et fwrite ne sont pas sûrs dans un
+ * gestionnaire de signal, et le modèle peut être à mi-tick.
+ *
+ * La boucle de jeu encode donc d'avance, après chaque tick en partie,
+ * l'instantané compact (save_encode_snapshot) dans l'un de deux tampons
+ * alloués au démarrage, puis le publie. Le gestionnaire ne fait plus
+ * qu'écrire le tampon publié : open, write, fsync, close puis rename, avec
+ * des chemins formatés à l'ouverture. Ni stdio, ni allocation, ni accès au
+ * modèle : quelques centaines de microsecondes avant fsync. Il demande
+ * ensuite à la boucle de s'arrêter proprement (suspend_requested) ; un
+ * second signal garde son effet par défaut.
+ *
+ * Au lancement suivant, suspend_resume restaure l'instantané
+ * (`sauvegardes/suspend.snap`), en pause, et supprime le fichier.
+ * Hors partie (menus, Game Over), rien n'est publié et rien n'est écrit.
+ * Actif par défaut en jeu interactif (SPACE_INVADERS_SUSPEND=0 le coupe).
+ *
+ * @code
+ * suspend_resume(model, "sauvegardes");  // Avant les enregistreurs
+ * suspend_init(&suspend, model, "sauvegardes"); // Après view->init : remplace ses gestionnaires
+ * ...
+ * model_update(model, dt);
+ * suspend_update(&suspend, model);
+ * if (suspend_requested())
+ *     running = false;
+ * ...
+ * suspend_close(&suspend);
+ * @endcode
+ */
+
+#ifndef SUSPEND_H
+#define SUSPEND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define SUSPEND_FILE "suspend.snap" ///< Nom de l'instantané dans le dossier des sauvegardes (absent du menu "Charger").
+#define SUSPEND_PATH_LEN 160        ///< Taille des chemins préformatés.
+
+/**
+ * @brief Mise en veille d'une session (tenue par la boucle de jeu).
+ */
+typedef struct
+{
+    bool active;                     ///< Tampons alloués et gestionnaires installés.
+    uint8_t *buffers[2];             ///< Instantanés encodés, en alternance.
+    size_t sizes[2];                 ///< Taille de chaque instantané.
+    size_t cap;                      ///< Capacité de chaque tampon.
+    int published;                   ///< Tampon publié + 1 (0 : rien à écrire), lu par le gestionnaire.
+    char path[SUSPEND_PATH_LEN];     ///< Fichier final.
+    char tmp_path[SUSPEND_PATH_LEN]; ///< Fichier temporaire, renommé une fois écrit.
+} Suspend;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Alloue les tampons et installe les gestionnaires de SIGTERM et SIGHUP.
+ *
+ * À appeler après l'initialisation de la Vue : ses propres gestionnaires
+ * (SDL, ncurses) sont remplacés, puis rendus par suspend_close.
+ *
+ * @param dir Dossier des sauvegardes (créé au besoin).
+ * @return false si la mise en veille est coupée (SPACE_INVADERS_SUSPEND=0) ou l'allocation échoue.
+ */
+bool suspend_init(Suspend *suspend, const GameModel *model, const char *dir);
+
+/**
+ * @brief À appeler après chaque model_update : encode et publie l'instantané en partie.
+ *
+ * En pause et sur les écrans de sauvegarde, le dernier instantané reste
+ * publié ; aux menus et au Game Over, plus rien ne l'est.
+ */
+void suspend_update(Suspend *suspend, const GameModel *model);
+
+/**
+ * @brief Un signal a écrit l'instantané : la boucle doit s'arrêter.
+ */
+bool suspend_requested(void);
+
+/**
+ * @brief Restaure la partie mise en veille au lancement précédent, puis supprime son fichier.
+ *
+ * La partie reprend en pause. Un fichier invalide est supprimé aussi.
+ *
+ * @param dir Dossier des sauvegardes.
+ * @return true si une partie a été restaurée.
+ */
+bool suspend_resume(GameModel *model, const char *dir);
+
+/**
+ * @brief Rend les gestionnaires d'origine et libère les tampons.
+ */
+void suspend_close(Suspend *suspend);
+
+#endif // SUSPEND_H
@@ -0,0 +1,133 @@
+/**
+ * @file telemetry.h
+ * @brief Télémétrie de jeu : journal binaire des événements d'une session, et son agrégation en CSV.
+ *
+ * Branché sur le Modèle (model_set_telemetry_sink), le journal reçoit chaque
+ * événement de jeu (TelemetryEvent : tirs, aliens et OVNI abattus,
+ * apparitions de l'OVNI, morts, niveaux, début et fin de partie), daté du
+ * tick de la session. Le Modèle les dépose dans une file SPSC allouée avec
+ * le journal : la boucle de jeu n'écrit jamais sur le disque. Un thread
+ * d'arrière-plan vide la file toutes les TELEMETRY_FLUSH_MS millisecondes
+ * et ajoute le lot en fin de fichier.
+ *
+ * Le fichier (`.tlm`) est un en-tête de TELEMETRY_HEADER_SIZE octets
+ * ("SITL", version, taille d'un enregistrement, graine de la session),
+ * suivi d'enregistrements de TELEMETRY_RECORD_SIZE octets, petit-boutiste :
+ *
+ * | Octets | Champ                     |
+ * |--------|---------------------------|
+ * | 0-3    | tick                      |
+ * | 4      | type (TelemetryEventType) |
+ * | 5      | précision (kind)          |
+ * | 6      | niveau                    |
+ * | 7      | vies                      |
+ * | 8-9    | x                         |
+ * | 10-11  | y                         |
+ * | 12-15  | score                     |
+ *
+ * Un journal interrompu (crash) reste lisible jusqu'à son dernier lot.
+ * telemetry_export agrège ensuite autant de journaux que voulu : un CSV des
+ * événements, et un CSV par niveau (parties qui l'atteignent, taux de
+ * réussite des tirs, morts, durée moyenne d'une vie) pour les courbes de
+ * survie.
+ *
+ * Pour une flotte entière, telemetry_aggregate lit des millions de journaux
+ * (fichiers ou dossiers, parcourus au fil de readdir) sur les threads de
+ * calcul (workers.h). Chaque journal est projeté en mémoire (mmap, lecture
+ * séquentielle) puis rendu : seul le journal en cours de chaque thread
+ * occupe la mémoire. Chaque thread a ses agrégats, fusionnés à la fin :
+ * carte des morts sur le terrain de GAME_WIDTH × GAME_HEIGHT cases (CSV et
+ * image PGM), abattus par type d'ennemi, courbe de survie par niveau
+ * (parties qui l'atteignent, parties qui s'y terminent).
+ *
+ * @code
+ * static TelemetryLog log;
+ * if (telemetry_open(&log, "sauvegardes/session.tlm", model->sim.rng.seed))
+ *     model_set_telemetry_sink(model, &log.ring);
+ * // ... partie ...
+ * model_set_telemetry_sink(model, NULL);
+ * telemetry_close(&log);
+ * @endcode
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "model.h"
+#include "spsc.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Journal de télémétrie */
+///@{
+#define TELEMETRY_MAGIC "SITL"   ///< Signature de l'en-tête.
+#define TELEMETRY_VERSION 1      ///< Version du format.
+#define TELEMETRY_HEADER_SIZE 16 ///< En-tête : signature, version (u16), taille d'enregistrement (u16), graine (u64).
+#define TELEMETRY_RECORD_SIZE 16 ///< Un événement sur le disque.
+#define TELEMETRY_RING 4096      ///< Événements en attente au plus (puissance de 2).
+#define TELEMETRY_FLUSH_MS 100   ///< Intervalle entre deux lots écrits.
+#define TELEMETRY_LEVELS 32      ///< Niveaux distingués par l'agrégation (au-delà : le dernier).
+///@}
+
+/**
+ * @brief Un journal ouvert : fichier, file des événements et thread d'écriture.
+ */
+typedef struct
+{
+    bool active;                            ///< Journal ouvert.
+    FILE *file;                             ///< Fichier, ouvert en ajout.
+    SpscRing ring;                          ///< File remplie par le Modèle, vidée par le thread.
+    TelemetryEvent storage[TELEMETRY_RING]; ///< Stockage de la file.
+    pthread_t thread;                       ///< Thread d'écriture.
+    int stop;                               ///< Arrêt demandé (atomique).
+    uint64_t written;                       ///< Événements écrits (thread d'écriture).
+    char path[160];                         ///< Chemin du journal.
+} TelemetryLog;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Crée le journal, écrit son en-tête et lance le thread d'écriture.
+ *
+ * @param seed Graine de la session (reprise dans l'en-tête).
+ * @return false si le fichier n'a pas pu être créé ou le thread lancé (journal inactif).
+ */
+bool telemetry_open(TelemetryLog *log, const char *path, uint64_t seed);
+
+/**
+ * @brief Écrit les derniers événements, arrête le thread et ferme le fichier.
+ *
+ * Le Modèle doit d'abord être débranché (model_set_telemetry_sink(model, NULL)) ou arrêté.
+ */
+void telemetry_close(TelemetryLog *log);
+
+/**
+ * @brief Agrège des journaux en deux CSV : `<prefix>.csv` (événements) et `<prefix>-niveaux.csv`.
+ *
+ * @return Nombre de journaux lus, ou -1 si aucun CSV n'a pu être créé.
+ */
+int telemetry_export(const char *prefix, const char *const *paths, int count);
+
+/**
+ * @brief Agrège en parallèle des journaux, ou les `.tlm` de dossiers, sans en écrire les événements.
+ *
+ * Écrit `<prefix>-morts.csv` et `<prefix>-morts.pgm` (morts par case du
+ * terrain), `<prefix>-types.csv` (abattus par type d'ennemi) et
+ * `<prefix>-survie.csv` (par niveau : survie, parties finies, risque, tirs,
+ * réussite, morts, durée d'une vie), puis un bilan sur la sortie standard.
+ *
+ * @param sources Journaux ou dossiers de journaux.
+ * @return Nombre de journaux lus, ou -1 si un fichier de sortie n'a pas pu être créé.
+ */
+long telemetry_aggregate(const char *prefix, const char *const *sources, int count);
+
+#endif // TELEMETRY_H
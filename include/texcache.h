@@ -0,0 +1,91 @@
+/**
+ * @file texcache.h
+ * @brief Cache disque des images déjà converties, prêtes pour SDL_UpdateTexture.
+ *
+ * Sans archive (asset_pack.h), chaque lancement décode les BMP, compose
+ * l'atlas des sprites puis convertit le tout au format des textures. Le
+ * résultat est conservé dans `cache/<clé>.tex` (SPACE_INVADERS_CACHE pour un
+ * autre dossier) : en-tête, métadonnées de l'appelant (ex: rectangles de
+ * l'atlas), puis pixels en ARGB8888 alignés sur TEXCACHE_ALIGN. Au lancement
+ * suivant, le fichier est projeté en mémoire et envoyé tel quel au GPU.
+ *
+ * Une entrée est liée à ses fichiers sources :
+ * - `stamp` : taille et date de modification de chaque source, vérifiées à
+ *   chaque ouverture (un stat par fichier) ;
+ * - `content` : hachage FNV-1a du contenu des sources, recalculé seulement
+ *   si `stamp` diffère (fichier touché mais identique : l'entrée reste bonne).
+ * Une source modifiée invalide donc l'entrée, qui est reconstruite.
+ */
+
+#ifndef TEXCACHE_H
+#define TEXCACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <SDL3/SDL.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Cache des textures */
+///@{
+#define TEXCACHE_DIR "cache"      ///< Dossier par défaut (relatif au dossier du jeu).
+#define TEXCACHE_MAGIC "SITX"     ///< Signature en tête de fichier.
+#define TEXCACHE_VERSION 1        ///< Version du format.
+#define TEXCACHE_ALIGN 64         ///< Alignement des pixels dans le fichier.
+#define TEXCACHE_KEY_MAX 96       ///< Longueur maximale d'une clé.
+#define TEXCACHE_HASH_SEED 14695981039346656037ull ///< Valeur initiale de texcache_hash (FNV-1a).
+///@}
+
+/**
+ * @brief Une entrée ouverte : pixels et métadonnées dans la projection du fichier.
+ */
+typedef struct
+{
+    void *map;          ///< Projection (NULL : entrée absente ou invalide).
+    size_t map_size;    ///< Taille projetée.
+    const void *pixels; ///< Pixels (pitch octets par ligne).
+    int w, h, pitch;    ///< Dimensions.
+    SDL_PixelFormat format; ///< Format des pixels (SDL_PIXELFORMAT_ARGB8888).
+    const void *meta;   ///< Métadonnées de l'appelant.
+    uint32_t meta_size; ///< Taille des métadonnées.
+} TexcacheEntry;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre l'entrée `key` si elle correspond encore à ses sources.
+ *
+ * @param sources Fichiers dont l'image est issue.
+ * @param salt Paramètres de construction hors fichiers (teintes, largeur d'atlas...).
+ * @return false si l'entrée est absente, d'un autre format ou périmée.
+ */
+bool texcache_open(TexcacheEntry *e, const char *key, const char *const *sources, int count, uint64_t salt);
+
+/**
+ * @brief Enregistre une image (convertie en ARGB8888) et ses métadonnées.
+ *
+ * Écriture dans un fichier temporaire puis renommage : un lancement
+ * concurrent lit l'ancienne entrée ou la nouvelle, jamais un mélange.
+ *
+ * @return false si le dossier ou le fichier n'ont pas pu être écrits.
+ */
+bool texcache_store(const char *key, const char *const *sources, int count, uint64_t salt,
+                    SDL_Surface *image, const void *meta, uint32_t meta_size);
+
+/**
+ * @brief Libère la projection d'une entrée (sans effet si elle est vide).
+ */
+void texcache_release(TexcacheEntry *e);
+
+/**
+ * @brief Hachage FNV-1a 64 bits, à chaîner depuis `h` (TEXCACHE_HASH_SEED au départ).
+ */
+uint64_t texcache_hash(const void *data, size_t size, uint64_t h);
+
+#endif // TEXCACHE_H
@@ -0,0 +1,102 @@
+/**
+ * @file thumbnail.h
+ * @brief Images rendues hors écran : encodage PNG et relecture sur un thread dédié.
+ *
+ * La Vue SDL dessine un état du Modèle dans une texture cible, relit ses
+ * pixels (SDL_RenderReadPixels) puis confie la surface à ce module : la
+ * conversion, la compression PNG et l'écriture sur le disque se font sur un
+ * thread unique, jamais dans une frame. Le fichier est écrit dans
+ * "<chemin>.tmp" puis renommé : une miniature n'est jamais à moitié écrite.
+ *
+ * Les miniatures déjà écrites sont relues par le même thread (IMG_Load) : la
+ * Vue demande des fichiers (toute une page de menu d'un coup), puis relève
+ * les surfaces décodées par sondage, dans l'ordre des demandes.
+ *
+ * @code
+ * thumbnail_save(SDL_RenderReadPixels(renderer, NULL), "sauvegardes/partie1.png");
+ * thumbnail_request("sauvegardes/partie1.png");
+ * SDL_Surface *s;
+ * if (thumbnail_take(path, sizeof(path), &s) && s) // Une frame plus tard (ou plus)
+ *     texture = SDL_CreateTextureFromSurface(renderer, s);
+ * @endcode
+ */
+
+#ifndef THUMBNAIL_H
+#define THUMBNAIL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <SDL3/SDL.h>
+
+// ============================================================================
+//                          CONSTANTES
+// ============================================================================
+
+/** @name Miniatures */
+///@{
+#define THUMBNAIL_WIDTH 240  ///< Largeur des miniatures de sauvegarde (pixels, 1/5 de la fenêtre).
+#define THUMBNAIL_HEIGHT 144 ///< Hauteur des miniatures de sauvegarde (pixels).
+#define THUMBNAIL_QUEUE 4    ///< Images en attente d'écriture au plus.
+#define THUMBNAIL_LOADS 16   ///< Décodages en attente (ou résultats non relevés) au plus.
+#define THUMBNAIL_PATH_LEN 192 ///< Taille maximale d'un chemin.
+///@}
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Confie une image au thread d'écriture (démarré au premier appel), sans attendre.
+ *
+ * La surface appartient ensuite au module, qui la libère, y compris en cas
+ * de refus.
+ *
+ * @param surface Pixels relus (NULL : rien à écrire, l'appel échoue).
+ * @param path Fichier PNG de destination.
+ * @return false si la file est pleine ou le thread indisponible.
+ */
+bool thumbnail_save(SDL_Surface *surface, const char *path);
+
+/**
+ * @brief Demande le décodage d'un PNG en fond (après les demandes déjà en file).
+ *
+ * Au-delà de THUMBNAIL_LOADS demandes en attente, la plus ancienne est abandonnée.
+ *
+ * @return false si le thread est indisponible.
+ */
+bool thumbnail_request(const char *path);
+
+/**
+ * @brief Abandonne les décodages demandés mais pas encore commencés (page de menu quittée).
+ */
+void thumbnail_cancel_loads(void);
+
+/**
+ * @brief Indique qu'un décodage demandé n'a pas encore été relevé (la Vue a une miniature à afficher).
+ */
+bool thumbnail_loading(void);
+
+/**
+ * @brief Relève le plus ancien décodage terminé, sans bloquer.
+ *
+ * @param path Reçoit le chemin demandé.
+ * @param size Taille du buffer `path`.
+ * @param out Reçoit la surface décodée (à libérer par l'appelant), ou NULL si
+ *            le fichier est absent ou illisible.
+ * @return true si un résultat était prêt (chacun n'est rendu qu'une fois).
+ */
+bool thumbnail_take(char *path, size_t size, SDL_Surface **out);
+
+/**
+ * @brief Attend que toutes les images confiées soient écrites.
+ * @return false si une écriture a échoué depuis l'appel précédent.
+ */
+bool thumbnail_flush(void);
+
+/**
+ * @brief Écrit les images en attente puis arrête le thread.
+ */
+void thumbnail_shutdown(void);
+
+#endif // THUMBNAIL_H
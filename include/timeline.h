@@ -0,0 +1,114 @@
+/**
+ * @file timeline.h
+ * @brief Enchaînements scriptés (attente, fondus, changement d'état), avancés par model_update.
+ *
+ * Une transition (message de sauvegarde, sortie du Game Over) est une courte
+ * suite d'étapes comptées en ticks : tenir un écran, le fondre au noir,
+ * changer d'état, revenir du noir. Elle avance d'un pas par tick, dans la
+ * boucle normale : la boucle de jeu continue de dessiner et de lire les
+ * entrées, sans jamais dormir, et le rejeu refait les mêmes ticks.
+ *
+ * La structure ne contient que des entiers : elle vit dans l'état simulé et
+ * suit ses copies (rollback, instantanés du rejeu).
+ *
+ * @code
+ * static const TimelineStep steps[] = {{TIMELINE_HOLD, 120}, {TIMELINE_FADE_OUT, 24}, {TIMELINE_SWITCH, 0},
+ *                                      {TIMELINE_FADE_IN, 24}};
+ * timeline_start(&sim->transition, steps, 4, 0);
+ * ...
+ * if (timeline_tick(&sim->transition) == TIMELINE_SWITCH)
+ *     sim->state = STATE_MENU; // L'étape de bascule est rendue une fois, au tick où elle est atteinte
+ * @endcode
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+#define TIMELINE_MAX_STEPS 6 ///< Étapes au plus par transition.
+
+/**
+ * @brief Nature d'une étape.
+ */
+typedef enum
+{
+    TIMELINE_NONE,     ///< Aucune (transition finie, ou retour de timeline_tick sans événement).
+    TIMELINE_HOLD,     ///< Tenir l'écran courant.
+    TIMELINE_FADE_OUT, ///< Fondu vers le noir.
+    TIMELINE_FADE_IN,  ///< Retour du noir.
+    TIMELINE_SWITCH    ///< Bascule (état suivant, sortie...) : décidée par l'appelant, sans durée.
+} TimelineOp;
+
+/**
+ * @brief Une étape : sa nature et sa durée.
+ */
+typedef struct
+{
+    uint8_t op;    ///< TimelineOp.
+    uint16_t ticks; ///< Durée (ignorée pour TIMELINE_SWITCH).
+} TimelineStep;
+
+/**
+ * @brief Transition en cours (count à 0 : aucune).
+ */
+typedef struct
+{
+    TimelineStep steps[TIMELINE_MAX_STEPS]; ///< Étapes.
+    uint8_t tag;                            ///< Sens de la bascule, libre pour l'appelant.
+    uint8_t count;                          ///< Nombre d'étapes.
+    uint8_t step;                           ///< Étape courante (count : finie).
+    uint16_t elapsed;                       ///< Ticks passés dans l'étape courante.
+} Timeline;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lance une transition (remplace celle en cours ; tronquée à TIMELINE_MAX_STEPS).
+ *
+ * @param tag Valeur rendue à l'appelant à la bascule (Timeline::tag).
+ */
+void timeline_start(Timeline *t, const TimelineStep *steps, int count, uint8_t tag);
+
+/**
+ * @brief Une transition est en cours.
+ */
+static inline bool timeline_active(const Timeline *t)
+{
+    return t->step < t->count;
+}
+
+/**
+ * @brief Une bascule reste à venir : l'écran courant n'attend plus d'entrée.
+ */
+bool timeline_before_switch(const Timeline *t);
+
+/**
+ * @brief Avance d'un tick.
+ *
+ * Les étapes de durée nulle sont franchies dans le même tick.
+ *
+ * @return TIMELINE_SWITCH si une bascule est atteinte pendant ce tick, sinon TIMELINE_NONE.
+ */
+TimelineOp timeline_tick(Timeline *t);
+
+/**
+ * @brief Saute les attentes et fondus jusqu'à la prochaine bascule (touche pressée).
+ *
+ * Sans bascule restante, la transition se termine.
+ */
+void timeline_skip(Timeline *t);
+
+/**
+ * @brief Opacité du noir à dessiner par-dessus l'image (0 : aucun, 1 : noir complet).
+ */
+float timeline_fade(const Timeline *t);
+
+#endif // TIMELINE_H
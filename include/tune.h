@@ -0,0 +1,119 @@
+/**
+ * @file tune.h
+ * @brief Réglage de la difficulté par Monte-Carlo : une courbe de niveaux, écrite en script de vagues.
+ *
+ * La difficulté d'une vague tient à deux constantes du script (wave.h) : la
+ * vitesse de la formation (`speed`) et la cadence de tir (`fire`). Pour
+ * chaque niveau, le régleur essaie TUNE_STEPS intensités, de la plus douce
+ * (TUNE_SPEED_MIN, TUNE_FIRE_MIN) à la plus dure (TUNE_SPEED_MAX,
+ * TUNE_FIRE_MAX), et joue chacune sur le pool (pool.h) : des milliers de
+ * parties du bot, limitées à cette seule vague, avec trois vies. Leur taux
+ * de victoire donne une courbe par niveau ; l'intensité retenue est celle
+ * où la courbe croise la cible du niveau, interpolée entre deux essais.
+ *
+ * Les cibles descendent en ligne droite de `target_first` (premier niveau)
+ * à `target_last` (dernier). Toutes les intensités d'un niveau jouent les
+ * mêmes graines : l'écart entre deux essais tient au réglage, pas au hasard.
+ * La forme, l'espacement et le gain de vitesse de chaque vague restent ceux
+ * de la table courante (SPACE_INVADERS_WAVES ou vague classique).
+ *
+ * @code
+ * TuneConfig cfg;
+ * tune_default_config(&cfg);
+ * cfg.levels = 10;
+ * TuneResult r;
+ * if (tune_run(&cfg, &r))
+ *     wave_format(&r.table, text, sizeof(text)); // Script prêt pour SPACE_INVADERS_WAVES
+ * @endcode
+ */
+
+#ifndef TUNE_H
+#define TUNE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bot.h"
+#include "wave.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Plage du réglage */
+///@{
+#define TUNE_STEPS 9                       ///< Intensités essayées par niveau (0 à 1, pas régulier).
+#define TUNE_SPEED_MIN 0.5f                ///< Multiplicateur de vitesse à l'intensité 0.
+#define TUNE_SPEED_MAX 2.5f                ///< Multiplicateur de vitesse à l'intensité 1.
+#define TUNE_FIRE_MIN 1                    ///< Cadence de tir (%) à l'intensité 0.
+#define TUNE_FIRE_MAX 24                   ///< Cadence de tir (%) à l'intensité 1.
+#define TUNE_TARGET_FIRST 0.95f            ///< Taux de victoire visé au premier niveau.
+#define TUNE_TARGET_LAST 0.50f             ///< Taux de victoire visé au dernier niveau.
+#define TUNE_WAVE_TICKS (TARGET_FPS * 180) ///< Ticks au plus par vague jouée (au-delà : perdue).
+///@}
+
+/**
+ * @brief Paramètres d'un réglage.
+ */
+typedef struct
+{
+    int levels;           ///< Niveaux à régler (1 à WAVE_MAX).
+    long games;           ///< Parties par intensité essayée.
+    int threads;          ///< Threads du pool (0 : un par cœur).
+    const BotConfig *bot; ///< Joueur des parties (NULL : BOT_LEVEL_NORMAL).
+    float target_first;   ///< Taux de victoire visé au premier niveau.
+    float target_last;    ///< Taux de victoire visé au dernier niveau.
+    uint64_t first_seed;  ///< Graine de la première partie de chaque essai.
+} TuneConfig;
+
+/**
+ * @brief Réglage d'un niveau.
+ */
+typedef struct
+{
+    float target;            ///< Taux de victoire visé.
+    float rates[TUNE_STEPS]; ///< Taux de victoire mesuré à chaque intensité (rendu décroissant).
+    float intensity;         ///< Intensité retenue (0 à 1).
+    float speed;             ///< Multiplicateur de vitesse retenu.
+    int fire;                ///< Cadence de tir retenue (%).
+    float clear_rate;        ///< Taux de victoire attendu à cette intensité (interpolé).
+} TuneLevel;
+
+/**
+ * @brief Résultat d'un réglage.
+ */
+typedef struct
+{
+    TuneLevel levels[WAVE_MAX]; ///< Un réglage par niveau.
+    int count;                  ///< Niveaux réglés.
+    WaveTable table;            ///< Vagues réglées (une par niveau, cadence sans pente).
+    long games;                 ///< Parties jouées en tout.
+    long long ticks;            ///< Ticks simulés en tout.
+    double elapsed;             ///< Temps réel (secondes).
+} TuneResult;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Réglage par défaut : 10 niveaux, 200 parties par essai, cibles TUNE_TARGET_*.
+ */
+void tune_default_config(TuneConfig *cfg);
+
+/**
+ * @brief Règle chaque niveau, puis installe la table réglée (wave_set_table).
+ *
+ * Comme pool_run, à lancer hors de toute simulation : chaque essai remplace
+ * la table partagée des vagues le temps de ses parties.
+ *
+ * @return false si la configuration est invalide ou si le pool n'a pas démarré.
+ */
+bool tune_run(const TuneConfig *cfg, TuneResult *out);
+
+/**
+ * @brief Affiche les courbes mesurées et le réglage de chaque niveau.
+ */
+void tune_print(const TuneResult *result);
+
+#endif // TUNE_H
@@ -11,6 +11,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 // ============================================================================
@@ -28,6 +29,44 @@
  */
 double utils_get_time(void);
 
+/**
+ * @brief Même horloge que utils_get_time, en nanosecondes entières.
+ *
+ * Un entier ne perd aucune précision, quelle que soit la durée de
+ * fonctionnement de la machine : un double en secondes ne distingue plus
+ * que des pas de quelques dizaines de nanosecondes après quelques semaines.
+ *
+ * @return Nanosecondes de l'horloge monotone.
+ */
+uint64_t utils_now_ns(void);
+
+#define UTILS_NS_PER_S 1000000000ULL ///< Nanosecondes par seconde.
+
+/**
+ * @brief Prépare l'horloge rapide des sondes (utils_fast_ns).
+ *
+ * Sur x86-64 à compteur invariant (TSC), son rapport aux nanosecondes est
+ * étalonné contre l'horloge monotone pendant UTILS_FAST_CALIBRATION_NS ;
+ * sur AArch64, le compteur virtuel (CNTVCT_EL0) donne sa fréquence. Sinon,
+ * ou avec SPACE_INVADERS_TSC=0, utils_fast_ns reste utils_now_ns.
+ * Appels suivants sans effet.
+ *
+ * @return true si le compteur matériel est utilisé.
+ */
+bool utils_fast_clock_init(void);
+
+#define UTILS_FAST_CALIBRATION_NS 5000000ULL ///< Durée d'étalonnage du compteur x86 (5 ms).
+
+/**
+ * @brief Instant des sondes, en nanosecondes : quelques nanosecondes par lecture.
+ *
+ * Même origine que utils_now_ns à l'étalonnage, mais une échelle étalonnée :
+ * précis pour mesurer des durées, l'écart à utils_now_ns peut croître de
+ * quelques millisecondes par heure. Les instants ne se comparent donc
+ * qu'entre eux (profileur, trace).
+ */
+uint64_t utils_fast_ns(void);
+
 /**
  * @brief Met le thread principal en pause (Sleep).
  *
@@ -38,6 +77,91 @@ double utils_get_time(void);
  */
 void utils_sleep_ms(int ms);
 
+#define UTILS_SPIN_S 0.0003     ///< Fin d'attente active avant une échéance (s), marge contre le retard du réveil.
+#define PACER_VSYNC_MIN_S 0.002 ///< Intervalle sous lequel une présentation n'a pas attendu l'écran (500 Hz).
+#define PACER_VSYNC_PROBE 30    ///< Images trop rapides de suite avant d'abandonner la vsync.
+
+/**
+ * @brief Attend jusqu'à un instant précis de utils_get_time().
+ *
+ * Dort jusqu'à UTILS_SPIN_S avant l'échéance (clock_nanosleep en temps
+ * absolu : pas d'arrondi à la milliseconde ni de dérive), puis cède le CPU
+ * en boucle (sched_yield) jusqu'à l'échéance exacte.
+ *
+ * @param deadline Instant visé, en secondes (même horloge que utils_get_time).
+ */
+void utils_sleep_until(double deadline);
+
+/**
+ * @brief utils_sleep_until, échéance en nanosecondes de utils_now_ns.
+ */
+void utils_sleep_until_ns(uint64_t deadline);
+
+/**
+ * @brief Régulateur de cadence d'affichage et mesure de sa régularité.
+ *
+ * Les échéances avancent d'exactement une période à chaque image ; après un
+ * retard de plus d'une période, elles repartent de l'instant courant au lieu
+ * d'enchaîner des images sans pause. Avec la synchronisation verticale, la
+ * présentation de l'image cadence déjà la boucle : le régulateur ne fait que
+ * mesurer, tant qu'elle bloque vraiment (certains pilotes l'acceptent sans
+ * l'appliquer : plus de PACER_VSYNC_PROBE images quasi instantanées de suite
+ * et il reprend ses propres échéances).
+ */
+typedef struct
+{
+    uint64_t period;   ///< Durée visée d'une image (ns).
+    uint64_t nominal;  ///< Période de départ (utils_pacer_init).
+    uint64_t deadline; ///< Début visé de l'image suivante (utils_now_ns).
+    bool vsync;        ///< La Vue se cale sur l'écran : pas d'attente.
+    bool capped;       ///< Cadence abaissée (utils_pacer_set_rate) : attente des échéances même avec la vsync.
+    int fast;          ///< Images consécutives sous PACER_VSYNC_MIN_S malgré la vsync.
+
+    // Mesures (intervalle entre deux débuts d'image, en ns)
+    uint64_t last;     ///< Début de l'image précédente (0 : aucune).
+    uint64_t frames;   ///< Intervalles mesurés.
+    uint64_t sum;      ///< Somme des intervalles.
+    double sum_sq;     ///< Somme des carrés des intervalles (ns², hors d'un entier 64 bits).
+    uint64_t min, max; ///< Plus court et plus long intervalle.
+    uint64_t late;     ///< Intervalles de plus d'une période et demie (image sautée).
+} FramePacer;
+
+/**
+ * @brief Prépare le régulateur.
+ *
+ * @param hz Images par seconde visées.
+ * @param vsync true si la Vue attend déjà la synchronisation verticale.
+ */
+void utils_pacer_init(FramePacer *pacer, int hz, bool vsync);
+
+/**
+ * @brief Attend le début de l'image suivante et mesure l'intervalle écoulé.
+ */
+void utils_pacer_wait(FramePacer *pacer);
+
+/**
+ * @brief Change la cadence visée en cours de route (mode d'énergie, cf. power.h).
+ *
+ * Sous la cadence de départ, les échéances sont attendues même avec la
+ * synchronisation verticale : la présentation suit alors la première
+ * synchronisation après chacune.
+ */
+void utils_pacer_set_rate(FramePacer *pacer, int hz);
+
+/**
+ * @brief Repart de l'instant courant après une attente hors cadence (repos des menus).
+ *
+ * L'intervalle qui la contient n'entre pas dans les mesures.
+ */
+void utils_pacer_rebase(FramePacer *pacer);
+
+/**
+ * @brief Affiche sur la sortie standard la cadence mesurée et sa gigue.
+ *
+ * @param label Préfixe de la ligne (ex: "Affichage").
+ */
+void utils_pacer_report(const FramePacer *pacer, const char *label);
+
 // ============================================================================
 //                          MATHÉMATIQUES & ALÉATOIRE
 // ============================================================================
@@ -45,8 +169,8 @@ void utils_sleep_ms(int ms);
 /**
  * @brief Génère un nombre entier pseudo-aléatoire borné.
  *
- * Utilitaire simple pour le gameplay (ex: probabilité qu'un ennemi tire,
- * apparition de l'OVNI, direction initiale).
+ * Utilitaire simple basé sur `rand()`, réservé aux effets visuels.
+ * Le gameplay (tirs ennemis, OVNI) utilise model_rng_* pour rester reproductible.
  *
  * @param min Borne inférieure (incluse).
  * @param max Borne supérieure (incluse).
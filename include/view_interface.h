@@ -24,7 +24,7 @@
  * @brief Structure regroupant les méthodes virtuelles (API) d'une Vue.
  *
  * Pour créer une nouvelle vue (ex: `view_vulkan.c`), il suffit de créer
- * une instance de cette structure et de remplir ces 4 pointeurs avec
+ * une instance de cette structure et de remplir ces pointeurs avec
  * les fonctions correspondantes.
  */
 typedef struct
@@ -55,11 +55,52 @@ typedef struct
     /**
      * @brief Capteur d'événements (Input).
      * Transforme les appuis touches/boutons bruts (SDL_Event, getch) en commandes de jeu logiques.
+     * Tous les événements en attente sont lus : chacun dépose sa commande, datée de son
+     * instant (horloge de utils_get_time), dans la file. Une lecture sans commande vaut CMD_NONE.
      *
      * @param model Pointeur vers le modèle (nécessaire pour le contexte, ex: saisie de texte vs jeu).
-     * @return La commande abstraite (GameCommand) correspondant à l'action du joueur.
+     * @param queue File à remplir (les commandes déjà présentes y restent).
      */
-    GameCommand (*get_input)(GameModel *model);
+    void (*get_input)(GameModel *model, CommandQueue *queue);
+
+    /**
+     * @brief Interpolation entre deux ticks de simulation (optionnel, peut être NULL).
+     * Appelé avant render() : la Vue dessine les positions à `prev + alpha * (model - prev)`.
+     * Une Vue en grille de caractères n'a rien à y gagner et laisse ce pointeur à NULL.
+     *
+     * @param prev État avant le dernier tick (NULL : dessiner l'état brut).
+     * @param alpha Fraction du pas fixe écoulée depuis le dernier tick (0 à 1).
+     */
+    void (*set_interpolation)(const GameModel *prev, float alpha);
+
+    /**
+     * @brief Indique si render() attend la synchronisation verticale (optionnel, peut être NULL).
+     * La boucle de jeu ne dort alors plus entre deux images : l'écran donne la cadence.
+     *
+     * @return true si la présentation d'une image est calée sur l'écran.
+     */
+    bool (*has_vsync)(void);
+
+    /**
+     * @brief File des événements audio de la Vue (optionnel, peut être NULL).
+     * La boucle de jeu y branche le modèle (model_set_audio_sink) ; la Vue
+     * consomme les sons pendant render(). Une Vue muette laisse ce pointeur à NULL.
+     *
+     * @return La file SPSC d'AudioEvent, valide entre init() et close().
+     */
+    SpscRing *(*audio_events)(void);
+
+    /**
+     * @brief Attend une entrée au lieu de l'image suivante (optionnel, peut être NULL).
+     * Appelé par la boucle de jeu à la place de sa pause de fin d'image quand le Modèle
+     * est au repos (model_is_idle) : bloque jusqu'à un événement (touche, fenêtre) ou
+     * `timeout` secondes. Une Vue qui a encore quelque chose à animer (chargement,
+     * panneau de performances) rend la main sans attendre.
+     *
+     * @param timeout Attente maximale (s).
+     * @return false si la Vue n'a pas attendu : la boucle reprend sa cadence normale.
+     */
+    bool (*wait_input)(double timeout);
 
 } ViewInterface;
 
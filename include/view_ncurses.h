@@ -11,7 +11,248 @@
 #ifndef VIEW_NCURSES_H
 #define VIEW_NCURSES_H
 
+#include "frame_arena.h"
+#include "spsc.h"
 #include "view_interface.h"
+#include "webterm.h"
+
+#include <ncurses.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <termios.h>
+
+// ============================================================================
+//                          GRILLE DE RENDU
+// ============================================================================
+
+#define NCURSES_FRAME_TEXT_BYTES (16u << 10) ///< Arène d'image : part du texte formaté, en plus du tampon des différences.
+
+/**
+ * @brief Écran en mémoire, comparé à l'image précédente.
+ *
+ * Chaque image est composée dans `cells` (caractère + attributs ncurses dans
+ * un chtype), puis seules les cases différentes de `shown` sont écrites dans
+ * le terminal. Sans `erase()` ni réécriture des sprites immobiles, les octets
+ * envoyés par image sont proportionnels à ce qui a bougé (liaisons lentes, SSH).
+ * Un modèle resté à la génération `drawn_gen` n'est pas recomposé du tout.
+ *
+ * Le texte formaté d'une image et le tampon des différences (ANSI, web)
+ * sont découpés dans l'arène d'image (frame_arena.h), remise à zéro au
+ * début de chaque image et agrandie seulement quand la grille grandit.
+ */
+typedef struct
+{
+    chtype *cells;     ///< Image en cours de composition (rows × cols).
+    chtype *shown;     ///< Contenu actuel du terminal.
+    int rows, cols;    ///< Taille de la grille (celle du terminal).
+    attr_t attr;       ///< Attributs courants (équivalent de attron/attroff).
+    uint64_t frames;   ///< Images affichées.
+    uint64_t written;  ///< Cases réécrites au total.
+    uint64_t bytes;    ///< Octets envoyés au total (estimation, cf. grid_flush).
+    int frame_bytes;   ///< Octets estimés de la dernière image.
+    uint64_t drawn_gen; ///< Génération MODEL_GEN_ANY de l'image affichée.
+} NcursesGrid;
+
+/** @name Tables de mise à l'échelle */
+///@{
+#define NCURSES_SCALE_SUBDIV 16 ///< Entrées de table par unité logique (résolution de 1/16).
+#define NCURSES_SCALE_MARGIN 16 ///< Unités logiques couvertes de part et d'autre de l'aire de jeu (OVNI hors écran).
+#define NCURSES_SCALE_COLS ((GAME_WIDTH + 2 * NCURSES_SCALE_MARGIN) * NCURSES_SCALE_SUBDIV + 1)  ///< Entrées de la table des colonnes.
+#define NCURSES_SCALE_ROWS ((GAME_HEIGHT + 2 * NCURSES_SCALE_MARGIN) * NCURSES_SCALE_SUBDIV + 1) ///< Entrées de la table des lignes.
+///@}
+
+/**
+ * @brief Correspondance coordonnées logiques → cases du terminal.
+ *
+ * Recalculée seulement quand la taille du terminal change : chaque entité
+ * dessinée coûte alors deux lectures de table au lieu de deux multiplications
+ * flottantes. `col[i]` est la colonne de x = i / NCURSES_SCALE_SUBDIV - NCURSES_SCALE_MARGIN
+ * (bord du cadre compris, comme `(int)(x * scale_x) + 1`) : une position
+ * n'est décalée d'une case qu'à moins de 1/NCURSES_SCALE_SUBDIV d'unité d'une frontière.
+ */
+typedef struct
+{
+    int rows, cols;                  ///< Taille du terminal pour laquelle les tables sont valides.
+    float scale_x, scale_y;          ///< Cases par unité logique (hors tables : calcul direct).
+    short col[NCURSES_SCALE_COLS];   ///< Colonne de chaque abscisse échantillonnée.
+    short row[NCURSES_SCALE_ROWS];   ///< Ligne de chaque ordonnée échantillonnée.
+    short half_row[NCURSES_SCALE_ROWS]; ///< Demi-ligne de chaque ordonnée (demi-blocs : `row` = `half_row` / 2).
+} NcursesScale;
+
+/** @name Cadence adaptative du terminal */
+///@{
+#define NCURSES_BACKLOG_MAX 2048 ///< Octets en attente dans la file de sortie au-delà desquels on ralentit.
+#define NCURSES_BLOCKED_MAX 0.25 ///< Part de la période passée bloquée dans refresh() au-delà de laquelle on ralentit.
+#define NCURSES_CALM_S 2.0       ///< Durée sans saturation avant de réaccélérer (s).
+#define NCURSES_HOLD_S 0.5       ///< Délai après un ralentissement avant le suivant (la file se vide).
+#define NCURSES_HEADROOM 0.8     ///< Part du débit mesuré qu'une cadence plus haute peut utiliser.
+///@}
+
+/**
+ * @brief Cadence de rafraîchissement du terminal pendant la partie.
+ *
+ * La simulation garde son tick fixe ; seul l'affichage descend par paliers
+ * (60, 30, 20, 15 Hz) quand la liaison ne suit plus, et remonte quand elle
+ * suit de nouveau. La saturation se voit de deux façons : des octets qui
+ * restent dans la file de sortie du terminal (TIOCOUTQ, terminal série), ou
+ * refresh() qui reste bloqué dans write() (pseudo-terminal, SSH : le noyau
+ * n'y garde pas de file mesurable).
+ */
+typedef struct
+{
+    int max_hz;         ///< Plafond imposé (--max-hz), 0 : aucun.
+    bool unpaced;       ///< Chaque appel de rendu envoie une image (banc de rendu).
+    int level;          ///< Palier courant (index dans la table des cadences).
+    double next;        ///< Instant de la prochaine image.
+    double last;        ///< Instant de la dernière image.
+    int backlog;        ///< Octets en attente après la dernière image (-1 : non mesurable).
+    double blocked;     ///< Temps passé dans refresh() à la dernière image (s).
+    double throughput;  ///< Débit de la liaison mesuré pendant une saturation (octets/s, 0 : inconnu).
+    double frame_bytes; ///< Moyenne glissante des octets par image.
+    double calm;        ///< Temps écoulé sans saturation.
+    double hold;        ///< Pas de nouveau ralentissement avant cet instant.
+    uint64_t skipped;   ///< Appels de rendu sautés par la cadence.
+} NcursesPacing;
+
+// ============================================================================
+//                          THREAD D'ENTRÉE
+// ============================================================================
+
+/** @name Thread d'entrée (SPACE_INVADERS_INPUT_THREAD=1) */
+///@{
+#define NCURSES_INPUT_RING 256   ///< Touches en attente au plus (puissance de 2).
+#define NCURSES_INPUT_POLL_MS 10 ///< Attente maximale de stdin avant de revérifier l'arrêt (ms).
+///@}
+
+/**
+ * @brief Touche lue par le thread d'entrée, datée à sa lecture.
+ */
+typedef struct
+{
+    int ch;      ///< Code renvoyé par getch (TERM_KEY_RELEASE en plus : touche relâchée).
+    double time; ///< Instant de lecture (utils_get_time).
+} NcursesKey;
+
+/**
+ * @brief Lecture du clavier sur un thread dédié.
+ *
+ * Sans lui, une touche n'est lue qu'à la frame suivante : le thread attend
+ * stdin (poll), lit aussitôt et date chaque touche. La Vue les retire ensuite
+ * de la file SPSC et les traduit dans l'état courant du modèle ; la boucle de
+ * jeu les applique ainsi au tick où elles ont eu lieu. ncurses n'étant pas
+ * réentrant, `lock` sérialise getch et le rendu.
+ */
+typedef struct
+{
+    pthread_t thread;                   ///< Thread de lecture.
+    pthread_mutex_t lock;               ///< Sérialise les appels ncurses (rendu / getch).
+    bool running;                       ///< Thread lancé.
+    bool stop;                          ///< Arrêt demandé (accès __atomic).
+    SpscRing ring;                      ///< File thread d'entrée -> Vue.
+    NcursesKey keys[NCURSES_INPUT_RING]; ///< Stockage de la file.
+} NcursesInput;
+
+// ============================================================================
+//                          TERMINAL ANSI DIRECT
+// ============================================================================
+
+/** @name Sortie ANSI directe (view_ansi) */
+///@{
+#define ANSI_CELL_BYTES 32     ///< Octets au plus par case réécrite (déplacement, SGR, UTF-8).
+#define ANSI_FRAME_BYTES 64    ///< Octets fixes d'une image (synchronisation, remise à zéro SGR).
+#define ANSI_QUERY_MS 100      ///< Attente de la réponse du terminal à la requête de synchronisation (ms).
+#define ANSI_INPUT_BYTES 64    ///< Octets d'entrée lus d'avance, pas encore décodés.
+///@}
+
+/**
+ * @brief Terminal piloté sans ncurses : séquences d'échappement écrites à la main.
+ *
+ * La grille (NcursesGrid) et la composition des images sont les mêmes qu'en
+ * ncurses ; seules changent la sortie et la lecture du clavier. Les cases
+ * modifiées sont traduites en déplacements de curseur et changements
+ * d'attributs (SGR) dans `out`, découpé dans l'arène d'image, puis
+ * envoyées par un seul write(). Si le terminal annonce la sortie synchronisée
+ * (mode privé 2026, demandé par DECRQM au démarrage), l'image est encadrée
+ * par ses bornes : le terminal l'affiche d'un bloc, jamais à moitié écrite.
+ *
+ * En demi-blocs (SPACE_INVADERS_HALF_BLOCKS=1), balles et boucliers bitmap
+ * sont dessinés à deux lignes par case : "▀" avec la moitié haute en couleur
+ * du texte et la moitié basse en couleur de fond ("▄" si seule la moitié
+ * basse est pleine). Les deux couleurs sont codées dans la paire de la case :
+ * le tampon des différences reste celui des autres cases, une case n'est
+ * réécrite que si l'une de ses moitiés a changé.
+ */
+typedef struct
+{
+    bool active;                          ///< Vue ANSI ouverte (sinon : ncurses).
+    struct termios saved;                 ///< Réglages du terminal à restaurer.
+    bool saved_ok;                        ///< `saved` a été lu (stdin est un terminal).
+    bool sync;                            ///< Sortie synchronisée (mode 2026) utilisée.
+    bool half_blocks;                     ///< Monde de jeu en demi-blocs (deux lignes par case).
+    char *out;                            ///< Tampon de l'image en cours (arène d'image).
+    int rows, cols;                       ///< Taille de l'écran à la dernière image (0 : à effacer).
+    unsigned char in[ANSI_INPUT_BYTES];   ///< Octets lus sur stdin, pas encore décodés (ncurses aussi, clavier kitty).
+    int in_len;                           ///< Octets valides dans `in`.
+} AnsiTerminal;
+
+// ============================================================================
+//                          CLAVIER KITTY
+// ============================================================================
+
+/** @name Protocole clavier kitty */
+///@{
+#define KITTY_FLAGS 11                 ///< Désambiguïser (1), types d'événements (2), toutes les touches en séquences (8).
+#define TERM_KEY_RELEASE 0x1000000     ///< Bit ajouté au code d'une touche relâchée.
+///@}
+
+/**
+ * @brief Appuis et relâchements réels au clavier (protocole progressif de kitty).
+ *
+ * Un terminal ne transmet d'ordinaire que des caractères : une touche tenue
+ * n'arrive qu'à la cadence de répétition (après un délai de 250 à 500 ms),
+ * son relâchement jamais, et deux touches tenues ensemble ne se voient pas.
+ * Les terminaux qui suivent le protocole de kitty (kitty, foot, WezTerm,
+ * Ghostty, Alacritty...) envoient sur demande chaque appui, répétition et
+ * relâchement en séquence "CSI code ; modificateurs : événement u".
+ *
+ * Au lancement, la Vue texte demande au terminal s'il le prend en charge
+ * ("CSI ? u", suivi d'une demande d'attributs qui borne l'attente) ; si
+ * oui, elle active KITTY_FLAGS, et le retire à la fermeture. Les touches de
+ * jeu tenues (flèches, Q/D, Espace) forment alors le masque INPUT_* envoyé
+ * en CMD_HELD, comme en SDL : déplacement continu dès l'appui, tir en
+ * mouvement. SPACE_INVADERS_KITTY=0 ou 1 force le choix.
+ */
+typedef struct
+{
+    bool active;   ///< Protocole activé (à retirer à la fermeture).
+    unsigned held; ///< Touches de jeu tenues (INPUT_*), suivies appui par appui (thread de la Vue).
+} KittyKeyboard;
+
+// ============================================================================
+//                          TERMINAL WEB
+// ============================================================================
+
+/** @name Sortie web (view_web) */
+///@{
+#define WEB_ROWS 30 ///< Lignes de la grille diffusée.
+#define WEB_COLS 90 ///< Colonnes de la grille diffusée.
+///@}
+
+/**
+ * @brief Grille diffusée aux navigateurs au lieu d'être écrite dans un terminal.
+ *
+ * Même composition qu'en ncurses, à une taille fixe (WEB_ROWS × WEB_COLS) ;
+ * les cases modifiées sont encodées en plages (cf. webterm.h) dans `out`,
+ * puis un seul message part vers tous les spectateurs.
+ */
+typedef struct
+{
+    bool active;     ///< Vue web ouverte.
+    WebTerm server;  ///< Serveur HTTP / WebSocket.
+    uint8_t *out;    ///< Tampon du message en cours (arène d'image).
+} WebStream;
 
 // ============================================================================
 //                          INSTANCE GLOBALE
@@ -28,4 +269,37 @@
  */
 extern const ViewInterface view_ncurses;
 
+/**
+ * @brief Même Vue texte, écrite directement en séquences ANSI (argument "ansi").
+ *
+ * Sans ncurses : un write() par image, sortie synchronisée si le terminal la
+ * prend en charge (cf. AnsiTerminal). SPACE_INVADERS_ANSI_SYNC=0 ou 1 force
+ * ce choix au lieu d'interroger le terminal.
+ */
+extern const ViewInterface view_ansi;
+
+/**
+ * @brief Même Vue texte, diffusée aux navigateurs par WebSocket (argument "web", cf. webterm.h).
+ *
+ * En lecture seule (aucune entrée) : derrière une Vue SDL (`--mirror=web`)
+ * ou pour regarder une partie diffusée (`watch`, `client`). Le port est
+ * SPACE_INVADERS_WEB_PORT (WEBTERM_DEFAULT_PORT par défaut).
+ */
+extern const ViewInterface view_web;
+
+/**
+ * @brief Plafonne la cadence de rafraîchissement du terminal.
+ *
+ * @param hz Images par seconde au plus pendant la partie (0 : adaptatif jusqu'à TARGET_FPS).
+ */
+void ncurses_set_max_refresh(int hz);
+
+/**
+ * @brief Coupe (ou rétablit) la cadence adaptative.
+ *
+ * Coupée, chaque appel à render envoie une image, à la vitesse de l'appelant :
+ * le banc de rendu mesure ainsi le coût d'une image et non la cadence.
+ */
+void ncurses_set_unpaced(bool unpaced);
+
 #endif // VIEW_NCURSES_H
\ No newline at end of file
@@ -13,6 +13,19 @@
 #define VIEW_SDL_H
 
 #include "view_interface.h"
+#include "asset_pack.h"
+#include "attract.h"
+#include "capture.h"
+#include "frame_arena.h"
+#include "hotreload.h"
+#include "lang.h"
+#include "membudget.h"
+#include "particles.h"
+#include "starfield.h"
+#include "quality.h"
+#include "scene.h"
+#include "texcache.h"
+#include "thumbnail.h"
 
 // --- Inclusions nécessaires pour les types SDL3 ---
 #include <SDL3/SDL.h>
@@ -42,6 +55,35 @@ static const SDL_Color COL_GRAY = {150, 150, 150, 255};
 #define MAX_LIVES_DISPLAY 3 ///< Nombre max de cœurs affichés dans l'interface.
 #define HEART_UI_SIZE 45    ///< Taille (carrée) de l'icône cœur en pixels.
 #define HEART_SPACING 5     ///< Espace entre les cœurs.
+#define HUD_LAYER_HEIGHT 80 ///< Hauteur du bandeau HUD mis en cache (texte et cœurs).
+#define LOWRES_WIDTH 640    ///< Largeur de la cible interne basse résolution (SPACE_INVADERS_LOWRES=1, QUALITY_LOWRES).
+#define LOWRES_HEIGHT 384   ///< Hauteur de la cible interne basse résolution.
+#define BUDGET_MAX_HALVINGS 3 ///< Divisions par deux au plus d'un fond qui dépasse MEM_BACKGROUNDS (1/8 de côté).
+#define BUDGET_MIN_LAYER_SCALE 0.25f ///< Échelle minimale des calques sous le plafond MEM_LAYERS.
+#define ATTRACT_LAYER_ALPHA 150 ///< Opacité du calque du menu posé sur la démo d'accueil.
+///@}
+
+/** @name Panneau de performances (F3) */
+///@{
+#define PERF_PANEL_X 10        ///< Bord gauche du panneau.
+#define PERF_PANEL_Y 80        ///< Bord haut du panneau (sous le bandeau HUD).
+#define PERF_PANEL_W 520       ///< Largeur du panneau.
+#define PERF_PANEL_H 420       ///< Hauteur du panneau.
+#define PERF_GRAPH_SAMPLES 120 ///< Frames affichées par la courbe des durées.
+#define PERF_GRAPH_H 70        ///< Hauteur de la courbe (2 budgets de frame).
+#define PERF_LINE_H 36         ///< Interligne du texte du panneau.
+///@}
+
+/** @name Particules d'explosion */
+///@{
+#define PARTICLE_PIXELS 3.0f                      ///< Côté d'une particule à l'écran (pixels logiques).
+#define PARTICLE_BURST_ENEMY 48                   ///< Particules par alien détruit.
+#define PARTICLE_BURST_UFO 160                    ///< Particules pour l'OVNI.
+#define PARTICLE_BURST_PLAYER 240                 ///< Particules par vaisseau touché.
+#define PARTICLE_SPEED 30.0f                      ///< Vitesse maximale d'éjection (unités logiques / s).
+#define PARTICLE_LIFE 0.8f                        ///< Durée de vie maximale d'une particule (s).
+#define PARTICLE_COLOR_PLAYER 0xFF6464            ///< Teinte de l'explosion du joueur (celle de son sprite).
+#define PARTICLE_FRAME_BUDGET (1.25 / TARGET_FPS) ///< Durée de frame au-delà de laquelle les gerbes rétrécissent.
 ///@}
 
 /** @name Chemins des Assets : Entités */
@@ -82,42 +124,308 @@ static const SDL_Color COL_GRAY = {150, 150, 150, 255};
 //                          STRUCTURES DE DONNÉES
 // ============================================================================
 
+/** @name Atlas des Sprites */
+///@{
+#define SPRITE_ATLAS_WIDTH 1024  ///< Largeur de la texture d'atlas des sprites (pixels).
+#define SPRITE_PADDING 1         ///< Marge transparente autour de chaque sprite.
+#define SPRITE_MIP_LEVELS 6      ///< Niveaux d'un sprite dans l'atlas : l'image, puis ses réductions de moitié.
+#define SPRITE_MIP_MIN 16        ///< Côté minimal d'un niveau réduit (pixels) : les petits sprites n'en ont pas.
+#define SPRITE_BATCH_MAX (FORMATION_SIZE + MODEL_MAX_BULLET_CAPACITY + 64) ///< Sprites d'un lot : tout le monde de jeu, même au plus grand pool de balles.
+#define RENDER_COMMAND_PRIME 512 ///< Commandes de rendu réservées à l'initialisation.
+#define RENDER_DRIVER_GPU "gpu"  ///< Pilote SDL_Renderer bâti sur l'API SDL_GPU (Vulkan, Metal, Direct3D 12).
+///@}
+
+/**
+ * @brief Identifiant d'un sprite dans l'atlas.
+ * Les variantes (frames, états) sont consécutives : `SPRITE_ENEMY_1A + 2 * type + frame`,
+ * `SPRITE_MISSILE_1 + frame`, `SPRITE_SHIELD_0 + dégâts`.
+ */
+typedef enum
+{
+    SPRITE_PLAYER,        ///< Vaisseau joueur.
+    SPRITE_UFO,           ///< OVNI bonus.
+    SPRITE_ENEMY_1A,      ///< Ennemi type 1, frame A.
+    SPRITE_ENEMY_1B,      ///< Ennemi type 1, frame B.
+    SPRITE_ENEMY_2A,      ///< Ennemi type 2, frame A.
+    SPRITE_ENEMY_2B,      ///< Ennemi type 2, frame B.
+    SPRITE_ENEMY_3A,      ///< Ennemi type 3, frame A.
+    SPRITE_ENEMY_3B,      ///< Ennemi type 3, frame B.
+    SPRITE_HEART_FULL,    ///< Cœur plein (vie restante).
+    SPRITE_HEART_EMPTY,   ///< Cœur vide (vie perdue).
+    SPRITE_HEART_BONUS,   ///< Cœur doré (vie bonus au-delà de MAX_LIVES_DISPLAY).
+    SPRITE_EXPL_PLAYER_A, ///< Mort joueur, frame A.
+    SPRITE_EXPL_PLAYER_B, ///< Mort joueur, frame B.
+    SPRITE_EXPL_ENEMY,    ///< Explosion alien (hitmarker).
+    SPRITE_EXPL_UFO,      ///< Explosion spéciale OVNI.
+    SPRITE_MISSILE_1,     ///< Missile joueur (4 frames).
+    SPRITE_PROJECTILE_1 = SPRITE_MISSILE_1 + 4, ///< Tir alien (4 frames).
+    SPRITE_SHIELD_0 = SPRITE_PROJECTILE_1 + 4,  ///< Bouclier intact (puis 9 états d'érosion).
+    SPRITE_COUNT = SPRITE_SHIELD_0 + 10         ///< Nombre de sprites.
+} SpriteId;
+
 /**
  * @brief Gestionnaire de Textures.
- * Contient tous les pointeurs `SDL_Texture*` chargés en mémoire GPU.
+ *
+ * Tous les sprites du jeu sont rangés à l'initialisation dans une seule
+ * texture, déjà teintés (joueur vert, ennemis cyan/orange/rouge, OVNI
+ * magenta, boucliers verts, cœur bonus doré) : le monde de jeu se dessine
+ * par simples copies, sans changer de texture ni de couleur. Seuls les fonds
+ * plein écran gardent leur propre texture.
+ *
+ * Un grand sprite (cœurs) y est aussi rangé réduit de moitié, puis de moitié
+ * encore, tant que le niveau garde SPRITE_MIP_MIN pixels de côté. Au dessin,
+ * le plus petit niveau encore aussi large que le sprite à l'écran est lu :
+ * l'image n'est jamais réduite de plus de moitié au filtrage (plus proche
+ * voisin), et une petite fenêtre ne relit pas l'original entier. Les petits
+ * sprites (pixel art agrandi) n'ont que leur image.
  */
 typedef struct
 {
-    // --- Entités ---
-    SDL_Texture *player; ///< Sprite du vaisseau joueur.
-    SDL_Texture *bullet; ///< Sprite générique de balle.
-    SDL_Texture *ufo;    ///< Sprite de l'OVNI bonus.
-
-    /** * @brief Tableau des sprites d'ennemis.
-     * Dimensions : [3 Types] x [2 Frames d'animation].
-     */
-    SDL_Texture *enemies[3][2];
+    // --- Sprites ---
+    SDL_Texture *sprites;          ///< Atlas de tous les sprites (NULL si rien n'a pu être chargé).
+    SDL_FRect rects[SPRITE_COUNT]; ///< Rectangle de chaque sprite dans l'atlas (largeur nulle : absent).
+    SDL_FRect mips[SPRITE_COUNT][SPRITE_MIP_LEVELS - 1]; ///< Niveaux réduits, du plus grand au plus petit (largeur nulle : fin).
+    float sprites_w, sprites_h;    ///< Taille de l'atlas (normalisation des coordonnées de texture).
 
     // --- Décors ---
     SDL_Texture *bg_menu;   ///< Fond écran titre.
     SDL_Texture *bg_menu_1; ///< Fond sous-menus.
     SDL_Texture *bg_game;   ///< Fond étoilé du jeu.
+    SDL_Texture *blur;      ///< Texture pour effet de flou (optionnel).
+} GameTextures;
 
-    // --- Interface (HUD) ---
-    SDL_Texture *heart_full;  ///< Cœur plein (Vie restante).
-    SDL_Texture *heart_empty; ///< Cœur vide (Vie perdue).
-    SDL_Texture *blur;        ///< Texture pour effet de flou (optionnel).
+/**
+ * @brief Image prête à devenir texture : surface décodée, ou pixels du cache disque.
+ */
+typedef struct
+{
+    SDL_Surface *surface;  ///< Image décodée (NULL si `cached` est ouverte).
+    TexcacheEntry cached;  ///< Pixels déjà convertis (texcache.h), envoyés par SDL_UpdateTexture.
+} StagedImage;
 
-    // --- Effets Visuels (FX) ---
-    SDL_Texture *expl_player[2]; ///< Animation mort joueur (2 frames).
-    SDL_Texture *expl_enemy;     ///< Explosion alien (hitmarker).
-    SDL_Texture *expl_ufo;       ///< Explosion spéciale OVNI.
+/**
+ * @brief Chargement en fond des images du jeu (atlas des sprites, fonds).
+ *
+ * Le menu principal n'a besoin que de son fond et des polices : le reste
+ * (vaisseaux, dix états de boucliers, explosions, fonds du jeu et des
+ * sous-menus) est décodé par un thread pendant que le menu s'affiche. Le
+ * renderer n'étant utilisable que depuis le thread principal, le thread
+ * s'arrête aux surfaces (ou aux entrées du cache disque) ; la Vue en fait des textures au premier rendu qui
+ * suit la fin du décodage, ou attend celle-ci avant de quitter le menu.
+ */
+typedef struct
+{
+    SDL_Thread *thread;     ///< Thread de décodage (NULL une fois rejoint).
+    SDL_AtomicInt ready;    ///< 1 quand les surfaces sont prêtes (écrit par le thread).
+    bool attached;          ///< Textures créées, surfaces libérées.
+    double started;         ///< Début du chargement (utils_get_time).
+    double decode_ms;       ///< Durée du décodage dans le thread.
+    StagedImage sheet;      ///< Planche des sprites (sprites_compose ou cache).
+    StagedImage bg_menu_1;  ///< Fond des sous-menus.
+    StagedImage bg_game;    ///< Fond du jeu.
+} WorldLoader;
 
-    // --- Projectiles & Boucliers ---
-    SDL_Texture *missiles[4];    ///< Sprites animés missiles joueur.
-    SDL_Texture *projectiles[4]; ///< Sprites animés tirs aliens.
-    SDL_Texture *shields[10];    ///< Sprites d'érosion des bunkers (10 états).
-} GameTextures;
+/**
+ * @brief Chronométrage du démarrage de la Vue (journal "Startup:").
+ */
+typedef struct
+{
+    double begin;     ///< Entrée dans sdl_init.
+    double last;      ///< Fin de l'étape précédente.
+    bool first_frame; ///< Première image présentée (durée totale journalisée).
+} StartupClock;
+
+/**
+ * @brief Lot de sprites envoyés en un seul appel de dessin.
+ *
+ * Chaque sprite ajoute un quadrilatère (4 sommets, 6 indices) prenant ses
+ * coordonnées dans l'atlas. Le lot part en un seul SDL_RenderGeometry quand
+ * il est plein ou avant tout dessin qui doit le recouvrir. Les tableaux sont
+ * alloués à l'initialisation pour SPRITE_BATCH_MAX sprites : vaisseaux,
+ * vague, OVNI, boucliers et balles tiennent dans un seul envoi, quelle que
+ * soit la capacité du pool de balles.
+ */
+typedef struct
+{
+    SDL_Vertex *vertices; ///< Sommets des quadrilatères en attente (SPRITE_BATCH_MAX * 4).
+    int *indices;         ///< Deux triangles par quadrilatère (SPRITE_BATCH_MAX * 6, rempli une fois).
+    int count;            ///< Quadrilatères en attente.
+} SpriteBatch;
+
+/**
+ * @brief Calque statique pré-composé (render target plein écran).
+ *
+ * Les écrans figés (menus, pause, fin de partie, confirmation, tutoriel)
+ * sont faits d'un fond, souvent d'un voile sombre et de titres qui ne
+ * bougent pas tant que l'état dure. Ils sont composés une fois dans cette
+ * texture à l'entrée dans l'état, puis recopiés en un seul appel à chaque
+ * frame ; seuls les éléments variables (sélection, volume, saisie) sont
+ * redessinés par-dessus.
+ */
+typedef struct
+{
+    SDL_Texture *texture; ///< Cible de rendu WIN_WIDTH x WIN_HEIGHT (NULL : dessin direct).
+    int key;              ///< Écran actuellement composé (0 : aucun, à reconstruire).
+} RenderLayer;
+
+/**
+ * @brief Calque du monde de jeu (fond, entités, particules), sans tremblement.
+ *
+ * Le monde est composé dans cette texture au plus une fois par image, et
+ * seulement quand il a changé (cf. world_layer_update). Pendant le
+ * tremblement, l'écran de jeu le recopie décalé ; les écrans de pause et de
+ * confirmation le recopient assombri (modulation de couleur) au lieu de
+ * redessiner toutes les entités sous un voile. Le reste du temps, la partie
+ * se dessine directement : interpolée, elle change à chaque image.
+ */
+typedef struct
+{
+    SDL_Texture *texture; ///< Cible de rendu WIN_WIDTH x WIN_HEIGHT (NULL : dessin direct).
+    bool valid;           ///< Le contenu correspond à la liste d'affichage courante (ctx.scene).
+    float alpha;          ///< Fraction d'interpolation de la dernière composition.
+    uint64_t draws;       ///< Compositions effectuées (statistiques).
+} WorldLayer;
+
+/**
+ * @brief Calque de la vague : ses aliens vivants, composés une fois par changement.
+ *
+ * La vague est une grille rigide (cf. Formation) : entre deux impacts ou deux
+ * images d'animation, elle ne fait que se déplacer. Les aliens vivants sont
+ * composés dans cette texture, à leur place relative à l'origine de la vague,
+ * quand la clé change (vivants, image d'animation, types, espacement) ; à
+ * chaque image, une seule copie la pose à l'origine interpolée. Les aliens
+ * en explosion, figés sur place, passent par-dessus en sprites.
+ */
+typedef struct
+{
+    SDL_Texture *texture;          ///< Cible de rendu (NULL : aliens dessinés un par un).
+    int w, h;                      ///< Taille de la texture en unités de fenêtre.
+    float scale;                   ///< Échelle de présentation à la création (PresentState::scale).
+    bool valid;                    ///< Le contenu correspond à la clé ci-dessous.
+    uint64_t alive;                ///< Aliens composés (Formation::alive_mask).
+    int frame;                     ///< Image d'animation composée.
+    float step_x, step_y;          ///< Espacement composé.
+    uint8_t types[FORMATION_SIZE]; ///< Type de chaque alien composé.
+    bool failed;                   ///< Cible refusée par le pilote : dessin direct.
+} FormationLayer;
+
+/**
+ * @brief Transformation de présentation, recalculée seulement quand la sortie change de taille.
+ *
+ * Tout se dessine en coordonnées logiques WIN_WIDTH x WIN_HEIGHT ; SDL les
+ * projette sur la sortie (présentation logique en letterbox) à la résolution
+ * native. Les calques mis en cache (écran figé, HUD) sont recréés à la taille
+ * en pixels qu'ils occupent à l'écran, avec leur propre présentation logique :
+ * ils restent nets en plein écran au lieu d'être agrandis.
+ *
+ * En basse résolution, toute l'image passe par une cible interne de
+ * LOWRES_WIDTH x LOWRES_HEIGHT, agrandie au plus proche voisin à la
+ * présentation : le coût de remplissage ne dépend plus de l'écran. Elle est
+ * imposée par SPACE_INVADERS_LOWRES=1, ou prise par le régulateur de qualité
+ * (quality.h) en dernier recours. La capture vidéo (CaptureState) a besoin
+ * de l'image composée dans une texture : sans basse résolution, la cible
+ * interne existe alors à la taille logique.
+ */
+typedef struct
+{
+    int pixel_w, pixel_h; ///< Taille de la sortie en pixels (SDL_GetRenderOutputSize).
+    float scale;          ///< Pixels de calque par unité logique (0 : à calculer).
+    SDL_Texture *lowres;  ///< Cible interne basse résolution (NULL : rendu à la résolution native).
+    float lowres_scale;   ///< Échelle de `lowres` : LOWRES_WIDTH / WIN_WIDTH, ou 1 pour la seule capture vidéo.
+    bool lowres_forced;   ///< SPACE_INVADERS_LOWRES=1 : basse résolution quel que soit le niveau de qualité.
+    bool hud_direct;      ///< HUD dessiné sans calque (alpha des cibles non fiable, cf. target_alpha_ok).
+    bool dirty;           ///< Sortie redimensionnée depuis le dernier calcul.
+} PresentState;
+
+/** @name Rectangles sales (renderer logiciel) */
+///@{
+#define DIRTY_MAX_ITEMS (SCENE_MAX_ITEMS + 3) ///< Éléments relevés par image (scène, vague, particules, HUD).
+#define DIRTY_MAX_RECTS 32      ///< Rectangles renvoyés au plus, après fusion.
+#define DIRTY_MARGIN 2.0f       ///< Marge autour d'un élément (arrondis du rendu), en pixels logiques.
+#define DIRTY_JOIN 16.0f        ///< Deux rectangles plus proches que cela sont fusionnés.
+#define DIRTY_FULL_AREA 0.6f    ///< Part de l'écran au-delà de laquelle l'image est redessinée entière.
+///@}
+
+/**
+ * @brief Un élément dessiné : son rectangle et de quoi le reconnaître inchangé.
+ */
+typedef struct
+{
+    SDL_FRect rect; ///< Rectangle logique, marge comprise.
+    uint64_t sig;   ///< Signature : rectangle, genre, image, teinte, génération.
+} DirtyItem;
+
+/**
+ * @brief Présentation par rectangles sales quand SDL tombe sur son renderer logiciel.
+ *
+ * Le renderer "software" dessine dans la surface de la fenêtre, qui garde
+ * l'image précédente. En partie, seuls les éléments qui ont bougé ou changé
+ * sont redessinés : les rectangles de l'image précédente et de la
+ * courante, fusionnés, sont redessinés un à un sous un rectangle de
+ * découpe (fond, monde, HUD), puis seuls ceux-là sont envoyés à l'écran
+ * (SDL_UpdateWindowSurfaceRects). Le fond vient d'une copie figée à la
+ * taille de la sortie : le champ d'étoiles ne défile pas dans ce mode.
+ * Toute autre image (menus, tremblement, fondu, panneau F3, capture,
+ * basse résolution, sortie redimensionnée) est complète.
+ */
+typedef struct
+{
+    bool enabled;                       ///< Renderer "software" (SPACE_INVADERS_DIRTY_RECTS=0 : désactivé).
+    bool valid;                         ///< `shown` décrit l'écran (false : prochaine image complète).
+    SDL_Texture *background;            ///< Fond figé à la taille de la sortie (NULL : à composer).
+    DirtyItem shown[DIRTY_MAX_ITEMS];   ///< Éléments à l'écran, triés par signature.
+    int shown_count;                    ///< Éléments de `shown`.
+    DirtyItem items[DIRTY_MAX_ITEMS];   ///< Éléments de l'image en cours.
+    int count;                          ///< Éléments de `items`.
+    SDL_FRect rects[DIRTY_MAX_RECTS];   ///< Rectangles à redessiner, fusionnés.
+    int rect_count;                     ///< Rectangles de `rects`.
+    uint64_t serial;                    ///< Numéro d'image (signature des particules, toujours nouvelle).
+    uint64_t frames;                    ///< Images présentées par rectangles.
+    uint64_t full_frames;               ///< Images complètes en partie.
+    double area;                        ///< Part de l'écran redessinée, cumulée sur `frames`.
+} DirtyRects;
+
+/**
+ * @brief Miniatures des sauvegardes : capture hors écran et affichage dans les menus.
+ *
+ * À l'entrée dans STATE_SAVING, le monde est redessiné dans `target`. Ses
+ * pixels ne sont relus qu'à l'image suivante, quand le GPU en a fini avec
+ * lui ; la surface part alors au thread de thumbnail.h, qui l'encode en PNG
+ * à côté de la sauvegarde. Dans les menus, les miniatures de toute la page
+ * affichée sont demandées d'un coup au même thread, puis envoyées au GPU à
+ * mesure qu'elles arrivent : changer de sélection dans la page est immédiat.
+ */
+typedef struct
+{
+    SDL_Texture *texture;            ///< Miniature décodée (NULL : absente ou en cours).
+    char path[THUMBNAIL_PATH_LEN];   ///< Fichier de la sauvegarde (vide : case libre).
+    int64_t stamp;                   ///< Date de cette sauvegarde (une réécriture change la miniature).
+} ThumbnailSlot;
+
+typedef struct
+{
+    SDL_Texture *target;                ///< Cible THUMBNAIL_WIDTH x THUMBNAIL_HEIGHT (NULL : pas de miniatures).
+    char pending[THUMBNAIL_PATH_LEN];   ///< Miniature dessinée, à relire (vide : aucune).
+    bool saving_seen;                   ///< STATE_SAVING déjà vu au rendu précédent.
+    ThumbnailSlot page[SAVE_MENU_PAGE_SIZE]; ///< Miniatures de la page affichée, dans l'ordre du menu.
+    int selected;                       ///< Case de la sauvegarde sélectionnée (-1 : aucune).
+} ThumbnailState;
+
+/**
+ * @brief Capture vidéo (SPACE_INVADERS_CAPTURE, cf. capture.h) : anneau de textures relues en différé.
+ *
+ * Chaque image composée (cible interne de PresentState) est copiée par le GPU
+ * dans `staging[next]`. Cette texture n'est relue qu'au tour suivant de
+ * l'anneau, au début d'une image, CAPTURE_STAGING images plus tard : la
+ * relecture ne tombe jamais sur une image que le GPU n'a pas finie.
+ */
+typedef struct
+{
+    SDL_Texture *staging[CAPTURE_STAGING]; ///< Cibles à la taille de la capture (NULL : pas de capture).
+    bool filled[CAPTURE_STAGING];          ///< Image copiée, pas encore relue.
+    int next;                              ///< Texture de l'image en cours.
+    uint64_t frames;                       ///< Images copiées dans l'anneau.
+} CaptureState;
 
 /**
  * @brief Gestionnaire Audio.
@@ -136,11 +444,403 @@ typedef struct
     MIX_Audio *select;    ///< Validation menu.
 
     // --- Pistes Audio (Contrôlables) ---
-    MIX_Audio *bg_music_data;  ///< Données brutes de la musique.
-    MIX_Track *bg_music_track; ///< Piste de contrôle (Volume, Pause) musique menu.
+    MIX_Track *bg_music_track; ///< Piste de la musique du menu, lue en flux depuis son fichier (MIX_SetTrackIOStream).
     MIX_Track *ufo_track;      ///< Piste de contrôle pour la boucle OVNI.
+    SDL_PropertiesID loop;     ///< Options de lecture en boucle infinie (musique, OVNI).
 } GameAudio;
 
+/**
+ * @brief Dernier état appliqué au mixeur.
+ *
+ * Chaque appel au mixeur peut prendre le verrou que le thread audio tient
+ * pendant le mixage : update_audio_state ne parle donc au mixeur que lorsque
+ * l'état voulu change (-1 : inconnu, à réappliquer).
+ */
+typedef struct
+{
+    float gain;  ///< Volume général appliqué (négatif : jamais appliqué).
+    bool frozen; ///< Toutes les pistes sont en pause (MIX_PauseAllTracks).
+    int music;   ///< Musique du menu audible (1), en pause (0) ou inconnu (-1).
+    int ufo;     ///< Boucle OVNI audible (1), en pause (0) ou inconnu (-1).
+} AudioApplied;
+
+#define AUDIO_EVENT_RING 128 ///< Sons en attente au plus entre deux rendus (puissance de 2).
+
+/**
+ * @brief Chargement de l'audio en fond, au démarrage.
+ *
+ * Ouvrir le périphérique et décoder une douzaine de fichiers retardait
+ * l'apparition du menu. Un thread s'en charge ; la Vue branche l'audio au
+ * premier rendu qui suit la fin du chargement (les sons demandés avant sont
+ * ignorés, la musique du menu démarre à ce moment-là).
+ */
+typedef struct
+{
+    SDL_Thread *thread; ///< Thread de chargement (NULL une fois rejoint).
+    SDL_AtomicInt ready; ///< 1 quand mixeur, sons et pistes sont prêts (écrit par le thread).
+    bool attached;      ///< Le rendu utilise l'audio (thread rejoint).
+    double started;     ///< Début du chargement (utils_get_time).
+    uint64_t bytes;     ///< Octets des sons chargés (versés à MEM_AUDIO au branchement).
+    uint32_t dropped;   ///< Sons laissés muets par le plafond MEM_AUDIO.
+} AudioLoader;
+
+/** @name Latence audio */
+///@{
+#define AUDIO_DEFAULT_RATE 44100     ///< Fréquence demandée par défaut (SPACE_INVADERS_AUDIO_RATE).
+#define AUDIO_DEFAULT_FRAMES 256     ///< Tampon demandé par défaut, par canal (SPACE_INVADERS_AUDIO_FRAMES).
+#define AUDIO_LATENCY_BUDGET_MS 20.0 ///< Latence de sortie visée pour les bruitages.
+///@}
+
+/**
+ * @brief Latence de sortie et calage des bruitages sur la présentation.
+ *
+ * Sans demande, SDL choisit un tampon d'environ 1024 échantillons (plus de
+ * 20 ms à 44,1 kHz, doublés par le double tampon) : les bruitages
+ * arrivaient après l'image qui les montre. Le tampon est donc demandé
+ * petit, puis relu sur le périphérique ouvert. Un bruitage met `output_ms`
+ * à sortir, une image `present_ms` du début du rendu à la fin de la
+ * présentation : quand le son est le plus rapide, les bruitages de l'image
+ * partent après SDL_RenderPresent, sinon dès le début du rendu.
+ */
+typedef struct
+{
+    int rate;            ///< Fréquence obtenue (Hz).
+    int frames;          ///< Tampon obtenu (échantillons par canal).
+    double output_ms;    ///< Latence de sortie estimée : deux tampons (l'un mixé, l'autre joué).
+    double present_ms;   ///< Début du rendu à la fin de SDL_RenderPresent (moyenne glissante).
+    double render_start; ///< Début du rendu en cours (utils_get_time).
+    bool after_present;  ///< Les bruitages de l'image en cours partent après la présentation.
+} AudioLatency;
+
+/** @name Voix des bruitages */
+///@{
+#define SFX_VOICES 16 ///< Pistes de mixage réservées aux sons ponctuels (plafond de voix simultanées).
+///@}
+
+/**
+ * @brief Une voix : piste de mixage réutilisée d'un son à l'autre.
+ */
+typedef struct
+{
+    MIX_Track *track;  ///< Piste SDL_mixer (créée à l'initialisation).
+    AudioSound sound;  ///< Dernier son joué sur cette voix.
+    uint64_t started;  ///< Horloge de lancement (la plus petite : la plus ancienne).
+} SfxVoice;
+
+/**
+ * @brief Réserve fixe de voix pour les sons ponctuels.
+ *
+ * Lancer un MIX_PlayAudio par tir ou par mort crée une voix de plus à chaque
+ * fois. Ici, le nombre de voix est fixe : chaque son a un plafond de
+ * lectures simultanées, au-delà duquel sa voix la plus ancienne est reprise,
+ * et la voix la plus ancienne tout court quand la réserve est pleine. La
+ * charge du mixeur ne dépend donc plus du nombre de projectiles.
+ */
+typedef struct
+{
+    SfxVoice voices[SFX_VOICES]; ///< Voix disponibles.
+    int count;                   ///< Voix effectivement créées.
+    uint64_t clock;              ///< Compteur de lancements.
+    uint64_t played;             ///< Sons lancés.
+    uint64_t stolen;             ///< Sons coupés pour en lancer un autre.
+} VoicePool;
+
+/** @name Rendu du Texte */
+///@{
+#define GLYPH_FIRST 32                               ///< Premier caractère de l'atlas (espace).
+#define GLYPH_LAST 126                               ///< Dernier caractère de l'atlas ('~').
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)   ///< Nombre de glyphes par atlas.
+#define GLYPH_ATLAS_WIDTH 1024                       ///< Largeur de la texture d'atlas (pixels).
+#define SDF_BASE_SIZE 64                             ///< Taille de rastérisation des champs de distance.
+#define SDF_SPREAD 6                                 ///< Portée des champs de distance (pixels, à SDF_BASE_SIZE).
+#define FONT_TITLE_SIZE 64                           ///< Taille de police des titres.
+///@}
+
+/**
+ * @brief Planche de champs de distance de la police (une seule taille, SDF_BASE_SIZE).
+ *
+ * Métadonnées de l'entrée "font-sdf" du cache disque (texcache.h) : la
+ * planche elle-même est une image ARGB8888 dont l'alpha porte le champ de
+ * chaque glyphe (sdf.h), bordé de SDF_SPREAD pixels.
+ */
+typedef struct
+{
+    SDL_Rect cell[GLYPH_COUNT];               ///< Champ de chaque glyphe dans la planche (largeur nulle : rien à dessiner).
+    int advance[GLYPH_COUNT];                 ///< Avance horizontale à SDF_BASE_SIZE.
+    signed char kerning[GLYPH_COUNT][GLYPH_COUNT]; ///< Crénage [précédent][courant] à SDF_BASE_SIZE.
+    int height;                               ///< Hauteur d'une ligne à SDF_BASE_SIZE.
+} SdfFontMeta;
+
+/**
+ * @brief Atlas de glyphes d'une police (ASCII imprimable), à une taille.
+ *
+ * Les glyphes sont tirés une fois, en blanc, de la planche de champs de
+ * distance (SdfFontMeta), dans une seule texture à l'initialisation : toutes
+ * les tailles viennent de la même rastérisation. Une chaîne se dessine
+ * ensuite par une copie de rectangle par caractère, teintée par color mod :
+ * ni rastérisation ni envoi au GPU pendant le rendu.
+ */
+typedef struct
+{
+    SDL_Texture *texture;                     ///< Texture contenant tous les glyphes (NULL : atlas indisponible).
+    SDL_Surface *sheet;                       ///< Copie en mémoire de la texture (composition du cache de chaînes).
+    float size;                               ///< Taille de la police (points).
+    SDL_FRect src[GLYPH_COUNT];               ///< Rectangle de chaque glyphe dans la texture.
+    int advance[GLYPH_COUNT];                 ///< Avance horizontale de chaque glyphe.
+    signed char kerning[GLYPH_COUNT][GLYPH_COUNT]; ///< Crénage [précédent][courant].
+    int height;                               ///< Hauteur d'une ligne.
+} GlyphAtlas;
+
+#define GLYPH_RUN_MAX 96 ///< Glyphes au plus dans une chaîne mise en forme.
+
+/**
+ * @brief Chaîne mise en forme dans un atlas : rang et abscisse de chaque glyphe, crénage compris.
+ *
+ * Une fois la chaîne mise en forme, la dessiner ou la composer n'est plus
+ * qu'une suite de copies de rectangles : ni décodage, ni recherche du crénage.
+ */
+typedef struct
+{
+    uint8_t glyph[GLYPH_RUN_MAX]; ///< Rang de chaque glyphe dans l'atlas.
+    int16_t x[GLYPH_RUN_MAX];     ///< Abscisse de chaque glyphe depuis le début de la chaîne.
+    int len;                      ///< Glyphes (-1 : chaîne hors atlas ou trop longue).
+    int width;                    ///< Largeur totale en pixels.
+} GlyphRun;
+
+/**
+ * @brief Morceau du format du HUD (STR_HUD) : texte fixe, ou valeur lue dans le modèle.
+ */
+typedef enum
+{
+    HUD_SEG_TEXT,   ///< Texte fixe, mis en forme d'avance.
+    HUD_SEG_SCORE,  ///< Premier %d : compteur du score.
+    HUD_SEG_LEVEL,  ///< Second %d : compteur du niveau.
+    HUD_SEG_RAPID,  ///< Premier %s : STR_HUD_RAPID pendant le tir rapide.
+    HUD_SEG_SPREAD  ///< Second %s : STR_HUD_SPREAD pendant le tir triple.
+} HudSegmentKind;
+
+/** @name Compteurs du HUD */
+///@{
+#define HUD_SEGMENTS_MAX 8     ///< Morceaux au plus dans le format du HUD.
+#define COUNTER_DIGITS_MAX 24  ///< Caractères au plus d'un compteur (signe, 20 chiffres, virgule).
+///@}
+
+/**
+ * @brief Un morceau du format du HUD.
+ */
+typedef struct
+{
+    HudSegmentKind kind; ///< Texte fixe ou valeur.
+    GlyphRun run;        ///< Mise en forme du texte (HUD_SEG_TEXT seulement).
+} HudSegment;
+
+/**
+ * @brief Bandeau HUD (score, niveau, cœurs).
+ *
+ * Le format STR_HUD est découpé une fois par langue en morceaux de texte
+ * mis en forme et en compteurs : le bandeau est alors redessiné à chaque
+ * image, chiffres copiés un à un depuis l'atlas, sans snprintf ni
+ * recomposition, aussi souvent que le score change. Si le format ne se
+ * découpe pas (conversion inconnue, caractère hors atlas), le texte passe
+ * par snprintf et le bandeau est composé dans une texture transparente,
+ * recomposée seulement quand la génération MODEL_GEN_HUD change.
+ */
+typedef struct
+{
+    SDL_Texture *texture; ///< Cible de rendu WIN_WIDTH x HUD_LAYER_HEIGHT (NULL : dessin direct).
+    bool valid;           ///< Le contenu correspond à `gen`.
+    uint64_t gen;         ///< Génération MODEL_GEN_HUD affichée.
+    HudSegment segments[HUD_SEGMENTS_MAX]; ///< Format découpé (langue de StringRuns).
+    int segment_count;    ///< Morceaux (0 : format non découpé, rendu par snprintf).
+} HudLayer;
+
+/**
+ * @brief Chaînes de l'interface (lang.h) mises en forme dans les deux atlas.
+ *
+ * Refaites seulement quand les atlas sont reconstruits ou que la langue
+ * change (lang_generation) : changer de langue coûte une mise en forme,
+ * afficher une chaîne de la table n'en coûte aucune.
+ */
+typedef struct
+{
+    GlyphRun runs[STR_COUNT][2]; ///< [chaîne][0 : ctx.atlas, 1 : ctx.atlas_title].
+    uint32_t gen;                ///< lang_generation() de la mise en forme (0 : à refaire).
+} StringRuns;
+
+/** @name Cache des Chaînes */
+///@{
+#define TEXT_CACHE_SIZE 32    ///< Nombre de chaînes gardées en texture.
+#define TEXT_CACHE_MAX_LEN 64 ///< Longueur maximale d'une chaîne mise en cache.
+#define TEXT_LINE_FALLBACK 128 ///< Ligne formatée sur la pile quand l'arène d'image est pleine (tronquée au-delà).
+#define MENU_LAYOUT_MAX_ROWS 24 ///< Lignes de texte au plus dans le plan d'un écran de menu.
+///@}
+
+/**
+ * @brief Une chaîne déjà rendue, prête à être copiée en un seul appel.
+ */
+typedef struct
+{
+    SDL_Texture *texture;          ///< Texture de la chaîne (NULL : entrée libre).
+    const GlyphAtlas *atlas;       ///< Atlas (taille de police) utilisé.
+    uint32_t hash;                 ///< Hachage FNV-1a du texte.
+    uint32_t color;                ///< Couleur RGBA empaquetée.
+    char text[TEXT_CACHE_MAX_LEN]; ///< Copie du texte (lève les collisions de hachage).
+    float w, h;                    ///< Taille de la texture en pixels.
+    uint64_t last_used;            ///< Horloge LRU du dernier accès.
+} TextCacheEntry;
+
+/**
+ * @brief Cache LRU des chaînes rendues par draw_text_centered.
+ *
+ * Titres, menus et lignes du tutoriel ne changent pas d'une frame à l'autre :
+ * ils sont rastérisés une fois puis copiés tels quels. Quand le cache est
+ * plein, l'entrée la moins récemment utilisée est détruite.
+ */
+typedef struct
+{
+    TextCacheEntry entries[TEXT_CACHE_SIZE]; ///< Entrées (recherche linéaire).
+    uint64_t clock;                          ///< Compteur d'accès (horloge LRU).
+    uint64_t hits;                           ///< Chaînes trouvées dans le cache.
+    uint64_t misses;                         ///< Chaînes rastérisées faute d'entrée.
+    uint64_t evictions;                      ///< Textures détruites pour faire place (invalide les plans de menu).
+} TextCache;
+
+/**
+ * @brief Plan d'un écran de menu : ses lignes de texte déjà mesurées et placées.
+ *
+ * Construit en dessinant l'écran une fois (draw_text_centered enregistre
+ * alors chaque ligne : texture du cache et rectangle centré), puis rejoué
+ * tel quel tant que la clé ne change pas : l'écran n'est plus qu'une suite
+ * de copies, sans formatage, hachage ni recherche dans le cache. La clé
+ * couvre l'état, les générations MODEL_GEN_MENU et MODEL_GEN_HUD (score de
+ * fin de partie), la saisie (modifiée par la Vue sans génération) et les
+ * évictions du cache de chaînes (textures référencées par le plan).
+ */
+typedef struct
+{
+    struct
+    {
+        SDL_Texture *texture; ///< Texture de la chaîne (entrée du cache de chaînes).
+        SDL_FRect dst;        ///< Position et taille, centrée à la construction.
+    } rows[MENU_LAYOUT_MAX_ROWS];
+    int count;              ///< Lignes enregistrées.
+    bool valid;             ///< Le plan correspond à la clé ci-dessous.
+    bool recording;         ///< Construction en cours (draw_text_centered enregistre).
+    bool direct;            ///< Une ligne n'a pas pu être enregistrée : l'écran se dessine sans plan.
+    int state;              ///< GameState de l'écran planifié.
+    uint64_t menu_gen;      ///< Génération MODEL_GEN_MENU.
+    uint64_t hud_gen;       ///< Génération MODEL_GEN_HUD.
+    uint32_t input_hash;    ///< Hachage de input_buffer.
+    uint64_t evictions;     ///< TextCache::evictions à la construction.
+    uint64_t builds;        ///< Plans construits (statistiques).
+} MenuLayout;
+
+/**
+ * @brief Panneau de performances et compteurs de rendu de la frame.
+ *
+ * Les compteurs sont incrémentés à chaque appel de dessin puis versés au
+ * profileur en fin de frame ; le panneau lit ceux de la frame précédente.
+ * Masqué, il ne coûte que ces incréments.
+ */
+typedef struct
+{
+    bool visible;     ///< Panneau affiché (F3).
+    uint32_t draws;   ///< Appels de dessin de la frame en cours.
+    uint32_t uploads; ///< Textures créées pendant la frame en cours.
+    uint64_t allocs_seen; ///< Allocations SDL cumulées à la fin de la frame précédente.
+    uint32_t driver_allocs; ///< Allocations du pilote pendant la frame (présentation, changement de cible).
+    uint32_t shield_rows; ///< Lignes de boucliers envoyées pendant la frame en cours.
+    uint32_t mixer_calls; ///< Appels au mixeur qui changent son état pendant la frame en cours.
+} PerfOverlay;
+
+/**
+ * @brief Texture d'un bouclier en bitmap (model_set_shield_bitmap), tenue à jour par lignes.
+ *
+ * Une cellule du bouclier est un texel (SHIELD_BITMAP_COLS x
+ * SHIELD_BITMAP_ROWS, accès streaming). `shown` garde les lignes déjà dans
+ * la texture : chaque image n'envoie que la bande des lignes qui en
+ * diffèrent, c'est-à-dire celles touchées depuis la dernière image. Tant
+ * que la génération MODEL_GEN_SHIELDS n'a pas bougé, rien n'est comparé.
+ */
+typedef struct
+{
+    SDL_Texture *texture;               ///< Cellules du bouclier (NULL : pas encore créée).
+    uint32_t shown[SHIELD_BITMAP_ROWS]; ///< Lignes actuellement dans la texture.
+    uint64_t gen;                       ///< Génération MODEL_GEN_SHIELDS de `shown`.
+    bool valid;                         ///< `shown` reflète la texture (false : tout renvoyer).
+    bool failed;                        ///< Création refusée : dessin par rectangles (draw_shield_cells).
+} ShieldTexture;
+
+/**
+ * @brief Particules d'explosion de la Vue et leur tampon de sommets.
+ *
+ * Les morts sont repérées en comparant l'état dessiné au précédent : bits
+ * nouveaux de `dying_mask`, OVNI qui passe en explosion, début de
+ * `hit_timer`. Toutes les particules partent en un seul SDL_RenderGeometry
+ * sans texture (un quadrilatère coloré chacune), dans un tampon alloué à
+ * l'initialisation à la capacité de la réserve.
+ */
+typedef struct
+{
+    ParticlePool pool;     ///< Réserve SoA (particles.h).
+    SDL_Vertex *vertices;  ///< 4 sommets par particule (NULL : particules désactivées).
+    int *indices;          ///< 6 indices par particule (remplis une fois).
+    uint64_t dying_seen;   ///< `dying_mask` au rendu précédent.
+    bool ufo_seen;         ///< OVNI déjà en explosion au rendu précédent.
+    bool hit_seen;         ///< `hit_timer` déjà actif au rendu précédent.
+    double last_time;      ///< Date du rendu précédent (utils_get_time ; 0 : aucun).
+} ParticleLayer;
+
+/**
+ * @brief Fond de jeu procédural (SPACE_INVADERS_STARFIELD=1) à la place de l'image bg_game.
+ *
+ * L'image n'est alors ni décodée ni envoyée : une texture plein écran de
+ * moins en mémoire vidéo, et plus de copie de toute la fenêtre à chaque
+ * image. Les étoiles ne défilent qu'en partie.
+ */
+typedef struct
+{
+    bool enabled;                        ///< Champ d'étoiles au lieu de bg_game.
+    StarField field;                     ///< Étoiles (starfield.h).
+    SDL_FPoint points[STARFIELD_STARS];  ///< Positions passées à SDL_RenderPoints.
+    double last_time;                    ///< Date du dessin précédent (utils_get_time ; 0 : aucun).
+} StarLayer;
+
+/** @name Rechargement à Chaud */
+///@{
+#define HOT_RELOAD_ROOT "assets" ///< Dossier surveillé (SPACE_INVADERS_HOT_RELOAD=1).
+#define HOT_APPLY_MAX 8          ///< Ressources échangées au plus par image (le reste attend la suivante).
+///@}
+
+/**
+ * @brief Genre d'une ressource rechargée à chaud.
+ */
+typedef enum
+{
+    HOT_SPRITE,  ///< Un sprite de même taille, sans niveaux réduits : réécrit dans son rectangle de l'atlas.
+    HOT_SHEET,   ///< Un sprite de taille nouvelle : planche des sprites recomposée.
+    HOT_TEXTURE, ///< Un fond plein écran : texture remplacée.
+    HOT_AUDIO,   ///< Un son : MIX_Audio remplacé (et piste rebranchée).
+    HOT_STREAM   ///< La musique : flux de sa piste remplacé.
+} HotAssetKind;
+
+/**
+ * @brief Ressource décodée par le thread de rechargement, échangée entre deux images.
+ */
+typedef struct
+{
+    HotAssetKind kind;             ///< Genre de la ressource.
+    SDL_Surface *surface;          ///< Pixels : sprite teinté, planche ou fond (ARGB8888).
+    SpriteId sprite;               ///< Sprite réécrit (HOT_SPRITE).
+    SDL_FRect rects[SPRITE_COUNT]; ///< Rectangles de la nouvelle planche (HOT_SHEET).
+    SDL_FRect mips[SPRITE_COUNT][SPRITE_MIP_LEVELS - 1]; ///< Niveaux réduits de la nouvelle planche (HOT_SHEET).
+    SDL_Texture **texture;         ///< Texture remplacée (HOT_TEXTURE).
+    MIX_Audio *audio;              ///< Son décodé (HOT_AUDIO).
+    MIX_Audio **slot;              ///< Son remplacé (HOT_AUDIO).
+    SDL_IOStream *io;              ///< Fichier ouvert, à lire en flux (HOT_STREAM).
+    MIX_Track *track;              ///< Piste à rebrancher (musique, OVNI ; NULL : voix ponctuelles).
+} HotAsset;
+
 /**
  * @brief Contexte Global SDL.
  * Structure "God Object" passée à toutes les fonctions de rendu SDL.
@@ -151,15 +851,58 @@ typedef struct
     SDL_Window *window;     ///< La fenêtre OS.
     SDL_Renderer *renderer; ///< Le contexte de rendu 2D (GPU).
 
-    TTF_Font *font;       ///< Police standard.
-    TTF_Font *font_title; ///< Police titre (grande).
+    TTF_Font *font;         ///< Police (une seule ouverture ; rendu de secours à la taille voulue).
+    GlyphAtlas atlas;       ///< Atlas de la police standard (FONT_SIZE).
+    GlyphAtlas atlas_title; ///< Atlas de la police titre (FONT_TITLE_SIZE).
+    TextCache text_cache;   ///< Chaînes centrées déjà rendues (LRU).
+    StringRuns strings;     ///< Chaînes de l'interface mises en forme.
+    MenuLayout menu;        ///< Plan de l'écran de menu affiché.
 
-    GameTextures tex; ///< Conteneur des images.
-    GameAudio sfx;    ///< Conteneur des sons.
+    AssetPack pack;    ///< Archive des ressources projetée (vide : fichiers un à un).
+    GameTextures tex;  ///< Conteneur des images.
+    WorldLoader world_loader; ///< Images du jeu chargées en fond.
+    StartupClock startup;     ///< Durées des étapes du démarrage.
+    SpriteBatch batch; ///< Sprites en attente d'envoi.
+    RenderLayer layer; ///< Fond pré-composé de l'écran courant.
+    WorldLayer world;  ///< Monde de jeu composé hors écran (tremblement, assombrissement).
+    FormationLayer formation; ///< Aliens vivants de la vague, en une copie par image.
+    HudLayer hud;      ///< Bandeau HUD pré-composé.
+    PerfOverlay perf;  ///< Panneau de performances (F3).
+    ShieldTexture shields[MAX_SHIELDS]; ///< Boucliers en bitmap.
+    ParticleLayer particles; ///< Particules d'explosion.
+    StarLayer stars;         ///< Champ d'étoiles (fond sans image).
+    PresentState present;    ///< Taille de sortie et calques à l'échelle.
+    DirtyRects dirty;        ///< Rectangles sales (renderer logiciel).
+    ThumbnailState thumbs;   ///< Miniatures des sauvegardes.
+    CaptureState capture;    ///< Capture vidéo de la partie.
+    QualityGovernor quality; ///< Niveau des effets selon la durée des frames.
+    MemBudget mem;           ///< Mémoire des ressources par catégorie et plafonds (membudget.h).
+    Attract attract;         ///< Démo d'accueil derrière le menu principal (attract.h).
+    bool attract_drawn;      ///< La démo a été dessinée depuis le dernier retour au jeu.
+    FrameArena frame;        ///< Mémoire passagère de l'image (mise en forme des chaînes longues).
+
+    const GameModel *prev; ///< État du tick précédent (NULL : pas d'interpolation).
+    float alpha;           ///< Fraction écoulée entre `prev` et l'état dessiné (0 à 1).
+    SceneList scene;       ///< Liste d'affichage du monde de jeu (refaite une fois par tick).
+    bool vsync;            ///< Présentation calée sur l'écran (SDL_SetRenderVSync accepté).
+    GameAudio sfx;     ///< Conteneur des sons.
 
     MIX_Mixer *mixer; ///< Instance principale du mixeur audio SDL3.
+    AudioLoader audio_loader;                   ///< Chargement de l'audio en fond.
+    AudioLatency audio_latency;                 ///< Latence de sortie, calage des bruitages.
+    AudioApplied audio_applied;                 ///< État du mixeur (appels seulement aux transitions).
+    VoicePool voices;                           ///< Voix des sons ponctuels.
+    SpscRing audio_events;                      ///< Sons demandés par le Modèle (un producteur : son thread).
+    AudioEvent audio_storage[AUDIO_EVENT_RING]; ///< Stockage de la file.
 
     int ufo_channel; ///< ID du canal audio OVNI (si gestion par canaux).
+
+    SDL_Gamepad *gamepad[PAD_PLAYERS]; ///< Manette de chaque joueur (NULL : clavier seul), dans l'ordre des branchements.
+    PadState pad[PAD_PLAYERS];         ///< Touches tenues par chaque manette, suivies événement par événement.
+
+    bool hot_wanted;                   ///< Rechargement à chaud demandé, lancé une fois tout chargé.
+    HotReload hot;                     ///< Surveillance de HOT_RELOAD_ROOT.
+    SDL_FRect hot_rects[SPRITE_COUNT]; ///< Rectangles de l'atlas vus du thread de rechargement (tailles).
 } SDLContext;
 
 /**
@@ -168,4 +911,31 @@ typedef struct
  */
 extern const ViewInterface view_sdl;
 
+/**
+ * @brief La même Vue sur le pilote SDL_Renderer "gpu" (API SDL_GPU de SDL3).
+ *
+ * Le pilote gpu regroupe tous les sommets de l'image dans un seul tampon
+ * envoyé une fois par image ; le lot de sprites y devient un seul appel de
+ * dessin pour tout le monde de jeu. Si aucun périphérique SDL_GPU n'est
+ * disponible, la Vue se replie sur le pilote par défaut.
+ */
+extern const ViewInterface view_sdlgpu;
+
+#define SNAPSHOT_DEFAULT_TICKS 600 ///< Ticks joués avant l'image de `./space_invaders snapshot` (10 s).
+
+/**
+ * @brief Dessine un état du Modèle hors écran et l'écrit en PNG.
+ *
+ * Ouvre la Vue sans fenêtre visible (pilote vidéo "offscreen", audio
+ * "dummy", sauf si SDL_VIDEO_DRIVER ou SDL_AUDIO_DRIVER sont définis), dessine le
+ * monde et le HUD dans une texture cible de `width` pixels de large (rapport
+ * de la fenêtre), relit ses pixels, attend leur écriture par le thread de
+ * thumbnail.h, puis referme la Vue. Sans particules ni interpolation : un
+ * même état donne la même image (images de référence des tests visuels).
+ *
+ * @param width Largeur de l'image (0 : WIN_WIDTH).
+ * @return false si la Vue, la cible ou l'écriture ont échoué.
+ */
+bool sdl_snapshot(const GameModel *model, const char *path, int width);
+
 #endif // VIEW_SDL_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * @file wave.h
+ * @brief Vagues scriptées : description texte compilée en table plate.
+ *
+ * Chaque niveau joue une vague décrite par un script (une section `wave` par
+ * niveau) : forme et types des aliens sur la grille FORMATION_ROWS ×
+ * FORMATION_COLS, origine, espacement, courbe de vitesse et cadence de tir.
+ *
+ * @code
+ * wave
+ * origin 5 7        # origine de la formation (coords logiques)
+ * spacing 8 5       # pas entre colonnes et entre rangées
+ * speed 1.0 0.5     # multiplicateur de départ, gain quand la vague s'éclaircit
+ * fire 0 2          # chance de tir par tick (%) : base + pente × niveau
+ * intercept 1       # tirs du joueur et des aliens s'annulent (0 : se croisent, par défaut)
+ * drops 10          # chance (%) qu'un alien abattu lâche un bonus (0 par défaut)
+ * boss 40           # vaisseau amiral de 40 pièces (0 : aucun, par défaut ; les rangées deviennent facultatives)
+ * row 3.3.3.3.3.3   # une ligne par rangée : '1' à '3' = type, '.' = case vide
+ * row 22222222222
+ * end
+ * @endcode
+ *
+ * Le script est compilé une fois, au chargement, en WaveSpec (masque, types,
+ * constantes) : init_enemies et model_update ne lisent que ces tableaux,
+ * jamais le texte. Les niveaux après la dernière vague rejouent celle-ci.
+ * Sans script (SPACE_INVADERS_WAVES), la table par défaut reprend la vague
+ * classique : 5 rangées de 11, calamars en haut, pieuvres en bas.
+ */
+
+#ifndef WAVE_H
+#define WAVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Table des vagues */
+///@{
+#define WAVE_MAX 32               ///< Vagues d'un script au plus.
+#define WAVE_ERROR_LEN 128        ///< Longueur d'un message d'erreur de compilation.
+///@}
+
+/**
+ * @brief Une vague compilée, prête pour init_enemies.
+ */
+typedef struct
+{
+    uint64_t mask;                    ///< Bit i à 1 : la case i de la grille est occupée.
+    uint8_t types[FORMATION_SIZE];    ///< Type de chaque case (EntityType), si occupée.
+    int size;                         ///< Nombre d'aliens (bits à 1 de `mask`).
+    float origin_x, origin_y;         ///< Origine de la formation au début du niveau.
+    float step_x, step_y;             ///< Pas entre colonnes et entre rangées.
+    float speed;                      ///< Multiplicateur de vitesse au départ.
+    float speedup;                    ///< Gain de vitesse quand toute la vague est tombée.
+    int fire_base;                    ///< Chance de tir par tick (%), partie fixe.
+    int fire_per_level;               ///< Chance de tir par tick (%), ajoutée à chaque niveau.
+    bool intercept;                   ///< Interception des tirs (directive `intercept`).
+    int drop_chance;                  ///< Chance de bonus par alien abattu, % (directive `drops`).
+    int boss;                         ///< Pièces du vaisseau amiral (directive `boss`, 0 : aucun).
+} WaveSpec;
+
+/**
+ * @brief Script compilé : une vague par niveau.
+ */
+typedef struct
+{
+    WaveSpec waves[WAVE_MAX]; ///< Vagues, dans l'ordre des niveaux.
+    int count;                ///< Nombre de vagues (au moins 1).
+} WaveTable;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Compile un script de vagues.
+ *
+ * @param err Reçoit le message d'erreur (ex: "ligne 4 : rangée trop longue").
+ * @return false si le script est invalide (`table` est alors indéterminée).
+ */
+bool wave_compile(WaveTable *table, const char *text, char *err, size_t err_cap);
+
+/**
+ * @brief Compile un fichier de vagues et en fait la table de toutes les parties.
+ *
+ * À appeler avant de lancer la simulation (la table est partagée, en lecture
+ * seule, par tous les modèles).
+ *
+ * @return false (table inchangée) si le fichier est illisible ou invalide.
+ */
+bool wave_load(const char *path, char *err, size_t err_cap);
+
+/**
+ * @brief Fait d'une table déjà compilée celle de toutes les parties (réglage, cf. tune.h).
+ *
+ * Mêmes précautions que wave_load : aucune simulation ne doit tourner.
+ */
+void wave_set_table(const WaveTable *table);
+
+/**
+ * @brief Vague d'un niveau (à partir de 1) ; au-delà de la table, la dernière.
+ */
+const WaveSpec *wave_for_level(int level);
+
+/**
+ * @brief Réécrit une table en script, que wave_compile relit à l'identique.
+ *
+ * @return Longueur du texte (sans le '\0'), ou 0 si `cap` ne suffit pas.
+ */
+size_t wave_format(const WaveTable *table, char *buf, size_t cap);
+
+#endif // WAVE_H
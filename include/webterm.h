@@ -0,0 +1,117 @@
+/**
+ * @file webterm.h
+ * @brief Terminal web : diffusion de la grille de la Vue texte par WebSocket, vers un navigateur.
+ *
+ * Un petit serveur HTTP sur son propre thread sert, sur le même port :
+ * - `GET /` : une page autonome (HTML et JavaScript, sans dépendance) qui
+ *   dessine la grille dans des lignes de texte ;
+ * - `GET /ws` : une connexion WebSocket (RFC 6455) par spectateur, en
+ *   lecture seule.
+ *
+ * La Vue texte (view_web, cf. view_ncurses.h) n'envoie que les cases qui
+ * ont changé depuis l'image précédente, comme dans un terminal : quelques
+ * centaines d'octets par image en partie. Un même message est envoyé à tous
+ * les spectateurs (un seul encodage) ; un nouveau venu reçoit d'abord une
+ * image complète. L'envoi ne bloque jamais : un spectateur dont le tampon
+ * d'envoi est plein (liaison trop lente) est déconnecté, sa page se
+ * reconnecte et repart d'une image complète.
+ *
+ * Format d'un message (binaire, petit-boutiste) :
+ *
+ * | Octets | Champ                                               |
+ * |--------|-----------------------------------------------------|
+ * | 0      | WEBTERM_KEY (image complète) ou WEBTERM_DIFF        |
+ * | 1-2    | lignes de la grille                                 |
+ * | 3-4    | colonnes de la grille                               |
+ * | 5-     | plages : indice de la première case (u16), nombre de cases (u8), puis les cases |
+ *
+ * Une case tient en WEBTERM_CELL_SIZE octets : l'octet du caractère,
+ * les couleurs (texte dans les 4 bits bas, fond dans les 4 bits hauts,
+ * WEBTERM_COLOR_DEFAULT : couleur par défaut) et les drapeaux
+ * (WEBTERM_BOLD, WEBTERM_LINE : symbole de tracé désigné par sa lettre VT100).
+ * Le texte des messages est en UTF-8, un octet par case.
+ */
+
+#ifndef WEBTERM_H
+#define WEBTERM_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Protocole */
+///@{
+#define WEBTERM_KEY 1             ///< Image complète (la page repart d'une grille vide).
+#define WEBTERM_DIFF 2            ///< Cases changées depuis le message précédent.
+#define WEBTERM_HEADER_SIZE 5     ///< Type, lignes, colonnes.
+#define WEBTERM_RUN_SIZE 3        ///< En-tête d'une plage : indice (u16), nombre (u8).
+#define WEBTERM_RUN_MAX 255       ///< Cases au plus par plage.
+#define WEBTERM_CELL_SIZE 3       ///< Caractère, couleurs, drapeaux.
+#define WEBTERM_COLOR_DEFAULT 0xF ///< Couleur par défaut de la page.
+#define WEBTERM_BOLD 0x1          ///< Drapeau : gras.
+#define WEBTERM_LINE 0x2          ///< Drapeau : symbole de tracé (lettre VT100 : 'q', 'x', 'l'...).
+///@}
+
+/** @name Serveur */
+///@{
+#define WEBTERM_DEFAULT_PORT 8090    ///< Port HTTP par défaut (SPACE_INVADERS_WEB_PORT).
+#define WEBTERM_MAX_VIEWERS 32       ///< Spectateurs simultanés au plus.
+#define WEBTERM_SNDBUF (256 * 1024)  ///< Tampon d'envoi de chaque spectateur (octets).
+///@}
+
+/**
+ * @brief Serveur de diffusion : socket d'écoute, spectateurs et statistiques.
+ */
+typedef struct
+{
+    bool active;                       ///< Serveur lancé.
+    int listen_fd;                     ///< Socket d'écoute HTTP.
+    pthread_t thread;                  ///< Thread d'acceptation et de lecture.
+    pthread_mutex_t lock;              ///< Protège les spectateurs (thread serveur / Vue).
+    int stop;                          ///< Arrêt demandé (atomique).
+    int fds[WEBTERM_MAX_VIEWERS];      ///< Sockets des spectateurs (-1 : libre).
+    bool live[WEBTERM_MAX_VIEWERS];    ///< A reçu une image complète (sinon : en attente).
+    int waiting;                       ///< Spectateurs en attente d'une image complète (atomique).
+    uint8_t *frame;                    ///< Trame WebSocket en cours d'envoi (Vue).
+    size_t frame_cap;                  ///< Taille de `frame`.
+    uint64_t viewers;                  ///< Spectateurs accueillis au total.
+    uint64_t messages;                 ///< Messages envoyés (une fois par spectateur).
+    uint64_t bytes;                    ///< Octets envoyés (tous spectateurs).
+    uint64_t slow;                     ///< Spectateurs déconnectés, tampon d'envoi plein.
+} WebTerm;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre le port et lance le thread du serveur.
+ * @return false si le port est indisponible ou le thread n'a pas pu être lancé.
+ */
+bool webterm_start(WebTerm *web, int port);
+
+/**
+ * @brief Indique qu'un spectateur attend une image complète (tout thread).
+ */
+bool webterm_wants_key(const WebTerm *web);
+
+/**
+ * @brief Envoie un message aux spectateurs, sans jamais bloquer.
+ *
+ * @param key true : image complète, envoyée aux seuls spectateurs qui
+ *            l'attendent (ils reçoivent ensuite les différences) ;
+ *            false : différences, envoyées aux autres.
+ */
+void webterm_send(WebTerm *web, const uint8_t *msg, size_t len, bool key);
+
+/**
+ * @brief Ferme les connexions, arrête le thread et affiche le bilan.
+ */
+void webterm_stop(WebTerm *web);
+
+#endif // WEBTERM_H
@@ -0,0 +1,120 @@
+/**
+ * @file workers.h
+ * @brief Threads de calcul partagés : une passe d'un tick répartie en tâches (fork-join).
+ *
+ * Le pool des parties (pool.h) répartit des parties entières ; celui-ci
+ * découpe le travail d'un seul tick quand il devient trop lourd pour un cœur
+ * (ex: la section F avec des milliers de balles, cf. model_update). L'appelant
+ * publie N tâches, les exécute avec les threads puis attend la dernière : au
+ * retour, tous les résultats sont écrits.
+ *
+ * @code
+ * if (!workers_run(chunk, &job, workers_threads()))
+ *     for (int c = 0; c < workers_threads(); c++)
+ *         chunk(&job, c); // Pool occupé par un autre modèle : même travail, sur place
+ * @endcode
+ *
+ * Un graphe de passes (WorkerGraph) enchaîne plusieurs de ces découpages :
+ * chaque passe déclare les domaines qu'elle lit et écrit (des bits choisis par
+ * l'appelant), et les passes consécutives sans conflit partagent une même
+ * répartition. L'ordre d'ajout est l'ordre de référence : sans threads, les
+ * passes s'exécutent une à une dans cet ordre, avec le même résultat.
+ *
+ * @code
+ * WorkerGraph g;
+ * workers_graph_clear(&g);
+ * workers_graph_add(&g, pack, &job, worlds, DOM_WORLDS, DOM_LANES);     // lit les mondes, écrit les tranches
+ * workers_graph_add(&g, step, &job, chunks, DOM_LANES, DOM_LANES);
+ * workers_graph_add(&g, finish, &job, worlds, DOM_LANES, DOM_WORLDS);
+ * workers_graph_run(&g, worlds >= 64);                                   // en deçà : sur place
+ * @endcode
+ *
+ * Les threads démarrent au premier appel qui en a besoin et attendent ensuite
+ * sur une condition : rien n'est alloué d'un tick à l'autre. Un seul appelant
+ * à la fois : un second (autre modèle, autre thread) reçoit false et fait le
+ * travail lui-même. SPACE_INVADERS_WORKERS fixe le nombre de threads, appelant
+ * compris (par défaut, un par cœur, au plus WORKERS_MAX ; 1 : désactivé).
+ */
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <stdbool.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Threads de calcul */
+///@{
+#define WORKERS_MAX 16       ///< Threads de calcul au plus (appelant compris).
+#define WORKERS_GRAPH_JOBS 8 ///< Passes d'un graphe au plus.
+///@}
+
+/**
+ * @brief Une tâche : `task` va de 0 au nombre de tâches - 1, dans n'importe quel ordre.
+ */
+typedef void (*WorkerTask)(void *ctx, int task);
+
+/**
+ * @brief Une passe du graphe : `tasks` tâches indépendantes entre elles.
+ */
+typedef struct
+{
+    WorkerTask fn;   ///< Tâche.
+    void *ctx;       ///< Contexte passé à chaque tâche.
+    int tasks;       ///< Nombre de tâches.
+    unsigned reads;  ///< Domaines lus.
+    unsigned writes; ///< Domaines écrits.
+} WorkerJob;
+
+/**
+ * @brief Passes à exécuter, dans l'ordre d'ajout.
+ */
+typedef struct
+{
+    WorkerJob jobs[WORKERS_GRAPH_JOBS]; ///< Passes ajoutées.
+    int count;                          ///< Nombre de passes.
+} WorkerGraph;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Nombre de threads de calcul, appelant compris (1 : aucun thread, tout sur place).
+ *
+ * Lu une fois dans SPACE_INVADERS_WORKERS (ou le nombre de cœurs en ligne).
+ */
+int workers_threads(void);
+
+/**
+ * @brief Exécute les tâches [0, tasks) sur les threads et l'appelant, puis attend la fin.
+ *
+ * @return false sans rien exécuter si le pool est désactivé, occupé par un
+ *         autre appelant ou si ses threads n'ont pas pu démarrer.
+ */
+bool workers_run(WorkerTask fn, void *ctx, int tasks);
+
+/**
+ * @brief Vide un graphe.
+ */
+void workers_graph_clear(WorkerGraph *graph);
+
+/**
+ * @brief Ajoute une passe à la fin du graphe.
+ *
+ * Deux passes sont en conflit si l'une écrit un domaine que l'autre lit ou écrit.
+ *
+ * @return false si le graphe est plein (WORKERS_GRAPH_JOBS).
+ */
+bool workers_graph_add(WorkerGraph *graph, WorkerTask fn, void *ctx, int tasks, unsigned reads, unsigned writes);
+
+/**
+ * @brief Exécute le graphe : chaque suite de passes consécutives sans conflit en une répartition.
+ *
+ * @param parallel false : tout sur place, dans l'ordre (travail trop petit pour réveiller les threads).
+ */
+void workers_graph_run(const WorkerGraph *graph, bool parallel);
+
+#endif // WORKERS_H
@@ -0,0 +1,114 @@
+/**
+ * @file workset.h
+ * @brief Mémoire de la boucle de jeu : un seul bloc réservé, prérempli et verrouillable au lancement.
+ *
+ * Les gros blocs d'une session (le modèle et ses pools, la copie
+ * d'interpolation, les états publiés du thread de simulation, les
+ * emplacements du miroir, les instantanés de l'enregistreur de vol) sont
+ * alloués une fois, mais chacun par malloc : leurs pages ne sont projetées
+ * qu'au premier accès, en pleine partie, et le noyau peut les évincer
+ * ensuite. Un défaut de page mineur coûte quelques microsecondes, un
+ * défaut majeur (page évincée) plusieurs millisecondes.
+ *
+ * workset_init réserve d'un coup une zone anonyme (mmap), en touche chaque
+ * page (préremplissage), puis, sur demande, la verrouille en mémoire
+ * (mlock, SPACE_INVADERS_MLOCK=1) et la place sur des pages de 2 Mo
+ * (madvise MADV_HUGEPAGE, SPACE_INVADERS_HUGEPAGES=1). Les blocs y sont
+ * découpés à la suite ; un bloc rendu est repris tel quel par la
+ * prochaine demande de même taille (copies du modèle). workset_adopt
+ * préremplit et verrouille de même une zone statique (file du profileur).
+ *
+ * Zone pleine, ou avant workset_init, un bloc vient de calloc : rien
+ * n'échoue, le débordement est seulement compté (workset_report).
+ * SPACE_INVADERS_WORKSET=0 revient entièrement à malloc.
+ *
+ * @code
+ * model_set_bullet_capacity(n);
+ * workset_init(WORKSET_MODEL_COPIES * model_block_bytes() + WORKSET_EXTRA_BYTES);
+ * GameModel *model = model_init(); // Découpé dans la zone
+ * ...
+ * model_free(model);
+ * workset_report();
+ * workset_close();
+ * @endcode
+ */
+
+#ifndef WORKSET_H
+#define WORKSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+//                          CONSTANTES & TYPES
+// ============================================================================
+
+/** @name Taille de la zone */
+///@{
+#define WORKSET_ALIGN 64                      ///< Alignement des blocs (une ligne de cache).
+#define WORKSET_MODEL_COPIES 8                ///< Copies du modèle prévues (modèle, interpolation, triple buffer, miroir...).
+#define WORKSET_EXTRA_BYTES (1u << 20)        ///< Marge pour les autres blocs (enregistreur de vol...).
+#define WORKSET_HUGE_PAGE (2u << 20)          ///< Taille d'une grande page (arrondi de la zone).
+///@}
+
+/**
+ * @brief Bilan de la zone.
+ */
+typedef struct
+{
+    size_t capacity;   ///< Taille réservée (0 : pas de zone).
+    size_t used;       ///< Octets découpés (blocs rendus compris).
+    uint64_t blocks;   ///< Blocs servis par la zone (repris compris).
+    uint64_t reused;   ///< Blocs repris d'un bloc rendu de même taille.
+    uint64_t overflow; ///< Blocs servis par calloc, zone pleine.
+    size_t adopted;    ///< Octets de zones statiques préremplies (workset_adopt).
+    bool locked;       ///< Zone verrouillée en mémoire (mlock).
+    bool huge;         ///< Grandes pages demandées (MADV_HUGEPAGE accepté).
+} WorksetStats;
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Réserve et préremplit la zone ; verrouillage et grandes pages selon l'environnement.
+ *
+ * @param bytes Taille voulue (arrondie à WORKSET_HUGE_PAGE).
+ * @return false si la zone est coupée (SPACE_INVADERS_WORKSET=0) ou la réservation refusée.
+ */
+bool workset_init(size_t bytes);
+
+/**
+ * @brief Bloc de `bytes` octets mis à zéro, aligné sur WORKSET_ALIGN (tout thread).
+ *
+ * @return NULL seulement si le repli sur calloc échoue aussi.
+ */
+void *workset_alloc(size_t bytes);
+
+/**
+ * @brief Rend un bloc de workset_alloc (NULL accepté) : gardé pour la prochaine demande de même taille.
+ */
+void workset_free(void *ptr);
+
+/**
+ * @brief Préremplit une zone existante (tableau statique) et la verrouille avec la zone.
+ */
+void workset_adopt(void *ptr, size_t bytes);
+
+/**
+ * @brief Lit le bilan.
+ */
+void workset_stats(WorksetStats *out);
+
+/**
+ * @brief Affiche le bilan (taille, occupation, débordements, verrouillage).
+ */
+void workset_report(void);
+
+/**
+ * @brief Libère la zone ; tous ses blocs doivent avoir été rendus.
+ */
+void workset_close(void);
+
+#endif // WORKSET_H
@@ -0,0 +1,225 @@
+/**
+ * @file affinity.c
+ * @brief Implémentation du placement des threads (Linux : sched_setaffinity, SCHED_FIFO, nice).
+ */
+
+/** @def _GNU_SOURCE
+ *  @brief Active cpu_set_t, pthread_setaffinity_np et syscall (extensions GNU).
+ */
+#define _GNU_SOURCE
+
+#include "affinity.h"
+#include "logger.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Suffixes des variables d'environnement, par rôle. */
+static const char *const role_keys[THREAD_ROLE_COUNT] = {"SIM", "RENDER", "INPUT", "AUDIO"};
+
+/** @brief Noms des rôles dans le journal. */
+static const char *const role_names[THREAD_ROLE_COUNT] = {"simulation", "rendu", "entree", "audio"};
+
+/**
+ * @brief Réglage demandé pour un rôle.
+ */
+typedef struct
+{
+    const char *cpus; ///< Liste de cœurs (NULL : placement inchangé).
+    int rt_priority;  ///< Priorité SCHED_FIFO demandée (0 : aucune).
+} RoleConfig;
+
+static RoleConfig configs[THREAD_ROLE_COUNT];
+static pthread_once_t configs_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Lit SPACE_INVADERS_CPU_<RÔLE> et SPACE_INVADERS_RT_<RÔLE>, une fois.
+ */
+static void read_configs(void)
+{
+    for (int r = 0; r < THREAD_ROLE_COUNT; r++)
+    {
+        char name[48];
+        snprintf(name, sizeof(name), "SPACE_INVADERS_CPU_%s", role_keys[r]);
+        const char *cpus = getenv(name);
+        configs[r].cpus = cpus && cpus[0] ? cpus : NULL;
+        snprintf(name, sizeof(name), "SPACE_INVADERS_RT_%s", role_keys[r]);
+        const char *rt = getenv(name);
+        int prio = rt ? atoi(rt) : 0;
+        configs[r].rt_priority = prio < 0 ? 0 : prio > 99 ? 99 : prio;
+    }
+}
+
+#ifdef __linux__
+/**
+ * @brief Lit une liste de cœurs ("0-1,3") dans `set`.
+ * @return false si la liste est mal formée.
+ */
+static bool parse_cpus(const char *text, cpu_set_t *set)
+{
+    CPU_ZERO(set);
+    const char *p = text;
+    while (*p)
+    {
+        char *end;
+        long lo = strtol(p, &end, 10);
+        if (end == p || lo < 0)
+            return false;
+        long hi = lo;
+        p = end;
+        if (*p == '-')
+        {
+            hi = strtol(p + 1, &end, 10);
+            if (end == p + 1 || hi < lo)
+                return false;
+            p = end;
+        }
+        for (long c = lo; c <= hi && c < CPU_SETSIZE; c++)
+            CPU_SET((int)c, set);
+        if (*p == ',')
+            p++;
+        else if (*p)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Écrit un ensemble de cœurs sous forme de liste compacte ("0-1,3").
+ */
+static void format_cpus(const cpu_set_t *set, char *out, size_t cap)
+{
+    size_t n = 0;
+    out[0] = '\0';
+    for (int c = 0; c < CPU_SETSIZE && n < cap; c++)
+    {
+        if (!CPU_ISSET(c, set))
+            continue;
+        int last = c;
+        while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set))
+            last++;
+        int w = last > c ? snprintf(out + n, cap - n, "%s%d-%d", n ? "," : "", c, last)
+                         : snprintf(out + n, cap - n, "%s%d", n ? "," : "", c);
+        if (w < 0)
+            break;
+        n += (size_t)w;
+        c = last;
+    }
+}
+
+/**
+ * @brief Fixe le thread sur les cœurs demandés qui sont permis au processus.
+ * @return false si aucun cœur demandé n'est utilisable (placement inchangé).
+ */
+static bool apply_cpus(const char *text, char *report, size_t cap)
+{
+    cpu_set_t wanted, allowed, effective;
+    if (!parse_cpus(text, &wanted))
+    {
+        snprintf(report, cap, "CPU \"%s\" illisible", text);
+        return false;
+    }
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        CPU_ZERO(&allowed);
+    CPU_AND(&effective, &wanted, &allowed);
+    if (CPU_COUNT(&effective) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(effective), &effective) != 0)
+    {
+        snprintf(report, cap, "CPU %s indisponible(s)", text);
+        return false;
+    }
+    char list[64];
+    format_cpus(&effective, list, sizeof(list));
+    snprintf(report, cap, "CPU %s", list);
+    return CPU_EQUAL(&effective, &wanted);
+}
+
+/**
+ * @brief SCHED_FIFO, borné par RLIMIT_RTPRIO sans privilège ; à défaut, le meilleur nice permis.
+ * @return true si la priorité demandée a été obtenue.
+ */
+static bool apply_priority(int wanted, char *report, size_t cap)
+{
+    int prio = wanted;
+    struct rlimit lim;
+    if (getrlimit(RLIMIT_RTPRIO, &lim) == 0 && lim.rlim_cur != RLIM_INFINITY && (rlim_t)prio > lim.rlim_cur &&
+        lim.rlim_cur > 0)
+        prio = (int)lim.rlim_cur; // Sans CAP_SYS_NICE, le noyau refuse au-delà de la limite
+
+    struct sched_param param = {.sched_priority = prio};
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0 && prio != wanted)
+    {
+        param.sched_priority = prio = wanted; // Limite ignorée avec CAP_SYS_NICE : dernier essai tel quel
+        err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+    if (err == 0)
+    {
+        snprintf(report, cap, "SCHED_FIFO %d", prio);
+        return prio == wanted;
+    }
+
+    // Temps réel refusé : nice du thread (son identifiant noyau), jusqu'à la borne de RLIMIT_NICE
+    pid_t tid = (pid_t)syscall(SYS_gettid);
+    int best = AFFINITY_NICE_FALLBACK;
+    if (getrlimit(RLIMIT_NICE, &lim) == 0 && lim.rlim_cur != RLIM_INFINITY && 20 - (int)lim.rlim_cur > best)
+        best = 20 - (int)lim.rlim_cur;
+    errno = 0;
+    int current = getpriority(PRIO_PROCESS, (id_t)tid);
+    if (errno == 0 && best < current && setpriority(PRIO_PROCESS, (id_t)tid, best) == 0)
+        snprintf(report, cap, "SCHED_FIFO refuse, nice %d", best);
+    else
+        snprintf(report, cap, "SCHED_FIFO refuse, priorite inchangee");
+    return false;
+}
+#endif
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Liste de cœurs ou priorité fixée pour ce rôle.
+ */
+bool affinity_configured(ThreadRole role)
+{
+    pthread_once(&configs_once, read_configs);
+    return configs[role].cpus || configs[role].rt_priority > 0;
+}
+
+/**
+ * @brief Placement puis priorité, chacun avec son repli ; une ligne de journal.
+ */
+bool affinity_apply(ThreadRole role)
+{
+    if (!affinity_configured(role))
+        return true;
+    const RoleConfig *cfg = &configs[role];
+    char cpus[96] = "CPU inchanges", prio[64] = "priorite inchangee";
+    bool ok = true;
+#ifdef __linux__
+    if (cfg->cpus)
+        ok = apply_cpus(cfg->cpus, cpus, sizeof(cpus)) && ok;
+    if (cfg->rt_priority > 0)
+        ok = apply_priority(cfg->rt_priority, prio, sizeof(prio)) && ok;
+#else
+    (void)cfg;
+    snprintf(cpus, sizeof(cpus), "placement non pris en charge sur ce systeme");
+    ok = false;
+#endif
+    logger_write(ok ? LOG_INFO : LOG_WARN, "[THREADS] %s : %s, %s\n", role_names[role], cpus, prio);
+    return ok;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file asset_pack.c
+ * @brief Implémentation de l'archive des ressources (lecture par mmap, construction).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour mmap, stat et dirent).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "asset_pack.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. LECTURE
+// ============================================================================
+
+/**
+ * @brief Projette le fichier et vérifie en-tête et table (blocs dans le fichier).
+ */
+bool asset_pack_open(AssetPack *pack, const char *path)
+{
+    memset(pack, 0, sizeof(*pack));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(AssetPackHeader))
+    {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // La projection reste valide
+    if (map == MAP_FAILED)
+        return false;
+
+    const uint8_t *base = map;
+    size_t size = (size_t)st.st_size;
+    const AssetPackHeader *h = map;
+    bool ok = memcmp(h->magic, ASSET_PACK_MAGIC, 4) == 0 && h->version == ASSET_PACK_VERSION &&
+              h->count <= ASSET_PACK_MAX_ENTRIES && sizeof(*h) + h->count * sizeof(AssetEntry) <= size;
+    const AssetEntry *entries = (const AssetEntry *)(base + sizeof(*h));
+    for (uint32_t i = 0; ok && i < h->count; i++)
+        ok = entries[i].offset <= size && entries[i].size <= size - entries[i].offset &&
+             memchr(entries[i].name, '\0', ASSET_NAME_MAX) != NULL;
+    if (!ok)
+    {
+        munmap(map, size);
+        return false;
+    }
+
+    pack->base = base;
+    pack->size = size;
+    pack->entries = entries;
+    pack->count = h->count;
+    return true;
+}
+
+/**
+ * @brief Recherche dichotomique dans la table triée.
+ */
+const AssetEntry *asset_pack_find(const AssetPack *pack, const char *name, const void **data)
+{
+    uint32_t lo = 0, hi = pack->base ? pack->count : 0;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int c = strcmp(name, pack->entries[mid].name);
+        if (c == 0)
+        {
+            if (data)
+                *data = pack->base + pack->entries[mid].offset;
+            return &pack->entries[mid];
+        }
+        if (c < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Libère la projection.
+ */
+void asset_pack_close(AssetPack *pack)
+{
+    if (pack->base)
+        munmap((void *)pack->base, pack->size);
+    memset(pack, 0, sizeof(*pack));
+}
+
+// ============================================================================
+//                          2. CONSTRUCTION
+// ============================================================================
+
+/**
+ * @brief Sous-dossiers de `assets/` repris dans l'archive.
+ */
+static const char *const PACK_DIRS[] = {"aliens", "backgrounds", "explosions", "hearts", "missiles",
+                                        "projectiles", "shelter", "fonts", "audio"};
+
+/**
+ * @brief Comparaison de deux entrées par nom (qsort).
+ */
+static int entry_cmp(const void *a, const void *b)
+{
+    return strcmp(((const AssetEntry *)a)->name, ((const AssetEntry *)b)->name);
+}
+
+/**
+ * @brief Vrai si le fichier est une image décodable par SDL_image.
+ */
+static bool is_image(const char *name)
+{
+    const char *dot = strrchr(name, '.');
+    return dot && (SDL_strcasecmp(dot, ".bmp") == 0 || SDL_strcasecmp(dot, ".png") == 0);
+}
+
+/**
+ * @brief Décode une image en ARGB8888, la couleur clé (noir) devenue transparente.
+ *
+ * Mêmes règles que le chargement direct de la Vue : une image sans canal
+ * alpha prend le noir pour couleur clé.
+ */
+static SDL_Surface *decode_image(const char *path)
+{
+    SDL_Surface *src = IMG_Load(path);
+    if (!src)
+        return NULL;
+    if (SDL_GetPixelFormatDetails(src->format)->bits_per_pixel < 32)
+    {
+        const SDL_PixelFormatDetails *d = SDL_GetPixelFormatDetails(src->format);
+        SDL_SetSurfaceColorKey(src, true, SDL_MapRGB(d, NULL, 0, 0, 0));
+    }
+    SDL_Surface *out = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
+    SDL_DestroySurface(src);
+    return out;
+}
+
+/**
+ * @brief Écrit un bloc à `*offset`, puis complète jusqu'au prochain multiple de ASSET_PACK_ALIGN.
+ */
+static bool write_blob(FILE *f, const void *data, size_t size, uint64_t *offset)
+{
+    static const uint8_t zeros[ASSET_PACK_ALIGN] = {0};
+    size_t pad = (ASSET_PACK_ALIGN - (*offset + size) % ASSET_PACK_ALIGN) % ASSET_PACK_ALIGN;
+    if (fwrite(data, 1, size, f) != size || fwrite(zeros, 1, pad, f) != pad)
+        return false;
+    *offset += size + pad;
+    return true;
+}
+
+/**
+ * @brief Ajoute une ressource : décodée (image) ou copiée, à la position courante.
+ *
+ * Une image que SDL_image ne sait pas décoder est copiée telle quelle.
+ */
+static bool pack_one(FILE *f, AssetEntry *e, uint64_t *offset)
+{
+    e->offset = *offset;
+    if (e->kind == ASSET_PIXELS)
+    {
+        SDL_Surface *s = decode_image(e->name);
+        if (!s)
+        {
+            // Format que cette SDL_image ne lit pas : gardé tel quel, comme sur le disque
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pack: cannot decode %s (%s), stored as is", e->name, SDL_GetError());
+            e->kind = ASSET_RAW;
+            return pack_one(f, e, offset);
+        }
+        e->width = (uint32_t)s->w;
+        e->height = (uint32_t)s->h;
+        e->pitch = (uint32_t)s->pitch;
+        e->format = (uint32_t)s->format;
+        e->size = e->pitch * e->height;
+        bool ok = write_blob(f, s->pixels, e->size, offset);
+        SDL_DestroySurface(s);
+        return ok;
+    }
+
+    size_t size = 0;
+    void *data = SDL_LoadFile(e->name, &size);
+    if (!data)
+        return false;
+    e->size = (uint32_t)size;
+    bool ok = write_blob(f, data, size, offset);
+    SDL_free(data);
+    return ok;
+}
+
+/**
+ * @brief Liste les fichiers des sous-dossiers, les trie, puis écrit l'archive.
+ */
+int asset_pack_build(const char *path)
+{
+    static AssetEntry entries[ASSET_PACK_MAX_ENTRIES];
+    uint32_t count = 0;
+    for (size_t d = 0; d < sizeof(PACK_DIRS) / sizeof(PACK_DIRS[0]); d++)
+    {
+        char dir[ASSET_NAME_MAX];
+        snprintf(dir, sizeof(dir), "assets/%s", PACK_DIRS[d]);
+        DIR *dp = opendir(dir);
+        if (!dp)
+            continue;
+        struct dirent *de;
+        while ((de = readdir(dp)) != NULL)
+        {
+            AssetEntry e = {0};
+            struct stat st;
+            if (de->d_name[0] == '.' ||
+                snprintf(e.name, sizeof(e.name), "%s/%s", dir, de->d_name) >= (int)sizeof(e.name) ||
+                stat(e.name, &st) != 0 || !S_ISREG(st.st_mode))
+                continue;
+            if (count == ASSET_PACK_MAX_ENTRIES)
+            {
+                fprintf(stderr, "[PACK] Plus de %d fichiers : %s ignoré\n", ASSET_PACK_MAX_ENTRIES, e.name);
+                continue;
+            }
+            e.kind = is_image(e.name) ? ASSET_PIXELS : ASSET_RAW;
+            entries[count++] = e;
+        }
+        closedir(dp);
+    }
+    qsort(entries, count, sizeof(entries[0]), entry_cmp);
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f)
+        return -1;
+    AssetPackHeader h = {{'S', 'I', 'P', 'K'}, ASSET_PACK_VERSION, count, 0};
+    uint64_t offset = sizeof(h);
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    // Table provisoire (positions encore inconnues), réécrite à la fin
+    ok = ok && write_blob(f, entries, count * sizeof(AssetEntry), &offset);
+    for (uint32_t i = 0; ok && i < count; i++)
+        ok = pack_one(f, &entries[i], &offset);
+    ok = ok && fseek(f, (long)sizeof(h), SEEK_SET) == 0 && fwrite(entries, sizeof(AssetEntry), count, f) == count;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(tmp, path) != 0)
+    {
+        remove(tmp);
+        return -1;
+    }
+    return (int)count;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file attract.c
+ * @brief Implémentation de la démo d'accueil (attente, choix de l'enregistrement, rejeu au rythme réel).
+ */
+
+#include "attract.h"
+#include "logger.h"
+#include "pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Ferme l'enregistrement et libère le modèle de la démo en cours.
+ */
+static void demo_stop(Attract *a)
+{
+    replay_cursor_close(a->cursor);
+    model_free(a->demo);
+    a->cursor = NULL;
+    a->demo = NULL;
+}
+
+/**
+ * @brief Ouvre un enregistrement sur un modèle neuf et passe ses menus jusqu'à la partie.
+ * @return false si le fichier est illisible ou si la partie ne commence jamais.
+ */
+static bool demo_open(Attract *a, const char *path, double now)
+{
+    a->demo = model_init();
+    a->cursor = a->demo ? replay_cursor_open(a->demo, path) : NULL;
+    if (!a->cursor)
+    {
+        demo_stop(a);
+        return false;
+    }
+    int ticks;
+    bool more = true;
+    for (int f = 0; more && f < ATTRACT_SKIP_FRAMES && a->demo->sim.state != STATE_PLAYING; f++)
+        more = replay_cursor_step(a->cursor, a->demo, &ticks);
+    if (!more || a->demo->sim.state != STATE_PLAYING)
+    {
+        demo_stop(a);
+        return false;
+    }
+    a->hz = replay_cursor_hz(a->cursor);
+    a->start = now;
+    a->ticks = 0;
+    return true;
+}
+
+/**
+ * @brief Liste les enregistrements du dossier et ne garde que ceux que replay_verify juge valides.
+ *
+ * Un enregistrement sans empreintes, ou fait avant un changement de la
+ * simulation, rejouerait des commandes qui ne correspondent plus à la
+ * partie : le vaisseau de la démo agirait à contretemps. Chaque fichier est
+ * rejoué une fois, au premier départ (quelques dizaines de millisecondes).
+ */
+static void demo_list(Attract *a)
+{
+    a->listed = true;
+    a->paths = pool_list_replays(a->dir, &a->count);
+    if (!a->paths)
+        a->count = 0;
+    GameModel *check = a->count > 0 ? model_init() : NULL;
+    int kept = 0;
+    for (int k = 0; k < a->count; k++)
+    {
+        ReplayStats rs;
+        ReplayVerdict verdict = check ? replay_verify(check, a->paths[k], &rs) : REPLAY_UNREADABLE;
+        if (verdict == REPLAY_VALID)
+        {
+            a->paths[kept++] = a->paths[k];
+            continue;
+        }
+        logger_write(LOG_WARN, "[DEMO] %s ignore : %s\n", a->paths[k], replay_verdict_label(verdict));
+        free(a->paths[k]);
+    }
+    model_free(check);
+    a->count = kept;
+    logger_write(LOG_INFO, "[DEMO] %d enregistrement(s) valide(s) dans %s\n", a->count, a->dir);
+}
+
+/**
+ * @brief Lance l'enregistrement suivant de la liste (le premier lisible, en faisant le tour une fois).
+ */
+static bool demo_next(Attract *a, double now)
+{
+    if (!a->listed)
+        demo_list(a);
+    for (int k = 0; k < a->count; k++)
+    {
+        const char *path = a->paths[a->next];
+        a->next = (a->next + 1) % a->count;
+        if (demo_open(a, path, now))
+        {
+            a->shown++;
+            return true;
+        }
+        logger_write(LOG_WARN, "[DEMO] %s ignore : illisible ou sans partie\n", path);
+    }
+    return false;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief SPACE_INVADERS_ATTRACT (secondes) et SPACE_INVADERS_ATTRACT_DIR.
+ */
+void attract_init(Attract *a, double now)
+{
+    memset(a, 0, sizeof(Attract));
+    const char *env = getenv("SPACE_INVADERS_ATTRACT");
+    a->idle_s = env && env[0] ? atof(env) : ATTRACT_IDLE_S;
+    if (a->idle_s < 0.0)
+        a->idle_s = 0.0;
+    const char *dir = getenv("SPACE_INVADERS_ATTRACT_DIR");
+    a->dir = dir && dir[0] ? dir : ATTRACT_DIR;
+    a->idle_since = now;
+}
+
+/**
+ * @brief Départ après le repos, puis autant de frames enregistrées que le temps écoulé en demande.
+ */
+const GameModel *attract_frame(Attract *a, const GameModel *model, double now)
+{
+    if (a->idle_s <= 0.0)
+        return NULL;
+    if (model->sim.state != STATE_MENU)
+    {
+        attract_wake(a, now);
+        return NULL;
+    }
+    if (!a->demo)
+    {
+        if (now - a->idle_since < a->idle_s)
+            return NULL;
+        if (!demo_next(a, now))
+        {
+            a->idle_since = now; // Rien à montrer : nouvel essai après une autre attente
+            return NULL;
+        }
+    }
+
+    // Après une image bloquée (chargement, fenêtre déplacée), la démo reprend sans rattraper
+    double due = (now - a->start) * a->hz;
+    if (due > (double)a->ticks + ATTRACT_MAX_LAG_S * a->hz)
+    {
+        a->start = now - (double)a->ticks / a->hz;
+        due = (double)a->ticks;
+    }
+    while ((double)a->ticks < due)
+    {
+        int ticks;
+        bool more = replay_cursor_step(a->cursor, a->demo, &ticks);
+        a->ticks += (uint64_t)ticks;
+        if (!more || a->demo->sim.state != STATE_PLAYING)
+        {
+            // Partie rejouée finie : l'enregistrement suivant, sinon retour au menu seul
+            demo_stop(a);
+            if (!demo_next(a, now))
+            {
+                a->idle_since = now;
+                return NULL;
+            }
+            break;
+        }
+    }
+    return a->demo;
+}
+
+/**
+ * @brief Arrêt de la démo, attente relancée.
+ */
+void attract_wake(Attract *a, double now)
+{
+    demo_stop(a);
+    a->idle_since = now;
+}
+
+/**
+ * @brief Modèle de démo alloué.
+ */
+bool attract_active(const Attract *a)
+{
+    return a->demo != NULL;
+}
+
+/**
+ * @brief Démo arrêtée, liste rendue.
+ */
+void attract_free(Attract *a)
+{
+    demo_stop(a);
+    if (a->paths)
+        pool_free_replays(a->paths, a->count);
+    a->paths = NULL;
+    a->count = 0;
+    a->listed = false;
+}
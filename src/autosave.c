@@ -0,0 +1,269 @@
+/**
+ * @file autosave.c
+ * @brief Implémentation du journal d'autosave (écriture en fond, reprise après crash).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour stat).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "autosave.h"
+#include "save.h"
+#include "save_writer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// ============================================================================
+//                          1. FORMAT DU JOURNAL
+// ============================================================================
+
+#define AUTOSAVE_DIR "sauvegardes" ///< Dossier du journal (celui des sauvegardes).
+#define RECORD_CHECKPOINT 'C'      ///< Enregistrement : sauvegarde complète (save_encode).
+#define RECORD_DELTA 'D'           ///< Enregistrement : delta (save_encode_delta).
+#define RECORD_HEADER_SIZE 9       ///< type u8 | taille u32 | CRC32 u32.
+
+/** @brief Écrit un entier 32 bits little-endian. */
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/** @brief Lit un entier 32 bits little-endian. */
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Complète l'en-tête d'un enregistrement dont les données sont déjà en place.
+ * @return La taille totale de l'enregistrement.
+ */
+static size_t frame_record(uint8_t *rec, uint8_t kind, size_t payload_len)
+{
+    rec[0] = kind;
+    put_le32(rec + 1, (uint32_t)payload_len);
+    put_le32(rec + 5, save_crc32(rec + RECORD_HEADER_SIZE, payload_len));
+    return RECORD_HEADER_SIZE + payload_len;
+}
+
+/**
+ * @brief Lit l'enregistrement suivant du journal.
+ *
+ * S'arrête au premier enregistrement incomplet ou dont le CRC est faux
+ * (écriture interrompue par un crash) : tout ce qui suit est ignoré.
+ *
+ * @return false en fin de journal (ou à la première corruption).
+ */
+static bool next_record(const uint8_t *buf, size_t len, size_t *pos,
+                        uint8_t *kind, const uint8_t **payload, size_t *payload_len)
+{
+    if (len - *pos < RECORD_HEADER_SIZE)
+        return false;
+    const uint8_t *rec = buf + *pos;
+    size_t n = get_le32(rec + 1);
+    if (n > len - *pos - RECORD_HEADER_SIZE)
+        return false;
+    if (save_crc32(rec + RECORD_HEADER_SIZE, n) != get_le32(rec + 5))
+        return false;
+
+    *kind = rec[0];
+    *payload = rec + RECORD_HEADER_SIZE;
+    *payload_len = n;
+    *pos += RECORD_HEADER_SIZE + n;
+    return true;
+}
+
+/**
+ * @brief Charge tout le journal en mémoire.
+ * @return Le buffer (à libérer), ou NULL si le fichier est absent ou vide.
+ */
+static uint8_t *read_journal(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+
+    uint8_t *buf = NULL;
+    long size = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    if (size > 0 && fseek(f, 0, SEEK_SET) == 0 && (buf = malloc((size_t)size)) != NULL)
+    {
+        *len = fread(buf, 1, (size_t)size, f);
+        if (*len == 0)
+        {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(f);
+    return buf;
+}
+
+// ============================================================================
+//                          2. ÉCRITURE (PENDANT LA PARTIE)
+// ============================================================================
+
+/**
+ * @brief Demande l'écriture d'un point de reprise (remplace tout le journal).
+ */
+static bool write_checkpoint(const GameModel *model)
+{
+    static uint8_t rec[SAVE_MAX_SIZE];
+    size_t n = save_encode(model, rec + RECORD_HEADER_SIZE, sizeof(rec) - RECORD_HEADER_SIZE);
+    if (n == 0)
+        return false;
+    return save_writer_try_submit(SAVE_WRITE_REPLACE, AUTOSAVE_DIR, AUTOSAVE_FILE,
+                                  rec, frame_record(rec, RECORD_CHECKPOINT, n));
+}
+
+/**
+ * @brief Demande l'ajout d'un delta en fin de journal.
+ */
+static bool write_delta(const GameModel *model)
+{
+    uint8_t rec[RECORD_HEADER_SIZE + SAVE_DELTA_MAX_SIZE];
+    size_t n = save_encode_delta(model, rec + RECORD_HEADER_SIZE, SAVE_DELTA_MAX_SIZE);
+    if (n == 0)
+        return false;
+    return save_writer_try_submit(SAVE_WRITE_APPEND, AUTOSAVE_DIR, AUTOSAVE_FILE,
+                                  rec, frame_record(rec, RECORD_DELTA, n));
+}
+
+/**
+ * @brief Initialise l'état de l'autosave.
+ */
+void autosave_init(Autosave *autosave, bool enabled)
+{
+    memset(autosave, 0, sizeof(Autosave));
+    autosave->enabled = enabled;
+}
+
+/**
+ * @brief À appeler après chaque model_update : écrit les entrées dues.
+ */
+void autosave_update(Autosave *autosave, const GameModel *model, double dt)
+{
+    if (!autosave->enabled)
+        return;
+
+    // Fin de partie : le journal n'a plus rien à reprendre
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        if (autosave->running &&
+            save_writer_try_submit(SAVE_WRITE_DELETE, AUTOSAVE_DIR, AUTOSAVE_FILE, NULL, 0))
+            autosave->running = false;
+        return;
+    }
+
+    // Retour aux menus : la prochaine partie (nouvelle ou chargée) repart d'un point de reprise
+    if (model->sim.state == STATE_MENU || model->sim.state == STATE_LOAD_MENU)
+    {
+        autosave->running = false;
+        return;
+    }
+    if (model->sim.state != STATE_PLAYING)
+        return;
+
+    if (!autosave->running || model->sim.level != autosave->level)
+    {
+        autosave->running = true;
+        autosave->need_checkpoint = true;
+        autosave->level = model->sim.level;
+    }
+
+    autosave->timer += dt;
+    bool due = autosave->need_checkpoint || autosave->timer >= AUTOSAVE_PERIOD;
+    if (!due)
+        return;
+
+    // Thread occupé : on réessaie au tick suivant, sans jamais attendre
+    if (autosave->need_checkpoint || autosave->entries + 1 >= AUTOSAVE_CHECKPOINT_EVERY)
+    {
+        if (!write_checkpoint(model))
+            return;
+        autosave->need_checkpoint = false;
+        autosave->entries = 0;
+    }
+    else
+    {
+        if (!write_delta(model))
+            return;
+        autosave->entries++;
+    }
+    autosave->timer = 0;
+}
+
+// ============================================================================
+//                          3. REPRISE
+// ============================================================================
+
+/**
+ * @brief Restaure une partie depuis un journal (point de reprise + deltas).
+ */
+bool autosave_recover(GameModel *model, const char *path)
+{
+    size_t len = 0;
+    uint8_t *buf = read_journal(path, &len);
+    if (!buf)
+        return false;
+
+    // 1. Dernier point de reprise valide
+    size_t pos = 0, deltas_from = 0;
+    const uint8_t *checkpoint = NULL;
+    size_t checkpoint_len = 0;
+    uint8_t kind;
+    const uint8_t *payload;
+    size_t n;
+    while (next_record(buf, len, &pos, &kind, &payload, &n))
+    {
+        if (kind == RECORD_CHECKPOINT)
+        {
+            checkpoint = payload;
+            checkpoint_len = n;
+            deltas_from = pos;
+        }
+    }
+
+    bool ok = checkpoint && save_decode(model, checkpoint, checkpoint_len);
+
+    // 2. Deltas qui le suivent, dans l'ordre (arrêt au premier incompatible)
+    pos = deltas_from;
+    while (ok && next_record(buf, len, &pos, &kind, &payload, &n))
+        if (kind == RECORD_DELTA && !save_apply_delta(model, payload, n))
+            break;
+
+    free(buf);
+    return ok;
+}
+
+/**
+ * @brief Lit les métadonnées du journal (pour le menu "Charger").
+ */
+bool autosave_describe(const char *path, SaveIndexEntry *entry)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return false;
+
+    GameModel *scratch = model_init();
+    if (!scratch)
+        return false;
+
+    bool ok = autosave_recover(scratch, path);
+    if (ok)
+    {
+        snprintf(entry->name, sizeof(entry->name), "%s", AUTOSAVE_FILE);
+        entry->timestamp = (int64_t)st.st_mtime;
+        entry->level = scratch->sim.level;
+        entry->score = scratch->sim.score;
+        entry->size = (uint32_t)st.st_size;
+    }
+    model_free(scratch);
+    return ok;
+}
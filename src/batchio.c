@@ -0,0 +1,373 @@
+/**
+ * @file batchio.c
+ * @brief Implémentation de la lecture groupée (io_uring sous Linux, threads de calcul sinon).
+ */
+
+/** @def _GNU_SOURCE
+ *  @brief Active syscall et O_CLOEXEC (io_uring n'a pas d'enveloppe dans la glibc).
+ */
+#define _GNU_SOURCE
+
+#include "batchio.h"
+#include "workers.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// ============================================================================
+//                          1. REPLI : THREADS DE CALCUL
+// ============================================================================
+
+static const char *backend = "threads"; ///< Mécanisme du dernier lot.
+
+/**
+ * @brief Résultats remis à zéro (avant un lot, ou avant sa reprise par les threads).
+ */
+static void reset_items(BatchIoItem *items, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        items[i].error = 0;
+        items[i].mtime = 0;
+        items[i].size = 0;
+        items[i].data = NULL;
+    }
+}
+
+/**
+ * @brief Un fichier : stat, puis open, read et close si son contenu est demandé.
+ */
+static void load_one(void *ctx, int task)
+{
+    BatchIoItem *it = (BatchIoItem *)ctx + task;
+    struct stat st;
+    if (stat(it->path, &st) != 0)
+    {
+        it->error = errno;
+        return;
+    }
+    it->mtime = (int64_t)st.st_mtime;
+    it->size = (uint64_t)st.st_size;
+    if (it->size == 0 || it->size > it->max_size)
+        return;
+
+    int fd = open(it->path, O_RDONLY | O_CLOEXEC);
+    uint8_t *data = fd >= 0 ? malloc((size_t)it->size) : NULL;
+    size_t got = 0;
+    while (data && got < it->size)
+    {
+        ssize_t n = read(fd, data + got, (size_t)it->size - got);
+        if (n <= 0)
+            break;
+        got += (size_t)n;
+    }
+    it->error = fd < 0 ? errno : (got == it->size ? 0 : EIO);
+    if (fd >= 0)
+        close(fd);
+    if (it->error == 0)
+        it->data = data;
+    else
+        free(data);
+}
+
+/**
+ * @brief Le lot réparti sur les threads de calcul (sur place s'ils sont occupés ou désactivés).
+ */
+static void load_threads(BatchIoItem *items, int count)
+{
+    backend = "threads";
+    if (!workers_run(load_one, items, count))
+        for (int i = 0; i < count; i++)
+            load_one(items, i);
+}
+
+// ============================================================================
+//                          2. IO_URING (LINUX)
+// ============================================================================
+
+#ifdef __linux__
+
+/**
+ * @brief Anneaux projetés d'une instance io_uring.
+ */
+typedef struct
+{
+    int fd;
+    void *sq_map, *cq_map;
+    size_t sq_len, cq_len;
+    struct io_uring_sqe *sqes;
+    size_t sqes_len;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+} Ring;
+
+/** @brief Étiquette d'une complétion : l'étape dans les 2 bits bas, l'entrée au-dessus. */
+enum
+{
+    OP_STATX,
+    OP_OPEN,
+    OP_READ
+};
+
+static bool ring_open(Ring *r)
+{
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(r, 0, sizeof(*r));
+    r->fd = (int)syscall(__NR_io_uring_setup, BATCHIO_RING, &p);
+    if (r->fd < 0)
+        return false;
+
+    r->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        r->sq_len = r->cq_len = r->sq_len > r->cq_len ? r->sq_len : r->cq_len;
+    r->sq_map = mmap(NULL, r->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    r->cq_map = (p.features & IORING_FEAT_SINGLE_MMAP) || r->sq_map == MAP_FAILED
+                    ? r->sq_map
+                    : mmap(NULL, r->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd,
+                           IORING_OFF_CQ_RING);
+    r->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    r->sqes = r->cq_map == MAP_FAILED ? MAP_FAILED
+                                      : mmap(NULL, r->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                             r->fd, IORING_OFF_SQES);
+    if (r->sqes == MAP_FAILED)
+    {
+        if (r->cq_map != MAP_FAILED && r->cq_map != r->sq_map)
+            munmap(r->cq_map, r->cq_len);
+        if (r->sq_map != MAP_FAILED)
+            munmap(r->sq_map, r->sq_len);
+        close(r->fd);
+        return false;
+    }
+
+    uint8_t *sq = r->sq_map, *cq = r->cq_map;
+    r->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    r->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    r->sq_array = (unsigned *)(sq + p.sq_off.array);
+    r->cq_head = (unsigned *)(cq + p.cq_off.head);
+    r->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    r->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    r->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return true;
+}
+
+static void ring_close(Ring *r)
+{
+    munmap(r->sqes, r->sqes_len);
+    if (r->cq_map != r->sq_map)
+        munmap(r->cq_map, r->cq_len);
+    munmap(r->sq_map, r->sq_len);
+    close(r->fd);
+}
+
+/**
+ * @brief Prochaine entrée de soumission, remise à zéro (publiée par ring_submit).
+ */
+static struct io_uring_sqe *ring_sqe(Ring *r, unsigned *tail, int op, int item)
+{
+    unsigned idx = *tail & *r->sq_mask;
+    struct io_uring_sqe *sqe = &r->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = (uint64_t)item << 2 | (uint64_t)op;
+    r->sq_array[idx] = idx;
+    (*tail)++;
+    return sqe;
+}
+
+/**
+ * @brief Publie les entrées préparées, attend toutes leurs complétions et les remet à `done`.
+ * @return false si le noyau refuse la soumission (le lot passe alors aux threads).
+ */
+static bool ring_submit(Ring *r, unsigned tail, unsigned pending, void (*done)(void *, uint64_t, int32_t), void *ctx)
+{
+    __atomic_store_n(r->sq_tail, tail, __ATOMIC_RELEASE);
+    unsigned to_submit = pending;
+    while (pending > 0)
+    {
+        long ret = syscall(__NR_io_uring_enter, r->fd, to_submit, pending, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret < 0 && errno != EINTR)
+            return false;
+        if (ret > 0)
+            to_submit -= (unsigned)ret < to_submit ? (unsigned)ret : to_submit;
+
+        unsigned head = *r->cq_head, end = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != end && pending > 0; head++, pending--)
+        {
+            const struct io_uring_cqe *cqe = &r->cqes[head & *r->cq_mask];
+            done(ctx, cqe->user_data, cqe->res);
+        }
+        __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+/**
+ * @brief Descripteurs et statx d'une tranche du lot (complétions des deux premières étapes).
+ */
+typedef struct
+{
+    BatchIoItem *items;
+    int *fds;
+    struct statx *stx;
+    bool refused; ///< Opération inconnue du noyau (trop ancien) : tout le lot passe aux threads.
+} RingBatch;
+
+static void ring_done(void *ctx, uint64_t tag, int32_t res)
+{
+    RingBatch *b = ctx;
+    int i = (int)(tag >> 2);
+    BatchIoItem *it = &b->items[i];
+    if (res == -EINVAL || res == -EOPNOTSUPP)
+        b->refused = true;
+    switch ((int)(tag & 3))
+    {
+    case OP_STATX:
+        if (res < 0)
+            it->error = -res;
+        else
+        {
+            it->mtime = (int64_t)b->stx[i].stx_mtime.tv_sec;
+            it->size = b->stx[i].stx_size;
+        }
+        break;
+    case OP_OPEN:
+        b->fds[i] = res;
+        if (res < 0 && it->error == 0)
+            it->error = -res;
+        break;
+    default:
+        if (res != (int32_t)it->size && it->error == 0)
+            it->error = res < 0 ? -res : EIO;
+        break;
+    }
+}
+
+/**
+ * @brief Une tranche d'au plus BATCHIO_RING / 2 fichiers : statx et ouvertures ensemble, puis les lectures.
+ */
+static bool ring_load(Ring *r, BatchIoItem *items, int count)
+{
+    int fds[BATCHIO_RING / 2];
+    struct statx stx[BATCHIO_RING / 2];
+    RingBatch b = {items, fds, stx, false};
+    unsigned tail = *r->sq_tail, pending = 0;
+    for (int i = 0; i < count; i++)
+    {
+        fds[i] = -1;
+        struct io_uring_sqe *sqe = ring_sqe(r, &tail, OP_STATX, i);
+        sqe->opcode = IORING_OP_STATX;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uint64_t)(uintptr_t)items[i].path;
+        sqe->len = STATX_SIZE | STATX_MTIME;
+        sqe->off = (uint64_t)(uintptr_t)&stx[i];
+        pending++;
+        if (items[i].max_size == 0)
+            continue;
+        sqe = ring_sqe(r, &tail, OP_OPEN, i);
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uint64_t)(uintptr_t)items[i].path;
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        pending++;
+    }
+    bool ok = ring_submit(r, tail, pending, ring_done, &b) && !b.refused;
+
+    pending = 0;
+    for (int i = 0; ok && i < count; i++)
+    {
+        BatchIoItem *it = &items[i];
+        if (fds[i] < 0 || it->error != 0 || it->size == 0 || it->size > it->max_size ||
+            !(it->data = malloc((size_t)it->size)))
+            continue;
+        struct io_uring_sqe *sqe = ring_sqe(r, &tail, OP_READ, i);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fds[i];
+        sqe->addr = (uint64_t)(uintptr_t)it->data;
+        sqe->len = (uint32_t)it->size;
+        pending++;
+    }
+    if (ok && pending > 0)
+        ok = ring_submit(r, tail, pending, ring_done, &b) && !b.refused;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (fds[i] >= 0)
+            close(fds[i]);
+        if (items[i].error != 0)
+        {
+            free(items[i].data);
+            items[i].data = NULL;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Le lot par io_uring, tranche par tranche.
+ * @return false si io_uring est indisponible ou refuse une opération (rien n'est gardé).
+ */
+static bool load_uring(BatchIoItem *items, int count)
+{
+    const char *env = getenv("SPACE_INVADERS_IO_URING");
+    Ring r;
+    if ((env && strcmp(env, "0") == 0) || !ring_open(&r))
+        return false;
+    bool ok = true;
+    for (int start = 0; ok && start < count; start += BATCHIO_RING / 2)
+    {
+        int n = count - start < BATCHIO_RING / 2 ? count - start : BATCHIO_RING / 2;
+        ok = ring_load(&r, items + start, n);
+    }
+    ring_close(&r);
+    if (ok)
+        backend = "io_uring";
+    else
+        batchio_release(items, count);
+    return ok;
+}
+
+#endif
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief io_uring d'abord ; au moindre refus, tout le lot est relu par les threads.
+ */
+void batchio_load(BatchIoItem *items, int count)
+{
+    reset_items(items, count);
+#ifdef __linux__
+    if (count > 0 && load_uring(items, count))
+        return;
+    reset_items(items, count);
+#endif
+    load_threads(items, count);
+}
+
+void batchio_release(BatchIoItem *items, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        free(items[i].data);
+        items[i].data = NULL;
+    }
+}
+
+const char *batchio_backend(void)
+{
+    return backend;
+}
@@ -0,0 +1,414 @@
+/**
+ * @file bot.c
+ * @brief Implémentation du joueur automatique.
+ */
+
+#include "bot.h"
+#include "utils.h"
+
+#include <math.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Réglages des niveaux prédéfinis (index BOT_LEVEL_*). */
+static const BotConfig presets[BOT_LEVEL_COUNT] = {
+    {12, 0.4f, 0.0f, 3.0f, 35, 0, 0}, // Facile
+    {5, 0.8f, 1.0f, 1.5f, 10, 0, 0},  // Normal
+    {1, 0.5f, 0.5f, 1.5f, 0, 0, 0},   // Difficile
+    {4, 0.5f, 0.5f, 1.5f, 0, 60, 2000}, // Planificateur : une décision toutes les 4 ticks, 1 s d'avance
+};
+
+/** @brief Touches candidates du planificateur (la décision de l'heuristique passe avant). */
+static const unsigned plan_actions[BOT_PLAN_ACTIONS] = {
+    0, INPUT_LEFT, INPUT_RIGHT, INPUT_FIRE, INPUT_LEFT | INPUT_FIRE, INPUT_RIGHT | INPUT_FIRE,
+};
+
+/**
+ * @brief Tire un entier 64 bits (SplitMix64), sur l'état du bot seulement.
+ */
+static uint64_t bot_rng_next(Bot *bot)
+{
+    uint64_t z = (bot->rng += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Position du vaisseau après `t` secondes dans la direction `dir` (bords compris).
+ */
+static float player_x_after(float x, float speed, int dir, float t)
+{
+    x += dir * speed * t;
+    if (x < 0)
+        x = 0;
+    if (x > GAME_WIDTH - PLAYER_WIDTH)
+        x = GAME_WIDTH - PLAYER_WIDTH;
+    return x;
+}
+
+/**
+ * @brief Danger d'une direction : somme, sur les balles ennemies qui toucheraient le vaisseau
+ * dans l'horizon d'esquive, de leur urgence (plus l'impact est proche, plus il pèse).
+ *
+ * Le vaisseau est testé à l'entrée de la balle dans sa rangée et à sa sortie.
+ */
+static float danger(const Bot *bot, const GameModel *model, int dir)
+{
+    const BulletPool *p = &model->sim.bullets;
+    const Entity *pl = &model->sim.player;
+    float margin = bot->cfg.dodge_margin;
+    float sum = 0.0f;
+    for (int k = 0; k < p->live.count; k++)
+    {
+        int i = p->live.items[k];
+        if (p->type[i] != ENTITY_BULLET_ENEMY || p->dy[i] <= 0.0f || p->y[i] >= pl->y + PLAYER_HEIGHT)
+            continue;
+        float t_in = (pl->y - (p->y[i] + BULLET_HEIGHT)) / p->dy[i];
+        if (t_in < 0)
+            t_in = 0;
+        if (t_in > bot->cfg.dodge_horizon)
+            continue;
+        float t_out = t_in + (PLAYER_HEIGHT + BULLET_HEIGHT) / p->dy[i];
+        for (int s = 0; s < 2; s++)
+        {
+            float x = player_x_after(pl->x, model->sim.params.player_speed, dir, s ? t_out : t_in);
+            if (p->x[i] + BULLET_WIDTH + margin > x && p->x[i] - margin < x + PLAYER_WIDTH)
+            {
+                sum += bot->cfg.dodge_horizon - t_in + 0.01f;
+                break;
+            }
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Indique si un bouclier arrêterait un tir partant de la position `x` du vaisseau.
+ */
+static bool shield_above(const GameModel *model, float x)
+{
+    float bx = x + 1.5f; // Départ du tir (cf. model_handle_input)
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        const Shield *sh = &model->sim.shields[s];
+        if (!sh->active || bx + BULLET_WIDTH <= sh->x || bx >= sh->x + sh->width)
+            continue;
+        // En bitmap, un tir passe par une brèche qui traverse tout le bunker
+        if (!model->sim.shield_bitmap || model_shield_cells(sh, bx, sh->y, BULLET_WIDTH, sh->height) > 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Position du vaisseau d'où un tir touchera la cible la plus proche.
+ *
+ * Candidats : l'alien vivant le plus bas de chaque colonne, les pièces du
+ * vaisseau amiral, et l'OVNI (préféré à distance égale, de 15 unités). Chaque cible est prise à sa position au
+ * moment où la balle arrive à sa hauteur (rebonds de la vague compris, cf.
+ * model_formation_at) ; une position sous un bouclier coûte 20 unités (le tir
+ * le détruirait).
+ *
+ * @return false si aucune cible n'est disponible.
+ */
+static bool pick_target(const GameModel *model, float *target_x)
+{
+    const Formation *f = &model->sim.formation;
+    const Entity *pl = &model->sim.player;
+    float shot_y = pl->y - 1;
+    float best_cost = HUGE_VALF;
+    bool found = false;
+
+    for (int c = 0; f->alive_count > 0 && c < FORMATION_COLS; c++)
+    {
+        int low = -1;
+        for (int r = FORMATION_ROWS - 1; r >= 0 && low < 0; r--)
+            if (f->alive_mask & (1ULL << (r * FORMATION_COLS + c)))
+                low = r * FORMATION_COLS + c;
+        if (low < 0)
+            continue;
+        float t = (shot_y - (model_get_enemy_y(model, low) + ENEMY_HEIGHT)) / model->sim.params.bullet_speed;
+        // Tir (largeur 1, en x + 1.5) centré sous l'alien : x du vaisseau = x de l'alien, rebonds compris
+        float ox, oy;
+        model_formation_at(model, t > 0 ? (int)(t / model->sim.tick_dt + 0.5) : 0, &ox, &oy);
+        float x = model_get_enemy_x(model, low) + (ox - f->origin_x);
+        float cost = fabsf(x - pl->x) + (shield_above(model, x) ? 20.0f : 0.0f);
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            *target_x = x;
+            found = true;
+        }
+    }
+
+    // Vaisseau amiral : chaque pièce intacte, à sa vitesse actuelle (le tir touche la plus basse de sa colonne)
+    Entity part;
+    for (int k = 0; k < BOSS_MAX_PARTS; k++)
+    {
+        if (!model_get_boss_part(model, k, &part))
+            continue;
+        float t = (shot_y - (part.y + part.height)) / model->sim.params.bullet_speed;
+        float x = part.x + part.dx * (t > 0 ? t : 0) + part.width / 2.0f - 1.5f;
+        float cost = fabsf(x - pl->x) + (shield_above(model, x) ? 20.0f : 0.0f);
+        if (x >= 0 && x <= GAME_WIDTH - PLAYER_WIDTH && cost < best_cost)
+        {
+            best_cost = cost;
+            *target_x = x;
+            found = true;
+        }
+    }
+
+    const Ufo *u = &model->sim.ufo;
+    if (u->active && !u->exploding)
+    {
+        float t = (shot_y - (u->y + u->height)) / model->sim.params.bullet_speed;
+        float x = u->x + u->dx * (t > 0 ? t : 0) + u->width / 2.0f - 2.0f;
+        float cost = fabsf(x - pl->x) - 15.0f + (shield_above(model, x) ? 20.0f : 0.0f);
+        if (x >= 0 && x <= GAME_WIDTH - PLAYER_WIDTH && cost < best_cost)
+        {
+            *target_x = x;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Cible, esquive, puis tir si la cible est alignée et le tir rechargé.
+ */
+static unsigned heuristic(Bot *bot, const GameModel *model)
+{
+    const Entity *pl = &model->sim.player;
+    bool has_target = pick_target(model, &bot->target_x);
+    float gap = has_target ? bot->target_x - pl->x : 0.0f;
+    float step = model->sim.params.player_speed / TARGET_FPS;
+    int want = (gap > step / 2) ? 1 : (gap < -step / 2) ? -1 : 0;
+
+    // Esquive : la direction voulue si elle est sûre, sinon la moins dangereuse
+    int dir = want;
+    if (bot->cfg.dodge_horizon > 0.0f)
+    {
+        const int order[3] = {want, want != 0 ? 0 : -1, want != 0 ? -want : 1};
+        float best = HUGE_VALF;
+        for (int k = 0; k < 3 && best > 0.0f; k++)
+        {
+            float v = danger(bot, model, order[k]);
+            if (v < best)
+            {
+                best = v;
+                dir = order[k];
+            }
+        }
+    }
+
+    unsigned held = (dir < 0) ? INPUT_LEFT : (dir > 0) ? INPUT_RIGHT : 0;
+    if (has_target && pl->shoot_timer <= 0 && fabsf(bot->target_x - pl->x) <= bot->cfg.aim_slack &&
+        !shield_above(model, pl->x) && (int)(bot_rng_next(bot) % 100) >= bot->cfg.miss_percent)
+        held |= INPUT_FIRE;
+    return held;
+}
+
+/**
+ * @brief Modèle de travail de la taille de `model`, sans son ni télémétrie (alloué une fois).
+ */
+static GameModel *plan_scratch(Bot *bot, const GameModel *model)
+{
+    if (bot->scratch && bot->scratch->block_size != model->block_size)
+    {
+        model_free(bot->scratch); // Autre capacité de balles : un autre bloc
+        bot->scratch = NULL;
+    }
+    if (!bot->scratch && (bot->scratch = model_clone(model)) != NULL)
+    {
+        model_set_audio_sink(bot->scratch, NULL);
+        model_set_telemetry_sink(bot->scratch, NULL);
+    }
+    return bot->scratch;
+}
+
+/**
+ * @brief Un déroulé : la touche tenue BOT_PLAN_HOLD ticks, puis un bot difficile jusqu'à `plan_ticks`.
+ *
+ * @param deadline Échéance du budget (utils_now_ns, 0 : aucune).
+ * @param value Reçoit le bilan : points marqués moins BOT_PLAN_LIFE_COST par vie perdue.
+ * @return false si le budget a expiré pendant le déroulé (bilan inutilisable).
+ */
+static bool plan_rollout(Bot *bot, GameModel *sim, const GameModel *model, unsigned action, uint64_t deadline,
+                         long *value)
+{
+    model_copy_sim(sim, model);
+    Bot rollout = {0};
+    bot_init(&rollout, &presets[BOT_LEVEL_HARD], bot->rng ^ action);
+    for (int t = 0; t < bot->cfg.plan_ticks && sim->sim.state == STATE_PLAYING; t++)
+    {
+        if (deadline && t % BOT_PLAN_CHECK_TICKS == 0 && t > 0 && utils_now_ns() >= deadline)
+            return false;
+        unsigned held = t < BOT_PLAN_HOLD ? action : heuristic(&rollout, sim);
+        model_handle_input(sim, command_held(held));
+        model_update(sim, sim->sim.tick_dt);
+        bot->plan_nodes++;
+    }
+    *value = (long)(sim->sim.score - model->sim.score) - (long)BOT_PLAN_LIFE_COST * (model->sim.lives - sim->sim.lives);
+    return true;
+}
+
+/**
+ * @brief Garde, parmi les touches candidates, celle au meilleur déroulé ; l'heuristique d'abord.
+ */
+static unsigned plan(Bot *bot, const GameModel *model, unsigned first)
+{
+    GameModel *sim = plan_scratch(bot, model);
+    if (!sim)
+        return first;
+    uint64_t start = utils_now_ns();
+    uint64_t deadline = bot->cfg.plan_budget_us > 0 ? start + (uint64_t)bot->cfg.plan_budget_us * 1000u : 0;
+    unsigned best = first;
+    long best_value = 0;
+    bool done = true;
+    for (int k = -1; k < BOT_PLAN_ACTIONS; k++)
+    {
+        unsigned action = k < 0 ? first : plan_actions[k];
+        if (k >= 0 && action == first)
+            continue;
+        if (k >= 0 && deadline && utils_now_ns() >= deadline)
+        {
+            done = false;
+            break;
+        }
+        long value;
+        if (!plan_rollout(bot, sim, model, action, deadline, &value))
+        {
+            done = false;
+            break;
+        }
+        if (k < 0 || value > best_value)
+        {
+            best = action;
+            best_value = value;
+        }
+    }
+    bot->plan_ns += utils_now_ns() - start;
+    bot->plan_decisions++;
+    if (!done)
+        bot->plan_cutoffs++;
+    return best;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Remplit les réglages d'un niveau prédéfini.
+ */
+void bot_preset(BotConfig *cfg, int level)
+{
+    if (level < 0)
+        level = 0;
+    if (level >= BOT_LEVEL_COUNT)
+        level = BOT_LEVEL_COUNT - 1;
+    *cfg = presets[level];
+}
+
+/**
+ * @brief Prépare un bot (à refaire pour chaque partie).
+ */
+void bot_init(Bot *bot, const BotConfig *cfg, uint64_t seed)
+{
+    bot->cfg = *cfg;
+    if (bot->cfg.plan_ticks < 0)
+        bot->cfg.plan_ticks = 0;
+    if (bot->cfg.reaction_ticks < 1)
+        bot->cfg.reaction_ticks = 1;
+    bot->rng = seed;
+    bot->wait = 0;
+    bot->held = 0;
+    bot->target_x = (GAME_WIDTH - PLAYER_WIDTH) / 2.0f;
+}
+
+/**
+ * @brief Décision de l'heuristique, vérifiée par le planificateur s'il est réglé.
+ *
+ * Entre deux décisions, le déplacement est maintenu mais pas le tir : sans
+ * quoi le tir partirait dès la fin du rechargement, aligné ou non.
+ */
+unsigned bot_decide(Bot *bot, const GameModel *model)
+{
+    if (model->sim.state != STATE_PLAYING || !model->sim.player.active)
+        return 0;
+    if (bot->wait > 0)
+    {
+        bot->wait--;
+        return bot->held & ~(unsigned)INPUT_FIRE;
+    }
+    bot->wait = bot->cfg.reaction_ticks - 1;
+
+    unsigned held = heuristic(bot, model);
+    if (bot->cfg.plan_ticks > 0)
+        held = plan(bot, model, held);
+    bot->held = held;
+    return held;
+}
+
+/**
+ * @brief Rend le modèle de travail.
+ */
+void bot_free(Bot *bot)
+{
+    model_free(bot->scratch);
+    bot->scratch = NULL;
+}
+
+/**
+ * @brief Nœuds (ticks simulés) par seconde de planification.
+ */
+double bot_plan_rate(const Bot *bot)
+{
+    return bot->plan_ns > 0 ? (double)bot->plan_nodes * 1e9 / (double)bot->plan_ns : 0.0;
+}
+
+/** @brief Bot et Vue d'origine de bot_attach_view. */
+static Bot view_bot;
+static bool view_bot_ready = false;
+static const ViewInterface *bot_view = NULL;
+
+/**
+ * @brief Contrat get_input du bot seul.
+ */
+void bot_get_input(GameModel *model, CommandQueue *queue)
+{
+    if (!view_bot_ready)
+    {
+        BotConfig cfg;
+        bot_preset(&cfg, BOT_LEVEL_NORMAL);
+        bot_init(&view_bot, &cfg, model->sim.rng.seed);
+        view_bot_ready = true;
+    }
+    if (model->sim.state == STATE_PLAYING)
+        command_queue_push(queue, command_held(bot_decide(&view_bot, model)), utils_get_time());
+}
+
+/**
+ * @brief get_input de la Vue branchée : ses événements d'abord, puis le bot.
+ */
+static void attached_get_input(GameModel *model, CommandQueue *queue)
+{
+    if (bot_view)
+        bot_view->get_input(model, queue);
+    bot_get_input(model, queue);
+}
+
+/**
+ * @brief Copie la Vue et remplace son get_input.
+ */
+void bot_attach_view(ViewInterface *out, const ViewInterface *view, const BotConfig *cfg, uint64_t seed)
+{
+    bot_init(&view_bot, cfg, seed);
+    view_bot_ready = true;
+    bot_view = view;
+    *out = *view;
+    out->get_input = attached_get_input;
+}
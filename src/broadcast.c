@@ -0,0 +1,1256 @@
+/**
+ * @file broadcast.c
+ * @brief Implémentation de la diffusion : source, relais et spectateurs.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour getaddrinfo, sigaction et select).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "broadcast.h"
+#include "save.h"
+#include "utils.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. PAQUETS
+// ============================================================================
+
+/** @name Types de paquets */
+///@{
+#define PKT_HELLO 1 ///< Abonné : abonnement, demande de l'image clé.
+#define PKT_NEED 2  ///< Abonné : accusé et paquets manquants.
+#define PKT_BYE 3   ///< Départ (d'un abonné) ou fin de la diffusion (de l'amont).
+#define PKT_DATA 4  ///< Amont : événements d'un paquet.
+#define PKT_KEY 5   ///< Amont : fragment d'image clé.
+#define PKT_SYNC 6  ///< Amont : empreinte d'une nouvelle image clé.
+///@}
+
+#define PKT_HEADER 4                                   ///< "SI" | version | type.
+#define DATA_HEADER (PKT_HEADER + 9)                   ///< En-tête de DATA, événements exclus.
+#define DATA_MAX (DATA_HEADER + BROADCAST_EVENTS_MAX)  ///< Plus grand paquet DATA.
+#define KEY_HEADER (PKT_HEADER + 23)                   ///< En-tête de KEY, fragment exclu.
+#define KEY_FRAGMENTS 64                               ///< Fragments d'une image clé, au plus.
+#define KEY_MAX (BROADCAST_FRAGMENT * KEY_FRAGMENTS)   ///< Plus grande image clé.
+#define KEY_FIXED 0x01                                 ///< Drapeau de KEY : physique en virgule fixe.
+#define KEY_SWEPT 0x02                                 ///< Drapeau de KEY : collisions balayées des balles.
+#define PKT_MAX (KEY_HEADER + BROADCAST_FRAGMENT)      ///< Plus grand paquet possible.
+#define NEED_GAP 0x01                                  ///< Drapeau de NEED : des paquets manquent.
+#define NEED_SIZE (PKT_HEADER + 13)                    ///< Taille de NEED.
+#define LINK_WINDOW BROADCAST_RESEND_MAX               ///< Paquets DATA gardés par un abonné en attendant un trou.
+#define TICK_RUN_MAX 0x7F                              ///< Ticks au plus par événement.
+
+/** @name Cadences des abonnés (s) */
+///@{
+#define HELLO_INTERVAL 0.5  ///< Entre deux HELLO tant que l'image clé n'est pas complète.
+#define NEED_INTERVAL 0.25  ///< Entre deux demandes de paquets manquants.
+#define ALIVE_INTERVAL 1.0  ///< Entre deux accusés sans demande (présence).
+///@}
+
+/** @brief Demande d'arrêt (SIGINT), relevée par la boucle du relais. */
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_sigint(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void put_header(uint8_t *p, uint8_t type)
+{
+    p[0] = 'S';
+    p[1] = 'I';
+    p[2] = BROADCAST_VERSION;
+    p[3] = type;
+}
+
+/**
+ * @brief Type d'un paquet reçu, ou 0 s'il n'est pas de ce protocole.
+ */
+static int packet_type(const uint8_t *p, ssize_t len)
+{
+    if (len < PKT_HEADER || p[0] != 'S' || p[1] != 'I' || p[2] != BROADCAST_VERSION)
+        return 0;
+    return p[3];
+}
+
+/**
+ * @brief Indique si `seq` vient avant `ref` (numéros sur 32 bits, qui reviennent à 0).
+ */
+static bool seq_before(uint32_t seq, uint32_t ref)
+{
+    return (int32_t)(seq - ref) < 0;
+}
+
+static bool same_addr(const struct sockaddr_in *a, const struct sockaddr_in *b)
+{
+    return a->sin_addr.s_addr == b->sin_addr.s_addr && a->sin_port == b->sin_port;
+}
+
+/**
+ * @brief Temps processeur du processus (s).
+ */
+static double cpu_time(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Ouvre un socket UDP connecté à l'amont.
+ *
+ * @return Le descripteur, ou -1 si l'hôte est introuvable.
+ */
+static int connect_upstream(const char *host, int port)
+{
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, service, &hints, &res) != 0 || !res)
+        return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+// ============================================================================
+//                          2. NŒUD (SOURCE OU RELAIS)
+// ============================================================================
+
+/**
+ * @brief Un paquet DATA gardé pour les répétitions.
+ */
+typedef struct
+{
+    uint16_t len;            ///< Taille du paquet (0 : emplacement vide).
+    uint8_t bytes[DATA_MAX]; ///< Paquet complet, en-tête compris.
+} DataSlot;
+
+/**
+ * @brief Un abonné (spectateur ou relais).
+ */
+typedef struct
+{
+    bool used;               ///< Emplacement occupé.
+    struct sockaddr_in addr; ///< Adresse de l'abonné.
+    double last_seen;        ///< Dernier paquet reçu (horloge de utils_get_time).
+    uint32_t next;           ///< Prochain paquet qu'il attend (dernier accusé).
+} Subscriber;
+
+/**
+ * @brief Image clé : l'état au début d'un paquet, encodé par save_encode_snapshot.
+ */
+typedef struct
+{
+    uint32_t seq;          ///< Paquet DATA dont elle précède les événements.
+    uint32_t tick;         ///< Ticks simulés avant elle.
+    uint32_t fingerprint;  ///< save_fingerprint de l'état (CRC32 de l'instantané).
+    uint8_t flags;         ///< KEY_FIXED, KEY_SWEPT.
+    uint16_t bullets;      ///< Capacité du pool de balles de la partie.
+    uint32_t len;          ///< Taille de l'instantané (0 : aucune image clé).
+    uint8_t bytes[KEY_MAX];///< Instantané.
+} KeyFrame;
+
+/**
+ * @brief Nœud de diffusion : historique, image clé et abonnés.
+ */
+struct Broadcast
+{
+    int fd;                                            ///< Socket UDP d'écoute des abonnés.
+    DataSlot history[BROADCAST_HISTORY];               ///< Derniers paquets (indice : numéro % BROADCAST_HISTORY).
+    uint32_t first_seq;                                ///< Plus ancien paquet gardé.
+    uint32_t next_seq;                                 ///< Prochain paquet (gardés : [first_seq, next_seq)).
+    KeyFrame key;                                      ///< Dernière image clé.
+    Subscriber subs[BROADCAST_MAX_SUBSCRIBERS];        ///< Abonnés.
+    int sub_count;                                     ///< Abonnés actuels.
+
+    // --- Source : paquet en cours ---
+    uint8_t events[BROADCAST_EVENTS_MAX];              ///< Événements du paquet en cours.
+    int event_len;                                     ///< Octets d'événements.
+    int ticks;                                         ///< Ticks du paquet en cours.
+    uint32_t tick;                                     ///< Ticks simulés depuis l'ouverture.
+    uint32_t packet_tick;                              ///< Ticks simulés avant le paquet en cours.
+
+    double start;                                      ///< Ouverture (horloge de utils_get_time).
+    double cpu_start;                                  ///< Temps processeur à l'ouverture.
+    BroadcastStats stats;                              ///< Bilan en cours.
+};
+
+static void node_send(Broadcast *b, const struct sockaddr_in *to, const uint8_t *p, size_t len)
+{
+    ssize_t sent = sendto(b->fd, p, len, 0, (const struct sockaddr *)to, sizeof(*to));
+    if (sent > 0)
+        b->stats.bytes_sent += sent;
+}
+
+/**
+ * @brief Ouvre un nœud sur un port UDP.
+ *
+ * @return NULL si l'allocation échoue ou si le port est indisponible.
+ */
+static Broadcast *node_open(int port, const char *label)
+{
+    Broadcast *b = calloc(1, sizeof(Broadcast));
+    if (!b)
+        return NULL;
+    b->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (b->fd < 0 || bind(b->fd, (const struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "[ERREUR] %s : port UDP %d indisponible (%s)\n", label, port, strerror(errno));
+        if (b->fd >= 0)
+            close(b->fd);
+        free(b);
+        return NULL;
+    }
+    b->start = utils_get_time();
+    b->cpu_start = cpu_time();
+    return b;
+}
+
+/**
+ * @brief Envoie l'image clé en fragments.
+ */
+static void node_send_key(Broadcast *b, const struct sockaddr_in *to)
+{
+    const KeyFrame *k = &b->key;
+    uint8_t p[PKT_MAX];
+    for (uint32_t off = 0; off < k->len; off += BROADCAST_FRAGMENT)
+    {
+        uint32_t n = k->len - off < BROADCAST_FRAGMENT ? k->len - off : BROADCAST_FRAGMENT;
+        put_header(p, PKT_KEY);
+        put32(p + PKT_HEADER, k->seq);
+        put32(p + PKT_HEADER + 4, k->tick);
+        put32(p + PKT_HEADER + 8, k->fingerprint);
+        p[PKT_HEADER + 12] = k->flags;
+        put16(p + PKT_HEADER + 13, k->bullets);
+        put32(p + PKT_HEADER + 15, k->len);
+        put32(p + PKT_HEADER + 19, off);
+        memcpy(p + KEY_HEADER, k->bytes + off, n);
+        node_send(b, to, p, KEY_HEADER + n);
+    }
+    b->stats.keys_sent++;
+}
+
+/**
+ * @brief Annonce l'image clé à tous les abonnés (sans l'envoyer).
+ */
+static void node_send_sync(Broadcast *b, uint32_t seq, uint32_t fingerprint)
+{
+    uint8_t p[PKT_HEADER + 8];
+    put_header(p, PKT_SYNC);
+    put32(p + PKT_HEADER, seq);
+    put32(p + PKT_HEADER + 4, fingerprint);
+    for (int i = 0; i < BROADCAST_MAX_SUBSCRIBERS; i++)
+        if (b->subs[i].used)
+            node_send(b, &b->subs[i].addr, p, sizeof(p));
+}
+
+/**
+ * @brief Annonce la fin de la diffusion à tous les abonnés.
+ */
+static void node_send_bye(Broadcast *b)
+{
+    uint8_t p[PKT_HEADER];
+    put_header(p, PKT_BYE);
+    for (int i = 0; i < BROADCAST_MAX_SUBSCRIBERS; i++)
+        if (b->subs[i].used)
+            for (int k = 0; k < 3; k++) // Sans accusé : répété contre la perte
+                node_send(b, &b->subs[i].addr, p, sizeof(p));
+}
+
+/**
+ * @brief Garde un paquet DATA (le suivant de l'historique) et le recopie à chaque abonné.
+ */
+static void node_store(Broadcast *b, const uint8_t *p, size_t len)
+{
+    DataSlot *slot = &b->history[b->next_seq % BROADCAST_HISTORY];
+    memcpy(slot->bytes, p, len);
+    slot->len = (uint16_t)len;
+    b->next_seq++;
+    if (b->next_seq - b->first_seq > BROADCAST_HISTORY)
+        b->first_seq = b->next_seq - BROADCAST_HISTORY;
+    b->stats.packets++;
+
+    for (int i = 0; i < BROADCAST_MAX_SUBSCRIBERS; i++)
+        if (b->subs[i].used)
+            node_send(b, &b->subs[i].addr, p, len);
+}
+
+/**
+ * @brief Repart d'un historique vide, au paquet `seq`.
+ */
+static void node_reset(Broadcast *b, uint32_t seq)
+{
+    b->first_seq = seq;
+    b->next_seq = seq;
+}
+
+static Subscriber *node_find(Broadcast *b, const struct sockaddr_in *addr)
+{
+    for (int i = 0; i < BROADCAST_MAX_SUBSCRIBERS; i++)
+        if (b->subs[i].used && same_addr(&b->subs[i].addr, addr))
+            return &b->subs[i];
+    return NULL;
+}
+
+/**
+ * @brief Inscrit un abonné.
+ *
+ * @return NULL si le nœud est plein.
+ */
+static Subscriber *node_add(Broadcast *b, const struct sockaddr_in *addr)
+{
+    for (int i = 0; i < BROADCAST_MAX_SUBSCRIBERS; i++)
+    {
+        Subscriber *s = &b->subs[i];
+        if (s->used)
+            continue;
+        memset(s, 0, sizeof(*s));
+        s->used = true;
+        s->addr = *addr;
+        s->next = b->key.seq;
+        b->sub_count++;
+        if (b->sub_count > b->stats.max_subscribers)
+            b->stats.max_subscribers = b->sub_count;
+        return s;
+    }
+    return NULL;
+}
+
+static void node_remove(Broadcast *b, Subscriber *s)
+{
+    s->used = false;
+    b->sub_count--;
+}
+
+/**
+ * @brief Répond à un NEED : les paquets manquants, ou l'image clé s'ils ne sont plus gardés.
+ *
+ * @param have Bit i : l'abonné a déjà le paquet `s->next + 1 + i`.
+ */
+static void node_resend(Broadcast *b, Subscriber *s, uint64_t have)
+{
+    if (seq_before(s->next, b->first_seq) || seq_before(b->next_seq, s->next))
+    {
+        if (b->key.len)
+            node_send_key(b, &s->addr);
+        return;
+    }
+    uint32_t end = b->next_seq;
+    if (end - s->next > BROADCAST_RESEND_MAX)
+        end = s->next + BROADCAST_RESEND_MAX;
+    for (uint32_t seq = s->next; seq != end; seq++)
+    {
+        if (seq != s->next && (have >> (seq - s->next - 1) & 1))
+            continue;
+        const DataSlot *slot = &b->history[seq % BROADCAST_HISTORY];
+        node_send(b, &s->addr, slot->bytes, slot->len);
+        b->stats.resent++;
+    }
+}
+
+/**
+ * @brief Traite un paquet d'un abonné.
+ */
+static void node_handle(Broadcast *b, const uint8_t *p, ssize_t len, const struct sockaddr_in *from, double now)
+{
+    int type = packet_type(p, len);
+    Subscriber *s = node_find(b, from);
+    if (type == PKT_BYE)
+    {
+        if (s)
+            node_remove(b, s);
+        return;
+    }
+    if (type != PKT_HELLO && (type != PKT_NEED || len < NEED_SIZE))
+    {
+        b->stats.rejected++;
+        return;
+    }
+    // Un NEED inconnu vient d'un abonné d'avant un redémarrage : il est réinscrit
+    if (!s)
+        s = node_add(b, from);
+    if (!s)
+    {
+        b->stats.rejected++; // Plein : l'abonné finira par abandonner
+        return;
+    }
+    s->last_seen = now;
+    if (type == PKT_HELLO)
+    {
+        if (b->key.len)
+            node_send_key(b, &s->addr);
+        return;
+    }
+    s->next = get32(p + PKT_HEADER);
+    if (p[PKT_HEADER + 4] & NEED_GAP)
+        node_resend(b, s, (uint64_t)get32(p + PKT_HEADER + 5) | (uint64_t)get32(p + PKT_HEADER + 9) << 32);
+}
+
+/**
+ * @brief Lit tous les paquets des abonnés en attente, puis oublie les abonnés muets.
+ */
+static void node_poll(Broadcast *b)
+{
+    uint8_t p[PKT_MAX];
+    double now = utils_get_time();
+    for (;;)
+    {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = recvfrom(b->fd, p, sizeof(p), MSG_DONTWAIT, (struct sockaddr *)&from, &from_len);
+        if (len < 0)
+            break;
+        b->stats.bytes_recv += len;
+        node_handle(b, p, len, &from, now);
+    }
+    for (int i = 0; i < BROADCAST_MAX_SUBSCRIBERS; i++)
+        if (b->subs[i].used && now - b->subs[i].last_seen > BROADCAST_TIMEOUT)
+            node_remove(b, &b->subs[i]);
+}
+
+/**
+ * @brief Termine un nœud : annonce la fin, remplit le bilan et libère.
+ */
+static void node_close(Broadcast *b, BroadcastStats *out)
+{
+    node_send_bye(b);
+    close(b->fd);
+    b->stats.elapsed = utils_get_time() - b->start;
+    b->stats.cpu = cpu_time() - b->cpu_start;
+    b->stats.subscribers = b->sub_count;
+    if (out)
+        *out = b->stats;
+    free(b);
+}
+
+// ============================================================================
+//                          3. SOURCE
+// ============================================================================
+
+/**
+ * @brief Prend l'image clé de l'état courant (début du prochain paquet) et l'annonce.
+ */
+static void source_take_key(Broadcast *b, const GameModel *model)
+{
+    KeyFrame *k = &b->key;
+    size_t len = save_encode_snapshot(model, k->bytes, sizeof(k->bytes));
+    if (len == 0)
+        return; // Trop grande : les abonnés gardent la précédente
+    k->len = (uint32_t)len;
+    k->seq = b->next_seq;
+    k->tick = b->tick;
+    k->fingerprint = save_crc32(k->bytes, len); // L'instantané est ce que save_fingerprint hache
+    k->flags = (model->sim.fixed_point ? KEY_FIXED : 0) | (model->sim.swept_bullets ? KEY_SWEPT : 0);
+    k->bullets = (uint16_t)model->sim.bullets.capacity;
+    b->stats.keyframes++;
+    node_send_sync(b, k->seq, k->fingerprint);
+}
+
+/**
+ * @brief Envoie le paquet en cours, même incomplet.
+ */
+static void source_flush(Broadcast *b)
+{
+    uint8_t p[DATA_MAX];
+    put_header(p, PKT_DATA);
+    put32(p + PKT_HEADER, b->next_seq);
+    put32(p + PKT_HEADER + 4, b->packet_tick);
+    p[PKT_HEADER + 8] = (uint8_t)b->event_len;
+    memcpy(p + DATA_HEADER, b->events, (size_t)b->event_len);
+    node_store(b, p, DATA_HEADER + (size_t)b->event_len);
+    b->event_len = 0;
+    b->ticks = 0;
+    b->packet_tick = b->tick;
+}
+
+static void source_event(Broadcast *b, uint8_t ev)
+{
+    if (b->event_len == BROADCAST_EVENTS_MAX)
+        source_flush(b);
+    b->events[b->event_len++] = ev;
+}
+
+/**
+ * @brief Ouvre la diffusion d'une partie et prend sa première image clé.
+ */
+Broadcast *broadcast_open(int port, const GameModel *model)
+{
+    Broadcast *b = node_open(port, "Diffusion");
+    if (!b)
+        return NULL;
+    source_take_key(b, model);
+    if (!b->key.len)
+    {
+        fprintf(stderr, "[ERREUR] Diffusion : image cle de plus de %d octets\n", KEY_MAX);
+        close(b->fd);
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+/**
+ * @brief Ajoute au flux une commande appliquée à la partie.
+ */
+void broadcast_command(Broadcast *b, GameCommand cmd)
+{
+    if (b && cmd < BROADCAST_EV_MENU)
+        source_event(b, (uint8_t)cmd);
+}
+
+/**
+ * @brief Ajoute au flux un retour au menu principal.
+ */
+void broadcast_menu(Broadcast *b)
+{
+    if (b)
+        source_event(b, BROADCAST_EV_MENU);
+}
+
+/**
+ * @brief Compte un tick simulé ; tous les BROADCAST_SEND_EVERY ticks, envoie le paquet DATA.
+ */
+void broadcast_tick(Broadcast *b, const GameModel *model)
+{
+    if (!b)
+        return;
+    // Ticks consécutifs sans commande : un seul événement
+    uint8_t *last = b->event_len ? &b->events[b->event_len - 1] : NULL;
+    if (last && (*last & BROADCAST_EV_TICKS) && (*last & TICK_RUN_MAX) < TICK_RUN_MAX)
+        (*last)++;
+    else
+        source_event(b, BROADCAST_EV_TICKS | 1);
+    b->tick++;
+    if (++b->ticks < BROADCAST_SEND_EVERY)
+        return;
+    source_flush(b);
+    if (b->next_seq - b->key.seq >= BROADCAST_KEY_EVERY)
+        source_take_key(b, model);
+}
+
+/**
+ * @brief Traite les demandes des abonnés en attente, sans bloquer.
+ */
+void broadcast_poll(Broadcast *b)
+{
+    if (b)
+        node_poll(b);
+}
+
+/**
+ * @brief Ferme la diffusion.
+ */
+void broadcast_close(Broadcast *b, BroadcastStats *out)
+{
+    if (!b)
+        return;
+    if (b->event_len)
+        source_flush(b);
+    node_close(b, out);
+}
+
+// ============================================================================
+//                          4. ABONNEMENT (RELAIS ET SPECTATEUR)
+// ============================================================================
+
+/** @brief Ce qu'un paquet de l'amont apporte. */
+typedef enum
+{
+    LINK_NONE, ///< Rien à traiter (doublon, hors d'ordre, fragment).
+    LINK_DATA, ///< Un paquet DATA gardé (à lire dans l'ordre par link_peek).
+    LINK_KEY,  ///< Une image clé complète, dans `key`.
+    LINK_SYNC, ///< Une annonce d'image clé (`sync_seq`, `sync_fp`).
+    LINK_END   ///< Fin de la diffusion.
+} LinkEvent;
+
+/**
+ * @brief Abonnement à un amont : ordre des paquets, image clé en cours de réception.
+ */
+typedef struct
+{
+    int fd;               ///< Socket UDP connecté à l'amont.
+    uint32_t next;        ///< Prochain paquet DATA attendu.
+    bool synced;          ///< Une image clé a été appliquée : les paquets DATA sont acceptés.
+    bool want_key;        ///< HELLO à répéter jusqu'à une image clé complète.
+    bool gap;             ///< Des paquets manquent.
+    uint32_t highest;     ///< Plus récent paquet DATA vu.
+    DataSlot window[LINK_WINDOW]; ///< Paquets reçus à partir de `next` (indice : numéro % LINK_WINDOW).
+    KeyFrame key;         ///< Image clé en cours de réception, puis complète.
+    uint64_t key_got;     ///< Fragments reçus (bit i : fragment i).
+    uint32_t sync_seq;    ///< Dernière annonce SYNC.
+    uint32_t sync_fp;     ///< Son empreinte.
+    double last_hello;    ///< Dernier HELLO envoyé.
+    double last_need;     ///< Dernière demande de paquets.
+    double last_alive;    ///< Dernier accusé.
+    double last_recv;     ///< Dernier paquet reçu.
+    BroadcastStats *stats;///< Bilan à compléter.
+} Link;
+
+static void link_send(Link *l, const uint8_t *p, size_t len)
+{
+    ssize_t sent = send(l->fd, p, len, 0);
+    if (sent > 0)
+        l->stats->bytes_sent += sent;
+}
+
+/**
+ * @brief Envoie un accusé (NEED), avec la demande des paquets manquants si besoin.
+ */
+static void link_send_need(Link *l, double now)
+{
+    uint64_t have = 0;
+    for (uint32_t i = 0; i < LINK_WINDOW; i++)
+    {
+        uint32_t seq = l->next + 1 + i;
+        const DataSlot *slot = &l->window[seq % LINK_WINDOW];
+        if (slot->len && get32(slot->bytes + PKT_HEADER) == seq)
+            have |= (uint64_t)1 << i;
+    }
+    uint8_t p[NEED_SIZE];
+    put_header(p, PKT_NEED);
+    put32(p + PKT_HEADER, l->next);
+    p[PKT_HEADER + 4] = l->gap ? NEED_GAP : 0;
+    put32(p + PKT_HEADER + 5, (uint32_t)have);
+    put32(p + PKT_HEADER + 9, (uint32_t)(have >> 32));
+    link_send(l, p, sizeof(p));
+    l->last_alive = now;
+    if (l->gap)
+        l->last_need = now;
+}
+
+/**
+ * @brief Relances de l'abonnement : HELLO tant qu'il manque l'image clé, NEED après un trou ou pour rester inscrit.
+ */
+static void link_maintain(Link *l, double now)
+{
+    if (l->want_key && now - l->last_hello > HELLO_INTERVAL)
+    {
+        uint8_t p[PKT_HEADER];
+        put_header(p, PKT_HELLO);
+        link_send(l, p, sizeof(p));
+        l->last_hello = now;
+        l->last_alive = now;
+    }
+    if (!l->synced)
+        return;
+    if ((l->gap && now - l->last_need > NEED_INTERVAL) || now - l->last_alive > ALIVE_INTERVAL)
+        link_send_need(l, now);
+}
+
+/**
+ * @brief Ajoute un fragment d'image clé.
+ *
+ * @return true si l'image clé est complète.
+ */
+static bool link_key_fragment(Link *l, const uint8_t *p, ssize_t len)
+{
+    if (len < KEY_HEADER)
+        return false;
+    uint32_t seq = get32(p + PKT_HEADER);
+    uint32_t size = get32(p + PKT_HEADER + 15);
+    uint32_t off = get32(p + PKT_HEADER + 19);
+    uint32_t n = (uint32_t)(len - KEY_HEADER);
+    if (size == 0 || size > KEY_MAX || off % BROADCAST_FRAGMENT != 0 || off >= size ||
+        n != (size - off < BROADCAST_FRAGMENT ? size - off : BROADCAST_FRAGMENT))
+        return false;
+
+    KeyFrame *k = &l->key;
+    if (k->seq != seq || k->len != size || !l->key_got)
+    {
+        k->seq = seq;
+        k->len = size;
+        k->tick = get32(p + PKT_HEADER + 4);
+        k->fingerprint = get32(p + PKT_HEADER + 8);
+        k->flags = p[PKT_HEADER + 12];
+        k->bullets = get16(p + PKT_HEADER + 13);
+        l->key_got = 0;
+    }
+    memcpy(k->bytes + off, p + KEY_HEADER, n);
+    l->key_got |= (uint64_t)1 << (off / BROADCAST_FRAGMENT);
+    uint32_t fragments = (size + BROADCAST_FRAGMENT - 1) / BROADCAST_FRAGMENT;
+    uint64_t all = fragments == KEY_FRAGMENTS ? ~(uint64_t)0 : ((uint64_t)1 << fragments) - 1;
+    return l->key_got == all;
+}
+
+/**
+ * @brief Trie un paquet de l'amont.
+ */
+static LinkEvent link_receive(Link *l, const uint8_t *p, ssize_t len, double now)
+{
+    int type = packet_type(p, len);
+    l->last_recv = now;
+    if (type == PKT_BYE)
+        return LINK_END;
+    if (type == PKT_SYNC && len >= PKT_HEADER + 8)
+    {
+        l->sync_seq = get32(p + PKT_HEADER);
+        l->sync_fp = get32(p + PKT_HEADER + 4);
+        return LINK_SYNC;
+    }
+    if (type == PKT_KEY)
+    {
+        // Image clé non demandée : utile seulement si l'amont ne garde plus le paquet attendu
+        if (len >= KEY_HEADER && !l->want_key && !(l->synced && seq_before(l->next, get32(p + PKT_HEADER))))
+            return LINK_NONE;
+        if (!link_key_fragment(l, p, len))
+            return LINK_NONE;
+        l->want_key = false;
+        l->key_got = 0;
+        l->stats->keyframes++;
+        return LINK_KEY;
+    }
+    if (type == PKT_DATA && len >= DATA_HEADER && len >= DATA_HEADER + p[PKT_HEADER + 8] && len <= DATA_MAX)
+    {
+        uint32_t seq = get32(p + PKT_HEADER);
+        if (!l->synced || seq_before(seq, l->next))
+            return LINK_NONE; // Doublon
+        if (seq_before(l->highest, seq))
+            l->highest = seq;
+        if (seq - l->next < LINK_WINDOW)
+        {
+            DataSlot *slot = &l->window[seq % LINK_WINDOW];
+            memcpy(slot->bytes, p, (size_t)len);
+            slot->len = (uint16_t)len;
+        }
+        // Un paquet plus récent que l'attendu : il en manque, demandés tout de suite
+        if (seq != l->next)
+        {
+            l->gap = true;
+            if (now - l->last_need > NEED_INTERVAL)
+                link_send_need(l, now);
+        }
+        return LINK_DATA;
+    }
+    l->stats->rejected++;
+    return LINK_NONE;
+}
+
+/**
+ * @brief Met l'abonnement au paquet qui suit une image clé, et demande les paquets suivants.
+ */
+static void link_start_at(Link *l, uint32_t seq, double now)
+{
+    memset(l->window, 0, sizeof(l->window));
+    l->next = seq;
+    l->highest = seq - 1;
+    l->synced = true;
+    l->gap = true;
+    link_send_need(l, now);
+}
+
+/**
+ * @brief Prochain paquet DATA dans l'ordre, s'il est arrivé.
+ */
+static const DataSlot *link_peek(const Link *l)
+{
+    const DataSlot *slot = &l->window[l->next % LINK_WINDOW];
+    return l->synced && slot->len && get32(slot->bytes + PKT_HEADER) == l->next ? slot : NULL;
+}
+
+/**
+ * @brief Passe au paquet suivant (celui de link_peek est traité).
+ */
+static void link_pop(Link *l)
+{
+    l->window[l->next % LINK_WINDOW].len = 0;
+    l->next++;
+    l->gap = !seq_before(l->highest, l->next);
+}
+
+/**
+ * @brief Attend qu'un des sockets soit lisible, au plus `seconds` secondes.
+ */
+static void wait_readable(int fd1, int fd2, double seconds)
+{
+    if (seconds < 0.0)
+        seconds = 0.0;
+    struct timeval tv;
+    tv.tv_sec = (time_t)seconds;
+    tv.tv_usec = (suseconds_t)((seconds - (double)tv.tv_sec) * 1e6);
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(fd1, &set);
+    if (fd2 >= 0)
+        FD_SET(fd2, &set);
+    (void)select((fd1 > fd2 ? fd1 : fd2) + 1, &set, NULL, NULL, &tv);
+}
+
+// ============================================================================
+//                          5. RELAIS
+// ============================================================================
+
+/**
+ * @brief Fait tourner un relais jusqu'à SIGINT ou au bout de `seconds`.
+ */
+bool broadcast_run_relay(const char *host, int upstream_port, int port, double seconds, BroadcastStats *out)
+{
+    Link link;
+    memset(&link, 0, sizeof(link));
+    link.fd = connect_upstream(host, upstream_port);
+    if (link.fd < 0)
+    {
+        fprintf(stderr, "[ERREUR] Relais : source %s:%d introuvable\n", host, upstream_port);
+        return false;
+    }
+    Broadcast *b = node_open(port, "Relais");
+    if (!b)
+    {
+        close(link.fd);
+        return false;
+    }
+    link.stats = &b->stats;
+    link.want_key = true;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_sigint;
+    sigemptyset(&sa.sa_mask);
+    struct sigaction old_sa;
+    sigaction(SIGINT, &sa, &old_sa);
+    stop_requested = 0;
+
+    printf("[RELAIS] Source %s:%d, abonnes sur le port UDP %d\n", host, upstream_port, port);
+    double start = utils_get_time();
+    link.last_recv = start;
+    bool ended = false;
+    uint8_t p[PKT_MAX];
+    while (!stop_requested && !ended && (seconds <= 0.0 || utils_get_time() - start < seconds))
+    {
+        wait_readable(link.fd, b->fd, 0.05);
+        double now = utils_get_time();
+
+        // --- A. Amont : paquets gardés et recopiés dans l'ordre ---
+        ssize_t len;
+        while (!ended && (len = recv(link.fd, p, sizeof(p), MSG_DONTWAIT)) >= 0)
+        {
+            b->stats.bytes_recv += len;
+            switch (link_receive(&link, p, len, now))
+            {
+            case LINK_DATA:
+            case LINK_NONE:
+                break;
+            case LINK_KEY:
+                b->key = link.key;
+                // Premier abonnement, ou image clé au-delà de l'historique : on repart d'elle
+                if (!link.synced || seq_before(link.key.seq, b->first_seq) || seq_before(b->next_seq, link.key.seq))
+                {
+                    node_reset(b, link.key.seq);
+                    link_start_at(&link, link.key.seq, now);
+                }
+                break;
+            case LINK_SYNC:
+                if (link.sync_seq != b->key.seq)
+                    link.want_key = true;
+                node_send_sync(b, link.sync_seq, link.sync_fp);
+                break;
+            case LINK_END:
+                printf("[RELAIS] Fin de la diffusion\n");
+                ended = true;
+                break;
+            }
+        }
+        const DataSlot *slot;
+        while ((slot = link_peek(&link)))
+        {
+            node_store(b, slot->bytes, slot->len);
+            link_pop(&link);
+        }
+        link_maintain(&link, now);
+
+        // --- B. Abonnés ---
+        node_poll(b);
+
+        if (now - link.last_recv > BROADCAST_TIMEOUT)
+        {
+            fprintf(stderr, "[ERREUR] Relais : la source ne repond plus\n");
+            break;
+        }
+    }
+
+    sigaction(SIGINT, &old_sa, NULL);
+    if (!ended)
+    {
+        uint8_t bye[PKT_HEADER];
+        put_header(bye, PKT_BYE);
+        link_send(&link, bye, sizeof(bye));
+    }
+    close(link.fd);
+    bool ok = link.synced;
+    node_close(b, out);
+    return ok;
+}
+
+// ============================================================================
+//                          6. SPECTATEUR
+// ============================================================================
+
+#define QUEUE_SIZE 65536 ///< Octets d'événements en attente de simulation, au plus (puissance de 2).
+
+/**
+ * @brief Spectateur : abonnement, événements à simuler et vérification des empreintes.
+ */
+typedef struct
+{
+    Link link;                  ///< Abonnement à l'amont.
+    uint8_t queue[QUEUE_SIZE];  ///< Événements reçus, pas encore simulés (file circulaire).
+    uint64_t head;              ///< Octets simulés depuis l'image clé.
+    uint64_t tail;              ///< Octets reçus depuis l'image clé.
+    long long queued_ticks;     ///< Ticks en attente dans la file.
+    bool check;                 ///< Une empreinte attend sa comparaison.
+    bool check_placed;          ///< Sa position dans la file est connue.
+    uint32_t check_seq;         ///< Paquet au début duquel la comparer.
+    uint32_t check_fp;          ///< Empreinte de la source.
+    uint64_t check_pos;         ///< Position du début de ce paquet dans la file.
+    bool playing;               ///< Tampon assez rempli pour jouer au rythme du jeu.
+} Spectator;
+
+/**
+ * @brief Ajoute à la file les événements d'un paquet DATA.
+ *
+ * @return false si la file est pleine (le paquet sera redemandé).
+ */
+static bool spectator_queue(Spectator *sp, const uint8_t *p)
+{
+    uint32_t seq = get32(p + PKT_HEADER);
+    int n = p[PKT_HEADER + 8];
+    if (sp->tail - sp->head + (uint64_t)n > QUEUE_SIZE)
+        return false;
+    if (sp->check && !sp->check_placed && seq == sp->check_seq)
+    {
+        sp->check_pos = sp->tail;
+        sp->check_placed = true;
+    }
+    for (int k = 0; k < n; k++)
+    {
+        uint8_t ev = p[DATA_HEADER + k];
+        sp->queue[sp->tail++ % QUEUE_SIZE] = ev;
+        if (ev & BROADCAST_EV_TICKS)
+            sp->queued_ticks += ev & TICK_RUN_MAX;
+    }
+    return true;
+}
+
+/**
+ * @brief Repart d'une image clé : nouveau modèle au besoin, file vidée.
+ *
+ * @return false si l'instantané est invalide.
+ */
+static bool spectator_load(Spectator *sp, GameModel **model, GameModel **prev, const ViewInterface *view)
+{
+    const KeyFrame *k = &sp->link.key;
+    if (!*model || (*model)->sim.bullets.capacity != k->bullets)
+    {
+        model_free(*model);
+        model_free(*prev);
+        *prev = NULL;
+        if (!model_set_bullet_capacity(k->bullets) || !(*model = model_init()))
+            return false;
+        if (view && view->set_interpolation)
+            *prev = model_clone(*model);
+        if (view && view->audio_events)
+            model_set_audio_sink(*model, view->audio_events());
+    }
+    if (!save_decode_snapshot(*model, k->bytes, k->len))
+        return false;
+    (*model)->sim.fixed_point = (k->flags & KEY_FIXED) != 0;
+    (*model)->sim.swept_bullets = (k->flags & KEY_SWEPT) != 0;
+    if (*prev)
+        model_copy_sim(*prev, *model);
+    sp->head = sp->tail = 0;
+    sp->queued_ticks = 0;
+    sp->check = false;
+    sp->playing = false;
+    return true;
+}
+
+/**
+ * @brief Retour au menu principal, comme le serveur de jeu le fait (net.c).
+ */
+static void spectator_menu(GameModel *model)
+{
+    model->ui.pending_quit = false;
+    model->sim.state = STATE_MENU;
+    model->ui.menu_selection = 0;
+    model_touch(model, MODEL_GEN_MENU);
+}
+
+/**
+ * @brief Simule au plus `ticks` ticks de la file.
+ *
+ * @return false si l'empreinte d'une image clé diffère (désynchronisation).
+ */
+static bool spectator_run(Spectator *sp, GameModel *model, GameModel *prev, long long ticks, BroadcastStats *stats)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    while (sp->head < sp->tail)
+    {
+        if (sp->check && sp->check_placed && sp->head == sp->check_pos)
+        {
+            sp->check = false;
+            stats->checks++;
+            if (save_fingerprint(model) != sp->check_fp)
+            {
+                stats->desyncs++;
+                return false;
+            }
+        }
+        uint8_t *ev = &sp->queue[sp->head % QUEUE_SIZE];
+        if (!(*ev & BROADCAST_EV_TICKS))
+        {
+            if (*ev == BROADCAST_EV_MENU)
+                spectator_menu(model);
+            else if (*ev <= CMD_HELD_P2_LAST)
+                (void)model_dispatch_command(model, (GameCommand)*ev); // La source décide des retours au menu
+            sp->head++;
+            continue;
+        }
+        if (ticks <= 0)
+            break;
+        if (prev)
+            model_copy_sim(prev, model);
+        model_update(model, dt);
+        stats->ticks++;
+        sp->queued_ticks--;
+        ticks--;
+        if ((*ev & TICK_RUN_MAX) > 1)
+            (*ev)--;
+        else
+            sp->head++;
+    }
+    return true;
+}
+
+/**
+ * @brief Regarde une partie diffusée jusqu'à CMD_EXIT.
+ */
+bool broadcast_run_spectator(const char *host, int port, const ViewInterface *view, double seconds,
+                             BroadcastStats *out)
+{
+    Spectator *sp = calloc(1, sizeof(Spectator));
+    if (!sp)
+        return false;
+    BroadcastStats stats;
+    memset(&stats, 0, sizeof(stats));
+    Link *l = &sp->link;
+    l->stats = &stats;
+    l->want_key = true;
+    l->fd = connect_upstream(host, port);
+    if (l->fd < 0)
+    {
+        fprintf(stderr, "[ERREUR] Spectateur : relais %s:%d introuvable\n", host, port);
+        free(sp);
+        return false;
+    }
+
+    GameModel *model = NULL, *prev = NULL;
+    SpscRing *sink = view && view->audio_events ? view->audio_events() : NULL;
+    const double dt = 1.0 / TARGET_FPS;
+    const long long buffer = 2 * BROADCAST_SEND_EVERY; // Tampon visé (ticks)
+    FramePacer pacer;
+    utils_pacer_init(&pacer, TARGET_FPS, view && view->has_vsync && view->has_vsync());
+
+    double start = utils_get_time(), cpu_start = cpu_time();
+    double last = start, accumulator = 0.0;
+    l->last_recv = start;
+    bool running = true, ended = false;
+    uint8_t p[PKT_MAX];
+    while (running && !ended)
+    {
+        double now = utils_get_time();
+        if (seconds > 0.0 && now - start >= seconds)
+            break;
+        if (now - l->last_recv > BROADCAST_TIMEOUT)
+        {
+            fprintf(stderr, "[ERREUR] Spectateur : le relais ne repond plus\n");
+            break;
+        }
+
+        // --- A. Flux reçu ---
+        ssize_t len;
+        while (!ended && (len = recv(l->fd, p, sizeof(p), MSG_DONTWAIT)) >= 0)
+        {
+            stats.bytes_recv += len;
+            switch (link_receive(l, p, len, now))
+            {
+            case LINK_DATA:
+            case LINK_NONE:
+                break;
+            case LINK_KEY:
+                if (!spectator_load(sp, &model, &prev, view))
+                {
+                    stats.rejected++;
+                    l->want_key = true;
+                    break;
+                }
+                link_start_at(l, l->key.seq, now);
+                break;
+            case LINK_SYNC:
+                // Comparée quand la simulation atteindra le début du paquet annoncé
+                if (l->synced && !seq_before(l->sync_seq, l->next))
+                {
+                    sp->check = true;
+                    sp->check_seq = l->sync_seq;
+                    sp->check_fp = l->sync_fp;
+                    sp->check_placed = l->sync_seq == l->next;
+                    sp->check_pos = sp->tail;
+                }
+                break;
+            case LINK_END:
+                printf("[SPECTATEUR] Fin de la diffusion\n");
+                ended = true;
+                break;
+            }
+        }
+        // File pleine : les paquets attendent dans la fenêtre de l'abonnement
+        const DataSlot *slot;
+        while ((slot = link_peek(l)) && spectator_queue(sp, slot->bytes))
+        {
+            link_pop(l);
+            stats.packets++;
+        }
+        link_maintain(l, now);
+
+        // --- B. Simulation au rythme du jeu, rattrapage d'un coup au-delà du tampon ---
+        double frame_time = now - last;
+        last = now;
+        if (model && l->synced)
+        {
+            accumulator += frame_time > 0.25 ? 0.25 : frame_time;
+            if (sp->queued_ticks == 0)
+                sp->playing = false;
+            else if (sp->queued_ticks >= buffer)
+                sp->playing = true;
+            long long due = sp->playing ? (long long)(accumulator / dt) : 0;
+            accumulator -= (double)due * dt;
+            if (!sp->playing)
+                accumulator = 0.0;
+            if (sp->queued_ticks - due > 4 * buffer)
+            {
+                model_set_audio_sink(model, NULL);
+                due = sp->queued_ticks - buffer;
+            }
+            bool in_sync = spectator_run(sp, model, prev, due, &stats);
+            model_set_audio_sink(model, sink);
+            if (!in_sync)
+            {
+                printf("[SPECTATEUR] Empreinte differente au paquet %u : retour a l'image cle\n",
+                       (unsigned)sp->check_seq);
+                l->synced = false;
+                l->want_key = true;
+            }
+        }
+
+        // --- C. Entrées (seule la sortie compte) et rendu ---
+        if (view && model)
+        {
+            CommandQueue input;
+            command_queue_clear(&input);
+            view->get_input(model, &input);
+            GameCommand cmd;
+            while (command_queue_pop(&input, HUGE_VAL, &cmd))
+                if (cmd == CMD_EXIT)
+                    running = false;
+            if (prev)
+                view->set_interpolation(prev, (float)(accumulator / dt));
+            view->render(model);
+        }
+        if (!view)
+            wait_readable(l->fd, -1, 1.0 / TARGET_FPS);
+        else
+            utils_pacer_wait(&pacer);
+    }
+
+    if (!ended)
+    {
+        uint8_t bye[PKT_HEADER];
+        put_header(bye, PKT_BYE);
+        for (int i = 0; i < 3; i++)
+            link_send(l, bye, sizeof(bye));
+    }
+    close(l->fd);
+    stats.elapsed = utils_get_time() - start;
+    stats.cpu = cpu_time() - cpu_start;
+    bool ok = model != NULL;
+    if (model)
+        stats.fingerprint = save_fingerprint(model);
+    if (out)
+        *out = stats;
+    model_free(prev);
+    model_free(model);
+    free(sp);
+    return ok;
+}
+
+// ============================================================================
+//                          7. BILAN
+// ============================================================================
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ */
+void broadcast_print_stats(const BroadcastStats *stats, const char *label)
+{
+    double secs = stats->elapsed > 0.0 ? stats->elapsed : 1.0;
+    printf("[%s] Duree : %.1f s, processeur : %.2f s (%.1f %%)\n", label, stats->elapsed, stats->cpu,
+           100.0 * stats->cpu / secs);
+    printf("[%s] Paquets : %lld, images cles : %lld, repetes : %lld, images cles envoyees : %lld, ignores : %lld\n",
+           label, stats->packets, stats->keyframes, stats->resent, stats->keys_sent, stats->rejected);
+    if (stats->max_subscribers)
+        printf("[%s] Abonnes : %d (au plus %d)\n", label, stats->subscribers, stats->max_subscribers);
+    printf("[%s] Debit : %.0f octets/s envoyes, %.0f octets/s recus\n", label, stats->bytes_sent / secs,
+           stats->bytes_recv / secs);
+    if (stats->ticks)
+        printf("[%s] Ticks simules : %lld, empreintes comparees : %lld, desynchronisations : %lld, empreinte 0x%08x\n",
+               label, stats->ticks, stats->checks, stats->desyncs, (unsigned)stats->fingerprint);
+}
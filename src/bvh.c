@@ -0,0 +1,160 @@
+/**
+ * @file bvh.c
+ * @brief Implémentation de la hiérarchie de volumes englobants (construction, remise à jour, requête).
+ */
+
+#include "bvh.h"
+
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Plus petite boîte qui contient `a` et `b`.
+ */
+static BvhBox box_union(BvhBox a, BvhBox b)
+{
+    return (BvhBox){a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0,
+                    a.x1 > b.x1 ? a.x1 : b.x1, a.y1 > b.y1 ? a.y1 : b.y1};
+}
+
+/**
+ * @brief Centre d'une boîte sur un axe, au double (évite une division).
+ */
+static float box_center2(BvhBox b, int axis)
+{
+    return axis ? b.y0 + b.y1 : b.x0 + b.x1;
+}
+
+/**
+ * @brief Range les pièces `order[from .. to)` sous le nœud `node` (déjà alloué).
+ *
+ * Tri par insertion sur le centre (quelques dizaines de pièces), à égalité
+ * par index : l'arbre ne dépend que des boîtes. Les deux moitiés prennent
+ * deux nœuds consécutifs.
+ */
+static void build_range(Bvh *bvh, const BvhBox *boxes, int8_t *order, int from, int to, int node)
+{
+    BvhNode *nd = &bvh->nodes[node];
+    if (to - from == 1)
+    {
+        nd->child = 0;
+        nd->leaf = order[from];
+        nd->box = boxes[order[from]];
+        bvh->leaf_node[order[from]] = (int8_t)node;
+        return;
+    }
+
+    // Axe le plus long de la boîte des centres
+    BvhBox c = BVH_EMPTY;
+    for (int k = from; k < to; k++)
+    {
+        float cx = box_center2(boxes[order[k]], 0), cy = box_center2(boxes[order[k]], 1);
+        c = box_union(c, (BvhBox){cx, cy, cx, cy});
+    }
+    int axis = (c.y1 - c.y0) > (c.x1 - c.x0);
+
+    for (int k = from + 1; k < to; k++)
+    {
+        int8_t v = order[k];
+        float key = box_center2(boxes[v], axis);
+        int j = k - 1;
+        while (j >= from && (box_center2(boxes[order[j]], axis) > key ||
+                             (box_center2(boxes[order[j]], axis) == key && order[j] > v)))
+        {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = v;
+    }
+
+    int mid = (from + to) / 2;
+    int child = bvh->count;
+    bvh->count += 2;
+    nd->child = (int8_t)child;
+    nd->leaf = -1;
+    bvh->nodes[child].parent = bvh->nodes[child + 1].parent = (int8_t)node;
+    build_range(bvh, boxes, order, from, mid, child);
+    build_range(bvh, boxes, order, mid, to, child + 1);
+    nd->box = box_union(bvh->nodes[child].box, bvh->nodes[child + 1].box);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Racine en 0, puis les enfants par paires, en profondeur d'abord.
+ */
+void bvh_build(Bvh *bvh, const BvhBox *boxes, int n)
+{
+    memset(bvh, 0, sizeof(Bvh));
+    if (n > BVH_MAX_LEAVES)
+        n = BVH_MAX_LEAVES;
+    if (n <= 0)
+        return;
+    int8_t order[BVH_MAX_LEAVES];
+    for (int k = 0; k < n; k++)
+        order[k] = (int8_t)k;
+    bvh->leaves = (int8_t)n;
+    bvh->count = 1;
+    bvh->nodes[0].parent = -1;
+    build_range(bvh, boxes, order, 0, n, 0);
+}
+
+/**
+ * @brief Feuille changée, puis union des deux enfants de chaque ancêtre, tant qu'elle change.
+ */
+void bvh_set_leaf(Bvh *bvh, int leaf, BvhBox box)
+{
+    if (leaf < 0 || leaf >= bvh->leaves)
+        return;
+    int node = bvh->leaf_node[leaf];
+    bvh->nodes[node].box = box;
+    for (node = bvh->nodes[node].parent; node >= 0; node = bvh->nodes[node].parent)
+    {
+        BvhNode *nd = &bvh->nodes[node];
+        BvhBox u = box_union(bvh->nodes[nd->child].box, bvh->nodes[nd->child + 1].box);
+        if (memcmp(&u, &nd->box, sizeof(BvhBox)) == 0)
+            break;
+        nd->box = u;
+        bvh->refits++;
+    }
+}
+
+/**
+ * @brief Boîte de la racine.
+ */
+BvhBox bvh_bounds(const Bvh *bvh)
+{
+    return bvh->count > 0 ? bvh->nodes[0].box : BVH_EMPTY;
+}
+
+/**
+ * @brief Parcours en profondeur sur une pile : un sous-arbre que la boîte ne chevauche pas n'est pas visité.
+ */
+int bvh_query(const Bvh *bvh, BvhBox box, int8_t *out, int max_out)
+{
+    if (bvh->count == 0)
+        return 0;
+    int8_t stack[BVH_MAX_DEPTH];
+    int top = 0, n = 0;
+    stack[top++] = 0;
+    while (top > 0 && n < max_out)
+    {
+        const BvhNode *nd = &bvh->nodes[stack[--top]];
+        if (!bvh_overlap(nd->box, box))
+            continue;
+        if (nd->leaf >= 0)
+            out[n++] = nd->leaf;
+        else
+        {
+            // Second enfant empilé d'abord : les pièces sortent dans l'ordre de l'arbre
+            stack[top++] = (int8_t)(nd->child + 1);
+            stack[top++] = nd->child;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file capture.c
+ * @brief Implémentation du thread d'encodage de la capture vidéo (YUV4MPEG2).
+ */
+
+#include "capture.h"
+#include "spsc.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. ÉTAT PARTAGÉ
+// ============================================================================
+
+static FILE *out = NULL;
+static int width = 0, height = 0;
+static SDL_Thread *encoder = NULL;
+static SDL_Semaphore *wake = NULL; ///< Une image de plus dans la file, ou l'arrêt.
+static int stop_requested = 0;     ///< Atomique.
+
+static SpscRing ring;                          ///< Vue -> encodeur.
+static SDL_Surface *ring_items[CAPTURE_QUEUE]; ///< Stockage de la file.
+static int queued = 0;                         ///< Images confiées, pas encore écrites (atomique).
+
+static uint64_t written = 0; ///< Thread d'encodage.
+static uint64_t dropped = 0; ///< Atomique (Vue et encodeur).
+static double encode_s = 0.0;
+
+static uint8_t *planes = NULL; ///< Y, puis U et V d'une image (thread d'encodage).
+
+// ============================================================================
+//                          2. THREAD D'ENCODAGE
+// ============================================================================
+
+/**
+ * @brief Convertit une image RGBA en YUV 4:2:0 (BT.601, pleine échelle), chrominance moyennée par blocs 2x2.
+ */
+static void to_yuv420(const uint8_t *px, int pitch)
+{
+    uint8_t *y = planes, *u = planes + width * height, *v = u + (width / 2) * (height / 2);
+    for (int j = 0; j < height; j++)
+    {
+        const uint8_t *row = px + (size_t)j * pitch;
+        for (int i = 0; i < width; i++)
+        {
+            const uint8_t *p = row + i * 4;
+            y[j * width + i] = (uint8_t)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+    for (int j = 0; j < height / 2; j++)
+    {
+        const uint8_t *r0 = px + (size_t)(2 * j) * pitch, *r1 = r0 + pitch;
+        for (int i = 0; i < width / 2; i++)
+        {
+            const uint8_t *a = r0 + i * 8, *b = r1 + i * 8;
+            int r = a[0] + a[4] + b[0] + b[4], g = a[1] + a[5] + b[1] + b[5], bl = a[2] + a[6] + b[2] + b[6];
+            u[j * (width / 2) + i] = (uint8_t)(128 + ((-43 * r - 85 * g + 128 * bl) >> 10));
+            v[j * (width / 2) + i] = (uint8_t)(128 + ((128 * r - 107 * g - 21 * bl) >> 10));
+        }
+    }
+}
+
+/**
+ * @brief Écrit une image (convertie en RGBA au besoin), puis libère la surface.
+ */
+static void encode(SDL_Surface *s)
+{
+    double t0 = utils_get_time();
+    SDL_Surface *rgba = s->format == SDL_PIXELFORMAT_RGBA32 ? s : SDL_ConvertSurface(s, SDL_PIXELFORMAT_RGBA32);
+    bool ok = rgba && rgba->w >= width && rgba->h >= height;
+    if (ok)
+    {
+        to_yuv420(rgba->pixels, rgba->pitch);
+        size_t n = (size_t)width * height * 3 / 2;
+        ok = fputs("FRAME\n", out) >= 0 && fwrite(planes, 1, n, out) == n;
+    }
+    if (ok)
+        written++;
+    else
+        __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+    if (rgba != s)
+        SDL_DestroySurface(rgba);
+    SDL_DestroySurface(s);
+    encode_s += utils_get_time() - t0;
+}
+
+/**
+ * @brief Boucle du thread : une image par réveil, jusqu'à l'arrêt et la file vide.
+ */
+static int SDLCALL capture_main(void *data)
+{
+    (void)data;
+    while (true)
+    {
+        SDL_WaitSemaphore(wake);
+        SDL_Surface *s;
+        if (spsc_pop(&ring, &s))
+        {
+            encode(s);
+            __atomic_fetch_sub(&queued, 1, __ATOMIC_RELEASE);
+        }
+        else if (__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE))
+            break;
+    }
+    return 0;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief En-tête YUV4MPEG2, file vide, puis le thread.
+ */
+bool capture_open(const char *path, int w, int h, int fps)
+{
+    capture_close(NULL);
+    width = w & ~1;
+    height = h & ~1;
+    if (width <= 0 || height <= 0)
+        return false;
+    planes = malloc((size_t)width * height * 3 / 2);
+    out = planes ? fopen(path, "wb") : NULL;
+    if (!out)
+    {
+        free(planes);
+        planes = NULL;
+        return false;
+    }
+    fprintf(out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+
+    spsc_init(&ring, ring_items, sizeof(SDL_Surface *), CAPTURE_QUEUE);
+    queued = 0;
+    written = dropped = 0;
+    encode_s = 0.0;
+    stop_requested = 0;
+    wake = SDL_CreateSemaphore(0);
+    encoder = wake ? SDL_CreateThread(capture_main, "capture", NULL) : NULL;
+    if (!encoder)
+    {
+        SDL_DestroySemaphore(wake);
+        wake = NULL;
+        fclose(out);
+        out = NULL;
+        free(planes);
+        planes = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Une place dans la file (le compteur inclut l'image en cours d'encodage).
+ */
+bool capture_ready(void)
+{
+    return encoder && __atomic_load_n(&queued, __ATOMIC_ACQUIRE) < CAPTURE_QUEUE;
+}
+
+/**
+ * @brief Poussée dans la file SPSC, puis réveil de l'encodeur (jamais bloquant).
+ */
+bool capture_submit(SDL_Surface *surface)
+{
+    if (!encoder || !surface || !capture_ready() || !spsc_push(&ring, &surface))
+    {
+        SDL_DestroySurface(surface);
+        capture_drop();
+        return false;
+    }
+    __atomic_fetch_add(&queued, 1, __ATOMIC_RELEASE);
+    SDL_SignalSemaphore(wake);
+    return true;
+}
+
+/**
+ * @brief Compteur partagé avec l'encodeur (écritures échouées).
+ */
+void capture_drop(void)
+{
+    __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Lecture atomique du compteur.
+ */
+uint64_t capture_dropped(void)
+{
+    return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Arrêt signalé après les images en attente : le thread les écrit toutes avant de sortir.
+ */
+void capture_close(CaptureStats *stats)
+{
+    if (encoder)
+    {
+        __atomic_store_n(&stop_requested, 1, __ATOMIC_RELEASE);
+        SDL_SignalSemaphore(wake);
+        SDL_WaitThread(encoder, NULL);
+        encoder = NULL;
+        SDL_DestroySemaphore(wake);
+        wake = NULL;
+    }
+    if (out)
+        fclose(out);
+    out = NULL;
+    free(planes);
+    planes = NULL;
+    if (stats)
+    {
+        stats->written = written;
+        stats->dropped = capture_dropped();
+        stats->encode_s = encode_s;
+    }
+}
@@ -0,0 +1,508 @@
+/**
+ * @file codec.c
+ * @brief Implémentation du codec LZ par blocs et des flux compressés.
+ */
+
+#include "codec.h"
+
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define MIN_MATCH 4      ///< Longueur minimale d'une copie.
+#define MAX_OFFSET 65535 ///< Distance maximale d'une copie (u16).
+#define HASH_BITS 12     ///< Taille de la table de recherche (4096 entrées).
+
+/** @brief Lit 4 octets (sans contrainte d'alignement). */
+static uint32_t read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/** @brief Hachage multiplicatif des 4 prochains octets. */
+static uint32_t hash4(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/** @brief Écrit un entier 32 bits little-endian. */
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/** @brief Lit un entier 32 bits little-endian. */
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** @brief Écrit le complément d'une longueur ≥ 15 (octets de 255, puis le reste). */
+static bool put_length(uint8_t *dst, size_t *op, size_t cap, size_t v)
+{
+    for (; v >= 255; v -= 255)
+    {
+        if (*op >= cap)
+            return false;
+        dst[(*op)++] = 255;
+    }
+    if (*op >= cap)
+        return false;
+    dst[(*op)++] = (uint8_t)v;
+    return true;
+}
+
+/** @brief Lit le complément d'une longueur (cf. put_length). */
+static bool get_length(const uint8_t *src, size_t n, size_t *ip, size_t *v)
+{
+    uint8_t b;
+    do
+    {
+        if (*ip >= n)
+            return false;
+        b = src[(*ip)++];
+        *v += b;
+    } while (b == 255);
+    return true;
+}
+
+/**
+ * @brief Écrit une séquence : littéraux, puis copie (match_len == 0 : dernière séquence).
+ */
+static bool put_sequence(uint8_t *dst, size_t *op, size_t cap,
+                         const uint8_t *lit, size_t lit_len, size_t offset, size_t match_len)
+{
+    size_t ml = match_len ? match_len - MIN_MATCH : 0;
+    if (*op >= cap)
+        return false;
+    dst[(*op)++] = (uint8_t)(((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+    if (lit_len >= 15 && !put_length(dst, op, cap, lit_len - 15))
+        return false;
+
+    if (lit_len > cap - *op)
+        return false;
+    memcpy(dst + *op, lit, lit_len);
+    *op += lit_len;
+
+    if (!match_len)
+        return true;
+    if (cap - *op < 2)
+        return false;
+    dst[(*op)++] = (uint8_t)offset;
+    dst[(*op)++] = (uint8_t)(offset >> 8);
+    return ml < 15 || put_length(dst, op, cap, ml - 15);
+}
+
+// ============================================================================
+//                          2. COMPRESSION D'UN BLOC
+// ============================================================================
+
+/**
+ * @brief Compresse un bloc.
+ *
+ * Recherche gloutonne : une table de hachage garde la dernière position de
+ * chaque suite de 4 octets, et chaque correspondance est étendue au maximum.
+ */
+size_t codec_compress(const uint8_t *src, size_t n, uint8_t *dst, size_t cap)
+{
+    uint16_t table[1u << HASH_BITS];
+    memset(table, 0, sizeof(table));
+    if (n > CODEC_BLOCK_SIZE)
+        return 0;
+
+    size_t ip = 0, anchor = 0, op = 0;
+    while (ip + MIN_MATCH <= n)
+    {
+        uint32_t seq = read32(src + ip);
+        uint32_t h = hash4(seq);
+        size_t candidate = table[h];
+        table[h] = (uint16_t)ip;
+
+        if (candidate >= ip || ip - candidate > MAX_OFFSET || read32(src + candidate) != seq)
+        {
+            ip++;
+            continue;
+        }
+
+        size_t len = MIN_MATCH;
+        while (ip + len < n && src[candidate + len] == src[ip + len])
+            len++;
+        if (!put_sequence(dst, &op, cap, src + anchor, ip - anchor, ip - candidate, len))
+            return 0;
+        ip += len;
+        anchor = ip;
+    }
+
+    // Dernière séquence : les littéraux restants, sans copie
+    if (!put_sequence(dst, &op, cap, src + anchor, n - anchor, 0, 0))
+        return 0;
+    return op;
+}
+
+/**
+ * @brief Décompresse un bloc produit par codec_compress.
+ */
+bool codec_decompress(const uint8_t *src, size_t n, uint8_t *dst, size_t cap, size_t *out)
+{
+    size_t ip = 0, op = 0;
+    while (ip < n)
+    {
+        uint8_t token = src[ip++];
+
+        size_t lit_len = token >> 4;
+        if (lit_len == 15 && !get_length(src, n, &ip, &lit_len))
+            return false;
+        if (lit_len > n - ip || lit_len > cap - op)
+            return false;
+        memcpy(dst + op, src + ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        if (ip == n)
+            break; // Dernière séquence : pas de copie
+
+        if (n - ip < 2)
+            return false;
+        size_t offset = src[ip] | ((size_t)src[ip + 1] << 8);
+        ip += 2;
+        size_t match_len = token & 0x0F;
+        if (match_len == 15 && !get_length(src, n, &ip, &match_len))
+            return false;
+        match_len += MIN_MATCH;
+        if (offset == 0 || offset > op || match_len > cap - op)
+            return false;
+
+        // Copie octet par octet : la source peut chevaucher la destination (répétitions)
+        const uint8_t *from = dst + op - offset;
+        for (size_t k = 0; k < match_len; k++)
+            dst[op + k] = from[k];
+        op += match_len;
+    }
+    *out = op;
+    return true;
+}
+
+// ============================================================================
+//                          3. ÉCRITURE D'UN FLUX
+// ============================================================================
+
+/**
+ * @brief Prépare l'écriture d'un flux à la position courante du fichier.
+ */
+void codec_writer_init(CodecWriter *w, FILE *file, bool compress)
+{
+    w->file = file;
+    w->compress = compress;
+    w->len = 0;
+}
+
+/**
+ * @brief Ajoute des octets au flux.
+ */
+void codec_writer_write(CodecWriter *w, const void *data, size_t n)
+{
+    if (!w->compress)
+    {
+        fwrite(data, 1, n, w->file);
+        return;
+    }
+
+    const uint8_t *p = data;
+    while (n > 0)
+    {
+        size_t room = CODEC_BLOCK_SIZE - w->len;
+        size_t take = n < room ? n : room;
+        memcpy(w->block + w->len, p, take);
+        w->len += take;
+        p += take;
+        n -= take;
+        if (w->len == CODEC_BLOCK_SIZE)
+            codec_writer_flush(w);
+    }
+}
+
+/**
+ * @brief Ajoute un octet au flux.
+ */
+void codec_writer_putc(CodecWriter *w, uint8_t byte)
+{
+    if (!w->compress)
+    {
+        fputc(byte, w->file);
+        return;
+    }
+    w->block[w->len++] = byte;
+    if (w->len == CODEC_BLOCK_SIZE)
+        codec_writer_flush(w);
+}
+
+/**
+ * @brief Termine le bloc en cours et l'écrit.
+ *
+ * Un bloc qui ne rétrécit pas est écrit tel quel (bit CODEC_BLOCK_STORED).
+ */
+void codec_writer_flush(CodecWriter *w)
+{
+    if (!w->compress || w->len == 0)
+        return;
+
+    uint8_t header[CODEC_BLOCK_HEADER_SIZE];
+    size_t packed = codec_compress(w->block, w->len, w->packed, sizeof(w->packed));
+    put_le32(header, (uint32_t)w->len);
+    if (packed == 0 || packed >= w->len)
+    {
+        put_le32(header + 4, (uint32_t)w->len | CODEC_BLOCK_STORED);
+        fwrite(header, 1, sizeof(header), w->file);
+        fwrite(w->block, 1, w->len, w->file);
+    }
+    else
+    {
+        put_le32(header + 4, (uint32_t)packed);
+        fwrite(header, 1, sizeof(header), w->file);
+        fwrite(w->packed, 1, packed, w->file);
+    }
+    w->len = 0;
+}
+
+/**
+ * @brief Termine le bloc en cours et renvoie la position du prochain octet.
+ */
+long codec_writer_mark(CodecWriter *w)
+{
+    codec_writer_flush(w);
+    return ftell(w->file);
+}
+
+// ============================================================================
+//                          4. LECTURE D'UN FLUX
+// ============================================================================
+
+/**
+ * @brief Charge le bloc suivant dans le buffer du lecteur.
+ * @return false en fin de flux (ou sur un bloc invalide : r->error).
+ */
+static bool load_block(CodecReader *r)
+{
+    long at = r->next_offset;
+    r->pos = r->len = 0;
+    r->block_offset = at;
+    if (r->end >= 0 && at >= r->end)
+        return false;
+
+    if (!r->compressed)
+    {
+        size_t want = CODEC_BLOCK_SIZE;
+        if (r->end >= 0 && (long)want > r->end - at)
+            want = (size_t)(r->end - at);
+        r->len = fread(r->block, 1, want, r->file);
+        r->next_offset = at + (long)r->len;
+        return r->len > 0;
+    }
+
+    uint8_t header[CODEC_BLOCK_HEADER_SIZE];
+    size_t got = fread(header, 1, sizeof(header), r->file);
+    if (got == 0)
+        return false;
+    uint32_t raw = get_le32(header);
+    uint32_t stored = get_le32(header + 4);
+    bool is_raw = (stored & CODEC_BLOCK_STORED) != 0;
+    size_t size = stored & ~CODEC_BLOCK_STORED;
+    if (got < sizeof(header) || raw > CODEC_BLOCK_SIZE || size > sizeof(r->packed) ||
+        (is_raw && size != raw) ||
+        (r->end >= 0 && (long)(sizeof(header) + size) > r->end - at))
+    {
+        r->error = true;
+        return false;
+    }
+
+    size_t out = raw;
+    if (is_raw)
+    {
+        if (fread(r->block, 1, size, r->file) != size)
+            r->error = true;
+    }
+    else if (fread(r->packed, 1, size, r->file) != size ||
+             !codec_decompress(r->packed, size, r->block, sizeof(r->block), &out) || out != raw)
+    {
+        r->error = true;
+    }
+    if (r->error)
+        return false;
+
+    r->len = raw;
+    r->next_offset = at + (long)(sizeof(header) + size);
+    return true;
+}
+
+/**
+ * @brief Prépare la lecture d'un flux.
+ */
+void codec_reader_init(CodecReader *r, FILE *file, bool compressed, long start, long end)
+{
+    r->file = file;
+    r->compressed = compressed;
+    r->end = end;
+    r->error = false;
+    codec_reader_seek(r, start);
+}
+
+/**
+ * @brief Lit jusqu'à `n` octets du flux.
+ */
+size_t codec_reader_read(CodecReader *r, void *dst, size_t n)
+{
+    uint8_t *p = dst;
+    size_t done = 0;
+    while (done < n)
+    {
+        if (r->pos == r->len && !load_block(r))
+            break;
+        size_t avail = r->len - r->pos;
+        size_t take = (n - done) < avail ? (n - done) : avail;
+        memcpy(p + done, r->block + r->pos, take);
+        r->pos += take;
+        done += take;
+    }
+    return done;
+}
+
+/**
+ * @brief Lit un octet du flux.
+ */
+int codec_reader_getc(CodecReader *r)
+{
+    if (r->pos == r->len && !load_block(r))
+        return -1;
+    return r->block[r->pos++];
+}
+
+/**
+ * @brief Position du prochain octet, si c'est un point de reprise.
+ */
+long codec_reader_mark(const CodecReader *r)
+{
+    if (!r->compressed)
+        return r->block_offset + (long)r->pos;
+    if (r->pos == r->len)
+        return r->next_offset;
+    return r->pos == 0 ? r->block_offset : -1;
+}
+
+/**
+ * @brief Repositionne la lecture sur un point de reprise (cf. codec_writer_mark).
+ */
+bool codec_reader_seek(CodecReader *r, long offset)
+{
+    r->pos = r->len = 0;
+    r->block_offset = r->next_offset = offset;
+    return fseek(r->file, offset, SEEK_SET) == 0;
+}
+
+// ============================================================================
+//                          5. DELTAS D'OCTETS
+// ============================================================================
+
+/** @brief Plus petit écart entre deux plages d'un delta (en deçà, elles sont fusionnées). */
+#define DIFF_MIN_GAP 8
+
+/** @brief Écrit un varint (7 bits par octet) ; false si le buffer est plein. */
+static bool diff_put_varint(uint8_t *buf, size_t cap, size_t *pos, size_t v)
+{
+    do
+    {
+        if (*pos >= cap)
+            return false;
+        buf[(*pos)++] = (uint8_t)((v & 0x7F) | (v >= 0x80 ? 0x80 : 0));
+        v >>= 7;
+    } while (v);
+    return true;
+}
+
+/** @brief Lit un varint ; false si le delta s'arrête au milieu. */
+static bool diff_get_varint(const uint8_t *buf, size_t len, size_t *pos, size_t *v)
+{
+    *v = 0;
+    for (int shift = 0; shift < 35 && *pos < len; shift += 7)
+    {
+        uint8_t b = buf[(*pos)++];
+        *v |= (size_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Encode les octets qui diffèrent entre deux buffers de même taille.
+ */
+bool codec_diff(const void *from, const void *to, size_t n, uint8_t *buf, size_t cap, size_t *len)
+{
+    const uint8_t *a = (const uint8_t *)from;
+    const uint8_t *b = (const uint8_t *)to;
+    size_t i = 0, last = 0, out = 0;
+
+    while (i < n)
+    {
+        if (a[i] == b[i])
+        {
+            i++;
+            continue;
+        }
+
+        // Étend la plage tant que l'écart jusqu'au prochain octet différent est court
+        size_t start = i, end = i + 1;
+        for (size_t k = end; k < n && k - end < DIFF_MIN_GAP; k++)
+            if (a[k] != b[k])
+                end = k + 1;
+
+        size_t run = end - start;
+        if (!diff_put_varint(buf, cap, &out, start - last) || !diff_put_varint(buf, cap, &out, run) ||
+            run > cap - out)
+            return false;
+        memcpy(buf + out, b + start, run);
+        out += run;
+        last = i = end;
+    }
+    *len = out;
+    return true;
+}
+
+/**
+ * @brief Parcourt un delta sur `n` octets ; avec `dst == NULL`, le valide seulement.
+ */
+static bool diff_walk(uint8_t *dst, size_t n, const uint8_t *diff, size_t len)
+{
+    size_t pos = 0, at = 0;
+    while (pos < len)
+    {
+        size_t skip, run;
+        if (!diff_get_varint(diff, len, &pos, &skip) || !diff_get_varint(diff, len, &pos, &run))
+            return false;
+        if (skip > n - at || run > n - at - skip || run > len - pos)
+            return false;
+        at += skip;
+        if (dst)
+            memcpy(dst + at, diff + pos, run);
+        at += run;
+        pos += run;
+    }
+    return true;
+}
+
+/**
+ * @brief Applique à `dst` un delta produit par codec_diff depuis ce même contenu.
+ */
+bool codec_apply_diff(void *dst, size_t n, const uint8_t *diff, size_t len)
+{
+    if (!diff_walk(NULL, n, diff, len))
+        return false;
+    diff_walk((uint8_t *)dst, n, diff, len);
+    return true;
+}
@@ -0,0 +1,453 @@
+/**
+ * @file collision.c
+ * @brief Implémentation de la grille uniforme de collisions (Broad Phase).
+ */
+
+#include "collision.h"
+#include "simd.h"
+
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Convertit une coordonnée logique en index de cellule, borné à la grille.
+ *
+ * Les entités qui débordent du terrain (balles hors écran, OVNI en approche)
+ * sont rabattues sur la cellule du bord : le résultat reste conservatif.
+ */
+static int cell_index(float v, int max_cells)
+{
+    int c = (int)(v * (1.0f / GRID_CELL_SIZE));
+    if (v < 0)
+        c = 0;
+    if (c >= max_cells)
+        c = max_cells - 1;
+    return c;
+}
+
+/**
+ * @brief Calcule la plage de cellules [c0, c1] × [r0, r1] recouverte par une boîte.
+ */
+static void cell_range(float x, float y, float w, float h, int *c0, int *c1, int *r0, int *r1)
+{
+    *c0 = cell_index(x, GRID_COLS);
+    *c1 = cell_index(x + w, GRID_COLS);
+    *r0 = cell_index(y, GRID_ROWS);
+    *r1 = cell_index(y + h, GRID_ROWS);
+}
+
+/**
+ * @brief Indique si une entité doit être rangée dans la grille.
+ */
+static bool is_collidable(const Entity *e)
+{
+    return e->active && !e->exploding;
+}
+
+/**
+ * @brief Vrai si les deux boîtes se chevauchent.
+ */
+static bool boxes_overlap(float ax, float ay, float aw, float ah, const AabbBox *b)
+{
+    return ax < b->x + b->w && ax + aw > b->x && ay < b->y + b->h && ay + ah > b->y;
+}
+
+/**
+ * @brief Ordre des listes balayées : x croissant, puis index croissant à x égal.
+ *
+ * L'ordre est total : la liste triée ne dépend que des positions, pas de
+ * l'historique des mises à jour (les couples sortent toujours dans le même ordre).
+ */
+static bool x_before(const float *xs, int a, int b)
+{
+    return xs[a] < xs[b] || (xs[a] == xs[b] && a < b);
+}
+
+/**
+ * @brief Trie des index de balles dans l'ordre de x_before (tri de Shell, sur place).
+ */
+static void sort_by_x(short *idx, int n, const float *xs)
+{
+    static const int gaps[] = {701, 301, 132, 57, 23, 10, 4, 1};
+    for (int g = 0; g < (int)(sizeof(gaps) / sizeof(gaps[0])); g++)
+    {
+        int gap = gaps[g];
+        for (int k = gap; k < n; k++)
+        {
+            short i = idx[k];
+            int j = k;
+            for (; j >= gap && x_before(xs, i, idx[j - gap]); j -= gap)
+                idx[j] = idx[j - gap];
+            idx[j] = i;
+        }
+    }
+}
+
+/**
+ * @brief Broad phase par grille : une requête par balle, doublons écartés.
+ *
+ * Une cible qui partage deux cellules avec la balle revient deux fois dans les
+ * candidats : seule sa première occurrence est gardée.
+ */
+static int grid_pairs(BroadPhaseState *bp, const float *xs, const float *ys, float w, float h,
+                      const short *live, int n_live, const Entity *targets, int n_targets,
+                      CollisionPair *out, int max_out)
+{
+    short cand[GRID_MAX_ITEMS];
+    int found = 0;
+
+    grid_build(&bp->grid, targets, n_targets);
+    for (int k = 0; k < n_live; k++)
+    {
+        int i = live[k];
+        int n = grid_query(&bp->grid, xs[i], ys[i], w, h, cand, GRID_MAX_ITEMS);
+        for (int c = 0; c < n; c++)
+        {
+            int d = 0;
+            while (d < c && cand[d] != cand[c])
+                d++;
+            const Entity *e = &targets[cand[c]];
+            AabbBox box = {e->x, e->y, e->width, e->height};
+            if (d < c || !boxes_overlap(xs[i], ys[i], w, h, &box))
+                continue;
+            if (found >= max_out)
+                return found;
+            out[found++] = (CollisionPair){(short)i, cand[c]};
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Broad phase par balayage : les deux listes triées sur X, parcourues ensemble.
+ *
+ * Les balles sont visitées par x croissant ; `first` avance sur les cibles
+ * dont le bord droit (au plus x + largeur maximale) est déjà dépassé. Seules
+ * les cibles dont l'intervalle X chevauche celui de la balle sont testées en Y.
+ */
+static int sweep_pairs(BroadPhaseState *bp, const float *xs, const float *ys, float w, float h,
+                       const Entity *targets, int n_targets, CollisionPair *out, int max_out)
+{
+    // Cibles touchables, triées par insertion (les rangées de la vague le sont déjà presque)
+    int m = 0;
+    float max_w = 0.0f;
+    for (int t = 0; t < n_targets && m < MAX_ENEMIES; t++)
+    {
+        const Entity *e = &targets[t];
+        if (!is_collidable(e))
+            continue;
+        AabbBox box = {e->x, e->y, e->width, e->height};
+        int j = m++;
+        while (j > 0 && bp->boxes[j - 1].x > box.x)
+        {
+            bp->boxes[j] = bp->boxes[j - 1];
+            bp->box_target[j] = bp->box_target[j - 1];
+            j--;
+        }
+        bp->boxes[j] = box;
+        bp->box_target[j] = (short)t;
+        if (box.w > max_w)
+            max_w = box.w;
+    }
+    bp->box_count = m;
+
+    const SweepList *list = &bp->bullets;
+    int found = 0;
+    int first = 0;
+    for (int k = 0; k < list->count && first < m; k++)
+    {
+        int i = list->order[k];
+        float x = xs[i];
+        while (first < m && bp->boxes[first].x + max_w <= x)
+            first++;
+        for (int j = first; j < m && bp->boxes[j].x < x + w; j++)
+        {
+            if (!boxes_overlap(x, ys[i], w, h, &bp->boxes[j]))
+                continue;
+            if (found >= max_out)
+                return found;
+            out[found++] = (CollisionPair){(short)i, bp->box_target[j]};
+        }
+    }
+    return found;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Vide la grille (aucune entité).
+ */
+void grid_clear(CollisionGrid *grid)
+{
+    memset(grid->cell_start, 0, sizeof(grid->cell_start));
+    grid->count = 0;
+}
+
+/**
+ * @brief Reconstruit la grille à partir d'un tableau d'entités.
+ *
+ * Deux passes (tri par comptage) :
+ * 1. On compte le nombre d'entrées par cellule puis on calcule les débuts (préfixe).
+ * 2. On range chaque indice à sa place définitive.
+ */
+void grid_build(CollisionGrid *grid, const Entity *entities, int n)
+{
+    int counts[GRID_CELLS] = {0};
+    int c0, c1, r0, r1;
+
+    // Passe 1 : Comptage
+    for (int i = 0; i < n; i++)
+    {
+        const Entity *e = &entities[i];
+        if (!is_collidable(e))
+            continue;
+        cell_range(e->x, e->y, e->width, e->height, &c0, &c1, &r0, &r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++)
+                counts[r * GRID_COLS + c]++;
+    }
+
+    // Préfixe : début de chaque cellule (borné à la capacité)
+    int total = 0;
+    for (int c = 0; c < GRID_CELLS; c++)
+    {
+        grid->cell_start[c] = (short)total;
+        total += counts[c];
+        if (total > GRID_MAX_ITEMS)
+            total = GRID_MAX_ITEMS;
+    }
+    grid->cell_start[GRID_CELLS] = (short)total;
+    grid->count = total;
+
+    // Passe 2 : Remplissage (on réutilise counts comme curseurs d'écriture)
+    for (int c = 0; c < GRID_CELLS; c++)
+        counts[c] = grid->cell_start[c];
+
+    for (int i = 0; i < n; i++)
+    {
+        const Entity *e = &entities[i];
+        if (!is_collidable(e))
+            continue;
+        cell_range(e->x, e->y, e->width, e->height, &c0, &c1, &r0, &r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++)
+            {
+                int cell = r * GRID_COLS + c;
+                if (counts[cell] < grid->cell_start[cell + 1])
+                    grid->items[counts[cell]++] = (short)i;
+            }
+    }
+}
+
+/**
+ * @brief Liste les entités candidates recouvrant une boîte donnée.
+ */
+int grid_query(const CollisionGrid *grid, float x, float y, float w, float h, short *out, int max_out)
+{
+    int c0, c1, r0, r1;
+    int found = 0;
+
+    cell_range(x, y, w, h, &c0, &c1, &r0, &r1);
+    for (int r = r0; r <= r1; r++)
+        for (int c = c0; c <= c1; c++)
+        {
+            int cell = r * GRID_COLS + c;
+            for (int k = grid->cell_start[cell]; k < grid->cell_start[cell + 1]; k++)
+            {
+                if (found >= max_out)
+                    return found;
+                out[found++] = grid->items[k];
+            }
+        }
+    return found;
+}
+
+/**
+ * @brief Teste une boîte contre N boîtes de même taille (SoA), en SIMD.
+ */
+void collision_box_vs_many(const AabbBox *box, const float *xs, const float *ys,
+                           float w, float h, int n, uint64_t *hits)
+{
+    memset(hits, 0, COLLISION_MASK_WORDS(n) * sizeof(uint64_t));
+    simd_aabb_hits(box->x, box->y, box->w, box->h, xs, ys, w, h, n, hits);
+}
+
+/**
+ * @brief Teste N boîtes de même taille (SoA) contre M boîtes quelconques.
+ */
+void collision_many_vs_many(const float *xs, const float *ys, float w, float h, int n,
+                            const AabbBox *boxes, int m, uint64_t *hits, int words)
+{
+    memset(hits, 0, (size_t)m * words * sizeof(uint64_t));
+    for (int j = 0; j < m; j++)
+        simd_aabb_hits(boxes[j].x, boxes[j].y, boxes[j].w, boxes[j].h, xs, ys, w, h, n, hits + j * words);
+}
+
+/**
+ * @brief Boîte balayée par une boîte qui vient de se déplacer verticalement de `move`.
+ */
+AabbBox collision_swept_box(float x, float y, float w, float h, float move)
+{
+    return (AabbBox){x, move > 0 ? y - move : y, w, move > 0 ? h + move : h - move};
+}
+
+/**
+ * @brief Variante balayée de collision_many_vs_many (segment contre boîte).
+ */
+void collision_sweep_vs_many(const float *xs, const float *ys, const float *dys, float step, float w, float h,
+                             int n, const uint64_t *active, const AabbBox *boxes, int m, uint64_t *hits, int words)
+{
+    memset(hits, 0, (size_t)m * words * sizeof(uint64_t));
+    for (int k = 0; k < COLLISION_MASK_WORDS(n); k++)
+    {
+        uint64_t bits = active[k];
+        if (k == n >> 6)
+            bits &= (1ULL << (n & 63)) - 1; // Dernier mot partiel
+        while (bits)
+        {
+            int i = k * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            AabbBox a = collision_swept_box(xs[i], ys[i], w, h, dys[i] * step);
+            for (int j = 0; j < m; j++)
+            {
+                const AabbBox *b = &boxes[j];
+                if (a.x < b->x + b->w && a.x + a.w > b->x && a.y < b->y + b->h && a.y + a.h > b->y)
+                    hits[j * words + k] |= 1ULL << (i & 63);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Prépare une liste vide.
+ */
+void sweep_init(SweepList *list, short *order, uint64_t *member, int capacity)
+{
+    list->order = order;
+    list->member = member;
+    list->count = 0;
+    list->capacity = capacity;
+    list->moves = 0;
+    memset(member, 0, COLLISION_MASK_WORDS(capacity) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Retire les balles mortes, met à part les déplacées et les nouvelles, puis fusionne.
+ *
+ * Une balle garde sa place tant qu'elle reste entre sa voisine gardée de
+ * gauche et sa voisine de droite : la partie gardée est triée par construction.
+ * Les autres (réutilisées ailleurs, nouvelles) sont triées à part puis
+ * fusionnées : le coût reste linéaire tant qu'elles sont peu nombreuses.
+ */
+void sweep_update(SweepList *list, const float *xs, const short *live, int n_live, const uint64_t *active)
+{
+    short *order = list->order;
+    short *moved = list->order + list->capacity;
+    int kept = 0;
+    int n_moved = 0;
+
+    // 1. Compaction : les mortes sortent, les balles hors d'ordre passent à part
+    for (int k = 0; k < list->count; k++)
+    {
+        int i = order[k];
+        if (!(active[i >> 6] & (1ULL << (i & 63))))
+        {
+            list->member[i >> 6] &= ~(1ULL << (i & 63));
+            continue;
+        }
+        if ((kept > 0 && x_before(xs, i, order[kept - 1])) || (k + 1 < list->count && x_before(xs, order[k + 1], i)))
+            moved[n_moved++] = (short)i;
+        else
+            order[kept++] = (short)i;
+    }
+
+    // 2. Nouvelles balles
+    for (int k = 0; k < n_live; k++)
+    {
+        int i = live[k];
+        if (i >= list->capacity || (list->member[i >> 6] & (1ULL << (i & 63))))
+            continue;
+        list->member[i >> 6] |= 1ULL << (i & 63);
+        moved[n_moved++] = (short)i;
+    }
+
+    // 3. Tri des balles mises à part, fusion par la fin (aucune case lue n'est écrasée)
+    sort_by_x(moved, n_moved, xs);
+    int a = kept - 1, b = n_moved - 1;
+    for (int k = kept + n_moved - 1; b >= 0; k--)
+        order[k] = (a >= 0 && x_before(xs, moved[b], order[a])) ? order[a--] : moved[b--];
+    list->count = kept + n_moved;
+    list->moves = n_moved;
+}
+
+/**
+ * @brief Apparie chaque balle `probe` à une balle d'un autre type qui la chevauche.
+ *
+ * Les balles d'une même largeur se chevauchent sur X si leurs positions sont
+ * à moins de `w` : chaque balle `probe` ne regarde que ses voisines de liste
+ * dans cette fenêtre, à droite puis à gauche, et prend la première encore libre.
+ */
+int sweep_cross_pairs(const SweepList *list, const float *xs, const float *ys, float w, float h,
+                      const EntityType *type, EntityType probe, uint64_t *unpaired, CollisionPair *out, int max_out)
+{
+    const short *order = list->order;
+    int found = 0;
+    for (int k = 0; k < list->count && found < max_out; k++)
+    {
+        int i = order[k];
+        if (type[i] != probe || !(unpaired[i >> 6] & (1ULL << (i & 63))))
+            continue;
+        int partner = -1;
+        for (int dir = 1; dir >= -1 && partner < 0; dir -= 2)
+            for (int j = k + dir; j >= 0 && j < list->count && fabsf(xs[order[j]] - xs[i]) < w; j += dir)
+            {
+                int o = order[j];
+                if (type[o] != probe && (unpaired[o >> 6] & (1ULL << (o & 63))) && ys[o] < ys[i] + h && ys[o] + h > ys[i])
+                {
+                    partner = o;
+                    break;
+                }
+            }
+        if (partner < 0)
+            continue;
+        unpaired[i >> 6] &= ~(1ULL << (i & 63));
+        unpaired[partner >> 6] &= ~(1ULL << (partner & 63));
+        out[found++] = (CollisionPair){(short)i, (short)partner};
+    }
+    return found;
+}
+
+/**
+ * @brief Prépare un broad phase (grille vide, liste vide).
+ */
+void broad_phase_init(BroadPhaseState *bp, BroadPhase kind, short *order, uint64_t *member, int capacity)
+{
+    bp->kind = kind;
+    grid_clear(&bp->grid);
+    bp->box_count = 0;
+    if (order && member)
+        sweep_init(&bp->bullets, order, member, capacity);
+    else
+        bp->bullets = (SweepList){0};
+}
+
+/**
+ * @brief Couples balle / cible qui se chevauchent, par la méthode choisie.
+ */
+int broad_phase_pairs(BroadPhaseState *bp, const float *xs, const float *ys, float w, float h,
+                      const short *live, int n_live, const uint64_t *active,
+                      const Entity *targets, int n_targets, CollisionPair *out, int max_out)
+{
+    if (bp->kind == BROAD_PHASE_GRID)
+        return grid_pairs(bp, xs, ys, w, h, live, n_live, targets, n_targets, out, max_out);
+    if (!bp->bullets.order)
+        return 0;
+    sweep_update(&bp->bullets, xs, live, n_live, active);
+    return sweep_pairs(bp, xs, ys, w, h, targets, n_targets, out, max_out);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file controller.c
+ * @brief Implémentation de la file des commandes et de l'état des manettes (Controller).
+ */
+
+#include "controller.h"
+
+// ============================================================================
+//                          ÉTAT MAINTENU
+// ============================================================================
+
+/**
+ * @brief Construit la commande d'un état maintenu.
+ */
+GameCommand command_held(unsigned bits)
+{
+    return (GameCommand)(CMD_HELD | (bits & INPUT_MASK));
+}
+
+/**
+ * @brief Indique si une commande est un état maintenu.
+ */
+bool command_is_held(GameCommand cmd, unsigned *bits)
+{
+    if (cmd < CMD_HELD || cmd > CMD_HELD_LAST)
+        return false;
+    if (bits)
+        *bits = (unsigned)cmd & INPUT_MASK;
+    return true;
+}
+
+/**
+ * @brief Construit la commande d'un état maintenu du second joueur.
+ */
+GameCommand command_held_p2(unsigned bits)
+{
+    return (GameCommand)(CMD_HELD_P2 | (bits & INPUT_MASK));
+}
+
+/**
+ * @brief Indique si une commande est un état maintenu du second joueur.
+ */
+bool command_is_held_p2(GameCommand cmd, unsigned *bits)
+{
+    if (cmd < CMD_HELD_P2 || cmd > CMD_HELD_P2_LAST)
+        return false;
+    if (bits)
+        *bits = (unsigned)cmd & INPUT_MASK;
+    return true;
+}
+
+// ============================================================================
+//                          MANETTE
+// ============================================================================
+
+/**
+ * @brief Prépare une manette au repos.
+ */
+void pad_init(PadState *pad, int deadzone)
+{
+    pad->deadzone = (deadzone > 0 && deadzone < PAD_AXIS_MAX) ? deadzone : PAD_DEADZONE;
+    pad->buttons = 0;
+    pad->stick = 0;
+    pad->lives = -1;
+}
+
+/**
+ * @brief Applique un appui ou un relâchement d'un bouton de jeu.
+ */
+bool pad_button(PadState *pad, unsigned bit, bool down)
+{
+    unsigned before = pad_held(pad);
+    if (down)
+        pad->buttons |= bit & INPUT_MASK;
+    else
+        pad->buttons &= ~bit;
+    return pad_held(pad) != before;
+}
+
+/**
+ * @brief Zone morte avec hystérésis : enclenché au-delà du seuil, relâché bien en deçà.
+ */
+bool pad_axis(PadState *pad, int value)
+{
+    unsigned before = pad_held(pad);
+    int release = pad->deadzone / PAD_DEADZONE_RELEASE;
+    if (value > pad->deadzone)
+        pad->stick = INPUT_RIGHT;
+    else if (value < -pad->deadzone)
+        pad->stick = INPUT_LEFT;
+    else if (value > -release && value < release)
+        pad->stick = 0;
+    return pad_held(pad) != before;
+}
+
+/**
+ * @brief Touches de jeu maintenues par la manette.
+ */
+unsigned pad_held(const PadState *pad)
+{
+    return (pad->buttons | pad->stick) & INPUT_MASK;
+}
+
+/**
+ * @brief Vies en baisse depuis l'appel précédent.
+ */
+bool pad_hit(PadState *pad, int lives)
+{
+    bool hit = pad->lives >= 0 && lives < pad->lives;
+    pad->lives = lives;
+    return hit;
+}
+
+// ============================================================================
+//                          FILE DES COMMANDES
+// ============================================================================
+
+/**
+ * @brief Vide la file (et son compteur de pertes).
+ */
+void command_queue_clear(CommandQueue *q)
+{
+    q->head = 0;
+    q->count = 0;
+    q->dropped = 0;
+}
+
+/**
+ * @brief Ajoute une commande en fin de file.
+ */
+bool command_queue_push(CommandQueue *q, GameCommand cmd, double time)
+{
+    if (q->count == COMMAND_QUEUE_SIZE)
+    {
+        q->dropped++;
+        return false;
+    }
+    TimedCommand *c = &q->items[(q->head + q->count) % COMMAND_QUEUE_SIZE];
+    c->cmd = cmd;
+    c->time = time;
+    q->count++;
+    return true;
+}
+
+/**
+ * @brief Retire la plus ancienne commande si elle date d'avant `until`.
+ */
+bool command_queue_pop(CommandQueue *q, double until, GameCommand *cmd)
+{
+    if (q->count == 0 || q->items[q->head].time > until)
+        return false;
+    *cmd = q->items[q->head].cmd;
+    q->head = (q->head + 1) % COMMAND_QUEUE_SIZE;
+    q->count--;
+    return true;
+}
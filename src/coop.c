@@ -0,0 +1,619 @@
+/**
+ * @file coop.c
+ * @brief Implémentation de la coopération en réseau (poignée de main, entrées, synchronisation).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour getaddrinfo et select).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "coop.h"
+#include "headless.h"
+#include "rollback.h"
+#include "save.h"
+#include "statehash.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. PAQUETS
+// ============================================================================
+
+/** @name Types de paquets */
+///@{
+#define PKT_JOIN 1  ///< Invité : demande à rejoindre.
+#define PKT_START 2 ///< Hôte : graine de la partie.
+#define PKT_INPUT 3 ///< Entrées, accusé, tick et empreinte.
+#define PKT_BYE 4   ///< Départ.
+///@}
+
+#define PKT_HEADER 4                      ///< "SI" | version | type.
+#define INPUT_MAX 64                      ///< Entrées au plus par paquet.
+#define INPUT_FIXED (PKT_HEADER + 27)     ///< Taille d'INPUT sans les touches.
+#define PKT_MAX (INPUT_FIXED + INPUT_MAX) ///< Plus grand paquet.
+#define LAG_QUEUE 256                     ///< Paquets retenus au plus par la latence simulée.
+#define CHECKS 16                         ///< Empreintes gardées de chaque côté.
+#define SYNC_INTERVAL 10                  ///< Images au moins entre deux ticks sautés pour attendre l'autre.
+
+/**
+ * @brief Paquet retenu par la latence simulée.
+ */
+typedef struct
+{
+    double due;            ///< Instant d'envoi.
+    size_t len;            ///< Taille.
+    uint8_t data[PKT_MAX]; ///< Contenu.
+} DelayedPacket;
+
+/**
+ * @brief Empreinte d'un état définitif.
+ */
+typedef struct
+{
+    uint32_t tick; ///< Tick de l'état (0 : emplacement vide).
+    uint64_t hash; ///< statehash_model.
+} Check;
+
+/**
+ * @brief État d'une session.
+ */
+typedef struct
+{
+    int fd;                            ///< Socket UDP connecté à l'autre joueur.
+    int local;                         ///< Indice du joueur local (0 : hôte, 1 : invité).
+    Rollback rb;                       ///< Simulation partagée.
+    uint32_t remote_ack;               ///< Entrées locales reçues par l'autre.
+    uint32_t remote_tick;              ///< Dernier tick annoncé par l'autre.
+    int remote_adv;                    ///< Avance annoncée par l'autre (ticks).
+    Check local_checks[CHECKS];        ///< Nos empreintes récentes.
+    Check remote_checks[CHECKS];       ///< Les siennes.
+    uint32_t next_check;               ///< Prochain tick à vérifier.
+    uint32_t compared;                 ///< Dernier tick comparé.
+    double lag;                        ///< Latence simulée (s).
+    DelayedPacket *queue;              ///< File de la latence simulée (LAG_QUEUE).
+    int queue_head, queue_count;       ///< Position et remplissage de la file.
+    CoopStats stats;                   ///< Bilan en cours.
+} CoopSession;
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void put_header(uint8_t *p, uint8_t type)
+{
+    p[0] = 'S';
+    p[1] = 'I';
+    p[2] = COOP_VERSION;
+    p[3] = type;
+}
+
+/**
+ * @brief Type d'un paquet reçu, ou 0 s'il n'est pas de ce protocole.
+ */
+static int packet_type(const uint8_t *p, ssize_t len)
+{
+    if (len < PKT_HEADER || p[0] != 'S' || p[1] != 'I' || p[2] != COOP_VERSION)
+        return 0;
+    return p[3];
+}
+
+/**
+ * @brief Attend qu'un socket soit lisible, au plus `seconds` secondes.
+ */
+static bool wait_readable(int fd, double seconds)
+{
+    struct timeval tv;
+    tv.tv_sec = (time_t)seconds;
+    tv.tv_usec = (suseconds_t)((seconds - (double)tv.tv_sec) * 1e6);
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(fd, &set);
+    return select(fd + 1, &set, NULL, NULL, &tv) > 0;
+}
+
+/**
+ * @brief Envoie les paquets retenus dont l'échéance est passée.
+ */
+static void flush_delayed(CoopSession *s, double now)
+{
+    while (s->queue_count > 0 && s->queue[s->queue_head].due <= now)
+    {
+        const DelayedPacket *d = &s->queue[s->queue_head];
+        (void)send(s->fd, d->data, d->len, 0); // Une perte est rattrapée par le paquet suivant
+        s->queue_head = (s->queue_head + 1) % LAG_QUEUE;
+        s->queue_count--;
+    }
+}
+
+/**
+ * @brief Envoie un paquet, tout de suite ou après la latence simulée.
+ */
+static void send_packet(CoopSession *s, const uint8_t *p, size_t len, double now)
+{
+    s->stats.bytes_sent += (long long)len;
+    if (s->lag <= 0.0)
+    {
+        (void)send(s->fd, p, len, 0);
+        return;
+    }
+    if (s->queue_count == LAG_QUEUE)
+        return; // File pleine : comme une perte
+    DelayedPacket *d = &s->queue[(s->queue_head + s->queue_count) % LAG_QUEUE];
+    d->due = now + s->lag;
+    d->len = len;
+    memcpy(d->data, p, len);
+    s->queue_count++;
+    flush_delayed(s, now);
+}
+
+// ============================================================================
+//                          2. ENTRÉES ET EMPREINTES
+// ============================================================================
+
+/**
+ * @brief Compare une empreinte à celle du même tick de l'autre côté, si elle est connue.
+ */
+static void compare_check(CoopSession *s, const Check *c, const Check *others)
+{
+    const Check *o = &others[(c->tick / COOP_CHECK_EVERY) % CHECKS];
+    if (c->tick <= s->compared || o->tick != c->tick)
+        return;
+    s->compared = c->tick;
+    s->stats.checks++;
+    if (o->hash != c->hash)
+    {
+        if (s->stats.desyncs == 0)
+            fprintf(stderr, "[COOP] Desynchronisation au tick %u (0x%016llx contre 0x%016llx)\n", c->tick,
+                    (unsigned long long)c->hash, (unsigned long long)o->hash);
+        s->stats.desyncs++;
+    }
+}
+
+/**
+ * @brief Calcule l'empreinte des états devenus définitifs aux ticks de vérification.
+ */
+static void update_checks(CoopSession *s)
+{
+    for (;;)
+    {
+        const GameModel *m = rollback_state(&s->rb, s->next_check);
+        if (!m)
+        {
+            if (s->rb.tick > s->next_check + ROLLBACK_STATES) // Plus gardé : on passe
+                s->next_check += COOP_CHECK_EVERY;
+            return;
+        }
+        Check *c = &s->local_checks[(s->next_check / COOP_CHECK_EVERY) % CHECKS];
+        c->tick = s->next_check;
+        c->hash = statehash_model(m, 0);
+        compare_check(s, c, s->remote_checks);
+        s->next_check += COOP_CHECK_EVERY;
+    }
+}
+
+/**
+ * @brief Envoie les entrées locales non accusées, l'accusé, le tick et la dernière empreinte.
+ */
+static void send_input(CoopSession *s, double now)
+{
+    uint8_t p[PKT_MAX];
+    uint32_t known = s->rb.known[s->local];
+    uint32_t first = s->remote_ack;
+    if (known - first > INPUT_MAX)
+        known = first + INPUT_MAX; // Les plus anciennes d'abord : l'autre les attend dans l'ordre
+    uint32_t n = known - first;
+
+    static const Check none = {0, 0};
+    uint32_t check_tick = s->next_check >= COOP_CHECK_EVERY ? s->next_check - COOP_CHECK_EVERY : 0;
+    const Check *c = &s->local_checks[(check_tick / COOP_CHECK_EVERY) % CHECKS];
+    if (c->tick != check_tick)
+        c = &none;
+    int adv = (int)s->rb.tick - (int)s->remote_tick;
+
+    put_header(p, PKT_INPUT);
+    uint8_t *q = p + PKT_HEADER;
+    put32(q, first);
+    q[4] = (uint8_t)n;
+    q += 5;
+    for (uint32_t k = 0; k < n; k++)
+        *q++ = rollback_input(&s->rb, s->local, first + k);
+    put32(q, s->rb.known[1 - s->local]);
+    put32(q + 4, s->rb.tick);
+    q[8] = (uint8_t)(int16_t)adv;
+    q[9] = (uint8_t)((uint16_t)(int16_t)adv >> 8);
+    put32(q + 10, c->tick);
+    put32(q + 14, (uint32_t)c->hash);
+    put32(q + 18, (uint32_t)(c->hash >> 32));
+    send_packet(s, p, (size_t)(q + 22 - p), now);
+}
+
+/**
+ * @brief Lit un paquet INPUT : entrées de l'autre joueur, accusé, tick et empreinte.
+ */
+static void handle_input(CoopSession *s, const uint8_t *p, ssize_t len)
+{
+    if (len < INPUT_FIXED)
+        return;
+    const uint8_t *q = p + PKT_HEADER;
+    uint32_t first = get32(q);
+    int n = q[4];
+    if (len < INPUT_FIXED + n)
+        return;
+    q += 5;
+    int remote = 1 - s->local;
+    for (int k = 0; k < n; k++)
+        rollback_add_input(&s->rb, remote, first + (uint32_t)k, q[k]);
+    q += n;
+
+    uint32_t ack = get32(q);
+    if (ack > s->remote_ack && ack <= s->rb.known[s->local])
+        s->remote_ack = ack;
+    uint32_t tick = get32(q + 4);
+    if (tick > s->remote_tick)
+    {
+        s->remote_tick = tick;
+        s->remote_adv = (int16_t)(uint16_t)(q[8] | q[9] << 8);
+    }
+    Check c = {get32(q + 10), (uint64_t)get32(q + 14) | (uint64_t)get32(q + 18) << 32};
+    if (c.tick > 0 && c.tick % COOP_CHECK_EVERY == 0)
+    {
+        s->remote_checks[(c.tick / COOP_CHECK_EVERY) % CHECKS] = c;
+        compare_check(s, &c, s->local_checks);
+    }
+}
+
+/**
+ * @brief Touches du joueur local pour cette image : Vue (états maintenus ou appuis) ou script.
+ *
+ * @param quit Mis à true sur CMD_EXIT.
+ */
+static uint8_t local_bits(CoopSession *s, const CoopConfig *cfg, const char *script, bool *quit)
+{
+    if (!cfg->view)
+    {
+        switch (headless_script_command(script[s->rb.tick % strlen(script)]))
+        {
+        case CMD_MOVE_LEFT:
+            return INPUT_LEFT;
+        case CMD_MOVE_RIGHT:
+            return INPUT_RIGHT;
+        case CMD_SHOOT:
+            return INPUT_FIRE;
+        default:
+            return 0;
+        }
+    }
+    CommandQueue input;
+    command_queue_clear(&input);
+    cfg->view->get_input(s->rb.model, &input);
+    unsigned bits = 0, held;
+    GameCommand cmd;
+    while (command_queue_pop(&input, HUGE_VAL, &cmd))
+    {
+        if (cmd == CMD_EXIT)
+            *quit = true;
+        else if (command_is_held(cmd, &held))
+            bits = held;
+        else if (cmd == CMD_MOVE_LEFT)
+            bits |= INPUT_LEFT;
+        else if (cmd == CMD_MOVE_RIGHT)
+            bits |= INPUT_RIGHT;
+        else if (cmd == CMD_SHOOT)
+            bits |= INPUT_FIRE;
+    }
+    return (uint8_t)bits;
+}
+
+// ============================================================================
+//                          3. CONNEXION
+// ============================================================================
+
+/**
+ * @brief Hôte : attend un JOIN et se connecte à son expéditeur.
+ *
+ * @return true si un joueur est arrivé avant `seconds` (0 : sans limite).
+ */
+static bool host_wait(CoopSession *s, int port, double seconds)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(s->fd, (const struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "[ERREUR] Coop : port UDP %d indisponible (%s)\n", port, strerror(errno));
+        return false;
+    }
+    printf("[COOP] En attente d'un joueur sur le port UDP %d\n", port);
+
+    double start = utils_get_time();
+    while (seconds <= 0.0 || utils_get_time() - start < seconds)
+    {
+        if (!wait_readable(s->fd, 0.25))
+            continue;
+        uint8_t p[PKT_MAX];
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = recvfrom(s->fd, p, sizeof(p), 0, (struct sockaddr *)&from, &from_len);
+        if (packet_type(p, len) != PKT_JOIN || connect(s->fd, (const struct sockaddr *)&from, from_len) != 0)
+            continue;
+        s->stats.bytes_recv += len;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Hôte : envoie (ou renvoie) la graine.
+ */
+static void send_start(CoopSession *s, uint64_t seed, double now)
+{
+    uint8_t p[PKT_HEADER + 8];
+    put_header(p, PKT_START);
+    put32(p + PKT_HEADER, (uint32_t)seed);
+    put32(p + PKT_HEADER + 4, (uint32_t)(seed >> 32));
+    send_packet(s, p, sizeof(p), now);
+}
+
+/**
+ * @brief Invité : se connecte à l'hôte et répète JOIN jusqu'à recevoir la graine.
+ */
+static bool guest_join(CoopSession *s, const char *host, int port, uint64_t *seed)
+{
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, service, &hints, &res) != 0 || !res)
+    {
+        fprintf(stderr, "[ERREUR] Coop : hote %s introuvable\n", host);
+        return false;
+    }
+    bool ok = connect(s->fd, res->ai_addr, res->ai_addrlen) == 0;
+    freeaddrinfo(res);
+    if (!ok)
+        return false;
+
+    uint8_t join[PKT_HEADER];
+    put_header(join, PKT_JOIN);
+    double start = utils_get_time();
+    while (utils_get_time() - start < 2.0 * COOP_TIMEOUT)
+    {
+        send_packet(s, join, sizeof(join), utils_get_time());
+        double until = utils_get_time() + 0.25;
+        while (utils_get_time() < until)
+        {
+            flush_delayed(s, utils_get_time());
+            if (!wait_readable(s->fd, 0.01))
+                continue;
+            uint8_t p[PKT_MAX];
+            ssize_t len = recv(s->fd, p, sizeof(p), 0);
+            if (packet_type(p, len) != PKT_START || len < PKT_HEADER + 8)
+                continue;
+            s->stats.bytes_recv += len;
+            *seed = (uint64_t)get32(p + PKT_HEADER) | (uint64_t)get32(p + PKT_HEADER + 4) << 32;
+            return true;
+        }
+    }
+    fprintf(stderr, "[ERREUR] Coop : %s:%d ne repond pas\n", host, port);
+    return false;
+}
+
+// ============================================================================
+//                          4. SESSION
+// ============================================================================
+
+/**
+ * @brief Lit tous les paquets en attente.
+ *
+ * @return false si l'autre joueur est parti.
+ */
+static bool receive_all(CoopSession *s, uint64_t seed, double now, double *last_recv)
+{
+    uint8_t p[PKT_MAX];
+    ssize_t len;
+    while ((len = recv(s->fd, p, sizeof(p), MSG_DONTWAIT)) >= 0)
+    {
+        s->stats.bytes_recv += len;
+        *last_recv = now;
+        int type = packet_type(p, len);
+        if (type == PKT_INPUT)
+            handle_input(s, p, len);
+        else if (type == PKT_JOIN && s->local == 0)
+            send_start(s, seed, now); // START perdu : l'invité le redemande
+        else if (type == PKT_BYE)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Héberge ou rejoint une partie, et la joue jusqu'à sa fin.
+ */
+bool coop_run(const CoopConfig *cfg, CoopStats *out)
+{
+    CoopSession *s = calloc(1, sizeof(CoopSession));
+    if (!s)
+        return false;
+    s->queue = calloc(LAG_QUEUE, sizeof(DelayedPacket));
+    s->lag = cfg->lag;
+    s->local = cfg->host ? 1 : 0;
+    s->next_check = COOP_CHECK_EVERY;
+    s->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    const char *script = (cfg->script && cfg->script[0]) ? cfg->script : HEADLESS_DEFAULT_SCRIPT;
+
+    // --- A. Poignée de main : l'hôte choisit la graine ---
+    uint64_t seed = cfg->seed;
+    bool ok = s->queue && s->fd >= 0;
+    if (ok && cfg->host)
+        ok = guest_join(s, cfg->host, cfg->port, &seed);
+    else if (ok)
+    {
+        ok = host_wait(s, cfg->port, cfg->seconds);
+        if (ok)
+            send_start(s, seed, utils_get_time());
+    }
+
+    // --- B. Même partie des deux côtés : graine, virgule fixe, deux vaisseaux ---
+    GameModel *model = ok ? model_init() : NULL;
+    ok = model && rollback_init(&s->rb, model, 1.0 / TARGET_FPS);
+    if (ok)
+    {
+        printf("[COOP] Partie lancee (joueur %d, graine 0x%llx)\n", s->local + 1, (unsigned long long)seed);
+        model_rng_seed(model, seed);
+        model->sim.fixed_point = true;
+        model->sim.shield_bitmap = false; // Le message START ne négocie pas les boucliers
+        model->sim.swept_bullets = false; // ...ni les collisions
+        model->sim.endless = false;       // ...ni la vague sans fin
+        model_set_coop(model, true);
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 0; // "JOUER"
+        model_handle_input(model, CMD_RETURN);
+        if (cfg->view && cfg->view->audio_events)
+            model_set_audio_sink(model, cfg->view->audio_events());
+        if (cfg->view && cfg->view->set_interpolation)
+            cfg->view->set_interpolation(NULL, 0.0f); // Une image par tick : rien à interpoler
+        for (uint32_t t = 0; t < COOP_INPUT_DELAY; t++)
+            rollback_add_input(&s->rb, s->local, t, 0);
+    }
+
+    // --- C. Boucle : entrées, synchronisation, rollback, rendu ---
+    FramePacer pacer;
+    utils_pacer_init(&pacer, TARGET_FPS, cfg->view && cfg->view->has_vsync && cfg->view->has_vsync());
+    double start = utils_get_time();
+    double last_recv = start;
+    long frame = 0, last_sync = 0;
+    bool running = ok;
+    while (running)
+    {
+        double now = utils_get_time();
+        flush_delayed(s, now);
+        if (!receive_all(s, seed, now, &last_recv))
+        {
+            printf("[COOP] L'autre joueur est parti\n");
+            break;
+        }
+        if (now - last_recv > COOP_TIMEOUT)
+        {
+            fprintf(stderr, "[ERREUR] Coop : l'autre joueur ne repond plus\n");
+            break;
+        }
+        if (cfg->seconds > 0.0 && now - start >= cfg->seconds)
+            break;
+
+        bool quit = false;
+        uint8_t bits = local_bits(s, cfg, script, &quit);
+        if (quit)
+            break;
+
+        // Trop d'avance sur l'autre (moitié de l'écart des avances) : un tick sauté de temps en temps
+        int adv = (int)s->rb.tick - (int)s->remote_tick;
+        if ((adv - s->remote_adv) / 2 >= 1 && frame - last_sync >= SYNC_INTERVAL)
+        {
+            last_sync = frame;
+            s->stats.stalls++;
+        }
+        else
+        {
+            rollback_add_input(&s->rb, s->local, s->rb.tick + COOP_INPUT_DELAY, bits);
+            if (rollback_advance(&s->rb))
+                s->stats.ticks++;
+        }
+        update_checks(s);
+        send_input(s, now);
+
+        // Fin de partie, une fois l'état définitif (les deux machines y arrivent au même tick)
+        const GameModel *m = rollback_state(&s->rb, rollback_confirmed(&s->rb));
+        if (m && m->sim.state == STATE_GAME_OVER)
+            running = false;
+
+        if (cfg->view)
+            cfg->view->render(model);
+        utils_pacer_wait(&pacer);
+        frame++;
+    }
+
+    // --- D. Départ : dernières entrées et BYE, répétés contre la perte ---
+    if (ok)
+    {
+        uint8_t bye[PKT_HEADER];
+        put_header(bye, PKT_BYE);
+        for (int i = 0; i < 3; i++)
+        {
+            send_input(s, utils_get_time());
+            send_packet(s, bye, sizeof(bye), utils_get_time());
+        }
+        while (s->queue_count > 0) // Latence simulée : les paquets retenus partent quand même
+        {
+            utils_sleep_ms(1);
+            flush_delayed(s, utils_get_time());
+        }
+
+        uint32_t final_tick = rollback_confirmed(&s->rb);
+        const GameModel *m = rollback_state(&s->rb, final_tick);
+        if (!m)
+            m = model;
+        s->stats.final_tick = m == model ? s->rb.tick : final_tick;
+        s->stats.score = m->sim.score;
+        s->stats.level = m->sim.level;
+        s->stats.fingerprint = save_fingerprint(m);
+        s->stats.rollbacks = s->rb.rollbacks;
+        s->stats.resimulated = s->rb.resimulated;
+        s->stats.max_depth = s->rb.max_depth;
+        s->stats.stalls += s->rb.stalls;
+        rollback_free(&s->rb);
+    }
+    s->stats.elapsed = utils_get_time() - start;
+    if (out)
+        *out = s->stats;
+
+    if (s->fd >= 0)
+        close(s->fd);
+    model_free(model);
+    free(s->queue);
+    free(s);
+    return ok;
+}
+
+// ============================================================================
+//                          5. BILAN
+// ============================================================================
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ */
+void coop_print_stats(const CoopStats *stats)
+{
+    double secs = stats->elapsed > 0.0 ? stats->elapsed : 1.0;
+    printf("[COOP] Duree : %.1f s, %lld ticks\n", stats->elapsed, stats->ticks);
+    printf("[COOP] Rollbacks : %lld (%lld ticks resimules, %d au plus), %lld attentes\n", stats->rollbacks,
+           stats->resimulated, stats->max_depth, stats->stalls);
+    printf("[COOP] Empreintes : %lld comparees, %lld differentes\n", stats->checks, stats->desyncs);
+    printf("[COOP] Debit : %.0f octets/s envoyes, %.0f octets/s recus\n", stats->bytes_sent / secs,
+           stats->bytes_recv / secs);
+    printf("[COOP] Score : %d (niveau %d)\n", stats->score, stats->level);
+    printf("[COOP] Empreinte : 0x%08x (tick %u)\n", stats->fingerprint, stats->final_tick);
+}
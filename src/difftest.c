@@ -0,0 +1,415 @@
+/**
+ * @file difftest.c
+ * @brief Implémentation du test différentiel entre model_update et model_update_reference.
+ */
+
+#include "difftest.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#include "controller.h"
+#include "headless.h"
+#include "simd.h"
+#include "statehash.h"
+#include "utils.h"
+#include "workers.h"
+
+// ============================================================================
+//                          1. COMPARAISON CHAMP PAR CHAMP
+// ============================================================================
+
+/**
+ * @brief Liste en cours : lignes écrites et champs comptés.
+ */
+typedef struct
+{
+    FILE *out;     ///< Sortie (NULL : compte seulement).
+    int max_lines; ///< Lignes écrites au plus.
+    int count;     ///< Champs différents.
+} Diff;
+
+/**
+ * @brief Compte un champ différent et l'écrit s'il reste de la place.
+ */
+static void diff_line(Diff *d, const char *fmt, ...)
+{
+    d->count++;
+    if (!d->out || d->count > d->max_lines)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    fprintf(d->out, "  ");
+    vfprintf(d->out, fmt, args);
+    fprintf(d->out, "\n");
+    va_end(args);
+}
+
+/** @brief Entier (ou booléen, énumération, masque) comparé par valeur. */
+static void diff_int(Diff *d, const char *name, long long a, long long b)
+{
+    if (a != b)
+        diff_line(d, "%s : %lld != %lld", name, a, b);
+}
+
+/** @brief Masque 64 bits, en hexadécimal. */
+static void diff_u64(Diff *d, const char *name, uint64_t a, uint64_t b)
+{
+    if (a != b)
+        diff_line(d, "%s : 0x%016llx != 0x%016llx", name, (unsigned long long)a, (unsigned long long)b);
+}
+
+/** @brief Flottant comparé bit à bit (un -0 ou un NaN différent compte). */
+static void diff_f32(Diff *d, const char *name, float a, float b)
+{
+    if (memcmp(&a, &b, sizeof(float)) != 0)
+        diff_line(d, "%s : %.9g != %.9g", name, a, b);
+}
+
+/**
+ * @brief Nom indexé d'un champ ("bullets[12].y").
+ */
+static const char *field(char *buf, size_t cap, const char *group, int index, const char *name)
+{
+    if (index >= 0)
+        snprintf(buf, cap, "%s[%d].%s", group, index, name);
+    else
+        snprintf(buf, cap, "%s.%s", group, name);
+    return buf;
+}
+
+/**
+ * @brief Champs simulés d'une Entity.
+ */
+static void diff_entity(Diff *d, const char *group, const Entity *a, const Entity *b)
+{
+    char n[64];
+    diff_f32(d, field(n, sizeof(n), group, -1, "x"), a->x, b->x);
+    diff_f32(d, field(n, sizeof(n), group, -1, "y"), a->y, b->y);
+    diff_f32(d, field(n, sizeof(n), group, -1, "dx"), a->dx, b->dx);
+    diff_f32(d, field(n, sizeof(n), group, -1, "dy"), a->dy, b->dy);
+    diff_int(d, field(n, sizeof(n), group, -1, "active"), a->active, b->active);
+    diff_int(d, field(n, sizeof(n), group, -1, "shoot_timer"), a->shoot_timer, b->shoot_timer);
+    diff_int(d, field(n, sizeof(n), group, -1, "anim_timer"), a->anim_timer, b->anim_timer);
+    diff_int(d, field(n, sizeof(n), group, -1, "anim_frame"), a->anim_frame, b->anim_frame);
+    diff_int(d, field(n, sizeof(n), group, -1, "exploding"), a->exploding, b->exploding);
+    diff_int(d, field(n, sizeof(n), group, -1, "explode_timer"), a->explode_timer, b->explode_timer);
+}
+
+/**
+ * @brief Pool de balles : compteurs, puis chaque slot occupé dans l'un des deux modèles.
+ */
+static void diff_bullets(Diff *d, const BulletPool *a, const BulletPool *b)
+{
+    diff_int(d, "bullets.capacity", a->capacity, b->capacity);
+    if (a->capacity != b->capacity)
+        return;
+    diff_int(d, "bullets.live.count", a->live.count, b->live.count);
+    diff_int(d, "bullets.high_water", a->high_water, b->high_water);
+    diff_int(d, "bullets.player_high", a->player_high, b->player_high);
+    for (int side = 0; side < BULLET_SIDES; side++)
+    {
+        char n[64];
+        snprintf(n, sizeof(n), "bullets.free_count[%d]", side);
+        diff_int(d, n, a->free_count[side], b->free_count[side]);
+        snprintf(n, sizeof(n), "bullets.dropped_spawns[%d]", side);
+        diff_int(d, n, a->dropped_spawns[side], b->dropped_spawns[side]);
+    }
+    for (int i = 0; i < a->capacity; i++)
+    {
+        bool on_a = (a->active[i >> 6] >> (i & 63)) & 1;
+        bool on_b = (b->active[i >> 6] >> (i & 63)) & 1;
+        if (!on_a && !on_b)
+            continue;
+        char n[64];
+        diff_int(d, field(n, sizeof(n), "bullets", i, "active"), on_a, on_b);
+        diff_f32(d, field(n, sizeof(n), "bullets", i, "x"), a->x[i], b->x[i]);
+        diff_f32(d, field(n, sizeof(n), "bullets", i, "y"), a->y[i], b->y[i]);
+        diff_f32(d, field(n, sizeof(n), "bullets", i, "dy"), a->dy[i], b->dy[i]);
+        diff_int(d, field(n, sizeof(n), "bullets", i, "type"), a->type[i], b->type[i]);
+        diff_int(d, field(n, sizeof(n), "bullets", i, "anim_timer"), a->anim_timer[i], b->anim_timer[i]);
+        diff_int(d, field(n, sizeof(n), "bullets", i, "anim_frame"), a->anim_frame[i], b->anim_frame[i]);
+    }
+}
+
+/**
+ * @brief Vague, roue des explosions et aliens figés.
+ */
+static void diff_wave(Diff *d, const SimState *a, const SimState *b)
+{
+    const Formation *fa = &a->formation, *fb = &b->formation;
+    diff_f32(d, "formation.origin_x", fa->origin_x, fb->origin_x);
+    diff_f32(d, "formation.origin_y", fa->origin_y, fb->origin_y);
+    diff_u64(d, "formation.alive_mask", fa->alive_mask, fb->alive_mask);
+    diff_u64(d, "formation.dying_mask", fa->dying_mask, fb->dying_mask);
+    diff_int(d, "formation.alive_count", fa->alive_count, fb->alive_count);
+    diff_int(d, "formation.min_col", fa->min_col, fb->min_col);
+    diff_int(d, "formation.max_col", fa->max_col, fb->max_col);
+    diff_int(d, "formation.path_ticks", fa->path_ticks, fb->path_ticks);
+    diff_f32(d, "formation.stream_lag", fa->stream_lag, fb->stream_lag);
+    diff_int(d, "formation.stream_rows", fa->stream_rows, fb->stream_rows);
+    diff_int(d, "enemies.live.count", a->enemies.live.count, b->enemies.live.count);
+    diff_int(d, "enemies.explosion_count", a->enemies.explosion_count, b->enemies.explosion_count);
+    uint64_t dying = fa->dying_mask | fb->dying_mask;
+    for (int e = 0; e < FORMATION_SIZE; e++)
+    {
+        if (!((dying >> e) & 1))
+            continue;
+        char n[64];
+        diff_f32(d, field(n, sizeof(n), "enemies", e, "x"), a->enemies.x[e], b->enemies.x[e]);
+        diff_f32(d, field(n, sizeof(n), "enemies", e, "y"), a->enemies.y[e], b->enemies.y[e]);
+    }
+}
+
+/**
+ * @brief OVNI, vaisseau amiral et boucliers.
+ */
+static void diff_targets(Diff *d, const SimState *a, const SimState *b)
+{
+    diff_f32(d, "ufo.x", a->ufo.x, b->ufo.x);
+    diff_f32(d, "ufo.y", a->ufo.y, b->ufo.y);
+    diff_f32(d, "ufo.dx", a->ufo.dx, b->ufo.dx);
+    diff_int(d, "ufo.active", a->ufo.active, b->ufo.active);
+    diff_int(d, "ufo.hasSpawnedThisLevel", a->ufo.hasSpawnedThisLevel, b->ufo.hasSpawnedThisLevel);
+    diff_int(d, "ufo.exploding", a->ufo.exploding, b->ufo.exploding);
+    diff_int(d, "ufo.explode_timer", a->ufo.explode_timer, b->ufo.explode_timer);
+
+    diff_int(d, "boss.active", a->boss.active, b->boss.active);
+    if (a->boss.active || b->boss.active)
+    {
+        diff_f32(d, "boss.x", a->boss.x, b->boss.x);
+        diff_f32(d, "boss.y", a->boss.y, b->boss.y);
+        diff_f32(d, "boss.dx", a->boss.dx, b->boss.dx);
+        diff_u64(d, "boss.alive_mask", a->boss.alive_mask, b->boss.alive_mask);
+        for (int k = 0; k < a->boss.parts && k < BOSS_MAX_PARTS; k++)
+        {
+            char n[64];
+            snprintf(n, sizeof(n), "boss.health[%d]", k);
+            diff_int(d, n, a->boss.health[k], b->boss.health[k]);
+        }
+    }
+
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        char n[64];
+        diff_int(d, field(n, sizeof(n), "shields", s, "health"), a->shields[s].health, b->shields[s].health);
+        diff_int(d, field(n, sizeof(n), "shields", s, "active"), a->shields[s].active, b->shields[s].active);
+        for (int r = 0; r < SHIELD_BITMAP_ROWS; r++)
+        {
+            if (a->shields[s].bits[r] == b->shields[s].bits[r])
+                continue;
+            snprintf(n, sizeof(n), "shields[%d].bits[%d]", s, r);
+            diff_int(d, n, a->shields[s].bits[r], b->shields[s].bits[r]);
+            break; // Première rangée seulement : un cratère en touche plusieurs
+        }
+    }
+}
+
+/**
+ * @brief Registre des autres entités : masques, puis données de chaque ensemble dense.
+ */
+static void diff_ecs(Diff *d, const EcsWorld *a, const EcsWorld *b)
+{
+    diff_int(d, "ecs.alive", a->alive, b->alive);
+    diff_int(d, "ecs.dropped", a->dropped, b->dropped);
+    for (int i = 0; i < ECS_MAX_ENTITIES; i++)
+    {
+        char n[64];
+        snprintf(n, sizeof(n), "ecs.mask[%d]", i);
+        diff_int(d, n, a->mask[i], b->mask[i]);
+    }
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+    {
+        char n[64];
+        snprintf(n, sizeof(n), "ecs.sets[%d].count", c);
+        diff_int(d, n, a->sets[c].count, b->sets[c].count);
+    }
+    for (int p = 0; p < a->sets[ECS_POSITION].count && p < b->sets[ECS_POSITION].count; p++)
+    {
+        char n[64];
+        diff_f32(d, field(n, sizeof(n), "ecs", p, "x"), a->x[p], b->x[p]);
+        diff_f32(d, field(n, sizeof(n), "ecs", p, "y"), a->y[p], b->y[p]);
+    }
+    for (int p = 0; p < a->sets[ECS_VELOCITY].count && p < b->sets[ECS_VELOCITY].count; p++)
+    {
+        char n[64];
+        diff_f32(d, field(n, sizeof(n), "ecs", p, "dx"), a->dx[p], b->dx[p]);
+        diff_f32(d, field(n, sizeof(n), "ecs", p, "dy"), a->dy[p], b->dy[p]);
+    }
+    for (int p = 0; p < a->sets[ECS_LIFETIME].count && p < b->sets[ECS_LIFETIME].count; p++)
+    {
+        char n[64];
+        diff_f32(d, field(n, sizeof(n), "ecs", p, "lifetime"), a->lifetime[p], b->lifetime[p]);
+    }
+}
+
+// ============================================================================
+//                          2. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Lance (ou relance) une partie par les vraies commandes du menu (cf. headless.c).
+ */
+static void start_game(GameModel *model)
+{
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        GameOverOption opts[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, opts);
+        for (int i = 0; i < count; i++)
+            if (opts[i] == GAME_OVER_REPLAY)
+                model->ui.menu_selection = i; // "REJOUER"
+    }
+    else
+    {
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 0; // "JOUER"
+    }
+    model_handle_input(model, CMD_RETURN);
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Configuration par défaut.
+ */
+void difftest_default_config(DiffTestConfig *cfg)
+{
+    cfg->max_ticks = DIFFTEST_DEFAULT_TICKS;
+    cfg->seed = MODEL_RNG_DEFAULT_SEED;
+    cfg->script = HEADLESS_DEFAULT_SCRIPT;
+    cfg->bot = NULL;
+}
+
+/**
+ * @brief Liste les champs qui diffèrent.
+ */
+int difftest_diff(const GameModel *ref, const GameModel *opt, FILE *out, int max_lines)
+{
+    Diff d = {out, max_lines, 0};
+    const SimState *a = &ref->sim, *b = &opt->sim;
+    diff_int(&d, "state", a->state, b->state);
+    diff_int(&d, "previous_state", a->previous_state, b->previous_state);
+    diff_int(&d, "score", a->score, b->score);
+    diff_int(&d, "lives", a->lives, b->lives);
+    diff_int(&d, "level", a->level, b->level);
+    diff_int(&d, "normal_max_lives", a->normal_max_lives, b->normal_max_lives);
+    diff_f32(&d, "enemy_speed_mult", a->enemy_speed_mult, b->enemy_speed_mult);
+    diff_int(&d, "direction_enemies", a->direction_enemies, b->direction_enemies);
+    diff_int(&d, "drop_direction", a->drop_direction, b->drop_direction);
+    diff_int(&d, "drop_step_count", a->drop_step_count, b->drop_step_count);
+    diff_int(&d, "animation_frame", a->animation_frame, b->animation_frame);
+    diff_int(&d, "animation_timer", a->animation_timer, b->animation_timer);
+    diff_int(&d, "game_over_timer", a->game_over_timer, b->game_over_timer);
+    diff_int(&d, "hit_timer", a->hit_timer, b->hit_timer);
+    diff_int(&d, "rapid_timer", a->rapid_timer, b->rapid_timer);
+    diff_int(&d, "spread_timer", a->spread_timer, b->spread_timer);
+    diff_f32(&d, "fire_timer", a->fire_timer, b->fire_timer);
+    diff_u64(&d, "rng.state", a->rng.state, b->rng.state);
+    diff_entity(&d, "player", &a->player, &b->player);
+    diff_entity(&d, "player2", &a->player2, &b->player2);
+    diff_wave(&d, a, b);
+    diff_targets(&d, a, b);
+    diff_bullets(&d, &a->bullets, &b->bullets);
+    diff_ecs(&d, &a->ecs, &b->ecs);
+    if (out && d.count > max_lines)
+        fprintf(out, "  ... %d autre(s) champ(s)\n", d.count - max_lines);
+    return d.count;
+}
+
+/**
+ * @brief Deux modèles de la même graine, mêmes entrées, deux chemins de mise à jour.
+ *
+ * Le bot décide sur le modèle optimisé ; tant que les empreintes sont
+ * égales, les deux modèles sont identiques pour lui.
+ */
+bool difftest_run(const DiffTestConfig *cfg, DiffTestResult *out)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    const char *script = (cfg->script && cfg->script[0]) ? cfg->script : HEADLESS_DEFAULT_SCRIPT;
+    size_t script_len = strlen(script);
+    DiffTestResult r = {.diverged_tick = -1};
+
+    GameModel *ref = model_init();
+    GameModel *opt = ref ? model_init() : NULL;
+    if (!opt)
+    {
+        model_free(ref);
+        return false;
+    }
+    model_rng_seed(ref, cfg->seed);
+    model_rng_seed(opt, cfg->seed);
+    start_game(ref);
+    start_game(opt);
+    r.games = 1;
+    Bot bot = {0};
+    if (cfg->bot)
+        bot_init(&bot, cfg->bot, cfg->seed);
+
+    for (long tick = 0; tick < cfg->max_ticks; tick++)
+    {
+        if (opt->sim.state == STATE_GAME_OVER)
+        {
+            start_game(ref);
+            start_game(opt);
+            if (cfg->bot)
+                bot_init(&bot, cfg->bot, cfg->seed + (uint64_t)r.games);
+            r.games++;
+        }
+        if (opt->sim.state == STATE_PLAYING)
+        {
+            GameCommand cmd =
+                cfg->bot ? command_held(bot_decide(&bot, opt)) : headless_script_command(script[tick % script_len]);
+            model_handle_input(ref, cmd);
+            model_handle_input(opt, cmd);
+        }
+
+        double t0 = utils_get_time();
+        model_update_reference(ref, dt);
+        double t1 = utils_get_time();
+        model_update(opt, dt);
+        double t2 = utils_get_time();
+        r.ref_seconds += t1 - t0;
+        r.opt_seconds += t2 - t1;
+        r.ticks++;
+
+        r.hash_ref = statehash_model(ref, 0);
+        r.hash_opt = statehash_model(opt, 0);
+        if (r.hash_ref != r.hash_opt || (r.fields = difftest_diff(ref, opt, NULL, 0)) > 0)
+        {
+            r.diverged_tick = tick;
+            printf("[DIFFTEST] Divergence au tick %ld (partie %d, niveau %d) : référence -> optimisé\n", tick, r.games,
+                   opt->sim.level);
+            r.fields = difftest_diff(ref, opt, stdout, DIFFTEST_MAX_FIELDS);
+            break;
+        }
+    }
+
+    if (cfg->bot)
+        bot_free(&bot);
+    model_free(opt);
+    model_free(ref);
+    if (out)
+        *out = r;
+    return true;
+}
+
+/**
+ * @brief Affiche le bilan.
+ */
+void difftest_print(const DiffTestResult *r)
+{
+    printf("[DIFFTEST] Ticks         : %ld (%d partie(s))\n", r->ticks, r->games);
+    printf("[DIFFTEST] Noyaux        : %s, %d thread(s) de calcul\n", simd_backend_name(), workers_threads());
+    printf("[DIFFTEST] Référence     : %.0f ticks/s\n", r->ref_seconds > 0 ? r->ticks / r->ref_seconds : 0.0);
+    printf("[DIFFTEST] Optimisé      : %.0f ticks/s (x%.2f)\n", r->opt_seconds > 0 ? r->ticks / r->opt_seconds : 0.0,
+           r->opt_seconds > 0 ? r->ref_seconds / r->opt_seconds : 0.0);
+    if (r->diverged_tick < 0)
+        printf("[DIFFTEST] Résultat      : identiques à chaque tick (empreinte finale 0x%016llx)\n",
+               (unsigned long long)r->hash_opt);
+    else
+        printf("[DIFFTEST] Résultat      : DIVERGENCE au tick %ld, %d champ(s) (empreintes 0x%016llx / 0x%016llx)\n",
+               r->diverged_tick, r->fields, (unsigned long long)r->hash_ref, (unsigned long long)r->hash_opt);
+}
@@ -0,0 +1,229 @@
+/**
+ * @file ecs.c
+ * @brief Implémentation du registre de composants.
+ */
+
+#include "ecs.h"
+
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Index d'un identifiant. */
+#define ECS_INDEX(e) ((e) & 0xFF)
+
+/** @brief Génération d'un identifiant. */
+#define ECS_GEN(e) ((e) >> 8)
+
+/**
+ * @brief Remet à zéro les données de la place `p` du composant `c`.
+ */
+static void clear_slot(EcsWorld *w, EcsComponent c, int p)
+{
+    switch (c)
+    {
+    case ECS_POSITION:
+        w->x[p] = w->y[p] = 0.0f;
+        break;
+    case ECS_VELOCITY:
+        w->dx[p] = w->dy[p] = 0.0f;
+        break;
+    case ECS_KIND:
+        w->kind[p] = 0;
+        break;
+    case ECS_LIFETIME:
+        w->lifetime[p] = 0.0f;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Recopie les données de la place `from` à la place `to` du composant `c`.
+ */
+static void move_slot(EcsWorld *w, EcsComponent c, int to, int from)
+{
+    switch (c)
+    {
+    case ECS_POSITION:
+        w->x[to] = w->x[from];
+        w->y[to] = w->y[from];
+        break;
+    case ECS_VELOCITY:
+        w->dx[to] = w->dx[from];
+        w->dy[to] = w->dy[from];
+        break;
+    case ECS_KIND:
+        w->kind[to] = w->kind[from];
+        break;
+    case ECS_LIFETIME:
+        w->lifetime[to] = w->lifetime[from];
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Retire le composant `c` de l'index `i` (présent) : la dernière place comble le trou.
+ */
+static void set_remove(EcsWorld *w, int i, EcsComponent c)
+{
+    EcsSet *s = &w->sets[c];
+    int p = s->sparse[i], last = --s->count;
+    if (p != last)
+    {
+        int moved = s->dense[last];
+        s->dense[p] = (int8_t)moved;
+        s->sparse[moved] = (int8_t)p;
+        move_slot(w, c, p, last);
+    }
+    s->sparse[i] = -1;
+    w->mask[i] &= ~ECS_BIT(c);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Les index sont empilés à l'envers : la première entité prend l'index 0.
+ */
+void ecs_clear(EcsWorld *w)
+{
+    for (int i = 0; i < ECS_MAX_ENTITIES; i++)
+    {
+        w->mask[i] = 0;
+        if (w->generation[i] == 0)
+            w->generation[i] = 1;
+        w->free_ids[i] = (int8_t)(ECS_MAX_ENTITIES - 1 - i);
+    }
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++)
+    {
+        memset(w->sets[c].sparse, 0xFF, sizeof(w->sets[c].sparse));
+        w->sets[c].count = 0;
+    }
+    w->free_count = ECS_MAX_ENTITIES;
+    w->alive = 0;
+    w->dropped = 0;
+}
+
+/**
+ * @brief Dépile un index libre.
+ */
+EcsEntity ecs_create(EcsWorld *w)
+{
+    if (w->free_count == 0)
+    {
+        w->dropped++;
+        return ECS_NONE;
+    }
+    int i = w->free_ids[--w->free_count];
+    w->mask[i] = ECS_ALIVE;
+    w->alive++;
+    return (EcsEntity)(i | w->generation[i] << 8);
+}
+
+/**
+ * @brief Retire chaque composant, change la génération, rend l'index à la pile.
+ */
+void ecs_destroy(EcsWorld *w, EcsEntity e)
+{
+    if (!ecs_alive(w, e))
+        return;
+    int i = ECS_INDEX(e);
+    for (EcsMask m = w->mask[i] & ~ECS_ALIVE; m; m &= m - 1)
+        set_remove(w, i, (EcsComponent)__builtin_ctz(m));
+    w->mask[i] = 0;
+    w->generation[i] = (uint8_t)(w->generation[i] + 1);
+    if (w->generation[i] == 0)
+        w->generation[i] = 1;
+    w->free_ids[w->free_count++] = (int8_t)i;
+    w->alive--;
+}
+
+/**
+ * @brief Index vivant et même génération.
+ */
+bool ecs_alive(const EcsWorld *w, EcsEntity e)
+{
+    int i = ECS_INDEX(e);
+    return e != ECS_NONE && i < ECS_MAX_ENTITIES && (w->mask[i] & ECS_ALIVE) && w->generation[i] == ECS_GEN(e);
+}
+
+/**
+ * @brief Index et génération courante.
+ */
+EcsEntity ecs_entity(const EcsWorld *w, int i)
+{
+    return (EcsEntity)(i | w->generation[i] << 8);
+}
+
+/**
+ * @brief Nouvelle place au bout de l'ensemble du composant.
+ */
+int ecs_add(EcsWorld *w, EcsEntity e, EcsComponent c)
+{
+    if (!ecs_alive(w, e))
+        return -1;
+    int i = ECS_INDEX(e);
+    EcsSet *s = &w->sets[c];
+    if (s->sparse[i] >= 0)
+        return s->sparse[i];
+    int p = s->count++;
+    s->dense[p] = (int8_t)i;
+    s->sparse[i] = (int8_t)p;
+    w->mask[i] |= ECS_BIT(c);
+    clear_slot(w, c, p);
+    return p;
+}
+
+/**
+ * @brief Sans effet si l'entité est morte ou n'a pas le composant.
+ */
+void ecs_remove(EcsWorld *w, EcsEntity e, EcsComponent c)
+{
+    if (ecs_alive(w, e) && w->sets[c].sparse[ECS_INDEX(e)] >= 0)
+        set_remove(w, ECS_INDEX(e), c);
+}
+
+/**
+ * @brief Contrôle de génération, puis lecture de `sparse`.
+ */
+int ecs_get(const EcsWorld *w, EcsEntity e, EcsComponent c)
+{
+    return ecs_alive(w, e) ? w->sets[c].sparse[ECS_INDEX(e)] : -1;
+}
+
+/**
+ * @brief Le plus petit ensemble demandé, filtré par le masque de chaque entité.
+ */
+int ecs_query(const EcsWorld *w, EcsMask mask, short *out)
+{
+    int n = 0;
+    if (mask == 0)
+    {
+        for (int i = 0; i < ECS_MAX_ENTITIES; i++)
+            if (w->mask[i] & ECS_ALIVE)
+                out[n++] = (short)i;
+        return n;
+    }
+
+    const EcsSet *best = NULL;
+    for (EcsMask m = mask; m; m &= m - 1)
+    {
+        const EcsSet *s = &w->sets[__builtin_ctz(m)];
+        if (!best || s->count < best->count)
+            best = s;
+    }
+    for (int k = 0; k < best->count; k++)
+    {
+        int i = best->dense[k];
+        if ((w->mask[i] & mask) == mask)
+            out[n++] = (short)i;
+    }
+    return n;
+}
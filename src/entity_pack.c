@@ -0,0 +1,116 @@
+/**
+ * @file entity_pack.c
+ * @brief Implémentation du format compact des entités.
+ */
+
+#include "entity_pack.h"
+
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Sprite d'animation (0 à 3) vers ses bits de drapeaux.
+ */
+static uint8_t pack_frame(int frame)
+{
+    return (uint8_t)((frame << PACK_FRAME_SHIFT) & PACK_FLAG_FRAME);
+}
+
+/**
+ * @brief Remplit une entité compacte.
+ */
+static PackedEntity pack(float x, float y, EntityType type, uint8_t flags)
+{
+    return (PackedEntity){entity_pack_coord(x), entity_pack_coord(y), (uint8_t)type, flags};
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Coordonnée logique vers Q10.6 (arrondi au plus proche, bornée à int16).
+ */
+int16_t entity_pack_coord(float v)
+{
+    float f = roundf(v * PACK_SCALE);
+    if (f > INT16_MAX)
+        f = INT16_MAX;
+    if (f < INT16_MIN)
+        f = INT16_MIN;
+    return (int16_t)f;
+}
+
+/**
+ * @brief Q10.6 vers coordonnée logique.
+ */
+float entity_unpack_coord(int16_t v)
+{
+    return (float)v / PACK_SCALE;
+}
+
+/**
+ * @brief Compacte une entité.
+ */
+void entity_pack(const Entity *e, PackedEntity *out)
+{
+    uint8_t flags = (e->active ? PACK_FLAG_ACTIVE : 0) | (e->exploding ? PACK_FLAG_EXPLODING : 0) |
+                    pack_frame(e->anim_frame);
+    *out = pack(e->x, e->y, e->type, flags);
+}
+
+/**
+ * @brief Reconstitue une entité.
+ */
+void entity_unpack(const PackedEntity *p, Entity *out)
+{
+    memset(out, 0, sizeof(Entity));
+    out->x = entity_unpack_coord(p->x);
+    out->y = entity_unpack_coord(p->y);
+    out->type = (EntityType)p->type;
+    out->width = entity_type_width(out->type);
+    out->height = entity_type_height(out->type);
+    out->active = (p->flags & PACK_FLAG_ACTIVE) != 0;
+    out->exploding = (p->flags & PACK_FLAG_EXPLODING) != 0;
+    out->anim_frame = (p->flags & PACK_FLAG_FRAME) >> PACK_FRAME_SHIFT;
+}
+
+/**
+ * @brief Joueur, aliens de la liste active, balles de la liste active, OVNI.
+ *
+ * Les aliens vivants prennent la frame globale de la vague (animation_frame),
+ * comme à l'affichage.
+ */
+int model_pack_entities(const GameModel *model, PackedEntity *out, int cap)
+{
+    const SimState *s = &model->sim;
+    int n = 0;
+
+    if (s->player.active && n < cap)
+        out[n++] = pack(s->player.x, s->player.y, ENTITY_PLAYER, PACK_FLAG_ACTIVE);
+
+    const EnemyPool *e = &s->enemies;
+    uint8_t frame = pack_frame(s->animation_frame);
+    for (int k = 0; k < e->live.count && n < cap; k++)
+    {
+        int i = e->live.items[k];
+        bool dying = (s->formation.dying_mask >> i) & 1;
+        out[n++] = pack(model_get_enemy_x(model, i), model_get_enemy_y(model, i), e->type[i],
+                        PACK_FLAG_ACTIVE | (dying ? PACK_FLAG_EXPLODING : frame));
+    }
+
+    const BulletPool *p = &s->bullets;
+    for (int k = 0; k < p->live.count && n < cap; k++)
+    {
+        int i = p->live.items[k];
+        out[n++] = pack(p->x[i], p->y[i], p->type[i], PACK_FLAG_ACTIVE | pack_frame(p->anim_frame[i]));
+    }
+
+    if (s->ufo.active && n < cap)
+        out[n++] = pack(s->ufo.x, s->ufo.y, ENTITY_UFO, PACK_FLAG_ACTIVE | (s->ufo.exploding ? PACK_FLAG_EXPLODING : 0));
+    return n;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file entity_type.c
+ * @brief Table des types d'entités.
+ */
+
+#include "entity_type.h"
+
+// ============================================================================
+//                          1. TABLE
+// ============================================================================
+
+const EntityTypeInfo entity_types[ENTITY_TYPE_COUNT] = {
+    [ENTITY_PLAYER] = {PLAYER_WIDTH, PLAYER_HEIGHT, 0, 0, 2, 0x00FF00, 0.0f},
+    [ENTITY_BULLET_PLAYER] = {BULLET_WIDTH, BULLET_HEIGHT, 0, 0, 3, 0xFFFF00, 0.0f},
+    [ENTITY_BULLET_ENEMY] = {BULLET_WIDTH, BULLET_HEIGHT, 0, 1, 3, 0xFFFF00, 0.0f},
+    [ENTITY_ENEMY_TYPE_1] = {ENEMY_WIDTH, ENEMY_HEIGHT, 10, 0, 1, 0x00FFFF, 0.2f},
+    [ENTITY_ENEMY_TYPE_2] = {ENEMY_WIDTH, ENEMY_HEIGHT, 20, 1, 6, 0xFFA500, 0.2f},
+    [ENTITY_ENEMY_TYPE_3] = {ENEMY_WIDTH, ENEMY_HEIGHT, 30, 2, 5, 0xFF3232, 0.2f},
+    [ENTITY_UFO] = {UFO_WIDTH, UFO_HEIGHT, 100, 0, 1, 0xFF00FF, 0.5f},
+    [ENTITY_POWERUP_RAPID] = {POWERUP_WIDTH, POWERUP_HEIGHT, 0, 0, 1, 0xFF5050, 0.0f, 'R'},
+    [ENTITY_POWERUP_SPREAD] = {POWERUP_WIDTH, POWERUP_HEIGHT, 0, 0, 6, 0x50C8FF, 0.0f, 'T'},
+    [ENTITY_POWERUP_REPAIR] = {POWERUP_WIDTH, POWERUP_HEIGHT, 0, 0, 2, 0x50FF50, 0.0f, 'B'},
+    [ENTITY_BOSS_PART] = {BOSS_PART_WIDTH, BOSS_PART_HEIGHT, 25, 0, 7, 0xB4B4D2, 0.0f, '#'},
+};
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Largeur de la hitbox d'un type (0 pour un type inconnu).
+ */
+int entity_type_width(EntityType type)
+{
+    return ((int)type >= 0 && (int)type < ENTITY_TYPE_COUNT) ? entity_types[type].width : 0;
+}
+
+/**
+ * @brief Hauteur de la hitbox d'un type (0 pour un type inconnu).
+ */
+int entity_type_height(EntityType type)
+{
+    return ((int)type >= 0 && (int)type < ENTITY_TYPE_COUNT) ? entity_types[type].height : 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file env.c
+ * @brief Implémentation de l'environnement d'apprentissage par renforcement.
+ */
+
+#include "env.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Un environnement : le modèle simulé et son état au sortir de model_init.
+ */
+struct Env
+{
+    GameModel *model; ///< Partie en cours.
+    GameModel *fresh; ///< Modèle neuf, recopié à chaque env_reset (aucune allocation).
+};
+
+/**
+ * @brief Marque les cases couvertes par une boîte (rognée au terrain), la plus grande valeur gagnant.
+ */
+static void fill_box(uint8_t *grid, float x, float y, float w, float h, uint8_t v)
+{
+    int x0 = (int)floorf(x), x1 = (int)ceilf(x + w);
+    int y0 = (int)floorf(y), y1 = (int)ceilf(y + h);
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 > ENV_OBS_WIDTH)
+        x1 = ENV_OBS_WIDTH;
+    if (y1 > ENV_OBS_HEIGHT)
+        y1 = ENV_OBS_HEIGHT;
+    for (int r = y0; r < y1; r++)
+    {
+        uint8_t *row = grid + r * ENV_OBS_WIDTH;
+        for (int c = x0; c < x1; c++)
+            if (row[c] < v)
+                row[c] = v;
+    }
+}
+
+/**
+ * @brief Ajoute une entité à la liste si elle a encore de la place.
+ */
+static void push_entity(EnvEntity *out, int cap, int *n, uint8_t kind, uint8_t value, float x, float y)
+{
+    if (*n < cap)
+        out[*n] = (EnvEntity){kind, value, x, y};
+    (*n)++;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Alloue le modèle de travail et son modèle neuf.
+ */
+Env *env_create(void)
+{
+    Env *env = calloc(1, sizeof(Env));
+    if (!env)
+        return NULL;
+    env->fresh = model_init();
+    env->model = env->fresh ? model_clone(env->fresh) : NULL;
+    if (!env->model)
+    {
+        env_free(env);
+        return NULL;
+    }
+    return env;
+}
+
+/**
+ * @brief Libère les deux modèles.
+ */
+void env_free(Env *env)
+{
+    if (!env)
+        return;
+    model_free(env->model);
+    model_free(env->fresh);
+    free(env);
+}
+
+/**
+ * @brief Repart du modèle neuf, fixe la graine, puis lance la partie par le menu (comme headless_run).
+ */
+void env_reset(Env *env, uint64_t seed)
+{
+    model_copy(env->model, env->fresh);
+    model_rng_seed(env->model, seed);
+    env->model->sim.state = STATE_MENU;
+    env->model->ui.menu_selection = 0; // "JOUER"
+    model_handle_input(env->model, CMD_RETURN);
+}
+
+/**
+ * @brief Touches maintenues, un tick, points marqués.
+ */
+EnvStep env_step(Env *env, unsigned action)
+{
+    GameModel *model = env->model;
+    int score = model->sim.score;
+    model_handle_input(model, command_held(action & INPUT_MASK));
+    model_update(model, 1.0 / TARGET_FPS);
+    return (EnvStep){(float)(model->sim.score - score), model->sim.state == STATE_GAME_OVER};
+}
+
+/**
+ * @brief Par lots de MODEL_BATCH_WORLDS : scores avant, model_step_batch, écarts.
+ */
+void env_step_many(Env **envs, const unsigned *actions, int n, EnvStep *out)
+{
+    GameModel *models[MODEL_BATCH_WORLDS];
+    GameCommand cmds[MODEL_BATCH_WORLDS];
+    int scores[MODEL_BATCH_WORLDS];
+    for (int first = 0; first < n; first += MODEL_BATCH_WORLDS)
+    {
+        int count = (n - first < MODEL_BATCH_WORLDS) ? n - first : MODEL_BATCH_WORLDS;
+        for (int k = 0; k < count; k++)
+        {
+            models[k] = envs[first + k]->model;
+            cmds[k] = command_held(actions[first + k] & INPUT_MASK);
+            scores[k] = models[k]->sim.score;
+        }
+        model_step_batch(models, cmds, count, 1.0 / TARGET_FPS);
+        for (int k = 0; k < count; k++)
+            out[first + k] = (EnvStep){(float)(models[k]->sim.score - scores[k]), models[k]->sim.state == STATE_GAME_OVER};
+    }
+}
+
+/**
+ * @brief Grille vide, puis boucliers, aliens vivants, OVNI, joueur et balles.
+ */
+void env_observe(const Env *env, uint8_t *buffer)
+{
+    const GameModel *model = env->model;
+    memset(buffer, ENV_CELL_EMPTY, ENV_OBS_SIZE);
+
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        const Shield *sh = &model->sim.shields[s];
+        if (!sh->active)
+            continue;
+        if (!model->sim.shield_bitmap)
+        {
+            fill_box(buffer, sh->x, sh->y, sh->width, sh->height, ENV_CELL_SHIELD);
+            continue;
+        }
+        // En bitmap : seules les cases qui gardent des cellules intactes
+        for (int y = (int)floorf(sh->y); y < sh->y + sh->height; y++)
+            for (int x = (int)floorf(sh->x); x < sh->x + sh->width; x++)
+                if (model_shield_cells(sh, (float)x, (float)y, 1.0f, 1.0f) > 0)
+                    fill_box(buffer, (float)x, (float)y, 1.0f, 1.0f, ENV_CELL_SHIELD);
+    }
+
+    const short *idx;
+    int count = model_get_live_enemies(model, &idx);
+    for (int k = 0; k < count; k++)
+    {
+        Entity e;
+        if (model_get_enemy(model, idx[k], &e) && !e.exploding)
+            fill_box(buffer, e.x, e.y, ENEMY_WIDTH, ENEMY_HEIGHT, ENV_CELL_ENEMY);
+    }
+
+    if (model->sim.ufo.active && !model->sim.ufo.exploding)
+        fill_box(buffer, model->sim.ufo.x, model->sim.ufo.y, UFO_WIDTH, UFO_HEIGHT, ENV_CELL_UFO);
+    if (model->sim.player.active)
+        fill_box(buffer, model->sim.player.x, model->sim.player.y, PLAYER_WIDTH, PLAYER_HEIGHT, ENV_CELL_PLAYER);
+
+    const BulletPool *p = &model->sim.bullets;
+    for (int k = 0; k < p->live.count; k++)
+    {
+        int i = p->live.items[k];
+        fill_box(buffer, p->x[i], p->y[i], BULLET_WIDTH, BULLET_HEIGHT,
+                 p->type[i] == ENTITY_BULLET_PLAYER ? ENV_CELL_PLAYER_BULLET : ENV_CELL_ENEMY_BULLET);
+    }
+}
+
+/**
+ * @brief N grilles consécutives.
+ */
+void env_observe_many(Env *const *envs, int n, uint8_t *buffer)
+{
+    for (int k = 0; k < n; k++)
+        env_observe(envs[k], buffer + (size_t)k * ENV_OBS_SIZE);
+}
+
+/**
+ * @brief Liste des entités, dans l'ordre joueur, aliens, balles, boucliers, OVNI.
+ */
+int env_observe_entities(const Env *env, EnvEntity *out, int cap)
+{
+    const GameModel *model = env->model;
+    int n = 0;
+    if (model->sim.player.active)
+        push_entity(out, cap, &n, ENV_CELL_PLAYER, 0, model->sim.player.x, model->sim.player.y);
+
+    const short *idx;
+    int count = model_get_live_enemies(model, &idx);
+    for (int k = 0; k < count; k++)
+    {
+        Entity e;
+        if (model_get_enemy(model, idx[k], &e) && !e.exploding)
+            push_entity(out, cap, &n, ENV_CELL_ENEMY, (uint8_t)(e.type - ENTITY_ENEMY_TYPE_1 + 1), e.x, e.y);
+    }
+
+    const BulletPool *p = &model->sim.bullets;
+    for (int k = 0; k < p->live.count; k++)
+    {
+        int i = p->live.items[k];
+        push_entity(out, cap, &n, p->type[i] == ENTITY_BULLET_PLAYER ? ENV_CELL_PLAYER_BULLET : ENV_CELL_ENEMY_BULLET,
+                    0, p->x[i], p->y[i]);
+    }
+
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        const Shield *sh = &model->sim.shields[s];
+        if (sh->active)
+            push_entity(out, cap, &n, ENV_CELL_SHIELD, (uint8_t)sh->health, sh->x, sh->y);
+    }
+    if (model->sim.ufo.active && !model->sim.ufo.exploding)
+        push_entity(out, cap, &n, ENV_CELL_UFO, 0, model->sim.ufo.x, model->sim.ufo.y);
+    return n < cap ? n : cap;
+}
+
+/**
+ * @brief Modèle simulé.
+ */
+const GameModel *env_model(const Env *env)
+{
+    return env->model;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file flightrec.c
+ * @brief Implémentation de l'enregistreur de vol.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour sigaction et localtime_r).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "flightrec.h"
+#include "replay.h"
+#include "save.h"
+#include "workset.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define FLIGHT_DIR "sauvegardes" ///< Dossier des vidages.
+
+/** @brief Signaux fatals qui déclenchent un vidage. */
+static const int fatal_signals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+#define FATAL_SIGNAL_COUNT ((int)(sizeof(fatal_signals) / sizeof(fatal_signals[0])))
+
+/** @brief Enregistreur vidé par le gestionnaire de signal. */
+static FlightRecorder *active_recorder = NULL;
+
+/** @brief Gestionnaires en place avant flight_init, rendus par flight_close. */
+static struct sigaction old_actions[FATAL_SIGNAL_COUNT];
+
+/** @brief Vidage demandé (flight_request_dump), lu et remis à zéro en fin d'image. */
+static int dump_requested = 0;
+
+/**
+ * @brief Signal fatal : vidage au mieux, puis effet par défaut du signal.
+ *
+ * Ni fopen ni snprintf ne sont sûrs dans un gestionnaire de signal : le
+ * processus meurt de toute façon, l'écriture est tentée telle quelle. Le
+ * signal reprend son effet par défaut dès l'entrée : un second crash pendant
+ * le vidage termine le processus.
+ */
+static void on_fatal_signal(int sig)
+{
+    signal(sig, SIG_DFL);
+    FlightRecorder *fr = active_recorder;
+    active_recorder = NULL;
+    if (fr)
+    {
+        char reason[32];
+        snprintf(reason, sizeof(reason), "signal %d", sig);
+        if (flight_dump(fr, NULL, reason))
+            fprintf(stderr, "\n[VOL] %s : enregistrement dans %s\n", reason, fr->last_dump);
+    }
+    raise(sig);
+}
+
+/**
+ * @brief Encode un instantané du modèle dans le tampon suivant.
+ *
+ * La taille reste à 0 pendant l'écriture : un crash au milieu ne vide jamais
+ * un tampon incomplet.
+ */
+static void take_snapshot(FlightRecorder *fr, const GameModel *model)
+{
+    FlightSnapshot *s = &fr->snapshots[fr->next_slot];
+    s->size = 0;
+    size_t n = save_encode_snapshot(model, s->data, fr->snapshot_cap);
+    s->frame = fr->frames;
+    s->size = n;
+    fr->next_slot = (fr->next_slot + 1) % FLIGHT_SNAPSHOTS;
+}
+
+/**
+ * @brief Plus ancien instantané dont toutes les frames suivantes sont encore dans l'anneau.
+ */
+static const FlightSnapshot *oldest_snapshot(const FlightRecorder *fr)
+{
+    const FlightSnapshot *best = NULL;
+    for (int k = 0; k < FLIGHT_SNAPSHOTS; k++)
+    {
+        const FlightSnapshot *s = &fr->snapshots[k];
+        if (s->size > 0 && fr->frames - s->frame <= FLIGHT_FRAMES && (!best || s->frame < best->frame))
+            best = s;
+    }
+    return best;
+}
+
+/**
+ * @brief Rapport texte : cause, départ, puis une ligne par frame.
+ */
+static void write_report(const FlightRecorder *fr, const GameModel *model, const char *path, const char *reason,
+                         uint64_t first, int open_updates)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return;
+    fprintf(f, "# Enregistreur de vol : %s\n", reason);
+    fprintf(f, "# Graine 0x%llx, frames %llu a %llu (%s)\n", (unsigned long long)fr->seed,
+            (unsigned long long)first, (unsigned long long)fr->frames,
+            first > 0 ? "depuis un instantane" : "depuis le debut");
+    fprintf(f, "# frame commande ticks rng image_ms travail_ms\n");
+    for (uint64_t i = first; i < fr->frames; i++)
+    {
+        const FlightFrame *e = &fr->ring[i % FLIGHT_FRAMES];
+        fprintf(f, "%llu %u %u 0x%016llx %.2f %.2f\n", (unsigned long long)(i - first), e->cmd, e->updates,
+                (unsigned long long)e->rng, e->frame_ms, e->work_ms);
+    }
+    if (fr->open && model)
+        fprintf(f, "%llu %u %d 0x%016llx %.2f %.2f\n", (unsigned long long)(fr->frames - first), fr->open_cmd,
+                open_updates, (unsigned long long)model->sim.rng.state, fr->frame_ms, fr->work_ms);
+    else if (fr->open)
+        fprintf(f, "%llu %u %d - - -%s\n", (unsigned long long)(fr->frames - first), fr->open_cmd, open_updates,
+                fr->in_tick ? " (tick en cours)" : "");
+    if (model)
+    {
+        fprintf(f, "# RNG final : 0x%016llx\n", (unsigned long long)model->sim.rng.state);
+        fprintf(f, "# Empreinte : 0x%08x\n", (unsigned)save_fingerprint(model));
+    }
+    fclose(f);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Tampons à la taille d'une sauvegarde de ce modèle, gestionnaires des signaux fatals.
+ */
+bool flight_init(FlightRecorder *fr, const GameModel *model)
+{
+    memset(fr, 0, sizeof(FlightRecorder));
+    const char *env = getenv("SPACE_INVADERS_FLIGHT");
+    if (env && strcmp(env, "0") == 0)
+        return false;
+
+    fr->snapshot_cap = 8192 + (size_t)model->sim.bullets.capacity * SAVE_BULLET_SIZE;
+    for (int k = 0; k < FLIGHT_SNAPSHOTS; k++)
+    {
+        fr->snapshots[k].data = workset_alloc(fr->snapshot_cap);
+        if (!fr->snapshots[k].data)
+        {
+            flight_close(fr);
+            return false;
+        }
+    }
+    fr->seed = model->sim.rng.seed;
+    fr->flags = replay_session_flags(model);
+    fr->hz = model_tick_rate(model);
+    fr->next_snapshot = 0;
+    const char *hitch_env = getenv("SPACE_INVADERS_FLIGHT_HITCH_MS");
+    fr->hitch_ms = hitch_env ? (float)atof(hitch_env) : FLIGHT_HITCH_MS;
+    fr->next_hitch = FLIGHT_SNAPSHOT_FRAMES; // Pas de vidage sur les images du démarrage
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_fatal_signal;
+    sigemptyset(&sa.sa_mask);
+    for (int k = 0; k < FATAL_SIGNAL_COUNT; k++)
+        sigaction(fatal_signals[k], &sa, &old_actions[k]);
+    active_recorder = fr;
+    fr->active = true;
+    return true;
+}
+
+/**
+ * @brief Clôt la frame ouverte dans l'anneau, prend l'instantané dû, ouvre la suivante.
+ */
+void flight_record_command(FlightRecorder *fr, const GameModel *model, GameCommand cmd)
+{
+    if (!fr->active)
+        return;
+    if (fr->open)
+    {
+        FlightFrame *e = &fr->ring[fr->frames % FLIGHT_FRAMES];
+        e->rng = model->sim.rng.state;
+        e->frame_ms = fr->frame_ms;
+        e->work_ms = fr->work_ms;
+        e->cmd = fr->open_cmd;
+        e->updates = (uint8_t)fr->open_updates;
+        fr->frames++;
+    }
+    // Instantané dû : seulement en partie (les menus dépendent du disque et de la saisie)
+    if (fr->frames >= fr->next_snapshot && model->sim.state == STATE_PLAYING)
+    {
+        take_snapshot(fr, model);
+        fr->next_snapshot = fr->frames + FLIGHT_SNAPSHOT_FRAMES;
+    }
+    fr->open = true;
+    fr->open_cmd = (uint8_t)cmd;
+    fr->open_updates = 0;
+}
+
+/**
+ * @brief Note les durées, puis vide sur une image lente (hors délai de garde) ou à la demande.
+ */
+void flight_record_timing(FlightRecorder *fr, const GameModel *model, double frame_s, double work_s)
+{
+    if (!fr->active)
+        return;
+    fr->frame_ms = (float)(frame_s * 1000.0);
+    fr->work_ms = (float)(work_s * 1000.0);
+    if (__atomic_exchange_n(&dump_requested, 0, __ATOMIC_ACQ_REL))
+    {
+        flight_dump(fr, model, "touche");
+    }
+    else if (fr->hitch_ms > 0 && fr->frame_ms > fr->hitch_ms && fr->frames >= fr->next_hitch &&
+             fr->dumps < FLIGHT_MAX_DUMPS)
+    {
+        char reason[48];
+        snprintf(reason, sizeof(reason), "image lente (%.0f ms)", fr->frame_ms);
+        if (flight_dump(fr, model, reason))
+            fr->next_hitch = fr->frames + FLIGHT_SNAPSHOT_FRAMES;
+    }
+}
+
+/**
+ * @brief Pose le drapeau lu par flight_record_timing.
+ */
+void flight_request_dump(void)
+{
+    __atomic_store_n(&dump_requested, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Instantané le plus ancien couvert (ou départ de session), frames suivantes, frame ouverte.
+ *
+ * La frame ouverte garde les ticks déjà simulés, plus celui en cours si un
+ * crash l'a interrompu : le rejeu refait alors le tick fautif.
+ */
+bool flight_dump(FlightRecorder *fr, const GameModel *model, const char *reason)
+{
+    if (!fr->active)
+        return false;
+
+    // Sans instantané couvert, seul un anneau qui n'a rien perdu se rejoue depuis la graine
+    const FlightSnapshot *snap = oldest_snapshot(fr);
+    uint64_t first = snap ? snap->frame : 0;
+    if (!snap && fr->frames > FLIGHT_FRAMES)
+        return false;
+
+    char stamp[32] = "";
+    time_t now = time(NULL);
+    struct tm tm;
+    if (localtime_r(&now, &tm))
+        strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+    char path[96], report[96];
+    snprintf(path, sizeof(path), FLIGHT_DIR "/vol-%s-%d.rpl", stamp, fr->dumps + 1);
+    snprintf(report, sizeof(report), FLIGHT_DIR "/vol-%s-%d.txt", stamp, fr->dumps + 1);
+    mkdir(FLIGHT_DIR, 0777);
+
+    ReplayRecorder rec;
+    if (!replay_record_open_at(&rec, path, fr->seed, fr->flags, fr->hz, snap ? snap->data : NULL, snap ? snap->size : 0))
+        return false;
+    for (uint64_t i = first; i < fr->frames; i++)
+    {
+        const FlightFrame *e = &fr->ring[i % FLIGHT_FRAMES];
+        replay_record_raw(&rec, (GameCommand)e->cmd, e->updates);
+    }
+    int open_updates = fr->open_updates + (fr->in_tick ? 1 : 0);
+    if (fr->open)
+        replay_record_raw(&rec, (GameCommand)fr->open_cmd, open_updates);
+    replay_record_close(&rec);
+    write_report(fr, model, report, reason, first, open_updates);
+
+    fr->dumps++;
+    snprintf(fr->last_dump, sizeof(fr->last_dump), "%s", path);
+    return true;
+}
+
+/**
+ * @brief Gestionnaires d'origine rendus, tampons libérés.
+ */
+void flight_close(FlightRecorder *fr)
+{
+    if (fr->dumps > 0)
+        printf("Enregistreur de vol : %d vidage(s), dernier dans %s\n", fr->dumps, fr->last_dump);
+    fr->dumps = 0;
+    if (fr->active && active_recorder == fr)
+    {
+        for (int k = 0; k < FATAL_SIGNAL_COUNT; k++)
+            sigaction(fatal_signals[k], &old_actions[k], NULL);
+        active_recorder = NULL;
+    }
+    for (int k = 0; k < FLIGHT_SNAPSHOTS; k++)
+    {
+        workset_free(fr->snapshots[k].data);
+        fr->snapshots[k].data = NULL;
+        fr->snapshots[k].size = 0;
+    }
+    fr->active = false;
+}
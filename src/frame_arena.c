@@ -0,0 +1,106 @@
+/**
+ * @file frame_arena.c
+ * @brief Implémentation de l'arène d'image (découpage à la suite, remise à zéro par image).
+ */
+
+#include "frame_arena.h"
+#include "workset.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Bloc pris dans la mémoire de jeu (calloc si elle est pleine ou absente).
+ */
+bool frame_arena_init(FrameArena *a, size_t bytes)
+{
+    memset(a, 0, sizeof(FrameArena));
+    return frame_arena_reserve(a, bytes);
+}
+
+/**
+ * @brief Nouveau bloc plus grand, l'ancien rendu (rien n'y vit en début d'image).
+ */
+bool frame_arena_reserve(FrameArena *a, size_t bytes)
+{
+    if (bytes <= a->capacity)
+        return true;
+    if (a->used > 0)
+        return false;
+    uint8_t *base = workset_alloc(bytes);
+    if (!base)
+        return false;
+    workset_free(a->base);
+    a->base = base;
+    a->capacity = bytes;
+    return true;
+}
+
+/**
+ * @brief Note l'utilisation de l'image finie, puis repart du début du bloc.
+ */
+void frame_arena_reset(FrameArena *a)
+{
+    a->last = a->used;
+    if (a->used > a->peak)
+        a->peak = a->used;
+    a->used = 0;
+    a->frames++;
+}
+
+/**
+ * @brief Arrondi à l'alignement, puis avance de la position courante.
+ */
+void *frame_arena_alloc(FrameArena *a, size_t bytes)
+{
+    size_t start = (a->used + FRAME_ARENA_ALIGN - 1) & ~(size_t)(FRAME_ARENA_ALIGN - 1);
+    if (!a->base || start > a->capacity || bytes > a->capacity - start)
+    {
+        a->overflows++;
+        return NULL;
+    }
+    a->used = start + bytes;
+    return a->base + start;
+}
+
+/**
+ * @brief Écrit directement dans la place restante, puis ne garde que la longueur utile.
+ */
+char *frame_arena_vprintf(FrameArena *a, const char *fmt, va_list args)
+{
+    size_t start = (a->used + FRAME_ARENA_ALIGN - 1) & ~(size_t)(FRAME_ARENA_ALIGN - 1);
+    size_t room = (a->base && start < a->capacity) ? a->capacity - start : 0;
+    int len = vsnprintf(room > 0 ? (char *)a->base + start : NULL, room, fmt, args);
+    if (len < 0 || (size_t)len >= room)
+    {
+        a->overflows++;
+        return NULL;
+    }
+    a->used = start + (size_t)len + 1;
+    return (char *)a->base + start;
+}
+
+/**
+ * @brief Arguments variables passés à frame_arena_vprintf.
+ */
+char *frame_arena_printf(FrameArena *a, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    char *s = frame_arena_vprintf(a, fmt, args);
+    va_end(args);
+    return s;
+}
+
+/**
+ * @brief Bloc rendu à la mémoire de jeu.
+ */
+void frame_arena_free(FrameArena *a)
+{
+    workset_free(a->base);
+    memset(a, 0, sizeof(FrameArena));
+}
@@ -0,0 +1,377 @@
+/**
+ * @file gputime.c
+ * @brief Implémentation de la mesure du GPU (horodatages OpenGL, barrières SDL_GPU).
+ */
+
+#include "gputime.h"
+
+#include <SDL3/SDL_opengl.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "utils.h"
+
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+/** @brief glGetIntegerv, chargée comme les autres (le jeu n'est pas lié à libGL). */
+typedef void(APIENTRYP GetIntegervProc)(GLenum pname, GLint *data);
+
+// ============================================================================
+//                          1. ÉTAT
+// ============================================================================
+
+/**
+ * @brief Méthodes de mesure.
+ */
+typedef enum
+{
+    METHOD_NONE,   ///< Pilote sans mesure.
+    METHOD_GL,     ///< Horodatages OpenGL (glQueryCounter).
+    METHOD_FENCES  ///< Barrières SDL_GPU attendues par un thread.
+} GpuTimeMethod;
+
+/**
+ * @brief Une image horodatée (OpenGL) : une paire de requêtes par lot.
+ */
+typedef struct
+{
+    GLuint queries[GPUTIME_SEGMENTS][2]; ///< Début et fin de chaque lot.
+    int segments;                        ///< Lots horodatés.
+} GlFrame;
+
+/**
+ * @brief Une barrière en vol (SDL_GPU).
+ */
+typedef struct
+{
+    SDL_GPUFence *fence; ///< Signalée quand le GPU a fini l'image.
+    uint64_t submitted;  ///< Début de la présentation (utils_fast_ns).
+} FenceSlot;
+
+static struct
+{
+    GpuTimeMethod method;
+    SDL_Renderer *renderer;
+    bool open_frame; ///< Un emplacement est réservé pour l'image en cours.
+    int head;        ///< Plus ancien emplacement en vol.
+    int count;       ///< Emplacements en vol.
+    uint64_t measured, skipped;
+
+    // OpenGL
+    bool gles;                ///< EXT_disjoint_timer_query : résultats invalidables.
+    GlFrame frames[GPUTIME_LATENCY];
+    int64_t offset;           ///< utils_fast_ns - horloge du GPU (ns).
+    int calibrate_in;         ///< Images avant le prochain recalage.
+    PFNGLGENQUERIESPROC GenQueries;
+    PFNGLDELETEQUERIESPROC DeleteQueries;
+    PFNGLQUERYCOUNTERPROC QueryCounter;
+    PFNGLGETQUERYOBJECTIVPROC GetQueryObjectiv;
+    PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v;
+    PFNGLGETINTEGER64VPROC GetInteger64v;
+    GetIntegervProc GetIntegerv;
+
+    // SDL_GPU
+    SDL_GPUDevice *device;
+    SDL_Thread *thread;
+    SDL_Mutex *lock;
+    SDL_Condition *wake;
+    bool quit;
+    FenceSlot fences[GPUTIME_LATENCY];
+    uint64_t present_start; ///< Début de la présentation en cours.
+    uint64_t last_done;     ///< Fin de l'image précédente sur le GPU (thread des barrières).
+} gt;
+
+// ============================================================================
+//                          2. OPENGL
+// ============================================================================
+
+/**
+ * @brief Charge une fonction, sous son nom d'extension en OpenGL ES.
+ */
+static void *gl_proc(const char *name)
+{
+    char ext[64];
+    SDL_snprintf(ext, sizeof(ext), "%s%s", name, gt.gles ? "EXT" : "");
+    return (void *)SDL_GL_GetProcAddress(ext);
+}
+
+/**
+ * @brief Lit l'heure du GPU et la rapporte à utils_fast_ns (les horloges dérivent lentement).
+ */
+static void gl_calibrate(void)
+{
+    GLint64 gpu = 0;
+    gt.GetInteger64v(GL_TIMESTAMP, &gpu);
+    gt.offset = (int64_t)utils_fast_ns() - (int64_t)gpu;
+    gt.calibrate_in = GPUTIME_CALIBRATE;
+}
+
+/**
+ * @brief Choisit OpenGL si le contexte du renderer a les requêtes d'horodatage.
+ */
+static bool gl_open(const char *driver)
+{
+    gt.gles = strcmp(driver, "opengles2") == 0;
+    if (!SDL_GL_GetCurrentContext() ||
+        !SDL_GL_ExtensionSupported(gt.gles ? "GL_EXT_disjoint_timer_query" : "GL_ARB_timer_query"))
+        return false;
+    gt.GenQueries = (PFNGLGENQUERIESPROC)gl_proc("glGenQueries");
+    gt.DeleteQueries = (PFNGLDELETEQUERIESPROC)gl_proc("glDeleteQueries");
+    gt.QueryCounter = (PFNGLQUERYCOUNTERPROC)gl_proc("glQueryCounter");
+    gt.GetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)gl_proc("glGetQueryObjectiv");
+    gt.GetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)gl_proc("glGetQueryObjectui64v");
+    gt.GetInteger64v = (PFNGLGETINTEGER64VPROC)gl_proc("glGetInteger64v");
+    gt.GetIntegerv = (GetIntegervProc)SDL_GL_GetProcAddress("glGetIntegerv");
+    if (!gt.GenQueries || !gt.DeleteQueries || !gt.QueryCounter || !gt.GetQueryObjectiv || !gt.GetQueryObjectui64v ||
+        !gt.GetInteger64v || !gt.GetIntegerv)
+        return false;
+    for (int i = 0; i < GPUTIME_LATENCY; i++)
+        gt.GenQueries(2 * GPUTIME_SEGMENTS, &gt.frames[i].queries[0][0]);
+    gl_calibrate();
+    return true;
+}
+
+/**
+ * @brief Relit les images dont la dernière requête est prête, de la plus ancienne à la plus récente.
+ */
+static void gl_collect(void)
+{
+    if (gt.gles)
+    {
+        GLint disjoint = 0;
+        gt.GetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        if (disjoint) // Fréquence changée, mise en veille... : résultats en vol inutilisables
+        {
+            gt.skipped += (uint64_t)gt.count;
+            gt.head = (gt.head + gt.count) % GPUTIME_LATENCY;
+            gt.count = 0;
+            gl_calibrate();
+            return;
+        }
+    }
+    while (gt.count > 0)
+    {
+        GlFrame *f = &gt.frames[gt.head];
+        GLint ready = 0;
+        if (f->segments > 0)
+            gt.GetQueryObjectiv(f->queries[f->segments - 1][1], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (f->segments > 0 && !ready)
+            break; // Les suivantes, envoyées après, ne sont pas prêtes non plus
+        uint64_t busy = 0, first = 0;
+        for (int s = 0; s < f->segments; s++)
+        {
+            GLuint64 t0 = 0, t1 = 0;
+            gt.GetQueryObjectui64v(f->queries[s][0], GL_QUERY_RESULT, &t0);
+            gt.GetQueryObjectui64v(f->queries[s][1], GL_QUERY_RESULT, &t1);
+            if (s == 0)
+                first = t0;
+            busy += t1 > t0 ? t1 - t0 : 0;
+        }
+        if (f->segments > 0)
+        {
+            profiler_record_span(PROF_GPU, (uint64_t)((int64_t)first + gt.offset), busy);
+            gt.measured++;
+        }
+        gt.head = (gt.head + 1) % GPUTIME_LATENCY;
+        gt.count--;
+    }
+}
+
+// ============================================================================
+//                          3. SDL_GPU
+// ============================================================================
+
+/**
+ * @brief Thread des barrières : attend chacune dans l'ordre et date sa fin.
+ */
+static int fence_main(void *arg)
+{
+    (void)arg;
+    SDL_LockMutex(gt.lock);
+    for (;;)
+    {
+        while (gt.count == 0 && !gt.quit)
+            SDL_WaitCondition(gt.wake, gt.lock);
+        if (gt.count == 0)
+            break; // Arrêt, plus rien en vol
+        FenceSlot slot = gt.fences[gt.head];
+        SDL_UnlockMutex(gt.lock);
+
+        bool ok = SDL_WaitForGPUFences(gt.device, true, &slot.fence, 1);
+        uint64_t done = utils_fast_ns();
+        SDL_ReleaseGPUFence(gt.device, slot.fence);
+        if (ok)
+        {
+            uint64_t start = slot.submitted > gt.last_done ? slot.submitted : gt.last_done;
+            profiler_record_span(PROF_GPU, start, done > start ? done - start : 0);
+            gt.last_done = done;
+        }
+
+        SDL_LockMutex(gt.lock);
+        if (ok)
+            gt.measured++;
+        else
+            gt.skipped++;
+        gt.head = (gt.head + 1) % GPUTIME_LATENCY; // Emplacement rendu après la mesure
+        gt.count--;
+    }
+    SDL_UnlockMutex(gt.lock);
+    return 0;
+}
+
+/**
+ * @brief Choisit les barrières si le renderer expose son périphérique SDL_GPU.
+ */
+static bool fences_open(void)
+{
+    gt.device = SDL_GetPointerProperty(SDL_GetRendererProperties(gt.renderer), SDL_PROP_RENDERER_GPU_DEVICE_POINTER, NULL);
+    if (!gt.device)
+        return false;
+    gt.lock = SDL_CreateMutex();
+    gt.wake = SDL_CreateCondition();
+    gt.thread = gt.lock && gt.wake ? SDL_CreateThread(fence_main, "gputime", NULL) : NULL;
+    if (gt.thread)
+        return true;
+    SDL_DestroyCondition(gt.wake);
+    SDL_DestroyMutex(gt.lock);
+    return false;
+}
+
+/**
+ * @brief Soumet un tampon vide derrière l'image présentée et confie sa barrière au thread.
+ */
+static void fences_submit(void)
+{
+    SDL_LockMutex(gt.lock);
+    bool full = gt.count == GPUTIME_LATENCY;
+    if (full)
+        gt.skipped++;
+    SDL_UnlockMutex(gt.lock);
+    if (full)
+        return;
+    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(gt.device);
+    SDL_GPUFence *fence = cmd ? SDL_SubmitGPUCommandBufferAndAcquireFence(cmd) : NULL;
+    if (!fence)
+        return;
+    SDL_LockMutex(gt.lock);
+    gt.fences[(gt.head + gt.count) % GPUTIME_LATENCY] = (FenceSlot){fence, gt.present_start};
+    gt.count++;
+    SDL_SignalCondition(gt.wake);
+    SDL_UnlockMutex(gt.lock);
+}
+
+// ============================================================================
+//                          4. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief OpenGL, puis SDL_GPU, selon le pilote.
+ */
+bool gputime_open(SDL_Renderer *renderer)
+{
+    memset(&gt, 0, sizeof(gt));
+    gt.renderer = renderer;
+    const char *driver = SDL_GetRendererName(renderer);
+    if (!driver)
+        return false;
+    if ((strcmp(driver, "opengl") == 0 || strcmp(driver, "opengles2") == 0) && gl_open(driver))
+        gt.method = METHOD_GL;
+    else if (strcmp(driver, SDL_GPU_RENDERER) == 0 && fences_open())
+        gt.method = METHOD_FENCES;
+    return gt.method != METHOD_NONE;
+}
+
+/**
+ * @brief Relit les images prêtes (OpenGL) et réserve l'emplacement de la nouvelle.
+ */
+void gputime_frame_begin(void)
+{
+    gt.open_frame = false;
+    if (gt.method != METHOD_GL || !profiler_enabled() || !SDL_GL_GetCurrentContext())
+        return;
+    gl_collect();
+    if (--gt.calibrate_in <= 0)
+        gl_calibrate();
+    if (gt.count == GPUTIME_LATENCY)
+    {
+        gt.skipped++; // GPU très en retard : image non mesurée, sans attente
+        return;
+    }
+    gt.frames[(gt.head + gt.count) % GPUTIME_LATENCY].segments = 0;
+    gt.open_frame = true;
+}
+
+/**
+ * @brief Horodatage, envoi des commandes en attente, horodatage (OpenGL).
+ */
+void gputime_flush(void)
+{
+    if (!gt.open_frame)
+        return;
+    GlFrame *f = &gt.frames[(gt.head + gt.count) % GPUTIME_LATENCY];
+    if (f->segments == GPUTIME_SEGMENTS)
+        return; // Le lot partira sans horodatage
+    gt.QueryCounter(f->queries[f->segments][0], GL_TIMESTAMP);
+    SDL_FlushRenderer(gt.renderer);
+    gt.QueryCounter(f->queries[f->segments][1], GL_TIMESTAMP);
+    f->segments++;
+}
+
+/**
+ * @brief Dernier lot de l'image (OpenGL), ou début de la présentation (SDL_GPU).
+ */
+void gputime_frame_end(void)
+{
+    if (gt.method == METHOD_FENCES)
+    {
+        gt.present_start = utils_fast_ns();
+        return;
+    }
+    if (!gt.open_frame)
+        return;
+    gputime_flush();
+    if (gt.frames[(gt.head + gt.count) % GPUTIME_LATENCY].segments > 0)
+        gt.count++;
+    gt.open_frame = false;
+}
+
+/**
+ * @brief Barrière de fin d'image (SDL_GPU).
+ */
+void gputime_presented(void)
+{
+    if (gt.method == METHOD_FENCES && profiler_enabled())
+        fences_submit();
+}
+
+/**
+ * @brief Arrêt du thread des barrières, ou suppression des requêtes.
+ */
+void gputime_close(GpuTimeStats *out)
+{
+    if (gt.method == METHOD_FENCES)
+    {
+        SDL_LockMutex(gt.lock);
+        gt.quit = true;
+        SDL_SignalCondition(gt.wake);
+        SDL_UnlockMutex(gt.lock);
+        SDL_WaitThread(gt.thread, NULL);
+        SDL_DestroyCondition(gt.wake);
+        SDL_DestroyMutex(gt.lock);
+    }
+    else if (gt.method == METHOD_GL && SDL_GL_GetCurrentContext())
+    {
+        for (int i = 0; i < GPUTIME_LATENCY; i++)
+            gt.DeleteQueries(2 * GPUTIME_SEGMENTS, &gt.frames[i].queries[0][0]);
+    }
+    if (out)
+    {
+        static const char *const names[] = {NULL, "horodatages GL", "barrieres SDL_GPU"};
+        out->method = names[gt.method];
+        out->measured = gt.measured;
+        out->skipped = gt.skipped;
+    }
+    memset(&gt, 0, sizeof(gt));
+}
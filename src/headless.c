@@ -0,0 +1,185 @@
+/**
+ * @file headless.c
+ * @brief Implémentation du pilote de simulation sans affichage.
+ *
+ * La boucle reprend le pas de temps fixe de main.c mais supprime le rendu,
+ * la lecture clavier et la régulation CPU (sleep) : seul `model_update` compte.
+ */
+
+#include "headless.h"
+#include "save.h"
+#include "simd.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Lance (ou relance) une partie en passant par les vraies commandes du menu.
+ *
+ * On simule la navigation du joueur plutôt que d'appeler reset_game directement :
+ * le Modèle reste une boîte noire et le chemin testé est celui du jeu réel.
+ */
+static void start_game(GameModel *model)
+{
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        GameOverOption opts[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, opts);
+        for (int i = 0; i < count; i++)
+            if (opts[i] == GAME_OVER_REPLAY)
+                model->ui.menu_selection = i; // "REJOUER"
+    }
+    else
+    {
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 0; // "JOUER"
+    }
+    model_handle_input(model, CMD_RETURN);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise une configuration avec les valeurs par défaut.
+ */
+void headless_default_config(HeadlessConfig *cfg)
+{
+    cfg->max_ticks = HEADLESS_DEFAULT_TICKS;
+    cfg->script = HEADLESS_DEFAULT_SCRIPT;
+    cfg->stop_on_game_over = false;
+    cfg->seed = MODEL_RNG_DEFAULT_SEED;
+    cfg->bot = NULL;
+    cfg->stop_level = 0;
+}
+
+/**
+ * @brief Traduit un caractère de script en commande abstraite.
+ */
+GameCommand headless_script_command(char c)
+{
+    switch (c)
+    {
+    case 'L':
+        return CMD_MOVE_LEFT;
+    case 'R':
+        return CMD_MOVE_RIGHT;
+    case 'S':
+        return CMD_SHOOT;
+    default:
+        return CMD_NONE;
+    }
+}
+
+/**
+ * @brief Lance une session de simulation sans affichage.
+ *
+ * Les commandes du script ne sont injectées qu'en STATE_PLAYING : on évite ainsi
+ * de déclencher par accident la pause ou les menus de sauvegarde. Le bot, lui,
+ * est réinitialisé à chaque partie (graine de la session + numéro de partie).
+ */
+void headless_run(GameModel *model, const HeadlessConfig *cfg, HeadlessStats *out)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    const char *script = (cfg->script && cfg->script[0]) ? cfg->script : HEADLESS_DEFAULT_SCRIPT;
+    size_t script_len = strlen(script);
+
+    HeadlessStats stats = {0};
+    Bot bot = {0};
+
+    model_rng_seed(model, cfg->seed);
+    start_game(model);
+    stats.games_played = 1;
+    if (cfg->bot)
+        bot_init(&bot, cfg->bot, cfg->seed);
+
+    double start = utils_get_time();
+
+    for (long tick = 0; tick < cfg->max_ticks; tick++)
+    {
+        // --- A. Fin de partie : arrêt ou relance immédiate ---
+        if (cfg->stop_level > 0 && model->sim.level >= cfg->stop_level)
+            break;
+        if (model->sim.state == STATE_GAME_OVER)
+        {
+            if (cfg->stop_on_game_over)
+                break;
+            for (int side = 0; side < BULLET_SIDES; side++) // Remis à 0 par la relance
+                stats.dropped_bullets[side] += model->sim.bullets.dropped_spawns[side];
+            start_game(model);
+            if (cfg->bot)
+                bot_init(&bot, cfg->bot, cfg->seed + (uint64_t)stats.games_played);
+            stats.games_played++;
+        }
+
+        // --- B. Entrée scriptée (ou décision du bot) ---
+        if (model->sim.state == STATE_PLAYING)
+            model_handle_input(model, cfg->bot ? command_held(bot_decide(&bot, model))
+                                               : headless_script_command(script[tick % script_len]));
+
+        // --- C. Simulation (pas fixe, aucune attente) ---
+        model_update(model, dt);
+
+        stats.ticks++;
+    }
+
+    stats.elapsed = utils_get_time() - start;
+    stats.steps_per_sec = (stats.elapsed > 0.0) ? stats.ticks / stats.elapsed : 0.0;
+    for (int side = 0; side < BULLET_SIDES; side++)
+        stats.dropped_bullets[side] += model->sim.bullets.dropped_spawns[side];
+    stats.seed = cfg->seed;
+    stats.bot = cfg->bot != NULL;
+    stats.fixed_point = model->sim.fixed_point;
+    stats.endless = model->sim.endless;
+    stats.coop = model->sim.coop;
+    stats.fingerprint = save_fingerprint(model);
+    stats.bullet_capacity = model->sim.bullets.capacity;
+    stats.player_slots = model->sim.bullets.player_slots;
+    stats.score = model->sim.score;
+    stats.level = model->sim.level;
+    if (cfg->bot)
+    {
+        stats.plan_nodes = bot.plan_nodes;
+        stats.plan_rate = bot_plan_rate(&bot);
+        stats.plan_decisions = bot.plan_decisions;
+        stats.plan_cutoffs = bot.plan_cutoffs;
+        bot_free(&bot);
+    }
+
+    if (out)
+        *out = stats;
+}
+
+/**
+ * @brief Affiche un résumé des statistiques sur la sortie standard.
+ */
+void headless_print_stats(const HeadlessStats *stats)
+{
+    printf("[HEADLESS] Ticks simules : %ld\n", stats->ticks);
+    printf("[HEADLESS] Temps reel    : %.3f s\n", stats->elapsed);
+    printf("[HEADLESS] Debit         : %.0f steps/s (x%.0f temps reel)\n",
+           stats->steps_per_sec, stats->steps_per_sec / TARGET_FPS);
+    printf("[HEADLESS] Noyaux SIMD   : %s\n", simd_backend_name());
+    printf("[HEADLESS] Entrees       : %s\n", stats->bot ? "bot" : "script");
+    if (stats->plan_nodes > 0)
+        printf("[HEADLESS] Planification : %llu ticks simules, %.0f ticks/s, %u decision(s) dont %u coupee(s)\n",
+               (unsigned long long)stats->plan_nodes, stats->plan_rate, stats->plan_decisions, stats->plan_cutoffs);
+    printf("[HEADLESS] Physique      : %s\n", stats->fixed_point ? "virgule fixe Q16.16" : "flottants");
+    if (stats->endless)
+        printf("[HEADLESS] Vague         : sans fin\n");
+    if (stats->coop)
+        printf("[HEADLESS] Joueurs       : 2 (cooperation)\n");
+    printf("[HEADLESS] Parties       : %d\n", stats->games_played);
+    printf("[HEADLESS] Score final   : %d (niveau %d)\n", stats->score, stats->level);
+    printf("[HEADLESS] Graine        : 0x%llx\n", (unsigned long long)stats->seed);
+    printf("[HEADLESS] Tirs perdus   : %d joueur / %d ennemis (pools de %d + %d balles pleins)\n",
+           stats->dropped_bullets[BULLET_SIDE_PLAYER], stats->dropped_bullets[BULLET_SIDE_ENEMY], stats->player_slots,
+           stats->bullet_capacity - stats->player_slots);
+    printf("[HEADLESS] Empreinte     : 0x%08x\n", (unsigned)stats->fingerprint);
+}
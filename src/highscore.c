@@ -0,0 +1,161 @@
+/**
+ * @file highscore.c
+ * @brief Implémentation de la table des meilleurs scores.
+ */
+
+#include "highscore.h"
+#include "save.h"
+#include "save_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FORMAT DU FICHIER
+// ============================================================================
+
+#define HIGHSCORE_MAGIC "SIHS"   ///< Signature en tête de fichier.
+#define HIGHSCORE_HEADER_SIZE 12 ///< "SIHS" | version u16 | nombre u16 | CRC32 u32.
+#define HIGHSCORE_RECORD_SIZE 16 ///< score i32 | niveau i32 | horodatage i64.
+#define HIGHSCORE_FILE_SIZE (HIGHSCORE_HEADER_SIZE + HIGHSCORE_COUNT * HIGHSCORE_RECORD_SIZE)
+
+/** @brief Écrit un entier little-endian de `n` octets. */
+static void put_le(uint8_t *p, uint64_t v, int n)
+{
+    for (int i = 0; i < n; i++)
+        p[i] = (uint8_t)(v >> (8 * i));
+}
+
+/** @brief Lit un entier little-endian de `n` octets. */
+static uint64_t get_le(const uint8_t *p, int n)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++)
+        v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+/**
+ * @brief Encode la table (en-tête + enregistrements utilisés).
+ * @return Le nombre d'octets écrits.
+ */
+static size_t encode_table(const HighscoreTable *table, uint8_t *buf)
+{
+    uint8_t *rec = buf + HIGHSCORE_HEADER_SIZE;
+    for (int i = 0; i < table->count; i++, rec += HIGHSCORE_RECORD_SIZE)
+    {
+        put_le(rec, (uint32_t)table->entries[i].score, 4);
+        put_le(rec + 4, (uint32_t)table->entries[i].level, 4);
+        put_le(rec + 8, (uint64_t)table->entries[i].timestamp, 8);
+    }
+
+    size_t body = (size_t)table->count * HIGHSCORE_RECORD_SIZE;
+    memcpy(buf, HIGHSCORE_MAGIC, 4);
+    put_le(buf + 4, HIGHSCORE_VERSION, 2);
+    put_le(buf + 6, (uint64_t)table->count, 2);
+    put_le(buf + 8, save_crc32(buf + HIGHSCORE_HEADER_SIZE, body), 4);
+    return HIGHSCORE_HEADER_SIZE + body;
+}
+
+// ============================================================================
+//                          2. TABLE EN MÉMOIRE
+// ============================================================================
+
+/**
+ * @brief Position d'insertion d'un score : premier rang strictement moins bon.
+ */
+static int insert_position(const HighscoreTable *table, int score)
+{
+    int lo = 0, hi = table->count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (table->entries[mid].score >= score)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Rang qu'obtiendrait un score, sans modifier la table.
+ */
+int highscore_rank(const HighscoreTable *table, int score)
+{
+    if (score <= 0)
+        return 0;
+    int pos = insert_position(table, score);
+    return (pos < HIGHSCORE_COUNT) ? pos + 1 : 0;
+}
+
+/**
+ * @brief Insère un score à sa place (recherche dichotomique).
+ */
+int highscore_insert(HighscoreTable *table, int score, int level, int64_t timestamp)
+{
+    int rank = highscore_rank(table, score);
+    if (rank == 0)
+        return 0;
+
+    int pos = rank - 1;
+    int moved = ((table->count < HIGHSCORE_COUNT) ? table->count : HIGHSCORE_COUNT - 1) - pos;
+    memmove(&table->entries[pos + 1], &table->entries[pos], (size_t)moved * sizeof(HighscoreEntry));
+    table->entries[pos].score = score;
+    table->entries[pos].level = level;
+    table->entries[pos].timestamp = timestamp;
+    if (table->count < HIGHSCORE_COUNT)
+        table->count++;
+    table->dirty = true;
+    return rank;
+}
+
+// ============================================================================
+//                          3. PERSISTANCE
+// ============================================================================
+
+/**
+ * @brief Charge la table depuis le disque.
+ */
+bool highscore_load(HighscoreTable *table, const char *dir)
+{
+    memset(table, 0, sizeof(HighscoreTable));
+
+    char path[192];
+    snprintf(path, sizeof(path), "%s/%s", dir, HIGHSCORE_FILE);
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    uint8_t buf[HIGHSCORE_FILE_SIZE + 1];
+    size_t len = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+
+    if (len < HIGHSCORE_HEADER_SIZE || memcmp(buf, HIGHSCORE_MAGIC, 4) != 0 ||
+        get_le(buf + 4, 2) != HIGHSCORE_VERSION)
+        return false;
+    int count = (int)get_le(buf + 6, 2);
+    size_t body = (size_t)count * HIGHSCORE_RECORD_SIZE;
+    if (count > HIGHSCORE_COUNT || len != HIGHSCORE_HEADER_SIZE + body ||
+        save_crc32(buf + HIGHSCORE_HEADER_SIZE, body) != (uint32_t)get_le(buf + 8, 4))
+        return false;
+
+    // Les scores sont réinsérés : une table mal triée ne peut pas casser la dichotomie
+    const uint8_t *rec = buf + HIGHSCORE_HEADER_SIZE;
+    for (int i = 0; i < count; i++, rec += HIGHSCORE_RECORD_SIZE)
+        highscore_insert(table, (int32_t)get_le(rec, 4), (int32_t)get_le(rec + 4, 4), (int64_t)get_le(rec + 8, 8));
+    table->dirty = false;
+    return true;
+}
+
+/**
+ * @brief Demande la réécriture de la table si elle a changé.
+ */
+void highscore_flush(HighscoreTable *table, const char *dir)
+{
+    if (!table->dirty)
+        return;
+    uint8_t buf[HIGHSCORE_FILE_SIZE];
+    size_t len = encode_table(table, buf);
+    if (save_writer_try_submit(SAVE_WRITE_REPLACE, dir, HIGHSCORE_FILE, buf, len))
+        table->dirty = false;
+}
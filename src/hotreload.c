@@ -0,0 +1,286 @@
+/**
+ * @file hotreload.c
+ * @brief Implémentation du rechargement à chaud (inotify, décodage sur le thread de surveillance).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread et poll).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "hotreload.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define HOTRELOAD_POLL_MS 100 ///< Attente maximale d'un événement (relecture du drapeau d'arrêt).
+
+/** @brief Événements surveillés : fichier réécrit, arrivé par renommage, nouveau dossier. */
+#define HOTRELOAD_MASK (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)
+
+/**
+ * @brief Surveille un dossier et, récursivement, ses sous-dossiers.
+ */
+static void watch_tree(HotReload *hot, const char *dir)
+{
+    if (hot->dir_count >= HOTRELOAD_MAX_DIRS)
+    {
+        fprintf(stderr, "Rechargement a chaud : plus de %d dossiers, %s non surveille\n", HOTRELOAD_MAX_DIRS, dir);
+        return;
+    }
+    int wd = inotify_add_watch(hot->fd, dir, HOTRELOAD_MASK);
+    if (wd < 0)
+        return;
+    hot->wds[hot->dir_count] = wd;
+    snprintf(hot->dirs[hot->dir_count], HOTRELOAD_PATH_MAX, "%s", dir);
+    hot->dir_count++;
+
+    DIR *d = opendir(dir);
+    if (!d)
+        return;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL)
+    {
+        if (e->d_name[0] == '.')
+            continue;
+        char path[HOTRELOAD_PATH_MAX];
+        struct stat st;
+        if (snprintf(path, sizeof(path), "%s/%s", dir, e->d_name) < (int)sizeof(path) && stat(path, &st) == 0 &&
+            S_ISDIR(st.st_mode))
+            watch_tree(hot, path);
+    }
+    closedir(d);
+}
+
+/**
+ * @brief Dossier d'une surveillance inotify, ou NULL s'il n'est plus suivi.
+ */
+static const char *watch_dir(const HotReload *hot, int wd)
+{
+    for (int i = 0; i < hot->dir_count; i++)
+        if (hot->wds[i] == wd)
+            return hot->dirs[i];
+    return NULL;
+}
+
+/**
+ * @brief Ajoute un fichier modifié aux attentes, une seule fois par rafale d'écritures.
+ */
+static void pending_add(HotReload *hot, const char *path)
+{
+    for (int i = 0; i < hot->pending_count; i++)
+        if (strcmp(hot->pending[i], path) == 0)
+            return;
+    if (hot->pending_count == HOTRELOAD_PENDING)
+    {
+        fprintf(stderr, "Rechargement a chaud : trop de fichiers modifies, %s ignore\n", path);
+        return;
+    }
+    snprintf(hot->pending[hot->pending_count++], HOTRELOAD_PATH_MAX, "%s", path);
+}
+
+/**
+ * @brief Lit les événements en attente sur le descripteur inotify.
+ */
+static void read_events(HotReload *hot)
+{
+    union
+    {
+        struct inotify_event align; // Alignement des événements dans le tampon
+        char bytes[4096];
+    } buf;
+    ssize_t n = read(hot->fd, buf.bytes, sizeof(buf.bytes));
+    for (ssize_t off = 0; off < n;)
+    {
+        const struct inotify_event *ev = (const struct inotify_event *)(buf.bytes + off);
+        off += (ssize_t)sizeof(struct inotify_event) + ev->len;
+        const char *dir = watch_dir(hot, ev->wd);
+        if (!dir || ev->len == 0 || ev->name[0] == '.')
+            continue; // Fichiers cachés : copies temporaires des éditeurs
+        char path[HOTRELOAD_PATH_MAX];
+        if (snprintf(path, sizeof(path), "%s/%s", dir, ev->name) >= (int)sizeof(path))
+            continue;
+        if (ev->mask & IN_ISDIR)
+        {
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+                watch_tree(hot, path);
+            continue;
+        }
+        if (ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+        {
+            hot->changes++;
+            pending_add(hot, path);
+        }
+    }
+}
+
+/**
+ * @brief Range un résultat pour le thread principal ; un résultat plus ancien du même fichier est remplacé.
+ */
+static void ready_push(HotReload *hot, const char *path, void *data)
+{
+    void *dropped = NULL;
+    pthread_mutex_lock(&hot->lock);
+    int slot = hot->ready_count;
+    for (int i = 0; i < hot->ready_count; i++)
+        if (strcmp(hot->ready[i].path, path) == 0)
+            slot = i;
+    if (slot < hot->ready_count)
+    {
+        dropped = hot->ready[slot].data; // Version intermédiaire, jamais affichée
+        hot->ready[slot].data = data;
+        hot->superseded++;
+    }
+    else if (slot < HOTRELOAD_READY)
+    {
+        snprintf(hot->ready[slot].path, HOTRELOAD_PATH_MAX, "%s", path);
+        hot->ready[slot].data = data;
+        hot->ready_count++;
+    }
+    else
+        dropped = data; // File pleine : le thread principal ne suit plus
+    pthread_mutex_unlock(&hot->lock);
+    if (dropped)
+        hot->ops.discard(dropped, hot->ops.user);
+    if (dropped != data && hot->ops.notify)
+        hot->ops.notify(hot->ops.user);
+}
+
+/**
+ * @brief Thread de surveillance : accumule les fichiers touchés, les décode une fois le dossier calme.
+ */
+static void *hotreload_main(void *arg)
+{
+    HotReload *hot = arg;
+    while (!__atomic_load_n(&hot->stop, __ATOMIC_ACQUIRE))
+    {
+        struct pollfd p = {hot->fd, POLLIN, 0};
+        int timeout = hot->pending_count > 0 ? HOTRELOAD_SETTLE_MS : HOTRELOAD_POLL_MS;
+        int r = poll(&p, 1, timeout);
+        if (r > 0)
+        {
+            read_events(hot);
+            continue; // Encore des écritures : on attend le calme
+        }
+        if (r < 0 || hot->pending_count == 0)
+            continue;
+
+        for (int i = 0; i < hot->pending_count; i++)
+        {
+            void *data = hot->ops.decode(hot->pending[i], hot->ops.user);
+            if (!data)
+            {
+                hot->ignored++;
+                continue;
+            }
+            hot->decoded++;
+            ready_push(hot, hot->pending[i], data);
+        }
+        hot->pending_count = 0;
+    }
+    return NULL;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Dossiers surveillés avant le lancement du thread : aucune écriture n'est manquée ensuite.
+ */
+bool hotreload_start(HotReload *hot, const char *root, const HotReloadOps *ops)
+{
+    memset(hot, 0, sizeof(*hot));
+    hot->ops = *ops;
+    hot->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (hot->fd < 0)
+        return false;
+    watch_tree(hot, root);
+    if (hot->dir_count == 0)
+    {
+        close(hot->fd);
+        return false;
+    }
+    pthread_mutex_init(&hot->lock, NULL);
+    if (pthread_create(&hot->thread, NULL, hotreload_main, hot) != 0)
+    {
+        pthread_mutex_destroy(&hot->lock);
+        close(hot->fd);
+        return false;
+    }
+    hot->active = true;
+    printf("Rechargement a chaud : %d dossier(s) surveille(s) sous %s\n", hot->dir_count, root);
+    return true;
+}
+
+/**
+ * @brief Copie puis vide la file ; ne bloque que le temps de la copie.
+ */
+int hotreload_take(HotReload *hot, HotReloadItem *out, int max)
+{
+    if (!hot->active)
+        return 0;
+    pthread_mutex_lock(&hot->lock);
+    int n = hot->ready_count < max ? hot->ready_count : max;
+    memcpy(out, hot->ready, (size_t)n * sizeof(HotReloadItem));
+    memmove(hot->ready, hot->ready + n, (size_t)(hot->ready_count - n) * sizeof(HotReloadItem));
+    hot->ready_count -= n;
+    pthread_mutex_unlock(&hot->lock);
+    return n;
+}
+
+/**
+ * @brief Arrêt du thread, puis résultats non récupérés rendus à l'appelant.
+ */
+void hotreload_stop(HotReload *hot)
+{
+    if (!hot->active)
+        return;
+    __atomic_store_n(&hot->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(hot->thread, NULL);
+    for (int i = 0; i < hot->ready_count; i++)
+        hot->ops.discard(hot->ready[i].data, hot->ops.user);
+    hot->ready_count = 0;
+    pthread_mutex_destroy(&hot->lock);
+    close(hot->fd);
+    hot->active = false;
+    printf("Rechargement a chaud : %llu ecriture(s), %llu fichier(s) recharge(s), %llu ignore(s), %llu remplace(s)\n",
+           (unsigned long long)hot->changes, (unsigned long long)hot->decoded, (unsigned long long)hot->ignored,
+           (unsigned long long)hot->superseded);
+}
+
+#else // Pas d'inotify : le rechargement à chaud n'est pas disponible
+
+bool hotreload_start(HotReload *hot, const char *root, const HotReloadOps *ops)
+{
+    (void)ops;
+    memset(hot, 0, sizeof(*hot));
+    fprintf(stderr, "Rechargement a chaud : indisponible sur ce systeme (%s non surveille)\n", root);
+    return false;
+}
+
+int hotreload_take(HotReload *hot, HotReloadItem *out, int max)
+{
+    (void)hot;
+    (void)out;
+    (void)max;
+    return 0;
+}
+
+void hotreload_stop(HotReload *hot)
+{
+    (void)hot;
+}
+
+#endif
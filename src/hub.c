@@ -0,0 +1,551 @@
+/**
+ * @file hub.c
+ * @brief Implémentation du serveur multi-parties (roue temporelle, threads de calcul).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour sigaction et sysconf).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "hub.h"
+#include "model.h"
+#include "net.h"
+#include "snapring.h"
+#include "spsc.h"
+#include "utils.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Images réseau d'une partie suivie (allouées à la première demande).
+ */
+typedef struct
+{
+    NetEncoder encoder;              ///< Fiches de tir des images capturées (thread de calcul).
+    NetFrame frames[SNAPRING_SLOTS]; ///< Stockage de `snapshots`.
+    SnapRing snapshots;              ///< Images capturées, du thread de calcul au thread réseau.
+} HubLink;
+
+/**
+ * @brief Une partie hébergée.
+ *
+ * Jamais avancée par deux threads à la fois : elle est soit dans la roue,
+ * soit dans la file des prêtes, soit entre les mains d'un seul thread de
+ * calcul (le verrou de la roue ordonne ces passages).
+ */
+typedef struct HubMatch
+{
+    GameModel *model;                         ///< Partie (bloc unique : structure et arène).
+    uint64_t due;                             ///< Échéance du prochain tick (utils_now_ns).
+    uint32_t tick;                            ///< Ticks joués.
+    bool human;                               ///< Un joueur a envoyé une commande : plus de bot.
+    Bot bot;                                  ///< Bot des parties sans joueur.
+    struct HubMatch *next;                    ///< Suivante dans sa case de la roue, ou dans la file des prêtes.
+    HubLink *link;                            ///< Images réseau (NULL : personne ne suit ; publié par le réseau).
+    SpscRing commands;                        ///< Commandes du réseau.
+    uint8_t command_storage[HUB_COMMAND_RING]; ///< Stockage de `commands`.
+} HubMatch;
+
+/**
+ * @brief Compteurs d'un thread de calcul (une ligne de cache chacun).
+ */
+typedef struct
+{
+    long long ticks, skipped, late, commands, games;
+    uint64_t step_ns;                       ///< Temps passé à avancer les parties.
+    uint64_t lateness_max;                  ///< Plus grand retard (ns).
+    long long late_hist[HUB_LATE_BUCKETS];  ///< Retards par puissance de 2 de µs.
+} __attribute__((aligned(64))) HubWorkerStats;
+
+struct Hub
+{
+    HubConfig cfg;
+    HubMatch *matches;                   ///< Parties (tableau alloué une fois).
+    uint64_t period;                     ///< Période d'un tick (ns).
+    double dt;                           ///< Pas de simulation (s).
+
+    pthread_mutex_t lock;                ///< Protège la roue, la file des prêtes et `stop`.
+    pthread_cond_t ready_cond;           ///< Des parties sont prêtes, ou arrêt demandé.
+    HubMatch *wheel[HUB_WHEEL_SLOTS];    ///< Parties en attente, par case (ms absolue modulo HUB_WHEEL_SLOTS).
+    uint64_t cursor;                     ///< Prochaine case à verser (ms absolue).
+    HubMatch *ready_head, *ready_tail;   ///< Parties échues, dans l'ordre des cases.
+    bool stop;                           ///< Arrêt demandé.
+
+    pthread_t timer;                     ///< Thread de la roue.
+    pthread_t threads[HUB_MAX_THREADS];  ///< Threads de calcul.
+    int thread_count;                    ///< Threads de calcul lancés.
+    HubWorkerStats stats[HUB_MAX_THREADS]; ///< Compteurs, un par thread de calcul.
+    double started;                      ///< Lancement (utils_get_time).
+    int watched;                         ///< Parties suivies (thread réseau).
+};
+
+/** @brief Contexte d'un thread de calcul. */
+typedef struct
+{
+    Hub *hub;
+    int index;
+} HubWorkerArg;
+
+static HubWorkerArg worker_args[HUB_MAX_THREADS];
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_sigint(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+/**
+ * @brief Lance (ou relance) une partie par les vraies commandes du menu (cf. headless.c).
+ */
+static void start_game(GameModel *model)
+{
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        GameOverOption opts[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, opts);
+        for (int i = 0; i < count; i++)
+            if (opts[i] == GAME_OVER_REPLAY)
+                model->ui.menu_selection = i; // "REJOUER"
+    }
+    else
+    {
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 0; // "JOUER"
+    }
+    model_handle_input(model, CMD_RETURN);
+}
+
+/**
+ * @brief Ramène la partie au menu principal (le joueur a demandé à quitter), comme net.c.
+ */
+static void back_to_menu(GameModel *model)
+{
+    model->ui.pending_quit = false;
+    model->sim.state = STATE_MENU;
+    model->ui.menu_selection = 0;
+    model_touch(model, MODEL_GEN_MENU);
+}
+
+/**
+ * @brief Range une partie dans la case de son échéance (verrou tenu).
+ *
+ * Échéance déjà passée : directement dans la file des prêtes.
+ */
+static void wheel_insert(Hub *hub, HubMatch *m)
+{
+    uint64_t slot = m->due / HUB_SLOT_NS;
+    if (slot < hub->cursor)
+    {
+        m->next = NULL;
+        if (hub->ready_tail)
+            hub->ready_tail->next = m;
+        else
+            hub->ready_head = m;
+        hub->ready_tail = m;
+        return;
+    }
+    if (slot >= hub->cursor + HUB_WHEEL_SLOTS)
+        slot = hub->cursor + HUB_WHEEL_SLOTS - 1; // Jamais au-delà d'un tour : la période est plus courte
+    HubMatch **head = &hub->wheel[slot & (HUB_WHEEL_SLOTS - 1)];
+    m->next = *head;
+    *head = m;
+}
+
+/**
+ * @brief Verse dans la file des prêtes toutes les cases commencées avant `now` (verrou tenu).
+ * @return true si des parties sont devenues prêtes.
+ */
+static bool wheel_expire(Hub *hub, uint64_t now)
+{
+    bool any = false;
+    uint64_t last = now / HUB_SLOT_NS;
+    for (; hub->cursor <= last; hub->cursor++)
+    {
+        HubMatch **head = &hub->wheel[hub->cursor & (HUB_WHEEL_SLOTS - 1)];
+        HubMatch *m = *head;
+        *head = NULL;
+        while (m)
+        {
+            HubMatch *next = m->next;
+            m->next = NULL;
+            if (hub->ready_tail)
+                hub->ready_tail->next = m;
+            else
+                hub->ready_head = m;
+            hub->ready_tail = m;
+            m = next;
+            any = true;
+        }
+    }
+    return any;
+}
+
+/**
+ * @brief Thread de la roue : à chaque début de case, verse les parties échues et réveille les calculs.
+ */
+static void *timer_main(void *arg)
+{
+    Hub *hub = arg;
+    for (;;)
+    {
+        pthread_mutex_lock(&hub->lock);
+        if (hub->stop)
+        {
+            pthread_mutex_unlock(&hub->lock);
+            break;
+        }
+        if (wheel_expire(hub, utils_now_ns()))
+            pthread_cond_broadcast(&hub->ready_cond);
+        uint64_t next = hub->cursor * HUB_SLOT_NS;
+        pthread_mutex_unlock(&hub->lock);
+        utils_sleep_until_ns(next);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Case de l'histogramme d'un retard : la plus petite puissance de 2 de µs qui le dépasse.
+ */
+static int late_bucket(uint64_t ns)
+{
+    uint64_t us = ns / 1000;
+    int b = 0;
+    while (b < HUB_LATE_BUCKETS - 1 && us >= (1ULL << b))
+        b++;
+    return b;
+}
+
+/**
+ * @brief Un tick d'une partie : commandes du joueur (ou bot), model_update, image réseau, échéance suivante.
+ */
+static void step_match(Hub *hub, HubMatch *m, HubWorkerStats *st)
+{
+    uint64_t start = utils_now_ns();
+    uint64_t lateness = start > m->due ? start - m->due : 0;
+    st->late_hist[late_bucket(lateness)]++;
+    if (lateness > st->lateness_max)
+        st->lateness_max = lateness;
+    if (lateness > hub->period)
+        st->late++;
+
+    GameModel *model = m->model;
+    uint8_t cmd;
+    while (spsc_pop(&m->commands, &cmd))
+    {
+        m->human = true;
+        if (!model_dispatch_command(model, (GameCommand)cmd))
+            back_to_menu(model);
+        st->commands++;
+    }
+    if (model->ui.pending_quit)
+        back_to_menu(model);
+    if (!m->human && hub->cfg.bot)
+    {
+        if (model->sim.state == STATE_MENU || model->sim.state == STATE_GAME_OVER)
+        {
+            start_game(model);
+            bot_init(&m->bot, hub->cfg.bot, model->sim.rng.seed + m->tick);
+            st->games++;
+        }
+        if (model->sim.state == STATE_PLAYING)
+            model_handle_input(model, command_held(bot_decide(&m->bot, model)));
+    }
+    model_update(model, hub->dt);
+    m->tick++;
+    st->ticks++;
+
+    HubLink *link = __atomic_load_n(&m->link, __ATOMIC_ACQUIRE);
+    if (link && m->tick % NET_SEND_EVERY == 0)
+    {
+        netframe_capture(snapring_write_slot(&link->snapshots), model, m->tick, &link->encoder);
+        snapring_publish(&link->snapshots, m->tick);
+    }
+
+    // Échéance suivante : exactement une période plus tard, sauf après un gros retard
+    m->due += hub->period;
+    uint64_t end = utils_now_ns();
+    if (end > m->due && end - m->due > HUB_MAX_LAG_NS)
+    {
+        st->skipped += (long long)((end - m->due) / hub->period);
+        m->due = end + hub->period;
+    }
+    st->step_ns += end - start;
+}
+
+/**
+ * @brief Thread de calcul : prend un lot de parties prêtes, les avance, les remet dans la roue.
+ */
+static void *worker_main(void *arg)
+{
+    HubWorkerArg *wa = arg;
+    Hub *hub = wa->hub;
+    HubWorkerStats *st = &hub->stats[wa->index];
+    HubMatch *batch[HUB_BATCH];
+
+    for (;;)
+    {
+        pthread_mutex_lock(&hub->lock);
+        while (!hub->stop && !hub->ready_head)
+            pthread_cond_wait(&hub->ready_cond, &hub->lock);
+        if (hub->stop)
+        {
+            pthread_mutex_unlock(&hub->lock);
+            break;
+        }
+        int n = 0;
+        while (n < HUB_BATCH && hub->ready_head)
+        {
+            batch[n++] = hub->ready_head;
+            hub->ready_head = hub->ready_head->next;
+        }
+        if (!hub->ready_head)
+            hub->ready_tail = NULL;
+        else
+            pthread_cond_signal(&hub->ready_cond); // Il en reste : un autre thread prend le lot suivant
+        pthread_mutex_unlock(&hub->lock);
+
+        for (int i = 0; i < n; i++)
+            step_match(hub, batch[i], st);
+
+        pthread_mutex_lock(&hub->lock);
+        for (int i = 0; i < n; i++)
+            wheel_insert(hub, batch[i]);
+        pthread_mutex_unlock(&hub->lock);
+    }
+    return NULL;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Un modèle par partie, graines consécutives.
+ */
+Hub *hub_create(const HubConfig *cfg)
+{
+    if (cfg->matches < 1 || cfg->matches > HUB_MAX_MATCHES)
+        return NULL;
+    Hub *hub = calloc(1, sizeof(Hub));
+    if (!hub)
+        return NULL;
+    hub->cfg = *cfg;
+    hub->matches = calloc((size_t)cfg->matches, sizeof(HubMatch));
+    if (!hub->matches)
+    {
+        free(hub);
+        return NULL;
+    }
+    for (int i = 0; i < cfg->matches; i++)
+    {
+        HubMatch *m = &hub->matches[i];
+        m->model = model_init();
+        if (!m->model)
+        {
+            hub_free(hub);
+            return NULL;
+        }
+        model_rng_seed(m->model, cfg->seed + (uint64_t)i);
+        spsc_init(&m->commands, m->command_storage, 1, HUB_COMMAND_RING);
+    }
+    int hz = model_tick_rate(hub->matches[0].model);
+    hub->period = UTILS_NS_PER_S / (uint64_t)hz;
+    hub->dt = 1.0 / hz;
+    pthread_mutex_init(&hub->lock, NULL);
+    pthread_cond_init(&hub->ready_cond, NULL);
+    return hub;
+}
+
+/**
+ * @brief Échéances réparties sur une période, puis thread de la roue et threads de calcul.
+ */
+bool hub_start(Hub *hub)
+{
+    int count = hub->cfg.threads > 0 ? hub->cfg.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1)
+        count = 1;
+    if (count > HUB_MAX_THREADS)
+        count = HUB_MAX_THREADS;
+
+    uint64_t now = utils_now_ns();
+    hub->cursor = now / HUB_SLOT_NS;
+    hub->stop = false;
+    for (int i = 0; i < hub->cfg.matches; i++)
+    {
+        HubMatch *m = &hub->matches[i];
+        m->due = now + hub->period * (uint64_t)i / (uint64_t)hub->cfg.matches;
+        wheel_insert(hub, m);
+    }
+    memset(hub->stats, 0, sizeof(hub->stats));
+    hub->started = utils_get_time();
+
+    if (pthread_create(&hub->timer, NULL, timer_main, hub) != 0)
+        return false;
+    for (hub->thread_count = 0; hub->thread_count < count; hub->thread_count++)
+    {
+        worker_args[hub->thread_count] = (HubWorkerArg){hub, hub->thread_count};
+        if (pthread_create(&hub->threads[hub->thread_count], NULL, worker_main, &worker_args[hub->thread_count]) != 0)
+        {
+            hub_stop(hub, NULL);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sommeil par tranches de 100 ms, jusqu'à la durée ou à SIGINT.
+ */
+void hub_wait(Hub *hub, double seconds)
+{
+    struct sigaction sa, old_sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_sigint;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, &old_sa);
+    stop_requested = 0;
+    while (!stop_requested && (seconds <= 0.0 || utils_get_time() - hub->started < seconds))
+        utils_sleep_ms(100);
+    sigaction(SIGINT, &old_sa, NULL);
+}
+
+/**
+ * @brief Réveille et attend tous les threads, puis fusionne leurs compteurs.
+ */
+void hub_stop(Hub *hub, HubStats *out)
+{
+    pthread_mutex_lock(&hub->lock);
+    hub->stop = true;
+    pthread_cond_broadcast(&hub->ready_cond);
+    pthread_mutex_unlock(&hub->lock);
+    pthread_join(hub->timer, NULL);
+    for (int t = 0; t < hub->thread_count; t++)
+        pthread_join(hub->threads[t], NULL);
+
+    if (!out)
+        return;
+    memset(out, 0, sizeof(*out));
+    out->elapsed = utils_get_time() - hub->started;
+    out->matches = hub->cfg.matches;
+    out->threads = hub->thread_count;
+    out->watched = hub->watched;
+    uint64_t step_ns = 0, worst = 0;
+    for (int t = 0; t < hub->thread_count; t++)
+    {
+        const HubWorkerStats *st = &hub->stats[t];
+        out->ticks += st->ticks;
+        out->skipped += st->skipped;
+        out->late += st->late;
+        out->commands += st->commands;
+        out->games += st->games;
+        step_ns += st->step_ns;
+        if (st->lateness_max > worst)
+            worst = st->lateness_max;
+        for (int b = 0; b < HUB_LATE_BUCKETS; b++)
+            out->late_hist[b] += st->late_hist[b];
+    }
+    for (int i = 0; i < hub->cfg.matches; i++)
+        out->dropped += hub->matches[i].commands.dropped;
+    out->step_us = out->ticks > 0 ? (double)step_ns / 1e3 / (double)out->ticks : 0.0;
+    out->lateness_max_us = (double)worst / 1e3;
+}
+
+/**
+ * @brief Modèles, images réseau, tableau des parties.
+ */
+void hub_free(Hub *hub)
+{
+    if (!hub)
+        return;
+    for (int i = 0; i < hub->cfg.matches; i++)
+    {
+        model_free(hub->matches[i].model);
+        bot_free(&hub->matches[i].bot);
+        free(hub->matches[i].link);
+    }
+    free(hub->matches);
+    pthread_mutex_destroy(&hub->lock);
+    pthread_cond_destroy(&hub->ready_cond);
+    free(hub);
+}
+
+/**
+ * @brief Nombre de parties.
+ */
+int hub_matches(const Hub *hub)
+{
+    return hub->cfg.matches;
+}
+
+/**
+ * @brief File SPSC de la partie ; le bot la cède au premier tick qui la vide.
+ */
+bool hub_push_command(Hub *hub, int match, GameCommand cmd)
+{
+    uint8_t c = (uint8_t)cmd;
+    return spsc_push(&hub->matches[match].commands, &c);
+}
+
+/**
+ * @brief Tampons alloués et initialisés, puis publiés au thread de calcul.
+ */
+bool hub_watch(Hub *hub, int match)
+{
+    HubMatch *m = &hub->matches[match];
+    if (m->link)
+        return true;
+    HubLink *link = calloc(1, sizeof(HubLink));
+    if (!link)
+        return false;
+    snapring_init(&link->snapshots, link->frames, sizeof(NetFrame));
+    __atomic_store_n(&m->link, link, __ATOMIC_RELEASE);
+    hub->watched++;
+    return true;
+}
+
+/**
+ * @brief Dernière image publiée par le thread de calcul.
+ */
+const NetFrame *hub_frame(Hub *hub, int match, uint32_t *tick)
+{
+    HubLink *link = hub->matches[match].link;
+    return link ? snapring_acquire(&link->snapshots, tick) : NULL;
+}
+
+/**
+ * @brief Débit, coût d'un tick, retard sur l'échéance (maximum et 99e centile).
+ */
+void hub_print_stats(const HubStats *stats)
+{
+    long long total = 0, seen = 0;
+    for (int b = 0; b < HUB_LATE_BUCKETS; b++)
+        total += stats->late_hist[b];
+    int p99 = 0;
+    for (; p99 < HUB_LATE_BUCKETS; p99++)
+    {
+        seen += stats->late_hist[p99];
+        if (seen * 100 >= total * 99)
+            break;
+    }
+    printf("[HUB] %d parties, %d threads, %.1f s\n", stats->matches, stats->threads, stats->elapsed);
+    printf("[HUB] Ticks        : %lld (%.0f/s), %.1f us par tick\n", stats->ticks,
+           stats->elapsed > 0.0 ? stats->ticks / stats->elapsed : 0.0, stats->step_us);
+    printf("[HUB] Retard       : 99e centile < %llu us, maximum %.0f us\n",
+           p99 < HUB_LATE_BUCKETS ? 1ULL << p99 : 0ULL, stats->lateness_max_us);
+    printf("[HUB] En retard    : %lld tick(s) de plus d'une periode, %lld saute(s)\n", stats->late, stats->skipped);
+    printf("[HUB] Joueurs      : %d partie(s) suivie(s), %lld commande(s), %lld perdue(s)\n", stats->watched,
+           stats->commands, stats->dropped);
+    if (stats->games > 0)
+        printf("[HUB] Bots         : %lld partie(s) lancee(s)\n", stats->games);
+}
@@ -0,0 +1,184 @@
+/**
+ * @file lang.c
+ * @brief Implémentation de la table des chaînes (textes par défaut, chargement d'un fichier de langue).
+ */
+
+#include "lang.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. TABLE PAR DÉFAUT
+// ============================================================================
+
+/** @brief Clés des chaînes (nom de l'identifiant sans STR_). */
+static const char *const KEYS[STR_COUNT] = {
+#define LANG_KEY(id, text) #id,
+    LANG_STRINGS(LANG_KEY)
+#undef LANG_KEY
+};
+
+/** @brief Textes par défaut (français). */
+static const char *const DEFAULTS[STR_COUNT] = {
+#define LANG_DEFAULT(id, text) text,
+    LANG_STRINGS(LANG_DEFAULT)
+#undef LANG_DEFAULT
+};
+
+static const char *table[STR_COUNT]; ///< Texte courant de chaque chaîne (NULL : texte par défaut).
+static char pool[16384];             ///< Textes du fichier chargé (table y pointe).
+static uint32_t generation = 1;      ///< Incrémenté à chaque chargement réussi.
+
+// ============================================================================
+//                          2. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Réduit un format printf à la suite de ses conversions (ex: "Rang %d/%d" -> "dd").
+ * @return false si le format a plus de conversions que `cap` - 1.
+ */
+static bool format_signature(const char *fmt, char *sig, size_t cap)
+{
+    size_t n = 0;
+    for (const char *p = fmt; *p; p++)
+    {
+        if (*p != '%')
+            continue;
+        p++;
+        while (*p && strchr("-+ #0123456789.lhz", *p))
+            p++;
+        if (!*p)
+            break;
+        if (*p == '%')
+            continue;
+        if (n + 1 >= cap)
+            return false;
+        sig[n++] = *p;
+    }
+    sig[n] = '\0';
+    return true;
+}
+
+/** @brief Retire les blancs en fin de chaîne (fin de ligne Windows comprise). */
+static void trim_end(char *s)
+{
+    size_t n = strlen(s);
+    while (n > 0 && isspace((unsigned char)s[n - 1]))
+        s[--n] = '\0';
+}
+
+/** @brief Identifiant d'une clé, ou STR_COUNT si elle est inconnue. */
+static StringId find_key(const char *key)
+{
+    for (int i = 0; i < STR_COUNT; i++)
+        if (strcmp(KEYS[i], key) == 0)
+            return (StringId)i;
+    return STR_COUNT;
+}
+
+// ============================================================================
+//                          3. API
+// ============================================================================
+
+const char *lang_get(StringId id)
+{
+    if ((unsigned)id >= STR_COUNT)
+        return "";
+    return table[id] ? table[id] : DEFAULTS[id];
+}
+
+uint32_t lang_generation(void)
+{
+    return generation;
+}
+
+/**
+ * @brief Charge un fichier de langue.
+ *
+ * Un texte entre guillemets garde ses blancs de début et de fin
+ * (`HUD_RAPID = "   RAPID"`) ; sinon ils sont retirés.
+ */
+bool lang_load(const char *path, char *err, size_t err_cap)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        snprintf(err, err_cap, "impossible d'ouvrir %s", path);
+        return false;
+    }
+
+    static char next_pool[sizeof(pool)];
+    const char *next[STR_COUNT] = {0};
+    size_t used = 0;
+    char line[512];
+    int line_no = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f))
+    {
+        line_no++;
+        trim_end(line);
+        char *p = line;
+        while (isspace((unsigned char)*p))
+            p++;
+        if (*p == '\0' || *p == '#')
+            continue;
+
+        char *eq = strchr(p, '=');
+        if (!eq)
+        {
+            snprintf(err, err_cap, "ligne %d : '=' attendu", line_no);
+            ok = false;
+            break;
+        }
+        *eq = '\0';
+        trim_end(p);
+        StringId id = find_key(p);
+        if (id == STR_COUNT)
+        {
+            snprintf(err, err_cap, "ligne %d : clé inconnue %s", line_no, p);
+            ok = false;
+            break;
+        }
+
+        char *value = eq + 1;
+        while (isspace((unsigned char)*value))
+            value++;
+        size_t len = strlen(value);
+        if (len >= 2 && value[0] == '"' && value[len - 1] == '"')
+        {
+            value[len - 1] = '\0';
+            value++;
+            len -= 2;
+        }
+
+        char want[16], got[16];
+        if (!format_signature(DEFAULTS[id], want, sizeof(want)) || !format_signature(value, got, sizeof(got)) ||
+            strcmp(want, got) != 0)
+        {
+            snprintf(err, err_cap, "ligne %d : %s doit garder les conversions de \"%s\"", line_no, KEYS[id], DEFAULTS[id]);
+            ok = false;
+            break;
+        }
+        if (used + len + 1 > sizeof(next_pool))
+        {
+            snprintf(err, err_cap, "%s dépasse %zu octets de texte", path, sizeof(next_pool));
+            ok = false;
+            break;
+        }
+        memcpy(next_pool + used, value, len + 1);
+        next[id] = next_pool + used;
+        used += len + 1;
+    }
+    fclose(f);
+    if (!ok)
+        return false;
+
+    // Adoption : les pointeurs de next visent next_pool, recopié dans pool
+    memcpy(pool, next_pool, used);
+    for (int i = 0; i < STR_COUNT; i++)
+        table[i] = next[i] ? pool + (next[i] - next_pool) : NULL;
+    generation++;
+    return true;
+}
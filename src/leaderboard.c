@@ -0,0 +1,478 @@
+/**
+ * @file leaderboard.c
+ * @brief Implémentation de la file durable du classement et de son thread d'envoi (HTTP/1.0).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2008 (requis pour getaddrinfo, pread, pwrite et fdatasync).
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "leaderboard.h"
+#include "replay.h"
+#include "save.h"
+#include "statehash.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 ///< Hors Linux : pas d'option pour taire SIGPIPE à l'envoi.
+#endif
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Ligne CSV d'une partie au plus (deux empreintes hexadécimales, entiers, séparateurs). */
+#define LINE_MAX_BYTES 96
+
+/**
+ * @brief Une partie décodée.
+ */
+typedef struct
+{
+    int64_t timestamp; ///< Fin de la partie (secondes depuis 1970).
+    uint64_t seed;     ///< Graine de la partie.
+    uint64_t hash;     ///< Empreinte de l'état final (statehash_model).
+    int32_t score;     ///< Score final.
+    int32_t level;     ///< Niveau atteint.
+    uint32_t flags;    ///< Physique de la session (replay_session_flags).
+} LeaderboardRun;
+
+static int append_fd = -1;    ///< Ajouts de la boucle de jeu (O_APPEND).
+static int io_fd = -1;        ///< Lectures et en-tête du thread d'envoi (pwrite ignore O_APPEND : autre descripteur).
+static uint64_t records = 0;  ///< Parties dans le fichier (atomique : écrit par le jeu, lu par l'envoi).
+static uint64_t acked = 0;    ///< Parties acceptées (atomique : écrit par l'envoi).
+static int unsynced = 0;      ///< Ajout pas encore forcé sur le disque (atomique).
+static int stop = 0;          ///< Arrêt demandé (atomique).
+static bool thread_started = false;
+static pthread_t uploader;
+static LeaderboardStats session; ///< submitted et append_max_us : jeu ; uploads et failures : envoi.
+
+static char host[128];
+static char port[16];
+static char path[128];
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_le64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++)
+        p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_le64(const uint8_t *p)
+{
+    return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+static void encode_run(uint8_t *p, const LeaderboardRun *r)
+{
+    put_le64(p, (uint64_t)r->timestamp);
+    put_le64(p + 8, r->seed);
+    put_le64(p + 16, r->hash);
+    put_le32(p + 24, (uint32_t)r->score);
+    put_le32(p + 28, (uint32_t)r->level);
+    put_le32(p + 32, r->flags);
+    put_le32(p + 36, save_crc32(p, LEADERBOARD_RECORD_SIZE - 4));
+}
+
+/**
+ * @return false si le CRC ne correspond pas (enregistrement abîmé).
+ */
+static bool decode_run(const uint8_t *p, LeaderboardRun *r)
+{
+    if (get_le32(p + 36) != save_crc32(p, LEADERBOARD_RECORD_SIZE - 4))
+        return false;
+    r->timestamp = (int64_t)get_le64(p);
+    r->seed = get_le64(p + 8);
+    r->hash = get_le64(p + 16);
+    r->score = (int32_t)get_le32(p + 24);
+    r->level = (int32_t)get_le32(p + 28);
+    r->flags = get_le32(p + 32);
+    return true;
+}
+
+static void encode_header(uint8_t *h, uint64_t accepted)
+{
+    memcpy(h, LEADERBOARD_MAGIC, 4);
+    h[4] = LEADERBOARD_VERSION & 0xFF;
+    h[5] = LEADERBOARD_VERSION >> 8;
+    h[6] = LEADERBOARD_RECORD_SIZE & 0xFF;
+    h[7] = LEADERBOARD_RECORD_SIZE >> 8;
+    put_le64(h + 8, accepted);
+}
+
+/**
+ * @brief Lit l'en-tête d'une file et compte ses parties entières.
+ * @return false si la signature, la version ou la taille d'enregistrement diffèrent.
+ */
+static bool read_header(int fd, uint64_t *count, uint64_t *accepted)
+{
+    uint8_t h[LEADERBOARD_HEADER_SIZE];
+    struct stat st;
+    if (pread(fd, h, sizeof(h), 0) != (ssize_t)sizeof(h) || fstat(fd, &st) != 0 ||
+        memcmp(h, LEADERBOARD_MAGIC, 4) != 0 || (h[4] | h[5] << 8) != LEADERBOARD_VERSION ||
+        (h[6] | h[7] << 8) != LEADERBOARD_RECORD_SIZE)
+        return false;
+    *count = (uint64_t)(st.st_size - LEADERBOARD_HEADER_SIZE) / LEADERBOARD_RECORD_SIZE;
+    *accepted = get_le64(h + 8);
+    if (*accepted > *count)
+        *accepted = *count;
+    return true;
+}
+
+/**
+ * @brief Coupe la file après la dernière partie lisible (fin tronquée ou abîmée par un plantage).
+ */
+static void trim_tail(int fd)
+{
+    uint8_t rec[LEADERBOARD_RECORD_SIZE];
+    LeaderboardRun run;
+    uint64_t valid = acked;
+    while (valid < records &&
+           pread(fd, rec, sizeof(rec), (off_t)(LEADERBOARD_HEADER_SIZE + valid * LEADERBOARD_RECORD_SIZE)) ==
+               (ssize_t)sizeof(rec) &&
+           decode_run(rec, &run))
+        valid++;
+    records = valid;
+    if (ftruncate(fd, (off_t)(LEADERBOARD_HEADER_SIZE + records * LEADERBOARD_RECORD_SIZE)) != 0)
+        return; // Fin illisible gardée : ignorée à l'envoi comme à la lecture
+}
+
+/**
+ * @brief Découpe "hôte:port[/chemin]".
+ */
+static bool parse_server(const char *server)
+{
+    const char *slash = strchr(server, '/');
+    size_t head = slash ? (size_t)(slash - server) : strlen(server);
+    const char *colon = memchr(server, ':', head);
+    if (!colon || colon == server || (size_t)(colon - server) >= sizeof(host))
+        return false;
+    size_t port_len = head - (size_t)(colon - server) - 1;
+    if (port_len == 0 || port_len >= sizeof(port))
+        return false;
+    memcpy(host, server, (size_t)(colon - server));
+    host[colon - server] = '\0';
+    memcpy(port, colon + 1, port_len);
+    port[port_len] = '\0';
+    snprintf(path, sizeof(path), "%s", slash ? slash : LEADERBOARD_DEFAULT_PATH);
+    return atoi(port) > 0;
+}
+
+// ============================================================================
+//                          2. ENVOI (THREAD D'ARRIÈRE-PLAN)
+// ============================================================================
+
+/**
+ * @brief Attend qu'un descripteur soit prêt, au plus LEADERBOARD_TIMEOUT_MS.
+ */
+static bool wait_fd(int fd, bool for_write)
+{
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(fd, &set);
+    struct timeval tv = {LEADERBOARD_TIMEOUT_MS / 1000, (LEADERBOARD_TIMEOUT_MS % 1000) * 1000};
+    return select(fd + 1, for_write ? NULL : &set, for_write ? &set : NULL, NULL, &tv) > 0;
+}
+
+/**
+ * @brief Connexion TCP bornée dans le temps (réseau absent : échec rapide, pas d'attente du système).
+ * @return Le descripteur (non bloquant), ou -1.
+ */
+static int http_connect(void)
+{
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, port, &hints, &res) != 0 || !res)
+        return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (connect(fd, res->ai_addr, res->ai_addrlen) != 0 &&
+            (errno != EINPROGRESS || !wait_fd(fd, true) || getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0 ||
+             err != 0))
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+/**
+ * @brief Envoie tout le buffer, chaque morceau attendu au plus LEADERBOARD_TIMEOUT_MS.
+ */
+static bool send_all(int fd, const char *data, size_t len)
+{
+    while (len > 0)
+    {
+        if (!wait_fd(fd, true))
+            return false;
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Poste un lot de lignes CSV.
+ * @return true si le serveur a répondu 2xx.
+ */
+static bool http_post(const char *body, size_t len)
+{
+    int fd = http_connect();
+    if (fd < 0)
+        return false;
+    char head[512];
+    int n = snprintf(head, sizeof(head),
+                     "POST %s HTTP/1.0\r\nHost: %s:%s\r\nContent-Type: text/csv\r\nContent-Length: %zu\r\n\r\n", path,
+                     host, port, len);
+    bool ok = n > 0 && (size_t)n < sizeof(head) && send_all(fd, head, (size_t)n) && send_all(fd, body, len);
+    char status[64] = {0}, rest[256];
+    size_t got = 0;
+    while (ok && wait_fd(fd, false)) // Réponse lue jusqu'à la fermeture ; seule la ligne d'état compte
+    {
+        ssize_t r = got < sizeof(status) - 1 ? recv(fd, status + got, sizeof(status) - 1 - got, 0)
+                                             : recv(fd, rest, sizeof(rest), 0);
+        if (r <= 0)
+            break;
+        if (got < sizeof(status) - 1)
+            got += (size_t)r;
+    }
+    close(fd);
+    return ok && got >= 12 && strncmp(status, "HTTP/1.", 7) == 0 && status[9] == '2';
+}
+
+/**
+ * @brief Poste les parties en attente, par lots, jusqu'à la fin de la file ou au premier échec.
+ *
+ * @param body Buffer de LEADERBOARD_BATCH lignes.
+ * @return false si une tentative a échoué.
+ */
+static bool upload_pending(char *body)
+{
+    static uint8_t recs[LEADERBOARD_BATCH * LEADERBOARD_RECORD_SIZE];
+    uint64_t done = __atomic_load_n(&acked, __ATOMIC_RELAXED);
+    uint64_t total = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+    while (done < total && !__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+    {
+        uint64_t take = total - done < LEADERBOARD_BATCH ? total - done : LEADERBOARD_BATCH;
+        size_t bytes = (size_t)take * LEADERBOARD_RECORD_SIZE;
+        if (pread(io_fd, recs, bytes, (off_t)(LEADERBOARD_HEADER_SIZE + done * LEADERBOARD_RECORD_SIZE)) !=
+            (ssize_t)bytes)
+            return false;
+        size_t len = 0;
+        for (uint64_t i = 0; i < take; i++)
+        {
+            LeaderboardRun r;
+            if (!decode_run(recs + i * LEADERBOARD_RECORD_SIZE, &r))
+                continue; // Abîmé sur le disque : rien à envoyer, compté accepté avec le lot
+            len += (size_t)snprintf(body + len, LINE_MAX_BYTES, "%016llx,%d,%d,%u,%016llx,%lld\n",
+                                    (unsigned long long)r.seed, r.score, r.level, r.flags,
+                                    (unsigned long long)r.hash, (long long)r.timestamp);
+        }
+        if (len > 0 && !http_post(body, len))
+            return false;
+
+        done += take;
+        uint8_t h[LEADERBOARD_HEADER_SIZE];
+        encode_header(h, done);
+        if (pwrite(io_fd, h + 8, 8, 8) != 8) // Compteur seul : une écriture de 8 octets alignée
+            return false;
+        fdatasync(io_fd);
+        __atomic_store_n(&acked, done, __ATOMIC_RELEASE);
+        session.uploads++;
+        total = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+    }
+    return true;
+}
+
+/**
+ * @brief Boucle du thread : force les ajouts sur le disque, envoie quand l'échéance de la prochaine tentative est passée.
+ */
+static void *uploader_main(void *arg)
+{
+    (void)arg;
+    char *body = malloc((size_t)LEADERBOARD_BATCH * LINE_MAX_BYTES);
+    double backoff = 1.0, next_try = 0.0;
+    while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+    {
+        if (__atomic_exchange_n(&unsynced, 0, __ATOMIC_ACQ_REL))
+            fdatasync(io_fd);
+        double now = utils_get_time();
+        bool pending = __atomic_load_n(&acked, __ATOMIC_RELAXED) < __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+        if (body && pending && now >= next_try)
+        {
+            if (upload_pending(body))
+                backoff = 1.0;
+            else if (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+            {
+                session.failures++;
+                next_try = utils_get_time() + backoff;
+                backoff = backoff * 2.0 < LEADERBOARD_BACKOFF_MAX_S ? backoff * 2.0 : LEADERBOARD_BACKOFF_MAX_S;
+            }
+        }
+        utils_sleep_ms(LEADERBOARD_POLL_MS);
+    }
+    free(body);
+    return NULL;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief En-tête vérifié (ou écrit), fin coupée, file vidée si tout est accepté, puis le thread.
+ */
+bool leaderboard_open(const char *dir, const char *server)
+{
+    leaderboard_close(NULL);
+    char file[256];
+    snprintf(file, sizeof(file), "%s/%s", dir, LEADERBOARD_FILE);
+    io_fd = open(file, O_RDWR | O_CREAT, 0644);
+    if (io_fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(io_fd, &st) == 0 && st.st_size < LEADERBOARD_HEADER_SIZE)
+    {
+        uint8_t h[LEADERBOARD_HEADER_SIZE];
+        encode_header(h, 0);
+        if (ftruncate(io_fd, 0) != 0 || pwrite(io_fd, h, sizeof(h), 0) != (ssize_t)sizeof(h))
+        {
+            close(io_fd);
+            io_fd = -1;
+            return false;
+        }
+    }
+    if (!read_header(io_fd, &records, &acked))
+    {
+        close(io_fd);
+        io_fd = -1;
+        return false;
+    }
+    trim_tail(io_fd);
+    if (acked == records && records > 0)
+    {
+        // Tout est accepté : la file repart vide
+        uint8_t h[LEADERBOARD_HEADER_SIZE];
+        encode_header(h, 0);
+        if (ftruncate(io_fd, LEADERBOARD_HEADER_SIZE) == 0 && pwrite(io_fd, h, sizeof(h), 0) == (ssize_t)sizeof(h))
+            records = acked = 0;
+    }
+    append_fd = open(file, O_WRONLY | O_APPEND);
+    if (append_fd < 0)
+    {
+        close(io_fd);
+        io_fd = -1;
+        return false;
+    }
+    memset(&session, 0, sizeof(session));
+    unsynced = stop = 0;
+    thread_started = server && parse_server(server) && pthread_create(&uploader, NULL, uploader_main, NULL) == 0;
+    return true;
+}
+
+/**
+ * @brief Un enregistrement, un write() en ajout ; le thread d'envoi le forcera sur le disque.
+ */
+bool leaderboard_submit(const GameModel *model)
+{
+    if (append_fd < 0)
+        return false;
+    uint64_t t0 = utils_now_ns();
+    LeaderboardRun r = {(int64_t)time(NULL), model->sim.rng.seed, statehash_model(model, 0), model->sim.score,
+                        model->sim.level, replay_session_flags(model)};
+    uint8_t rec[LEADERBOARD_RECORD_SIZE];
+    encode_run(rec, &r);
+    if (write(append_fd, rec, sizeof(rec)) != (ssize_t)sizeof(rec))
+        return false;
+    __atomic_add_fetch(&records, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&unsynced, 1, __ATOMIC_RELEASE);
+    session.submitted++;
+    double us = (double)(utils_now_ns() - t0) / 1000.0;
+    if (us > session.append_max_us)
+        session.append_max_us = us;
+    return true;
+}
+
+/**
+ * @brief Compteurs lus de façon atomique, bilan de la session.
+ */
+void leaderboard_stats(LeaderboardStats *out)
+{
+    *out = session;
+    out->records = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+    out->acked = __atomic_load_n(&acked, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Arrêt du thread, dernier fdatasync, descripteurs fermés.
+ */
+void leaderboard_close(LeaderboardStats *out)
+{
+    if (thread_started)
+    {
+        __atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+        pthread_join(uploader, NULL);
+        thread_started = false;
+    }
+    if (out)
+        leaderboard_stats(out);
+    if (io_fd >= 0)
+    {
+        fdatasync(io_fd);
+        close(io_fd);
+    }
+    if (append_fd >= 0)
+        close(append_fd);
+    io_fd = append_fd = -1;
+}
+
+/**
+ * @brief En-tête et taille du fichier, en lecture seule.
+ */
+bool leaderboard_status(const char *dir, LeaderboardStats *out)
+{
+    memset(out, 0, sizeof(LeaderboardStats));
+    char file[256];
+    snprintf(file, sizeof(file), "%s/%s", dir, LEADERBOARD_FILE);
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+        return false;
+    bool ok = read_header(fd, &out->records, &out->acked);
+    close(fd);
+    return ok;
+}
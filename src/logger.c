@@ -0,0 +1,292 @@
+/**
+ * @file logger.c
+ * @brief Implémentation du journal : anneau sans verrou à plusieurs producteurs, thread d'écriture.
+ */
+
+#include "logger.h"
+#include "utils.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Un message en attente d'écriture.
+ */
+typedef struct
+{
+    uint32_t seq;               ///< Position attendue : égale à la position d'écriture, l'emplacement est libre ; +1, il est publié.
+    uint8_t level;              ///< LogLevel.
+    double time;                ///< Date du message (utils_get_time).
+    char text[LOG_RECORD_TEXT]; ///< Message formaté.
+} LogRecord;
+
+static LogRecord ring[LOG_RING];
+static uint32_t write_pos = 0; ///< Prochain emplacement à réserver (producteurs, par CAS).
+static uint32_t read_pos = 0;  ///< Prochain emplacement à écrire (thread d'écriture seul).
+static uint64_t dropped = 0;   ///< Messages perdus, anneau plein.
+
+static bool running = false;        ///< Thread lancé : les messages passent par l'anneau.
+static int stop_requested = 0;      ///< Arrêt demandé au thread.
+static pthread_t writer;            ///< Thread d'écriture.
+static LogLevel min_level = LOG_INFO; ///< Seuil (SPACE_INVADERS_LOG_LEVEL).
+static double start_time = 0.0;     ///< Origine des dates du fichier.
+
+/** @brief Protège la destination ; pris par le thread d'écriture et l'écriture directe, jamais dans l'anneau. */
+static pthread_mutex_t sink_lock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *file = NULL;     ///< Fichier de destination (NULL : stdout/stderr).
+static bool forced = false;   ///< Fichier imposé par SPACE_INVADERS_LOG : logger_redirect l'ignore.
+
+/** @brief Noms des niveaux, pour SPACE_INVADERS_LOG_LEVEL et le fichier. */
+static const char *const level_names[LOG_LEVEL_COUNT] = {"debug", "info", "warn", "error"};
+
+/**
+ * @brief Écrit un message à sa destination (verrou de destination tenu).
+ */
+static void emit(LogLevel level, double time, const char *text)
+{
+    if (file)
+        fprintf(file, "%10.3f %-5s %s", time - start_time, level_names[level], text);
+    else
+        fputs(text, level >= LOG_WARN ? stderr : stdout);
+}
+
+/**
+ * @brief Vide les destinations après un lot de messages.
+ */
+static void flush_sinks(void)
+{
+    if (file)
+        fflush(file);
+    else
+    {
+        fflush(stdout);
+        fflush(stderr);
+    }
+}
+
+/**
+ * @brief Réserve un emplacement libre (CAS sur la position d'écriture).
+ * @return NULL si l'anneau est plein.
+ */
+static LogRecord *reserve(uint32_t *pos_out)
+{
+    uint32_t pos = __atomic_load_n(&write_pos, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        LogRecord *r = &ring[pos & (LOG_RING - 1)];
+        int32_t diff = (int32_t)(__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&write_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                *pos_out = pos;
+                return r;
+            }
+        }
+        else if (diff < 0)
+            return NULL; // L'emplacement n'a pas encore été écrit : un tour de retard, anneau plein
+        else
+            pos = __atomic_load_n(&write_pos, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Écrit tous les messages publiés, dans l'ordre des positions.
+ * @return Nombre de messages écrits.
+ */
+static int drain(void)
+{
+    int n = 0;
+    pthread_mutex_lock(&sink_lock);
+    for (;;)
+    {
+        LogRecord *r = &ring[read_pos & (LOG_RING - 1)];
+        if (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != read_pos + 1)
+            break;
+        emit((LogLevel)r->level, r->time, r->text);
+        __atomic_store_n(&r->seq, read_pos + LOG_RING, __ATOMIC_RELEASE); // Libre pour le tour suivant
+        read_pos++;
+        n++;
+    }
+    if (n > 0)
+        flush_sinks();
+    pthread_mutex_unlock(&sink_lock);
+    return n;
+}
+
+/**
+ * @brief Thread d'écriture : vide l'anneau toutes les LOG_FLUSH_MS millisecondes.
+ */
+static void *writer_main(void *arg)
+{
+    (void)arg;
+    while (!__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE))
+    {
+        drain();
+        utils_sleep_ms(LOG_FLUSH_MS);
+    }
+    drain();
+    return NULL;
+}
+
+/**
+ * @brief Ouvre un fichier de journal en ajout, dossier parent créé au besoin.
+ */
+static FILE *open_file(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    if (slash && slash > path)
+    {
+        char dir[256];
+        size_t len = (size_t)(slash - path) < sizeof(dir) - 1 ? (size_t)(slash - path) : sizeof(dir) - 1;
+        memcpy(dir, path, len);
+        dir[len] = '\0';
+        mkdir(dir, 0777);
+    }
+    return fopen(path, "a");
+}
+
+/**
+ * @brief Remplace la destination (verrou pris).
+ */
+static void set_file(FILE *f)
+{
+    pthread_mutex_lock(&sink_lock);
+    if (file)
+        fclose(file);
+    file = f;
+    pthread_mutex_unlock(&sink_lock);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Anneau remis à zéro, seuil et fichier imposé lus, thread lancé.
+ */
+bool logger_start(void)
+{
+    if (running)
+        return true;
+    for (uint32_t i = 0; i < LOG_RING; i++)
+        ring[i].seq = i;
+    write_pos = read_pos = 0;
+    __atomic_store_n(&dropped, 0, __ATOMIC_RELAXED);
+    start_time = utils_get_time();
+
+    const char *level_env = getenv("SPACE_INVADERS_LOG_LEVEL");
+    for (int l = 0; level_env && l < LOG_LEVEL_COUNT; l++)
+        if (strcmp(level_env, level_names[l]) == 0)
+            min_level = (LogLevel)l;
+    const char *file_env = getenv("SPACE_INVADERS_LOG");
+    if (file_env && file_env[0])
+    {
+        FILE *f = open_file(file_env);
+        if (f)
+        {
+            set_file(f);
+            forced = true;
+        }
+        else
+            fprintf(stderr, "[ERREUR] Journal impossible a ouvrir : %s\n", file_env);
+    }
+
+    __atomic_store_n(&stop_requested, 0, __ATOMIC_RELEASE);
+    if (pthread_create(&writer, NULL, writer_main, NULL) != 0)
+        return false;
+    __atomic_store_n(&running, true, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Formate dans un emplacement réservé, ou écrit aussitôt sans thread.
+ */
+void logger_write(LogLevel level, const char *fmt, ...)
+{
+    if (level < min_level)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    if (!__atomic_load_n(&running, __ATOMIC_ACQUIRE))
+    {
+        char text[LOG_RECORD_TEXT];
+        vsnprintf(text, sizeof(text), fmt, args);
+        pthread_mutex_lock(&sink_lock);
+        emit(level, utils_get_time(), text);
+        flush_sinks();
+        pthread_mutex_unlock(&sink_lock);
+        va_end(args);
+        return;
+    }
+
+    uint32_t pos;
+    LogRecord *r = reserve(&pos);
+    if (!r)
+    {
+        __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+        va_end(args);
+        return;
+    }
+    int len = vsnprintf(r->text, LOG_RECORD_TEXT, fmt, args);
+    va_end(args);
+    if (len >= LOG_RECORD_TEXT)
+        r->text[LOG_RECORD_TEXT - 2] = '\n'; // Tronqué : la ligne reste terminée
+    r->level = (uint8_t)level;
+    r->time = utils_get_time();
+    __atomic_store_n(&r->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Nouvelle destination, sauf fichier imposé.
+ */
+void logger_redirect(const char *path)
+{
+    if (forced)
+        return;
+    FILE *f = NULL;
+    if (path)
+    {
+        f = open_file(path);
+        if (!f)
+            return; // Le terminal reste la destination
+    }
+    set_file(f);
+}
+
+/**
+ * @brief Compteur de messages perdus.
+ */
+uint64_t logger_dropped(void)
+{
+    return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Dernier vidage, thread arrêté ; les messages suivants sont écrits aussitôt.
+ */
+void logger_stop(void)
+{
+    if (!running)
+        return;
+    __atomic_store_n(&stop_requested, 1, __ATOMIC_RELEASE);
+    pthread_join(writer, NULL);
+    __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+    drain(); // Messages publiés entre le dernier vidage du thread et l'arrêt
+    uint64_t lost = logger_dropped();
+    if (lost > 0)
+        logger_write(LOG_WARN, "[LOG] %llu message(s) perdu(s), journal plein\n", (unsigned long long)lost);
+    if (forced)
+    {
+        set_file(NULL);
+        forced = false;
+    }
+}
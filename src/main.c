@@ -3,30 +3,1376 @@
  * @brief Point d'entrée principal (Main Entry Point) du jeu.
  *
  * Ce fichier orchestre l'ensemble du projet :
- * 1. Il lit les arguments CLI pour choisir le moteur graphique (SDL ou Ncurses).
+ * 1. Il lit les arguments CLI pour choisir le moteur graphique (SDL, Ncurses ou ANSI direct).
  * 2. Il initialise le Modèle (Données) et la Vue (Affichage).
  * 3. Il exécute la "Game Loop" (Boucle de jeu) qui gère le temps, les inputs et le rendu.
+ *
+ * Un mode "headless" (sans affichage) permet aussi de simuler des parties
+ * à pleine vitesse : `./space_invaders headless [ticks] [script] [graine]`, ou
+ * beaucoup de parties sur tous les cœurs : `./space_invaders pool <parties>` (cf. pool.h).
+ * `./space_invaders tune [niveaux] [parties] [vagues.txt]` en tire une courbe de
+ * difficulté, écrite en script de vagues (cf. tune.h).
+ * `./space_invaders difftest [ticks] [graine]` compare model_update à son chemin de
+ * référence, tick par tick (cf. difftest.h).
+ *
+ * Une session interactive peut être enregistrée (`./space_invaders sdl record partie.rpl`)
+ * puis rejouée à l'identique, sans Vue ou à l'écran en accéléré
+ * (`./space_invaders replay partie.rpl sdl 8 120` : vitesse x8 à partir de 2 min).
+ *
+ * `./space_invaders bench-render <sdl|sdlgpu|ncurses|ansi> [images] [graine] [--stress=nom]` mesure le
+ * rendu seul sur une scène fixe, ou sur un scénario de pire cas (cf. render_bench.h, stress.h).
+ *
+ * Avec SPACE_INVADERS_RENDER_CAPTURE=fichier, la Vue SDL enregistre ses appels
+ * au renderer ; `./space_invaders render-replay fichier [passes] [pilote]` les
+ * rejoue sans le jeu ni ses ressources, aussi vite que possible (cf. rendercap.h).
+ *
+ * `./space_invaders snapshot image.png [ticks|sauvegarde.dat]` dessine un état
+ * du jeu hors écran et l'écrit en PNG (images de référence, cf. sdl_snapshot).
+ *
+ * `./space_invaders pack [archive]` range les ressources dans une archive
+ * projetée en mémoire au démarrage de la Vue SDL (cf. asset_pack.h).
+ *
+ * `./space_invaders server [port]` simule seule la partie et la diffuse en UDP ;
+ * `./space_invaders client <hote> [port] [sdl|sdlgpu|ncurses|ansi|headless]` ne fait
+ * qu'afficher ses images et lui envoyer les commandes (cf. net.h).
+ * `./space_invaders coop host` et `./space_invaders coop join <hote>` jouent
+ * à deux vaisseaux, chaque machine simulant la partie (rollback, cf. coop.h).
+ * `./space_invaders relay <hote> [port]` relaie la partie d'un serveur à ses
+ * spectateurs, `./space_invaders watch <hote> [port]` la regarde (cf. broadcast.h).
+ *
+ * Avec SPACE_INVADERS_PARAMS=fichier, les vitesses, l'OVNI et la cadence de
+ * tir se règlent en pleine partie : `./space_invaders params fichier cle=valeur...`
+ * publie de nouvelles valeurs, appliquées au tick suivant (cf. params.h).
+ *
+ * Avec SPACE_INVADERS_OVERLAY=fichier, la boucle publie après chaque rendu la
+ * scène, le score et les mesures du profileur dans un bloc partagé, que
+ * d'autres processus lisent sans jamais la ralentir : `./space_invaders overlay
+ * fichier` en affiche un résumé (cf. overlay.h).
+ *
+ * Avec SPACE_INVADERS_SIM_THREAD=1, la simulation tourne sur son propre thread
+ * et la Vue dessine le dernier état publié (cf. sim_thread.h).
+ *
+ * Chaque phase de la boucle est chronométrée (cf. profiler.h) et résumée à
+ * la sortie ; SPACE_INVADERS_PROFILE=0 coupe les sondes. Avec
+ * SPACE_INVADERS_TRACE=fichier.json, les mesures sont aussi exportées en
+ * trace Chrome à la sortie (et sur F12).
+ *
+ * Avec `--kiosk`, une partie finie ("Quitter" du menu, du Game Over ou de la
+ * confirmation) ne ferme pas le jeu : le Modèle revient à l'accueil
+ * (model_restart) et la Vue garde ses textures, polices et sons chargés.
+ * Seule une sortie forcée (second CMD_EXIT) arrête le processus.
+ *
+ * Au repos des menus (model_is_idle), la boucle ne redessine plus à 60 Hz :
+ * elle attend une entrée dans la Vue (ViewInterface::wait_input), au plus
+ * IDLE_WAIT_S secondes. SPACE_INVADERS_IDLE=0 garde la cadence fixe.
+ *
+ * Sur batterie, ou quand la machine chauffe (power.h), la boucle n'affiche
+ * plus que POWER_SAVER_HZ images par seconde et attend plus longtemps au
+ * repos ; la simulation garde son tick fixe.
  */
 
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
 
 #include "model.h"
 #include "view_ncurses.h"
 #include "view_sdl.h"
 #include "utils.h"
+#include "headless.h"
+#include "pool.h"
+#include "difftest.h"
+#include "tune.h"
+#include "asset_pack.h"
+#include "autosave.h"
+#include "replay.h"
+#include "flightrec.h"
+#include "logger.h"
+#include "suspend.h"
+#include "affinity.h"
+#include "workset.h"
+#include "sim_thread.h"
+#include "profiler.h"
+#include "metrics.h"
+#include "overlay.h"
+#include "telemetry.h"
+#include "leaderboard.h"
+#include "mirror.h"
+#include "render_bench.h"
+#include "rendercap.h"
+#include "wave.h"
+#include "lang.h"
+#include "bot.h"
+#include "net.h"
+#include "broadcast.h"
+#include "coop.h"
+#include "save.h"
+#include "hub.h"
+#include "power.h"
+#include "startup.h"
+
+/** @brief Réglages de `--bot=N` (cf. bot.h), NULL sans l'option. */
+static const BotConfig *bot_option = NULL;
+
+/** @brief Partie demandée à un serveur multi-parties (`--match=N`, client). */
+static int match_option = 0;
+
+/** @brief Borne de jeu (`--kiosk`) : "Quitter" redémarre la session à chaud au lieu de fermer. */
+static bool kiosk_option = false;
+
+/** @brief Échelle de temps en millièmes (`--time-scale=X`, SPACE_INVADERS_TIME_SCALE) : ticks par seconde réelle. */
+static uint32_t time_scale_option = TIME_SCALE_NORMAL;
+
+/** @brief Attente des entrées au repos des menus (false : SPACE_INVADERS_IDLE=0). */
+static bool idle_option = true;
+
+/** @brief Lancement du processus (temps de démarrage des métriques de flotte). */
+static double boot_time = 0.0;
+
+/** @brief Vue miroir de `--mirror=<vue>` (inactive sans l'option). */
+static MirrorView mirror;
+
+/** @brief Régulateur d'énergie (SPACE_INVADERS_POWER), relu par les deux boucles de jeu. */
+static PowerGovernor power;
+
+/**
+ * @brief Vue graphique désignée par son nom : "sdl", ou "sdlgpu" (pilote SDL_GPU, cf. view_sdl.h).
+ * @return La Vue, ou NULL si le nom n'en désigne aucune.
+ */
+static const ViewInterface *graphic_view(const char *name)
+{
+    if (strcmp(name, "sdl") == 0)
+        return &view_sdl;
+    if (strcmp(name, "sdlgpu") == 0)
+        return &view_sdlgpu;
+    return NULL;
+}
+
+/**
+ * @brief Vue texte désignée par son nom : "ncurses", "ansi" (séquences écrites directement, cf. view_ncurses.h)
+ *        ou "web" (diffusée aux navigateurs, en lecture seule, cf. webterm.h).
+ * @return La Vue, ou NULL si le nom n'en désigne aucune.
+ */
+static const ViewInterface *text_view(const char *name)
+{
+    if (strcmp(name, "ncurses") == 0)
+        return &view_ncurses;
+    if (strcmp(name, "ansi") == 0)
+        return &view_ansi;
+    if (strcmp(name, "web") == 0)
+        return &view_web;
+    return NULL;
+}
+
+/**
+ * @brief Point d'entrée du mode headless (simulation sans Vue).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = nombre de ticks (optionnel), argv[3] = script d'entrées (optionnel),
+ *             argv[4] = graine du générateur (optionnel, décimal ou 0x hexadécimal).
+ * @return 0 si succès, 1 si erreur d'initialisation.
+ */
+static int run_headless(int argc, char *argv[])
+{
+    HeadlessConfig cfg;
+    headless_default_config(&cfg);
+    cfg.bot = bot_option;
+    if (argc > 2)
+        cfg.max_ticks = atol(argv[2]);
+    if (argc > 3)
+        cfg.script = argv[3];
+    if (argc > 4)
+        cfg.seed = strtoull(argv[4], NULL, 0);
+
+    GameModel *model = model_init();
+    if (!model)
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        return 1;
+    }
+
+    HeadlessStats stats;
+    headless_run(model, &cfg, &stats);
+    headless_print_stats(&stats);
+
+    model_free(model);
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée du mode difftest (model_update contre model_update_reference, cf. difftest.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = nombre de ticks (optionnel), argv[3] = graine (optionnel, décimal ou 0x hexadécimal),
+ *             argv[4] = script d'entrées (optionnel, sans --bot).
+ * @return 0 si les deux chemins restent identiques, 1 en cas de divergence ou d'erreur.
+ */
+static int run_difftest(int argc, char *argv[])
+{
+    DiffTestConfig cfg;
+    difftest_default_config(&cfg);
+    cfg.bot = bot_option;
+    if (argc > 2)
+        cfg.max_ticks = atol(argv[2]);
+    if (argc > 3)
+        cfg.seed = strtoull(argv[3], NULL, 0);
+    if (argc > 4)
+        cfg.script = argv[4];
+
+    DiffTestResult result;
+    if (!difftest_run(&cfg, &result))
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        return 1;
+    }
+    difftest_print(&result);
+    return result.diverged_tick >= 0;
+}
+
+/**
+ * @brief Point d'entrée du mode pool (parties headless en parallèle, cf. pool.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = nombre de parties, argv[3] = threads (0 : un par cœur),
+ *             argv[4] = ticks au plus par partie, argv[5] = graine de la première partie ;
+ *             ou argv[2] = "replay" suivi des enregistrements à rejouer ;
+ *             ou argv[2] = "verify", argv[3] = dossier d'enregistrements, argv[4] = threads.
+ * @return 0 si succès, 1 si les arguments sont invalides, si aucun thread n'a démarré
+ *         ou si un enregistrement vérifié n'est pas valide.
+ */
+static int run_pool(int argc, char *argv[])
+{
+    PoolConfig cfg = {0, 0, MODEL_RNG_DEFAULT_SEED, HEADLESS_DEFAULT_TICKS, NULL, bot_option, NULL, 0, 0, NULL};
+    char **listed = NULL;
+    if (argc > 3 && strcmp(argv[2], "verify") == 0)
+    {
+        listed = pool_list_replays(argv[3], &cfg.replay_count);
+        if (!listed)
+        {
+            fprintf(stderr, "[ERREUR] Dossier illisible : %s\n", argv[3]);
+            return 1;
+        }
+        if (cfg.replay_count == 0)
+        {
+            printf("[VERIFY] Aucun enregistrement dans %s\n", argv[3]);
+            pool_free_replays(listed, 0);
+            return 0;
+        }
+        cfg.replays = (const char *const *)listed;
+        cfg.verdicts = calloc((size_t)cfg.replay_count + 1, sizeof(PoolVerdict));
+        if (argc > 4)
+            cfg.threads = atoi(argv[4]);
+    }
+    else if (argc > 2 && strcmp(argv[2], "replay") == 0)
+    {
+        cfg.replays = (const char *const *)(argv + 3);
+        cfg.replay_count = argc - 3;
+    }
+    else if (argc > 2)
+    {
+        cfg.games = atol(argv[2]);
+        if (argc > 3)
+            cfg.threads = atoi(argv[3]);
+        if (argc > 4)
+            cfg.max_ticks = atol(argv[4]);
+        if (argc > 5)
+            cfg.first_seed = strtoull(argv[5], NULL, 0);
+    }
+    bool usable = (cfg.replays ? cfg.replay_count : cfg.games) > 0 && cfg.threads >= 0 && cfg.max_ticks > 0 &&
+                  (!listed || cfg.verdicts);
+    PoolSummary summary;
+    int status = 1;
+    if (!usable)
+        fprintf(stderr, "Usage : %s pool <parties> [threads] [ticks_max] [graine]\n"
+                        "        %s pool replay <fichier.rpl>...\n"
+                        "        %s pool verify <dossier> [threads]\n", argv[0], argv[0], argv[0]);
+    else if (!pool_run(&cfg, &summary))
+        fprintf(stderr, "[ERREUR] Impossible de lancer les threads du pool\n");
+    else
+    {
+        pool_print_summary(&cfg, &summary);
+        status = summary.invalid > 0;
+    }
+    free(cfg.verdicts);
+    if (listed)
+        pool_free_replays(listed, cfg.replay_count);
+    return status;
+}
+
+/**
+ * @brief Point d'entrée du mode tune (réglage de la difficulté, cf. tune.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = niveaux à régler, argv[3] = parties par essai, argv[4] = script
+ *             à écrire (sortie standard sinon), argv[5] = threads (0 : un par cœur).
+ * @return 0 si succès, 1 si les arguments sont invalides, le pool absent ou le fichier impossible à écrire.
+ */
+static int run_tune(int argc, char *argv[])
+{
+    TuneConfig cfg;
+    tune_default_config(&cfg);
+    cfg.bot = bot_option;
+    if (argc > 2)
+        cfg.levels = atoi(argv[2]);
+    if (argc > 3)
+        cfg.games = atol(argv[3]);
+    if (argc > 5)
+        cfg.threads = atoi(argv[5]);
+    if (cfg.levels < 1 || cfg.levels > WAVE_MAX || cfg.games < 1 || cfg.threads < 0)
+    {
+        fprintf(stderr, "Usage : %s tune [niveaux 1-%d] [parties] [vagues.txt] [threads]\n", argv[0], WAVE_MAX);
+        return 1;
+    }
+
+    static TuneResult result;
+    if (!tune_run(&cfg, &result))
+    {
+        fprintf(stderr, "[ERREUR] Impossible de lancer les threads du pool\n");
+        return 1;
+    }
+    tune_print(&result);
+
+    static char text[16384];
+    size_t len = wave_format(&result.table, text, sizeof(text));
+    FILE *out = argc > 4 ? fopen(argv[4], "w") : stdout;
+    if (!out || fwrite(text, 1, len, out) != len)
+    {
+        fprintf(stderr, "[ERREUR] Impossible d'ecrire %s\n", argc > 4 ? argv[4] : "le script");
+        if (out && out != stdout)
+            fclose(out);
+        return 1;
+    }
+    if (out != stdout)
+    {
+        fclose(out);
+        printf("[TUNE] Script        : %s (SPACE_INVADERS_WAVES=%s)\n", argv[4], argv[4]);
+    }
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée du mode replay (rejeu d'un enregistrement).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = fichier d'enregistrement (.rpl), argv[3] = vue ("headless" par défaut,
+ *             "sdl" ou "ncurses"), argv[4] = vitesse ("1", "2", "8" ou "max"),
+ *             argv[5] = instant de départ en secondes de jeu.
+ * @return 0 si succès, 1 si le fichier est absent ou invalide, ou si une empreinte d'état diffère.
+ */
+static int run_replay(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s replay <fichier.rpl> [headless|sdl|sdlgpu|ncurses|ansi] [1|2|8|max] [debut_s]\n", argv[0]);
+        return 1;
+    }
+
+    ReplayOptions opt = {NULL, 1, 0.0, NULL};
+    if (argc > 3 && graphic_view(argv[3]))
+        opt.view = graphic_view(argv[3]);
+    else if (argc > 3 && text_view(argv[3]))
+        opt.view = text_view(argv[3]);
+    if (argc > 4)
+        opt.speed = (strcmp(argv[4], "max") == 0) ? REPLAY_SPEED_MAX : atoi(argv[4]);
+    if (opt.speed < 0 || !opt.view)
+        opt.speed = REPLAY_SPEED_MAX;
+    if (argc > 5)
+        opt.start_s = atof(argv[5]);
+
+    GameModel *model = model_init();
+    if (!model)
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        return 1;
+    }
+    if (opt.view && !opt.view->init())
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        model_free(model);
+        return 1;
+    }
+
+    // Empreinte de chaque tick rejoué (SPACE_INVADERS_HASH_TRACE) : deux traces comparées donnent le tick exact d'une divergence
+    const char *trace_env = getenv("SPACE_INVADERS_HASH_TRACE");
+    if (trace_env && trace_env[0] && !(opt.hash_trace = fopen(trace_env, "w")))
+        fprintf(stderr, "[ERREUR] Impossible de creer %s\n", trace_env);
+
+    ReplayStats stats;
+    bool ok = replay_play(model, argv[2], &opt, &stats);
+    if (opt.view)
+        opt.view->close();
+    if (opt.hash_trace)
+        fclose(opt.hash_trace);
+    if (ok)
+        replay_print_stats(&stats);
+    else
+        fprintf(stderr, "[ERREUR] Enregistrement illisible : %s\n", argv[2]);
+
+    model_free(model);
+    return ok && stats.hash_mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Construit l'archive des ressources (cf. asset_pack.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = archive à écrire (optionnel, ASSET_PACK_PATH par défaut).
+ * @return 0 si succès, 1 si l'archive n'a pas pu être écrite.
+ */
+static int run_pack(int argc, char *argv[])
+{
+    const char *path = (argc > 2) ? argv[2] : ASSET_PACK_PATH;
+    double t0 = utils_get_time();
+    int count = asset_pack_build(path);
+    if (count < 0)
+    {
+        fprintf(stderr, "[ERREUR] Impossible d'écrire l'archive %s\n", path);
+        return 1;
+    }
+    printf("[PACK] %d ressources dans %s (%.0f ms)\n", count, path, (utils_get_time() - t0) * 1000.0);
+    return 0;
+}
+
+/**
+ * @brief Agrège des journaux de télémétrie en CSV (cf. telemetry.h).
+ *
+ * `telemetry stats` agrège en parallèle des journaux ou des dossiers entiers
+ * (carte des morts, abattus par type, survie), sans CSV des événements.
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = préfixe des CSV, argv[3..] = journaux `.tlm` ;
+ *             ou argv[2] = "stats", argv[3] = préfixe, argv[4..] = journaux ou dossiers.
+ * @return 0 si succès, 1 si les arguments manquent ou si les CSV n'ont pas pu être écrits.
+ */
+static int run_telemetry(int argc, char *argv[])
+{
+    bool stats = argc > 2 && strcmp(argv[2], "stats") == 0;
+    if (argc < (stats ? 5 : 4))
+    {
+        fprintf(stderr, "Usage : %s telemetry <prefixe> <journal.tlm>...\n", argv[0]);
+        fprintf(stderr, "        %s telemetry stats <prefixe> <journal.tlm|dossier>...\n", argv[0]);
+        return 1;
+    }
+    if (stats)
+    {
+        long logs = telemetry_aggregate(argv[3], (const char *const *)argv + 4, argc - 4);
+        if (logs < 0)
+            fprintf(stderr, "[ERREUR] Impossible d'écrire les fichiers %s-*\n", argv[3]);
+        return logs > 0 ? 0 : 1;
+    }
+    int read = telemetry_export(argv[2], (const char *const *)argv + 3, argc - 3);
+    if (read < 0)
+    {
+        fprintf(stderr, "[ERREUR] Impossible d'écrire %s.csv\n", argv[2]);
+        return 1;
+    }
+    return read > 0 ? 0 : 1;
+}
+
+/**
+ * @brief Affiche l'état de la file du classement (cf. leaderboard.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = dossier des sauvegardes (optionnel, "sauvegardes" par défaut).
+ * @return 0 si succès, 1 si la file est absente ou invalide.
+ */
+static int run_leaderboard(int argc, char *argv[])
+{
+    const char *dir = argc > 2 ? argv[2] : "sauvegardes";
+    LeaderboardStats st;
+    if (!leaderboard_status(dir, &st))
+    {
+        fprintf(stderr, "Usage : %s leaderboard [dossier]\n", argv[0]);
+        fprintf(stderr, "[ERREUR] Pas de file valide dans %s/%s\n", dir, LEADERBOARD_FILE);
+        return 1;
+    }
+    printf("Classement : %llu partie(s) dans la file, %llu acceptée(s), %llu en attente\n",
+           (unsigned long long)st.records, (unsigned long long)st.acked,
+           (unsigned long long)(st.records - st.acked));
+    return 0;
+}
+
+/**
+ * @brief Lit ou modifie le bloc de paramètres d'une partie en cours (cf. params.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = fichier du bloc, argv[3..] = affectations `cle=valeur` (optionnelles).
+ * @return 0 si succès, 1 si le bloc est illisible ou une affectation invalide.
+ */
+static int run_params(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s params <fichier> [cle=valeur]...\n", argv[0]);
+        return 1;
+    }
+    if (!params_live_open(argv[2]))
+    {
+        fprintf(stderr, "[ERREUR] Paramètres %s : bloc illisible\n", argv[2]);
+        return 1;
+    }
+    SimParams p;
+    params_live_read(&p);
+    for (int i = 3; i < argc; i++)
+    {
+        if (!params_set(&p, argv[i]))
+        {
+            fprintf(stderr, "[ERREUR] Affectation invalide : %s\n", argv[i]);
+            params_live_close();
+            return 1;
+        }
+    }
+    if (argc > 3)
+        params_live_publish(&p);
+    char text[PARAMS_TEXT_MAX];
+    params_format(&p, text, sizeof(text));
+    fputs(text, stdout);
+    params_live_close();
+    return 0;
+}
+
+/**
+ * @brief Inspecteur : lit l'image partagée d'une partie en cours et la résume (cf. overlay.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = fichier du bloc, argv[3] = lectures par seconde (optionnel, 2),
+ *             argv[4] = durée en secondes (optionnel, 0 : jusqu'à Ctrl+C).
+ * @return 0 si succès, 1 si le bloc est illisible.
+ */
+static int run_overlay(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s overlay <fichier> [lectures/s] [secondes]\n", argv[0]);
+        return 1;
+    }
+    OverlayReader reader;
+    if (!overlay_attach(&reader, argv[2]))
+    {
+        fprintf(stderr, "[ERREUR] Image %s : bloc illisible (jeu lancé avec SPACE_INVADERS_OVERLAY ?)\n", argv[2]);
+        return 1;
+    }
+    double hz = (argc > 3) ? atof(argv[3]) : 2.0;
+    double seconds = (argc > 4) ? atof(argv[4]) : 0.0;
+    if (hz <= 0.0)
+        hz = 2.0;
+    OverlayFrame *f = malloc(sizeof(OverlayFrame));
+    if (!f)
+    {
+        overlay_detach(&reader);
+        return 1;
+    }
+    double start = utils_get_time();
+    uint64_t last = 0;
+    for (double next = start; seconds <= 0.0 || next - start < seconds; next += 1.0 / hz)
+    {
+        utils_sleep_until(next);
+        if (!overlay_read(&reader, f) || f->frame == last)
+            continue;
+        last = f->frame;
+        printf("[OVERLAY] image %llu | état %d | score %d | vies %d | niveau %d | %d aliens, %d balles | "
+               "image %.2f ms (moy. %.2f) | tick moy. %.3f ms | rendu %.2f ms\n",
+               (unsigned long long)f->frame, f->state, f->score, f->lives, f->level,
+               f->first[SCENE_ENEMY + 1] - f->first[SCENE_ENEMY], f->first[SCENE_BULLET + 1] - f->first[SCENE_BULLET],
+               f->frame_ms[PROF_FRAME], f->avg_ms[PROF_FRAME], f->avg_ms[PROF_UPDATE], f->frame_ms[PROF_RENDER]);
+        fflush(stdout);
+    }
+    printf("[OVERLAY] Lectures reprises : %llu, abandonnées : %llu\n", (unsigned long long)reader.retries,
+           (unsigned long long)reader.misses);
+    free(f);
+    overlay_detach(&reader);
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée du serveur réseau (cf. net.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = port UDP (optionnel, NET_DEFAULT_PORT), argv[3] = durée en secondes
+ *             (optionnel, 0 : jusqu'à Ctrl+C), argv[4] = graine (optionnel), argv[5] = port de
+ *             diffusion aux spectateurs (optionnel, cf. broadcast.h).
+ * @return 0 si succès, 1 si le serveur n'a pas pu démarrer.
+ */
+static int run_server(int argc, char *argv[])
+{
+    int port = (argc > 2) ? atoi(argv[2]) : NET_DEFAULT_PORT;
+    double seconds = (argc > 3) ? atof(argv[3]) : 0.0;
+    uint64_t seed = (argc > 4) ? strtoull(argv[4], NULL, 0) : (uint64_t)time(NULL);
+    int broadcast_port = (argc > 5) ? atoi(argv[5]) : 0;
+
+    NetStats stats;
+    if (!net_run_server(port, seconds, seed, broadcast_port, &stats))
+        return 1;
+    net_print_stats(&stats, "SERVEUR");
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée du serveur multi-parties (cf. hub.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = nombre de parties, argv[3] = durée en secondes (optionnel, 0 : jusqu'à Ctrl+C),
+ *             argv[4] = threads de calcul (optionnel, 0 : un par cœur), argv[5] = port UDP des clients
+ *             (optionnel, aucun réseau sans lui).
+ * @return 0 si succès, 1 si le serveur n'a pas pu démarrer.
+ */
+static int run_hub(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s hub <parties> [secondes] [threads] [port] [--bot=N]\n", argv[0]);
+        return 1;
+    }
+    HubConfig cfg = {atoi(argv[2]), (argc > 4) ? atoi(argv[4]) : 0, (uint64_t)time(NULL), bot_option};
+    double seconds = (argc > 3) ? atof(argv[3]) : 0.0;
+    int port = (argc > 5) ? atoi(argv[5]) : 0;
+    if (cfg.matches > 0 && cfg.matches <= HUB_MAX_MATCHES)
+        workset_init((size_t)cfg.matches * model_block_bytes() + WORKSET_EXTRA_BYTES);
+
+    Hub *hub = hub_create(&cfg);
+    if (!hub || !hub_start(hub))
+    {
+        fprintf(stderr, "[ERREUR] Serveur : %d parties impossibles (1 a %d)\n", cfg.matches, HUB_MAX_MATCHES);
+        hub_free(hub);
+        workset_close();
+        return 1;
+    }
+    NetStats net_stats;
+    bool networked = port > 0 && net_run_hub(hub, port, seconds, &net_stats);
+    if (port <= 0)
+        hub_wait(hub, seconds);
+    HubStats stats;
+    hub_stop(hub, &stats);
+    hub_print_stats(&stats);
+    if (networked)
+        net_print_stats(&net_stats, "SERVEUR");
+    hub_free(hub);
+    workset_report();
+    workset_close();
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée du client d'affichage (cf. net.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = hôte du serveur, argv[3] = port (optionnel), argv[4] = vue ("ncurses" par défaut,
+ *             "sdl" ou "headless"), argv[5] = durée en secondes (optionnel), argv[6] = script du client
+ *             headless (optionnel).
+ * @return 0 si succès, 1 si le serveur est injoignable ou la vue n'a pas pu s'ouvrir.
+ */
+static int run_client(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s client <hote> [port] [sdl|sdlgpu|ncurses|ansi|web|headless] [secondes] [script]\n", argv[0]);
+        return 1;
+    }
+    int port = (argc > 3) ? atoi(argv[3]) : NET_DEFAULT_PORT;
+    const ViewInterface *view = &view_ncurses;
+    if (argc > 4 && graphic_view(argv[4]))
+        view = graphic_view(argv[4]);
+    else if (argc > 4 && text_view(argv[4]))
+        view = text_view(argv[4]);
+    else if (argc > 4 && strcmp(argv[4], "headless") == 0)
+        view = NULL;
+    double seconds = (argc > 5) ? atof(argv[5]) : 0.0;
+
+    if (view && !view->init())
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        return 1;
+    }
+    NetStats stats;
+    bool ok = net_run_client(argv[2], port, match_option, view, (argc > 6) ? argv[6] : NULL, seconds, &stats);
+    if (view)
+        view->close();
+    if (ok)
+        net_print_stats(&stats, "CLIENT");
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Point d'entrée du relais de diffusion (cf. broadcast.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = hôte de la source (ou d'un autre relais), argv[3] = son port (optionnel),
+ *             argv[4] = port d'écoute des spectateurs (optionnel, son port + 1), argv[5] = durée
+ *             en secondes (optionnel, 0 : jusqu'à Ctrl+C).
+ * @return 0 si succès, 1 si la source est injoignable ou le port indisponible.
+ */
+static int run_relay(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s relay <hote> [port de la source] [port] [secondes]\n", argv[0]);
+        return 1;
+    }
+    int upstream = (argc > 3) ? atoi(argv[3]) : BROADCAST_DEFAULT_PORT;
+    int port = (argc > 4) ? atoi(argv[4]) : upstream + 1;
+    double seconds = (argc > 5) ? atof(argv[5]) : 0.0;
+
+    BroadcastStats stats;
+    if (!broadcast_run_relay(argv[2], upstream, port, seconds, &stats))
+        return 1;
+    broadcast_print_stats(&stats, "RELAIS");
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée d'un spectateur (cf. broadcast.h).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = hôte du relais (ou de la source), argv[3] = port (optionnel), argv[4] = vue
+ *             ("ncurses" par défaut, "sdl" ou "headless"), argv[5] = durée en secondes (optionnel).
+ * @return 0 si succès, 1 si le relais est injoignable ou la vue n'a pas pu s'ouvrir.
+ */
+static int run_watch(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s watch <hote> [port] [sdl|sdlgpu|ncurses|ansi|web|headless] [secondes]\n", argv[0]);
+        return 1;
+    }
+    int port = (argc > 3) ? atoi(argv[3]) : BROADCAST_DEFAULT_PORT + 1;
+    const ViewInterface *view = &view_ncurses;
+    if (argc > 4 && graphic_view(argv[4]))
+        view = graphic_view(argv[4]);
+    else if (argc > 4 && text_view(argv[4]))
+        view = text_view(argv[4]);
+    else if (argc > 4 && strcmp(argv[4], "headless") == 0)
+        view = NULL;
+    double seconds = (argc > 5) ? atof(argv[5]) : 0.0;
+
+    if (view && !view->init())
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        return 1;
+    }
+    BroadcastStats stats;
+    bool ok = broadcast_run_spectator(argv[2], port, view, seconds, &stats);
+    if (view)
+        view->close();
+    if (ok)
+        broadcast_print_stats(&stats, "SPECTATEUR");
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Point d'entrée de la coopération en réseau (cf. coop.h).
+ *
+ * SPACE_INVADERS_NET_LAG=ms retarde chaque paquet envoyé (essais de latence).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = "host" puis port, vue ("ncurses" par défaut, "sdl" ou "headless"),
+ *             durée en secondes et graine (optionnels) ; ou argv[2] = "join", argv[3] = hôte,
+ *             puis port, vue et durée (optionnels).
+ * @return 0 si succès, 1 si les arguments sont invalides ou si la partie n'a pas pu commencer.
+ */
+static int run_coop(int argc, char *argv[])
+{
+    bool host = argc > 2 && strcmp(argv[2], "host") == 0;
+    bool join = argc > 3 && strcmp(argv[2], "join") == 0;
+    if (!host && !join)
+    {
+        fprintf(stderr, "Usage : %s coop host [port] [sdl|sdlgpu|ncurses|ansi|headless] [secondes] [graine]\n"
+                        "        %s coop join <hote> [port] [sdl|sdlgpu|ncurses|ansi|headless] [secondes]\n", argv[0], argv[0]);
+        return 1;
+    }
+    int arg = host ? 3 : 4; // Premier argument après l'hôte
+    CoopConfig cfg = {join ? argv[3] : NULL, COOP_DEFAULT_PORT, (uint64_t)time(NULL), &view_ncurses, NULL, 0.0, 0.0};
+    if (argc > arg)
+        cfg.port = atoi(argv[arg]);
+    if (argc > arg + 1 && graphic_view(argv[arg + 1]))
+        cfg.view = graphic_view(argv[arg + 1]);
+    else if (argc > arg + 1 && text_view(argv[arg + 1]))
+        cfg.view = text_view(argv[arg + 1]);
+    else if (argc > arg + 1 && strcmp(argv[arg + 1], "headless") == 0)
+        cfg.view = NULL;
+    if (argc > arg + 2)
+        cfg.seconds = atof(argv[arg + 2]);
+    if (host && argc > arg + 3)
+        cfg.seed = strtoull(argv[arg + 3], NULL, 0);
+    const char *lag_env = getenv("SPACE_INVADERS_NET_LAG");
+    if (lag_env)
+        cfg.lag = atof(lag_env) / 1000.0;
+
+    if (cfg.view && !cfg.view->init())
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        return 1;
+    }
+    CoopStats stats;
+    bool ok = coop_run(&cfg, &stats);
+    if (cfg.view)
+        cfg.view->close();
+    if (ok)
+        coop_print_stats(&stats);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Point d'entrée du banc de rendu (scène fixe dessinée sans attente).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = vue ("sdl", "sdlgpu", "ncurses" ou "ansi"), argv[3] = nombre d'images (optionnel),
+ *             argv[4] = graine du générateur (optionnel) ; `--stress=nom` (n'importe où
+ *             après la vue) redessine un scénario de pire cas (stress.h).
+ * @return 0 si succès, 1 si la vue ou le scénario sont inconnus, si la vue n'a pas pu être
+ *         ouverte, ou a alloué en partie.
+ */
+static int run_render_bench(int argc, char *argv[])
+{
+    RenderBenchConfig cfg;
+    render_bench_default_config(&cfg);
+    char *args[8];
+    int n = 0;
+    for (int i = 0; i < argc; i++)
+    {
+        if (i > 2 && strncmp(argv[i], "--stress=", 9) == 0)
+        {
+            if ((cfg.stress = stress_parse(argv[i] + 9)) == STRESS_NONE)
+            {
+                fprintf(stderr, "Scénario inconnu : %s (pool-full, formation, shields, ufo, all)\n", argv[i] + 9);
+                return 1;
+            }
+        }
+        else if (n < (int)(sizeof(args) / sizeof(args[0])))
+            args[n++] = argv[i];
+    }
+    argc = n;
+    argv = args;
+    if (argc > 2 && graphic_view(argv[2]))
+        cfg.view = graphic_view(argv[2]);
+    else if (argc > 2 && text_view(argv[2]))
+    {
+        cfg.view = text_view(argv[2]);
+        cfg.pty = true;
+        ncurses_set_unpaced(true);
+    }
+    if (!cfg.view)
+    {
+        fprintf(stderr, "Usage : %s bench-render <sdl|sdlgpu|ncurses|ansi> [images] [graine] [--stress=nom]\n",
+                argv[0]);
+        return 1;
+    }
+    if (argc > 3)
+        cfg.frames = atol(argv[3]);
+    if (argc > 4)
+        cfg.seed = strtoull(argv[4], NULL, 0);
+
+    GameModel *model = model_init();
+    if (!model)
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        return 1;
+    }
+
+    RenderBenchStats stats;
+    bool ok = render_bench_run(model, &cfg, &stats);
+    if (ok)
+        render_bench_print_stats(&cfg, &stats);
+
+    model_free(model);
+    return (ok && stats.steady_allocs == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Point d'entrée du rejeu d'un enregistrement de commandes de rendu.
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = fichier de commandes, argv[3] = nombre de passes (optionnel),
+ *             argv[4] = pilote SDL_Renderer (optionnel, celui de l'enregistrement par défaut).
+ * @return 0 si le fichier a été rejoué en entier, 1 sinon.
+ */
+static int run_render_replay(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s render-replay <commandes> [passes] [pilote]\n", argv[0]);
+        return 1;
+    }
+    int loops = argc > 3 ? atoi(argv[3]) : 1;
+    RendercapReport report;
+    if (!rendercap_play(argv[2], loops, argc > 4 ? argv[4] : NULL, &report))
+    {
+        fprintf(stderr, "Erreur : rejeu de %s impossible (fichier absent, invalide ou tronqué, ou pas de renderer).\n",
+                argv[2]);
+        return 1;
+    }
+    rendercap_print_report(&report);
+    return 0;
+}
+
+/**
+ * @brief Point d'entrée du mode snapshot : une image du jeu en PNG, sans fenêtre visible.
+ *
+ * L'état dessiné est soit une sauvegarde (argument en ".dat"), soit la partie
+ * jouée depuis le menu comme en headless (script par défaut) pendant le
+ * nombre de ticks donné : même graine, même image (cf. sdl_snapshot).
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv argv[2] = image PNG de sortie, argv[3] = ticks de jeu ou sauvegarde ".dat" (optionnel),
+ *             argv[4] = graine (optionnel), argv[5] = largeur en pixels (optionnel, WIN_WIDTH par défaut).
+ * @return 0 si l'image est écrite, 1 sinon.
+ */
+static int run_snapshot(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : %s snapshot <image.png> [ticks|sauvegarde.dat] [graine] [largeur]\n", argv[0]);
+        return 1;
+    }
+    long ticks = SNAPSHOT_DEFAULT_TICKS;
+    const char *save = NULL;
+    if (argc > 3)
+    {
+        size_t len = strlen(argv[3]);
+        if (len > 4 && strcmp(argv[3] + len - 4, ".dat") == 0)
+            save = argv[3];
+        else
+            ticks = atol(argv[3]);
+    }
+    uint64_t seed = argc > 4 ? strtoull(argv[4], NULL, 0) : MODEL_RNG_DEFAULT_SEED;
+    int width = argc > 5 ? atoi(argv[5]) : 0;
+
+    GameModel *model = model_init();
+    if (!model)
+    {
+        fprintf(stderr, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        return 1;
+    }
+
+    bool ok = true;
+    if (save)
+    {
+        SaveMapping map;
+        ok = save_map_file(save, &map);
+        if (ok)
+        {
+            ok = save_decode(model, map.data, map.len);
+            save_unmap_file(&map);
+        }
+        model->sim.state = STATE_PLAYING;
+        model_touch(model, MODEL_GEN_MENU);
+        if (!ok)
+            fprintf(stderr, "[ERREUR] Sauvegarde illisible : %s\n", save);
+    }
+    else
+    {
+        model_rng_seed(model, seed);
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 0; // "JOUER"
+        model_handle_input(model, CMD_RETURN);
+        size_t script_len = strlen(HEADLESS_DEFAULT_SCRIPT);
+        for (long t = 0; t < ticks && model->sim.state == STATE_PLAYING; t++)
+        {
+            model_handle_input(model, headless_script_command(HEADLESS_DEFAULT_SCRIPT[t % script_len]));
+            model_update(model, 1.0 / TARGET_FPS);
+        }
+    }
+
+    if (ok && !sdl_snapshot(model, argv[2], width))
+    {
+        fprintf(stderr, "[ERREUR] Impossible d'écrire l'image : %s\n", argv[2]);
+        ok = false;
+    }
+    if (ok)
+        printf("Image : %s (niveau %d, score %d)\n", argv[2], model->sim.level, model->sim.score);
+    model_free(model);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Lit une fréquence (Hz) dans une variable d'environnement.
+ *
+ * @param name Nom de la variable.
+ * @param fallback Valeur si la variable est absente ou hors de [10, 500].
+ */
+static int env_rate(const char *name, int fallback)
+{
+    const char *env = getenv(name);
+    int hz = env ? atoi(env) : 0;
+    return (hz >= 10 && hz <= 500) ? hz : fallback;
+}
+
+/**
+ * @brief Lit une échelle de temps ("0.25", "4") en millièmes, bornée à [TIME_SCALE_MIN, TIME_SCALE_MAX].
+ * @return TIME_SCALE_NORMAL si le texte est illisible ou nul.
+ */
+static uint32_t time_scale_parse(const char *text)
+{
+    double x = text ? atof(text) : 0.0;
+    if (!(x > 0.0))
+        return TIME_SCALE_NORMAL;
+    double milli = x * TIME_SCALE_NORMAL + 0.5;
+    return milli < TIME_SCALE_MIN ? TIME_SCALE_MIN : milli > TIME_SCALE_MAX ? TIME_SCALE_MAX : (uint32_t)milli;
+}
+
+/**
+ * @brief Résume le profil et écrit la trace, une fois la Vue fermée.
+ *
+ * Appelé en fin de main, après view->close() : le résumé ne s'affiche pas
+ * dans un terminal encore en mode ncurses.
+ */
+static void profile_report(void)
+{
+    if (!profiler_enabled())
+        return;
+    profiler_report();
+    if (profiler_trace_active())
+        printf("Trace : %zu événements écrits\n", profiler_trace_flush());
+    int slices = profiler_hitch_flush();
+    if (slices > 0)
+        printf("Images lentes : %d tranche(s) de trace écrite(s)\n", slices);
+}
+
+/**
+ * @brief Contexte d'une image lente (profiler_hitch_detected) : état et entités vivantes.
+ */
+static void hitch_context(const GameModel *model)
+{
+    profiler_hitch_context("etat", model->sim.state);
+    profiler_hitch_context("aliens", model->sim.formation.alive_count);
+    profiler_hitch_context("balles", model->sim.bullets.live.count);
+    profiler_hitch_context("entites", model->sim.ecs.alive);
+    profiler_hitch_context("ovni", model->sim.ufo.active);
+}
+
+/**
+ * @brief Métriques de flotte d'une image affichée : temps de démarrage à la première, parties lancées.
+ */
+static void fleet_metrics(const GameModel *model)
+{
+    static bool shown = false;
+    static GameStateEnum last = STATE_MENU;
+    if (!metrics_enabled())
+        return;
+    if (!shown)
+    {
+        metrics_set_startup(utils_get_time() - boot_time);
+        shown = true;
+    }
+    GameStateEnum state = model->sim.state;
+    if (state == STATE_PLAYING && (last == STATE_MENU || last == STATE_LOAD_MENU || last == STATE_GAME_OVER ||
+                                   last == STATE_VICTORY))
+        metrics_count(METRIC_GAMES, 1);
+    last = state;
+}
+
+/**
+ * @brief File du classement : la partie est ajoutée à son passage au Game Over ou à la victoire.
+ */
+static void leaderboard_watch(const GameModel *model)
+{
+    static GameStateEnum last = STATE_MENU;
+    GameStateEnum state = model->sim.state;
+    bool over = state == STATE_GAME_OVER || state == STATE_VICTORY;
+    if (over && last != STATE_GAME_OVER && last != STATE_VICTORY)
+        leaderboard_submit(model);
+    last = state;
+}
+
+/**
+ * @brief Applique au modèle les commandes de la file survenues avant `until`.
+ *
+ * Chacune est enregistrée à part (replay_record_command, et dans
+ * l'enregistreur de vol) : ses ticks suivront, le rejeu retrouve donc la
+ * même répartition.
+ *
+ * @return false si une commande demande de quitter immédiatement (second CMD_EXIT
+ *         ou menu "Quitter") ; les commandes suivantes restent dans la file.
+ */
+static bool dispatch_commands(GameModel *model, CommandQueue *input, double until, ReplayRecorder *recorder,
+                              FlightRecorder *flight)
+{
+    GameCommand cmd;
+    while (command_queue_pop(input, until, &cmd))
+    {
+        flight_record_command(flight, model, cmd);
+        replay_record_command(recorder, model, cmd);
+        if (!model_dispatch_command(model, cmd))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Fin d'image : pause jusqu'à l'image suivante, ou attente d'une entrée au repos.
+ *
+ * Le repos commence après IDLE_GRACE_FRAMES images sans entrée, pour que
+ * l'effet de la dernière touche (publié un tick plus tard avec le thread de
+ * simulation) soit dessiné avant de s'endormir.
+ *
+ * @param calm Images consécutives sans entrée (mis à jour).
+ * @param had_input La Vue a lu au moins une commande pendant cette image.
+ * @return true si l'image s'est terminée au repos : l'intervalle suivant n'est pas une durée de frame.
+ */
+static bool frame_wait(const ViewInterface *view, const GameModel *model, FramePacer *pacer, int *calm, bool had_input)
+{
+    *calm = had_input ? 0 : *calm + 1;
+    if (idle_option && view->wait_input && *calm >= IDLE_GRACE_FRAMES && model_is_idle(model) &&
+        view->wait_input(power_saving(model->ui.power_mode) ? POWER_IDLE_WAIT_S : IDLE_WAIT_S))
+    {
+        utils_pacer_rebase(pacer);
+        return true;
+    }
+    utils_pacer_wait(pacer);
+    return false;
+}
+
+/**
+ * @brief Relit le mode d'énergie et le passe à la Vue ; à un changement, adapte la cadence d'affichage.
+ *
+ * @param render_hz Cadence d'affichage nominale.
+ */
+static void power_frame(GameModel *model, FramePacer *pacer, int render_hz)
+{
+    if (power_update(&power, utils_get_time()))
+    {
+        utils_pacer_set_rate(pacer, power_render_hz(power.mode, render_hz));
+        logger_write(LOG_INFO, "[ENERGIE] Mode %s : %d images/s au plus (batterie %d%%, %d C)\n", power_name(power.mode),
+                     power_render_hz(power.mode, render_hz), power.battery, power.temp_c);
+    }
+    model->ui.power_mode = power.mode;
+}
+
+/**
+ * @brief Boucle de jeu avec la simulation sur un thread dédié (cf. sim_thread.h).
+ *
+ * Le thread principal ne fait que lire les entrées et dessiner le dernier
+ * état publié : un rendu lent ne ralentit plus la physique, il saute des états.
+ *
+ * @param render_hz Images affichées par seconde au plus.
+ * @param force_quit Reçoit true si la partie s'est terminée par une sortie immédiate.
+ * @return false si le thread n'a pas pu être lancé (la boucle classique prend le relais).
+ */
+static bool run_threaded(const ViewInterface *view, GameModel *model, Autosave *autosave, ReplayRecorder *recorder,
+                         FlightRecorder *flight, Suspend *suspend, int render_hz, bool *force_quit)
+{
+    static SimThread sim;
+    if (!sim_thread_start(&sim, model, autosave, recorder, flight, suspend, kiosk_option, time_scale_option))
+        return false;
+
+    FramePacer pacer;
+    utils_pacer_init(&pacer, render_hz, view->has_vsync && view->has_vsync());
+    utils_pacer_set_rate(&pacer, power_render_hz(power.mode, render_hz));
+    bool force_exit = false;
+    uint64_t last_start = 0;
+    int calm = 0;
+    bool idle = false;
+    while (!sim_thread_finished(&sim, &force_exit) && !startup_bench_done())
+    {
+        uint64_t start = profiler_begin();
+        if (last_start > 0 && !idle)
+            profiler_record(PROF_FRAME, start - last_start);
+        last_start = start;
+        GameModel *front = sim_thread_acquire(&sim);
+        if (profiler_hitch_detected())
+            hitch_context(front);
+
+        // La Vue écrit dans input_buffer : toute modification part avec la commande
+        char typed[MAX_FILENAME_LEN];
+        sim_thread_prepare_input(&sim, front);
+        memcpy(typed, front->ui.input_buffer, sizeof(typed));
+        CommandQueue input;
+        command_queue_clear(&input);
+        view->get_input(front, &input);
+        bool had_input = input.count > 0;
+        if (!had_input)
+            command_queue_push(&input, CMD_NONE, utils_get_time());
+        const char *text = memcmp(typed, front->ui.input_buffer, sizeof(typed)) != 0 ? front->ui.input_buffer : NULL;
+        GameCommand cmd;
+        while (command_queue_pop(&input, HUGE_VAL, &cmd))
+        {
+            sim_thread_push(&sim, cmd, text);
+            text = NULL; // La saisie précède toujours la commande qui la valide
+        }
+        uint64_t t = profiler_end(PROF_INPUT, start);
+
+        power_frame(front, &pacer, render_hz);
+        view->render(front);
+        mirror_publish(&mirror, front);
+        overlay_publish(front);
+        t = profiler_end(PROF_RENDER, t);
+        profiler_record(PROF_WORK, t - start);
+        fleet_metrics(front);
+        leaderboard_watch(front);
+        idle = frame_wait(view, front, &pacer, &calm, had_input);
+        profiler_end(PROF_SLEEP, t);
+        profiler_frame_end();
+    }
+    sim_thread_stop(&sim);
+    utils_pacer_report(&pacer, "Affichage");
+    logger_write(LOG_INFO, "Simulation : %llu pas, %llu états publiés, %llu non affichés, %llu en retard\n",
+                 (unsigned long long)sim.ticks, (unsigned long long)sim.published,
+                 (unsigned long long)sim.skipped, (unsigned long long)sim.late);
+
+    *force_quit = force_exit;
+    return true;
+}
 
 /**
  * @brief Fonction principale.
  *
  * @param argc Nombre d'arguments.
- * @param argv Tableau des arguments (argv[1] = "sdl" pour le mode graphique).
+ * @param argv Tableau des arguments (argv[1] = "sdl" ou "sdlgpu" pour le mode graphique, "ansi" pour le terminal sans ncurses, "headless" pour la simulation seule,
+ *             "replay" pour rejouer un enregistrement, "snapshot" pour une image hors écran, "server", "client" et "coop" pour le jeu en réseau, "hub" pour des milliers de parties,
+ *             "relay" et "watch" pour sa diffusion aux spectateurs ; argv[2] = "record" et argv[3] = fichier pour enregistrer).
+ *             `--max-hz=N`, à n'importe quelle place, plafonne le rafraîchissement du terminal (ncurses, ansi) ;
+ *             `--bullets=N` fixe la capacité du pool de balles (MAX_BULLETS par défaut) ;
+ *             `--player-bullets=N` la part réservée aux tirs du joueur (un tiers par défaut) ;
+ *             `--bot=N` confie les entrées au bot (niveau 0 à 3, cf. bot.h), en jeu, headless, pool, tune et hub ;
+ *             `--match=N` choisit la partie d'un serveur multi-parties (client, cf. hub.h) ;
+ *             `--fixed` passe la physique en virgule fixe (model_set_fixed_point) ;
+ *             `--erosion` passe les boucliers en bitmap, érodés cellule par cellule (model_set_shield_bitmap) ;
+ *             `--swept` teste les balles sur tout leur trajet du tick (model_set_swept_bullets) ;
+ *             `--endless` joue une vague sans fin, recyclée rangée par rangée (model_set_endless) ;
+ *             `--local-coop` joue à deux vaisseaux sur la même machine (model_set_local_coop) ;
+ *             `--mirror=ncurses|ansi|web` suit la partie d'une Vue SDL dans le terminal ou un navigateur (cf. mirror.h) ;
+ *             `--kiosk` enchaîne les joueurs sans fermer la Vue (model_restart) ;
+ *             `--time-scale=X` joue X fois plus vite (0.05 à 16 ; ralenti sous 1), sans changer dt.
  * @return 0 si succès, 1 si erreur critique d'initialisation.
  */
 int main(int argc, char *argv[])
 {
+    boot_time = utils_get_time();
+    startup_begin();
+
+    // Options nommées (retirées avant la lecture des arguments positionnels)
+    const char *mirror_option = NULL;
+    int kept = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--max-hz=", 9) == 0)
+            ncurses_set_max_refresh(atoi(argv[i] + 9));
+        else if (strncmp(argv[i], "--bullets=", 10) == 0)
+        {
+            if (!model_set_bullet_capacity(atoi(argv[i] + 10)))
+            {
+                fprintf(stderr, "[ERREUR] --bullets : capacité de 2 à %d attendue\n", MODEL_MAX_BULLET_CAPACITY);
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--player-bullets=", 17) == 0)
+        {
+            if (!model_set_player_bullets(atoi(argv[i] + 17)))
+            {
+                fprintf(stderr, "[ERREUR] --player-bullets : de 0 (part par défaut) à %d slots attendus\n",
+                        MODEL_MAX_BULLET_CAPACITY - 1);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--fixed") == 0)
+            model_set_fixed_point(true);
+        else if (strcmp(argv[i], "--erosion") == 0)
+            model_set_shield_bitmap(true);
+        else if (strcmp(argv[i], "--swept") == 0)
+            model_set_swept_bullets(true);
+        else if (strcmp(argv[i], "--endless") == 0)
+            model_set_endless(true);
+        else if (strcmp(argv[i], "--local-coop") == 0)
+            model_set_local_coop(true);
+        else if (strcmp(argv[i], "--kiosk") == 0)
+            kiosk_option = true;
+        else if (strncmp(argv[i], "--mirror=", 9) == 0)
+            mirror_option = argv[i] + 9;
+        else if (strncmp(argv[i], "--match=", 8) == 0)
+            match_option = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--time-scale=", 13) == 0)
+            time_scale_option = time_scale_parse(argv[i] + 13);
+        else if (strncmp(argv[i], "--bot=", 6) == 0)
+        {
+            static BotConfig bot_cfg;
+            bot_preset(&bot_cfg, atoi(argv[i] + 6));
+            bot_option = &bot_cfg;
+        }
+        else
+            argv[kept++] = argv[i];
+    }
+    argc = kept;
+    argv[argc] = NULL;
+
+    // Vagues scriptées (SPACE_INVADERS_WAVES), compilées avant toute partie
+    const char *waves_env = getenv("SPACE_INVADERS_WAVES");
+    if (waves_env && waves_env[0])
+    {
+        char err[WAVE_ERROR_LEN];
+        if (!wave_load(waves_env, err, sizeof(err)))
+        {
+            fprintf(stderr, "[ERREUR] Vagues %s : %s\n", waves_env, err);
+            return 1;
+        }
+    }
+
+    // Paramètres d'équilibrage réglables à chaud (SPACE_INVADERS_PARAMS, cf. params.h)
+    const char *params_env = getenv("SPACE_INVADERS_PARAMS");
+    if (params_env && params_env[0] && !(argc > 1 && strcmp(argv[1], "params") == 0))
+    {
+        if (!params_live_open(params_env))
+        {
+            fprintf(stderr, "[ERREUR] Paramètres %s : bloc illisible\n", params_env);
+            return 1;
+        }
+        printf("[PARAMS] Réglage en direct depuis %s\n", params_env);
+    }
+
+    // Langue de l'interface (SPACE_INVADERS_LANG), chargée avant toute Vue
+    const char *lang_env = getenv("SPACE_INVADERS_LANG");
+    if (lang_env && lang_env[0])
+    {
+        char err[LANG_ERROR_LEN];
+        if (!lang_load(lang_env, err, sizeof(err)))
+        {
+            fprintf(stderr, "[ERREUR] Langue %s : %s\n", lang_env, err);
+            return 1;
+        }
+    }
+
+    // Mode simulation pure : aucune Vue n'est initialisée
+    if (argc > 1 && strcmp(argv[1], "headless") == 0)
+        return run_headless(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "difftest") == 0)
+        return run_difftest(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "pool") == 0)
+        return run_pool(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "tune") == 0)
+        return run_tune(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "replay") == 0)
+        return run_replay(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "bench-render") == 0)
+        return run_render_bench(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "render-replay") == 0)
+        return run_render_replay(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "snapshot") == 0)
+        return run_snapshot(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "pack") == 0)
+        return run_pack(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "telemetry") == 0)
+        return run_telemetry(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "leaderboard") == 0)
+        return run_leaderboard(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "params") == 0)
+        return run_params(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "overlay") == 0)
+        return run_overlay(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "server") == 0)
+        return run_server(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "client") == 0)
+        return run_client(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "hub") == 0)
+        return run_hub(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "relay") == 0)
+        return run_relay(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "watch") == 0)
+        return run_watch(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "coop") == 0)
+        return run_coop(argc, argv);
+
     // ========================================================================
     // 1. SÉLECTION DE L'INTERFACE (PATTERN STRATEGY)
     // ========================================================================
@@ -35,10 +1381,15 @@ int main(int argc, char *argv[])
 
     const ViewInterface *view = &view_ncurses; // Par défaut : Terminal
 
-    if (argc > 1 && strcmp(argv[1], "sdl") == 0)
+    if (argc > 1 && graphic_view(argv[1]))
     {
         printf("Démarrage en mode SDL (Graphique)...\n");
-        view = &view_sdl; // On change la stratégie pour SDL
+        view = graphic_view(argv[1]); // On change la stratégie pour SDL (ou SDL_GPU)
+    }
+    else if (argc > 1 && strcmp(argv[1], "ansi") == 0)
+    {
+        printf("Démarrage en mode ANSI (Texte, sans ncurses)...\n");
+        view = &view_ansi;
     }
     else
     {
@@ -50,21 +1401,176 @@ int main(int argc, char *argv[])
     // 2. INITIALISATIONS
     // ========================================================================
 
+    // Journal : les messages de la partie passent par un thread d'écriture, jamais bloquant
+    logger_start();
+
+    // Mémoire de la boucle de jeu : modèle, copies publiées, tampons, réservés et préremplis d'un coup
+    // à la capacité choisie (SPACE_INVADERS_MLOCK=1, SPACE_INVADERS_HUGEPAGES=1, SPACE_INVADERS_WORKSET=0)
+    double model_start = utils_get_time();
+    workset_init(WORKSET_MODEL_COPIES * model_block_bytes() + WORKSET_EXTRA_BYTES);
+
     // Création du Modèle (Données du jeu)
     GameModel *model = model_init();
+    startup_add(STARTUP_MODEL, utils_get_time() - model_start);
     if (!model)
     {
-        fprintf(stderr, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        logger_write(LOG_ERROR, "Erreur Critique: Impossible d'allouer le modèle.\n");
+        logger_stop();
         return 1;
     }
 
+    // En jeu interactif, chaque lancement tire une graine différente
+    model_rng_seed(model, (uint64_t)time(NULL));
+
+    // Avec --bot=N, le bot joue à la place du clavier (la Vue garde pause, menus et fermeture)
+    static ViewInterface bot_view;
+    if (bot_option)
+    {
+        bot_attach_view(&bot_view, view, bot_option, model->sim.rng.seed);
+        view = &bot_view;
+    }
+
+    // Meilleurs scores : lus une fois, réécrits en fond après chaque record
+    highscore_load(&model->ui.highscores, "sauvegardes");
+
+    // Journal d'autosave (désactivable par SPACE_INVADERS_AUTOSAVE=0)
+    const char *autosave_env = getenv("SPACE_INVADERS_AUTOSAVE");
+    Autosave autosave;
+    autosave_init(&autosave, !(autosave_env && strcmp(autosave_env, "0") == 0));
+
+    // Partie mise en veille par SIGTERM/SIGHUP au lancement précédent : reprise en pause,
+    // avant l'ouverture des enregistreurs (leur en-tête porte l'état de départ)
+    suspend_resume(model, "sauvegardes");
+
+    // Fréquences de simulation et d'affichage (SPACE_INVADERS_SIM_HZ, SPACE_INVADERS_RENDER_HZ),
+    // fixées avant l'ouverture des enregistreurs : leur en-tête porte la fréquence de simulation.
+    // La virgule fixe garde son tick (MODEL_FIXED_TICK), donc TARGET_FPS.
+    int sim_hz = model->sim.fixed_point ? TARGET_FPS : env_rate("SPACE_INVADERS_SIM_HZ", TARGET_FPS);
+    int render_hz = env_rate("SPACE_INVADERS_RENDER_HZ", TARGET_FPS);
+    if (render_hz < sim_hz)
+        render_hz = sim_hz;
+    model_set_tick_rate(model, sim_hz);
+    if (sim_hz < TARGET_FPS)
+        model->sim.swept_bullets = true; // Pas plus long : une balle peut sauter un alien en un tick
+    // Ralenti ou accéléré (SPACE_INVADERS_TIME_SCALE, `--time-scale=X` prioritaire) : ticks par seconde réelle
+    const char *scale_env = getenv("SPACE_INVADERS_TIME_SCALE");
+    if (time_scale_option == TIME_SCALE_NORMAL && scale_env && scale_env[0])
+        time_scale_option = time_scale_parse(scale_env);
+    if (time_scale_option != TIME_SCALE_NORMAL)
+        logger_write(LOG_INFO, "[TEMPS] Echelle x%.2f : %.0f ticks par seconde reelle (au plus %d par image)\n",
+                     time_scale_option / (double)TIME_SCALE_NORMAL,
+                     sim_hz * (double)time_scale_option / TIME_SCALE_NORMAL, sim_hz / 4);
+
+    // Enregistrement des entrées (rejouable avec `./space_invaders replay <fichier>`),
+    // compressé sauf avec SPACE_INVADERS_COMPRESSION=0
+    const char *compress_env = getenv("SPACE_INVADERS_COMPRESSION");
+    static ReplayRecorder recorder;
+    if (argc > 3 && strcmp(argv[2], "record") == 0)
+    {
+        if (replay_record_open(&recorder, argv[3], model, !(compress_env && strcmp(compress_env, "0") == 0)))
+            logger_write(LOG_INFO, "Enregistrement de la session dans %s\n", argv[3]);
+        else
+            logger_write(LOG_ERROR, "[ERREUR] Impossible de creer %s\n", argv[3]);
+    }
+
+    // Enregistreur de vol : dernières secondes en mémoire, vidées sur image lente,
+    // crash ou F9 (désactivable par SPACE_INVADERS_FLIGHT=0)
+    static FlightRecorder flight;
+    flight_init(&flight, model);
+
+    // Télémétrie de jeu : journal des événements de la session dans SPACE_INVADERS_TELEMETRY (dossier)
+    static TelemetryLog telemetry;
+    const char *telemetry_env = getenv("SPACE_INVADERS_TELEMETRY");
+    if (telemetry_env && telemetry_env[0])
+    {
+        char stamp[32] = "";
+        time_t now = time(NULL);
+        strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+        char path[160];
+        snprintf(path, sizeof(path), "%s/session-%s.tlm", telemetry_env, stamp);
+        mkdir(telemetry_env, 0777);
+        if (telemetry_open(&telemetry, path, model->sim.rng.seed))
+            model_set_telemetry_sink(model, &telemetry.ring);
+        else
+            logger_write(LOG_ERROR, "[ERREUR] Impossible de creer %s\n", path);
+    }
+
+    // Classement en ligne : parties finies dans sauvegardes/leaderboard.q, envoyées à SPACE_INVADERS_LEADERBOARD
+    const char *leaderboard_env = getenv("SPACE_INVADERS_LEADERBOARD");
+    if (leaderboard_env && leaderboard_env[0] && !leaderboard_open("sauvegardes", leaderboard_env))
+        logger_write(LOG_ERROR, "[ERREUR] File du classement illisible (sauvegardes/%s)\n", LEADERBOARD_FILE);
+
     // Initialisation de la Vue choisie (Fenêtre, Textures...)
     if (!view->init())
     {
-        fprintf(stderr, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        logger_write(LOG_ERROR, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        logger_stop();
         model_free(model);
         return 1;
     }
+    if (view->audio_events)
+        model_set_audio_sink(model, view->audio_events());
+
+    // Thread principal : cœurs et priorité du rendu (SPACE_INVADERS_CPU_RENDER, SPACE_INVADERS_RT_RENDER)
+    affinity_apply(THREAD_ROLE_RENDER);
+
+    // Mise en veille sur SIGTERM/SIGHUP (désactivable par SPACE_INVADERS_SUSPEND=0) :
+    // après la Vue, dont elle remplace les gestionnaires
+    static Suspend suspend;
+    suspend_init(&suspend, model, "sauvegardes");
+
+    // Vue miroir (--mirror=ncurses|ansi|web) : le terminal (ou un navigateur) suit la partie de
+    // la fenêtre SDL, sur son propre thread (les Vues texte partagent leur grille : une seule à la fois)
+    if (mirror_option)
+    {
+        const ViewInterface *observer = text_view(mirror_option);
+        if (!observer || !(argc > 1 && graphic_view(argv[1])))
+            logger_write(LOG_ERROR, "[ERREUR] --mirror : ncurses, ansi ou web attendu, derriere une Vue sdl ou sdlgpu\n");
+        else if (!mirror_start(&mirror, observer, model, env_rate("SPACE_INVADERS_MIRROR_HZ", MIRROR_DEFAULT_HZ)))
+            logger_write(LOG_ERROR, "[ERREUR] Impossible d'ouvrir la Vue miroir %s\n", mirror_option);
+    }
+
+    // Image partagée pour les habillages et inspecteurs externes (SPACE_INVADERS_OVERLAY, cf. overlay.h)
+    const char *overlay_env = getenv("SPACE_INVADERS_OVERLAY");
+    if (overlay_env && overlay_env[0])
+    {
+        if (overlay_open(overlay_env))
+            logger_write(LOG_INFO, "[OVERLAY] Image publiée dans %s\n", overlay_env);
+        else
+            logger_write(LOG_ERROR, "[ERREUR] Impossible de projeter %s\n", overlay_env);
+    }
+
+    // Profileur de frames (désactivable par SPACE_INVADERS_PROFILE=0) et trace Chrome
+    const char *profile_env = getenv("SPACE_INVADERS_PROFILE");
+    const char *trace_env = getenv("SPACE_INVADERS_TRACE");
+    if (trace_env && trace_env[0])
+        profiler_trace_open(trace_env);
+    else if (!(profile_env && strcmp(profile_env, "0") == 0))
+        profiler_enable(true);
+    // Guet des images lentes : frame au-delà de SPACE_INVADERS_HITCH_MS, tranche de trace de 2 s autour
+    const char *hitch_env = getenv("SPACE_INVADERS_HITCH_MS");
+    if (hitch_env && atof(hitch_env) > 0)
+    {
+        const char *prefix = getenv("SPACE_INVADERS_HITCH_TRACE");
+        profiler_hitch_open(atof(hitch_env) / 1000.0, prefix && prefix[0] ? prefix : "hitch");
+    }
+    // Métriques de flotte : StatsD (SPACE_INVADERS_STATSD=hôte:port) et/ou point Prometheus
+    // (SPACE_INVADERS_METRICS_PORT), images lentes au seuil du guet s'il est fixé
+    const char *statsd_env = getenv("SPACE_INVADERS_STATSD");
+    const char *metrics_port = getenv("SPACE_INVADERS_METRICS_PORT");
+    if (metrics_start(statsd_env, metrics_port ? atoi(metrics_port) : 0))
+    {
+        if (hitch_env && atof(hitch_env) > 0)
+            metrics_set_hitch_budget(atof(hitch_env) / 1000.0);
+        metrics_count(METRIC_SESSIONS, 1);
+    }
+    const char *idle_env = getenv("SPACE_INVADERS_IDLE");
+    idle_option = !(idle_env && strcmp(idle_env, "0") == 0);
+    // Mode d'énergie : secteur, batterie ou chauffe (SPACE_INVADERS_POWER=0 pour le couper)
+    power_init(&power);
+    if (power_saving(power.mode))
+        logger_write(LOG_INFO, "[ENERGIE] Mode %s : %d images/s au plus\n", power_name(power.mode),
+                     power_render_hz(power.mode, render_hz));
 
     // ========================================================================
     // 3. BOUCLE DE JEU (GAME LOOP) - FIXED TIMESTEP
@@ -72,90 +1578,184 @@ int main(int argc, char *argv[])
     // Cette boucle utilise un accumulateur de temps pour garantir que la physique
     // tourne toujours à la même vitesse, quel que soit le framerate de l'écran.
 
-    bool running = true;
-    double last_time = utils_get_time();
-    double accumulator = 0.0;
-    const double dt = 1.0 / TARGET_FPS; // Pas de temps fixe (0.016s pour 60Hz)
+    // Simulation sur un thread dédié (SPACE_INVADERS_SIM_THREAD=1)
+    // Dans tous les cas, la Vue et le Modèle sont libérés ici, jamais par exit()
+    const char *thread_env = getenv("SPACE_INVADERS_SIM_THREAD");
+    bool force_quit = false;
+    bool running = !(thread_env && strcmp(thread_env, "1") == 0 &&
+                     run_threaded(view, model, &autosave, &recorder, &flight, &suspend, render_hz, &force_quit));
+    uint64_t last_time = utils_now_ns();
+    uint64_t accumulator = 0; // Nanosecondes entières : aucune dérive, quelle que soit la durée de la session
+    uint64_t scale_rest = 0;  // Reste de la mise à l'échelle (millièmes de ns), reporté à la frame suivante
+
+    const double dt = 1.0 / sim_hz; // Pas de temps fixe (0.016s pour 60Hz)
+    const uint64_t dt_ns = UTILS_NS_PER_S / (uint64_t)sim_hz;
+    const uint64_t max_frame = UTILS_NS_PER_S / 4;
+
+    // Cadence d'affichage : échéances absolues, ou la synchronisation verticale de la Vue
+    FramePacer pacer;
+    utils_pacer_init(&pacer, render_hz, view->has_vsync && view->has_vsync());
+    utils_pacer_set_rate(&pacer, power_render_hz(power.mode, render_hz));
+
+    // État avant le dernier tick : la Vue interpole entre lui et l'état courant
+    // (copie allouée une fois, à la capacité du modèle)
+    GameModel *previous = view->set_interpolation ? model_clone(model) : NULL;
+    bool interpolate = previous != NULL;
+
+    // Commandes lues par la Vue, en attente de leur tick
+    CommandQueue input;
+    command_queue_clear(&input);
+    int calm = 0;      // Images sans entrée (passage au repos, cf. frame_wait)
+    bool idle = false; // L'image précédente a fini au repos
 
     while (running)
     {
         // --- A. Gestion du Temps (Time Management) ---
-        double current_time = utils_get_time();
-        double frame_time = current_time - last_time; // Temps écoulé pour cette frame
-        last_time = current_time;
+        uint64_t current_ns = utils_now_ns();
+        uint64_t frame_ns = current_ns - last_time; // Temps écoulé pour cette frame
+        last_time = current_ns;
+        double current_time = (double)current_ns / 1e9; // Même horloge que les dates des commandes
+        uint64_t probe = profiler_begin();
+        if (!idle)
+            profiler_record(PROF_FRAME, frame_ns); // Une attente au repos n'est pas une image lente
+        if (profiler_hitch_detected())
+            hitch_context(model);
+        double measured = idle ? 0.0 : (double)frame_ns / 1e9;
 
         // "Spiral of Death" protection : Si l'ordi lag trop (>0.25s),
         // on plafonne le temps pour éviter de calculer trop de mises à jour d'un coup.
-        if (frame_time > 0.25)
-            frame_time = 0.25;
+        if (frame_ns > max_frame)
+            frame_ns = max_frame;
 
-        accumulator += frame_time;
-
-        // --- B. Gestion des Entrées (Input) ---
-        // On demande à la Vue de traduire les touches en Commandes de Jeu
-        GameCommand cmd = view->get_input(model);
-
-        if (cmd == CMD_EXIT)
+        // Échelle de temps : plus ou moins de ticks par seconde réelle, dt inchangé (déterminisme).
+        // Le temps simulé d'une frame garde le même plafond : au plus max_frame / dt ticks par image.
+        if (time_scale_option != TIME_SCALE_NORMAL)
         {
-            // Logique spéciale pour quitter proprement
-            // 1. Si on est déjà dans le menu de confirmation -> Force Quit
-            if (model->state == STATE_CONFIRM_QUIT)
+            uint64_t scaled = frame_ns * time_scale_option + scale_rest;
+            scale_rest = scaled % TIME_SCALE_NORMAL;
+            frame_ns = scaled / TIME_SCALE_NORMAL;
+            if (frame_ns > max_frame)
             {
-                // running = false; // Alternative propre
-                exit(0); // Sortie brutale mais efficace ici
+                frame_ns = max_frame;
+                scale_rest = 0;
             }
-
-            // 2. Sinon, on passe en état de demande de confirmation
-            model->previous_state = model->state;
-            model->state = STATE_CONFIRM_QUIT;
-            model->menu_selection = 1; // Curseur sur "NON" par sécurité
-        }
-        else
-        {
-            // Traitement standard de la commande par le Modèle
-            model_handle_input(model, cmd);
         }
 
+        accumulator += frame_ns;
+
+        // --- B. Gestion des Entrées (Input) ---
+        // La Vue dépose toutes les commandes lues depuis la frame précédente, datées
+        view->get_input(model, &input);
+        bool had_input = input.count > 0;
+        if (!had_input)
+            command_queue_push(&input, CMD_NONE, current_time);
+        uint64_t t = profiler_end(PROF_INPUT, probe);
+
         // --- C. Mise à jour Physique (Physics Update) ---
         // On consomme l'accumulateur par tranches fixes de 'dt'.
         // Cela garantit une physique déterministe.
-        while (accumulator >= dt)
+        // Chaque tick reçoit les commandes survenues avant sa fin ; le dernier prend
+        // toutes les autres, pour qu'aucune n'attende la frame suivante.
+        while (accumulator >= dt_ns)
         {
+            double tick_end = (double)(current_ns - (accumulator - dt_ns)) / 1e9;
+            if (!dispatch_commands(model, &input, accumulator - dt_ns >= dt_ns ? tick_end : HUGE_VAL, &recorder, &flight))
+            {
+                force_quit = true;
+                break;
+            }
+            if (interpolate)
+                model_copy_sim(previous, model); // La Vue n'interpole que l'état simulé
+            if (params_live_poll(&model->sim.params))
+                logger_write(LOG_INFO, "[PARAMS] Nouveaux paramètres appliqués (un enregistrement en cours ne se rejouera plus)\n");
+            t = profiler_begin();
+            flight_record_tick_begin(&flight);
             model_update(model, dt);
-            accumulator -= dt;
+            flight_record_tick(&flight);
+            profiler_end(PROF_UPDATE, t);
+            profiler_count(PROF_COUNT_TICKS, 1);
+            autosave_update(&autosave, model, dt);
+            suspend_update(&suspend, model);
+            replay_record_tick(&recorder, model);
+            accumulator -= dt_ns;
         }
+        // Frame sans tick (menus à haute cadence)
+        if (force_quit || !dispatch_commands(model, &input, HUGE_VAL, &recorder, &flight))
+        {
+            force_quit = true;
+            break; // Sortie immédiate : ni tick ni rendu de plus
+        }
+        highscore_flush(&model->ui.highscores, "sauvegardes");
 
         // --- D. Rendu (Render) ---
-        // On dessine l'état actuel du modèle
+        // On dessine l'état actuel du modèle, à la fraction de pas déjà écoulée
+        if (interpolate)
+            view->set_interpolation(previous, (float)accumulator / (float)dt_ns);
+        power_frame(model, &pacer, render_hz);
+        t = profiler_begin();
         view->render(model);
+        mirror_publish(&mirror, model);
+        overlay_publish(model);
+        t = profiler_end(PROF_RENDER, t);
+        if (t > 0)
+            profiler_record(PROF_WORK, t - probe);
+        fleet_metrics(model);
+        leaderboard_watch(model);
+        flight_record_timing(&flight, model, measured, (double)(utils_now_ns() - current_ns) / 1e9);
 
         // --- E. Régulation CPU (Sleep) ---
-        // Si on a fini le travail plus tôt que prévu (ex: en 5ms au lieu de 16ms),
-        // on dort pour ne pas utiliser 100% du CPU inutilement.
-        double frame_end = utils_get_time();
-        double work_time = frame_end - current_time;
-        if (work_time < dt)
-        {
-            utils_sleep_ms((int)((dt - work_time) * 1000));
-        }
+        // On dort jusqu'au début de l'image suivante (échéance absolue, sans arrondi
+        // à la milliseconde), pour ne pas utiliser 100% du CPU inutilement.
+        // Au repos des menus, on attend plutôt la prochaine entrée (IDLE_WAIT_S au plus).
+        idle = frame_wait(view, model, &pacer, &calm, had_input);
+        profiler_end(PROF_SLEEP, t);
+        profiler_frame_end();
 
-        // Vérification de demande de sortie interne (via menu)
-        if (model->pending_quit)
+        // Vérification de demande de sortie interne (via menu), ou mise en veille déjà écrite
+        // (ou banc de démarrage arrivé à la première image jouable)
+        if (suspend_requested() || startup_bench_done() || (model->ui.pending_quit && !kiosk_option))
             running = false;
-    }
-
-    // Petit délai en cas de Game Over pour laisser le joueur réaliser
-    if (model->state == STATE_GAME_OVER)
-    {
-        view->render(model); // Un dernier rendu
-        utils_sleep_ms(3000);
+        else if (model->ui.pending_quit)
+        {
+            // Borne : le joueur suivant part de l'accueil dès l'image suivante, ressources de la Vue en place
+            model_restart(model);
+            if (interpolate)
+                model_copy_sim(previous, model);
+            metrics_count(METRIC_SESSIONS, 1);
+        }
     }
 
     // ========================================================================
     // 4. NETTOYAGE & SORTIE
     // ========================================================================
+    mirror_stop(&mirror); // Restauration du terminal de l'observateur, avant les bilans
+    overlay_close();
     view->close();     // Fermeture fenêtre / Restauration terminal
+    logger_stop();     // Messages restants, avant les bilans
+    highscore_flush(&model->ui.highscores, "sauvegardes");
+    utils_pacer_report(&pacer, "Affichage");
+    profile_report();
+    metrics_stop();
+    model_set_telemetry_sink(model, NULL);
+    telemetry_close(&telemetry);
+    if (leaderboard_env && leaderboard_env[0])
+    {
+        LeaderboardStats board;
+        leaderboard_close(&board);
+        printf("Classement : %llu partie(s) ajoutée(s), %llu lot(s) envoyé(s), %llu échec(s), %llu en attente "
+               "(ajout max %.0f us)\n",
+               (unsigned long long)board.submitted, (unsigned long long)board.uploads,
+               (unsigned long long)board.failures, (unsigned long long)(board.records - board.acked),
+               board.append_max_us);
+    }
+    replay_record_close(&recorder);
+    flight_close(&flight);
+    suspend_close(&suspend);
+    model_free(previous);
     model_free(model); // Libération mémoire
+    workset_report();
+    workset_close();
+    startup_report();
 
     printf("Merci d'avoir joué !\n");
     return 0;
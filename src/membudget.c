@@ -0,0 +1,92 @@
+/**
+ * @file membudget.c
+ * @brief Implémentation du compte des ressources (plafonds, ajustement, bilan).
+ */
+
+#include "membudget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Suffixes des variables d'environnement, par catégorie. */
+static const char *const category_keys[MEM_CATEGORY_COUNT] = {"SPRITES", "BACKGROUNDS", "TEXT", "LAYERS", "AUDIO"};
+
+/** @brief Noms des catégories dans le journal et le panneau. */
+static const char *const category_names[MEM_CATEGORY_COUNT] = {"sprites", "fonds", "texte", "calques", "audio"};
+
+/** @brief Octets d'un Mo. */
+#define MEM_MIB (1024.0 * 1024.0)
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Plafond absent, nul ou illisible : aucun.
+ */
+void membudget_init(MemBudget *mem)
+{
+    memset(mem, 0, sizeof(*mem));
+    for (int c = 0; c < MEM_CATEGORY_COUNT; c++)
+    {
+        char name[48];
+        snprintf(name, sizeof(name), "SPACE_INVADERS_BUDGET_%s", category_keys[c]);
+        const char *env = getenv(name);
+        double mib = env ? atof(env) : 0.0;
+        mem->budget[c] = mib > 0.0 ? (uint64_t)(mib * MEM_MIB) : 0;
+    }
+}
+
+const char *membudget_name(MemCategory cat)
+{
+    return category_names[cat];
+}
+
+/**
+ * @brief Essais de plus en plus petits, un quart de la taille à chaque pas.
+ */
+int membudget_fit(const MemBudget *mem, MemCategory cat, uint64_t used, uint64_t bytes, int max_halvings)
+{
+    uint64_t budget = mem->budget[cat];
+    if (budget == 0)
+        return 0;
+    for (int k = 0; k <= max_halvings; k++)
+        if (used + (bytes >> (2 * k)) <= budget)
+            return k;
+    return -1;
+}
+
+uint64_t membudget_total(const MemBudget *mem)
+{
+    uint64_t total = 0;
+    for (int c = 0; c < MEM_CATEGORY_COUNT; c++)
+        total += mem->bytes[c];
+    return total;
+}
+
+/**
+ * @brief Mo à une décimale ; plafond après une barre, réductions entre parenthèses.
+ */
+void membudget_format(const MemBudget *mem, char *out, size_t cap)
+{
+    size_t n = 0;
+    out[0] = '\0';
+    for (int c = 0; c < MEM_CATEGORY_COUNT && n < cap; c++)
+    {
+        int w = snprintf(out + n, cap - n, "%s%s %.1f", c ? ", " : "", category_names[c], mem->bytes[c] / MEM_MIB);
+        if (w > 0 && (size_t)w < cap - n && mem->budget[c])
+            w += snprintf(out + n + w, cap - n - w, "/%g", mem->budget[c] / MEM_MIB);
+        if (w > 0 && (size_t)w < cap - n && mem->reduced[c])
+            w += snprintf(out + n + w, cap - n - w, " (%u reduit%s)", mem->reduced[c], mem->reduced[c] > 1 ? "s" : "");
+        if (w < 0)
+            break;
+        n += (size_t)w;
+    }
+    if (n < cap)
+        snprintf(out + n, cap - n, " Mo");
+}
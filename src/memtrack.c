@@ -0,0 +1,108 @@
+/**
+ * @file memtrack.c
+ * @brief Implémentation du compteur d'allocations de SDL.
+ */
+
+#include "memtrack.h"
+
+#include <SDL3/SDL.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#define BLOCK_SIZE(p) malloc_usable_size(p)
+#else
+#define BLOCK_SIZE(p) ((size_t)0)
+#endif
+
+// ============================================================================
+//                          1. ÉTAT & FONCTIONS DE COMPTAGE
+// ============================================================================
+
+static bool installed = false;
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_free_func real_free;
+static MemtrackStats counters; ///< Accès __atomic uniquement.
+
+/**
+ * @brief Compte un bloc obtenu (`old` octets rendus, `now` octets pris).
+ */
+static void account(size_t old, size_t now, bool alloc)
+{
+    if (alloc)
+        __atomic_fetch_add(&counters.allocs, 1, __ATOMIC_RELAXED);
+    int64_t live = __atomic_add_fetch(&counters.live_bytes, (int64_t)now - (int64_t)old, __ATOMIC_RELAXED);
+    int64_t peak = __atomic_load_n(&counters.peak_bytes, __ATOMIC_RELAXED);
+    while (live > peak && !__atomic_compare_exchange_n(&counters.peak_bytes, &peak, live, true,
+                                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static void *SDLCALL track_malloc(size_t size)
+{
+    void *p = real_malloc(size);
+    if (p)
+        account(0, BLOCK_SIZE(p), true);
+    return p;
+}
+
+static void *SDLCALL track_calloc(size_t nmemb, size_t size)
+{
+    void *p = real_calloc(nmemb, size);
+    if (p)
+        account(0, BLOCK_SIZE(p), true);
+    return p;
+}
+
+static void *SDLCALL track_realloc(void *mem, size_t size)
+{
+    size_t old = mem ? BLOCK_SIZE(mem) : 0;
+    void *p = real_realloc(mem, size);
+    if (p)
+        account(old, BLOCK_SIZE(p), true);
+    return p;
+}
+
+static void SDLCALL track_free(void *mem)
+{
+    size_t old = BLOCK_SIZE(mem);
+    real_free(mem);
+    __atomic_fetch_add(&counters.frees, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&counters.live_bytes, (int64_t)old, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Installe les fonctions de comptage devant l'allocateur d'origine de SDL.
+ */
+bool memtrack_install(void)
+{
+    if (installed)
+        return true;
+    SDL_GetOriginalMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    installed = SDL_SetMemoryFunctions(track_malloc, track_calloc, track_realloc, track_free);
+    return installed;
+}
+
+/**
+ * @brief Indique si les fonctions de comptage sont en place.
+ */
+bool memtrack_installed(void)
+{
+    return installed;
+}
+
+/**
+ * @brief Lit les compteurs.
+ */
+void memtrack_stats(MemtrackStats *out)
+{
+    out->allocs = __atomic_load_n(&counters.allocs, __ATOMIC_RELAXED);
+    out->frees = __atomic_load_n(&counters.frees, __ATOMIC_RELAXED);
+    out->live_bytes = __atomic_load_n(&counters.live_bytes, __ATOMIC_RELAXED);
+    out->peak_bytes = __atomic_load_n(&counters.peak_bytes, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,461 @@
+/**
+ * @file metrics.c
+ * @brief Implémentation des métriques de flotte (StatsD, Prometheus texte).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour getaddrinfo, select et pthread).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "metrics.h"
+#include "logger.h"
+#include "utils.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 ///< Hors Linux : pas d'option pour taire SIGPIPE à l'envoi.
+#endif
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define METRICS_POLL_S 0.2   ///< Attente au plus du thread entre deux vérifications de l'arrêt.
+#define METRICS_PAYLOAD 1400 ///< Datagramme StatsD (sous la MTU usuelle).
+#define METRICS_PAGE 8192    ///< Réponse Prometheus.
+
+/** @brief Bornes des classes, en millisecondes (une observation va dans la première borne >= elle). */
+static const double bounds_ms[METRICS_BOUND_COUNT] = {1,  2,  4,  6,  8,  10,  12,  14,  16,  17,
+                                                      18, 20, 25, 33, 50, 75, 100, 250, 500, 1000};
+
+/**
+ * @brief Histogramme : une classe par borne, plus une au-delà ; somme en nanosecondes.
+ */
+typedef struct
+{
+    uint64_t buckets[METRICS_BOUND_COUNT + 1];
+    uint64_t sum_ns;
+    uint64_t count;
+} Histogram;
+
+static const char *const counter_names[METRIC_COUNTER_COUNT] = {"sessions", "games", "hitches", "saves",
+                                                                 "save_failures"};
+static const char *const counter_help[METRIC_COUNTER_COUNT] = {
+    "Lancements du jeu.", "Parties lancees.", "Images au-dela du seuil d'image lente.", "Sauvegardes ecrites.",
+    "Sauvegardes en echec."};
+static const char *const histogram_names[METRIC_HISTOGRAM_COUNT] = {"frame", "save"};
+static const char *const histogram_help[METRIC_HISTOGRAM_COUNT] = {"Intervalle entre deux images.",
+                                                                   "Ecriture d'une sauvegarde."};
+
+static bool on = false;
+static uint64_t counters[METRIC_COUNTER_COUNT];       ///< Totaux (atomiques).
+static Histogram histograms[METRIC_HISTOGRAM_COUNT]; ///< Totaux (atomiques).
+static uint64_t startup_ns = 0;                      ///< 0 : pas encore d'image.
+static uint64_t hitch_ns = (uint64_t)(METRICS_HITCH_S * 1e9);
+
+static pthread_t exporter;
+static int stop_requested = 0; ///< Atomique : lu par le thread à chaque réveil.
+static int statsd_fd = -1;     ///< Socket UDP connecté au collecteur.
+static int listen_fd = -1;     ///< Socket TCP du point /metrics.
+
+// Dernier état envoyé en StatsD : les envois ne portent que sur l'intervalle (thread d'export seul)
+static uint64_t sent_counters[METRIC_COUNTER_COUNT];
+static Histogram sent_histograms[METRIC_HISTOGRAM_COUNT];
+
+/**
+ * @brief Copie cohérente champ par champ (chaque champ est lu atomiquement).
+ */
+static void load_histogram(const Histogram *src, Histogram *dst)
+{
+    for (int i = 0; i <= METRICS_BOUND_COUNT; i++)
+        dst->buckets[i] = __atomic_load_n(&src->buckets[i], __ATOMIC_RELAXED);
+    dst->sum_ns = __atomic_load_n(&src->sum_ns, __ATOMIC_RELAXED);
+    dst->count = __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Quantile `q` d'un histogramme, interpolé dans sa classe (ms).
+ *
+ * La classe au-delà de la dernière borne n'a pas de borne haute : elle rend
+ * cette dernière borne.
+ */
+static double quantile_ms(const Histogram *h, double q)
+{
+    uint64_t total = 0;
+    for (int i = 0; i <= METRICS_BOUND_COUNT; i++)
+        total += h->buckets[i];
+    if (total == 0)
+        return 0.0;
+    double rank = q * (double)total;
+    uint64_t seen = 0;
+    for (int i = 0; i < METRICS_BOUND_COUNT; i++)
+    {
+        if (h->buckets[i] > 0 && (double)(seen + h->buckets[i]) >= rank)
+        {
+            double lower = i > 0 ? bounds_ms[i - 1] : 0.0;
+            double f = (rank - (double)seen) / (double)h->buckets[i];
+            return lower + f * (bounds_ms[i] - lower);
+        }
+        seen += h->buckets[i];
+    }
+    return bounds_ms[METRICS_BOUND_COUNT - 1];
+}
+
+/**
+ * @brief Ouvre un socket UDP connecté à "hôte:port".
+ *
+ * @return Le descripteur, ou -1 si la destination est invalide ou introuvable.
+ */
+static int statsd_connect(const char *target)
+{
+    char host[128];
+    const char *colon = strrchr(target, ':');
+    if (!colon || colon == target || (size_t)(colon - target) >= sizeof(host) || atoi(colon + 1) <= 0)
+        return -1;
+    memcpy(host, target, (size_t)(colon - target));
+    host[colon - target] = '\0';
+
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, colon + 1, &hints, &res) != 0 || !res)
+        return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+/**
+ * @brief Ouvre le socket TCP d'écoute sur toutes les interfaces.
+ */
+static int prometheus_listen(int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(fd, (const struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 4) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Un datagramme : compteurs et percentiles de l'intervalle écoulé depuis le précédent.
+ */
+static void statsd_flush(void)
+{
+    char payload[METRICS_PAYLOAD];
+    size_t len = 0;
+#define APPEND(...)                                                                                           \
+    do                                                                                                        \
+    {                                                                                                         \
+        int n = snprintf(payload + len, sizeof(payload) - len, __VA_ARGS__);                                  \
+        if (n > 0 && (size_t)n < sizeof(payload) - len)                                                       \
+            len += (size_t)n;                                                                                 \
+    } while (0)
+
+    for (int c = 0; c < METRIC_COUNTER_COUNT; c++)
+    {
+        uint64_t now = __atomic_load_n(&counters[c], __ATOMIC_RELAXED);
+        uint64_t delta = now - sent_counters[c];
+        sent_counters[c] = now;
+        if (delta > 0)
+            APPEND(METRICS_PREFIX ".%s:%llu|c\n", counter_names[c], (unsigned long long)delta);
+    }
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        Histogram now, interval;
+        load_histogram(&histograms[h], &now);
+        for (int i = 0; i <= METRICS_BOUND_COUNT; i++)
+            interval.buckets[i] = now.buckets[i] - sent_histograms[h].buckets[i];
+        interval.count = now.count - sent_histograms[h].count;
+        interval.sum_ns = now.sum_ns - sent_histograms[h].sum_ns;
+        sent_histograms[h] = now;
+        if (interval.count == 0)
+            continue;
+        const char *name = histogram_names[h];
+        APPEND(METRICS_PREFIX ".%s_ms.count:%llu|c\n", name, (unsigned long long)interval.count);
+        APPEND(METRICS_PREFIX ".%s_ms.mean:%.2f|g\n", name, (double)interval.sum_ns / 1e6 / (double)interval.count);
+        APPEND(METRICS_PREFIX ".%s_ms.p50:%.2f|g\n", name, quantile_ms(&interval, 0.50));
+        APPEND(METRICS_PREFIX ".%s_ms.p90:%.2f|g\n", name, quantile_ms(&interval, 0.90));
+        APPEND(METRICS_PREFIX ".%s_ms.p99:%.2f|g\n", name, quantile_ms(&interval, 0.99));
+    }
+    uint64_t boot = __atomic_load_n(&startup_ns, __ATOMIC_RELAXED);
+    if (boot > 0)
+        APPEND(METRICS_PREFIX ".startup_ms:%.1f|g\n", (double)boot / 1e6);
+#undef APPEND
+
+    if (len > 0)
+        send(statsd_fd, payload, len - 1, 0); // Sans le dernier saut de ligne
+}
+
+/**
+ * @brief Page texte Prometheus : totaux de la session.
+ *
+ * @return Octets écrits dans `page`.
+ */
+static size_t prometheus_page(char *page, size_t cap)
+{
+    size_t len = 0;
+#define APPEND(...)                                                                                           \
+    do                                                                                                        \
+    {                                                                                                         \
+        int n = snprintf(page + len, cap - len, __VA_ARGS__);                                                 \
+        if (n > 0 && (size_t)n < cap - len)                                                                   \
+            len += (size_t)n;                                                                                 \
+    } while (0)
+
+    for (int c = 0; c < METRIC_COUNTER_COUNT; c++)
+    {
+        const char *name = counter_names[c];
+        APPEND("# HELP " METRICS_PREFIX "_%s_total %s\n", name, counter_help[c]);
+        APPEND("# TYPE " METRICS_PREFIX "_%s_total counter\n", name);
+        APPEND(METRICS_PREFIX "_%s_total %llu\n", name,
+               (unsigned long long)__atomic_load_n(&counters[c], __ATOMIC_RELAXED));
+    }
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        const char *name = histogram_names[h];
+        Histogram now;
+        load_histogram(&histograms[h], &now);
+        APPEND("# HELP " METRICS_PREFIX "_%s_seconds %s\n", name, histogram_help[h]);
+        APPEND("# TYPE " METRICS_PREFIX "_%s_seconds histogram\n", name);
+        uint64_t cumulative = 0;
+        for (int i = 0; i < METRICS_BOUND_COUNT; i++)
+        {
+            cumulative += now.buckets[i];
+            APPEND(METRICS_PREFIX "_%s_seconds_bucket{le=\"%g\"} %llu\n", name, bounds_ms[i] / 1000.0,
+                   (unsigned long long)cumulative);
+        }
+        cumulative += now.buckets[METRICS_BOUND_COUNT];
+        APPEND(METRICS_PREFIX "_%s_seconds_bucket{le=\"+Inf\"} %llu\n", name, (unsigned long long)cumulative);
+        APPEND(METRICS_PREFIX "_%s_seconds_sum %.6f\n", name, (double)now.sum_ns / 1e9);
+        APPEND(METRICS_PREFIX "_%s_seconds_count %llu\n", name, (unsigned long long)cumulative);
+    }
+    uint64_t boot = __atomic_load_n(&startup_ns, __ATOMIC_RELAXED);
+    APPEND("# HELP " METRICS_PREFIX "_startup_seconds Lancement jusqu'a la premiere image.\n");
+    APPEND("# TYPE " METRICS_PREFIX "_startup_seconds gauge\n");
+    APPEND(METRICS_PREFIX "_startup_seconds %.6f\n", (double)boot / 1e9);
+#undef APPEND
+    return len;
+}
+
+/**
+ * @brief Répond à une connexion : la page pour `GET /metrics` (ou `/`), 404 sinon.
+ */
+static void serve_client(int fd)
+{
+    // Une requête lente ne bloque pas l'export : une seconde au plus pour la lire
+    struct timeval tv = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    char request[512];
+    ssize_t n = recv(fd, request, sizeof(request) - 1, 0);
+    if (n <= 0)
+        return;
+    request[n] = '\0';
+
+    static char page[METRICS_PAGE];
+    char header[160];
+    size_t body = 0;
+    bool found = strncmp(request, "GET /metrics", 12) == 0 || strncmp(request, "GET / ", 6) == 0;
+    if (found)
+        body = prometheus_page(page, sizeof(page));
+    int head = snprintf(header, sizeof(header),
+                        "HTTP/1.0 %s\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\n"
+                        "Connection: close\r\n\r\n",
+                        found ? "200 OK" : "404 Not Found", body);
+    send(fd, header, (size_t)head, MSG_NOSIGNAL);
+    for (size_t sent = 0; sent < body;)
+    {
+        ssize_t w = send(fd, page + sent, body - sent, MSG_NOSIGNAL);
+        if (w <= 0)
+            break;
+        sent += (size_t)w;
+    }
+}
+
+/**
+ * @brief Thread d'export : connexions Prometheus au fil de l'eau, StatsD toutes les METRICS_FLUSH_S secondes.
+ */
+static void *exporter_main(void *arg)
+{
+    (void)arg;
+    double next_flush = utils_get_time() + METRICS_FLUSH_S;
+    while (!__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE))
+    {
+        double now = utils_get_time();
+        if (statsd_fd >= 0 && now >= next_flush)
+        {
+            statsd_flush();
+            next_flush += METRICS_FLUSH_S;
+            if (next_flush < now)
+                next_flush = now + METRICS_FLUSH_S; // Pas de rafale après une suspension
+        }
+
+        double wait = METRICS_POLL_S;
+        if (statsd_fd >= 0 && next_flush - now < wait)
+            wait = next_flush - now > 0 ? next_flush - now : 0;
+        struct timeval tv = {0, (long)(wait * 1e6)};
+        if (listen_fd < 0)
+        {
+            select(0, NULL, NULL, NULL, &tv);
+            continue;
+        }
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(listen_fd, &set);
+        if (select(listen_fd + 1, &set, NULL, NULL, &tv) > 0 && FD_ISSET(listen_fd, &set))
+        {
+            int client = accept(listen_fd, NULL, NULL);
+            if (client >= 0)
+            {
+                serve_client(client);
+                close(client);
+            }
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Ouvre les exports demandés ; un seul suffit pour activer les métriques.
+ */
+bool metrics_start(const char *statsd, int prometheus_port)
+{
+    if (on)
+        return true;
+    if (statsd && statsd[0])
+    {
+        statsd_fd = statsd_connect(statsd);
+        if (statsd_fd < 0)
+            logger_write(LOG_WARN, "[METRIQUES] Destination StatsD invalide : %s\n", statsd);
+    }
+    if (prometheus_port > 0)
+    {
+        listen_fd = prometheus_listen(prometheus_port);
+        if (listen_fd < 0)
+            logger_write(LOG_WARN, "[METRIQUES] Port %d indisponible\n", prometheus_port);
+    }
+    if (statsd_fd < 0 && listen_fd < 0)
+        return false;
+
+    __atomic_store_n(&stop_requested, 0, __ATOMIC_RELEASE);
+    if (pthread_create(&exporter, NULL, exporter_main, NULL) != 0)
+    {
+        metrics_stop();
+        return false;
+    }
+    __atomic_store_n(&on, true, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @brief Indique si les métriques sont actives.
+ */
+bool metrics_enabled(void)
+{
+    return __atomic_load_n(&on, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Addition atomique relâchée : l'ordre entre compteurs n'importe pas.
+ */
+void metrics_count(MetricCounter counter, uint32_t n)
+{
+    if (!__atomic_load_n(&on, __ATOMIC_RELAXED))
+        return;
+    __atomic_fetch_add(&counters[counter], n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Recherche linéaire de la classe (20 bornes), trois additions atomiques.
+ */
+void metrics_observe(MetricHistogram histogram, double seconds)
+{
+    if (!__atomic_load_n(&on, __ATOMIC_RELAXED))
+        return;
+    if (seconds < 0.0)
+        seconds = 0.0;
+    double ms = seconds * 1000.0;
+    int i = 0;
+    while (i < METRICS_BOUND_COUNT && ms > bounds_ms[i])
+        i++;
+    uint64_t ns = (uint64_t)(seconds * 1e9);
+    Histogram *h = &histograms[histogram];
+    __atomic_fetch_add(&h->buckets[i], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->sum_ns, ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+    if (histogram == METRIC_FRAME && ns > __atomic_load_n(&hitch_ns, __ATOMIC_RELAXED))
+        __atomic_fetch_add(&counters[METRIC_HITCHES], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Fixe le temps de démarrage.
+ */
+void metrics_set_startup(double seconds)
+{
+    uint64_t ns = seconds > 0.0 ? (uint64_t)(seconds * 1e9) : 1;
+    __atomic_store_n(&startup_ns, ns, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Fixe le seuil d'image lente.
+ */
+void metrics_set_hitch_budget(double seconds)
+{
+    if (seconds > 0.0)
+        __atomic_store_n(&hitch_ns, (uint64_t)(seconds * 1e9), __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Arrêt du thread (au plus METRICS_POLL_S), dernier envoi StatsD, sockets fermés.
+ */
+void metrics_stop(void)
+{
+    if (on)
+    {
+        __atomic_store_n(&stop_requested, 1, __ATOMIC_RELEASE);
+        pthread_join(exporter, NULL);
+        __atomic_store_n(&on, false, __ATOMIC_RELAXED);
+    }
+    if (statsd_fd >= 0)
+    {
+        statsd_flush();
+        close(statsd_fd);
+        statsd_fd = -1;
+    }
+    if (listen_fd >= 0)
+    {
+        close(listen_fd);
+        listen_fd = -1;
+    }
+}
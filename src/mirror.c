@@ -0,0 +1,144 @@
+/**
+ * @file mirror.c
+ * @brief Implémentation de la Vue miroir (observateur sur son propre thread).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "mirror.h"
+#include "utils.h"
+#include "workset.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define MIRROR_ALIGN 64 ///< Alignement des emplacements (lignes de cache distinctes).
+
+/**
+ * @brief Recopie l'état dans l'emplacement libre et le publie.
+ *
+ * model_copy recâble les pools sur l'emplacement lui-même : l'observateur
+ * lit un modèle cohérent, à son adresse définitive.
+ */
+static void publish_now(MirrorView *mirror, const GameModel *model)
+{
+    if (model->block_size > mirror->size)
+        return; // Modèle agrandi depuis mirror_start : l'observateur garde son dernier état
+    model_copy(snapring_write_slot(&mirror->ring), model);
+    snapring_publish(&mirror->ring, ++mirror->seq);
+}
+
+/**
+ * @brief Thread de l'observateur : ouvre sa Vue, dessine le dernier état publié à sa cadence, la ferme.
+ */
+static void *mirror_main(void *arg)
+{
+    MirrorView *mirror = arg;
+    if (!mirror->view->init())
+    {
+        __atomic_store_n(&mirror->ready, -1, __ATOMIC_RELEASE);
+        return NULL;
+    }
+    __atomic_store_n(&mirror->ready, 1, __ATOMIC_RELEASE);
+
+    uint32_t shown = 0;
+    double next = utils_get_time();
+    while (!__atomic_load_n(&mirror->stop, __ATOMIC_ACQUIRE))
+    {
+        uint32_t seq;
+        const GameModel *model = snapring_acquire(&mirror->ring, &seq);
+        if (model && seq != shown)
+        {
+            mirror->view->render(model);
+            mirror->rendered++;
+            shown = seq;
+        }
+        next += mirror->period;
+        double now = utils_get_time();
+        if (next < now)
+            next = now; // Image en retard : pas de rattrapage en rafale
+        utils_sleep_until(next);
+    }
+    mirror->view->close();
+    return NULL;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Emplacements alloués une fois, premier état publié avant le lancement du thread.
+ */
+bool mirror_start(MirrorView *mirror, const ViewInterface *view, const GameModel *model, int hz)
+{
+    memset(mirror, 0, sizeof(*mirror));
+    mirror->view = view;
+    mirror->period = 1.0 / (hz > 0 ? hz : MIRROR_DEFAULT_HZ);
+    mirror->size = (model->block_size + MIRROR_ALIGN - 1) / MIRROR_ALIGN * MIRROR_ALIGN;
+    mirror->storage = workset_alloc(mirror->size * SNAPRING_SLOTS);
+    if (!mirror->storage)
+        return false;
+    snapring_init(&mirror->ring, mirror->storage, mirror->size);
+    publish_now(mirror, model);
+    mirror->next = utils_get_time() + mirror->period;
+
+    if (pthread_create(&mirror->thread, NULL, mirror_main, mirror) != 0)
+    {
+        workset_free(mirror->storage);
+        mirror->storage = NULL;
+        return false;
+    }
+    int ready;
+    while ((ready = __atomic_load_n(&mirror->ready, __ATOMIC_ACQUIRE)) == 0)
+        utils_sleep_ms(1);
+    if (ready < 0)
+    {
+        pthread_join(mirror->thread, NULL);
+        workset_free(mirror->storage);
+        mirror->storage = NULL;
+        return false;
+    }
+    mirror->active = true;
+    return true;
+}
+
+/**
+ * @brief Une copie par période de l'observateur : les images intermédiaires ne lui seraient jamais montrées.
+ */
+void mirror_publish(MirrorView *mirror, const GameModel *model)
+{
+    if (!mirror->active)
+        return;
+    double now = utils_get_time();
+    if (now < mirror->next)
+        return;
+    mirror->next += mirror->period;
+    if (mirror->next < now)
+        mirror->next = now + mirror->period;
+    publish_now(mirror, model);
+}
+
+/**
+ * @brief Arrêt du thread (qui ferme sa Vue), puis bilan.
+ */
+void mirror_stop(MirrorView *mirror)
+{
+    if (!mirror->active)
+        return;
+    __atomic_store_n(&mirror->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(mirror->thread, NULL);
+    mirror->active = false;
+    printf("Miroir : %llu image(s) affichee(s), %u etat(s) publie(s), %u non affiche(s)\n",
+           (unsigned long long)mirror->rendered, mirror->ring.published, mirror->ring.overwritten);
+    workset_free(mirror->storage);
+    mirror->storage = NULL;
+}
@@ -4,1122 +4,4533 @@
  */
 
 #include "model.h"
+#include "codec.h"
+#include "collision.h"
+#include "simd.h"
+#include "save.h"
+#include "save_writer.h"
+#include "autosave.h"
+#include "logger.h"
+#include "profiler.h"
+#include "wave.h"
+#include "workers.h"
+#include "workset.h"
+#include "entity_pack.h"
+#include "entity_type.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 // Gestion des dossiers (Spécifique Linux pour les sauvegardes)
 #include <sys/stat.h>
-#include <dirent.h>
+
+// La recherche formation_hit suppose qu'une balle ne peut chevaucher qu'une
+// seule colonne et (hors collisions balayées) une seule rangée d'aliens à la
+// fois (vérifié aussi par wave_compile pour l'espacement de chaque vague scriptée).
+#if BULLET_WIDTH + ENEMY_WIDTH > FORMATION_STEP_X || BULLET_HEIGHT + ENEMY_HEIGHT > FORMATION_STEP_Y
+#error "Les balles doivent etre plus fines que l'espacement de la formation"
+#endif
+
+#if FORMATION_SIZE > MAX_ENEMIES || FORMATION_SIZE > 64
+#error "La formation doit tenir dans le tableau d'ennemis et dans un masque 64 bits"
+#endif
+
+#if BOSS_MAX_PARTS > 64 || BOSS_COLS * BOSS_PART_WIDTH > GAME_WIDTH
+#error "Le vaisseau amiral doit tenir dans un masque 64 bits et dans la largeur du terrain"
+#endif
 
 // ============================================================================
 //                          1. FONCTIONS INTERNES (HELPERS)
 // ============================================================================
 
 /**
- * @brief Teste la collision entre deux entités via AABB (Axis-Aligned Bounding Box).
+ * @brief Teste le chevauchement de deux rectangles (AABB).
  * @return true si les rectangles se chevauchent.
  */
-static bool check_collision(const Entity *a, const Entity *b)
+static bool aabb_overlap(float ax, float ay, float aw, float ah,
+                         float bx, float by, float bw, float bh)
+{
+    return (ax < bx + bw &&
+            ax + aw > bx &&
+            ay < by + bh &&
+            ay + ah > by);
+}
+
+/** @brief Teste le bit i d'un masque multi-mots. */
+static bool bit_test(const uint64_t *mask, int i)
+{
+    return (mask[i >> 6] >> (i & 63)) & 1;
+}
+
+/** @brief Met à 1 le bit i d'un masque multi-mots. */
+static void bit_set(uint64_t *mask, int i)
 {
-    if (!a->active || !b->active)
-        return false; // Pas de collision si l'un est inactif/mort
+    mask[i >> 6] |= 1ULL << (i & 63);
+}
 
-    // Vérifie le chevauchement sur les axes X et Y
-    return (a->x < b->x + b->width &&
-            a->x + a->width > b->x &&
-            a->y < b->y + b->height &&
-            a->y + a->height > b->y);
+/** @brief Met à 0 le bit i d'un masque multi-mots. */
+static void bit_clear(uint64_t *mask, int i)
+{
+    mask[i >> 6] &= ~(1ULL << (i & 63));
 }
 
 /**
- * @brief Recherche un slot libre dans le tableau (Pool) et active une balle.
+ * @brief Ajoute un index à une liste active.
  */
-static void spawn_bullet(GameModel *model, float x, float y, float dy, EntityType type)
+static void active_list_add(ActiveList *l, int i)
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
-    {
-        if (!model->bullets[i].active) // Slot trouvé
-        {
-            model->bullets[i].active = true;
-            model->bullets[i].x = x;
-            model->bullets[i].y = y;
-            model->bullets[i].dx = 0;
-            model->bullets[i].dy = dy; // Vitesse verticale (+ monte, - descend)
-            model->bullets[i].width = BULLET_WIDTH;
-            model->bullets[i].height = BULLET_HEIGHT;
-            model->bullets[i].type = type;
-
-            // Reset animation
-            model->bullets[i].anim_timer = 0;
-            model->bullets[i].anim_frame = 0;
-            return; // Balle créée, on arrête la recherche
-        }
-    }
+    l->pos[i] = (short)l->count;
+    l->items[l->count++] = (short)i;
 }
+
 /**
- * @brief Vérifie l'existence physique d'un fichier dans le répertoire de sauvegarde.
- * * Tente d'ouvrir le fichier en lecture binaire pour confirmer sa présence.
- * * @param filename Le nom du fichier à tester (ex: "Partie1.dat").
- * @return true si le fichier existe et est accessible, false sinon.
+ * @brief Retire un index d'une liste active (swap-remove, O(1)).
+ * Le dernier élément prend la place du retiré : parcourir la liste à l'envers
+ * permet donc de retirer l'élément courant sans sauter personne.
  */
-static bool save_file_exists(const char *filename)
+static void active_list_remove(ActiveList *l, int i)
 {
-    char path[128];
-    // Construction du chemin relatif : sauvegardes/ + filename
-    snprintf(path, sizeof(path), "sauvegardes/%s", filename);
-
-    FILE *f = fopen(path, "rb");
-    if (f)
-    {
-        fclose(f);
-        return true;
-    }
-    return false;
+    int k = l->pos[i];
+    int last = l->items[--l->count];
+    l->items[k] = (short)last;
+    l->pos[last] = (short)k;
 }
 
+/** @brief Capacité du pool de balles des prochains model_init (model_set_bullet_capacity). */
+static int bullet_capacity = MAX_BULLETS;
+
+/** @brief Slots réservés au joueur des prochains model_init (0 : part par défaut, model_set_player_bullets). */
+static int player_bullets = 0;
+
+/** @brief Physique des prochains model_init (model_set_fixed_point). */
+static bool fixed_point_default = false;
+
+/** @brief Boucliers des prochains model_init (model_set_shield_bitmap). */
+static bool shield_bitmap_default = false;
+
+/** @brief Collisions des balles des prochains model_init (model_set_swept_bullets). */
+static bool swept_bullets_default = false;
+
+/** @brief Vague sans fin des prochains model_init (model_set_endless). */
+static bool endless_default = false;
+
+/** @brief Coopération locale des prochains model_init (model_set_local_coop). */
+static bool coop_default = false;
+
 /**
- * @brief Génère un nom de fichier unique par incrémentation automatique.
- * * Cette fonction évite l'écrasement involontaire. Si "Partie" est demandé mais existe déjà,
- * elle génère "Partie(1).dat", puis "Partie(2).dat", etc., jusqu'à trouver un slot libre.
- * * @param base_name La racine du nom (ex: "Partie").
- * @param out_buffer Buffer de sortie qui recevra le nom final unique.
+ * @brief Valeur logique vers Q16.16 : mise à l'échelle exacte (puissance de 2), arrondi au plus proche.
  */
-static void generate_unique_filename(const char *base_name, char *out_buffer)
+static int32_t fixed_from(float v)
 {
-    int i = 1;
-    char candidate[128];
+    return (int32_t)lrintf(v * MODEL_FIXED_ONE);
+}
 
-    // Recherche itérative d'un suffixe (N) disponible
-    while (true)
-    {
-        snprintf(candidate, sizeof(candidate), "%s(%d).dat", base_name, i);
+/**
+ * @brief Q16.16 vers valeur logique (exacte sous 256 unités).
+ */
+static float fixed_to(int32_t q)
+{
+    return (float)q / MODEL_FIXED_ONE;
+}
 
-        if (!save_file_exists(candidate))
-        {
-            strcpy(out_buffer, candidate);
-            return; // Nom unique trouvé
-        }
-        i++;
-    }
+/**
+ * @brief Produit Q16.16, arrondi au plus proche (symétrique : aucun décalage de négatif).
+ */
+static int32_t fixed_mul(int32_t a, int32_t b)
+{
+    int64_t p = (int64_t)a * b;
+    return (int32_t)(p >= 0 ? (p + MODEL_FIXED_ONE / 2) / MODEL_FIXED_ONE
+                            : -((-p + MODEL_FIXED_ONE / 2) / MODEL_FIXED_ONE));
 }
-// ============================================================================
-//                          2. LOGIQUE ENNEMIS & UFO
-// ============================================================================
+
 /**
- * @brief Initialise la grille d'ennemis (Wave) pour un début de niveau.
- *
- * Crée une formation classique de 5 rangées par 11 colonnes.
- * Réinitialise également la physique de groupe (vitesse, direction) et l'état de l'OVNI.
+ * @brief Avance une valeur à `rate` unités par seconde pendant un tick.
  *
- * @param model Le modèle contenant le tableau d'ennemis.
+ * En flottants : `value + rate * dt`, comme un `+=`. En virgule fixe (`fixed`,
+ * copie de sim.fixed_point) : un tick de MODEL_FIXED_TICK, en entiers ; `dt` est ignoré.
  */
-static void init_enemies(GameModel *model)
+static float advance(bool fixed, float value, float rate, double dt)
 {
-    int idx = 0;
-
-    // Formation : 5 rangées de 11 colonnes
-    for (int row = 0; row < 5; row++)
-    {
-        for (int col = 0; col < 11; col++)
-        {
-            if (idx >= MAX_ENEMIES)
-                break; // Sécurité débordement
-
-            Entity *e = &model->enemies[idx];
-
-            // 1. Met à zéro tous les champs (exploding, timers, etc.)
-            // Indispensable pour éviter des bugs visuels au redémarrage.
-            memset(e, 0, sizeof(Entity));
-
-            // 2. CONFIGURATION PHYSIQUE
-            e->active = true;
-            e->width = ENEMY_WIDTH;
-            e->height = ENEMY_HEIGHT;
+    if (!fixed)
+        return (float)(value + rate * dt);
+    return fixed_to(fixed_from(value) + fixed_mul(fixed_from(rate), MODEL_FIXED_TICK));
+}
 
-            // Calcul de position : Marge + Index * (Taille + Espace)
-            e->x = 5 + col * (ENEMY_WIDTH + 2);
-            e->y = 7 + row * (ENEMY_HEIGHT + 2);
+/**
+ * @brief Coordonnée d'une case de la formation : origine + index × pas.
+ *
+ * En virgule fixe, le calcul est entier : pas de multiplication-addition
+ * flottante, qu'un compilateur peut fusionner (FMA) ou non.
+ */
+static float grid_coord(bool fixed, float origin, int index, float step)
+{
+    if (fixed)
+        return fixed_to(fixed_from(origin) + index * fixed_from(step));
+    return origin + index * step;
+}
 
-            // 3. TYPES SELON L'ALTITUDE
-            if (row == 0)
-                e->type = ENTITY_ENEMY_TYPE_3; // Haut (Calamar)
-            else if (row < 3)
-                e->type = ENTITY_ENEMY_TYPE_2; // Milieu (Crabe)
-            else
-                e->type = ENTITY_ENEMY_TYPE_1; // Bas (Pieuvre)
+// ============================================================================
+//                          TRAJECTOIRE DE LA VAGUE
+// ============================================================================
 
-            idx++;
-        }
-    }
+/** @brief Tick de rebond d'une vague qui ne peut plus toucher de bord (immobile, ou qui s'en éloigne). */
+#define PATH_EDGE_NEVER (1 << 24)
 
-    // Réinitialisation de la logique de groupe (Vague)
-    model->enemy_speed_mult = 1.0f;
-    model->direction_enemies = 1; // Commence vers la Droite
-    model->drop_direction = 1;
-    model->drop_step_count = 0;
+/**
+ * @brief Origine X après `n` ticks d'un segment parti de `x0` à `rate` unités par seconde.
+ *
+ * Un produit au lieu de `n` additions. En virgule fixe, `n` pas d'un tick
+ * identiques à ceux d'advance, en entiers.
+ */
+static float path_x(bool fixed, double dt, float x0, float rate, int n)
+{
+    if (fixed)
+        return fixed_to((int32_t)(fixed_from(x0) + (int64_t)n * fixed_mul(fixed_from(rate), MODEL_FIXED_TICK)));
+    return (float)(x0 + n * (rate * dt));
+}
 
-    // L'OVNI est désactivé au début du niveau
-    model->ufo.active = false;
-    model->ufo.hasSpawnedThisLevel = false;
-    model->ufo.y = 4; // Altitude de croisière fixe
+/**
+ * @brief La vague d'origine `x`, allant dans le sens `dir`, touche son bord (comparaisons du tick).
+ */
+static bool path_at_edge(bool fixed, const Formation *f, int dir, float x)
+{
+    if (dir < 0)
+        return grid_coord(fixed, x, f->min_col, f->step_x) <= 0;
+    return grid_coord(fixed, x, f->max_col, f->step_x) >= GAME_WIDTH - ENEMY_WIDTH;
 }
 
 /**
- * @brief Active l'apparition de l'OVNI bonus (Mystery Ship).
+ * @brief Premier tick d'un segment où la vague touche son bord.
  *
- * Réinitialise l'entité UFO pour qu'elle soit "neuve" (non explosée)
- * et détermine aléatoirement son côté d'entrée (Gauche ou Droite).
- *
- * @param model Le modèle de jeu.
+ * Distance au bord divisée par le pas d'un tick, puis ajustée d'un tick ou
+ * deux avec les comparaisons du tick lui-même : l'arrondi de la division ne
+ * décide jamais du rebond.
  */
-static void spawn_ufo(GameModel *model)
+static int path_solve(bool fixed, double dt, const Formation *f, int dir, float x0, float rate)
 {
-    // 1. NETTOYAGE : Réinitialise les flags d'explosion.
-    // Indispensable si l'OVNI précédent a été détruit (évite d'afficher une explosion dès le spawn).
-    model->ufo.exploding = false;
-    model->ufo.explode_timer = 0.0f;
-
-    // 2. ACTIVATION
-    model->ufo.active = true;
-    model->ufo.hasSpawnedThisLevel = true; // Bloque le spawn multiple par niveau
-    model->ufo.type = ENTITY_UFO;
-    model->ufo.width = UFO_WIDTH;
-    model->ufo.height = UFO_HEIGHT;
-    model->ufo.y = 4; // Altitude fixe (Très haut dans le ciel)
+    double step = fixed ? fixed_to(fixed_mul(fixed_from(rate), MODEL_FIXED_TICK)) : rate * dt;
+    double gap = (dir < 0) ? x0 + f->min_col * f->step_x : (GAME_WIDTH - ENEMY_WIDTH) - (x0 + f->max_col * f->step_x);
+    if (path_at_edge(fixed, f, dir, x0))
+        return 0;
+    if (step * dir <= 0)
+        return PATH_EDGE_NEVER;
+    int n = (int)fmin(ceil(gap / fabs(step)), PATH_EDGE_NEVER);
+    while (n > 1 && path_at_edge(fixed, f, dir, path_x(fixed, dt, x0, rate, n - 1)))
+        n--;
+    while (n < PATH_EDGE_NEVER && !path_at_edge(fixed, f, dir, path_x(fixed, dt, x0, rate, n)))
+        n++;
+    return n;
+}
 
-    // 3. DIRECTION ALÉATOIRE
-    if (rand() % 2 == 0)
+/**
+ * @brief Pas vertical d'un rebond : descente saccadée en trois temps, puis remontée.
+ *
+ * @return Déplacement de l'origine Y ; le sens et le compteur passent au rebond suivant.
+ */
+static float drop_step(float height, int *drop_direction, int *drop_step_count)
+{
+    float dy = *drop_direction * height; // drop_direction vaut ±1
+    if (*drop_direction == 1)
     {
-        // Apparition à GAUCHE -> Va à DROITE
-        model->ufo.x = -UFO_WIDTH;
-        model->ufo.dx = UFO_SPEED;
+        if (++*drop_step_count >= 3)
+            *drop_direction = -1;
     }
     else
     {
-        // Apparition à DROITE -> Va à GAUCHE
-        model->ufo.x = GAME_WIDTH;
-        model->ufo.dx = -UFO_SPEED;
+        if (--*drop_step_count <= 0)
+            *drop_direction = 1;
     }
+    return dy;
 }
-// ============================================================================
-//                          3. INITIALISATION & RESET
-// ============================================================================
 
 /**
- * @brief Initialise les boucliers de protection du joueur.
- *
- * Place les 4 boucliers de manière équidistante sur l'écran,
- * juste au-dessus du vaisseau du joueur. Chaque bouclier a une santé
- * initiale définie par SHIELD_MAX_HEALTH.
- *
- * @param model Le modèle de jeu contenant le tableau des boucliers.
+ * @brief Le segment en cours décrit encore la vague (même vitesse, mêmes colonnes, même origine).
  */
-static void init_shields(GameModel *model)
+static bool path_current(bool fixed, double dt, const Formation *f, float rate)
 {
-    float shield_w = 8.0f;
-    float shield_h = 6.0f;
-    // Espacement dynamique pour centrer
-    float spacing = GAME_WIDTH / (MAX_SHIELDS + 1.0f);
+    return f->path_ticks >= 0 && rate == f->path_rate && f->min_col == f->path_min_col &&
+           f->max_col == f->path_max_col && path_x(fixed, dt, f->path_x0, f->path_rate, f->path_ticks) == f->origin_x;
+}
 
-    for (int i = 0; i < MAX_SHIELDS; i++)
+/**
+ * @brief Tient le segment de la vague à jour et dit si ce tick est celui du rebond.
+ *
+ * Un rebond, un changement de vitesse ou de colonnes extrêmes (alien abattu),
+ * une origine posée de l'extérieur (nouveau niveau, chargement) ouvrent un
+ * segment à l'origine courante ; sinon, le tick ne fait qu'une comparaison.
+ */
+static bool path_follow(GameModel *model, bool fixed, double dt)
+{
+    Formation *f = &model->sim.formation;
+    int dir = model->sim.direction_enemies;
+    float rate = model->sim.params.enemy_speed * model->sim.enemy_speed_mult * dir;
+    if (!path_current(fixed, dt, f, rate))
     {
-        model->shields[i].active = true;
-        model->shields[i].health = SHIELD_MAX_HEALTH; // 10
-        model->shields[i].width = shield_w;
-        model->shields[i].height = shield_h;
-        model->shields[i].x = (spacing * (i + 1)) - (shield_w / 2.0f);
-        model->shields[i].y = GAME_HEIGHT - PLAYER_HEIGHT - 9;
+        f->path_x0 = f->origin_x;
+        f->path_rate = rate;
+        f->path_ticks = 0;
+        f->path_min_col = f->min_col;
+        f->path_max_col = f->max_col;
+        f->path_edge = path_solve(fixed, dt, f, dir, f->origin_x, rate);
     }
+    return f->path_ticks >= f->path_edge;
 }
 
+/** @brief Pas flottants rejoués au plus pour retrouver la durée d'un ancien timer (au-delà : arrondi). */
+#define TIMER_REPLAY_MAX 100000
+
 /**
- * @brief Initialise et alloue un nouveau modèle de jeu.
- *
- * Crée la structure GameModel avec tous ses composants initialisés :
- * - État initial sur le menu principal
- * - Joueur positionné au centre de l'écran
- * - Grille d'ennemis créée
- * - Boucliers mis en place
- * - Volume audio à 30%
+ * @brief Façon dont l'ancien timer flottant atteignait une durée.
+ */
+typedef enum
+{
+    TICKS_DOWN, ///< Décompte depuis la durée jusqu'à <= 0 (advance, pas -1).
+    TICKS_UP,   ///< Compte de 0 jusqu'à >= la durée (advance, pas +1).
+    TICKS_PAST  ///< Compte de 0 jusqu'à > la durée, en float (animation des balles, simd_bullet_step).
+} TickRule;
+
+/**
+ * @brief Nombre de ticks d'une durée.
  *
- * @return Pointeur vers le GameModel alloué, ou NULL en cas d'échec d'allocation.
- * @note Le dossier "sauvegardes" est créé s'il n'existe pas.
+ * En virgule fixe : les pas entiers de MODEL_FIXED_TICK d'advance, calculés
+ * d'une division. Avec exact_timers : la durée arrondie au tick. Sinon
+ * (sessions enregistrées avant les timers entiers) : les pas flottants sont
+ * rejoués, pour tomber sur le même tick que l'ancien timer.
  */
-GameModel *model_init(void)
+static int duration_ticks(const SimState *s, float seconds, double dt, TickRule rule)
 {
-    // 1. Allocation + Mise à zéro automatique (calloc)
-    // Plus besoin d'initialiser is_muted, dx, dy, timers... tout est à 0 !
-    GameModel *model = calloc(1, sizeof(GameModel));
-    if (!model)
-        return NULL;
+    if (!(seconds > 0.0f))
+        return rule == TICKS_DOWN ? 0 : 1;
+    if (s->fixed_point)
+    {
+        if (rule == TICKS_DOWN)
+            return (fixed_from(seconds) + MODEL_FIXED_TICK - 1) / MODEL_FIXED_TICK;
+        if (rule == TICKS_UP)
+            return (int)((ceil((double)seconds * MODEL_FIXED_ONE) + MODEL_FIXED_TICK - 1) / MODEL_FIXED_TICK);
+        return fixed_from(seconds) / MODEL_FIXED_TICK + 1;
+    }
+    double x = seconds / dt;
+    if (s->exact_timers || x > TIMER_REPLAY_MAX)
+    {
+        int n = (int)ceil(x - 1e-3);
+        return n > 1 ? n : 1;
+    }
 
-    // 2. Création du dossier sauvegarde (Linux)
-    mkdir("sauvegardes", 0777);
+    int n = 0;
+    if (rule == TICKS_DOWN)
+        for (float v = seconds; v > 0; v = (float)(v - dt))
+            n++;
+    else if (rule == TICKS_UP)
+        for (float v = 0.0f; v < seconds; v = (float)(v + dt))
+            n++;
+    else
+        for (float t = 0.0f, step = (float)dt; t <= seconds; t += step)
+            n++;
+    return n;
+}
 
-    // 3. Valeurs par défaut (Seulement ce qui n'est pas 0)
-    model->state = STATE_MENU;
-    model->lives = 3;
-    model->normal_max_lives = MAX_LIVES_NORMAL;
-    model->level = 1;
-    model->volume = 30; // 30% volume
+/** @brief Durée d'un tick en secondes (MODEL_FIXED_TICK en virgule fixe, sinon le dernier `dt`). */
+static double tick_seconds(const SimState *s)
+{
+    return s->fixed_point ? (double)MODEL_FIXED_TICK / MODEL_FIXED_ONE : s->tick_dt;
+}
 
-    // 4. Initialisation Joueur
-    model->player.active = true;
-    model->player.type = ENTITY_PLAYER;
-    model->player.width = PLAYER_WIDTH;
-    model->player.height = PLAYER_HEIGHT;
-    model->player.x = (GAME_WIDTH - PLAYER_WIDTH) / 2.0f;
-    model->player.y = GAME_HEIGHT - PLAYER_HEIGHT - 1;
+/** @brief Ticks entre deux sprites d'une balle (BULLET_ANIM_PERIOD). */
+static int bullet_anim_ticks(const SimState *s, double dt)
+{
+    return duration_ticks(s, BULLET_ANIM_PERIOD, dt, TICKS_PAST);
+}
 
-    // 5. Initialisation du Monde
-    init_enemies(model);
-    init_shields(model); // On utilise la fonction helper
+/** @brief Position de l'arène dans le bloc du modèle : juste après la structure, alignée. */
+static size_t arena_offset(void)
+{
+    return (sizeof(GameModel) + MODEL_ARENA_ALIGN - 1) / MODEL_ARENA_ALIGN * MODEL_ARENA_ALIGN;
+}
 
-    return model;
+/**
+ * @brief Réserve `bytes` octets en `*at` (arrondis à MODEL_ARENA_ALIGN).
+ * @return L'adresse réservée, ou NULL si `base` est NULL (simple calcul de taille).
+ */
+static void *arena_take(uint8_t *base, size_t *at, size_t bytes)
+{
+    void *out = base ? base + *at : NULL;
+    *at += (bytes + MODEL_ARENA_ALIGN - 1) / MODEL_ARENA_ALIGN * MODEL_ARENA_ALIGN;
+    return out;
 }
 
 /**
- * @brief Réinitialise complètement une partie de jeu.
+ * @brief Découpe l'arène des pools et renvoie sa taille.
  *
- * Remet à zéro tous les éléments du jeu pour commencer une nouvelle partie :
- * - Score remis à 0
- * - Vies remises à 3
- * - Niveau remis à 1
- * - Joueur repositionné au centre
- * - Ennemis et boucliers recréés
- * - Toutes les balles supprimées
+ * Les pointeurs des pools reçoivent leurs tableaux dans `base` (tous NULL si
+ * `base` est NULL). Le même découpage sert au calcul de la taille, au câblage
+ * d'un modèle neuf ou copié et aux instantanés, qui gardent l'arène telle quelle.
  *
- * @param model Le modèle de jeu à réinitialiser.
+ * @param b, e Pools à câbler (NULL : taille seule).
  */
-static void reset_game(GameModel *model)
+static size_t arena_layout(uint8_t *base, int bullets, BulletPool *b, EnemyPool *e)
 {
-    // 1. Reset Stats
-    model->score = 0;
-    model->lives = 3;
-    model->level = 1;
-    model->hit_timer = 0;
+    BulletPool unused_b;
+    EnemyPool unused_e;
+    if (!b)
+        b = &unused_b;
+    if (!e)
+        e = &unused_e;
+    size_t n = (size_t)bullets, m = MAX_ENEMIES, at = 0;
 
-    // 2. Reset Difficulté
-    model->enemy_speed_mult = 1.0f;
-    model->direction_enemies = 1;
-    model->drop_direction = 1;
-    model->drop_step_count = 0;
+    b->x = arena_take(base, &at, n * sizeof(float));
+    b->y = arena_take(base, &at, n * sizeof(float));
+    b->dy = arena_take(base, &at, n * sizeof(float));
+    b->active = arena_take(base, &at, BULLET_MASK_WORDS(n) * sizeof(uint64_t));
+    b->type = arena_take(base, &at, n * sizeof(EntityType));
+    b->anim_timer = arena_take(base, &at, n * sizeof(int));
+    b->anim_frame = arena_take(base, &at, n * sizeof(int));
+    b->free_slots = arena_take(base, &at, n * sizeof(short));
+    b->live.items = arena_take(base, &at, n * sizeof(short));
+    b->live.pos = arena_take(base, &at, n * sizeof(short));
+    b->sweep_order = arena_take(base, &at, 2 * n * sizeof(short));
+    b->sweep_member = arena_take(base, &at, BULLET_MASK_WORDS(n) * sizeof(uint64_t));
 
-    // 3. Nettoyage des balles (memset = instantané)
-    // Remplace ta boucle for qui parcourait tout le tableau
-    memset(model->bullets, 0, sizeof(model->bullets));
+    e->x = arena_take(base, &at, m * sizeof(float));
+    e->y = arena_take(base, &at, m * sizeof(float));
+    e->type = arena_take(base, &at, m * sizeof(EntityType));
+    e->live.items = arena_take(base, &at, m * sizeof(short));
+    e->live.pos = arena_take(base, &at, m * sizeof(short));
+    return at;
+}
 
-    // 4. Reset Entités
-    model->ufo.active = false;
-    model->ufo.hasSpawnedThisLevel = false;
+/** @brief Câble les pools du modèle sur sa propre arène (`bullets.capacity` fixé). */
+static void model_link_arena(GameModel *model)
+{
+    arena_layout((uint8_t *)model + arena_offset(), model->sim.bullets.capacity, &model->sim.bullets, &model->sim.enemies);
+}
 
-    // Replacer le joueur au centre
-    model->player.x = (GAME_WIDTH - PLAYER_WIDTH) / 2.0f;
-    model->player.dx = 0;
+/**
+ * @brief Vide les tableaux du pool de balles et ses compteurs (capacité gardée).
+ */
+static void bullet_pool_clear(BulletPool *p)
+{
+    size_t n = (size_t)p->capacity;
+    memset(p->x, 0, n * sizeof(float));
+    memset(p->y, 0, n * sizeof(float));
+    memset(p->dy, 0, n * sizeof(float));
+    memset(p->active, 0, (size_t)p->mask_words * sizeof(uint64_t));
+    memset(p->type, 0, n * sizeof(EntityType));
+    memset(p->anim_timer, 0, n * sizeof(int));
+    memset(p->anim_frame, 0, n * sizeof(int));
+    memset(p->free_slots, 0, n * sizeof(short));
+    memset(p->sweep_member, 0, (size_t)p->mask_words * sizeof(uint64_t));
+    p->sweep_count = 0;
+    memset(p->free_count, 0, sizeof(p->free_count));
+    memset(p->dropped_spawns, 0, sizeof(p->dropped_spawns));
+    p->high_water = 0;
+    p->player_high = 0;
+    p->live.count = 0;
+}
 
-    // 5. Recréation du niveau
-    init_enemies(model);
-    init_shields(model); // Plus de duplication de code ici !
+/** @brief Slots du joueur pour une capacité : le réglage, ou la part par défaut (un slot au moins par camp). */
+static int player_slots_for(int capacity)
+{
+    int n = player_bullets > 0 ? player_bullets : capacity / MODEL_PLAYER_BULLET_SHARE;
+    if (n > capacity - 1)
+        n = capacity - 1;
+    return n < 1 ? 1 : n;
+}
 
-    // 6. Lancement
-    model->state = STATE_PLAYING;
+/** @brief Camp d'un type de balle (BULLET_SIDE_*). */
+static inline int bullet_side(EntityType type)
+{
+    return type != ENTITY_BULLET_PLAYER;
+}
+
+/** @brief Premier slot du camp `s` (aussi le fond de sa pile dans `free_slots`). */
+static inline int side_base(const BulletPool *p, int s)
+{
+    return s ? p->player_slots : 0;
+}
+
+/** @brief Slot juste après le bloc du camp `s`. */
+static inline int side_end(const BulletPool *p, int s)
+{
+    return s ? p->capacity : p->player_slots;
 }
 
 /**
- * @brief Libère la mémoire allouée pour le modèle de jeu.
- *
- * @param model Le modèle de jeu à libérer (peut être NULL).
+ * @brief Empile le slot libre `i` sur la pile de son camp (camp déduit de l'index).
  */
-void model_free(GameModel *model)
+static inline void free_push(BulletPool *p, int i)
 {
-    if (model)
-        free(model);
+    int s = i >= p->player_slots;
+    p->free_slots[side_base(p, s) + p->free_count[s]++] = (short)i;
 }
 
-// ============================================================================
-//                          5. GESTION DES ENTRÉES (CONTROLLER -> MODEL)
-// ============================================================================
+/**
+ * @brief Note un slot qui vient d'être occupé dans les bornes des passes.
+ */
+static inline void high_water_note(BulletPool *p, int i)
+{
+    if (i >= p->high_water)
+        p->high_water = i + 1;
+    if (i < p->player_slots && i >= p->player_high)
+        p->player_high = i + 1;
+}
 
 /**
- * @brief Gère les entrées utilisateur en fonction de l'état actuel du jeu.
- *
- * Dispatche les commandes vers la logique appropriée selon l'état du jeu :
- * - STATE_MENU : Navigation et sélection dans le menu principal
- * - STATE_LOAD_MENU : Sélection d'une sauvegarde à charger
- * - STATE_TUTORIAL : Affichage du tutoriel
- * - STATE_PLAYING : Contrôle du vaisseau et tir
- * - STATE_PAUSED : Menu pause avec options
- * - STATE_GAME_OVER : Écran de fin de partie
- * - STATE_SAVE_* : Gestion des sauvegardes
- * - STATE_CONFIRM_QUIT : Confirmation avant de quitter
- *
- * @param model Le modèle de jeu à mettre à jour.
- * @param cmd La commande reçue du contrôleur (GameCommand).
+ * @brief Vide le pool de balles et remplit la pile des slots libres de chaque camp.
+ * Les index sont empilés à l'envers : le premier tir d'un camp prend son premier slot.
  */
-void model_handle_input(GameModel *model, GameCommand cmd)
+static void bullet_pool_reset(BulletPool *p)
 {
-    // ---------------------------------------------------------
-    // 1. MENU PRINCIPAL
-    // ---------------------------------------------------------
-    if (model->state == STATE_MENU)
+    bullet_pool_clear(p);
+    for (int i = p->capacity - 1; i >= 0; i--)
+        free_push(p, i);
+}
+
+/**
+ * @brief Désactive une balle et rend son slot à la pile des libres de son camp.
+ */
+static void bullet_release(BulletPool *p, int i)
+{
+    bit_clear(p->active, i);
+    active_list_remove(&p->live, i);
+    free_push(p, i);
+}
+
+/**
+ * @brief Dépile un slot libre du camp du tir (Pool) et active une balle.
+ * Si le camp est plein, le tir est perdu et comptabilisé dans `dropped_spawns` :
+ * l'autre camp n'est jamais entamé.
+ */
+static void spawn_bullet(GameModel *model, float x, float y, float dy, EntityType type)
+{
+    BulletPool *p = &model->sim.bullets;
+    int s = bullet_side(type);
+    if (p->free_count[s] == 0)
     {
-        if (cmd == CMD_EXIT)
-            exit(0);
+        p->dropped_spawns[s]++;
+        return;
+    }
 
-        // Navigation (0 à 4)
-        if (cmd == CMD_UP)
-            model->menu_selection = (model->menu_selection - 1 < 0) ? 4 : model->menu_selection - 1;
-        if (cmd == CMD_DOWN)
-            model->menu_selection = (model->menu_selection + 1 > 4) ? 0 : model->menu_selection + 1;
+    int i = p->free_slots[side_base(p, s) + --p->free_count[s]];
+    high_water_note(p, i);
+    bit_set(p->active, i);
+    active_list_add(&p->live, i);
+    p->x[i] = x;
+    p->y[i] = y;
+    p->dy[i] = dy; // Vitesse verticale (+ monte, - descend)
+    p->type[i] = type;
 
-        // Gestion Volume (Option 3)
-        if (model->menu_selection == 3)
-        {
-            if (cmd == CMD_LEFT || cmd == CMD_MOVE_LEFT)
-            {
-                model->volume = (model->volume - 10 < 0) ? 0 : model->volume - 10;
-                model->is_muted = false;
-            }
-            if (cmd == CMD_RIGHT || cmd == CMD_MOVE_RIGHT)
-            {
-                model->volume = (model->volume + 10 > 100) ? 100 : model->volume + 10;
-                model->is_muted = false;
-            }
-            if (cmd == CMD_SHOOT || cmd == CMD_RETURN)
-                model->is_muted = !model->is_muted;
-        }
-        // Validation
-        else if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            model->sounds.play_select_sound = true;
+    // Reset animation
+    p->anim_timer[i] = 0;
+    p->anim_frame[i] = 0;
+    model_touch(model, MODEL_GEN_BULLETS);
+}
+/**
+ * @brief Vérifie l'existence physique d'un fichier dans le répertoire de sauvegarde.
+ * * Tente d'ouvrir le fichier en lecture binaire pour confirmer sa présence.
+ * * @param filename Le nom du fichier à tester (ex: "Partie1.dat").
+ * @return true si le fichier existe et est accessible, false sinon.
+ */
+static bool save_file_exists(const char *filename)
+{
+    char path[128];
+    // Construction du chemin relatif : sauvegardes/ + filename
+    snprintf(path, sizeof(path), "sauvegardes/%s", filename);
 
-            if (model->menu_selection == 0)
-                reset_game(model);
-            else if (model->menu_selection == 1)
-                model->state = STATE_TUTORIAL;
-            else if (model->menu_selection == 2)
-            {
-                model_scan_saves(model);
-                if (model->save_file_count > 0)
-                {
-                    model->state = STATE_LOAD_MENU;
-                    model->menu_selection = 0;
-                }
-                else
-                {
-                    model->state = STATE_LOAD_MENU;
-                }
-            }
-            else if (model->menu_selection == 4)
-                exit(0);
-        }
-        return;
+    FILE *f = fopen(path, "rb");
+    if (f)
+    {
+        fclose(f);
+        return true;
     }
+    return false;
+}
 
-    // ---------------------------------------------------------
-    // 2. MENU CHARGEMENT
-    // ---------------------------------------------------------
-    if (model->state == STATE_LOAD_MENU)
-    {
-        if (cmd == CMD_EXIT || cmd == CMD_PAUSE)
-        {
-            model->state = STATE_MENU;
-            model->menu_selection = 2;
-            return;
-        }
+/**
+ * @brief Place le journal d'autosave (s'il existe) en tête de la liste "Charger".
+ *
+ * Il n'est pas dans l'index : ce n'est pas une sauvegarde que l'on peut écraser.
+ */
+static void list_autosave(GameModel *model)
+{
+    SaveIndexEntry entry;
+    if (!autosave_describe("sauvegardes/" AUTOSAVE_FILE, &entry))
+        return;
 
-        if (cmd == CMD_UP)
-            model->menu_selection = (model->menu_selection - 1 < 0) ? model->save_file_count - 1 : model->menu_selection - 1;
-        if (cmd == CMD_DOWN)
-            model->menu_selection = (model->menu_selection + 1 >= model->save_file_count) ? 0 : model->menu_selection + 1;
+    int n = (model->ui.save_file_count < MAX_SAVE_FILES) ? model->ui.save_file_count : MAX_SAVE_FILES - 1;
+    memmove(&model->ui.save_files[1], &model->ui.save_files[0], n * sizeof(SaveIndexEntry));
+    model->ui.save_files[0] = entry;
+    model->ui.save_file_count = n + 1;
+}
 
-        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            if (model->save_file_count > 0)
-            {
-                model->sounds.play_select_sound = true;
-                model_load_named(model, model->save_files[model->menu_selection]);
-            }
-        }
+/**
+ * @brief Reporte dans la liste les sauvegardes trouvées en fond depuis le tick précédent.
+ *
+ * L'entrée d'autosave, placée en tête à l'ouverture du menu "Charger", y
+ * reste. Une fois la liste définitive, un menu "Charger" vide se referme,
+ * comme si aucune sauvegarde n'avait été trouvée à l'ouverture.
+ */
+static void poll_save_scan(GameModel *model)
+{
+    SaveIndexEntry *files = model->ui.save_files;
+    int keep = (model->ui.save_file_count > 0 && strcmp(files[0].name, AUTOSAVE_FILE) == 0) ? 1 : 0;
+    bool done;
+    int n = save_index_scan_poll(files + keep, MAX_SAVE_FILES - keep, &done);
+    if (n >= 0 || done)
+        model_touch(model, MODEL_GEN_MENU);
+    if (n >= 0)
+    {
+        model->ui.save_file_count = keep + n;
+        int last = (model->sim.state == STATE_SAVE_SELECT) ? model->ui.save_file_count : model->ui.save_file_count - 1;
+        if (model->ui.menu_selection > last)
+            model->ui.menu_selection = (last > 0) ? last : 0;
+    }
+    if (!done)
         return;
+    model->ui.save_scan_pending = false;
+    if (model->sim.state == STATE_LOAD_MENU && model->ui.save_file_count == 0)
+    {
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 2; // "CHARGER"
     }
+}
 
-    // ---------------------------------------------------------
-    // 3. TUTORIEL
-    // ---------------------------------------------------------
-    if (model->state == STATE_TUTORIAL)
+/**
+ * @brief Lance une sauvegarde en arrière-plan et passe en attente de confirmation.
+ *
+ * Le nom est gardé dans ui.current_filename : la Vue SDL y range la miniature
+ * de la partie (cf. save_index_thumbnail). Un nom qui n'y tient pas entier est
+ * refusé plutôt que tronqué (la miniature serait rangée sous un autre nom).
+ * En cas d'échec immédiat (nom trop long, encodage, thread), on revient à la
+ * saisie du nom.
+ */
+static void begin_save(GameModel *model, const char *filename)
+{
+    size_t len = strlen(filename);
+    if (len >= sizeof(model->ui.current_filename))
     {
-        if (cmd == CMD_EXIT || cmd == CMD_PAUSE || cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            model->sounds.play_select_sound = true;
-            model->state = STATE_MENU;
-            model->menu_selection = 1;
-        }
+        model->sim.state = STATE_SAVE_INPUT;
         return;
     }
+    memcpy(model->ui.current_filename, filename, len + 1);
+    model->sim.state = model_save_named(model, filename) ? STATE_SAVING : STATE_SAVE_INPUT;
+}
 
-    // ---------------------------------------------------------
-    // 4. JEU (PLAYING)
-    // ---------------------------------------------------------
-    if (model->state == STATE_PLAYING)
+/**
+ * @brief Dépose un son dans la file de la Vue (rien sans file branchée).
+ *
+ * @param x Abscisse de l'émetteur en unités de jeu (donne la position stéréo).
+ */
+static void emit_sound(GameModel *model, AudioSound sound, float x)
+{
+    if (!model->ui.sounds.events)
+        return;
+    float pan = x / GAME_WIDTH * 2.0f - 1.0f;
+    AudioEvent e = {sound, (pan < -1.0f) ? -1.0f : (pan > 1.0f ? 1.0f : pan), 1.0f};
+    spsc_push(model->ui.sounds.events, &e);
+}
+
+/**
+ * @brief Dépose un événement dans le journal de télémétrie (rien sans file branchée).
+ */
+static void emit_telemetry(GameModel *model, TelemetryEventType type, int kind, float x, float y)
+{
+    TelemetryState *t = &model->ui.telemetry;
+    if (!t->events)
+        return;
+    TelemetryEvent e;
+    e.tick = t->tick;
+    e.type = (uint8_t)type;
+    e.kind = (uint8_t)kind;
+    e.level = (uint8_t)(model->sim.level > 255 ? 255 : model->sim.level);
+    e.lives = (uint8_t)(model->sim.lives < 0 ? 0 : (model->sim.lives > 255 ? 255 : model->sim.lives));
+    e.x = (int16_t)x;
+    e.y = (int16_t)y;
+    e.score = model->sim.score;
+    spsc_push(t->events, &e);
+}
+
+// ============================================================================
+//                          2. LOGIQUE ENNEMIS & UFO
+// ============================================================================
+
+/**
+ * @brief Recalcule l'alien vivant le plus bas d'une colonne (le seul qui y tire).
+ */
+static void formation_update_bottom(Formation *f, int col)
+{
+    f->bottom[col] = -1;
+    for (int row = FORMATION_ROWS - 1; row >= 0; row--)
     {
-        if (cmd == CMD_PAUSE)
+        int idx = row * FORMATION_COLS + col;
+        if (f->alive_mask & (1ULL << idx))
         {
-            model->state = STATE_PAUSED;
-            model->menu_selection = 0;
+            f->bottom[col] = (int8_t)idx;
             return;
         }
+    }
+}
 
-        if (cmd == CMD_MOVE_LEFT || cmd == CMD_LEFT)
-            model->player.dx = -PLAYER_SPEED;
-        else if (cmd == CMD_MOVE_RIGHT || cmd == CMD_RIGHT)
-            model->player.dx = PLAYER_SPEED;
-        else if (cmd == CMD_NONE)
-            model->player.dx = 0;
+/**
+ * @brief Recalcule les colonnes extrêmes encore occupées par des aliens vivants.
+ *
+ * On replie les rangées du masque de vie en un masque de colonnes (11 bits).
+ * Vague vide : min_col = max_col = -1. Le bas de chaque colonne est recalculé
+ * avec (vague neuve ou restaurée).
+ */
+static void formation_update_span(Formation *f)
+{
+    for (int col = 0; col < FORMATION_COLS; col++)
+        formation_update_bottom(f, col);
 
-        if (cmd == CMD_SHOOT && model->player.shoot_timer <= 0.0f)
-        {
-            // Tir centré par rapport au joueur
-            spawn_bullet(model,
-                         model->player.x + 1.5f,
-                         model->player.y - 1,
-                         -BULLET_SPEED,
-                         ENTITY_BULLET_PLAYER);
-            model->player.shoot_timer = 0.5f;
-            model->sounds.play_shoot = true;
-        }
+    uint64_t cols = 0;
+    for (int row = 0; row < FORMATION_ROWS; row++)
+        cols |= f->alive_mask >> (row * FORMATION_COLS);
+    cols &= (1ULL << FORMATION_COLS) - 1;
+
+    f->min_col = f->max_col = -1;
+    if (!cols)
+        return;
+
+    int lo = 0, hi = FORMATION_COLS - 1;
+    while (!(cols & (1ULL << lo)))
+        lo++;
+    while (!(cols & (1ULL << hi)))
+        hi--;
+    f->min_col = lo;
+    f->max_col = hi;
+}
+
+/**
+ * @brief Recalcule tous les caches de la vague depuis son masque de vie (chemin de référence).
+ */
+static void formation_rescan(Formation *f)
+{
+    f->alive_count = __builtin_popcountll(f->alive_mask);
+    formation_update_span(f);
+}
+
+/**
+ * @brief Courbe de vitesse : la vague accélère à mesure qu'elle s'éclaircit.
+ * Sans gain (`speedup` nul), le multiplicateur garde sa valeur de départ.
+ */
+static void formation_update_speed(GameModel *model)
+{
+    const Formation *f = &model->sim.formation;
+    if (f->speedup <= 0 || f->size <= 0)
         return;
+    if (model->sim.fixed_point)
+    {
+        int32_t gain = (int32_t)((int64_t)fixed_from(f->speedup) * (f->size - f->alive_count) / f->size);
+        model->sim.enemy_speed_mult = fixed_to(fixed_mul(fixed_from(f->speed), MODEL_FIXED_ONE + gain));
     }
+    else
+        model->sim.enemy_speed_mult = f->speed * (1.0f + f->speedup * (float)(f->size - f->alive_count) / (float)f->size);
+}
 
-    // ---------------------------------------------------------
-    // 5. PAUSE
-    // ---------------------------------------------------------
-    if (model->state == STATE_PAUSED)
+/**
+ * @brief Ajoute un alien à la roue des explosions.
+ *
+ * Il rejoint le créneau qui a autant de ticks restants que lui : ils
+ * finissent d'exploser au même tick. Sinon, il ouvre un créneau (il y en a
+ * au plus un par alien).
+ */
+static void explosion_add(EnemyPool *e, int i, int timer)
+{
+    for (int k = 0; k < e->explosion_count; k++)
     {
-        if (cmd == CMD_PAUSE)
+        if (e->explosions[k].timer == timer)
         {
-            model->state = STATE_PLAYING;
+            e->explosions[k].mask |= 1ULL << i;
             return;
         }
-
-        if (cmd == CMD_UP)
-            model->menu_selection = (model->menu_selection - 1 < 0) ? 3 : model->menu_selection - 1;
-        if (cmd == CMD_DOWN)
-            model->menu_selection = (model->menu_selection + 1 > 3) ? 0 : model->menu_selection + 1;
-
-        // Volume (Index 1)
-        if (model->menu_selection == 1)
-        {
-            if (cmd == CMD_LEFT)
-            {
-                model->volume = (model->volume < 10) ? 0 : model->volume - 10;
-                model->is_muted = false;
-            }
-            if (cmd == CMD_RIGHT)
-            {
-                model->volume = (model->volume > 90) ? 100 : model->volume + 10;
-                model->is_muted = false;
-            }
-            if (cmd == CMD_SHOOT || cmd == CMD_RETURN)
-                model->is_muted = !model->is_muted;
-        }
-        else if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            model->sounds.play_select_sound = true;
-            if (model->menu_selection == 0)
-                model->state = STATE_PLAYING;
-            else if (model->menu_selection == 2)
-            {
-                model_scan_saves(model);
-                model->state = STATE_SAVE_SELECT;
-                model->menu_selection = 0;
-            }
-            else if (model->menu_selection == 3)
-            {
-                model->previous_state = STATE_PAUSED;
-                model->state = STATE_CONFIRM_QUIT;
-                model->menu_selection = 1;
-            }
-        }
-        return;
     }
+    e->explosions[e->explosion_count++] = (ExplosionSlot){1ULL << i, timer};
+}
 
-    // ---------------------------------------------------------
-    // 6. GAME OVER
-    // ---------------------------------------------------------
-    if (model->state == STATE_GAME_OVER)
+/**
+ * @brief Avance les créneaux de la roue des explosions d'un tick.
+ *
+ * @return Les aliens dont l'explosion vient de finir (créneaux retirés).
+ */
+static uint64_t explosion_advance(EnemyPool *e)
+{
+    uint64_t done = 0;
+    int kept = 0;
+    for (int k = 0; k < e->explosion_count; k++)
     {
-        // Navigation (0, 1, 2)
-        if (cmd == CMD_UP)
-            model->menu_selection = (model->menu_selection - 1 < 0) ? 2 : model->menu_selection - 1;
+        ExplosionSlot slot = e->explosions[k];
+        if (--slot.timer <= 0)
+            done |= slot.mask;
+        else
+            e->explosions[kept++] = slot;
+    }
+    e->explosion_count = kept;
+    return done;
+}
 
-        if (cmd == CMD_DOWN)
-            model->menu_selection = (model->menu_selection + 1 > 2) ? 0 : model->menu_selection + 1;
+/**
+ * @brief Retire un alien de la formation (impact) et met à jour les caches.
+ *
+ * La position courante est figée dans l'EnemyPool pour l'explosion. Les colonnes
+ * extrêmes ne sont recalculées que si l'alien touché se trouvait sur l'une d'elles,
+ * et le bas de sa colonne que s'il en était le tireur.
+ *
+ * @param reference Chemin de référence : caches recalculés en entier (formation_rescan).
+ */
+static void formation_kill(GameModel *model, int i, const bool reference)
+{
+    Formation *f = &model->sim.formation;
+    int col = i % FORMATION_COLS;
 
-        // Validation
-        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            model->sounds.play_select_sound = true;
+    model->sim.enemies.x[i] = model_get_enemy_x(model, i);
+    model->sim.enemies.y[i] = model_get_enemy_y(model, i);
 
-            if (model->menu_selection == 0)
-            {
-                model_scan_saves(model);
-                model->state = STATE_SAVE_SELECT;
-                model->menu_selection = 0;
-            }
-            else if (model->menu_selection == 1)
-            {
-                reset_game(model);
-            }
-            else if (model->menu_selection == 2)
-            {
-                exit(0);
-            }
-        }
-        return;
+    f->alive_mask &= ~(1ULL << i);
+    f->dying_mask |= 1ULL << i;
+    if (reference)
+        formation_rescan(f);
+    else
+    {
+        f->alive_count--;
+        if (col == f->min_col || col == f->max_col)
+            formation_update_span(f);
+        else if (f->bottom[col] == i)
+            formation_update_bottom(f, col);
     }
 
-    // ---------------------------------------------------------
-    // 7. SYSTÈME DE SAUVEGARDE (Select / Input / Confirm)
-    // ---------------------------------------------------------
+    formation_update_speed(model);
+}
 
-    // Étape A : Choix du Slot
-    if (model->state == STATE_SAVE_SELECT)
-    {
-        if (cmd == CMD_PAUSE || cmd == CMD_EXIT)
-        {
-            model->state = STATE_PAUSED;
-            return;
-        }
+/**
+ * @brief Trouve l'alien vivant touché par une balle, par calcul direct.
+ *
+ * La colonne et la rangée candidates se déduisent de la position relative
+ * à l'origine de la formation : une seule case à tester, puis un AABB exact.
+ * Une boîte balayée (plus haute que BULLET_HEIGHT) couvre plusieurs rangées,
+ * testées dans le sens du tir : le premier alien rencontré est touché.
+ *
+ * @param by, bh Haut et hauteur de la boîte de la balle (BULLET_HEIGHT, ou balayée).
+ * @param dy Vitesse verticale de la balle (sens du tir).
+ * @return L'index de l'alien touché, ou -1.
+ */
+static int formation_hit(const GameModel *model, float bx, float by, float bh, float dy)
+{
+    const Formation *f = &model->sim.formation;
+    float rx = bx - f->origin_x;
+    float ry = by - f->origin_y;
 
-        int max = model->save_file_count;
-        if (cmd == CMD_UP)
-            model->menu_selection = (model->menu_selection - 1 < 0) ? max : model->menu_selection - 1;
-        if (cmd == CMD_DOWN)
-            model->menu_selection = (model->menu_selection + 1 > max) ? 0 : model->menu_selection + 1;
+    // Seules cases dont la boîte peut chevaucher la balle (cf. #error en tête de fichier) :
+    // celle de la première position de la balle dans la boîte, puis celle de la dernière
+    int col = (int)floorf((rx + BULLET_WIDTH) / f->step_x);
+    int first = (int)floorf((ry + BULLET_HEIGHT) / f->step_y);
+    int last = (int)floorf((ry + bh) / f->step_y);
+    if (first < 0)
+        first = 0;
+    if (last > FORMATION_ROWS - 1)
+        last = FORMATION_ROWS - 1;
+    if (col < 0 || col >= FORMATION_COLS || first > last)
+        return -1;
 
-        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            model->sounds.play_select_sound = true;
-            if (model->menu_selection == 0)
-            {
-                model->state = STATE_SAVE_INPUT;
-                model->input_buffer[0] = '\0';
-            }
-            else
-            {
-                char *f = model->save_files[model->menu_selection - 1];
-                int len = strlen(f) - 4;
-                if (len > 0)
-                {
-                    strncpy(model->input_buffer, f, len);
-                    model->input_buffer[len] = '\0';
-                }
+    int step = dy < 0 ? -1 : 1;
+    for (int row = dy < 0 ? last : first; row >= first && row <= last; row += step)
+    {
+        int idx = row * FORMATION_COLS + col;
+        if (!(f->alive_mask & (1ULL << idx)))
+            continue;
+        if (aabb_overlap(rx, ry, BULLET_WIDTH, bh,
+                         col * f->step_x, row * f->step_y, ENEMY_WIDTH, ENEMY_HEIGHT))
+            return idx;
+    }
+    return -1;
+}
 
-                model->state = STATE_OVERWRITE_CONFIRM;
-                model->menu_selection = 0;
-            }
-        }
-        return;
+/**
+ * @brief Chemin de référence de formation_hit : un test par alien vivant, sans case calculée.
+ *
+ * Même boîte (coordonnées relatives à l'origine) et même règle : parmi les
+ * aliens que la balle chevauche, le premier rencontré dans le sens du tir ;
+ * à égalité, le plus petit index.
+ */
+static int formation_scan(const GameModel *model, float bx, float by, float bh, float dy)
+{
+    const Formation *f = &model->sim.formation;
+    float rx = bx - f->origin_x;
+    float ry = by - f->origin_y;
+    int best = -1;
+    for (int idx = 0; idx < FORMATION_SIZE; idx++)
+    {
+        int row = idx / FORMATION_COLS, col = idx % FORMATION_COLS;
+        if (!(f->alive_mask & (1ULL << idx)) ||
+            !aabb_overlap(rx, ry, BULLET_WIDTH, bh, col * f->step_x, row * f->step_y, ENEMY_WIDTH, ENEMY_HEIGHT))
+            continue;
+        if (best < 0 || (dy < 0 ? row > best / FORMATION_COLS : row < best / FORMATION_COLS))
+            best = idx;
     }
+    return best;
+}
 
-    // Étape B : Saisie du nom
-    if (model->state == STATE_SAVE_INPUT)
+/**
+ * @brief Indique si l'alien d'index i est vivant (actif et non explosé).
+ */
+static bool enemy_alive(const GameModel *model, int i)
+{
+    return i < FORMATION_SIZE && (model->sim.formation.alive_mask & (1ULL << i));
+}
+
+// ============================================================================
+//                          VAISSEAU AMIRAL
+// ============================================================================
+
+/**
+ * @brief Cases des pièces : deux rangées de BOSS_COLS, puis deux pièces de moins par rangée.
+ *
+ * Chaque rangée est centrée dans la coque, la dernière (incomplète) aussi :
+ * la coque reste symétrique autant que le nombre de pièces le permet. Ne
+ * dépend que de `parts`.
+ */
+static void boss_layout(Boss *b)
+{
+    int k = 0;
+    for (int row = 0; k < b->parts; row++)
     {
-        if (cmd == CMD_PAUSE)
+        int width = BOSS_COLS - 2 * (row > 0 ? row - 1 : 0);
+        if (width < 2)
+            width = 2;
+        int n = b->parts - k < width ? b->parts - k : width;
+        for (int c = 0; c < n; c++, k++)
         {
-            model->state = STATE_PAUSED;
-            return;
+            b->col[k] = (uint8_t)((BOSS_COLS - n) / 2 + c);
+            b->row[k] = (uint8_t)row;
         }
+    }
+    b->width = BOSS_COLS * BOSS_PART_WIDTH;
+}
 
-        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            if (strlen(model->input_buffer) > 0)
-            {
-                model->sounds.play_select_sound = true;
-                char filename[64];
-                snprintf(filename, 64, "%s.dat", model->input_buffer);
+/**
+ * @brief Boîte d'une pièce, relative au coin de la coque.
+ */
+static BvhBox boss_part_box(const Boss *b, int k)
+{
+    float x = (float)(b->col[k] * BOSS_PART_WIDTH), y = (float)(b->row[k] * BOSS_PART_HEIGHT);
+    return (BvhBox){x, y, x + BOSS_PART_WIDTH, y + BOSS_PART_HEIGHT};
+}
 
-                if (save_file_exists(filename))
-                {
-                    model->state = STATE_OVERWRITE_CONFIRM;
-                    model->menu_selection = 1;
-                }
-                else
-                {
-                    model_save_named(model, filename);
-                    model->state = STATE_SAVE_SUCCESS;
-                    model->save_success_timer = 2.0f;
-                }
-            }
-        }
-        if (cmd == CMD_BACKSPACE)
-        {
-            int l = strlen(model->input_buffer);
-            if (l > 0)
-                model->input_buffer[l - 1] = '\0';
-        }
+/**
+ * @brief Cases et BVH refaits depuis `parts` et `alive_mask` (vague neuve, sauvegarde relue).
+ *
+ * L'arbre est construit sur la coque intacte, puis les pièces détruites
+ * sont vidées : même arbre, aux mêmes boîtes, que celui tenu à jour en jeu.
+ */
+static void boss_rebuild(Boss *b)
+{
+    boss_layout(b);
+    BvhBox boxes[BOSS_MAX_PARTS];
+    for (int k = 0; k < b->parts; k++)
+        boxes[k] = boss_part_box(b, k);
+    bvh_build(&b->bvh, boxes, b->parts);
+    for (int k = 0; k < b->parts; k++)
+        if (!(b->alive_mask & (1ULL << k)))
+            bvh_set_leaf(&b->bvh, k, BVH_EMPTY);
+}
+
+/**
+ * @brief Met en jeu le vaisseau amiral de la vague (`parts` nul : aucun), centré en haut du terrain.
+ */
+static void boss_spawn(GameModel *model, int parts)
+{
+    Boss *b = &model->sim.boss;
+    memset(b, 0, sizeof(Boss));
+    if (parts <= 0)
         return;
+    b->parts = parts < BOSS_MAX_PARTS ? parts : BOSS_MAX_PARTS;
+    b->alive_mask = (1ULL << b->parts) - 1;
+    boss_rebuild(b);
+    for (int k = 0; k < b->parts; k++)
+        b->health[k] = (int8_t)(b->row[k] == 0 ? BOSS_BRIDGE_HEALTH : BOSS_PART_HEALTH);
+    b->active = true;
+    b->x = (GAME_WIDTH - b->width) / 2.0f;
+    b->y = BOSS_START_Y;
+    b->dx = BOSS_SPEED;
+}
+
+/**
+ * @brief Déplacement latéral, rebond sur les bords de la coque restante (racine du BVH).
+ */
+static void boss_move(GameModel *model, bool fixed, double dt)
+{
+    Boss *b = &model->sim.boss;
+    b->x = advance(fixed, b->x, b->dx, dt);
+    BvhBox hull = bvh_bounds(&b->bvh);
+    if ((b->x + hull.x0 <= 0 && b->dx < 0) || (b->x + hull.x1 >= GAME_WIDTH && b->dx > 0))
+        b->dx = -b->dx;
+}
+
+/**
+ * @brief Pièce touchée par une balle : requête dans le BVH, en coordonnées de la coque.
+ *
+ * Parmi les pièces que la boîte (balayée) chevauche, la première rencontrée
+ * dans le sens du tir ; à égalité, la plus petite.
+ *
+ * @param by, bh Haut et hauteur de la boîte de la balle (BULLET_HEIGHT, ou balayée).
+ * @param dy Vitesse verticale de la balle (sens du tir).
+ * @return La pièce touchée, ou -1.
+ */
+static int boss_hit(const GameModel *model, float bx, float by, float bh, float dy)
+{
+    const Boss *b = &model->sim.boss;
+    float rx = bx - b->x, ry = by - b->y;
+    int8_t found[BOSS_MAX_PARTS];
+    int n = bvh_query(&b->bvh, (BvhBox){rx, ry, rx + BULLET_WIDTH, ry + bh}, found, BOSS_MAX_PARTS);
+    int best = -1;
+    for (int j = 0; j < n; j++)
+    {
+        int k = found[j];
+        if (best < 0 || (dy < 0 ? b->row[k] > b->row[best] : b->row[k] < b->row[best]) ||
+            (b->row[k] == b->row[best] && k < best))
+            best = k;
     }
+    return best;
+}
 
-    // ---------------------------------------------------------
-    // 9. CONFIRMATION ÉCRASEMENT
-    // ---------------------------------------------------------
-    if (model->state == STATE_OVERWRITE_CONFIRM)
+/**
+ * @brief Chemin de référence de boss_hit : chaque pièce intacte testée, sans BVH.
+ */
+static int boss_scan(const GameModel *model, float bx, float by, float bh, float dy)
+{
+    const Boss *b = &model->sim.boss;
+    float rx = bx - b->x, ry = by - b->y;
+    BvhBox box = {rx, ry, rx + BULLET_WIDTH, ry + bh};
+    int best = -1;
+    for (int k = 0; k < b->parts; k++)
     {
-        // Navigation Gauche/Droite entre les 2 options
-        if (cmd == CMD_LEFT || cmd == CMD_RIGHT || cmd == CMD_UP || cmd == CMD_DOWN)
-        {
-            model->menu_selection = !model->menu_selection; // Bascule 0 <-> 1
-        }
+        if (!(b->alive_mask & (1ULL << k)) || !bvh_overlap(boss_part_box(b, k), box))
+            continue;
+        if (best < 0 || (dy < 0 ? b->row[k] > b->row[best] : b->row[k] < b->row[best]))
+            best = k;
+    }
+    return best;
+}
 
-        else if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
-        {
-            model->sounds.play_select_sound = true;
+/**
+ * @brief Un impact sur une pièce ; détruite, elle quitte le BVH et le vaisseau accélère.
+ *
+ * Seuls les ancêtres de sa feuille sont refaits (bvh_set_leaf). Le vaisseau
+ * quitte le jeu avec sa dernière pièce.
+ */
+static void boss_damage(GameModel *model, int k)
+{
+    Boss *b = &model->sim.boss;
+    model_touch(model, MODEL_GEN_FORMATION);
+    if (--b->health[k] > 0)
+        return;
 
-            if (model->menu_selection == 0)
-            {
-                char filename[64];
-                snprintf(filename, 64, "%s.dat", model->input_buffer);
+    float cx = b->x + b->col[k] * BOSS_PART_WIDTH + BOSS_PART_WIDTH / 2.0f;
+    b->alive_mask &= ~(1ULL << k);
+    bvh_set_leaf(&b->bvh, k, BVH_EMPTY);
+    model->sim.score += entity_types[ENTITY_BOSS_PART].points;
+    model_touch(model, MODEL_GEN_HUD);
+    emit_sound(model, AUDIO_INVADER_KILLED, cx);
+    emit_telemetry(model, TELEMETRY_KILL, ENTITY_BOSS_PART, cx, b->y + b->row[k] * BOSS_PART_HEIGHT);
+    if (!b->alive_mask)
+    {
+        b->active = false;
+        return;
+    }
+    int lost = b->parts - __builtin_popcountll(b->alive_mask);
+    b->dx = (b->dx < 0 ? -BOSS_SPEED : BOSS_SPEED) * (1.0f + (float)lost / (float)b->parts);
+}
 
-                model_save_named(model, filename);
-                model->state = STATE_SAVE_SUCCESS;
-                model->save_success_timer = 2.0f;
-            }
-            else
-            {
-                char new_name[128];
-                generate_unique_filename(model->input_buffer, new_name);
-                model_save_named(model, new_name);
+/**
+ * @brief Tireurs du vaisseau amiral : la pièce intacte la plus basse de chaque colonne.
+ *
+ * @param out Reçoit FORMATION_SIZE + pièce, par colonne croissante.
+ * @return Le nombre de tireurs écrits.
+ */
+static int boss_shooters(const Boss *b, int *out)
+{
+    int low[BOSS_COLS];
+    for (int c = 0; c < BOSS_COLS; c++)
+        low[c] = -1;
+    for (uint64_t m = b->alive_mask; m; m &= m - 1)
+    {
+        int k = __builtin_ctzll(m);
+        if (low[b->col[k]] < 0 || b->row[k] > b->row[low[b->col[k]]])
+            low[b->col[k]] = k;
+    }
+    int n = 0;
+    for (int c = 0; c < BOSS_COLS; c++)
+        if (low[c] >= 0)
+            out[n++] = FORMATION_SIZE + low[c];
+    return n;
+}
 
-                model->state = STATE_SAVE_SUCCESS;
-                model->save_success_timer = 2.0f;
-            }
-        }
-        else if (cmd == CMD_PAUSE)
+// ============================================================================
+//                          TIRS ENNEMIS
+// ============================================================================
+
+#define FIRE_LN2_Q16 45426 ///< ln 2 en Q16.16 (conversion de log2 en logarithme naturel).
+
+/**
+ * @brief log2(x) en Q16.16, pour 1 <= x <= 65536, en entiers seulement.
+ *
+ * Partie entière par la position du bit de poids fort, puis un bit de
+ * fraction par élévation au carré de la mantisse (Q1.30) : même résultat
+ * sur toute machine, en flottants comme en virgule fixe.
+ */
+static int32_t log2_q16(uint32_t x)
+{
+    int n = 31 - __builtin_clz(x);
+    int32_t result = n << MODEL_FIXED_SHIFT;
+    uint64_t m = (uint64_t)x << (30 - n); // Mantisse dans [1, 2)
+    for (int32_t bit = MODEL_FIXED_ONE >> 1; bit > 0; bit >>= 1)
+    {
+        m = (m * m) >> 30;
+        if (m >= (1ULL << 31))
         {
-            model->state = STATE_SAVE_INPUT;
+            m >>= 1;
+            result |= bit;
         }
+    }
+    return result;
+}
+
+/**
+ * @brief Délai jusqu'au prochain tir ennemi, tiré d'une loi exponentielle.
+ *
+ * Le taux moyen est celui de l'ancien tirage par tick : `fire_chance` % des
+ * ticks de TARGET_FPS, soit fire_chance * TARGET_FPS / 100 tirs par seconde,
+ * mis à l'échelle par `params.fire_percent` (exact à 100 %). Le délai,
+ * -ln(U) / taux, est calculé en Q16.16 (log2_q16).
+ *
+ * @param draw 16 bits aléatoires (U = (draw + 1) / 65536, dans ]0, 1]).
+ * @return Le délai en secondes (exact en Q16.16).
+ */
+static float fire_delay(const SimState *s, uint32_t draw)
+{
+    int64_t e = (16 << MODEL_FIXED_SHIFT) - log2_q16(draw + 1); // -log2(U), Q16.16
+    int64_t rate = (int64_t)s->formation.fire_chance * s->params.fire_percent;
+    int64_t q = e * FIRE_LN2_Q16 * 100 * 100 / (rate * TARGET_FPS << MODEL_FIXED_SHIFT);
+    return fixed_to((int32_t)q);
+}
+
+/**
+ * @brief Tir planifié d'un alien : l'alien vivant le plus bas d'une colonne tirée au sort.
+ *
+ * Un seul tirage sert au tireur (16 bits de poids faible) et au délai du tir
+ * suivant (16 bits de poids fort).
+ */
+static void enemy_fire(GameModel *model)
+{
+    Formation *f = &model->sim.formation;
+    uint32_t draw = model_rng_next(model);
+    model->sim.fire_timer += fire_delay(&model->sim, draw >> 16);
+
+    // Tireurs : le bas de chaque colonne encore occupée (tenu à jour par formation_kill),
+    // puis celui de chaque colonne du vaisseau amiral (FORMATION_SIZE + pièce)
+    int shooters[FORMATION_COLS + BOSS_COLS];
+    int n = 0;
+    for (int col = f->min_col; col >= 0 && col <= f->max_col; col++)
+        if (f->bottom[col] >= 0)
+            shooters[n++] = f->bottom[col];
+    if (model->sim.boss.active)
+        n += boss_shooters(&model->sim.boss, shooters + n);
+    if (n == 0)
+        return;
+
+    int idx = shooters[((draw & 0xFFFF) * (uint32_t)n) >> 16];
+    if (idx >= FORMATION_SIZE)
+    {
+        const Boss *b = &model->sim.boss;
+        int k = idx - FORMATION_SIZE;
+        spawn_bullet(model, b->x + b->col[k] * BOSS_PART_WIDTH + BOSS_PART_WIDTH / 2.0f,
+                     b->y + (b->row[k] + 1) * BOSS_PART_HEIGHT, model->sim.params.bullet_speed * 0.6f, ENTITY_BULLET_ENEMY);
         return;
     }
+    spawn_bullet(model, model_get_enemy_x(model, idx) + ENEMY_WIDTH / 2.0f, model_get_enemy_y(model, idx) + ENEMY_HEIGHT,
+                 model->sim.params.bullet_speed * 0.6f, ENTITY_BULLET_ENEMY);
+}
+/**
+ * @brief Recopie dans la formation les constantes de la vague du niveau.
+ *
+ * La forme et l'origine ne servent qu'au début du niveau ; espacement, courbe
+ * de vitesse et cadence de tir sont relus à chaque tick sans revenir à la table.
+ */
+static void formation_apply_wave(Formation *f, const WaveSpec *w, int level)
+{
+    f->step_x = w->step_x;
+    f->step_y = w->step_y;
+    f->size = w->size;
+    f->speed = w->speed;
+    f->speedup = w->speedup;
+    f->fire_chance = w->fire_base + w->fire_per_level * level;
+    f->intercept = w->intercept;
+    f->drop_chance = w->drop_chance;
+}
 
-    // ---------------------------------------------------------
-    // 8. CONFIRMATION QUITTER
-    // ---------------------------------------------------------
-    if (model->state == STATE_CONFIRM_QUIT)
+/**
+ * @brief Constantes de la vague du niveau courant.
+ *
+ * En vague sans fin, la grille n'est jamais reconstruite : l'espacement reste
+ * celui de la première vague, et la courbe de vitesse se mesure sur la grille
+ * pleine (le nombre d'aliens varie au gré des rangées entrées).
+ */
+static void formation_apply_level(GameModel *model)
+{
+    Formation *f = &model->sim.formation;
+    formation_apply_wave(f, wave_for_level(model->sim.level), model->sim.level);
+    if (model->sim.endless)
     {
-        if (cmd == CMD_UP)
-            model->menu_selection = (model->menu_selection - 1 < 0) ? 2 : model->menu_selection - 1;
-        if (cmd == CMD_DOWN)
-            model->menu_selection = (model->menu_selection + 1 > 2) ? 0 : model->menu_selection + 1;
+        f->step_x = wave_for_level(1)->step_x;
+        f->step_y = wave_for_level(1)->step_y;
+        f->size = FORMATION_SIZE;
+    }
+}
 
-        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+/**
+ * @brief Initialise la grille d'ennemis (Wave) pour un début de niveau.
+ *
+ * La vague est prise dans la table compilée (wave_for_level) : forme, types,
+ * origine et constantes de jeu. Réinitialise également la physique de groupe
+ * (vitesse, direction) et l'état de l'OVNI.
+ *
+ * @param model Le modèle contenant le tableau d'ennemis.
+ */
+static void init_enemies(GameModel *model)
+{
+    const WaveSpec *w = wave_for_level(model->sim.level);
+    Formation *f = &model->sim.formation;
+
+    // 1. Met à zéro tous les champs (timers d'explosion, positions figées).
+    // Indispensable pour éviter des bugs visuels au redémarrage.
+    model_clear_enemies(model);
+    formation_apply_level(model);
+
+    // 2. Cases occupées de la grille, dans l'ordre des index
+    for (int idx = 0; idx < FORMATION_SIZE; idx++)
+    {
+        if (!(w->mask & (1ULL << idx)))
+            continue;
+
+        // Position initiale (indicative : tant qu'il vit, l'alien suit la formation)
+        model->sim.enemies.x[idx] = w->origin_x + (idx % FORMATION_COLS) * w->step_x;
+        model->sim.enemies.y[idx] = w->origin_y + (idx / FORMATION_COLS) * w->step_y;
+        model->sim.enemies.type[idx] = (EntityType)w->types[idx];
+        active_list_add(&model->sim.enemies.live, idx);
+    }
+
+    // Réinitialisation de la logique de groupe (Vague)
+    f->origin_x = w->origin_x;
+    f->origin_y = w->origin_y;
+    f->alive_mask = w->mask;
+    f->dying_mask = 0;
+    f->alive_count = w->size;
+    formation_update_span(f);
+    f->path_ticks = -1; // Segment ouvert au premier tick de la vague
+    f->stream_lag = 0;
+    f->stream_rows = 0;
+    model->sim.enemy_speed_mult = w->speed;
+    if (model->sim.endless)
+        formation_update_speed(model); // Courbe mesurée sur la grille pleine
+    boss_spawn(model, w->boss);
+    model->sim.direction_enemies = 1; // Commence vers la Droite
+    model->sim.drop_direction = 1;
+    model->sim.drop_step_count = 0;
+
+    // Premier tir planifié de la vague
+    if (model->sim.fire_scheduled && f->fire_chance > 0 && model->sim.params.fire_percent > 0)
+        model->sim.fire_timer = fire_delay(&model->sim, model_rng_next(model) >> 16);
+
+    // L'OVNI est désactivé au début du niveau
+    model->sim.ufo.active = false;
+    model->sim.ufo.hasSpawnedThisLevel = false;
+    model->sim.ufo.y = 4; // Altitude de croisière fixe
+    model_touch_all(model); // Nouvelle vague : niveau, formation, boucliers
+}
+
+/**
+ * @brief Tire une rangée neuve de la vague sans fin : cases occupées et type.
+ *
+ * Chaque case est occupée avec une chance qui croît avec le niveau, et la
+ * rangée compte au moins un alien. Un seul type par rangée, comme la vague
+ * classique. Tirages dans le générateur de la simulation : une partie
+ * rejouée reçoit les mêmes rangées.
+ *
+ * @return Les cases occupées, en bits de la rangée 0.
+ */
+static uint64_t stream_row(GameModel *model, EntityType *type)
+{
+    uint32_t density = ENDLESS_DENSITY_BASE + ENDLESS_DENSITY_PER_LEVEL * (uint32_t)model->sim.level;
+    *type = (EntityType)(ENTITY_ENEMY_TYPE_1 + model_rng_below(model, 3));
+    uint64_t row = 0;
+    for (int col = 0; col < FORMATION_COLS; col++)
+        if (model_rng_below(model, 100) < density)
+            row |= 1ULL << col;
+    if (!row)
+        row = 1ULL << model_rng_below(model, FORMATION_COLS);
+    return row;
+}
+
+/**
+ * @brief Vague sans fin : descente des rangées entrées, puis recyclage de la rangée du bas.
+ *
+ * Quand la rangée du bas ne contient plus rien (ni alien vivant, ni
+ * explosion), les index de la grille glissent d'une rangée vers le bas et
+ * l'origine remonte d'autant : aucun alien ne bouge à l'écran. La rangée 0
+ * libérée reçoit une rangée neuve, au-dessus de la vague, qui descend ensuite
+ * avec toute la formation à ENDLESS_STREAM_SPEED (`stream_lag`). Les cases,
+ * la roue des explosions et les listes sont réutilisées sur place : rien
+ * n'est réinitialisé, rien n'est alloué. Une rangée au plus par tick.
+ */
+static void stream_wave(GameModel *model, bool fixed, double dt)
+{
+    Formation *f = &model->sim.formation;
+    EnemyPool *e = &model->sim.enemies;
+
+    // 1. Descente des rangées entrées, jusqu'à la hauteur d'avant leur arrivée
+    if (f->stream_lag > 0)
+    {
+        float lag = advance(fixed, f->stream_lag, -ENDLESS_STREAM_SPEED, dt);
+        if (lag < 0)
+            lag = 0;
+        f->origin_y += f->stream_lag - lag;
+        f->stream_lag = lag;
+    }
+
+    // 2. Rangée du bas vide : la grille glisse d'une rangée (index), l'origine remonte
+    const uint64_t bottom = ((1ULL << FORMATION_COLS) - 1) << (FORMATION_SIZE - FORMATION_COLS);
+    if ((f->alive_mask | f->dying_mask) & bottom)
+        return;
+    size_t moved = FORMATION_SIZE - FORMATION_COLS;
+    memmove(e->x + FORMATION_COLS, e->x, moved * sizeof(float));
+    memmove(e->y + FORMATION_COLS, e->y, moved * sizeof(float));
+    memmove(e->type + FORMATION_COLS, e->type, moved * sizeof(EntityType));
+    f->alive_mask <<= FORMATION_COLS;
+    f->dying_mask <<= FORMATION_COLS;
+    for (int k = 0; k < e->explosion_count; k++)
+        e->explosions[k].mask <<= FORMATION_COLS;
+    f->origin_y -= f->step_y;
+    f->stream_lag += f->step_y;
+
+    // 3. Rangée neuve en rangée 0
+    EntityType type;
+    uint64_t row = stream_row(model, &type);
+    for (int col = 0; col < FORMATION_COLS; col++)
+    {
+        e->type[col] = type;
+        e->x[col] = f->origin_x + col * f->step_x; // Indicatives, comme init_enemies
+        e->y[col] = f->origin_y;
+    }
+    f->alive_mask |= row;
+    f->alive_count += __builtin_popcountll(row);
+
+    // Liste active par index croissant (les index ont tous glissé), caches de la vague
+    e->live.count = 0;
+    for (uint64_t shown = f->alive_mask | f->dying_mask; shown; shown &= shown - 1)
+        active_list_add(&e->live, __builtin_ctzll(shown));
+    formation_update_span(f);
+    formation_update_speed(model);
+    model_touch(model, MODEL_GEN_FORMATION);
+
+    // 4. Niveau suivant, sans transition ni reconstruction (ni départ de niveau mémorisé)
+    if (++f->stream_rows < ENDLESS_ROWS_PER_LEVEL)
+        return;
+    f->stream_rows = 0;
+    model->sim.level++;
+    formation_apply_level(model);
+    formation_update_speed(model);
+    model->sim.ufo.hasSpawnedThisLevel = false;
+    model_touch(model, MODEL_GEN_HUD);
+    emit_sound(model, AUDIO_LEVEL_UP, GAME_WIDTH / 2.0f);
+    emit_telemetry(model, TELEMETRY_LEVEL_UP, 0, GAME_WIDTH / 2.0f, 0);
+}
+
+/**
+ * @brief Active l'apparition de l'OVNI bonus (Mystery Ship).
+ *
+ * Réinitialise l'entité UFO pour qu'elle soit "neuve" (non explosée)
+ * et détermine aléatoirement son côté d'entrée (Gauche ou Droite).
+ *
+ * @param model Le modèle de jeu.
+ */
+static void spawn_ufo(GameModel *model)
+{
+    // 1. NETTOYAGE : Réinitialise les flags d'explosion.
+    // Indispensable si l'OVNI précédent a été détruit (évite d'afficher une explosion dès le spawn).
+    model->sim.ufo.exploding = false;
+    model->sim.ufo.explode_timer = 0;
+
+    // 2. ACTIVATION
+    model->sim.ufo.active = true;
+    model->sim.ufo.hasSpawnedThisLevel = true; // Bloque le spawn multiple par niveau
+    model->sim.ufo.type = ENTITY_UFO;
+    model->sim.ufo.width = UFO_WIDTH;
+    model->sim.ufo.height = UFO_HEIGHT;
+    model->sim.ufo.y = 4; // Altitude fixe (Très haut dans le ciel)
+
+    // 3. DIRECTION ALÉATOIRE
+    if (model_rng_below(model, 2) == 0)
+    {
+        // Apparition à GAUCHE -> Va à DROITE
+        model->sim.ufo.x = -UFO_WIDTH;
+        model->sim.ufo.dx = model->sim.params.ufo_speed;
+    }
+    else
+    {
+        // Apparition à DROITE -> Va à GAUCHE
+        model->sim.ufo.x = GAME_WIDTH;
+        model->sim.ufo.dx = -model->sim.params.ufo_speed;
+    }
+    emit_telemetry(model, TELEMETRY_UFO_SPAWN, model->sim.ufo.dx > 0 ? 0 : 1, model->sim.ufo.x, model->sim.ufo.y);
+}
+/**
+ * @brief Bunker intact, ligne par ligne : coins supérieurs biseautés, arche en bas au centre.
+ */
+static const uint32_t shield_template[SHIELD_BITMAP_ROWS] = {
+    0x0FFFFFF0, 0x1FFFFFF8, 0x3FFFFFFC, 0x7FFFFFFE,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFF00FFF, 0xFFE007FF, 0xFFC003FF, 0xFFC003FF,
+    0xFFC003FF, 0xFFC003FF, 0xFFC003FF, 0xFFC003FF,
+};
+
+/**
+ * @brief Cratère d'un impact, ligne par ligne dans le sens du tir (bit 4 : colonne d'impact).
+ */
+static const uint8_t shield_crater[] = {0x7E, 0x3C, 0x5A, 0x24};
+
+/** @brief Colonnes [c0, c1] d'une ligne de bouclier (0 <= c0 <= c1 < SHIELD_BITMAP_COLS). */
+static uint32_t shield_span(int c0, int c1)
+{
+    uint32_t hi = (c1 >= SHIELD_BITMAP_COLS - 1) ? 0xFFFFFFFFu : (1u << (c1 + 1)) - 1;
+    return hi & ~((1u << c0) - 1);
+}
+
+/** @brief Cellules intactes de lignes de bouclier. */
+static int shield_count(const uint32_t *rows)
+{
+    int n = 0;
+    for (int r = 0; r < SHIELD_BITMAP_ROWS; r++)
+        n += __builtin_popcount(rows[r]);
+    return n;
+}
+
+/**
+ * @brief Creuse un cratère centré sur la colonne `col`, à partir de la ligne `row`.
+ *
+ * Puis recalcule `health` : la part de cellules restantes, arrondie par excès
+ * (un bunker n'est inactif qu'une fois vide).
+ *
+ * @param step Sens du tir (+1 : vers le bas, -1 : vers le haut).
+ */
+static void shield_carve(Shield *sh, int col, int row, int step)
+{
+    const int n = (int)(sizeof(shield_crater) / sizeof(shield_crater[0]));
+    for (int k = 0, r = row; k < n && r >= 0 && r < SHIELD_BITMAP_ROWS; k++, r += step)
+    {
+        int shift = col - 4;
+        uint64_t m = shift >= 0 ? (uint64_t)shield_crater[k] << shift : (uint64_t)shield_crater[k] >> -shift;
+        sh->bits[r] &= ~(uint32_t)m;
+    }
+
+    int full = shield_count(shield_template);
+    int left = shield_count(sh->bits);
+    sh->health = (left * SHIELD_MAX_HEALTH + full - 1) / full;
+    sh->active = left > 0;
+}
+
+/**
+ * @brief Impact d'un tir dont la hitbox chevauche la boîte d'un bouclier.
+ *
+ * Sans bitmap, le bunker perd un point de vie. En bitmap, la première ligne
+ * de cellules intactes rencontrée sous la hitbox, dans le sens du tir, reçoit
+ * le cratère : deux ET sur un mot par ligne, sur les 4 lignes de la hitbox
+ * (ou sur toutes celles de la boîte balayée).
+ *
+ * @param by, bh Haut et hauteur de la hitbox (BULLET_HEIGHT, ou balayée).
+ * @return true si le tir est arrêté (false : il passe par une brèche).
+ */
+static bool shield_impact(const GameModel *model, Shield *sh, float bx, float by, float bh, float dy)
+{
+    if (!model->sim.shield_bitmap)
+    {
+        sh->health--;
+        if (sh->health <= 0)
+            sh->active = false;
+        return true;
+    }
+
+    int c0 = (int)floorf((bx - sh->x) * SHIELD_BITMAP_SCALE);
+    int r0 = (int)floorf((by - sh->y) * SHIELD_BITMAP_SCALE);
+    int c1 = c0 + BULLET_WIDTH * SHIELD_BITMAP_SCALE - 1;
+    int r1 = r0 + (int)ceilf(bh * SHIELD_BITMAP_SCALE) - 1;
+    int center = (c0 + c1 + 1) / 2;
+    if (c0 < 0)
+        c0 = 0;
+    if (c1 > SHIELD_BITMAP_COLS - 1)
+        c1 = SHIELD_BITMAP_COLS - 1;
+    if (r0 < 0)
+        r0 = 0;
+    if (r1 > SHIELD_BITMAP_ROWS - 1)
+        r1 = SHIELD_BITMAP_ROWS - 1;
+    if (c0 > c1 || r0 > r1)
+        return false;
+
+    uint32_t cols = shield_span(c0, c1);
+    int step = dy < 0 ? -1 : 1;
+    int end = dy < 0 ? r0 - 1 : r1 + 1;
+    for (int r = dy < 0 ? r1 : r0; r != end; r += step)
+    {
+        if (sh->bits[r] & cols)
         {
-            model->sounds.play_select_sound = true;
-            if (model->menu_selection == 0)
-                exit(0);
-            else if (model->menu_selection == 1)
-            {
-                model->state = (model->previous_state == STATE_GAME_OVER) ? STATE_GAME_OVER : STATE_PAUSED;
-                model->menu_selection = 3;
-            }
-            else if (model->menu_selection == 2)
-            {
-                model_scan_saves(model);
-                model->state = STATE_SAVE_SELECT;
-                model->menu_selection = 0;
-            }
+            shield_carve(sh, center, r, step);
+            return true;
         }
-        return;
     }
+    return false;
+}
+
+// ============================================================================
+//                          3. INITIALISATION & RESET
+// ============================================================================
+
+/**
+ * @brief Initialise les boucliers de protection du joueur.
+ *
+ * Place les 4 boucliers de manière équidistante sur l'écran,
+ * juste au-dessus du vaisseau du joueur. Chaque bouclier a une santé
+ * initiale définie par SHIELD_MAX_HEALTH.
+ *
+ * @param model Le modèle de jeu contenant le tableau des boucliers.
+ */
+static void init_shields(GameModel *model)
+{
+    float shield_w = 8.0f;
+    float shield_h = 6.0f;
+    // Espacement dynamique pour centrer
+    float spacing = GAME_WIDTH / (MAX_SHIELDS + 1.0f);
+
+    for (int i = 0; i < MAX_SHIELDS; i++)
+    {
+        model->sim.shields[i].active = true;
+        model->sim.shields[i].health = SHIELD_MAX_HEALTH; // 10
+        model->sim.shields[i].width = shield_w;
+        model->sim.shields[i].height = shield_h;
+        model->sim.shields[i].x = (spacing * (i + 1)) - (shield_w / 2.0f);
+        model->sim.shields[i].y = GAME_HEIGHT - PLAYER_HEIGHT - 9;
+        memcpy(model->sim.shields[i].bits, shield_template, sizeof(shield_template));
+    }
+}
+
+/**
+ * @brief Initialise et alloue un nouveau modèle de jeu.
+ *
+ * Crée la structure GameModel avec tous ses composants initialisés :
+ * - État initial sur le menu principal
+ * - Joueur positionné au centre de l'écran
+ * - Grille d'ennemis créée
+ * - Boucliers mis en place
+ * - Volume audio à 30%
+ *
+ * Les tableaux des pools sont découpés dans l'arène qui suit la structure,
+ * à la capacité choisie par model_set_bullet_capacity.
+ *
+ * @return Pointeur vers le GameModel alloué, ou NULL en cas d'échec d'allocation.
+ * @note Le dossier "sauvegardes" est créé s'il n'existe pas.
+ */
+GameModel *model_init(void)
+{
+    // 1. Allocation + Mise à zéro automatique (workset_alloc, calloc hors zone) : la structure
+    // et l'arène des pools en un seul bloc. Plus besoin d'initialiser is_muted, dx, dy, timers...
+    size_t size = model_block_bytes();
+    GameModel *model = workset_alloc(size);
+    if (!model)
+        return NULL;
+    model->block_size = size;
+    model->sim.bullets.capacity = bullet_capacity;
+    model->sim.bullets.player_slots = player_slots_for(bullet_capacity);
+    model->sim.bullets.mask_words = BULLET_MASK_WORDS(bullet_capacity);
+    model_link_arena(model);
+
+    // 2. Création du dossier sauvegarde (Linux)
+    mkdir("sauvegardes", 0777);
+
+    // 3. Valeurs par défaut (Seulement ce qui n'est pas 0)
+    model->sim.state = STATE_MENU;
+    model->sim.lives = 3;
+    model->sim.normal_max_lives = MAX_LIVES_NORMAL;
+    model->sim.level = 1;
+    model->sim.fixed_point = fixed_point_default;
+    model->sim.shield_bitmap = shield_bitmap_default;
+    model->sim.swept_bullets = swept_bullets_default;
+    model->sim.endless = endless_default;
+    model->sim.fire_scheduled = true;
+    model->sim.exact_timers = true;
+    model->sim.formation_path = true;
+    model->sim.level_retry = true;
+    model->sim.tick_dt = 1.0 / TARGET_FPS;
+    params_default(&model->sim.params);
+    model->ui.volume = 30; // 30% volume
+    model_rng_seed(model, MODEL_RNG_DEFAULT_SEED);
+
+    // 4. Initialisation Joueur
+    model->sim.player.active = true;
+    model->sim.player.type = ENTITY_PLAYER;
+    model->sim.player.width = PLAYER_WIDTH;
+    model->sim.player.height = PLAYER_HEIGHT;
+    model->sim.player.x = (GAME_WIDTH - PLAYER_WIDTH) / 2.0f;
+    model->sim.player.y = GAME_HEIGHT - PLAYER_HEIGHT - 1;
+    model->sim.player2 = model->sim.player; // Même vaisseau, activé par model_set_coop
+    model->sim.player2.active = false;
+    if (coop_default)
+        model_set_coop(model, true); // Coopération locale : les deux vaisseaux dès le menu
+
+    // 5. Initialisation du Monde
+    bullet_pool_reset(&model->sim.bullets);
+    ecs_clear(&model->sim.ecs);
+    model->sim.rapid_timer = 0;
+    model->sim.spread_timer = 0;
+    init_enemies(model);
+    init_shields(model); // On utilise la fonction helper
+    model_touch_all(model);
+
+    return model;
+}
+
+/**
+ * @brief Replace les vaisseaux : au centre en solo, au tiers et aux deux tiers en coopération.
+ */
+static void place_ships(GameModel *model)
+{
+    SimState *s = &model->sim;
+    s->player.x = s->coop ? GAME_WIDTH / 3.0f - PLAYER_WIDTH / 2.0f : (GAME_WIDTH - PLAYER_WIDTH) / 2.0f;
+    s->player.dx = 0;
+    s->player2.x = 2.0f * GAME_WIDTH / 3.0f - PLAYER_WIDTH / 2.0f;
+    s->player2.dx = 0;
+    s->player2.shoot_timer = 0;
+    s->player2.active = s->coop;
+}
+
+/**
+ * @brief Mémorise le départ du niveau courant (fin du tick qui l'a lancé) dans l'anneau.
+ *
+ * Un départ du même niveau que le plus récent le remplace : un rollback qui
+ * rejoue le début de niveau n'empile pas deux fois le même. Un état trop gros
+ * (pool de balles plein) n'est pas mémorisé.
+ */
+static void level_start_capture(GameModel *model)
+{
+    if (!model->sim.level_retry)
+        return;
+    UiState *ui = &model->ui;
+    int last = (ui->level_start_head + MODEL_LEVEL_STARTS - 1) % MODEL_LEVEL_STARTS;
+    bool same = ui->level_starts[last].len > 0 && ui->level_starts[last].level == model->sim.level;
+    int slot = same ? last : ui->level_start_head;
+    LevelStart *ls = &ui->level_starts[slot];
+    ls->len = (uint16_t)save_encode_level_start(model, ls->data, sizeof(ls->data));
+    ls->level = model->sim.level;
+    if (ls->len > 0 && !same)
+        ui->level_start_head = (slot + 1) % MODEL_LEVEL_STARTS;
+}
+
+/**
+ * @brief Départ le plus récent au niveau courant ou avant (un rollback a pu défaire un niveau), ou NULL.
+ */
+static const LevelStart *level_start_latest(const GameModel *model)
+{
+    const UiState *ui = &model->ui;
+    for (int k = 1; k <= MODEL_LEVEL_STARTS; k++)
+    {
+        const LevelStart *ls = &ui->level_starts[(ui->level_start_head + MODEL_LEVEL_STARTS - k) % MODEL_LEVEL_STARTS];
+        if (ls->len > 0 && ls->level <= model->sim.level)
+            return ls;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Oublie les départs de niveau (nouvelle partie, chargement, retour à l'accueil).
+ */
+static void level_start_clear(GameModel *model)
+{
+    memset(model->ui.level_starts, 0, sizeof(model->ui.level_starts));
+    model->ui.level_start_head = 0;
+}
+
+/**
+ * @brief Réinitialise complètement une partie de jeu.
+ *
+ * Remet à zéro tous les éléments du jeu pour commencer une nouvelle partie :
+ * - Score remis à 0
+ * - Vies remises à 3
+ * - Niveau remis à 1
+ * - Joueur repositionné au centre
+ * - Ennemis et boucliers recréés
+ * - Toutes les balles supprimées
+ *
+ * @param model Le modèle de jeu à réinitialiser.
+ */
+static void reset_game(GameModel *model)
+{
+    // 1. Reset Stats
+    model->sim.score = 0;
+    model->sim.lives = 3;
+    model->sim.level = 1;
+    model->sim.hit_timer = 0;
+
+    // 2. Reset Difficulté
+    model->sim.enemy_speed_mult = 1.0f;
+    model->sim.direction_enemies = 1;
+    model->sim.drop_direction = 1;
+    model->sim.drop_step_count = 0;
+
+    // 3. Nettoyage des balles (pool vidé, pile des slots libres reconstruite) et du registre
+    bullet_pool_reset(&model->sim.bullets);
+    ecs_clear(&model->sim.ecs);
+
+    // 4. Reset Entités
+    model->sim.ufo.active = false;
+    model->sim.ufo.hasSpawnedThisLevel = false;
+
+    // Replacer le joueur au centre (les deux vaisseaux en coopération)
+    place_ships(model);
+
+    // 5. Recréation du niveau
+    init_enemies(model);
+    init_shields(model); // Plus de duplication de code ici !
+
+    // 6. Lancement
+    model->sim.state = STATE_PLAYING;
+    model_touch_all(model);
+    emit_telemetry(model, TELEMETRY_GAME_START, 0, GAME_WIDTH / 2.0f, 0);
+    level_start_clear(model);
+    level_start_capture(model);
+}
+
+/**
+ * @brief Choisit la capacité du pool de balles des prochains model_init.
+ */
+bool model_set_bullet_capacity(int capacity)
+{
+    if (capacity < 2 || capacity > MODEL_MAX_BULLET_CAPACITY)
+        return false;
+    bullet_capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Choisit la part du joueur des prochains model_init (0 : part par défaut).
+ */
+bool model_set_player_bullets(int slots)
+{
+    if (slots < 0 || slots >= MODEL_MAX_BULLET_CAPACITY)
+        return false;
+    player_bullets = slots;
+    return true;
+}
+
+/**
+ * @brief Structure et arène à la capacité courante (celle des prochains model_init).
+ */
+size_t model_block_bytes(void)
+{
+    return arena_offset() + arena_layout(NULL, bullet_capacity, NULL, NULL);
+}
+
+/**
+ * @brief Choisit la physique (flottants ou virgule fixe) des prochains model_init.
+ */
+void model_set_fixed_point(bool on)
+{
+    fixed_point_default = on;
+}
+
+/**
+ * @brief Choisit les boucliers (boîte ou bitmap) des prochains model_init.
+ */
+void model_set_shield_bitmap(bool on)
+{
+    shield_bitmap_default = on;
+}
+
+/**
+ * @brief Choisit les collisions des balles (position de fin ou balayées) des prochains model_init.
+ */
+void model_set_swept_bullets(bool on)
+{
+    swept_bullets_default = on;
+}
+
+/**
+ * @brief Choisit la vague (une par niveau ou sans fin) des prochains model_init.
+ */
+void model_set_endless(bool on)
+{
+    endless_default = on;
+}
+
+/**
+ * @brief Choisit la coopération locale (deux vaisseaux sur une machine) des prochains model_init.
+ */
+void model_set_local_coop(bool on)
+{
+    coop_default = on;
+}
+
+/**
+ * @brief Cellules intactes d'un bouclier sous un rectangle logique (mode bitmap).
+ */
+int model_shield_cells(const Shield *shield, float x, float y, float w, float h)
+{
+    int c0 = (int)floorf((x - shield->x) * SHIELD_BITMAP_SCALE);
+    int c1 = (int)ceilf((x + w - shield->x) * SHIELD_BITMAP_SCALE) - 1;
+    int r0 = (int)floorf((y - shield->y) * SHIELD_BITMAP_SCALE);
+    int r1 = (int)ceilf((y + h - shield->y) * SHIELD_BITMAP_SCALE) - 1;
+    if (c0 < 0)
+        c0 = 0;
+    if (c1 > SHIELD_BITMAP_COLS - 1)
+        c1 = SHIELD_BITMAP_COLS - 1;
+    if (r0 < 0)
+        r0 = 0;
+    if (r1 > SHIELD_BITMAP_ROWS - 1)
+        r1 = SHIELD_BITMAP_ROWS - 1;
+    if (c0 > c1 || r0 > r1)
+        return 0;
+
+    uint32_t cols = shield_span(c0, c1);
+    int n = 0;
+    for (int r = r0; r <= r1; r++)
+        n += __builtin_popcount(shield->bits[r] & cols);
+    return n;
+}
+
+/**
+ * @brief Passe un modèle en coopération à deux vaisseaux (ou le ramène en solo).
+ */
+void model_set_coop(GameModel *model, bool coop)
+{
+    model->sim.coop = coop;
+    place_ships(model);
+    model_touch_all(model);
+}
+
+/**
+ * @brief Alloue une copie complète d'un modèle.
+ */
+GameModel *model_clone(const GameModel *model)
+{
+    GameModel *copy = workset_alloc(model->block_size);
+    if (copy)
+        model_copy(copy, model);
+    return copy;
+}
+
+/**
+ * @brief Recopie un modèle entier (structure et arène), puis recâble les pools.
+ */
+void model_copy(GameModel *dst, const GameModel *src)
+{
+    memcpy(dst, src, src->block_size);
+    model_link_arena(dst);
+}
+
+/**
+ * @brief Recopie l'état simulé et l'arène, puis recâble les pools.
+ */
+void model_copy_sim(GameModel *dst, const GameModel *src)
+{
+    memcpy(&dst->sim, &src->sim, sizeof(SimState));
+    model_link_arena(dst);
+    memcpy((uint8_t *)dst + arena_offset(), (const uint8_t *)src + arena_offset(), src->block_size - arena_offset());
+    model_touch_all(dst);
+}
+
+/**
+ * @brief Efface la partie et revient au menu principal, les allocations et la Vue restant en place.
+ */
+void model_restart(GameModel *model)
+{
+    SimState *s = &model->sim;
+    bullet_pool_reset(&s->bullets);
+    ecs_clear(&s->ecs);
+    memset(&s->transition, 0, sizeof(s->transition));
+    s->score = 0;
+    s->lives = 3;
+    s->level = 1;
+    s->hit_timer = 0;
+    s->game_over_timer = 0;
+    s->rapid_timer = 0;
+    s->spread_timer = 0;
+    s->ufo.active = false;
+    s->state = STATE_MENU;
+    s->previous_state = STATE_MENU;
+    level_start_clear(model);
+    model->ui.menu_selection = 0;
+    model->ui.input_buffer[0] = '\0';
+    model->ui.pending_quit = false;
+    model_touch_all(model);
+}
+
+/**
+ * @brief Libère la mémoire allouée pour le modèle de jeu.
+ *
+ * @param model Le modèle de jeu à libérer (peut être NULL).
+ */
+void model_free(GameModel *model)
+{
+    workset_free(model);
+}
+
+// ============================================================================
+//                          5. GESTION DES ENTRÉES (CONTROLLER -> MODEL)
+// ============================================================================
+
+/**
+ * @brief Applique des touches maintenues à un vaisseau (gauche et droite ensemble s'annulent).
+ *
+ * @return true si le tir est maintenu.
+ */
+static bool ship_held(Entity *ship, float speed, unsigned held)
+{
+    int dir = ((held & INPUT_RIGHT) ? 1 : 0) - ((held & INPUT_LEFT) ? 1 : 0);
+    ship->dx = dir * speed;
+    return (held & INPUT_FIRE) != 0;
+}
+
+/**
+ * @brief Tire depuis un vaisseau si son arme est rechargée.
+ */
+static void ship_fire(GameModel *model, Entity *ship)
+{
+    if (ship->shoot_timer > 0.0f)
+        return;
+    // Tir centré par rapport au joueur, flanqué de deux autres sous tir triple
+    spawn_bullet(model, ship->x + 1.5f, ship->y - 1, -model->sim.params.bullet_speed, ENTITY_BULLET_PLAYER);
+    if (model->sim.spread_timer > 0)
+    {
+        spawn_bullet(model, ship->x + 1.5f - POWERUP_SPREAD_OFFSET, ship->y - 1, -model->sim.params.bullet_speed, ENTITY_BULLET_PLAYER);
+        spawn_bullet(model, ship->x + 1.5f + POWERUP_SPREAD_OFFSET, ship->y - 1, -model->sim.params.bullet_speed, ENTITY_BULLET_PLAYER);
+    }
+    ship->shoot_timer = duration_ticks(&model->sim, model->sim.rapid_timer > 0 ? POWERUP_RAPID_RELOAD : 0.5f,
+                                       model->sim.tick_dt, TICKS_DOWN);
+    emit_sound(model, AUDIO_SHOOT, ship->x + PLAYER_WIDTH / 2.0f);
+    emit_telemetry(model, TELEMETRY_SHOT, model->sim.spread_timer > 0 ? 3 : 1, ship->x + PLAYER_WIDTH / 2.0f,
+                   ship->y);
+}
+
+/**
+ * @brief Applique à un vaisseau une commande de jeu du joueur 1 (déplacement, tir).
+ */
+bool model_ship_command(const GameModel *model, Entity *ship, GameCommand cmd)
+{
+    unsigned held;
+    if (command_is_held(cmd, &held))
+        return ship_held(ship, model->sim.params.player_speed, held);
+    if (cmd == CMD_MOVE_LEFT || cmd == CMD_LEFT)
+        ship->dx = -model->sim.params.player_speed;
+    else if (cmd == CMD_MOVE_RIGHT || cmd == CMD_RIGHT)
+        ship->dx = model->sim.params.player_speed;
+    else if (cmd == CMD_NONE)
+        ship->dx = 0;
+    return cmd == CMD_SHOOT;
+}
+
+/**
+ * @brief Déplacement d'un vaisseau pendant un tick, borné à l'aire de jeu (en ligne dans les chemins spécialisés).
+ */
+static inline void ship_step(Entity *ship, bool fixed, double dt)
+{
+    ship->x = advance(fixed, ship->x, ship->dx, dt);
+    if (ship->x < 0)
+        ship->x = 0;
+    if (ship->x > GAME_WIDTH - PLAYER_WIDTH)
+        ship->x = GAME_WIDTH - PLAYER_WIDTH;
+}
+
+/**
+ * @brief Déplacement d'un vaisseau pendant un tick (section C de model_update).
+ */
+void model_step_ship(Entity *ship, bool fixed, double dt)
+{
+    ship_step(ship, fixed, dt);
+}
+
+/**
+ * @brief Horloge des générations, commune à tous les modèles (jamais 0 après un model_touch).
+ */
+static uint64_t gen_clock = 0;
+
+/**
+ * @brief Une nouvelle valeur pour le domaine et pour MODEL_GEN_ANY.
+ */
+void model_touch(GameModel *model, ModelGen domain)
+{
+    uint64_t stamp = __atomic_add_fetch(&gen_clock, 1, __ATOMIC_RELAXED);
+    model->ui.gen[domain] = stamp;
+    model->ui.gen[MODEL_GEN_ANY] = stamp;
+}
+
+/**
+ * @brief Une même nouvelle valeur pour tous les domaines.
+ */
+void model_touch_all(GameModel *model)
+{
+    uint64_t stamp = __atomic_add_fetch(&gen_clock, 1, __ATOMIC_RELAXED);
+    for (int d = 0; d < MODEL_GEN_COUNT; d++)
+        model->ui.gen[d] = stamp;
+}
+
+// ============================================================================
+//                          TRANSITIONS
+// ============================================================================
+
+/**
+ * @brief Destination d'une transition (Timeline::tag).
+ */
+enum
+{
+    TRANSITION_TO_MENU, ///< Menu principal, prêt pour une nouvelle partie.
+    TRANSITION_QUIT     ///< Fermeture, confiée à la boucle de l'appelant (pending_quit).
+};
+
+#define TRANSITION_FADE 0.5f      ///< Durée d'un fondu vers ou depuis le noir (secondes).
+#define TRANSITION_QUIT_FADE 0.75f ///< Fondu de sortie du jeu, depuis le Game Over (secondes).
+
+/** @brief Ticks d'une étape, au pas courant. */
+static uint16_t transition_ticks(const SimState *s, float seconds)
+{
+    int n = duration_ticks(s, seconds, tick_seconds(s), TICKS_DOWN);
+    return (uint16_t)(n < UINT16_MAX ? n : UINT16_MAX);
+}
+
+/**
+ * @brief Tient l'écran courant `hold` secondes, le fond au noir, puis rejoint `tag`.
+ *
+ * Vers le menu, l'image revient du noir ; vers la sortie, le noir tient
+ * jusqu'à ce que la boucle de l'appelant s'arrête.
+ */
+static void start_transition(GameModel *model, float hold, float fade, uint8_t tag)
+{
+    SimState *s = &model->sim;
+    uint16_t out = transition_ticks(s, fade);
+    TimelineStep steps[] = {{TIMELINE_HOLD, transition_ticks(s, hold)},
+                            {TIMELINE_FADE_OUT, out},
+                            {TIMELINE_SWITCH, 0},
+                            {tag == TRANSITION_QUIT ? TIMELINE_HOLD : TIMELINE_FADE_IN, tag == TRANSITION_QUIT ? 1 : out}};
+    timeline_start(&s->transition, steps, 4, tag);
+    model_touch(model, MODEL_GEN_ANY);
+}
+
+/**
+ * @brief Avance la transition d'un tick et applique sa bascule.
+ */
+static void advance_transition(GameModel *model)
+{
+    Timeline *t = &model->sim.transition;
+    if (timeline_tick(t) == TIMELINE_SWITCH)
+    {
+        if (t->tag == TRANSITION_QUIT)
+            model->ui.pending_quit = true;
+        else
+        {
+            model->sim.state = STATE_MENU;
+            model->ui.menu_selection = 0;
+        }
+        model_touch(model, MODEL_GEN_MENU);
+    }
+    model_touch(model, MODEL_GEN_ANY); // Le fondu change à chaque tick
+}
+
+/**
+ * @brief Gère les entrées utilisateur en fonction de l'état actuel du jeu.
+ *
+ * Dispatche les commandes vers la logique appropriée selon l'état du jeu :
+ * - STATE_MENU : Navigation et sélection dans le menu principal
+ * - STATE_LOAD_MENU : Sélection d'une sauvegarde à charger
+ * - STATE_TUTORIAL : Affichage du tutoriel
+ * - STATE_PLAYING : Contrôle du vaisseau et tir
+ * - STATE_PAUSED : Menu pause avec options
+ * - STATE_GAME_OVER : Écran de fin de partie
+ * - STATE_SAVE_* : Gestion des sauvegardes
+ * - STATE_CONFIRM_QUIT : Confirmation avant de quitter
+ *
+ * @param model Le modèle de jeu à mettre à jour.
+ * @param cmd La commande reçue du contrôleur (GameCommand).
+ */
+static void handle_input(GameModel *model, GameCommand cmd)
+{
+    // ---------------------------------------------------------
+    // 0. TRANSITION EN COURS : l'écran est sur le départ
+    // ---------------------------------------------------------
+    if (timeline_before_switch(&model->sim.transition))
+    {
+        // Valider abrège l'attente et le fondu ; le reste est ignoré
+        if (cmd == CMD_RETURN || cmd == CMD_SHOOT || cmd == CMD_EXIT)
+            timeline_skip(&model->sim.transition);
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 1. MENU PRINCIPAL
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_MENU)
+    {
+        if (cmd == CMD_EXIT)
+        {
+            model->ui.pending_quit = true;
+            return;
+        }
+
+        // Navigation (0 à 4)
+        if (cmd == CMD_UP)
+            model->ui.menu_selection = (model->ui.menu_selection - 1 < 0) ? 4 : model->ui.menu_selection - 1;
+        if (cmd == CMD_DOWN)
+            model->ui.menu_selection = (model->ui.menu_selection + 1 > 4) ? 0 : model->ui.menu_selection + 1;
+
+        // Gestion Volume (Option 3)
+        if (model->ui.menu_selection == 3)
+        {
+            if (cmd == CMD_LEFT || cmd == CMD_MOVE_LEFT)
+            {
+                model->ui.volume = (model->ui.volume - 10 < 0) ? 0 : model->ui.volume - 10;
+                model->ui.is_muted = false;
+            }
+            if (cmd == CMD_RIGHT || cmd == CMD_MOVE_RIGHT)
+            {
+                model->ui.volume = (model->ui.volume + 10 > 100) ? 100 : model->ui.volume + 10;
+                model->ui.is_muted = false;
+            }
+            if (cmd == CMD_SHOOT || cmd == CMD_RETURN)
+                model->ui.is_muted = !model->ui.is_muted;
+        }
+        // Validation
+        else if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+
+            if (model->ui.menu_selection == 0)
+                reset_game(model);
+            else if (model->ui.menu_selection == 1)
+                model->sim.state = STATE_TUTORIAL;
+            else if (model->ui.menu_selection == 2)
+            {
+                model_scan_saves(model);
+                list_autosave(model);
+                if (model->ui.save_file_count > 0 || model->ui.save_scan_pending)
+                {
+                    model->sim.state = STATE_LOAD_MENU;
+                    model->ui.menu_selection = 0;
+                }
+                else
+                {
+                    model->sim.state = STATE_LOAD_MENU;
+                }
+            }
+            else if (model->ui.menu_selection == 4)
+                model->ui.pending_quit = true;
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 2. MENU CHARGEMENT
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_LOAD_MENU)
+    {
+        if (cmd == CMD_EXIT || cmd == CMD_PAUSE)
+        {
+            model->sim.state = STATE_MENU;
+            model->ui.menu_selection = 2;
+            return;
+        }
+
+        if (cmd == CMD_UP)
+            model->ui.menu_selection = (model->ui.menu_selection - 1 < 0) ? model->ui.save_file_count - 1 : model->ui.menu_selection - 1;
+        if (cmd == CMD_DOWN)
+            model->ui.menu_selection = (model->ui.menu_selection + 1 >= model->ui.save_file_count) ? 0 : model->ui.menu_selection + 1;
+
+        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            if (model->ui.save_file_count > 0)
+            {
+                emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+                if (model_load_named(model, model->ui.save_files[model->ui.menu_selection].name))
+                    emit_telemetry(model, TELEMETRY_GAME_START, 1, GAME_WIDTH / 2.0f, 0);
+            }
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 3. TUTORIEL
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_TUTORIAL)
+    {
+        if (cmd == CMD_EXIT || cmd == CMD_PAUSE || cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+            model->sim.state = STATE_MENU;
+            model->ui.menu_selection = 1;
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 4. JEU (PLAYING)
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_PLAYING)
+    {
+        if (cmd == CMD_PAUSE)
+        {
+            model->sim.state = STATE_PAUSED;
+            model->ui.menu_selection = 0;
+            return;
+        }
+
+        unsigned held;
+        if (command_is_held_p2(cmd, &held))
+        {
+            if (model->sim.player2.active && ship_held(&model->sim.player2, model->sim.params.player_speed, held))
+                ship_fire(model, &model->sim.player2);
+            return;
+        }
+
+        if (model_ship_command(model, &model->sim.player, cmd))
+            ship_fire(model, &model->sim.player);
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 5. PAUSE
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_PAUSED)
+    {
+        if (cmd == CMD_PAUSE)
+        {
+            model->sim.state = STATE_PLAYING;
+            return;
+        }
+
+        if (cmd == CMD_UP)
+            model->ui.menu_selection = (model->ui.menu_selection - 1 < 0) ? 3 : model->ui.menu_selection - 1;
+        if (cmd == CMD_DOWN)
+            model->ui.menu_selection = (model->ui.menu_selection + 1 > 3) ? 0 : model->ui.menu_selection + 1;
+
+        // Volume (Index 1)
+        if (model->ui.menu_selection == 1)
+        {
+            if (cmd == CMD_LEFT)
+            {
+                model->ui.volume = (model->ui.volume < 10) ? 0 : model->ui.volume - 10;
+                model->ui.is_muted = false;
+            }
+            if (cmd == CMD_RIGHT)
+            {
+                model->ui.volume = (model->ui.volume > 90) ? 100 : model->ui.volume + 10;
+                model->ui.is_muted = false;
+            }
+            if (cmd == CMD_SHOOT || cmd == CMD_RETURN)
+                model->ui.is_muted = !model->ui.is_muted;
+        }
+        else if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+            if (model->ui.menu_selection == 0)
+                model->sim.state = STATE_PLAYING;
+            else if (model->ui.menu_selection == 2)
+            {
+                model_scan_saves(model);
+                model->sim.state = STATE_SAVE_SELECT;
+                model->ui.menu_selection = 0;
+            }
+            else if (model->ui.menu_selection == 3)
+            {
+                model->sim.previous_state = STATE_PAUSED;
+                model->sim.state = STATE_CONFIRM_QUIT;
+                model->ui.menu_selection = 1;
+            }
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 6. GAME OVER
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        GameOverOption options[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, options);
+        int max = count - 1;
+
+        // Navigation
+        if (cmd == CMD_UP)
+            model->ui.menu_selection = (model->ui.menu_selection - 1 < 0) ? max : model->ui.menu_selection - 1;
+
+        if (cmd == CMD_DOWN)
+            model->ui.menu_selection = (model->ui.menu_selection + 1 > max) ? 0 : model->ui.menu_selection + 1;
+
+        // Validation
+        if ((cmd == CMD_RETURN || cmd == CMD_SHOOT) && model->ui.menu_selection >= 0 && model->ui.menu_selection <= max)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+
+            switch (options[model->ui.menu_selection])
+            {
+            case GAME_OVER_RETRY:
+            {
+                // Restauration en place, depuis l'anneau (les départs eux-mêmes ne bougent pas)
+                const LevelStart *ls = level_start_latest(model);
+                if (ls && save_decode_snapshot(model, ls->data, ls->len))
+                {
+                    model_touch_all(model);
+                    emit_telemetry(model, TELEMETRY_GAME_START, 2, GAME_WIDTH / 2.0f, 0);
+                }
+                break;
+            }
+            case GAME_OVER_SAVE:
+                model_scan_saves(model);
+                model->sim.state = STATE_SAVE_SELECT;
+                model->ui.menu_selection = 0;
+                break;
+            case GAME_OVER_REPLAY:
+                reset_game(model);
+                break;
+            case GAME_OVER_QUIT:
+            default:
+                start_transition(model, 0.0f, TRANSITION_QUIT_FADE, TRANSITION_QUIT);
+                break;
+            }
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 7. SYSTÈME DE SAUVEGARDE (Select / Input / Confirm)
+    // ---------------------------------------------------------
+
+    // Étape A : Choix du Slot
+    if (model->sim.state == STATE_SAVE_SELECT)
+    {
+        if (cmd == CMD_PAUSE || cmd == CMD_EXIT)
+        {
+            model->sim.state = STATE_PAUSED;
+            return;
+        }
+
+        int max = model->ui.save_file_count;
+        if (cmd == CMD_UP)
+            model->ui.menu_selection = (model->ui.menu_selection - 1 < 0) ? max : model->ui.menu_selection - 1;
+        if (cmd == CMD_DOWN)
+            model->ui.menu_selection = (model->ui.menu_selection + 1 > max) ? 0 : model->ui.menu_selection + 1;
+
+        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+            if (model->ui.menu_selection == 0)
+            {
+                model->sim.state = STATE_SAVE_INPUT;
+                model->ui.input_buffer[0] = '\0';
+            }
+            else
+            {
+                const char *f = model->ui.save_files[model->ui.menu_selection - 1].name;
+                int len = strlen(f) - 4;
+                if (len > 0)
+                {
+                    strncpy(model->ui.input_buffer, f, len);
+                    model->ui.input_buffer[len] = '\0';
+                }
+
+                model->sim.state = STATE_OVERWRITE_CONFIRM;
+                model->ui.menu_selection = 0;
+            }
+        }
+        return;
+    }
+
+    // Étape B : Saisie du nom
+    if (model->sim.state == STATE_SAVE_INPUT)
+    {
+        if (cmd == CMD_PAUSE)
+        {
+            model->sim.state = STATE_PAUSED;
+            return;
+        }
+
+        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            if (strlen(model->ui.input_buffer) > 0)
+            {
+                emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+                char filename[64];
+                snprintf(filename, 64, "%s.dat", model->ui.input_buffer);
+
+                if (save_file_exists(filename))
+                {
+                    model->sim.state = STATE_OVERWRITE_CONFIRM;
+                    model->ui.menu_selection = 1;
+                }
+                else
+                {
+                    begin_save(model, filename);
+                }
+            }
+        }
+        if (cmd == CMD_BACKSPACE)
+        {
+            int l = strlen(model->ui.input_buffer);
+            if (l > 0)
+                model->ui.input_buffer[l - 1] = '\0';
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 9. CONFIRMATION ÉCRASEMENT
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_OVERWRITE_CONFIRM)
+    {
+        // Navigation Gauche/Droite entre les 2 options
+        if (cmd == CMD_LEFT || cmd == CMD_RIGHT || cmd == CMD_UP || cmd == CMD_DOWN)
+        {
+            model->ui.menu_selection = !model->ui.menu_selection; // Bascule 0 <-> 1
+        }
+
+        else if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+
+            if (model->ui.menu_selection == 0)
+            {
+                char filename[64];
+                snprintf(filename, 64, "%s.dat", model->ui.input_buffer);
+
+                begin_save(model, filename);
+            }
+            else
+            {
+                char new_name[SAVE_NAME_LEN];
+                if (save_index_copy_name("sauvegardes", model->ui.input_buffer, new_name, sizeof(new_name)))
+                    begin_save(model, new_name);
+            }
+        }
+        else if (cmd == CMD_PAUSE)
+        {
+            model->sim.state = STATE_SAVE_INPUT;
+        }
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // 8. CONFIRMATION QUITTER
+    // ---------------------------------------------------------
+    if (model->sim.state == STATE_CONFIRM_QUIT)
+    {
+        if (cmd == CMD_UP)
+            model->ui.menu_selection = (model->ui.menu_selection - 1 < 0) ? 2 : model->ui.menu_selection - 1;
+        if (cmd == CMD_DOWN)
+            model->ui.menu_selection = (model->ui.menu_selection + 1 > 2) ? 0 : model->ui.menu_selection + 1;
+
+        if (cmd == CMD_RETURN || cmd == CMD_SHOOT)
+        {
+            emit_sound(model, AUDIO_SELECT, GAME_WIDTH / 2.0f);
+            if (model->ui.menu_selection == 0)
+                model->ui.pending_quit = true;
+            else if (model->ui.menu_selection == 1)
+            {
+                model->sim.state = (model->sim.previous_state == STATE_GAME_OVER) ? STATE_GAME_OVER : STATE_PAUSED;
+                model->ui.menu_selection = 3;
+            }
+            else if (model->ui.menu_selection == 2)
+            {
+                model_scan_saves(model);
+                model->sim.state = STATE_SAVE_SELECT;
+                model->ui.menu_selection = 0;
+            }
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Applique la commande, puis renouvelle la génération du menu si elle l'a touché.
+ */
+void model_handle_input(GameModel *model, GameCommand cmd)
+{
+    GameStateEnum before = model->sim.state;
+    handle_input(model, cmd);
+    // En partie, le tick renouvelle déjà tout ce que les commandes déplacent
+    if (model->sim.state != before || (before != STATE_PLAYING && cmd != CMD_NONE))
+        model_touch(model, MODEL_GEN_MENU);
+}
+
+/**
+ * @brief Traite une commande venant de la Vue, y compris CMD_EXIT.
+ *
+ * @param model Le modèle de jeu.
+ * @param cmd La commande lue par la Vue.
+ * @return false si la commande demande de quitter immédiatement (second CMD_EXIT ou menu "Quitter").
+ */
+bool model_dispatch_command(GameModel *model, GameCommand cmd)
+{
+    if (cmd != CMD_EXIT || timeline_before_switch(&model->sim.transition))
+    {
+        // Traitement standard de la commande par le Modèle (menu "Quitter" : pending_quit)
+        model_handle_input(model, cmd);
+        return !model->ui.pending_quit;
+    }
+
+    // 1. Si on est déjà dans le menu de confirmation -> Force Quit
+    if (model->sim.state == STATE_CONFIRM_QUIT)
+        return false;
+
+    // 2. Sinon, on passe en état de demande de confirmation
+    model->sim.previous_state = model->sim.state;
+    model->sim.state = STATE_CONFIRM_QUIT;
+    model->ui.menu_selection = 1; // Curseur sur "NON" par sécurité
+    model_touch(model, MODEL_GEN_MENU);
+    return true;
+}
+
+// ============================================================================
+//                          6. MISE À JOUR DU MONDE (GAME LOOP)
+// ============================================================================
+
+/**
+ * @brief Corps d'un tick, inséré dans chacun des chemins de model_update.
+ *
+ * Les paramètres de configuration (virgule fixe, mots des masques de balles)
+ * y deviennent des constantes : branches de physique éliminées, masques de
+ * taille fixe (cf. MODEL_UPDATE_VARIANTS).
+ */
+#define MODEL_SPECIALIZE static inline __attribute__((always_inline))
+
+/**
+ * @brief Crée un bonus du registre : position, chute et type.
+ */
+static bool powerup_create(EcsWorld *w, float x, float y, EntityType kind)
+{
+    EcsEntity id = ecs_create(w);
+    if (id == ECS_NONE)
+        return false;
+    int p = ecs_add(w, id, ECS_POSITION);
+    w->x[p] = x;
+    w->y[p] = y;
+    w->dy[ecs_add(w, id, ECS_VELOCITY)] = POWERUP_SPEED;
+    w->kind[ecs_add(w, id, ECS_KIND)] = (uint8_t)kind;
+    return true;
+}
+
+/**
+ * @brief Un alien abattu lâche un bonus, centré sous lui, avec la chance de la vague.
+ *
+ * Le générateur n'est consulté que si la vague a une directive `drops` : les
+ * parties sans bonus tirent les mêmes nombres qu'avant.
+ */
+static void drop_powerup(GameModel *model, int e)
+{
+    const Formation *f = &model->sim.formation;
+    if (f->drop_chance <= 0 || (int)model_rng_below(model, 100) >= f->drop_chance)
+        return;
+    EntityType kind = (EntityType)(ENTITY_POWERUP_RAPID + model_rng_below(model, 3));
+    powerup_create(&model->sim.ecs, model->sim.enemies.x[e] + (ENEMY_WIDTH - POWERUP_WIDTH) / 2.0f,
+                   model->sim.enemies.y[e] + ENEMY_HEIGHT, kind);
+}
+
+/**
+ * @brief Effet d'un bonus ramassé : durées remises à POWERUP_TIME, ou boucliers refaits à neuf.
+ */
+static void apply_powerup(GameModel *model, EntityType kind, float x)
+{
+    if (kind == ENTITY_POWERUP_RAPID)
+        model->sim.rapid_timer = duration_ticks(&model->sim, POWERUP_TIME, model->sim.tick_dt, TICKS_DOWN);
+    else if (kind == ENTITY_POWERUP_SPREAD)
+        model->sim.spread_timer = duration_ticks(&model->sim, POWERUP_TIME, model->sim.tick_dt, TICKS_DOWN);
+    else
+    {
+        init_shields(model);
+        model_touch(model, MODEL_GEN_SHIELDS);
+    }
+    model_touch(model, MODEL_GEN_HUD);
+    emit_sound(model, AUDIO_SELECT, x);
+}
+
+/**
+ * @brief Ramassage : chaque vaisseau actif contre toutes les positions du registre, en un test groupé.
+ *
+ * Les bits de `hits` suivent les places denses de ECS_POSITION ; les bonus
+ * touchés sont relevés avant d'être détruits (une destruction déplace des places).
+ */
+static void collect_powerups(GameModel *model)
+{
+    EcsWorld *w = &model->sim.ecs;
+    const EcsSet *pos = &w->sets[ECS_POSITION];
+    const Entity *ships[2] = {&model->sim.player, &model->sim.player2};
+    for (int s = 0; s < 2; s++)
+    {
+        const Entity *ship = ships[s];
+        if (!ship->active || pos->count == 0)
+            continue;
+        AabbBox box = {ship->x, ship->y, ship->width, ship->height};
+        uint64_t hits[COLLISION_MASK_WORDS(ECS_MAX_ENTITIES)];
+        collision_box_vs_many(&box, w->x, w->y, POWERUP_WIDTH, POWERUP_HEIGHT, pos->count, hits);
+
+        EcsEntity taken[ECS_MAX_ENTITIES];
+        int n = 0;
+        for (int p = 0; p < pos->count; p++)
+        {
+            int i = pos->dense[p], c = ecs_slot(w, i, ECS_KIND);
+            if ((hits[p >> 6] >> (p & 63) & 1) && c >= 0 && w->kind[c] >= ENTITY_POWERUP_RAPID &&
+                w->kind[c] <= ENTITY_POWERUP_REPAIR)
+                taken[n++] = ecs_entity(w, i);
+        }
+        for (int k = 0; k < n; k++)
+        {
+            int c = ecs_get(w, taken[k], ECS_KIND);
+            apply_powerup(model, (EntityType)w->kind[c], ship->x + PLAYER_WIDTH / 2.0f);
+            ecs_destroy(w, taken[k]);
+        }
+    }
+}
+
+/**
+ * @brief Systèmes du registre : déplacement, durée de vie, sortie de l'aire de jeu.
+ *
+ * Chaque système parcourt l'ensemble le plus petit qu'il demande, dans
+ * l'ordre de ses tableaux denses : le tick est reproductible. Les index sont
+ * relevés avant les destructions, qui déplacent des places mais pas les
+ * index des autres entités.
+ */
+MODEL_SPECIALIZE void update_entities(GameModel *model, double dt, const bool fixed)
+{
+    EcsWorld *w = &model->sim.ecs;
+    short ids[ECS_MAX_ENTITIES];
+
+    int n = ecs_query(w, ECS_BIT(ECS_POSITION) | ECS_BIT(ECS_VELOCITY), ids);
+    for (int k = 0; k < n; k++)
+    {
+        int p = ecs_slot(w, ids[k], ECS_POSITION), v = ecs_slot(w, ids[k], ECS_VELOCITY);
+        w->x[p] = advance(fixed, w->x[p], w->dx[v], dt);
+        w->y[p] = advance(fixed, w->y[p], w->dy[v], dt);
+    }
+
+    n = ecs_query(w, ECS_BIT(ECS_LIFETIME), ids);
+    for (int k = 0; k < n; k++)
+    {
+        int l = ecs_slot(w, ids[k], ECS_LIFETIME);
+        w->lifetime[l] = advance(fixed, w->lifetime[l], -1.0f, dt);
+        if (w->lifetime[l] <= 0)
+            ecs_destroy(w, ecs_entity(w, ids[k]));
+    }
+
+    // Boîte entièrement hors de l'aire de jeu (hitbox du type, nulle sans ECS_KIND)
+    n = ecs_query(w, ECS_BIT(ECS_POSITION), ids);
+    for (int k = 0; k < n; k++)
+    {
+        int p = ecs_slot(w, ids[k], ECS_POSITION), c = ecs_slot(w, ids[k], ECS_KIND);
+        int width = c >= 0 ? entity_type_width((EntityType)w->kind[c]) : 0;
+        int height = c >= 0 ? entity_type_height((EntityType)w->kind[c]) : 0;
+        if (w->x[p] + width < 0 || w->x[p] > GAME_WIDTH || w->y[p] + height < 0 || w->y[p] > GAME_HEIGHT)
+            ecs_destroy(w, ecs_entity(w, ids[k]));
+    }
+}
+
+/**
+ * @brief Sections A à E d'un tick : états spéciaux, timers, joueur, OVNI, formation, tirs ennemis.
+ *
+ * @param fixed Physique en virgule fixe (sim.fixed_point, constante dans un chemin spécialisé).
+ * @param prof Reçoit l'horodatage du profileur à la fin de la section E.
+ * @return false si le tick s'arrête avant les balles (menus, fin de partie, niveau suivant).
+ */
+MODEL_SPECIALIZE bool update_world(GameModel *model, double dt, const bool fixed, uint64_t *prof)
+{
+    model->sim.tick_dt = dt; // Les durées en secondes se convertissent au pas courant
+    // A. ÉTATS SPÉCIAUX
+    if (timeline_active(&model->sim.transition))
+        advance_transition(model);
+    if (model->ui.save_scan_pending)
+        poll_save_scan(model);
+    if (model->sim.state == STATE_SAVING)
+    {
+        char path[192];
+        SaveWriterStatus st = save_writer_poll(path, sizeof(path));
+        if (st == SAVE_WRITER_DONE)
+        {
+            logger_write(LOG_INFO, "[SYSTEM] Sauvegarde reussie : %s\n", path);
+            model->sim.state = STATE_SAVE_SUCCESS;
+            start_transition(model, 2.0f, TRANSITION_FADE, TRANSITION_TO_MENU);
+            model_touch(model, MODEL_GEN_MENU);
+        }
+        else if (st == SAVE_WRITER_FAILED)
+        {
+            logger_write(LOG_ERROR, "[ERREUR] Impossible d'ecrire dans %s\n", path);
+            model->sim.state = STATE_SAVE_INPUT;
+            model_touch(model, MODEL_GEN_MENU);
+        }
+        return false;
+    }
+    if (model->sim.state == STATE_SAVE_SUCCESS)
+    {
+        // Message restauré d'un instantané sans sa transition : on la relance
+        if (!timeline_active(&model->sim.transition))
+            start_transition(model, 2.0f, TRANSITION_FADE, TRANSITION_TO_MENU);
+        return false;
+    }
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        model->sim.game_over_timer++;
+        return false;
+    }
+    if (model->sim.state != STATE_PLAYING)
+        return false;
+    uint64_t t = profiler_begin(); // Sondes par section (cf. profiler.h)
+    model_touch(model, MODEL_GEN_ANY); // Joueurs, timers, OVNI : changent à chaque tick de jeu
+
+    // B. TIMERS
+    if (model->sim.player.shoot_timer > 0)
+        model->sim.player.shoot_timer--;
+    if (model->sim.player2.shoot_timer > 0)
+        model->sim.player2.shoot_timer--;
+    if (model->sim.hit_timer > 0)
+        model->sim.hit_timer--;
+    if (model->sim.rapid_timer > 0 && --model->sim.rapid_timer == 0)
+        model_touch(model, MODEL_GEN_HUD); // Fin du bonus : le HUD le retire
+    if (model->sim.spread_timer > 0 && --model->sim.spread_timer == 0)
+        model_touch(model, MODEL_GEN_HUD);
+
+    float beat = 0.5f - (model->sim.level * 0.05f);
+    if (fixed)
+        beat = fixed_to(MODEL_FIXED_ONE / 2 - model->sim.level * fixed_from(0.05f));
+    if (beat < 0.05f)
+        beat = 0.05f;
+    if (++model->sim.animation_timer >= duration_ticks(&model->sim, beat, dt, TICKS_UP))
+    {
+        model->sim.animation_frame = !model->sim.animation_frame;
+        model->sim.animation_timer = 0;
+        model->ui.sounds.beat_index = (model->ui.sounds.beat_index + 1) % 4;
+        emit_sound(model, AUDIO_BEAT + model->ui.sounds.beat_index, GAME_WIDTH / 2.0f);
+    }
+
+    // C. JOUEURS (le second n'est actif qu'en coopération)
+    if (model->sim.player.active)
+        ship_step(&model->sim.player, fixed, dt);
+    if (model->sim.player2.active)
+        ship_step(&model->sim.player2, fixed, dt);
+
+    t = PROFILER_LAP(PROF_UPDATE_TIMERS, t);
+
+    // D. UFO (OVNI)
+    if (model->sim.ufo.active)
+    {
+        model->ui.sounds.ufo_loopING = !model->sim.ufo.exploding;
+
+        if (model->sim.ufo.exploding)
+        {
+            if (--model->sim.ufo.explode_timer <= 0)
+                model->sim.ufo.active = false;
+        }
+        else
+        {
+            model->sim.ufo.x = advance(fixed, model->sim.ufo.x, model->sim.ufo.dx, dt);
+            if ((model->sim.ufo.dx > 0 && model->sim.ufo.x > GAME_WIDTH) ||
+                (model->sim.ufo.dx < 0 && model->sim.ufo.x < -UFO_WIDTH))
+            {
+                model->sim.ufo.active = false;
+            }
+        }
+    }
+    else
+    {
+        model->ui.sounds.ufo_loopING = false;
+        // Vérifie s'il reste des ennemis (vivants ou en train d'exploser, vaisseau amiral compris)
+        bool enemies_alive = model->sim.formation.alive_count > 0 || model->sim.formation.dying_mask ||
+                             model->sim.boss.active;
+
+        // Spawn aléatoire
+        if (!model->sim.ufo.hasSpawnedThisLevel && enemies_alive && (model_rng_below(model, (uint32_t)model->sim.params.ufo_odds) == 0))
+            spawn_ufo(model);
+    }
+
+    t = PROFILER_LAP(PROF_UPDATE_UFO, t);
+
+    // D2. REGISTRE DE COMPOSANTS (bonus compris, ramassés après leur chute du tick)
+    if (model->sim.ecs.alive)
+    {
+        update_entities(model, dt, fixed);
+        collect_powerups(model);
+    }
+
+    t = PROFILER_LAP(PROF_UPDATE_ENTITIES, t);
+
+    // E. ENNEMIS
+    Formation *f = &model->sim.formation;
+    if (f->alive_count > 0 || model->sim.enemies.explosion_count)
+        model_touch(model, MODEL_GEN_FORMATION);
+
+    // Explosions en cours (positions figées au moment de l'impact) : un timer par
+    // créneau de la roue, puis retrait des aliens expirés par index croissant
+    if (model->sim.enemies.explosion_count)
+    {
+        uint64_t done = explosion_advance(&model->sim.enemies);
+        f->dying_mask &= ~done;
+        for (; done; done &= done - 1)
+            active_list_remove(&model->sim.enemies.live, __builtin_ctzll(done));
+    }
+
+    // Vague sans fin : les rangées vidées en bas reviennent par le haut, le niveau
+    // monte sans reconstruire la vague
+    if (model->sim.endless)
+        stream_wave(model, fixed, dt);
+    if (model->sim.boss.active)
+        boss_move(model, fixed, dt);
+
+    // Bords : tick du rebond calculé à l'ouverture du segment, ou deux comparaisons
+    // sur la boîte englobante en cache (sessions antérieures)
+    bool touch_edge = false;
+    if (f->alive_count > 0 && model->sim.formation_path)
+        touch_edge = path_follow(model, fixed, dt);
+    else if (f->alive_count > 0)
+    {
+        float left = grid_coord(fixed, f->origin_x, f->min_col, f->step_x);
+        float right = grid_coord(fixed, f->origin_x, f->max_col, f->step_x);
+        touch_edge = (left <= 0 && model->sim.direction_enemies == -1) ||
+                     (right >= GAME_WIDTH - ENEMY_WIDTH && model->sim.direction_enemies == 1);
+    }
+
+    if (f->alive_count == 0 && !model->sim.ufo.active && !model->sim.boss.active && !model->sim.endless)
+    {
+        model->sim.level++;
+        emit_sound(model, AUDIO_LEVEL_UP, GAME_WIDTH / 2.0f);
+        emit_telemetry(model, TELEMETRY_LEVEL_UP, 0, GAME_WIDTH / 2.0f, 0);
+        init_enemies(model);
+        level_start_capture(model); // Le tick s'arrête ici : l'état est celui de la fin du tick
+        *prof = PROFILER_LAP(PROF_UPDATE_ENEMIES, t);
+        return false;
+    }
+
+    if (touch_edge)
+    {
+        model->sim.direction_enemies *= -1;
+        f->origin_y += drop_step(model->sim.params.enemy_drop, &model->sim.drop_direction, &model->sim.drop_step_count);
+        f->origin_x += model->sim.direction_enemies * 2.0f;
+    }
+    else if (f->alive_count > 0 && model->sim.formation_path)
+        f->origin_x = path_x(fixed, dt, f->path_x0, f->path_rate, ++f->path_ticks);
+    else
+    {
+        float spd = model->sim.params.enemy_speed * model->sim.enemy_speed_mult * model->sim.direction_enemies;
+        f->origin_x = advance(fixed, f->origin_x, spd, dt);
+    }
+
+    t = PROFILER_LAP(PROF_UPDATE_ENEMIES, t);
+
+    // Tirs Ennemis : planifiés (un tirage par tir), ou tirage à chaque tick (sessions antérieures)
+    if (model->sim.fire_scheduled)
+    {
+        if (f->fire_chance > 0 && model->sim.params.fire_percent > 0)
+        {
+            model->sim.fire_timer = advance(fixed, model->sim.fire_timer, -1.0f, dt);
+            if (model->sim.fire_timer <= 0)
+                enemy_fire(model);
+        }
+    }
+    else if ((int)model_rng_below(model, 100) * 100 < f->fire_chance * model->sim.params.fire_percent)
+    {
+        for (int k = 0; k < 10; k++)
+        {
+            int idx = (int)model_rng_below(model, MAX_ENEMIES);
+            if (enemy_alive(model, idx))
+            {
+                spawn_bullet(model, model_get_enemy_x(model, idx) + ENEMY_WIDTH / 2.0f, model_get_enemy_y(model, idx) + ENEMY_HEIGHT, model->sim.params.bullet_speed * 0.6f, ENTITY_BULLET_ENEMY);
+                break;
+            }
+        }
+    }
+
+    *prof = PROFILER_LAP(PROF_UPDATE_ENEMY_FIRE, t);
+    return true;
+}
+
+/**
+ * @brief Section F1 en virgule fixe : le travail de simd_bullet_step, en entiers, slot par slot.
+ */
+static void bullet_step_fixed(BulletPool *p, int anim_ticks, uint64_t *cull)
+{
+    for (int i = 0; i < p->high_water; i++)
+    {
+        p->y[i] = fixed_to(fixed_from(p->y[i]) + fixed_mul(fixed_from(p->dy[i]), MODEL_FIXED_TICK));
+
+        int t = p->anim_timer[i] + 1;
+        int wrap = t >= anim_ticks;
+        p->anim_timer[i] = wrap ? 0 : t;
+        p->anim_frame[i] = (p->anim_frame[i] + wrap) & 3;
+
+        if (p->y[i] < BULLET_CULL_TOP || p->y[i] > GAME_HEIGHT)
+            cull[i >> 6] |= 1ULL << (i & 63);
+    }
+}
+
+/**
+ * @brief Intégration répartie : slots [0, n) par tranches de MODEL_BATCH_SLICE.
+ */
+typedef struct
+{
+    float *y, *dy;              ///< Tableaux intégrés (d'un pool, ou des tranches communes).
+    int *anim_timer;            ///< Ticks dans la frame d'animation courante.
+    int *anim_frame;            ///< Frames d'animation.
+    int anim_ticks;             ///< Ticks entre deux frames (bullet_anim_ticks).
+    int n;                      ///< Slots.
+    float dt;                   ///< Durée du tick.
+    uint64_t *cull;             ///< Masque de sortie, remis à zéro par l'appelant.
+} StepJob;
+
+/**
+ * @brief Une tranche de simd_bullet_step : ses mots du masque ne sont écrits par aucune autre.
+ */
+static void step_slice(void *ctx, int c)
+{
+    StepJob *job = ctx;
+    int from = c * MODEL_BATCH_SLICE;
+    int n = (job->n - from < MODEL_BATCH_SLICE) ? job->n - from : MODEL_BATCH_SLICE;
+    simd_bullet_step(job->y + from, job->dy + from, job->anim_timer + from, job->anim_frame + from, job->anim_ticks, n,
+                     job->dt, job->cull + from / 64);
+}
+
+/**
+ * @brief Section F1 d'un monde seul : noyau SIMD, ou boucle entière en virgule fixe.
+ */
+MODEL_SPECIALIZE void bullet_step(GameModel *model, double dt, const bool fixed, uint64_t *cull)
+{
+    BulletPool *p = &model->sim.bullets;
+    int anim_ticks = bullet_anim_ticks(&model->sim, dt);
+    if (fixed)
+        bullet_step_fixed(p, anim_ticks, cull);
+    else if (p->high_water >= MODEL_PARALLEL_BULLETS && workers_threads() > 1)
+    {
+        // Essaim : le bloc est intégré par tranches sur les workers (slots indépendants)
+        StepJob job = {p->y, p->dy, p->anim_timer, p->anim_frame, anim_ticks, p->high_water, (float)dt, cull};
+        WorkerGraph g;
+        workers_graph_clear(&g);
+        workers_graph_add(&g, step_slice, &job, (job.n + MODEL_BATCH_SLICE - 1) / MODEL_BATCH_SLICE, 0, 0);
+        workers_graph_run(&g, true);
+    }
+    else
+        simd_bullet_step(p->y, p->dy, p->anim_timer, p->anim_frame, anim_ticks, p->high_water, (float)dt, cull);
+}
+
+/**
+ * @brief Tests des slots [from, to) contre M boîtes : à leur position, ou sur leur trajet du tick.
+ *
+ * `from` est ramené au début de son mot : le bloc d'un camp est testé d'un
+ * seul tenant, sans test de type par balle. Les quelques slots de l'autre
+ * camp pris dans le premier mot ne sont jamais lus pour cette cible (F4 ne
+ * lit que les cibles du camp de la balle). Avec M > 1, `from` doit valoir 0
+ * (les M masques sont rangés à `words` mots d'intervalle).
+ *
+ * Le test balayé, scalaire, ne parcourt que les slots vivants (bits de
+ * `active`) : high_water ne redescend qu'au changement de niveau, le bloc
+ * compte surtout des slots libres.
+ *
+ * @param step Durée du tick pour les collisions balayées, 0 sinon.
+ */
+static void bullet_hits(const BulletPool *p, int from, int to, float step, const AabbBox *boxes, int m,
+                        uint64_t *hits, int words)
+{
+    from &= ~63;
+    if (to <= from)
+        return;
+    hits += from / 64;
+    words -= from / 64;
+    if (step > 0)
+        collision_sweep_vs_many(p->x + from, p->y + from, p->dy + from, step, BULLET_WIDTH, BULLET_HEIGHT, to - from,
+                                p->active + from / 64, boxes, m, hits, words);
+    else
+        collision_many_vs_many(p->x + from, p->y + from, BULLET_WIDTH, BULLET_HEIGHT, to - from, boxes, m, hits, words);
+}
+
+/** @name Cibles des balles (bits de BulletHit::targets) */
+///@{
+#define HIT_UFO MAX_SHIELDS               ///< Bits 0 à MAX_SHIELDS - 1 : les boucliers, puis l'OVNI.
+#define HIT_PLAYER (MAX_SHIELDS + 1)      ///< Le joueur.
+#define HIT_PLAYER2 (MAX_SHIELDS + 2)     ///< Le second joueur.
+#define HIT_BOSS (MAX_SHIELDS + 3)        ///< Le vaisseau amiral (boîte de la racine de son BVH).
+#define HIT_TARGETS (MAX_SHIELDS + 4)     ///< Nombre de cibles (bits de BulletHit::targets).
+///@}
+
+/**
+ * @brief Balle à résoudre : les cibles dont sa boîte (balayée) chevauche la boîte.
+ */
+typedef struct
+{
+    short bullet;    ///< Index de la balle.
+    uint8_t targets; ///< Bit h à 1 : la cible h (HIT_*) est touchée géométriquement.
+} BulletHit;
+
+/** @brief Cibles de chaque camp : les boucliers, puis l'OVNI et le vaisseau amiral (joueur) ou les vaisseaux (ennemis). */
+static const unsigned side_targets[BULLET_SIDES] = {
+    ((1u << MAX_SHIELDS) - 1) | 1u << HIT_UFO | 1u << HIT_BOSS,
+    ((1u << MAX_SHIELDS) - 1) | 1u << HIT_PLAYER | 1u << HIT_PLAYER2,
+};
+
+/**
+ * @brief Tests F3 répartis sur les workers (lecture seule du modèle).
+ */
+typedef struct
+{
+    const GameModel *model;          ///< Modèle du tick (non modifié pendant les tests).
+    float step;                      ///< Durée des collisions balayées (0 : position seule).
+    AabbBox targets[HIT_TARGETS];    ///< Boîtes des cibles.
+    unsigned tested[BULLET_SIDES];   ///< Bit h à 1 : la cible h est testée pour ce camp (active, touchable).
+    int chunks;                      ///< Tranches de la liste des balles vivantes.
+    BulletHit *hits;                 ///< La tranche c écrit à partir de son premier index de liste.
+    int *counts;                     ///< Balles retenues par tranche.
+} HitJob;
+
+/**
+ * @brief Cibles de son camp que la balle i chevauche (sur son trajet du tick en collisions balayées).
+ *
+ * @param box Reçoit la boîte testée.
+ */
+static inline unsigned bullet_targets(const HitJob *job, const BulletPool *p, int i, AabbBox *box)
+{
+    int side = i >= p->player_slots;
+    AabbBox a = collision_swept_box(p->x[i], p->y[i], BULLET_WIDTH, BULLET_HEIGHT, p->dy[i] * job->step);
+    unsigned targets = 0;
+    for (int h = 0; h < HIT_TARGETS; h++)
+    {
+        const AabbBox *b = &job->targets[h];
+        if ((job->tested[side] & (1u << h)) && a.x < b->x + b->w && a.x + a.w > b->x && a.y < b->y + b->h &&
+            a.y + a.h > b->y)
+            targets |= 1u << h;
+    }
+    *box = a;
+    return targets;
+}
+
+/**
+ * @brief Une tranche de balles vivantes, parcourue à l'envers comme en F4.
+ *
+ * Ne retient que les balles qui touchent une cible géométriquement, ou un
+ * alien encore vivant au début de la résolution. Les impacts ne font que
+ * retirer des cibles (alien tué, cratère, OVNI explosé, invulnérabilité) :
+ * une balle écartée ici ne toucherait rien non plus dans le chemin simple.
+ * Même expression que simd_aabb_hits et collision_sweep_vs_many : les bits
+ * sont identiques au bit près.
+ */
+static void hit_chunk(void *ctx, int c)
+{
+    HitJob *job = ctx;
+    const BulletPool *p = &job->model->sim.bullets;
+    int n = p->live.count;
+    int from = (int)((long)n * c / job->chunks);
+    int to = (int)((long)n * (c + 1) / job->chunks);
+    BulletHit *out = job->hits + from;
+    int found = 0;
+    for (int k = to - 1; k >= from; k--)
+    {
+        int i = p->live.items[k];
+        AabbBox a;
+        unsigned targets = bullet_targets(job, p, i, &a);
+        if (targets || (i < p->player_slots && formation_hit(job->model, a.x, a.y, a.h, p->dy[i]) >= 0))
+            out[found++] = (BulletHit){(short)i, (uint8_t)targets};
+    }
+    job->counts[c] = found;
+}
+
+/**
+ * @brief Section F4 pour une balle : bouclier, OVNI ou alien, joueur, dans cet ordre.
+ *
+ * Les balles sont résolues une à une, de la fin de la liste vivante vers son
+ * début : c'est cet ordre, et non l'ordre des slots, qui départage deux balles
+ * qui se disputent une issue (cratère qui vide un bouclier, OVNI, perte de la
+ * dernière vie puis fin de partie). La liste est sauvegardée dans son ordre :
+ * une partie rechargée ou rejouée départage de même.
+ *
+ * @param targets Cibles touchées géométriquement (bits HIT_*).
+ * @param reference Chemin de référence : alien et pièce cherchés par formation_scan et boss_scan.
+ */
+static void resolve_bullet(GameModel *model, int i, float step, unsigned targets, const bool reference)
+{
+    BulletPool *p = &model->sim.bullets;
+    const Entity *p2 = &model->sim.player2;
+    AabbBox box = collision_swept_box(p->x[i], p->y[i], BULLET_WIDTH, BULLET_HEIGHT, p->dy[i] * step);
+
+    // --- Boucliers ---
+    bool hit_shield = false;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        Shield *sh = &model->sim.shields[s];
+        if (sh->active && (targets & (1u << s)) && shield_impact(model, sh, box.x, box.y, box.h, p->dy[i]))
+        {
+            bullet_release(p, i);
+            model_touch(model, MODEL_GEN_SHIELDS);
+            hit_shield = true;
+            break;
+        }
+    }
+    if (hit_shield)
+        return;
+
+    if (i < p->player_slots)
+    {
+        // Recherche O(1) dans la grille rigide de la formation. Un trajet
+        // balayé peut aussi couvrir l'OVNI : l'alien, plus bas, est rencontré avant.
+        bool hit_ufo = model->sim.ufo.active && !model->sim.ufo.exploding && (targets & (1u << HIT_UFO));
+        int e = -1;
+        if (!hit_ufo || step != 0.0f)
+            e = reference ? formation_scan(model, box.x, box.y, box.h, p->dy[i])
+                          : formation_hit(model, box.x, box.y, box.h, p->dy[i]);
+
+        if (hit_ufo && e < 0)
+        {
+            bullet_release(p, i);
+            model->sim.ufo.exploding = true;
+            model->sim.ufo.explode_timer = duration_ticks(&model->sim, entity_types[ENTITY_UFO].explode_time,
+                                                           model->sim.tick_dt, TICKS_DOWN);
+            model->sim.score += entity_types[ENTITY_UFO].points;
+            model->sim.lives++;
+            model_touch(model, MODEL_GEN_HUD);
+            emit_sound(model, AUDIO_INVADER_KILLED, model->sim.ufo.x + UFO_WIDTH / 2.0f);
+            emit_telemetry(model, TELEMETRY_UFO_KILL, ENTITY_UFO, model->sim.ufo.x + UFO_WIDTH / 2.0f,
+                           model->sim.ufo.y);
+            return;
+        }
+
+        if (e >= 0)
+        {
+            bullet_release(p, i);
+            formation_kill(model, e, reference);
+            const EntityTypeInfo *info = &entity_types[model->sim.enemies.type[e]];
+            explosion_add(&model->sim.enemies, e, duration_ticks(&model->sim, info->explode_time, model->sim.tick_dt, TICKS_DOWN));
+            model->sim.score += info->points;
+            model_touch(model, MODEL_GEN_HUD);
+            emit_sound(model, AUDIO_INVADER_KILLED, model->sim.enemies.x[e] + ENEMY_WIDTH / 2.0f);
+            emit_telemetry(model, TELEMETRY_KILL, model->sim.enemies.type[e],
+                           model->sim.enemies.x[e] + ENEMY_WIDTH / 2.0f, model_get_enemy_y(model, e));
+            drop_powerup(model, e);
+        }
+        else if (model->sim.boss.active && (targets & (1u << HIT_BOSS)))
+        {
+            // Dans la coque : seules les pièces des nœuds du BVH que la balle chevauche sont testées
+            int part = reference ? boss_scan(model, box.x, box.y, box.h, p->dy[i])
+                                 : boss_hit(model, box.x, box.y, box.h, p->dy[i]);
+            if (part >= 0)
+            {
+                bullet_release(p, i);
+                boss_damage(model, part);
+            }
+        }
+    }
+    else
+    {
+        // Vies et invulnérabilité partagées : le premier vaisseau touché l'emporte
+        const Entity *hit = NULL;
+        if (model->sim.player.active && (targets & (1u << HIT_PLAYER)))
+            hit = &model->sim.player;
+        else if (p2->active && (targets & (1u << HIT_PLAYER2)))
+            hit = p2;
+        if (hit && model->sim.hit_timer <= 0)
+        {
+            bullet_release(p, i);
+            model->sim.lives--;
+            model->sim.hit_timer = duration_ticks(&model->sim, 2.0f, model->sim.tick_dt, TICKS_DOWN);
+            model_touch(model, MODEL_GEN_HUD);
+            emit_sound(model, AUDIO_PLAYER_EXPLOSION, hit->x + PLAYER_WIDTH / 2.0f);
+            emit_telemetry(model, TELEMETRY_DEATH, hit == p2 ? 2 : 1, hit->x + PLAYER_WIDTH / 2.0f, hit->y);
+
+            if (model->sim.lives <= 0)
+            {
+                model->sim.state = STATE_GAME_OVER;
+                emit_sound(model, AUDIO_GAME_OVER, GAME_WIDTH / 2.0f);
+                emit_telemetry(model, TELEMETRY_GAME_OVER, 0, GAME_WIDTH / 2.0f, 0);
+                model->ui.highscore_rank = highscore_insert(&model->ui.highscores, model->sim.score, model->sim.level,
+                                                            (int64_t)time(NULL));
+
+                model->ui.menu_selection = 0;
+                model->sim.game_over_timer = 0;
+                model_touch(model, MODEL_GEN_MENU);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Section F2b : annule les tirs du joueur qui croisent un tir alien, par paires.
+ *
+ * La liste triée vit dans l'arène (copiée avec les balles) ; son ordre ne
+ * dépend que des positions, si bien qu'une partie rechargée ou rejouée
+ * apparie les mêmes balles.
+ */
+static void intercept_bullets(BulletPool *p, const int words)
+{
+    SweepList list = {p->sweep_order, p->sweep_member, p->sweep_count, p->capacity, 0};
+    sweep_update(&list, p->x, p->live.items, p->live.count, p->active);
+    p->sweep_count = list.count;
+
+    uint64_t unpaired[words];
+    memcpy(unpaired, p->active, sizeof(unpaired));
+    CollisionPair pairs[p->live.count / 2];
+    int n = sweep_cross_pairs(&list, p->x, p->y, BULLET_WIDTH, BULLET_HEIGHT, p->type, ENTITY_BULLET_PLAYER,
+                              unpaired, pairs, p->live.count / 2);
+    for (int k = 0; k < n; k++)
+    {
+        bullet_release(p, pairs[k].bullet);
+        bullet_release(p, pairs[k].target);
+    }
+}
+
+/**
+ * @brief Section F3, préparation : boîtes des cibles et cibles testées par camp, au début de la résolution.
+ */
+static void hit_targets(GameModel *model, double dt, bool fixed, HitJob *job)
+{
+    *job = (HitJob){.model = model};
+    if (model->sim.swept_bullets)
+        job->step = fixed ? fixed_to(MODEL_FIXED_TICK) : (float)dt;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+        job->targets[s] = (AabbBox){model->sim.shields[s].x, model->sim.shields[s].y,
+                                    model->sim.shields[s].width, model->sim.shields[s].height};
+    const Entity *p2 = &model->sim.player2;
+    job->targets[HIT_UFO] = (AabbBox){model->sim.ufo.x, model->sim.ufo.y, model->sim.ufo.width, model->sim.ufo.height};
+    job->targets[HIT_PLAYER] = (AabbBox){model->sim.player.x, model->sim.player.y,
+                                         model->sim.player.width, model->sim.player.height};
+    job->targets[HIT_PLAYER2] = (AabbBox){p2->x, p2->y, p2->width, p2->height};
+    unsigned tested = (1u << MAX_SHIELDS) - 1;
+    const Boss *boss = &model->sim.boss;
+    if (boss->active)
+    {
+        BvhBox hull = bvh_bounds(&boss->bvh);
+        job->targets[HIT_BOSS] = (AabbBox){boss->x + hull.x0, boss->y + hull.y0, hull.x1 - hull.x0, hull.y1 - hull.y0};
+        tested |= 1u << HIT_BOSS;
+    }
+    if (model->sim.ufo.active && !model->sim.ufo.exploding)
+        tested |= 1u << HIT_UFO;
+    if (model->sim.player.active && model->sim.hit_timer <= 0)
+        tested |= 1u << HIT_PLAYER;
+    if (p2->active && model->sim.hit_timer <= 0)
+        tested |= 1u << HIT_PLAYER2;
+    for (int side = 0; side < BULLET_SIDES; side++)
+        job->tested[side] = tested & side_targets[side];
+}
+
+/**
+ * @brief Section F d'un tick, après l'intégration des balles : sorties d'écran et impacts.
+ *
+ * @param fixed Physique en virgule fixe (durée du tick des collisions balayées).
+ * @param cull Masque de sortie d'écran du noyau simd_bullet_step (`words` mots).
+ * @param words sim.bullets.mask_words (constante dans un chemin spécialisé : masques de taille fixe).
+ */
+MODEL_SPECIALIZE void update_bullets(GameModel *model, double dt, const bool fixed, const uint64_t *cull,
+                                     const int words, uint64_t t)
+{
+    // F. BALLES & COLLISIONS
+    BulletPool *p = &model->sim.bullets;
+    if (p->live.count)
+        model_touch(model, MODEL_GEN_BULLETS);
+
+    // F2. Libération des balles sorties (parcours à l'envers : un retrait
+    // par swap-remove ne fait sauter aucune balle)
+    for (int k = p->live.count - 1; k >= 0; k--)
+    {
+        int i = p->live.items[k];
+        if (bit_test(cull, i))
+            bullet_release(p, i);
+    }
+
+    // F2b. Interceptions (vague `intercept`) : un tir du joueur et un tir alien
+    // qui se chevauchent disparaissent ensemble. Les slots vivants restent triés
+    // sur X d'un tick à l'autre (sweep_update) : le coût suit les balles, pas leur carré.
+    if (model->sim.formation.intercept && p->live.count > 1)
+        intercept_bullets(p, words);
+
+    // F3. Géométrie des collisions : les positions ne bougent plus d'ici la fin
+    // du tick. Les états (actif, explosion, invulnérabilité) sont vérifiés
+    // ensuite, balle par balle, dans l'ordre de résolution.
+    // En collisions balayées, chaque balle est testée sur son trajet du tick.
+    HitJob job;
+    hit_targets(model, dt, fixed, &job);
+    float step = job.step;
+
+    if (p->live.count >= MODEL_PARALLEL_BULLETS && workers_threads() > 1)
+    {
+        // F3-F4 répartis : tests en parallèle, résolution dans l'ordre du chemin simple
+        job.chunks = workers_threads();
+        BulletHit hits[p->live.count];
+        int counts[WORKERS_MAX];
+        job.hits = hits;
+        job.counts = counts;
+        if (!workers_run(hit_chunk, &job, job.chunks))
+            for (int c = 0; c < job.chunks; c++)
+                hit_chunk(&job, c);
+        int n = p->live.count;
+        for (int c = job.chunks - 1; c >= 0; c--)
+        {
+            const BulletHit *h = hits + (long)n * c / job.chunks;
+            for (int k = 0; k < counts[c]; k++)
+                resolve_bullet(model, h[k].bullet, step, h[k].targets, false);
+        }
+        PROFILER_LAP(PROF_UPDATE_BULLETS, t);
+        return;
+    }
+
+    if (p->live.count < MODEL_BATCH_HITS_MIN || p->live.count * MODEL_BATCH_HITS_DENSITY < p->high_water)
+    {
+        // F3-F4 balle par balle, même ordre que F4 : peu de balles, ou un bloc
+        // surtout libre où les lots testeraient des slots vides (cf. MODEL_BATCH_HITS_MIN)
+        for (int k = p->live.count - 1; k >= 0; k--)
+        {
+            int i = p->live.items[k];
+            AabbBox a;
+            resolve_bullet(model, i, step, bullet_targets(&job, p, i, &a), false);
+        }
+        PROFILER_LAP(PROF_UPDATE_BULLETS, t);
+        return;
+    }
+
+    // F3 par lots (SIMD) : les boucliers sur tout le bloc [0, high_water), puis
+    // chaque cible sur le seul bloc du camp qui peut la toucher (l'OVNI sur les
+    // tirs du joueur, les vaisseaux sur les tirs ennemis), sans test de type
+    uint64_t target_hits[HIT_TARGETS][words];
+    memset(&target_hits[MAX_SHIELDS][0], 0, (HIT_TARGETS - MAX_SHIELDS) * words * sizeof(uint64_t));
+    bullet_hits(p, 0, p->high_water, step, job.targets, MAX_SHIELDS, &target_hits[0][0], words);
+    for (int h = MAX_SHIELDS; h < HIT_TARGETS; h++)
+    {
+        if (job.tested[BULLET_SIDE_PLAYER] & (1u << h))
+            bullet_hits(p, 0, p->player_high, step, &job.targets[h], 1, target_hits[h], words);
+        else if (job.tested[BULLET_SIDE_ENEMY] & (1u << h))
+            bullet_hits(p, p->player_slots, p->high_water, step, &job.targets[h], 1, target_hits[h], words);
+    }
+
+    // F4. Résolution des impacts (à l'envers : un retrait par swap-remove ne fait sauter aucune balle).
+    // L'ordre est celui de la liste vivante, pas celui des slots : quand deux balles
+    // se disputent une même issue (dernier point d'un bouclier, OVNI, dernière vie),
+    // celle qui est rangée le plus loin dans la liste l'emporte (cf. resolve_bullet).
+    for (int k = p->live.count - 1; k >= 0; k--)
+    {
+        int i = p->live.items[k];
+        unsigned targets = 0;
+        for (int h = 0; h < HIT_TARGETS; h++)
+            targets |= (unsigned)bit_test(target_hits[h], i) << h;
+        resolve_bullet(model, i, step, targets, false);
+    }
+    PROFILER_LAP(PROF_UPDATE_BULLETS, t);
+}
+
+/**
+ * @brief Un tick complet, configuration passée en paramètres.
+ */
+MODEL_SPECIALIZE void update_tick(GameModel *model, double dt, const bool fixed, const int words)
+{
+    uint64_t t;
+    if (!update_world(model, dt, fixed, &t))
+        return;
+
+    // F1. Intégration, animation et sortie d'écran : un seul noyau vectorisé
+    // sur le bloc contigu [0, high_water) des slots déjà utilisés.
+    // Masques du tick sur la pile, à la taille du pool (tableaux de longueur variable)
+    uint64_t cull[words];
+    memset(cull, 0, sizeof(cull));
+    bullet_step(model, dt, fixed, cull);
+    update_bullets(model, dt, fixed, cull, words, t);
+}
+
+/**
+ * @brief Configurations courantes, compilées chacune en un chemin de mise à jour.
+ *
+ * `X(nom, virgule fixe, mots des masques de balles)` : le jeu classique
+ * (pool de MAX_BULLETS balles), en flottants et en virgule fixe (réseau,
+ * diffusion). Les dimensions de la formation sont déjà des constantes
+ * (FORMATION_COLS, FORMATION_ROWS).
+ */
+#define MODEL_UPDATE_VARIANTS(X)                           \
+    X(classic, false, BULLET_MASK_WORDS(MAX_BULLETS))      \
+    X(classic_fixed, true, BULLET_MASK_WORDS(MAX_BULLETS))
+
+/** @brief Définit update_<nom> pour une ligne de MODEL_UPDATE_VARIANTS. */
+#define MODEL_UPDATE_DEFINE(name, fixed, words)           \
+    static void update_##name(GameModel *model, double dt) \
+    {                                                      \
+        update_tick(model, dt, fixed, words);              \
+    }
+
+MODEL_UPDATE_VARIANTS(MODEL_UPDATE_DEFINE)
+
+/**
+ * @brief Chemin de repli : configuration lue dans le modèle (capacité choisie par model_set_bullet_capacity).
+ */
+static void update_generic(GameModel *model, double dt)
+{
+    update_tick(model, dt, model->sim.fixed_point, model->sim.bullets.mask_words);
+}
+
+/**
+ * @brief Met à jour l'état du jeu pour une frame.
+ *
+ * Fonction principale de la boucle de jeu qui gère :
+ * - Les timers (tir, invincibilité, animations)
+ * - Le déplacement du joueur avec contraintes de bords
+ * - Le comportement de l'OVNI (spawn, mouvement, explosion)
+ * - Le déplacement collectif des ennemis (pattern classique)
+ * - La montée de difficulté (accélération progressive)
+ * - Les tirs ennemis aléatoires
+ * - La physique des balles et détection de collisions
+ * - Les transitions de niveau quand tous les ennemis sont éliminés
+ * - Les conditions de Game Over (vies <= 0)
+ *
+ * Chemin choisi à chaque appel : une configuration de MODEL_UPDATE_VARIANTS
+ * si le modèle y correspond, sinon update_generic.
+ *
+ * @param model Le modèle de jeu à mettre à jour.
+ * @param dt Delta time en secondes depuis la dernière frame (ignoré en virgule fixe : MODEL_FIXED_TICK).
+ */
+void model_update(GameModel *model, double dt)
+{
+    if (model->ui.telemetry.events)
+        model->ui.telemetry.tick++;
+#define MODEL_UPDATE_SELECT(name, fixed, words)                                                \
+    if (model->sim.fixed_point == (fixed) && model->sim.bullets.mask_words == (words)) \
+    {                                                                                  \
+        update_##name(model, dt);                                                      \
+        return;                                                                        \
+    }
+    MODEL_UPDATE_VARIANTS(MODEL_UPDATE_SELECT)
+#undef MODEL_UPDATE_SELECT
+    update_generic(model, dt);
+}
+
+/**
+ * @brief Range des slots vivants du dernier au premier de la liste vivante (ordre de F2 et F4).
+ *
+ * Le chemin de référence parcourt les slots dans leur ordre ; seul l'ordre de
+ * résolution, qui fait partie du contrat (cf. resolve_bullet), vient de la
+ * liste : tri explicite sur la position de chaque slot, au début de la passe.
+ * Un retrait par swap-remove ne déplace que des balles déjà traitées : cet
+ * ordre figé est celui du parcours à l'envers de la liste.
+ */
+static void reference_live_order(const BulletPool *p, short *slots, int n)
+{
+    if (n == 0)
+        return;
+    short by_pos[p->live.count];
+    for (int pos = 0; pos < p->live.count; pos++)
+        by_pos[pos] = -1;
+    for (int k = 0; k < n; k++)
+        by_pos[p->live.pos[slots[k]]] = slots[k];
+    n = 0;
+    for (int pos = p->live.count - 1; pos >= 0; pos--)
+        if (by_pos[pos] >= 0)
+            slots[n++] = by_pos[pos];
+}
+
+/**
+ * @brief Chemin de référence de intercept_bullets : tri complet sur X, puis appariement sans fenêtre.
+ *
+ * Même ordre que la SweepList (x croissant, puis slot croissant) et même
+ * règle : chaque tir du joueur, dans cet ordre, prend le premier tir alien
+ * encore libre qu'il chevauche, à sa droite puis à sa gauche. Les paires
+ * sont retirées dans l'ordre où elles se forment. La liste triée du chemin
+ * optimisé est vidée : elle repartirait de zéro.
+ */
+static void reference_intercept(BulletPool *p)
+{
+    short order[p->capacity];
+    int n = 0;
+    for (int i = 0; i < p->capacity; i++)
+    {
+        if (!bit_test(p->active, i))
+            continue;
+        int k = n++;
+        for (; k > 0 && (p->x[order[k - 1]] > p->x[i] || (p->x[order[k - 1]] == p->x[i] && order[k - 1] > i)); k--)
+            order[k] = order[k - 1];
+        order[k] = (short)i;
+    }
+
+    bool paired[p->capacity];
+    for (int i = 0; i < p->capacity; i++)
+        paired[i] = false;
+    CollisionPair pairs[n / 2 + 1];
+    int found = 0;
+    for (int k = 0; k < n; k++)
+    {
+        int i = order[k];
+        if (p->type[i] != ENTITY_BULLET_PLAYER || paired[i])
+            continue;
+        int partner = -1;
+        for (int dir = 1; dir >= -1 && partner < 0; dir -= 2)
+            for (int j = k + dir; j >= 0 && j < n && partner < 0; j += dir)
+            {
+                int o = order[j];
+                if (p->type[o] != ENTITY_BULLET_PLAYER && !paired[o] && fabsf(p->x[o] - p->x[i]) < BULLET_WIDTH &&
+                    p->y[o] < p->y[i] + BULLET_HEIGHT && p->y[o] + BULLET_HEIGHT > p->y[i])
+                    partner = o;
+            }
+        if (partner < 0)
+            continue;
+        paired[i] = paired[partner] = true;
+        pairs[found++] = (CollisionPair){(short)i, (short)partner};
+    }
+    for (int k = 0; k < found; k++)
+    {
+        bullet_release(p, pairs[k].bullet);
+        bullet_release(p, pairs[k].target);
+    }
+    p->sweep_count = 0;
+    memset(p->sweep_member, 0, (size_t)p->mask_words * sizeof(uint64_t));
+}
+
+/**
+ * @brief Chemin de référence de hit_targets et bullet_targets : cibles de la balle i lues dans le modèle.
+ *
+ * Les pièces du vaisseau amiral sont toutes testées par boss_scan, sans la
+ * boîte de la coque.
+ */
+static unsigned reference_targets(const GameModel *model, int i, float step)
+{
+    const BulletPool *p = &model->sim.bullets;
+    AabbBox a = collision_swept_box(p->x[i], p->y[i], BULLET_WIDTH, BULLET_HEIGHT, p->dy[i] * step);
+    unsigned targets = 0;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        const Shield *sh = &model->sim.shields[s];
+        targets |= (unsigned)aabb_overlap(a.x, a.y, a.w, a.h, sh->x, sh->y, sh->width, sh->height) << s;
+    }
+    if (i < p->player_slots)
+    {
+        const Ufo *ufo = &model->sim.ufo;
+        if (ufo->active && !ufo->exploding && aabb_overlap(a.x, a.y, a.w, a.h, ufo->x, ufo->y, ufo->width, ufo->height))
+            targets |= 1u << HIT_UFO;
+        if (model->sim.boss.active)
+            targets |= 1u << HIT_BOSS;
+        return targets;
+    }
+    const Entity *ships[2] = {&model->sim.player, &model->sim.player2};
+    for (int k = 0; k < 2; k++)
+        if (ships[k]->active && model->sim.hit_timer <= 0 &&
+            aabb_overlap(a.x, a.y, a.w, a.h, ships[k]->x, ships[k]->y, ships[k]->width, ships[k]->height))
+            targets |= 1u << (HIT_PLAYER + k);
+    return targets;
+}
+
+/**
+ * @brief Section F de référence : slots [0, capacity) dans leur ordre, chacun vérifié dans `active`.
+ */
+static void reference_bullets(GameModel *model, double dt, const bool fixed)
+{
+    BulletPool *p = &model->sim.bullets;
+    int anim_ticks = bullet_anim_ticks(&model->sim, dt);
+    short slots[p->capacity];
+    unsigned targets[p->capacity];
+
+    // F1. Intégration et sortie d'écran
+    int n = 0;
+    for (int i = 0; i < p->capacity; i++)
+    {
+        if (!bit_test(p->active, i))
+            continue;
+        if (fixed)
+            p->y[i] = fixed_to(fixed_from(p->y[i]) + fixed_mul(fixed_from(p->dy[i]), MODEL_FIXED_TICK));
+        else
+            p->y[i] += p->dy[i] * (float)dt;
+        int timer = p->anim_timer[i] + 1;
+        int wrap = timer >= anim_ticks;
+        p->anim_timer[i] = wrap ? 0 : timer;
+        p->anim_frame[i] = (p->anim_frame[i] + wrap) & 3;
+        if (p->y[i] < BULLET_CULL_TOP || p->y[i] > GAME_HEIGHT)
+            slots[n++] = (short)i;
+    }
+
+    // F2. Sorties d'écran, puis interceptions
+    if (p->live.count)
+        model_touch(model, MODEL_GEN_BULLETS);
+    reference_live_order(p, slots, n);
+    for (int k = 0; k < n; k++)
+        bullet_release(p, slots[k]);
+    if (model->sim.formation.intercept && p->live.count > 1)
+        reference_intercept(p);
+
+    // F3. Chaque balle contre chaque cible de son camp, géométrie figée avant toute résolution
+    float step = !model->sim.swept_bullets ? 0.0f : fixed ? fixed_to(MODEL_FIXED_TICK) : (float)dt;
+    n = 0;
+    for (int i = 0; i < p->capacity; i++)
+    {
+        if (!bit_test(p->active, i))
+            continue;
+        targets[i] = reference_targets(model, i, step);
+        slots[n++] = (short)i;
+    }
+
+    // F4. Résolution dans l'ordre du contrat
+    reference_live_order(p, slots, n);
+    for (int k = 0; k < n; k++)
+        resolve_bullet(model, slots[k], step, targets[slots[k]], true);
+}
+
+/**
+ * @brief Tick de référence : le chemin le plus simple, sans aucune des optimisations de la section F.
+ *
+ * Les balles sont prises slot par slot sur [0, capacity), leur ordre de
+ * résolution trié explicitement (reference_live_order) ; chaque balle est
+ * testée contre chaque cible, l'alien et la pièce touchés par un balayage de
+ * toute la vague (formation_scan, boss_scan), les interceptions par un tri
+ * complet. Les sections A à E sont celles de model_update, mais lisent des
+ * caches de la vague (compte, colonnes extrêmes, bas des colonnes) refaits
+ * depuis son masque de vie avant le tick, à chaque impact et après le tick :
+ * une erreur de mise à jour incrémentale dans model_update devient un écart.
+ */
+void model_update_reference(GameModel *model, double dt)
+{
+    if (model->ui.telemetry.events)
+        model->ui.telemetry.tick++;
+    const bool fixed = model->sim.fixed_point;
+    formation_rescan(&model->sim.formation);
+    uint64_t t;
+    if (update_world(model, dt, fixed, &t))
+        reference_bullets(model, dt, fixed);
+    formation_rescan(&model->sim.formation);
+}
+
+/**
+ * @brief Tranches SoA communes à plusieurs mondes, pour un seul appel du noyau des balles.
+ *
+ * Les blocs [0, high_water) des mondes y sont rangés bout à bout : le monde k
+ * occupe les slots [début_k, début_k + high_water_k), début_k étant la somme
+ * des high_water des mondes précédents.
+ */
+typedef struct
+{
+    float y[MODEL_BATCH_LANES];                  ///< Altitudes.
+    float dy[MODEL_BATCH_LANES];                 ///< Vitesses verticales.
+    int anim_timer[MODEL_BATCH_LANES];           ///< Ticks d'animation.
+    int anim_frame[MODEL_BATCH_LANES];           ///< Frames d'animation.
+    int anim_ticks;                              ///< Ticks entre deux frames, commun aux mondes rangés.
+    uint64_t cull[MODEL_BATCH_LANES / 64 + 1];   ///< Masque de sortie (un mot de marge pour mask_extract).
+    GameModel *worlds[MODEL_BATCH_WORLDS];       ///< Mondes rangés, dans l'ordre des tranches.
+    int count;                                   ///< Nombre de mondes rangés.
+    int lanes;                                   ///< Slots occupés.
+} BatchLanes;
+
+/**
+ * @brief Copie `count` bits de `src`, à partir du bit `from`, au début de `dst`.
+ *
+ * Lit au plus un mot au-delà du dernier bit copié (cf. BatchLanes::cull).
+ */
+static void mask_extract(const uint64_t *src, int from, int count, uint64_t *dst)
+{
+    int words = BULLET_MASK_WORDS(count);
+    for (int w = 0; w < words; w++)
+    {
+        int bit = from + w * 64;
+        uint64_t v = src[bit >> 6] >> (bit & 63);
+        if (bit & 63)
+            v |= src[(bit >> 6) + 1] << (64 - (bit & 63));
+        dst[w] = v;
+    }
+    if (count & 63)
+        dst[words - 1] &= (1ULL << (count & 63)) - 1;
+}
+
+/** @name Domaines des passes de model_step_batch (WorkerGraph) */
+///@{
+#define BATCH_DOM_WORLDS 1u ///< États des mondes (chaque tâche ne touche qu'aux siens).
+#define BATCH_DOM_LANES 2u  ///< Tranches communes (BatchLanes).
+///@}
+
+/**
+ * @brief Travail d'un appel de model_step_batch, partagé par ses passes.
+ */
+typedef struct
+{
+    GameModel **models;                 ///< Mondes.
+    const GameCommand *cmds;            ///< Commandes (NULL : aucune).
+    int n;                              ///< Nombre de mondes.
+    double dt;                          ///< Durée du tick.
+    int chunks;                         ///< Tranches de mondes de la passe A à E (en parallèle).
+    uint8_t *pending;                   ///< 1 : monde à intégrer dans les tranches communes (en parallèle).
+    BatchLanes *b;                      ///< Tranches communes.
+    int starts[MODEL_BATCH_WORLDS];     ///< Premier slot de chaque monde rangé.
+    StepJob step;                       ///< Intégration des tranches.
+} BatchJob;
+
+/**
+ * @brief Commande et sections A à E du monde i ; vrai s'il attend l'intégration commune.
+ *
+ * Un monde en virgule fixe, ou dont le bloc dépasse MODEL_BATCH_LANES, finit
+ * son tick sur place.
+ */
+static bool batch_world(BatchJob *job, int i)
+{
+    GameModel *model = job->models[i];
+    if (job->cmds)
+        model_handle_input(model, job->cmds[i]);
+    uint64_t t;
+    if (!update_world(model, job->dt, model->sim.fixed_point, &t))
+        return false;
+
+    BulletPool *p = &model->sim.bullets;
+    if (model->sim.fixed_point || p->high_water > MODEL_BATCH_LANES)
+    {
+        uint64_t cull[p->mask_words];
+        memset(cull, 0, sizeof(cull));
+        bullet_step(model, job->dt, model->sim.fixed_point, cull);
+        update_bullets(model, job->dt, model->sim.fixed_point, cull, p->mask_words, t);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Passe A à E d'une tranche de mondes (tâche c sur job->chunks).
+ */
+static void batch_worlds(void *ctx, int c)
+{
+    BatchJob *job = ctx;
+    int from = (int)((long)job->n * c / job->chunks);
+    int to = (int)((long)job->n * (c + 1) / job->chunks);
+    for (int i = from; i < to; i++)
+        job->pending[i] = batch_world(job, i);
+}
+
+/**
+ * @brief Range les balles du monde k au bout des précédents.
+ */
+static void batch_pack(void *ctx, int k)
+{
+    BatchJob *job = ctx;
+    BatchLanes *b = job->b;
+    const BulletPool *p = &b->worlds[k]->sim.bullets;
+    size_t n = (size_t)p->high_water, at = (size_t)job->starts[k];
+    memcpy(b->y + at, p->y, n * sizeof(float));
+    memcpy(b->dy + at, p->dy, n * sizeof(float));
+    memcpy(b->anim_timer + at, p->anim_timer, n * sizeof(int));
+    memcpy(b->anim_frame + at, p->anim_frame, n * sizeof(int));
+}
+
+/**
+ * @brief Rend au monde k ses balles intégrées, puis finit son tick (sorties d'écran, collisions).
+ */
+static void batch_finish(void *ctx, int k)
+{
+    BatchJob *job = ctx;
+    BatchLanes *b = job->b;
+    GameModel *model = b->worlds[k];
+    BulletPool *p = &model->sim.bullets;
+    size_t n = (size_t)p->high_water, at = (size_t)job->starts[k];
+    memcpy(p->y, b->y + at, n * sizeof(float));
+    memcpy(p->anim_timer, b->anim_timer + at, n * sizeof(int));
+    memcpy(p->anim_frame, b->anim_frame + at, n * sizeof(int));
+
+    uint64_t cull[p->mask_words];
+    memset(cull, 0, sizeof(cull));
+    mask_extract(b->cull, (int)at, p->high_water, cull);
+    update_bullets(model, job->dt, false, cull, p->mask_words, 0.0); // Section F non chronométrée : le noyau est commun
+}
+
+/**
+ * @brief Vrai si le monde peut rejoindre les tranches communes sans qu'on les intègre d'abord.
+ *
+ * Il faut de la place, et la même période d'animation des balles : une
+ * session d'avant les timers entiers ne la compte pas toujours en autant de ticks.
+ */
+static bool batch_fits(const BatchJob *job, const GameModel *model)
+{
+    const BatchLanes *b = job->b;
+    return b->count == 0 || (b->lanes + model->sim.bullets.high_water <= MODEL_BATCH_LANES &&
+                             b->count < MODEL_BATCH_WORLDS && bullet_anim_ticks(&model->sim, job->dt) == b->anim_ticks);
+}
+
+/**
+ * @brief Ajoute un monde aux tranches communes, au bout des précédents (ses balles sont rangées à part).
+ */
+static void batch_add(BatchJob *job, GameModel *model)
+{
+    BatchLanes *b = job->b;
+    if (b->count == 0)
+        b->anim_ticks = bullet_anim_ticks(&model->sim, job->dt);
+    job->starts[b->count] = b->lanes;
+    b->worlds[b->count++] = model;
+    b->lanes += model->sim.bullets.high_water;
+}
+
+/**
+ * @brief Intègre les tranches communes, puis finit le tick des mondes rangés.
+ *
+ * @param parallel Graphe sur les workers : rangement, intégration par
+ *                 tranches de MODEL_BATCH_SLICE, fin de tick. Sinon, les
+ *                 balles sont déjà rangées et le noyau les prend d'un appel.
+ */
+static void batch_flush(BatchJob *job, bool parallel)
+{
+    BatchLanes *b = job->b;
+    if (b->count == 0)
+        return;
+    memset(b->cull, 0, (size_t)(BULLET_MASK_WORDS(b->lanes) + 1) * sizeof(uint64_t));
+    if (parallel)
+    {
+        job->step = (StepJob){b->y, b->dy, b->anim_timer, b->anim_frame, b->anim_ticks, b->lanes, (float)job->dt, b->cull};
+        WorkerGraph g;
+        workers_graph_clear(&g);
+        workers_graph_add(&g, batch_pack, job, b->count, BATCH_DOM_WORLDS, BATCH_DOM_LANES);
+        workers_graph_add(&g, step_slice, &job->step, (b->lanes + MODEL_BATCH_SLICE - 1) / MODEL_BATCH_SLICE,
+                          BATCH_DOM_LANES, BATCH_DOM_LANES);
+        workers_graph_add(&g, batch_finish, job, b->count, BATCH_DOM_LANES, BATCH_DOM_WORLDS);
+        workers_graph_run(&g, true);
+    }
+    else
+    {
+        simd_bullet_step(b->y, b->dy, b->anim_timer, b->anim_frame, b->anim_ticks, b->lanes, (float)job->dt, b->cull);
+        for (int k = 0; k < b->count; k++)
+            batch_finish(job, k);
+    }
+    b->count = 0;
+    b->lanes = 0;
+}
+
+/**
+ * @brief Avance N mondes indépendants d'un tick, noyau des balles partagé.
+ *
+ * Chaque monde reçoit sa commande puis passe ses sections A à E ; ses balles
+ * sont ensuite rangées dans les tranches communes. Quand elles sont pleines
+ * (ou en fin de liste), elles sont intégrées par tranches de
+ * MODEL_BATCH_SLICE slots et chaque monde termine son tick (sorties d'écran,
+ * collisions). Un monde dont le bloc dépasse MODEL_BATCH_LANES, ou en
+ * virgule fixe, est intégré seul, sur place.
+ *
+ * À partir de MODEL_PARALLEL_WORLDS mondes (sondes du profileur coupées),
+ * les passes forment un graphe réparti sur les workers (workers.h) : sections
+ * A à E de tous les mondes, puis, groupe par groupe, rangement, intégration
+ * et fin de tick. En dessous, la boucle reste séquentielle et range chaque
+ * monde juste après sa section E, encore en cache.
+ *
+ * Les mondes ne partagent rien et le noyau traite chaque slot
+ * indépendamment : le résultat est identique, bit à bit, à N appels de
+ * model_update, quel que soit le nombre de threads.
+ */
+void model_step_batch(GameModel **models, const GameCommand *cmds, int n, double dt)
+{
+    BatchLanes lanes;
+    BatchJob job = {.models = models, .cmds = cmds, .n = n, .dt = dt, .b = &lanes};
+    lanes.count = 0;
+    lanes.lanes = 0;
+
+    if (n < MODEL_PARALLEL_WORLDS || workers_threads() < 2 || profiler_enabled())
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (!batch_world(&job, i))
+                continue;
+            if (!batch_fits(&job, models[i]))
+                batch_flush(&job, false);
+            batch_add(&job, models[i]);
+            batch_pack(&job, lanes.count - 1);
+        }
+        batch_flush(&job, false);
+        return;
+    }
+
+    uint8_t pending[n];
+    WorkerGraph g;
+    job.pending = pending;
+    job.chunks = (4 * workers_threads() < n) ? 4 * workers_threads() : n;
+    workers_graph_clear(&g);
+    workers_graph_add(&g, batch_worlds, &job, job.chunks, BATCH_DOM_WORLDS, BATCH_DOM_WORLDS);
+    workers_graph_run(&g, true);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (!pending[i])
+            continue;
+        if (!batch_fits(&job, models[i]))
+            batch_flush(&job, true);
+        batch_add(&job, models[i]);
+    }
+    batch_flush(&job, true);
+}
+
+// ============================================================================
+//                          7. ACCESSEURS (LECTURE SEULE)
+// ============================================================================
+
+/**
+ * @brief Position X courante d'un ennemi.
+ *
+ * Vivant : déduite de l'origine de la formation. Explosé ou hors formation :
+ * position stockée dans l'Entity (figée au moment de l'impact).
+ */
+float model_get_enemy_x(const GameModel *model, int i)
+{
+    if (enemy_alive(model, i))
+        return grid_coord(model->sim.fixed_point, model->sim.formation.origin_x, i % FORMATION_COLS, model->sim.formation.step_x);
+    return model->sim.enemies.x[i];
+}
+
+/**
+ * @brief Position Y courante d'un ennemi (voir model_get_enemy_x).
+ */
+float model_get_enemy_y(const GameModel *model, int i)
+{
+    if (enemy_alive(model, i))
+        return grid_coord(model->sim.fixed_point, model->sim.formation.origin_y, i / FORMATION_COLS, model->sim.formation.step_y);
+    return model->sim.enemies.y[i];
+}
+
+/**
+ * @brief Origine de la vague dans `ticks` ticks : un segment par rebond, sans simuler les ticks.
+ *
+ * Reprend le segment du modèle s'il est à jour (mêmes positions que les
+ * ticks à venir), sinon en ouvre un à l'origine courante, comme le tick.
+ */
+void model_formation_at(const GameModel *model, int ticks, float *x, float *y)
+{
+    const SimState *s = &model->sim;
+    const Formation *f = &s->formation;
+    bool fixed = s->fixed_point;
+    double dt = s->tick_dt;
+    int dir = s->direction_enemies;
+    int drop_direction = s->drop_direction;
+    int drop_step_count = s->drop_step_count;
+    float rate = s->params.enemy_speed * s->enemy_speed_mult * dir;
+    float x0 = f->origin_x;
+    *y = f->origin_y;
+    if (ticks <= 0)
+    {
+        *x = x0;
+        return;
+    }
+    if (f->alive_count == 0)
+    {
+        *x = path_x(fixed, dt, x0, rate, ticks);
+        return;
+    }
+
+    int n = 0;
+    int edge;
+    if (s->formation_path && path_current(fixed, dt, f, rate))
+    {
+        x0 = f->path_x0;
+        n = f->path_ticks;
+        edge = f->path_edge;
+    }
+    else
+        edge = path_solve(fixed, dt, f, dir, x0, rate);
+
+    // Marche jusqu'au rebond, le rebond (un tick), puis segment suivant
+    while (ticks > edge - n)
+    {
+        ticks -= (edge > n ? edge - n : 0) + 1;
+        float at = path_x(fixed, dt, x0, rate, edge > n ? edge : n);
+        dir = -dir;
+        rate = -rate;
+        *y += drop_step(s->params.enemy_drop, &drop_direction, &drop_step_count);
+        x0 = at + dir * 2.0f;
+        n = 0;
+        edge = path_solve(fixed, dt, f, dir, x0, rate);
+    }
+    *x = path_x(fixed, dt, x0, rate, n + ticks);
+}
+
+/**
+ * @brief Ticks d'explosion restants d'un alien : le timer de son créneau.
+ */
+int model_get_enemy_explode_timer(const GameModel *model, int i)
+{
+    const EnemyPool *e = &model->sim.enemies;
+    for (int k = 0; k < e->explosion_count; k++)
+        if (e->explosions[k].mask & (1ULL << i))
+            return e->explosions[k].timer;
+    return 0;
+}
+
+/**
+ * @brief Reconstitue un ennemi sous forme d'Entity (lecture seule, pour les Vues).
+ */
+bool model_get_enemy(const GameModel *model, int i, Entity *out)
+{
+    if (i < 0 || i >= FORMATION_SIZE)
+        return false;
+    bool dying = (model->sim.formation.dying_mask >> i) & 1;
+    if (!dying && !enemy_alive(model, i))
+        return false;
+
+    memset(out, 0, sizeof(Entity));
+    out->active = true;
+    out->exploding = dying;
+    out->explode_timer = model_get_enemy_explode_timer(model, i);
+    out->type = model->sim.enemies.type[i];
+    out->x = model_get_enemy_x(model, i);
+    out->y = model_get_enemy_y(model, i);
+    out->width = entity_type_width(out->type);
+    out->height = entity_type_height(out->type);
+    return true;
+}
+
+/**
+ * @brief Reconstitue une pièce intacte du vaisseau amiral (lecture seule, pour les Vues).
+ */
+bool model_get_boss_part(const GameModel *model, int k, Entity *out)
+{
+    const Boss *b = &model->sim.boss;
+    if (!b->active || k < 0 || k >= b->parts || !(b->alive_mask & (1ULL << k)))
+        return false;
+
+    memset(out, 0, sizeof(Entity));
+    out->active = true;
+    out->type = ENTITY_BOSS_PART;
+    out->x = b->x + b->col[k] * BOSS_PART_WIDTH;
+    out->y = b->y + b->row[k] * BOSS_PART_HEIGHT;
+    out->dx = b->dx;
+    out->width = BOSS_PART_WIDTH;
+    out->height = BOSS_PART_HEIGHT;
+    return true;
+}
+
+/**
+ * @brief Reconstitue une balle sous forme d'Entity (lecture seule, pour les Vues).
+ */
+bool model_get_bullet(const GameModel *model, int i, Entity *out)
+{
+    const BulletPool *p = &model->sim.bullets;
+    if (i < 0 || i >= p->capacity || !bit_test(p->active, i))
+        return false;
+
+    memset(out, 0, sizeof(Entity));
+    out->active = true;
+    out->x = p->x[i];
+    out->y = p->y[i];
+    out->dy = p->dy[i];
+    out->type = p->type[i];
+    out->width = entity_type_width(out->type);
+    out->height = entity_type_height(out->type);
+    out->anim_timer = p->anim_timer[i];
+    out->anim_frame = p->anim_frame[i];
+    return true;
+}
+
+/**
+ * @brief Trajectoire d'une balle au pas fixe du jeu.
+ *
+ * Même arithmétique que bullet_step : Q16.16 en virgule fixe, sinon pas
+ * flottant du dernier tick ; période d'animation de bullet_anim_ticks.
+ */
+bool model_get_bullet_motion(const GameModel *model, int i, int32_t *step, int *anim_ticks, int *anim_phase)
+{
+    const BulletPool *p = &model->sim.bullets;
+    if (i < 0 || i >= p->capacity || !bit_test(p->active, i))
+        return false;
+
+    *anim_ticks = bullet_anim_ticks(&model->sim, model->sim.tick_dt);
+    *anim_phase = p->anim_timer[i];
+    if (model->sim.fixed_point)
+        *step = fixed_mul(fixed_from(p->dy[i]), MODEL_FIXED_TICK);
+    else
+        *step = (int32_t)lrint((double)(p->dy[i] * (float)model->sim.tick_dt) * MODEL_FIXED_ONE);
+    return true;
+}
+
+void model_set_tick_rate(GameModel *model, int hz)
+{
+    if (hz < MODEL_TICK_RATE_MIN)
+        hz = MODEL_TICK_RATE_MIN;
+    if (hz > MODEL_TICK_RATE_MAX)
+        hz = MODEL_TICK_RATE_MAX;
+    model->sim.tick_dt = 1.0 / hz;
+}
+
+int model_tick_rate(const GameModel *model)
+{
+    return (int)lround(1.0 / tick_seconds(&model->sim));
+}
+
+int model_countdown_ticks(const GameModel *model, float seconds)
+{
+    return duration_ticks(&model->sim, seconds, model->sim.tick_dt, TICKS_DOWN);
+}
+
+float model_countdown_seconds(const GameModel *model, int ticks)
+{
+    return ticks > 0 ? (float)((ticks - 0.5) * tick_seconds(&model->sim)) : 0.0f;
+}
+
+int model_elapsed_ticks(const GameModel *model, float seconds)
+{
+    return seconds > 0.0f ? (int)lround(seconds / tick_seconds(&model->sim)) : 0;
+}
+
+float model_elapsed_seconds(const GameModel *model, int ticks)
+{
+    return (float)(ticks * tick_seconds(&model->sim));
+}
+
+/**
+ * @brief Liste compacte des ennemis à afficher (vivants ou en explosion).
+ */
+int model_get_live_enemies(const GameModel *model, const short **indices)
+{
+    *indices = model->sim.enemies.live.items;
+    return model->sim.enemies.live.count;
+}
+
+/**
+ * @brief Liste compacte des balles actives.
+ */
+int model_get_live_bullets(const GameModel *model, const short **indices)
+{
+    *indices = model->sim.bullets.live.items;
+    return model->sim.bullets.live.count;
+}
+
+/**
+ * @brief États sans timer ni animation du Modèle : seuls les commandes les font évoluer.
+ */
+bool model_is_idle(const GameModel *model)
+{
+    if (model->ui.save_scan_pending || model->ui.pending_quit || timeline_active(&model->sim.transition))
+        return false;
+    switch (model->sim.state)
+    {
+    case STATE_MENU:
+    case STATE_TUTORIAL:
+    case STATE_LOAD_MENU:
+    case STATE_SAVE_SELECT:
+    case STATE_PAUSED:
+    case STATE_CONFIRM_QUIT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Options du Game Over : « réessayer » en tête s'il y a un départ à reprendre.
+ */
+int model_game_over_options(const GameModel *model, GameOverOption out[GAME_OVER_OPTION_COUNT])
+{
+    int n = 0;
+    if (level_start_latest(model))
+        out[n++] = GAME_OVER_RETRY;
+    out[n++] = GAME_OVER_SAVE;
+    out[n++] = GAME_OVER_REPLAY;
+    out[n++] = GAME_OVER_QUIT;
+    return n;
+}
+
+/**
+ * @brief Niveau du départ que « réessayer » restaurerait.
+ */
+int model_retry_level(const GameModel *model)
+{
+    const LevelStart *ls = level_start_latest(model);
+    return ls ? ls->level : 0;
+}
+
+/**
+ * @brief Branche le Modèle sur la file d'événements audio d'une Vue.
+ */
+void model_set_audio_sink(GameModel *model, SpscRing *events)
+{
+    model->ui.sounds.events = events;
+}
+
+/**
+ * @brief Branche le Modèle sur la file d'un journal de télémétrie, tick remis à 0.
+ */
+void model_set_telemetry_sink(GameModel *model, SpscRing *events)
+{
+    model->ui.telemetry.events = events;
+    model->ui.telemetry.tick = 0;
 }
 
 // ============================================================================
-//                          6. MISE À JOUR DU MONDE (GAME LOOP)
+//                          8. GÉNÉRATEUR ALÉATOIRE (PCG32)
 // ============================================================================
 
 /**
- * @brief Met à jour l'état du jeu pour une frame.
- *
- * Fonction principale de la boucle de jeu qui gère :
- * - Les timers (tir, invincibilité, animations)
- * - Le déplacement du joueur avec contraintes de bords
- * - Le comportement de l'OVNI (spawn, mouvement, explosion)
- * - Le déplacement collectif des ennemis (pattern classique)
- * - La montée de difficulté (accélération progressive)
- * - Les tirs ennemis aléatoires
- * - La physique des balles et détection de collisions
- * - Les transitions de niveau quand tous les ennemis sont éliminés
- * - Les conditions de Game Over (vies <= 0)
+ * @brief (Ré)initialise le générateur du modèle à partir d'une graine.
  *
- * @param model Le modèle de jeu à mettre à jour.
- * @param dt Delta time en secondes depuis la dernière frame.
+ * Séquence d'initialisation de référence de PCG : l'incrément est dérivé
+ * de la graine pour que deux graines voisines donnent des flux indépendants.
  */
-void model_update(GameModel *model, double dt)
+void model_rng_seed(GameModel *model, uint64_t seed)
 {
-    // A. ÉTATS SPÉCIAUX
-    if (model->state == STATE_SAVE_SUCCESS)
-    {
-        model->save_success_timer -= dt;
-        if (model->save_success_timer <= 0)
-            exit(0);
-        return;
-    }
-    if (model->state == STATE_GAME_OVER)
-    {
-        model->game_over_timer += dt;
-        return;
-    }
-    if (model->state != STATE_PLAYING)
-        return;
+    ModelRng *r = &model->sim.rng;
+    r->seed = seed;
+    r->state = 0;
+    r->inc = (seed << 1) | 1u;
+    model_rng_next(model);
+    r->state += seed;
+    model_rng_next(model);
+}
 
-    // B. TIMERS
-    if (model->player.shoot_timer > 0)
-        model->player.shoot_timer -= dt;
-    if (model->hit_timer > 0)
-        model->hit_timer -= dt;
+/**
+ * @brief Tire un entier 32 bits uniforme (PCG-XSH-RR).
+ */
+uint32_t model_rng_next(GameModel *model)
+{
+    ModelRng *r = &model->sim.rng;
+    uint64_t old = r->state;
+    r->state = old * 6364136223846793005ULL + r->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
 
-    float beat = 0.5f - (model->level * 0.05f);
-    if (beat < 0.05f)
-        beat = 0.05f;
-    model->animation_timer += dt;
-    if (model->animation_timer >= beat)
-    {
-        model->animation_frame = !model->animation_frame;
-        model->animation_timer = 0;
-        model->sounds.play_beat = true;
-        model->sounds.beat_index = (model->sounds.beat_index + 1) % 4;
-    }
+/**
+ * @brief Tire un entier dans [0, bound).
+ */
+uint32_t model_rng_below(GameModel *model, uint32_t bound)
+{
+    return (uint32_t)(((uint64_t)model_rng_next(model) * bound) >> 32);
+}
 
-    // C. JOUEUR
-    if (model->player.active)
-    {
-        model->player.x += model->player.dx * dt;
-        if (model->player.x < 0)
-            model->player.x = 0;
-        if (model->player.x > GAME_WIDTH - PLAYER_WIDTH)
-            model->player.x = GAME_WIDTH - PLAYER_WIDTH;
-    }
+// ============================================================================
+//                          9. GESTION DES FICHIERS (SAUVEGARDE / CHARGEMENT)
+// ============================================================================
 
-    // D. UFO (OVNI)
-    if (model->ufo.active)
-    {
-        model->sounds.ufo_loopING = !model->ufo.exploding;
+/**
+ * @brief Vide les tableaux du pool d'ennemis et sa liste active.
+ */
+void model_clear_enemies(GameModel *model)
+{
+    EnemyPool *e = &model->sim.enemies;
+    memset(e->x, 0, MAX_ENEMIES * sizeof(float));
+    memset(e->y, 0, MAX_ENEMIES * sizeof(float));
+    memset(e->type, 0, MAX_ENEMIES * sizeof(EntityType));
+    e->live.count = 0;
+    e->explosion_count = 0;
+}
 
-        if (model->ufo.exploding)
-        {
-            model->ufo.explode_timer -= dt;
-            if (model->ufo.explode_timer <= 0)
-                model->ufo.active = false;
-        }
-        else
-        {
-            model->ufo.x += model->ufo.dx * dt;
-            if ((model->ufo.dx > 0 && model->ufo.x > GAME_WIDTH) ||
-                (model->ufo.dx < 0 && model->ufo.x < -UFO_WIDTH))
-            {
-                model->ufo.active = false;
-            }
-        }
-    }
-    else
-    {
-        model->sounds.ufo_loopING = false;
-        // Vérifie s'il reste des ennemis vivants
-        bool enemies_alive = false;
-        for (int i = 0; i < MAX_ENEMIES; i++)
-            if (model->enemies[i].active)
-            {
-                enemies_alive = true;
-                break;
-            }
+/**
+ * @brief Range un alien déjà marqué dans dying_mask dans la roue des explosions (décodage d'une vague).
+ */
+void model_add_enemy_explosion(GameModel *model, int i, int timer)
+{
+    explosion_add(&model->sim.enemies, i, timer);
+}
 
-        // Spawn aléatoire
-        if (!model->ufo.hasSpawnedThisLevel && enemies_alive && (rand() % 500 == 0))
-            spawn_ufo(model);
-    }
+/**
+ * @brief Un bonus de plus dans le registre (décodage d'une sauvegarde).
+ */
+bool model_add_powerup(GameModel *model, float x, float y, EntityType kind)
+{
+    return powerup_create(&model->sim.ecs, x, y, kind);
+}
 
-    // E. ENNEMIS
-    int active_enemies = 0;
-    bool touch_edge = false;
+/**
+ * @brief Vide les tableaux du pool de balles (pile des slots libres comprise).
+ */
+void model_clear_bullets(GameModel *model)
+{
+    bullet_pool_clear(&model->sim.bullets);
+}
 
-    for (int i = 0; i < MAX_ENEMIES; i++)
+/**
+ * @brief Reconstruit les structures dérivées après une restauration.
+ *
+ * Seules les données de base sont sauvegardées (bits d'activité des balles,
+ * masques de la formation) : listes actives, piles des slots libres et caches
+ * de la vague s'en déduisent. La liste des balles garde l'ordre des balles
+ * déjà placées par model_restore_bullet (l'ordre de résolution) ; les balles
+ * activées directement par leur bit y sont ajoutées par index croissant.
+ * Toutes les générations sont renouvelées (model_touch_all).
+ *
+ * @param model Le modèle fraîchement décodé.
+ */
+void model_rebuild_indexes(GameModel *model)
+{
+    // --- Balles ---
+    BulletPool *p = &model->sim.bullets;
+    int placed = 0;
+    for (int k = 0; k < p->live.count; k++)
     {
-        if (!model->enemies[i].active)
-            continue;
-        if (model->enemies[i].exploding)
+        int i = p->live.items[k];
+        if (bit_test(p->active, i))
         {
-            model->enemies[i].explode_timer -= dt;
-            if (model->enemies[i].explode_timer <= 0)
-                model->enemies[i].active = false;
-            continue;
+            p->live.items[placed] = (short)i;
+            p->live.pos[i] = (short)placed++;
         }
-        active_enemies++;
-        if ((model->enemies[i].x <= 0 && model->direction_enemies == -1) ||
-            (model->enemies[i].x >= GAME_WIDTH - ENEMY_WIDTH && model->direction_enemies == 1))
-            touch_edge = true;
-    }
-
-    if (active_enemies == 0 && !model->ufo.active)
-    {
-        model->level++;
-        model->sounds.play_level_up = true;
-        init_enemies(model);
-        return;
     }
-
-    if (touch_edge)
+    p->live.count = placed;
+    memset(p->free_count, 0, sizeof(p->free_count));
+    p->high_water = 0;
+    p->player_high = 0;
+    for (int i = p->capacity - 1; i >= 0; i--)
     {
-        model->direction_enemies *= -1;
-        float dy = (model->drop_direction == 1) ? ENEMY_DROP_HEIGHT : -ENEMY_DROP_HEIGHT;
-        if (model->drop_direction == 1)
-        {
-            if (++model->drop_step_count >= 3)
-                model->drop_direction = -1;
-        }
-        else
+        if (!bit_test(p->active, i))
         {
-            if (--model->drop_step_count <= 0)
-                model->drop_direction = 1;
+            free_push(p, i);
+            continue;
         }
-
-        for (int i = 0; i < MAX_ENEMIES; i++)
-            if (model->enemies[i].active && !model->enemies[i].exploding)
-            {
-                model->enemies[i].y += dy;
-                model->enemies[i].x += model->direction_enemies * 2.0f;
-            }
-    }
-    else
-    {
-        float spd = ENEMY_SPEED_BASE * model->enemy_speed_mult * model->direction_enemies;
-        for (int i = 0; i < MAX_ENEMIES; i++)
-            if (model->enemies[i].active && !model->enemies[i].exploding)
-                model->enemies[i].x += spd * dt;
+        high_water_note(p, i);
+        int at = p->live.pos[i];
+        if (at < 0 || at >= placed || p->live.items[at] != i)
+            p->live.pos[i] = -1; // Pas encore dans la liste
     }
+    for (int i = 0; i < p->high_water; i++)
+        if (bit_test(p->active, i) && p->live.pos[i] < 0)
+            active_list_add(&p->live, i);
+
+    // --- Vague (constantes relues dans la table : le niveau suffit) ---
+    Formation *f = &model->sim.formation;
+    formation_apply_level(model);
 
-    // Tirs Ennemis
-    if ((rand() % 100) < (model->level * 2))
+    // Roue des explosions : seuls restent les aliens encore marqués en explosion
+    EnemyPool *e = &model->sim.enemies;
+    int kept = 0;
+    for (int k = 0; k < e->explosion_count; k++)
     {
-        for (int k = 0; k < 10; k++)
-        {
-            int idx = rand() % MAX_ENEMIES;
-            if (model->enemies[idx].active && !model->enemies[idx].exploding)
-            {
-                spawn_bullet(model, model->enemies[idx].x + ENEMY_WIDTH / 2.0f, model->enemies[idx].y + ENEMY_HEIGHT, BULLET_SPEED * 0.6f, ENTITY_BULLET_ENEMY);
-                break;
-            }
-        }
+        e->explosions[k].mask &= f->dying_mask;
+        if (e->explosions[k].mask)
+            e->explosions[kept++] = e->explosions[k];
     }
-
-    // F. BALLES & COLLISIONS
-    for (int i = 0; i < MAX_BULLETS; i++)
+    e->explosion_count = kept;
+    model->sim.enemies.live.count = 0;
+    f->alive_count = 0;
+    for (int i = 0; i < FORMATION_SIZE; i++)
     {
-        Entity *b = &model->bullets[i];
-        if (!b->active)
-            continue;
-
-        b->y += b->dy * dt;
-        b->anim_timer += dt;
-        if (b->anim_timer > 0.1f)
-        {
-            b->anim_timer = 0;
-            b->anim_frame = (b->anim_frame + 1) % 4;
-        }
-        if (b->y < -10 || b->y > GAME_HEIGHT)
+        if (f->alive_mask & (1ULL << i))
         {
-            b->active = false;
-            continue;
-        }
-
-        // --- Boucliers ---
-        bool hit_shield = false;
-        for (int s = 0; s < MAX_SHIELDS; s++)
-        {
-            if (model->shields[s].active)
-            {
-                if (b->x < model->shields[s].x + model->shields[s].width &&
-                    b->x + b->width > model->shields[s].x &&
-                    b->y < model->shields[s].y + model->shields[s].height &&
-                    b->y + b->height > model->shields[s].y)
-                {
-                    b->active = false;
-                    hit_shield = true;
-                    model->shields[s].health--;
-                    if (model->shields[s].health <= 0)
-                        model->shields[s].active = false;
-                    break;
-                }
-            }
+            model->sim.enemies.x[i] = model_get_enemy_x(model, i);
+            model->sim.enemies.y[i] = model_get_enemy_y(model, i);
+            f->alive_count++;
         }
-        if (hit_shield)
+        else if (!(f->dying_mask & (1ULL << i)))
             continue;
+        active_list_add(&model->sim.enemies.live, i);
+    }
+    formation_update_span(f);
+    formation_update_speed(model);
 
-        if (b->type == ENTITY_BULLET_PLAYER)
-        {
-            if (model->ufo.active && !model->ufo.exploding)
-            {
-                if (b->x < model->ufo.x + model->ufo.width &&
-                    b->x + b->width > model->ufo.x &&
-                    b->y < model->ufo.y + model->ufo.height &&
-                    b->y + b->height > model->ufo.y)
-                {
-                    b->active = false;
-                    model->ufo.exploding = true;
-                    model->ufo.explode_timer = 0.5f;
-                    model->score += 100;
-                    model->lives++;
-                    model->sounds.play_invader_killed = true;
-                    continue;
-                }
-            }
-
-            for (int e = 0; e < MAX_ENEMIES; e++)
-            {
-                if (model->enemies[e].active && !model->enemies[e].exploding && check_collision(b, &model->enemies[e]))
-                {
-                    b->active = false;
-                    model->enemies[e].exploding = true;
-                    model->enemies[e].explode_timer = 0.2f;
-                    int pts = (model->enemies[e].type == ENTITY_ENEMY_TYPE_1) ? 10 : (model->enemies[e].type == ENTITY_ENEMY_TYPE_2 ? 20 : 30);
-                    model->score += pts;
-                    model->sounds.play_invader_killed = true;
-                    break;
-                }
-            }
-        }
-        else
-        {
-            if (model->player.active && model->hit_timer <= 0 && check_collision(b, &model->player))
-            {
-                b->active = false;
-                model->lives--;
-                model->hit_timer = 2.0f;
-                model->sounds.play_player_explosion = true;
-
-                if (model->lives <= 0)
-                {
-                    model->state = STATE_GAME_OVER;
-                    model->sounds.play_game_over = true;
+    // --- Vaisseau amiral (cases et BVH) ---
+    if (model->sim.boss.active)
+        boss_rebuild(&model->sim.boss);
+    model_touch_all(model); // État écrit en bloc : tous les domaines ont pu changer
+}
 
-                    model->menu_selection = 0;
-                    model->game_over_timer = 0;
-                }
-            }
-        }
+/**
+ * @brief Le slot souhaité s'il convient, sinon le premier bit libre du bloc du camp.
+ */
+int model_restore_bullet(GameModel *model, int slot, EntityType type)
+{
+    BulletPool *p = &model->sim.bullets;
+    int s = bullet_side(type);
+    int from = side_base(p, s), to = side_end(p, s);
+    if (slot < from || slot >= to || bit_test(p->active, slot))
+    {
+        for (slot = from; slot < to && bit_test(p->active, slot); slot++)
+            ;
+        if (slot == to)
+            return -1;
     }
+    bit_set(p->active, slot);
+    active_list_add(&p->live, slot);
+    high_water_note(p, slot);
+    p->type[slot] = type;
+    return slot;
+}
+
+/**
+ * @brief Tire une balle depuis l'extérieur du Modèle (bancs d'essai, scénarios).
+ */
+void model_spawn_bullet(GameModel *model, float x, float y, float dy, EntityType type)
+{
+    spawn_bullet(model, x, y, dy, type);
 }
-// ============================================================================
-//                          7. GESTION DES FICHIERS (SAUVEGARDE / CHARGEMENT)
-// ============================================================================
 
 /**
- * @brief Scanne le dossier de sauvegardes et remplit la liste des fichiers disponibles.
+ * @brief Lance la lecture de la liste des sauvegardes depuis l'index du dossier.
  *
- * Parcourt le répertoire "sauvegardes/" et collecte tous les fichiers
- * avec l'extension ".dat". Les noms sont stockés dans model->save_files[]
- * et le compteur model->save_file_count est mis à jour.
+ * Ne lit que "sauvegardes/index.txt" (cf. save_index.h) : nom, date, niveau et
+ * score de chaque sauvegarde, triés de la plus récente à la plus ancienne.
+ * Si l'index n'existe pas encore (dossier d'une ancienne version), il est
+ * reconstruit une fois en parcourant le dossier. La lecture se fait sur un
+ * thread : le menu s'ouvre aussitôt et la liste arrive par poll_save_scan.
  *
  * @param model Le modèle de jeu dont la liste de sauvegardes sera mise à jour.
- * @note Limite de MAX_SAVE_FILES fichiers maximum.
+ * @note Seules les MAX_SAVE_FILES plus récentes sont listées.
  */
 void model_scan_saves(GameModel *model)
 {
-    model->save_file_count = 0;
-
-    // Ouverture du dossier (Standard POSIX/Linux)
-    DIR *d = opendir("sauvegardes");
-    if (!d)
-        return; // Le dossier n'existe peut-être pas encore
-
-    struct dirent *dir;
-    while ((dir = readdir(d)) != NULL)
-    {
-        // On ignore les dossiers cachés (. et ..)
-        if (dir->d_name[0] == '.')
-            continue;
+    model->ui.save_file_count = 0;
+    model->ui.save_scan_pending = save_index_scan_start("sauvegardes", MAX_SAVE_FILES);
+    if (model->ui.save_scan_pending)
+        return;
 
-        // On cherche uniquement les fichiers finissant par .dat
-        if (strstr(dir->d_name, ".dat"))
-        {
-            if (model->save_file_count < MAX_SAVE_FILES)
-            {
-                // On copie le nom (ex: "partie1.dat")
-                snprintf(model->save_files[model->save_file_count], 256, "%s", dir->d_name);
-                model->save_file_count++;
-            }
-        }
-    }
-    closedir(d);
+    // Sans thread de recherche : lecture directe, comme avant
+    int n = save_index_read("sauvegardes", model->ui.save_files, MAX_SAVE_FILES);
+    if (n < 0)
+        n = save_index_rebuild("sauvegardes", model->ui.save_files, MAX_SAVE_FILES);
+    model->ui.save_file_count = (n < 0) ? 0 : n;
 }
 
 /**
  * @brief Sauvegarde l'état actuel du jeu dans un fichier binaire.
  *
- * Écrit la structure GameModel complète dans un fichier du dossier
- * "sauvegardes/". La sauvegarde est effectuée en mode binaire (dump mémoire).
+ * L'état de jeu est encodé au format versionné de save.h (quelques centaines
+ * d'octets), puis confié au thread d'écriture : aucun accès disque n'a lieu
+ * dans la boucle de jeu. Le résultat est relevé par model_update (STATE_SAVING).
  *
  * @param model Le modèle de jeu à sauvegarder.
  * @param filename Le nom du fichier de sauvegarde (ex: "partie1.dat").
+ * @return false si l'encodage ou la prise en charge par le thread a échoué.
  * @note Le dossier "sauvegardes" est créé automatiquement s'il n'existe pas.
  */
-void model_save_named(const GameModel *model, const char *filename)
+bool model_save_named(const GameModel *model, const char *filename)
 {
-    // On s'assure que le dossier existe (Linux : 0777 = permissions complètes)
-    mkdir("sauvegardes", 0777);
-
-    char path[128];
-    snprintf(path, sizeof(path), "sauvegardes/%s", filename);
-
-    FILE *f = fopen(path, "wb");
-    if (f)
+    static uint8_t buf[SAVE_MAX_SIZE]; // Trop gros pour la pile (pool de balles maximal)
+    size_t len = save_encode(model, buf, sizeof(buf));
+    if (len == 0 || !save_writer_submit("sauvegardes", filename, buf, len))
     {
-        fwrite(model, sizeof(GameModel), 1, f);
-        fclose(f);
-        printf("[SYSTEM] Sauvegarde reussie : %s\n", path);
-    }
-    else
-    {
-        fprintf(stderr, "[ERREUR] Impossible d'ecrire dans %s\n", path);
+        logger_write(LOG_ERROR, "[ERREUR] Impossible de lancer la sauvegarde : %s\n", filename);
+        return false;
     }
+    return true;
 }
 
 /**
  * @brief Charge une sauvegarde depuis un fichier binaire.
  *
- * Lit le fichier spécifié et restaure l'état complet du jeu.
- * Après le chargement, l'état est automatiquement mis sur STATE_PLAYING
- * et les timers visuels sont réinitialisés.
+ * Projette le fichier en mémoire (mmap), le valide en place puis le décode
+ * directement dans le modèle (cf. save_decode). Après le chargement, l'état est automatiquement mis
+ * sur STATE_PLAYING et les timers visuels sont réinitialisés.
  *
  * @param model Le modèle de jeu à restaurer.
  * @param filename Le nom du fichier de sauvegarde (ex: "partie1.dat").
- * @return true si le chargement a réussi, false sinon (fichier inexistant ou corrompu).
+ * @return true si le chargement a réussi, false sinon (fichier inexistant, corrompu ou d'un ancien format).
  */
 bool model_load_named(GameModel *model, const char *filename)
 {
     char path[128];
     snprintf(path, sizeof(path), "sauvegardes/%s", filename);
 
-    FILE *f = fopen(path, "rb");
-    if (!f)
-        return false;
+    // Journal d'autosave : dernier point de reprise + deltas
+    if (strcmp(filename, AUTOSAVE_FILE) == 0)
+    {
+        if (!autosave_recover(model, path))
+        {
+            logger_write(LOG_ERROR, "[ERREUR] Journal d'autosave illisible.\n");
+            return false;
+        }
+        model->sim.state = STATE_PLAYING;
+        model->sim.hit_timer = 0;
+        memset(&model->ui.sounds, 0, sizeof(SoundState));
+        logger_write(LOG_INFO, "[SYSTEM] Reprise de l'autosave : %s\n", path);
+        return true;
+    }
 
-    GameModel temp;
-    size_t res = fread(&temp, sizeof(GameModel), 1, f);
-    fclose(f);
+    // Projection en lecture seule : validation et décodage directement sur les octets du fichier
+    SaveMapping map;
+    if (!save_map_file(path, &map))
+    {
+        logger_write(LOG_ERROR, "[ERREUR] Fichier de sauvegarde introuvable ou de taille invalide.\n");
+        return false;
+    }
+    bool ok = save_decode(model, map.data, map.len);
+    save_unmap_file(&map);
 
-    if (res == 1)
+    if (ok)
     {
-        *model = temp;
-        model->state = STATE_PLAYING;
-        model->hit_timer = 0;
-        memset(&model->sounds, 0, sizeof(SoundState));
-        printf("[SYSTEM] Chargement reussi : %s\n", path);
+        model->sim.state = STATE_PLAYING;
+        model->sim.hit_timer = 0;
+        memset(&model->ui.sounds, 0, sizeof(SoundState));
+        level_start_clear(model); // Partie chargée en cours de niveau : rien à réessayer avant le suivant
+        logger_write(LOG_INFO, "[SYSTEM] Chargement reussi : %s\n", path);
         return true;
     }
 
-    printf("[ERREUR] Fichier de sauvegarde corrompu.\n");
+    logger_write(LOG_ERROR, "[ERREUR] Fichier de sauvegarde corrompu ou d'un ancien format.\n");
     return false;
-}
\ No newline at end of file
+}
+
+// ============================================================================
+//                          10. INSTANTANÉS DE SIMULATION
+// ============================================================================
+
+/**
+ * @brief Alloue un instantané à la capacité du modèle (état à zéro).
+ */
+ModelSnapshot *model_snapshot_create(const GameModel *model)
+{
+    ModelSnapshot *snap = calloc(1, sizeof(ModelSnapshot) + (model->block_size - arena_offset()));
+    if (snap)
+        snap->state.bullets.capacity = model->sim.bullets.capacity;
+    return snap;
+}
+
+/**
+ * @brief Libère un instantané.
+ */
+void model_snapshot_free(ModelSnapshot *snap)
+{
+    free(snap);
+}
+
+/**
+ * @brief Taille de l'instantané, déduite de sa capacité.
+ */
+size_t model_snapshot_size(const ModelSnapshot *snap)
+{
+    return sizeof(ModelSnapshot) + arena_layout(NULL, snap->state.bullets.capacity, NULL, NULL);
+}
+
+/**
+ * @brief Pire cas d'un delta : une plage par octet modifié, en-têtes compris.
+ */
+size_t model_diff_max_size(const ModelSnapshot *snap)
+{
+    return CODEC_DIFF_BOUND(model_snapshot_size(snap));
+}
+
+/**
+ * @brief Copie la partie simulée du modèle dans un instantané préalloué.
+ *
+ * SimState est recopié d'un bloc (octets de remplissage compris : ils ne
+ * changent pas d'un tick à l'autre, et n'apparaissent donc pas dans les
+ * deltas). Les pointeurs des pools y sont remis à NULL et l'arène est copiée d'un bloc.
+ */
+bool model_snapshot(const GameModel *model, ModelSnapshot *snap)
+{
+    if (snap->state.bullets.capacity != model->sim.bullets.capacity)
+        return false;
+    SimState *st = &snap->state;
+    memcpy(st, &model->sim, sizeof(SimState));
+    arena_layout(NULL, model->sim.bullets.capacity, &st->bullets, &st->enemies);
+    memcpy(snap->arrays, (const uint8_t *)model + arena_offset(), model->block_size - arena_offset());
+    return true;
+}
+
+/**
+ * @brief Restaure la partie simulée du modèle (menus, fichiers et audio intacts).
+ *
+ * Les listes actives et la pile des slots libres font partie de l'instantané :
+ * aucune reconstruction n'est nécessaire (contrairement à save_decode). Les
+ * pools repris de l'instantané sont recâblés sur l'arène du modèle.
+ */
+bool model_restore(GameModel *model, const ModelSnapshot *snap)
+{
+    if (snap->state.bullets.capacity != model->sim.bullets.capacity)
+        return false;
+    memcpy(&model->sim, &snap->state, sizeof(SimState));
+    model_link_arena(model);
+    memcpy((uint8_t *)model + arena_offset(), snap->arrays, model->block_size - arena_offset());
+    model_touch_all(model);
+    return true;
+}
+
+/**
+ * @brief Encode les octets qui diffèrent entre deux instantanés.
+ */
+bool model_diff(const ModelSnapshot *from, const ModelSnapshot *to, uint8_t *buf, size_t cap, size_t *len)
+{
+    const size_t n = model_snapshot_size(from);
+    if (model_snapshot_size(to) != n)
+        return false;
+    return codec_diff(from, to, n, buf, cap, len);
+}
+
+/**
+ * @brief Applique à `snap` un delta produit par model_diff depuis ce même instantané.
+ */
+bool model_apply_diff(ModelSnapshot *snap, const uint8_t *diff, size_t len)
+{
+    return codec_apply_diff(snap, model_snapshot_size(snap), diff, len);
+}
@@ -0,0 +1,1413 @@
+/**
+ * @file net.c
+ * @brief Implémentation du serveur UDP et des clients d'affichage.
+ *
+ * Des deux côtés, un thread réseau possède le socket : il lit, décode et
+ * répond, tandis que l'autre thread (simulation du serveur, rendu du client)
+ * ne voit que des instantanés complets (snapring.h) et des files de commandes
+ * (spsc.h). Aucun verrou : un afflux de paquets occupe le thread réseau, jamais
+ * la boucle du jeu.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour getaddrinfo, sigaction, select et pthread).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "net.h"
+#include "broadcast.h"
+#include "codec.h"
+#include "headless.h"
+#include "netframe.h"
+#include "netpredict.h"
+#include "snapring.h"
+#include "spsc.h"
+#include "utils.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. PAQUETS
+// ============================================================================
+
+/** @name Types de paquets */
+///@{
+#define PKT_HELLO 1 ///< Client : connexion.
+#define PKT_INPUT 2 ///< Client : commandes et accusé d'image.
+#define PKT_BYE 3   ///< Client : départ.
+#define PKT_SNAP 4  ///< Serveur : image (delta).
+///@}
+
+#define PKT_HEADER 4                                        ///< "SI" | version | type.
+#define SNAP_HEADER (PKT_HEADER + 13)                       ///< En-tête de SNAP, delta exclu.
+#define INPUT_HEADER (PKT_HEADER + 9)                       ///< En-tête d'INPUT, commandes exclues.
+#define PKT_MAX (SNAP_HEADER + CODEC_DIFF_BOUND(NET_FRAME_SIZE)) ///< Plus grand paquet possible.
+
+/** @name Threads réseau */
+///@{
+#define NET_RECV_BURST 256      ///< Paquets lus d'affilée au plus, avant de reprendre les images à envoyer.
+#define NET_POLL_INTERVAL 0.002 ///< Attente maximale du socket (s) : délai ajouté au plus à une image.
+#define NET_COMMAND_RING 256    ///< Commandes en transit entre les deux threads (puissance de 2).
+///@}
+
+/** @name Client */
+///@{
+#define NET_RTT_SAMPLES 16 ///< Mesures d'aller-retour gardées (l'estimation est la plus petite).
+#define NET_LAG_QUEUE 64   ///< Paquets retenus au plus, dans chaque sens, par la latence simulée.
+///@}
+
+/** @brief Demande d'arrêt (SIGINT), relevée par la boucle du serveur. */
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_sigint(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/**
+ * @brief Écrit l'en-tête commun d'un paquet.
+ */
+static void put_header(uint8_t *p, uint8_t type)
+{
+    p[0] = 'S';
+    p[1] = 'I';
+    p[2] = NET_VERSION;
+    p[3] = type;
+}
+
+/**
+ * @brief Type d'un paquet reçu, ou 0 s'il n'est pas de ce protocole.
+ */
+static int packet_type(const uint8_t *p, ssize_t len)
+{
+    if (len < PKT_HEADER || p[0] != 'S' || p[1] != 'I' || p[2] != NET_VERSION)
+        return 0;
+    return p[3];
+}
+
+/**
+ * @brief Indique si une commande reçue peut être appliquée (CMD_EXIT n'est jamais transmis).
+ */
+static bool command_valid(uint8_t c)
+{
+    return (c != CMD_NONE && c != CMD_EXIT && c <= CMD_BACKSPACE) || (c >= CMD_HELD && c <= CMD_HELD_LAST);
+}
+
+/**
+ * @brief Emplacement d'une image dans un historique (les ticks envoyés sont des multiples de NET_SEND_EVERY).
+ */
+static int history_slot(uint32_t tick)
+{
+    return (int)((tick / NET_SEND_EVERY) % NET_HISTORY);
+}
+
+/**
+ * @brief Attend qu'un socket soit lisible, au plus jusqu'à `deadline` (horloge de utils_get_time).
+ *
+ * @return true si des données sont disponibles.
+ */
+static bool wait_readable(int fd, double deadline)
+{
+    double left = deadline - utils_get_time();
+    if (left < 0.0)
+        left = 0.0;
+    struct timeval tv;
+    tv.tv_sec = (time_t)left;
+    tv.tv_usec = (suseconds_t)((left - (double)tv.tv_sec) * 1e6);
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(fd, &set);
+    return select(fd + 1, &set, NULL, NULL, &tv) > 0;
+}
+
+// ============================================================================
+//                          2. SERVEUR
+// ============================================================================
+
+/**
+ * @brief Un client connu du serveur.
+ */
+typedef struct
+{
+    bool used;                 ///< Emplacement occupé.
+    struct sockaddr_in addr;   ///< Adresse du client.
+    double last_seen;          ///< Dernier paquet reçu (horloge de utils_get_time).
+    uint32_t acked;            ///< Dernière image accusée (0 : aucune).
+    uint32_t next_seq;         ///< Numéro de la prochaine commande attendue.
+    long long joined;          ///< Ordre d'arrivée (promotion du plus ancien spectateur).
+    bool player;               ///< Ses commandes pilotent la partie.
+} NetClient;
+
+/**
+ * @brief État du serveur.
+ *
+ * La simulation (thread appelant) ne touche qu'au modèle, à la diffusion et
+ * aux deux files ; tout le reste appartient au thread réseau.
+ */
+typedef struct
+{
+    int fd;                                  ///< Socket UDP.
+    GameModel *model;                        ///< Partie qui fait autorité (simulation).
+    Broadcast *broadcast;                    ///< Diffusion aux spectateurs (simulation ; NULL : aucune).
+    NetEncoder encoder;                      ///< Fiches de tir des images capturées (simulation).
+    NetFrame frames[SNAPRING_SLOTS];         ///< Stockage de `snapshots`.
+    SnapRing snapshots;                      ///< Images capturées, de la simulation au thread réseau.
+    uint8_t command_storage[NET_COMMAND_RING]; ///< Stockage de `commands`.
+    SpscRing commands;                       ///< Commandes du joueur, du thread réseau à la simulation.
+    pthread_t thread;                        ///< Thread réseau.
+    bool stop;                               ///< Arrêt du thread réseau (atomique).
+    NetClient clients[NET_MAX_CLIENTS];      ///< Clients connectés.
+    NetFrame history[NET_HISTORY];           ///< Dernières images envoyées (bases des deltas).
+    uint32_t tick;                           ///< Dernière image envoyée (0 : aucune encore).
+    long long joined;                        ///< Compteur d'arrivées.
+    NetStats stats;                          ///< Bilan du thread réseau.
+} NetServer;
+
+static bool same_addr(const struct sockaddr_in *a, const struct sockaddr_in *b)
+{
+    return a->sin_addr.s_addr == b->sin_addr.s_addr && a->sin_port == b->sin_port;
+}
+
+static NetClient *find_client(NetServer *srv, const struct sockaddr_in *addr)
+{
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+        if (srv->clients[i].used && same_addr(&srv->clients[i].addr, addr))
+            return &srv->clients[i];
+    return NULL;
+}
+
+/**
+ * @brief Donne la main au plus ancien client s'il n'y a plus de joueur.
+ */
+static void elect_player(NetClient *clients, int count)
+{
+    NetClient *oldest = NULL;
+    for (int i = 0; i < count; i++)
+    {
+        NetClient *c = &clients[i];
+        if (!c->used)
+            continue;
+        if (c->player)
+            return;
+        if (!oldest || c->joined < oldest->joined)
+            oldest = c;
+    }
+    if (oldest)
+    {
+        oldest->player = true;
+        printf("[SERVEUR] %s:%d prend la main\n", inet_ntoa(oldest->addr.sin_addr), ntohs(oldest->addr.sin_port));
+    }
+}
+
+static void drop_client(NetClient *clients, int count, NetClient *c, const char *why)
+{
+    printf("[SERVEUR] %s:%d %s\n", inet_ntoa(c->addr.sin_addr), ntohs(c->addr.sin_port), why);
+    c->used = false;
+    c->player = false;
+    elect_player(clients, count);
+}
+
+/**
+ * @brief Ramène la partie au menu principal (le joueur a demandé à quitter).
+ */
+static void back_to_menu(GameModel *model)
+{
+    model->ui.pending_quit = false;
+    model->sim.state = STATE_MENU;
+    model->ui.menu_selection = 0;
+    model_touch(model, MODEL_GEN_MENU);
+}
+
+/**
+ * @brief Lit un paquet INPUT : accusé d'image, puis commandes nouvelles du joueur dans `out`.
+ *
+ * @param tick Dernière image envoyée (borne des accusés).
+ * @return Nombre de commandes à passer à la simulation (au plus 255), -1 si le paquet est mal formé.
+ */
+static int read_input(NetClient *c, uint32_t tick, const uint8_t *p, ssize_t len, uint8_t *out)
+{
+    if (len < INPUT_HEADER)
+        return -1;
+    uint32_t ack = get32(p + PKT_HEADER);
+    uint32_t first = get32(p + PKT_HEADER + 4);
+    int count = p[PKT_HEADER + 8];
+    if (len < INPUT_HEADER + count)
+        return -1;
+    if (ack > c->acked && ack <= tick)
+        c->acked = ack;
+
+    // Déjà reçues : ignorées. Un trou ne vient que d'une file du client qui a débordé :
+    // les commandes perdues le restent, on reprend à la plus ancienne qu'il garde.
+    if ((int32_t)(first - c->next_seq) > 0)
+        c->next_seq = first;
+    int n = 0;
+    for (int k = 0; k < count; k++)
+    {
+        uint32_t seq = first + (uint32_t)k;
+        if (seq != c->next_seq)
+            continue;
+        uint8_t cmd = p[INPUT_HEADER + k];
+        c->next_seq++;
+        if (c->player && command_valid(cmd))
+            out[n++] = cmd;
+    }
+    return n;
+}
+
+/**
+ * @brief Passe à la simulation les commandes nouvelles d'un paquet INPUT.
+ */
+static void handle_input(NetServer *srv, NetClient *c, const uint8_t *p, ssize_t len)
+{
+    uint8_t cmds[256];
+    int n = read_input(c, srv->tick, p, len, cmds);
+    if (n < 0)
+        srv->stats.rejected++;
+    for (int k = 0; k < n; k++)
+        spsc_push(&srv->commands, &cmds[k]); // File pleine : commande perdue (compteur `dropped`)
+}
+
+/**
+ * @brief Lit les paquets en attente, au plus NET_RECV_BURST.
+ */
+static void server_receive(NetServer *srv, double now)
+{
+    uint8_t p[PKT_MAX];
+    for (int n = 0; n < NET_RECV_BURST; n++)
+    {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = recvfrom(srv->fd, p, sizeof(p), MSG_DONTWAIT, (struct sockaddr *)&from, &from_len);
+        if (len < 0)
+            return;
+        int type = packet_type(p, len);
+        NetClient *c = find_client(srv, &from);
+        if (type == PKT_HELLO && !c)
+        {
+            for (int i = 0; i < NET_MAX_CLIENTS && !c; i++)
+                if (!srv->clients[i].used)
+                    c = &srv->clients[i];
+            if (!c)
+                continue; // Serveur plein : le client finira par abandonner
+            memset(c, 0, sizeof(*c));
+            c->used = true;
+            c->addr = from;
+            c->joined = srv->joined++;
+            srv->stats.clients++;
+            printf("[SERVEUR] %s:%d connecte\n", inet_ntoa(from.sin_addr), ntohs(from.sin_port));
+            elect_player(srv->clients, NET_MAX_CLIENTS);
+        }
+        if (!c)
+        {
+            if (type != PKT_BYE) // BYE répété après le départ
+                srv->stats.rejected++;
+            continue;
+        }
+        c->last_seen = now;
+        if (type == PKT_INPUT)
+            handle_input(srv, c, p, len);
+        else if (type == PKT_BYE)
+            drop_client(srv->clients, NET_MAX_CLIENTS, c, "deconnecte");
+        else if (type != PKT_HELLO)
+            srv->stats.rejected++;
+    }
+}
+
+/**
+ * @brief Envoie l'image `tick` de l'historique à chaque client, en delta depuis son dernier accusé.
+ */
+static void send_frame(int fd, const NetFrame *history, uint32_t tick, const NetClient *clients, int count,
+                       NetStats *stats)
+{
+    static const NetFrame zero;
+    const NetFrame *frame = &history[history_slot(tick)];
+    uint8_t p[PKT_MAX];
+
+    for (int i = 0; i < count; i++)
+    {
+        const NetClient *c = &clients[i];
+        if (!c->used)
+            continue;
+        // Base encore dans l'historique (et pas écrasée par un tour complet), sinon image complète
+        const NetFrame *base = &history[history_slot(c->acked)];
+        uint32_t base_tick = c->acked;
+        if (base_tick == 0 || tick - base_tick >= NET_HISTORY * NET_SEND_EVERY || netframe_tick(base) != base_tick)
+        {
+            base = &zero;
+            base_tick = 0;
+        }
+        size_t len;
+        if (!codec_diff(base->bytes, frame->bytes, NET_FRAME_SIZE, p + SNAP_HEADER, sizeof(p) - SNAP_HEADER, &len))
+            continue;
+        put_header(p, PKT_SNAP);
+        put32(p + PKT_HEADER, tick);
+        put32(p + PKT_HEADER + 4, base_tick);
+        put32(p + PKT_HEADER + 8, c->next_seq);
+        p[PKT_HEADER + 12] = c->player ? NET_ROLE_PLAYER : NET_ROLE_SPECTATOR;
+        ssize_t sent = sendto(fd, p, SNAP_HEADER + len, 0, (const struct sockaddr *)&c->addr, sizeof(c->addr));
+        if (sent > 0)
+        {
+            stats->bytes += sent;
+            stats->snapshots++;
+            if (base_tick == 0)
+                stats->keyframes++;
+        }
+    }
+}
+
+/**
+ * @brief Boucle du thread réseau : paquets reçus, puis envoi de la dernière image publiée.
+ */
+static void *server_main(void *arg)
+{
+    NetServer *srv = arg;
+    while (!__atomic_load_n(&srv->stop, __ATOMIC_ACQUIRE))
+    {
+        if (wait_readable(srv->fd, utils_get_time() + NET_POLL_INTERVAL))
+            server_receive(srv, utils_get_time());
+
+        uint32_t tick;
+        const NetFrame *frame = snapring_acquire(&srv->snapshots, &tick);
+        if (frame && tick != srv->tick)
+        {
+            srv->history[history_slot(tick)] = *frame;
+            srv->tick = tick;
+            send_frame(srv->fd, srv->history, srv->tick, srv->clients, NET_MAX_CLIENTS, &srv->stats);
+        }
+
+        double now = utils_get_time();
+        for (int i = 0; i < NET_MAX_CLIENTS; i++)
+            if (srv->clients[i].used && now - srv->clients[i].last_seen > NET_TIMEOUT)
+                drop_client(srv->clients, NET_MAX_CLIENTS, &srv->clients[i], "ne repond plus");
+    }
+    return NULL;
+}
+
+/**
+ * @brief Fait tourner le serveur jusqu'à SIGINT ou au bout de `seconds`.
+ */
+bool net_run_server(int port, double seconds, uint64_t seed, int broadcast_port, NetStats *out)
+{
+    NetServer *srv = calloc(1, sizeof(NetServer));
+    if (!srv)
+        return false;
+    srv->model = model_init();
+    if (!srv->model)
+    {
+        free(srv);
+        return false;
+    }
+    // Les spectateurs simulent la partie : elle doit donner le même état sur toutes les machines
+    if (broadcast_port > 0)
+        srv->model->sim.fixed_point = true;
+    if (srv->model->sim.bullets.capacity > NET_MAX_BULLETS)
+    {
+        fprintf(stderr, "[ERREUR] Serveur : %d balles au plus (--bullets)\n", NET_MAX_BULLETS);
+        model_free(srv->model);
+        free(srv);
+        return false;
+    }
+    model_rng_seed(srv->model, seed);
+
+    srv->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (srv->fd < 0 || bind(srv->fd, (const struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "[ERREUR] Serveur : port UDP %d indisponible (%s)\n", port, strerror(errno));
+        if (srv->fd >= 0)
+            close(srv->fd);
+        model_free(srv->model);
+        free(srv);
+        return false;
+    }
+    if (broadcast_port > 0 && !(srv->broadcast = broadcast_open(broadcast_port, srv->model)))
+    {
+        close(srv->fd);
+        model_free(srv->model);
+        free(srv);
+        return false;
+    }
+    snapring_init(&srv->snapshots, srv->frames, sizeof(NetFrame));
+    spsc_init(&srv->commands, srv->command_storage, 1, NET_COMMAND_RING);
+    if (pthread_create(&srv->thread, NULL, server_main, srv) != 0)
+    {
+        fprintf(stderr, "[ERREUR] Serveur : thread reseau impossible\n");
+        broadcast_close(srv->broadcast, NULL);
+        close(srv->fd);
+        model_free(srv->model);
+        free(srv);
+        return false;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_sigint;
+    sigemptyset(&sa.sa_mask);
+    struct sigaction old_sa;
+    sigaction(SIGINT, &sa, &old_sa);
+    stop_requested = 0;
+
+    printf("[SERVEUR] Ecoute sur le port UDP %d (%d images/s, graine 0x%llx)\n", port, TARGET_FPS / NET_SEND_EVERY,
+           (unsigned long long)seed);
+    if (srv->broadcast)
+        printf("[SERVEUR] Diffusion aux spectateurs sur le port UDP %d\n", broadcast_port);
+
+    const double dt = 1.0 / TARGET_FPS;
+    double start = utils_get_time();
+    double next = start + dt;
+    uint32_t tick = 0;
+    NetStats sim_stats;
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    while (!stop_requested && (seconds <= 0.0 || utils_get_time() - start < seconds))
+    {
+        // --- A. Commandes du joueur reçues par le thread réseau ---
+        uint8_t cmd;
+        while (spsc_pop(&srv->commands, &cmd))
+        {
+            bool stay = model_dispatch_command(srv->model, (GameCommand)cmd);
+            broadcast_command(srv->broadcast, (GameCommand)cmd);
+            if (!stay)
+            {
+                back_to_menu(srv->model);
+                broadcast_menu(srv->broadcast);
+            }
+            sim_stats.commands++;
+        }
+
+        // --- B. Simulation (pas fixe) ---
+        if (srv->model->ui.pending_quit)
+        {
+            back_to_menu(srv->model);
+            broadcast_menu(srv->broadcast);
+        }
+        model_update(srv->model, dt);
+        tick++;
+        sim_stats.ticks++;
+        broadcast_tick(srv->broadcast, srv->model);
+        broadcast_poll(srv->broadcast);
+
+        // --- C. Image publiée pour le thread réseau, capturée en place ---
+        if (tick % NET_SEND_EVERY == 0)
+        {
+            netframe_capture(snapring_write_slot(&srv->snapshots), srv->model, tick, &srv->encoder);
+            snapring_publish(&srv->snapshots, tick);
+        }
+
+        // Échéance suivante (après un gros retard, on repart de maintenant)
+        double now = utils_get_time();
+        next += dt;
+        if (now - next > 0.25)
+            next = now + dt;
+        utils_sleep_until(next);
+    }
+
+    __atomic_store_n(&srv->stop, true, __ATOMIC_RELEASE);
+    pthread_join(srv->thread, NULL);
+    sigaction(SIGINT, &old_sa, NULL);
+    close(srv->fd);
+    if (srv->broadcast)
+    {
+        BroadcastStats bstats;
+        broadcast_close(srv->broadcast, &bstats);
+        broadcast_print_stats(&bstats, "DIFFUSION");
+    }
+    srv->stats.elapsed = utils_get_time() - start;
+    srv->stats.ticks = sim_stats.ticks;
+    srv->stats.commands = sim_stats.commands;
+    srv->stats.skipped = srv->snapshots.overwritten;
+    srv->stats.dropped = srv->commands.dropped;
+    if (out)
+        *out = srv->stats;
+    model_free(srv->model);
+    free(srv);
+    return true;
+}
+
+// ============================================================================
+//                          3. CLIENT
+// ============================================================================
+
+/**
+ * @brief Image décodée par le thread réseau, avec ce que le rendu doit savoir de sa réception.
+ */
+typedef struct
+{
+    NetFrame frame;  ///< Image complète.
+    double received; ///< Instant de réception (après la latence simulée).
+    double rtt;      ///< Aller-retour estimé à cet instant (s, 0 : pas encore mesuré).
+    int role;        ///< Rôle annoncé avec l'image (NET_ROLE_PLAYER...).
+} NetArrival;
+
+/**
+ * @brief Paquet retenu par la latence simulée (SPACE_INVADERS_NET_LAG).
+ */
+typedef struct
+{
+    double due;            ///< Instant de passage.
+    size_t len;            ///< Taille.
+    uint8_t data[PKT_MAX]; ///< Contenu.
+} NetDelayed;
+
+/**
+ * @brief File de paquets retenus, par échéance croissante (latence constante).
+ */
+typedef struct
+{
+    NetDelayed packets[NET_LAG_QUEUE]; ///< File circulaire.
+    int head, count;                   ///< Position du plus ancien, nombre de paquets.
+} NetDelayQueue;
+
+/**
+ * @brief État du client.
+ *
+ * Le rendu (thread appelant) ne touche qu'aux deux files ; tout le reste
+ * appartient au thread réseau.
+ */
+typedef struct
+{
+    int fd;                                    ///< Socket UDP connecté au serveur.
+    NetArrival frames[SNAPRING_SLOTS];         ///< Stockage de `snapshots`.
+    SnapRing snapshots;                        ///< Images décodées, du thread réseau au rendu.
+    uint8_t command_storage[NET_COMMAND_RING]; ///< Stockage de `commands`.
+    SpscRing commands;                         ///< Commandes de la Vue, du rendu au thread réseau.
+    pthread_t thread;                          ///< Thread réseau.
+    bool stop;                                 ///< Arrêt du thread réseau (atomique).
+    NetFrame history[NET_HISTORY];             ///< Images reçues (bases des deltas du serveur).
+    uint32_t last_tick;                        ///< Dernière image décodée (0 : aucune).
+    uint8_t pending[NET_INPUT_WINDOW];         ///< Commandes non accusées (file circulaire).
+    double queued_at[NET_INPUT_WINDOW];        ///< Instant de mise en file de chaque commande (aller-retour).
+    uint32_t first_seq;                        ///< Numéro de pending[first_seq % NET_INPUT_WINDOW].
+    uint32_t next_seq;                         ///< Numéro de la prochaine commande.
+    int last_held;                             ///< Dernier état maintenu envoyé (-1 : aucun).
+    int role;                                  ///< Rôle annoncé par le serveur (-1 : inconnu).
+    uint32_t match;                            ///< Partie demandée au serveur multi-parties (HELLO).
+    double hello_at;                           ///< Dernier HELLO envoyé (premier aller-retour).
+    double rtt_samples[NET_RTT_SAMPLES];       ///< Derniers allers-retours mesurés (file circulaire).
+    int rtt_count;                             ///< Mesures prises au total.
+    double rtt;                                ///< Aller-retour estimé (s, 0 : inconnu).
+    double lag;                                ///< Latence simulée dans chaque sens (s).
+    NetDelayQueue outbox;                      ///< Paquets à envoyer, retenus par la latence simulée.
+    NetDelayQueue inbox;                       ///< Paquets reçus, retenus par la latence simulée.
+    NetStats stats;                            ///< Bilan du thread réseau.
+} NetClientState;
+
+/**
+ * @brief Retient un paquet jusqu'à `due` (file pleine : perdu, comme sur le réseau).
+ */
+static void delay_push(NetDelayQueue *q, const uint8_t *p, size_t len, double due)
+{
+    if (q->count == NET_LAG_QUEUE)
+        return;
+    NetDelayed *d = &q->packets[(q->head + q->count) % NET_LAG_QUEUE];
+    d->due = due;
+    d->len = len;
+    memcpy(d->data, p, len);
+    q->count++;
+}
+
+/**
+ * @brief Plus ancien paquet retenu dont l'échéance est passée (NULL : aucun), retiré de la file.
+ *
+ * Le paquet rendu reste valide jusqu'au prochain delay_push.
+ */
+static const NetDelayed *delay_pop(NetDelayQueue *q, double now)
+{
+    if (q->count == 0 || q->packets[q->head].due > now)
+        return NULL;
+    const NetDelayed *d = &q->packets[q->head];
+    q->head = (q->head + 1) % NET_LAG_QUEUE;
+    q->count--;
+    return d;
+}
+
+static void client_send(NetClientState *cl, const uint8_t *p, size_t len)
+{
+    if (cl->lag > 0.0)
+    {
+        delay_push(&cl->outbox, p, len, utils_get_time() + cl->lag);
+        return;
+    }
+    (void)send(cl->fd, p, len, 0); // Une perte est rattrapée par le paquet suivant
+}
+
+/**
+ * @brief Ajoute une mesure d'aller-retour ; l'estimation est la plus petite des dernières.
+ *
+ * Une mesure compte en plus l'attente de l'image suivante du serveur (au
+ * plus NET_SEND_EVERY ticks) : la plus petite en est la plus proche du
+ * délai du réseau seul.
+ */
+static void client_rtt_sample(NetClientState *cl, double sample)
+{
+    cl->rtt_samples[cl->rtt_count++ % NET_RTT_SAMPLES] = sample;
+    int n = cl->rtt_count < NET_RTT_SAMPLES ? cl->rtt_count : NET_RTT_SAMPLES;
+    cl->rtt = sample;
+    for (int k = 0; k < n; k++)
+        if (cl->rtt_samples[k] < cl->rtt)
+            cl->rtt = cl->rtt_samples[k];
+}
+
+/**
+ * @brief Ajoute une commande à renvoyer jusqu'à son accusé (la plus ancienne saute si la file déborde).
+ */
+static void client_queue(NetClientState *cl, GameCommand cmd)
+{
+    if (cmd == CMD_NONE || cmd == CMD_EXIT)
+        return;
+    if (cmd >= CMD_HELD && cmd <= CMD_HELD_LAST)
+    {
+        // Les Vues répètent l'état maintenu à chaque image : seul un changement est transmis
+        if ((int)cmd == cl->last_held)
+            return;
+        cl->last_held = (int)cmd;
+    }
+    if (cl->next_seq - cl->first_seq >= NET_INPUT_WINDOW)
+        cl->first_seq++;
+    cl->pending[cl->next_seq % NET_INPUT_WINDOW] = (uint8_t)cmd;
+    cl->queued_at[cl->next_seq % NET_INPUT_WINDOW] = utils_get_time();
+    cl->next_seq++;
+    cl->stats.commands++;
+}
+
+/**
+ * @brief Envoie les commandes non accusées et l'accusé de la dernière image.
+ */
+static void client_send_input(NetClientState *cl)
+{
+    uint8_t p[INPUT_HEADER + NET_INPUT_WINDOW];
+    uint32_t count = cl->next_seq - cl->first_seq;
+    put_header(p, PKT_INPUT);
+    put32(p + PKT_HEADER, cl->last_tick);
+    put32(p + PKT_HEADER + 4, cl->first_seq);
+    p[PKT_HEADER + 8] = (uint8_t)count;
+    for (uint32_t k = 0; k < count; k++)
+        p[INPUT_HEADER + k] = cl->pending[(cl->first_seq + k) % NET_INPUT_WINDOW];
+    client_send(cl, p, INPUT_HEADER + count);
+}
+
+/**
+ * @brief Décode une image reçue dans l'emplacement libre du passage, et la publie.
+ *
+ * Son accusé des commandes donne une mesure d'aller-retour : depuis la mise
+ * en file de la dernière commande accusée (depuis le HELLO pour la première image).
+ *
+ * @param now Instant de réception.
+ * @return true si l'image est nouvelle et valide.
+ */
+static bool client_decode(NetClientState *cl, const uint8_t *p, ssize_t len, double now)
+{
+    static const NetFrame zero;
+    if (len < SNAP_HEADER)
+        return false;
+    uint32_t tick = get32(p + PKT_HEADER);
+    uint32_t base_tick = get32(p + PKT_HEADER + 4);
+    if (tick <= cl->last_tick || tick % NET_SEND_EVERY != 0)
+        return false; // En retard ou dupliquée
+    const NetFrame *base = base_tick ? &cl->history[history_slot(base_tick)] : &zero;
+    if (base_tick && netframe_tick(base) != base_tick)
+        return false;
+
+    NetArrival *arrival = snapring_write_slot(&cl->snapshots);
+    NetFrame *frame = &arrival->frame;
+    *frame = *base;
+    if (!codec_apply_diff(frame->bytes, NET_FRAME_SIZE, p + SNAP_HEADER, (size_t)(len - SNAP_HEADER)) ||
+        netframe_tick(frame) != tick)
+        return false;
+    cl->history[history_slot(tick)] = *frame;
+
+    if (cl->last_tick == 0)
+        client_rtt_sample(cl, now - cl->hello_at);
+    cl->last_tick = tick;
+    if (base_tick == 0)
+        cl->stats.keyframes++;
+
+    // Commandes accusées : retirées de la file
+    uint32_t acked = get32(p + PKT_HEADER + 8);
+    if (acked != cl->first_seq && acked - cl->first_seq <= cl->next_seq - cl->first_seq)
+    {
+        client_rtt_sample(cl, now - cl->queued_at[(acked - 1) % NET_INPUT_WINDOW]);
+        cl->first_seq = acked;
+    }
+    int role = p[PKT_HEADER + 12];
+    if (role != cl->role)
+        printf("[CLIENT] %s\n", role == NET_ROLE_PLAYER ? "Vous jouez" : "Vous regardez");
+    cl->role = role;
+
+    arrival->received = now;
+    arrival->rtt = cl->rtt;
+    arrival->role = role;
+    snapring_publish(&cl->snapshots, tick);
+    return true;
+}
+
+/**
+ * @brief Traite un paquet reçu du serveur.
+ *
+ * @return true si c'est une image nouvelle et valide.
+ */
+static bool client_receive(NetClientState *cl, const uint8_t *p, ssize_t len, double now)
+{
+    if (packet_type(p, len) == PKT_SNAP && client_decode(cl, p, len, now))
+        return true;
+    cl->stats.rejected++;
+    return false;
+}
+
+/**
+ * @brief Boucle du thread réseau : images reçues, puis commandes de la Vue envoyées.
+ */
+static void *client_main(void *arg)
+{
+    NetClientState *cl = arg;
+    uint8_t hello[PKT_HEADER + 4], p[PKT_MAX];
+    put_header(hello, PKT_HELLO);
+    put32(hello + PKT_HEADER, cl->match); // Ignoré par le serveur à une partie
+    double last_hello = 0.0;
+    while (!__atomic_load_n(&cl->stop, __ATOMIC_ACQUIRE))
+    {
+        double now = utils_get_time();
+        if (cl->last_tick == 0 && now - last_hello > 0.5)
+        {
+            client_send(cl, hello, sizeof(hello));
+            last_hello = now;
+            cl->hello_at = now;
+        }
+
+        // --- A. Images reçues (retenues d'abord par la latence simulée) ---
+        bool received = false;
+        if (wait_readable(cl->fd, now + NET_POLL_INTERVAL))
+        {
+            ssize_t len;
+            for (int n = 0; n < NET_RECV_BURST && (len = recv(cl->fd, p, sizeof(p), MSG_DONTWAIT)) >= 0; n++)
+            {
+                cl->stats.bytes += len;
+                if (cl->lag > 0.0)
+                    delay_push(&cl->inbox, p, (size_t)len, utils_get_time() + cl->lag);
+                else if (client_receive(cl, p, len, utils_get_time()))
+                    received = true;
+            }
+        }
+        const NetDelayed *d;
+        while ((d = delay_pop(&cl->inbox, utils_get_time())))
+            if (client_receive(cl, d->data, (ssize_t)d->len, d->due))
+                received = true;
+        while ((d = delay_pop(&cl->outbox, utils_get_time())))
+            (void)send(cl->fd, d->data, d->len, 0);
+
+        // --- B. Entrées : en file jusqu'à leur accusé ---
+        uint32_t queued = cl->next_seq;
+        uint8_t cmd;
+        while (spsc_pop(&cl->commands, &cmd))
+            client_queue(cl, (GameCommand)cmd);
+        if (received || cl->next_seq != queued)
+            client_send_input(cl);
+    }
+
+    if (cl->last_tick)
+    {
+        uint8_t bye[PKT_HEADER];
+        put_header(bye, PKT_BYE);
+        for (int i = 0; i < 3; i++) // Sans accusé : répété contre la perte (sans latence simulée : le thread s'arrête)
+            (void)send(cl->fd, bye, sizeof(bye), 0);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Ouvre un socket UDP connecté au serveur.
+ *
+ * @return Le descripteur, ou -1 si l'hôte est introuvable.
+ */
+static int client_connect(const char *host, int port)
+{
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, service, &hints, &res) != 0 || !res)
+        return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+/**
+ * @brief Commande du client sans Vue : lance la partie depuis le menu, puis suit le script.
+ */
+static GameCommand script_command(const GameModel *model, const char *script, long frame, double now,
+                                  double *last_start)
+{
+    if (model->sim.state == STATE_PLAYING)
+        return headless_script_command(script[frame % (long)strlen(script)]);
+    if (model->sim.state == STATE_MENU && now - *last_start > 0.5)
+    {
+        *last_start = now; // Une seule validation par aller-retour
+        return CMD_RETURN;
+    }
+    return CMD_NONE;
+}
+
+/**
+ * @brief Pose l'abscisse prédite du vaisseau local dans un modèle d'affichage.
+ */
+static void place_local_ship(GameModel *model, float x)
+{
+    if (model && model->sim.player.x != x)
+    {
+        model->sim.player.x = x;
+        model_touch(model, MODEL_GEN_ANY);
+    }
+}
+
+/**
+ * @brief Envoie une commande locale au thread réseau, et l'applique aussitôt au vaisseau prédit.
+ *
+ * Comme sur le serveur, seules les commandes reçues en partie déplacent le vaisseau.
+ */
+static void client_command(NetClientState *cl, NetPredict *predict, const GameModel *latest, GameCommand cmd)
+{
+    uint8_t c = (uint8_t)cmd;
+    if (cmd == CMD_NONE || !spsc_push(&cl->commands, &c))
+        return;
+    if (latest->sim.state == STATE_PLAYING)
+        net_predict_command(predict, latest, cmd);
+}
+
+/**
+ * @brief Se connecte à un serveur et affiche ses images jusqu'à CMD_EXIT.
+ *
+ * Trois modèles d'affichage : la dernière image reçue (état du jeu,
+ * position qui fait autorité), et les deux images du tampon de gigue entre
+ * lesquelles la Vue interpole, NET_INTERP_DELAY dans le passé. Le vaisseau
+ * local y est remplacé par sa prédiction (netpredict.h).
+ */
+bool net_run_client(const char *host, int port, int match, const ViewInterface *view, const char *script,
+                    double seconds, NetStats *out)
+{
+    NetClientState *cl = calloc(1, sizeof(NetClientState));
+    NetJitter *jitter = malloc(sizeof(NetJitter));
+    if (!cl || !jitter)
+    {
+        free(cl);
+        free(jitter);
+        return false;
+    }
+    cl->last_held = -1;
+    cl->role = -1;
+    cl->match = match > 0 ? (uint32_t)match : 0;
+    const char *lag_env = getenv("SPACE_INVADERS_NET_LAG");
+    cl->lag = lag_env ? atof(lag_env) / 1000.0 : 0.0;
+    cl->fd = client_connect(host, port);
+    if (cl->fd < 0)
+    {
+        fprintf(stderr, "[ERREUR] Client : serveur %s:%d introuvable\n", host, port);
+        free(jitter);
+        free(cl);
+        return false;
+    }
+    if (!script || !script[0])
+        script = HEADLESS_DEFAULT_SCRIPT;
+    net_jitter_init(jitter);
+    NetPredict predict;
+    net_predict_init(&predict);
+
+    // Dernière image reçue ; images interpolées (arrivée, départ) pour la Vue
+    GameModel *latest = model_init();
+    GameModel *cur = latest && view ? model_clone(latest) : NULL;
+    GameModel *prev = cur && view->set_interpolation ? model_clone(cur) : NULL;
+    bool ok = latest && (!view || (cur && (prev || !view->set_interpolation)));
+
+    snapring_init(&cl->snapshots, cl->frames, sizeof(NetArrival));
+    spsc_init(&cl->commands, cl->command_storage, 1, NET_COMMAND_RING);
+    if (ok && pthread_create(&cl->thread, NULL, client_main, cl) != 0)
+    {
+        fprintf(stderr, "[ERREUR] Client : thread reseau impossible\n");
+        ok = false;
+    }
+    bool started = ok;
+
+    FramePacer pacer;
+    utils_pacer_init(&pacer, TARGET_FPS, view && view->has_vsync && view->has_vsync());
+
+    double start = utils_get_time();
+    double last_recv = start, last_start = 0.0;
+    uint32_t shown = 0, shown_from = 0, shown_to = 0;
+    long frame = 0;
+    NetStats view_stats;
+    memset(&view_stats, 0, sizeof(view_stats));
+    bool running = ok;
+    while (running)
+    {
+        double now = utils_get_time();
+        if (seconds > 0.0 && now - start >= seconds)
+            break;
+        if (now - last_recv > NET_TIMEOUT)
+        {
+            fprintf(stderr, "[ERREUR] Client : le serveur ne repond plus\n");
+            break;
+        }
+
+        // --- A. Dernière image décodée : tampon de gigue, puis correction de la prédiction ---
+        uint32_t tick;
+        const NetArrival *arrival = snapring_acquire(&cl->snapshots, &tick);
+        if (arrival && tick != shown)
+        {
+            shown = tick;
+            last_recv = now;
+            if (netframe_apply(&arrival->frame, latest))
+            {
+                view_stats.snapshots++;
+                net_jitter_push(jitter, &arrival->frame, arrival->received);
+                net_predict_reconcile(&predict, latest, arrival->role == NET_ROLE_PLAYER, arrival->rtt);
+                view_stats.rtt = arrival->rtt;
+            }
+            else
+                view_stats.rejected++;
+        }
+
+        // --- B. Entrées : envoyées par le thread réseau, appliquées tout de suite au vaisseau prédit ---
+        if (view)
+        {
+            CommandQueue input;
+            command_queue_clear(&input);
+            view->get_input(cur, &input);
+            GameCommand cmd;
+            while (running && command_queue_pop(&input, HUGE_VAL, &cmd))
+            {
+                if (cmd == CMD_EXIT)
+                    running = false;
+                else
+                    client_command(cl, &predict, latest, cmd);
+            }
+        }
+        else if (shown)
+            client_command(cl, &predict, latest, script_command(latest, script, frame, now, &last_start));
+        net_predict_advance(&predict, latest, now);
+
+        // --- C. Rendu : entités distantes dans le passé, vaisseau local dans le présent ---
+        const NetFrame *from, *to;
+        float alpha;
+        if (view && net_jitter_sample(jitter, now, &from, &to, &alpha))
+        {
+            uint32_t from_tick = netframe_tick(from), to_tick = netframe_tick(to);
+            if (!prev)
+                to_tick = from_tick; // Sans interpolation : l'image de départ seule
+            if (from_tick != shown_from || to_tick != shown_to)
+            {
+                // Paire suivante : l'ancienne image d'arrivée devient celle de départ
+                if (prev && from_tick == shown_to)
+                    model_copy_sim(prev, cur);
+                else if (prev)
+                    netframe_apply(from, prev);
+                netframe_apply(prev ? to : from, cur);
+                shown_from = from_tick;
+                shown_to = to_tick;
+            }
+            if (predict.active)
+            {
+                place_local_ship(cur, net_predict_x(&predict));
+                place_local_ship(prev, net_predict_x(&predict));
+            }
+            if (prev)
+                view->set_interpolation(prev, alpha);
+            view->render(cur);
+        }
+        utils_pacer_wait(&pacer);
+        frame++;
+    }
+
+    if (started)
+    {
+        __atomic_store_n(&cl->stop, true, __ATOMIC_RELEASE);
+        pthread_join(cl->thread, NULL);
+    }
+    close(cl->fd);
+    cl->stats.elapsed = utils_get_time() - start;
+    cl->stats.snapshots = view_stats.snapshots;
+    cl->stats.rejected += view_stats.rejected;
+    cl->stats.skipped = cl->snapshots.overwritten;
+    cl->stats.dropped = cl->commands.dropped;
+    cl->stats.rtt = view_stats.rtt;
+    cl->stats.underruns = jitter->underruns;
+    cl->stats.corrections = predict.corrections;
+    cl->stats.correction_avg = predict.corrections ? predict.error_sum / predict.corrections : 0.0;
+    cl->stats.correction_max = predict.error_max;
+    ok = ok && cl->last_tick != 0;
+    if (out)
+        *out = cl->stats;
+    model_free(prev);
+    model_free(cur);
+    model_free(latest);
+    free(jitter);
+    free(cl);
+    return ok;
+}
+
+// ============================================================================
+//                          4. SERVEUR MULTI-PARTIES
+// ============================================================================
+
+#define HUB_ENTRY_FREE (-1)    ///< Case jamais occupée : fin de la recherche.
+#define HUB_ENTRY_REMOVED (-2) ///< Case d'un client parti : la recherche continue.
+#define HUB_TIMEOUT_EVERY 0.1  ///< Intervalle (s) entre deux recherches de clients muets.
+
+/**
+ * @brief Clients et historique d'une partie suivie (alloués à son premier client).
+ */
+typedef struct
+{
+    NetClient clients[NET_HUB_MATCH_CLIENTS]; ///< Clients de la partie.
+    NetFrame history[NET_HISTORY];            ///< Dernières images envoyées (bases des deltas).
+    uint32_t tick;                            ///< Dernière image envoyée (0 : aucune encore).
+    long long joined;                         ///< Compteur d'arrivées.
+} NetHubMatch;
+
+/**
+ * @brief Case de la table des clients : adresse -> (partie, emplacement).
+ */
+typedef struct
+{
+    struct sockaddr_in addr; ///< Adresse du client.
+    int32_t match;           ///< Partie, ou HUB_ENTRY_FREE / HUB_ENTRY_REMOVED.
+    int32_t slot;            ///< Emplacement dans les clients de la partie.
+} NetHubEntry;
+
+/**
+ * @brief État du réseau du serveur multi-parties (thread appelant seul).
+ */
+typedef struct
+{
+    int fd;                 ///< Socket UDP.
+    Hub *hub;               ///< Parties (threads de calcul).
+    NetHubMatch **matches;  ///< Par partie (NULL : jamais suivie).
+    int *watched;           ///< Parties suivies, dans l'ordre d'arrivée.
+    int watched_count;      ///< Taille de `watched`.
+    NetHubEntry *table;     ///< Table des clients (adressage ouvert, sondage linéaire).
+    uint32_t mask;          ///< Taille de la table moins un (puissance de 2).
+    uint32_t removed;       ///< Cases HUB_ENTRY_REMOVED (reconstruction au-delà d'un quart).
+    NetStats stats;         ///< Bilan.
+} NetHub;
+
+static uint32_t addr_hash(const struct sockaddr_in *a)
+{
+    uint64_t key = ((uint64_t)a->sin_addr.s_addr << 16) | a->sin_port;
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static NetHubEntry *hub_find(NetHub *net, const struct sockaddr_in *addr)
+{
+    for (uint32_t i = addr_hash(addr) & net->mask;; i = (i + 1) & net->mask)
+    {
+        NetHubEntry *e = &net->table[i];
+        if (e->match == HUB_ENTRY_FREE)
+            return NULL;
+        if (e->match >= 0 && same_addr(&e->addr, addr))
+            return e;
+    }
+}
+
+/**
+ * @brief Range un client (absent de la table) ; la table a toujours des cases libres.
+ */
+static void hub_insert(NetHub *net, const struct sockaddr_in *addr, int match, int slot)
+{
+    uint32_t i = addr_hash(addr) & net->mask;
+    while (net->table[i].match >= 0)
+        i = (i + 1) & net->mask;
+    if (net->table[i].match == HUB_ENTRY_REMOVED)
+        net->removed--;
+    net->table[i].addr = *addr;
+    net->table[i].match = match;
+    net->table[i].slot = slot;
+}
+
+/**
+ * @brief Retire un client ; trop de cases supprimées allongent les recherches : la table est reconstruite.
+ */
+static void hub_remove(NetHub *net, NetHubEntry *e)
+{
+    e->match = HUB_ENTRY_REMOVED;
+    if (++net->removed <= (net->mask + 1) / 4)
+        return;
+    uint32_t size = net->mask + 1;
+    NetHubEntry *old = net->table;
+    NetHubEntry *fresh = malloc(size * sizeof(NetHubEntry));
+    if (!fresh)
+        return; // Recherches plus longues, mais justes
+    for (uint32_t i = 0; i < size; i++)
+        fresh[i].match = HUB_ENTRY_FREE;
+    net->table = fresh;
+    net->removed = 0;
+    for (uint32_t i = 0; i < size; i++)
+        if (old[i].match >= 0)
+            hub_insert(net, &old[i].addr, old[i].match, old[i].slot);
+    free(old);
+}
+
+/**
+ * @brief Clients de la partie `match`, alloués et suivis à la première demande.
+ */
+static NetHubMatch *hub_match(NetHub *net, int match)
+{
+    if (net->matches[match])
+        return net->matches[match];
+    NetHubMatch *hm = calloc(1, sizeof(NetHubMatch));
+    if (!hm || !hub_watch(net->hub, match))
+    {
+        free(hm);
+        return NULL;
+    }
+    net->matches[match] = hm;
+    net->watched[net->watched_count++] = match;
+    return hm;
+}
+
+static void hub_drop(NetHub *net, NetHubEntry *e, const char *why)
+{
+    NetHubMatch *hm = net->matches[e->match];
+    drop_client(hm->clients, NET_HUB_MATCH_CLIENTS, &hm->clients[e->slot], why);
+    hub_remove(net, e);
+}
+
+/**
+ * @brief Lit les paquets en attente, au plus NET_RECV_BURST.
+ */
+static void hub_receive(NetHub *net, double now)
+{
+    uint8_t p[PKT_MAX];
+    for (int n = 0; n < NET_RECV_BURST; n++)
+    {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = recvfrom(net->fd, p, sizeof(p), MSG_DONTWAIT, (struct sockaddr *)&from, &from_len);
+        if (len < 0)
+            return;
+        int type = packet_type(p, len);
+        NetHubEntry *e = hub_find(net, &from);
+        if (type == PKT_HELLO && !e)
+        {
+            uint32_t match = len >= PKT_HEADER + 4 ? get32(p + PKT_HEADER) : 0;
+            NetHubMatch *hm = match < (uint32_t)hub_matches(net->hub) ? hub_match(net, (int)match) : NULL;
+            int slot = -1;
+            for (int i = 0; hm && i < NET_HUB_MATCH_CLIENTS && slot < 0; i++)
+                if (!hm->clients[i].used)
+                    slot = i;
+            if (slot < 0)
+            {
+                net->stats.rejected++; // Partie inconnue ou pleine : le client finira par abandonner
+                continue;
+            }
+            NetClient *c = &hm->clients[slot];
+            memset(c, 0, sizeof(*c));
+            c->used = true;
+            c->addr = from;
+            c->joined = hm->joined++;
+            hub_insert(net, &from, (int)match, slot);
+            net->stats.clients++;
+            printf("[SERVEUR] %s:%d connecte a la partie %u\n", inet_ntoa(from.sin_addr), ntohs(from.sin_port),
+                   match);
+            elect_player(hm->clients, NET_HUB_MATCH_CLIENTS);
+            e = hub_find(net, &from);
+        }
+        if (!e)
+        {
+            if (type != PKT_BYE) // BYE répété après le départ
+                net->stats.rejected++;
+            continue;
+        }
+        NetHubMatch *hm = net->matches[e->match];
+        NetClient *c = &hm->clients[e->slot];
+        c->last_seen = now;
+        if (type == PKT_INPUT)
+        {
+            uint8_t cmds[256];
+            int count = read_input(c, hm->tick, p, len, cmds);
+            if (count < 0)
+                net->stats.rejected++;
+            for (int k = 0; k < count; k++)
+                hub_push_command(net->hub, e->match, (GameCommand)cmds[k]); // File pleine : compté par le hub
+        }
+        else if (type == PKT_BYE)
+            hub_drop(net, e, "deconnecte");
+        else if (type != PKT_HELLO)
+            net->stats.rejected++;
+    }
+}
+
+/**
+ * @brief Une passe sur les parties suivies : nouvelle image envoyée à leurs clients.
+ */
+static void hub_send(NetHub *net)
+{
+    for (int i = 0; i < net->watched_count; i++)
+    {
+        int match = net->watched[i];
+        NetHubMatch *hm = net->matches[match];
+        uint32_t tick;
+        const NetFrame *frame = hub_frame(net->hub, match, &tick);
+        if (!frame || tick == hm->tick)
+            continue;
+        hm->history[history_slot(tick)] = *frame;
+        hm->tick = tick;
+        send_frame(net->fd, hm->history, tick, hm->clients, NET_HUB_MATCH_CLIENTS, &net->stats);
+    }
+}
+
+/**
+ * @brief Retire les clients muets depuis NET_TIMEOUT.
+ */
+static void hub_timeouts(NetHub *net, double now)
+{
+    for (int i = 0; i < net->watched_count; i++)
+    {
+        NetHubMatch *hm = net->matches[net->watched[i]];
+        for (int k = 0; k < NET_HUB_MATCH_CLIENTS; k++)
+        {
+            NetClient *c = &hm->clients[k];
+            if (c->used && now - c->last_seen > NET_TIMEOUT)
+                hub_drop(net, hub_find(net, &c->addr), "ne repond plus");
+        }
+    }
+}
+
+/**
+ * @brief Boucle réseau du serveur multi-parties, sur le thread appelant.
+ */
+bool net_run_hub(Hub *hub, int port, double seconds, NetStats *out)
+{
+    int matches = hub_matches(hub);
+    uint32_t size = 1;
+    while (size < 2u * (uint32_t)matches * NET_HUB_MATCH_CLIENTS) // Toujours moitié vide au moins
+        size <<= 1;
+    NetHub net;
+    memset(&net, 0, sizeof(net));
+    net.hub = hub;
+    net.mask = size - 1;
+    net.matches = calloc((size_t)matches, sizeof(NetHubMatch *));
+    net.watched = calloc((size_t)matches, sizeof(int));
+    net.table = malloc(size * sizeof(NetHubEntry));
+    net.fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    bool ok = net.matches && net.watched && net.table;
+    if (ok && (net.fd < 0 || bind(net.fd, (const struct sockaddr *)&addr, sizeof(addr)) != 0))
+    {
+        fprintf(stderr, "[ERREUR] Serveur : port UDP %d indisponible (%s)\n", port, strerror(errno));
+        ok = false;
+    }
+    if (!ok)
+    {
+        if (net.fd >= 0)
+            close(net.fd);
+        free(net.matches);
+        free(net.watched);
+        free(net.table);
+        return false;
+    }
+    for (uint32_t i = 0; i < size; i++)
+        net.table[i].match = HUB_ENTRY_FREE;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_sigint;
+    sigemptyset(&sa.sa_mask);
+    struct sigaction old_sa;
+    sigaction(SIGINT, &sa, &old_sa);
+    stop_requested = 0;
+
+    printf("[SERVEUR] %d parties sur le port UDP %d (%d images/s)\n", matches, port, TARGET_FPS / NET_SEND_EVERY);
+    double start = utils_get_time();
+    double next_timeouts = start + HUB_TIMEOUT_EVERY;
+    while (!stop_requested && (seconds <= 0.0 || utils_get_time() - start < seconds))
+    {
+        if (wait_readable(net.fd, utils_get_time() + NET_POLL_INTERVAL))
+            hub_receive(&net, utils_get_time());
+        hub_send(&net);
+        double now = utils_get_time();
+        if (now >= next_timeouts)
+        {
+            hub_timeouts(&net, now);
+            next_timeouts = now + HUB_TIMEOUT_EVERY;
+        }
+    }
+
+    sigaction(SIGINT, &old_sa, NULL);
+    close(net.fd);
+    net.stats.elapsed = utils_get_time() - start;
+    if (out)
+        *out = net.stats;
+    for (int i = 0; i < net.watched_count; i++)
+        free(net.matches[net.watched[i]]);
+    free(net.matches);
+    free(net.watched);
+    free(net.table);
+    return true;
+}
+
+// ============================================================================
+//                          5. BILAN
+// ============================================================================
+
+/**
+ * @brief Affiche un bilan sur la sortie standard.
+ */
+void net_print_stats(const NetStats *stats, const char *label)
+{
+    double secs = stats->elapsed > 0.0 ? stats->elapsed : 1.0;
+    printf("[%s] Duree : %.1f s\n", label, stats->elapsed);
+    if (stats->ticks)
+        printf("[%s] Ticks : %lld, clients : %d\n", label, stats->ticks, stats->clients);
+    printf("[%s] Images : %lld (%lld completes), %lld commandes, %lld paquets ignores\n", label, stats->snapshots,
+           stats->keyframes, stats->commands, stats->rejected);
+    if (stats->skipped || stats->dropped)
+        printf("[%s] Entre threads : %lld images remplacees avant d'etre prises, %lld commandes perdues\n", label,
+               stats->skipped, stats->dropped);
+    if (stats->rtt > 0.0)
+        printf("[%s] Aller-retour : %.0f ms ; %lld rendus sans image d'avance, %lld corrections du vaisseau "
+               "(%.2f unites en moyenne, %.2f au plus)\n",
+               label, 1000.0 * stats->rtt, stats->underruns, stats->corrections, stats->correction_avg,
+               stats->correction_max);
+    double per_image = stats->snapshots ? (double)stats->bytes / stats->snapshots : 0.0;
+    printf("[%s] Debit : %lld octets (%.0f octets/s), %.1f octets/image, soit %.0f octets/s par client\n", label,
+           stats->bytes, stats->bytes / secs, per_image, per_image * TARGET_FPS / NET_SEND_EVERY);
+}
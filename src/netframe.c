@@ -0,0 +1,345 @@
+/**
+ * @file netframe.c
+ * @brief Implémentation de l'image réseau (capture côté serveur, reconstruction côté client).
+ */
+
+#include "netframe.h"
+#include "entity_pack.h"
+
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Champs d'une image, sous leur forme native.
+ */
+typedef struct
+{
+    uint32_t tick;
+    uint8_t state, previous_state, menu_selection, lives;
+    uint32_t score;
+    uint16_t level;
+    uint8_t flags;
+    uint16_t hit;
+    uint8_t anim_ticks;
+    int16_t player_x, player_y, ufo_x, ufo_y;
+    int16_t origin_x, origin_y, step_x, step_y;
+    uint64_t alive_mask, dying_mask;
+    uint8_t enemy_type[FORMATION_SIZE];
+    int16_t enemy_x[FORMATION_SIZE], enemy_y[FORMATION_SIZE];
+    uint8_t shield_health[MAX_SHIELDS];
+    NetBullet bullets[NET_MAX_BULLETS];
+} FrameFields;
+
+/**
+ * @brief Curseur de lecture ou d'écriture dans une image.
+ */
+typedef struct
+{
+    uint8_t *p; ///< Position courante.
+} Cursor;
+
+static void put(Cursor *c, uint64_t v, int n)
+{
+    for (int i = 0; i < n; i++)
+        *c->p++ = (uint8_t)(v >> (8 * i));
+}
+
+static uint64_t get(Cursor *c, int n)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++)
+        v |= (uint64_t)*c->p++ << (8 * i);
+    return v;
+}
+
+/**
+ * @brief Parcourt les champs dans l'ordre du format : écrit depuis `f`, ou lit dans `f`.
+ *
+ * Un seul parcours pour les deux sens : l'ordre ne peut pas diverger entre
+ * capture et reconstruction.
+ */
+static void walk(FrameFields *f, uint8_t *bytes, bool write)
+{
+    Cursor c = {bytes};
+#define FIELD(x, n)                    \
+    do                                 \
+    {                                  \
+        if (write)                     \
+            put(&c, (uint64_t)(x), n); \
+        else                           \
+            (x) = get(&c, n);          \
+    } while (0)
+    FIELD(f->tick, 4);
+    FIELD(f->state, 1);
+    FIELD(f->previous_state, 1);
+    FIELD(f->menu_selection, 1);
+    FIELD(f->lives, 1);
+    FIELD(f->score, 4);
+    FIELD(f->level, 2);
+    FIELD(f->flags, 1);
+    FIELD(f->hit, 2);
+    FIELD(f->anim_ticks, 1);
+    FIELD(f->player_x, 2);
+    FIELD(f->player_y, 2);
+    FIELD(f->ufo_x, 2);
+    FIELD(f->ufo_y, 2);
+    FIELD(f->origin_x, 2);
+    FIELD(f->origin_y, 2);
+    FIELD(f->step_x, 2);
+    FIELD(f->step_y, 2);
+    FIELD(f->alive_mask, 8);
+    FIELD(f->dying_mask, 8);
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        FIELD(f->enemy_type[i], 1);
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        FIELD(f->enemy_x[i], 2);
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        FIELD(f->enemy_y[i], 2);
+    for (int s = 0; s < MAX_SHIELDS; s++)
+        FIELD(f->shield_health[s], 1);
+    for (int i = 0; i < NET_MAX_BULLETS; i++)
+    {
+        FIELD(f->bullets[i].x, 2);
+        FIELD(f->bullets[i].y, 2);
+        FIELD(f->bullets[i].tick, 2);
+        FIELD(f->bullets[i].step, 4);
+        FIELD(f->bullets[i].type, 1);
+        FIELD(f->bullets[i].sprite, 1);
+    }
+#undef FIELD
+}
+
+/**
+ * @brief Vérifie qu'une image décodée ne contient que des valeurs que le Modèle accepte.
+ */
+static bool fields_valid(const FrameFields *f)
+{
+    if (f->state > STATE_SAVE_SUCCESS || f->previous_state > STATE_SAVE_SUCCESS || f->level == 0)
+        return false;
+    if ((f->alive_mask | f->dying_mask) >> FORMATION_SIZE || (f->alive_mask & f->dying_mask))
+        return false;
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        if (((f->alive_mask | f->dying_mask) >> i & 1) &&
+            (f->enemy_type[i] < ENTITY_ENEMY_TYPE_1 || f->enemy_type[i] > ENTITY_ENEMY_TYPE_3))
+            return false;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+        if (f->shield_health[s] > SHIELD_MAX_HEALTH)
+            return false;
+    for (int i = 0; i < NET_MAX_BULLETS; i++)
+    {
+        const NetBullet *b = &f->bullets[i];
+        if (!b->sprite)
+            continue;
+        if ((b->type != ENTITY_BULLET_PLAYER && b->type != ENTITY_BULLET_ENEMY) || !(b->sprite & NETB_USED) ||
+            f->anim_ticks == 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Position (Q10.6) et sprite d'une balle au tick `tick`, d'après sa fiche.
+ *
+ * Seul calcul commun à l'encodeur et au client : tout en entiers, les deux
+ * côtés obtiennent le même résultat.
+ */
+static int16_t bullet_predict(const NetBullet *b, uint32_t tick, int anim_ticks, int *frame)
+{
+    uint16_t n = (uint16_t)(tick - b->tick);
+    int phase = (b->sprite & NETB_PHASE) + n;
+    *frame = (((b->sprite & NETB_FRAME) >> NETB_FRAME_SHIFT) + phase / anim_ticks) & 3;
+
+    // Q16.16 -> Q10.6, arrondi au plus proche (symétrique)
+    const int shift = MODEL_FIXED_SHIFT - PACK_FRAC_BITS;
+    int64_t q = (int64_t)b->y * (1 << shift) + (int64_t)b->step * n;
+    int64_t v = q >= 0 ? (q + (1 << (shift - 1))) >> shift : -((-q + (1 << (shift - 1))) >> shift);
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+/**
+ * @brief Fiche d'une balle : celle de l'image précédente si elle la prédit encore, sinon une neuve.
+ *
+ * @return false si le slot est libre.
+ */
+static bool bullet_record(const GameModel *model, int i, uint32_t tick, const NetBullet *prev, NetBullet *out,
+                          uint8_t *anim_ticks)
+{
+    Entity e;
+    int32_t step;
+    int ticks, phase;
+    if (!model_get_bullet(model, i, &e) || !model_get_bullet_motion(model, i, &step, &ticks, &phase))
+        return false;
+    *anim_ticks = (uint8_t)(ticks > NETB_PHASE ? NETB_PHASE : ticks);
+
+    out->x = entity_pack_coord(e.x);
+    out->y = entity_pack_coord(e.y);
+    out->tick = (uint16_t)tick;
+    out->step = step;
+    out->type = (uint8_t)e.type;
+    out->sprite = NETB_USED | (uint8_t)((e.anim_frame & 3) << NETB_FRAME_SHIFT) |
+                  (uint8_t)(phase < 0 ? 0 : phase > NETB_PHASE ? NETB_PHASE : phase);
+
+    if (prev && prev->sprite && prev->type == out->type && prev->x == out->x && prev->step == out->step &&
+        (uint16_t)(tick - prev->tick) < NETB_MAX_AGE)
+    {
+        int frame;
+        int dy = bullet_predict(prev, tick, *anim_ticks, &frame) - out->y;
+        if (dy >= -1 && dy <= 1 && frame == (e.anim_frame & 3))
+            *out = *prev;
+    }
+    return true;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Capture l'image d'un modèle.
+ */
+void netframe_capture(NetFrame *out, const GameModel *model, uint32_t tick, NetEncoder *enc)
+{
+    const SimState *s = &model->sim;
+    FrameFields f;
+    memset(&f, 0, sizeof(f));
+
+    f.tick = tick;
+    f.state = (uint8_t)s->state;
+    f.previous_state = (uint8_t)s->previous_state;
+    f.menu_selection = (uint8_t)model->ui.menu_selection;
+    f.lives = (uint8_t)(s->lives < 0 ? 0 : s->lives > 255 ? 255 : s->lives);
+    f.score = (uint32_t)s->score;
+    f.level = (uint16_t)s->level;
+    f.flags = (s->animation_frame ? NETF_ANIM_FRAME : 0) | (s->player.active ? NETF_PLAYER : 0) |
+              (s->ufo.active ? NETF_UFO : 0) | (s->ufo.exploding ? NETF_UFO_EXPLODING : 0);
+    f.hit = s->hit_timer > 0 ? (uint16_t)ceilf(model_countdown_seconds(model, s->hit_timer) * 256.0f) : 0;
+    f.player_x = entity_pack_coord(s->player.x);
+    f.player_y = entity_pack_coord(s->player.y);
+    f.ufo_x = entity_pack_coord(s->ufo.x);
+    f.ufo_y = entity_pack_coord(s->ufo.y);
+    f.origin_x = entity_pack_coord(s->formation.origin_x);
+    f.origin_y = entity_pack_coord(s->formation.origin_y);
+    f.step_x = entity_pack_coord(s->formation.step_x);
+    f.step_y = entity_pack_coord(s->formation.step_y);
+    f.alive_mask = s->formation.alive_mask;
+    f.dying_mask = s->formation.dying_mask;
+
+    for (int i = 0; i < FORMATION_SIZE; i++)
+    {
+        if ((f.alive_mask | f.dying_mask) >> i & 1)
+            f.enemy_type[i] = (uint8_t)s->enemies.type[i];
+        if (f.dying_mask & (1ULL << i)) // Les vivants se déduisent de l'origine
+        {
+            f.enemy_x[i] = entity_pack_coord(s->enemies.x[i]);
+            f.enemy_y[i] = entity_pack_coord(s->enemies.y[i]);
+        }
+    }
+    for (int k = 0; k < MAX_SHIELDS; k++)
+        f.shield_health[k] = (uint8_t)(s->shields[k].active ? s->shields[k].health : 0);
+
+    const BulletPool *p = &s->bullets;
+    for (int k = 0; k < p->live.count; k++)
+    {
+        int i = p->live.items[k];
+        if (i >= NET_MAX_BULLETS)
+            continue;
+        const NetBullet *prev = enc ? &enc->bullets[i] : NULL;
+        if (bullet_record(model, i, tick, prev, &f.bullets[i], &f.anim_ticks) && enc &&
+            memcmp(prev, &f.bullets[i], sizeof(NetBullet)) != 0)
+            enc->records++;
+    }
+    if (enc)
+        memcpy(enc->bullets, f.bullets, sizeof(enc->bullets)); // Slots libérés : fiches effacées
+
+    walk(&f, out->bytes, true);
+}
+
+/**
+ * @brief Numéro de tick d'une image.
+ */
+uint32_t netframe_tick(const NetFrame *frame)
+{
+    const uint8_t *b = frame->bytes;
+    return (uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+/**
+ * @brief Recopie une image dans un modèle d'affichage.
+ */
+bool netframe_apply(const NetFrame *frame, GameModel *model)
+{
+    FrameFields f;
+    walk(&f, (uint8_t *)frame->bytes, false); // Lecture seule : le cast ne sert qu'au curseur commun
+    if (!fields_valid(&f))
+        return false;
+
+    SimState *s = &model->sim;
+    s->state = (GameStateEnum)f.state;
+    s->previous_state = (GameStateEnum)f.previous_state;
+    model->ui.menu_selection = f.menu_selection;
+    s->lives = f.lives;
+    s->score = (int)f.score;
+    s->level = f.level;
+    s->animation_frame = (f.flags & NETF_ANIM_FRAME) != 0;
+    s->hit_timer = model_countdown_ticks(model, f.hit / 256.0f);
+    s->player.active = (f.flags & NETF_PLAYER) != 0;
+    s->player.x = entity_unpack_coord(f.player_x);
+    s->player.y = entity_unpack_coord(f.player_y);
+    s->ufo.active = (f.flags & NETF_UFO) != 0;
+    s->ufo.exploding = (f.flags & NETF_UFO_EXPLODING) != 0;
+    s->ufo.x = entity_unpack_coord(f.ufo_x);
+    s->ufo.y = entity_unpack_coord(f.ufo_y);
+    s->ufo.type = ENTITY_UFO;
+    s->ufo.width = UFO_WIDTH;
+    s->ufo.height = UFO_HEIGHT;
+
+    Formation *fm = &s->formation;
+    fm->origin_x = entity_unpack_coord(f.origin_x);
+    fm->origin_y = entity_unpack_coord(f.origin_y);
+    fm->alive_mask = f.alive_mask;
+    fm->dying_mask = f.dying_mask;
+    for (int i = 0; i < FORMATION_SIZE; i++)
+    {
+        s->enemies.type[i] = (EntityType)f.enemy_type[i];
+        s->enemies.x[i] = entity_unpack_coord(f.enemy_x[i]);
+        s->enemies.y[i] = entity_unpack_coord(f.enemy_y[i]);
+    }
+    s->shield_bitmap = false; // Les images ne portent que la santé des boucliers
+    for (int k = 0; k < MAX_SHIELDS; k++)
+    {
+        s->shields[k].health = f.shield_health[k];
+        s->shields[k].active = f.shield_health[k] > 0;
+    }
+
+    model_clear_bullets(model);
+    BulletPool *p = &s->bullets;
+    for (int i = 0; i < NET_MAX_BULLETS && i < p->capacity; i++)
+    {
+        const NetBullet *b = &f.bullets[i];
+        if (!b->sprite)
+            continue;
+        // Slot du serveur gardé (interpolation d'une image à l'autre), sauf s'il
+        // tombe hors du bloc de son camp ici
+        int j = model_restore_bullet(model, i, (EntityType)b->type);
+        if (j < 0)
+            continue;
+        int frame;
+        p->x[j] = entity_unpack_coord(b->x);
+        p->y[j] = entity_unpack_coord(bullet_predict(b, f.tick, f.anim_ticks, &frame));
+        p->dy[j] = (float)b->step * TARGET_FPS / MODEL_FIXED_ONE;
+        p->anim_frame[j] = frame;
+    }
+
+    // Listes actives et constantes de la vague, puis l'espacement transmis
+    // (la table des vagues du client peut différer de celle du serveur) ;
+    // le registre (bonus) n'est pas transmis
+    ecs_clear(&model->sim.ecs);
+    model_rebuild_indexes(model);
+    fm->step_x = entity_unpack_coord(f.step_x);
+    fm->step_y = entity_unpack_coord(f.step_y);
+    return true;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file netpredict.c
+ * @brief Implémentation du tampon de gigue et de la prédiction du vaisseau local.
+ */
+
+#include "netpredict.h"
+#include "entity_pack.h"
+
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. TAMPON DE GIGUE
+// ============================================================================
+
+/** @brief Emplacement de la k-ième image, de la plus ancienne à la plus récente. */
+static int jitter_slot(const NetJitter *jitter, int k)
+{
+    return (jitter->first + k) % NET_JITTER_FRAMES;
+}
+
+/**
+ * @brief Vide le tampon de gigue.
+ */
+void net_jitter_init(NetJitter *jitter)
+{
+    memset(jitter, 0, sizeof(*jitter));
+}
+
+/**
+ * @brief Ajoute une image reçue et recale l'horloge du serveur.
+ */
+void net_jitter_push(NetJitter *jitter, const NetFrame *frame, double received)
+{
+    if (jitter->count == NET_JITTER_FRAMES)
+    {
+        jitter->first = jitter_slot(jitter, 1);
+        jitter->count--;
+    }
+    int slot = jitter_slot(jitter, jitter->count++);
+    jitter->frames[slot] = *frame;
+    jitter->ticks[slot] = netframe_tick(frame);
+
+    // Image en avance sur l'horloge : l'horloge la rejoint ; en retard : elle s'y fait lentement
+    double sample = (double)jitter->ticks[slot] / TARGET_FPS - received;
+    if (!jitter->synced || sample > jitter->offset)
+        jitter->offset = sample;
+    else
+        jitter->offset += (sample - jitter->offset) * NET_CLOCK_SMOOTHING;
+    jitter->synced = true;
+}
+
+/**
+ * @brief Paire d'images qui encadre l'instant à dessiner.
+ */
+bool net_jitter_sample(NetJitter *jitter, double now, const NetFrame **from, const NetFrame **to, float *alpha)
+{
+    if (jitter->count == 0)
+        return false;
+    double tick = (now + jitter->offset - NET_INTERP_DELAY) * TARGET_FPS;
+    int last = jitter_slot(jitter, jitter->count - 1);
+    *alpha = 0.0f;
+    if (tick >= jitter->ticks[last])
+    {
+        *from = *to = &jitter->frames[last];
+        jitter->underruns += tick > jitter->ticks[last];
+        return true;
+    }
+    *from = *to = &jitter->frames[jitter->first];
+    for (int k = jitter->count - 1; k > 0; k--)
+    {
+        int a = jitter_slot(jitter, k - 1), b = jitter_slot(jitter, k);
+        if (tick >= jitter->ticks[a])
+        {
+            *from = &jitter->frames[a];
+            *to = &jitter->frames[b];
+            *alpha = (float)((tick - jitter->ticks[a]) / (double)(jitter->ticks[b] - jitter->ticks[a]));
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Dernière image reçue.
+ */
+const NetFrame *net_jitter_latest(const NetJitter *jitter)
+{
+    return jitter->count ? &jitter->frames[jitter_slot(jitter, jitter->count - 1)] : NULL;
+}
+
+// ============================================================================
+//                          2. PRÉDICTION DU VAISSEAU LOCAL
+// ============================================================================
+
+/**
+ * @brief Prépare une prédiction inactive.
+ */
+void net_predict_init(NetPredict *predict)
+{
+    memset(predict, 0, sizeof(*predict));
+}
+
+/**
+ * @brief Applique une commande locale au vaisseau prédit.
+ */
+void net_predict_command(NetPredict *predict, const GameModel *model, GameCommand cmd)
+{
+    (void)model_ship_command(model, &predict->ship, cmd); // Le tir reste au serveur
+}
+
+/**
+ * @brief Simule les ticks locaux écoulés jusqu'à `now`.
+ *
+ * Après un long arrêt (plus de NET_PREDICT_HISTORY ticks), l'horloge repart
+ * de `now` : la prochaine image reprend la position de toute façon.
+ */
+void net_predict_advance(NetPredict *predict, const GameModel *model, double now)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    if (predict->clock == 0.0 || now - predict->clock > NET_PREDICT_HISTORY * dt)
+        predict->clock = now;
+    while (predict->clock <= now)
+    {
+        predict->dx[predict->ticks % NET_PREDICT_HISTORY] = predict->ship.dx;
+        predict->ticks++;
+        if (predict->active)
+            model_step_ship(&predict->ship, model->sim.fixed_point, dt);
+        predict->error *= NET_PREDICT_DECAY;
+        predict->clock += dt;
+    }
+}
+
+/**
+ * @brief Reprend la position d'une image du serveur et rejoue les ticks qu'il n'a pas vus.
+ *
+ * L'image a été produite un aller-retour après les commandes qu'elle
+ * reflète : les ticks locaux de ce dernier aller-retour sont rejoués, avec
+ * les vitesses qu'ils ont eues.
+ */
+void net_predict_reconcile(NetPredict *predict, const GameModel *latest, bool player, double rtt)
+{
+    const Entity *auth = &latest->sim.player;
+    if (!player || latest->sim.state != STATE_PLAYING || !auth->active)
+    {
+        predict->active = false;
+        predict->error = 0.0f;
+        predict->ship.x = auth->x;
+        predict->ship.y = auth->y;
+        return;
+    }
+
+    int replay = (int)lrint(rtt * TARGET_FPS);
+    if (replay > (int)predict->ticks)
+        replay = (int)predict->ticks;
+    if (replay > NET_PREDICT_HISTORY)
+        replay = NET_PREDICT_HISTORY;
+    Entity ship = predict->ship;
+    ship.x = auth->x;
+    ship.y = auth->y;
+    for (uint32_t t = predict->ticks - (uint32_t)replay; t != predict->ticks; t++)
+    {
+        ship.dx = predict->dx[t % NET_PREDICT_HISTORY];
+        model_step_ship(&ship, latest->sim.fixed_point, 1.0 / TARGET_FPS);
+    }
+    ship.dx = predict->ship.dx;
+
+    if (predict->active)
+    {
+        float error = predict->ship.x - ship.x;
+        if (fabsf(error) > NET_PREDICT_SNAP)
+            predict->error = 0.0f; // Vaisseau replacé par le serveur : pas de glissade
+        else if (fabsf(error) > 1.0f / PACK_SCALE) // En deçà : arrondi des positions transmises
+        {
+            predict->error += error;
+            predict->corrections++;
+            predict->error_sum += fabsf(error);
+            if (fabsf(error) > predict->error_max)
+                predict->error_max = fabsf(error);
+        }
+    }
+    predict->ship = ship;
+    predict->active = true;
+}
+
+/**
+ * @brief Abscisse à dessiner.
+ */
+float net_predict_x(const NetPredict *predict)
+{
+    return predict->ship.x + predict->error;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file overlay.c
+ * @brief Implémentation de l'image partagée (mmap, seqlock à un seul écrivain).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour mmap et ftruncate).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "overlay.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Octets de l'image avant ses éléments. */
+#define FRAME_HEAD offsetof(OverlayFrame, items)
+
+/** @brief Bloc projeté par le jeu (NULL : pas de publication). */
+static OverlayBlock *block = NULL;
+
+/** @brief Scène publiée, reconstruite à chaque nouvel état. */
+static SceneList scene;
+
+/** @brief En-tête de l'image en préparation (mesures, score). */
+static OverlayFrame head;
+
+/**
+ * @brief Dernière mesure et moyenne de session de chaque phase, compteurs de la frame.
+ */
+static void fill_measures(OverlayFrame *f)
+{
+    for (int p = 0; p < PROF_PHASE_COUNT; p++)
+    {
+        const ProfilerPhaseData *d = profiler_phase((ProfilerPhase)p);
+        f->frame_ms[p] = d->count > 0 ? d->window[(d->next + PROFILER_WINDOW - 1) % PROFILER_WINDOW] * 1000.0f : 0.0f;
+        f->avg_ms[p] = d->count > 0 ? (float)(d->sum / (double)d->count * 1000.0) : 0.0f;
+    }
+    for (int c = 0; c < PROF_COUNTER_COUNT; c++)
+        f->counters[c] = profiler_counter((ProfilerCounter)c);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Fichier ramené à la taille du bloc, version et image à zéro, puis l'en-tête.
+ */
+bool overlay_open(const char *path)
+{
+    overlay_close();
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(OverlayBlock)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, sizeof(OverlayBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // La projection garde le fichier
+    if (map == MAP_FAILED)
+        return false;
+
+    block = map;
+    block->size = sizeof(OverlayFrame);
+    __atomic_store_n(&block->magic, OVERLAY_MAGIC, __ATOMIC_RELEASE);
+    memset(&head, 0, sizeof(head));
+    scene_invalidate(&scene);
+    return true;
+}
+
+/**
+ * @brief Version impaire, en-tête et éléments valides, version paire.
+ */
+void overlay_publish(const GameModel *model)
+{
+    if (!block)
+        return;
+    if (scene_update(&scene, model, NULL))
+    {
+        memcpy(head.first, scene.first, sizeof(head.first));
+        head.count = scene.count;
+    }
+    head.frame++;
+    head.gen = model->ui.gen[MODEL_GEN_ANY];
+    head.state = (int32_t)model->sim.state;
+    head.score = model->sim.score;
+    head.lives = model->sim.lives;
+    head.level = model->sim.level;
+    fill_measures(&head);
+
+    uint32_t v = __atomic_load_n(&block->version, __ATOMIC_RELAXED);
+    __atomic_store_n(&block->version, v + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&block->frame, &head, FRAME_HEAD);
+    memcpy(block->frame.items, scene.items, (size_t)scene.count * sizeof(SceneItem));
+    __atomic_store_n(&block->version, v + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Compteur de l'en-tête.
+ */
+uint64_t overlay_published(void)
+{
+    return head.frame;
+}
+
+/**
+ * @brief Projection rendue, plus de publication.
+ */
+void overlay_close(void)
+{
+    if (block)
+        munmap(block, sizeof(OverlayBlock));
+    block = NULL;
+}
+
+/**
+ * @brief Projection en lecture seule : un lecteur ne peut pas abîmer le bloc.
+ */
+bool overlay_attach(OverlayReader *reader, const char *path)
+{
+    memset(reader, 0, sizeof(OverlayReader));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size != (off_t)sizeof(OverlayBlock))
+    {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, sizeof(OverlayBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+    const OverlayBlock *b = map;
+    if (__atomic_load_n(&b->magic, __ATOMIC_ACQUIRE) != OVERLAY_MAGIC || b->size != sizeof(OverlayFrame))
+    {
+        munmap(map, sizeof(OverlayBlock));
+        return false;
+    }
+    reader->block = b;
+    return true;
+}
+
+/**
+ * @brief Version paire, copie, même version après la copie ; sinon, nouvel essai.
+ */
+bool overlay_read(OverlayReader *reader, OverlayFrame *out)
+{
+    const OverlayBlock *b = reader->block;
+    if (!b)
+        return false;
+    for (int tries = 0; tries < OVERLAY_READ_TRIES; tries++)
+    {
+        uint32_t v1 = __atomic_load_n(&b->version, __ATOMIC_ACQUIRE);
+        if (v1 == 0)
+            return false; // Rien de publié
+        if (!(v1 & 1))
+        {
+            memcpy(out, (const void *)&b->frame, FRAME_HEAD);
+            int count = out->count;
+            if (count >= 0 && count <= SCENE_MAX_ITEMS) // Un compte déchiré est écarté par la version
+                memcpy(out->items, (const void *)b->frame.items, (size_t)count * sizeof(SceneItem));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&b->version, __ATOMIC_RELAXED) == v1)
+                return true;
+        }
+        reader->retries++;
+    }
+    reader->misses++;
+    return false;
+}
+
+/**
+ * @brief Projection du lecteur rendue.
+ */
+void overlay_detach(OverlayReader *reader)
+{
+    if (reader->block)
+        munmap((void *)reader->block, sizeof(OverlayBlock));
+    reader->block = NULL;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file params.c
+ * @brief Implémentation des paramètres d'équilibrage et de leur bloc partagé (mmap, seqlock).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour mmap et ftruncate).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "params.h"
+#include "model.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Un paramètre : nom, place dans SimParams, plage.
+ */
+typedef struct
+{
+    const char *name; ///< Clé des affectations `cle=valeur`.
+    size_t offset;    ///< Place du champ.
+    bool integer;     ///< int32_t (sinon float).
+    double min, max;  ///< Plage admise (bornes comprises).
+} ParamField;
+
+/** @brief Paramètres, dans l'ordre de SimParams. */
+static const ParamField fields[] = {
+    {"player_speed", offsetof(SimParams, player_speed), false, 1.0, 400.0},
+    {"bullet_speed", offsetof(SimParams, bullet_speed), false, 1.0, 400.0},
+    {"enemy_speed", offsetof(SimParams, enemy_speed), false, 0.0, 200.0},
+    {"enemy_drop", offsetof(SimParams, enemy_drop), false, 0.0, 10.0},
+    {"ufo_speed", offsetof(SimParams, ufo_speed), false, 0.0, 200.0},
+    {"ufo_odds", offsetof(SimParams, ufo_odds), true, 1.0, 1000000.0},
+    {"fire_percent", offsetof(SimParams, fire_percent), true, 0.0, 1000.0},
+};
+#define FIELD_COUNT ((int)(sizeof(fields) / sizeof(fields[0])))
+
+/** @brief Valeur d'un champ, en double. */
+static double field_get(const SimParams *p, const ParamField *f)
+{
+    const char *at = (const char *)p + f->offset;
+    return f->integer ? (double)*(const int32_t *)at : (double)*(const float *)at;
+}
+
+/** @brief Écrit un champ. */
+static void field_put(SimParams *p, const ParamField *f, double v)
+{
+    char *at = (char *)p + f->offset;
+    if (f->integer)
+        *(int32_t *)at = (int32_t)v;
+    else
+        *(float *)at = (float)v;
+}
+
+/** @brief Bloc projeté (NULL : pas de réglage en direct). */
+static ParamsBlock *live = NULL;
+
+/** @brief Dernière version lue par params_live_poll. */
+static uint32_t live_seen = 0;
+
+/** @brief Versions refusées (valeurs hors plage). */
+static uint64_t live_rejected = 0;
+
+/**
+ * @brief Copie stable des valeurs : version paire, identique avant et après la copie.
+ * @return false si une écriture est en cours (à reprendre plus tard).
+ */
+static bool live_snapshot(SimParams *out, uint32_t *version)
+{
+    uint32_t v1 = __atomic_load_n(&live->version, __ATOMIC_ACQUIRE);
+    if (v1 & 1)
+        return false;
+    memcpy(out, (const void *)&live->values, sizeof(SimParams));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&live->version, __ATOMIC_RELAXED) != v1)
+        return false;
+    *version = v1;
+    return true;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Les constantes de model.h.
+ */
+void params_default(SimParams *p)
+{
+    memset(p, 0, sizeof(SimParams));
+    p->player_speed = PLAYER_SPEED;
+    p->bullet_speed = BULLET_SPEED;
+    p->enemy_speed = ENEMY_SPEED_BASE;
+    p->enemy_drop = ENEMY_DROP_HEIGHT;
+    p->ufo_speed = UFO_SPEED;
+    p->ufo_odds = UFO_SPAWN_ODDS;
+    p->fire_percent = 100;
+}
+
+/**
+ * @brief Comparaison octet à octet aux valeurs par défaut.
+ */
+bool params_is_default(const SimParams *p)
+{
+    SimParams d;
+    params_default(&d);
+    return memcmp(p, &d, sizeof(SimParams)) == 0;
+}
+
+/**
+ * @brief Chaque champ dans sa plage (un NaN n'y est jamais).
+ */
+bool params_valid(const SimParams *p)
+{
+    for (int k = 0; k < FIELD_COUNT; k++)
+    {
+        double v = field_get(p, &fields[k]);
+        if (!(v >= fields[k].min && v <= fields[k].max))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Clé cherchée dans la table, valeur lue en entier ou en réel selon le champ.
+ */
+bool params_set(SimParams *p, const char *assignment)
+{
+    const char *eq = strchr(assignment, '=');
+    if (!eq)
+        return false;
+    size_t len = (size_t)(eq - assignment);
+    for (int k = 0; k < FIELD_COUNT; k++)
+    {
+        const ParamField *f = &fields[k];
+        if (strlen(f->name) != len || strncmp(f->name, assignment, len) != 0)
+            continue;
+        char *end;
+        double v = f->integer ? (double)strtol(eq + 1, &end, 10) : strtod(eq + 1, &end);
+        if (end == eq + 1 || *end != '\0' || !(v >= f->min && v <= f->max))
+            return false;
+        field_put(p, f, v);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Une ligne par champ, dans l'ordre de la table.
+ */
+int params_format(const SimParams *p, char *out, size_t cap)
+{
+    size_t n = 0;
+    if (cap > 0)
+        out[0] = '\0';
+    for (int k = 0; k < FIELD_COUNT && n < cap; k++)
+    {
+        const ParamField *f = &fields[k];
+        int w = f->integer ? snprintf(out + n, cap - n, "%s=%d\n", f->name, (int)field_get(p, f))
+                           : snprintf(out + n, cap - n, "%s=%g\n", f->name, field_get(p, f));
+        if (w < 0)
+            break;
+        n += (size_t)w < cap - n ? (size_t)w : cap - n - 1;
+    }
+    return (int)n;
+}
+
+/**
+ * @brief Fichier agrandi à la taille du bloc s'il est vide, puis projeté en MAP_SHARED.
+ */
+bool params_live_open(const char *path)
+{
+    params_live_close();
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    bool fresh = fstat(fd, &st) == 0 && st.st_size == 0;
+    if ((fresh && ftruncate(fd, sizeof(ParamsBlock)) != 0) ||
+        (!fresh && st.st_size != (off_t)sizeof(ParamsBlock)))
+    {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, sizeof(ParamsBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // La projection garde le fichier
+    if (map == MAP_FAILED)
+        return false;
+
+    ParamsBlock *b = map;
+    if (fresh)
+    {
+        params_default(&b->values);
+        b->size = sizeof(SimParams);
+        __atomic_store_n(&b->magic, PARAMS_MAGIC, __ATOMIC_RELEASE);
+    }
+    if (b->magic != PARAMS_MAGIC || b->size != sizeof(SimParams))
+    {
+        munmap(map, sizeof(ParamsBlock));
+        return false;
+    }
+    live = b;
+    live_rejected = 0;
+    if (fresh)
+        live_seen = __atomic_load_n(&b->version, __ATOMIC_ACQUIRE); // Valeurs par défaut : rien à appliquer
+    else
+        live_seen = ~0u; // Bloc déjà réglé : appliqué au premier tick
+    return true;
+}
+
+/**
+ * @brief Une lecture atomique par appel tant que la version ne change pas.
+ */
+bool params_live_poll(SimParams *p)
+{
+    if (!live || __atomic_load_n(&live->version, __ATOMIC_ACQUIRE) == live_seen)
+        return false;
+    SimParams next;
+    uint32_t version;
+    if (!live_snapshot(&next, &version))
+        return false; // Écriture en cours : tick suivant
+    live_seen = version;
+    if (!params_valid(&next))
+    {
+        live_rejected++;
+        return false;
+    }
+    if (memcmp(p, &next, sizeof(SimParams)) == 0)
+        return false;
+    *p = next;
+    return true;
+}
+
+/**
+ * @brief Version impaire, valeurs, version paire (un seul écrivain à la fois).
+ */
+void params_live_publish(const SimParams *p)
+{
+    if (!live)
+        return;
+    uint32_t v = __atomic_load_n(&live->version, __ATOMIC_RELAXED);
+    __atomic_store_n(&live->version, v + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy((void *)&live->values, p, sizeof(SimParams));
+    __atomic_store_n(&live->version, v + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copie stable, reprise tant qu'une écriture est en cours.
+ */
+bool params_live_read(SimParams *out)
+{
+    if (!live)
+        return false;
+    uint32_t version;
+    while (!live_snapshot(out, &version))
+        ;
+    return true;
+}
+
+/**
+ * @brief Compteur de params_live_poll.
+ */
+uint64_t params_live_rejected(void)
+{
+    return live_rejected;
+}
+
+/**
+ * @brief Projection rendue, plus de réglage en direct.
+ */
+void params_live_close(void)
+{
+    if (live)
+        munmap(live, sizeof(ParamsBlock));
+    live = NULL;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file particles.c
+ * @brief Implémentation de la réserve de particules (émission, intégration, retrait).
+ */
+
+#include "particles.h"
+#include "simd.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Tirage xorshift32, ramené dans [0, 1).
+ */
+static float particle_rand(ParticlePool *pool)
+{
+    uint32_t s = pool->rng;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    pool->rng = s;
+    return (s >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Recopie la particule `from` dans le slot `to`.
+ */
+static void particle_move(ParticlePool *pool, int to, int from)
+{
+    pool->x[to] = pool->x[from];
+    pool->y[to] = pool->y[from];
+    pool->vx[to] = pool->vx[from];
+    pool->vy[to] = pool->vy[from];
+    pool->life[to] = pool->life[from];
+    pool->inv_life[to] = pool->inv_life[from];
+    pool->alpha[to] = pool->alpha[from];
+    pool->color[to] = pool->color[from];
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Alloue les tableaux de la réserve en un seul bloc.
+ */
+bool particles_init(ParticlePool *pool, int capacity)
+{
+    memset(pool, 0, sizeof(*pool));
+    pool->spawn_scale = 1.0f;
+    pool->rng = 0x9E3779B9u;
+    if (capacity <= 0)
+        return false;
+
+    int cap = (capacity + 63) & ~63;
+    size_t floats = (size_t)cap * sizeof(float);
+    size_t size = 7 * floats + (size_t)cap * sizeof(uint32_t) + (size_t)(cap / 64) * sizeof(uint64_t);
+    char *p = malloc(size);
+    if (!p)
+        return false;
+
+    pool->block = p;
+    pool->dead = (uint64_t *)p; // En tête : alignement sur 8 octets garanti
+    p += (size_t)(cap / 64) * sizeof(uint64_t);
+    float **lanes[] = {&pool->x, &pool->y, &pool->vx, &pool->vy, &pool->life, &pool->inv_life, &pool->alpha};
+    for (int i = 0; i < 7; i++, p += floats)
+        *lanes[i] = (float *)p;
+    pool->color = (uint32_t *)p;
+    pool->capacity = cap;
+    return true;
+}
+
+/**
+ * @brief Libère le bloc de la réserve.
+ */
+void particles_free(ParticlePool *pool)
+{
+    free(pool->block);
+    memset(pool, 0, sizeof(*pool));
+}
+
+/**
+ * @brief Émet une gerbe, réduite par `spawn_scale` et bornée par la place restante.
+ */
+int particles_burst(ParticlePool *pool, float x, float y, int count, uint32_t color, float speed, float life)
+{
+    int wanted = count;
+    count = (int)(count * pool->spawn_scale + 0.5f);
+    if (count > pool->capacity - pool->count)
+        count = pool->capacity - pool->count;
+    if (count < 0)
+        count = 0;
+    pool->dropped += (uint64_t)(wanted - count);
+
+    for (int k = 0; k < count; k++)
+    {
+        int i = pool->count++;
+        float angle = particle_rand(pool) * 6.2831853f;
+        float v = speed * (0.25f + 0.75f * particle_rand(pool));
+        float t = life * (0.5f + 0.5f * particle_rand(pool));
+        pool->x[i] = x;
+        pool->y[i] = y;
+        pool->vx[i] = cosf(angle) * v;
+        pool->vy[i] = sinf(angle) * v;
+        pool->life[i] = t;
+        pool->inv_life[i] = 1.0f / t;
+        pool->alpha[i] = 1.0f;
+        pool->color[i] = color;
+    }
+    pool->spawned += (uint64_t)count;
+    return count;
+}
+
+/**
+ * @brief Intègre (noyau vectorisé), puis retire les particules mortes.
+ *
+ * Les mortes sont parcourues de la plus haute à la plus basse : la dernière
+ * particule, qui prend la place libérée, est donc toujours vivante.
+ */
+void particles_update(ParticlePool *pool, float dt)
+{
+    int n = pool->count;
+    if (n == 0)
+        return;
+    int words = (n + 63) >> 6;
+    memset(pool->dead, 0, (size_t)words * sizeof(uint64_t));
+    simd_particle_step(pool->x, pool->y, pool->vx, pool->vy, pool->life, pool->inv_life, pool->alpha,
+                       n, dt, PARTICLE_GRAVITY, pool->dead);
+
+    for (int w = words - 1; w >= 0; w--)
+    {
+        uint64_t bits = pool->dead[w];
+        while (bits)
+        {
+            int b = 63 - __builtin_clzll(bits);
+            bits &= ~(1ULL << b);
+            int i = (w << 6) + b;
+            if (i != --n)
+                particle_move(pool, i, n);
+        }
+    }
+    pool->count = n;
+}
+
+/**
+ * @brief Réduit ou rétablit la taille des gerbes selon la durée de frame.
+ */
+void particles_pace(ParticlePool *pool, double frame_time, double budget)
+{
+    if (frame_time > budget)
+    {
+        pool->spawn_scale *= 0.5f;
+        if (pool->spawn_scale < PARTICLE_SCALE_MIN)
+            pool->spawn_scale = PARTICLE_SCALE_MIN;
+    }
+    else
+    {
+        pool->spawn_scale += PARTICLE_SCALE_RECOVER;
+        if (pool->spawn_scale > 1.0f)
+            pool->spawn_scale = 1.0f;
+    }
+}
+
+/**
+ * @brief Vide la réserve sans la libérer.
+ */
+void particles_clear(ParticlePool *pool)
+{
+    pool->count = 0;
+}
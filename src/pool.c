@@ -0,0 +1,397 @@
+/**
+ * @file pool.c
+ * @brief Implémentation du pool de threads des parties headless.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour sysconf).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "pool.h"
+#include "headless.h"
+#include "replay.h"
+#include "utils.h"
+
+#include <dirent.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. TRANCHES DE TÂCHES
+// ============================================================================
+
+/**
+ * @brief Tâches restantes d'un thread : [next, end), sous son verrou.
+ */
+typedef struct
+{
+    pthread_mutex_t lock; ///< Protège next et end (propriétaire et voleurs).
+    long next;            ///< Prochaine tâche du propriétaire.
+    long end;             ///< Fin exclue (les voleurs la font reculer).
+} JobRange;
+
+/**
+ * @brief Un thread du pool : ses tâches, ses modèles, son résumé partiel.
+ */
+typedef struct
+{
+    const PoolConfig *cfg; ///< Travail commun (lecture seule).
+    JobRange *ranges;      ///< Tranches de tous les threads (une par thread).
+    int count;             ///< Nombre de threads.
+    int id;                ///< Index de ce thread (sa tranche).
+    PoolSummary part;      ///< Résumé de ses parties.
+    pthread_t thread;      ///< Handle POSIX.
+} PoolWorker;
+
+/**
+ * @brief Prend la prochaine tâche de sa tranche, sinon vole la moitié d'une autre.
+ *
+ * Un seul verrou est tenu à la fois : la tranche volée est retirée à la
+ * victime, puis installée chez le voleur.
+ *
+ * @return false quand plus aucune tranche n'a de tâche.
+ */
+static bool take_job(PoolWorker *w, long *job)
+{
+    JobRange *own = &w->ranges[w->id];
+    pthread_mutex_lock(&own->lock);
+    bool found = own->next < own->end;
+    if (found)
+        *job = own->next++;
+    pthread_mutex_unlock(&own->lock);
+    if (found)
+        return true;
+
+    for (int k = 1; k < w->count; k++)
+    {
+        JobRange *victim = &w->ranges[(w->id + k) % w->count];
+        pthread_mutex_lock(&victim->lock);
+        long left = victim->end - victim->next;
+        long lo = victim->end - (left + 1) / 2;
+        long hi = victim->end;
+        if (left > 0)
+            victim->end = lo;
+        pthread_mutex_unlock(&victim->lock);
+        if (left <= 0)
+            continue;
+
+        pthread_mutex_lock(&own->lock);
+        own->next = lo + 1;
+        own->end = hi;
+        pthread_mutex_unlock(&own->lock);
+        *job = lo;
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+//                          2. PARTIES
+// ============================================================================
+
+/**
+ * @brief Résumé vide (extrêmes prêts pour la première partie).
+ */
+static void summary_clear(PoolSummary *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->score_min = -1;
+    s->best_job = -1;
+}
+
+/**
+ * @brief Ajoute une partie au résumé.
+ */
+static void summary_add(PoolSummary *s, long job, int score, int level, long ticks, bool finished)
+{
+    s->games++;
+    s->unfinished += !finished;
+    s->ticks += ticks;
+    s->score_sum += score;
+    s->score_sq_sum += (double)score * score;
+    s->level_sum += level;
+    if (s->score_min < 0 || score < s->score_min)
+        s->score_min = score;
+    if (s->best_job < 0 || score > s->score_max || (score == s->score_max && job < s->best_job))
+    {
+        s->score_max = score;
+        s->best_job = job;
+    }
+    int bucket = (level < 1) ? 0 : (level > POOL_LEVELS ? POOL_LEVELS : level) - 1;
+    s->levels[bucket]++;
+}
+
+/**
+ * @brief Ajoute le résumé partiel d'un thread au résumé global.
+ */
+static void summary_merge(PoolSummary *into, const PoolSummary *s)
+{
+    if (s->games > 0)
+    {
+        if (into->score_min < 0 || s->score_min < into->score_min)
+            into->score_min = s->score_min;
+        if (into->best_job < 0 || s->score_max > into->score_max ||
+            (s->score_max == into->score_max && s->best_job < into->best_job))
+        {
+            into->score_max = s->score_max;
+            into->best_job = s->best_job;
+        }
+    }
+    into->games += s->games;
+    into->unfinished += s->unfinished;
+    into->failed += s->failed;
+    into->invalid += s->invalid;
+    into->ticks += s->ticks;
+    into->score_sum += s->score_sum;
+    into->score_sq_sum += s->score_sq_sum;
+    into->level_sum += s->level_sum;
+    for (int i = 0; i < POOL_LEVELS; i++)
+        into->levels[i] += s->levels[i];
+}
+
+/**
+ * @brief Joue une tâche sur `model`, remis à l'état de `fresh` au préalable.
+ */
+static void run_job(PoolWorker *w, GameModel *model, const GameModel *fresh, long job)
+{
+    const PoolConfig *cfg = w->cfg;
+    model_copy(model, fresh);
+
+    if (cfg->verdicts)
+    {
+        // Chaque tâche n'écrit que son verdict : aucun verrou
+        ReplayStats rs;
+        PoolVerdict *v = &cfg->verdicts[job];
+        v->verdict = replay_verify(model, cfg->replays[job], &rs);
+        v->claimed_score = rs.claimed_score;
+        v->score = rs.score;
+        v->desync_tick = rs.desync_tick;
+        w->part.invalid += v->verdict != REPLAY_VALID;
+        if (v->verdict == REPLAY_UNREADABLE)
+        {
+            w->part.failed++;
+            return;
+        }
+        summary_add(&w->part, job, rs.score, rs.level, (long)rs.ticks, rs.state == STATE_GAME_OVER);
+        return;
+    }
+    if (cfg->replays)
+    {
+        ReplayStats rs;
+        if (!replay_run(model, cfg->replays[job], &rs))
+        {
+            w->part.failed++;
+            return;
+        }
+        summary_add(&w->part, job, rs.score, rs.level, (long)rs.ticks, rs.state == STATE_GAME_OVER);
+        return;
+    }
+
+    HeadlessConfig hc;
+    headless_default_config(&hc);
+    hc.max_ticks = cfg->max_ticks;
+    if (cfg->script)
+        hc.script = cfg->script;
+    hc.bot = cfg->bot;
+    hc.stop_on_game_over = true;
+    hc.stop_level = cfg->stop_level;
+    hc.seed = cfg->first_seed + (uint64_t)job;
+    HeadlessStats hs;
+    headless_run(model, &hc, &hs);
+    bool finished = model->sim.state == STATE_GAME_OVER || (cfg->stop_level > 0 && hs.level >= cfg->stop_level);
+    summary_add(&w->part, job, hs.score, hs.level, hs.ticks, finished);
+}
+
+/**
+ * @brief Boucle d'un thread : un modèle de départ et un modèle de travail, réutilisés pour chaque tâche.
+ */
+static void *worker_main(void *arg)
+{
+    PoolWorker *w = arg;
+    GameModel *fresh = model_init();
+    GameModel *model = fresh ? model_clone(fresh) : NULL;
+    long job;
+    while (take_job(w, &job))
+    {
+        if (model)
+            run_job(w, model, fresh, job);
+        else
+            w->part.failed++;
+    }
+    model_free(model);
+    model_free(fresh);
+    return NULL;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Découpe les tâches en tranches, lance les threads, puis fusionne leurs résumés.
+ */
+bool pool_run(const PoolConfig *cfg, PoolSummary *out)
+{
+    static PoolWorker workers[POOL_MAX_THREADS];
+    static JobRange ranges[POOL_MAX_THREADS];
+    long jobs = cfg->replays ? cfg->replay_count : cfg->games;
+    int count = cfg->threads > 0 ? cfg->threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1)
+        count = 1;
+    if (count > POOL_MAX_THREADS)
+        count = POOL_MAX_THREADS;
+    if (jobs < count)
+        count = jobs > 0 ? (int)jobs : 1;
+
+    summary_clear(out);
+    double start = utils_get_time();
+    int started = 0;
+    for (int i = 0; i < count; i++)
+    {
+        pthread_mutex_init(&ranges[i].lock, NULL);
+        ranges[i].next = jobs * i / count;
+        ranges[i].end = jobs * (i + 1) / count;
+        workers[i].cfg = cfg;
+        workers[i].ranges = ranges;
+        workers[i].count = count;
+        workers[i].id = i;
+        summary_clear(&workers[i].part);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        // Un thread non lancé laisse sa tranche aux autres, qui la volent
+        if (pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]) != 0)
+            break;
+        started++;
+    }
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i].thread, NULL);
+        summary_merge(out, &workers[i].part);
+    }
+    for (int i = 0; i < count; i++)
+        pthread_mutex_destroy(&ranges[i].lock);
+
+    out->threads = started;
+    out->elapsed = utils_get_time() - start;
+    return started > 0;
+}
+
+/** @brief Ordre alphabétique des chemins (qsort). */
+static int compare_paths(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * @brief Chemins des fichiers `.rpl` d'un dossier, triés : le bilan ne dépend pas de l'ordre de readdir.
+ */
+char **pool_list_replays(const char *dir, int *count)
+{
+    DIR *d = opendir(dir);
+    if (!d)
+        return NULL;
+    char **paths = NULL;
+    int n = 0, cap = 0;
+    bool ok = true;
+    struct dirent *ent;
+    while (ok && (ent = readdir(d)) != NULL)
+    {
+        size_t len = strlen(ent->d_name);
+        if (len <= 4 || strcmp(ent->d_name + len - 4, ".rpl") != 0)
+            continue;
+        if (n == cap)
+        {
+            cap = cap ? cap * 2 : 256;
+            char **grown = realloc(paths, (size_t)cap * sizeof(char *));
+            ok = grown != NULL;
+            if (!ok)
+                break;
+            paths = grown;
+        }
+        size_t size = strlen(dir) + len + 2;
+        ok = (paths[n] = malloc(size)) != NULL;
+        if (ok)
+            snprintf(paths[n++], size, "%s/%s", dir, ent->d_name);
+    }
+    closedir(d);
+    if (!ok)
+    {
+        pool_free_replays(paths, n);
+        return NULL;
+    }
+    qsort(paths, (size_t)n, sizeof(char *), compare_paths);
+    *count = n;
+    return paths ? paths : malloc(sizeof(char *)); // Dossier sans enregistrement : liste vide, pas une erreur
+}
+
+/**
+ * @brief Libère une liste obtenue par pool_list_replays.
+ */
+void pool_free_replays(char **paths, int count)
+{
+    for (int i = 0; i < count; i++)
+        free(paths[i]);
+    free(paths);
+}
+
+/**
+ * @brief Liste les enregistrements invalides, dans l'ordre des tâches, puis le décompte.
+ */
+static void print_verdicts(const PoolConfig *cfg, const PoolSummary *s)
+{
+    for (int i = 0; i < cfg->replay_count; i++)
+    {
+        const PoolVerdict *v = &cfg->verdicts[i];
+        if (v->verdict == REPLAY_VALID)
+            continue;
+        printf("[VERIFY] %s : %s", cfg->replays[i], replay_verdict_label(v->verdict));
+        if (v->verdict == REPLAY_DESYNC)
+            printf(" (divergence avant le tick %llu)", (unsigned long long)v->desync_tick);
+        else if (v->verdict == REPLAY_WRONG_RESULT)
+            printf(" (score annoncé %d, rejoué %d)", v->claimed_score, v->score);
+        printf("\n");
+    }
+    printf("[VERIFY] Valides       : %ld / %d (%ld invalides)\n", cfg->replay_count - s->invalid, cfg->replay_count,
+           s->invalid);
+}
+
+/**
+ * @brief Affiche le résumé sur la sortie standard.
+ */
+void pool_print_summary(const PoolConfig *cfg, const PoolSummary *s)
+{
+    double games = s->games > 0 ? (double)s->games : 1.0;
+    double mean = s->score_sum / games;
+    double var = s->score_sq_sum / games - mean * mean;
+    double sem = s->games > 1 ? sqrt((var > 0 ? var : 0) / (games - 1)) : 0.0;
+
+    printf("[POOL] Parties       : %ld (%ld non terminées, %ld échecs)\n", s->games, s->unfinished, s->failed);
+    printf("[POOL] Threads       : %d\n", s->threads);
+    printf("[POOL] Temps reel    : %.3f s (%.0f parties/s, %.0f steps/s)\n", s->elapsed,
+           s->elapsed > 0 ? s->games / s->elapsed : 0.0, s->elapsed > 0 ? s->ticks / s->elapsed : 0.0);
+    printf("[POOL] Ticks         : %lld (%.0f par partie)\n", s->ticks, s->ticks / games);
+    printf("[POOL] Score         : moyenne %.1f +/- %.1f, min %d, max %d\n", mean, sem,
+           s->score_min < 0 ? 0 : s->score_min, s->score_max);
+    if (s->best_job >= 0)
+    {
+        if (cfg->replays)
+            printf("[POOL] Meilleure     : %s\n", cfg->replays[s->best_job]);
+        else
+            printf("[POOL] Meilleure     : graine 0x%llx\n", (unsigned long long)(cfg->first_seed + (uint64_t)s->best_job));
+    }
+    printf("[POOL] Niveau        : moyenne %.2f\n", s->level_sum / games);
+    for (int i = 0; i < POOL_LEVELS; i++)
+    {
+        if (s->levels[i] == 0)
+            continue;
+        printf("[POOL]   niveau %2d%s : %ld (%.1f %%)\n", i + 1, i == POOL_LEVELS - 1 ? "+" : " ",
+               s->levels[i], 100.0 * s->levels[i] / games);
+    }    if (cfg->verdicts)
+        print_verdicts(cfg, s);
+}
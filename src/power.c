@@ -0,0 +1,127 @@
+/**
+ * @file power.c
+ * @brief Implémentation du régulateur d'énergie (SDL_GetPowerInfo, zones thermiques Linux).
+ */
+
+#include "power.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Température la plus haute des zones thermiques, en °C (-1 : aucune lisible).
+ *
+ * Chaque zone donne des millièmes de degré dans un petit fichier de sysfs
+ * (lecture en mémoire, sans disque).
+ */
+static int read_temperature(void)
+{
+    int hottest = -1;
+#ifdef __linux__
+    for (int z = 0; z < POWER_THERMAL_ZONES; z++)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/class/thermal/thermal_zone%d/temp", z);
+        FILE *f = fopen(path, "r");
+        if (!f)
+            break; // Zones numérotées sans trou
+        long milli;
+        if (fscanf(f, "%ld", &milli) == 1 && milli > 0 && milli / 1000 > hottest)
+            hottest = (int)(milli / 1000);
+        fclose(f);
+    }
+#endif
+    return hottest;
+}
+
+/**
+ * @brief Relit l'alimentation et les températures, puis en déduit le mode.
+ */
+static void poll(PowerGovernor *p)
+{
+    int percent = -1;
+    SDL_PowerState state = SDL_GetPowerInfo(NULL, &percent);
+    p->battery = percent;
+    p->temp_c = read_temperature();
+    if (p->temp_c >= POWER_HOT_C)
+        p->hot = true;
+    else if (p->temp_c < POWER_COOL_C)
+        p->hot = false; // Entre les deux seuils : état inchangé
+    if (p->hot)
+        p->mode = POWER_HOT;
+    else
+        p->mode = state == SDL_POWERSTATE_ON_BATTERY ? POWER_BATTERY : POWER_MAINS;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief "0" : coupé ; "batterie" ou "chauffe" : mode fixé ; sinon, relu toutes les POWER_POLL_S secondes.
+ */
+void power_init(PowerGovernor *p)
+{
+    memset(p, 0, sizeof(*p));
+    p->mode = POWER_MAINS;
+    p->battery = p->temp_c = -1;
+    const char *env = getenv("SPACE_INVADERS_POWER");
+    if (env && strcmp(env, "0") == 0)
+        return;
+    if (env && strcmp(env, "batterie") == 0)
+        p->mode = POWER_BATTERY;
+    else if (env && strcmp(env, "chauffe") == 0)
+        p->mode = POWER_HOT;
+    else
+    {
+        p->automatic = true;
+        poll(p);
+    }
+}
+
+/**
+ * @brief Lecture espacée de POWER_POLL_S : quelques petits fichiers, hors de la plupart des images.
+ */
+bool power_update(PowerGovernor *p, double now)
+{
+    if (!p->automatic || now < p->next_poll)
+        return false;
+    p->next_poll = now + POWER_POLL_S;
+    int before = p->mode;
+    poll(p);
+    if (p->mode == before)
+        return false;
+    p->changes++;
+    return true;
+}
+
+/**
+ * @brief Batterie ou chauffe.
+ */
+bool power_saving(int mode)
+{
+    return mode == POWER_BATTERY || mode == POWER_HOT;
+}
+
+/**
+ * @brief POWER_SAVER_HZ au plus en mode économe, la cadence nominale sinon.
+ */
+int power_render_hz(int mode, int nominal_hz)
+{
+    return power_saving(mode) && nominal_hz > POWER_SAVER_HZ ? POWER_SAVER_HZ : nominal_hz;
+}
+
+/**
+ * @brief Nom affiché par le panneau de performances et le journal.
+ */
+const char *power_name(int mode)
+{
+    static const char *const names[POWER_MODE_COUNT] = {"secteur", "batterie", "chauffe"};
+    return (mode >= 0 && mode < POWER_MODE_COUNT) ? names[mode] : "?";
+}
@@ -0,0 +1,549 @@
+/**
+ * @file profiler.c
+ * @brief Implémentation du profileur de frames et de sa trace (POSIX).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread_self).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "profiler.h"
+#include "metrics.h"
+#include "utils.h"
+#include "workset.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. ÉTAT & HELPERS
+// ============================================================================
+
+static bool enabled = false;
+static ProfilerPhaseData phases[PROF_PHASE_COUNT];
+static uint32_t counting[PROF_COUNTER_COUNT]; ///< Frame en cours.
+static uint32_t counted[PROF_COUNTER_COUNT];  ///< Dernière frame terminée.
+
+// Trace : file circulaire partagée par les threads qui mesurent
+static bool tracing = false;       ///< Fichier de trace ouvert (profiler_trace_open).
+static bool ring = false;          ///< File remplie (trace ou guet des images lentes).
+static char trace_path[256];
+static uint64_t trace_origin;      ///< Instant 0 du chronogramme (utils_fast_ns).
+static pthread_t trace_main;       ///< Thread principal (ligne 1).
+static uint32_t trace_next;        ///< Prochain index d'écriture (atomique).
+static ProfilerTraceEvent trace_events[PROFILER_TRACE_EVENTS];
+
+/**
+ * @brief Une image lente notée par le guet, avec son contexte.
+ */
+typedef struct
+{
+    uint64_t start;                              ///< Début de la frame (utils_fast_ns).
+    uint64_t duration;                           ///< Durée de la frame (ns).
+    uint32_t counters[PROF_COUNTER_COUNT];       ///< Compteurs de cette frame.
+    const char *keys[PROFILER_HITCH_CONTEXT];    ///< Noms des valeurs de contexte.
+    long values[PROFILER_HITCH_CONTEXT];         ///< Valeurs de contexte.
+    int context;                                 ///< Valeurs données.
+} HitchMark;
+
+// Guet des images lentes : une tranche de trace en attente au plus
+static struct
+{
+    bool on;                               ///< Guet actif.
+    double budget;                         ///< Durée de frame au-delà de laquelle elle est notée (s).
+    char prefix[240];                      ///< Début du nom des tranches.
+    bool detected;                         ///< La frame mesurée en dernier est lente (jusqu'à profiler_frame_end).
+    bool mute;                             ///< La prochaine frame mesurée contient l'écriture d'une tranche.
+    HitchMark marks[PROFILER_HITCH_MARKS]; ///< Images lentes de la tranche en attente.
+    int count;                             ///< Images notées dans la tranche.
+    uint64_t deadline;                     ///< Instant d'écriture de la tranche (utils_fast_ns, 0 : aucune en attente).
+    int written;                           ///< Tranches écrites.
+} hitch;
+
+static const char *const counter_names[PROF_COUNTER_COUNT] = {
+    [PROF_COUNT_TICKS] = "ticks",
+    [PROF_COUNT_DRAW_CALLS] = "appels_dessin",
+    [PROF_COUNT_UPLOADS] = "textures_creees",
+    [PROF_COUNT_TERM_BYTES] = "octets_terminal",
+    [PROF_COUNT_ALLOCS] = "allocations",
+    [PROF_COUNT_DRIVER_ALLOCS] = "allocations_pilote",
+    [PROF_COUNT_SHIELD_ROWS] = "lignes_boucliers",
+    [PROF_COUNT_MIXER_CALLS] = "appels_mixeur",
+};
+
+static const char *const phase_names[PROF_PHASE_COUNT] = {
+    [PROF_FRAME] = "Frame",
+    [PROF_WORK] = "Travail",
+    [PROF_INPUT] = "Commandes",
+    [PROF_UPDATE] = "model_update",
+    [PROF_UPDATE_TIMERS] = "  timers",
+    [PROF_UPDATE_UFO] = "  OVNI",
+    [PROF_UPDATE_ENTITIES] = "  registre",
+    [PROF_UPDATE_ENEMIES] = "  ennemis",
+    [PROF_UPDATE_ENEMY_FIRE] = "  tirs ennemis",
+    [PROF_UPDATE_BULLETS] = "  balles",
+    [PROF_RENDER] = "Rendu",
+    [PROF_SLEEP] = "Attente",
+    [PROF_GPU] = "GPU",
+};
+
+/**
+ * @brief Classe de l'histogramme d'une durée en nanosecondes.
+ *
+ * Sous 8 ns, une classe par nanoseconde ; au-delà, 8 classes par puissance
+ * de 2 (les 3 bits suivant le bit de poids fort).
+ */
+static int bucket_of(uint64_t ns)
+{
+    if (ns < 8)
+        return (int)ns;
+    int e = 63 - __builtin_clzll(ns);
+    int idx = (e - 2) * 8 + (int)((ns >> (e - 3)) & 7);
+    return idx < PROFILER_BUCKETS ? idx : PROFILER_BUCKETS - 1;
+}
+
+/**
+ * @brief Borne supérieure (exclue) d'une classe, en secondes.
+ */
+static double bucket_upper(int idx)
+{
+    if (idx < 8)
+        return (idx + 1) * 1e-9;
+    int e = idx / 8 + 2;
+    return (double)((uint64_t)(9 + idx % 8) << (e - 3)) * 1e-9;
+}
+
+static int compare_float(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Ajoute un événement à la trace (sans verrou ni allocation).
+ *
+ * Chaque thread réserve son emplacement par un incrément atomique, y écrit
+ * l'événement, puis publie son numéro (release) pour la lecture.
+ */
+static void trace_push(ProfilerPhase phase, uint64_t start, uint64_t ns)
+{
+    uint32_t idx = __atomic_fetch_add(&trace_next, 1, __ATOMIC_RELAXED);
+    ProfilerTraceEvent *e = &trace_events[idx % PROFILER_TRACE_EVENTS];
+    __atomic_store_n(&e->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    e->start = start;
+    e->duration = ns < UINT32_MAX ? (uint32_t)ns : UINT32_MAX;
+    e->phase = (uint8_t)phase;
+    e->tid = phase == PROF_GPU ? 4 : pthread_equal(pthread_self(), trace_main) ? 1 : 2;
+    __atomic_store_n(&e->seq, idx + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Note une frame lente dans la tranche en attente (ou en ouvre une).
+ *
+ * Ses compteurs sont ceux de la dernière frame terminée : l'intervalle
+ * mesuré au début d'une frame est celui de la précédente.
+ */
+static void hitch_mark(uint64_t ns, uint64_t end)
+{
+    if (hitch.mute)
+    {
+        hitch.mute = false;
+        return;
+    }
+    if ((double)ns <= hitch.budget * 1e9 || hitch.written >= PROFILER_HITCH_MAX || hitch.count == PROFILER_HITCH_MARKS)
+        return;
+    HitchMark *m = &hitch.marks[hitch.count++];
+    m->start = end - ns;
+    m->duration = ns;
+    memcpy(m->counters, counted, sizeof(m->counters));
+    m->context = 0;
+    if (hitch.deadline == 0)
+        hitch.deadline = end + (uint64_t)(PROFILER_HITCH_WINDOW * 1e9);
+    hitch.detected = true;
+}
+
+/**
+ * @brief Enregistre une mesure terminée à l'instant `end` (0 : inconnu).
+ */
+static void record_at(ProfilerPhase phase, uint64_t ns, uint64_t end)
+{
+    double seconds = (double)ns * 1e-9;
+    if (phase == PROF_FRAME)
+        metrics_observe(METRIC_FRAME, seconds); // Les métriques de flotte se passent du profileur
+    if (!enabled)
+        return;
+    ProfilerPhaseData *d = &phases[phase];
+    d->window[d->next] = (float)seconds;
+    d->next = (d->next + 1) % PROFILER_WINDOW;
+    if (d->count == 0 || seconds < d->min)
+        d->min = seconds;
+    if (seconds > d->max)
+        d->max = seconds;
+    d->count++;
+    d->sum += seconds;
+    d->buckets[bucket_of(ns)]++;
+
+    // L'intervalle entre frames chevaucherait les phases : le chronogramme s'en passe
+    if (ring && phase != PROF_FRAME)
+        trace_push(phase, (end > 0 ? end : utils_fast_ns()) - ns, ns);
+    else if (hitch.on && phase == PROF_FRAME)
+        hitch_mark(ns, end > 0 ? end : utils_fast_ns());
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Active ou coupe les sondes.
+ */
+void profiler_enable(bool on)
+{
+    if (on)
+        utils_fast_clock_init();
+    enabled = on;
+}
+
+/**
+ * @brief Indique si les sondes sont actives.
+ */
+bool profiler_enabled(void)
+{
+    return enabled;
+}
+
+/**
+ * @brief Début d'une mesure.
+ */
+uint64_t profiler_begin(void)
+{
+    return enabled ? utils_fast_ns() : 0;
+}
+
+/**
+ * @brief Fin d'une mesure ; renvoie l'instant courant.
+ */
+uint64_t profiler_end(ProfilerPhase phase, uint64_t start)
+{
+    if (!enabled)
+        return 0;
+    uint64_t now = utils_fast_ns();
+    record_at(phase, now > start ? now - start : 0, now);
+    return now;
+}
+
+/**
+ * @brief Ajoute une durée mesurée à la fenêtre et à l'histogramme.
+ */
+void profiler_record(ProfilerPhase phase, uint64_t ns)
+{
+    record_at(phase, ns, 0);
+}
+
+/**
+ * @brief Ajoute une mesure terminée à `start + ns`.
+ */
+void profiler_record_span(ProfilerPhase phase, uint64_t start, uint64_t ns)
+{
+    record_at(phase, ns, start + ns);
+}
+
+/**
+ * @brief Ajoute `n` au compteur de la frame en cours.
+ */
+void profiler_count(ProfilerCounter counter, uint32_t n)
+{
+    if (enabled)
+        counting[counter] += n;
+}
+
+/**
+ * @brief Valeur d'un compteur sur la dernière frame terminée.
+ */
+uint32_t profiler_counter(ProfilerCounter counter)
+{
+    return counted[counter];
+}
+
+/**
+ * @brief Termine la frame ; écrit la tranche du guet une fois sa fenêtre écoulée.
+ */
+void profiler_frame_end(void)
+{
+    memcpy(counted, counting, sizeof(counted));
+    memset(counting, 0, sizeof(counting));
+    hitch.detected = false;
+    if (hitch.deadline > 0 && utils_fast_ns() >= hitch.deadline)
+    {
+        profiler_hitch_flush();
+        hitch.mute = true; // L'écriture allonge la frame en cours : elle n'est pas une image lente du jeu
+    }
+}
+
+/**
+ * @brief Statistiques récentes (tri de la fenêtre) et de la session (histogramme).
+ */
+void profiler_stats(ProfilerPhase phase, ProfilerStats *window, ProfilerStats *session)
+{
+    const ProfilerPhaseData *d = &phases[phase];
+
+    if (window)
+    {
+        memset(window, 0, sizeof(ProfilerStats));
+        int n = d->count < PROFILER_WINDOW ? (int)d->count : PROFILER_WINDOW;
+        if (n > 0)
+        {
+            float sorted[PROFILER_WINDOW];
+            memcpy(sorted, d->window, sizeof(sorted)); // Fenêtre incomplète : les n premiers
+            qsort(sorted, n, sizeof(float), compare_float);
+            double sum = 0.0;
+            for (int i = 0; i < n; i++)
+                sum += sorted[i];
+            window->count = (uint64_t)n;
+            window->min = sorted[0];
+            window->avg = sum / n;
+            window->p99 = sorted[(99 * n + 99) / 100 - 1];
+            window->max = sorted[n - 1];
+        }
+    }
+
+    if (session)
+    {
+        memset(session, 0, sizeof(ProfilerStats));
+        if (d->count > 0)
+        {
+            uint64_t target = (99 * d->count + 99) / 100, seen = 0;
+            int idx = 0;
+            while (idx < PROFILER_BUCKETS - 1 && seen + d->buckets[idx] < target)
+                seen += d->buckets[idx++];
+            session->count = d->count;
+            session->min = d->min;
+            session->avg = d->sum / (double)d->count;
+            session->p99 = bucket_upper(idx) < d->max ? bucket_upper(idx) : d->max;
+            session->max = d->max;
+        }
+    }
+}
+
+/**
+ * @brief Mesures brutes d'une phase.
+ */
+const ProfilerPhaseData *profiler_phase(ProfilerPhase phase)
+{
+    return &phases[phase];
+}
+
+/**
+ * @brief Nom lisible d'une phase.
+ */
+const char *profiler_phase_name(ProfilerPhase phase)
+{
+    return phase_names[phase];
+}
+
+/**
+ * @brief Affiche une ligne par phase mesurée (durées en ms).
+ */
+void profiler_report(void)
+{
+    if (phases[PROF_FRAME].count == 0 && phases[PROF_UPDATE].count == 0)
+        return;
+    printf("Profil (ms)       %10s %9s %9s %9s %9s\n", "mesures", "min", "moyenne", "p99", "max");
+    for (int p = 0; p < PROF_PHASE_COUNT; p++)
+    {
+        ProfilerStats s;
+        profiler_stats((ProfilerPhase)p, NULL, &s);
+        if (s.count == 0)
+            continue;
+        printf("  %-15s %10llu %9.3f %9.3f %9.3f %9.3f\n", phase_names[p], (unsigned long long)s.count,
+               1000.0 * s.min, 1000.0 * s.avg, 1000.0 * s.p99, 1000.0 * s.max);
+    }
+}
+
+// ============================================================================
+//                          3. TRACE (CHROME TRACE_EVENT)
+// ============================================================================
+
+/**
+ * @brief Origine du chronogramme et thread principal, au premier usage de la file.
+ */
+static void ring_open(void)
+{
+    if (!ring)
+    {
+        utils_fast_clock_init();
+        trace_origin = utils_fast_ns();
+        trace_main = pthread_self();
+        __atomic_store_n(&trace_next, 0, __ATOMIC_RELAXED);
+        workset_adopt(trace_events, sizeof(trace_events)); // Pages projetées (et verrouillées) avant la partie
+        workset_adopt(hitch.marks, sizeof(hitch.marks));
+    }
+    ring = true;
+    enabled = true;
+}
+
+/**
+ * @brief Écrit l'en-tête JSON et les événements de la file commencés dans [from, to].
+ *
+ * Chaque emplacement est lu comme un seqlock : numéro, copie, numéro à
+ * nouveau ; un événement réécrit entre-temps est ignoré.
+ *
+ * @return Nombre d'événements écrits.
+ */
+static size_t write_events(FILE *f, uint64_t from, uint64_t to)
+{
+    uint32_t end = __atomic_load_n(&trace_next, __ATOMIC_ACQUIRE);
+    uint32_t begin = end > PROFILER_TRACE_EVENTS ? end - PROFILER_TRACE_EVENTS : 0;
+    size_t written = 0;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Boucle de jeu\"}},\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Simulation\"}},\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":4,\"args\":{\"name\":\"GPU\"}}");
+    for (uint32_t i = begin; i != end; i++)
+    {
+        const ProfilerTraceEvent *slot = &trace_events[i % PROFILER_TRACE_EVENTS];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != i + 1)
+            continue;
+        ProfilerTraceEvent e = *slot;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != i + 1 || e.phase >= PROF_PHASE_COUNT ||
+            e.start < from || e.start > to)
+            continue;
+
+        const char *name = phase_names[e.phase];
+        while (*name == ' ')
+            name++;
+        const char *cat = "boucle";
+        if (e.phase == PROF_GPU)
+            cat = "gpu";
+        else if (e.phase >= PROF_UPDATE && e.phase <= PROF_UPDATE_BULLETS)
+            cat = "simulation";
+        fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                name, cat,
+                (double)(int64_t)(e.start - trace_origin) / 1e3, e.duration / 1e3, e.tid);
+        written++;
+    }
+    return written;
+}
+
+/**
+ * @brief Commence à enregistrer la trace.
+ */
+void profiler_trace_open(const char *path)
+{
+    snprintf(trace_path, sizeof(trace_path), "%s", path);
+    ring_open();
+    tracing = true;
+}
+
+/**
+ * @brief Indique si une trace est en cours.
+ */
+bool profiler_trace_active(void)
+{
+    return tracing;
+}
+
+/**
+ * @brief Écrit les derniers événements en JSON (événements complets "X", en µs).
+ *
+ * Aucun message : la Vue est peut-être encore affichée (touche de capture).
+ */
+size_t profiler_trace_flush(void)
+{
+    if (!tracing)
+        return 0;
+    FILE *f = fopen(trace_path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "[ERREUR] Impossible de creer %s\n", trace_path);
+        return 0;
+    }
+    size_t written = write_events(f, 0, UINT64_MAX);
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0 ? written : 0;
+}
+
+// ============================================================================
+//                          4. GUET DES IMAGES LENTES
+// ============================================================================
+
+/**
+ * @brief Active le guet : sondes, file de trace, budget.
+ */
+void profiler_hitch_open(double budget_s, const char *prefix)
+{
+    snprintf(hitch.prefix, sizeof(hitch.prefix), "%s", prefix);
+    hitch.budget = budget_s;
+    hitch.on = true;
+    ring_open();
+}
+
+/**
+ * @brief Vrai juste après la mesure d'une image lente.
+ */
+bool profiler_hitch_detected(void)
+{
+    return hitch.detected;
+}
+
+/**
+ * @brief Ajoute une valeur au contexte de la dernière image notée.
+ */
+void profiler_hitch_context(const char *key, long value)
+{
+    if (!hitch.detected)
+        return;
+    HitchMark *m = &hitch.marks[hitch.count - 1];
+    if (m->context < PROFILER_HITCH_CONTEXT)
+    {
+        m->keys[m->context] = key;
+        m->values[m->context] = value;
+        m->context++;
+    }
+}
+
+/**
+ * @brief Tranche [première image - fenêtre, dernière image + fenêtre], images lentes sur la ligne 3.
+ *
+ * Aucun message, comme profiler_trace_flush : la Vue est encore affichée.
+ */
+int profiler_hitch_flush(void)
+{
+    if (hitch.count == 0)
+        return hitch.written;
+    char path[sizeof(hitch.prefix) + 24];
+    snprintf(path, sizeof(path), "%s-%d.json", hitch.prefix, hitch.written + 1);
+    FILE *f = fopen(path, "w");
+    if (f)
+    {
+        const HitchMark *last = &hitch.marks[hitch.count - 1];
+        const uint64_t window = (uint64_t)(PROFILER_HITCH_WINDOW * 1e9);
+        write_events(f, hitch.marks[0].start > window ? hitch.marks[0].start - window : 0,
+                     last->start + last->duration + window);
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"Guet\"}}");
+        for (int k = 0; k < hitch.count; k++)
+        {
+            const HitchMark *m = &hitch.marks[k];
+            fprintf(f, ",\n{\"name\":\"Image lente\",\"cat\":\"guet\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,"
+                       "\"tid\":3,\"args\":{\"budget_ms\":%.1f",
+                    (double)(int64_t)(m->start - trace_origin) / 1e3, m->duration / 1e3, 1000.0 * hitch.budget);
+            for (int c = 0; c < PROF_COUNTER_COUNT; c++)
+                fprintf(f, ",\"%s\":%u", counter_names[c], m->counters[c]);
+            for (int c = 0; c < m->context; c++)
+                fprintf(f, ",\"%s\":%ld", m->keys[c], m->values[c]);
+            fprintf(f, "}}");
+        }
+        fprintf(f, "\n]}\n");
+        if (fclose(f) == 0)
+            hitch.written++;
+    }
+    hitch.count = 0;
+    hitch.deadline = 0;
+    return hitch.written;
+}
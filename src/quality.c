@@ -0,0 +1,150 @@
+/**
+ * @file quality.c
+ * @brief Implémentation du régulateur de qualité.
+ */
+
+#include "quality.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "profiler.h"
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Moyenne des `n` dernières mesures d'une phase (s), chacune plafonnée à `cap`.
+ *
+ * Le plafond borne le poids d'un à-coup isolé (chargement, changement
+ * d'écran) : seule une lenteur qui dure fait descendre la qualité.
+ */
+static double recent_average(ProfilerPhase phase, int n, double cap)
+{
+    const ProfilerPhaseData *d = profiler_phase(phase);
+    if (d->count < (uint64_t)n)
+        n = (int)d->count;
+    if (n <= 0)
+        return 0.0;
+    double sum = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        double v = d->window[(d->next + PROFILER_WINDOW - n + i) % PROFILER_WINDOW];
+        sum += v < cap ? v : cap;
+    }
+    return sum / n;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Part du niveau demandé, sans historique.
+ */
+void quality_init(QualityGovernor *q, int level)
+{
+    memset(q, 0, sizeof(*q));
+    q->automatic = level == QUALITY_AUTO;
+    if (level < 0)
+        level = QUALITY_FULL;
+    q->level = q->fixed = level < QUALITY_LEVEL_COUNT ? level : QUALITY_LEVEL_COUNT - 1;
+    q->budget = 1.0 / TARGET_FPS;
+    q->up_evals = QUALITY_UP_EVALS;
+    q->since_up = -1;
+    q->seen = profiler_phase(PROF_FRAME)->count;
+}
+
+/**
+ * @brief "auto" (ou rien) : réglage automatique ; un chiffre : niveau fixe.
+ */
+int quality_from_env(void)
+{
+    const char *env = getenv("SPACE_INVADERS_QUALITY");
+    if (!env || !env[0] || strcmp(env, "auto") == 0)
+        return QUALITY_AUTO;
+    char *end;
+    long level = strtol(env, &end, 10);
+    if (*end || level < 0 || level >= QUALITY_LEVEL_COUNT)
+        return QUALITY_AUTO;
+    return (int)level;
+}
+
+/**
+ * @brief Descend après QUALITY_DOWN_EVALS évaluations lentes, remonte après `up_evals` avec marge.
+ */
+bool quality_update(QualityGovernor *q, bool vsync)
+{
+    uint64_t count = profiler_phase(PROF_FRAME)->count;
+    if (!q->automatic || count - q->seen < QUALITY_SAMPLES)
+        return false;
+    q->seen = count;
+
+    const double budget = q->budget;
+    double frame = recent_average(PROF_FRAME, QUALITY_SAMPLES, 2.0 * budget);
+    double work = recent_average(PROF_WORK, QUALITY_SAMPLES, 2.0 * budget);
+    q->frame_ms = (float)(1000.0 * frame);
+    q->work_ms = (float)(1000.0 * work);
+
+    bool slow = frame > QUALITY_LATE_RATIO * budget || (!vsync && work > QUALITY_OVER_RATIO * budget);
+    bool idle = !slow && (vsync || work < QUALITY_IDLE_RATIO * budget);
+    if (q->since_up >= 0 && ++q->since_up >= QUALITY_UP_EVALS_MAX)
+    {
+        q->up_evals = QUALITY_UP_EVALS; // Remontée tenue longtemps : le délai repart du début
+        q->since_up = -1;
+    }
+
+    if (slow)
+    {
+        q->good = 0;
+        if (++q->over < QUALITY_DOWN_EVALS || q->level == QUALITY_LEVEL_COUNT - 1)
+            return false;
+        q->over = 0;
+        q->level++;
+        if (q->since_up >= 0 && q->since_up <= QUALITY_DOWN_EVALS + 1) // Remontée aussitôt annulée
+            q->up_evals = (2 * q->up_evals < QUALITY_UP_EVALS_MAX) ? 2 * q->up_evals : QUALITY_UP_EVALS_MAX;
+        q->since_up = -1;
+        return true;
+    }
+    q->over = 0;
+    if (!idle)
+    {
+        q->good = 0;
+        return false;
+    }
+    if (++q->good < q->up_evals || q->level <= q->floor)
+        return false;
+    q->good = 0;
+    q->level--;
+    q->since_up = 0;
+    return true;
+}
+
+/**
+ * @brief Relève le niveau au plancher ; un niveau fixé y revient quand le plancher redescend.
+ */
+bool quality_constrain(QualityGovernor *q, int floor, int hz)
+{
+    q->budget = 1.0 / hz;
+    q->floor = floor < QUALITY_LEVEL_COUNT ? floor : QUALITY_LEVEL_COUNT - 1;
+    int level = q->automatic ? q->level : q->fixed;
+    if (level < q->floor)
+        level = q->floor;
+    if (level == q->level)
+        return false;
+    q->level = level;
+    q->over = q->good = 0;
+    return true;
+}
+
+/**
+ * @brief Nom affiché par le panneau de performances.
+ */
+const char *quality_name(int level)
+{
+    static const char *const names[QUALITY_LEVEL_COUNT] = {"complete", "sans particules", "sans tremblement",
+                                                           "sans fond", "basse resolution"};
+    return (level >= 0 && level < QUALITY_LEVEL_COUNT) ? names[level] : "?";
+}
@@ -0,0 +1,304 @@
+/**
+ * @file render_bench.c
+ * @brief Implémentation du banc de rendu (POSIX).
+ *
+ * La scène est produite comme en headless : même départ par le menu, même
+ * script rejoué en boucle, relance immédiate après un Game Over. Entre deux
+ * images, `model_update` n'est pas chronométré.
+ */
+
+/** @def _XOPEN_SOURCE
+ *  @brief Active POSIX 2001 et XSI (requis pour posix_openpt, grantpt, setenv).
+ */
+#define _XOPEN_SOURCE 600
+
+#include "render_bench.h"
+#include "headless.h"
+#include "memtrack.h"
+#include "profiler.h"
+#include "utils.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. PSEUDO-TERMINAL
+// ============================================================================
+
+/**
+ * @brief Pseudo-terminal branché sur stdin/stdout pendant le banc.
+ *
+ * Le thread de vidage lit le maître sans relâche : sans lui, la file du
+ * terminal se remplirait et refresh() bloquerait.
+ */
+typedef struct
+{
+    int master, slave;     ///< Descripteurs du pseudo-terminal.
+    int saved_in, saved_out; ///< stdin/stdout d'origine.
+    pthread_t drain;       ///< Thread de vidage.
+    uint64_t bytes;        ///< Octets lus sur le maître (accès __atomic).
+} BenchPty;
+
+/**
+ * @brief Lit et jette tout ce que la Vue écrit ; s'arrête quand l'esclave est fermé.
+ */
+static void *pty_drain(void *arg)
+{
+    BenchPty *pty = arg;
+    char buf[16384];
+    ssize_t n;
+    while ((n = read(pty->master, buf, sizeof(buf))) > 0)
+        __atomic_fetch_add(&pty->bytes, (uint64_t)n, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+/**
+ * @brief Ouvre un pseudo-terminal et y redirige stdin/stdout.
+ */
+static bool pty_open(BenchPty *pty)
+{
+    memset(pty, 0, sizeof(*pty));
+    pty->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty->master < 0 || grantpt(pty->master) != 0 || unlockpt(pty->master) != 0)
+    {
+        if (pty->master >= 0)
+            close(pty->master);
+        return false;
+    }
+    pty->slave = open(ptsname(pty->master), O_RDWR | O_NOCTTY);
+    if (pty->slave < 0)
+    {
+        close(pty->master);
+        return false;
+    }
+    struct winsize ws = {RENDER_BENCH_ROWS, RENDER_BENCH_COLS, 0, 0};
+    ioctl(pty->slave, TIOCSWINSZ, &ws);
+    if (pthread_create(&pty->drain, NULL, pty_drain, pty) != 0)
+    {
+        close(pty->slave);
+        close(pty->master);
+        return false;
+    }
+
+    setenv("TERM", "xterm-256color", 0); // Lancé hors terminal : ncurses en exige un
+    fflush(stdout);
+    pty->saved_in = dup(STDIN_FILENO);
+    pty->saved_out = dup(STDOUT_FILENO);
+    dup2(pty->slave, STDIN_FILENO);
+    dup2(pty->slave, STDOUT_FILENO);
+    return true;
+}
+
+/**
+ * @brief Octets reçus jusqu'ici, une fois la sortie en attente lue par le thread.
+ */
+static uint64_t pty_bytes(BenchPty *pty)
+{
+    fflush(stdout);
+    tcdrain(pty->slave);
+    return __atomic_load_n(&pty->bytes, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Rétablit stdin/stdout et ferme le pseudo-terminal.
+ */
+static void pty_close(BenchPty *pty)
+{
+    fflush(stdout);
+    dup2(pty->saved_in, STDIN_FILENO);
+    dup2(pty->saved_out, STDOUT_FILENO);
+    close(pty->saved_in);
+    close(pty->saved_out);
+    close(pty->slave); // Le maître lit alors EIO : le thread s'arrête
+    pthread_join(pty->drain, NULL);
+    close(pty->master);
+}
+
+// ============================================================================
+//                          2. SCÈNE
+// ============================================================================
+
+/**
+ * @brief Lance (ou relance) une partie par les commandes du menu, comme en headless.
+ */
+static void start_game(GameModel *model)
+{
+    if (model->sim.state == STATE_GAME_OVER)
+    {
+        GameOverOption opts[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, opts);
+        for (int i = 0; i < count; i++)
+            if (opts[i] == GAME_OVER_REPLAY)
+                model->ui.menu_selection = i; // "REJOUER"
+    }
+    else
+    {
+        model->sim.state = STATE_MENU;
+        model->ui.menu_selection = 0; // "JOUER"
+    }
+    model_handle_input(model, CMD_RETURN);
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Initialise une configuration avec les valeurs par défaut.
+ */
+void render_bench_default_config(RenderBenchConfig *cfg)
+{
+    cfg->view = NULL;
+    cfg->pty = false;
+    cfg->frames = RENDER_BENCH_DEFAULT_FRAMES;
+    cfg->script = HEADLESS_DEFAULT_SCRIPT;
+    cfg->seed = MODEL_RNG_DEFAULT_SEED;
+    cfg->stress = STRESS_NONE;
+}
+
+/**
+ * @brief Ouvre la Vue, dessine la scène image par image, ferme la Vue.
+ *
+ * Le profileur est activé pour relever les compteurs de la Vue et les
+ * durées de rendu (PROF_RENDER) ; ses mesures repartent de zéro ici.
+ */
+bool render_bench_run(GameModel *model, const RenderBenchConfig *cfg, RenderBenchStats *out)
+{
+    const double dt = 1.0 / TARGET_FPS;
+    const char *script = (cfg->script && cfg->script[0]) ? cfg->script : HEADLESS_DEFAULT_SCRIPT;
+    size_t script_len = strlen(script);
+    RenderBenchStats stats = {0};
+
+    setenv("SPACE_INVADERS_VSYNC", "0", 1);
+    setenv("SDL_VIDEODRIVER", "offscreen", 0);
+
+    BenchPty pty;
+    if (cfg->pty && !pty_open(&pty))
+    {
+        fprintf(stderr, "[ERREUR] Impossible d'ouvrir un pseudo-terminal\n");
+        return false;
+    }
+    if (!cfg->view->init())
+    {
+        if (cfg->pty)
+            pty_close(&pty);
+        fprintf(stderr, "Erreur Critique: Impossible d'initialiser la vue.\n");
+        return false;
+    }
+    if (cfg->view->set_interpolation)
+        cfg->view->set_interpolation(NULL, 1.0f);
+
+    model_rng_seed(model, cfg->seed);
+    start_game(model);
+    GameModel *scenario = NULL;
+    if (cfg->stress != STRESS_NONE && (scenario = model_clone(model)) != NULL)
+        stress_build(scenario, cfg->stress);
+    profiler_enable(true);
+    profiler_frame_end();
+
+    uint64_t draws = 0, uploads = 0, estimate = 0, allocs = 0, driver_allocs = 0;
+    MemtrackStats mem;
+    memtrack_stats(&mem);
+    stats.allocs_tracked = memtrack_installed();
+    stats.startup_allocs = mem.allocs;
+    uint64_t bytes_start = cfg->pty ? pty_bytes(&pty) : 0;
+    for (long frame = 0; frame < cfg->frames; frame++)
+    {
+        if (scenario)
+        {
+            model_copy(model, scenario);
+            model_handle_input(model, stress_command());
+        }
+        else
+        {
+            if (model->sim.state == STATE_GAME_OVER)
+                start_game(model);
+            if (model->sim.state == STATE_PLAYING)
+                model_handle_input(model, headless_script_command(script[frame % script_len]));
+        }
+        model_update(model, dt);
+
+        uint64_t t0 = profiler_begin();
+        cfg->view->render(model);
+        uint64_t t1 = profiler_end(PROF_RENDER, t0);
+        stats.elapsed += (double)(t1 - t0) / 1e9;
+
+        profiler_frame_end();
+        draws += profiler_counter(PROF_COUNT_DRAW_CALLS);
+        uploads += profiler_counter(PROF_COUNT_UPLOADS);
+        estimate += profiler_counter(PROF_COUNT_TERM_BYTES);
+        allocs += profiler_counter(PROF_COUNT_ALLOCS);
+        driver_allocs += profiler_counter(PROF_COUNT_DRIVER_ALLOCS);
+        if (frame >= RENDER_BENCH_WARMUP && model->sim.state == STATE_PLAYING)
+        {
+            stats.steady_frames++;
+            stats.steady_allocs += profiler_counter(PROF_COUNT_ALLOCS);
+        }
+        stats.frames++;
+    }
+    uint64_t bytes = cfg->pty ? pty_bytes(&pty) - bytes_start : 0;
+    memtrack_stats(&mem);
+    stats.live_kib = mem.live_bytes / 1024.0;
+
+    cfg->view->close();
+    if (cfg->pty)
+        pty_close(&pty);
+    profiler_enable(false);
+    if (scenario)
+        model_free(scenario);
+
+    ProfilerStats render;
+    profiler_stats(PROF_RENDER, NULL, &render);
+    double n = stats.frames > 0 ? (double)stats.frames : 1.0;
+    stats.fps = stats.elapsed > 0.0 ? stats.frames / stats.elapsed : 0.0;
+    stats.avg_ms = 1000.0 * render.avg;
+    stats.p99_ms = 1000.0 * render.p99;
+    stats.max_ms = 1000.0 * render.max;
+    stats.draw_calls = draws / n;
+    stats.uploads = uploads / n;
+    stats.term_bytes = bytes / n;
+    stats.term_estimate = estimate / n;
+    stats.allocs = allocs / n;
+    stats.driver_allocs = driver_allocs / n;
+
+    if (out)
+        *out = stats;
+    return true;
+}
+
+/**
+ * @brief Affiche le résumé sur la sortie standard.
+ */
+void render_bench_print_stats(const RenderBenchConfig *cfg, const RenderBenchStats *stats)
+{
+    printf("[RENDU] Images          : %ld (graine 0x%llx%s%s)\n", stats->frames, (unsigned long long)cfg->seed,
+           cfg->stress != STRESS_NONE ? ", pire cas " : "", cfg->stress != STRESS_NONE ? stress_name(cfg->stress) : "");
+    printf("[RENDU] Cadence         : %.0f images/s (rendu seul, sans vsync)\n", stats->fps);
+    printf("[RENDU] Durée par image : %.3f ms en moyenne, p99 %.3f ms, max %.3f ms\n",
+           stats->avg_ms, stats->p99_ms, stats->max_ms);
+    if (cfg->pty)
+    {
+        printf("[RENDU] Terminal        : %.0f octets par image (%dx%d, estimation de la Vue : %.0f)\n",
+               stats->term_bytes, RENDER_BENCH_COLS, RENDER_BENCH_ROWS, stats->term_estimate);
+    }
+    else
+    {
+        printf("[RENDU] Appels de dessin: %.1f par image\n", stats->draw_calls);
+        printf("[RENDU] Textures texte  : %.1f créées par image\n", stats->uploads);
+    }
+    if (stats->allocs_tracked)
+    {
+        printf("[RENDU] Allocations SDL : %llu au démarrage, %.2f par image (+%.2f dans le pilote), "
+               "%.0f Kio vivants à la fin\n",
+               (unsigned long long)stats->startup_allocs, stats->allocs, stats->driver_allocs, stats->live_kib);
+        printf("[RENDU] En partie       : %llu allocations sur %ld images (après %d d'échauffement)%s\n",
+               (unsigned long long)stats->steady_allocs, stats->steady_frames, RENDER_BENCH_WARMUP,
+               stats->steady_allocs > 0 ? "  ECHEC : 0 attendu" : "");
+    }
+}
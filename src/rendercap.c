@@ -0,0 +1,1009 @@
+/**
+ * @file rendercap.c
+ * @brief Implémentation de l'enregistrement des commandes de rendu et de leur rejeu.
+ *
+ * Format : en-tête de RENDERCAP_HEADER_SIZE octets (magie, version, taille
+ * de sortie, pilote), puis un flux compressé de commandes : un octet de code
+ * suivi de ses champs, entiers et réels sur 4 octets petit-boutistes.
+ */
+
+#include "rendercap.h"
+#include "codec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FORMAT
+// ============================================================================
+
+/**
+ * @brief Codes des commandes du flux.
+ */
+typedef enum
+{
+    OP_CREATE = 1,      ///< id, format, accès, largeur, hauteur.
+    OP_DESTROY,         ///< id.
+    OP_UPDATE,          ///< id, rectangle entier, pas (pitch) des lignes.
+    OP_TEX_BLEND,       ///< id, mode.
+    OP_TEX_SCALE,       ///< id, mode.
+    OP_TEX_COLOR,       ///< id, r, g, b.
+    OP_TEX_ALPHA,       ///< id, a.
+    OP_TARGET,          ///< id (0 : la fenêtre).
+    OP_LOGICAL,         ///< largeur, hauteur, mode.
+    OP_DRAW_COLOR,      ///< r, g, b, a.
+    OP_DRAW_BLEND,      ///< mode.
+    OP_CLEAR,           ///< -
+    OP_FILL_RECT,       ///< rectangle.
+    OP_FILL_RECTS,      ///< nombre, rectangles.
+    OP_RECT,            ///< rectangle.
+    OP_LINE,            ///< x1, y1, x2, y2.
+    OP_POINTS,          ///< nombre, points.
+    OP_TEXTURE,         ///< id, source, destination.
+    OP_GEOMETRY,        ///< id, sommets, indices.
+    OP_READ,            ///< rectangle entier.
+    OP_FLUSH,           ///< -
+    OP_PRESENT,         ///< Durée de l'image d'origine (µs).
+} RendercapOp;
+
+/** @brief Propriété SDL portant l'identifiant d'une texture enregistrée. */
+#define ID_PROP "space_invaders.rendercap.id"
+
+/** @brief Côté maximal d'une texture recréée au rejeu. */
+#define MAX_SIDE 16384
+
+// ============================================================================
+//                          2. ENREGISTREMENT
+// ============================================================================
+
+static FILE *file = NULL;
+static CodecWriter out;
+static RendercapStats rec;
+static uint32_t next_id = 0;      ///< Dernier identifiant donné.
+static Uint64 frame_start_ns = 0; ///< Début de l'image en cours.
+
+/** @brief Entier sur 4 octets petit-boutistes. */
+static void put_u32(uint32_t v)
+{
+    for (int i = 0; i < 4; i++)
+        codec_writer_putc(&out, (uint8_t)(v >> (8 * i)));
+}
+
+/** @brief Réel sur 4 octets (représentation IEEE 754). */
+static void put_f32(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    put_u32(u);
+}
+
+/** @brief Octet de présence, puis le rectangle s'il y en a un. */
+static void put_frect(const SDL_FRect *r)
+{
+    codec_writer_putc(&out, r != NULL);
+    if (r)
+    {
+        put_f32(r->x);
+        put_f32(r->y);
+        put_f32(r->w);
+        put_f32(r->h);
+    }
+}
+
+/** @brief Octet de présence, puis le rectangle entier s'il y en a un. */
+static void put_rect(const SDL_Rect *r)
+{
+    codec_writer_putc(&out, r != NULL);
+    if (r)
+    {
+        put_u32((uint32_t)r->x);
+        put_u32((uint32_t)r->y);
+        put_u32((uint32_t)r->w);
+        put_u32((uint32_t)r->h);
+    }
+}
+
+/** @brief Code d'une commande. */
+static void put_op(RendercapOp op)
+{
+    codec_writer_putc(&out, (uint8_t)op);
+    rec.commands++;
+}
+
+/** @brief Identifiant d'une texture (0 : NULL, ou créée hors enregistrement). */
+static uint32_t tex_id(SDL_Texture *t)
+{
+    return t ? (uint32_t)SDL_GetNumberProperty(SDL_GetTextureProperties(t), ID_PROP, 0) : 0;
+}
+
+/** @brief Donne un identifiant à une texture créée et écrit sa création. */
+static uint32_t put_create(SDL_Texture *t, SDL_TextureAccess access)
+{
+    uint32_t id = ++next_id;
+    SDL_SetNumberProperty(SDL_GetTextureProperties(t), ID_PROP, id);
+    put_op(OP_CREATE);
+    put_u32(id);
+    put_u32((uint32_t)t->format);
+    put_u32((uint32_t)access);
+    put_u32((uint32_t)t->w);
+    put_u32((uint32_t)t->h);
+    rec.textures++;
+    return id;
+}
+
+/**
+ * @brief En-tête brut, puis flux compressé.
+ */
+bool rendercap_open(const char *path, SDL_Renderer *renderer)
+{
+    rendercap_close(NULL);
+    file = fopen(path, "wb");
+    if (!file)
+        return false;
+    int w = 0, h = 0;
+    SDL_GetRenderOutputSize(renderer, &w, &h);
+    uint8_t head[RENDERCAP_HEADER_SIZE] = {0};
+    memcpy(head, RENDERCAP_MAGIC, 4);
+    head[4] = RENDERCAP_VERSION & 0xFF;
+    head[5] = RENDERCAP_VERSION >> 8;
+    for (int i = 0; i < 4; i++)
+    {
+        head[8 + i] = (uint8_t)((uint32_t)w >> (8 * i));
+        head[12 + i] = (uint8_t)((uint32_t)h >> (8 * i));
+    }
+    const char *name = SDL_GetRendererName(renderer);
+    if (name)
+        strncpy((char *)head + 16, name, 15);
+    fwrite(head, 1, sizeof(head), file);
+    codec_writer_init(&out, file, true);
+    memset(&rec, 0, sizeof(rec));
+    next_id = 0;
+    frame_start_ns = SDL_GetTicksNS();
+    return true;
+}
+
+/**
+ * @brief Fichier ouvert.
+ */
+bool rendercap_active(void)
+{
+    return file != NULL;
+}
+
+/**
+ * @brief Dernier bloc écrit, taille relevée, fichier fermé.
+ */
+void rendercap_close(RendercapStats *stats)
+{
+    if (file)
+    {
+        codec_writer_flush(&out);
+        long size = ftell(file);
+        rec.bytes = size > 0 ? (uint64_t)size : 0;
+        fclose(file);
+    }
+    file = NULL;
+    if (stats)
+        *stats = rec;
+}
+
+// ============================================================================
+//                          3. RELAIS
+// ============================================================================
+
+SDL_Texture *rendercap_create_texture(SDL_Renderer *r, SDL_PixelFormat format, SDL_TextureAccess access, int w, int h)
+{
+    SDL_Texture *t = SDL_CreateTexture(r, format, access, w, h);
+    if (file && t)
+        put_create(t, access);
+    return t;
+}
+
+/**
+ * Une texture tirée d'une surface (images, texte) s'écrit comme une
+ * création suivie d'un envoi de toute sa surface.
+ */
+SDL_Texture *rendercap_create_texture_from_surface(SDL_Renderer *r, SDL_Surface *surface)
+{
+    SDL_Texture *t = SDL_CreateTextureFromSurface(r, surface);
+    if (file && t)
+    {
+        uint32_t id = put_create(t, SDL_TEXTUREACCESS_STATIC);
+        put_op(OP_UPDATE);
+        put_u32(id);
+        put_rect(NULL);
+        put_u32((uint32_t)(t->w * SDL_BYTESPERPIXEL(t->format)));
+    }
+    return t;
+}
+
+bool rendercap_update_texture(SDL_Texture *t, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    if (file && t)
+    {
+        put_op(OP_UPDATE);
+        put_u32(tex_id(t));
+        put_rect(rect);
+        put_u32((uint32_t)pitch);
+    }
+    return SDL_UpdateTexture(t, rect, pixels, pitch);
+}
+
+void rendercap_destroy_texture(SDL_Texture *t)
+{
+    if (file && t)
+    {
+        put_op(OP_DESTROY);
+        put_u32(tex_id(t));
+    }
+    SDL_DestroyTexture(t);
+}
+
+bool rendercap_set_texture_blend_mode(SDL_Texture *t, SDL_BlendMode mode)
+{
+    if (file && t)
+    {
+        put_op(OP_TEX_BLEND);
+        put_u32(tex_id(t));
+        put_u32(mode);
+    }
+    return SDL_SetTextureBlendMode(t, mode);
+}
+
+bool rendercap_set_texture_scale_mode(SDL_Texture *t, SDL_ScaleMode mode)
+{
+    if (file && t)
+    {
+        put_op(OP_TEX_SCALE);
+        put_u32(tex_id(t));
+        put_u32((uint32_t)mode);
+    }
+    return SDL_SetTextureScaleMode(t, mode);
+}
+
+bool rendercap_set_texture_color_mod(SDL_Texture *t, Uint8 r, Uint8 g, Uint8 b)
+{
+    if (file && t)
+    {
+        put_op(OP_TEX_COLOR);
+        put_u32(tex_id(t));
+        codec_writer_putc(&out, r);
+        codec_writer_putc(&out, g);
+        codec_writer_putc(&out, b);
+    }
+    return SDL_SetTextureColorMod(t, r, g, b);
+}
+
+bool rendercap_set_texture_alpha_mod(SDL_Texture *t, Uint8 a)
+{
+    if (file && t)
+    {
+        put_op(OP_TEX_ALPHA);
+        put_u32(tex_id(t));
+        codec_writer_putc(&out, a);
+    }
+    return SDL_SetTextureAlphaMod(t, a);
+}
+
+bool rendercap_set_render_target(SDL_Renderer *r, SDL_Texture *t)
+{
+    if (file)
+    {
+        put_op(OP_TARGET);
+        put_u32(tex_id(t));
+    }
+    return SDL_SetRenderTarget(r, t);
+}
+
+bool rendercap_set_render_logical_presentation(SDL_Renderer *r, int w, int h, SDL_RendererLogicalPresentation mode)
+{
+    if (file)
+    {
+        put_op(OP_LOGICAL);
+        put_u32((uint32_t)w);
+        put_u32((uint32_t)h);
+        put_u32((uint32_t)mode);
+    }
+    return SDL_SetRenderLogicalPresentation(r, w, h, mode);
+}
+
+bool rendercap_set_render_draw_color(SDL_Renderer *r, Uint8 red, Uint8 g, Uint8 b, Uint8 a)
+{
+    if (file)
+    {
+        put_op(OP_DRAW_COLOR);
+        codec_writer_putc(&out, red);
+        codec_writer_putc(&out, g);
+        codec_writer_putc(&out, b);
+        codec_writer_putc(&out, a);
+    }
+    return SDL_SetRenderDrawColor(r, red, g, b, a);
+}
+
+bool rendercap_set_render_draw_blend_mode(SDL_Renderer *r, SDL_BlendMode mode)
+{
+    if (file)
+    {
+        put_op(OP_DRAW_BLEND);
+        put_u32(mode);
+    }
+    return SDL_SetRenderDrawBlendMode(r, mode);
+}
+
+bool rendercap_render_clear(SDL_Renderer *r)
+{
+    if (file)
+        put_op(OP_CLEAR);
+    return SDL_RenderClear(r);
+}
+
+bool rendercap_render_fill_rect(SDL_Renderer *r, const SDL_FRect *rect)
+{
+    if (file)
+    {
+        put_op(OP_FILL_RECT);
+        put_frect(rect);
+    }
+    return SDL_RenderFillRect(r, rect);
+}
+
+bool rendercap_render_fill_rects(SDL_Renderer *r, const SDL_FRect *rects, int count)
+{
+    if (file && count > 0)
+    {
+        put_op(OP_FILL_RECTS);
+        put_u32((uint32_t)count);
+        for (int i = 0; i < count; i++)
+        {
+            put_f32(rects[i].x);
+            put_f32(rects[i].y);
+            put_f32(rects[i].w);
+            put_f32(rects[i].h);
+        }
+    }
+    return SDL_RenderFillRects(r, rects, count);
+}
+
+bool rendercap_render_rect(SDL_Renderer *r, const SDL_FRect *rect)
+{
+    if (file)
+    {
+        put_op(OP_RECT);
+        put_frect(rect);
+    }
+    return SDL_RenderRect(r, rect);
+}
+
+bool rendercap_render_line(SDL_Renderer *r, float x1, float y1, float x2, float y2)
+{
+    if (file)
+    {
+        put_op(OP_LINE);
+        put_f32(x1);
+        put_f32(y1);
+        put_f32(x2);
+        put_f32(y2);
+    }
+    return SDL_RenderLine(r, x1, y1, x2, y2);
+}
+
+bool rendercap_render_points(SDL_Renderer *r, const SDL_FPoint *points, int count)
+{
+    if (file && count > 0)
+    {
+        put_op(OP_POINTS);
+        put_u32((uint32_t)count);
+        for (int i = 0; i < count; i++)
+        {
+            put_f32(points[i].x);
+            put_f32(points[i].y);
+        }
+    }
+    return SDL_RenderPoints(r, points, count);
+}
+
+bool rendercap_render_texture(SDL_Renderer *r, SDL_Texture *t, const SDL_FRect *src, const SDL_FRect *dst)
+{
+    if (file && t)
+    {
+        put_op(OP_TEXTURE);
+        put_u32(tex_id(t));
+        put_frect(src);
+        put_frect(dst);
+    }
+    return SDL_RenderTexture(r, t, src, dst);
+}
+
+bool rendercap_render_geometry(SDL_Renderer *r, SDL_Texture *t, const SDL_Vertex *vertices, int num_vertices,
+                               const int *indices, int num_indices)
+{
+    if (file && num_vertices > 0)
+    {
+        put_op(OP_GEOMETRY);
+        put_u32(tex_id(t));
+        put_u32((uint32_t)num_vertices);
+        for (int i = 0; i < num_vertices; i++)
+        {
+            const SDL_Vertex *v = &vertices[i];
+            put_f32(v->position.x);
+            put_f32(v->position.y);
+            put_f32(v->color.r);
+            put_f32(v->color.g);
+            put_f32(v->color.b);
+            put_f32(v->color.a);
+            put_f32(v->tex_coord.x);
+            put_f32(v->tex_coord.y);
+        }
+        put_u32(indices ? (uint32_t)num_indices : 0);
+        for (int i = 0; indices && i < num_indices; i++)
+            put_u32((uint32_t)indices[i]);
+    }
+    return SDL_RenderGeometry(r, t, vertices, num_vertices, indices, num_indices);
+}
+
+SDL_Surface *rendercap_render_read_pixels(SDL_Renderer *r, const SDL_Rect *rect)
+{
+    if (file)
+    {
+        put_op(OP_READ);
+        put_rect(rect);
+    }
+    return SDL_RenderReadPixels(r, rect);
+}
+
+bool rendercap_flush_renderer(SDL_Renderer *r)
+{
+    if (file)
+        put_op(OP_FLUSH);
+    return SDL_FlushRenderer(r);
+}
+
+/**
+ * La présentation clôt l'image : sa durée d'origine va de la présentation
+ * précédente à la fin de celle-ci (attente de la synchronisation comprise).
+ */
+bool rendercap_render_present(SDL_Renderer *r)
+{
+    bool ok = SDL_RenderPresent(r);
+    if (file)
+    {
+        Uint64 now = SDL_GetTicksNS();
+        Uint64 us = (now - frame_start_ns) / 1000;
+        frame_start_ns = now;
+        put_op(OP_PRESENT);
+        put_u32(us > UINT32_MAX ? UINT32_MAX : (uint32_t)us);
+        rec.frames++;
+    }
+    return ok;
+}
+
+// ============================================================================
+//                          4. REJEU
+// ============================================================================
+
+/**
+ * @brief État d'un rejeu.
+ */
+typedef struct
+{
+    CodecReader in;          ///< Flux de commandes.
+    bool bad;                ///< Champ tronqué ou hors limites.
+    SDL_Renderer *renderer;  ///< Renderer du rejeu.
+    SDL_Texture **textures;  ///< Textures vivantes, par identifiant.
+    uint32_t texture_cap;    ///< Places de la table.
+    uint8_t *pixels;         ///< Motif envoyé à la place des pixels d'origine.
+    size_t pixels_cap;       ///< Octets du motif.
+    void *items;             ///< Rectangles, points ou sommets d'une commande.
+    size_t items_cap;        ///< Octets de `items`.
+    int *indices;            ///< Indices d'une géométrie.
+    size_t indices_cap;      ///< Octets de `indices`.
+    int pass;                ///< Passe en cours (0 : la première).
+    uint64_t commands;       ///< Commandes lues pendant la première passe.
+    uint64_t created;        ///< Textures créées pendant la première passe.
+    float *orig_ms;          ///< Durées d'origine (première passe).
+    size_t orig_cap;         ///< Octets de orig_ms.
+    uint64_t frames;         ///< Images de la première passe.
+    float *play_ms;          ///< Durées rejouées (toutes passes).
+    size_t play_cap;         ///< Octets de play_ms.
+    uint64_t played;         ///< Images rejouées.
+    double upload_bytes;     ///< Octets envoyés pendant la première passe.
+} Player;
+
+static uint32_t get_u32(Player *p)
+{
+    uint8_t b[4];
+    if (codec_reader_read(&p->in, b, 4) != 4)
+    {
+        p->bad = true;
+        return 0;
+    }
+    return (uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+static float get_f32(Player *p)
+{
+    uint32_t u = get_u32(p);
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static uint8_t get_u8(Player *p)
+{
+    int c = codec_reader_getc(&p->in);
+    if (c < 0)
+        p->bad = true;
+    return (uint8_t)c;
+}
+
+/** @brief Rectangle s'il est présent (NULL sinon), lu dans `r`. */
+static const SDL_FRect *get_frect(Player *p, SDL_FRect *r)
+{
+    if (!get_u8(p))
+        return NULL;
+    r->x = get_f32(p);
+    r->y = get_f32(p);
+    r->w = get_f32(p);
+    r->h = get_f32(p);
+    return r;
+}
+
+/** @brief Rectangle entier s'il est présent (NULL sinon), lu dans `r`. */
+static const SDL_Rect *get_rect(Player *p, SDL_Rect *r)
+{
+    if (!get_u8(p))
+        return NULL;
+    r->x = (int)get_u32(p);
+    r->y = (int)get_u32(p);
+    r->w = (int)get_u32(p);
+    r->h = (int)get_u32(p);
+    return r;
+}
+
+/** @brief Texture d'un identifiant (NULL pour 0 ; identifiant inconnu : flux invalide). */
+static SDL_Texture *get_texture(Player *p)
+{
+    uint32_t id = get_u32(p);
+    if (id == 0)
+        return NULL;
+    if (id >= p->texture_cap)
+    {
+        p->bad = true;
+        return NULL;
+    }
+    return p->textures[id];
+}
+
+/** @brief Agrandit un buffer (au moins `need` octets). */
+static bool reserve(void **buf, size_t *cap, size_t need)
+{
+    if (need <= *cap)
+        return true;
+    size_t n = *cap ? *cap : 4096;
+    while (n < need)
+        n *= 2;
+    void *grown = realloc(*buf, n);
+    if (!grown)
+        return false;
+    *buf = grown;
+    *cap = n;
+    return true;
+}
+
+/** @brief Au moins `n` octets de motif (damier opaque et translucide). */
+static bool pattern(Player *p, size_t n)
+{
+    size_t had = p->pixels_cap;
+    if (!reserve((void **)&p->pixels, &p->pixels_cap, n))
+        return false;
+    for (size_t i = had; i < p->pixels_cap; i++)
+        p->pixels[i] = (i / 64) & 1 ? (uint8_t)(i * 37) : (uint8_t)(0x80 | i);
+    return true;
+}
+
+/** @brief Lit `count` éléments de `floats` réels chacun dans `items`. */
+static bool get_items(Player *p, uint32_t count, int floats)
+{
+    if (count == 0 || count > RENDERCAP_MAX_ITEMS ||
+        !reserve(&p->items, &p->items_cap, (size_t)count * floats * sizeof(float)))
+        return !(p->bad = true);
+    float *f = p->items;
+    for (size_t i = 0; i < (size_t)count * floats; i++)
+        f[i] = get_f32(p);
+    return !p->bad;
+}
+
+/** @brief Crée une texture de l'enregistrement et la range à son identifiant. */
+static void play_create(Player *p)
+{
+    uint32_t id = get_u32(p);
+    SDL_PixelFormat format = (SDL_PixelFormat)get_u32(p);
+    SDL_TextureAccess access = (SDL_TextureAccess)get_u32(p);
+    int w = (int)get_u32(p), h = (int)get_u32(p);
+    if (p->bad || id == 0 || id > 16 * RENDERCAP_MAX_ITEMS || w <= 0 || h <= 0 || w > MAX_SIDE || h > MAX_SIDE)
+    {
+        p->bad = true;
+        return;
+    }
+    if (id >= p->texture_cap)
+    {
+        uint32_t cap = p->texture_cap ? p->texture_cap : 256;
+        while (cap <= id)
+            cap *= 2;
+        SDL_Texture **grown = realloc(p->textures, cap * sizeof(SDL_Texture *));
+        if (!grown)
+        {
+            p->bad = true;
+            return;
+        }
+        memset(grown + p->texture_cap, 0, (cap - p->texture_cap) * sizeof(SDL_Texture *));
+        p->textures = grown;
+        p->texture_cap = cap;
+    }
+    SDL_DestroyTexture(p->textures[id]);
+    p->textures[id] = SDL_CreateTexture(p->renderer, format, access, w, h);
+    if (p->pass == 0)
+        p->created++;
+}
+
+
+/** @brief Envoie le motif, à la taille et au pas de l'envoi d'origine. */
+static void play_update(Player *p)
+{
+    SDL_Texture *t = get_texture(p);
+    SDL_Rect rect;
+    const SDL_Rect *r = get_rect(p, &rect);
+    uint32_t pitch = get_u32(p);
+    if (p->bad || !t)
+        return;
+    int rows = r ? r->h : t->h;
+    size_t n = (size_t)(rows > 0 ? rows : 0) * pitch;
+    if (pitch > 4u * MAX_SIDE || rows > MAX_SIDE || !pattern(p, n))
+    {
+        p->bad = true;
+        return;
+    }
+    SDL_UpdateTexture(t, r, p->pixels, (int)pitch);
+    if (p->pass == 0)
+        p->upload_bytes += (double)n;
+}
+
+/** @brief Sommets (lus tels quels dans `items` : un SDL_Vertex est fait de 8 réels) puis indices. */
+static void play_geometry(Player *p)
+{
+    SDL_Texture *t = get_texture(p);
+    uint32_t nv = get_u32(p);
+    if (p->bad || !get_items(p, nv, 8))
+        return;
+    uint32_t ni = get_u32(p);
+    if (ni > RENDERCAP_MAX_ITEMS || !reserve((void **)&p->indices, &p->indices_cap, (size_t)ni * sizeof(int)))
+    {
+        p->bad = true;
+        return;
+    }
+    for (uint32_t i = 0; i < ni; i++)
+    {
+        uint32_t k = get_u32(p);
+        p->indices[i] = k < nv ? (int)k : 0;
+    }
+    if (!p->bad)
+        SDL_RenderGeometry(p->renderer, t, p->items, (int)nv, ni ? p->indices : NULL, (int)ni);
+}
+
+/** @brief Ajoute une durée à un tableau de mesures. */
+static void push_ms(float **samples, size_t *cap, uint64_t count, float ms, bool *bad)
+{
+    if (reserve((void **)samples, cap, (size_t)(count + 1) * sizeof(float)))
+        (*samples)[count] = ms;
+    else
+        *bad = true;
+}
+
+/** @brief Présente l'image et relève sa durée (d'origine pendant la première passe). */
+static void play_present(Player *p, Uint64 *frame_start)
+{
+    uint32_t orig_us = get_u32(p);
+    if (p->bad)
+        return;
+    SDL_RenderPresent(p->renderer);
+    Uint64 now = SDL_GetTicksNS();
+    push_ms(&p->play_ms, &p->play_cap, p->played++, (float)((now - *frame_start) / 1e6), &p->bad);
+    *frame_start = now;
+    if (p->pass == 0)
+        push_ms(&p->orig_ms, &p->orig_cap, p->frames++, orig_us / 1000.0f, &p->bad);
+}
+
+/**
+ * @brief Exécute une commande du flux.
+ * @return false en fin de flux (ou flux invalide : `bad`).
+ */
+static bool play_command(Player *p, Uint64 *frame_start)
+{
+    int op = codec_reader_getc(&p->in);
+    if (op < 0)
+        return false;
+    if (p->pass == 0)
+        p->commands++;
+    SDL_Renderer *r = p->renderer;
+    SDL_FRect fa, fb;
+    SDL_Rect ra;
+    switch (op)
+    {
+    case OP_CREATE:
+        play_create(p);
+        break;
+    case OP_DESTROY:
+    {
+        uint32_t id = get_u32(p);
+        if (!p->bad && id < p->texture_cap)
+        {
+            SDL_DestroyTexture(p->textures[id]);
+            p->textures[id] = NULL;
+        }
+        break;
+    }
+    case OP_UPDATE:
+        play_update(p);
+        break;
+    case OP_TEX_BLEND:
+    {
+        SDL_Texture *t = get_texture(p);
+        SDL_BlendMode mode = get_u32(p);
+        if (t)
+            SDL_SetTextureBlendMode(t, mode);
+        break;
+    }
+    case OP_TEX_SCALE:
+    {
+        SDL_Texture *t = get_texture(p);
+        SDL_ScaleMode mode = (SDL_ScaleMode)get_u32(p);
+        if (t)
+            SDL_SetTextureScaleMode(t, mode);
+        break;
+    }
+    case OP_TEX_COLOR:
+    {
+        SDL_Texture *t = get_texture(p);
+        uint8_t cr = get_u8(p), cg = get_u8(p), cb = get_u8(p);
+        if (t)
+            SDL_SetTextureColorMod(t, cr, cg, cb);
+        break;
+    }
+    case OP_TEX_ALPHA:
+    {
+        SDL_Texture *t = get_texture(p);
+        uint8_t a = get_u8(p);
+        if (t)
+            SDL_SetTextureAlphaMod(t, a);
+        break;
+    }
+    case OP_TARGET:
+    {
+        SDL_Texture *t = get_texture(p);
+        if (!p->bad)
+            SDL_SetRenderTarget(r, t);
+        break;
+    }
+    case OP_LOGICAL:
+    {
+        int w = (int)get_u32(p), h = (int)get_u32(p);
+        SDL_RendererLogicalPresentation mode = (SDL_RendererLogicalPresentation)get_u32(p);
+        if (!p->bad)
+            SDL_SetRenderLogicalPresentation(r, w, h, mode);
+        break;
+    }
+    case OP_DRAW_COLOR:
+    {
+        uint8_t cr = get_u8(p), cg = get_u8(p), cb = get_u8(p), ca = get_u8(p);
+        SDL_SetRenderDrawColor(r, cr, cg, cb, ca);
+        break;
+    }
+    case OP_DRAW_BLEND:
+        SDL_SetRenderDrawBlendMode(r, get_u32(p));
+        break;
+    case OP_CLEAR:
+        SDL_RenderClear(r);
+        break;
+    case OP_FILL_RECT:
+    {
+        const SDL_FRect *rect = get_frect(p, &fa);
+        if (!p->bad)
+            SDL_RenderFillRect(r, rect);
+        break;
+    }
+    case OP_FILL_RECTS:
+    {
+        uint32_t n = get_u32(p);
+        if (!p->bad && get_items(p, n, 4))
+            SDL_RenderFillRects(r, p->items, (int)n);
+        break;
+    }
+    case OP_RECT:
+    {
+        const SDL_FRect *rect = get_frect(p, &fa);
+        if (!p->bad)
+            SDL_RenderRect(r, rect);
+        break;
+    }
+    case OP_LINE:
+    {
+        float x1 = get_f32(p), y1 = get_f32(p), x2 = get_f32(p), y2 = get_f32(p);
+        if (!p->bad)
+            SDL_RenderLine(r, x1, y1, x2, y2);
+        break;
+    }
+    case OP_POINTS:
+    {
+        uint32_t n = get_u32(p);
+        if (!p->bad && get_items(p, n, 2))
+            SDL_RenderPoints(r, p->items, (int)n);
+        break;
+    }
+    case OP_TEXTURE:
+    {
+        SDL_Texture *t = get_texture(p);
+        const SDL_FRect *src = get_frect(p, &fa);
+        const SDL_FRect *dst = get_frect(p, &fb);
+        if (!p->bad && t)
+            SDL_RenderTexture(r, t, src, dst);
+        break;
+    }
+    case OP_GEOMETRY:
+        play_geometry(p);
+        break;
+    case OP_READ:
+    {
+        const SDL_Rect *rect = get_rect(p, &ra);
+        if (!p->bad)
+            SDL_DestroySurface(SDL_RenderReadPixels(r, rect));
+        break;
+    }
+    case OP_FLUSH:
+        SDL_FlushRenderer(r);
+        break;
+    case OP_PRESENT:
+        play_present(p, frame_start);
+        break;
+    default:
+        p->bad = true;
+    }
+    return !p->bad;
+}
+
+/** @brief Comparaison de deux réels (qsort). */
+static int compare_float(const void *a, const void *b)
+{
+    float fa = *(const float *)a, fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+/** @brief Moyenne, 99e centile et maximum de `n` durées (triées sur place). */
+static void summarize(float *ms, uint64_t n, double *avg, double *p99, double *max)
+{
+    *avg = *p99 = *max = 0.0;
+    if (n == 0)
+        return;
+    double sum = 0.0;
+    for (uint64_t i = 0; i < n; i++)
+        sum += ms[i];
+    qsort(ms, (size_t)n, sizeof(float), compare_float);
+    *avg = sum / (double)n;
+    *p99 = ms[(99 * n + 99) / 100 - 1];
+    *max = ms[n - 1];
+}
+
+/**
+ * @brief En-tête vérifié, fenêtre et renderer sans vsync, puis les passes.
+ */
+bool rendercap_play(const char *path, int loops, const char *driver, RendercapReport *report)
+{
+    memset(report, 0, sizeof(RendercapReport));
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    uint8_t head[RENDERCAP_HEADER_SIZE];
+    if (fread(head, 1, sizeof(head), f) != sizeof(head) || memcmp(head, RENDERCAP_MAGIC, 4) != 0 ||
+        (head[4] | head[5] << 8) != RENDERCAP_VERSION)
+    {
+        fclose(f);
+        return false;
+    }
+    report->width = (int)((uint32_t)head[8] | (uint32_t)head[9] << 8 | (uint32_t)head[10] << 16 | (uint32_t)head[11] << 24);
+    report->height = (int)((uint32_t)head[12] | (uint32_t)head[13] << 8 | (uint32_t)head[14] << 16 | (uint32_t)head[15] << 24);
+    memcpy(report->driver, head + 16, 15);
+    report->loops = loops < 1 ? 1 : loops;
+    if (report->width <= 0 || report->height <= 0 || report->width > MAX_SIDE || report->height > MAX_SIDE ||
+        !SDL_Init(SDL_INIT_VIDEO))
+    {
+        fclose(f);
+        return false;
+    }
+
+    Player *p = calloc(1, sizeof(Player));
+    SDL_Window *window = p ? SDL_CreateWindow("Space Invaders - render replay", report->width, report->height, 0) : NULL;
+    if (window)
+    {
+        p->renderer = SDL_CreateRenderer(window, driver ? driver : report->driver);
+        if (!p->renderer && !driver)
+            p->renderer = SDL_CreateRenderer(window, NULL);
+    }
+    bool ok = p && p->renderer;
+    if (ok)
+    {
+        SDL_SetRenderVSync(p->renderer, 0);
+        SDL_strlcpy(report->played_on, SDL_GetRendererName(p->renderer), sizeof(report->played_on));
+        double t0 = SDL_GetTicksNS() / 1e9;
+        for (p->pass = 0; ok && p->pass < report->loops; p->pass++)
+        {
+            codec_reader_init(&p->in, f, true, RENDERCAP_HEADER_SIZE, -1);
+            Uint64 frame_start = SDL_GetTicksNS();
+            while (play_command(p, &frame_start))
+            {
+                if ((p->played & 63) == 0)
+                    SDL_PumpEvents(); // La fenêtre reste réactive pour le système
+            }
+            ok = !p->bad && !p->in.error;
+            for (uint32_t id = 0; id < p->texture_cap; id++)
+            {
+                SDL_DestroyTexture(p->textures[id]); // La passe suivante les recrée
+                p->textures[id] = NULL;
+            }
+        }
+        report->total_s = SDL_GetTicksNS() / 1e9 - t0;
+    }
+    if (ok)
+    {
+        report->frames = p->frames;
+        report->commands = p->commands;
+        report->textures = p->created;
+        report->upload_mb = p->upload_bytes / (1024.0 * 1024.0);
+        summarize(p->orig_ms, p->frames, &report->orig_avg_ms, &report->orig_p99_ms, &report->orig_max_ms);
+        float worst = 0.0f;
+        for (uint64_t i = 0; i < p->played; i++)
+        {
+            if (p->play_ms[i] > worst)
+            {
+                worst = p->play_ms[i];
+                report->slowest = i % (p->frames ? p->frames : 1) + 1;
+            }
+        }
+        summarize(p->play_ms, p->played, &report->avg_ms, &report->p99_ms, &report->max_ms);
+    }
+
+    if (p)
+    {
+        if (p->renderer)
+            SDL_DestroyRenderer(p->renderer);
+        free(p->textures);
+        free(p->pixels);
+        free(p->items);
+        free(p->indices);
+        free(p->orig_ms);
+        free(p->play_ms);
+        free(p);
+    }
+    if (window)
+        SDL_DestroyWindow(window);
+    SDL_Quit();
+    fclose(f);
+    return ok;
+}
+
+/**
+ * @brief Résumé sur la sortie standard, à la manière du banc de rendu.
+ */
+void rendercap_print_report(const RendercapReport *report)
+{
+    printf("[REJEU] Enregistrement  : %dx%d, pilote %s ; rejoué sur %s, %d passe(s)\n", report->width,
+           report->height, report->driver[0] ? report->driver : "?", report->played_on, report->loops);
+    printf("[REJEU] Par passe       : %llu images, %llu commandes, %llu textures, %.1f Mo envoyés\n",
+           (unsigned long long)report->frames, (unsigned long long)report->commands,
+           (unsigned long long)report->textures, report->upload_mb);
+    printf("[REJEU] Origine         : %.3f ms en moyenne, p99 %.3f ms, max %.3f ms\n", report->orig_avg_ms,
+           report->orig_p99_ms, report->orig_max_ms);
+    printf("[REJEU] Rejeu           : %.3f ms en moyenne, p99 %.3f ms, max %.3f ms (image %llu)\n", report->avg_ms,
+           report->p99_ms, report->max_ms, (unsigned long long)report->slowest);
+    printf("[REJEU] Cadence         : %.0f images/s (sans vsync, %.2f s)\n",
+           report->total_s > 0.0 ? (double)report->frames * report->loops / report->total_s : 0.0, report->total_s);
+}
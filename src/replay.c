@@ -0,0 +1,1173 @@
+/**
+ * @file replay.c
+ * @brief Implémentation de l'enregistreur d'entrées et du rejeu déterministe.
+ */
+
+#include "replay.h"
+#include "codec.h"
+#include "save.h"
+#include "statehash.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define REPLAY_HEADER_SIZE 20   ///< Taille de l'en-tête (octets).
+#define RECORD_SNAPSHOT 0xFF    ///< Marqueur d'un instantané (jamais une commande).
+#define RECORD_INDEX 0xFE       ///< Marqueur de l'index : fin du flux de frames.
+#define RECORD_HASH 0xFD        ///< Marqueur d'une empreinte d'état (REPLAY_FLAG_HASHES).
+#define HASH_RECORD_SIZE 8      ///< Octets de la chaîne, après le varint de la fenêtre.
+#define RECORD_RESULT 0xFC      ///< Marqueur du résultat de la session (REPLAY_FLAG_HASHES).
+#define RESULT_RECORD_SIZE 24   ///< ticks u64 | score u32 | niveau u32 | chaîne u64.
+#define SNAPSHOT_HEADER_SIZE 21 ///< marqueur u8 | frame u64 | tick u64 | taille u32.
+#define INDEX_ENTRY_SIZE 24     ///< frame u64 | tick u64 | position u64.
+#define TRAILER_MAGIC "SIDX"    ///< Signature de la fin de fichier.
+#define TRAILER_SIZE 12         ///< "SIDX" | position de l'index u64.
+
+/** @brief Enregistreur fermé par le hook atexit. */
+static ReplayRecorder *open_recorder = NULL;
+
+/** @brief Écrit un entier non signé au format varint (7 bits par octet). */
+static void write_varint(CodecWriter *w, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        codec_writer_putc(w, (uint8_t)((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    codec_writer_putc(w, (uint8_t)v);
+}
+
+/** @brief Lit un varint ; false si le flux s'arrête au milieu. */
+static bool read_varint(CodecReader *in, uint32_t *out)
+{
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        int b = codec_reader_getc(in);
+        if (b < 0)
+            return false;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+        {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Écrit un entier little-endian de `n` octets. */
+static void write_le(CodecWriter *w, uint64_t v, int n)
+{
+    for (int i = 0; i < n; i++)
+        codec_writer_putc(w, (uint8_t)((v >> (8 * i)) & 0xFF));
+}
+
+/** @brief Décode un entier little-endian de `n` octets. */
+static uint64_t get_le(const uint8_t *p, int n)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++)
+        v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+/** @brief Écrit la plage en cours. */
+static void flush_run(ReplayRecorder *rec)
+{
+    if (rec->count == 0)
+        return;
+    codec_writer_putc(&rec->out, rec->cmd);
+    codec_writer_putc(&rec->out, rec->updates);
+    write_varint(&rec->out, rec->count);
+    rec->count = 0;
+}
+
+/** @brief Ajoute une frame à la plage en cours (ou en ouvre une nouvelle). */
+static void append_frame(ReplayRecorder *rec, GameCommand cmd, int updates)
+{
+    rec->frames++;
+    rec->ticks += (uint64_t)updates;
+    if (rec->count > 0 && rec->cmd == (uint8_t)cmd && rec->updates == (uint8_t)updates && rec->count < UINT32_MAX)
+    {
+        rec->count++;
+    }
+    else
+    {
+        flush_run(rec);
+        rec->cmd = (uint8_t)cmd;
+        rec->updates = (uint8_t)updates;
+        rec->count = 1;
+    }
+}
+
+/** @brief Hook atexit : ferme l'enregistrement en cours. */
+static void close_at_exit(void)
+{
+    if (open_recorder)
+        replay_record_close(open_recorder);
+}
+
+/** @brief Recopie l'état final du modèle dans les stats. */
+static void fill_final_state(ReplayStats *stats, const GameModel *model, double start)
+{
+    stats->elapsed_s = utils_get_time() - start;
+    stats->score = model->sim.score;
+    stats->level = model->sim.level;
+    stats->lives = model->sim.lives;
+    stats->state = model->sim.state;
+    stats->fixed_point = model->sim.fixed_point;
+    stats->shield_bitmap = model->sim.shield_bitmap;
+    stats->swept_bullets = model->sim.swept_bullets;
+    stats->endless = model->sim.endless;
+    stats->coop = model->sim.coop;
+    stats->fire_scheduled = model->sim.fire_scheduled;
+    stats->rng_state = model->sim.rng.state;
+    stats->fingerprint = save_fingerprint(model);
+}
+
+// ============================================================================
+//                          2. ENREGISTREMENT
+// ============================================================================
+
+/**
+ * @brief Écrit un instantané encodé et l'ajoute à l'index.
+ *
+ * La plage en cours est écrite avant : une plage ne chevauche jamais un
+ * instantané, le rejeu peut donc reprendre juste après lui.
+ */
+static void write_snapshot_data(ReplayRecorder *rec, const uint8_t *payload, size_t n)
+{
+    if (rec->snapshot_count == rec->snapshot_cap)
+    {
+        uint32_t cap = rec->snapshot_cap ? rec->snapshot_cap * 2 : 64;
+        ReplaySnapshot *grown = realloc(rec->snapshots, cap * sizeof(ReplaySnapshot));
+        if (!grown)
+            return;
+        rec->snapshots = grown;
+        rec->snapshot_cap = cap;
+    }
+
+    // Un instantané ouvre toujours un bloc : c'est un point de reprise du flux
+    flush_run(rec);
+    long offset = codec_writer_mark(&rec->out);
+    if (offset < 0)
+        return;
+
+    ReplaySnapshot *snap = &rec->snapshots[rec->snapshot_count++];
+    snap->frame = rec->frames;
+    snap->tick = rec->ticks;
+    snap->offset = (uint64_t)offset;
+
+    codec_writer_putc(&rec->out, RECORD_SNAPSHOT);
+    write_le(&rec->out, snap->frame, 8);
+    write_le(&rec->out, snap->tick, 8);
+    write_le(&rec->out, n, 4);
+    codec_writer_write(&rec->out, payload, n);
+}
+
+/**
+ * @brief Écrit un instantané du modèle et l'ajoute à l'index.
+ */
+static void write_snapshot(ReplayRecorder *rec, const GameModel *model)
+{
+    static uint8_t payload[SAVE_MAX_SIZE];
+    size_t n = save_encode_snapshot(model, payload, sizeof(payload));
+    if (n > 0)
+        write_snapshot_data(rec, payload, n);
+}
+
+/**
+ * @brief Écrit la chaîne d'empreintes de la fenêtre qui finit au tick `tick`.
+ *
+ * La plage en cours est écrite avant, comme pour un instantané. Avec
+ * replay_record_command, la frame ouverte (qui contient ce tick) suit
+ * l'empreinte : le lecteur la garde en attente jusqu'à ce tick.
+ */
+static void write_hash(ReplayRecorder *rec, uint64_t tick)
+{
+    flush_run(rec);
+    codec_writer_putc(&rec->out, RECORD_HASH);
+    write_varint(&rec->out, (uint32_t)(tick / REPLAY_HASH_TICKS));
+    write_le(&rec->out, rec->hash, HASH_RECORD_SIZE);
+}
+
+/**
+ * @brief Écrit le résultat de la session : ticks, score, niveau et chaîne de la dernière fenêtre.
+ */
+static void write_result(ReplayRecorder *rec)
+{
+    codec_writer_putc(&rec->out, RECORD_RESULT);
+    write_le(&rec->out, rec->ticks, 8);
+    write_le(&rec->out, (uint32_t)rec->score, 4);
+    write_le(&rec->out, (uint32_t)rec->level, 4);
+    write_le(&rec->out, rec->hash, HASH_RECORD_SIZE);
+}
+
+/**
+ * @brief Écrit l'index des instantanés et la fin de fichier.
+ *
+ * L'index suit le dernier bloc et n'est jamais compressé : le lecteur le
+ * trouve depuis la fin du fichier sans décoder le flux.
+ */
+static void write_index(ReplayRecorder *rec)
+{
+    long offset = codec_writer_mark(&rec->out);
+    if (offset < 0)
+        return;
+
+    CodecWriter *raw = &rec->out;
+    raw->compress = false;
+    codec_writer_putc(raw, RECORD_INDEX);
+    write_le(raw, rec->snapshot_count, 4);
+    for (uint32_t i = 0; i < rec->snapshot_count; i++)
+    {
+        write_le(raw, rec->snapshots[i].frame, 8);
+        write_le(raw, rec->snapshots[i].tick, 8);
+        write_le(raw, rec->snapshots[i].offset, 8);
+    }
+    codec_writer_write(raw, TRAILER_MAGIC, 4);
+    write_le(raw, (uint64_t)offset, 8);
+}
+
+/**
+ * @brief Crée le fichier et écrit son en-tête.
+ */
+static bool open_file(ReplayRecorder *rec, const char *path, uint64_t seed, uint32_t flags, int hz)
+{
+    memset(rec, 0, sizeof(ReplayRecorder));
+    rec->file = fopen(path, "wb");
+    if (!rec->file)
+        return false;
+    rec->next_snapshot = REPLAY_SNAPSHOT_TICKS;
+
+    uint8_t h[REPLAY_HEADER_SIZE] = {0};
+    memcpy(h, REPLAY_MAGIC, 4);
+    h[4] = REPLAY_VERSION & 0xFF;
+    h[5] = REPLAY_VERSION >> 8;
+    h[6] = hz & 0xFF;
+    h[7] = hz >> 8;
+    for (int i = 0; i < 8; i++)
+        h[8 + i] = (uint8_t)(seed >> (8 * i));
+    for (int i = 0; i < 4; i++)
+        h[16 + i] = (uint8_t)(flags >> (8 * i));
+    fwrite(h, 1, sizeof(h), rec->file);
+    codec_writer_init(&rec->out, rec->file, (flags & REPLAY_FLAG_COMPRESSED) != 0);
+    return true;
+}
+
+/**
+ * @brief Ouvre un fichier d'enregistrement et écrit son en-tête.
+ */
+bool replay_record_open(ReplayRecorder *rec, const char *path, const GameModel *model, bool compress)
+{
+    uint32_t flags = replay_session_flags(model) | (compress ? REPLAY_FLAG_COMPRESSED : 0) | REPLAY_FLAG_HASHES;
+    if (!open_file(rec, path, model->sim.rng.seed, flags, model_tick_rate(model)))
+        return false;
+    rec->hashes = true;
+
+    static bool hook_set = false;
+    if (!hook_set)
+        hook_set = atexit(close_at_exit) == 0;
+    open_recorder = rec;
+    return true;
+}
+
+/**
+ * @brief Ouvre un enregistrement écrit d'un bloc, parti d'un instantané ou de la graine.
+ */
+bool replay_record_open_at(ReplayRecorder *rec, const char *path, uint64_t seed, uint32_t flags, int hz,
+                           const uint8_t *snapshot, size_t size)
+{
+    flags &= ~(uint32_t)(REPLAY_FLAG_COMPRESSED | REPLAY_FLAG_HASHES); // Ni compression ni empreintes
+    if (snapshot)
+        flags |= REPLAY_FLAG_PARTIAL;
+    if (!open_file(rec, path, seed, flags, hz))
+        return false;
+    rec->next_snapshot = UINT64_MAX;
+    if (snapshot)
+        write_snapshot_data(rec, snapshot, size);
+    return true;
+}
+
+/**
+ * @brief Physique de la session, telle que le rejeu doit la reprendre.
+ */
+uint32_t replay_session_flags(const GameModel *model)
+{
+    return (model->sim.fixed_point ? REPLAY_FLAG_FIXED : 0) | (model->sim.shield_bitmap ? REPLAY_FLAG_SHIELDS : 0) |
+           (model->sim.swept_bullets ? REPLAY_FLAG_SWEPT : 0) | (model->sim.fire_scheduled ? REPLAY_FLAG_FIRE : 0) |
+           (model->sim.exact_timers ? REPLAY_FLAG_TICKS : 0) | (model->sim.formation_path ? REPLAY_FLAG_PATH : 0) |
+           (model->sim.level_retry ? REPLAY_FLAG_RETRY : 0) | (model->sim.endless ? REPLAY_FLAG_ENDLESS : 0) |
+           (model->sim.coop ? REPLAY_FLAG_COOP : 0);
+}
+
+/**
+ * @brief Ajoute une frame au flux, sans jamais d'instantané.
+ */
+void replay_record_raw(ReplayRecorder *rec, GameCommand cmd, int updates)
+{
+    if (rec->file)
+        append_frame(rec, cmd, updates);
+}
+
+/**
+ * @brief Enregistre une frame : la commande lue puis le nombre de ticks simulés.
+ */
+void replay_record_frame(ReplayRecorder *rec, const GameModel *model, GameCommand cmd, int updates)
+{
+    if (!rec->file)
+        return;
+
+    append_frame(rec, cmd, updates);
+
+    // Instantané dû : seulement en partie (les menus dépendent du disque et de la saisie)
+    if (rec->ticks >= rec->next_snapshot && model->sim.state == STATE_PLAYING)
+    {
+        write_snapshot(rec, model);
+        rec->next_snapshot = (rec->ticks / REPLAY_SNAPSHOT_TICKS + 1) * REPLAY_SNAPSHOT_TICKS;
+    }
+}
+
+/**
+ * @brief Enregistre une commande, juste avant de l'appliquer au modèle, sans ses ticks.
+ */
+void replay_record_command(ReplayRecorder *rec, const GameModel *model, GameCommand cmd)
+{
+    if (!rec->file)
+        return;
+    if (rec->open)
+        replay_record_frame(rec, model, rec->open_cmd, rec->open_updates);
+    rec->open = true;
+    rec->open_cmd = cmd;
+    rec->open_updates = 0;
+}
+
+/**
+ * @brief Compte un tick simulé, et chaîne l'empreinte de l'état qu'il a produit.
+ */
+void replay_record_tick(ReplayRecorder *rec, const GameModel *model)
+{
+    if (!rec->file)
+        return;
+    if (rec->open)
+        rec->open_updates++;
+    if (!rec->hashes)
+        return;
+    rec->score = model->sim.score;
+    rec->level = model->sim.level;
+
+    // Avec replay_record_frame, la frame du tick est déjà comptée ; sinon elle est encore ouverte
+    uint64_t tick = rec->ticks + (rec->open ? (uint64_t)rec->open_updates : 0);
+    rec->hash = statehash_model(model, rec->hash);
+    if (tick % REPLAY_HASH_TICKS == 0)
+    {
+        write_hash(rec, tick);
+        rec->hash = 0;
+    }
+}
+
+/**
+ * @brief Écrit la dernière plage, l'index des instantanés, et ferme le fichier.
+ */
+void replay_record_close(ReplayRecorder *rec)
+{
+    if (!rec->file)
+        return;
+    if (rec->open)
+    {
+        // Dernière commande : ses ticks sont connus, l'instantané éventuel est superflu
+        append_frame(rec, rec->open_cmd, rec->open_updates);
+        rec->open = false;
+    }
+    flush_run(rec);
+    if (rec->hashes)
+        write_result(rec);
+    write_index(rec);
+    fclose(rec->file);
+    rec->file = NULL;
+    free(rec->snapshots);
+    rec->snapshots = NULL;
+    rec->snapshot_count = rec->snapshot_cap = 0;
+    if (open_recorder == rec)
+        open_recorder = NULL;
+}
+
+// ============================================================================
+//                          3. LECTURE DU FICHIER
+// ============================================================================
+
+/**
+ * @brief Curseur de lecture sur un enregistrement.
+ *
+ * Le fichier n'est jamais chargé en entier : le flux est lu bloc par bloc
+ * (cf. codec.h), seul l'index des instantanés est gardé en mémoire.
+ */
+typedef struct
+{
+    FILE *file;                  ///< Fichier ouvert.
+    CodecReader in;              ///< Flux des frames (compressé ou brut).
+    bool indexed;                ///< Index de fin présent : une troncature est une erreur.
+    uint64_t seed;               ///< Graine de la session.
+    int hz;                      ///< Fréquence de simulation de la session.
+    bool fixed_point;            ///< Session en virgule fixe (REPLAY_FLAG_FIXED).
+    bool shield_bitmap;          ///< Boucliers en bitmap (REPLAY_FLAG_SHIELDS).
+    bool swept_bullets;          ///< Collisions balayées (REPLAY_FLAG_SWEPT).
+    bool fire_scheduled;         ///< Tirs ennemis planifiés (REPLAY_FLAG_FIRE).
+    bool exact_timers;           ///< Timers arrondis au tick (REPLAY_FLAG_TICKS).
+    bool formation_path;         ///< Vague en segments (REPLAY_FLAG_PATH).
+    bool level_retry;            ///< « Réessayer » au Game Over (REPLAY_FLAG_RETRY).
+    bool endless;                ///< Vague sans fin (REPLAY_FLAG_ENDLESS).
+    bool coop;                   ///< Deux vaisseaux (REPLAY_FLAG_COOP).
+    bool partial;                ///< Départ d'un instantané (REPLAY_FLAG_PARTIAL).
+    bool hashes;                 ///< Empreintes d'état dans le flux (REPLAY_FLAG_HASHES).
+    uint64_t hash;               ///< Chaîne des empreintes de la fenêtre en cours.
+    bool hash_whole;             ///< La chaîne couvre toute la fenêtre (faux après un saut).
+    uint64_t done_tick;          ///< Fin de la dernière fenêtre entière rejouée (0 : aucune).
+    uint64_t done_hash;          ///< Sa chaîne.
+    uint64_t pending_tick;       ///< Empreinte lue avant d'avoir rejoué sa fenêtre (0 : aucune).
+    uint64_t pending_hash;       ///< Sa chaîne.
+    uint64_t ticks;              ///< Ticks rejoués (compte de replay_frame).
+    FILE *trace;                 ///< Empreinte de chaque tick (ReplayOptions::hash_trace).
+    uint32_t hash_checks;        ///< Empreintes comparées.
+    uint32_t hash_mismatches;    ///< Empreintes différentes.
+    uint64_t desync_tick;        ///< Fin de la première fenêtre divergente (0 : aucune).
+    bool claimed;                ///< Résultat de la session lu (RECORD_RESULT).
+    uint64_t claimed_ticks;      ///< Ticks annoncés.
+    int claimed_score;           ///< Score annoncé.
+    int claimed_level;           ///< Niveau annoncé.
+    ReplaySnapshot *snapshots;   ///< Instantanés (index ou parcours), par tick croissant.
+    uint32_t snapshot_count;     ///< Nombre d'instantanés.
+    uint8_t cmd;                 ///< Commande de la plage en cours.
+    uint8_t updates;             ///< Ticks par frame de la plage en cours.
+    uint32_t remaining;          ///< Frames restantes dans la plage en cours.
+    bool error;                  ///< Flux tronqué ou invalide.
+} ReplayReader;
+
+/**
+ * @brief Lit l'index de fin de fichier (version 2 fermée proprement).
+ * @return La position de l'index (fin du flux), ou -1 si la fin de fichier est absente ou incohérente.
+ */
+static long load_index(ReplayReader *r, long size)
+{
+    uint8_t trailer[TRAILER_SIZE];
+    if (size < REPLAY_HEADER_SIZE + TRAILER_SIZE || fseek(r->file, size - TRAILER_SIZE, SEEK_SET) != 0 ||
+        fread(trailer, 1, sizeof(trailer), r->file) != sizeof(trailer) ||
+        memcmp(trailer, TRAILER_MAGIC, 4) != 0)
+        return -1;
+
+    uint64_t at = get_le(trailer + 4, 8);
+    long limit = size - TRAILER_SIZE;
+    uint8_t head[5];
+    if (at < REPLAY_HEADER_SIZE || at + sizeof(head) > (uint64_t)limit ||
+        fseek(r->file, (long)at, SEEK_SET) != 0 || fread(head, 1, sizeof(head), r->file) != sizeof(head) ||
+        head[0] != RECORD_INDEX)
+        return -1;
+    uint32_t count = (uint32_t)get_le(head + 1, 4);
+    if (count > (uint64_t)(limit - (long)at - 5) / INDEX_ENTRY_SIZE)
+        return -1;
+
+    ReplaySnapshot *snaps = count ? malloc(count * sizeof(ReplaySnapshot)) : NULL;
+    if (count && !snaps)
+        return -1;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint8_t e[INDEX_ENTRY_SIZE];
+        if (fread(e, 1, sizeof(e), r->file) != sizeof(e))
+        {
+            free(snaps);
+            return -1;
+        }
+        snaps[i].frame = get_le(e, 8);
+        snaps[i].tick = get_le(e + 8, 8);
+        snaps[i].offset = get_le(e + 16, 8);
+    }
+    r->snapshots = snaps;
+    r->snapshot_count = count;
+    return (long)at;
+}
+
+/** @brief Saute `n` octets du flux. @return false si le flux s'arrête avant. */
+static bool skip_bytes(CodecReader *in, uint64_t n)
+{
+    uint8_t scratch[256];
+    while (n > 0)
+    {
+        size_t take = n < sizeof(scratch) ? (size_t)n : sizeof(scratch);
+        if (codec_reader_read(in, scratch, take) != take)
+            return false;
+        n -= take;
+    }
+    return true;
+}
+
+/**
+ * @brief Retrouve les instantanés en parcourant le flux (fichier sans index).
+ *
+ * S'arrête au premier enregistrement incomplet : la fin d'une session
+ * interrompue est ignorée.
+ */
+static void scan_snapshots(ReplayReader *r)
+{
+    uint32_t cap = 0;
+    for (;;)
+    {
+        long at = codec_reader_mark(&r->in);
+        int marker = codec_reader_getc(&r->in);
+        if (marker < 0 || marker == RECORD_INDEX)
+            break;
+        if (marker == RECORD_SNAPSHOT)
+        {
+            uint8_t h[SNAPSHOT_HEADER_SIZE - 1];
+            if (at < 0 || codec_reader_read(&r->in, h, sizeof(h)) != sizeof(h) ||
+                !skip_bytes(&r->in, get_le(h + 16, 4)))
+                break;
+            if (r->snapshot_count == cap)
+            {
+                cap = cap ? cap * 2 : 64;
+                ReplaySnapshot *grown = realloc(r->snapshots, cap * sizeof(ReplaySnapshot));
+                if (!grown)
+                    break;
+                r->snapshots = grown;
+            }
+            ReplaySnapshot *snap = &r->snapshots[r->snapshot_count++];
+            snap->frame = get_le(h, 8);
+            snap->tick = get_le(h + 8, 8);
+            snap->offset = (uint64_t)at;
+        }
+        else if (marker == RECORD_HASH)
+        {
+            uint32_t window;
+            if (!read_varint(&r->in, &window) || !skip_bytes(&r->in, HASH_RECORD_SIZE))
+                break;
+        }
+        else if (marker == RECORD_RESULT)
+        {
+            if (!skip_bytes(&r->in, RESULT_RECORD_SIZE))
+                break;
+        }
+        else
+        {
+            uint32_t count;
+            if (codec_reader_getc(&r->in) < 0 || !read_varint(&r->in, &count))
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Ouvre un enregistrement, vérifie l'en-tête et localise les instantanés.
+ * @return false si le fichier n'est pas un enregistrement lisible.
+ */
+static bool reader_open(ReplayReader *r, const char *path)
+{
+    memset(r, 0, sizeof(ReplayReader));
+    r->file = fopen(path, "rb");
+    if (!r->file)
+        return false;
+
+    uint8_t h[REPLAY_HEADER_SIZE];
+    long size = -1;
+    bool ok = fread(h, 1, sizeof(h), r->file) == sizeof(h) && memcmp(h, REPLAY_MAGIC, 4) == 0 &&
+              fseek(r->file, 0, SEEK_END) == 0 && (size = ftell(r->file)) >= REPLAY_HEADER_SIZE;
+    int version = h[4] | (h[5] << 8);
+    int hz = h[6] | (h[7] << 8);
+    uint32_t flags = (uint32_t)get_le(h + 16, 4);
+    if (!ok || version < 1 || version > REPLAY_VERSION || hz < MODEL_TICK_RATE_MIN || hz > MODEL_TICK_RATE_MAX ||
+        (flags & ~(uint32_t)(REPLAY_FLAG_COMPRESSED | REPLAY_FLAG_FIXED | REPLAY_FLAG_SHIELDS | REPLAY_FLAG_SWEPT |
+                               REPLAY_FLAG_FIRE | REPLAY_FLAG_PARTIAL | REPLAY_FLAG_TICKS |
+                               REPLAY_FLAG_HASHES | REPLAY_FLAG_PATH | REPLAY_FLAG_RETRY | REPLAY_FLAG_ENDLESS |
+                               REPLAY_FLAG_COOP)) != 0)
+    {
+        fclose(r->file);
+        r->file = NULL;
+        return false;
+    }
+    r->seed = get_le(h + 8, 8);
+    r->hz = hz;
+    r->fixed_point = (flags & REPLAY_FLAG_FIXED) != 0;
+    r->shield_bitmap = (flags & REPLAY_FLAG_SHIELDS) != 0;
+    r->swept_bullets = (flags & REPLAY_FLAG_SWEPT) != 0;
+    r->fire_scheduled = (flags & REPLAY_FLAG_FIRE) != 0;
+    r->exact_timers = (flags & REPLAY_FLAG_TICKS) != 0;
+    r->formation_path = (flags & REPLAY_FLAG_PATH) != 0;
+    r->level_retry = (flags & REPLAY_FLAG_RETRY) != 0;
+    r->endless = (flags & REPLAY_FLAG_ENDLESS) != 0;
+    r->coop = (flags & REPLAY_FLAG_COOP) != 0;
+    r->hashes = (flags & REPLAY_FLAG_HASHES) != 0;
+    r->hash_whole = true;
+    r->partial = (flags & REPLAY_FLAG_PARTIAL) != 0;
+    bool compressed = (flags & REPLAY_FLAG_COMPRESSED) != 0;
+
+    long end = (version >= 2) ? load_index(r, size) : -1;
+    r->indexed = end >= 0;
+    codec_reader_init(&r->in, r->file, compressed, REPLAY_HEADER_SIZE, end);
+    if (version >= 2 && !r->indexed)
+    {
+        scan_snapshots(r);
+        codec_reader_init(&r->in, r->file, compressed, REPLAY_HEADER_SIZE, -1);
+    }
+    return true;
+}
+
+/** @brief Ferme l'enregistrement et libère l'index. */
+static void reader_close(ReplayReader *r)
+{
+    if (r->file)
+        fclose(r->file);
+    free(r->snapshots);
+    r->file = NULL;
+    r->snapshots = NULL;
+}
+
+/**
+ * @brief Compare la chaîne enregistrée d'une fenêtre à celle du rejeu.
+ */
+static void hash_compare(ReplayReader *r, uint64_t tick, uint64_t recorded, uint64_t replayed)
+{
+    r->hash_checks++;
+    if (recorded != replayed && r->hash_mismatches++ == 0)
+        r->desync_tick = tick;
+}
+
+/**
+ * @brief Empreinte lue dans le flux : comparée si sa fenêtre est rejouée, gardée si elle est à venir.
+ *
+ * Une fenêtre qui n'a pas été rejouée en entier (saut à un instantané) n'est pas vérifiée.
+ */
+static void hash_record(ReplayReader *r, uint64_t tick, uint64_t recorded)
+{
+    if (tick > r->ticks)
+    {
+        r->pending_tick = tick;
+        r->pending_hash = recorded;
+    }
+    else if (tick == r->done_tick)
+    {
+        hash_compare(r, tick, recorded, r->done_hash);
+    }
+}
+
+/**
+ * @brief Résultat lu en fin de flux : annoncé tel quel, et chaîne de la dernière fenêtre comparée.
+ *
+ * Le rejeu n'a plus de frame à simuler : si ses ticks ne sont pas ceux
+ * annoncés, replay_verify le signale ; sa chaîne n'est pas comparable.
+ */
+static void hash_result(ReplayReader *r, const uint8_t *p)
+{
+    r->claimed = true;
+    r->claimed_ticks = get_le(p, 8);
+    r->claimed_score = (int)(uint32_t)get_le(p + 8, 4);
+    r->claimed_level = (int)(uint32_t)get_le(p + 12, 4);
+    if (r->claimed_ticks == r->ticks && r->hash_whole && r->ticks % REPLAY_HASH_TICKS != 0)
+        hash_compare(r, r->ticks, get_le(p + 16, HASH_RECORD_SIZE), r->hash);
+}
+
+/**
+ * @brief Chaîne l'empreinte du tick qui vient d'être rejoué ; clôt la fenêtre à sa fin.
+ */
+static void hash_tick(ReplayReader *r, const GameModel *model)
+{
+    if (r->trace)
+        fprintf(r->trace, "%llu %016llx\n", (unsigned long long)r->ticks,
+                (unsigned long long)statehash_model(model, 0));
+    if (!r->hashes)
+        return;
+    r->hash = statehash_model(model, r->hash);
+    if (r->ticks % REPLAY_HASH_TICKS != 0)
+        return;
+    if (r->hash_whole)
+    {
+        r->done_tick = r->ticks;
+        r->done_hash = r->hash;
+        if (r->pending_tick == r->ticks)
+            hash_compare(r, r->ticks, r->pending_hash, r->hash);
+    }
+    r->hash = 0;
+    r->hash_whole = true;
+}
+
+/**
+ * @brief Lit la frame suivante (commande et ticks), en sautant les instantanés.
+ *
+ * Les empreintes d'état rencontrées en chemin sont vérifiées (hash_record).
+ * Sans index, un flux qui s'arrête au milieu d'un enregistrement est une
+ * session interrompue : sa fin est ignorée, comme au parcours.
+ *
+ * @return false en fin de flux ou sur un flux invalide (r->error).
+ */
+static bool reader_next(ReplayReader *r, GameCommand *cmd, int *updates)
+{
+    while (r->remaining == 0)
+    {
+        int marker = codec_reader_getc(&r->in);
+        if (marker < 0)
+        {
+            r->error = r->indexed && r->in.error;
+            return false;
+        }
+        if (marker == RECORD_INDEX)
+            return false;
+
+        bool complete;
+        if (marker == RECORD_SNAPSHOT)
+        {
+            uint8_t h[SNAPSHOT_HEADER_SIZE - 1];
+            complete = codec_reader_read(&r->in, h, sizeof(h)) == sizeof(h) &&
+                       skip_bytes(&r->in, get_le(h + 16, 4));
+        }
+        else if (marker == RECORD_HASH)
+        {
+            uint32_t window;
+            uint8_t h[HASH_RECORD_SIZE];
+            complete = read_varint(&r->in, &window) && codec_reader_read(&r->in, h, sizeof(h)) == sizeof(h);
+            if (complete)
+                hash_record(r, (uint64_t)window * REPLAY_HASH_TICKS, get_le(h, HASH_RECORD_SIZE));
+        }
+        else if (marker == RECORD_RESULT)
+        {
+            uint8_t h[RESULT_RECORD_SIZE];
+            complete = codec_reader_read(&r->in, h, sizeof(h)) == sizeof(h);
+            if (complete)
+                hash_result(r, h);
+        }
+        else
+        {
+            r->cmd = (uint8_t)marker;
+            int u = codec_reader_getc(&r->in);
+            r->updates = (uint8_t)u;
+            complete = u >= 0 && read_varint(&r->in, &r->remaining);
+        }
+        if (!complete)
+        {
+            r->remaining = 0;
+            r->error = r->indexed;
+            return false;
+        }
+    }
+    r->remaining--;
+    *cmd = (GameCommand)r->cmd;
+    *updates = r->updates;
+    return true;
+}
+
+/**
+ * @brief Restaure un instantané et place la lecture juste après lui.
+ * @return false (modèle intact) si l'instantané est invalide.
+ */
+static bool reader_restore(ReplayReader *r, GameModel *model, const ReplaySnapshot *snap)
+{
+    uint8_t h[SNAPSHOT_HEADER_SIZE];
+    r->remaining = 0;
+    if (snap->offset > LONG_MAX || !codec_reader_seek(&r->in, (long)snap->offset) ||
+        codec_reader_read(&r->in, h, sizeof(h)) != sizeof(h) || h[0] != RECORD_SNAPSHOT)
+        return false;
+    uint64_t n = get_le(h + 17, 4);
+    uint8_t *payload = n <= SAVE_MAX_SIZE ? malloc((size_t)n) : NULL; // Pas de tampon statique : rejeux en parallèle (pool.h)
+    bool ok = payload && codec_reader_read(&r->in, payload, (size_t)n) == n &&
+              save_decode_snapshot(model, payload, (size_t)n);
+    free(payload);
+    if (!ok)
+        return false;
+
+    // La chaîne de la fenêtre en cours est perdue : vérification à la prochaine fenêtre entière
+    r->ticks = snap->tick;
+    r->hash = 0;
+    r->hash_whole = snap->tick % REPLAY_HASH_TICKS == 0;
+    r->done_tick = r->pending_tick = 0;
+    return true;
+}
+
+// ============================================================================
+//                          4. REJEU
+// ============================================================================
+
+/**
+ * @brief Rejoue une frame : même séquence que la boucle de jeu (commande, puis ticks).
+ * @return false si la session s'est terminée pendant cette frame.
+ */
+static bool replay_frame(ReplayReader *r, GameModel *model, GameCommand cmd, int updates, ReplayStats *stats)
+{
+    const double dt = 1.0 / stats->hz;
+    stats->frames++;
+    if (!model_dispatch_command(model, cmd))
+    {
+        stats->quit = true;
+        return false;
+    }
+    for (int u = 0; u < updates; u++)
+    {
+        model_update(model, dt);
+        r->ticks++;
+        if (r->hashes || r->trace)
+            hash_tick(r, model);
+    }
+    stats->ticks += (uint64_t)updates;
+    if (model->ui.pending_quit)
+    {
+        stats->quit = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Avance jusqu'au tick `target` : instantané le plus proche, puis simulation.
+ */
+static void seek_to(ReplayReader *r, GameModel *model, uint64_t target, ReplayStats *stats)
+{
+    // Index trié par tick : on part du dernier instantané valide avant la cible
+    bool moved = false, restored = false;
+    for (uint32_t i = r->snapshot_count; i-- > 0 && !restored;)
+    {
+        const ReplaySnapshot *snap = &r->snapshots[i];
+        if (snap->tick > target)
+            continue;
+        moved = true;
+        restored = reader_restore(r, model, snap);
+        if (restored)
+        {
+            stats->frames = snap->frame;
+            stats->ticks = snap->tick;
+            stats->seek_tick = snap->tick;
+        }
+    }
+    if (moved && !restored)
+        codec_reader_seek(&r->in, REPLAY_HEADER_SIZE); // Aucun instantané lisible : depuis le début
+
+    GameCommand cmd;
+    int updates;
+    while (stats->ticks < target && !stats->quit && reader_next(r, &cmd, &updates))
+    {
+        uint64_t before = stats->ticks;
+        replay_frame(r, model, cmd, updates, stats);
+        stats->seek_ticks += stats->ticks - before;
+    }
+}
+
+/**
+ * @brief Lecture dans une Vue, au rythme de TARGET_FPS frames affichées par seconde
+ * (ou de la fréquence de simulation, si elle est plus haute).
+ *
+ * Chaque frame affichée avance de `speed` frames enregistrées ; en vitesse
+ * maximale, on simule jusqu'à épuiser le pas de temps. Seul le dernier état
+ * est dessiné.
+ */
+static void play_in_view(ReplayReader *r, GameModel *model, const ReplayOptions *opt, ReplayStats *stats)
+{
+    const int hz = stats->hz > TARGET_FPS ? stats->hz : TARGET_FPS; // Cadence d'affichage par défaut de la session
+    const double dt = 1.0 / hz;
+    const ViewInterface *view = opt->view;
+    bool playing = true;
+    FramePacer pacer;
+    utils_pacer_init(&pacer, hz, view->has_vsync && view->has_vsync());
+
+    // Sons à partir d'ici seulement : l'avance rapide jusqu'à l'instant de départ reste muette
+    if (view->audio_events)
+        model_set_audio_sink(model, view->audio_events());
+
+    while (playing)
+    {
+        double frame_start = utils_get_time();
+
+        GameCommand cmd;
+        int updates;
+        for (int k = 0; opt->speed == REPLAY_SPEED_MAX || k < opt->speed; k++)
+        {
+            if (!reader_next(r, &cmd, &updates) || !replay_frame(r, model, cmd, updates, stats))
+            {
+                playing = false;
+                break;
+            }
+            if (opt->speed == REPLAY_SPEED_MAX && utils_get_time() - frame_start >= dt)
+                break;
+        }
+
+        view->render(model);
+
+        // La Vue peut écrire dans le buffer de saisie : le rejeu ne doit pas en dépendre
+        char typed[MAX_FILENAME_LEN];
+        memcpy(typed, model->ui.input_buffer, sizeof(typed));
+        CommandQueue input;
+        command_queue_clear(&input);
+        view->get_input(model, &input);
+        memcpy(model->ui.input_buffer, typed, sizeof(typed));
+        GameCommand key;
+        while (command_queue_pop(&input, HUGE_VAL, &key))
+        {
+            if (key == CMD_EXIT || key == CMD_PAUSE)
+            {
+                stats->interrupted = playing;
+                playing = false;
+            }
+        }
+        utils_pacer_wait(&pacer);
+    }
+
+    // Laisse voir l'état final un instant
+    if (!stats->interrupted)
+    {
+        view->render(model);
+        utils_sleep_ms(1500);
+    }
+}
+
+/**
+ * @brief Donne au modèle la physique et la graine de l'enregistrement, et restaure l'instantané de tête d'un vidage.
+ * @return false si le vidage n'a pas d'instantané de départ lisible.
+ */
+static bool reader_prepare(ReplayReader *r, GameModel *model)
+{
+    model->sim.fixed_point = r->fixed_point; // La physique de l'enregistrement, pas celle de la ligne de commande
+    model->sim.shield_bitmap = r->shield_bitmap;
+    model->sim.swept_bullets = r->swept_bullets;
+    model->sim.fire_scheduled = r->fire_scheduled; // Les sessions sans ce drapeau tiraient à chaque tick
+    model->sim.exact_timers = r->exact_timers;     // ...et comptaient leurs timers en flottants
+    model->sim.formation_path = r->formation_path; // ...et déplaçaient la vague pas à pas
+    model->sim.level_retry = r->level_retry;       // ...sans « réessayer » au Game Over
+    model->sim.endless = r->endless;
+    if (model->sim.coop != r->coop)
+        model_set_coop(model, r->coop); // Les vaisseaux de l'enregistrement, pas ceux de `--local-coop`
+    model_set_tick_rate(model, r->hz);
+    model_rng_seed(model, r->seed);
+
+    // Vidage de l'enregistreur de vol : l'état de départ est l'instantané de tête
+    return !r->partial || (r->snapshot_count > 0 && r->snapshots[0].tick == 0 && reader_restore(r, model, &r->snapshots[0]));
+}
+
+/**
+ * @brief Rejoue un enregistrement sur un modèle fraîchement initialisé.
+ */
+bool replay_play(GameModel *model, const char *path, const ReplayOptions *opt, ReplayStats *stats)
+{
+    static const ReplayOptions headless = {NULL, REPLAY_SPEED_MAX, 0.0, NULL};
+    if (!opt)
+        opt = &headless;
+    memset(stats, 0, sizeof(ReplayStats));
+
+    ReplayReader r;
+    if (!reader_open(&r, path))
+        return false;
+    stats->seed = r.seed;
+    stats->hz = r.hz;
+    stats->hashed = r.hashes;
+    r.trace = opt->hash_trace;
+    stats->snapshots = r.snapshot_count;
+    stats->partial = r.partial;
+    if (!reader_prepare(&r, model))
+    {
+        reader_close(&r);
+        return false;
+    }
+
+    double start = utils_get_time();
+
+    if (opt->start_s > 0)
+        seek_to(&r, model, (uint64_t)(opt->start_s * r.hz), stats);
+
+    if (!stats->quit)
+    {
+        if (opt->view)
+        {
+            play_in_view(&r, model, opt, stats);
+        }
+        else
+        {
+            GameCommand cmd;
+            int updates;
+            while (reader_next(&r, &cmd, &updates) && replay_frame(&r, model, cmd, updates, stats))
+                ;
+        }
+    }
+
+    // Session quittée en cours de plage : le reste du flux est lu sans simuler, jusqu'au résultat
+    if (!stats->interrupted)
+    {
+        GameCommand cmd;
+        int updates;
+        while (reader_next(&r, &cmd, &updates))
+            ;
+    }
+
+    fill_final_state(stats, model, start);
+    stats->hash_checks = r.hash_checks;
+    stats->hash_mismatches = r.hash_mismatches;
+    stats->desync_tick = r.desync_tick;
+    stats->claimed = r.claimed;
+    stats->claimed_ticks = r.claimed_ticks;
+    stats->claimed_score = r.claimed_score;
+    stats->claimed_level = r.claimed_level;
+    bool ok = !r.error;
+    reader_close(&r);
+    return ok;
+}
+
+/**
+ * @brief Lecture pas à pas : un lecteur et le bilan de son rejeu.
+ */
+struct ReplayCursor
+{
+    ReplayReader reader; ///< Position dans le flux.
+    ReplayStats stats;   ///< Frames et ticks rejoués.
+};
+
+/**
+ * @brief Lecteur alloué, modèle préparé comme par replay_play.
+ */
+ReplayCursor *replay_cursor_open(GameModel *model, const char *path)
+{
+    ReplayCursor *cur = calloc(1, sizeof(ReplayCursor));
+    if (!cur)
+        return NULL;
+    if (!reader_open(&cur->reader, path))
+    {
+        free(cur);
+        return NULL;
+    }
+    cur->stats.hz = cur->reader.hz;
+    if (!reader_prepare(&cur->reader, model))
+    {
+        replay_cursor_close(cur);
+        return NULL;
+    }
+    return cur;
+}
+
+/**
+ * @brief Une frame enregistrée : sa commande puis ses ticks.
+ */
+bool replay_cursor_step(ReplayCursor *cur, GameModel *model, int *ticks)
+{
+    GameCommand cmd;
+    int updates;
+    uint64_t before = cur->stats.ticks;
+    bool more = !cur->stats.quit && reader_next(&cur->reader, &cmd, &updates) &&
+                replay_frame(&cur->reader, model, cmd, updates, &cur->stats);
+    *ticks = (int)(cur->stats.ticks - before);
+    return more;
+}
+
+/**
+ * @brief Fréquence de simulation lue dans l'en-tête.
+ */
+int replay_cursor_hz(const ReplayCursor *cur)
+{
+    return cur->reader.hz;
+}
+
+/**
+ * @brief Ferme le fichier et libère le lecteur.
+ */
+void replay_cursor_close(ReplayCursor *cur)
+{
+    if (!cur)
+        return;
+    reader_close(&cur->reader);
+    free(cur);
+}
+
+/**
+ * @brief Rejoue un enregistrement en entier, sans Vue, à pleine vitesse.
+ */
+bool replay_run(GameModel *model, const char *path, ReplayStats *stats)
+{
+    return replay_play(model, path, NULL, stats);
+}
+
+/**
+ * @brief Rejoue un enregistrement en entier et juge le résultat qu'il annonce.
+ *
+ * Une désynchronisation l'emporte sur un résultat faux : elle situe la fraude
+ * (ou le non-déterminisme) au tick près.
+ */
+ReplayVerdict replay_verify(GameModel *model, const char *path, ReplayStats *stats)
+{
+    if (!replay_run(model, path, stats))
+        return REPLAY_UNREADABLE;
+    if (!stats->hashed || !stats->claimed || stats->partial)
+        return REPLAY_UNVERIFIABLE;
+    if (stats->hash_mismatches > 0)
+        return REPLAY_DESYNC;
+    if (stats->claimed_ticks != stats->ticks || stats->claimed_score != stats->score ||
+        stats->claimed_level != stats->level)
+        return REPLAY_WRONG_RESULT;
+    return REPLAY_VALID;
+}
+
+/**
+ * @brief Libellé court d'un verdict.
+ */
+const char *replay_verdict_label(ReplayVerdict verdict)
+{
+    switch (verdict)
+    {
+    case REPLAY_VALID:
+        return "valide";
+    case REPLAY_UNREADABLE:
+        return "illisible";
+    case REPLAY_UNVERIFIABLE:
+        return "invérifiable";
+    case REPLAY_DESYNC:
+        return "désynchronisé";
+    case REPLAY_WRONG_RESULT:
+        return "résultat faux";
+    }
+    return "?";
+}
+
+/**
+ * @brief Affiche le résultat d'un rejeu sur la sortie standard.
+ */
+void replay_print_stats(const ReplayStats *stats)
+{
+    printf("[REPLAY] Graine        : 0x%llx\n", (unsigned long long)stats->seed);
+    printf("[REPLAY] Instantanes   : %u\n", stats->snapshots);
+    printf("[REPLAY] Physique      : %s\n", stats->fixed_point ? "virgule fixe Q16.16" : "flottants");
+    if (stats->hz != TARGET_FPS)
+        printf("[REPLAY] Simulation    : %d ticks/s\n", stats->hz);
+    if (stats->shield_bitmap)
+        printf("[REPLAY] Boucliers     : bitmap (erosion)\n");
+    if (stats->swept_bullets)
+        printf("[REPLAY] Collisions    : balayees\n");
+    if (stats->endless)
+        printf("[REPLAY] Vague         : sans fin\n");
+    if (stats->coop)
+        printf("[REPLAY] Joueurs       : 2 (cooperation)\n");
+    if (stats->partial)
+        printf("[REPLAY] Depart        : instantane (enregistreur de vol)\n");
+    if (stats->seek_tick || stats->seek_ticks)
+        printf("[REPLAY] Reprise       : instantane au tick %llu, puis %llu ticks simules\n",
+               (unsigned long long)stats->seek_tick, (unsigned long long)stats->seek_ticks);
+    printf("[REPLAY] Frames        : %llu\n", (unsigned long long)stats->frames);
+    printf("[REPLAY] Ticks simules : %llu (%.1f s de jeu)\n",
+           (unsigned long long)stats->ticks, (double)stats->ticks / (stats->hz ? stats->hz : TARGET_FPS));
+    printf("[REPLAY] Temps reel    : %.3f s\n", stats->elapsed_s);
+    printf("[REPLAY] Score final   : %d (niveau %d, %d vies)\n", stats->score, stats->level, stats->lives);
+    printf("[REPLAY] Etat final    : %d%s%s\n", (int)stats->state, stats->quit ? " (session quittee)" : "",
+           stats->interrupted ? " (lecture interrompue)" : "");
+    if (stats->partial)
+        printf("[REPLAY] RNG final     : 0x%016llx\n", (unsigned long long)stats->rng_state);
+    printf("[REPLAY] Empreinte     : 0x%08x\n", (unsigned)stats->fingerprint);
+    if (stats->hashed && stats->hash_mismatches == 0)
+        printf("[REPLAY] Verification  : %u empreintes d'etat identiques\n", stats->hash_checks);
+    else if (stats->hashed)
+        printf("[REPLAY] Verification  : %u/%u empreintes d'etat differentes, premiere divergence entre les ticks %llu et %llu\n",
+               stats->hash_mismatches, stats->hash_checks,
+               (unsigned long long)((stats->desync_tick - 1) / REPLAY_HASH_TICKS * REPLAY_HASH_TICKS + 1),
+               (unsigned long long)stats->desync_tick);
+    if (stats->claimed)
+        printf("[REPLAY] Annonce       : score %d (niveau %d, %llu ticks)%s\n", stats->claimed_score,
+               stats->claimed_level, (unsigned long long)stats->claimed_ticks,
+               stats->claimed_score == stats->score && stats->claimed_level == stats->level &&
+                       stats->claimed_ticks == stats->ticks
+                   ? ""
+                   : " : different du rejeu");
+}
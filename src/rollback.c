@@ -0,0 +1,160 @@
+/**
+ * @file rollback.c
+ * @brief Implémentation de la prédiction et du retour en arrière.
+ */
+
+#include "rollback.h"
+
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Simule le tick courant avec les entrées connues ou prédites.
+ *
+ * L'état de départ est gardé d'abord : c'est lui qu'un retour en arrière restaure.
+ */
+static void step(Rollback *rb)
+{
+    uint32_t t = rb->tick;
+    model_copy_sim(rb->states[t % ROLLBACK_STATES], rb->model);
+
+    uint8_t b0 = rollback_input(rb, 0, t);
+    uint8_t b1 = rollback_input(rb, 1, t);
+    rb->used[0][t % ROLLBACK_INPUT_RING] = b0;
+    rb->used[1][t % ROLLBACK_INPUT_RING] = b1;
+
+    // Touches maintenues seulement en partie : les menus ne sont pas partagés
+    if (rb->model->sim.state == STATE_PLAYING)
+    {
+        model_handle_input(rb->model, command_held(b0));
+        model_handle_input(rb->model, command_held_p2(b1));
+    }
+    model_update(rb->model, rb->dt);
+    rb->tick++;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Prépare une session sur un modèle et alloue l'historique.
+ */
+bool rollback_init(Rollback *rb, GameModel *model, double dt)
+{
+    memset(rb, 0, sizeof(*rb));
+    rb->model = model;
+    rb->dt = dt;
+    rb->rewind = ROLLBACK_NONE;
+    for (int i = 0; i < ROLLBACK_STATES; i++)
+    {
+        rb->states[i] = model_clone(model);
+        if (!rb->states[i])
+        {
+            rollback_free(rb);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Libère l'historique.
+ */
+void rollback_free(Rollback *rb)
+{
+    for (int i = 0; i < ROLLBACK_STATES; i++)
+    {
+        model_free(rb->states[i]);
+        rb->states[i] = NULL;
+    }
+}
+
+/**
+ * @brief Ajoute l'entrée d'un joueur pour un tick.
+ */
+bool rollback_add_input(Rollback *rb, int player, uint32_t tick, uint8_t bits)
+{
+    if (player < 0 || player > 1 || tick != rb->known[player])
+        return false;
+    // Trop loin devant : le tampon écraserait des entrées encore utiles
+    if (tick >= rb->tick + ROLLBACK_INPUT_RING - ROLLBACK_MAX_FRAMES)
+        return false;
+
+    bits &= INPUT_MASK;
+    rb->input[player][tick % ROLLBACK_INPUT_RING] = bits;
+    rb->known[player]++;
+    if (tick < rb->tick && rb->used[player][tick % ROLLBACK_INPUT_RING] != bits && tick < rb->rewind)
+        rb->rewind = tick;
+    return true;
+}
+
+/**
+ * @brief Touches d'un joueur pour un tick : reçues, sinon prédites.
+ */
+uint8_t rollback_input(const Rollback *rb, int player, uint32_t tick)
+{
+    uint32_t known = rb->known[player];
+    if (tick < known)
+        return rb->input[player][tick % ROLLBACK_INPUT_RING];
+    return known ? rb->input[player][(known - 1) % ROLLBACK_INPUT_RING] : 0;
+}
+
+/**
+ * @brief Corrige les erreurs de prédiction, puis simule un tick.
+ */
+bool rollback_advance(Rollback *rb)
+{
+    if (rb->rewind != ROLLBACK_NONE)
+    {
+        uint32_t end = rb->tick;
+        int depth = (int)(end - rb->rewind);
+        SpscRing *sink = rb->model->ui.sounds.events;
+        model_set_audio_sink(rb->model, NULL);
+
+        model_copy_sim(rb->model, rb->states[rb->rewind % ROLLBACK_STATES]);
+        rb->tick = rb->rewind;
+        rb->rewind = ROLLBACK_NONE;
+        while (rb->tick < end)
+            step(rb);
+
+        model_set_audio_sink(rb->model, sink);
+        rb->rollbacks++;
+        rb->resimulated += depth;
+        if (depth > rb->max_depth)
+            rb->max_depth = depth;
+    }
+
+    if (rb->tick >= rollback_confirmed(rb) + ROLLBACK_MAX_FRAMES)
+    {
+        rb->stalls++;
+        return false;
+    }
+    step(rb);
+    return true;
+}
+
+/**
+ * @brief Premier tick dont les entrées ne sont pas toutes connues.
+ */
+uint32_t rollback_confirmed(const Rollback *rb)
+{
+    return rb->known[0] < rb->known[1] ? rb->known[0] : rb->known[1];
+}
+
+/**
+ * @brief État définitif au début de `tick`.
+ */
+const GameModel *rollback_state(const Rollback *rb, uint32_t tick)
+{
+    if (tick > rollback_confirmed(rb) || (rb->rewind != ROLLBACK_NONE && tick > rb->rewind) || tick > rb->tick)
+        return NULL;
+    if (tick == rb->tick)
+        return rb->model;
+    if (rb->tick - tick >= ROLLBACK_STATES)
+        return NULL;
+    return rb->states[tick % ROLLBACK_STATES];
+}
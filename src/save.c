@@ -0,0 +1,1202 @@
+/**
+ * @file save.c
+ * @brief Implémentation du format de sauvegarde versionné (encodage / décodage).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour mmap).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "save.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. TAGS DES BLOCS
+// ============================================================================
+
+#define TAG_GAME "GAME" ///< Stats de partie et IA de groupe.
+#define TAG_PLYR "PLYR" ///< Vaisseau du joueur.
+#define TAG_PLY2 "PLY2" ///< Second vaisseau (coopération uniquement).
+#define TAG_WAVE "WAVE" ///< Formation et aliens (types, explosions en cours).
+#define TAG_BULL "BULL" ///< Balles actives (dans l'ordre de résolution).
+#define TAG_SHLD "SHLD" ///< Boucliers.
+#define TAG_BNKR "BNKR" ///< Cellules des boucliers (mode bitmap uniquement).
+#define TAG_UFO "UFO_"  ///< OVNI.
+#define TAG_FIRE "FIRE" ///< Prochain tir ennemi (tirs planifiés uniquement).
+#define TAG_PATH "PATH" ///< Segment de trajectoire de la vague (vague en segments uniquement).
+#define TAG_BONU "BONU" ///< Bonus qui tombent et effets en cours (vagues `drops` uniquement).
+#define TAG_ENDL "ENDL" ///< Rangées en cours d'entrée (vague sans fin uniquement).
+#define TAG_BOSS "BOSS" ///< Vaisseau amiral (vagues `boss`, tant qu'il est en jeu).
+#define TAG_PARM "PARM" ///< Paramètres d'équilibrage (s'ils diffèrent des valeurs par défaut).
+#define TAG_RNG "RNG_"  ///< Générateur aléatoire.
+#define TAG_SESS "SESS" ///< État de session (instantanés de rejeu uniquement).
+#define TAG_LVLS "LVLS" ///< Départs de niveau mémorisés (instantanés de rejeu uniquement).
+
+// ============================================================================
+//                          2. ÉCRITURE (BYTE WRITER)
+// ============================================================================
+
+/**
+ * @brief Curseur d'écriture borné : un dépassement est mémorisé, jamais commis.
+ */
+typedef struct
+{
+    uint8_t *buf;  ///< Destination.
+    size_t cap;    ///< Capacité.
+    size_t len;    ///< Octets écrits.
+    bool overflow; ///< true si une écriture a dépassé la capacité.
+} Writer;
+
+static void put_bytes(Writer *w, const void *data, size_t n)
+{
+    if (w->overflow || w->len + n > w->cap)
+    {
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buf + w->len, data, n);
+    w->len += n;
+}
+
+static void put_u8(Writer *w, uint8_t v)
+{
+    put_bytes(w, &v, 1);
+}
+
+static void put_u16(Writer *w, uint16_t v)
+{
+    uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+    put_bytes(w, b, 2);
+}
+
+static void put_u32(Writer *w, uint32_t v)
+{
+    uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+    put_bytes(w, b, 4);
+}
+
+static void put_u64(Writer *w, uint64_t v)
+{
+    put_u32(w, (uint32_t)v);
+    put_u32(w, (uint32_t)(v >> 32));
+}
+
+static void put_i32(Writer *w, int v)
+{
+    put_u32(w, (uint32_t)v);
+}
+
+static void put_f32(Writer *w, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    put_u32(w, bits);
+}
+
+/** @brief Écrit le tag d'un bloc et réserve sa taille ; retourne la position à compléter. */
+static size_t chunk_begin(Writer *w, const char *tag)
+{
+    put_bytes(w, tag, 4);
+    size_t at = w->len;
+    put_u32(w, 0);
+    return at;
+}
+
+/** @brief Complète la taille d'un bloc ouvert par chunk_begin. */
+static void chunk_end(Writer *w, size_t at)
+{
+    if (w->overflow)
+        return;
+    uint32_t size = (uint32_t)(w->len - at - 4);
+    uint8_t b[4] = {(uint8_t)size, (uint8_t)(size >> 8), (uint8_t)(size >> 16), (uint8_t)(size >> 24)};
+    memcpy(w->buf + at, b, 4);
+}
+
+// ============================================================================
+//                          3. LECTURE (BYTE READER)
+// ============================================================================
+
+/**
+ * @brief Curseur de lecture borné : toute lecture hors limites lève `error`.
+ */
+typedef struct
+{
+    const uint8_t *buf; ///< Source.
+    size_t len;         ///< Taille.
+    size_t pos;         ///< Position courante.
+    bool error;         ///< true si une lecture a dépassé la fin.
+} Reader;
+
+static const uint8_t *get_bytes(Reader *r, size_t n)
+{
+    if (r->error || r->pos + n > r->len)
+    {
+        r->error = true;
+        return NULL;
+    }
+    const uint8_t *p = r->buf + r->pos;
+    r->pos += n;
+    return p;
+}
+
+static uint8_t get_u8(Reader *r)
+{
+    const uint8_t *p = get_bytes(r, 1);
+    return p ? p[0] : 0;
+}
+
+static uint16_t get_u16(Reader *r)
+{
+    const uint8_t *p = get_bytes(r, 2);
+    return p ? (uint16_t)(p[0] | (p[1] << 8)) : 0;
+}
+
+static uint32_t get_u32(Reader *r)
+{
+    const uint8_t *p = get_bytes(r, 4);
+    return p ? (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24) : 0;
+}
+
+static uint64_t get_u64(Reader *r)
+{
+    uint64_t lo = get_u32(r);
+    uint64_t hi = get_u32(r);
+    return lo | (hi << 32);
+}
+
+static int get_i32(Reader *r)
+{
+    return (int)get_u32(r);
+}
+
+static float get_f32(Reader *r)
+{
+    uint32_t bits = get_u32(r);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// ============================================================================
+//                          4. CRC32
+// ============================================================================
+
+/**
+ * @brief CRC32 (polynôme IEEE 802.3 réfléchi), table calculée au premier appel.
+ */
+uint32_t save_crc32(const uint8_t *data, size_t len)
+{
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// ============================================================================
+//                          5. ENCODAGE
+// ============================================================================
+
+/**
+ * @brief Encode l'état de jeu, et optionnellement l'état de session.
+ *
+ * @param session true pour ajouter le bloc SESS (machine à états, timers).
+ * @param starts true pour ajouter le bloc LVLS (départs de niveau mémorisés, s'il y en a).
+ */
+static size_t encode_state(const GameModel *model, uint8_t *buf, size_t cap, bool session, bool starts)
+{
+    Writer w = {buf, cap, 0, false};
+    size_t at;
+
+    // En-tête (taille et CRC complétés à la fin)
+    put_bytes(&w, SAVE_MAGIC, 4);
+    put_u16(&w, SAVE_VERSION);
+    put_u16(&w, 0);
+    put_u32(&w, 0);
+    put_u32(&w, 0);
+
+    // --- Stats et IA de groupe ---
+    at = chunk_begin(&w, TAG_GAME);
+    put_i32(&w, model->sim.score);
+    put_i32(&w, model->sim.lives);
+    put_i32(&w, model->sim.level);
+    put_i32(&w, model->sim.normal_max_lives);
+    put_f32(&w, model->sim.enemy_speed_mult);
+    put_i32(&w, model->sim.direction_enemies);
+    put_i32(&w, model->sim.drop_direction);
+    put_i32(&w, model->sim.drop_step_count);
+    put_i32(&w, model->sim.animation_frame);
+    put_f32(&w, model_elapsed_seconds(model, model->sim.animation_timer));
+    chunk_end(&w, at);
+
+    // --- Joueur ---
+    at = chunk_begin(&w, TAG_PLYR);
+    put_f32(&w, model->sim.player.x);
+    put_f32(&w, model->sim.player.y);
+    put_f32(&w, model->sim.player.dx);
+    put_f32(&w, model_countdown_seconds(model, model->sim.player.shoot_timer));
+    put_u8(&w, model->sim.player.active);
+    chunk_end(&w, at);
+
+    // --- Second joueur (coopération) : son absence ramène le modèle en solo ---
+    if (model->sim.coop)
+    {
+        at = chunk_begin(&w, TAG_PLY2);
+        put_f32(&w, model->sim.player2.x);
+        put_f32(&w, model->sim.player2.dx);
+        put_f32(&w, model_countdown_seconds(model, model->sim.player2.shoot_timer));
+        put_u8(&w, model->sim.player2.active);
+        chunk_end(&w, at);
+    }
+
+    // --- Vague : formation, types, puis aliens en cours d'explosion ---
+    const Formation *f = &model->sim.formation;
+    at = chunk_begin(&w, TAG_WAVE);
+    put_f32(&w, f->origin_x);
+    put_f32(&w, f->origin_y);
+    put_u64(&w, f->alive_mask);
+    put_u64(&w, f->dying_mask);
+    put_u8(&w, FORMATION_SIZE);
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        put_u8(&w, (uint8_t)model->sim.enemies.type[i]);
+    for (int i = 0; i < FORMATION_SIZE; i++)
+    {
+        if (!(f->dying_mask & (1ULL << i)))
+            continue;
+        put_f32(&w, model->sim.enemies.x[i]);
+        put_f32(&w, model->sim.enemies.y[i]);
+        put_f32(&w, model_countdown_seconds(model, model_get_enemy_explode_timer(model, i)));
+    }
+    chunk_end(&w, at);
+
+    // --- Balles actives, dans l'ordre de la liste (ordre de résolution) ---
+    const BulletPool *p = &model->sim.bullets;
+    at = chunk_begin(&w, TAG_BULL);
+    put_u16(&w, (uint16_t)p->live.count);
+    for (int k = 0; k < p->live.count; k++)
+    {
+        int i = p->live.items[k];
+        put_f32(&w, p->x[i]);
+        put_f32(&w, p->y[i]);
+        put_f32(&w, p->dy[i]);
+        put_u8(&w, (uint8_t)p->type[i]);
+        put_f32(&w, model_elapsed_seconds(model, p->anim_timer[i]));
+        put_u8(&w, (uint8_t)p->anim_frame[i]);
+    }
+    chunk_end(&w, at);
+
+    // --- Boucliers ---
+    at = chunk_begin(&w, TAG_SHLD);
+    put_u8(&w, MAX_SHIELDS);
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        const Shield *sh = &model->sim.shields[s];
+        put_f32(&w, sh->x);
+        put_f32(&w, sh->y);
+        put_f32(&w, sh->width);
+        put_f32(&w, sh->height);
+        put_i32(&w, sh->health);
+        put_u8(&w, sh->active);
+    }
+    chunk_end(&w, at);
+
+    // --- Cellules des boucliers (bitmap) : leur absence ramène les boucliers en boîtes ---
+    if (model->sim.shield_bitmap)
+    {
+        at = chunk_begin(&w, TAG_BNKR);
+        put_u8(&w, MAX_SHIELDS);
+        put_u8(&w, SHIELD_BITMAP_ROWS);
+        for (int s = 0; s < MAX_SHIELDS; s++)
+            for (int row = 0; row < SHIELD_BITMAP_ROWS; row++)
+                put_u32(&w, model->sim.shields[s].bits[row]);
+        chunk_end(&w, at);
+    }
+
+    // --- OVNI ---
+    const Ufo *u = &model->sim.ufo;
+    at = chunk_begin(&w, TAG_UFO);
+    put_f32(&w, u->x);
+    put_f32(&w, u->y);
+    put_f32(&w, u->dx);
+    put_f32(&w, model_countdown_seconds(model, u->explode_timer));
+    put_u8(&w, (uint8_t)(u->active | (u->hasSpawnedThisLevel << 1) | (u->exploding << 2)));
+    chunk_end(&w, at);
+
+    // --- Tirs ennemis planifiés : leur absence ramène le tirage à chaque tick ---
+    if (model->sim.fire_scheduled)
+    {
+        at = chunk_begin(&w, TAG_FIRE);
+        put_f32(&w, model->sim.fire_timer);
+        chunk_end(&w, at);
+    }
+
+    // --- Vague en segments : leur absence ramène le déplacement pas à pas ---
+    if (model->sim.formation_path)
+    {
+        const Formation *f = &model->sim.formation;
+        at = chunk_begin(&w, TAG_PATH);
+        put_f32(&w, f->path_x0);
+        put_f32(&w, f->path_rate);
+        put_i32(&w, f->path_ticks);
+        put_i32(&w, f->path_edge);
+        put_i32(&w, f->path_min_col);
+        put_i32(&w, f->path_max_col);
+        chunk_end(&w, at);
+    }
+
+    // --- Vague sans fin : son absence ramène une vague par niveau ---
+    if (model->sim.endless)
+    {
+        at = chunk_begin(&w, TAG_ENDL);
+        put_f32(&w, model->sim.formation.stream_lag);
+        put_i32(&w, model->sim.formation.stream_rows);
+        chunk_end(&w, at);
+    }
+
+    // --- Vaisseau amiral : position et pièces (cases et BVH refaits au chargement) ---
+    const Boss *boss = &model->sim.boss;
+    if (boss->active)
+    {
+        at = chunk_begin(&w, TAG_BOSS);
+        put_f32(&w, boss->x);
+        put_f32(&w, boss->y);
+        put_f32(&w, boss->dx);
+        put_u8(&w, (uint8_t)boss->parts);
+        put_u64(&w, boss->alive_mask);
+        for (int k = 0; k < boss->parts; k++)
+            put_u8(&w, (uint8_t)boss->health[k]);
+        chunk_end(&w, at);
+    }
+
+    // --- Bonus, dans l'ordre du registre : leur absence ramène un registre vide ---
+    const EcsWorld *ecs = &model->sim.ecs;
+    short ids[ECS_MAX_ENTITIES];
+    int bonus = ecs_query(ecs, ECS_BIT(ECS_POSITION) | ECS_BIT(ECS_KIND), ids);
+    if (bonus > 0 || model->sim.rapid_timer > 0 || model->sim.spread_timer > 0)
+    {
+        at = chunk_begin(&w, TAG_BONU);
+        put_f32(&w, model_countdown_seconds(model, model->sim.rapid_timer));
+        put_f32(&w, model_countdown_seconds(model, model->sim.spread_timer));
+        put_u8(&w, (uint8_t)bonus);
+        for (int k = 0; k < bonus; k++)
+        {
+            int pos = ecs_slot(ecs, ids[k], ECS_POSITION);
+            put_f32(&w, ecs->x[pos]);
+            put_f32(&w, ecs->y[pos]);
+            put_u8(&w, ecs->kind[ecs_slot(ecs, ids[k], ECS_KIND)]);
+        }
+        chunk_end(&w, at);
+    }
+
+    // --- Paramètres d'équilibrage : leur absence ramène les valeurs par défaut ---
+    const SimParams *prm = &model->sim.params;
+    if (!params_is_default(prm))
+    {
+        at = chunk_begin(&w, TAG_PARM);
+        put_f32(&w, prm->player_speed);
+        put_f32(&w, prm->bullet_speed);
+        put_f32(&w, prm->enemy_speed);
+        put_f32(&w, prm->enemy_drop);
+        put_f32(&w, prm->ufo_speed);
+        put_i32(&w, prm->ufo_odds);
+        put_i32(&w, prm->fire_percent);
+        chunk_end(&w, at);
+    }
+
+    // --- Générateur aléatoire ---
+    at = chunk_begin(&w, TAG_RNG);
+    put_u64(&w, model->sim.rng.state);
+    put_u64(&w, model->sim.rng.inc);
+    put_u64(&w, model->sim.rng.seed);
+    chunk_end(&w, at);
+
+    // --- Session (instantanés) : ce que model_load_named réinitialise ---
+    if (session)
+    {
+        at = chunk_begin(&w, TAG_SESS);
+        put_i32(&w, (int32_t)model->sim.state);
+        put_i32(&w, (int32_t)model->sim.previous_state);
+        put_i32(&w, model->ui.menu_selection);
+        put_f32(&w, model_countdown_seconds(model, model->sim.hit_timer));
+        put_f32(&w, model_elapsed_seconds(model, model->sim.game_over_timer));
+        put_f32(&w, 0.0f); // Ancien délai du message de sauvegarde, remplacé par la transition
+        // Transition en cours : écrite seulement si elle existe (absente des anciens instantanés)
+        const Timeline *t = &model->sim.transition;
+        if (timeline_active(t))
+        {
+            put_u8(&w, t->tag);
+            put_u8(&w, t->count);
+            put_u8(&w, t->step);
+            put_u16(&w, t->elapsed);
+            for (int i = 0; i < t->count; i++)
+            {
+                put_u8(&w, t->steps[i].op);
+                put_u16(&w, t->steps[i].ticks);
+            }
+        }
+        chunk_end(&w, at);
+    }
+
+    // --- Départs de niveau : du plus ancien au plus récent, cases vides omises ---
+    int kept = 0;
+    for (int k = 0; k < MODEL_LEVEL_STARTS; k++)
+        kept += model->ui.level_starts[k].len > 0;
+    if (starts && kept > 0)
+    {
+        at = chunk_begin(&w, TAG_LVLS);
+        put_u8(&w, (uint8_t)kept);
+        for (int k = 0; k < MODEL_LEVEL_STARTS; k++)
+        {
+            const LevelStart *ls = &model->ui.level_starts[(model->ui.level_start_head + k) % MODEL_LEVEL_STARTS];
+            if (ls->len == 0)
+                continue;
+            put_i32(&w, ls->level);
+            put_u16(&w, ls->len);
+            put_bytes(&w, ls->data, ls->len);
+        }
+        chunk_end(&w, at);
+    }
+
+    if (w.overflow)
+        return 0;
+
+    // Complète l'en-tête : taille de la charge utile et CRC
+    uint32_t payload = (uint32_t)(w.len - SAVE_HEADER_SIZE);
+    uint32_t crc = save_crc32(buf + SAVE_HEADER_SIZE, payload);
+    Writer hdr = {buf + 8, 8, 0, false};
+    put_u32(&hdr, payload);
+    put_u32(&hdr, crc);
+    return w.len;
+}
+
+/**
+ * @brief Encode l'état de jeu dans un buffer.
+ */
+size_t save_encode(const GameModel *model, uint8_t *buf, size_t cap)
+{
+    return encode_state(model, buf, cap, false, false);
+}
+
+/**
+ * @brief Encode un instantané complet (état de jeu + session + départs de niveau) pour le rejeu.
+ */
+size_t save_encode_snapshot(const GameModel *model, uint8_t *buf, size_t cap)
+{
+    return encode_state(model, buf, cap, true, true);
+}
+
+/**
+ * @brief Encode un départ de niveau : l'instantané, sans les départs déjà mémorisés.
+ */
+size_t save_encode_level_start(const GameModel *model, uint8_t *buf, size_t cap)
+{
+    return encode_state(model, buf, cap, true, false);
+}
+
+/**
+ * @brief Empreinte d'un modèle : CRC32 de son instantané, départs de niveau exclus.
+ */
+uint32_t save_fingerprint(const GameModel *model)
+{
+    uint8_t *buf = malloc(SAVE_MAX_SIZE);
+    if (!buf)
+        return 0;
+    size_t len = encode_state(model, buf, SAVE_MAX_SIZE, true, false);
+    uint32_t crc = len ? save_crc32(buf, len) : 0;
+    free(buf);
+    return crc;
+}
+
+// ============================================================================
+//                          6. DÉCODAGE
+// ============================================================================
+
+/**
+ * @brief Valide l'en-tête (signature, version, taille, CRC) et place le curseur
+ * au début des blocs.
+ */
+static bool read_header(Reader *r)
+{
+    const uint8_t *magic = get_bytes(r, 4);
+    uint16_t version = get_u16(r);
+    get_u16(r); // Réservé
+    uint32_t payload = get_u32(r);
+    uint32_t crc = get_u32(r);
+    if (r->error || memcmp(magic, SAVE_MAGIC, 4) != 0 || version != SAVE_VERSION)
+        return false;
+    return payload == r->len - SAVE_HEADER_SIZE && save_crc32(r->buf + SAVE_HEADER_SIZE, payload) == crc;
+}
+
+/** @brief Vérifie qu'un type lu correspond à un alien. */
+static bool valid_enemy_type(uint8_t t)
+{
+    return t >= ENTITY_ENEMY_TYPE_1 && t <= ENTITY_ENEMY_TYPE_3;
+}
+
+/** @brief Vérifie qu'un type lu correspond à une balle. */
+static bool valid_bullet_type(uint8_t t)
+{
+    return t == ENTITY_BULLET_PLAYER || t == ENTITY_BULLET_ENEMY;
+}
+
+/**
+ * @brief Décode (ou valide seulement) un bloc.
+ *
+ * Avec `m == NULL`, le bloc est lu et vérifié sans rien écrire : save_decode
+ * fait une première passe de validation, puis décode directement dans le
+ * modèle vivant, sans copie intermédiaire.
+ *
+ * @param bullets Capacité du pool de balles de destination (les deux passes la vérifient).
+ * @return false si le contenu du bloc est invalide.
+ */
+static bool decode_chunk(GameModel *m, const char *tag, Reader *r, int bullets)
+{
+    if (memcmp(tag, TAG_GAME, 4) == 0)
+    {
+        int score = get_i32(r);
+        int lives = get_i32(r);
+        int level = get_i32(r);
+        int normal_max_lives = get_i32(r);
+        float speed_mult = get_f32(r);
+        int direction = get_i32(r);
+        int drop_direction = get_i32(r);
+        int drop_step_count = get_i32(r);
+        int animation_frame = get_i32(r) & 1;
+        float animation_timer = get_f32(r);
+        if (level < 1 || (direction != 1 && direction != -1))
+            return false;
+        if (m)
+        {
+            m->sim.score = score;
+            m->sim.lives = lives;
+            m->sim.level = level;
+            m->sim.normal_max_lives = normal_max_lives;
+            m->sim.enemy_speed_mult = speed_mult;
+            m->sim.direction_enemies = direction;
+            m->sim.drop_direction = drop_direction;
+            m->sim.drop_step_count = drop_step_count;
+            m->sim.animation_frame = animation_frame;
+            m->sim.animation_timer = model_elapsed_ticks(m, animation_timer);
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_PLYR, 4) == 0)
+    {
+        float x = get_f32(r);
+        float y = get_f32(r);
+        float dx = get_f32(r);
+        float shoot_timer = get_f32(r);
+        bool active = get_u8(r) != 0;
+        if (m)
+        {
+            m->sim.player.x = x;
+            m->sim.player.y = y;
+            m->sim.player.dx = dx;
+            m->sim.player.shoot_timer = model_countdown_ticks(m, shoot_timer);
+            m->sim.player.active = active;
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_PLY2, 4) == 0)
+    {
+        float x = get_f32(r);
+        float dx = get_f32(r);
+        float shoot_timer = get_f32(r);
+        bool active = get_u8(r) != 0;
+        if (m)
+        {
+            m->sim.coop = true;
+            m->sim.player2.x = x;
+            m->sim.player2.dx = dx;
+            m->sim.player2.shoot_timer = model_countdown_ticks(m, shoot_timer);
+            m->sim.player2.active = active;
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_WAVE, 4) == 0)
+    {
+        float origin_x = get_f32(r);
+        float origin_y = get_f32(r);
+        uint64_t alive = get_u64(r);
+        uint64_t dying = get_u64(r);
+        uint64_t valid = (FORMATION_SIZE >= 64) ? ~0ULL : (1ULL << FORMATION_SIZE) - 1;
+        if (get_u8(r) != FORMATION_SIZE || (alive & ~valid) || (dying & ~valid) || (alive & dying))
+            return false;
+
+        if (m)
+        {
+            model_clear_enemies(m);
+            m->sim.formation.origin_x = origin_x;
+            m->sim.formation.origin_y = origin_y;
+            m->sim.formation.alive_mask = alive;
+            m->sim.formation.dying_mask = dying;
+        }
+        for (int i = 0; i < FORMATION_SIZE; i++)
+        {
+            uint8_t t = get_u8(r);
+            if (((alive | dying) >> i & 1) && !valid_enemy_type(t)) // Case vide (vague scriptée) : type indifférent
+                return false;
+            if (m)
+                m->sim.enemies.type[i] = (EntityType)t;
+        }
+        for (int i = 0; i < FORMATION_SIZE; i++)
+        {
+            if (!(dying & (1ULL << i)))
+                continue;
+            float x = get_f32(r);
+            float y = get_f32(r);
+            float timer = get_f32(r);
+            if (m)
+            {
+                m->sim.enemies.x[i] = x;
+                m->sim.enemies.y[i] = y;
+                model_add_enemy_explosion(m, i, model_countdown_ticks(m, timer));
+            }
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_BULL, 4) == 0)
+    {
+        BulletPool *p = m ? &m->sim.bullets : NULL;
+        int n = get_u16(r);
+        if (n > bullets)
+            return false;
+        if (p)
+            model_clear_bullets(m);
+        // Les slots sont réattribués dans l'ordre, chacun dans le bloc de son camp :
+        // la liste active garde l'ordre d'origine (un camp plein perd ses balles en trop)
+        for (int k = 0; k < n; k++)
+        {
+            float x = get_f32(r);
+            float y = get_f32(r);
+            float dy = get_f32(r);
+            uint8_t t = get_u8(r);
+            float anim_timer = get_f32(r);
+            int anim_frame = get_u8(r) & 3;
+            if (!valid_bullet_type(t))
+                return false;
+            int i = p ? model_restore_bullet(m, -1, (EntityType)t) : -1;
+            if (i >= 0)
+            {
+                p->x[i] = x;
+                p->y[i] = y;
+                p->dy[i] = dy;
+                p->type[i] = (EntityType)t;
+                p->anim_timer[i] = model_elapsed_ticks(m, anim_timer);
+                p->anim_frame[i] = anim_frame;
+            }
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_SHLD, 4) == 0)
+    {
+        if (get_u8(r) != MAX_SHIELDS)
+            return false;
+        for (int s = 0; s < MAX_SHIELDS; s++)
+        {
+            Shield sh;
+            sh.x = get_f32(r);
+            sh.y = get_f32(r);
+            sh.width = get_f32(r);
+            sh.height = get_f32(r);
+            sh.health = get_i32(r);
+            sh.active = get_u8(r) != 0;
+            if (sh.health < 0 || sh.health > SHIELD_MAX_HEALTH)
+                return false;
+            if (m) // Les cellules viennent du bloc BNKR
+            {
+                memcpy(sh.bits, m->sim.shields[s].bits, sizeof(sh.bits));
+                m->sim.shields[s] = sh;
+            }
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_BNKR, 4) == 0)
+    {
+        if (get_u8(r) != MAX_SHIELDS || get_u8(r) != SHIELD_BITMAP_ROWS)
+            return false;
+        for (int s = 0; s < MAX_SHIELDS; s++)
+        {
+            for (int row = 0; row < SHIELD_BITMAP_ROWS; row++)
+            {
+                uint32_t bits = get_u32(r);
+                if (m)
+                    m->sim.shields[s].bits[row] = bits;
+            }
+        }
+        if (m)
+            m->sim.shield_bitmap = true;
+        return true;
+    }
+    if (memcmp(tag, TAG_UFO, 4) == 0)
+    {
+        Ufo u;
+        u.x = get_f32(r);
+        u.y = get_f32(r);
+        u.dx = get_f32(r);
+        float explode_timer = get_f32(r);
+        uint8_t flags = get_u8(r);
+        u.active = flags & 1;
+        u.hasSpawnedThisLevel = (flags >> 1) & 1;
+        u.exploding = (flags >> 2) & 1;
+        u.width = UFO_WIDTH;
+        u.height = UFO_HEIGHT;
+        u.type = ENTITY_UFO;
+        if (m)
+        {
+            u.explode_timer = model_countdown_ticks(m, explode_timer);
+            m->sim.ufo = u;
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_FIRE, 4) == 0)
+    {
+        float timer = get_f32(r);
+        if (m)
+        {
+            m->sim.fire_scheduled = true;
+            m->sim.fire_timer = timer;
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_PATH, 4) == 0)
+    {
+        float x0 = get_f32(r);
+        float rate = get_f32(r);
+        int ticks = get_i32(r);
+        int edge = get_i32(r);
+        int min_col = get_i32(r);
+        int max_col = get_i32(r);
+        if (m)
+        {
+            Formation *f = &m->sim.formation;
+            m->sim.formation_path = true;
+            f->path_x0 = x0;
+            f->path_rate = rate;
+            f->path_ticks = ticks;
+            f->path_edge = edge;
+            f->path_min_col = min_col;
+            f->path_max_col = max_col;
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_ENDL, 4) == 0)
+    {
+        float lag = get_f32(r);
+        int rows = get_i32(r);
+        if (!(lag >= 0.0f && lag <= FORMATION_ROWS * GAME_HEIGHT) || rows < 0 || rows >= ENDLESS_ROWS_PER_LEVEL)
+            return false;
+        if (m)
+        {
+            m->sim.endless = true;
+            m->sim.formation.stream_lag = lag;
+            m->sim.formation.stream_rows = rows;
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_BOSS, 4) == 0)
+    {
+        Boss b;
+        memset(&b, 0, sizeof(Boss));
+        b.x = get_f32(r);
+        b.y = get_f32(r);
+        b.dx = get_f32(r);
+        b.parts = get_u8(r);
+        b.alive_mask = get_u64(r);
+        if (b.parts < 1 || b.parts > BOSS_MAX_PARTS || !b.alive_mask || (b.alive_mask >> (b.parts - 1)) > 1)
+            return false;
+        for (int k = 0; k < b.parts; k++)
+        {
+            b.health[k] = (int8_t)get_u8(r);
+            if ((b.alive_mask >> k & 1) && (b.health[k] < 1 || b.health[k] > BOSS_BRIDGE_HEALTH))
+                return false;
+        }
+        b.active = true;
+        if (m)
+            m->sim.boss = b; // Cases et BVH : model_rebuild_indexes
+        return true;
+    }
+    if (memcmp(tag, TAG_BONU, 4) == 0)
+    {
+        float rapid = get_f32(r);
+        float spread = get_f32(r);
+        int count = get_u8(r);
+        if (count > ECS_MAX_ENTITIES)
+            return false;
+        if (m)
+        {
+            m->sim.rapid_timer = model_countdown_ticks(m, rapid);
+            m->sim.spread_timer = model_countdown_ticks(m, spread);
+        }
+        for (int k = 0; k < count; k++)
+        {
+            float x = get_f32(r);
+            float y = get_f32(r);
+            int kind = get_u8(r);
+            if (kind < ENTITY_POWERUP_RAPID || kind > ENTITY_POWERUP_REPAIR)
+                return false;
+            if (m)
+                model_add_powerup(m, x, y, (EntityType)kind);
+        }
+        return true;
+    }
+    if (memcmp(tag, TAG_PARM, 4) == 0)
+    {
+        SimParams p;
+        params_default(&p);
+        p.player_speed = get_f32(r);
+        p.bullet_speed = get_f32(r);
+        p.enemy_speed = get_f32(r);
+        p.enemy_drop = get_f32(r);
+        p.ufo_speed = get_f32(r);
+        p.ufo_odds = get_i32(r);
+        p.fire_percent = get_i32(r);
+        if (!params_valid(&p))
+            return false;
+        if (m)
+            m->sim.params = p;
+        return true;
+    }
+    if (memcmp(tag, TAG_RNG, 4) == 0)
+    {
+        ModelRng rng;
+        rng.state = get_u64(r);
+        rng.inc = get_u64(r) | 1u;
+        rng.seed = get_u64(r);
+        if (m)
+            m->sim.rng = rng;
+        return true;
+    }
+    return true; // Bloc inconnu : ignoré (écrit par une version plus récente)
+}
+
+/**
+ * @brief Décode (ou valide seulement) le bloc SESS d'un instantané.
+ * @return false si l'état de session est invalide.
+ */
+static bool decode_session(GameModel *m, Reader *r)
+{
+    int state = get_i32(r);
+    int previous_state = get_i32(r);
+    int menu_selection = get_i32(r);
+    float hit_timer = get_f32(r);
+    float game_over_timer = get_f32(r);
+    (void)get_f32(r); // Ancien délai du message de sauvegarde
+    Timeline t = {0};
+    if (r->pos < r->len)
+    {
+        t.tag = get_u8(r);
+        t.count = get_u8(r);
+        t.step = get_u8(r);
+        t.elapsed = get_u16(r);
+        if (t.count > TIMELINE_MAX_STEPS || t.step > t.count)
+            return false;
+        for (int i = 0; i < t.count; i++)
+        {
+            t.steps[i].op = get_u8(r);
+            t.steps[i].ticks = get_u16(r);
+        }
+    }
+    if (state < STATE_MENU || state > STATE_SAVE_SUCCESS ||
+        previous_state < STATE_MENU || previous_state > STATE_SAVE_SUCCESS)
+        return false;
+    if (m)
+    {
+        m->sim.state = (GameStateEnum)state;
+        m->sim.previous_state = (GameStateEnum)previous_state;
+        m->ui.menu_selection = menu_selection;
+        m->sim.hit_timer = model_countdown_ticks(m, hit_timer);
+        m->sim.game_over_timer = model_elapsed_ticks(m, game_over_timer);
+        m->sim.transition = t;
+    }
+    return true;
+}
+
+/**
+ * @brief Lit le bloc LVLS : l'anneau des départs de niveau, remplacé en entier.
+ *
+ * Les départs eux-mêmes ne sont validés qu'au moment de les restaurer.
+ */
+static bool decode_level_starts(GameModel *m, Reader *r)
+{
+    int count = get_u8(r);
+    if (count > MODEL_LEVEL_STARTS)
+        return false;
+    if (m)
+        memset(m->ui.level_starts, 0, sizeof(m->ui.level_starts));
+    for (int k = 0; k < count; k++)
+    {
+        int level = get_i32(r);
+        uint16_t len = get_u16(r);
+        const uint8_t *data = get_bytes(r, len);
+        if (r->error || len == 0 || len > MODEL_LEVEL_START_BYTES)
+            return false;
+        if (m)
+        {
+            LevelStart *ls = &m->ui.level_starts[k];
+            ls->level = level;
+            ls->len = len;
+            memcpy(ls->data, data, len);
+        }
+    }
+    if (m)
+        m->ui.level_start_head = count % MODEL_LEVEL_STARTS;
+    return true;
+}
+
+/**
+ * @brief Parcourt tous les blocs de la charge utile.
+ *
+ * @param m Modèle de destination, ou NULL pour une simple validation.
+ * @param bullets Capacité du pool de balles de destination.
+ * @param session true pour un instantané : le bloc SESS est alors lu et obligatoire
+ *        (une sauvegarde l'ignore comme un bloc inconnu).
+ * @return true si tous les blocs sont valides et que les blocs obligatoires sont présents.
+ */
+static bool decode_chunks(GameModel *m, const uint8_t *buf, size_t len, int bullets, bool session)
+{
+    static const char *const tags[] = {TAG_GAME, TAG_PLYR, TAG_WAVE, TAG_BULL, TAG_SHLD, TAG_UFO, TAG_RNG};
+    const unsigned count = sizeof(tags) / sizeof(tags[0]);
+    unsigned seen = 0; // Un bit par bloc obligatoire rencontré
+    bool has_session = false;
+
+    // Solo sauf bloc PLY2, boucliers en boîtes sauf bloc BNKR, tirage par tick sauf bloc FIRE,
+    // vague pas à pas sauf bloc PATH, une vague par niveau sauf bloc ENDL, ni vaisseau amiral sauf bloc BOSS,
+    // ni bonus ni effet sauf bloc BONU, paramètres par défaut sauf bloc PARM
+    // (la passe de validation a déjà tout vérifié)
+    if (m)
+    {
+        m->sim.coop = false;
+        m->sim.player2.active = false;
+        m->sim.shield_bitmap = false;
+        m->sim.fire_scheduled = false;
+        m->sim.formation_path = false;
+        m->sim.endless = false;
+        m->sim.formation.stream_lag = 0;
+        m->sim.formation.stream_rows = 0;
+        memset(&m->sim.boss, 0, sizeof(Boss));
+        ecs_clear(&m->sim.ecs);
+        m->sim.rapid_timer = 0;
+        m->sim.spread_timer = 0;
+        params_default(&m->sim.params);
+    }
+
+    Reader r = {buf, len, SAVE_HEADER_SIZE, false};
+    while (r.pos < r.len)
+    {
+        const uint8_t *tag = get_bytes(&r, 4);
+        uint32_t size = get_u32(&r);
+        const uint8_t *body = get_bytes(&r, size);
+        if (r.error)
+            return false;
+
+        Reader chunk = {body, size, 0, false};
+        if (memcmp(tag, TAG_SESS, 4) == 0)
+        {
+            if (session && (!decode_session(m, &chunk) || chunk.error))
+                return false;
+            has_session = true;
+            continue;
+        }
+        if (memcmp(tag, TAG_LVLS, 4) == 0)
+        {
+            if (session && (!decode_level_starts(m, &chunk) || chunk.error))
+                return false;
+            continue;
+        }
+        if (!decode_chunk(m, (const char *)tag, &chunk, bullets) || chunk.error)
+            return false;
+
+        for (unsigned t = 0; t < count; t++)
+            if (memcmp(tag, tags[t], 4) == 0)
+                seen |= 1u << t;
+    }
+    return seen == (1u << count) - 1 && (has_session || !session);
+}
+
+/**
+ * @brief Décode une sauvegarde et restaure l'état de jeu dans le modèle.
+ *
+ * Deux passes sur les mêmes octets, sans allocation : validation complète
+ * (m == NULL), puis décodage direct dans le modèle. Le modèle n'est donc
+ * modifié que si la sauvegarde est entièrement valide.
+ */
+bool save_decode(GameModel *model, const uint8_t *buf, size_t len)
+{
+    Reader r = {buf, len, 0, false};
+    if (!read_header(&r) || !decode_chunks(NULL, buf, len, model->sim.bullets.capacity, false))
+        return false;
+
+    decode_chunks(model, buf, len, model->sim.bullets.capacity, false);
+    model_rebuild_indexes(model);
+    return true;
+}
+
+/**
+ * @brief Restaure un instantané de rejeu (état de jeu + session).
+ */
+bool save_decode_snapshot(GameModel *model, const uint8_t *buf, size_t len)
+{
+    Reader r = {buf, len, 0, false};
+    if (!read_header(&r) || !decode_chunks(NULL, buf, len, model->sim.bullets.capacity, true))
+        return false;
+
+    decode_chunks(model, buf, len, model->sim.bullets.capacity, true);
+    model_rebuild_indexes(model);
+    return true;
+}
+
+/**
+ * @brief Valide une sauvegarde et en extrait niveau et score, sans toucher à un modèle.
+ */
+bool save_read_summary(const uint8_t *buf, size_t len, int *level, int *score)
+{
+    Reader r = {buf, len, 0, false};
+    if (!read_header(&r))
+        return false;
+
+    while (r.pos < r.len)
+    {
+        const uint8_t *tag = get_bytes(&r, 4);
+        uint32_t size = get_u32(&r);
+        const uint8_t *body = get_bytes(&r, size);
+        if (r.error)
+            return false;
+        if (memcmp(tag, TAG_GAME, 4) != 0)
+            continue;
+
+        // Même ordre que decode_chunk : score, vies, niveau
+        Reader chunk = {body, size, 0, false};
+        int s = get_i32(&chunk);
+        get_i32(&chunk);
+        int l = get_i32(&chunk);
+        if (chunk.error)
+            return false;
+        if (level)
+            *level = l;
+        if (score)
+            *score = s;
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+//                          7. PROJECTION MÉMOIRE (MMAP)
+// ============================================================================
+
+/**
+ * @brief Projette un fichier de sauvegarde en mémoire (lecture seule).
+ */
+bool save_map_file(const char *path, SaveMapping *out)
+{
+    out->data = NULL;
+    out->len = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && st.st_size >= SAVE_HEADER_SIZE && st.st_size <= SAVE_MAX_SIZE;
+    if (ok)
+    {
+        void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ok = p != MAP_FAILED;
+        if (ok)
+        {
+            out->data = p;
+            out->len = (size_t)st.st_size;
+        }
+    }
+    close(fd); // La projection reste valide après fermeture du descripteur
+    return ok;
+}
+
+/**
+ * @brief Libère une projection obtenue par save_map_file.
+ */
+void save_unmap_file(SaveMapping *map)
+{
+    if (map->data)
+        munmap((void *)map->data, map->len);
+    map->data = NULL;
+    map->len = 0;
+}
+
+// ============================================================================
+//                          8. DELTAS (JOURNAL D'AUTOSAVE)
+// ============================================================================
+
+/**
+ * @brief Encode la progression depuis le dernier point de reprise.
+ */
+size_t save_encode_delta(const GameModel *model, uint8_t *buf, size_t cap)
+{
+    Writer w = {buf, cap, 0, false};
+    put_i32(&w, model->sim.level);
+    put_i32(&w, model->sim.score);
+    put_i32(&w, model->sim.lives);
+    put_u64(&w, model->sim.formation.alive_mask);
+    put_u8(&w, MAX_SHIELDS);
+    for (int s = 0; s < MAX_SHIELDS; s++)
+        put_i32(&w, model->sim.shields[s].health);
+    return w.overflow ? 0 : w.len;
+}
+
+/**
+ * @brief Applique un delta au modèle restauré depuis un point de reprise.
+ */
+bool save_apply_delta(GameModel *model, const uint8_t *buf, size_t len)
+{
+    Reader r = {buf, len, 0, false};
+    int level = get_i32(&r);
+    int score = get_i32(&r);
+    int lives = get_i32(&r);
+    uint64_t alive = get_u64(&r);
+    int health[MAX_SHIELDS];
+    bool ok = get_u8(&r) == MAX_SHIELDS;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        health[s] = get_i32(&r);
+        ok = ok && health[s] >= 0 && health[s] <= SHIELD_MAX_HEALTH;
+    }
+
+    // Un delta ne fait que retirer des aliens à la vague du point de reprise
+    if (!ok || r.error || level != model->sim.level || (alive & ~model->sim.formation.alive_mask))
+        return false;
+
+    model->sim.score = score;
+    model->sim.lives = lives;
+    model->sim.formation.alive_mask = alive;
+    model->sim.formation.dying_mask &= ~alive;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+    {
+        model->sim.shields[s].health = health[s];
+        model->sim.shields[s].active = health[s] > 0;
+        if (health[s] == 0) // Bitmap : les cellules restent celles du point de reprise, sauf bunker détruit
+            memset(model->sim.shields[s].bits, 0, sizeof(model->sim.shields[s].bits));
+    }
+    model_rebuild_indexes(model);
+    return true;
+}
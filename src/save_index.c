@@ -0,0 +1,481 @@
+/**
+ * @file save_index.c
+ * @brief Implémentation de l'index des sauvegardes (lecture, mise à jour, reconstruction).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour dirent et pthread).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "save_index.h"
+#include "batchio.h"
+#include "save.h"
+
+#include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define INDEX_HEADER "# space-invaders save index v1" ///< Première ligne du fichier.
+
+/**
+ * @brief Vrai si `a` doit apparaître avant `b` (plus récent d'abord, puis par nom).
+ */
+static bool entry_before(const SaveIndexEntry *a, const SaveIndexEntry *b)
+{
+    if (a->timestamp != b->timestamp)
+        return a->timestamp > b->timestamp;
+    return strcmp(a->name, b->name) < 0;
+}
+
+/**
+ * @brief Insère une entrée à sa place dans un tableau trié borné.
+ * Si le tableau est plein, l'entrée la plus ancienne est abandonnée.
+ */
+static void insert_sorted(SaveIndexEntry *out, int *count, int cap, const SaveIndexEntry *e)
+{
+    int i = *count;
+    if (i == cap)
+    {
+        if (cap == 0 || !entry_before(e, &out[cap - 1]))
+            return;
+        i--;
+    }
+    else
+        (*count)++;
+
+    while (i > 0 && entry_before(e, &out[i - 1]))
+    {
+        out[i] = out[i - 1];
+        i--;
+    }
+    out[i] = *e;
+}
+
+/**
+ * @brief Ajoute une entrée à un tableau dynamique (capacité doublée si besoin).
+ * @return false si la mémoire manque.
+ */
+static bool push_entry(SaveIndexEntry **all, int *count, int *cap, const SaveIndexEntry *e)
+{
+    if (*count == *cap)
+    {
+        int new_cap = *cap ? 2 * *cap : 64;
+        SaveIndexEntry *grown = realloc(*all, new_cap * sizeof(SaveIndexEntry));
+        if (!grown)
+            return false;
+        *all = grown;
+        *cap = new_cap;
+    }
+    (*all)[(*count)++] = *e;
+    return true;
+}
+
+/**
+ * @brief Vrai si le nom se termine exactement par ".dat" (et pas "x.dat.bak").
+ */
+static bool has_dat_suffix(const char *name)
+{
+    size_t n = strlen(name);
+    return n > 4 && strcmp(name + n - 4, ".dat") == 0;
+}
+
+/**
+ * @brief Lit une ligne d'index.
+ * @return false si la ligne est mal formée (ignorée).
+ */
+static bool parse_line(const char *line, SaveIndexEntry *e)
+{
+    long long ts;
+    unsigned size;
+    if (sscanf(line, "%lld\t%d\t%d\t%u\t%63[^\n]", &ts, &e->level, &e->score, &size, e->name) != 5)
+        return false;
+    e->timestamp = ts;
+    e->size = size;
+    return has_dat_suffix(e->name);
+}
+
+/**
+ * @brief Réécrit l'index complet (fichier temporaire puis rename).
+ */
+static bool write_index(const char *dir, const SaveIndexEntry *entries, int count)
+{
+    char path[256], tmp[260];
+    snprintf(path, sizeof(path), "%s/%s", dir, SAVE_INDEX_FILE);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    FILE *f = fopen(tmp, "w");
+    if (!f)
+        return false;
+
+    bool ok = fprintf(f, "%s\n", INDEX_HEADER) > 0;
+    for (int i = 0; ok && i < count; i++)
+        ok = fprintf(f, "%lld\t%d\t%d\t%u\t%s\n", (long long)entries[i].timestamp, entries[i].level,
+                     entries[i].score, (unsigned)entries[i].size, entries[i].name) > 0;
+    ok = (fclose(f) == 0) && ok;
+
+    if (ok && rename(tmp, path) == 0)
+        return true;
+    remove(tmp);
+    return false;
+}
+
+/**
+ * @brief Ordre de qsort équivalent à entry_before.
+ */
+static int entry_compare(const void *a, const void *b)
+{
+    if (entry_before(a, b))
+        return -1;
+    return entry_before(b, a) ? 1 : 0;
+}
+
+/**
+ * @brief Charge les sauvegardes valides du dossier : noms par readdir, puis métadonnées et contenus en un lot.
+ *
+ * Tous les statx et lectures partent ensemble (cf. batchio.h) au lieu d'un
+ * stat puis d'une lecture par fichier. Les fichiers d'un ancien format,
+ * corrompus, vides ou trop gros ne sont pas gardés. Le tableau est trié du
+ * plus récent au plus ancien.
+ *
+ * @param all Reçoit le tableau (à libérer par l'appelant, NULL si vide).
+ * @return Le nombre d'entrées, ou -1 si le dossier est illisible.
+ */
+static int load_dat_files(const char *dir, SaveIndexEntry **all)
+{
+    *all = NULL;
+    DIR *d = opendir(dir);
+    if (!d)
+        return -1;
+
+    int count = 0, cap = 0;
+    struct dirent *ent;
+    while ((ent = readdir(d)) != NULL)
+    {
+        size_t name_len = strlen(ent->d_name);
+        if (ent->d_name[0] == '.' || !has_dat_suffix(ent->d_name) || name_len >= SAVE_NAME_LEN)
+            continue;
+        SaveIndexEntry e;
+        memcpy(e.name, ent->d_name, name_len + 1);
+        e.timestamp = 0;
+        e.level = e.score = -1;
+        e.size = 0;
+        if (!push_entry(all, &count, &cap, &e))
+            break;
+    }
+    closedir(d);
+    if (count == 0)
+        return 0;
+
+    // Chemins et lot : un seul aller-retour pour tout le dossier
+    char (*paths)[320] = malloc((size_t)count * sizeof(*paths));
+    BatchIoItem *items = malloc((size_t)count * sizeof(BatchIoItem));
+    if (!paths || !items)
+    {
+        free(paths);
+        free(items);
+        free(*all);
+        *all = NULL;
+        return -1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        snprintf(paths[i], sizeof(paths[i]), "%s/%s", dir, (*all)[i].name);
+        items[i].path = paths[i];
+        items[i].max_size = SAVE_MAX_SIZE;
+    }
+    batchio_load(items, count);
+
+    int valid = 0;
+    for (int i = 0; i < count; i++)
+    {
+        SaveIndexEntry *e = &(*all)[i];
+        if (!items[i].data || !save_read_summary(items[i].data, (size_t)items[i].size, &e->level, &e->score))
+            continue; // Ancien format ou fichier corrompu : non listé
+        e->timestamp = items[i].mtime;
+        e->size = (uint32_t)items[i].size;
+        (*all)[valid++] = *e;
+    }
+    batchio_release(items, count);
+    free(items);
+    free(paths);
+    if (valid > 1)
+        qsort(*all, (size_t)valid, sizeof(SaveIndexEntry), entry_compare);
+    return valid;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lit l'index, trié de la sauvegarde la plus récente à la plus ancienne.
+ */
+int save_index_read(const char *dir, SaveIndexEntry *out, int cap)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, SAVE_INDEX_FILE);
+
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return -1;
+
+    int count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        SaveIndexEntry e;
+        if (line[0] != '#' && parse_line(line, &e))
+            insert_sorted(out, &count, cap, &e);
+    }
+    fclose(f);
+    return count;
+}
+
+/**
+ * @brief Ajoute ou remplace (même nom) une entrée, puis réécrit l'index atomiquement.
+ */
+bool save_index_update(const char *dir, const SaveIndexEntry *entry)
+{
+    // Lecture complète (pas de plafond) : l'index ne perd jamais d'entrée
+    SaveIndexEntry *all = NULL;
+    int count = 0, cap = 0;
+    bool ok = true;
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, SAVE_INDEX_FILE);
+    FILE *f = fopen(path, "r");
+    if (f)
+    {
+        char line[256];
+        while (ok && fgets(line, sizeof(line), f))
+        {
+            SaveIndexEntry e;
+            if (line[0] != '#' && parse_line(line, &e) && strcmp(e.name, entry->name) != 0)
+                ok = push_entry(&all, &count, &cap, &e);
+        }
+        fclose(f);
+    }
+
+    ok = ok && push_entry(&all, &count, &cap, entry) && write_index(dir, all, count);
+    free(all);
+    return ok;
+}
+
+/**
+ * @brief Reconstruit l'index en parcourant le dossier (fichiers "*.dat" valides).
+ */
+int save_index_rebuild(const char *dir, SaveIndexEntry *out, int cap)
+{
+    SaveIndexEntry *all = NULL;
+    int valid = load_dat_files(dir, &all);
+    if (valid < 0)
+        return -1;
+
+    // L'index garde tout ; l'appelant ne reçoit que les plus récentes
+    write_index(dir, all, valid);
+    int kept = (valid < cap) ? valid : cap;
+    if (kept > 0)
+        memcpy(out, all, (size_t)kept * sizeof(SaveIndexEntry));
+    free(all);
+    return kept;
+}
+
+/**
+ * @brief Un seul parcours des noms du dossier : le plus grand suffixe "(N)" de la racine, plus un.
+ */
+bool save_index_copy_name(const char *dir, const char *base, char *out, size_t size)
+{
+    DIR *d = opendir(dir);
+    int highest = 0;
+    if (d)
+    {
+        size_t base_len = strlen(base);
+        struct dirent *ent;
+        while ((ent = readdir(d)) != NULL)
+        {
+            const char *name = ent->d_name;
+            if (strncmp(name, base, base_len) != 0 || name[base_len] != '(')
+                continue;
+            char *end;
+            long n = strtol(name + base_len + 1, &end, 10);
+            if (end != name + base_len + 1 && strcmp(end, ").dat") == 0 && n > highest && n < INT_MAX)
+                highest = (int)n;
+        }
+        closedir(d);
+    }
+    return snprintf(out, size, "%s(%d).dat", base, highest + 1) < (int)size;
+}
+
+/**
+ * @brief Formate une entrée pour les menus.
+ */
+void save_index_describe(const SaveIndexEntry *entry, char *buf, size_t size)
+{
+    char date[32] = "";
+    time_t t = (time_t)entry->timestamp;
+    struct tm *tm = localtime(&t);
+    if (tm)
+        strftime(date, sizeof(date), "%d/%m %H:%M", tm);
+    snprintf(buf, size, "%s  NIV %d  %d PTS  %s", entry->name, entry->level, entry->score, date);
+}
+
+/**
+ * @brief Remplace l'extension ".dat" du nom par SAVE_THUMBNAIL_EXT.
+ */
+void save_index_thumbnail(const char *dir, const char *name, char *buf, size_t size)
+{
+    int len = (int)strlen(name);
+    if (len > 4 && strcmp(name + len - 4, ".dat") == 0)
+        len -= 4;
+    snprintf(buf, size, "%s/%.*s%s", dir, len, name, SAVE_THUMBNAIL_EXT);
+}
+
+// ============================================================================
+//                          3. RECHERCHE EN FOND
+// ============================================================================
+
+static pthread_mutex_t scan_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t scan_thread;
+static bool scan_started = false;      ///< Thread lancé, à joindre.
+static bool scan_cancel = false;       ///< Abandon demandé (nouvelle recherche).
+static char scan_dir[128];             ///< Dossier parcouru (fixé avant le lancement du thread).
+static int scan_cap = 0;               ///< Entrées publiées au plus.
+static SaveIndexEntry *scan_list = NULL; ///< Dernier état publié.
+static int scan_count = 0;             ///< Entrées de scan_list.
+static bool scan_done = false;         ///< Liste définitive.
+static unsigned scan_version = 0;      ///< Incrémenté à chaque publication.
+static unsigned scan_seen = 0;         ///< Dernière version relevée par save_index_scan_poll.
+
+/**
+ * @brief Publie la liste (au plus scan_cap entrées).
+ */
+static void scan_publish(const SaveIndexEntry *list, int count, bool done)
+{
+    pthread_mutex_lock(&scan_lock);
+    int n = (count < scan_cap) ? count : scan_cap;
+    if (n < 0)
+        n = 0; // Dossier illisible : liste vide
+    if (n > 0)
+        memcpy(scan_list, list, (size_t)n * sizeof(SaveIndexEntry));
+    scan_count = n;
+    scan_done = done;
+    scan_version++;
+    pthread_mutex_unlock(&scan_lock);
+}
+
+/**
+ * @brief Vrai si une nouvelle recherche a remplacé celle-ci.
+ */
+static bool scan_cancelled(void)
+{
+    pthread_mutex_lock(&scan_lock);
+    bool c = scan_cancel;
+    pthread_mutex_unlock(&scan_lock);
+    return c;
+}
+
+/**
+ * @brief Thread de recherche : l'index s'il existe, sinon le dossier en un lot (load_dat_files).
+ *
+ * L'index reconstruit est réécrit avant la publication, sauf si une
+ * nouvelle recherche a remplacé celle-ci entre-temps.
+ */
+static void *scan_main(void *arg)
+{
+    (void)arg;
+    SaveIndexEntry *list = malloc((size_t)scan_cap * sizeof(SaveIndexEntry));
+    int n = list ? save_index_read(scan_dir, list, scan_cap) : -1;
+    if (n >= 0)
+    {
+        scan_publish(list, n, true);
+        free(list);
+        return NULL;
+    }
+    free(list);
+
+    SaveIndexEntry *all = NULL;
+    int count = load_dat_files(scan_dir, &all);
+    if (!scan_cancelled())
+    {
+        if (count > 0)
+            write_index(scan_dir, all, count);
+        scan_publish(all, count, true);
+    }
+    free(all);
+    return NULL;
+}
+
+/**
+ * @brief Abandonne la recherche en cours et attend la fin de son thread.
+ */
+static void scan_stop(void)
+{
+    if (!scan_started)
+        return;
+    pthread_mutex_lock(&scan_lock);
+    scan_cancel = true;
+    pthread_mutex_unlock(&scan_lock);
+    pthread_join(scan_thread, NULL);
+    scan_started = false;
+}
+
+/**
+ * @brief Lance la recherche sur un thread (dans l'appel même si le thread ne démarre pas).
+ */
+bool save_index_scan_start(const char *dir, int cap)
+{
+    scan_stop();
+    SaveIndexEntry *list = (cap > 0) ? malloc((size_t)cap * sizeof(SaveIndexEntry)) : NULL;
+    if (!list)
+        return false;
+
+    pthread_mutex_lock(&scan_lock);
+    free(scan_list);
+    scan_list = list;
+    scan_cap = cap;
+    snprintf(scan_dir, sizeof(scan_dir), "%s", dir);
+    scan_count = 0;
+    scan_done = scan_cancel = false;
+    scan_version = scan_seen = 0;
+    pthread_mutex_unlock(&scan_lock);
+
+    if (pthread_create(&scan_thread, NULL, scan_main, NULL) == 0)
+        scan_started = true;
+    else
+        scan_main(NULL);
+    return true;
+}
+
+/**
+ * @brief Copie le dernier état publié s'il est nouveau ; joint le thread une fois la liste définitive.
+ */
+int save_index_scan_poll(SaveIndexEntry *out, int cap, bool *done)
+{
+    pthread_mutex_lock(&scan_lock);
+    int n = -1;
+    if (scan_version != scan_seen)
+    {
+        n = (scan_count < cap) ? scan_count : cap;
+        if (n > 0)
+            memcpy(out, scan_list, (size_t)n * sizeof(SaveIndexEntry));
+        scan_seen = scan_version;
+    }
+    *done = scan_done;
+    pthread_mutex_unlock(&scan_lock);
+
+    if (*done && scan_started)
+    {
+        pthread_join(scan_thread, NULL);
+        scan_started = false;
+    }
+    return n;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file save_writer.c
+ * @brief Implémentation du thread d'écriture des sauvegardes (POSIX).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread et fsync).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "save_writer.h"
+#include "save.h"
+#include "save_index.h"
+#include "metrics.h"
+#include "utils.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. ÉTAT PARTAGÉ
+// ============================================================================
+
+/**
+ * @brief Demande d'écriture (un seul emplacement : les écritures de fond
+ * sont refusées tant qu'une autre est en cours, cf. save_writer_try_submit).
+ */
+typedef struct
+{
+    SaveWriteMode mode;          ///< Nature de l'opération.
+    char dir[64];                ///< Dossier à créer si besoin.
+    char name[SAVE_NAME_LEN];    ///< Nom du fichier dans le dossier.
+    char path[192];              ///< Chemin final.
+    uint8_t data[SAVE_MAX_SIZE]; ///< Copie de la sauvegarde encodée.
+    size_t len;                  ///< Taille des données.
+} SaveJob;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER; ///< Signale une demande, une fin d'écriture ou l'arrêt.
+static pthread_t worker;
+static bool worker_started = false;
+static bool exit_hook_set = false; ///< atexit n'est enregistré qu'une fois.
+static bool stop_requested = false;
+static bool job_pending = false; ///< true entre la demande et la fin de l'écriture.
+static SaveJob job;
+static SaveWriterStatus status = SAVE_WRITER_IDLE;
+
+// ============================================================================
+//                          2. THREAD D'ÉCRITURE
+// ============================================================================
+
+/**
+ * @brief Met à jour l'index du dossier après une écriture réussie.
+ *
+ * Si l'index ne peut pas être réécrit, il est supprimé : le prochain menu
+ * "Charger" le reconstruira plutôt que d'afficher une liste périmée.
+ */
+static void update_index(const SaveJob *j)
+{
+    SaveIndexEntry e;
+    snprintf(e.name, sizeof(e.name), "%s", j->name);
+    e.timestamp = (int64_t)time(NULL);
+    e.size = (uint32_t)j->len;
+    if (!save_read_summary(j->data, j->len, &e.level, &e.score))
+        e.level = e.score = 0;
+
+    if (!save_index_update(j->dir, &e))
+    {
+        char path[128];
+        snprintf(path, sizeof(path), "%s/%s", j->dir, SAVE_INDEX_FILE);
+        remove(path);
+    }
+}
+
+/**
+ * @brief Écrit les données dans "<chemin>.tmp", les synchronise, puis renomme le fichier.
+ * @return true si le fichier final contient les nouvelles données.
+ */
+static bool write_atomic(const SaveJob *j)
+{
+    char tmp[sizeof(j->path) + 4];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", j->path);
+
+    FILE *f = fopen(tmp, "wb");
+    if (!f)
+        return false;
+
+    bool ok = fwrite(j->data, 1, j->len, f) == j->len;
+    ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = (fclose(f) == 0) && ok;
+
+    if (!ok || rename(tmp, j->path) != 0)
+    {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Ajoute les données en fin de fichier et les synchronise.
+ */
+static bool write_append(const SaveJob *j)
+{
+    FILE *f = fopen(j->path, "ab");
+    if (!f)
+        return false;
+
+    bool ok = fwrite(j->data, 1, j->len, f) == j->len;
+    ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    return (fclose(f) == 0) && ok;
+}
+
+/**
+ * @brief Exécute une demande selon son mode.
+ */
+static bool run_job(const SaveJob *j)
+{
+    // On s'assure que le dossier existe (Linux : 0777 = permissions complètes)
+    mkdir(j->dir, 0777);
+
+    switch (j->mode)
+    {
+    case SAVE_WRITE_SAVE:
+        if (!write_atomic(j))
+            return false;
+        update_index(j);
+        return true;
+    case SAVE_WRITE_REPLACE:
+        return write_atomic(j);
+    case SAVE_WRITE_APPEND:
+        return write_append(j);
+    case SAVE_WRITE_DELETE:
+        return remove(j->path) == 0;
+    }
+    return false;
+}
+
+/**
+ * @brief Boucle du thread : attend une demande, l'écrit, publie le résultat.
+ */
+static void *writer_main(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;)
+    {
+        while (!job_pending && !stop_requested)
+            pthread_cond_wait(&cond, &lock);
+        if (!job_pending)
+            break; // Arrêt demandé et plus rien à écrire
+
+        // L'écriture se fait hors verrou : la boucle de jeu peut sonder librement
+        pthread_mutex_unlock(&lock);
+        double start = utils_get_time();
+        bool ok = run_job(&job);
+        if (job.mode == SAVE_WRITE_SAVE)
+        {
+            metrics_observe(METRIC_SAVE, utils_get_time() - start);
+            metrics_count(ok ? METRIC_SAVES : METRIC_SAVE_FAILURES, 1);
+        }
+        pthread_mutex_lock(&lock);
+
+        // Seules les sauvegardes du joueur sont rapportées à save_writer_poll
+        if (job.mode == SAVE_WRITE_SAVE)
+            status = ok ? SAVE_WRITER_DONE : SAVE_WRITER_FAILED;
+        job_pending = false;
+        pthread_cond_broadcast(&cond);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Démarre le thread si besoin (verrou tenu).
+ */
+static bool ensure_worker(void)
+{
+    if (worker_started)
+        return true;
+    if (pthread_create(&worker, NULL, writer_main, NULL) != 0)
+        return false;
+    worker_started = true;
+    stop_requested = false;
+    if (!exit_hook_set)
+        exit_hook_set = atexit(save_writer_shutdown) == 0;
+    return true;
+}
+
+/**
+ * @brief Remplit l'emplacement de demande et réveille le thread (verrou tenu, emplacement libre).
+ */
+static void post_job(SaveWriteMode mode, const char *dir, const char *filename, const uint8_t *data, size_t len)
+{
+    job.mode = mode;
+    snprintf(job.dir, sizeof(job.dir), "%s", dir);
+    snprintf(job.name, sizeof(job.name), "%s", filename);
+    snprintf(job.path, sizeof(job.path), "%s/%s", dir, filename);
+    if (len > 0)
+        memcpy(job.data, data, len);
+    job.len = len;
+    job_pending = true;
+    if (mode == SAVE_WRITE_SAVE)
+        status = SAVE_WRITER_BUSY;
+    pthread_cond_broadcast(&cond);
+}
+
+/**
+ * @brief Confie une sauvegarde au thread d'écriture (démarré au premier appel).
+ */
+bool save_writer_submit(const char *dir, const char *filename, const uint8_t *data, size_t len)
+{
+    if (len > SAVE_MAX_SIZE)
+        return false;
+
+    pthread_mutex_lock(&lock);
+    bool ok = ensure_worker();
+    if (ok)
+    {
+        while (job_pending)
+            pthread_cond_wait(&cond, &lock);
+        post_job(SAVE_WRITE_SAVE, dir, filename, data, len);
+    }
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+/**
+ * @brief Confie une écriture de fond au thread, sans jamais attendre.
+ */
+bool save_writer_try_submit(SaveWriteMode mode, const char *dir, const char *filename,
+                            const uint8_t *data, size_t len)
+{
+    if (len > SAVE_MAX_SIZE || mode == SAVE_WRITE_SAVE)
+        return false;
+
+    pthread_mutex_lock(&lock);
+    bool ok = !job_pending && ensure_worker();
+    if (ok)
+        post_job(mode, dir, filename, data, len);
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+/**
+ * @brief Relève l'état de la dernière écriture, sans bloquer.
+ */
+SaveWriterStatus save_writer_poll(char *path, size_t path_size)
+{
+    pthread_mutex_lock(&lock);
+    SaveWriterStatus s = status;
+    if (path && path_size > 0)
+        snprintf(path, path_size, "%s", job.path);
+    if (s == SAVE_WRITER_DONE || s == SAVE_WRITER_FAILED)
+        status = SAVE_WRITER_IDLE;
+    pthread_mutex_unlock(&lock);
+    return s;
+}
+
+/**
+ * @brief Attend la fin de l'écriture en cours et arrête le thread.
+ */
+void save_writer_shutdown(void)
+{
+    pthread_mutex_lock(&lock);
+    if (!worker_started)
+    {
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    stop_requested = true;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&lock);
+
+    pthread_join(worker, NULL);
+    worker_started = false;
+}
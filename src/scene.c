@@ -0,0 +1,190 @@
+/**
+ * @file scene.c
+ * @brief Implémentation de l'extraction de la scène (parcours du Modèle, aiguillage par type).
+ */
+
+#include "scene.h"
+#include "entity_type.h"
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Ajoute un élément immobile (px, py = x, y) et le renvoie pour compléter ses champs.
+ */
+static SceneItem *scene_push(SceneList *scene, SceneKind kind, EntityType type, float x, float y, float w, float h)
+{
+    SceneItem *it = &scene->items[scene->count++];
+    *it = (SceneItem){.x = x, .y = y, .px = x, .py = y, .w = w, .h = h, .tint = SCENE_TINT_NONE,
+                      .kind = (uint8_t)kind, .type = (uint8_t)type};
+    return it;
+}
+
+/**
+ * @brief Ouvre le genre `kind` : ses éléments commencent au rang courant.
+ */
+static void scene_open(SceneList *scene, SceneKind kind)
+{
+    scene->first[kind] = scene->count;
+}
+
+// ============================================================================
+//                          2. API
+// ============================================================================
+
+void scene_build(SceneList *scene, const GameModel *model, const GameModel *prev)
+{
+    const SimState *sim = &model->sim;
+    scene->count = 0;
+    scene->model = model;
+    scene->gen = model->ui.gen[MODEL_GEN_ANY];
+    scene->prev = prev;
+    scene->prev_gen = prev ? prev->ui.gen[MODEL_GEN_ANY] : 0;
+    scene->builds++;
+
+    // Interpolation seulement entre deux ticks de la même partie (pas de changement de niveau)
+    if (prev && (prev->sim.state != STATE_PLAYING || sim->state != STATE_PLAYING || prev->sim.level != sim->level))
+        prev = NULL;
+
+    // Vaisseaux (le second, teinté en bleu, n'existe qu'en coopération)
+    static const uint32_t ship_tint[2] = {SCENE_TINT_NONE, 0x73CCFF};
+    scene_open(scene, SCENE_SHIP);
+    for (int k = 0; k < 2; k++)
+    {
+        const Entity *ship = k ? &sim->player2 : &sim->player;
+        const Entity *before = prev ? (k ? &prev->sim.player2 : &prev->sim.player) : NULL;
+        if (!ship->active)
+            continue;
+        SceneItem *it = scene_push(scene, SCENE_SHIP, ENTITY_PLAYER, ship->x, ship->y, ship->width, ship->height);
+        it->tint = ship_tint[k];
+        it->index = (uint8_t)k;
+        if (before && before->active)
+            it->px = before->x;
+        if (sim->hit_timer > 0)
+        {
+            it->flags = SCENE_EXPLODING;
+            it->frame = (uint8_t)((int)(model_elapsed_seconds(model, sim->hit_timer) * 10) % 4);
+        }
+    }
+
+    // Les aliens vivants suivent l'origine de la vague ; les explosions restent figées
+    float wave_dx = 0.0f, wave_dy = 0.0f;
+    if (prev)
+    {
+        wave_dx = prev->sim.formation.origin_x - sim->formation.origin_x;
+        wave_dy = prev->sim.formation.origin_y - sim->formation.origin_y;
+    }
+    scene_open(scene, SCENE_ENEMY);
+    const short *live_enemies;
+    int n_enemies = model_get_live_enemies(model, &live_enemies);
+    for (int k = 0; k < n_enemies; k++)
+    {
+        Entity e;
+        if (!model_get_enemy(model, live_enemies[k], &e))
+            continue;
+        SceneItem *it = scene_push(scene, SCENE_ENEMY, e.type, e.x, e.y, e.width, e.height);
+        it->frame = (uint8_t)(2 * entity_types[e.type].sprite + sim->animation_frame);
+        if (e.exploding)
+            it->flags = SCENE_EXPLODING;
+        else
+        {
+            it->px += wave_dx;
+            it->py += wave_dy;
+        }
+    }
+
+    scene_open(scene, SCENE_UFO);
+    if (sim->ufo.active)
+    {
+        const Ufo *u = &sim->ufo;
+        SceneItem *it = scene_push(scene, SCENE_UFO, ENTITY_UFO, u->x, u->y, u->width, u->height);
+        it->flags = u->exploding ? SCENE_EXPLODING : 0;
+        if (prev && prev->sim.ufo.active)
+            it->px = prev->sim.ufo.x;
+    }
+
+    // Entités du registre : la teinte de leur type (entity_types), sans sprite dédié
+    scene_open(scene, SCENE_ENTITY);
+    const EcsWorld *w = &sim->ecs;
+    if (w->alive)
+    {
+        short ids[ECS_MAX_ENTITIES];
+        int n = ecs_query(w, ECS_BIT(ECS_POSITION) | ECS_BIT(ECS_KIND), ids);
+        for (int k = 0; k < n; k++)
+        {
+            int p = ecs_slot(w, ids[k], ECS_POSITION);
+            EntityType type = (EntityType)w->kind[ecs_slot(w, ids[k], ECS_KIND)];
+            const EntityTypeInfo *info = &entity_types[type];
+            SceneItem *it = scene_push(scene, SCENE_ENTITY, type, w->x[p], w->y[p], info->width, info->height);
+            it->tint = info->color;
+            int q = prev ? ecs_get(&prev->sim.ecs, ecs_entity(w, ids[k]), ECS_POSITION) : -1;
+            if (q >= 0)
+            {
+                it->px = prev->sim.ecs.x[q];
+                it->py = prev->sim.ecs.y[q];
+            }
+        }
+    }
+
+    // Pièces du vaisseau amiral : même rendu, assombries une fois entamées
+    const Boss *boss = &sim->boss;
+    if (boss->active)
+    {
+        const EntityTypeInfo *info = &entity_types[ENTITY_BOSS_PART];
+        bool follow = prev && prev->sim.boss.active;
+        for (int k = 0; k < boss->parts; k++)
+        {
+            Entity part;
+            if (!model_get_boss_part(model, k, &part))
+                continue;
+            SceneItem *it = scene_push(scene, SCENE_ENTITY, ENTITY_BOSS_PART, part.x, part.y, part.width, part.height);
+            int full = boss->row[k] == 0 ? BOSS_BRIDGE_HEALTH : BOSS_PART_HEALTH;
+            it->tint = boss->health[k] < full ? (info->color >> 1) & 0x7F7F7F : info->color;
+            if (follow)
+                it->px += prev->sim.boss.x - boss->x;
+        }
+    }
+
+    scene_open(scene, SCENE_SHIELD);
+    for (int i = 0; i < MAX_SHIELDS; i++)
+    {
+        const Shield *sh = &sim->shields[i];
+        if (!sh->active)
+            continue;
+        SceneItem *it = scene_push(scene, SCENE_SHIELD, ENTITY_PLAYER, sh->x, sh->y, sh->width, sh->height);
+        int idx = 10 - sh->health;
+        it->frame = (uint8_t)(idx < 0 ? 0 : idx > 9 ? 9 : idx);
+        it->index = (uint8_t)i;
+    }
+
+    scene_open(scene, SCENE_BULLET);
+    const short *live_bullets;
+    int n_bullets = model_get_live_bullets(model, &live_bullets);
+    for (int k = 0; k < n_bullets; k++)
+    {
+        int i = live_bullets[k];
+        Entity b;
+        if (!model_get_bullet(model, i, &b))
+            continue;
+        SceneItem *it = scene_push(scene, SCENE_BULLET, b.type, b.x, b.y, b.width, b.height);
+        it->frame = (uint8_t)(4 * entity_types[b.type].sprite + b.anim_frame);
+        if (prev && (prev->sim.bullets.active[i >> 6] >> (i & 63) & 1) && prev->sim.bullets.type[i] == b.type)
+            it->py = prev->sim.bullets.y[i];
+    }
+    scene_open(scene, SCENE_KIND_COUNT);
+}
+
+bool scene_update(SceneList *scene, const GameModel *model, const GameModel *prev)
+{
+    if (scene->model == model && scene->gen == model->ui.gen[MODEL_GEN_ANY] && scene->prev == prev &&
+        scene->prev_gen == (prev ? prev->ui.gen[MODEL_GEN_ANY] : 0))
+        return false;
+    scene_build(scene, model, prev);
+    return true;
+}
+
+void scene_invalidate(SceneList *scene)
+{
+    scene->model = NULL;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file sdf.c
+ * @brief Implémentation des champs de distance signée (propagation en deux passes, rééchantillonnage).
+ */
+
+#include "sdf.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define SDF_FAR 1e9f ///< Distance initiale d'un pixel sans point du bord connu.
+
+/**
+ * @brief Plus proche point d'un ensemble de pixels, pour chaque pixel (propagation à 8 voisins).
+ *
+ * Chaque pixel retient les coordonnées de son point le plus proche ; une
+ * passe descendante puis une passe montante suffisent à le propager à
+ * toute l'image (erreur de moins d'un pixel, sans importance à cette échelle).
+ *
+ * @param seed Image W × H : 1 si le pixel appartient à l'ensemble.
+ * @param dist Reçoit la distance de chaque pixel à l'ensemble (0 dedans).
+ * @param near Travail : 2 entiers par pixel.
+ */
+static void nearest_seed(const uint8_t *seed, int W, int H, float *dist, int16_t *near)
+{
+    for (int i = 0; i < W * H; i++)
+    {
+        dist[i] = seed[i] ? 0.0f : SDF_FAR;
+        near[2 * i] = (int16_t)(i % W);
+        near[2 * i + 1] = (int16_t)(i / W);
+    }
+    static const int fwd[4][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}};
+    static const int bwd[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const int(*dirs)[2] = pass == 0 ? fwd : bwd;
+        for (int k = 0; k < W * H; k++)
+        {
+            int i = pass == 0 ? k : W * H - 1 - k;
+            int x = i % W, y = i / W;
+            for (int d = 0; d < 4; d++)
+            {
+                int nx = x + dirs[d][0], ny = y + dirs[d][1];
+                if (nx < 0 || ny < 0 || nx >= W || ny >= H)
+                    continue;
+                int n = ny * W + nx;
+                if (dist[n] >= SDF_FAR)
+                    continue;
+                float dx = (float)(x - near[2 * n]), dy = (float)(y - near[2 * n + 1]);
+                float dd = sqrtf(dx * dx + dy * dy);
+                if (dd < dist[i])
+                {
+                    dist[i] = dd;
+                    near[2 * i] = near[2 * n];
+                    near[2 * i + 1] = near[2 * n + 1];
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Distances aux pixels intérieurs et extérieurs, puis codage sur 8 bits.
+ *
+ * Un pixel partiellement couvert est traversé par le bord : sa couverture
+ * donne directement sa distance (a - 0.5). Les autres prennent la distance
+ * au plus proche pixel de l'autre côté, moins un demi-pixel.
+ */
+bool sdf_generate(const uint8_t *coverage, int w, int h, int pitch, int step, int spread,
+                  uint8_t *field, int fpitch, int fstep)
+{
+    int W = w + 2 * spread, H = h + 2 * spread;
+    size_t n = (size_t)W * (size_t)H;
+    uint8_t *cov = calloc(n, 1);
+    uint8_t *seed = calloc(n, 1); // Mis à zéro : l'optimiseur ne le voit pas rempli avant sa lecture
+    float *inside = malloc(n * sizeof(float));
+    float *outside = malloc(n * sizeof(float));
+    int16_t *near = malloc(n * 2 * sizeof(int16_t));
+    bool ok = cov && seed && inside && outside && near;
+    if (ok)
+    {
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++)
+                cov[(size_t)(y + spread) * W + (size_t)(x + spread)] = coverage[(size_t)y * pitch + (size_t)x * step];
+
+        for (size_t i = 0; i < n; i++)
+            seed[i] = cov[i] >= SDF_EDGE;
+        nearest_seed(seed, W, H, inside, near); // Distance au tracé
+        for (size_t i = 0; i < n; i++)
+            seed[i] = !seed[i];
+        nearest_seed(seed, W, H, outside, near); // Distance au fond
+
+        for (int y = 0; y < H; y++)
+            for (int x = 0; x < W; x++)
+            {
+                size_t i = (size_t)y * W + (size_t)x;
+                float a = cov[i] / 255.0f, sd;
+                if (cov[i] > 0 && cov[i] < 255)
+                    sd = a - 0.5f;
+                else if (cov[i] >= SDF_EDGE)
+                    sd = outside[i] - 0.5f;
+                else
+                    sd = 0.5f - inside[i];
+                float v = SDF_EDGE + sd * 127.0f / (float)spread;
+                field[(size_t)y * fpitch + (size_t)x * fstep] = (uint8_t)(v < 0.0f ? 0.0f : v > 255.0f ? 255.0f : v + 0.5f);
+            }
+    }
+    free(cov);
+    free(seed);
+    free(inside);
+    free(outside);
+    free(near);
+    return ok;
+}
+
+/**
+ * @brief Lecture bilinéaire du champ, seuil adouci sur un pixel de sortie.
+ */
+void sdf_resample(const uint8_t *field, int fw, int fh, int fpitch, int fstep, int spread, float scale,
+                  uint8_t *coverage, int w, int h, int pitch, int step)
+{
+    for (int y = 0; y < h; y++)
+    {
+        float fy = (float)spread + ((float)y + 0.5f) / scale - 0.5f;
+        if (fy < 0.0f)
+            fy = 0.0f;
+        if (fy > (float)(fh - 1))
+            fy = (float)(fh - 1);
+        int y0 = (int)fy, y1 = y0 + 1 < fh ? y0 + 1 : y0;
+        float ty = fy - (float)y0;
+        for (int x = 0; x < w; x++)
+        {
+            float fx = (float)spread + ((float)x + 0.5f) / scale - 0.5f;
+            if (fx < 0.0f)
+                fx = 0.0f;
+            if (fx > (float)(fw - 1))
+                fx = (float)(fw - 1);
+            int x0 = (int)fx, x1 = x0 + 1 < fw ? x0 + 1 : x0;
+            float tx = fx - (float)x0;
+            const uint8_t *r0 = field + (size_t)y0 * fpitch, *r1 = field + (size_t)y1 * fpitch;
+            float top = r0[(size_t)x0 * fstep] + tx * (r0[(size_t)x1 * fstep] - r0[(size_t)x0 * fstep]);
+            float bottom = r1[(size_t)x0 * fstep] + tx * (r1[(size_t)x1 * fstep] - r1[(size_t)x0 * fstep]);
+            float v = top + ty * (bottom - top);
+            float sd = (v - SDF_EDGE) * (float)spread / 127.0f; // Pixels du champ
+            float a = sd * scale + 0.5f;                        // Pixels de sortie
+            coverage[(size_t)y * pitch + (size_t)x * step] = (uint8_t)(a <= 0.0f ? 0 : a >= 1.0f ? 255 : a * 255.0f + 0.5f);
+        }
+    }
+}
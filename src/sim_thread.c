@@ -0,0 +1,323 @@
+/**
+ * @file sim_thread.c
+ * @brief Implémentation du thread de simulation et du triple buffer (POSIX).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "sim_thread.h"
+#include "affinity.h"
+#include "highscore.h"
+#include "logger.h"
+#include "metrics.h"
+#include "profiler.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define SIM_MAX_LAG 0.25 ///< Retard au-delà duquel les pas manqués sont abandonnés (s).
+
+/**
+ * @brief Libère les copies du triple buffer.
+ */
+static void free_frames(SimThread *sim)
+{
+    for (int k = 0; k < SIM_FRAME_COUNT; k++)
+    {
+        model_free(sim->frames[k].model);
+        sim->frames[k].model = NULL;
+    }
+}
+
+/**
+ * @brief Copie le modèle dans le buffer arrière et le publie.
+ */
+static void publish(SimThread *sim)
+{
+    SimFrame *back = &sim->frames[sim->back];
+    model_copy(back->model, sim->model);
+    back->text_seq = sim->text_seq;
+
+    pthread_mutex_lock(&sim->lock);
+    if (sim->fresh)
+        sim->skipped++;
+    int old = sim->pending;
+    sim->pending = sim->back;
+    sim->back = old;
+    sim->fresh = true;
+    sim->published++;
+    pthread_mutex_unlock(&sim->lock);
+}
+
+/**
+ * @brief Applique une commande au modèle (et la saisie qui l'accompagne).
+ * @return false sur un second CMD_EXIT pendant la confirmation.
+ */
+static bool apply_command(SimThread *sim, const SimCommand *c)
+{
+    if (c->text_seq)
+    {
+        memcpy(sim->model->ui.input_buffer, c->text, MAX_FILENAME_LEN);
+        sim->text_seq = c->text_seq;
+    }
+    flight_record_command(sim->flight, sim->model, c->cmd);
+    replay_record_command(sim->recorder, sim->model, c->cmd);
+    sim->last_cmd = c->cmd;
+    return model_dispatch_command(sim->model, c->cmd);
+}
+
+/**
+ * @brief Un pas de simulation : commandes reçues, puis model_update.
+ *
+ * Chaque commande est enregistrée comme une frame du replay : les premières
+ * avec 0 mise à jour, la dernière avec celle de ce pas. Sans nouvelle commande,
+ * la dernière est répétée (touche maintenue) en partie, CMD_NONE ailleurs :
+ * le rejeu refait exactement les mêmes appels.
+ *
+ * @return false sur un second CMD_EXIT pendant la confirmation.
+ */
+static bool step(SimThread *sim, double dt)
+{
+    SimCommand batch[SIM_COMMAND_QUEUE];
+    pthread_mutex_lock(&sim->lock);
+    int n = sim->count;
+    for (int i = 0; i < n; i++)
+        batch[i] = sim->queue[(sim->head + i) % SIM_COMMAND_QUEUE];
+    sim->head = (sim->head + n) % SIM_COMMAND_QUEUE;
+    sim->count = 0;
+    pthread_mutex_unlock(&sim->lock);
+
+    if (n == 0)
+    {
+        batch[0].cmd = CMD_NONE;
+        batch[0].text_seq = 0;
+        if (sim->model->sim.state == STATE_PLAYING &&
+            (sim->last_cmd == CMD_MOVE_LEFT || sim->last_cmd == CMD_MOVE_RIGHT || sim->last_cmd == CMD_SHOOT ||
+             command_is_held(sim->last_cmd, NULL)))
+            batch[0].cmd = sim->last_cmd;
+        n = 1;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (!apply_command(sim, &batch[i]))
+            return false;
+    }
+
+    if (params_live_poll(&sim->model->sim.params))
+        logger_write(LOG_INFO, "[PARAMS] Nouveaux paramètres appliqués (un enregistrement en cours ne se rejouera plus)\n");
+    uint64_t t = profiler_begin();
+    flight_record_tick_begin(sim->flight);
+    model_update(sim->model, dt);
+    flight_record_tick(sim->flight);
+    replay_record_tick(sim->recorder, sim->model);
+    profiler_end(PROF_UPDATE, t);
+    autosave_update(sim->autosave, sim->model, dt);
+    suspend_update(sim->suspend, sim->model);
+    highscore_flush(&sim->model->ui.highscores, "sauvegardes");
+    sim->ticks++;
+    return true;
+}
+
+// ============================================================================
+//                          2. THREAD DE SIMULATION
+// ============================================================================
+
+/**
+ * @brief Boucle du thread : pas fixes calés sur une échéance absolue.
+ *
+ * Dormir "le reste de la frame" accumulerait les erreurs d'arrondi ;
+ * l'échéance, elle, avance d'exactement dt à chaque pas (utils_sleep_until_ns),
+ * en nanosecondes entières : aucune dérive, même après des jours.
+ */
+static void *sim_main(void *arg)
+{
+    SimThread *sim = arg;
+    affinity_apply(THREAD_ROLE_SIM);
+    const double dt = 1.0 / model_tick_rate(sim->model);
+    const uint64_t dt_ns = UTILS_NS_PER_S / (uint64_t)model_tick_rate(sim->model);
+    // Ralenti ou accéléré : seul l'intervalle réel entre deux pas change, jamais dt
+    const uint64_t period_ns = dt_ns * TIME_SCALE_NORMAL / sim->time_scale;
+    const uint64_t max_lag = (uint64_t)(SIM_MAX_LAG * UTILS_NS_PER_S);
+    uint64_t deadline = utils_now_ns();
+    uint64_t last_step = deadline;
+    bool force_exit = false;
+
+    publish(sim);
+    for (;;)
+    {
+        pthread_mutex_lock(&sim->lock);
+        bool stop = sim->stop;
+        pthread_mutex_unlock(&sim->lock);
+        if (stop)
+            break;
+
+        utils_sleep_until_ns(deadline);
+        uint64_t now = utils_now_ns();
+        if (now - deadline > max_lag)
+            deadline = now; // Même protection que la boucle classique ("Spiral of Death")
+        else if (now - deadline > period_ns)
+            sim->late++;
+        deadline += period_ns;
+
+        if (!step(sim, dt))
+        {
+            force_exit = true;
+            break;
+        }
+        publish(sim);
+        // Une "image" du thread : intervalle entre deux pas, travail du pas et de sa publication
+        uint64_t done = utils_now_ns();
+        flight_record_timing(sim->flight, sim->model, (double)(now - last_step) / 1e9, (double)(done - now) / 1e9);
+        last_step = now;
+        if (suspend_requested())
+            break; // Instantané déjà écrit par le gestionnaire du signal
+        if (sim->model->ui.pending_quit)
+        {
+            if (!sim->kiosk)
+                break;
+            model_restart(sim->model); // Borne : le joueur suivant part de l'accueil, dès l'état publié suivant
+            publish(sim);
+            metrics_count(METRIC_SESSIONS, 1);
+        }
+    }
+
+    pthread_mutex_lock(&sim->lock);
+    sim->finished = true;
+    sim->force_exit = force_exit;
+    pthread_mutex_unlock(&sim->lock);
+    return NULL;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Lance la simulation sur son propre thread.
+ */
+bool sim_thread_start(SimThread *sim, GameModel *model, Autosave *autosave, ReplayRecorder *recorder,
+                      FlightRecorder *flight, Suspend *suspend, bool kiosk, uint32_t time_scale)
+{
+    memset(sim, 0, sizeof(SimThread));
+    sim->time_scale = time_scale ? time_scale : TIME_SCALE_NORMAL;
+    sim->model = model;
+    sim->autosave = autosave;
+    sim->recorder = recorder;
+    sim->flight = flight;
+    sim->suspend = suspend;
+    sim->kiosk = kiosk;
+    sim->last_cmd = CMD_NONE;
+    sim->back = 0;
+    sim->pending = 1;
+    sim->front = 2;
+    // Les trois copies sont allouées une fois pour toutes (même capacité que le modèle)
+    for (int k = 0; k < SIM_FRAME_COUNT; k++)
+        sim->frames[k].model = model_clone(model);
+    memcpy(sim->sent_text, model->ui.input_buffer, MAX_FILENAME_LEN);
+
+    if (!sim->frames[0].model || !sim->frames[1].model || !sim->frames[2].model)
+    {
+        free_frames(sim);
+        return false;
+    }
+    if (pthread_mutex_init(&sim->lock, NULL) != 0)
+    {
+        free_frames(sim);
+        return false;
+    }
+    if (pthread_create(&sim->thread, NULL, sim_main, sim) != 0)
+    {
+        pthread_mutex_destroy(&sim->lock);
+        free_frames(sim);
+        return false;
+    }
+    sim->started = true;
+    return true;
+}
+
+/**
+ * @brief Renvoie le dernier état publié, à dessiner.
+ */
+GameModel *sim_thread_acquire(SimThread *sim)
+{
+    pthread_mutex_lock(&sim->lock);
+    if (sim->fresh)
+    {
+        int old = sim->front;
+        sim->front = sim->pending;
+        sim->pending = old;
+        sim->fresh = false;
+    }
+    pthread_mutex_unlock(&sim->lock);
+    return sim->frames[sim->front].model;
+}
+
+/**
+ * @brief Remet dans l'état affiché la dernière saisie envoyée mais pas encore appliquée.
+ */
+void sim_thread_prepare_input(SimThread *sim, GameModel *front)
+{
+    if (sim->frames[sim->front].text_seq != sim->sent_seq)
+        memcpy(front->ui.input_buffer, sim->sent_text, MAX_FILENAME_LEN);
+}
+
+/**
+ * @brief Transmet une commande au prochain pas de simulation.
+ */
+void sim_thread_push(SimThread *sim, GameCommand cmd, const char *text)
+{
+    SimCommand c;
+    c.cmd = cmd;
+    c.text_seq = 0;
+    if (text)
+    {
+        snprintf(c.text, sizeof(c.text), "%s", text);
+        memcpy(sim->sent_text, c.text, MAX_FILENAME_LEN);
+        c.text_seq = ++sim->sent_seq;
+    }
+
+    pthread_mutex_lock(&sim->lock);
+    if (sim->count < SIM_COMMAND_QUEUE)
+    {
+        sim->queue[(sim->head + sim->count) % SIM_COMMAND_QUEUE] = c;
+        sim->count++;
+    }
+    pthread_mutex_unlock(&sim->lock);
+}
+
+/**
+ * @brief Indique si la partie est terminée.
+ */
+bool sim_thread_finished(SimThread *sim, bool *force_exit)
+{
+    pthread_mutex_lock(&sim->lock);
+    bool finished = sim->finished;
+    if (force_exit)
+        *force_exit = sim->force_exit;
+    pthread_mutex_unlock(&sim->lock);
+    return finished;
+}
+
+/**
+ * @brief Arrête le thread et rend le modèle au thread appelant.
+ */
+void sim_thread_stop(SimThread *sim)
+{
+    if (!sim->started)
+        return;
+    pthread_mutex_lock(&sim->lock);
+    sim->stop = true;
+    pthread_mutex_unlock(&sim->lock);
+    pthread_join(sim->thread, NULL);
+    pthread_mutex_destroy(&sim->lock);
+    free_frames(sim);
+    sim->started = false;
+}
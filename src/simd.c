@@ -0,0 +1,567 @@
+/**
+ * @file simd.c
+ * @brief Implémentation des noyaux vectorisés et de leur sélection à l'exécution.
+ *
+ * Les versions AVX2 sont compilées avec l'attribut `target("avx2")` : aucun flag
+ * de compilation global n'est nécessaire, et elles ne sont appelées que si le CPU
+ * les supporte. SSE2 fait partie de la base x86-64 ; NEON de la base AArch64.
+ */
+
+#include "simd.h"
+#include "common.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#define SIMD_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ============================================================================
+//                          1. TABLE DES BACKENDS
+// ============================================================================
+
+/** @brief Signature du noyau d'intégration des balles. */
+typedef void (*BulletStepFn)(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                             int n, float dt, uint64_t *cull);
+
+/** @brief Signature du noyau de test AABB "une boîte contre N". */
+typedef void (*AabbHitsFn)(float bx, float by, float bw, float bh,
+                           const float *xs, const float *ys, float w, float h,
+                           int n, uint64_t *hits);
+
+/** @brief Signature du noyau d'intégration des particules. */
+typedef void (*ParticleStepFn)(float *x, float *y, const float *vx, float *vy,
+                               float *life, const float *inv_life, float *alpha,
+                               int n, float dt, float gravity, uint64_t *dead);
+
+/**
+ * @brief Un jeu complet de noyaux pour un jeu d'instructions.
+ */
+typedef struct
+{
+    const char *name;             ///< Nom court (sélection par variable d'environnement).
+    BulletStepFn bullet_step;     ///< Intégration + animation + masque de sortie.
+    AabbHitsFn aabb_hits;         ///< Test AABB d'une boîte contre N boîtes de même taille.
+    ParticleStepFn particle_step; ///< Intégration + fondu + masque de mort des particules.
+} SimdBackend;
+
+// ============================================================================
+//                          2. VERSION SCALAIRE (RÉFÉRENCE)
+// ============================================================================
+
+/**
+ * @brief Traite les slots [from, n) un par un.
+ * Sert de référence, de repli, et de fin de boucle pour les versions vectorielles.
+ */
+static void bullet_step_tail(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                             int from, int n, float dt, uint64_t *cull)
+{
+    for (int i = from; i < n; i++)
+    {
+        y[i] += dy[i] * dt;
+
+        int t = anim_timer[i] + 1;
+        int wrap = t >= anim_ticks;
+        anim_timer[i] = wrap ? 0 : t;
+        anim_frame[i] = (anim_frame[i] + wrap) & 3;
+
+        if (y[i] < BULLET_CULL_TOP || y[i] > GAME_HEIGHT)
+            cull[i >> 6] |= 1ULL << (i & 63);
+    }
+}
+
+static void bullet_step_scalar(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                               int n, float dt, uint64_t *cull)
+{
+    bullet_step_tail(y, dy, anim_timer, anim_frame, anim_ticks, 0, n, dt, cull);
+}
+
+/**
+ * @brief Test AABB scalaire sur les boîtes [from, n).
+ * Même forme d'expression que les anciens tests AABB de model_update (balle à gauche).
+ */
+static void aabb_hits_tail(float bx, float by, float bw, float bh,
+                           const float *xs, const float *ys, float w, float h,
+                           int from, int n, uint64_t *hits)
+{
+    float right = bx + bw;
+    float bottom = by + bh;
+    for (int i = from; i < n; i++)
+    {
+        if (xs[i] < right && xs[i] + w > bx && ys[i] < bottom && ys[i] + h > by)
+            hits[i >> 6] |= 1ULL << (i & 63);
+    }
+}
+
+static void aabb_hits_scalar(float bx, float by, float bw, float bh,
+                             const float *xs, const float *ys, float w, float h,
+                             int n, uint64_t *hits)
+{
+    aabb_hits_tail(bx, by, bw, bh, xs, ys, w, h, 0, n, hits);
+}
+
+/**
+ * @brief Particules [from, n) une par une (référence et fin de boucle).
+ */
+static void particle_step_tail(float *x, float *y, const float *vx, float *vy,
+                               float *life, const float *inv_life, float *alpha,
+                               int from, int n, float dt, float gravity, uint64_t *dead)
+{
+    const float gdt = gravity * dt;
+    for (int i = from; i < n; i++)
+    {
+        vy[i] += gdt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= dt;
+        alpha[i] = life[i] * inv_life[i];
+
+        if (life[i] <= 0.0f)
+            dead[i >> 6] |= 1ULL << (i & 63);
+    }
+}
+
+static void particle_step_scalar(float *x, float *y, const float *vx, float *vy,
+                                 float *life, const float *inv_life, float *alpha,
+                                 int n, float dt, float gravity, uint64_t *dead)
+{
+    particle_step_tail(x, y, vx, vy, life, inv_life, alpha, 0, n, dt, gravity, dead);
+}
+
+// ============================================================================
+//                          3. VERSIONS x86 (SSE2 / AVX2)
+// ============================================================================
+
+#ifdef SIMD_HAVE_X86
+
+/**
+ * @brief 4 balles par itération (SSE2, disponible sur tout CPU x86-64), à partir de `from`.
+ * `from` doit être un multiple de 4 pour que les bits ne chevauchent pas deux mots.
+ */
+static void bullet_step_sse2_from(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                                  int from, int n, float dt, uint64_t *cull)
+{
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128i vlast = _mm_set1_epi32(anim_ticks - 1);
+    const __m128 vtop = _mm_set1_ps(BULLET_CULL_TOP);
+    const __m128 vbottom = _mm_set1_ps((float)GAME_HEIGHT);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i three = _mm_set1_epi32(3);
+
+    int i = from;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(dy + i), vdt));
+        _mm_storeu_ps(y + i, vy);
+
+        __m128i t = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(anim_timer + i)), one);
+        __m128i wrap = _mm_cmpgt_epi32(t, vlast);
+        _mm_storeu_si128((__m128i *)(anim_timer + i), _mm_andnot_si128(wrap, t));
+
+        __m128i f = _mm_loadu_si128((const __m128i *)(anim_frame + i));
+        f = _mm_add_epi32(f, _mm_and_si128(wrap, one));
+        _mm_storeu_si128((__m128i *)(anim_frame + i), _mm_and_si128(f, three));
+
+        __m128 out = _mm_or_ps(_mm_cmplt_ps(vy, vtop), _mm_cmpgt_ps(vy, vbottom));
+        cull[i >> 6] |= (uint64_t)_mm_movemask_ps(out) << (i & 63);
+    }
+    bullet_step_tail(y, dy, anim_timer, anim_frame, anim_ticks, i, n, dt, cull);
+}
+
+static void bullet_step_sse2(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                             int n, float dt, uint64_t *cull)
+{
+    bullet_step_sse2_from(y, dy, anim_timer, anim_frame, anim_ticks, 0, n, dt, cull);
+}
+
+/**
+ * @brief Test AABB, 4 boîtes par itération (SSE2), à partir de `from` (multiple de 4).
+ */
+static void aabb_hits_sse2_from(float bx, float by, float bw, float bh,
+                                const float *xs, const float *ys, float w, float h,
+                                int from, int n, uint64_t *hits)
+{
+    const __m128 vleft = _mm_set1_ps(bx);
+    const __m128 vtop = _mm_set1_ps(by);
+    const __m128 vright = _mm_set1_ps(bx + bw);
+    const __m128 vbottom = _mm_set1_ps(by + bh);
+    const __m128 vw = _mm_set1_ps(w);
+    const __m128 vh = _mm_set1_ps(h);
+
+    int i = from;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 in_x = _mm_and_ps(_mm_cmplt_ps(x, vright), _mm_cmpgt_ps(_mm_add_ps(x, vw), vleft));
+        __m128 in_y = _mm_and_ps(_mm_cmplt_ps(y, vbottom), _mm_cmpgt_ps(_mm_add_ps(y, vh), vtop));
+        hits[i >> 6] |= (uint64_t)_mm_movemask_ps(_mm_and_ps(in_x, in_y)) << (i & 63);
+    }
+    aabb_hits_tail(bx, by, bw, bh, xs, ys, w, h, i, n, hits);
+}
+
+static void aabb_hits_sse2(float bx, float by, float bw, float bh,
+                           const float *xs, const float *ys, float w, float h,
+                           int n, uint64_t *hits)
+{
+    aabb_hits_sse2_from(bx, by, bw, bh, xs, ys, w, h, 0, n, hits);
+}
+
+/**
+ * @brief 4 particules par itération (SSE2), à partir de `from` (multiple de 4).
+ */
+static void particle_step_sse2_from(float *x, float *y, const float *vx, float *vy,
+                                    float *life, const float *inv_life, float *alpha,
+                                    int from, int n, float dt, float gravity, uint64_t *dead)
+{
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vgdt = _mm_set1_ps(gravity * dt);
+    const __m128 zero = _mm_setzero_ps();
+
+    int i = from;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 v = _mm_add_ps(_mm_loadu_ps(vy + i), vgdt);
+        _mm_storeu_ps(vy + i, v);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(v, vdt)));
+
+        __m128 l = _mm_sub_ps(_mm_loadu_ps(life + i), vdt);
+        _mm_storeu_ps(life + i, l);
+        _mm_storeu_ps(alpha + i, _mm_mul_ps(l, _mm_loadu_ps(inv_life + i)));
+
+        dead[i >> 6] |= (uint64_t)_mm_movemask_ps(_mm_cmple_ps(l, zero)) << (i & 63);
+    }
+    particle_step_tail(x, y, vx, vy, life, inv_life, alpha, i, n, dt, gravity, dead);
+}
+
+static void particle_step_sse2(float *x, float *y, const float *vx, float *vy,
+                               float *life, const float *inv_life, float *alpha,
+                               int n, float dt, float gravity, uint64_t *dead)
+{
+    particle_step_sse2_from(x, y, vx, vy, life, inv_life, alpha, 0, n, dt, gravity, dead);
+}
+
+/**
+ * @brief 8 balles par itération (AVX2), le reste en SSE2 puis en scalaire.
+ */
+__attribute__((target("avx2"))) static void bullet_step_avx2(float *y, const float *dy, int *anim_timer, int *anim_frame,
+                                                             int anim_ticks, int n, float dt, uint64_t *cull)
+{
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256i vlast = _mm256_set1_epi32(anim_ticks - 1);
+    const __m256 vtop = _mm256_set1_ps(BULLET_CULL_TOP);
+    const __m256 vbottom = _mm256_set1_ps((float)GAME_HEIGHT);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i three = _mm256_set1_epi32(3);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(dy + i), vdt));
+        _mm256_storeu_ps(y + i, vy);
+
+        __m256i t = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(anim_timer + i)), one);
+        __m256i wrap = _mm256_cmpgt_epi32(t, vlast);
+        _mm256_storeu_si256((__m256i *)(anim_timer + i), _mm256_andnot_si256(wrap, t));
+
+        __m256i f = _mm256_loadu_si256((const __m256i *)(anim_frame + i));
+        f = _mm256_add_epi32(f, _mm256_and_si256(wrap, one));
+        _mm256_storeu_si256((__m256i *)(anim_frame + i), _mm256_and_si256(f, three));
+
+        __m256 out = _mm256_or_ps(_mm256_cmp_ps(vy, vtop, _CMP_LT_OQ), _mm256_cmp_ps(vy, vbottom, _CMP_GT_OQ));
+        cull[i >> 6] |= (uint64_t)_mm256_movemask_ps(out) << (i & 63);
+    }
+    // Retour au code SSE non-VEX (fin de boucle scalaire, appelant) : on vide
+    // la moitié haute des registres pour éviter la pénalité de transition AVX/SSE.
+    _mm256_zeroupper();
+    bullet_step_sse2_from(y, dy, anim_timer, anim_frame, anim_ticks, i, n, dt, cull);
+}
+
+/**
+ * @brief Test AABB, 8 boîtes par itération (AVX2), le reste en SSE2 puis en scalaire.
+ */
+__attribute__((target("avx2"))) static void aabb_hits_avx2(float bx, float by, float bw, float bh,
+                                                           const float *xs, const float *ys, float w, float h,
+                                                           int n, uint64_t *hits)
+{
+    const __m256 vleft = _mm256_set1_ps(bx);
+    const __m256 vtop = _mm256_set1_ps(by);
+    const __m256 vright = _mm256_set1_ps(bx + bw);
+    const __m256 vbottom = _mm256_set1_ps(by + bh);
+    const __m256 vw = _mm256_set1_ps(w);
+    const __m256 vh = _mm256_set1_ps(h);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = _mm256_loadu_ps(ys + i);
+        __m256 in_x = _mm256_and_ps(_mm256_cmp_ps(x, vright, _CMP_LT_OQ),
+                                    _mm256_cmp_ps(_mm256_add_ps(x, vw), vleft, _CMP_GT_OQ));
+        __m256 in_y = _mm256_and_ps(_mm256_cmp_ps(y, vbottom, _CMP_LT_OQ),
+                                    _mm256_cmp_ps(_mm256_add_ps(y, vh), vtop, _CMP_GT_OQ));
+        hits[i >> 6] |= (uint64_t)_mm256_movemask_ps(_mm256_and_ps(in_x, in_y)) << (i & 63);
+    }
+    _mm256_zeroupper();
+    aabb_hits_sse2_from(bx, by, bw, bh, xs, ys, w, h, i, n, hits);
+}
+
+/**
+ * @brief 8 particules par itération (AVX2), le reste en SSE2 puis en scalaire.
+ */
+__attribute__((target("avx2"))) static void particle_step_avx2(float *x, float *y, const float *vx, float *vy,
+                                                               float *life, const float *inv_life, float *alpha,
+                                                               int n, float dt, float gravity, uint64_t *dead)
+{
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 vgdt = _mm256_set1_ps(gravity * dt);
+    const __m256 zero = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 v = _mm256_add_ps(_mm256_loadu_ps(vy + i), vgdt);
+        _mm256_storeu_ps(vy + i, v);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(v, vdt)));
+
+        __m256 l = _mm256_sub_ps(_mm256_loadu_ps(life + i), vdt);
+        _mm256_storeu_ps(life + i, l);
+        _mm256_storeu_ps(alpha + i, _mm256_mul_ps(l, _mm256_loadu_ps(inv_life + i)));
+
+        dead[i >> 6] |= (uint64_t)_mm256_movemask_ps(_mm256_cmp_ps(l, zero, _CMP_LE_OQ)) << (i & 63);
+    }
+    _mm256_zeroupper();
+    particle_step_sse2_from(x, y, vx, vy, life, inv_life, alpha, i, n, dt, gravity, dead);
+}
+
+#endif // SIMD_HAVE_X86
+
+// ============================================================================
+//                          4. VERSION ARM (NEON)
+// ============================================================================
+
+#ifdef SIMD_HAVE_NEON
+
+/**
+ * @brief Convertit un masque de comparaison NEON (4 voies) en 4 bits.
+ */
+static unsigned neon_movemask(uint32x4_t m)
+{
+    return (vgetq_lane_u32(m, 0) & 1) |
+           (vgetq_lane_u32(m, 1) & 2) |
+           (vgetq_lane_u32(m, 2) & 4) |
+           (vgetq_lane_u32(m, 3) & 8);
+}
+
+/**
+ * @brief 4 balles par itération (NEON).
+ * Multiplication et addition restent séparées (pas de FMA) : même arrondi que le scalaire.
+ */
+static void bullet_step_neon(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                             int n, float dt, uint64_t *cull)
+{
+    const float32x4_t vdt = vdupq_n_f32(dt);
+    const int32x4_t vticks = vdupq_n_s32(anim_ticks);
+    const int32x4_t one = vdupq_n_s32(1);
+    const float32x4_t vtop = vdupq_n_f32(BULLET_CULL_TOP);
+    const float32x4_t vbottom = vdupq_n_f32((float)GAME_HEIGHT);
+    const int32x4_t three = vdupq_n_s32(3);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t vy = vaddq_f32(vld1q_f32(y + i), vmulq_f32(vld1q_f32(dy + i), vdt));
+        vst1q_f32(y + i, vy);
+
+        int32x4_t t = vaddq_s32(vld1q_s32(anim_timer + i), one);
+        uint32x4_t wrap = vcgeq_s32(t, vticks);
+        vst1q_s32(anim_timer + i, vbicq_s32(t, vreinterpretq_s32_u32(wrap)));
+
+        // wrap vaut -1 (tous bits à 1) sur les voies concernées : on le soustrait.
+        int32x4_t f = vsubq_s32(vld1q_s32(anim_frame + i), vreinterpretq_s32_u32(wrap));
+        vst1q_s32(anim_frame + i, vandq_s32(f, three));
+
+        uint32x4_t out = vorrq_u32(vcltq_f32(vy, vtop), vcgtq_f32(vy, vbottom));
+        cull[i >> 6] |= (uint64_t)neon_movemask(out) << (i & 63);
+    }
+    bullet_step_tail(y, dy, anim_timer, anim_frame, anim_ticks, i, n, dt, cull);
+}
+
+/**
+ * @brief Test AABB, 4 boîtes par itération (NEON).
+ */
+static void aabb_hits_neon(float bx, float by, float bw, float bh,
+                           const float *xs, const float *ys, float w, float h,
+                           int n, uint64_t *hits)
+{
+    const float32x4_t vleft = vdupq_n_f32(bx);
+    const float32x4_t vtop = vdupq_n_f32(by);
+    const float32x4_t vright = vdupq_n_f32(bx + bw);
+    const float32x4_t vbottom = vdupq_n_f32(by + bh);
+    const float32x4_t vw = vdupq_n_f32(w);
+    const float32x4_t vh = vdupq_n_f32(h);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t x = vld1q_f32(xs + i);
+        float32x4_t y = vld1q_f32(ys + i);
+        uint32x4_t in_x = vandq_u32(vcltq_f32(x, vright), vcgtq_f32(vaddq_f32(x, vw), vleft));
+        uint32x4_t in_y = vandq_u32(vcltq_f32(y, vbottom), vcgtq_f32(vaddq_f32(y, vh), vtop));
+        hits[i >> 6] |= (uint64_t)neon_movemask(vandq_u32(in_x, in_y)) << (i & 63);
+    }
+    aabb_hits_tail(bx, by, bw, bh, xs, ys, w, h, i, n, hits);
+}
+
+/**
+ * @brief 4 particules par itération (NEON), sans FMA.
+ */
+static void particle_step_neon(float *x, float *y, const float *vx, float *vy,
+                               float *life, const float *inv_life, float *alpha,
+                               int n, float dt, float gravity, uint64_t *dead)
+{
+    const float32x4_t vdt = vdupq_n_f32(dt);
+    const float32x4_t vgdt = vdupq_n_f32(gravity * dt);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t v = vaddq_f32(vld1q_f32(vy + i), vgdt);
+        vst1q_f32(vy + i, v);
+        vst1q_f32(x + i, vaddq_f32(vld1q_f32(x + i), vmulq_f32(vld1q_f32(vx + i), vdt)));
+        vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), vmulq_f32(v, vdt)));
+
+        float32x4_t l = vsubq_f32(vld1q_f32(life + i), vdt);
+        vst1q_f32(life + i, l);
+        vst1q_f32(alpha + i, vmulq_f32(l, vld1q_f32(inv_life + i)));
+
+        dead[i >> 6] |= (uint64_t)neon_movemask(vcleq_f32(l, zero)) << (i & 63);
+    }
+    particle_step_tail(x, y, vx, vy, life, inv_life, alpha, i, n, dt, gravity, dead);
+}
+
+#endif // SIMD_HAVE_NEON
+
+// ============================================================================
+//                          5. SÉLECTION À L'EXÉCUTION
+// ============================================================================
+
+/** @brief Backends disponibles, du plus rapide au plus lent. */
+static const SimdBackend backends[] = {
+#ifdef SIMD_HAVE_X86
+    {"avx2", bullet_step_avx2, aabb_hits_avx2, particle_step_avx2},
+    {"sse2", bullet_step_sse2, aabb_hits_sse2, particle_step_sse2},
+#endif
+#ifdef SIMD_HAVE_NEON
+    {"neon", bullet_step_neon, aabb_hits_neon, particle_step_neon},
+#endif
+    {"scalar", bullet_step_scalar, aabb_hits_scalar, particle_step_scalar},
+};
+
+#define BACKEND_COUNT ((int)(sizeof(backends) / sizeof(backends[0])))
+
+/**
+ * @brief Indique si le CPU courant sait exécuter un backend.
+ */
+static int backend_supported(const SimdBackend *b)
+{
+#ifdef SIMD_HAVE_X86
+    if (strcmp(b->name, "avx2") == 0)
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+#endif
+    (void)b;
+    return 1;
+}
+
+static const SimdBackend *active;                      ///< Backend choisi (écrit une fois, sous active_once).
+static pthread_once_t active_once = PTHREAD_ONCE_INIT; ///< Premier appel, d'où qu'il vienne (workers compris).
+
+/**
+ * @brief Choisit le backend : celui de SPACE_INVADERS_SIMD s'il est supporté, sinon le meilleur.
+ */
+static void select_backend(void)
+{
+    const char *forced = getenv("SPACE_INVADERS_SIMD");
+    const SimdBackend *chosen = NULL;
+    for (int i = 0; i < BACKEND_COUNT && !chosen; i++)
+    {
+        if (!backend_supported(&backends[i]))
+            continue;
+        if (!forced || strcmp(forced, backends[i].name) == 0)
+            chosen = &backends[i];
+    }
+
+    // Backend demandé inconnu ou non supporté : repli sur le meilleur disponible
+    for (int i = 0; i < BACKEND_COUNT && !chosen; i++)
+        if (backend_supported(&backends[i]))
+            chosen = &backends[i];
+
+    active = chosen;
+}
+
+/**
+ * @brief Retourne le backend actif (choisi une seule fois, au premier appel).
+ *
+ * pthread_once ordonne le choix avant toute lecture : des threads de
+ * simulation qui arrivent ensemble attendent le premier, sans course.
+ */
+static const SimdBackend *active_backend(void)
+{
+    pthread_once(&active_once, select_backend);
+    return active;
+}
+
+// ============================================================================
+//                          6. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Intègre un bloc contigu de balles et calcule leur masque de sortie d'écran.
+ */
+void simd_bullet_step(float *y, const float *dy, int *anim_timer, int *anim_frame, int anim_ticks,
+                      int n, float dt, uint64_t *cull)
+{
+    active_backend()->bullet_step(y, dy, anim_timer, anim_frame, anim_ticks, n, dt, cull);
+}
+
+/**
+ * @brief Teste une boîte contre N boîtes de même taille (SoA).
+ */
+void simd_aabb_hits(float bx, float by, float bw, float bh,
+                    const float *xs, const float *ys, float w, float h,
+                    int n, uint64_t *hits)
+{
+    active_backend()->aabb_hits(bx, by, bw, bh, xs, ys, w, h, n, hits);
+}
+
+/**
+ * @brief Intègre un bloc contigu de particules (position, vie, opacité, masque de mort).
+ */
+void simd_particle_step(float *x, float *y, const float *vx, float *vy,
+                        float *life, const float *inv_life, float *alpha,
+                        int n, float dt, float gravity, uint64_t *dead)
+{
+    active_backend()->particle_step(x, y, vx, vy, life, inv_life, alpha, n, dt, gravity, dead);
+}
+
+/**
+ * @brief Nom du backend sélectionné.
+ */
+const char *simd_backend_name(void)
+{
+    return active_backend()->name;
+}
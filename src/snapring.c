@@ -0,0 +1,62 @@
+/**
+ * @file snapring.c
+ * @brief Implémentation du passage d'instantanés (échanges atomiques GCC/Clang __atomic).
+ */
+
+#include "snapring.h"
+
+#define SNAPRING_FRESH 0x4u ///< Bit de `middle` : publié, pas encore pris.
+#define SNAPRING_INDEX 0x3u ///< Masque de l'emplacement dans `middle`.
+
+/**
+ * @brief Prépare un passage vide.
+ */
+void snapring_init(SnapRing *ring, void *storage, size_t size)
+{
+    ring->slots = storage;
+    ring->size = size;
+    for (int i = 0; i < SNAPRING_SLOTS; i++)
+        ring->seq[i] = 0;
+    ring->back = 0;
+    ring->middle = 1;
+    ring->front = 2;
+    ring->published = 0;
+    ring->overwritten = 0;
+}
+
+/**
+ * @brief Emplacement à remplir (thread producteur uniquement).
+ */
+void *snapring_write_slot(SnapRing *ring)
+{
+    return ring->slots + (size_t)ring->back * ring->size;
+}
+
+/**
+ * @brief Publie l'emplacement rempli (thread producteur uniquement).
+ *
+ * L'échange release rend l'instantané et son numéro visibles avant son
+ * index ; l'acquire récupère un emplacement que le consommateur a fini de lire.
+ */
+void snapring_publish(SnapRing *ring, uint32_t seq)
+{
+    ring->seq[ring->back] = seq;
+    uint32_t old = __atomic_exchange_n(&ring->middle, ring->back | SNAPRING_FRESH, __ATOMIC_ACQ_REL);
+    if (old & SNAPRING_FRESH)
+        ring->overwritten++;
+    ring->back = old & SNAPRING_INDEX;
+    ring->published++;
+}
+
+/**
+ * @brief Prend le plus récent instantané publié (thread consommateur uniquement).
+ */
+const void *snapring_acquire(SnapRing *ring, uint32_t *seq)
+{
+    if (__atomic_load_n(&ring->middle, __ATOMIC_ACQUIRE) & SNAPRING_FRESH)
+        ring->front = __atomic_exchange_n(&ring->middle, ring->front, __ATOMIC_ACQ_REL) & SNAPRING_INDEX;
+    if (ring->seq[ring->front] == 0)
+        return NULL;
+    *seq = ring->seq[ring->front];
+    return ring->slots + (size_t)ring->front * ring->size;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file spsc.c
+ * @brief Implémentation de la file SPSC sans verrou (barrières GCC/Clang __atomic).
+ */
+
+#include "spsc.h"
+
+#include <string.h>
+
+/**
+ * @brief Prépare une file vide.
+ */
+void spsc_init(SpscRing *ring, void *storage, size_t size, uint32_t capacity)
+{
+    ring->items = storage;
+    ring->size = size;
+    ring->capacity = capacity;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+}
+
+/**
+ * @brief Ajoute un élément (thread producteur uniquement).
+ *
+ * Les index croissent sans fin (modulo 2^32) : `tail - head` est le nombre
+ * d'éléments présents, même après un débordement.
+ */
+bool spsc_push(SpscRing *ring, const void *item)
+{
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (tail - head == ring->capacity)
+    {
+        ring->dropped++;
+        return false;
+    }
+    memcpy(ring->items + (size_t)(tail & (ring->capacity - 1)) * ring->size, item, ring->size);
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Retire le plus ancien élément (thread consommateur uniquement).
+ */
+bool spsc_pop(SpscRing *ring, void *item)
+{
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head == tail)
+        return false;
+    memcpy(item, ring->items + (size_t)(head & (ring->capacity - 1)) * ring->size, ring->size);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Indique que la file est vide (thread consommateur uniquement).
+ */
+bool spsc_empty(SpscRing *ring)
+{
+    return ring->head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
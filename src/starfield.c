@@ -0,0 +1,75 @@
+/**
+ * @file starfield.c
+ * @brief Implémentation du champ d'étoiles (semis, défilement).
+ */
+
+#include "starfield.h"
+
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Part des étoiles de chaque plan, en millièmes (lointain d'abord). */
+static const int LAYER_SHARE[STARFIELD_LAYERS] = {550, 300, 150};
+
+/** @brief Vitesse de base de chaque plan (pixels / s). */
+static const float LAYER_SPEED[STARFIELD_LAYERS] = {8.0f, 20.0f, 48.0f};
+
+/**
+ * @brief Tirage xorshift32, ramené dans [0, 1).
+ */
+static float star_rand(StarField *sf)
+{
+    uint32_t s = sf->rng;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    sf->rng = s;
+    return (s >> 8) * (1.0f / 16777216.0f);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Plans contigus, vitesses à ±25 % de celle du plan : les étoiles d'un plan ne défilent pas en bloc.
+ */
+void starfield_init(StarField *sf, float width, float height, uint32_t seed)
+{
+    memset(sf, 0, sizeof(*sf));
+    sf->width = width;
+    sf->height = height;
+    sf->rng = seed ? seed : 0x9E3779B9u;
+    int at = 0;
+    for (int l = 0; l < STARFIELD_LAYERS; l++)
+    {
+        sf->first[l] = at;
+        int end = (l == STARFIELD_LAYERS - 1) ? STARFIELD_STARS : at + STARFIELD_STARS * LAYER_SHARE[l] / 1000;
+        for (; at < end; at++)
+        {
+            sf->x[at] = star_rand(sf) * width;
+            sf->y[at] = star_rand(sf) * height;
+            sf->speed[at] = LAYER_SPEED[l] * (0.75f + 0.5f * star_rand(sf));
+        }
+    }
+    sf->first[STARFIELD_LAYERS] = STARFIELD_STARS;
+}
+
+/**
+ * @brief Intégration en une passe ; une étoile sortie garde son plan et sa vitesse.
+ */
+void starfield_update(StarField *sf, float dt)
+{
+    float h = sf->height;
+    for (int i = 0; i < STARFIELD_STARS; i++)
+        sf->y[i] += sf->speed[i] * dt;
+    for (int i = 0; i < STARFIELD_STARS; i++)
+        if (sf->y[i] >= h)
+        {
+            sf->y[i] -= h;
+            sf->x[i] = star_rand(sf) * sf->width;
+        }
+}
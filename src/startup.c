@@ -0,0 +1,98 @@
+/**
+ * @file startup.c
+ * @brief Implémentation du chronométrage du démarrage.
+ *
+ * Toutes les écritures viennent du thread de rendu, sauf les phases de fond,
+ * ajoutées par ce même thread quand il branche leur résultat : aucun verrou.
+ */
+
+#include "startup.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+
+// ============================================================================
+//                          1. ÉTAT
+// ============================================================================
+
+/** @brief Clés du bilan, dans l'ordre de StartupPhase. */
+static const char *const phase_keys[STARTUP_PHASE_COUNT] = {"model_init", "sdl_init", "fonts",
+                                                            "textures",   "images",   "audio"};
+
+static double begin = 0.0;                         ///< Entrée dans main() (utils_get_time).
+static double phases[STARTUP_PHASE_COUNT];         ///< Durées cumulées (s).
+static double menu_at = -1.0;                      ///< Première image (s depuis begin, -1 : pas encore).
+static double playable_at = -1.0;                  ///< Première image jouable (s depuis begin, -1 : pas encore).
+static bool bench = false;                         ///< SPACE_INVADERS_STARTUP_BENCH=1.
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Date l'entrée dans main() et lit SPACE_INVADERS_STARTUP_BENCH.
+ */
+void startup_begin(void)
+{
+    begin = utils_get_time();
+    const char *env = getenv("SPACE_INVADERS_STARTUP_BENCH");
+    bench = env && strcmp(env, "1") == 0;
+}
+
+/**
+ * @brief Cumule la durée (phase hors bornes ignorée).
+ */
+void startup_add(StartupPhase phase, double seconds)
+{
+    if (phase >= 0 && phase < STARTUP_PHASE_COUNT)
+        phases[phase] += seconds;
+}
+
+/**
+ * @brief Date la première image, puis la première image jouable.
+ */
+void startup_frame(bool playable)
+{
+    double now = utils_get_time() - begin;
+    if (menu_at < 0.0)
+        menu_at = now;
+    if (playable && playable_at < 0.0)
+        playable_at = now;
+}
+
+/**
+ * @brief Première image jouable présentée.
+ */
+bool startup_playable(void)
+{
+    return playable_at >= 0.0;
+}
+
+/**
+ * @brief Image jouable présentée, ou délai dépassé.
+ */
+bool startup_bench_done(void)
+{
+    return bench && (playable_at >= 0.0 || utils_get_time() - begin > STARTUP_BENCH_TIMEOUT_S);
+}
+
+/**
+ * @brief Une ligne "[DEMARRAGE] clé=ms ..." ; un jalon non atteint est absent.
+ */
+void startup_report(void)
+{
+    if (!bench)
+        return;
+    printf("[DEMARRAGE]");
+    if (menu_at >= 0.0)
+        printf(" menu_frame=%.1f", menu_at * 1000.0);
+    if (playable_at >= 0.0)
+        printf(" playable_frame=%.1f", playable_at * 1000.0);
+    for (int p = 0; p < STARTUP_PHASE_COUNT; p++)
+        printf(" %s=%.1f", phase_keys[p], phases[p] * 1000.0);
+    printf("\n");
+    fflush(stdout);
+}
@@ -0,0 +1,413 @@
+/**
+ * @file statehash.c
+ * @brief Implémentation de l'empreinte d'état (xxHash64 sur un relevé canonique des champs).
+ */
+
+#include "statehash.h"
+
+#include <string.h>
+
+// ============================================================================
+//                          1. XXHASH64
+// ============================================================================
+
+#define PRIME1 0x9E3779B185EBCA87ULL
+#define PRIME2 0xC2B2AE3D27D4EB4FULL
+#define PRIME3 0x165667B19E3779F9ULL
+#define PRIME4 0x85EBCA77C2B2AE63ULL
+#define PRIME5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/** @brief Lecture little-endian, indépendante de l'alignement et de la machine. */
+static inline uint64_t read64(const uint8_t *p)
+{
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+           (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline uint64_t round64(uint64_t acc, uint64_t input)
+{
+    acc += input * PRIME2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME1;
+}
+
+static inline uint64_t merge64(uint64_t h, uint64_t acc)
+{
+    h ^= round64(0, acc);
+    return h * PRIME1 + PRIME4;
+}
+
+/** @brief Avale des bandes complètes de 32 octets. @return Les octets consommés. */
+static size_t consume_stripes(uint64_t acc[4], const uint8_t *p, size_t len)
+{
+    size_t done = 0;
+    for (; done + 32 <= len; done += 32)
+    {
+        acc[0] = round64(acc[0], read64(p + done));
+        acc[1] = round64(acc[1], read64(p + done + 8));
+        acc[2] = round64(acc[2], read64(p + done + 16));
+        acc[3] = round64(acc[3], read64(p + done + 24));
+    }
+    return done;
+}
+
+void statehash_init(StateHash *h, uint64_t seed)
+{
+    h->acc[0] = seed + PRIME1 + PRIME2;
+    h->acc[1] = seed + PRIME2;
+    h->acc[2] = seed;
+    h->acc[3] = seed - PRIME1;
+    h->seed = seed;
+    h->total = 0;
+    h->pending = 0;
+}
+
+void statehash_update(StateHash *h, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    h->total += len;
+    if (h->pending + len < 32)
+    {
+        memcpy(h->mem + h->pending, p, len);
+        h->pending += (uint32_t)len;
+        return;
+    }
+    if (h->pending > 0)
+    {
+        size_t fill = 32 - h->pending;
+        memcpy(h->mem + h->pending, p, fill);
+        consume_stripes(h->acc, h->mem, 32);
+        p += fill;
+        len -= fill;
+        h->pending = 0;
+    }
+    size_t done = consume_stripes(h->acc, p, len);
+    memcpy(h->mem, p + done, len - done);
+    h->pending = (uint32_t)(len - done);
+}
+
+uint64_t statehash_digest(const StateHash *h)
+{
+    uint64_t r;
+    if (h->total >= 32)
+    {
+        r = rotl64(h->acc[0], 1) + rotl64(h->acc[1], 7) + rotl64(h->acc[2], 12) + rotl64(h->acc[3], 18);
+        for (int i = 0; i < 4; i++)
+            r = merge64(r, h->acc[i]);
+    }
+    else
+    {
+        r = h->seed + PRIME5;
+    }
+    r += h->total;
+
+    const uint8_t *p = h->mem;
+    uint32_t n = h->pending;
+    for (; n >= 8; p += 8, n -= 8)
+        r = rotl64(r ^ round64(0, read64(p)), 27) * PRIME1 + PRIME4;
+    if (n >= 4)
+    {
+        r = rotl64(r ^ (uint64_t)read32(p) * PRIME1, 23) * PRIME2 + PRIME3;
+        p += 4;
+        n -= 4;
+    }
+    for (; n > 0; p++, n--)
+        r = rotl64(r ^ (uint64_t)*p * PRIME5, 11) * PRIME1;
+
+    r ^= r >> 33;
+    r *= PRIME2;
+    r ^= r >> 29;
+    r *= PRIME3;
+    r ^= r >> 32;
+    return r;
+}
+
+uint64_t statehash_bytes(const void *data, size_t len, uint64_t seed)
+{
+    StateHash h;
+    statehash_init(&h, seed);
+    statehash_update(&h, data, len);
+    return statehash_digest(&h);
+}
+
+// ============================================================================
+//                          2. RELEVÉ DE L'ÉTAT
+// ============================================================================
+
+/**
+ * @brief Tampon de mots little-endian, vidé dans le hachage quand il est plein.
+ */
+typedef struct
+{
+    StateHash hash;    ///< Hachage en cours.
+    uint8_t buf[1024]; ///< Mots en attente.
+    size_t len;        ///< Octets dans `buf`.
+} Dump;
+
+static void dump_flush(Dump *d)
+{
+    statehash_update(&d->hash, d->buf, d->len);
+    d->len = 0;
+}
+
+static inline void put_u32(Dump *d, uint32_t v)
+{
+    if (d->len + 4 > sizeof(d->buf))
+        dump_flush(d);
+    uint8_t *p = d->buf + d->len;
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    d->len += 4;
+}
+
+static inline void put_i32(Dump *d, int v)
+{
+    put_u32(d, (uint32_t)v);
+}
+
+static inline void put_u64(Dump *d, uint64_t v)
+{
+    put_u32(d, (uint32_t)v);
+    put_u32(d, (uint32_t)(v >> 32));
+}
+
+/** @brief Un flottant par ses bits : deux états égaux au bit près, pas seulement à l'arrondi. */
+static inline void put_f32(Dump *d, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    put_u32(d, bits);
+}
+
+static void put_entity(Dump *d, const Entity *e)
+{
+    put_f32(d, e->x);
+    put_f32(d, e->y);
+    put_i32(d, e->width);
+    put_i32(d, e->height);
+    put_f32(d, e->dx);
+    put_f32(d, e->dy);
+    put_u32(d, (uint32_t)e->active | (uint32_t)e->exploding << 1 | (uint32_t)e->type << 8);
+    put_i32(d, e->shoot_timer);
+    put_i32(d, e->anim_timer);
+    put_i32(d, e->anim_frame);
+    put_i32(d, e->explode_timer);
+}
+
+/** @brief Vague : formation, aliens en explosion (positions figées) et roue des explosions. */
+static void put_wave(Dump *d, const SimState *s)
+{
+    const Formation *f = &s->formation;
+    put_f32(d, f->origin_x);
+    put_f32(d, f->origin_y);
+    put_u64(d, f->alive_mask);
+    put_u64(d, f->dying_mask);
+    put_f32(d, f->step_x);
+    put_f32(d, f->step_y);
+    put_i32(d, f->size);
+    put_f32(d, f->speed);
+    put_f32(d, f->speedup);
+    put_i32(d, f->fire_chance);
+    put_u32(d, (uint32_t)f->intercept);
+    put_i32(d, f->drop_chance);
+    put_i32(d, f->alive_count);
+    put_i32(d, f->min_col);
+    put_i32(d, f->max_col);
+    for (int c = 0; c < FORMATION_COLS; c++)
+        put_i32(d, f->bottom[c]);
+    if (s->formation_path) // Le segment décide des rebonds à venir ; pas à pas, il n'existe pas
+    {
+        put_f32(d, f->path_x0);
+        put_f32(d, f->path_rate);
+        put_i32(d, f->path_ticks);
+        put_i32(d, f->path_edge);
+        put_i32(d, f->path_min_col);
+        put_i32(d, f->path_max_col);
+    }
+    if (s->endless) // Rangées en cours d'entrée ; une vague par niveau, elles n'existent pas
+    {
+        put_f32(d, f->stream_lag);
+        put_i32(d, f->stream_rows);
+    }
+
+    const EnemyPool *e = &s->enemies;
+    uint64_t shown = f->alive_mask | f->dying_mask;
+    while (shown)
+    {
+        int i = __builtin_ctzll(shown);
+        shown &= shown - 1;
+        put_u32(d, (uint32_t)e->type[i]);
+        if (f->dying_mask >> i & 1)
+        {
+            put_f32(d, e->x[i]);
+            put_f32(d, e->y[i]);
+        }
+    }
+    put_i32(d, e->explosion_count);
+    for (int k = 0; k < e->explosion_count; k++)
+    {
+        put_u64(d, e->explosions[k].mask);
+        put_i32(d, e->explosions[k].timer);
+    }
+}
+
+/** @brief Balles actives, dans l'ordre de la liste (ordre de résolution) : le slot n'en fait pas partie. */
+static void put_bullets(Dump *d, const BulletPool *p)
+{
+    put_i32(d, p->live.count);
+    for (int k = 0; k < p->live.count; k++)
+    {
+        int i = p->live.items[k];
+        put_f32(d, p->x[i]);
+        put_f32(d, p->y[i]);
+        put_f32(d, p->dy[i]);
+        put_u32(d, (uint32_t)p->type[i] | (uint32_t)p->anim_frame[i] << 8);
+        put_i32(d, p->anim_timer[i]);
+    }
+}
+
+static void put_shields(Dump *d, const SimState *s)
+{
+    for (int i = 0; i < MAX_SHIELDS; i++)
+    {
+        const Shield *sh = &s->shields[i];
+        put_f32(d, sh->x);
+        put_f32(d, sh->y);
+        put_f32(d, sh->width);
+        put_f32(d, sh->height);
+        put_i32(d, sh->health);
+        put_u32(d, (uint32_t)sh->active);
+        if (s->shield_bitmap)
+            for (int r = 0; r < SHIELD_BITMAP_ROWS; r++)
+                put_u32(d, sh->bits[r]);
+    }
+}
+
+/**
+ * @brief Entités du registre, dans l'ordre des positions (celui des sauvegardes).
+ *
+ * Ni index ni génération : un instantané recrée les entités ailleurs.
+ */
+static void put_ecs(Dump *d, const EcsWorld *w)
+{
+    short ids[ECS_MAX_ENTITIES];
+    int n = ecs_query(w, ECS_BIT(ECS_POSITION), ids);
+    put_i32(d, w->alive);
+    put_i32(d, n);
+    for (int k = 0; k < n; k++)
+    {
+        int i = ids[k], p;
+        put_u32(d, w->mask[i]);
+        if ((p = ecs_slot(w, i, ECS_POSITION)) >= 0)
+        {
+            put_f32(d, w->x[p]);
+            put_f32(d, w->y[p]);
+        }
+        if ((p = ecs_slot(w, i, ECS_VELOCITY)) >= 0)
+        {
+            put_f32(d, w->dx[p]);
+            put_f32(d, w->dy[p]);
+        }
+        if ((p = ecs_slot(w, i, ECS_KIND)) >= 0)
+            put_u32(d, w->kind[p]);
+        if ((p = ecs_slot(w, i, ECS_LIFETIME)) >= 0)
+            put_f32(d, w->lifetime[p]);
+    }
+}
+
+// ============================================================================
+//                          3. API
+// ============================================================================
+
+/**
+ * @brief Empreinte de l'état simulé du modèle.
+ *
+ * Les booléens de mode (virgule fixe, boucliers, balayage...) en font partie :
+ * la même partie dans deux physiques n'a pas la même empreinte.
+ */
+uint64_t statehash_model(const GameModel *model, uint64_t seed)
+{
+    const SimState *s = &model->sim;
+    Dump d;
+    statehash_init(&d.hash, seed);
+    d.len = 0;
+
+    put_u32(&d, (uint32_t)s->state | (uint32_t)s->previous_state << 8);
+    put_u32(&d, (uint32_t)s->fixed_point | (uint32_t)s->shield_bitmap << 1 | (uint32_t)s->swept_bullets << 2 |
+                    (uint32_t)s->exact_timers << 3 | (uint32_t)s->fire_scheduled << 4 | (uint32_t)s->coop << 5 |
+                    (uint32_t)s->formation_path << 6 | (uint32_t)s->level_retry << 7 | (uint32_t)s->endless << 8);
+    put_i32(&d, s->score);
+    put_i32(&d, s->lives);
+    put_i32(&d, s->level);
+    put_i32(&d, s->normal_max_lives);
+    put_f32(&d, s->enemy_speed_mult);
+    put_i32(&d, s->direction_enemies);
+    put_i32(&d, s->drop_direction);
+    put_i32(&d, s->drop_step_count);
+    put_i32(&d, s->animation_frame);
+    put_i32(&d, s->animation_timer);
+    put_i32(&d, s->game_over_timer);
+    put_i32(&d, s->hit_timer);
+    // Une transition finie vaut une absence de transition (instantanés, cf. save.c)
+    bool transition = timeline_active(&s->transition);
+    put_i32(&d, transition ? s->transition.tag | s->transition.count << 8 | s->transition.step << 16 : 0);
+    put_i32(&d, transition ? s->transition.elapsed : 0);
+    put_i32(&d, s->rapid_timer);
+    put_i32(&d, s->spread_timer);
+    put_f32(&d, s->fire_timer);
+    put_u64(&d, s->rng.state);
+    put_u64(&d, s->rng.inc);
+    if (!params_is_default(&s->params)) // Réglés à la main seulement : les autres empreintes ne changent pas
+    {
+        put_f32(&d, s->params.player_speed);
+        put_f32(&d, s->params.bullet_speed);
+        put_f32(&d, s->params.enemy_speed);
+        put_f32(&d, s->params.enemy_drop);
+        put_f32(&d, s->params.ufo_speed);
+        put_i32(&d, s->params.ufo_odds);
+        put_i32(&d, s->params.fire_percent);
+    }
+
+    put_entity(&d, &s->player);
+    if (s->coop)
+        put_entity(&d, &s->player2);
+
+    const Ufo *u = &s->ufo;
+    put_f32(&d, u->x);
+    put_f32(&d, u->y);
+    put_f32(&d, u->dx);
+    put_u32(&d, (uint32_t)u->active | (uint32_t)u->hasSpawnedThisLevel << 1 | (uint32_t)u->exploding << 2);
+    put_i32(&d, u->explode_timer);
+
+    const Boss *b = &s->boss;
+    if (b->active) // Vagues `boss` seulement : le hachage des autres parties ne change pas
+    {
+        put_f32(&d, b->x);
+        put_f32(&d, b->y);
+        put_f32(&d, b->dx);
+        put_i32(&d, b->parts);
+        put_u64(&d, b->alive_mask);
+        for (int k = 0; k < b->parts; k++)
+            put_i32(&d, b->health[k]);
+    }
+
+    put_wave(&d, s);
+    put_shields(&d, s);
+    put_bullets(&d, &s->bullets);
+    put_ecs(&d, &s->ecs);
+
+    dump_flush(&d);
+    return statehash_digest(&d.hash);
+}
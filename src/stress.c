@@ -0,0 +1,283 @@
+/**
+ * @file stress.c
+ * @brief Implémentation des scénarios de pire cas.
+ *
+ * Les scénarios ne passent que par l'API du Modèle ouverte aux décodeurs
+ * (model_clear_bullets, model_add_enemy_explosion, model_rebuild_indexes,
+ * model_spawn_bullet, model_add_powerup) : l'état produit est de ceux
+ * qu'une sauvegarde pourrait contenir.
+ */
+
+#include "stress.h"
+
+#include "entity_type.h"
+
+// ============================================================================
+//                          1. NOMS
+// ============================================================================
+
+/**
+ * @brief Noms courts, indexés par StressScenario.
+ */
+static const char *const stress_names[STRESS_COUNT] = {
+    [STRESS_NONE] = "none",
+    [STRESS_POOL_FULL] = "pool-full",
+    [STRESS_FORMATION] = "formation",
+    [STRESS_SHIELDS] = "shields",
+    [STRESS_UFO] = "ufo",
+    [STRESS_ALL] = "all",
+};
+
+// ============================================================================
+//                          2. PLACEMENT DES BALLES
+// ============================================================================
+
+/**
+ * @brief Aliens vivants, par index croissant.
+ * @return Leur nombre.
+ */
+static int alive_enemies(const GameModel *model, int out[FORMATION_SIZE])
+{
+    int n = 0;
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        if (model->sim.formation.alive_mask & (1ULL << i))
+            out[n++] = i;
+    return n;
+}
+
+/**
+ * @brief La k-ième balle dans un alien vivant : les aliens à tour de rôle, une case différente à chaque tour.
+ *
+ * Les balles sont placées à une demi-unité des bords gauche et droit et sous
+ * la ligne du haut : après le déplacement du tick (balle d'une unité, vague
+ * de moins d'une unité), elles chevauchent encore leur alien.
+ */
+static bool spot_formation(const GameModel *model, const int *alive, int n, int k, float *x, float *y)
+{
+    if (n == 0)
+        return false;
+    int i = alive[k % n], turn = k / n;
+    *x = model_get_enemy_x(model, i) + 0.5f + (float)(turn % (ENEMY_WIDTH - 1));
+    *y = model_get_enemy_y(model, i) + 1.0f + (float)(turn / (ENEMY_WIDTH - 1) % (ENEMY_HEIGHT - 1));
+    return true;
+}
+
+/**
+ * @brief La k-ième balle dans un bunker actif : les bunkers à tour de rôle, balayés ligne par ligne.
+ *
+ * Ni la première ni la dernière ligne : les tirs des deux camps y sont encore après leur pas du tick.
+ */
+static bool spot_shield(const GameModel *model, int k, float *x, float *y)
+{
+    int active[MAX_SHIELDS], n = 0;
+    for (int s = 0; s < MAX_SHIELDS; s++)
+        if (model->sim.shields[s].active)
+            active[n++] = s;
+    if (n == 0)
+        return false;
+    const Shield *sh = &model->sim.shields[active[k % n]];
+    int w = sh->width > 1.0f ? (int)sh->width : 1, h = sh->height > 3.0f ? (int)sh->height - 2 : 1;
+    int turn = k / n;
+    *x = sh->x + (float)(turn % w);
+    *y = sh->y + 1.0f + (float)(turn / w % h);
+    return true;
+}
+
+/**
+ * @brief La k-ième balle sur n en plein champ : colonnes régulières, sur une bande de 10 lignes.
+ *
+ * Les tirs du joueur partent du bas, ceux de la vague du haut (comme bench/bench.c).
+ */
+static void spot_field(int k, int n, bool player, float *x, float *y)
+{
+    *x = (float)((long)k * GAME_WIDTH / (n > 0 ? n : 1));
+    *y = player ? GAME_HEIGHT - 5.0f - (k % 10) : 12.0f + (k % 10);
+}
+
+/**
+ * @brief Position de la k-ième balle (sur n) d'un camp dans un scénario.
+ *
+ * Les cibles épuisées (vague vide, bunkers détruits) rendent la place au plein champ.
+ */
+static void bullet_spot(const GameModel *model, StressScenario s, bool player, int k, int n,
+                        const int *alive, int alive_n, float *x, float *y)
+{
+    const Ufo *ufo = &model->sim.ufo;
+    bool placed = false;
+    switch (s)
+    {
+    case STRESS_FORMATION:
+        placed = spot_formation(model, alive, alive_n, k, x, y);
+        break;
+    case STRESS_SHIELDS:
+        placed = spot_shield(model, k, x, y);
+        break;
+    case STRESS_UFO:
+        // Une balle dans l'OVNI, une dans chaque alien vivant, le reste en plein champ
+        if (player && k == 0 && ufo->active)
+        {
+            *x = ufo->x + ufo->width / 2.0f;
+            *y = ufo->y + ufo->height / 2.0f;
+            placed = true;
+        }
+        else if (player && k - 1 < alive_n)
+            placed = spot_formation(model, alive, alive_n, k - 1, x, y);
+        break;
+    case STRESS_ALL:
+        if (player && k == 0 && ufo->active)
+        {
+            *x = ufo->x + ufo->width / 2.0f;
+            *y = ufo->y + ufo->height / 2.0f;
+            placed = true;
+        }
+        else if (k % 3 == 0)
+            placed = spot_formation(model, alive, alive_n, k / 3, x, y);
+        else if (k % 3 == 1)
+            placed = spot_shield(model, k / 3, x, y);
+        break;
+    default:
+        break;
+    }
+    if (!placed)
+        spot_field(k, n, player, x, y);
+}
+
+/**
+ * @brief Remplit toutes les places libres d'un camp.
+ */
+static void fill_side(GameModel *model, StressScenario s, int side, const int *alive, int alive_n)
+{
+    BulletPool *p = &model->sim.bullets;
+    bool player = side == BULLET_SIDE_PLAYER;
+    EntityType type = player ? ENTITY_BULLET_PLAYER : ENTITY_BULLET_ENEMY;
+    float dy = player ? -model->sim.params.bullet_speed : model->sim.params.bullet_speed * 0.6f;
+    int n = p->free_count[side];
+    for (int k = 0; k < n; k++)
+    {
+        float x, y;
+        bullet_spot(model, s, player, k, n, alive, alive_n, &x, &y);
+        model_spawn_bullet(model, x, y, dy, type);
+    }
+}
+
+// ============================================================================
+//                          3. VAGUE, OVNI ET BONUS
+// ============================================================================
+
+/**
+ * @brief Un alien vivant sur deux passe en explosion, chacun dans son créneau de la roue.
+ *
+ * Les durées sont toutes différentes (celle du type, plus le rang) : aucun
+ * créneau n'est partagé, la roue est aussi longue que possible.
+ */
+static void explode_half(GameModel *model)
+{
+    Formation *f = &model->sim.formation;
+    int alive[FORMATION_SIZE];
+    int n = alive_enemies(model, alive);
+    for (int k = 0; k < n; k += 2)
+    {
+        int i = alive[k];
+        model->sim.enemies.x[i] = model_get_enemy_x(model, i);
+        model->sim.enemies.y[i] = model_get_enemy_y(model, i);
+        f->alive_mask &= ~(1ULL << i);
+        f->dying_mask |= 1ULL << i;
+        float seconds = entity_types[model->sim.enemies.type[i]].explode_time;
+        model_add_enemy_explosion(model, i, model_countdown_ticks(model, seconds) + k / 2 + 1);
+    }
+}
+
+/**
+ * @brief OVNI en vol au milieu du terrain.
+ */
+static void launch_ufo(GameModel *model)
+{
+    Ufo *ufo = &model->sim.ufo;
+    ufo->active = true;
+    ufo->hasSpawnedThisLevel = true;
+    ufo->exploding = false;
+    ufo->explode_timer = 0;
+    ufo->type = ENTITY_UFO;
+    ufo->width = UFO_WIDTH;
+    ufo->height = UFO_HEIGHT;
+    ufo->x = (GAME_WIDTH - UFO_WIDTH) / 2.0f;
+    ufo->y = 4.0f;
+    ufo->dx = model->sim.params.ufo_speed;
+}
+
+/**
+ * @brief Remplit le registre de bonus qui tombent, répartis dans la largeur du terrain.
+ */
+static void fill_powerups(GameModel *model)
+{
+    static const EntityType kinds[] = {ENTITY_POWERUP_RAPID, ENTITY_POWERUP_SPREAD, ENTITY_POWERUP_REPAIR};
+    for (int k = 0; k < ECS_MAX_ENTITIES; k++)
+    {
+        float x = (float)(k * GAME_WIDTH / ECS_MAX_ENTITIES);
+        if (!model_add_powerup(model, x, GAME_HEIGHT / 2.0f + (k % 8), kinds[k % 3]))
+            break;
+    }
+}
+
+// ============================================================================
+//                          4. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Nom court d'un scénario.
+ */
+const char *stress_name(StressScenario s)
+{
+    return (s >= 0 && s < STRESS_COUNT) ? stress_names[s] : stress_names[STRESS_NONE];
+}
+
+/**
+ * @brief Scénario d'après son nom court.
+ */
+StressScenario stress_parse(const char *name)
+{
+    for (int s = 0; name && s < STRESS_COUNT; s++)
+        if (strcmp(name, stress_names[s]) == 0)
+            return (StressScenario)s;
+    return STRESS_NONE;
+}
+
+/**
+ * @brief Compose un scénario : vague et OVNI d'abord, index reconstruits, puis le pool rempli.
+ */
+void stress_build(GameModel *model, StressScenario s)
+{
+    if (s <= STRESS_NONE || s >= STRESS_COUNT)
+        return;
+
+    model->sim.level = STRESS_LEVEL;
+    model_clear_bullets(model);
+    if (s == STRESS_UFO || s == STRESS_ALL)
+    {
+        explode_half(model);
+        launch_ufo(model);
+        fill_powerups(model);
+    }
+    model_rebuild_indexes(model); // Constantes du niveau, piles libres, caches de la vague
+
+    int alive[FORMATION_SIZE];
+    int alive_n = alive_enemies(model, alive);
+    fill_side(model, s, BULLET_SIDE_PLAYER, alive, alive_n);
+    fill_side(model, s, BULLET_SIDE_ENEMY, alive, alive_n);
+
+    // Le tick suivant tente encore de tirer, des deux côtés : pool plein, tirs perdus
+    int powerup = model_countdown_ticks(model, POWERUP_TIME);
+    model->sim.player.shoot_timer = 0;
+    model->sim.rapid_timer = powerup;
+    model->sim.spread_timer = powerup;
+    model->sim.fire_timer = 0.0f;
+    model->sim.hit_timer = 0;
+}
+
+/**
+ * @brief Tir maintenu, vaisseau vers la gauche.
+ */
+GameCommand stress_command(void)
+{
+    return command_held(INPUT_LEFT | INPUT_FIRE);
+}
@@ -0,0 +1,231 @@
+/**
+ * @file suspend.c
+ * @brief Implémentation de la mise en veille sur disque.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2008 (requis pour sigaction, SA_RESETHAND et fsync).
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "suspend.h"
+#include "logger.h"
+#include "save.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/** @brief Signaux de mise en veille. */
+static const int suspend_signals[] = {SIGTERM, SIGHUP};
+#define SUSPEND_SIGNAL_COUNT ((int)(sizeof(suspend_signals) / sizeof(suspend_signals[0])))
+
+/** @brief Mise en veille écrite par le gestionnaire de signal. */
+static Suspend *active_suspend = NULL;
+
+/** @brief Gestionnaires en place avant suspend_init, rendus par suspend_close. */
+static struct sigaction old_actions[SUSPEND_SIGNAL_COUNT];
+
+/** @brief Un signal a été reçu (suspend_requested). */
+static volatile sig_atomic_t stop_requested = 0;
+
+/**
+ * @brief Écrit tout le tampon, en reprenant les écritures partielles ou interrompues.
+ */
+static bool write_all(int fd, const uint8_t *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(fd, data, len);
+        if (n < 0)
+            return false;
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Écrit l'instantané publié à côté du fichier de veille, puis le renomme par-dessus.
+ */
+static void write_published(Suspend *s)
+{
+    int k = __atomic_load_n(&s->published, __ATOMIC_ACQUIRE) - 1;
+    if (k < 0)
+        return;
+
+    int fd = open(s->tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return;
+    bool ok = write_all(fd, s->buffers[k], s->sizes[k]) && fsync(fd) == 0;
+    close(fd);
+    if (ok)
+        rename(s->tmp_path, s->path);
+    else
+        unlink(s->tmp_path);
+}
+
+/**
+ * @brief SIGTERM ou SIGHUP : écrit l'instantané publié, puis demande l'arrêt de la boucle.
+ *
+ * Uniquement des appels sûrs dans un gestionnaire (open, write, fsync,
+ * close, rename) sur des chemins et un tampon préparés d'avance. Le tampon
+ * publié n'est plus réécrit avant deux ticks : l'encodage en cours, s'il y
+ * en a un, vise l'autre. SA_RESETHAND rend son effet par défaut au signal :
+ * un second SIGTERM termine le processus. `errno` est rendu tel quel au
+ * thread interrompu, qui peut être en train de le lire après un appel.
+ */
+static void on_suspend_signal(int sig)
+{
+    (void)sig;
+    int saved_errno = errno;
+    Suspend *s = active_suspend;
+    active_suspend = NULL;
+    stop_requested = 1;
+    if (s)
+        write_published(s);
+    errno = saved_errno;
+}
+
+/**
+ * @brief Encode l'instantané dans le tampon non publié, puis le publie.
+ */
+static void publish(Suspend *suspend, const GameModel *model)
+{
+    int k = __atomic_load_n(&suspend->published, __ATOMIC_RELAXED) == 1 ? 1 : 0;
+    size_t n = save_encode_snapshot(model, suspend->buffers[k], suspend->cap);
+    if (n == 0)
+        return;
+    suspend->sizes[k] = n;
+    __atomic_store_n(&suspend->published, k + 1, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Tampons à la taille d'un instantané de ce modèle, chemins préformatés, gestionnaires.
+ */
+bool suspend_init(Suspend *suspend, const GameModel *model, const char *dir)
+{
+    memset(suspend, 0, sizeof(Suspend));
+    const char *env = getenv("SPACE_INVADERS_SUSPEND");
+    if (env && strcmp(env, "0") == 0)
+        return false;
+
+    suspend->cap = 8192 + (size_t)model->sim.bullets.capacity * SAVE_BULLET_SIZE +
+                   MODEL_LEVEL_STARTS * (MODEL_LEVEL_START_BYTES + 6);
+    for (int k = 0; k < 2; k++)
+    {
+        suspend->buffers[k] = malloc(suspend->cap);
+        if (!suspend->buffers[k])
+        {
+            suspend_close(suspend);
+            return false;
+        }
+    }
+    snprintf(suspend->path, sizeof(suspend->path), "%s/%s", dir, SUSPEND_FILE);
+    snprintf(suspend->tmp_path, sizeof(suspend->tmp_path), "%s/%s.tmp", dir, SUSPEND_FILE);
+    mkdir(dir, 0777);
+    if (model->sim.state == STATE_PAUSED)
+        publish(suspend, model); // Partie reprise par suspend_resume : à réécrire même sans tick joué
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_suspend_signal;
+    sa.sa_flags = SA_RESETHAND;
+    sigemptyset(&sa.sa_mask);
+    for (int k = 0; k < SUSPEND_SIGNAL_COUNT; k++)
+        sigaddset(&sa.sa_mask, suspend_signals[k]);
+    stop_requested = 0;
+    active_suspend = suspend;
+    for (int k = 0; k < SUSPEND_SIGNAL_COUNT; k++)
+        sigaction(suspend_signals[k], &sa, &old_actions[k]);
+    suspend->active = true;
+    return true;
+}
+
+/**
+ * @brief Publie l'instantané en partie, retire la publication hors partie.
+ */
+void suspend_update(Suspend *suspend, const GameModel *model)
+{
+    if (!suspend->active)
+        return;
+    switch (model->sim.state)
+    {
+    case STATE_PLAYING:
+        break;
+    case STATE_MENU:
+    case STATE_TUTORIAL:
+    case STATE_GAME_OVER:
+    case STATE_VICTORY:
+    case STATE_LOAD_MENU:
+        __atomic_store_n(&suspend->published, 0, __ATOMIC_RELEASE); // Plus de partie à reprendre
+        return;
+    default:
+        return; // Pause, sauvegarde : la partie reprendra du dernier tick joué
+    }
+    publish(suspend, model);
+}
+
+/**
+ * @brief Un signal de mise en veille a été reçu.
+ */
+bool suspend_requested(void)
+{
+    return stop_requested != 0;
+}
+
+/**
+ * @brief Restaure `dir/suspend.snap` en pause, puis le supprime.
+ */
+bool suspend_resume(GameModel *model, const char *dir)
+{
+    char path[SUSPEND_PATH_LEN];
+    snprintf(path, sizeof(path), "%s/%s", dir, SUSPEND_FILE);
+    SaveMapping map;
+    if (!save_map_file(path, &map))
+        return false;
+    bool ok = save_decode_snapshot(model, map.data, map.len);
+    save_unmap_file(&map);
+    remove(path); // Reprise unique : un fichier illisible ne bloque pas les lancements suivants
+
+    if (!ok)
+    {
+        logger_write(LOG_ERROR, "[ERREUR] Mise en veille illisible : %s\n", path);
+        return false;
+    }
+    model->sim.state = STATE_PAUSED;
+    model->ui.menu_selection = 0;
+    memset(&model->ui.sounds, 0, sizeof(SoundState));
+    logger_write(LOG_INFO, "[SYSTEM] Reprise de la partie mise en veille (niveau %d, score %d)\n", model->sim.level,
+                 model->sim.score);
+    return true;
+}
+
+/**
+ * @brief Gestionnaires d'origine, tampons libérés.
+ */
+void suspend_close(Suspend *suspend)
+{
+    if (suspend->active)
+    {
+        active_suspend = NULL;
+        for (int k = 0; k < SUSPEND_SIGNAL_COUNT; k++)
+            sigaction(suspend_signals[k], &old_actions[k], NULL);
+    }
+    for (int k = 0; k < 2; k++)
+        free(suspend->buffers[k]);
+    memset(suspend, 0, sizeof(Suspend));
+}
@@ -0,0 +1,658 @@
+/**
+ * @file telemetry.c
+ * @brief Implémentation du journal de télémétrie et de son agrégation.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread, mmap et posix_madvise).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "telemetry.h"
+#include "utils.h"
+#include "workers.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define TELEMETRY_BATCH 256 ///< Événements écrits par appel à fwrite.
+
+/** @brief Noms des événements dans le CSV (indice : TelemetryEventType). */
+static const char *const event_names[TELEMETRY_EVENT_COUNT] = {
+    "debut", "tir", "alien", "ovni_apparition", "ovni_abattu", "mort", "niveau", "fin"};
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t get_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Un événement au format du disque.
+ */
+static void encode_event(uint8_t *p, const TelemetryEvent *e)
+{
+    put_le32(p, e->tick);
+    p[4] = e->type;
+    p[5] = e->kind;
+    p[6] = e->level;
+    p[7] = e->lives;
+    put_le16(p + 8, (uint16_t)e->x);
+    put_le16(p + 10, (uint16_t)e->y);
+    put_le32(p + 12, (uint32_t)e->score);
+}
+
+static void decode_event(const uint8_t *p, TelemetryEvent *e)
+{
+    e->tick = get_le32(p);
+    e->type = p[4];
+    e->kind = p[5];
+    e->level = p[6];
+    e->lives = p[7];
+    e->x = (int16_t)get_le16(p + 8);
+    e->y = (int16_t)get_le16(p + 10);
+    e->score = (int32_t)get_le32(p + 12);
+}
+
+/**
+ * @brief Vide la file en lots de TELEMETRY_BATCH, puis pousse le tout vers le système.
+ */
+static void drain(TelemetryLog *log)
+{
+    uint8_t batch[TELEMETRY_BATCH * TELEMETRY_RECORD_SIZE];
+    TelemetryEvent e;
+    int n = 0;
+    bool any = false;
+    while (spsc_pop(&log->ring, &e))
+    {
+        encode_event(batch + n * TELEMETRY_RECORD_SIZE, &e);
+        if (++n == TELEMETRY_BATCH)
+        {
+            fwrite(batch, TELEMETRY_RECORD_SIZE, (size_t)n, log->file);
+            log->written += (uint64_t)n;
+            n = 0;
+        }
+        any = true;
+    }
+    if (n > 0)
+    {
+        fwrite(batch, TELEMETRY_RECORD_SIZE, (size_t)n, log->file);
+        log->written += (uint64_t)n;
+    }
+    if (any)
+        fflush(log->file);
+}
+
+/**
+ * @brief Thread d'écriture : un lot toutes les TELEMETRY_FLUSH_MS, un dernier à l'arrêt.
+ */
+static void *writer_main(void *arg)
+{
+    TelemetryLog *log = arg;
+    while (!__atomic_load_n(&log->stop, __ATOMIC_ACQUIRE))
+    {
+        drain(log);
+        utils_sleep_ms(TELEMETRY_FLUSH_MS);
+    }
+    drain(log);
+    return NULL;
+}
+
+/**
+ * @brief Agrégats d'un niveau, sur tous les journaux.
+ */
+typedef struct
+{
+    long reached;   ///< Parties qui ont joué ce niveau.
+    long ended;     ///< Parties finies (plus de vies) sur ce niveau.
+    long shots;     ///< Balles tirées.
+    long kills;     ///< Aliens et OVNI abattus.
+    long deaths;    ///< Vaisseaux touchés.
+    long long life; ///< Ticks de vie cumulés, morts sur ce niveau.
+} LevelStats;
+
+/**
+ * @brief Indice d'agrégation d'un niveau (1 à TELEMETRY_LEVELS, le dernier regroupe la suite).
+ */
+static int level_slot(int level)
+{
+    if (level < 1)
+        return 0;
+    return (level > TELEMETRY_LEVELS ? TELEMETRY_LEVELS : level) - 1;
+}
+
+/**
+ * @brief Partie en cours dans la lecture d'un journal.
+ */
+typedef struct
+{
+    bool in_game;        ///< Entre un début et une fin de partie.
+    int level;           ///< Niveau en cours.
+    uint32_t life_start; ///< Tick du début de la vie en cours.
+} LogCursor;
+
+/**
+ * @brief Compte un événement dans les agrégats par niveau.
+ */
+static void account_event(LogCursor *c, const TelemetryEvent *e, LevelStats *levels, long *games)
+{
+    LevelStats *l = &levels[level_slot(e->level)];
+    switch (e->type)
+    {
+    case TELEMETRY_GAME_START:
+        c->in_game = true;
+        c->level = e->level;
+        c->life_start = e->tick;
+        (*games)++;
+        l->reached++;
+        break;
+    case TELEMETRY_LEVEL_UP:
+        if (c->in_game && e->level != c->level)
+            l->reached++;
+        c->level = e->level;
+        break;
+    case TELEMETRY_SHOT:
+        l->shots += e->kind;
+        break;
+    case TELEMETRY_KILL:
+    case TELEMETRY_UFO_KILL:
+        l->kills++;
+        break;
+    case TELEMETRY_DEATH:
+        l->deaths++;
+        l->life += (long long)(e->tick - c->life_start);
+        c->life_start = e->tick;
+        break;
+    case TELEMETRY_GAME_OVER:
+        if (c->in_game)
+            l->ended++;
+        c->in_game = false;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief En-tête d'un journal : signature, version et taille d'enregistrement attendues.
+ */
+static bool header_ok(const uint8_t *header)
+{
+    return memcmp(header, TELEMETRY_MAGIC, 4) == 0 && get_le16(header + 4) == TELEMETRY_VERSION &&
+           get_le16(header + 6) == TELEMETRY_RECORD_SIZE;
+}
+
+/**
+ * @brief Lit un journal : une ligne CSV par événement, agrégats par niveau.
+ *
+ * @return false si l'en-tête est absent ou invalide.
+ */
+static bool export_log(const char *path, int session, FILE *csv, LevelStats *levels, long *games, long *events)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    uint8_t header[TELEMETRY_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) || !header_ok(header))
+    {
+        fclose(f);
+        return false;
+    }
+
+    uint8_t rec[TELEMETRY_RECORD_SIZE];
+    LogCursor cursor = {false, 1, 0};
+    while (fread(rec, 1, sizeof(rec), f) == sizeof(rec))
+    {
+        TelemetryEvent e;
+        decode_event(rec, &e);
+        if (e.type >= TELEMETRY_EVENT_COUNT)
+            continue;
+        fprintf(csv, "%d,%u,%s,%u,%u,%u,%d,%d,%d\n", session, e.tick, event_names[e.type], e.kind, e.level, e.lives,
+                e.x, e.y, e.score);
+        (*events)++;
+        account_event(&cursor, &e, levels, games);
+    }
+    fclose(f);
+    return true;
+}
+
+// ============================================================================
+//                          2. AGRÉGATION PARALLÈLE
+// ============================================================================
+
+#define SCAN_BATCH 64     ///< Journaux pris à la fois dans la liste partagée.
+#define SCAN_PATH_MAX 512 ///< Chemin d'un journal au plus.
+
+/** @brief Noms des types abattus dans `<prefixe>-types.csv`. */
+static const char *const kill_names[ENTITY_TYPE_COUNT] = {
+    [ENTITY_ENEMY_TYPE_1] = "pieuvre", [ENTITY_ENEMY_TYPE_2] = "crabe", [ENTITY_ENEMY_TYPE_3] = "calamar",
+    [ENTITY_UFO] = "ovni",             [ENTITY_BOSS_PART] = "amiral"};
+
+/**
+ * @brief Agrégats d'un thread (fusionnés à la fin : aucun verrou pendant la lecture).
+ */
+typedef struct
+{
+    long logs;                             ///< Journaux lus.
+    long unreadable;                       ///< Journaux illisibles.
+    long games;                            ///< Parties commencées.
+    uint64_t events;                       ///< Événements lus.
+    uint64_t bytes;                        ///< Octets projetés.
+    LevelStats levels[TELEMETRY_LEVELS];   ///< Agrégats par niveau.
+    uint64_t kills[ENTITY_TYPE_COUNT];     ///< Abattus, par type.
+    uint64_t heat[GAME_HEIGHT][GAME_WIDTH]; ///< Morts, par case du terrain.
+} AggPart;
+
+/**
+ * @brief Travail partagé : les sources (journaux ou dossiers), parcourues sous verrou par lots.
+ */
+typedef struct
+{
+    const char *const *sources; ///< Arguments.
+    int count;                  ///< Nombre d'arguments.
+    int next;                   ///< Prochain argument.
+    DIR *dir;                   ///< Dossier en cours de parcours (NULL : aucun).
+    const char *dir_path;       ///< Chemin de ce dossier.
+    pthread_mutex_t lock;       ///< Protège next, dir et dir_path.
+    AggPart *parts;             ///< Un agrégat par tâche.
+} AggJob;
+
+/**
+ * @brief Prend jusqu'à SCAN_BATCH chemins : les fichiers `.tlm` des dossiers, au fil de readdir.
+ *
+ * La liste n'est jamais construite en entier : des millions de journaux ne
+ * coûtent que le lot en cours de chaque thread.
+ *
+ * @return Nombre de chemins (0 : plus rien à lire).
+ */
+static int next_batch(AggJob *job, char (*paths)[SCAN_PATH_MAX])
+{
+    int n = 0;
+    pthread_mutex_lock(&job->lock);
+    while (n < SCAN_BATCH)
+    {
+        if (job->dir)
+        {
+            struct dirent *ent = readdir(job->dir);
+            if (!ent)
+            {
+                closedir(job->dir);
+                job->dir = NULL;
+                continue;
+            }
+            size_t len = strlen(ent->d_name);
+            if (len > 4 && strcmp(ent->d_name + len - 4, ".tlm") == 0)
+                snprintf(paths[n++], SCAN_PATH_MAX, "%s/%s", job->dir_path, ent->d_name);
+            continue;
+        }
+        if (job->next >= job->count)
+            break;
+        const char *src = job->sources[job->next++];
+        struct stat st;
+        if (stat(src, &st) == 0 && S_ISDIR(st.st_mode) && (job->dir = opendir(src)) != NULL)
+            job->dir_path = src;
+        else
+            snprintf(paths[n++], SCAN_PATH_MAX, "%s", src); // Fichier (ou absent : compté illisible)
+    }
+    pthread_mutex_unlock(&job->lock);
+    return n;
+}
+
+/**
+ * @brief Projette un journal en lecture séquentielle et en compte les événements.
+ *
+ * @return false si le fichier est absent, vide ou n'est pas un journal.
+ */
+static bool aggregate_log(const char *path, AggPart *part)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < TELEMETRY_HEADER_SIZE)
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    const uint8_t *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // La projection garde le fichier
+    if (map == MAP_FAILED)
+        return false;
+    posix_madvise((void *)map, size, POSIX_MADV_SEQUENTIAL); // Lecture anticipée, pages lues vite rendues
+    if (!header_ok(map))
+    {
+        munmap((void *)map, size);
+        return false;
+    }
+
+    LogCursor cursor = {false, 1, 0};
+    size_t records = (size - TELEMETRY_HEADER_SIZE) / TELEMETRY_RECORD_SIZE; // Lot tronqué : ignoré
+    for (size_t i = 0; i < records; i++)
+    {
+        TelemetryEvent e;
+        decode_event(map + TELEMETRY_HEADER_SIZE + i * TELEMETRY_RECORD_SIZE, &e);
+        if (e.type >= TELEMETRY_EVENT_COUNT)
+            continue;
+        part->events++;
+        account_event(&cursor, &e, part->levels, &part->games);
+        if (e.type == TELEMETRY_DEATH)
+        {
+            int x = e.x < 0 ? 0 : e.x >= GAME_WIDTH ? GAME_WIDTH - 1 : e.x;
+            int y = e.y < 0 ? 0 : e.y >= GAME_HEIGHT ? GAME_HEIGHT - 1 : e.y;
+            part->heat[y][x]++;
+        }
+        else if ((e.type == TELEMETRY_KILL || e.type == TELEMETRY_UFO_KILL) && e.kind < ENTITY_TYPE_COUNT)
+            part->kills[e.kind]++;
+    }
+    munmap((void *)map, size);
+    part->bytes += size;
+    return true;
+}
+
+/**
+ * @brief Une tâche : des lots de journaux jusqu'à épuisement des sources, dans son propre agrégat.
+ */
+static void aggregate_task(void *ctx, int task)
+{
+    AggJob *job = ctx;
+    AggPart *part = &job->parts[task];
+    char paths[SCAN_BATCH][SCAN_PATH_MAX]; // 32 Kio de pile
+    int n;
+    while ((n = next_batch(job, paths)) > 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (aggregate_log(paths[i], part))
+                part->logs++;
+            else
+                part->unreadable++;
+        }
+    }
+}
+
+/**
+ * @brief Ajoute l'agrégat d'une tâche au total.
+ */
+static void part_merge(AggPart *into, const AggPart *p)
+{
+    into->logs += p->logs;
+    into->unreadable += p->unreadable;
+    into->games += p->games;
+    into->events += p->events;
+    into->bytes += p->bytes;
+    for (int l = 0; l < TELEMETRY_LEVELS; l++)
+    {
+        LevelStats *a = &into->levels[l];
+        const LevelStats *b = &p->levels[l];
+        a->reached += b->reached;
+        a->ended += b->ended;
+        a->shots += b->shots;
+        a->kills += b->kills;
+        a->deaths += b->deaths;
+        a->life += b->life;
+    }
+    for (int k = 0; k < ENTITY_TYPE_COUNT; k++)
+        into->kills[k] += p->kills[k];
+    for (int y = 0; y < GAME_HEIGHT; y++)
+        for (int x = 0; x < GAME_WIDTH; x++)
+            into->heat[y][x] += p->heat[y][x];
+}
+
+/**
+ * @brief Carte des morts : une ligne CSV par rangée du terrain, et une image PGM (échelle logarithmique).
+ */
+static bool write_heatmap(const char *prefix, const AggPart *t)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s-morts.csv", prefix);
+    FILE *csv = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s-morts.pgm", prefix);
+    FILE *pgm = fopen(path, "wb");
+    if (!csv || !pgm)
+    {
+        if (csv)
+            fclose(csv);
+        if (pgm)
+            fclose(pgm);
+        return false;
+    }
+    uint64_t max = 0;
+    fprintf(csv, "y");
+    for (int x = 0; x < GAME_WIDTH; x++)
+        fprintf(csv, ",%d", x);
+    fprintf(csv, "\n");
+    for (int y = 0; y < GAME_HEIGHT; y++)
+    {
+        fprintf(csv, "%d", y);
+        for (int x = 0; x < GAME_WIDTH; x++)
+        {
+            fprintf(csv, ",%llu", (unsigned long long)t->heat[y][x]);
+            if (t->heat[y][x] > max)
+                max = t->heat[y][x];
+        }
+        fprintf(csv, "\n");
+    }
+    fclose(csv);
+
+    fprintf(pgm, "P5\n%d %d\n255\n", GAME_WIDTH, GAME_HEIGHT);
+    for (int y = 0; y < GAME_HEIGHT; y++)
+    {
+        uint8_t row[GAME_WIDTH];
+        for (int x = 0; x < GAME_WIDTH; x++)
+            row[x] = max > 0 ? (uint8_t)(255.0 * log1p((double)t->heat[y][x]) / log1p((double)max) + 0.5) : 0;
+        fwrite(row, 1, sizeof(row), pgm);
+    }
+    fclose(pgm);
+    return true;
+}
+
+/**
+ * @brief Abattus par type, et courbe de survie par niveau.
+ */
+static bool write_tables(const char *prefix, const AggPart *t)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s-types.csv", prefix);
+    FILE *types = fopen(path, "w");
+    if (!types)
+        return false;
+    uint64_t total = 0;
+    for (int k = 0; k < ENTITY_TYPE_COUNT; k++)
+        total += t->kills[k];
+    fprintf(types, "type,nom,abattus,part,par_partie\n");
+    for (int k = 0; k < ENTITY_TYPE_COUNT; k++)
+    {
+        if (!kill_names[k] && t->kills[k] == 0)
+            continue;
+        fprintf(types, "%d,%s,%llu,%.4f,%.3f\n", k, kill_names[k] ? kill_names[k] : "?",
+                (unsigned long long)t->kills[k], total > 0 ? (double)t->kills[k] / (double)total : 0.0,
+                t->games > 0 ? (double)t->kills[k] / (double)t->games : 0.0);
+    }
+    fclose(types);
+
+    snprintf(path, sizeof(path), "%s-survie.csv", prefix);
+    FILE *lv = fopen(path, "w");
+    if (!lv)
+        return false;
+    fprintf(lv, "niveau,parties,survie,fins,risque,tirs,abattus,reussite,morts,ticks_par_vie\n");
+    for (int l = 0; l < TELEMETRY_LEVELS; l++)
+    {
+        const LevelStats *s = &t->levels[l];
+        if (s->reached == 0 && s->shots == 0 && s->deaths == 0)
+            continue;
+        fprintf(lv, "%d,%ld,%.4f,%ld,%.4f,%ld,%ld,%.4f,%ld,%.1f\n", l + 1, s->reached,
+                t->games > 0 ? (double)s->reached / (double)t->games : 0.0, s->ended,
+                s->reached > 0 ? (double)s->ended / (double)s->reached : 0.0, s->shots, s->kills,
+                s->shots > 0 ? (double)s->kills / (double)s->shots : 0.0, s->deaths,
+                s->deaths > 0 ? (double)s->life / (double)s->deaths : 0.0);
+    }
+    fclose(lv);
+    return true;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief En-tête écrit tout de suite : un journal vide reste un journal valide.
+ */
+bool telemetry_open(TelemetryLog *log, const char *path, uint64_t seed)
+{
+    memset(log, 0, sizeof(*log));
+    log->file = fopen(path, "wb");
+    if (!log->file)
+        return false;
+    snprintf(log->path, sizeof(log->path), "%s", path);
+
+    uint8_t header[TELEMETRY_HEADER_SIZE];
+    memcpy(header, TELEMETRY_MAGIC, 4);
+    put_le16(header + 4, TELEMETRY_VERSION);
+    put_le16(header + 6, TELEMETRY_RECORD_SIZE);
+    put_le32(header + 8, (uint32_t)seed);
+    put_le32(header + 12, (uint32_t)(seed >> 32));
+    fwrite(header, 1, sizeof(header), log->file);
+    fflush(log->file);
+
+    spsc_init(&log->ring, log->storage, sizeof(TelemetryEvent), TELEMETRY_RING);
+    if (pthread_create(&log->thread, NULL, writer_main, log) != 0)
+    {
+        fclose(log->file);
+        log->file = NULL;
+        return false;
+    }
+    log->active = true;
+    return true;
+}
+
+/**
+ * @brief Dernier lot, arrêt du thread, bilan sur la sortie standard.
+ */
+void telemetry_close(TelemetryLog *log)
+{
+    if (!log->active)
+        return;
+    __atomic_store_n(&log->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(log->thread, NULL);
+    fclose(log->file);
+    log->file = NULL;
+    log->active = false;
+    printf("Telemetrie : %llu evenement(s) dans %s", (unsigned long long)log->written, log->path);
+    if (log->ring.dropped > 0)
+        printf(" (%u perdu(s), file pleine)", log->ring.dropped);
+    printf("\n");
+}
+
+/**
+ * @brief Lit chaque journal, écrit les événements au fil de l'eau, puis le tableau par niveau.
+ */
+int telemetry_export(const char *prefix, const char *const *paths, int count)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s.csv", prefix);
+    FILE *csv = fopen(path, "w");
+    if (!csv)
+        return -1;
+    fprintf(csv, "session,tick,evenement,precision,niveau,vies,x,y,score\n");
+
+    static LevelStats levels[TELEMETRY_LEVELS];
+    memset(levels, 0, sizeof(levels));
+    long games = 0, events = 0;
+    int read = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (export_log(paths[i], i, csv, levels, &games, &events))
+            read++;
+        else
+            fprintf(stderr, "[TELEMETRIE] Journal illisible : %s\n", paths[i]);
+    }
+    fclose(csv);
+
+    snprintf(path, sizeof(path), "%s-niveaux.csv", prefix);
+    FILE *lv = fopen(path, "w");
+    if (!lv)
+        return -1;
+    fprintf(lv, "niveau,parties,survie,tirs,abattus,reussite,morts,ticks_par_vie\n");
+    for (int l = 0; l < TELEMETRY_LEVELS; l++)
+    {
+        const LevelStats *s = &levels[l];
+        if (s->reached == 0 && s->shots == 0 && s->deaths == 0)
+            continue;
+        fprintf(lv, "%d,%ld,%.4f,%ld,%ld,%.4f,%ld,%.1f\n", l + 1, s->reached,
+                games > 0 ? (double)s->reached / (double)games : 0.0, s->shots, s->kills,
+                s->shots > 0 ? (double)s->kills / (double)s->shots : 0.0, s->deaths,
+                s->deaths > 0 ? (double)s->life / (double)s->deaths : 0.0);
+    }
+    fclose(lv);
+    printf("[TELEMETRIE] %d journal(aux), %ld partie(s), %ld evenement(s) : %s.csv, %s\n", read, games, events,
+           prefix, path);
+    return read;
+}
+
+/**
+ * @brief Une tâche par thread de calcul, chacune dans son agrégat ; fusion, puis les fichiers.
+ */
+long telemetry_aggregate(const char *prefix, const char *const *sources, int count)
+{
+    int tasks = workers_threads();
+    AggJob job = {sources, count, 0, NULL, NULL, PTHREAD_MUTEX_INITIALIZER, calloc((size_t)tasks, sizeof(AggPart))};
+    AggPart *total = calloc(1, sizeof(AggPart));
+    if (!job.parts || !total)
+    {
+        free(job.parts);
+        free(total);
+        return -1;
+    }
+    double start = utils_get_time();
+    bool parallel = workers_run(aggregate_task, &job, tasks);
+    if (!parallel)
+        aggregate_task(&job, 0); // Pool désactivé ou occupé : tout sur place
+    for (int i = 0; i < tasks; i++)
+        part_merge(total, &job.parts[i]);
+    double elapsed = utils_get_time() - start;
+    pthread_mutex_destroy(&job.lock);
+
+    bool written = write_heatmap(prefix, total) && write_tables(prefix, total);
+    long logs = total->logs;
+    if (written)
+    {
+        printf("[TELEMETRIE] %ld journal(aux), %ld illisible(s), %ld partie(s), %llu evenement(s)\n", total->logs,
+               total->unreadable, total->games, (unsigned long long)total->events);
+        printf("[TELEMETRIE] %.1f Mo en %.2f s sur %d thread(s) (%.0f journaux/s, %.0f Mo/s)\n",
+               total->bytes / (1024.0 * 1024.0), elapsed, parallel ? tasks : 1,
+               elapsed > 0.0 ? (double)(total->logs + total->unreadable) / elapsed : 0.0,
+               elapsed > 0.0 ? total->bytes / (1024.0 * 1024.0) / elapsed : 0.0);
+        printf("[TELEMETRIE] %s-morts.csv, %s-morts.pgm, %s-types.csv, %s-survie.csv\n", prefix, prefix, prefix,
+               prefix);
+    }
+    free(job.parts);
+    free(total);
+    return written ? logs : -1;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file texcache.c
+ * @brief Implémentation du cache disque des images converties.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour mmap, stat et mkdir).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "texcache.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief En-tête d'un fichier de cache.
+ */
+typedef struct
+{
+    char magic[4];      ///< TEXCACHE_MAGIC.
+    uint32_t version;   ///< TEXCACHE_VERSION.
+    uint64_t stamp;     ///< Tailles et dates des sources (cf. texcache.h).
+    uint64_t content;   ///< Hachage du contenu des sources.
+    uint32_t w, h;      ///< Dimensions.
+    uint32_t pitch;     ///< Octets par ligne.
+    uint32_t format;    ///< Format SDL des pixels.
+    uint32_t meta_size; ///< Octets de métadonnées, juste après l'en-tête.
+    uint32_t pixels;    ///< Position des pixels (multiple de TEXCACHE_ALIGN).
+} TexcacheHeader;
+
+/**
+ * @brief Dossier du cache (SPACE_INVADERS_CACHE, sinon TEXCACHE_DIR).
+ */
+static const char *cache_dir(void)
+{
+    const char *dir = getenv("SPACE_INVADERS_CACHE");
+    return (dir && *dir) ? dir : TEXCACHE_DIR;
+}
+
+/**
+ * @brief Chemin du fichier d'une clé.
+ */
+static void entry_path(char *out, size_t cap, const char *key)
+{
+    snprintf(out, cap, "%s/%s.tex", cache_dir(), key);
+}
+
+/**
+ * @brief Empreinte rapide : taille et date de chaque source (0 si l'une manque).
+ */
+static uint64_t sources_stamp(const char *const *sources, int count, uint64_t salt)
+{
+    uint64_t h = texcache_hash(&salt, sizeof(salt), TEXCACHE_HASH_SEED);
+    for (int i = 0; i < count; i++)
+    {
+        struct stat st;
+        if (stat(sources[i], &st) != 0)
+            return 0;
+        int64_t v[2] = {(int64_t)st.st_size, (int64_t)st.st_mtime};
+        h = texcache_hash(sources[i], strlen(sources[i]), h);
+        h = texcache_hash(v, sizeof(v), h);
+    }
+    return h;
+}
+
+/**
+ * @brief Hachage du contenu des sources (0 si l'une est illisible).
+ */
+static uint64_t sources_content(const char *const *sources, int count, uint64_t salt)
+{
+    uint64_t h = texcache_hash(&salt, sizeof(salt), TEXCACHE_HASH_SEED);
+    uint8_t buf[16384];
+    for (int i = 0; i < count; i++)
+    {
+        FILE *f = fopen(sources[i], "rb");
+        if (!f)
+            return 0;
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+            h = texcache_hash(buf, n, h);
+        fclose(f);
+    }
+    return h;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Hachage FNV-1a 64 bits.
+ */
+uint64_t texcache_hash(const void *data, size_t size, uint64_t h)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
+/**
+ * @brief Projette l'entrée, vérifie son format puis ses sources.
+ *
+ * Si seules les dates ont changé et que le contenu est identique, l'empreinte
+ * enregistrée est mise à jour : le hachage complet n'est refait qu'une fois.
+ */
+bool texcache_open(TexcacheEntry *e, const char *key, const char *const *sources, int count, uint64_t salt)
+{
+    memset(e, 0, sizeof(*e));
+    char path[512];
+    entry_path(path, sizeof(path), key);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TexcacheHeader))
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    TexcacheHeader h;
+    memcpy(&h, map, sizeof(h));
+    bool ok = memcmp(h.magic, TEXCACHE_MAGIC, 4) == 0 && h.version == TEXCACHE_VERSION &&
+              sizeof(h) + h.meta_size <= h.pixels && h.pixels <= size &&
+              (uint64_t)h.pitch * h.h <= size - h.pixels;
+    uint64_t stamp = ok ? sources_stamp(sources, count, salt) : 0;
+    ok = ok && stamp != 0;
+    if (ok && stamp != h.stamp)
+    {
+        // Sources touchées : seul leur contenu fait foi
+        ok = sources_content(sources, count, salt) == h.content;
+        FILE *f = ok ? fopen(path, "r+b") : NULL;
+        if (f)
+        {
+            h.stamp = stamp;
+            fwrite(&h, sizeof(h), 1, f);
+            fclose(f);
+        }
+    }
+    if (!ok)
+    {
+        munmap(map, size);
+        return false;
+    }
+
+    e->map = map;
+    e->map_size = size;
+    e->pixels = (const uint8_t *)map + h.pixels;
+    e->w = (int)h.w;
+    e->h = (int)h.h;
+    e->pitch = (int)h.pitch;
+    e->format = (SDL_PixelFormat)h.format;
+    e->meta = (const uint8_t *)map + sizeof(h);
+    e->meta_size = h.meta_size;
+    return true;
+}
+
+/**
+ * @brief Convertit l'image, puis écrit en-tête, métadonnées et pixels.
+ */
+bool texcache_store(const char *key, const char *const *sources, int count, uint64_t salt,
+                    SDL_Surface *image, const void *meta, uint32_t meta_size)
+{
+    uint64_t stamp = sources_stamp(sources, count, salt);
+    if (!image || stamp == 0)
+        return false;
+    SDL_Surface *px = (image->format == SDL_PIXELFORMAT_ARGB8888) ? image : SDL_ConvertSurface(image, SDL_PIXELFORMAT_ARGB8888);
+    if (!px)
+        return false;
+
+    TexcacheHeader h = {{'S', 'I', 'T', 'X'}, TEXCACHE_VERSION, stamp, sources_content(sources, count, salt),
+                        (uint32_t)px->w, (uint32_t)px->h, (uint32_t)px->pitch, (uint32_t)px->format, meta_size, 0};
+    h.pixels = (uint32_t)((sizeof(h) + meta_size + TEXCACHE_ALIGN - 1) / TEXCACHE_ALIGN * TEXCACHE_ALIGN);
+
+    char path[512], tmp[520];
+    mkdir(cache_dir(), 0777);
+    entry_path(path, sizeof(path), key);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    bool ok = f != NULL;
+    if (f)
+    {
+        static const uint8_t zeros[TEXCACHE_ALIGN] = {0};
+        size_t pad = h.pixels - sizeof(h) - meta_size;
+        size_t bytes = (size_t)px->pitch * (size_t)px->h;
+        ok = fwrite(&h, sizeof(h), 1, f) == 1 && (meta_size == 0 || fwrite(meta, meta_size, 1, f) == 1) &&
+             fwrite(zeros, 1, pad, f) == pad && fwrite(px->pixels, 1, bytes, f) == bytes;
+        ok = (fclose(f) == 0) && ok;
+        if (!ok || rename(tmp, path) != 0)
+        {
+            remove(tmp);
+            ok = false;
+        }
+    }
+    if (px != image)
+        SDL_DestroySurface(px);
+    return ok;
+}
+
+/**
+ * @brief Libère la projection.
+ */
+void texcache_release(TexcacheEntry *e)
+{
+    if (e->map)
+        munmap(e->map, e->map_size);
+    memset(e, 0, sizeof(*e));
+}
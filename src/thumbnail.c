@@ -0,0 +1,292 @@
+/**
+ * @file thumbnail.c
+ * @brief Implémentation du thread d'encodage et de relecture des miniatures.
+ */
+
+#include "thumbnail.h"
+
+#include <SDL3_image/SDL_image.h>
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. ÉTAT PARTAGÉ
+// ============================================================================
+
+/**
+ * @brief Image en attente d'écriture.
+ */
+typedef struct
+{
+    SDL_Surface *surface;          ///< Pixels relus (libérés après l'écriture).
+    char path[THUMBNAIL_PATH_LEN]; ///< Fichier PNG de destination.
+} ThumbnailJob;
+
+static SDL_Mutex *lock = NULL;
+static SDL_Condition *cond = NULL; ///< Signale une demande, une fin de travail ou l'arrêt.
+static SDL_Thread *worker = NULL;
+static bool stop_requested = false;
+
+static ThumbnailJob queue[THUMBNAIL_QUEUE]; ///< File circulaire des écritures.
+static int queue_head = 0, queue_count = 0;
+static bool writing = false; ///< Une écriture sortie de la file est en cours.
+static bool loading = false; ///< Un décodage sorti de la file est en cours.
+static int failures = 0;     ///< Écritures échouées depuis le dernier thumbnail_flush.
+
+/**
+ * @brief Décodage terminé, en attente de thumbnail_take.
+ */
+typedef struct
+{
+    SDL_Surface *surface;          ///< Image décodée (NULL : fichier absent ou illisible).
+    char path[THUMBNAIL_PATH_LEN]; ///< Fichier demandé.
+} ThumbnailResult;
+
+static char loads[THUMBNAIL_LOADS][THUMBNAIL_PATH_LEN]; ///< File circulaire des décodages demandés.
+static int loads_head = 0, loads_count = 0;
+static ThumbnailResult results[THUMBNAIL_LOADS]; ///< File circulaire des décodages terminés.
+static int results_head = 0, results_count = 0;
+
+// ============================================================================
+//                          2. THREAD DE TRAVAIL
+// ============================================================================
+
+/**
+ * @brief Encode la surface dans "<chemin>.tmp" puis renomme le fichier.
+ */
+static void write_png(ThumbnailJob *job)
+{
+    char tmp[THUMBNAIL_PATH_LEN + 4];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", job->path);
+    if (!IMG_SavePNG(job->surface, tmp) || rename(tmp, job->path) != 0)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Thumbnail %s: %s", job->path, SDL_GetError());
+        remove(tmp);
+        SDL_LockMutex(lock);
+        failures++;
+        SDL_UnlockMutex(lock);
+    }
+    SDL_DestroySurface(job->surface);
+}
+
+/**
+ * @brief Boucle du thread : écritures d'abord (dans l'ordre), puis décodage.
+ */
+static int SDLCALL thumbnail_main(void *data)
+{
+    (void)data;
+    SDL_LockMutex(lock);
+    while (true)
+    {
+        while (!stop_requested && queue_count == 0 && loads_count == 0)
+            SDL_WaitCondition(cond, lock);
+        if (queue_count > 0)
+        {
+            ThumbnailJob job = queue[queue_head];
+            queue_head = (queue_head + 1) % THUMBNAIL_QUEUE;
+            queue_count--;
+            writing = true;
+            SDL_UnlockMutex(lock);
+            write_png(&job);
+            SDL_LockMutex(lock);
+            writing = false;
+            SDL_BroadcastCondition(cond);
+            continue;
+        }
+        if (loads_count > 0)
+        {
+            char path[THUMBNAIL_PATH_LEN];
+            snprintf(path, sizeof(path), "%s", loads[loads_head]);
+            loads_head = (loads_head + 1) % THUMBNAIL_LOADS;
+            loads_count--;
+            loading = true;
+            SDL_UnlockMutex(lock);
+            SDL_Surface *s = IMG_Load(path);
+            SDL_LockMutex(lock);
+            loading = false;
+            if (results_count == THUMBNAIL_LOADS) // File pleine : le plus ancien résultat est perdu
+            {
+                SDL_DestroySurface(results[results_head].surface);
+                results_head = (results_head + 1) % THUMBNAIL_LOADS;
+                results_count--;
+            }
+            ThumbnailResult *r = &results[(results_head + results_count) % THUMBNAIL_LOADS];
+            r->surface = s;
+            snprintf(r->path, sizeof(r->path), "%s", path);
+            results_count++;
+            continue;
+        }
+        break; // Arrêt demandé, plus rien à faire
+    }
+    SDL_UnlockMutex(lock);
+    return 0;
+}
+
+/**
+ * @brief Démarre le thread au premier besoin (verrou tenu).
+ */
+static bool ensure_worker(void)
+{
+    if (worker)
+        return true;
+    stop_requested = false;
+    worker = SDL_CreateThread(thumbnail_main, "thumbnails", NULL);
+    return worker != NULL;
+}
+
+/**
+ * @brief Crée le verrou et la condition une fois.
+ */
+static bool ensure_lock(void)
+{
+    if (!lock)
+        lock = SDL_CreateMutex();
+    if (!cond)
+        cond = SDL_CreateCondition();
+    return lock && cond;
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Met l'image en file d'écriture, sans attendre.
+ */
+bool thumbnail_save(SDL_Surface *surface, const char *path)
+{
+    if (!surface)
+        return false;
+    bool ok = ensure_lock();
+    if (ok)
+    {
+        SDL_LockMutex(lock);
+        ok = queue_count < THUMBNAIL_QUEUE && ensure_worker();
+        if (ok)
+        {
+            ThumbnailJob *job = &queue[(queue_head + queue_count) % THUMBNAIL_QUEUE];
+            job->surface = surface;
+            snprintf(job->path, sizeof(job->path), "%s", path);
+            queue_count++;
+            SDL_BroadcastCondition(cond);
+        }
+        SDL_UnlockMutex(lock);
+    }
+    if (!ok)
+        SDL_DestroySurface(surface);
+    return ok;
+}
+
+/**
+ * @brief Ajoute un décodage à la file ; la demande la plus ancienne cède sa place si elle est pleine.
+ */
+bool thumbnail_request(const char *path)
+{
+    if (!ensure_lock())
+        return false;
+    SDL_LockMutex(lock);
+    bool ok = ensure_worker();
+    if (ok)
+    {
+        if (loads_count == THUMBNAIL_LOADS)
+        {
+            loads_head = (loads_head + 1) % THUMBNAIL_LOADS;
+            loads_count--;
+        }
+        snprintf(loads[(loads_head + loads_count) % THUMBNAIL_LOADS], THUMBNAIL_PATH_LEN, "%s", path);
+        loads_count++;
+        SDL_BroadcastCondition(cond);
+    }
+    SDL_UnlockMutex(lock);
+    return ok;
+}
+
+/**
+ * @brief Oublie les décodages pas encore commencés.
+ */
+void thumbnail_cancel_loads(void)
+{
+    if (!lock)
+        return;
+    SDL_LockMutex(lock);
+    loads_count = 0;
+    SDL_UnlockMutex(lock);
+}
+
+/**
+ * @brief Vrai tant qu'un décodage est en file, en cours ou pas encore relevé.
+ */
+bool thumbnail_loading(void)
+{
+    if (!lock)
+        return false;
+    SDL_LockMutex(lock);
+    bool busy = loads_count > 0 || loading || results_count > 0;
+    SDL_UnlockMutex(lock);
+    return busy;
+}
+
+/**
+ * @brief Rend le plus ancien décodage terminé, une seule fois.
+ */
+bool thumbnail_take(char *path, size_t size, SDL_Surface **out)
+{
+    *out = NULL;
+    if (!lock)
+        return false;
+    SDL_LockMutex(lock);
+    bool ready = results_count > 0;
+    if (ready)
+    {
+        ThumbnailResult *r = &results[results_head];
+        snprintf(path, size, "%s", r->path);
+        *out = r->surface;
+        results_head = (results_head + 1) % THUMBNAIL_LOADS;
+        results_count--;
+    }
+    SDL_UnlockMutex(lock);
+    return ready;
+}
+
+/**
+ * @brief Attend que la file d'écriture soit vide et la dernière écriture finie.
+ */
+bool thumbnail_flush(void)
+{
+    if (!lock)
+        return true;
+    SDL_LockMutex(lock);
+    while (worker && (queue_count > 0 || writing))
+        SDL_WaitCondition(cond, lock);
+    bool ok = failures == 0;
+    failures = 0;
+    SDL_UnlockMutex(lock);
+    return ok;
+}
+
+/**
+ * @brief Écrit les images en attente, arrête le thread et libère l'état.
+ */
+void thumbnail_shutdown(void)
+{
+    if (!lock)
+        return;
+    SDL_LockMutex(lock);
+    stop_requested = true;
+    loads_count = 0;
+    SDL_BroadcastCondition(cond);
+    SDL_UnlockMutex(lock);
+
+    SDL_WaitThread(worker, NULL);
+    worker = NULL;
+    for (; results_count > 0; results_count--)
+    {
+        SDL_DestroySurface(results[results_head].surface);
+        results_head = (results_head + 1) % THUMBNAIL_LOADS;
+    }
+    SDL_DestroyCondition(cond);
+    SDL_DestroyMutex(lock);
+    cond = NULL;
+    lock = NULL;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file timeline.c
+ * @brief Implémentation des enchaînements scriptés.
+ */
+
+#include "timeline.h"
+
+#include <string.h>
+
+/**
+ * @brief Lance une transition.
+ */
+void timeline_start(Timeline *t, const TimelineStep *steps, int count, uint8_t tag)
+{
+    if (count > TIMELINE_MAX_STEPS)
+        count = TIMELINE_MAX_STEPS;
+    if (count < 0)
+        count = 0;
+    memset(t, 0, sizeof(*t));
+    memcpy(t->steps, steps, (size_t)count * sizeof(TimelineStep));
+    t->count = (uint8_t)count;
+    t->tag = tag;
+}
+
+/**
+ * @brief Une bascule reste à venir.
+ */
+bool timeline_before_switch(const Timeline *t)
+{
+    for (int i = t->step; i < t->count; i++)
+        if (t->steps[i].op == TIMELINE_SWITCH)
+            return true;
+    return false;
+}
+
+/**
+ * @brief Avance d'un tick ; franchit les étapes finies ou sans durée.
+ */
+TimelineOp timeline_tick(Timeline *t)
+{
+    if (!timeline_active(t))
+        return TIMELINE_NONE;
+    const TimelineStep *s = &t->steps[t->step];
+    if (s->op != TIMELINE_SWITCH && ++t->elapsed < s->ticks)
+        return TIMELINE_NONE;
+
+    // Étape finie : on passe aux suivantes, bascule comprise
+    TimelineOp event = TIMELINE_NONE;
+    if (s->op == TIMELINE_SWITCH)
+        event = TIMELINE_SWITCH;
+    t->step++;
+    t->elapsed = 0;
+    while (timeline_active(t) && event == TIMELINE_NONE &&
+           (t->steps[t->step].op == TIMELINE_SWITCH || t->steps[t->step].ticks == 0))
+    {
+        if (t->steps[t->step].op == TIMELINE_SWITCH)
+            event = TIMELINE_SWITCH;
+        t->step++;
+    }
+    return event;
+}
+
+/**
+ * @brief Saute jusqu'à la prochaine bascule (franchie au tick suivant).
+ */
+void timeline_skip(Timeline *t)
+{
+    while (timeline_active(t) && t->steps[t->step].op != TIMELINE_SWITCH)
+        t->step++;
+    t->elapsed = 0;
+}
+
+/**
+ * @brief Opacité du noir : fondu en cours, ou celle du dernier fondu (attente et bascule la gardent).
+ */
+float timeline_fade(const Timeline *t)
+{
+    if (!timeline_active(t))
+        return 0.0f;
+    for (int i = t->step; i >= 0; i--)
+    {
+        const TimelineStep *s = &t->steps[i];
+        float done = (i == t->step && s->ticks > 0) ? (float)t->elapsed / s->ticks : 1.0f;
+        if (s->op == TIMELINE_FADE_OUT)
+            return done;
+        if (s->op == TIMELINE_FADE_IN)
+            return 1.0f - done;
+    }
+    return 0.0f;
+}
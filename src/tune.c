@@ -0,0 +1,165 @@
+/**
+ * @file tune.c
+ * @brief Implémentation du réglage de la difficulté par Monte-Carlo.
+ */
+
+#include "tune.h"
+#include "pool.h"
+#include "utils.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Vague `base` jouée à l'intensité `t` : vitesse et cadence interpolées, cadence sans pente.
+ */
+static WaveSpec wave_at(const WaveSpec *base, float t)
+{
+    WaveSpec w = *base;
+    w.speed = TUNE_SPEED_MIN + t * (TUNE_SPEED_MAX - TUNE_SPEED_MIN);
+    w.fire_base = (int)lroundf(TUNE_FIRE_MIN + t * (TUNE_FIRE_MAX - TUNE_FIRE_MIN));
+    w.fire_per_level = 0;
+    return w;
+}
+
+/**
+ * @brief Taux de victoire d'une vague : parties du pool arrêtées au niveau 2, perdues sinon.
+ *
+ * @return Part des parties qui ont atteint le niveau 2, ou -1 si le pool n'a pas démarré.
+ */
+static float clear_rate(const TuneConfig *cfg, const WaveSpec *wave, TuneResult *out)
+{
+    WaveTable single = {.count = 1};
+    single.waves[0] = *wave;
+    wave_set_table(&single);
+
+    PoolConfig pc = {0};
+    pc.threads = cfg->threads;
+    pc.games = cfg->games;
+    pc.first_seed = cfg->first_seed;
+    pc.max_ticks = TUNE_WAVE_TICKS;
+    pc.bot = cfg->bot;
+    pc.stop_level = 2;
+    PoolSummary s;
+    if (!pool_run(&pc, &s))
+        return -1.0f;
+    out->games += s.games;
+    out->ticks += s.ticks;
+    return s.games > 0 ? (float)(s.games - s.levels[0]) / (float)s.games : 0.0f;
+}
+
+/**
+ * @brief Intensité où la courbe (décroissante) croise la cible, interpolée entre ses deux voisins.
+ */
+static float crossing(const float *rates, float target, float *rate)
+{
+    if (rates[0] <= target)
+    {
+        *rate = rates[0];
+        return 0.0f;
+    }
+    for (int s = 1; s < TUNE_STEPS; s++)
+    {
+        if (rates[s] > target)
+            continue;
+        float span = rates[s - 1] - rates[s];
+        float f = span > 0 ? (rates[s - 1] - target) / span : 0.0f;
+        *rate = target;
+        return (s - 1 + f) / (TUNE_STEPS - 1);
+    }
+    *rate = rates[TUNE_STEPS - 1];
+    return 1.0f;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief 10 niveaux, 200 parties par essai, un thread par cœur.
+ */
+void tune_default_config(TuneConfig *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->levels = 10;
+    cfg->games = 200;
+    cfg->target_first = TUNE_TARGET_FIRST;
+    cfg->target_last = TUNE_TARGET_LAST;
+    cfg->first_seed = MODEL_RNG_DEFAULT_SEED;
+}
+
+/**
+ * @brief Niveau par niveau : TUNE_STEPS essais sur les mêmes graines, puis le croisement avec la cible.
+ */
+bool tune_run(const TuneConfig *cfg, TuneResult *out)
+{
+    if (cfg->levels < 1 || cfg->levels > WAVE_MAX || cfg->games < 1)
+        return false;
+    memset(out, 0, sizeof(*out));
+
+    BotConfig normal;
+    bot_preset(&normal, BOT_LEVEL_NORMAL);
+    TuneConfig run = *cfg;
+    if (!run.bot)
+        run.bot = &normal;
+
+    // Table courante, avant que les essais ne la remplacent : toutes ses vagues
+    // (la dernière répétée au-delà), pour la rendre intacte en cas d'échec
+    WaveTable current = {.count = WAVE_MAX};
+    for (int l = 0; l < WAVE_MAX; l++)
+        current.waves[l] = *wave_for_level(l + 1);
+    const WaveSpec *base = current.waves;
+
+    double start = utils_get_time();
+    for (int l = 0; l < cfg->levels; l++)
+    {
+        TuneLevel *tl = &out->levels[l];
+        float k = cfg->levels > 1 ? (float)l / (float)(cfg->levels - 1) : 0.0f;
+        tl->target = cfg->target_first + k * (cfg->target_last - cfg->target_first);
+        for (int s = 0; s < TUNE_STEPS; s++)
+        {
+            WaveSpec w = wave_at(&base[l], (float)s / (TUNE_STEPS - 1));
+            float rate = clear_rate(&run, &w, out);
+            if (rate < 0)
+            {
+                wave_set_table(&current);
+                return false;
+            }
+            // Plus dur ne gagne pas plus souvent : le bruit des essais ne fait pas remonter la courbe
+            tl->rates[s] = (s > 0 && rate > tl->rates[s - 1]) ? tl->rates[s - 1] : rate;
+        }
+        tl->intensity = crossing(tl->rates, tl->target, &tl->clear_rate);
+        out->table.waves[l] = wave_at(&base[l], tl->intensity);
+        tl->speed = out->table.waves[l].speed;
+        tl->fire = out->table.waves[l].fire_base;
+    }
+    out->table.count = cfg->levels;
+    out->count = cfg->levels;
+    out->elapsed = utils_get_time() - start;
+    wave_set_table(&out->table);
+    return true;
+}
+
+/**
+ * @brief Une ligne par niveau : cible, réglage, puis la courbe mesurée.
+ */
+void tune_print(const TuneResult *r)
+{
+    printf("[TUNE] Parties       : %ld (%lld ticks, %.1f s)\n", r->games, r->ticks, r->elapsed);
+    printf("[TUNE] Intensites    : %d, vitesse %.2f a %.2f, tir %d a %d %%\n", TUNE_STEPS, TUNE_SPEED_MIN,
+           TUNE_SPEED_MAX, TUNE_FIRE_MIN, TUNE_FIRE_MAX);
+    for (int l = 0; l < r->count; l++)
+    {
+        const TuneLevel *tl = &r->levels[l];
+        printf("[TUNE] niveau %2d : cible %3.0f %% -> vitesse %.2f, tir %2d %% (intensite %.2f) |", l + 1,
+               100.0f * tl->target, tl->speed, tl->fire, tl->intensity);
+        for (int s = 0; s < TUNE_STEPS; s++)
+            printf(" %3.0f", 100.0f * tl->rates[s]);
+        printf("\n");
+    }
+}
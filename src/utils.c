@@ -3,18 +3,37 @@
  * @brief Implémentation des fonctions utilitaires (Version POSIX/Linux).
  *
  * Ce fichier implémente les outils de gestion du temps et d'aléatoire.
- * Il utilise les API standards POSIX (`clock_gettime`, `nanosleep`) pour garantir
+ * Il utilise les API standards POSIX (`clock_gettime`, `clock_nanosleep`) pour garantir
  * une précision à la nanoseconde, nécessaire pour une boucle de jeu fluide (60 FPS).
  */
 
 /** @def _POSIX_C_SOURCE
- *  @brief Active les fonctionnalités POSIX 1993 (requis pour clock_gettime).
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour clock_gettime et clock_nanosleep).
  */
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 
 #include "utils.h"
-#include <time.h>
+#include <math.h>
+#include <sched.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+/**
+ * @brief Horloge rapide : compteur matériel ramené aux nanosecondes de l'horloge monotone.
+ */
+static struct
+{
+    bool ready;           ///< utils_fast_clock_init appelé.
+    bool hw;              ///< Compteur matériel utilisable (sinon utils_now_ns).
+    uint64_t base_ns;     ///< utils_now_ns à l'étalonnage.
+    uint64_t base_cycles; ///< Compteur au même instant.
+    uint64_t mult;        ///< Nanosecondes par cycle, en virgule fixe 32.32.
+} fast_clock;
 
 /**
  * @brief Récupère le temps écoulé depuis le démarrage système.
@@ -33,6 +52,94 @@ double utils_get_time(void)
     return ts.tv_sec + ts.tv_nsec / 1000000000.0;
 }
 
+/**
+ * @brief Temps monotone en nanosecondes entières.
+ */
+uint64_t utils_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * UTILS_NS_PER_S + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Lit le compteur matériel (0 sur une architecture sans compteur connu).
+ */
+static inline uint64_t read_cycles(void)
+{
+#if defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Étalonne le compteur : TSC invariant mesuré contre l'horloge monotone, ou fréquence de CNTVCT.
+ *
+ * Chaque lecture de l'horloge monotone est encadrée par deux lectures du
+ * compteur, dont on garde le milieu : l'erreur d'étalonnage reste de l'ordre
+ * de quelques millionièmes.
+ */
+bool utils_fast_clock_init(void)
+{
+    if (fast_clock.ready)
+        return fast_clock.hw;
+    fast_clock.ready = true;
+    const char *env = getenv("SPACE_INVADERS_TSC");
+    if (env && strcmp(env, "0") == 0)
+        return false;
+#if defined(__SIZEOF_INT128__) && defined(__x86_64__)
+    unsigned a, b, c, d;
+    if (!__get_cpuid(0x80000007, &a, &b, &c, &d) || !(d & (1u << 8)))
+        return false; // Compteur variable avec la fréquence ou arrêté en veille : inutilisable
+    uint64_t c0 = read_cycles();
+    uint64_t ns0 = utils_now_ns();
+    c0 = c0 / 2 + read_cycles() / 2;
+    uint64_t ns1, c1;
+    do
+    {
+        c1 = read_cycles();
+        ns1 = utils_now_ns();
+        c1 = c1 / 2 + read_cycles() / 2;
+    } while (ns1 - ns0 < UTILS_FAST_CALIBRATION_NS);
+    if (c1 <= c0)
+        return false;
+    fast_clock.mult = ((ns1 - ns0) << 32) / (c1 - c0);
+    fast_clock.base_ns = ns1;
+    fast_clock.base_cycles = c1;
+#elif defined(__SIZEOF_INT128__) && defined(__aarch64__)
+    uint64_t freq;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+    if (freq == 0)
+        return false;
+    fast_clock.mult = (UTILS_NS_PER_S << 32) / freq;
+    fast_clock.base_cycles = read_cycles();
+    fast_clock.base_ns = utils_now_ns();
+#else
+    return false;
+#endif
+    fast_clock.hw = fast_clock.mult > 0;
+    return fast_clock.hw;
+}
+
+/**
+ * @brief Compteur matériel converti (une lecture, une multiplication 64x64), ou horloge monotone.
+ */
+uint64_t utils_fast_ns(void)
+{
+#if defined(__SIZEOF_INT128__)
+    if (fast_clock.hw)
+        return fast_clock.base_ns +
+               (uint64_t)(((unsigned __int128)(read_cycles() - fast_clock.base_cycles) * fast_clock.mult) >> 32);
+#endif
+    return utils_now_ns();
+}
+
 /**
  * @brief Endort le processus pour libérer le CPU.
  *
@@ -48,11 +155,135 @@ void utils_sleep_ms(int ms)
     nanosleep(&ts, NULL);
 }
 
+/**
+ * @brief Attend jusqu'à un instant précis (sommeil absolu puis attente active).
+ *
+ * Le réveil d'un sommeil arrive souvent avec quelques dizaines à centaines de
+ * microsecondes de retard : on se réveille UTILS_SPIN_S avant l'échéance et
+ * on termine en cédant le CPU à chaque tour.
+ */
+void utils_sleep_until_ns(uint64_t deadline)
+{
+    const uint64_t spin = (uint64_t)(UTILS_SPIN_S * UTILS_NS_PER_S);
+    if (deadline > spin && utils_now_ns() < deadline - spin)
+    {
+        uint64_t wake = deadline - spin;
+        struct timespec ts;
+        ts.tv_sec = (time_t)(wake / UTILS_NS_PER_S);
+        ts.tv_nsec = (long)(wake % UTILS_NS_PER_S);
+        // EINTR : on termine simplement par l'attente active
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+    while (utils_now_ns() < deadline)
+        sched_yield();
+}
+
+/**
+ * @brief Échéance en secondes, convertie à la nanoseconde.
+ */
+void utils_sleep_until(double deadline)
+{
+    utils_sleep_until_ns(deadline > 0.0 ? (uint64_t)(deadline * UTILS_NS_PER_S) : 0);
+}
+
+/**
+ * @brief Prépare le régulateur de cadence.
+ */
+void utils_pacer_init(FramePacer *pacer, int hz, bool vsync)
+{
+    pacer->period = pacer->nominal = UTILS_NS_PER_S / (uint64_t)hz;
+    pacer->deadline = utils_now_ns() + pacer->period;
+    pacer->vsync = vsync;
+    pacer->capped = false;
+    pacer->fast = 0;
+    pacer->last = 0;
+    pacer->frames = 0;
+    pacer->sum = pacer->min = pacer->max = 0;
+    pacer->sum_sq = 0.0;
+    pacer->late = 0;
+}
+
+/**
+ * @brief Attend le début de l'image suivante et mesure l'intervalle écoulé.
+ */
+void utils_pacer_wait(FramePacer *pacer)
+{
+    const uint64_t vsync_min = (uint64_t)(PACER_VSYNC_MIN_S * UTILS_NS_PER_S);
+    if (!pacer->vsync || pacer->capped)
+    {
+        uint64_t now = utils_now_ns();
+        if (now > pacer->deadline && now - pacer->deadline > pacer->period)
+            pacer->deadline = now; // Trop en retard : on ne rattrape pas
+        utils_sleep_until_ns(pacer->deadline);
+        pacer->deadline += pacer->period;
+    }
+
+    uint64_t now = utils_now_ns();
+    if (pacer->last > 0)
+    {
+        uint64_t interval = now - pacer->last;
+        if (pacer->frames == 0 || interval < pacer->min)
+            pacer->min = interval;
+        if (interval > pacer->max)
+            pacer->max = interval;
+        pacer->frames++;
+        pacer->sum += interval;
+        pacer->sum_sq += (double)interval * (double)interval;
+        if (2 * interval > 3 * pacer->period)
+            pacer->late++;
+
+        // Vsync acceptée mais sans effet : on reprend les échéances
+        pacer->fast = (pacer->vsync && interval < vsync_min) ? pacer->fast + 1 : 0;
+        if (pacer->fast >= PACER_VSYNC_PROBE)
+        {
+            pacer->vsync = false;
+            pacer->deadline = now + pacer->period;
+        }
+    }
+    pacer->last = now;
+}
+
+/**
+ * @brief Nouvelle période, à partir de l'échéance déjà prévue ; les mesures continuent.
+ */
+void utils_pacer_set_rate(FramePacer *pacer, int hz)
+{
+    uint64_t period = UTILS_NS_PER_S / (uint64_t)hz;
+    pacer->capped = period > pacer->nominal;
+    pacer->deadline = pacer->deadline - pacer->period + period;
+    pacer->period = period;
+}
+
+/**
+ * @brief Repart de l'instant courant, sans mesurer l'intervalle en cours.
+ */
+void utils_pacer_rebase(FramePacer *pacer)
+{
+    pacer->deadline = utils_now_ns() + pacer->period;
+    pacer->last = 0;
+}
+
+/**
+ * @brief Affiche la cadence mesurée et sa gigue (écart-type des intervalles).
+ */
+void utils_pacer_report(const FramePacer *pacer, const char *label)
+{
+    if (pacer->frames == 0)
+        return;
+    double n = (double)pacer->frames;
+    double mean = (double)pacer->sum / n;
+    double var = pacer->sum_sq / n - mean * mean;
+    printf("%s : %.1f img/s (%s), intervalle moyen %.3f ms, gigue %.3f ms (min %.3f, max %.3f), %llu images en retard\n",
+           label, 1e9 / mean, pacer->vsync ? "vsync" : "régulé", mean / 1e6, sqrt(var > 0.0 ? var : 0.0) / 1e6,
+           (double)pacer->min / 1e6, (double)pacer->max / 1e6, (unsigned long long)pacer->late);
+}
+
 /**
  * @brief Générateur pseudo-aléatoire simple.
  *
  * Utilise l'arithmétique modulaire pour borner le résultat entre min et max.
- * Note : Suppose que srand() a été appelé au début du programme (fait dans model_init).
+ * Note : Réservé aux effets purement visuels. La simulation utilise le générateur
+ * du modèle (model_rng_*), pour rester reproductible.
  */
 int utils_random_int(int min, int max)
 {
@@ -4,35 +4,1179 @@
  *
  * Ce fichier gère l'affichage du jeu Space Invaders dans un terminal
  * en utilisant la bibliothèque ncurses pour le rendu ASCII et les couleurs.
+ * La Vue ANSI (view_ansi) partage toute la composition des images et ne
+ * diffère que par la sortie (séquences d'échappement, un write() par image)
+ * et la lecture du clavier (octets bruts de stdin). La Vue web (view_web)
+ * diffuse la même grille aux navigateurs (cf. webterm.h), sans clavier.
  */
 
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour ioctl sur le terminal).
+ */
+#define _POSIX_C_SOURCE 200112L
+
 #include "view_ncurses.h"
+#include "affinity.h"
+#include "entity_type.h"
+#include "flightrec.h"
+#include "logger.h"
+#include "profiler.h"
+#include "lang.h"
+#include "scene.h"
+#include "utils.h"
 #include <ncurses.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 #include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ============================================================================
+// ASSETS VISUELS
+// ============================================================================
+static const char *SPRITE_PLAYER = "_^_";
+static const char *SPRITE_PLAYER_HIT = "*#*";
+static const char *SPRITE_UFO = "<=O=>";
+
+/** @brief Sprite des aliens par rang (EntityTypeInfo::sprite). */
+static const char *const ALIEN_SPRITES[] = {"/o\\", "/M\\", "/^\\"};
+
+/** @brief Paire de couleurs (init_pair) par couleur ANSI (EntityTypeInfo::ansi_color). */
+static const short ANSI_PAIRS[8] = {
+    [COLOR_RED] = 2, [COLOR_GREEN] = 1, [COLOR_YELLOW] = 3, [COLOR_BLUE] = 4,
+    [COLOR_MAGENTA] = 6, [COLOR_CYAN] = 5,
+};
+
+/** @brief Couleurs (texte, fond) des paires 1 à 7 (-1 : couleur par défaut du terminal). */
+static const short PAIR_COLORS[8][2] = {
+    [1] = {COLOR_GREEN, -1},          // Joueur
+    [2] = {COLOR_RED, -1},            // UFO / Danger
+    [3] = {COLOR_YELLOW, -1},         // Balles
+    [4] = {COLOR_BLUE, -1},           // Cadres
+    [5] = {COLOR_CYAN, -1},           // Bouclier
+    [6] = {COLOR_MAGENTA, -1},        // Ennemi
+    [7] = {COLOR_BLACK, COLOR_WHITE}, // Sélection (Reste sur fond blanc pour lisibilité)
+};
+
+// Caractères pour les boucliers selon les dégâts
+static const char SHIELD_FULL = '#';
+static const char SHIELD_MED = '+';
+static const char SHIELD_LOW = '.';
+
+static const char CHAR_BULLET = '|';
+
+/** @name Demi-blocs (cf. AnsiTerminal::half_blocks) */
+///@{
+#define HALF_UPPER 'U'    ///< Lettre (marquée A_ALTCHARSET) du demi-bloc haut "▀" : texte = haut, fond = bas.
+#define HALF_LOWER 'L'    ///< Lettre du demi-bloc bas "▄" : texte = bas, fond du terminal en haut.
+#define HALF_PAIR_BASE 8  ///< Première paire des demi-blocs : 8 + (texte + 1) × 9 + (fond + 1).
+#define HALF_SHADES 9     ///< Couleurs d'une moitié : les 8 couleurs ANSI et celle par défaut (-1).
+///@}
+
+/** @brief Lignes d'un motif en demi-blocs ('#' : moitié allumée), réparties sur la hauteur de l'entité. */
+#define HALF_SPRITE_ROWS 4
+
+/** @brief Motifs des aliens en demi-blocs, par `frame` de la scène (2 × rang + image d'animation). */
+static const char *const HALF_ALIENS[6][HALF_SPRITE_ROWS] = {
+    {".#.", "###", "###", "#.#"}, {".#.", "###", "###", ".#."}, // "/o\"
+    {"#.#", ".#.", "###", "#.#"}, {"#.#", ".#.", "###", ".#."}, // "/M\"
+    {".#.", "#.#", "###", "#.#"}, {".#.", "#.#", "###", ".#."}, // "/^\"
+};
+static const char *const HALF_ALIEN_HIT[HALF_SPRITE_ROWS] = {"#.#", ".#.", ".#.", "#.#"};
+static const char *const HALF_PLAYER[HALF_SPRITE_ROWS] = {".#.", ".#.", "###", "###"};
+static const char *const HALF_PLAYER_HIT[HALF_SPRITE_ROWS] = {"#.#", ".#.", "###", "#.#"};
+static const char *const HALF_UFO[HALF_SPRITE_ROWS] = {"..#..", ".###.", "#####", ".#.#."};
+static const char *const HALF_UFO_HIT[HALF_SPRITE_ROWS] = {"#.#.#", ".###.", ".###.", "#.#.#"};
+
+// Écran en mémoire (cf. NcursesGrid)
+static NcursesGrid grid = {0};
+
+// Mémoire passagère d'une image : texte formaté, tampon des différences
+static FrameArena arena = {0};
+
+// Mise à l'échelle logique → terminal (cf. NcursesScale)
+static NcursesScale scale = {0};
+
+// Cadence du terminal (cf. NcursesPacing)
+static NcursesPacing pacing = {0};
+
+/** @brief Thread d'entrée (inactif par défaut). */
+static NcursesInput input;
+
+// Terminal piloté directement (cf. AnsiTerminal) : inactif en ncurses
+static AnsiTerminal ansi = {0};
+
+// Appuis et relâchements (cf. KittyKeyboard), si le terminal les envoie
+static KittyKeyboard kitty = {0};
+
+// Diffusion web
+static WebStream web = {0};
+
+// Liste d'affichage du monde de jeu (refaite seulement quand l'état change)
+static SceneList scene;
+
+// Ligne de performances (F3) : affichée, et modèle de l'image en cours
+static bool perf_visible = false;
+static const GameModel *perf_model = NULL;
+
+// Paliers de cadence pendant la partie, du plus rapide au plus lent
+static const int PACING_RATES[] = {TARGET_FPS, 30, 20, 15};
+#define PACING_LEVELS ((int)(sizeof(PACING_RATES) / sizeof(PACING_RATES[0])))
+
+// ============================================================================
+// CADENCE ADAPTATIVE
+// ============================================================================
+
+/**
+ * @brief Cadence d'un palier, plafonnée par --max-hz.
+ */
+static int pacing_hz(int level)
+{
+    int hz = PACING_RATES[level];
+    return (pacing.max_hz > 0 && hz > pacing.max_hz) ? pacing.max_hz : hz;
+}
+
+/**
+ * @brief Indique si une image doit être envoyée maintenant (partie en cours).
+ *
+ * Les appels entre deux échéances sont ignorés : la Vue redessine le dernier
+ * état du modèle à l'échéance suivante.
+ */
+static bool pacing_due(double now)
+{
+    if (pacing.unpaced)
+        return true;
+    if (now < pacing.next)
+    {
+        pacing.skipped++;
+        return false;
+    }
+    double period = 1.0 / pacing_hz(pacing.level);
+    pacing.next = (now - pacing.next > period) ? now + period : pacing.next + period;
+    return true;
+}
+
+/**
+ * @brief Mesure la saturation de la liaison après une image et ajuste le palier.
+ *
+ * Quand la liaison sature, la boucle est ralentie par la sortie elle-même :
+ * le débit réel est alors la taille d'une image divisée par l'intervalle
+ * entre deux images. On ne remonte d'un palier qu'après NCURSES_CALM_S sans
+ * saturation, et si ce débit suffit à la cadence visée.
+ *
+ * @param start Instant juste avant refresh().
+ * @param end Instant juste après refresh().
+ */
+static void pacing_measure(double start, double end)
+{
+    pacing.frame_bytes = (pacing.frame_bytes > 0.0) ? 0.9 * pacing.frame_bytes + 0.1 * grid.frame_bytes
+                                                    : grid.frame_bytes;
+    int queued = -1;
+#ifdef TIOCOUTQ
+    if (ioctl(STDOUT_FILENO, TIOCOUTQ, &queued) != 0)
+        queued = -1;
+#endif
+    double elapsed = (pacing.last > 0.0) ? end - pacing.last : 0.0;
+    pacing.backlog = queued;
+    pacing.blocked = end - start;
+    pacing.last = end;
+    if (elapsed <= 0.0)
+        return;
+
+    double period = 1.0 / pacing_hz(pacing.level);
+    bool saturated = queued > NCURSES_BACKLOG_MAX || pacing.blocked > NCURSES_BLOCKED_MAX * period;
+    if (saturated)
+    {
+        double rate = grid.frame_bytes / elapsed;
+        pacing.throughput = (pacing.throughput > 0.0) ? 0.8 * pacing.throughput + 0.2 * rate : rate;
+        if (pacing.level < PACING_LEVELS - 1 && end >= pacing.hold)
+        {
+            pacing.level++;
+            pacing.hold = end + NCURSES_HOLD_S;
+        }
+        pacing.calm = 0.0;
+    }
+    else if (queued <= 0)
+    {
+        pacing.calm += elapsed;
+        if (pacing.calm >= NCURSES_CALM_S && pacing.level > 0)
+        {
+            int hz = pacing_hz(pacing.level - 1);
+            if (pacing.throughput <= 0.0 || pacing.frame_bytes * hz <= NCURSES_HEADROOM * pacing.throughput)
+                pacing.level--;
+            pacing.calm = 0.0;
+        }
+    }
+    else
+    {
+        pacing.calm = 0.0;
+    }
+}
+
+/**
+ * @brief Plafonne la cadence de rafraîchissement du terminal.
+ */
+void ncurses_set_max_refresh(int hz)
+{
+    pacing.max_hz = (hz > 0) ? hz : 0;
+}
+
+/**
+ * @brief Coupe (ou rétablit) la cadence adaptative.
+ */
+void ncurses_set_unpaced(bool unpaced)
+{
+    pacing.unpaced = unpaced;
+}
+
+// ============================================================================
+// GRILLE DE RENDU
+// ============================================================================
+
+/**
+ * @brief Recalcule les tables de mise à l'échelle pour une taille de terminal.
+ */
+static void scale_build(int rows, int cols)
+{
+    scale.rows = rows;
+    scale.cols = cols;
+    scale.scale_x = (float)(cols - 2) / (float)GAME_WIDTH;
+    scale.scale_y = (float)(rows - 2) / (float)GAME_HEIGHT;
+    for (int i = 0; i < NCURSES_SCALE_COLS; i++)
+    {
+        float x = (float)i / NCURSES_SCALE_SUBDIV - NCURSES_SCALE_MARGIN;
+        scale.col[i] = (short)((int)(x * scale.scale_x) + 1);
+    }
+    for (int i = 0; i < NCURSES_SCALE_ROWS; i++)
+    {
+        float y = (float)i / NCURSES_SCALE_SUBDIV - NCURSES_SCALE_MARGIN;
+        scale.row[i] = (short)((int)(y * scale.scale_y) + 1);
+        scale.half_row[i] = (short)((int)(y * scale.scale_y * 2.0f) + 2);
+    }
+}
+
+/**
+ * @brief Colonne du terminal d'une abscisse logique.
+ */
+static int map_col(float x)
+{
+    int i = (int)floorf((x + NCURSES_SCALE_MARGIN) * NCURSES_SCALE_SUBDIV);
+    if (i < 0 || i >= NCURSES_SCALE_COLS)
+        return (int)(x * scale.scale_x) + 1;
+    return scale.col[i];
+}
+
+/**
+ * @brief Ligne du terminal d'une ordonnée logique.
+ */
+static int map_row(float y)
+{
+    int i = (int)floorf((y + NCURSES_SCALE_MARGIN) * NCURSES_SCALE_SUBDIV);
+    if (i < 0 || i >= NCURSES_SCALE_ROWS)
+        return (int)(y * scale.scale_y) + 1;
+    return scale.row[i];
+}
+
+/**
+ * @brief Demi-ligne du terminal d'une ordonnée logique (deux par case, cf. AnsiTerminal::half_blocks).
+ */
+static int map_half_row(float y)
+{
+    int i = (int)floorf((y + NCURSES_SCALE_MARGIN) * NCURSES_SCALE_SUBDIV);
+    if (i < 0 || i >= NCURSES_SCALE_ROWS)
+        return (int)(y * scale.scale_y * 2.0f) + 2;
+    return scale.half_row[i];
+}
+
+/**
+ * @brief Commence une image : grille vide à la taille du terminal.
+ *
+ * Un changement de taille réalloue la grille, agrandit au besoin l'arène
+ * d'image (tampon des différences au pire, plus le texte), recalcule les
+ * tables de mise à l'échelle et invalide l'image affichée : toutes les
+ * cases sont alors réécrites.
+ *
+ * @return false si la grille n'a pas pu être allouée.
+ */
+static bool grid_begin(int rows, int cols)
+{
+    if (rows != grid.rows || cols != grid.cols || !grid.cells)
+    {
+        size_t n = (size_t)rows * (size_t)cols;
+        size_t diff = web.active ? WEBTERM_HEADER_SIZE + n * (WEBTERM_CELL_SIZE + WEBTERM_RUN_SIZE)
+                    : ansi.active ? n * ANSI_CELL_BYTES + ANSI_FRAME_BYTES
+                                  : 0;
+        if (!frame_arena_reserve(&arena, diff + NCURSES_FRAME_TEXT_BYTES))
+        {
+            grid.rows = grid.cols = 0;
+            return false;
+        }
+        chtype *cells = realloc(grid.cells, n * sizeof(chtype));
+        if (cells)
+            grid.cells = cells;
+        chtype *shown = cells ? realloc(grid.shown, n * sizeof(chtype)) : NULL;
+        if (!cells || !shown)
+        {
+            grid.rows = grid.cols = 0;
+            return false;
+        }
+        grid.shown = shown;
+        grid.rows = rows;
+        grid.cols = cols;
+        scale_build(rows, cols);
+        for (size_t i = 0; i < n; i++)
+            grid.shown[i] = (chtype)-1; // Jamais égal à une case : tout sera réécrit
+    }
+    for (int i = 0; i < rows * cols; i++)
+        grid.cells[i] = ' ';
+    grid.attr = A_NORMAL;
+    return true;
+}
+
+/**
+ * @brief Active des attributs (mêmes règles que attron : une paire remplace la précédente).
+ */
+static void grid_attron(attr_t a)
+{
+    if (a & A_COLOR)
+        grid.attr &= ~A_COLOR;
+    grid.attr |= a;
+}
+
+/**
+ * @brief Désactive des attributs (mêmes règles que attroff).
+ */
+static void grid_attroff(attr_t a)
+{
+    if (a & A_COLOR)
+        grid.attr &= ~A_COLOR;
+    grid.attr &= ~(a & ~A_COLOR);
+}
+
+/**
+ * @brief Place un caractère (ou un symbole ACS) avec les attributs courants.
+ */
+static void grid_putc(int y, int x, chtype c)
+{
+    if (y < 0 || y >= grid.rows || x < 0 || x >= grid.cols)
+        return;
+    grid.cells[y * grid.cols + x] = c | grid.attr;
+}
+
+/**
+ * @brief Équivalent de mvprintw dans la grille (le texte est coupé au bord).
+ */
+static void grid_printf(int y, int x, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    const char *buf = frame_arena_vprintf(&arena, fmt, args); // Longueur exacte, sans troncature
+    va_end(args);
+    if (!buf)
+        return;
+    for (int i = 0; buf[i] && x + i < grid.cols; i++)
+        grid_putc(y, x + i, (unsigned char)buf[i]);
+}
+
+/**
+ * @brief Couleurs (texte, fond) d'une paire, demi-blocs compris (-1 : couleur par défaut du terminal).
+ */
+static void pair_colors(int pair, short *fg, short *bg)
+{
+    *fg = *bg = -1;
+    if (pair > 0 && pair < 8)
+    {
+        *fg = PAIR_COLORS[pair][0];
+        *bg = PAIR_COLORS[pair][1];
+    }
+    else if (pair >= HALF_PAIR_BASE && pair < HALF_PAIR_BASE + HALF_SHADES * HALF_SHADES)
+    {
+        *fg = (short)((pair - HALF_PAIR_BASE) / HALF_SHADES - 1);
+        *bg = (short)((pair - HALF_PAIR_BASE) % HALF_SHADES - 1);
+    }
+}
+
+/**
+ * @brief Colore une moitié de case (demi-ligne `hy`), l'autre moitié gardée si la case est déjà en demi-blocs.
+ *
+ * Une case de texte est remplacée comme par grid_putc. La case reste un
+ * caractère et une paire : ansi_encode la compare et l'écrit comme les autres.
+ */
+static void grid_half(int hy, int x, short color)
+{
+    int y = hy >> 1;
+    if (hy < 0 || y >= grid.rows || x < 0 || x >= grid.cols)
+        return;
+    chtype *cell = &grid.cells[y * grid.cols + x];
+    short half[2] = {-1, -1}, fg, bg; // Haut, bas
+    pair_colors(PAIR_NUMBER(*cell), &fg, &bg);
+    if ((*cell & (A_ALTCHARSET | A_CHARTEXT)) == (A_ALTCHARSET | HALF_UPPER))
+    {
+        half[0] = fg;
+        half[1] = bg;
+    }
+    else if ((*cell & (A_ALTCHARSET | A_CHARTEXT)) == (A_ALTCHARSET | HALF_LOWER))
+        half[1] = fg;
+    half[hy & 1] = color;
+
+    bool upper = half[0] >= 0;
+    fg = upper ? half[0] : half[1];
+    bg = upper ? half[1] : -1;
+    *cell = A_ALTCHARSET | (upper ? HALF_UPPER : HALF_LOWER) |
+            COLOR_PAIR(HALF_PAIR_BASE + (fg + 1) * HALF_SHADES + (bg + 1));
+}
+
+/**
+ * @brief Dessine un motif en demi-blocs sur les demi-lignes couvertes par l'entité (une au moins).
+ *
+ * Chaque demi-ligne prend la ligne du motif à la même hauteur relative ;
+ * les colonnes partent de `x`, sans déborder sur le cadre.
+ */
+static void grid_half_sprite(const char *const sprite[HALF_SPRITE_ROWS], const SceneItem *it, int x, short color)
+{
+    int top = map_half_row(it->y), span = map_half_row(it->y + it->h) - top;
+    if (span < 1)
+        span = 1;
+    int width = (int)strlen(sprite[0]);
+    for (int k = 0; k < span; k++)
+    {
+        int hy = top + k;
+        if (hy < 2 || hy >= 2 * (grid.rows - 1))
+            continue;
+        const char *line = sprite[k * HALF_SPRITE_ROWS / span];
+        for (int i = 0; i < width; i++)
+            if (line[i] == '#' && x + i > 0 && x + i < grid.cols - 1)
+                grid_half(hy, x + i, color);
+    }
+}
+
+/**
+ * @brief Symbole de tracé désigné par sa lettre VT100 ('q' : trait horizontal...).
+ *
+ * Sans ncurses, la table ACS n'est pas remplie : la case garde la lettre,
+ * marquée A_ALTCHARSET, et ansi_encode l'écrit en caractère UTF-8 (la page
+ * web fait de même).
+ */
+static chtype box_char(char vt100)
+{
+    return (ansi.active || web.active) ? ((chtype)vt100 | A_ALTCHARSET) : NCURSES_ACS(vt100);
+}
+
+/**
+ * @brief Cadre autour de l'écran (équivalent de box(stdscr, 0, 0)).
+ */
+static void grid_box(void)
+{
+    int r = grid.rows - 1, c = grid.cols - 1;
+    chtype h = box_char('q'), v = box_char('x');
+    for (int x = 1; x < c; x++)
+    {
+        grid_putc(0, x, h);
+        grid_putc(r, x, h);
+    }
+    for (int y = 1; y < r; y++)
+    {
+        grid_putc(y, 0, v);
+        grid_putc(y, c, v);
+    }
+    grid_putc(0, 0, box_char('l'));
+    grid_putc(0, c, box_char('k'));
+    grid_putc(r, 0, box_char('m'));
+    grid_putc(r, c, box_char('j'));
+}
+
+/**
+ * @brief Écrit la ligne de performances (F3) sur le bord inférieur du cadre.
+ *
+ * Cadence et durée des frames lues dans le profileur, octets de la dernière
+ * image envoyée (les images sautées par la cadence n'en ont pas), entités vivantes et, au bout, la durée des dernières frames
+ * en caractères de plus en plus denses (un budget de 1 / TARGET_FPS pour
+ * les trois premiers niveaux).
+ */
+static void draw_perf_status(const GameModel *model)
+{
+    static const char LEVELS[] = " .:-=+*#";
+    ProfilerStats frame;
+    profiler_stats(PROF_FRAME, &frame, NULL);
+    const short *live;
+    int bullets = model_get_live_bullets(model, &live);
+
+    char buf[160];
+    int len = snprintf(buf, sizeof(buf), " %.0f img/s %.1f ms p99 %.1f | ticks %u | %u o/img | arene %zu o | E%d B%d U%d ",
+                       frame.avg > 0.0 ? 1.0 / frame.avg : 0.0, 1000.0 * frame.avg, 1000.0 * frame.p99,
+                       profiler_counter(PROF_COUNT_TICKS), (unsigned)grid.frame_bytes, arena.last,
+                       model->sim.formation.alive_count, bullets, model->sim.ufo.active ? 1 : 0);
+    const ProfilerPhaseData *d = profiler_phase(PROF_FRAME);
+    int room = grid.cols - 2 - len - 1, n = d->count < (uint64_t)room ? (int)d->count : room;
+    for (int i = 0; i < n && len < (int)sizeof(buf) - 2; i++)
+    {
+        float v = d->window[(d->next + PROFILER_WINDOW - n + i) % PROFILER_WINDOW];
+        int level = (int)(v * TARGET_FPS * 3.0f);
+        buf[len++] = LEVELS[level < 7 ? level : 7];
+    }
+    buf[len] = '\0';
+
+    grid_attron(COLOR_PAIR(7));
+    grid_printf(grid.rows - 1, 1, "%.*s", grid.cols - 2, buf);
+    grid_attroff(COLOR_PAIR(7));
+}
+
+/** @brief Fond d'un jeu d'attributs (-1 : fond du terminal). */
+static short attr_background(attr_t attr)
+{
+    short fg, bg;
+    pair_colors(PAIR_NUMBER(attr), &fg, &bg);
+    return bg;
+}
+
+/**
+ * @brief Attributs avec lesquels écrire une case : les siens, ou `current` si la différence ne se voit pas.
+ *
+ * Un blanc sans fond ne montre ni sa couleur ni sa graisse : il s'écrit avec
+ * les attributs déjà actifs quand ceux-ci n'ont pas de fond non plus. Effacer
+ * la trace d'un sprite entre deux sprites de même couleur ne coûte ainsi
+ * aucun changement d'attributs (les blancs forment l'essentiel des cases
+ * modifiées d'une image).
+ *
+ * @param current Attributs actifs côté terminal ((attr_t)-1 : inconnus).
+ */
+static attr_t cell_attr(chtype c, attr_t current)
+{
+    attr_t attr = c & A_ATTRIBUTES;
+    if (attr == current || current == (attr_t)-1 || (c & A_CHARTEXT) != ' ')
+        return attr;
+    const attr_t visible_on_blank = A_ATTRIBUTES & ~(A_COLOR | A_BOLD); // Inverse, souligné, symboles...
+    if ((attr | current) & visible_on_blank || attr_background(attr) >= 0 || attr_background(current) >= 0)
+        return attr;
+    return current;
+}
+
+/**
+ * @brief Passe à ncurses les cases qui ont changé.
+ *
+ * Les blancs reprennent les attributs de la case écrite juste avant quand
+ * cela ne se voit pas (cell_attr) : ncurses n'a pas à changer d'attributs.
+ *
+ * @return Estimation des octets que refresh() enverra.
+ */
+static int curses_encode(void)
+{
+    int n = grid.rows * grid.cols;
+    int bytes = 0, last = -2;
+    attr_t last_attr = (attr_t)-1;
+    for (int i = 0; i < n; i++)
+    {
+        if (grid.cells[i] == grid.shown[i])
+            continue;
+        attr_t attr = cell_attr(grid.cells[i], last_attr);
+        mvaddch(i / grid.cols, i % grid.cols, (grid.cells[i] & ~A_ATTRIBUTES) | attr);
+        grid.shown[i] = grid.cells[i];
+        grid.written++;
+
+        // Coût approximatif côté terminal : déplacement du curseur, changement d'attributs, caractère
+        bytes += (i == last + 1) ? 0 : 8;
+        bytes += (attr == last_attr) ? 0 : 10;
+        bytes += (attr & A_ALTCHARSET) ? 3 : 1;
+        last = i;
+        last_attr = attr;
+    }
+    return bytes;
+}
+
+// ============================================================================
+// SORTIE ANSI DIRECTE
+// ============================================================================
+
+/** @brief Ajoute `len` octets au tampon de l'image. */
+static size_t ansi_put(size_t at, const char *s, size_t len)
+{
+    memcpy(ansi.out + at, s, len);
+    return at + len;
+}
+
+/** @brief Ajoute un entier positif en décimal. */
+static size_t ansi_num(size_t at, int v)
+{
+    char digits[12];
+    int n = 0;
+    do
+        digits[n++] = (char)('0' + v % 10);
+    while ((v /= 10) > 0);
+    while (n > 0)
+        ansi.out[at++] = digits[--n];
+    return at;
+}
+
+/**
+ * @brief Ajoute la séquence SGR qui passe des attributs `from` à `attr`.
+ *
+ * Seuls la graisse et les couleurs qui changent sont émises (`from` inconnu :
+ * remise à zéro complète) : passer d'un alien magenta à une balle jaune
+ * coûte "ESC[33m" au lieu de "ESC[0;33m".
+ */
+static size_t ansi_sgr(size_t at, attr_t attr, attr_t from)
+{
+    short fg, bg;
+    pair_colors(PAIR_NUMBER(attr), &fg, &bg);
+    if (from == (attr_t)-1)
+    {
+        at = ansi_put(at, "\x1b[0", 3);
+        if (attr & A_BOLD)
+            at = ansi_put(at, ";1", 2);
+        if (fg >= 0)
+            at = ansi_num(ansi_put(at, ";3", 2), fg);
+        if (bg >= 0)
+            at = ansi_num(ansi_put(at, ";4", 2), bg);
+        return ansi_put(at, "m", 1);
+    }
+
+    short from_fg, from_bg;
+    pair_colors(PAIR_NUMBER(from), &from_fg, &from_bg);
+    at = ansi_put(at, "\x1b[", 2);
+    const char *sep = "";
+    if ((attr ^ from) & A_BOLD)
+    {
+        at = (attr & A_BOLD) ? ansi_put(at, "1", 1) : ansi_put(at, "22", 2);
+        sep = ";";
+    }
+    if (fg != from_fg)
+    {
+        at = ansi_put(at, sep, strlen(sep));
+        at = (fg >= 0) ? ansi_num(ansi_put(at, "3", 1), fg) : ansi_put(at, "39", 2);
+        sep = ";";
+    }
+    if (bg != from_bg)
+    {
+        at = ansi_put(at, sep, strlen(sep));
+        at = (bg >= 0) ? ansi_num(ansi_put(at, "4", 1), bg) : ansi_put(at, "49", 2);
+    }
+    return ansi_put(at, "m", 1);
+}
+
+/**
+ * @brief Ajoute le caractère d'une case (symboles de tracé et demi-blocs en UTF-8).
+ */
+static size_t ansi_char(size_t at, chtype c)
+{
+    if (c & A_ALTCHARSET)
+    {
+        const char *s;
+        switch (c & A_CHARTEXT)
+        {
+        case 'q': s = "\u2500"; break;
+        case 'x': s = "\u2502"; break;
+        case 'l': s = "\u250c"; break;
+        case 'k': s = "\u2510"; break;
+        case 'm': s = "\u2514"; break;
+        case 'j': s = "\u2518"; break;
+        case HALF_UPPER: s = "\u2580"; break;
+        case HALF_LOWER: s = "\u2584"; break;
+        default: return ansi_put(at, "+", 1);
+        }
+        return ansi_put(at, s, 3);
+    }
+    unsigned char ch = (unsigned char)(c & A_CHARTEXT);
+    ansi.out[at] = (char)(ch < ' ' ? ' ' : ch);
+    return at + 1;
+}
+
+/**
+ * @brief Traduit les cases qui ont changé en séquences d'échappement dans `out`.
+ *
+ * Le curseur n'est déplacé que pour sauter des cases inchangées : en avant
+ * sur la même ligne (CUF, plus court), ailleurs en position absolue (CUP).
+ * Les attributs ne sont réémis qu'à leur changement visible (cell_attr), et
+ * seulement pour ce qui change (ansi_sgr). Un octet non ASCII
+ * (accent UTF-8 des messages) occupe moins de colonnes que de cases : la
+ * case suivante est alors repositionnée en absolu.
+ *
+ * @return Octets de l'image (0 : rien à envoyer, ou tampon indisponible).
+ */
+static int ansi_encode(void)
+{
+    int n = grid.rows * grid.cols;
+    ansi.out = frame_arena_alloc(&arena, (size_t)n * ANSI_CELL_BYTES + ANSI_FRAME_BYTES);
+    if (!ansi.out)
+        return 0; // Cases non marquées affichées : elles repartiront à l'image suivante
+
+    size_t at = 0;
+    bool changed = false;
+    if (ansi.sync)
+        at = ansi_put(at, "\x1b[?2026h", 8);
+    if (ansi.rows != grid.rows || ansi.cols != grid.cols)
+    {
+        at = ansi_put(at, "\x1b[0m\x1b[2J", 8); // Nouvelle taille : le terminal a pu replier l'ancien contenu
+        ansi.rows = grid.rows;
+        ansi.cols = grid.cols;
+        changed = true;
+    }
+    int last = -2;
+    attr_t last_attr = (attr_t)-1;
+    for (int i = 0; i < n; i++)
+    {
+        chtype c = grid.cells[i];
+        if (c == grid.shown[i])
+            continue;
+        int row = i / grid.cols, col = i % grid.cols;
+        if (i != last + 1 || col == 0)
+        {
+            if (last >= 0 && last / grid.cols == row)
+                at = ansi_put(ansi_num(ansi_put(at, "\x1b[", 2), i - last - 1), "C", 1);
+            else
+                at = ansi_put(ansi_num(ansi_put(ansi_num(ansi_put(at, "\x1b[", 2), row + 1), ";", 1), col + 1), "H", 1);
+        }
+        attr_t attr = cell_attr(c, last_attr) & (A_COLOR | A_BOLD); // Symboles : ansi_char
+        if (attr != last_attr)
+            at = ansi_sgr(at, attr, last_attr);
+        at = ansi_char(at, c);
+        grid.shown[i] = c;
+        grid.written++;
+        last = ((c & A_CHARTEXT) < 0x80 || (c & A_ALTCHARSET)) ? i : -2;
+        last_attr = attr;
+        changed = true;
+    }
+    if (!changed)
+        return 0;
+    if (ansi.sync)
+        at = ansi_put(at, "\x1b[?2026l", 8);
+    return (int)at;
+}
+
+/**
+ * @brief Envoie l'image composée par ansi_encode (un seul write() si le terminal l'accepte d'un bloc).
+ */
+static void ansi_write(size_t len)
+{
+    size_t done = 0;
+    while (done < len)
+    {
+        ssize_t n = write(STDOUT_FILENO, ansi.out + done, len - done);
+        if (n > 0)
+            done += (size_t)n;
+        else if (n < 0 && errno != EINTR && errno != EAGAIN)
+            return; // Terminal fermé : l'image est perdue
+    }
+}
+
+// ============================================================================
+// DIFFUSION WEB
+// ============================================================================
+
+/**
+ * @brief Couleurs et drapeaux d'une case au format du terminal web.
+ */
+static void web_cell(uint8_t *p, chtype c)
+{
+    int pair = PAIR_NUMBER(c & A_ATTRIBUTES);
+    int fg = WEBTERM_COLOR_DEFAULT, bg = WEBTERM_COLOR_DEFAULT;
+    if (pair > 0 && pair < 8)
+    {
+        if (PAIR_COLORS[pair][0] >= 0)
+            fg = PAIR_COLORS[pair][0];
+        if (PAIR_COLORS[pair][1] >= 0)
+            bg = PAIR_COLORS[pair][1];
+    }
+    p[0] = (uint8_t)(c & A_CHARTEXT);
+    p[1] = (uint8_t)(fg | (bg << 4));
+    p[2] = (uint8_t)(((c & A_BOLD) ? WEBTERM_BOLD : 0) | ((c & A_ALTCHARSET) ? WEBTERM_LINE : 0));
+}
+
+/**
+ * @brief Encode en plages les cases où `cells` diffère de `base` (toutes si `base` est NULL).
+ *
+ * @return Taille du message (en-tête seul : rien n'a changé).
+ */
+static size_t web_encode_runs(uint8_t type, const chtype *base)
+{
+    int n = grid.rows * grid.cols;
+    size_t at = 0;
+    web.out[at++] = type;
+    web.out[at++] = (uint8_t)grid.rows;
+    web.out[at++] = (uint8_t)(grid.rows >> 8);
+    web.out[at++] = (uint8_t)grid.cols;
+    web.out[at++] = (uint8_t)(grid.cols >> 8);
+    size_t run = 0; // Position de l'en-tête de la plage ouverte (0 : aucune)
+    int count = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (base && grid.cells[i] == base[i])
+        {
+            run = 0;
+            continue;
+        }
+        if (!run || count == WEBTERM_RUN_MAX)
+        {
+            run = at;
+            count = 0;
+            web.out[at++] = (uint8_t)i;
+            web.out[at++] = (uint8_t)(i >> 8);
+            web.out[at++] = 0;
+        }
+        web_cell(web.out + at, grid.cells[i]);
+        at += WEBTERM_CELL_SIZE;
+        web.out[run + 2] = (uint8_t)++count;
+    }
+    return at;
+}
+
+/**
+ * @brief Envoie les cases changées aux spectateurs à jour, puis une image complète aux nouveaux venus.
+ *
+ * @return Octets du message des différences.
+ */
+static int web_encode(void)
+{
+    int n = grid.rows * grid.cols;
+    web.out = frame_arena_alloc(&arena, WEBTERM_HEADER_SIZE + (size_t)n * (WEBTERM_CELL_SIZE + WEBTERM_RUN_SIZE));
+    if (!web.out)
+        return 0;
+    size_t len = web_encode_runs(WEBTERM_DIFF, grid.shown);
+    for (int i = 0; i < n; i++)
+        if (grid.cells[i] != grid.shown[i])
+        {
+            grid.shown[i] = grid.cells[i];
+            grid.written++;
+        }
+    if (len > WEBTERM_HEADER_SIZE)
+        webterm_send(&web.server, web.out, len, false);
+    if (webterm_wants_key(&web.server))
+        webterm_send(&web.server, web.out, web_encode_runs(WEBTERM_KEY, NULL), true);
+    return len > WEBTERM_HEADER_SIZE ? (int)len : 0;
+}
+
+/**
+ * @brief Taille du terminal : getmaxyx en ncurses, TIOCGWINSZ sinon (24 × 80 par défaut).
+ */
+static void term_size(int *rows, int *cols)
+{
+    if (web.active)
+    {
+        *rows = WEB_ROWS;
+        *cols = WEB_COLS;
+        return;
+    }
+    if (!ansi.active)
+    {
+        getmaxyx(stdscr, *rows, *cols);
+        return;
+    }
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0 && ws.ws_col > 0)
+    {
+        *rows = ws.ws_row;
+        *cols = ws.ws_col;
+        return;
+    }
+    *rows = 24;
+    *cols = 80;
+}
+
+/**
+ * @brief Décode une touche des octets en attente dans `ansi.in`, avec les codes de getch.
+ *
+ * Flèches et touches de fonction arrivent en séquences CSI ("ESC [ A",
+ * "ESC [ 24 ~") ou SS3 ("ESC O R") : elles sont rendues en KEY_UP, KEY_F(3)...
+ * Un ESC seul (rien derrière dans la même lecture) est la touche Échap.
+ *
+ * Avec le protocole kitty, chaque touche arrive en "CSI code ; mod : événement u"
+ * (ou la forme des flèches, "CSI 1 ; 1 : 3 D") : le code est celui du
+ * caractère (13 Entrée, 27 Échap, 127 Effacement), les majuscules viennent du
+ * modificateur Maj, et un relâchement (événement 3) ajoute TERM_KEY_RELEASE.
+ * Une séquence coupée par la lecture attend la suite au lieu d'être lue en Échap.
+ *
+ * @return Le code de la touche, 0 pour une séquence inconnue, ERR si rien n'est en attente.
+ */
+static int key_decode(void)
+{
+    if (ansi.in_len == 0)
+        return ERR;
+
+    int used = 1, key = ansi.in[0];
+    if (key == '\r')
+        key = '\n';
+    else if (key == 27 && ansi.in_len > 1 && (ansi.in[1] == '[' || ansi.in[1] == 'O'))
+    {
+        // Paramètres numériques (champs ';', sous-champs ':') puis octet final (0x40 à 0x7E)
+        int end = 2, field = 0, sub = 0, v[3][3] = {{0}};
+        bool reply = end < ansi.in_len && ansi.in[end] == '?'; // Réponse du terminal, pas une touche
+        if (reply)
+            end++;
+        for (; end < ansi.in_len && (isdigit(ansi.in[end]) || ansi.in[end] == ';' || ansi.in[end] == ':'); end++)
+        {
+            char c = (char)ansi.in[end];
+            if (c == ';')
+            {
+                field++;
+                sub = 0;
+            }
+            else if (c == ':')
+                sub++;
+            else if (field < 3 && sub < 3)
+                v[field][sub] = v[field][sub] * 10 + (c - '0');
+        }
+        if (end == ansi.in_len && kitty.active && ansi.in_len < ANSI_INPUT_BYTES)
+            return ERR; // Séquence incomplète : la suite arrive à la prochaine lecture
+        if (end < ansi.in_len)
+        {
+            used = end + 1;
+            int mods = v[1][0] > 1 ? v[1][0] - 1 : 0; // Bits : 1 Maj, 4 Ctrl
+            switch (ansi.in[end])
+            {
+            case 'A': key = KEY_UP; break;
+            case 'B': key = KEY_DOWN; break;
+            case 'C': key = KEY_RIGHT; break;
+            case 'D': key = KEY_LEFT; break;
+            case 'R': key = KEY_F(3); break; // SS3 R (l'octet final suffit : CSI R n'est pas une touche)
+            case '~': key = (v[0][0] == 13) ? KEY_F(3) : (v[0][0] == 20) ? KEY_F(9) : (v[0][0] == 24) ? KEY_F(12) : 0; break;
+            case 'u':
+                key = v[0][0] == 13 ? '\n' : v[0][0] < 128 ? v[0][0] : 0;
+                if ((mods & 1) && islower(key))
+                    key = toupper(key);
+                if ((mods & 4) && key == 'c' && v[1][1] != 3)
+                    raise(SIGINT); // Ctrl+C arrive en séquence : le terminal n'envoie plus le signal
+                break;
+            default: key = 0; break;
+            }
+            if (reply)
+                key = 0;
+            else if (key && v[1][1] == 3)
+                key |= TERM_KEY_RELEASE;
+        }
+    }
+    ansi.in_len -= used;
+    memmove(ansi.in, ansi.in + used, (size_t)ansi.in_len);
+    return key;
+}
+
+/**
+ * @brief Lit les octets en attente sur stdin, puis décode une touche.
+ */
+static int ansi_getch(void)
+{
+    struct pollfd p = {STDIN_FILENO, POLLIN, 0};
+    if (ansi.in_len < ANSI_INPUT_BYTES && poll(&p, 1, 0) > 0)
+    {
+        ssize_t n = read(STDIN_FILENO, ansi.in + ansi.in_len, (size_t)(ANSI_INPUT_BYTES - ansi.in_len));
+        if (n > 0)
+            ansi.in_len += (int)n;
+    }
+    return key_decode();
+}
+
+/**
+ * @brief Protocole kitty sous ncurses : octets bruts de getch (keypad coupé), décodés comme en ANSI.
+ *
+ * Les codes de ncurses au-delà d'un octet (KEY_RESIZE) passent tels quels,
+ * après les octets déjà lus.
+ */
+static int kitty_getch(void)
+{
+    int ch;
+    while (ansi.in_len < ANSI_INPUT_BYTES && (ch = getch()) != ERR)
+    {
+        if (ch <= 0xFF)
+        {
+            ansi.in[ansi.in_len++] = (unsigned char)ch;
+            continue;
+        }
+        if (ansi.in_len == 0)
+            return ch;
+        ungetch(ch);
+        break;
+    }
+    return key_decode();
+}
+
+/**
+ * @brief Lit une touche : getch en ncurses, ansi_getch sinon.
+ */
+static int term_getch(void)
+{
+    return ansi.active ? ansi_getch() : kitty.active ? kitty_getch() : getch();
+}
+
+/**
+ * @brief Envoie au terminal les seules cases qui ont changé, puis rafraîchit.
+ */
+static void grid_flush(void)
+{
+    if (perf_visible && perf_model && grid.rows >= 2)
+        draw_perf_status(perf_model);
+
+    int bytes = web.active ? web_encode() : ansi.active ? ansi_encode() : curses_encode();
+    grid.frames++;
+    grid.frame_bytes = bytes;
+    profiler_count(PROF_COUNT_TERM_BYTES, (uint32_t)bytes);
+    grid.bytes += (uint64_t)bytes;
+    if (web.active)
+        return; // Envoi sans attente : rien à mesurer du côté d'un terminal
+    double start = utils_get_time();
+    if (ansi.active)
+        ansi_write((size_t)bytes);
+    else
+        refresh();
+    pacing_measure(start, utils_get_time());
+}
 
 // ============================================================================
-// ASSETS VISUELS
+// THREAD D'ENTRÉE
 // ============================================================================
-static const char *SPRITE_PLAYER = "_^_";
-static const char *SPRITE_PLAYER_HIT = "*#*";
-static const char *SPRITE_A1 = "/^\\";
-static const char *SPRITE_A2 = "/M\\";
-static const char *SPRITE_A3 = "/o\\";
-static const char *SPRITE_UFO = "<=O=>";
 
-// Caractères pour les boucliers selon les dégâts
-static const char SHIELD_FULL = '#';
-static const char SHIELD_MED = '+';
-static const char SHIELD_LOW = '.';
+/**
+ * @brief Boucle du thread d'entrée : attend stdin, puis lit toutes les touches.
+ *
+ * getch est aussi appelé au réveil périodique : un redimensionnement (KEY_RESIZE)
+ * ne rend pas stdin lisible.
+ */
+static void *input_main(void *arg)
+{
+    (void)arg;
+    affinity_apply(THREAD_ROLE_INPUT);
+    while (!__atomic_load_n(&input.stop, __ATOMIC_ACQUIRE))
+    {
+        struct pollfd p = {STDIN_FILENO, POLLIN, 0};
+        poll(&p, 1, NCURSES_INPUT_POLL_MS);
 
-static const char CHAR_BULLET = '|';
+        pthread_mutex_lock(&input.lock);
+        int ch;
+        while ((ch = term_getch()) != ERR)
+        {
+            NcursesKey key = {ch, utils_get_time()};
+            spsc_push(&input.ring, &key);
+        }
+        pthread_mutex_unlock(&input.lock);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Lance le thread d'entrée si SPACE_INVADERS_INPUT_THREAD=1.
+ */
+static void input_start(void)
+{
+    const char *env = getenv("SPACE_INVADERS_INPUT_THREAD");
+    if (!env || strcmp(env, "1") != 0)
+        return;
+
+    spsc_init(&input.ring, input.keys, sizeof(NcursesKey), NCURSES_INPUT_RING);
+    input.stop = false;
+    if (pthread_mutex_init(&input.lock, NULL) != 0)
+        return;
+    if (pthread_create(&input.thread, NULL, input_main, NULL) != 0)
+    {
+        pthread_mutex_destroy(&input.lock);
+        return;
+    }
+    input.running = true;
+}
+
+/**
+ * @brief Arrête le thread d'entrée (touches non lues abandonnées).
+ */
+static void input_stop(void)
+{
+    if (!input.running)
+        return;
+    __atomic_store_n(&input.stop, true, __ATOMIC_RELEASE);
+    pthread_join(input.thread, NULL);
+    pthread_mutex_destroy(&input.lock);
+    input.running = false;
+    if (input.ring.dropped > 0)
+        printf("Ncurses : %u touches perdues (file d'entrée pleine)\n", input.ring.dropped);
+}
 
 // ============================================================================
 // INITIALISATION
 // ============================================================================
 
+/**
+ * @brief Demande au terminal s'il suit le protocole clavier de kitty (cf. KittyKeyboard).
+ *
+ * "CSI ? u" reçoit "CSI ? n u" d'un terminal qui le suit ; la demande
+ * d'attributs envoyée derrière ("CSI c"), à laquelle tous répondent, clôt
+ * l'attente sans aller jusqu'à ANSI_QUERY_MS. Les touches arrivées
+ * entre-temps restent dans `in`.
+ */
+static bool kitty_query(void)
+{
+    static const char query[] = "\x1b[?u\x1b[c";
+    if (write(STDOUT_FILENO, query, sizeof(query) - 1) != (ssize_t)(sizeof(query) - 1))
+        return false;
+    bool supported = false;
+    double end = utils_get_time() + ANSI_QUERY_MS / 1000.0;
+    for (;;)
+    {
+        // Réponses complètes : "ESC [ ? ... u" (kitty) puis "ESC [ ? ... c" (attributs, toujours la dernière)
+        for (int i = 0; i + 3 <= ansi.in_len; i++)
+        {
+            if (memcmp(ansi.in + i, "\x1b[?", 3) != 0)
+                continue;
+            int k = i + 3;
+            while (k < ansi.in_len && (isdigit(ansi.in[k]) || ansi.in[k] == ';'))
+                k++;
+            if (k == ansi.in_len)
+                break; // Réponse encore incomplète
+            unsigned char final = ansi.in[k];
+            ansi.in_len -= k + 1 - i;
+            memmove(ansi.in + i, ansi.in + k + 1, (size_t)(ansi.in_len - i));
+            if (final == 'c')
+                return supported;
+            supported = supported || final == 'u';
+            i--; // La suite a glissé en i
+        }
+        int left = (int)((end - utils_get_time()) * 1000.0);
+        struct pollfd p = {STDIN_FILENO, POLLIN, 0};
+        if (left <= 0 || ansi.in_len == ANSI_INPUT_BYTES || poll(&p, 1, left) <= 0)
+            return supported;
+        ssize_t n = read(STDIN_FILENO, ansi.in + ansi.in_len, (size_t)(ANSI_INPUT_BYTES - ansi.in_len));
+        if (n <= 0)
+            return supported;
+        ansi.in_len += (int)n;
+    }
+}
+
+/**
+ * @brief Active le protocole kitty si le terminal le suit (SPACE_INVADERS_KITTY=0 ou 1 force le choix).
+ *
+ * À appeler sur l'écran secondaire : le terminal y garde ses propres
+ * réglages du clavier, rendus d'eux-mêmes au retour à l'écran principal.
+ */
+static void kitty_start(void)
+{
+    const char *env = getenv("SPACE_INVADERS_KITTY");
+    if (env && env[0])
+        kitty.active = strcmp(env, "0") != 0;
+    else
+        kitty.active = isatty(STDIN_FILENO) && isatty(STDOUT_FILENO) && kitty_query();
+    kitty.held = 0;
+    if (!kitty.active)
+        return;
+    char push[16];
+    int len = snprintf(push, sizeof(push), "\x1b[>%du", KITTY_FLAGS);
+    ssize_t n = write(STDOUT_FILENO, push, (size_t)len);
+    (void)n;
+    logger_write(LOG_INFO, "[CLAVIER] Protocole kitty actif : appuis et relachements reels\n");
+}
+
+/**
+ * @brief Retire les réglages du protocole kitty (utilisable dans un gestionnaire de signal).
+ */
+static void kitty_stop(void)
+{
+    static const char pop[] = "\x1b[<u";
+    if (!kitty.active)
+        return;
+    ssize_t n = write(STDOUT_FILENO, pop, sizeof(pop) - 1);
+    (void)n;
+}
+
 /**
  * @brief Initialise la bibliothèque ncurses et configure le terminal.
  *
@@ -44,6 +1188,7 @@ static const char CHAR_BULLET = '|';
  */
 static bool ncurses_init(void)
 {
+    logger_redirect("sauvegardes/" LOG_FILE); // Les messages abîmeraient l'écran
     initscr();
     cbreak();
     noecho();
@@ -56,17 +1201,39 @@ static bool ncurses_init(void)
         start_color();
         use_default_colors();
 
-        init_pair(1, COLOR_GREEN, -1);          // Joueur
-        init_pair(2, COLOR_RED, -1);            // UFO / Danger
-        init_pair(3, COLOR_YELLOW, -1);         // Balles
-        init_pair(4, COLOR_BLUE, -1);           // Cadres
-        init_pair(5, COLOR_CYAN, -1);           // Bouclier
-        init_pair(6, COLOR_MAGENTA, -1);        // Ennemi
-        init_pair(7, COLOR_BLACK, COLOR_WHITE); // Sélection (Reste sur fond blanc pour lisibilité)
+        for (int i = 1; i < 8; i++)
+            init_pair(i, PAIR_COLORS[i][0], PAIR_COLORS[i][1]);
     }
+    refresh(); // Passage à l'écran secondaire avant d'y régler le clavier
+    kitty_start();
+    if (kitty.active)
+        keypad(stdscr, FALSE); // Octets bruts : les séquences kitty sont décodées par key_decode
+    input_start();
     return true;
 }
 
+/**
+ * @brief Affiche le bilan des images envoyées puis libère la grille.
+ *
+ * @param name Nom de la Vue dans le bilan.
+ */
+static void grid_release(const char *name)
+{
+    if (grid.frames > 0)
+        printf("%s : %.1f cases réécrites et ~%.0f octets par image en moyenne (%llu images, %llu sautées), "
+               "cadence finale %d Hz\n",
+               name, (double)grid.written / (double)grid.frames, (double)grid.bytes / (double)grid.frames,
+               (unsigned long long)grid.frames, (unsigned long long)pacing.skipped, pacing_hz(pacing.level));
+    if (arena.frames > 0)
+        printf("%s : arene d'image, pic %zu octets sur %zu, %llu depassement(s)\n", name, arena.peak,
+               arena.capacity, (unsigned long long)arena.overflows);
+    free(grid.cells);
+    free(grid.shown);
+    grid.cells = grid.shown = NULL;
+    grid.rows = grid.cols = 0;
+    frame_arena_free(&arena);
+}
+
 /**
  * @brief Ferme proprement la session ncurses.
  *
@@ -74,7 +1241,180 @@ static bool ncurses_init(void)
  */
 static void ncurses_close(void)
 {
+    input_stop();
+    kitty_stop();
+    kitty.active = false;
     endwin();
+    logger_redirect(NULL);
+    grid_release("Ncurses");
+}
+
+/**
+ * @brief Rend au terminal ses réglages et l'écran principal (utilisable dans un gestionnaire de signal).
+ */
+static void ansi_restore(void)
+{
+    static const char seq[] = "\x1b[0m\x1b[?25h\x1b[?1049l";
+    kitty_stop(); // Avant de quitter l'écran secondaire, qui porte le réglage
+    ssize_t n = write(STDOUT_FILENO, seq, sizeof(seq) - 1);
+    (void)n;
+    if (ansi.saved_ok)
+        tcsetattr(STDIN_FILENO, TCSANOW, &ansi.saved);
+}
+
+/**
+ * @brief Ctrl+C ou arrêt : le terminal est restauré avant de laisser le signal terminer le processus.
+ *
+ * ncurses fait de même pour son propre mode ; ici, personne d'autre ne le ferait.
+ */
+static void ansi_on_signal(int sig)
+{
+    ansi_restore();
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+/**
+ * @brief Demande au terminal s'il prend en charge la sortie synchronisée (DECRQM, mode 2026).
+ *
+ * La réponse "ESC [ ? 2026 ; n $ y" est attendue au plus ANSI_QUERY_MS ; n vaut
+ * 1 ou 2 si le mode est reconnu. Les touches arrivées entre-temps restent dans
+ * `in` pour ansi_getch. Sans réponse (terminal ancien, sortie redirigée), pas
+ * de synchronisation : les octets de bornes seraient inutiles.
+ */
+static bool ansi_query_sync(void)
+{
+    static const char query[] = "\x1b[?2026$p";
+    static const char reply[] = "\x1b[?2026;";
+    if (write(STDOUT_FILENO, query, sizeof(query) - 1) != (ssize_t)(sizeof(query) - 1))
+        return false;
+    double end = utils_get_time() + ANSI_QUERY_MS / 1000.0;
+    for (;;)
+    {
+        // Réponse complète déjà reçue ?
+        for (int i = 0; i + (int)sizeof(reply) + 2 <= ansi.in_len; i++)
+        {
+            if (memcmp(ansi.in + i, reply, sizeof(reply) - 1) != 0)
+                continue;
+            int k = i + (int)sizeof(reply) - 1;
+            char mode = (char)ansi.in[k];
+            while (k < ansi.in_len && ansi.in[k] != 'y')
+                k++;
+            if (k == ansi.in_len)
+                break; // Réponse encore incomplète
+            ansi.in_len -= k + 1 - i;
+            memmove(ansi.in + i, ansi.in + k + 1, (size_t)(ansi.in_len - i));
+            return mode == '1' || mode == '2';
+        }
+        int left = (int)((end - utils_get_time()) * 1000.0);
+        struct pollfd p = {STDIN_FILENO, POLLIN, 0};
+        if (left <= 0 || ansi.in_len == ANSI_INPUT_BYTES || poll(&p, 1, left) <= 0)
+            return false;
+        ssize_t n = read(STDIN_FILENO, ansi.in + ansi.in_len, (size_t)(ANSI_INPUT_BYTES - ansi.in_len));
+        if (n <= 0)
+            return false;
+        ansi.in_len += (int)n;
+    }
+}
+
+/**
+ * @brief Ouvre le terminal sans ncurses : saisie sans écho ni tampon de ligne, écran secondaire, curseur masqué.
+ *
+ * Comme ncurses en mode cbreak, Ctrl+C garde son effet (ISIG).
+ *
+ * @return true (un terminal qui refuse ces réglages reste utilisable, en écho).
+ */
+static bool ansi_init(void)
+{
+    logger_redirect("sauvegardes/" LOG_FILE); // Les messages abîmeraient l'écran
+    ansi.active = true;
+    ansi.in_len = 0;
+    ansi.rows = ansi.cols = 0;
+    ansi.saved_ok = tcgetattr(STDIN_FILENO, &ansi.saved) == 0;
+    if (ansi.saved_ok)
+    {
+        struct termios t = ansi.saved;
+        t.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+        t.c_cc[VMIN] = 0;
+        t.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &t);
+    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = ansi_on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    static const char enter[] = "\x1b[?1049h\x1b[?25l";
+    ssize_t n = write(STDOUT_FILENO, enter, sizeof(enter) - 1);
+    (void)n;
+
+    const char *env = getenv("SPACE_INVADERS_ANSI_SYNC");
+    if (env && env[0])
+        ansi.sync = strcmp(env, "0") != 0;
+    else
+        ansi.sync = ansi.saved_ok && isatty(STDOUT_FILENO) && ansi_query_sync();
+    env = getenv("SPACE_INVADERS_HALF_BLOCKS");
+    ansi.half_blocks = env && strcmp(env, "1") == 0;
+    kitty_start();
+    input_start();
+    return true;
+}
+
+/**
+ * @brief Restaure le terminal, affiche le bilan et libère les tampons.
+ */
+static void ansi_close(void)
+{
+    input_stop();
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    ansi_restore();
+    logger_redirect(NULL);
+    ansi.active = false;
+    ansi.half_blocks = false;
+    kitty.active = false;
+    grid_release(ansi.sync ? "ANSI (synchronisé)" : "ANSI");
+    ansi.out = NULL;
+}
+
+/**
+ * @brief Ouvre le serveur du terminal web (SPACE_INVADERS_WEB_PORT, WEBTERM_DEFAULT_PORT par défaut).
+ *
+ * @return false si le port est indisponible.
+ */
+static bool web_init(void)
+{
+    const char *env = getenv("SPACE_INVADERS_WEB_PORT");
+    int port = (env && atoi(env) > 0) ? atoi(env) : WEBTERM_DEFAULT_PORT;
+    if (!webterm_start(&web.server, port))
+    {
+        fprintf(stderr, "[WEB] Port %d indisponible\n", port);
+        return false;
+    }
+    web.active = true;
+    printf("Web : partie diffusee sur http://localhost:%d/\n", port);
+    return true;
+}
+
+/**
+ * @brief Ferme le serveur, affiche le bilan et libère les tampons.
+ */
+static void web_close(void)
+{
+    webterm_stop(&web.server);
+    web.active = false;
+    grid_release("Web");
+    web.out = NULL;
+}
+
+/**
+ * @brief Aucune entrée : les spectateurs ne font que regarder.
+ */
+static void web_get_input(GameModel *model, CommandQueue *queue)
+{
+    (void)model;
+    (void)queue;
 }
 
 /**
@@ -89,8 +1429,7 @@ static void ncurses_close(void)
  */
 static void draw_centered(int y_offset, const char *text, int pair_color)
 {
-    int h, w;
-    getmaxyx(stdscr, h, w);
+    int h = grid.rows, w = grid.cols;
     int len = strlen(text);
     int x = (w / 2) - (len / 2);
     int y = (h / 2) + y_offset;
@@ -98,12 +1437,29 @@ static void draw_centered(int y_offset, const char *text, int pair_color)
         x = 0;
     if (y >= 0 && y < h)
     {
-        attron(COLOR_PAIR(pair_color));
-        mvprintw(y, x, "%s", text);
-        attroff(COLOR_PAIR(pair_color));
+        grid_attron(COLOR_PAIR(pair_color));
+        grid_printf(y, x, "%s", text);
+        grid_attroff(COLOR_PAIR(pair_color));
     }
 }
 
+/**
+ * @brief Affiche "PAGE x/y" sous une liste de sauvegardes (si plus d'une page).
+ *
+ * @param selection Index de l'élément sélectionné dans la liste.
+ * @param count Nombre total d'éléments.
+ */
+static void draw_page_footer(int selection, int count)
+{
+    int pages = (count + SAVE_MENU_PAGE_SIZE - 1) / SAVE_MENU_PAGE_SIZE;
+    if (pages <= 1)
+        return;
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), lang_get(STR_PAGE), selection / SAVE_MENU_PAGE_SIZE + 1, pages);
+    draw_centered(SAVE_MENU_PAGE_SIZE - 1, buf, 4);
+}
+
 // ============================================================================
 // RENDU (RENDER)
 // ============================================================================
@@ -119,351 +1475,464 @@ static void draw_centered(int y_offset, const char *text, int pair_color)
  * - Menus popup (pause, game over, sauvegarde, confirmation)
  *
  * Le rendu est adapté dynamiquement à la taille du terminal avec un système
- * de mise à l'échelle.
+ * de mise à l'échelle. L'image est composée dans la grille en mémoire, et
+ * seules les cases modifiées depuis l'image précédente sont envoyées au
+ * terminal (cf. grid_flush). Si la génération MODEL_GEN_ANY du modèle n'a
+ * pas bougé depuis, l'image n'est même pas recomposée.
  *
  * @param model Le modèle de jeu contenant l'état actuel à afficher.
  */
-static void ncurses_render(const GameModel *model)
+static void render_frame(const GameModel *model)
 {
-    erase();
-    int rows, cols;
-    getmaxyx(stdscr, rows, cols);
+    // Pendant la partie, l'affichage suit la cadence que le terminal supporte (le tick reste fixe)
+    if (model->sim.state == STATE_PLAYING && !pacing_due(utils_get_time()))
+        return;
 
-    if (rows < 20 || cols < 50)
+    int rows, cols;
+    term_size(&rows, &cols);
+    // Rien n'a changé depuis l'image affichée (même génération, même terminal)
+    if (!perf_visible && grid.cells && rows == grid.rows && cols == grid.cols &&
+        model->ui.gen[MODEL_GEN_ANY] == grid.drawn_gen && !webterm_wants_key(&web.server))
+        return;
+    grid.drawn_gen = model->ui.gen[MODEL_GEN_ANY];
+    frame_arena_reset(&arena);
+    if (!grid_begin(rows, cols))
     {
-        mvprintw(0, 0, "FENETRE TROP PETITE !");
+        // Pas de mémoire pour la grille : rendu minimal direct
+        if (web.active)
+            return;
+        if (ansi.active)
+        {
+            static const char msg[] = "\x1b[H\x1b[2JMEMOIRE INSUFFISANTE";
+            ssize_t n = write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+            (void)n;
+            return;
+        }
+        erase();
+        mvprintw(0, 0, "MEMOIRE INSUFFISANTE");
         refresh();
         return;
     }
 
-    float scale_x = (float)(cols - 2) / (float)GAME_WIDTH;
-    float scale_y = (float)(rows - 2) / (float)GAME_HEIGHT;
+    if (rows < 20 || cols < 50)
+    {
+        grid_printf(0, 0, "%s", lang_get(STR_TXT_TOO_SMALL));
+        grid_flush();
+        return;
+    }
 
-    attron(COLOR_PAIR(4));
-    box(stdscr, 0, 0);
-    attroff(COLOR_PAIR(4));
+    grid_attron(COLOR_PAIR(4));
+    grid_box();
+    grid_attroff(COLOR_PAIR(4));
 
     // --- A. MENU PRINCIPAL ---
-    if (model->state == STATE_MENU)
+    if (model->sim.state == STATE_MENU)
     {
-        draw_centered(-6, "=== SPACE INVADERS ===", 1);
+        draw_centered(-6, lang_get(STR_TXT_TITLE), 1);
 
-        const char *options[] = {"JOUER", "TUTORIEL", "CHARGER", "VOLUME", "QUITTER"};
+        const StringId options[] = {STR_MENU_PLAY, STR_MENU_TUTORIAL, STR_MENU_LOAD, STR_MENU_VOLUME, STR_MENU_QUIT};
 
         for (int i = 0; i < 5; i++)
         {
             char buf[64];
             if (i == 3)
-                snprintf(buf, 64, "VOLUME (N/A)");
+                snprintf(buf, 64, "%s", lang_get(STR_TXT_VOLUME_NA));
             else
-                strcpy(buf, options[i]);
+                snprintf(buf, 64, "%s", lang_get(options[i]));
 
-            int col = (i == model->menu_selection) ? 7 : 0;
-            if (i == model->menu_selection)
-                attron(COLOR_PAIR(7));
+            int col = (i == model->ui.menu_selection) ? 7 : 0;
+            if (i == model->ui.menu_selection)
+                grid_attron(COLOR_PAIR(7));
             draw_centered(-2 + (i * 2), buf, col);
-            if (i == model->menu_selection)
-                attroff(COLOR_PAIR(7));
+            if (i == model->ui.menu_selection)
+                grid_attroff(COLOR_PAIR(7));
         }
-        refresh();
+        grid_flush();
         return;
     }
 
     // --- B. CHARGEMENT / TUTO ---
-    if (model->state == STATE_LOAD_MENU)
+    if (model->sim.state == STATE_LOAD_MENU)
     {
-        draw_centered(-8, "=== CHARGER ===", 5);
-        if (model->save_file_count == 0)
-            draw_centered(0, "Aucune sauvegarde trouvé.", 2);
+        draw_centered(-8, lang_get(STR_TXT_LOAD_TITLE), 5);
+        if (model->ui.save_file_count == 0 && model->ui.save_scan_pending)
+            draw_centered(0, lang_get(STR_TXT_LOAD_SCANNING), 0);
+        else if (model->ui.save_file_count == 0)
+            draw_centered(0, lang_get(STR_TXT_LOAD_NONE), 2);
         else
         {
-            for (int i = 0; i < model->save_file_count; i++)
+            // Pagination : on affiche la page contenant la sélection
+            int first = (model->ui.menu_selection / SAVE_MENU_PAGE_SIZE) * SAVE_MENU_PAGE_SIZE;
+            for (int i = first; i < model->ui.save_file_count && i < first + SAVE_MENU_PAGE_SIZE; i++)
             {
-                int col = (i == model->menu_selection) ? 7 : 0;
-                if (i == model->menu_selection)
-                    attron(COLOR_PAIR(7));
-                draw_centered(-4 + i, model->save_files[i], col);
-                if (i == model->menu_selection)
-                    attroff(COLOR_PAIR(7));
+                char buf[128];
+                save_index_describe(&model->ui.save_files[i], buf, sizeof(buf));
+
+                int col = (i == model->ui.menu_selection) ? 7 : 0;
+                if (i == model->ui.menu_selection)
+                    grid_attron(COLOR_PAIR(7));
+                draw_centered(-4 + (i - first), buf, col);
+                if (i == model->ui.menu_selection)
+                    grid_attroff(COLOR_PAIR(7));
             }
+            draw_page_footer(model->ui.menu_selection, model->ui.save_file_count);
         }
-        refresh();
+        grid_flush();
         return;
     }
 
-    if (model->state == STATE_TUTORIAL)
+    if (model->sim.state == STATE_TUTORIAL)
     {
-        draw_centered(-9, "=== TABLEAU DES POINTS ===", 6);
+        draw_centered(-9, lang_get(STR_TXT_TUTO_TITLE), 6);
 
         int cx = cols / 2;
         int cy = rows / 2;
 
-        attron(COLOR_PAIR(2));
-        mvprintw(cy - 5, cx - 12, "%s", SPRITE_UFO);
-        attroff(COLOR_PAIR(2));
-        attron(A_BOLD);
-        mvprintw(cy - 5, cx - 4, "= 100 PTS + ???");
-        attroff(A_BOLD);
-
-        attron(COLOR_PAIR(6));
-        mvprintw(cy - 3, cx - 12, " %s ", SPRITE_A1);
-        attroff(COLOR_PAIR(6));
-        mvprintw(cy - 3, cx - 4, "= 30 PTS");
-
-        attron(COLOR_PAIR(5));
-        mvprintw(cy - 1, cx - 12, " %s ", SPRITE_A2);
-        attroff(COLOR_PAIR(5));
-        mvprintw(cy - 1, cx - 4, "= 20 PTS");
+        const EntityTypeInfo *ufo = &entity_types[ENTITY_UFO];
+        grid_attron(COLOR_PAIR(ANSI_PAIRS[ufo->ansi_color]));
+        grid_printf(cy - 5, cx - 12, "%s", SPRITE_UFO);
+        grid_attroff(COLOR_PAIR(ANSI_PAIRS[ufo->ansi_color]));
+        grid_attron(A_BOLD);
+        grid_printf(cy - 5, cx - 4, lang_get(STR_POINTS_UFO), ufo->points);
+        grid_attroff(A_BOLD);
 
-        attron(COLOR_PAIR(1));
-        mvprintw(cy + 1, cx - 12, " %s ", SPRITE_A3);
-        attroff(COLOR_PAIR(1));
-        mvprintw(cy + 1, cx - 4, "= 10 PTS");
+        // Du plus rentable au moins rentable
+        for (int t = ENTITY_ENEMY_TYPE_3; t >= ENTITY_ENEMY_TYPE_1; t--)
+        {
+            const EntityTypeInfo *info = &entity_types[t];
+            int y = cy - 3 + 2 * (ENTITY_ENEMY_TYPE_3 - t);
+            grid_attron(COLOR_PAIR(ANSI_PAIRS[info->ansi_color]));
+            grid_printf(y, cx - 12, " %s ", ALIEN_SPRITES[info->sprite]);
+            grid_attroff(COLOR_PAIR(ANSI_PAIRS[info->ansi_color]));
+            grid_printf(y, cx - 4, lang_get(STR_POINTS), info->points);
+        }
 
-        draw_centered(5, "FLECHES : Deplacer", 7);
-        draw_centered(6, "ESPACE  : Tirer", 7);
+        draw_centered(5, lang_get(STR_TXT_TUTO_MOVE), 7);
+        draw_centered(6, lang_get(STR_TXT_TUTO_FIRE), 7);
 
-        draw_centered(9, "[ ENTREE POUR RETOUR ]", 4);
+        draw_centered(9, lang_get(STR_TXT_TUTO_BACK), 4);
 
-        refresh();
+        grid_flush();
         return;
     }
 
     // --- C. JEU ---
     // HUD
-    attron(A_BOLD);
-    mvprintw(1, 2, "SCORE: %d", model->score);
-    mvprintw(1, cols - 15, "VIES: %d", model->lives);
-    mvprintw(1, cols / 2 - 4, "LVL: %d", model->level);
-    attroff(A_BOLD);
+    grid_attron(A_BOLD);
+    grid_printf(1, 2, lang_get(STR_TXT_SCORE), model->sim.score);
+    grid_printf(1, cols - 15, lang_get(STR_TXT_LIVES), model->sim.lives);
+    grid_printf(1, cols / 2 - 4, lang_get(STR_TXT_LEVEL), model->sim.level);
+    if (model->sim.rapid_timer > 0 || model->sim.spread_timer > 0)
+        grid_printf(1, cols / 2 + 6, "%s%s", model->sim.rapid_timer > 0 ? lang_get(STR_TXT_RAPID) : "",
+                    model->sim.spread_timer > 0 ? lang_get(STR_TXT_SPREAD) : "");
+    grid_attroff(A_BOLD);
 
-    // 1. JOUEUR (AVEC EFFET EXPLOSION)
-    if (model->player.active)
+    // Monde de jeu : la liste d'affichage (scene.h), déjà triée par genre dans l'ordre de dessin
+    scene_update(&scene, model, NULL);
+    for (int i = 0; i < scene.count; i++)
     {
-        int px = (int)(model->player.x * scale_x) + 1;
-        int py = (int)(model->player.y * scale_y) + 1;
-        if (px < cols - 3 && py < rows - 1)
+        const SceneItem *it = &scene.items[i];
+        const EntityTypeInfo *info = &entity_types[it->type];
+        int ex = map_col(it->x);
+        int ey = map_row(it->y);
+        switch ((SceneKind)it->kind)
         {
-            if (model->hit_timer > 0)
+        // 1. JOUEURS (AVEC EFFET EXPLOSION ; le second, en cyan, n'existe qu'en coopération)
+        case SCENE_SHIP:
+            if (ex >= cols - 3 || ey >= rows - 1)
+                break;
+            if (ansi.half_blocks)
+            {
+                if (!(it->flags & SCENE_EXPLODING))
+                    grid_half_sprite(HALF_PLAYER, it, ex, it->index ? COLOR_CYAN : COLOR_GREEN);
+                else if ((it->frame >> 1) == 0)
+                    grid_half_sprite(HALF_PLAYER_HIT, it, ex, COLOR_RED);
+            }
+            else if (it->flags & SCENE_EXPLODING)
             {
-                if ((int)(model->hit_timer * 5) % 2 == 0)
+                if ((it->frame >> 1) == 0)
                 {
-                    attron(COLOR_PAIR(2));
-                    mvprintw(py, px, "%s", SPRITE_PLAYER_HIT);
-                    attroff(COLOR_PAIR(2));
+                    grid_attron(COLOR_PAIR(2));
+                    grid_printf(ey, ex, "%s", SPRITE_PLAYER_HIT);
+                    grid_attroff(COLOR_PAIR(2));
                 }
             }
             else
             {
-                attron(COLOR_PAIR(1));
-                mvprintw(py, px, "%s", SPRITE_PLAYER);
-                attroff(COLOR_PAIR(1));
+                grid_attron(COLOR_PAIR(it->index ? 5 : 1));
+                grid_printf(ey, ex, "%s", SPRITE_PLAYER);
+                grid_attroff(COLOR_PAIR(it->index ? 5 : 1));
             }
-        }
-    }
+            break;
 
-    // 2. ENNEMIS
-    for (int i = 0; i < MAX_ENEMIES; i++)
-    {
-        const Entity *e = &model->enemies[i];
-        if (e->active)
-        {
-            int ex = (int)(e->x * scale_x) + 1;
-            int ey = (int)(e->y * scale_y) + 1;
-            int c = 2;
-            const char *s = SPRITE_A3;
-            if (e->type == ENTITY_ENEMY_TYPE_3)
+        // 2. ENNEMIS
+        case SCENE_ENEMY:
+            if (ansi.half_blocks && ex > 0 && ex < cols - 3 && ey > 0 && ey < rows - 1)
+                grid_half_sprite((it->flags & SCENE_EXPLODING) ? HALF_ALIEN_HIT : HALF_ALIENS[it->frame], it, ex,
+                                 info->ansi_color);
+            else if (ex > 0 && ex < cols - 3 && ey > 0 && ey < rows - 1)
             {
-                c = 6;
-                s = SPRITE_A1;
+                int c = ANSI_PAIRS[info->ansi_color];
+                grid_attron(COLOR_PAIR(c));
+                grid_printf(ey, ex, "%s", (it->flags & SCENE_EXPLODING) ? "*" : ALIEN_SPRITES[it->frame / 2]);
+                grid_attroff(COLOR_PAIR(c));
             }
-            else if (e->type == ENTITY_ENEMY_TYPE_2)
+            break;
+
+        // 3. UFO
+        case SCENE_UFO:
+            if (ansi.half_blocks && ex > -5 && ex < cols)
+                grid_half_sprite((it->flags & SCENE_EXPLODING) ? HALF_UFO_HIT : HALF_UFO, it, ex, info->ansi_color);
+            else if (ex > -5 && ex < cols)
             {
-                c = 5;
-                s = SPRITE_A2;
+                int c = ANSI_PAIRS[info->ansi_color];
+                grid_attron(COLOR_PAIR(c) | A_BOLD);
+                grid_printf(ey, (ex < 1 ? 1 : ex), "%s", (it->flags & SCENE_EXPLODING) ? "BOOM" : SPRITE_UFO);
+                grid_attroff(COLOR_PAIR(c) | A_BOLD);
             }
+            break;
 
-            if (ex > 0 && ex < cols - 3 && ey > 0 && ey < rows - 1)
+        // 3b. ENTITÉS DU REGISTRE (caractère et couleur de leur type)
+        case SCENE_ENTITY:
+            if (ex > 0 && ex < cols - 1 && ey > 0 && ey < rows - 1)
             {
-                attron(COLOR_PAIR(c));
-                mvprintw(ey, ex, "%s", (e->exploding ? "*" : s));
-                attroff(COLOR_PAIR(c));
+                int c = ANSI_PAIRS[info->ansi_color];
+                grid_attron(COLOR_PAIR(c) | A_BOLD);
+                grid_putc(ey, ex, info->glyph ? info->glyph : '*');
+                grid_attroff(COLOR_PAIR(c) | A_BOLD);
             }
-        }
-    }
-
-    // 3. UFO
-    if (model->ufo.active)
-    {
-        int ux = (int)(model->ufo.x * scale_x) + 1;
-        int uy = (int)(model->ufo.y * scale_y) + 1;
-        if (ux > -5 && ux < cols)
-        {
-            attron(COLOR_PAIR(2) | A_BOLD);
-            mvprintw(uy, (ux < 1 ? 1 : ux), "%s", (model->ufo.exploding ? "BOOM" : SPRITE_UFO));
-            attroff(COLOR_PAIR(2) | A_BOLD);
-        }
-    }
+            break;
 
-    // 4. BOUCLIERS (AVEC DÉGÂTS PROGRESSIFS)
-    attron(COLOR_PAIR(5));
-    for (int i = 0; i < MAX_SHIELDS; i++)
-    {
-        if (model->shields[i].active)
+        // 4. BOUCLIERS (AVEC DÉGÂTS PROGRESSIFS)
+        case SCENE_SHIELD:
         {
-            int sx = (int)(model->shields[i].x * scale_x) + 1;
-            int sy = (int)(model->shields[i].y * scale_y) + 1;
-            int sw = (int)(model->shields[i].width * scale_x);
+            int sw = map_col(it->w) - 1;
             if (sw < 1)
                 sw = 1;
-            int sh = (int)(model->shields[i].height * scale_y);
+            int sh = map_row(it->h) - 1;
             if (sh < 1)
                 sh = 1;
 
-            char c = SHIELD_FULL;
-            if (model->shields[i].health <= 3)
-                c = SHIELD_LOW;
-            else if (model->shields[i].health <= 6)
-                c = SHIELD_MED;
+            // Usure 7 à 9 : 3 PV ou moins ; 4 à 6 : 6 PV ou moins
+            char c = (it->frame >= 7) ? SHIELD_LOW : (it->frame >= 4) ? SHIELD_MED : SHIELD_FULL;
 
+            // En bitmap, chaque case du terminal montre la densité des cellules qu'elle couvre
+            const Shield *s = &model->sim.shields[it->index];
+            float cw = it->w / sw, ch = it->h / sh;
+            if (ansi.half_blocks && model->sim.shield_bitmap)
+            {
+                // En demi-blocs, chaque moitié de case est pleine dès qu'une cellule intacte s'y trouve
+                for (int y = 0; y < 2 * sh; y++)
+                    for (int x = 0; x < sw; x++)
+                        if (ex + x < cols - 1 && ey + y / 2 < rows - 1 &&
+                            model_shield_cells(s, it->x + x * cw, it->y + y * ch / 2.0f, cw, ch / 2.0f) > 0)
+                            grid_half(2 * ey + y, ex + x, COLOR_CYAN);
+                break;
+            }
+            int full = (int)(cw * SHIELD_BITMAP_SCALE) * (int)(ch * SHIELD_BITMAP_SCALE);
+            grid_attron(COLOR_PAIR(5));
             for (int y = 0; y < sh; y++)
+            {
                 for (int x = 0; x < sw; x++)
-                    if (sx + x < cols - 1 && sy + y < rows - 1)
-                        mvaddch(sy + y, sx + x, c);
+                {
+                    if (ex + x >= cols - 1 || ey + y >= rows - 1)
+                        continue;
+                    if (model->sim.shield_bitmap)
+                    {
+                        int n = model_shield_cells(s, it->x + x * cw, it->y + y * ch, cw, ch);
+                        if (n == 0)
+                            continue;
+                        c = (3 * n >= 2 * full) ? SHIELD_FULL : (3 * n >= full) ? SHIELD_MED : SHIELD_LOW;
+                    }
+                    grid_putc(ey + y, ex + x, c);
+                }
+            }
+            grid_attroff(COLOR_PAIR(5));
+            break;
         }
-    }
-    attroff(COLOR_PAIR(5));
 
-    // 5. BALLES
-    attron(COLOR_PAIR(3));
-    for (int i = 0; i < MAX_BULLETS; i++)
-    {
-        if (model->bullets[i].active)
+        // 5. BALLES
+        case SCENE_BULLET:
         {
-            int bx = (int)((model->bullets[i].x - 0.8f) * scale_x) + 1;
-            int by = (int)(model->bullets[i].y * scale_y) + 1;
-            if (bx > 0 && bx < cols - 1 && by > 0 && by < rows - 1)
-                mvaddch(by, bx, CHAR_BULLET);
+            int bx = map_col(it->x - 0.8f);
+            if (ansi.half_blocks && bx > 0 && bx < cols - 1 && ey > 0 && ey < rows - 1)
+            {
+                // Demi-lignes couvertes par la balle (une au moins), sans déborder sur le cadre
+                int top = map_half_row(it->y), bottom = map_half_row(it->y + it->h);
+                for (int hy = top; hy == top || (hy < bottom && hy < 2 * (rows - 1)); hy++)
+                    grid_half(hy, bx, COLOR_YELLOW);
+            }
+            else if (bx > 0 && bx < cols - 1 && ey > 0 && ey < rows - 1)
+            {
+                grid_attron(COLOR_PAIR(3));
+                grid_putc(ey, bx, CHAR_BULLET);
+                grid_attroff(COLOR_PAIR(3));
+            }
+            break;
+        }
+        default:
+            break;
         }
     }
-    attroff(COLOR_PAIR(3));
 
     // --- MENUS POPUP ---
 
     // PAUSE
-    if (model->state == STATE_PAUSED)
+    if (model->sim.state == STATE_PAUSED)
     {
-        draw_centered(-4, "=== PAUSE ===", 7);
-        const char *o[] = {"REPRENDRE", "VOLUME (N/A)", "SAUVEGARDER", "QUITTER"};
+        draw_centered(-4, lang_get(STR_TXT_PAUSE), 7);
+        const StringId o[] = {STR_PAUSE_RESUME, STR_TXT_VOLUME_NA, STR_SAVE, STR_MENU_QUIT};
         for (int i = 0; i < 4; i++)
         {
-            int c = (i == model->menu_selection) ? 7 : 0;
-            if (i == model->menu_selection)
-                attron(COLOR_PAIR(7));
-            draw_centered(-1 + i, o[i], c);
-            if (i == model->menu_selection)
-                attroff(COLOR_PAIR(7));
+            int c = (i == model->ui.menu_selection) ? 7 : 0;
+            if (i == model->ui.menu_selection)
+                grid_attron(COLOR_PAIR(7));
+            draw_centered(-1 + i, lang_get(o[i]), c);
+            if (i == model->ui.menu_selection)
+                grid_attroff(COLOR_PAIR(7));
         }
     }
-    else if (model->state == STATE_GAME_OVER)
+    else if (model->sim.state == STATE_GAME_OVER)
     {
-        draw_centered(-3, "!!! GAME OVER !!!", 2);
+        draw_centered(-3, lang_get(STR_TXT_GAME_OVER), 2);
 
         char sc[32];
-        snprintf(sc, 32, "SCORE FINAL: %d", model->score);
+        snprintf(sc, 32, lang_get(STR_TXT_FINAL_SCORE), model->sim.score);
         draw_centered(-1, sc, 1);
 
-        const char *o[] = {"SAUVEGARDER SCORE", "REJOUER", "QUITTER"};
-        for (int i = 0; i < 3; i++)
+        char rank[48];
+        if (model->ui.highscore_rank > 0)
+        {
+            snprintf(rank, 48, lang_get(STR_TXT_NEW_RECORD), model->ui.highscore_rank, HIGHSCORE_COUNT);
+            draw_centered(0, rank, 3);
+        }
+        else if (model->ui.highscores.count > 0)
+        {
+            snprintf(rank, 48, lang_get(STR_TXT_BEST_SCORE), model->ui.highscores.entries[0].score);
+            draw_centered(0, rank, 1);
+        }
+
+        const StringId labels[] = {STR_RETRY_LEVEL, STR_TXT_SAVE_SCORE, STR_REPLAY, STR_MENU_QUIT}; // Par GameOverOption
+        GameOverOption o[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, o);
+        for (int i = 0; i < count; i++)
         {
-            int c = (i == model->menu_selection) ? 7 : 0;
-            if (i == model->menu_selection)
-                attron(COLOR_PAIR(7));
-            draw_centered(2 + (i * 2), o[i], c);
-            if (i == model->menu_selection)
-                attroff(COLOR_PAIR(7));
+            int c = (i == model->ui.menu_selection) ? 7 : 0;
+            char label[48];
+            snprintf(label, sizeof(label), lang_get(labels[o[i]]), model_retry_level(model));
+            if (i == model->ui.menu_selection)
+                grid_attron(COLOR_PAIR(7));
+            draw_centered(2 + (i * 2), label, c);
+            if (i == model->ui.menu_selection)
+                grid_attroff(COLOR_PAIR(7));
         }
     }
-    else if (model->state == STATE_SAVE_SELECT)
+    else if (model->sim.state == STATE_SAVE_SELECT)
     {
-        draw_centered(-8, "=== CHOISIR EMPLACEMENT ===", 5);
+        draw_centered(-8, lang_get(STR_TXT_SAVE_SELECT), 5);
 
-        int col_new = (model->menu_selection == 0) ? 7 : 1;
-        if (model->menu_selection == 0)
-            attron(COLOR_PAIR(7));
-        draw_centered(-4, "[ + ]  NOUVELLE SAUVEGARDE", col_new);
-        if (model->menu_selection == 0)
-            attroff(COLOR_PAIR(7));
+        int col_new = (model->ui.menu_selection == 0) ? 7 : 1;
+        if (model->ui.menu_selection == 0)
+            grid_attron(COLOR_PAIR(7));
+        draw_centered(-4, lang_get(STR_TXT_SAVE_NEW), col_new);
+        if (model->ui.menu_selection == 0)
+            grid_attroff(COLOR_PAIR(7));
 
-        if (model->save_file_count == 0)
+        if (model->ui.save_file_count == 0)
         {
-            draw_centered(0, "(Aucun fichier existant)", 4);
+            draw_centered(0, lang_get(STR_TXT_NO_FILES), 4);
         }
         else
         {
-            for (int i = 0; i < model->save_file_count; i++)
+            // La ligne 0 est "Nouvelle sauvegarde" : la sélection i + 1 désigne le fichier i
+            int sel = (model->ui.menu_selection > 0) ? model->ui.menu_selection - 1 : 0;
+            int first = (sel / SAVE_MENU_PAGE_SIZE) * SAVE_MENU_PAGE_SIZE;
+            for (int i = first; i < model->ui.save_file_count && i < first + SAVE_MENU_PAGE_SIZE; i++)
             {
                 int menu_index = i + 1;
 
-                char buf[512];
-                snprintf(buf, sizeof(buf), "FICHIER : %s", model->save_files[i]);
+                char desc[128], buf[160];
+                save_index_describe(&model->ui.save_files[i], desc, sizeof(desc));
+                snprintf(buf, sizeof(buf), lang_get(STR_TXT_FILE), desc);
 
-                int col = (model->menu_selection == menu_index) ? 7 : 0;
-                if (model->menu_selection == menu_index)
-                    attron(COLOR_PAIR(7));
+                int col = (model->ui.menu_selection == menu_index) ? 7 : 0;
+                if (model->ui.menu_selection == menu_index)
+                    grid_attron(COLOR_PAIR(7));
 
-                draw_centered(-2 + (i * 1), buf, col);
+                draw_centered(-2 + (i - first), buf, col);
 
-                if (model->menu_selection == menu_index)
-                    attroff(COLOR_PAIR(7));
+                if (model->ui.menu_selection == menu_index)
+                    grid_attroff(COLOR_PAIR(7));
             }
+            draw_page_footer(sel, model->ui.save_file_count);
         }
 
-        draw_centered(rows / 2 - 2, "[ENTREE] Valider   [ECHAP] Retour", 4);
+        draw_centered(rows / 2 - 2, lang_get(STR_TXT_SAVE_SELECT_HINT), 4);
     }
     // SAUVEGARDE
-    else if (model->state == STATE_SAVE_INPUT)
+    else if (model->sim.state == STATE_SAVE_INPUT)
     {
-        draw_centered(-2, "NOM DE SAUVEGARDE :", 5);
+        draw_centered(-2, lang_get(STR_TXT_SAVE_NAME), 5);
         char buf[64];
-        snprintf(buf, 64, "[ %s_ ]", model->input_buffer);
+        snprintf(buf, 64, "[ %s_ ]", model->ui.input_buffer);
         draw_centered(0, buf, 7);
-        draw_centered(2, "(Lettres/Chiffres - ENTREE Valider)", 0);
+        draw_centered(2, lang_get(STR_TXT_SAVE_NAME_HINT), 0);
     }
-    else if (model->state == STATE_SAVE_SUCCESS)
+    else if (model->sim.state == STATE_SAVING)
     {
-        draw_centered(0, "SAUVEGARDE REUSSIE !", 1);
+        draw_centered(0, lang_get(STR_SAVING), 7);
+    }
+    else if (model->sim.state == STATE_SAVE_SUCCESS)
+    {
+        draw_centered(0, lang_get(STR_SAVE_DONE), 1);
     }
     // CONFIRMATION QUITTER (Classique Oui/Non)
-    else if (model->state == STATE_CONFIRM_QUIT)
+    else if (model->sim.state == STATE_CONFIRM_QUIT)
     {
-        draw_centered(-2, "VOULEZ-VOUS QUITTER ?", 2);
-        draw_centered(0, (model->menu_selection == 0 ? "> OUI <" : "  OUI  "), (model->menu_selection == 0 ? 7 : 0));
-        draw_centered(1, (model->menu_selection == 1 ? "> NON <" : "  NON  "), (model->menu_selection == 1 ? 7 : 0));
+        draw_centered(-2, lang_get(STR_TXT_QUIT_ASK), 2);
+        char yes[64], no[64];
+        snprintf(yes, sizeof(yes), model->ui.menu_selection == 0 ? "> %s <" : "  %s  ", lang_get(STR_TXT_YES));
+        snprintf(no, sizeof(no), model->ui.menu_selection == 1 ? "> %s <" : "  %s  ", lang_get(STR_TXT_NO));
+        draw_centered(0, yes, (model->ui.menu_selection == 0 ? 7 : 0));
+        draw_centered(1, no, (model->ui.menu_selection == 1 ? 7 : 0));
     }
 
     // CONFIRMATION ECRASER (Nouveau style)
-    else if (model->state == STATE_OVERWRITE_CONFIRM)
+    else if (model->sim.state == STATE_OVERWRITE_CONFIRM)
     {
-        draw_centered(-4, "CE FICHIER EXISTE DEJA !", 3);
+        draw_centered(-4, lang_get(STR_OVERWRITE_EXISTS), 3);
 
         char buf[64];
-        snprintf(buf, 64, "'%s.dat'", model->input_buffer);
+        snprintf(buf, 64, "'%s.dat'", model->ui.input_buffer);
         draw_centered(-2, buf, 7);
 
-        const char *opt0 = (model->menu_selection == 0) ? "> ECRASER <" : "  ECRASER  ";
-        const char *opt1 = (model->menu_selection == 1) ? "> CREER COPIE (1..) <" : "  CREER COPIE (1..)  ";
+        char opt0[64], opt1[64];
+        snprintf(opt0, sizeof(opt0), (model->ui.menu_selection == 0) ? "> %s <" : "  %s  ", lang_get(STR_TXT_OVERWRITE_REPLACE));
+        snprintf(opt1, sizeof(opt1), (model->ui.menu_selection == 1) ? "> %s <" : "  %s  ", lang_get(STR_TXT_OVERWRITE_COPY));
 
-        draw_centered(1, opt0, (model->menu_selection == 0 ? 2 : 0));
-        draw_centered(3, opt1, (model->menu_selection == 1 ? 7 : 0));
+        draw_centered(1, opt0, (model->ui.menu_selection == 0 ? 2 : 0));
+        draw_centered(3, opt1, (model->ui.menu_selection == 1 ? 7 : 0));
     }
-    refresh();
+    grid_flush();
 }
 
 // ============================================================================
 // GESTION INPUT
 // ============================================================================
 
+/**
+ * @brief Point d'entrée du rendu : render_frame, à l'abri du thread d'entrée.
+ */
+static void ncurses_render(const GameModel *model)
+{
+    if (input.running)
+        pthread_mutex_lock(&input.lock);
+    perf_model = model;
+    render_frame(model);
+    if (input.running)
+        pthread_mutex_unlock(&input.lock);
+}
+
 /**
  * @brief Récupère et traduit les entrées clavier en commandes de jeu.
  *
@@ -476,18 +1945,20 @@ static void ncurses_render(const GameModel *model)
  * - Espace : Tir
  * - Entrée : Validation
  * - P / Échap : Pause
+ * - F3 : Ligne de performances
+ * - F12 : Capture de la trace (SPACE_INVADERS_TRACE)
  * - Backspace : Effacement (en mode saisie)
  *
  * @param model Le modèle de jeu (utilisé pour connaître l'état et le buffer de saisie).
+ * @param ch Touche lue par getch.
  * @return La commande GameCommand correspondant à la touche pressée.
  */
-static GameCommand ncurses_get_input(GameModel *model)
+static GameCommand translate_key(GameModel *model, int ch)
 {
-    int ch = getch();
     if (ch == KEY_RESIZE)
         return CMD_NONE;
 
-    if (model->state == STATE_SAVE_INPUT)
+    if (model->sim.state == STATE_SAVE_INPUT)
     {
         if (ch == '\n' || ch == KEY_ENTER)
             return CMD_RETURN;
@@ -497,11 +1968,11 @@ static GameCommand ncurses_get_input(GameModel *model)
             return CMD_BACKSPACE;
         if (isalnum(ch) || ch == '-' || ch == '_')
         {
-            int len = strlen(model->input_buffer);
+            int len = strlen(model->ui.input_buffer);
             if (len < 19)
             {
-                model->input_buffer[len] = (char)ch;
-                model->input_buffer[len + 1] = '\0';
+                model->ui.input_buffer[len] = (char)ch;
+                model->ui.input_buffer[len + 1] = '\0';
             }
         }
         return CMD_NONE;
@@ -510,13 +1981,13 @@ static GameCommand ncurses_get_input(GameModel *model)
     switch (ch)
     {
     case KEY_LEFT:
-        return (model->state == STATE_PLAYING) ? CMD_MOVE_LEFT : CMD_LEFT;
+        return (model->sim.state == STATE_PLAYING) ? CMD_MOVE_LEFT : CMD_LEFT;
     case 'q':
-        return (model->state == STATE_PLAYING) ? CMD_MOVE_LEFT : CMD_LEFT;
+        return (model->sim.state == STATE_PLAYING) ? CMD_MOVE_LEFT : CMD_LEFT;
     case KEY_RIGHT:
-        return (model->state == STATE_PLAYING) ? CMD_MOVE_RIGHT : CMD_RIGHT;
+        return (model->sim.state == STATE_PLAYING) ? CMD_MOVE_RIGHT : CMD_RIGHT;
     case 'd':
-        return (model->state == STATE_PLAYING) ? CMD_MOVE_RIGHT : CMD_RIGHT;
+        return (model->sim.state == STATE_PLAYING) ? CMD_MOVE_RIGHT : CMD_RIGHT;
     case KEY_UP:
         return CMD_UP;
     case 'z':
@@ -535,13 +2006,143 @@ static GameCommand ncurses_get_input(GameModel *model)
         return CMD_PAUSE;
     case 27:
         return CMD_PAUSE;
+    case KEY_F(3):
+        perf_visible = !perf_visible;
+        grid.drawn_gen = 0; // Ligne d'état à effacer : image à recomposer
+        return CMD_NONE;
+    case KEY_F(9):
+        flight_request_dump(); // Vidage de l'enregistreur de vol (flightrec.h)
+        return CMD_NONE;
+    case KEY_F(12):
+        profiler_trace_flush(); // Capture de la trace en cours (SPACE_INVADERS_TRACE)
+        return CMD_NONE;
     default:
         return CMD_NONE;
     }
 }
 
+/**
+ * @brief Touche de jeu tenue (INPUT_*) correspondant à une touche, 0 pour les autres.
+ */
+static unsigned key_held_bit(int ch)
+{
+    switch (ch)
+    {
+    case KEY_LEFT:
+    case 'q':
+        return INPUT_LEFT;
+    case KEY_RIGHT:
+    case 'd':
+        return INPUT_RIGHT;
+    case ' ':
+        return INPUT_FIRE;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Lit toutes les touches en attente et dépose leurs commandes dans la file.
+ *
+ * Chaque touche est datée à sa lecture (ncurses ne fournit pas d'horodatage) :
+ * ici, ou dès son arrivée par le thread d'entrée s'il est actif.
+ * Valider ou annuler la saisie d'un nom arrête la lecture : les touches
+ * suivantes seront interprétées dans le nouvel état.
+ *
+ * Avec le protocole kitty, les touches de jeu sont suivies appui par
+ * relâchement : en partie, chaque changement dépose command_held à
+ * l'instant de la touche, puis l'état tenu est redéposé à chaque image,
+ * comme la Vue SDL. Les autres relâchements sont ignorés.
+ *
+ * @param model Le modèle de jeu (utilisé pour connaître l'état et le buffer de saisie).
+ * @param queue File où déposer les commandes lues.
+ */
+static void ncurses_get_input(GameModel *model, CommandQueue *queue)
+{
+    NcursesKey key;
+    for (;;)
+    {
+        if (input.running)
+        {
+            if (!spsc_pop(&input.ring, &key))
+                break;
+        }
+        else
+        {
+            key.ch = term_getch();
+            key.time = utils_get_time();
+            if (key.ch == ERR)
+                break;
+        }
+
+        if (kitty.active && model->sim.state != STATE_SAVE_INPUT)
+        {
+            unsigned bit = key_held_bit(key.ch & ~TERM_KEY_RELEASE);
+            unsigned held = (key.ch & TERM_KEY_RELEASE) ? kitty.held & ~bit : kitty.held | bit;
+            bool changed = held != kitty.held;
+            kitty.held = held;
+            if (bit && model->sim.state == STATE_PLAYING)
+            {
+                if (changed)
+                    command_queue_push(queue, command_held(held), key.time);
+                continue;
+            }
+            if (key.ch & TERM_KEY_RELEASE)
+                continue;
+        }
+        else if (key.ch & TERM_KEY_RELEASE)
+            continue;
+
+        GameCommand cmd = translate_key(model, key.ch);
+        if (cmd == CMD_NONE)
+            continue;
+        command_queue_push(queue, cmd, key.time);
+        if (model->sim.state == STATE_SAVE_INPUT && (cmd == CMD_RETURN || cmd == CMD_PAUSE))
+            return;
+    }
+    if (kitty.active && model->sim.state == STATE_PLAYING)
+        command_queue_push(queue, command_held(kitty.held), utils_get_time());
+}
+
+/**
+ * @brief Attend une touche au repos des menus (poll sur stdin), au plus `timeout` secondes.
+ *
+ * Avec le thread d'entrée, c'est lui qui lit stdin : on attend alors que sa
+ * file se remplisse, au pas de NCURSES_INPUT_POLL_MS. Un redimensionnement
+ * (SIGWINCH) interrompt poll : l'image suivante le prend en compte.
+ */
+static bool ncurses_wait_input(double timeout)
+{
+    if (perf_visible)
+        return false; // La ligne de performances se met à jour à chaque image
+    if (!input.running)
+    {
+        struct pollfd p = {STDIN_FILENO, POLLIN, 0};
+        poll(&p, 1, (int)(timeout * 1000.0));
+        return true;
+    }
+    double end = utils_get_time() + timeout;
+    while (spsc_empty(&input.ring) && utils_get_time() < end)
+        utils_sleep_until(utils_get_time() + NCURSES_INPUT_POLL_MS / 1000.0);
+    return true;
+}
+
 const ViewInterface view_ncurses = {
     .init = ncurses_init,
     .close = ncurses_close,
     .render = ncurses_render,
-    .get_input = ncurses_get_input};
\ No newline at end of file
+    .get_input = ncurses_get_input,
+    .wait_input = ncurses_wait_input};
+
+const ViewInterface view_ansi = {
+    .init = ansi_init,
+    .close = ansi_close,
+    .render = ncurses_render,
+    .get_input = ncurses_get_input,
+    .wait_input = ncurses_wait_input};
+
+const ViewInterface view_web = {
+    .init = web_init,
+    .close = web_close,
+    .render = ncurses_render,
+    .get_input = web_get_input};
@@ -7,8 +7,24 @@
  */
 
 #include "view_sdl.h"
+#include "affinity.h"
+#include "entity_type.h"
+#include "flightrec.h"
+#include "gputime.h"
+#include "startup.h"
+#include "memtrack.h"
+#include "power.h"
+#include "profiler.h"
+#include "sdf.h"
+#include "utils.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// Appels au renderer passés par les relais de l'enregistrement des commandes (après les en-têtes SDL)
+#define RENDERCAP_INTERPOSE
+#include "rendercap.h"
 
 // ============================================================================
 // 1. CONFIGURATION & GLOBALES
@@ -20,25 +36,53 @@ static SDLContext ctx = {0};
 // Facteurs de mise à l'échelle (Model -> Pixels)
 static float SCALE_X = 1.0f;
 static float SCALE_Y = 1.0f;
+
+// Pilote SDL_Renderer demandé (NULL : choix de SDL ; RENDER_DRIVER_GPU pour view_sdlgpu)
+static const char *render_driver = NULL;
 // ============================================================================
 // 2. FONCTIONS UTILITAIRES (HELPERS DE BASE)
 // ============================================================================
 
 /**
- * @brief Charge une image depuis un fichier et crée une texture SDL.
+ * @brief Ouvre une ressource en lecture : dans l'archive si elle y est, sinon sur le disque.
+ * @return Le flux (à fermer par l'appelant), ou NULL si le fichier est absent.
+ */
+static SDL_IOStream *asset_io(const char *path)
+{
+    const void *data;
+    const AssetEntry *e = asset_pack_find(&ctx.pack, path, &data);
+    if (e && e->kind == ASSET_RAW)
+        return SDL_IOFromConstMem(data, e->size);
+    SDL_IOStream *io = SDL_IOFromFile(path, "rb");
+    if (!io)
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Missing: %s", path);
+    return io;
+}
+
+/**
+ * @brief Charge une image depuis un fichier (sans créer de texture).
  *
  * Gère automatiquement la transparence pour les images sans canal alpha
- * en utilisant le noir (0,0,0) comme couleur clé.
+ * en utilisant le noir (0,0,0) comme couleur clé. Une image présente dans
+ * l'archive (asset_pack.h) pointe directement dans la projection. N'utilise
+ * pas le renderer : peut s'appeler depuis un thread de chargement.
  *
  * @param path Chemin vers le fichier image (BMP, PNG, etc.).
- * @return Pointeur vers la texture SDL créée, ou NULL en cas d'échec.
+ * @return La surface chargée, ou NULL en cas d'échec.
  */
-static SDL_Texture *load_texture(const char *path)
+static SDL_Surface *load_surface(const char *path)
 {
-    SDL_Surface *surface = IMG_Load(path);
+    const void *pixels;
+    const AssetEntry *e = asset_pack_find(&ctx.pack, path, &pixels);
+    if (e && e->kind == ASSET_PIXELS) // Déjà décodée, transparence comprise : aucune copie
+        return SDL_CreateSurfaceFrom((int)e->width, (int)e->height, (SDL_PixelFormat)e->format, (void *)pixels, (int)e->pitch);
+
+    SDL_IOStream *io = asset_io(path);
+    SDL_Surface *surface = io ? IMG_Load_IO(io, true) : NULL;
     if (!surface)
     {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Missing: %s", path);
+        if (io)
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Cannot decode %s: %s", path, SDL_GetError());
         return NULL;
     }
     if (SDL_GetPixelFormatDetails(surface->format)->bits_per_pixel < 32)
@@ -47,6 +91,51 @@ static SDL_Texture *load_texture(const char *path)
         Uint32 key = SDL_MapRGB(d, NULL, 0, 0, 0);
         SDL_SetSurfaceColorKey(surface, true, key);
     }
+    return surface;
+}
+
+/**
+ * @brief Charge un son (cf. MIX_LoadAudio) depuis l'archive ou le disque.
+ *
+ * @param bytes Reçoit la mémoire gardée par le son (NULL : non demandé) :
+ *              son PCM s'il est décodé, sinon le fichier, gardé entier.
+ */
+static MIX_Audio *load_audio(const char *path, bool predecode, uint64_t *bytes)
+{
+    SDL_IOStream *io = asset_io(path);
+    if (!io)
+        return NULL;
+    Sint64 size = SDL_GetIOSize(io);
+    MIX_Audio *audio = MIX_LoadAudio_IO(ctx.mixer, io, predecode, true);
+    if (audio && bytes)
+    {
+        SDL_AudioSpec spec;
+        Sint64 frames = MIX_GetAudioDuration(audio);
+        if (predecode && frames > 0 && MIX_GetAudioFormat(audio, &spec))
+            *bytes = (uint64_t)frames * SDL_AUDIO_FRAMESIZE(spec);
+        else
+            *bytes = size > 0 ? (uint64_t)size : 0;
+    }
+    return audio;
+}
+
+/**
+ * @brief Ouvre la police de FONT_PATH à une taille donnée, depuis l'archive ou le disque.
+ */
+static TTF_Font *load_font(float size)
+{
+    SDL_IOStream *io = asset_io(FONT_PATH);
+    return io ? TTF_OpenFontIO(io, true, size) : NULL;
+}
+
+/**
+ * @brief Crée une texture depuis une surface, puis libère la surface.
+ * @return La texture, ou NULL si la surface est NULL ou la création échoue.
+ */
+static SDL_Texture *texture_from_surface(SDL_Surface *surface)
+{
+    if (!surface)
+        return NULL;
     SDL_Texture *tex = SDL_CreateTextureFromSurface(ctx.renderer, surface);
     SDL_DestroySurface(surface);
     if (tex)
@@ -55,321 +144,3634 @@ static SDL_Texture *load_texture(const char *path)
 }
 
 /**
- * @brief Affiche du texte à une position donnée avec la police par défaut.
- *
- * @param text Le texte à afficher.
- * @param x Position horizontale en pixels.
- * @param y Position verticale en pixels.
- * @param color Couleur du texte (SDL_Color).
+ * @brief Crée une texture à partir de pixels du cache disque, sans conversion.
+ * @return La texture, ou NULL si la création échoue.
  */
-static void draw_text(const char *text, int x, int y, SDL_Color color)
+static SDL_Texture *texture_from_pixels(const TexcacheEntry *c)
 {
-    if (!ctx.font || !text || !text[0])
-        return;
-    SDL_Surface *s = TTF_RenderText_Blended(ctx.font, text, 0, color);
-    if (!s)
-        return;
-    SDL_Texture *t = SDL_CreateTextureFromSurface(ctx.renderer, s);
-    if (t)
-    {
-        SDL_FRect r = {(float)x, (float)y, (float)s->w, (float)s->h};
-        SDL_RenderTexture(ctx.renderer, t, NULL, &r);
-        SDL_DestroyTexture(t);
-    }
-    SDL_DestroySurface(s);
+    SDL_Texture *tex = SDL_CreateTexture(ctx.renderer, c->format, SDL_TEXTUREACCESS_STATIC, c->w, c->h);
+    if (!tex)
+        return NULL;
+    SDL_UpdateTexture(tex, NULL, c->pixels, c->pitch);
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_NEAREST);
+    return tex;
 }
 
 /**
- * @brief Affiche du texte centré horizontalement avec une police spécifique.
- *
- * @param text Le texte à afficher.
- * @param y Position verticale en pixels.
- * @param color Couleur du texte (SDL_Color).
- * @param font Police TTF à utiliser pour le rendu.
+ * @brief Fait une texture d'une image préparée, puis libère surface ou entrée de cache.
  */
-static void draw_text_centered(const char *text, int y, SDL_Color color, TTF_Font *font)
+static SDL_Texture *staged_upload(StagedImage *img)
 {
-    if (!font || !text || !text[0])
-        return;
-    SDL_Surface *s = TTF_RenderText_Blended(font, text, 0, color);
-    if (!s)
-        return;
-    SDL_Texture *t = SDL_CreateTextureFromSurface(ctx.renderer, s);
-    if (t)
+    SDL_Texture *tex;
+    if (img->cached.map)
     {
-        float x = (WIN_WIDTH - s->w) / 2.0f;
-        SDL_FRect r = {x, (float)y, (float)s->w, (float)s->h};
-        SDL_RenderTexture(ctx.renderer, t, NULL, &r);
-        SDL_DestroyTexture(t);
+        tex = texture_from_pixels(&img->cached);
+        texcache_release(&img->cached);
     }
-    SDL_DestroySurface(s);
+    else
+        tex = texture_from_surface(img->surface);
+    img->surface = NULL;
+    return tex;
 }
 
 /**
- * @brief Dessine une entité du jeu avec mise à l'échelle et décalage optionnel.
- *
- * Convertit les coordonnées du modèle de jeu en pixels écran
- * et applique un décalage pour les effets de tremblement.
+ * @brief Clé de cache d'un fichier : son chemin, '/' remplacés par '_'.
+ */
+static void cache_key(char *out, size_t cap, const char *path)
+{
+    snprintf(out, cap, "%s", path);
+    for (char *c = out; *c; c++)
+        if (*c == '/')
+            *c = '_';
+}
+
+/**
+ * @brief Prépare une image : depuis le cache disque s'il est à jour, sinon décodée (et mise en cache).
  *
- * @param tex Texture SDL de l'entité.
- * @param x Position X dans le modèle de jeu.
- * @param y Position Y dans le modèle de jeu.
- * @param w Largeur dans le modèle de jeu.
- * @param h Hauteur dans le modèle de jeu.
- * @param shake_x Décalage horizontal pour l'effet de tremblement.
- * @param shake_y Décalage vertical pour l'effet de tremblement.
+ * Avec une archive (asset_pack.h), l'image y est déjà décodée : le cache
+ * n'est pas consulté. N'utilise pas le renderer.
  */
-static void draw_entity_scaled(SDL_Texture *tex, float x, float y, float w, float h, int shake_x, int shake_y)
+static void stage_image(StagedImage *img, const char *path)
 {
-    if (!tex)
+    memset(img, 0, sizeof(*img));
+    char key[TEXCACHE_KEY_MAX];
+    cache_key(key, sizeof(key), path);
+    bool use_cache = (ctx.pack.base == NULL);
+    if (use_cache && texcache_open(&img->cached, key, &path, 1, 0))
         return;
-    SDL_FRect dst = {(x * SCALE_X) + shake_x, (y * SCALE_Y) + shake_y, w * SCALE_X, h * SCALE_Y};
-    SDL_RenderTexture(ctx.renderer, tex, NULL, &dst);
+    img->surface = load_surface(path);
+    if (use_cache && img->surface)
+        texcache_store(key, &path, 1, 0, img->surface, NULL, 0);
 }
 
 /**
- * @brief Dessine un overlay semi-transparent noir sur tout l'écran.
- *
- * Utilisé pour assombrir le fond lors des menus et popups.
+ * @brief Octets d'une texture (largeur x hauteur x octets par pixel ; 0 si NULL).
+ */
+static uint64_t texture_bytes(const SDL_Texture *t)
+{
+    return t ? (uint64_t)t->w * (uint64_t)t->h * SDL_BYTESPERPIXEL(t->format) : 0;
+}
+
+/**
+ * @brief Recompte la mémoire des textures et des copies en mémoire, audio excepté.
  *
- * @param alpha Niveau d'opacité (0 = transparent, 255 = opaque).
+ * Appelée quand l'ensemble des ressources change (chargement, redimensionnement),
+ * pas à chaque image : la liste est courte mais parcourt le cache de chaînes.
  */
-static void draw_overlay(int alpha)
+static void mem_census(void)
 {
-    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, alpha);
-    SDL_RenderFillRect(ctx.renderer, NULL);
-    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_NONE);
+    MemBudget *m = &ctx.mem;
+    m->bytes[MEM_SPRITES] = texture_bytes(ctx.tex.sprites);
+    m->bytes[MEM_BACKGROUNDS] =
+        texture_bytes(ctx.tex.bg_menu) + texture_bytes(ctx.tex.bg_menu_1) + texture_bytes(ctx.tex.bg_game);
+
+    uint64_t text = 0;
+    const GlyphAtlas *atlases[] = {&ctx.atlas, &ctx.atlas_title};
+    for (size_t i = 0; i < SDL_arraysize(atlases); i++)
+    {
+        text += texture_bytes(atlases[i]->texture);
+        if (atlases[i]->sheet)
+            text += (uint64_t)atlases[i]->sheet->pitch * (uint64_t)atlases[i]->sheet->h;
+    }
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+        text += texture_bytes(ctx.text_cache.entries[i].texture);
+    m->bytes[MEM_TEXT] = text;
+
+    uint64_t layers = texture_bytes(ctx.layer.texture) + texture_bytes(ctx.world.texture) +
+                      texture_bytes(ctx.hud.texture) + texture_bytes(ctx.formation.texture) +
+                      texture_bytes(ctx.present.lowres) + texture_bytes(ctx.thumbs.target);
+    for (int i = 0; i < CAPTURE_STAGING; i++)
+        layers += texture_bytes(ctx.capture.staging[i]);
+    for (int i = 0; i < MAX_SHIELDS; i++)
+        layers += texture_bytes(ctx.shields[i].texture);
+    for (int i = 0; i < SAVE_MENU_PAGE_SIZE; i++)
+        layers += texture_bytes(ctx.thumbs.page[i].texture);
+    m->bytes[MEM_LAYERS] = layers;
 }
 
-// ============================================================================
-// 3. FONCTIONS DE RENDU INTERMÉDIAIRES
-// ============================================================================
+/**
+ * @brief Journalise le bilan mémoire et les catégories non réductibles au-delà de leur plafond.
+ */
+static void mem_report(const char *when)
+{
+    mem_census();
+    char line[256];
+    membudget_format(&ctx.mem, line, sizeof(line));
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Memory (%s): %s", when, line);
+    const MemCategory fixed[] = {MEM_SPRITES, MEM_TEXT};
+    for (size_t i = 0; i < SDL_arraysize(fixed); i++)
+        if (ctx.mem.budget[fixed[i]] && ctx.mem.bytes[fixed[i]] > ctx.mem.budget[fixed[i]])
+            SDL_LogWarn(SDL_LOG_CATEGORY_VIDEO, "Memory: %s over budget, not reducible",
+                        membudget_name(fixed[i]));
+}
 
 /**
- * @brief Met à jour l'état audio selon l'état du jeu.
+ * @brief Comme staged_upload, pour un fond : réduit de moitié (de chaque côté) tant qu'il dépasse MEM_BACKGROUNDS.
  *
- * Gère la lecture des sons et musiques :
- * - Pause/reprise selon l'état du jeu
- * - Volume et mute
- * - Sons ponctuels (tir, explosion, etc.)
- * - Musique de fond et boucle UFO
- *
- * @param model Le modèle de jeu en lecture seule.
- * @param mutable_model Pointeur modifiable pour réinitialiser les flags sonores.
+ * La texture réduite est agrandie au rendu (filtre linéaire) : le fond est
+ * plus flou mais tient dans le plafond. Un fond qui ne tient pas même au
+ * huitième est écarté (NULL : l'écran se dessine sans lui).
  */
-static void update_audio_state(const GameModel *model, GameModel *mutable_model)
+static SDL_Texture *background_upload(StagedImage *img)
 {
-    if (!ctx.mixer)
-        return;
-    bool game_frozen = (model->state == STATE_PAUSED || model->state == STATE_CONFIRM_QUIT ||
-                        model->state == STATE_SAVE_SELECT || model->state == STATE_SAVE_INPUT);
+    MemBudget *m = &ctx.mem;
+    int w = img->cached.map ? img->cached.w : img->surface ? img->surface->w : 0;
+    int h = img->cached.map ? img->cached.h : img->surface ? img->surface->h : 0;
+    uint64_t used = texture_bytes(ctx.tex.bg_menu) + texture_bytes(ctx.tex.bg_menu_1) + texture_bytes(ctx.tex.bg_game);
+    int halvings = membudget_fit(m, MEM_BACKGROUNDS, used, (uint64_t)w * (uint64_t)h * 4, BUDGET_MAX_HALVINGS);
+    if (halvings == 0 || w == 0)
+        return staged_upload(img);
 
-    if (game_frozen)
-        MIX_PauseAllTracks(ctx.mixer);
-    else if (model->state == STATE_PLAYING || model->state == STATE_SAVE_SUCCESS)
-        MIX_ResumeAllTracks(ctx.mixer);
+    m->reduced[MEM_BACKGROUNDS]++;
+    SDL_Surface *full = img->surface;
+    if (img->cached.map)
+        full = SDL_CreateSurfaceFrom(w, h, img->cached.format, (void *)img->cached.pixels, img->cached.pitch);
+    SDL_Surface *small = NULL;
+    if (full && halvings > 0)
+        small = SDL_ScaleSurface(full, SDL_max(w >> halvings, 1), SDL_max(h >> halvings, 1), SDL_SCALEMODE_LINEAR);
+    SDL_DestroySurface(full);
+    if (img->cached.map)
+        texcache_release(&img->cached);
+    img->surface = NULL;
 
-    MIX_SetMasterGain(ctx.mixer, model->is_muted ? 0.0f : (float)model->volume / 100.0f);
+    SDL_Texture *tex = texture_from_surface(small);
+    if (tex)
+        SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_LINEAR);
+    if (halvings < 0)
+        SDL_LogWarn(SDL_LOG_CATEGORY_VIDEO, "Memory: %dx%d background dropped (budget)", w, h);
+    else
+        SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Memory: %dx%d background reduced to %dx%d (budget)", w, h,
+                    tex ? tex->w : 0, tex ? tex->h : 0);
+    return tex;
+}
 
-    bool in_menu = (model->state == STATE_MENU || model->state == STATE_TUTORIAL ||
-                    model->state == STATE_LOAD_MENU || model->state == STATE_GAME_OVER);
+/**
+ * @brief Image source et teinte de chaque sprite, dans l'ordre de SpriteId.
+ */
+static const struct
+{
+    const char *path; ///< Fichier image.
+    SDL_Color tint;   ///< Teinte appliquée une fois pour toutes dans l'atlas.
+} SPRITE_DEFS[SPRITE_COUNT] = {
+    [SPRITE_PLAYER] = {IMG_PLAYER, {0, 255, 0, 255}},
+    [SPRITE_UFO] = {IMG_UFO, {255, 0, 255, 255}},
+    [SPRITE_ENEMY_1A] = {IMG_ENEMY1_A, {0, 255, 255, 255}},
+    [SPRITE_ENEMY_1B] = {IMG_ENEMY1_B, {0, 255, 255, 255}},
+    [SPRITE_ENEMY_2A] = {IMG_ENEMY2_A, {255, 165, 0, 255}},
+    [SPRITE_ENEMY_2B] = {IMG_ENEMY2_B, {255, 165, 0, 255}},
+    [SPRITE_ENEMY_3A] = {IMG_ENEMY3_A, {255, 50, 50, 255}},
+    [SPRITE_ENEMY_3B] = {IMG_ENEMY3_B, {255, 50, 50, 255}},
+    [SPRITE_HEART_FULL] = {IMG_HEART_FULL, {255, 255, 255, 255}},
+    [SPRITE_HEART_EMPTY] = {IMG_HEART_EMPTY, {255, 255, 255, 255}},
+    [SPRITE_HEART_BONUS] = {IMG_HEART_FULL, {255, 215, 0, 255}},
+    [SPRITE_EXPL_PLAYER_A] = {IMG_EXPLOSION_A, {255, 100, 100, 255}},
+    [SPRITE_EXPL_PLAYER_B] = {IMG_EXPLOSION_B, {255, 100, 100, 255}},
+    [SPRITE_EXPL_ENEMY] = {"assets/explosions/enemyExplosion.bmp", {255, 255, 255, 255}},
+    [SPRITE_EXPL_UFO] = {"assets/explosions/ufoExplosion.bmp", {255, 255, 255, 255}},
+    [SPRITE_MISSILE_1] = {"assets/missiles/missile_1.bmp", {255, 255, 255, 255}},
+    [SPRITE_MISSILE_1 + 1] = {"assets/missiles/missile_2.bmp", {255, 255, 255, 255}},
+    [SPRITE_MISSILE_1 + 2] = {"assets/missiles/missile_3.bmp", {255, 255, 255, 255}},
+    [SPRITE_MISSILE_1 + 3] = {"assets/missiles/missile_4.bmp", {255, 255, 255, 255}},
+    [SPRITE_PROJECTILE_1] = {"assets/projectiles/projectileA_1.bmp", {255, 255, 255, 255}},
+    [SPRITE_PROJECTILE_1 + 1] = {"assets/projectiles/projectileA_2.bmp", {255, 255, 255, 255}},
+    [SPRITE_PROJECTILE_1 + 2] = {"assets/projectiles/projectileA_3.bmp", {255, 255, 255, 255}},
+    [SPRITE_PROJECTILE_1 + 3] = {"assets/projectiles/projectileA_4.bmp", {255, 255, 255, 255}},
+    [SPRITE_SHIELD_0] = {"assets/shelter/shelter_full.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 1] = {"assets/shelter/shelterDamaged_1.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 2] = {"assets/shelter/shelterDamaged_2.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 3] = {"assets/shelter/shelterDamaged_3.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 4] = {"assets/shelter/shelterDamaged_4.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 5] = {"assets/shelter/shelterDamaged_5.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 6] = {"assets/shelter/shelterDamaged_6.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 7] = {"assets/shelter/shelterDamaged_7.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 8] = {"assets/shelter/shelterDamaged_8.bmp", {0, 255, 0, 255}},
+    [SPRITE_SHIELD_0 + 9] = {"assets/shelter/shelterDamaged_9.bmp", {0, 255, 0, 255}}};
 
-    if (ctx.sfx.bg_music_track)
+/**
+ * @brief Niveaux d'un sprite de w x h pixels : l'image, puis ses moitiés d'au moins SPRITE_MIP_MIN de côté.
+ */
+static int sprite_mip_count(int w, int h)
+{
+    int n = 1;
+    while (n < SPRITE_MIP_LEVELS && (w >> n) >= SPRITE_MIP_MIN && (h >> n) >= SPRITE_MIP_MIN)
+        n++;
+    return n;
+}
+
+/**
+ * @brief Charge tous les sprites et les range dans une seule texture.
+ *
+ * Les images sont placées par étagères, de la plus haute à la plus basse,
+ * avec SPRITE_PADDING pixels transparents autour de chacune (le filtrage ne
+ * déborde jamais sur un voisin). Chaque image est multipliée par sa teinte
+ * pendant la copie. La transparence par couleur clé de load_surface est
+ * conservée : les pixels noirs des images sans alpha ne sont pas recopiés.
+ * Les niveaux réduits d'un grand sprite (sprite_mip_count) sont calculés
+ * depuis l'image teintée, chacun depuis le précédent (filtre linéaire :
+ * moyenne de chaque carré de 2 x 2), et rangés comme les autres images.
+ *
+ * Seule la planche est composée ici (sans renderer, depuis le thread de
+ * chargement) ; sprites_upload en fait la texture.
+ *
+ * @return La planche, ou NULL si aucun sprite n'a pu être chargé.
+ */
+static SDL_Surface *sprites_compose(GameTextures *tex)
+{
+    SDL_Surface *img[SPRITE_COUNT * SPRITE_MIP_LEVELS] = {0};
+    SDL_FRect *slot[SPRITE_COUNT * SPRITE_MIP_LEVELS];
+    int order[SPRITE_COUNT * SPRITE_MIP_LEVELS], n = 0, count = 0;
+    memset(tex->mips, 0, sizeof(tex->mips));
+    for (int i = 0; i < SPRITE_COUNT; i++)
     {
-        if (in_menu && !game_frozen)
+        tex->rects[i] = (SDL_FRect){0, 0, 0, 0};
+        SDL_Surface *src = load_surface(SPRITE_DEFS[i].path);
+        if (!src)
+            continue;
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceColorMod(src, SPRITE_DEFS[i].tint.r, SPRITE_DEFS[i].tint.g, SPRITE_DEFS[i].tint.b);
+        int levels = sprite_mip_count(src->w, src->h);
+        SDL_Surface *level = src;
+        if (levels > 1)
         {
-            if (!MIX_TrackPlaying(ctx.sfx.bg_music_track))
-                MIX_PlayTrack(ctx.sfx.bg_music_track, 0);
-            if (MIX_TrackPaused(ctx.sfx.bg_music_track))
-                MIX_ResumeTrack(ctx.sfx.bg_music_track);
+            // Niveaux réduits : depuis une copie déjà teintée, aux pixels clés transparents
+            level = SDL_CreateSurface(src->w, src->h, SDL_PIXELFORMAT_ARGB8888);
+            if (level)
+                SDL_BlitSurface(src, NULL, level, NULL);
+            SDL_DestroySurface(src);
+        }
+        for (int k = 0; k < levels && level; k++)
+        {
+            if (k > 0)
+            {
+                level = SDL_ScaleSurface(level, level->w / 2, level->h / 2, SDL_SCALEMODE_LINEAR);
+                if (!level)
+                    break;
+            }
+            SDL_SetSurfaceBlendMode(level, SDL_BLENDMODE_NONE);
+            img[count] = level;
+            slot[count] = k == 0 ? &tex->rects[i] : &tex->mips[i][k - 1];
+
+            // Tri par insertion, hauteur décroissante
+            int j = n++;
+            for (; j > 0 && img[order[j - 1]]->h < level->h; j--)
+                order[j] = order[j - 1];
+            order[j] = count++;
         }
-        else if (MIX_TrackPlaying(ctx.sfx.bg_music_track))
-            MIX_PauseTrack(ctx.sfx.bg_music_track);
     }
 
-    if (model->sounds.play_select_sound)
+    int x = 0, y = 0, shelf = 0;
+    for (int k = 0; k < n; k++)
     {
-        MIX_PlayAudio(ctx.mixer, ctx.sfx.select);
-        mutable_model->sounds.play_select_sound = false;
+        SDL_Surface *s = img[order[k]];
+        int w = s->w + 2 * SPRITE_PADDING, h = s->h + 2 * SPRITE_PADDING;
+        if (x + w > SPRITE_ATLAS_WIDTH)
+        {
+            x = 0;
+            y += shelf;
+            shelf = 0;
+        }
+        *slot[order[k]] = (SDL_FRect){(float)(x + SPRITE_PADDING), (float)(y + SPRITE_PADDING), (float)s->w, (float)s->h};
+        x += w;
+        if (h > shelf)
+            shelf = h;
     }
-    if (model->sounds.play_game_over)
+
+    SDL_Surface *sheet = (n > 0) ? SDL_CreateSurface(SPRITE_ATLAS_WIDTH, y + shelf, SDL_PIXELFORMAT_ARGB8888) : NULL;
+    if (sheet)
     {
-        MIX_PlayAudio(ctx.mixer, ctx.sfx.game_over);
-        mutable_model->sounds.play_game_over = false;
+        for (int k = 0; k < count; k++)
+        {
+            SDL_Rect dst = {(int)slot[k]->x, (int)slot[k]->y, img[k]->w, img[k]->h};
+            SDL_BlitSurface(img[k], NULL, sheet, &dst);
+        }
     }
-    if (model->sounds.play_level_up)
+    for (int k = 0; k < count; k++)
+        SDL_DestroySurface(img[k]);
+    return sheet;
+}
+
+/**
+ * @brief Prépare la planche des sprites : cache disque à jour, sinon sprites_compose.
+ *
+ * L'entrée de cache garde aussi les rectangles de l'atlas. Elle dépend des
+ * fichiers des sprites et de ce qui, dans le code, change la planche
+ * (teintes, largeur, marges).
+ */
+static void stage_sprites(StagedImage *img, GameTextures *tex)
+{
+    memset(img, 0, sizeof(*img));
+    const char *sources[SPRITE_COUNT];
+    uint64_t salt = TEXCACHE_HASH_SEED;
+    for (int i = 0; i < SPRITE_COUNT; i++)
     {
-        MIX_PlayAudio(ctx.mixer, ctx.sfx.level_up);
-        mutable_model->sounds.play_level_up = false;
+        sources[i] = SPRITE_DEFS[i].path;
+        salt = texcache_hash(&SPRITE_DEFS[i].tint, sizeof(SDL_Color), salt);
     }
+    int layout[4] = {SPRITE_ATLAS_WIDTH, SPRITE_PADDING, SPRITE_MIP_LEVELS, SPRITE_MIP_MIN};
+    salt = texcache_hash(layout, sizeof(layout), salt);
 
-    if (!game_frozen && model->state == STATE_PLAYING)
+    bool use_cache = (ctx.pack.base == NULL);
+    if (use_cache && texcache_open(&img->cached, "sprites", sources, SPRITE_COUNT, salt))
     {
-        if (model->sounds.play_shoot)
+        if (img->cached.meta_size == sizeof(tex->rects) + sizeof(tex->mips))
         {
-            MIX_PlayAudio(ctx.mixer, ctx.sfx.shoot);
-            mutable_model->sounds.play_shoot = false;
+            memcpy(tex->rects, img->cached.meta, sizeof(tex->rects));
+            memcpy(tex->mips, (const uint8_t *)img->cached.meta + sizeof(tex->rects), sizeof(tex->mips));
+            return;
         }
-        if (model->sounds.play_invader_killed)
-        {
-            MIX_PlayAudio(ctx.mixer, ctx.sfx.killed);
-            mutable_model->sounds.play_invader_killed = false;
-        }
-        if (model->sounds.play_player_explosion)
+        texcache_release(&img->cached);
+    }
+    img->surface = sprites_compose(tex);
+    if (use_cache && img->surface)
+    {
+        uint8_t meta[sizeof(tex->rects) + sizeof(tex->mips)]; // Rectangles, puis niveaux réduits
+        memcpy(meta, tex->rects, sizeof(tex->rects));
+        memcpy(meta + sizeof(tex->rects), tex->mips, sizeof(tex->mips));
+        texcache_store("sprites", sources, SPRITE_COUNT, salt, img->surface, meta, sizeof(meta));
+    }
+}
+
+/**
+ * @brief Fait de la planche préparée la texture d'atlas.
+ * @return false si aucun sprite n'a pu être chargé.
+ */
+static bool sprites_upload(GameTextures *tex, StagedImage *sheet)
+{
+    tex->sprites = staged_upload(sheet);
+    if (!tex->sprites)
+        return false;
+    SDL_GetTextureSize(tex->sprites, &tex->sprites_w, &tex->sprites_h);
+    SDL_SetTextureScaleMode(tex->sprites, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(tex->sprites, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+/**
+ * @brief Journalise la durée d'une étape du démarrage (depuis la précédente) et l'ajoute à sa phase.
+ */
+static void startup_step(const char *step, StartupPhase phase)
+{
+    double now = utils_get_time();
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Startup: %-10s %7.1f ms", step, (now - ctx.startup.last) * 1000.0);
+    startup_add(phase, now - ctx.startup.last);
+    ctx.startup.last = now;
+}
+
+/**
+ * @brief Thread de décodage des images du jeu (cf. WorldLoader).
+ */
+static int SDLCALL world_load_main(void *data)
+{
+    (void)data;
+    WorldLoader *w = &ctx.world_loader;
+    stage_sprites(&w->sheet, &ctx.tex);
+    stage_image(&w->bg_menu_1, IMG_BG_MENU_1);
+    if (!ctx.stars.enabled)
+        stage_image(&w->bg_game, IMG_BG_GAME);
+    w->decode_ms = (utils_get_time() - w->started) * 1000.0;
+    SDL_SetAtomicInt(&w->ready, 1);
+    return 0;
+}
+
+/**
+ * @brief Crée les textures du jeu dès que leurs images sont décodées.
+ *
+ * @param wait Attendre la fin du décodage (barrière avant de quitter le menu).
+ * @return true si les textures sont en place.
+ */
+static bool world_attach(bool wait)
+{
+    WorldLoader *w = &ctx.world_loader;
+    if (w->attached)
+        return true;
+    if (!wait && !SDL_GetAtomicInt(&w->ready))
+        return false;
+    double t0 = utils_get_time();
+    if (w->thread)
+        SDL_WaitThread(w->thread, NULL);
+    w->thread = NULL;
+    double waited = utils_get_time() - t0;
+
+    if (!sprites_upload(&ctx.tex, &w->sheet))
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sprite atlas unavailable");
+    ctx.tex.bg_menu_1 = background_upload(&w->bg_menu_1);
+    ctx.tex.bg_game = background_upload(&w->bg_game);
+    w->attached = true;
+    startup_add(STARTUP_IMAGES, w->decode_ms / 1000.0);
+    startup_add(STARTUP_TEXTURES, utils_get_time() - t0);
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "World assets: decoded in %.0f ms, uploaded in %.1f ms, render waited %.1f ms",
+                w->decode_ms, (utils_get_time() - t0 - waited) * 1000.0, waited * 1000.0);
+    mem_report("world");
+    return true;
+}
+
+/**
+ * @brief Change de cible de rendu.
+ *
+ * Le changement envoie les commandes en attente au pilote, qui peut alors
+ * allouer (comme dans SDL_RenderPresent) : ces allocations sont comptées à
+ * part de celles de la Vue.
+ */
+static void set_render_target(SDL_Texture *target)
+{
+    MemtrackStats mem;
+    memtrack_stats(&mem);
+    uint64_t before = mem.allocs;
+    gputime_flush(); // Le changement de cible envoie les commandes : lot horodaté
+    SDL_SetRenderTarget(ctx.renderer, target);
+    memtrack_stats(&mem);
+    ctx.perf.driver_allocs += (uint32_t)(mem.allocs - before);
+}
+
+/**
+ * @brief Copie une texture à l'écran (appel de dessin compté pour le panneau F3).
+ */
+static void render_texture(SDL_Texture *texture, const SDL_FRect *src, const SDL_FRect *dst)
+{
+    SDL_RenderTexture(ctx.renderer, texture, src, dst);
+    ctx.perf.draws++;
+}
+
+/**
+ * @brief Envoie les sprites en attente en un seul appel de dessin.
+ *
+ * À appeler avant tout dessin qui doit passer par-dessus les sprites déjà
+ * ajoutés (texte, voile), et en fin de scène.
+ */
+static void sprite_flush(void)
+{
+    SpriteBatch *b = &ctx.batch;
+    if (b->count == 0)
+        return;
+    SDL_RenderGeometry(ctx.renderer, ctx.tex.sprites, b->vertices, b->count * 4, b->indices, b->count * 6);
+    ctx.perf.draws++;
+    b->count = 0;
+}
+
+/**
+ * @brief Ajoute un sprite de l'atlas au lot, dans un rectangle écran, multiplié par une teinte.
+ */
+static void draw_sprite_tinted(SpriteId id, const SDL_FRect *dst, SDL_FColor tint)
+{
+    const SDL_FRect *src = &ctx.tex.rects[id];
+    if (!ctx.tex.sprites || src->w <= 0)
+        return;
+    // Plus petit niveau encore aussi large que le sprite en pixels de la cible
+    float px = dst->w * (ctx.present.scale > 0.0f ? ctx.present.scale : 1.0f);
+    for (int k = 0; k < SPRITE_MIP_LEVELS - 1 && ctx.tex.mips[id][k].w >= px; k++)
+        src = &ctx.tex.mips[id][k];
+    SpriteBatch *b = &ctx.batch;
+    if (b->count == SPRITE_BATCH_MAX)
+        sprite_flush();
+
+    float u0 = src->x / ctx.tex.sprites_w, v0 = src->y / ctx.tex.sprites_h;
+    float u1 = (src->x + src->w) / ctx.tex.sprites_w, v1 = (src->y + src->h) / ctx.tex.sprites_h;
+    SDL_Vertex *v = &b->vertices[b->count * 4];
+    v[0] = (SDL_Vertex){{dst->x, dst->y}, tint, {u0, v0}};
+    v[1] = (SDL_Vertex){{dst->x + dst->w, dst->y}, tint, {u1, v0}};
+    v[2] = (SDL_Vertex){{dst->x + dst->w, dst->y + dst->h}, tint, {u1, v1}};
+    v[3] = (SDL_Vertex){{dst->x, dst->y + dst->h}, tint, {u0, v1}};
+    b->count++;
+}
+
+/**
+ * @brief Ajoute un sprite de l'atlas au lot, dans un rectangle écran.
+ */
+static void draw_sprite(SpriteId id, const SDL_FRect *dst)
+{
+    static const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f}; // Teintes déjà dans l'atlas
+    draw_sprite_tinted(id, dst, white);
+}
+
+/** @brief Octet de l'alpha dans un pixel ARGB8888 (entier 32 bits natif). */
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define ARGB_ALPHA_BYTE 0
+#else
+#define ARGB_ALPHA_BYTE 3
+#endif
+
+/**
+ * @brief Rastérise chaque glyphe une fois, à SDF_BASE_SIZE, et en fait la planche de champs de distance.
+ *
+ * Les champs sont rangés par lignes de GLYPH_ATLAS_WIDTH pixels ; RVB blanc,
+ * alpha : le champ. Avances, crénage et hauteur de ligne sont relevés à la
+ * même taille.
+ *
+ * @return La planche, ou NULL si la police ou la mémoire manquent.
+ */
+static SDL_Surface *sdf_sheet_build(TTF_Font *font, SdfFontMeta *meta)
+{
+    memset(meta, 0, sizeof(*meta));
+    if (!font || !TTF_SetFontSize(font, SDF_BASE_SIZE))
+        return NULL;
+
+    SDL_Surface *glyphs[GLYPH_COUNT] = {0};
+    meta->height = TTF_GetFontHeight(font);
+    int x = 0, y = 0, row = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++)
+    {
+        char c[2] = {(char)(GLYPH_FIRST + i), '\0'};
+        int w = 0, h = 0;
+        TTF_GetStringSize(font, c, 1, &w, &h);
+        meta->advance[i] = w;
+        SDL_Surface *g = TTF_RenderText_Blended(font, c, 1, COL_WHITE);
+        if (!g)
+            continue; // Espace : avance seule, rien à dessiner
+        glyphs[i] = SDL_ConvertSurface(g, SDL_PIXELFORMAT_ARGB8888);
+        SDL_DestroySurface(g);
+        if (!glyphs[i])
+            continue;
+        int cw = glyphs[i]->w + 2 * SDF_SPREAD, ch = glyphs[i]->h + 2 * SDF_SPREAD;
+        if (x + cw > GLYPH_ATLAS_WIDTH)
         {
-            MIX_PlayAudio(ctx.mixer, ctx.sfx.explosion);
-            mutable_model->sounds.play_player_explosion = false;
+            x = 0;
+            y += row;
+            row = 0;
         }
-        if (model->sounds.play_beat)
+        meta->cell[i] = (SDL_Rect){x, y, cw, ch};
+        x += cw;
+        if (ch > row)
+            row = ch;
+    }
+
+    SDL_Surface *sheet = SDL_CreateSurface(GLYPH_ATLAS_WIDTH, y + row, SDL_PIXELFORMAT_ARGB8888);
+    if (sheet)
+        SDL_FillSurfaceRect(sheet, NULL, 0x00FFFFFFu); // Blanc, champ à 0 (loin à l'extérieur du tracé)
+    for (int i = 0; i < GLYPH_COUNT; i++)
+    {
+        if (!glyphs[i])
+            continue;
+        const SDL_Rect *c = &meta->cell[i];
+        if (sheet && !sdf_generate((const uint8_t *)glyphs[i]->pixels + ARGB_ALPHA_BYTE, glyphs[i]->w, glyphs[i]->h,
+                                   glyphs[i]->pitch, 4, SDF_SPREAD,
+                                   (uint8_t *)sheet->pixels + (size_t)c->y * sheet->pitch + (size_t)c->x * 4 + ARGB_ALPHA_BYTE,
+                                   sheet->pitch, 4))
         {
-            MIX_PlayAudio(ctx.mixer, ctx.sfx.beat[model->sounds.beat_index]);
-            mutable_model->sounds.play_beat = false;
+            SDL_DestroySurface(sheet);
+            sheet = NULL;
         }
+        SDL_DestroySurface(glyphs[i]);
+    }
 
-        if (ctx.sfx.ufo_track)
+    for (int p = 0; p < GLYPH_COUNT; p++)
+        for (int i = 0; i < GLYPH_COUNT; i++)
         {
-            if (model->sounds.ufo_loopING)
-            {
-                if (!MIX_TrackPlaying(ctx.sfx.ufo_track))
-                    MIX_PlayTrack(ctx.sfx.ufo_track, 0);
-                if (MIX_TrackPaused(ctx.sfx.ufo_track))
-                    MIX_ResumeTrack(ctx.sfx.ufo_track);
-            }
-            else if (MIX_TrackPlaying(ctx.sfx.ufo_track))
-                MIX_PauseTrack(ctx.sfx.ufo_track);
+            int k = 0;
+            if (TTF_GetGlyphKerning(font, (Uint32)(GLYPH_FIRST + p), (Uint32)(GLYPH_FIRST + i), &k))
+                meta->kerning[p][i] = (signed char)k;
         }
-    }
+    return sheet;
 }
 
 /**
- * @brief Dessine l'interface utilisateur en jeu (HUD).
+ * @brief Tire l'atlas d'une taille de la planche de champs de distance.
  *
- * Affiche le score, le niveau et les vies restantes (cœurs).
- * Les cœurs bonus au-delà de la limite normale sont colorés en or.
+ * Chaque glyphe est rééchantillonné (sdf_resample) à l'échelle
+ * size / SDF_BASE_SIZE, sans marge ; avances, crénage et hauteur de ligne
+ * suivent la même échelle. La surface reste en mémoire pour le cache de
+ * chaînes.
  *
- * @param model Le modèle de jeu contenant les informations à afficher.
+ * @param field Premier pixel de la planche (ARGB8888), `pitch` octets par ligne.
+ * @return false si la mémoire ou la texture manquent.
  */
-static void draw_hud(const GameModel *model)
+static bool atlas_bake(GlyphAtlas *atlas, const uint8_t *field, int pitch, const SdfFontMeta *meta, float size)
 {
-    char buf[64];
-    snprintf(buf, 64, "SCORE: %d   NIVEAU: %d", model->score, model->level);
-    draw_text(buf, 20, 20, COL_WHITE);
-
-    int start_x = WIN_WIDTH - 20;
-    int max_draw = (model->lives > MAX_LIVES_DISPLAY) ? model->lives : MAX_LIVES_DISPLAY;
-    for (int i = 0; i < max_draw; i++)
+    memset(atlas, 0, sizeof(GlyphAtlas));
+    float scale = size / SDF_BASE_SIZE;
+    atlas->size = size;
+    atlas->height = (int)lroundf((float)meta->height * scale);
+    int x = 0, y = 0, row = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++)
     {
-        int cx = start_x - ((i + 1) * (HEART_UI_SIZE + 5));
-        SDL_Texture *t = (i < model->lives) ? ctx.tex.heart_full : ctx.tex.heart_empty;
-        SDL_FRect r = {(float)cx, 20, HEART_UI_SIZE, HEART_UI_SIZE};
-        if (t)
+        atlas->advance[i] = (int)lroundf((float)meta->advance[i] * scale);
+        for (int p = 0; p < GLYPH_COUNT; p++)
+            atlas->kerning[p][i] = (signed char)lroundf((float)meta->kerning[p][i] * scale);
+        if (meta->cell[i].w == 0)
+            continue;
+        int w = (int)ceilf((float)(meta->cell[i].w - 2 * SDF_SPREAD) * scale);
+        int h = (int)ceilf((float)(meta->cell[i].h - 2 * SDF_SPREAD) * scale);
+        if (x + w > GLYPH_ATLAS_WIDTH)
         {
-            if (i >= MAX_LIVES_DISPLAY)
-                SDL_SetTextureColorMod(t, 255, 215, 0);
-            else
-                SDL_SetTextureColorMod(t, 255, 255, 255);
-            SDL_RenderTexture(ctx.renderer, t, NULL, &r);
+            x = 0;
+            y += row;
+            row = 0;
         }
+        atlas->src[i] = (SDL_FRect){(float)x, (float)y, (float)w, (float)h};
+        x += w;
+        if (h > row)
+            row = h;
+    }
+
+    atlas->sheet = SDL_CreateSurface(GLYPH_ATLAS_WIDTH, y + row, SDL_PIXELFORMAT_ARGB8888);
+    if (!atlas->sheet)
+        return false;
+    SDL_FillSurfaceRect(atlas->sheet, NULL, 0x00FFFFFFu);
+    for (int i = 0; i < GLYPH_COUNT; i++)
+    {
+        const SDL_Rect *c = &meta->cell[i];
+        const SDL_FRect *r = &atlas->src[i];
+        if (c->w == 0)
+            continue;
+        sdf_resample(field + (size_t)c->y * pitch + (size_t)c->x * 4 + ARGB_ALPHA_BYTE, c->w, c->h, pitch, 4, SDF_SPREAD, scale,
+                     (uint8_t *)atlas->sheet->pixels + (size_t)r->y * atlas->sheet->pitch + (size_t)r->x * 4 + ARGB_ALPHA_BYTE,
+                     (int)r->w, (int)r->h, atlas->sheet->pitch, 4);
     }
+    atlas->texture = SDL_CreateTextureFromSurface(ctx.renderer, atlas->sheet);
+    if (!atlas->texture)
+        return false;
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+    return true;
 }
 
 /**
- * @brief Dessine le monde de jeu complet.
+ * @brief Construit les atlas de toutes les tailles depuis une seule planche de champs de distance.
  *
- * Affiche tous les éléments du jeu avec effets visuels :
- * - Fond de jeu
- * - Joueur (avec clignotement rouge quand touché)
- * - Ennemis (avec animations et couleurs par type)
- * - UFO (avec effet d'explosion)
- * - Boucliers (avec états de dégradation)
- * - Balles (joueur et ennemis)
- * - Effet de tremblement d'écran quand le joueur est touché
+ * La planche vient du cache disque si elle correspond encore au fichier de
+ * police et aux paramètres (taille de base, portée, glyphes) ; sinon elle
+ * est rastérisée puis mise en cache. Avec une archive, pas de cache.
+ * La police est laissée à FONT_SIZE pour le rendu de secours.
  *
- * @param model Le modèle de jeu contenant l'état du monde.
+ * @return false si la planche ou l'un des atlas n'a pas pu être construit.
  */
-static void draw_game_world(const GameModel *model)
+static bool fonts_build(void)
 {
-    int sx = 0, sy = 0;
-    if (model->state == STATE_PLAYING && model->hit_timer > 0)
+    const char *source = FONT_PATH;
+    int params[5] = {SDF_BASE_SIZE, SDF_SPREAD, GLYPH_FIRST, GLYPH_LAST, GLYPH_ATLAS_WIDTH};
+    uint64_t salt = texcache_hash(params, sizeof(params), TEXCACHE_HASH_SEED);
+    bool use_cache = (ctx.pack.base == NULL);
+
+    static SdfFontMeta meta; // Plus de 9 Ko : hors de la pile
+    TexcacheEntry cached = {0};
+    SDL_Surface *sheet = NULL;
+    const uint8_t *field = NULL;
+    int pitch = 0;
+    if (use_cache && texcache_open(&cached, "font-sdf", &source, 1, salt) && cached.meta_size == sizeof(meta))
     {
-        sx = (rand() % 11) - 5;
-        sy = (rand() % 11) - 5;
+        memcpy(&meta, cached.meta, sizeof(meta));
+        field = cached.pixels;
+        pitch = cached.pitch;
+    }
+    else
+    {
+        texcache_release(&cached);
+        sheet = sdf_sheet_build(ctx.font, &meta);
+        if (!sheet)
+            return false;
+        if (use_cache)
+            texcache_store("font-sdf", &source, 1, salt, sheet, &meta, sizeof(meta));
+        field = sheet->pixels;
+        pitch = sheet->pitch;
+    }
+
+    bool ok = atlas_bake(&ctx.atlas, field, pitch, &meta, FONT_SIZE) &&
+              atlas_bake(&ctx.atlas_title, field, pitch, &meta, FONT_TITLE_SIZE);
+    texcache_release(&cached);
+    SDL_DestroySurface(sheet);
+    if (ctx.font)
+        TTF_SetFontSize(ctx.font, FONT_SIZE);
+    return ok;
+}
+
+/** @brief Détruit un atlas (texture et copie en mémoire). */
+static void atlas_free(GlyphAtlas *atlas)
+{
+    SDL_DestroyTexture(atlas->texture);
+    SDL_DestroySurface(atlas->sheet);
+    memset(atlas, 0, sizeof(GlyphAtlas));
+}
+
+/**
+ * @brief Met une chaîne en forme dans des tableaux de glyphes et d'abscisses (au plus `max`).
+ * @return Glyphes écrits, ou -1 si un caractère est hors atlas, si la chaîne dépasse `max` ou sa largeur un int16_t.
+ */
+static int shape_glyphs(const GlyphAtlas *atlas, const char *text, uint8_t *glyph, int16_t *xs, int max, int *width)
+{
+    int x = 0, prev = -1, n = 0;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+    {
+        if (*p < GLYPH_FIRST || *p > GLYPH_LAST || n == max || x > INT16_MAX)
+            return -1;
+        int g = *p - GLYPH_FIRST;
+        if (prev >= 0)
+            x += atlas->kerning[prev][g];
+        glyph[n] = (uint8_t)g;
+        xs[n++] = (int16_t)x;
+        x += atlas->advance[g];
+        prev = g;
+    }
+    *width = x;
+    return n;
+}
+
+/**
+ * @brief Met une chaîne en forme dans un atlas (glyphes, abscisses et largeur).
+ * @return false (run->len vaut -1) si l'atlas manque, si un caractère en est absent ou si la chaîne dépasse GLYPH_RUN_MAX.
+ */
+static bool shape_run(const GlyphAtlas *atlas, const char *text, GlyphRun *run)
+{
+    run->width = 0;
+    run->len = atlas->texture ? shape_glyphs(atlas, text, run->glyph, run->x, GLYPH_RUN_MAX, &run->width) : -1;
+    return run->len >= 0;
+}
+
+/**
+ * @brief Dessine des glyphes mis en forme depuis l'atlas.
+ */
+static void glyphs_draw(const GlyphAtlas *atlas, const uint8_t *glyph, const int16_t *xs, int len, float x, float y,
+                        SDL_Color color)
+{
+    SDL_SetTextureColorMod(atlas->texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(atlas->texture, color.a);
+    for (int i = 0; i < len; i++)
+    {
+        const SDL_FRect *src = &atlas->src[glyph[i]];
+        if (src->w > 0)
+        {
+            SDL_FRect dst = {x + xs[i], y, src->w, src->h};
+            render_texture(atlas->texture, src, &dst);
+        }
+    }
+}
+
+/**
+ * @brief Dessine une chaîne mise en forme depuis l'atlas.
+ */
+static void atlas_draw(const GlyphAtlas *atlas, const GlyphRun *run, float x, float y, SDL_Color color)
+{
+    glyphs_draw(atlas, run->glyph, run->x, run->len, x, y, color);
+}
+
+/**
+ * @brief Chaîne plus longue qu'une GlyphRun : mise en forme dans l'arène d'image, puis dessinée depuis l'atlas.
+ *
+ * @param x Position horizontale, ou une valeur négative pour centrer.
+ * @return false si un caractère est hors atlas ou si l'arène est pleine (rendu de secours alors).
+ */
+static bool draw_text_frame(const GlyphAtlas *atlas, const char *text, float x, int y, SDL_Color color)
+{
+    size_t len = strlen(text);
+    if (!atlas->texture || len > INT16_MAX)
+        return false;
+    uint8_t *glyph = frame_arena_alloc(&ctx.frame, len);
+    int16_t *xs = glyph ? frame_arena_alloc(&ctx.frame, len * sizeof(int16_t)) : NULL;
+    int width = 0;
+    int n = xs ? shape_glyphs(atlas, text, glyph, xs, (int)len, &width) : -1;
+    if (n < 0)
+        return false;
+    glyphs_draw(atlas, glyph, xs, n, x < 0 ? (WIN_WIDTH - width) / 2.0f : x, (float)y, color);
+    return true;
+}
+
+/**
+ * @brief Rendu de secours (caractère hors atlas) : rastérisation et envoi à chaque appel.
+ *
+ * @param x Position horizontale, ou une valeur négative pour centrer.
+ * @param size Taille de police voulue (celle de l'atlas qui n'a pas pu servir).
+ */
+static void draw_text_ttf(const char *text, float x, int y, SDL_Color color, float size)
+{
+    if (!ctx.font || (TTF_GetFontSize(ctx.font) != size && !TTF_SetFontSize(ctx.font, size)))
+        return;
+    SDL_Surface *s = TTF_RenderText_Blended(ctx.font, text, 0, color);
+    if (!s)
+        return;
+    SDL_Texture *t = SDL_CreateTextureFromSurface(ctx.renderer, s);
+    ctx.perf.uploads++;
+    if (t)
+    {
+        if (x < 0)
+            x = (WIN_WIDTH - s->w) / 2.0f;
+        SDL_FRect r = {x, (float)y, (float)s->w, (float)s->h};
+        render_texture(t, NULL, &r);
+        SDL_DestroyTexture(t);
+    }
+    SDL_DestroySurface(s);
+}
+
+/** @brief Hachage FNV-1a d'une chaîne (longueur renvoyée dans `len`). */
+static uint32_t text_hash(const char *text, size_t *len)
+{
+    uint32_t h = 2166136261u;
+    size_t n = 0;
+    for (; text[n]; n++)
+        h = (h ^ (unsigned char)text[n]) * 16777619u;
+    *len = n;
+    return h;
+}
+
+/**
+ * @brief Compose une chaîne mise en forme depuis la copie en mémoire d'un atlas.
+ *
+ * Les glyphes blancs sont fondus sur un fond blanc transparent (les bords
+ * restent blancs, seul l'alpha varie) ; la teinte passe ensuite par color mod.
+ *
+ * @return La surface, ou NULL si la mémoire manque.
+ */
+static SDL_Surface *atlas_compose(const GlyphAtlas *atlas, const GlyphRun *run)
+{
+    SDL_Surface *s = SDL_CreateSurface(run->width > 0 ? run->width : 1, atlas->height, SDL_PIXELFORMAT_ARGB8888);
+    if (!s)
+        return NULL;
+    SDL_FillSurfaceRect(s, NULL, 0x00FFFFFFu);
+    SDL_SetSurfaceBlendMode(atlas->sheet, SDL_BLENDMODE_BLEND);
+    for (int i = 0; i < run->len; i++)
+    {
+        const SDL_FRect *src = &atlas->src[run->glyph[i]];
+        if (src->w > 0)
+        {
+            SDL_Rect from = {(int)src->x, (int)src->y, (int)src->w, (int)src->h};
+            SDL_Rect to = {run->x[i], 0, from.w, from.h};
+            SDL_BlitSurface(atlas->sheet, &from, s, &to);
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief Cherche une chaîne rendue dans le cache, ou la compose depuis l'atlas et l'ajoute.
+ *
+ * La clé est (atlas, hachage, couleur) ; le texte stocké départage les
+ * collisions. Sur un défaut, l'entrée libre ou la moins récemment utilisée
+ * est remplacée.
+ *
+ * @param run Mise en forme de `text` dans `atlas` (chaîne de la table), ou NULL pour la faire au besoin.
+ * @return L'entrée, ou NULL si la chaîne est trop longue, hors atlas ou n'a pas pu être composée.
+ */
+static const TextCacheEntry *text_cache_get(const char *text, SDL_Color color, const GlyphAtlas *atlas, const GlyphRun *run)
+{
+    TextCache *cache = &ctx.text_cache;
+    size_t len;
+    uint32_t hash = text_hash(text, &len);
+    uint32_t key = ((uint32_t)color.r << 24) | ((uint32_t)color.g << 16) | ((uint32_t)color.b << 8) | color.a;
+    if (len >= TEXT_CACHE_MAX_LEN)
+        return NULL;
+
+    TextCacheEntry *victim = &cache->entries[0];
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+    {
+        TextCacheEntry *e = &cache->entries[i];
+        if (e->texture && e->atlas == atlas && e->hash == hash && e->color == key && strcmp(e->text, text) == 0)
+        {
+            e->last_used = ++cache->clock;
+            cache->hits++;
+            return e;
+        }
+        if (victim->texture && (!e->texture || e->last_used < victim->last_used))
+            victim = e;
+    }
+
+    GlyphRun shaped;
+    if (!run && shape_run(atlas, text, &shaped))
+        run = &shaped;
+    if (!run || run->len < 0 || !atlas->sheet)
+        return NULL;
+    cache->misses++;
+    SDL_Surface *s = atlas_compose(atlas, run);
+    if (!s)
+        return NULL;
+    SDL_Texture *t = SDL_CreateTextureFromSurface(ctx.renderer, s);
+    ctx.perf.uploads++;
+    float w = (float)s->w, h = (float)s->h;
+    SDL_DestroySurface(s);
+    if (!t)
+        return NULL;
+    SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(t, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(t, color.a);
+
+    if (victim->texture)
+        cache->evictions++;
+    SDL_DestroyTexture(victim->texture);
+    victim->texture = t;
+    victim->atlas = atlas;
+    victim->hash = hash;
+    victim->color = key;
+    memcpy(victim->text, text, len + 1);
+    victim->w = w;
+    victim->h = h;
+    victim->last_used = ++cache->clock;
+    return victim;
+}
+
+/** @brief Détruit les textures du cache de chaînes. */
+static void text_cache_clear(void)
+{
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+        SDL_DestroyTexture(ctx.text_cache.entries[i].texture);
+    memset(&ctx.text_cache, 0, sizeof(ctx.text_cache));
+    ctx.menu.valid = false;
+}
+
+/**
+ * @brief Affiche du texte à une position donnée avec la police par défaut.
+ *
+ * @param text Le texte à afficher.
+ * @param x Position horizontale en pixels.
+ * @param y Position verticale en pixels.
+ * @param color Couleur du texte (SDL_Color).
+ */
+static void draw_text(const char *text, int x, int y, SDL_Color color)
+{
+    if (!text || !text[0])
+        return;
+    GlyphRun run;
+    if (shape_run(&ctx.atlas, text, &run))
+        atlas_draw(&ctx.atlas, &run, (float)x, (float)y, color);
+    else if (!draw_text_frame(&ctx.atlas, text, (float)x, y, color))
+        draw_text_ttf(text, (float)x, y, color, FONT_SIZE);
+}
+
+/**
+ * @brief Écrit un entier en caractères, sans snprintf : chiffres de droite à gauche, puis retournés.
+ *
+ * @param decimals Chiffres après la virgule (`value` compte alors des 10^-decimals).
+ * @param out Au moins COUNTER_DIGITS_MAX caractères (pas de zéro final).
+ * @return Nombre de caractères écrits.
+ */
+static int counter_format(long long value, int decimals, char *out)
+{
+    char rev[COUNTER_DIGITS_MAX];
+    unsigned long long v = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    int n = 0, digits = 0;
+    do
+    {
+        if (digits == decimals && decimals > 0)
+            rev[n++] = '.';
+        rev[n++] = (char)('0' + v % 10);
+        v /= 10;
+        digits++;
+    } while ((v > 0 || digits <= decimals) && n < COUNTER_DIGITS_MAX - 2);
+    if (value < 0)
+        rev[n++] = '-';
+    for (int i = 0; i < n; i++)
+        out[i] = rev[n - 1 - i];
+    return n;
+}
+
+/**
+ * @brief Dessine un compteur avec les glyphes des chiffres de l'atlas.
+ *
+ * Les chiffres avancent tous de la largeur de '0' : un score qui défile ne
+ * fait pas bouger le texte qui le suit. Une copie de rectangle par
+ * caractère, sans mise en forme ni envoi de texture.
+ *
+ * @return Largeur dessinée en pixels.
+ */
+static int draw_counter(const GlyphAtlas *atlas, long long value, int decimals, float x, float y, SDL_Color color)
+{
+    char text[COUNTER_DIGITS_MAX];
+    int len = counter_format(value, decimals, text);
+    int digit_advance = atlas->advance['0' - GLYPH_FIRST];
+    SDL_SetTextureColorMod(atlas->texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(atlas->texture, color.a);
+    int w = 0;
+    for (int i = 0; i < len; i++)
+    {
+        int g = text[i] - GLYPH_FIRST;
+        const SDL_FRect *src = &atlas->src[g];
+        if (src->w > 0)
+        {
+            SDL_FRect dst = {x + w, y, src->w, src->h};
+            render_texture(atlas->texture, src, &dst);
+        }
+        w += (text[i] >= '0' && text[i] <= '9') ? digit_advance : atlas->advance[g];
+    }
+    return w;
+}
+
+/**
+ * @brief Dessine une chaîne fixe depuis l'atlas standard, mise en forme à l'appel.
+ * @return Sa largeur en pixels (0 si elle n'entre pas dans l'atlas).
+ */
+static int draw_label(const char *text, float x, float y, SDL_Color color)
+{
+    GlyphRun run;
+    if (!shape_run(&ctx.atlas, text, &run))
+        return 0;
+    atlas_draw(&ctx.atlas, &run, x, y, color);
+    return run.width;
+}
+
+/**
+ * @brief Affiche du texte centré horizontalement à la taille d'un atlas.
+ *
+ * La chaîne est copiée depuis le cache de textures (composée depuis l'atlas
+ * au premier affichage seulement) ; l'atlas ne sert directement que si elle
+ * ne peut pas y entrer. Pendant la construction d'un plan de menu, la ligne
+ * y est enregistrée.
+ *
+ * @param text Le texte à afficher.
+ * @param run Sa mise en forme dans `atlas` (chaîne de la table), ou NULL pour la faire au besoin.
+ * @param y Position verticale en pixels.
+ * @param color Couleur du texte (SDL_Color).
+ * @param atlas Atlas de la taille voulue (ctx.atlas, ctx.atlas_title).
+ */
+static void draw_run_centered(const char *text, const GlyphRun *run, int y, SDL_Color color, const GlyphAtlas *atlas)
+{
+    if (!text || !text[0])
+        return;
+    const TextCacheEntry *cached = text_cache_get(text, color, atlas, run);
+    if (cached)
+    {
+        SDL_FRect r = {(WIN_WIDTH - cached->w) / 2.0f, (float)y, cached->w, cached->h};
+        render_texture(cached->texture, NULL, &r);
+        MenuLayout *menu = &ctx.menu;
+        if (menu->recording && menu->count < MENU_LAYOUT_MAX_ROWS)
+        {
+            menu->rows[menu->count].texture = cached->texture;
+            menu->rows[menu->count++].dst = r;
+        }
+        else if (menu->recording)
+            menu->direct = true;
+        return;
+    }
+    ctx.menu.direct = ctx.menu.direct || ctx.menu.recording;
+
+    GlyphRun shaped;
+    if (!run && shape_run(atlas, text, &shaped))
+        run = &shaped;
+    if (run && run->len >= 0)
+        atlas_draw(atlas, run, (WIN_WIDTH - run->width) / 2.0f, (float)y, color);
+    else if (!draw_text_frame(atlas, text, -1.0f, y, color))
+        draw_text_ttf(text, -1.0f, y, color, atlas->size > 0 ? atlas->size : FONT_SIZE);
+}
+
+/** @brief Affiche du texte centré, mis en forme à l'appel (chaîne formatée ou hors table). */
+static void draw_text_centered(const char *text, int y, SDL_Color color, const GlyphAtlas *atlas)
+{
+    draw_run_centered(text, NULL, y, color, atlas);
+}
+
+/**
+ * @brief Formate une ligne dans l'arène d'image (longueur exacte), puis l'affiche centrée.
+ *
+ * Arène pleine : la ligne passe par un tampon sur la pile, tronquée à TEXT_LINE_FALLBACK.
+ */
+__attribute__((format(printf, 4, 5))) static void draw_textf_centered(int y, SDL_Color color, const GlyphAtlas *atlas,
+                                                                     const char *fmt, ...)
+{
+    va_list args, again;
+    va_start(args, fmt);
+    va_copy(again, args);
+    char fallback[TEXT_LINE_FALLBACK];
+    const char *text = frame_arena_vprintf(&ctx.frame, fmt, args);
+    if (!text)
+    {
+        vsnprintf(fallback, sizeof(fallback), fmt, again);
+        text = fallback;
+    }
+    va_end(again);
+    va_end(args);
+    draw_text_centered(text, y, color, atlas);
+}
+
+/** @brief "> texte <" pour la ligne sélectionnée, sinon `plain` (format à un %s). */
+static const char *selected_format(bool selected, const char *plain)
+{
+    return selected ? "> %s <" : plain;
+}
+
+/** @brief Affiche une chaîne de la table centrée, avec sa mise en forme pré-calculée (StringRuns). */
+static void draw_string_centered(StringId id, int y, SDL_Color color, const GlyphAtlas *atlas)
+{
+    draw_run_centered(lang_get(id), &ctx.strings.runs[id][atlas == &ctx.atlas_title], y, color, atlas);
+}
+
+/**
+ * @brief Découpe le format STR_HUD en textes fixes mis en forme et en compteurs (HudLayer).
+ *
+ * Les conversions sont prises dans l'ordre de snprintf : score, niveau, puis
+ * les deux bonus. Toute autre conversion, ou un texte hors atlas, laisse
+ * le format entier à snprintf (segment_count à 0).
+ */
+static void hud_format_update(void)
+{
+    HudLayer *hud = &ctx.hud;
+    static const HudSegmentKind numbers[2] = {HUD_SEG_SCORE, HUD_SEG_LEVEL};
+    static const HudSegmentKind flags[2] = {HUD_SEG_RAPID, HUD_SEG_SPREAD};
+    const char *fmt = lang_get(STR_HUD);
+    int n = 0, ints = 0, strs = 0;
+    hud->segment_count = 0;
+    if (ctx.strings.runs[STR_HUD_RAPID][0].len < 0 || ctx.strings.runs[STR_HUD_SPREAD][0].len < 0)
+        return;
+    while (*fmt)
+    {
+        char text[GLYPH_RUN_MAX + 1];
+        int len = 0;
+        while (*fmt && len < GLYPH_RUN_MAX)
+        {
+            if (fmt[0] == '%' && fmt[1] == '%')
+                fmt++;
+            else if (fmt[0] == '%')
+                break;
+            text[len++] = *fmt++;
+        }
+        text[len] = '\0';
+        if (len > 0)
+        {
+            if (n == HUD_SEGMENTS_MAX || !shape_run(&ctx.atlas, text, &hud->segments[n].run))
+                return;
+            hud->segments[n++].kind = HUD_SEG_TEXT;
+        }
+        if (!*fmt)
+            break;
+        if (*fmt != '%' || n == HUD_SEGMENTS_MAX)
+            return; // Texte fixe de plus de GLYPH_RUN_MAX caractères, ou format trop morcelé
+        if (fmt[1] == 'd' && ints < 2)
+            hud->segments[n++].kind = numbers[ints++];
+        else if (fmt[1] == 's' && strs < 2)
+            hud->segments[n++].kind = flags[strs++];
+        else
+            return;
+        fmt += 2;
+    }
+    hud->segment_count = n;
+}
+
+/**
+ * @brief Met en forme les chaînes de la table dans les deux atlas si la langue ou les atlas ont changé.
+ *
+ * Les textures du cache de chaînes, le calque de l'écran et le bandeau HUD
+ * portent les textes de l'ancienne langue : ils sont refaits.
+ */
+static void strings_update(void)
+{
+    if (ctx.strings.gen == lang_generation())
+        return;
+    for (int i = 0; i < STR_COUNT; i++)
+    {
+        shape_run(&ctx.atlas, lang_get((StringId)i), &ctx.strings.runs[i][0]);
+        shape_run(&ctx.atlas_title, lang_get((StringId)i), &ctx.strings.runs[i][1]);
+    }
+    ctx.strings.gen = lang_generation();
+    text_cache_clear();
+    ctx.layer.key = 0;
+    ctx.hud.valid = false;
+    hud_format_update();
+}
+
+/**
+ * @brief Dessine une entité du jeu avec mise à l'échelle et décalage optionnel.
+ *
+ * Convertit les coordonnées du modèle de jeu en pixels écran.
+ *
+ * @param id Sprite de l'entité dans l'atlas.
+ * @param x Position X dans le modèle de jeu.
+ * @param y Position Y dans le modèle de jeu.
+ * @param w Largeur dans le modèle de jeu.
+ * @param h Hauteur dans le modèle de jeu.
+ */
+static void draw_entity_scaled(SpriteId id, float x, float y, float w, float h)
+{
+    SDL_FRect dst = {x * SCALE_X, y * SCALE_Y, w * SCALE_X, h * SCALE_Y};
+    draw_sprite(id, &dst);
+}
+
+/**
+ * @brief Dessine les cellules intactes d'un bouclier en bitmap, une bande par suite de cellules.
+ *
+ * Vide d'abord le lot de sprites : les rectangles pleins passent directement
+ * par le renderer, l'ordre de dessin est gardé.
+ */
+static void draw_shield_cells(const Shield *sh)
+{
+    SDL_FRect runs[SHIELD_BITMAP_ROWS * SHIELD_BITMAP_COLS / 2];
+    int n = 0;
+    float cw = SCALE_X / SHIELD_BITMAP_SCALE, ch = SCALE_Y / SHIELD_BITMAP_SCALE;
+    for (int r = 0; r < SHIELD_BITMAP_ROWS; r++)
+    {
+        uint32_t bits = sh->bits[r];
+        int c = 0;
+        while (bits >> c)
+        {
+            c += __builtin_ctz(bits >> c);
+            uint32_t rest = ~(bits >> c);
+            int len = rest ? __builtin_ctz(rest) : SHIELD_BITMAP_COLS - c;
+            runs[n++] = (SDL_FRect){sh->x * SCALE_X + c * cw, sh->y * SCALE_Y + r * ch, len * cw, ch};
+            c += len;
+            if (c >= SHIELD_BITMAP_COLS)
+                break;
+        }
+    }
+    sprite_flush();
+    SDL_SetRenderDrawColor(ctx.renderer, COL_GREEN.r, COL_GREEN.g, COL_GREEN.b, 255);
+    SDL_RenderFillRects(ctx.renderer, runs, n);
+}
+
+/**
+ * @brief Met à jour la texture d'un bouclier en bitmap, puis la dessine.
+ *
+ * Seules les lignes qui diffèrent de `shown` partent, en une bande
+ * [première, dernière] par SDL_UpdateTexture : l'envoi suit les dégâts de
+ * l'image, pas le nombre de boucliers. À génération inchangée (`gen`,
+ * MODEL_GEN_SHIELDS), la texture est redessinée telle quelle. Sans texture,
+ * repli sur draw_shield_cells.
+ */
+static void draw_shield_texture(ShieldTexture *st, const Shield *sh, uint64_t gen)
+{
+    if (!st->texture && !st->failed)
+    {
+        st->texture = SDL_CreateTexture(ctx.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                        SHIELD_BITMAP_COLS, SHIELD_BITMAP_ROWS);
+        st->failed = !st->texture;
+        st->valid = false;
+        if (st->texture)
+        {
+            SDL_SetTextureBlendMode(st->texture, SDL_BLENDMODE_BLEND);
+            SDL_SetTextureScaleMode(st->texture, SDL_SCALEMODE_NEAREST);
+            ctx.perf.uploads++;
+        }
+    }
+    if (!st->texture)
+    {
+        draw_shield_cells(sh);
+        return;
+    }
+
+    int first = -1, last = -1;
+    for (int r = 0; r < SHIELD_BITMAP_ROWS && !(st->valid && st->gen == gen); r++)
+    {
+        if (st->valid && st->shown[r] == sh->bits[r])
+            continue;
+        if (first < 0)
+            first = r;
+        last = r;
+    }
+    if (first >= 0)
+    {
+        const uint32_t on = 0xFF000000u | (uint32_t)COL_GREEN.r << 16 | (uint32_t)COL_GREEN.g << 8 | COL_GREEN.b;
+        uint32_t pixels[SHIELD_BITMAP_ROWS][SHIELD_BITMAP_COLS];
+        for (int r = first; r <= last; r++)
+        {
+            for (int c = 0; c < SHIELD_BITMAP_COLS; c++)
+                pixels[r - first][c] = (sh->bits[r] >> c & 1) ? on : 0;
+            st->shown[r] = sh->bits[r];
+        }
+        SDL_Rect band = {0, first, SHIELD_BITMAP_COLS, last - first + 1};
+        SDL_UpdateTexture(st->texture, &band, pixels, (int)sizeof(pixels[0]));
+        st->valid = true;
+        ctx.perf.shield_rows += (uint32_t)(last - first + 1);
+    }
+    st->gen = gen;
+
+    sprite_flush();
+    SDL_FRect dst = {sh->x * SCALE_X, sh->y * SCALE_Y, sh->width * SCALE_X, sh->height * SCALE_Y};
+    render_texture(st->texture, NULL, &dst);
+}
+
+/**
+ * @brief Dessine un overlay semi-transparent noir sur tout l'écran.
+ *
+ * Utilisé pour assombrir le fond lors des menus et popups.
+ *
+ * @param alpha Niveau d'opacité (0 = transparent, 255 = opaque).
+ */
+static void draw_overlay(int alpha)
+{
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, alpha);
+    SDL_RenderFillRect(ctx.renderer, NULL);
+    ctx.perf.draws++;
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_NONE);
+}
+
+/**
+ * @brief Affiche "PAGE x/y" sous une liste de sauvegardes (si plus d'une page).
+ *
+ * @param selection Index de l'élément sélectionné dans la liste.
+ * @param count Nombre total d'éléments.
+ */
+static void draw_page_footer(int selection, int count)
+{
+    int pages = (count + SAVE_MENU_PAGE_SIZE - 1) / SAVE_MENU_PAGE_SIZE;
+    if (pages <= 1)
+        return;
+
+    draw_textf_centered(WIN_HEIGHT - 100, COL_GRAY, &ctx.atlas, lang_get(STR_PAGE), selection / SAVE_MENU_PAGE_SIZE + 1,
+                        pages);
+}
+
+/**
+ * @brief Dessine le texte variable de l'écran de menu courant (options, sélection, listes, saisie).
+ *
+ * Le fond, le voile et les titres fixes viennent du calque (draw_static_layer) ;
+ * les miniatures sont ajoutées par l'appelant.
+ */
+static void draw_menu_text(const GameModel *model)
+{
+    if (model->sim.state == STATE_MENU)
+    {
+        const StringId opts[] = {STR_MENU_PLAY, STR_MENU_TUTORIAL, STR_MENU_LOAD, STR_MENU_VOLUME, STR_MENU_QUIT};
+        for (int i = 0; i < 5; i++)
+        {
+            SDL_Color c = (i == model->ui.menu_selection) ? COL_YELLOW : COL_GRAY;
+            int y = WIN_HEIGHT / 2 + i * 50;
+            if (i == 3 && model->ui.is_muted)
+                draw_text_centered(lang_get(STR_VOLUME_MUTED), y, c, &ctx.atlas);
+            else if (i == 3)
+            {
+                char b[11] = {0};
+                int n = model->ui.volume / 10;
+                for (int k = 0; k < 10; k++)
+                    b[k] = (k < n) ? '|' : '-';
+                draw_textf_centered(y, c, &ctx.atlas, lang_get(STR_VOLUME_BAR), b, model->ui.volume);
+            }
+            else
+                draw_textf_centered(y, c, &ctx.atlas, selected_format(i == model->ui.menu_selection, "%s"),
+                                    lang_get(opts[i]));
+        }
+    }
+    else if (model->sim.state == STATE_PAUSED)
+    {
+        const StringId opts[] = {STR_PAUSE_RESUME, STR_MENU_VOLUME, STR_PAUSE_SAVE_QUIT, STR_PAUSE_QUIT_NOSAVE};
+        for (int i = 0; i < 4; i++)
+        {
+            SDL_Color c = (i == model->ui.menu_selection) ? COL_YELLOW : COL_GRAY;
+            int y = WIN_HEIGHT / 2 - 50 + i * 60;
+            if (i == 1)
+                draw_textf_centered(y, c, &ctx.atlas, lang_get(model->ui.is_muted ? STR_SOUND_OFF : STR_SOUND_LEVEL),
+                                    model->ui.volume);
+            else
+                draw_textf_centered(y, c, &ctx.atlas, selected_format(i == model->ui.menu_selection, "%s"),
+                                    lang_get(opts[i]));
+        }
+    }
+    else if (model->sim.state == STATE_GAME_OVER)
+    {
+        draw_textf_centered(WIN_HEIGHT / 2 - 50, COL_WHITE, &ctx.atlas, lang_get(STR_FINAL_SCORE), model->sim.score);
+        if (model->ui.highscore_rank > 0)
+            draw_textf_centered(WIN_HEIGHT / 2 - 20, COL_YELLOW, &ctx.atlas, lang_get(STR_NEW_RECORD),
+                                model->ui.highscore_rank, HIGHSCORE_COUNT);
+        else if (model->ui.highscores.count > 0)
+            draw_textf_centered(WIN_HEIGHT / 2 - 20, COL_GRAY, &ctx.atlas, lang_get(STR_BEST_SCORE),
+                                model->ui.highscores.entries[0].score);
+        const StringId labels[] = {STR_RETRY_LEVEL, STR_SAVE, STR_REPLAY, STR_MENU_QUIT}; // Par GameOverOption
+        GameOverOption opts[GAME_OVER_OPTION_COUNT];
+        int count = model_game_over_options(model, opts);
+        int gap = (count > 3) ? 50 : 60;
+        for (int i = 0; i < count; i++)
+        {
+            SDL_Color c = (i == model->ui.menu_selection) ? COL_WHITE : COL_GRAY;
+            const char *label = frame_arena_printf(&ctx.frame, lang_get(labels[opts[i]]), model_retry_level(model));
+            draw_textf_centered(WIN_HEIGHT / 2 + 30 + i * gap, c, &ctx.atlas,
+                                selected_format(i == model->ui.menu_selection, "%s"),
+                                label ? label : lang_get(labels[opts[i]]));
+        }
+    }
+    else if (model->sim.state == STATE_CONFIRM_QUIT)
+    {
+        const StringId opts[] = {STR_CONFIRM_YES, STR_CONFIRM_NO, STR_PAUSE_SAVE_QUIT};
+        for (int i = 0; i < 3; i++)
+        {
+            SDL_Color c = (i == model->ui.menu_selection) ? COL_YELLOW : COL_GRAY;
+            draw_textf_centered(WIN_HEIGHT / 2 + 50 + i * 60, c, &ctx.atlas,
+                                selected_format(i == model->ui.menu_selection, "%s"), lang_get(opts[i]));
+        }
+    }
+    else if (model->sim.state == STATE_SAVE_SELECT || model->sim.state == STATE_LOAD_MENU || model->sim.state == STATE_SAVE_INPUT || model->sim.state == STATE_OVERWRITE_CONFIRM)
+    {
+        if (model->sim.state == STATE_SAVE_SELECT)
+        {
+            draw_string_centered(STR_SAVE_SELECT, 80, COL_YELLOW, &ctx.atlas_title);
+            draw_textf_centered(180, (model->ui.menu_selection == 0) ? COL_GREEN : COL_GRAY, &ctx.atlas,
+                                selected_format(model->ui.menu_selection == 0, " %s "), lang_get(STR_SAVE_NEW));
+            // La ligne 0 est "Créer nouvelle" : la sélection i + 1 désigne le fichier i
+            int sel = (model->ui.menu_selection > 0) ? model->ui.menu_selection - 1 : 0;
+            int first = (sel / SAVE_MENU_PAGE_SIZE) * SAVE_MENU_PAGE_SIZE;
+            for (int i = first; i < model->ui.save_file_count && i < first + SAVE_MENU_PAGE_SIZE; i++)
+            {
+                char desc[128];
+                save_index_describe(&model->ui.save_files[i], desc, sizeof(desc));
+                draw_textf_centered(230 + (i - first) * 45, (i + 1 == model->ui.menu_selection) ? COL_WHITE : COL_GRAY,
+                                    &ctx.atlas, selected_format(i + 1 == model->ui.menu_selection, "%s"), desc);
+            }
+            draw_page_footer(sel, model->ui.save_file_count);
+        }
+        else if (model->sim.state == STATE_LOAD_MENU)
+        {
+            draw_string_centered(STR_LOAD_TITLE, 100, COL_GREEN, &ctx.atlas_title);
+            if (model->ui.save_file_count == 0 && model->ui.save_scan_pending)
+                draw_string_centered(STR_LOAD_SCANNING, WIN_HEIGHT / 2, COL_GRAY, &ctx.atlas);
+            else if (model->ui.save_file_count == 0)
+                draw_string_centered(STR_LOAD_NONE, WIN_HEIGHT / 2, COL_RED, &ctx.atlas);
+            // Pagination : on affiche la page contenant la sélection
+            int first = (model->ui.menu_selection / SAVE_MENU_PAGE_SIZE) * SAVE_MENU_PAGE_SIZE;
+            for (int i = first; i < model->ui.save_file_count && i < first + SAVE_MENU_PAGE_SIZE; i++)
+            {
+                char desc[128];
+                save_index_describe(&model->ui.save_files[i], desc, sizeof(desc));
+                draw_textf_centered(200 + (i - first) * 40, (i == model->ui.menu_selection) ? COL_WHITE : COL_GRAY,
+                                    &ctx.atlas, selected_format(i == model->ui.menu_selection, "%s"), desc);
+            }
+            draw_page_footer(model->ui.menu_selection, model->ui.save_file_count);
+        }
+        else if (model->sim.state == STATE_SAVE_INPUT)
+        {
+            draw_string_centered(STR_SAVE_NAME, WIN_HEIGHT / 2 + 20, COL_YELLOW, &ctx.atlas_title);
+            draw_textf_centered(WIN_HEIGHT / 2 + 100, COL_WHITE, &ctx.atlas, "%s_", model->ui.input_buffer);
+            draw_string_centered(STR_SAVE_NAME_HINT, WIN_HEIGHT / 2 + 150, COL_GRAY, &ctx.atlas);
+        }
+        else
+        {
+            draw_string_centered(STR_OVERWRITE_EXISTS, WIN_HEIGHT / 2 - 100, (SDL_Color){255, 165, 0, 255}, &ctx.atlas);
+
+            draw_textf_centered(WIN_HEIGHT / 2 - 50, COL_WHITE, &ctx.atlas, lang_get(STR_OVERWRITE_FILE),
+                                model->ui.input_buffer);
+
+            SDL_Color col0 = (model->ui.menu_selection == 0) ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){128, 128, 128, 255};
+            draw_textf_centered(WIN_HEIGHT / 2 + 30, col0, &ctx.atlas, selected_format(model->ui.menu_selection == 0, "  %s  "),
+                                lang_get(STR_OVERWRITE_REPLACE));
+
+            SDL_Color col1 = (model->ui.menu_selection == 1) ? (SDL_Color){0, 255, 0, 255} : (SDL_Color){128, 128, 128, 255};
+            draw_textf_centered(WIN_HEIGHT / 2 + 80, col1, &ctx.atlas, selected_format(model->ui.menu_selection == 1, "  %s  "),
+                                lang_get(STR_OVERWRITE_COPY));
+        }
+    }
+    else if (model->sim.state == STATE_SAVING)
+    {
+        draw_string_centered(STR_SAVING, WIN_HEIGHT / 2, COL_WHITE, &ctx.atlas_title);
+    }
+    else if (model->sim.state == STATE_SAVE_SUCCESS)
+    {
+        draw_string_centered(STR_SAVE_DONE, WIN_HEIGHT / 2 - 40, COL_GREEN, &ctx.atlas_title);
+        draw_string_centered(STR_SAVE_RETURNING, WIN_HEIGHT / 2 + 40, COL_WHITE, &ctx.atlas);
+    }
+}
+
+/**
+ * @brief Dessine l'écran de menu depuis son plan (MenuLayout), reconstruit si la clé a changé.
+ *
+ * Le plan se construit en dessinant l'écran une fois (draw_menu_text) ; les
+ * images suivantes ne font que recopier ses lignes. Un écran dont une ligne
+ * n'entre pas dans le cache de chaînes est redessiné à chaque image.
+ */
+static void draw_menu(const GameModel *model)
+{
+    MenuLayout *menu = &ctx.menu;
+    size_t len;
+    uint32_t input_hash = text_hash(model->ui.input_buffer, &len);
+    if (menu->valid && menu->state == (int)model->sim.state && menu->menu_gen == model->ui.gen[MODEL_GEN_MENU] &&
+        menu->hud_gen == model->ui.gen[MODEL_GEN_HUD] && menu->input_hash == input_hash &&
+        menu->evictions == ctx.text_cache.evictions)
+    {
+        if (menu->direct)
+        {
+            draw_menu_text(model);
+            return;
+        }
+        for (int i = 0; i < menu->count; i++)
+            render_texture(menu->rows[i].texture, NULL, &menu->rows[i].dst);
+        return;
+    }
+
+    menu->count = 0;
+    menu->direct = false;
+    menu->recording = true;
+    uint64_t evictions = ctx.text_cache.evictions;
+    draw_menu_text(model);
+    menu->recording = false;
+    // Une éviction pendant la construction a pu détruire une ligne déjà enregistrée
+    menu->direct = menu->direct || ctx.text_cache.evictions != evictions;
+    menu->state = (int)model->sim.state;
+    menu->menu_gen = model->ui.gen[MODEL_GEN_MENU];
+    menu->hud_gen = model->ui.gen[MODEL_GEN_HUD];
+    menu->input_hash = input_hash;
+    menu->evictions = ctx.text_cache.evictions;
+    menu->valid = true;
+    menu->builds++;
+}
+
+// ============================================================================
+// 3. FONCTIONS DE RENDU INTERMÉDIAIRES
+// ============================================================================
+
+/**
+ * @brief Fichier, emplacement et mode de lecture de chaque son.
+ */
+static const struct
+{
+    const char *path;  ///< Fichier du son.
+    MIX_Audio **slot;  ///< Emplacement dans ctx.sfx (NULL : lu en flux par sa piste, jamais résident).
+    bool predecode;    ///< Décodé en PCM résident (false : fichier gardé entier, décodé à la lecture).
+    MIX_Track **track; ///< Piste dédiée (NULL : voix ponctuelles).
+} SOUND_DEFS[] = {
+    {"assets/audio/shootSound.wav", &ctx.sfx.shoot, true, NULL},
+    {"assets/audio/invaderKilledSound.wav", &ctx.sfx.killed, true, NULL},
+    {"assets/audio/explosionSound.wav", &ctx.sfx.explosion, true, NULL},
+    {"assets/audio/ufoSound.wav", &ctx.sfx.ufo, true, &ctx.sfx.ufo_track},
+    {"assets/audio/gameOverSound.wav", &ctx.sfx.game_over, true, NULL},
+    {"assets/audio/levelUpSound.wav", &ctx.sfx.level_up, true, NULL},
+    {"assets/audio/selectSound.wav", &ctx.sfx.select, true, NULL},
+    {"assets/audio/menuSound.wav", NULL, false, &ctx.sfx.bg_music_track},
+    {"assets/audio/fastinvader1.wav", &ctx.sfx.beat[0], true, NULL},
+    {"assets/audio/fastinvader2.wav", &ctx.sfx.beat[1], true, NULL},
+    {"assets/audio/fastinvader3.wav", &ctx.sfx.beat[2], true, NULL},
+    {"assets/audio/fastinvader4.wav", &ctx.sfx.beat[3], true, NULL}};
+
+/**
+ * @brief Premier mixage sur le thread du périphérique audio : y applique le réglage AUDIO.
+ *
+ * Ce thread appartient à SDL ; le rappel de fin de mixage est le seul code
+ * du jeu qui s'y exécute. Installé seulement si un réglage est demandé.
+ */
+static void SDLCALL audio_thread_setup(void *userdata, MIX_Mixer *mixer, const SDL_AudioSpec *spec, float *pcm,
+                                       int samples)
+{
+    (void)userdata;
+    (void)mixer;
+    (void)spec;
+    (void)pcm;
+    (void)samples;
+    static int applied = 0;
+    if (!__atomic_exchange_n(&applied, 1, __ATOMIC_RELAXED))
+        affinity_apply(THREAD_ROLE_AUDIO);
+}
+
+/**
+ * @brief Branche un fichier sur une piste, lu par morceaux pendant le mixage.
+ *
+ * Le mixeur n'en lit que l'en-tête ici ; la suite est lue et décodée au fil
+ * de la lecture, sur son propre thread. Le flux appartient ensuite à la piste.
+ *
+ * @return false (flux fermé) si le fichier est absent ou illisible.
+ */
+static bool track_stream(MIX_Track *track, const char *path)
+{
+    SDL_IOStream *io = asset_io(path);
+    if (!io)
+        return false;
+    if (MIX_SetTrackIOStream(track, io, true))
+        return true;
+    SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Cannot stream %s: %s", path, SDL_GetError());
+    SDL_CloseIO(io);
+    return false;
+}
+
+/**
+ * @brief Thread de chargement audio : ouvre le mixeur, décode les sons, crée les pistes.
+ *
+ * Les bruitages courts sont décodés une fois en PCM résident (lecture sans
+ * décodage ni accès disque). La musique de fond n'est pas chargée : sa piste
+ * lit le fichier par morceaux pendant le mixage (track_stream), si bien que
+ * ni sa durée de décodage ni sa taille ne pèsent sur le démarrage et la
+ * mémoire. Le thread principal ne touche à rien de tout cela avant que
+ * `ready` passe à 1 (cf. audio_attach).
+ */
+static int SDLCALL audio_load_main(void *data)
+{
+    (void)data;
+    // Fréquence et tampon demandés (SPACE_INVADERS_AUDIO_RATE, SPACE_INVADERS_AUDIO_FRAMES), relus à l'ouverture
+    const char *rate_env = getenv("SPACE_INVADERS_AUDIO_RATE");
+    const char *frames_env = getenv("SPACE_INVADERS_AUDIO_FRAMES");
+    int rate = rate_env && atoi(rate_env) > 0 ? atoi(rate_env) : AUDIO_DEFAULT_RATE;
+    int frames = frames_env && atoi(frames_env) > 0 ? atoi(frames_env) : AUDIO_DEFAULT_FRAMES;
+    char hint[16];
+    snprintf(hint, sizeof(hint), "%d", frames);
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, hint);
+    SDL_AudioSpec spec = {SDL_AUDIO_S16, 2, rate};
+    ctx.mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    if (ctx.mixer)
+    {
+        if (affinity_configured(THREAD_ROLE_AUDIO))
+            MIX_SetPostMixCallback(ctx.mixer, audio_thread_setup, NULL);
+        SDL_AudioDeviceID device =
+            (SDL_AudioDeviceID)SDL_GetNumberProperty(MIX_GetMixerProperties(ctx.mixer), MIX_PROP_MIXER_DEVICE_NUMBER, 0);
+        SDL_AudioSpec opened = spec;
+        int opened_frames = frames;
+        if (device && SDL_GetAudioDeviceFormat(device, &opened, &opened_frames))
+        {
+            rate = opened.freq;
+            frames = opened_frames;
+        }
+        ctx.audio_latency.rate = rate;
+        ctx.audio_latency.frames = frames;
+        ctx.audio_latency.output_ms = rate > 0 ? 2000.0 * frames / rate : 0.0;
+
+        ctx.sfx.loop = SDL_CreateProperties();
+        if (ctx.sfx.loop)
+            SDL_SetNumberProperty(ctx.sfx.loop, MIX_PROP_PLAY_LOOPS_NUMBER, -1);
+        // Un son qui dépasse le plafond MEM_AUDIO est libéré : il restera muet
+        uint64_t budget = ctx.mem.budget[MEM_AUDIO];
+        for (size_t i = 0; i < SDL_arraysize(SOUND_DEFS); i++)
+        {
+            if (!SOUND_DEFS[i].slot)
+                continue; // Lu en flux : rien de résident
+            uint64_t bytes = 0;
+            MIX_Audio *audio = load_audio(SOUND_DEFS[i].path, SOUND_DEFS[i].predecode, &bytes);
+            if (audio && budget && ctx.audio_loader.bytes + bytes > budget)
+            {
+                MIX_DestroyAudio(audio);
+                audio = NULL;
+                ctx.audio_loader.dropped++;
+            }
+            else if (audio)
+                ctx.audio_loader.bytes += bytes;
+            *SOUND_DEFS[i].slot = audio;
+        }
+        for (size_t i = 0; i < SDL_arraysize(SOUND_DEFS); i++)
+        {
+            if (SOUND_DEFS[i].slot || !(*SOUND_DEFS[i].track = MIX_CreateTrack(ctx.mixer)))
+                continue;
+            if (!track_stream(*SOUND_DEFS[i].track, SOUND_DEFS[i].path))
+            {
+                MIX_DestroyTrack(*SOUND_DEFS[i].track);
+                *SOUND_DEFS[i].track = NULL;
+            }
+        }
+        if (ctx.sfx.ufo)
+        {
+            ctx.sfx.ufo_track = MIX_CreateTrack(ctx.mixer);
+            if (ctx.sfx.ufo_track)
+                MIX_SetTrackAudio(ctx.sfx.ufo_track, ctx.sfx.ufo);
+        }
+
+        // Réserve de voix des bruitages
+        while (ctx.voices.count < SFX_VOICES)
+        {
+            MIX_Track *t = MIX_CreateTrack(ctx.mixer);
+            if (!t)
+                break;
+            ctx.voices.voices[ctx.voices.count++].track = t;
+        }
+    }
+    ctx.audio_applied.gain = -1.0f;
+    ctx.audio_applied.music = ctx.audio_applied.ufo = -1;
+    SDL_SetAtomicInt(&ctx.audio_loader.ready, 1);
+    return 0;
+}
+
+/**
+ * @brief Branche l'audio dès que le thread de chargement a fini.
+ * @return true si l'audio est prêt (mixeur ouvert ou non).
+ */
+static bool audio_attach(void)
+{
+    if (ctx.audio_loader.attached)
+        return true;
+    if (!SDL_GetAtomicInt(&ctx.audio_loader.ready))
+        return false;
+    if (ctx.audio_loader.thread)
+        SDL_WaitThread(ctx.audio_loader.thread, NULL);
+    ctx.audio_loader.thread = NULL;
+    ctx.audio_loader.attached = true;
+    startup_add(STARTUP_AUDIO, utils_get_time() - ctx.audio_loader.started);
+    SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO, "Audio ready after %.0f ms", (utils_get_time() - ctx.audio_loader.started) * 1000.0);
+    const AudioLatency *lat = &ctx.audio_latency;
+    if (ctx.mixer)
+        SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO, "Audio: %d Hz, %d frames, output latency ~%.1f ms", lat->rate, lat->frames,
+                    lat->output_ms);
+    if (ctx.mixer && lat->output_ms > AUDIO_LATENCY_BUDGET_MS)
+        SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Audio: latency above %.0f ms (SPACE_INVADERS_AUDIO_FRAMES)",
+                    AUDIO_LATENCY_BUDGET_MS);
+    ctx.mem.bytes[MEM_AUDIO] = ctx.audio_loader.bytes;
+    ctx.mem.reduced[MEM_AUDIO] = ctx.audio_loader.dropped;
+    if (ctx.audio_loader.dropped)
+        SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Memory: %u sound(s) left silent (budget)", ctx.audio_loader.dropped);
+    mem_report("audio");
+    return true;
+}
+
+/**
+ * @brief Son SDL correspondant à un événement du Modèle (NULL : non chargé).
+ */
+static MIX_Audio *event_audio(AudioSound sound)
+{
+    switch (sound)
+    {
+    case AUDIO_SHOOT:
+        return ctx.sfx.shoot;
+    case AUDIO_INVADER_KILLED:
+        return ctx.sfx.killed;
+    case AUDIO_PLAYER_EXPLOSION:
+        return ctx.sfx.explosion;
+    case AUDIO_SELECT:
+        return ctx.sfx.select;
+    case AUDIO_GAME_OVER:
+        return ctx.sfx.game_over;
+    case AUDIO_LEVEL_UP:
+        return ctx.sfx.level_up;
+    default:
+        if (sound >= AUDIO_BEAT && sound < AUDIO_SOUND_COUNT)
+            return ctx.sfx.beat[sound - AUDIO_BEAT];
+        return NULL;
+    }
+}
+
+/** @brief Lectures simultanées au plus de chaque son (AudioSound). */
+static const int SOUND_VOICE_LIMIT[AUDIO_SOUND_COUNT] = {
+    [AUDIO_SHOOT] = 3,
+    [AUDIO_INVADER_KILLED] = 4,
+    [AUDIO_PLAYER_EXPLOSION] = 2,
+    [AUDIO_SELECT] = 2,
+    [AUDIO_GAME_OVER] = 1,
+    [AUDIO_LEVEL_UP] = 1,
+    [AUDIO_BEAT] = 1,
+    [AUDIO_BEAT + 1] = 1,
+    [AUDIO_BEAT + 2] = 1,
+    [AUDIO_BEAT + 3] = 1,
+};
+
+/**
+ * @brief Choisit la voix d'un nouveau son.
+ *
+ * Son plafond atteint, le son reprend sa propre voix la plus ancienne ;
+ * sinon une voix libre, et à défaut la plus ancienne de la réserve.
+ */
+static SfxVoice *voice_pick(AudioSound sound)
+{
+    VoicePool *pool = &ctx.voices;
+    SfxVoice *free_voice = NULL, *oldest = NULL, *oldest_same = NULL;
+    int same = 0;
+    for (int i = 0; i < pool->count; i++)
+    {
+        SfxVoice *v = &pool->voices[i];
+        if (!MIX_TrackPlaying(v->track))
+        {
+            if (!free_voice)
+                free_voice = v;
+            continue;
+        }
+        if (!oldest || v->started < oldest->started)
+            oldest = v;
+        if (v->sound == sound)
+        {
+            same++;
+            if (!oldest_same || v->started < oldest_same->started)
+                oldest_same = v;
+        }
+    }
+    if (same >= SOUND_VOICE_LIMIT[sound] && oldest_same)
+        return oldest_same;
+    return free_voice ? free_voice : oldest;
+}
+
+/**
+ * @brief Joue un son du Modèle sur une voix de la réserve, placé dans le panoramique.
+ *
+ * Balance linéaire : au centre, les deux canaux restent à plein volume.
+ */
+static void voice_play(const AudioEvent *e, MIX_Audio *audio)
+{
+    SfxVoice *v = voice_pick(e->sound);
+    if (!v)
+        return;
+    if (MIX_TrackPlaying(v->track))
+    {
+        MIX_StopTrack(v->track, 0);
+        ctx.voices.stolen++;
+        ctx.perf.mixer_calls++;
+    }
+    MIX_StereoGains gains = {(e->pan > 0.0f) ? 1.0f - e->pan : 1.0f, (e->pan < 0.0f) ? 1.0f + e->pan : 1.0f};
+    MIX_SetTrackAudio(v->track, audio);
+    MIX_SetTrackStereo(v->track, &gains);
+    MIX_SetTrackGain(v->track, e->gain);
+    MIX_PlayTrack(v->track, 0);
+    ctx.perf.mixer_calls += 4;
+    v->sound = e->sound;
+    v->started = ++ctx.voices.clock;
+    ctx.voices.played++;
+}
+
+/**
+ * @brief Rend une piste en boucle audible ou la met en pause, si ce n'est pas déjà fait.
+ *
+ * @param applied Dernier état appliqué à la piste (-1 : inconnu), mis à jour.
+ */
+static void track_apply(MIX_Track *track, bool audible, int *applied)
+{
+    if (!track || *applied == (int)audible)
+        return;
+    if (audible)
+    {
+        if (MIX_TrackPaused(track))
+            MIX_ResumeTrack(track);
+        else if (!MIX_TrackPlaying(track))
+            MIX_PlayTrack(track, ctx.sfx.loop);
+    }
+    else if (MIX_TrackPlaying(track))
+        MIX_PauseTrack(track);
+    *applied = audible;
+    ctx.perf.mixer_calls++;
+}
+
+/**
+ * @brief Joue les sons ponctuels reçus depuis le rendu précédent.
+ */
+static void play_sfx(void)
+{
+    AudioEvent e;
+    while (spsc_pop(&ctx.audio_events, &e))
+    {
+        MIX_Audio *audio = event_audio(e.sound);
+        if (audio)
+            voice_play(&e, audio);
+    }
+}
+
+/**
+ * @brief Met à jour l'état audio selon l'état du jeu.
+ *
+ * Gère la lecture des sons et musiques :
+ * - Pause/reprise selon l'état du jeu
+ * - Volume et mute
+ * - Sons ponctuels : tous les événements reçus depuis le rendu précédent,
+ *   joués ici ou après la présentation (cf. AudioLatency)
+ * - Musique de fond et boucle UFO
+ *
+ * @param model Le modèle de jeu en lecture seule.
+ */
+static void update_audio_state(const GameModel *model)
+{
+    AudioEvent e;
+    if (!audio_attach() || !ctx.mixer)
+    {
+        while (spsc_pop(&ctx.audio_events, &e))
+            ; // Pas de mixeur : les sons sont consommés sans être joués
+        return;
+    }
+    bool game_frozen = (model->sim.state == STATE_PAUSED || model->sim.state == STATE_CONFIRM_QUIT ||
+                        model->sim.state == STATE_SAVE_SELECT || model->sim.state == STATE_SAVE_INPUT);
+    AudioApplied *applied = &ctx.audio_applied;
+
+    if (game_frozen && !applied->frozen)
+    {
+        MIX_PauseAllTracks(ctx.mixer);
+        ctx.perf.mixer_calls++;
+        applied->frozen = true;
+        applied->music = applied->ufo = 0;
+    }
+    else if (applied->frozen && (model->sim.state == STATE_PLAYING || model->sim.state == STATE_SAVE_SUCCESS))
+    {
+        MIX_ResumeAllTracks(ctx.mixer);
+        ctx.perf.mixer_calls++;
+        applied->frozen = false;
+        applied->music = applied->ufo = -1; // Reprises aussi : leur état est à réappliquer
+    }
+
+    float gain = model->ui.is_muted ? 0.0f : (float)model->ui.volume / 100.0f;
+    if (gain != applied->gain)
+    {
+        MIX_SetMasterGain(ctx.mixer, gain);
+        ctx.perf.mixer_calls++;
+        applied->gain = gain;
+    }
+
+    bool in_menu = (model->sim.state == STATE_MENU || model->sim.state == STATE_TUTORIAL ||
+                    model->sim.state == STATE_LOAD_MENU || model->sim.state == STATE_GAME_OVER);
+    track_apply(ctx.sfx.bg_music_track, in_menu && !game_frozen, &applied->music);
+
+    // Le son part au plus tôt s'il met plus longtemps que l'image à paraître, sinon après la présentation
+    AudioLatency *lat = &ctx.audio_latency;
+    lat->after_present = lat->output_ms < lat->present_ms;
+    if (!lat->after_present)
+        play_sfx();
+
+    if (!game_frozen && model->sim.state == STATE_PLAYING)
+        track_apply(ctx.sfx.ufo_track, model->ui.sounds.ufo_loopING, &applied->ufo);
+}
+
+/**
+ * @brief Dessine le contenu du HUD : score, niveau, bonus en cours et vies restantes (cœurs).
+ *
+ * Avec le format découpé (HudLayer), textes fixes et compteurs sont copiés
+ * depuis l'atlas ; sinon la ligne passe par snprintf. Les cœurs bonus
+ * au-delà de la limite normale sont colorés en or.
+ *
+ * @param model Le modèle de jeu contenant les informations à afficher.
+ */
+static void draw_hud_content(const GameModel *model)
+{
+    const HudLayer *hud = &ctx.hud;
+    float x = 20;
+    for (int i = 0; i < hud->segment_count; i++)
+    {
+        const HudSegment *seg = &hud->segments[i];
+        const GlyphRun *run = NULL;
+        if (seg->kind == HUD_SEG_TEXT)
+            run = &seg->run;
+        else if (seg->kind == HUD_SEG_SCORE)
+            x += draw_counter(&ctx.atlas, model->sim.score, 0, x, 20, COL_WHITE);
+        else if (seg->kind == HUD_SEG_LEVEL)
+            x += draw_counter(&ctx.atlas, model->sim.level, 0, x, 20, COL_WHITE);
+        else if (seg->kind == HUD_SEG_RAPID && model->sim.rapid_timer > 0)
+            run = &ctx.strings.runs[STR_HUD_RAPID][0];
+        else if (seg->kind == HUD_SEG_SPREAD && model->sim.spread_timer > 0)
+            run = &ctx.strings.runs[STR_HUD_SPREAD][0];
+        if (run)
+        {
+            atlas_draw(&ctx.atlas, run, x, 20, COL_WHITE);
+            x += run->width;
+        }
+    }
+    if (hud->segment_count == 0)
+    {
+        char buf[64];
+        snprintf(buf, 64, lang_get(STR_HUD), model->sim.score, model->sim.level,
+                 model->sim.rapid_timer > 0 ? lang_get(STR_HUD_RAPID) : "", model->sim.spread_timer > 0 ? lang_get(STR_HUD_SPREAD) : "");
+        draw_text(buf, 20, 20, COL_WHITE);
+    }
+
+    int start_x = WIN_WIDTH - 20;
+    int max_draw = (model->sim.lives > MAX_LIVES_DISPLAY) ? model->sim.lives : MAX_LIVES_DISPLAY;
+    for (int i = 0; i < max_draw; i++)
+    {
+        int cx = start_x - ((i + 1) * (HEART_UI_SIZE + 5));
+        SDL_FRect r = {(float)cx, 20, HEART_UI_SIZE, HEART_UI_SIZE};
+        SpriteId t = (i >= MAX_LIVES_DISPLAY) ? SPRITE_HEART_BONUS : SPRITE_HEART_FULL;
+        draw_sprite((i < model->sim.lives) ? t : SPRITE_HEART_EMPTY, &r);
+    }
+    sprite_flush();
+}
+
+/**
+ * @brief Vérifie que le renderer mélange correctement l'alpha dans une cible transparente.
+ *
+ * Certains backends (le renderer logiciel notamment) rendent opaque tout
+ * pixel touché dans une render target, ce qui noircirait le fond autour du
+ * texte du HUD. Une texture d'un pixel à moitié transparent y est copiée
+ * puis relue, une fois à l'initialisation.
+ *
+ * @return true si l'alpha relu est bien celui de SDL_BLENDMODE_BLEND.
+ */
+static bool target_alpha_ok(SDL_Texture *target)
+{
+    const Uint8 half[4] = {255, 255, 255, 128};
+    SDL_Texture *probe = SDL_CreateTexture(ctx.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (!probe)
+        return false;
+    SDL_UpdateTexture(probe, NULL, half, sizeof(half));
+    SDL_SetTextureBlendMode(probe, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderTarget(ctx.renderer, target);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 0);
+    SDL_RenderClear(ctx.renderer);
+    SDL_FRect one = {0, 0, 1, 1};
+    SDL_RenderTexture(ctx.renderer, probe, NULL, &one);
+    SDL_DestroyTexture(probe);
+
+    SDL_Rect px = {0, 0, 1, 1};
+    SDL_Surface *s = SDL_RenderReadPixels(ctx.renderer, &px);
+    SDL_SetRenderTarget(ctx.renderer, NULL);
+    Uint8 r = 0, g = 0, b = 0, a = 255;
+    if (s)
+    {
+        SDL_ReadSurfacePixel(s, 0, 0, &r, &g, &b, &a);
+        SDL_DestroySurface(s);
+    }
+    return a >= 120 && a <= 136;
+}
+
+/**
+ * @brief Remplit d'avance la réserve de commandes du renderer.
+ *
+ * SDL garde les commandes envoyées pour les réutiliser, mais n'en alloue de
+ * nouvelles que lorsqu'une image en demande plus que toutes les précédentes :
+ * la première image chargée du HUD allouerait en pleine partie. On file ici
+ * RENDER_COMMAND_PRIME rectangles invisibles, puis on les envoie, une fois.
+ */
+static void prime_render_commands(void)
+{
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_BLEND);
+    for (int i = 0; i < RENDER_COMMAND_PRIME; i++)
+    {
+        SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, (Uint8)(i & 1));
+        SDL_FRect dot = {(float)(i & 1), 0, 1, 1};
+        SDL_RenderFillRect(ctx.renderer, &dot);
+    }
+    SDL_FlushRenderer(ctx.renderer);
+}
+
+/**
+ * @brief Dessine l'interface utilisateur en jeu (HUD), directement ou depuis son cache.
+ *
+ * Format découpé en compteurs : redessiné à chaque image, pour le même
+ * coût que le score change ou non. Sinon, le bandeau n'est recomposé que
+ * si sa génération (MODEL_GEN_HUD) a changé. Il est rendu sur fond
+ * transparent : la texture contient des couleurs prémultipliées par
+ * l'alpha, d'où le mode de mélange SDL_BLENDMODE_BLEND_PREMULTIPLIED à la
+ * copie.
+ *
+ * @param model Le modèle de jeu contenant les informations à afficher.
+ */
+static void draw_hud(const GameModel *model)
+{
+    HudLayer *hud = &ctx.hud;
+    if (!hud->texture || hud->segment_count > 0)
+    {
+        draw_hud_content(model);
+        return;
+    }
+
+    if (!hud->valid || hud->gen != model->ui.gen[MODEL_GEN_HUD])
+    {
+        set_render_target(hud->texture);
+        SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 0);
+        SDL_RenderClear(ctx.renderer);
+        draw_hud_content(model);
+        set_render_target(ctx.present.lowres);
+        hud->gen = model->ui.gen[MODEL_GEN_HUD];
+        hud->valid = true;
+    }
+    SDL_FRect r = {0, 0, WIN_WIDTH, HUD_LAYER_HEIGHT};
+    render_texture(hud->texture, NULL, &r);
+}
+
+/**
+ * @brief Dessine le panneau de performances (F3) par-dessus l'image.
+ *
+ * Cadence, durée des frames (moyenne et p99 récents) et compteurs de la
+ * frame précédente lus dans le profileur, entités vivantes lues dans le
+ * modèle, puis la courbe des PERF_GRAPH_SAMPLES dernières frames (une barre
+ * par frame, en un seul appel ; la ligne marque le budget de 1 / TARGET_FPS).
+ */
+static void draw_perf_overlay(const GameModel *model)
+{
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 170);
+    SDL_FRect panel = {PERF_PANEL_X, PERF_PANEL_Y, PERF_PANEL_W, PERF_PANEL_H};
+    SDL_RenderFillRect(ctx.renderer, &panel);
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_NONE);
+
+    ProfilerStats frame, work;
+    profiler_stats(PROF_FRAME, &frame, NULL);
+    profiler_stats(PROF_WORK, &work, NULL);
+    const short *live;
+    int bullets = model_get_live_bullets(model, &live);
+
+    char buf[96];
+    int x = PERF_PANEL_X + 10, y = PERF_PANEL_Y + 8;
+    if (ctx.atlas.texture)
+    {
+        // Cadence en compteurs (dixièmes, centièmes) : change à chaque image, sans snprintf
+        float cx = (float)x;
+        cx += draw_counter(&ctx.atlas, llround(frame.avg > 0.0 ? 10.0 / frame.avg : 0.0), 1, cx, y, COL_WHITE);
+        cx += draw_label(" img/s  ", cx, y, COL_WHITE);
+        cx += draw_counter(&ctx.atlas, llround(100000.0 * frame.avg), 2, cx, y, COL_WHITE);
+        cx += draw_label(" ms  p99 ", cx, y, COL_WHITE);
+        draw_counter(&ctx.atlas, llround(100000.0 * frame.p99), 2, cx, y, COL_WHITE);
+    }
+    else
+    {
+        snprintf(buf, sizeof(buf), "%.1f img/s  %.2f ms  p99 %.2f", frame.avg > 0.0 ? 1.0 / frame.avg : 0.0,
+                 1000.0 * frame.avg, 1000.0 * frame.p99);
+        draw_text(buf, x, y, COL_WHITE);
+    }
+    ProfilerStats gpu;
+    profiler_stats(PROF_GPU, &gpu, NULL);
+    if (gpu.count > 0)
+        snprintf(buf, sizeof(buf), "travail %.2f ms  gpu %.2f ms  ticks %u", 1000.0 * work.avg, 1000.0 * gpu.avg,
+                 profiler_counter(PROF_COUNT_TICKS));
+    else
+        snprintf(buf, sizeof(buf), "travail %.2f ms  gpu -  ticks %u", 1000.0 * work.avg,
+                 profiler_counter(PROF_COUNT_TICKS));
+    draw_text(buf, x, y + PERF_LINE_H, COL_WHITE);
+    snprintf(buf, sizeof(buf), "dessins %u  textures %u  boucliers %u", profiler_counter(PROF_COUNT_DRAW_CALLS),
+             profiler_counter(PROF_COUNT_UPLOADS), profiler_counter(PROF_COUNT_SHIELD_ROWS));
+    draw_text(buf, x, y + 2 * PERF_LINE_H, COL_WHITE);
+    snprintf(buf, sizeof(buf), "ennemis %d  balles %d  ovni %d", model->sim.formation.alive_count, bullets,
+             model->sim.ufo.active ? 1 : 0);
+    draw_text(buf, x, y + 3 * PERF_LINE_H, COL_WHITE);
+    MemtrackStats mem;
+    memtrack_stats(&mem);
+    snprintf(buf, sizeof(buf), "allocs %u+%u  vivant %.0f Ko  image %.1f Ko", profiler_counter(PROF_COUNT_ALLOCS),
+             profiler_counter(PROF_COUNT_DRIVER_ALLOCS), mem.live_bytes / 1024.0, ctx.frame.last / 1024.0);
+    draw_text(buf, x, y + 4 * PERF_LINE_H, COL_WHITE);
+    snprintf(buf, sizeof(buf), "particules %d  gerbes %.0f%%", ctx.particles.pool.count,
+             100.0f * ctx.particles.pool.spawn_scale);
+    draw_text(buf, x, y + 5 * PERF_LINE_H, COL_WHITE);
+    snprintf(buf, sizeof(buf), "qualite %d/%d %s  %s  energie %s", ctx.quality.level, QUALITY_LEVEL_COUNT - 1,
+             ctx.quality.automatic ? "auto" : "fixe", quality_name(ctx.quality.level), power_name(model->ui.power_mode));
+    draw_text(buf, x, y + 6 * PERF_LINE_H, COL_WHITE);
+    const AudioLatency *lat = &ctx.audio_latency;
+    snprintf(buf, sizeof(buf), "audio %d Hz  %d ech.  %.1f ms  %s", lat->rate, lat->frames, lat->output_ms,
+             lat->after_present ? "apres image" : "au rendu");
+    draw_text(buf, x, y + 7 * PERF_LINE_H, COL_WHITE);
+    mem_census(); // Panneau affiché seulement : le cache de chaînes change d'un écran à l'autre
+    int top[2] = {-1, -1}; // Les deux catégories les plus lourdes
+    for (int c = 0; c < MEM_CATEGORY_COUNT; c++)
+    {
+        if (top[0] < 0 || ctx.mem.bytes[c] > ctx.mem.bytes[top[0]])
+        {
+            top[1] = top[0];
+            top[0] = c;
+        }
+        else if (top[1] < 0 || ctx.mem.bytes[c] > ctx.mem.bytes[top[1]])
+            top[1] = c;
+    }
+    snprintf(buf, sizeof(buf), "memoire %.1f Mo  %s %.1f  %s %.1f", membudget_total(&ctx.mem) / 1048576.0,
+             membudget_name(top[0]), ctx.mem.bytes[top[0]] / 1048576.0, membudget_name(top[1]),
+             ctx.mem.bytes[top[1]] / 1048576.0);
+    draw_text(buf, x, y + 8 * PERF_LINE_H, COL_WHITE);
+
+    // Courbe : du plus ancien (à gauche) au plus récent
+    const ProfilerPhaseData *d = profiler_phase(PROF_FRAME);
+    int n = d->count < PERF_GRAPH_SAMPLES ? (int)d->count : PERF_GRAPH_SAMPLES;
+    float bottom = PERF_PANEL_Y + PERF_PANEL_H - 8, bar = (PERF_PANEL_W - 20) / (float)PERF_GRAPH_SAMPLES;
+    float full = 2.0f / TARGET_FPS; // Hauteur de la courbe : deux budgets
+    SDL_FRect bars[PERF_GRAPH_SAMPLES];
+    for (int i = 0; i < n; i++)
+    {
+        float v = d->window[(d->next + PROFILER_WINDOW - n + i) % PROFILER_WINDOW];
+        float h = (v > full ? 1.0f : v / full) * PERF_GRAPH_H;
+        bars[i] = (SDL_FRect){x + i * bar, bottom - h, bar > 1.0f ? bar - 1.0f : bar, h};
+    }
+    SDL_SetRenderDrawColor(ctx.renderer, 80, 220, 120, 255);
+    SDL_RenderFillRects(ctx.renderer, bars, n);
+    SDL_SetRenderDrawColor(ctx.renderer, 255, 80, 80, 255);
+    SDL_RenderLine(ctx.renderer, (float)x, bottom - PERF_GRAPH_H / 2.0f, x + PERF_GRAPH_SAMPLES * bar,
+                   bottom - PERF_GRAPH_H / 2.0f);
+    ctx.perf.draws += 3;
+}
+
+/**
+ * @brief Alloue la réserve de particules et son tampon de sommets.
+ *
+ * Les indices (deux triangles par particule) ne changent jamais : remplis ici
+ * une fois. En cas d'échec, les particules sont simplement désactivées.
+ */
+static void particles_setup(void)
+{
+    ParticleLayer *pl = &ctx.particles;
+    if (!particles_init(&pl->pool, PARTICLE_CAPACITY))
+        return;
+    int cap = pl->pool.capacity;
+    pl->vertices = SDL_malloc((size_t)cap * 4 * sizeof(SDL_Vertex));
+    pl->indices = SDL_malloc((size_t)cap * 6 * sizeof(int));
+    if (!pl->vertices || !pl->indices)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Particle buffers unavailable, explosions drawn as sprites only");
+        SDL_free(pl->vertices);
+        SDL_free(pl->indices);
+        pl->vertices = NULL;
+        pl->indices = NULL;
+        particles_free(&pl->pool);
+        return;
+    }
+    for (int q = 0; q < cap; q++)
+    {
+        static const int quad[6] = {0, 1, 2, 0, 2, 3};
+        for (int k = 0; k < 6; k++)
+            pl->indices[q * 6 + k] = q * 4 + quad[k];
+    }
+}
+
+/**
+ * @brief Mémorise les morts en cours sans émettre (reprise d'une partie, chargement).
+ */
+static void particles_sync(const GameModel *model)
+{
+    ctx.particles.dying_seen = model->sim.formation.dying_mask;
+    ctx.particles.ufo_seen = model->sim.ufo.active && model->sim.ufo.exploding;
+    ctx.particles.hit_seen = model->sim.hit_timer > 0;
+}
+
+/**
+ * @brief Émet les gerbes des morts apparues depuis le rendu précédent.
+ */
+static void particles_emit(const GameModel *model)
+{
+    ParticleLayer *pl = &ctx.particles;
+    uint64_t fresh = model->sim.formation.dying_mask & ~pl->dying_seen;
+    while (fresh)
+    {
+        int i = __builtin_ctzll(fresh);
+        fresh &= fresh - 1;
+        Entity e;
+        if (model_get_enemy(model, i, &e))
+            particles_burst(&pl->pool, e.x + e.width * 0.5f, e.y + e.height * 0.5f, PARTICLE_BURST_ENEMY,
+                            entity_types[e.type].color, PARTICLE_SPEED, PARTICLE_LIFE);
+    }
+
+    const Ufo *ufo = &model->sim.ufo;
+    bool ufo_dying = ufo->active && ufo->exploding;
+    if (ufo_dying && !pl->ufo_seen)
+        particles_burst(&pl->pool, ufo->x + ufo->width * 0.5f, ufo->y + ufo->height * 0.5f, PARTICLE_BURST_UFO,
+                        entity_types[ENTITY_UFO].color, PARTICLE_SPEED, PARTICLE_LIFE);
+
+    // Vies partagées en coopération : les deux vaisseaux affichent l'explosion
+    bool hit = model->sim.hit_timer > 0;
+    for (int k = 0; k < 2 && hit && !pl->hit_seen; k++)
+    {
+        const Entity *ship = k ? &model->sim.player2 : &model->sim.player;
+        if (ship->active)
+            particles_burst(&pl->pool, ship->x + ship->width * 0.5f, ship->y + ship->height * 0.5f, PARTICLE_BURST_PLAYER,
+                            PARTICLE_COLOR_PLAYER, PARTICLE_SPEED, PARTICLE_LIFE);
+    }
+    particles_sync(model);
+}
+
+/**
+ * @brief Avance les particules d'une frame : émission, intégration, réglage des gerbes.
+ *
+ * Le pas est la durée réelle depuis le rendu précédent (bornée à 0,1 s) :
+ * les particules ne dépendent pas des ticks de la simulation. Elles restent
+ * figées en pause et disparaissent hors de la partie.
+ */
+static void particles_frame(const GameModel *model)
+{
+    ParticleLayer *pl = &ctx.particles;
+    if (!pl->vertices)
+        return;
+    double now = utils_get_time();
+    double dt = pl->last_time > 0.0 ? now - pl->last_time : 0.0;
+    pl->last_time = now;
+
+    if (model->sim.state != STATE_PLAYING || ctx.quality.level >= QUALITY_NO_PARTICLES)
+    {
+        if (model->sim.state != STATE_PAUSED)
+            particles_clear(&pl->pool);
+        particles_sync(model);
+        return;
+    }
+    particles_pace(&pl->pool, dt, PARTICLE_FRAME_BUDGET);
+    particles_emit(model);
+    particles_update(&pl->pool, (float)(dt > 0.1 ? 0.1 : dt));
+}
+
+/**
+ * @brief Dessine toutes les particules en un seul appel (quadrilatères colorés, sans texture).
+ *
+ * Mélange additif : les gerbes qui se recouvrent s'éclaircissent, et
+ * l'opacité calculée par le noyau fait le fondu.
+ */
+static void draw_particles(void)
+{
+    ParticleLayer *pl = &ctx.particles;
+    const ParticlePool *p = &pl->pool;
+    if (!pl->vertices || p->count == 0)
+        return;
+
+    const float half = PARTICLE_PIXELS * 0.5f;
+    for (int i = 0; i < p->count; i++)
+    {
+        float cx = p->x[i] * SCALE_X, cy = p->y[i] * SCALE_Y;
+        uint32_t c = p->color[i];
+        SDL_FColor col = {(c >> 16 & 255) / 255.0f, (c >> 8 & 255) / 255.0f, (c & 255) / 255.0f, p->alpha[i]};
+        SDL_Vertex *v = &pl->vertices[i * 4];
+        v[0] = (SDL_Vertex){{cx - half, cy - half}, col, {0.0f, 0.0f}};
+        v[1] = (SDL_Vertex){{cx + half, cy - half}, col, {0.0f, 0.0f}};
+        v[2] = (SDL_Vertex){{cx + half, cy + half}, col, {0.0f, 0.0f}};
+        v[3] = (SDL_Vertex){{cx - half, cy + half}, col, {0.0f, 0.0f}};
+    }
+    sprite_flush();
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_ADD);
+    SDL_RenderGeometry(ctx.renderer, NULL, pl->vertices, p->count * 4, pl->indices, p->count * 6);
+    SDL_SetRenderDrawBlendMode(ctx.renderer, SDL_BLENDMODE_NONE);
+    ctx.perf.draws++;
+}
+
+/**
+ * @brief (Re)crée une cible de `scale` pixels par unité logique, où l'on dessine en coordonnées logiques.
+ *
+ * La présentation logique (étirée) est propre à la texture : elle reste
+ * valable à chaque fois qu'elle redevient la cible.
+ *
+ * @param old Cible à remplacer (détruite), ou NULL.
+ * @return La nouvelle cible, ou NULL si le pilote la refuse (dessin direct).
+ */
+static SDL_Texture *scaled_target(SDL_Texture *old, int logical_w, int logical_h, float scale, SDL_BlendMode mode)
+{
+    SDL_DestroyTexture(old);
+    int w = (int)(logical_w * scale + 0.5f), h = (int)(logical_h * scale + 0.5f);
+    SDL_Texture *t = SDL_CreateTexture(ctx.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                       w > 0 ? w : 1, h > 0 ? h : 1);
+    if (!t)
+        return NULL;
+    ctx.perf.uploads++;
+    SDL_SetTextureBlendMode(t, mode);
+    SDL_SetRenderTarget(ctx.renderer, t);
+    SDL_SetRenderLogicalPresentation(ctx.renderer, logical_w, logical_h, SDL_LOGICAL_PRESENTATION_STRETCH);
+    SDL_SetRenderTarget(ctx.renderer, NULL);
+    return t;
+}
+
+/**
+ * @brief Recompose le calque de la vague si sa clé a changé (impact, image d'animation, nouvelle vague).
+ *
+ * La texture ne fait que grandir : elle suit la plus grande vague vue, et
+ * n'est recréée qu'au changement d'échelle de présentation.
+ *
+ * @return false sans calque utilisable (aliens à dessiner un par un).
+ */
+static bool formation_layer_update(const GameModel *model)
+{
+    FormationLayer *fl = &ctx.formation;
+    const Formation *f = &model->sim.formation;
+    // Sans atlas, le calque serait composé vide ; sans alpha fiable des cibles, il masquerait le fond
+    if (fl->failed || !ctx.tex.sprites || ctx.present.hud_direct || ctx.present.scale <= 0.0f)
+        return false;
+
+    uint8_t types[FORMATION_SIZE];
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        types[i] = (f->alive_mask >> i & 1) ? (uint8_t)model->sim.enemies.type[i] : 0;
+    if (fl->valid && fl->scale == ctx.present.scale && fl->alive == f->alive_mask &&
+        fl->frame == model->sim.animation_frame && fl->step_x == f->step_x && fl->step_y == f->step_y &&
+        memcmp(fl->types, types, sizeof(types)) == 0)
+        return true;
+
+    // Étendue des aliens vivants, relative à l'origine de la vague
+    float need_w = 1.0f, need_h = 1.0f;
+    Entity e;
+    for (uint64_t m = f->alive_mask; m; m &= m - 1)
+        if (model_get_enemy(model, __builtin_ctzll(m), &e))
+        {
+            need_w = fmaxf(need_w, (e.x - f->origin_x + e.width) * SCALE_X);
+            need_h = fmaxf(need_h, (e.y - f->origin_y + e.height) * SCALE_Y);
+        }
+    int w = (int)ceilf(need_w) + 1, h = (int)ceilf(need_h) + 1;
+    sprite_flush();
+    SDL_Texture *back = SDL_GetRenderTarget(ctx.renderer); // scaled_target repart de la sortie
+    if (!fl->texture || fl->scale != ctx.present.scale || w > fl->w || h > fl->h)
+    {
+        fl->w = w > fl->w ? w : fl->w;
+        fl->h = h > fl->h ? h : fl->h;
+        fl->texture = scaled_target(fl->texture, fl->w, fl->h, ctx.present.scale, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        if (!fl->texture)
+        {
+            fl->failed = true;
+            set_render_target(back);
+            return false;
+        }
+        SDL_SetTextureScaleMode(fl->texture, SDL_SCALEMODE_NEAREST);
+        fl->scale = ctx.present.scale;
+    }
+
+    // Cible transparente : le mélange y laisse des couleurs prémultipliées, recopiées telles quelles
+    set_render_target(fl->texture);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 0);
+    SDL_RenderClear(ctx.renderer);
+    for (uint64_t m = f->alive_mask; m; m &= m - 1)
+        if (model_get_enemy(model, __builtin_ctzll(m), &e))
+        {
+            SDL_FRect dst = {(e.x - f->origin_x) * SCALE_X, (e.y - f->origin_y) * SCALE_Y, e.width * SCALE_X,
+                             e.height * SCALE_Y};
+            draw_sprite(SPRITE_ENEMY_1A + 2 * entity_types[e.type].sprite + model->sim.animation_frame, &dst);
+        }
+    sprite_flush();
+    set_render_target(back);
+
+    fl->valid = true;
+    fl->alive = f->alive_mask;
+    fl->frame = model->sim.animation_frame;
+    fl->step_x = f->step_x;
+    fl->step_y = f->step_y;
+    memcpy(fl->types, types, sizeof(types));
+    return true;
+}
+
+/**
+ * @brief Pose le calque de la vague à l'origine interpolée (comme les aliens de la liste d'affichage).
+ */
+static void draw_formation_layer(const GameModel *model)
+{
+    const Formation *f = &model->sim.formation;
+    float ox = f->origin_x, oy = f->origin_y;
+    if (ctx.prev)
+    {
+        ox = scene_lerp(ctx.prev->sim.formation.origin_x, ox, ctx.alpha);
+        oy = scene_lerp(ctx.prev->sim.formation.origin_y, oy, ctx.alpha);
+    }
+    sprite_flush();
+    SDL_FRect dst = {ox * SCALE_X, oy * SCALE_Y, (float)ctx.formation.w, (float)ctx.formation.h};
+    render_texture(ctx.formation.texture, NULL, &dst);
+}
+
+/**
+ * @brief Oublie l'écran affiché : la prochaine image en partie sera complète.
+ *
+ * @param background Le fond figé est aussi à recomposer (échelle, qualité ou image changées).
+ */
+static void dirty_reset(bool background)
+{
+    ctx.dirty.valid = false;
+    if (background && ctx.dirty.background)
+    {
+        SDL_DestroyTexture(ctx.dirty.background);
+        ctx.dirty.background = NULL;
+    }
+}
+
+static void draw_background_direct(bool moving);
+
+/**
+ * @brief Compose au besoin le fond figé des rectangles sales (image bg_game, ou étoiles à l'arrêt).
+ * @return false sans cible (fond dessiné directement).
+ */
+static bool dirty_background(void)
+{
+    DirtyRects *d = &ctx.dirty;
+    if (d->background)
+        return true;
+    if (ctx.present.scale <= 0.0f)
+        return false;
+    d->background = scaled_target(NULL, WIN_WIDTH, WIN_HEIGHT, ctx.present.scale, SDL_BLENDMODE_NONE);
+    if (!d->background)
+        return false;
+    SDL_Texture *back = SDL_GetRenderTarget(ctx.renderer);
+    set_render_target(d->background);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+    SDL_RenderClear(ctx.renderer);
+    draw_background_direct(false);
+    set_render_target(back);
+    return true;
+}
+
+/**
+ * @brief Dessine le fond du jeu : champ d'étoiles, ou image bg_game.
+ *
+ * Les étoiles avancent du temps écoulé depuis le dessin précédent (borné à
+ * 100 ms), en partie seulement ; un plan, une couleur, un SDL_RenderPoints.
+ *
+ * @param moving La partie avance (hors pause et menus, les étoiles restent figées).
+ */
+static void draw_background(bool moving)
+{
+    // Rectangles sales : fond figé, recopié tel quel (une copie sans mise à l'échelle)
+    if (ctx.dirty.enabled && dirty_background())
+    {
+        render_texture(ctx.dirty.background, NULL, NULL);
+        return;
+    }
+    draw_background_direct(moving);
+}
+
+/**
+ * @brief Fond du jeu dessiné à chaque image (cf. draw_background).
+ */
+static void draw_background_direct(bool moving)
+{
+    StarLayer *st = &ctx.stars;
+    if (!st->enabled)
+    {
+        render_texture(ctx.tex.bg_game, NULL, NULL);
+        return;
+    }
+    double now = utils_get_time();
+    if (moving && st->last_time > 0.0)
+        starfield_update(&st->field, (float)(now - st->last_time < 0.1 ? now - st->last_time : 0.1));
+    st->last_time = now;
+
+    static const Uint8 shade[STARFIELD_LAYERS] = {110, 180, 255};
+    for (int i = 0; i < STARFIELD_STARS; i++)
+        st->points[i] = (SDL_FPoint){st->field.x[i], st->field.y[i]};
+    for (int l = 0; l < STARFIELD_LAYERS; l++)
+    {
+        int first = st->field.first[l];
+        SDL_SetRenderDrawColor(ctx.renderer, shade[l], shade[l], shade[l], 255);
+        SDL_RenderPoints(ctx.renderer, st->points + first, st->field.first[l + 1] - first);
+    }
+    ctx.perf.draws += STARFIELD_LAYERS;
+}
+
+/**
+ * @brief Dessine le monde de jeu complet, sans tremblement.
+ *
+ * Traduit la liste d'affichage (scene.h) en sprites :
+ * - Fond de jeu
+ * - Joueur (avec clignotement rouge quand touché)
+ * - Ennemis (avec animations et couleurs par type) : les vivants en une copie
+ *   du calque de la vague, sous les sprites ; les explosions en sprites
+ * - UFO (avec effet d'explosion)
+ * - Boucliers (avec états de dégradation)
+ * - Balles (joueur et ennemis)
+ * - Particules d'explosion
+ *
+ * @param model Le modèle de jeu contenant l'état du monde.
+ */
+static void draw_world_content(const GameModel *model)
+{
+    if (ctx.quality.level < QUALITY_NO_BACKGROUND)
+        draw_background(model->sim.state == STATE_PLAYING); // Sinon, le noir de la cible effacée
+
+    const SceneList *scene = &ctx.scene;
+    scene_update(&ctx.scene, model, ctx.prev);
+    // La vague passe sous les sprites : sa copie précède le lot, qui part toujours en un appel
+    bool formation = model->sim.formation.alive_mask != 0 && formation_layer_update(model);
+    if (formation)
+        draw_formation_layer(model);
+    float a = ctx.alpha;
+    for (int i = 0; i < scene->count; i++)
+    {
+        const SceneItem *it = &scene->items[i];
+        float x = scene_lerp(it->px, it->x, a), y = scene_lerp(it->py, it->y, a);
+        bool exploding = it->flags & SCENE_EXPLODING;
+        switch ((SceneKind)it->kind)
+        {
+        case SCENE_SHIP:
+        {
+            SpriteId t = exploding ? SPRITE_EXPL_PLAYER_A + (it->frame & 1) : SPRITE_PLAYER;
+            SDL_FRect dst = {x * SCALE_X, y * SCALE_Y, it->w * SCALE_X, it->h * SCALE_Y};
+            SDL_FColor tint = {(it->tint >> 16) / 255.0f, (it->tint >> 8 & 0xFF) / 255.0f, (it->tint & 0xFF) / 255.0f, 1.0f};
+            draw_sprite_tinted(t, &dst, tint);
+            break;
+        }
+        case SCENE_ENEMY:
+            if (exploding)
+                draw_entity_scaled(SPRITE_EXPL_ENEMY, x, y, it->w, it->h);
+            else if (!formation)
+                draw_entity_scaled(SPRITE_ENEMY_1A + it->frame, x, y, it->w, it->h);
+            break;
+        case SCENE_UFO:
+            draw_entity_scaled(exploding ? SPRITE_EXPL_UFO : SPRITE_UFO, x, y, it->w, it->h);
+            break;
+        case SCENE_ENTITY:
+        {
+            // Un rectangle de la teinte de leur type, sans sprite dédié
+            if (i == scene->first[SCENE_ENTITY])
+                sprite_flush();
+            SDL_FRect r = {x * SCALE_X, y * SCALE_Y, it->w * SCALE_X, it->h * SCALE_Y};
+            SDL_SetRenderDrawColor(ctx.renderer, it->tint >> 16, (it->tint >> 8) & 0xFF, it->tint & 0xFF, 255);
+            SDL_RenderFillRect(ctx.renderer, &r);
+            break;
+        }
+        case SCENE_SHIELD:
+            if (model->sim.shield_bitmap)
+                draw_shield_texture(&ctx.shields[it->index], &model->sim.shields[it->index], model->ui.gen[MODEL_GEN_SHIELDS]);
+            else
+                draw_entity_scaled(SPRITE_SHIELD_0 + it->frame, x, y, it->w, it->h);
+            break;
+        case SCENE_BULLET:
+            draw_entity_scaled(SPRITE_MISSILE_1 + it->frame, x, y, it->w, it->h);
+            break;
+        default:
+            break;
+        }
+    }
+    draw_particles();
+    sprite_flush();
+}
+
+/**
+ * @brief Met à jour le calque du monde s'il ne correspond plus à l'image à dessiner.
+ *
+ * Recomposé quand la liste d'affichage change (nouveau tick), quand la
+ * fraction d'interpolation avance, ou tant que des particules vivent en
+ * partie ; sinon (pause, confirmation, images entre deux ticks sans
+ * interpolation), le calque figé est recopié tel quel.
+ *
+ * @return false sans calque (le monde est alors à dessiner directement).
+ */
+static bool world_layer_update(const GameModel *model)
+{
+    WorldLayer *world = &ctx.world;
+    if (!world->texture)
+        return false;
+    bool rebuilt = scene_update(&ctx.scene, model, ctx.prev);
+    bool moving = model->sim.state == STATE_PLAYING && (ctx.alpha != world->alpha || ctx.particles.pool.count > 0);
+    if (world->valid && !rebuilt && !moving)
+        return true;
+
+    SDL_Texture *back = SDL_GetRenderTarget(ctx.renderer);
+    set_render_target(world->texture);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+    SDL_RenderClear(ctx.renderer);
+    draw_world_content(model);
+    set_render_target(back);
+    world->alpha = ctx.alpha;
+    world->valid = true;
+    world->draws++;
+    return true;
+}
+
+/**
+ * @brief Dessine le monde de jeu, avec tremblement d'écran quand le joueur est touché.
+ *
+ * Pendant le tremblement, le monde passe par son calque (WorldLayer) : le
+ * tremblement n'est qu'un décalage de la copie, aucune entité ne le calcule.
+ * Le fond non décalé reste dessous, pour que la bande découverte au bord ne
+ * soit pas noire.
+ */
+static void draw_game_world(const GameModel *model)
+{
+    int sx = 0, sy = 0;
+    if (model->sim.state == STATE_PLAYING && model->sim.hit_timer > 0 && ctx.quality.level < QUALITY_NO_SHAKE)
+    {
+        sx = (rand() % 11) - 5;
+        sy = (rand() % 11) - 5;
+    }
+    // Sans tremblement, le monde va droit à l'écran : en partie, il change à chaque
+    // image (interpolation), le calque n'ajouterait qu'une copie plein écran
+    if ((sx == 0 && sy == 0) || !world_layer_update(model))
+    {
+        draw_world_content(model);
+        return;
+    }
+    if (ctx.quality.level < QUALITY_NO_BACKGROUND)
+        draw_background(false); // Déjà avancées par le calque
+    SDL_FRect dst = {(float)sx, (float)sy, WIN_WIDTH, WIN_HEIGHT};
+    render_texture(ctx.world.texture, NULL, &dst);
+}
+
+/**
+ * @brief Ajoute un élément dessiné au relevé de l'image : rectangle logique (marge comprise) et signature.
+ *
+ * @param key Genre, image, teinte... de l'élément.
+ * @param gen Contenu qui change sans que le reste bouge (génération de bouclier, de HUD).
+ */
+static void dirty_add(float x, float y, float w, float h, uint64_t key, uint64_t gen)
+{
+    DirtyRects *d = &ctx.dirty;
+    if (d->count == DIRTY_MAX_ITEMS || w <= 0.0f || h <= 0.0f)
+        return;
+    SDL_FRect r = {x - DIRTY_MARGIN, y - DIRTY_MARGIN, w + 2.0f * DIRTY_MARGIN, h + 2.0f * DIRTY_MARGIN};
+    uint64_t words[6] = {0, 0, 0, 0, key, gen};
+    memcpy(words, &r, sizeof(r));
+    uint64_t sig = 1469598103934665603ULL; // FNV-1a, par octet
+    const uint8_t *b = (const uint8_t *)words;
+    for (size_t i = 0; i < sizeof(words); i++)
+        sig = (sig ^ b[i]) * 1099511628211ULL;
+    d->items[d->count++] = (DirtyItem){r, sig};
+}
+
+/** @brief Ordre des signatures (comparaison des relevés de deux images). */
+static int dirty_compare(const void *a, const void *b)
+{
+    uint64_t x = ((const DirtyItem *)a)->sig, y = ((const DirtyItem *)b)->sig;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Relève les éléments que draw_world_content et draw_hud vont dessiner, aux mêmes positions.
+ */
+static void dirty_collect(const GameModel *model)
+{
+    DirtyRects *d = &ctx.dirty;
+    d->count = 0;
+    d->serial++;
+    scene_update(&ctx.scene, model, ctx.prev);
+    bool formation = model->sim.formation.alive_mask != 0 && formation_layer_update(model);
+    if (formation)
+    {
+        const Formation *f = &model->sim.formation;
+        float ox = f->origin_x, oy = f->origin_y;
+        if (ctx.prev)
+        {
+            ox = scene_lerp(ctx.prev->sim.formation.origin_x, ox, ctx.alpha);
+            oy = scene_lerp(ctx.prev->sim.formation.origin_y, oy, ctx.alpha);
+        }
+        dirty_add(ox * SCALE_X, oy * SCALE_Y, (float)ctx.formation.w, (float)ctx.formation.h, SCENE_KIND_COUNT,
+                  model->ui.gen[MODEL_GEN_FORMATION]);
+    }
+    const SceneList *scene = &ctx.scene;
+    for (int i = 0; i < scene->count; i++)
+    {
+        const SceneItem *it = &scene->items[i];
+        if (it->kind == SCENE_ENEMY && formation && !(it->flags & SCENE_EXPLODING))
+            continue; // Dans la copie de la vague
+        float x = scene_lerp(it->px, it->x, ctx.alpha), y = scene_lerp(it->py, it->y, ctx.alpha);
+        uint64_t key = (uint64_t)it->kind | (uint64_t)it->frame << 8 | (uint64_t)it->flags << 16 |
+                       (uint64_t)it->index << 24 | (uint64_t)it->tint << 32;
+        uint64_t gen = it->kind == SCENE_SHIELD ? model->ui.gen[MODEL_GEN_SHIELDS] : 0;
+        dirty_add(x * SCALE_X, y * SCALE_Y, it->w * SCALE_X, it->h * SCALE_Y, key, gen);
+    }
+    const ParticlePool *pp = &ctx.particles.pool;
+    if (ctx.particles.vertices && pp->count > 0)
+    {
+        float x0 = pp->x[0], x1 = pp->x[0], y0 = pp->y[0], y1 = pp->y[0];
+        for (int i = 1; i < pp->count; i++)
+        {
+            x0 = fminf(x0, pp->x[i]);
+            x1 = fmaxf(x1, pp->x[i]);
+            y0 = fminf(y0, pp->y[i]);
+            y1 = fmaxf(y1, pp->y[i]);
+        }
+        const float half = PARTICLE_PIXELS * 0.5f;
+        dirty_add(x0 * SCALE_X - half, y0 * SCALE_Y - half, (x1 - x0) * SCALE_X + 2.0f * half,
+                  (y1 - y0) * SCALE_Y + 2.0f * half, SCENE_KIND_COUNT + 1, d->serial); // Toujours nouvelles
+    }
+    const SimState *sim = &model->sim;
+    uint64_t hud = (uint64_t)(uint32_t)sim->score | (uint64_t)(sim->level & 0xFFFF) << 32 | (uint64_t)(sim->lives & 0xFF) << 48 |
+                   (uint64_t)(sim->rapid_timer > 0) << 56 | (uint64_t)(sim->spread_timer > 0) << 57;
+    dirty_add(DIRTY_MARGIN, DIRTY_MARGIN, WIN_WIDTH - 2.0f * DIRTY_MARGIN, HUD_LAYER_HEIGHT - 2.0f * DIRTY_MARGIN, hud,
+              model->ui.gen[MODEL_GEN_HUD]);
+    qsort(d->items, (size_t)d->count, sizeof(DirtyItem), dirty_compare);
+}
+
+/**
+ * @brief Ajoute un rectangle à redessiner, fusionné avec ceux qu'il touche (à DIRTY_JOIN près).
+ *
+ * Au-delà de DIRTY_MAX_RECTS, il rejoint le rectangle qu'il agrandit le moins.
+ */
+static void dirty_push(SDL_FRect r)
+{
+    DirtyRects *d = &ctx.dirty;
+    for (int j = 0; j < d->rect_count;)
+    {
+        const SDL_FRect *o = &d->rects[j];
+        if (r.x < o->x + o->w + DIRTY_JOIN && o->x < r.x + r.w + DIRTY_JOIN && r.y < o->y + o->h + DIRTY_JOIN &&
+            o->y < r.y + r.h + DIRTY_JOIN)
+        {
+            SDL_FRect u;
+            SDL_GetRectUnionFloat(&r, o, &u);
+            r = u;
+            d->rects[j] = d->rects[--d->rect_count];
+            j = 0; // Agrandi, il peut maintenant toucher un rectangle déjà passé
+            continue;
+        }
+        j++;
+    }
+    if (d->rect_count == DIRTY_MAX_RECTS)
+    {
+        int best = 0;
+        float best_growth = INFINITY;
+        for (int j = 0; j < d->rect_count; j++)
+        {
+            SDL_FRect u;
+            SDL_GetRectUnionFloat(&r, &d->rects[j], &u);
+            float growth = u.w * u.h - d->rects[j].w * d->rects[j].h;
+            if (growth < best_growth)
+            {
+                best_growth = growth;
+                best = j;
+            }
+        }
+        SDL_FRect u;
+        SDL_GetRectUnionFloat(&r, &d->rects[best], &u);
+        d->rects[best] = d->rects[--d->rect_count];
+        dirty_push(u);
+        return;
+    }
+    d->rects[d->rect_count++] = r;
+}
+
+/**
+ * @brief Décide du rendu d'une image en partie : rectangles sales, ou image complète.
+ *
+ * Relève les éléments de l'image, puis compare leurs signatures à celles
+ * de l'image affichée : un élément présent des deux côtés, identique, n'a
+ * pas changé. Les rectangles des autres (anciennes et nouvelles places)
+ * sont fusionnés. Au-delà de DIRTY_FULL_AREA de l'écran, l'image complète
+ * revient moins cher.
+ *
+ * @return true si l'image se dessine par rectangles (dirty_draw, dirty_present).
+ */
+static bool dirty_frame(const GameModel *model)
+{
+    DirtyRects *d = &ctx.dirty;
+    dirty_collect(model);
+    d->rect_count = 0;
+    int i = 0, j = 0;
+    while (d->valid && (i < d->shown_count || j < d->count))
+    {
+        if (j == d->count || (i < d->shown_count && d->shown[i].sig < d->items[j].sig))
+            dirty_push(d->shown[i++].rect); // Disparu ou déplacé : place à restaurer
+        else if (i == d->shown_count || d->items[j].sig < d->shown[i].sig)
+            dirty_push(d->items[j++].rect); // Nouveau ou changé
+        else
+        {
+            i++;
+            j++;
+        }
+    }
+    float area = 0.0f;
+    for (int k = 0; k < d->rect_count; k++)
+    {
+        SDL_FRect c;
+        SDL_FRect screen = {0, 0, WIN_WIDTH, WIN_HEIGHT};
+        if (SDL_GetRectIntersectionFloat(&d->rects[k], &screen, &c))
+            area += c.w * c.h;
+    }
+    area /= (float)WIN_WIDTH * WIN_HEIGHT;
+
+    bool partial = d->valid && area <= DIRTY_FULL_AREA;
+    memcpy(d->shown, d->items, (size_t)d->count * sizeof(DirtyItem));
+    d->shown_count = d->count;
+    d->valid = true;
+    if (partial)
+    {
+        d->frames++;
+        d->area += area;
+    }
+    else
+        d->full_frames++;
+    return partial;
+}
+
+/**
+ * @brief Vrai si l'écran peut être repris par rectangles : partie sans effet plein écran, image précédente connue.
+ *
+ * Sinon, l'image est complète et `valid` retombe (hors partie, la liste ne décrit plus l'écran).
+ */
+static bool dirty_possible(const GameModel *model)
+{
+    DirtyRects *d = &ctx.dirty;
+    if (!d->enabled)
+        return false;
+    bool shaking = model->sim.hit_timer > 0 && ctx.quality.level < QUALITY_NO_SHAKE;
+    if (model->sim.state != STATE_PLAYING || shaking || ctx.present.lowres || ctx.perf.visible ||
+        timeline_fade(&model->sim.transition) > 0.0f || rendercap_active())
+    {
+        d->valid = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Redessine chaque rectangle sale sous sa découpe : fond, monde, HUD.
+ */
+static void dirty_draw(const GameModel *model)
+{
+    DirtyRects *d = &ctx.dirty;
+    for (int k = 0; k < d->rect_count; k++)
+    {
+        const SDL_FRect *r = &d->rects[k];
+        int x0 = (int)floorf(r->x), y0 = (int)floorf(r->y);
+        SDL_Rect clip = {x0, y0, (int)ceilf(r->x + r->w) - x0, (int)ceilf(r->y + r->h) - y0};
+        SDL_SetRenderClipRect(ctx.renderer, &clip);
+        if (ctx.quality.level >= QUALITY_NO_BACKGROUND)
+        {
+            // SDL_RenderClear ignore la découpe : le noir du fond absent, rectangle par rectangle
+            SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+            SDL_RenderFillRect(ctx.renderer, r);
+            ctx.perf.draws++;
+        }
+        draw_world_content(model);
+        draw_hud(model);
+        sprite_flush(); // Le lot part sous la découpe de ce rectangle
+    }
+    SDL_SetRenderClipRect(ctx.renderer, NULL);
+}
+
+/**
+ * @brief Envoie à l'écran les seuls rectangles redessinés (pixels de la surface de la fenêtre).
+ */
+static void dirty_present(void)
+{
+    DirtyRects *d = &ctx.dirty;
+    SDL_FlushRenderer(ctx.renderer);
+    SDL_FRect view;
+    if (!SDL_GetRenderLogicalPresentationRect(ctx.renderer, &view) || view.w <= 0.0f || view.h <= 0.0f)
+        return;
+    float sx = view.w / WIN_WIDTH, sy = view.h / WIN_HEIGHT;
+    SDL_Rect px[DIRTY_MAX_RECTS];
+    int n = 0;
+    for (int k = 0; k < d->rect_count; k++)
+    {
+        const SDL_FRect *r = &d->rects[k];
+        int x0 = (int)floorf(view.x + r->x * sx), y0 = (int)floorf(view.y + r->y * sy);
+        int x1 = (int)ceilf(view.x + (r->x + r->w) * sx), y1 = (int)ceilf(view.y + (r->y + r->h) * sy);
+        x0 = x0 > (int)view.x ? x0 : (int)view.x;
+        y0 = y0 > (int)view.y ? y0 : (int)view.y;
+        x1 = x1 < (int)(view.x + view.w) ? x1 : (int)(view.x + view.w);
+        y1 = y1 < (int)(view.y + view.h) ? y1 : (int)(view.y + view.h);
+        if (x1 > x0 && y1 > y0)
+            px[n++] = (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+    }
+    if (n > 0)
+        SDL_UpdateWindowSurfaceRects(ctx.window, px, n);
+}
+
+/**
+ * @brief Dessine le monde figé assombri (fond des écrans de pause et de confirmation).
+ *
+ * Avec le calque du monde, l'assombrissement est une modulation de couleur
+ * de la copie : un seul appel, sans voile par-dessus.
+ *
+ * @param alpha Opacité du voile noir équivalent (0 = aucun, 255 = noir).
+ */
+static void draw_world_dimmed(const GameModel *model, int alpha)
+{
+    if (!world_layer_update(model))
+    {
+        draw_world_content(model);
+        draw_overlay(alpha);
+        return;
+    }
+    Uint8 mod = (Uint8)(255 - alpha);
+    SDL_SetTextureColorMod(ctx.world.texture, mod, mod, mod);
+    render_texture(ctx.world.texture, NULL, NULL);
+    SDL_SetTextureColorMod(ctx.world.texture, 255, 255, 255);
+}
+
+/**
+ * @brief Identifie la partie statique de l'écran courant.
+ *
+ * La confirmation de sortie a deux fonds (monde de jeu ou menu) selon l'état
+ * précédent.
+ *
+ * @return Une clé non nulle pour les écrans à calque, 0 sinon.
+ */
+static int layer_key(const GameModel *model)
+{
+    bool in_game = (model->sim.previous_state == STATE_PLAYING || model->sim.previous_state == STATE_PAUSED);
+    switch (model->sim.state)
+    {
+    case STATE_MENU:
+    case STATE_PAUSED:
+    case STATE_GAME_OVER:
+    case STATE_TUTORIAL:
+    case STATE_SAVE_SELECT:
+    case STATE_LOAD_MENU:
+    case STATE_SAVE_INPUT:
+    case STATE_OVERWRITE_CONFIRM:
+        return (int)model->sim.state * 2 + 1;
+    case STATE_CONFIRM_QUIT:
+        return (int)model->sim.state * 2 + 1 + (in_game ? 1 : 0);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Dessine la partie statique d'un écran (fond, voile, titres).
+ */
+static void draw_layer_content(const GameModel *model)
+{
+    bool in_game = (model->sim.previous_state == STATE_PLAYING || model->sim.previous_state == STATE_PAUSED);
+    switch (model->sim.state)
+    {
+    case STATE_MENU:
+        render_texture(ctx.tex.bg_menu, NULL, NULL);
+        draw_string_centered(STR_TITLE, WIN_HEIGHT / 4, COL_GREEN, &ctx.atlas_title);
+        break;
+
+    case STATE_PAUSED:
+        draw_world_dimmed(model, 180);
+        draw_string_centered(STR_PAUSE, WIN_HEIGHT / 4, COL_WHITE, &ctx.atlas_title);
+        break;
+
+    case STATE_CONFIRM_QUIT:
+        if (in_game)
+        {
+            draw_world_dimmed(model, 230);
+        }
+        else
+        {
+            if (ctx.tex.bg_menu_1)
+                render_texture(ctx.tex.bg_menu_1, NULL, NULL);
+            draw_overlay(200);
+        }
+        draw_string_centered(STR_QUIT_WARNING, WIN_HEIGHT / 3, COL_RED, &ctx.atlas_title);
+        if (in_game)
+            draw_string_centered(STR_QUIT_UNSAVED, WIN_HEIGHT / 3 + 60, COL_WHITE, &ctx.atlas);
+        else
+            draw_string_centered(STR_QUIT_ASK, WIN_HEIGHT / 3 + 60, COL_WHITE, &ctx.atlas);
+        draw_string_centered(STR_QUIT_CONFIRM, WIN_HEIGHT / 3 + 90, COL_GRAY, &ctx.atlas);
+        break;
+
+    case STATE_TUTORIAL:
+    {
+        if (ctx.tex.bg_menu_1)
+            render_texture(ctx.tex.bg_menu_1, NULL, NULL);
+        draw_overlay(200);
+        draw_string_centered(STR_TUTO_TITLE, 50, (SDL_Color){0, 255, 255, 255}, &ctx.atlas_title);
+        draw_string_centered(STR_TUTO_MOVE, 130, COL_WHITE, &ctx.atlas);
+        draw_string_centered(STR_TUTO_FIRE, 180, COL_WHITE, &ctx.atlas);
+        const EntityType tuts[] = {ENTITY_ENEMY_TYPE_1, ENTITY_ENEMY_TYPE_2, ENTITY_ENEMY_TYPE_3, ENTITY_UFO};
+        for (int i = 0; i < 4; i++)
+        {
+            const EntityTypeInfo *info = &entity_types[tuts[i]];
+            bool ufo = tuts[i] == ENTITY_UFO;
+            SDL_FRect r = {WIN_WIDTH / 2 - 80, 325 + i * 60, 40, ufo ? 20 : 40};
+            draw_sprite(ufo ? SPRITE_UFO : SPRITE_ENEMY_1A + 2 * info->sprite, &r);
+            char b[32];
+            snprintf(b, 32, lang_get(ufo ? STR_POINTS_UFO : STR_POINTS), info->points);
+            SDL_Color c = {(info->color >> 16) & 0xFF, (info->color >> 8) & 0xFF, info->color & 0xFF, 255};
+            draw_text(b, WIN_WIDTH / 2 - 20, 320 + i * 60, c);
+        }
+        sprite_flush();
+        draw_string_centered(STR_TUTO_BACK, WIN_HEIGHT - 50, COL_GRAY, &ctx.atlas);
+        break;
+    }
+
+    case STATE_GAME_OVER:
+        if (ctx.tex.bg_menu_1)
+            render_texture(ctx.tex.bg_menu_1, NULL, NULL);
+        draw_overlay(200);
+        draw_string_centered(STR_GAME_OVER, WIN_HEIGHT / 4, COL_RED, &ctx.atlas_title);
+        break;
+
+    default: // Menus de sauvegarde et de chargement
+        if (ctx.tex.bg_menu_1)
+            render_texture(ctx.tex.bg_menu_1, NULL, NULL);
+        draw_overlay(200);
+        break;
+    }
+}
+
+/**
+ * @brief Dessine la partie statique de l'écran, depuis le calque si possible.
+ *
+ * Le calque est recomposé quand l'écran change (clé différente de celle de
+ * la frame précédente) ; les écrans sans calque le marquent à reconstruire.
+ * Sans render target, le contenu est dessiné directement.
+ *
+ * @param alpha Opacité de la copie (255 : opaque, sinon par-dessus ce qui est déjà dessiné).
+ */
+static void draw_static_layer(const GameModel *model, Uint8 alpha)
+{
+    RenderLayer *layer = &ctx.layer;
+    int key = layer_key(model);
+    if (key == 0)
+    {
+        layer->key = 0;
+        return;
+    }
+    if (!layer->texture)
+    {
+        draw_layer_content(model);
+        return;
+    }
+
+    if (layer->key != key)
+    {
+        set_render_target(layer->texture);
+        SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+        SDL_RenderClear(ctx.renderer);
+        draw_layer_content(model);
+        set_render_target(ctx.present.lowres);
+        layer->key = key;
+    }
+    if (alpha == 255)
+    {
+        render_texture(layer->texture, NULL, NULL);
+        return;
+    }
+    SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureAlphaMod(layer->texture, alpha);
+    render_texture(layer->texture, NULL, NULL);
+    SDL_SetTextureAlphaMod(layer->texture, 255);
+    SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_NONE);
+}
+
+/**
+ * @brief Dessine la démo d'accueil (attract.h) puis, en transparence, le calque du menu principal.
+ *
+ * La démo avance au tick près, sans état précédent : son monde est dessiné
+ * sans interpolation. Le calque du menu (fond et titre) est celui de
+ * l'écran sans démo, recopié avec une opacité réduite.
+ */
+static void draw_attract(const GameModel *demo, const GameModel *model)
+{
+    const GameModel *prev = ctx.prev;
+    float alpha = ctx.alpha;
+    ctx.prev = NULL;
+    ctx.alpha = 1.0f;
+    draw_world_content(demo);
+    ctx.prev = prev;
+    ctx.alpha = alpha;
+    draw_static_layer(model, ATTRACT_LAYER_ALPHA);
+    ctx.attract_drawn = true;
+}
+
+/**
+ * @brief Recalcule l'échelle de présentation et recrée les calques à leur taille à l'écran.
+ *
+ * Appelée à l'initialisation puis après un redimensionnement de la sortie
+ * (fenêtre, plein écran F11), jamais à chaque image. En basse résolution,
+ * l'échelle des calques est celle de la cible interne : ils ne changent pas.
+ * Fenêtre réduite (sortie vide) : les calques sont gardés.
+ */
+static void present_update(void)
+{
+    PresentState *p = &ctx.present;
+    p->dirty = false;
+    dirty_reset(true); // Surface de la fenêtre recréée, fond figé à la nouvelle échelle
+    int w = 0, h = 0;
+    if (!SDL_GetRenderOutputSize(ctx.renderer, &w, &h) || w <= 0 || h <= 0)
+        return;
+    p->pixel_w = w;
+    p->pixel_h = h;
+    float sx = (float)w / WIN_WIDTH, sy = (float)h / WIN_HEIGHT;
+    float scale = p->lowres ? p->lowres_scale : (sx < sy ? sx : sy);
+    // Plafond MEM_LAYERS : écran figé, monde et HUD (4 octets par pixel) dans ce que laissent les autres calques
+    uint64_t budget = ctx.mem.budget[MEM_LAYERS];
+    if (budget)
+    {
+        mem_census();
+        uint64_t scaled = texture_bytes(ctx.layer.texture) + texture_bytes(ctx.world.texture) + texture_bytes(ctx.hud.texture);
+        uint64_t others = ctx.mem.bytes[MEM_LAYERS] - scaled;
+        double unit = 4.0 * WIN_WIDTH * (2.0 * WIN_HEIGHT + HUD_LAYER_HEIGHT);
+        double room = budget > others ? (double)(budget - others) : 0.0;
+        if (unit * scale * scale > room)
+        {
+            float fit = (float)sqrt(room / unit);
+            scale = fit > BUDGET_MIN_LAYER_SCALE ? fit : BUDGET_MIN_LAYER_SCALE;
+            ctx.mem.reduced[MEM_LAYERS]++;
+        }
+    }
+    if (scale == p->scale)
+        return;
+
+    p->scale = scale;
+    ctx.layer.texture = scaled_target(ctx.layer.texture, WIN_WIDTH, WIN_HEIGHT, scale, SDL_BLENDMODE_NONE);
+    ctx.layer.key = 0;
+    ctx.world.texture = scaled_target(ctx.world.texture, WIN_WIDTH, WIN_HEIGHT, scale, SDL_BLENDMODE_NONE);
+    ctx.world.valid = false;
+    ctx.formation.valid = false;
+    if (!p->hud_direct)
+        ctx.hud.texture = scaled_target(ctx.hud.texture, WIN_WIDTH, HUD_LAYER_HEIGHT, scale, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    ctx.hud.valid = false;
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Present: output %dx%d, layers x%.2f%s", w, h, scale,
+                p->lowres ? " (low resolution target)" : "");
+    mem_census();
+}
+
+/**
+ * @brief Crée ou libère la cible basse résolution selon le niveau de qualité.
+ *
+ * @return true si la cible a changé (les calques sont à recréer à la nouvelle échelle).
+ */
+static bool lowres_update(void)
+{
+    PresentState *p = &ctx.present;
+    bool low = p->lowres_forced || ctx.quality.level >= QUALITY_LOWRES;
+    bool want = low || ctx.capture.staging[0] != NULL; // La capture relit l'image composée
+    float scale = low ? (float)LOWRES_WIDTH / WIN_WIDTH : 1.0f;
+    if (want == (p->lowres != NULL) && (!want || scale == p->lowres_scale))
+        return false;
+    SDL_DestroyTexture(p->lowres);
+    p->lowres = NULL;
+    if (want)
+    {
+        p->lowres = scaled_target(NULL, WIN_WIDTH, WIN_HEIGHT, scale, SDL_BLENDMODE_NONE);
+        if (!p->lowres)
+            return true;
+        p->lowres_scale = scale;
+        if (low)
+            SDL_SetTextureScaleMode(p->lowres, SDL_SCALEMODE_NEAREST);
+    }
+    return true;
+}
+
+/**
+ * @brief Applique un nouveau niveau de qualité (régulateur de quality.h).
+ *
+ * Les particules en vol sont effacées, l'écran figé est recomposé (son fond
+ * peut changer) et, à l'entrée ou à la sortie de QUALITY_LOWRES, les calques
+ * sont recréés à l'échelle de la nouvelle cible.
+ */
+static void quality_apply(void)
+{
+    if (ctx.quality.level >= QUALITY_NO_PARTICLES)
+        particles_clear(&ctx.particles.pool);
+    ctx.layer.key = 0;
+    ctx.world.valid = false;
+    dirty_reset(true); // Le fond peut disparaître (QUALITY_NO_BACKGROUND) ou revenir
+    if (lowres_update())
+    {
+        ctx.present.scale = 0.0f;
+        present_update();
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Quality: level %d (%s), frame %.2f ms, work %.2f ms", ctx.quality.level,
+                quality_name(ctx.quality.level), ctx.quality.frame_ms, ctx.quality.work_ms);
+}
+
+/**
+ * @brief Dessine le monde (et sur demande le HUD) d'un état dans une cible hors écran.
+ */
+static void draw_offscreen(SDL_Texture *target, const GameModel *model, bool hud)
+{
+    set_render_target(target);
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+    SDL_RenderClear(ctx.renderer);
+    draw_world_content(model);
+    if (hud)
+        draw_hud_content(model);
+    set_render_target(ctx.present.lowres);
+}
+
+/**
+ * @brief Relit les pixels d'une cible entière (surface à libérer par l'appelant, NULL si échec).
+ */
+static SDL_Surface *read_target(SDL_Texture *target)
+{
+    set_render_target(target);
+    SDL_Surface *s = SDL_RenderReadPixels(ctx.renderer, NULL);
+    set_render_target(ctx.present.lowres);
+    return s;
+}
+
+/**
+ * @brief Ouvre la capture vidéo : anneau de cibles à la taille demandée, puis le fichier et son encodeur.
+ *
+ * SPACE_INVADERS_CAPTURE_SCALE (0.1 à 1) règle la taille des images par
+ * rapport à la fenêtre logique (CAPTURE_DEFAULT_SCALE par défaut).
+ */
+static void capture_setup(const char *path)
+{
+    CaptureState *c = &ctx.capture;
+    const char *scale_env = getenv("SPACE_INVADERS_CAPTURE_SCALE");
+    float scale = scale_env ? (float)atof(scale_env) : CAPTURE_DEFAULT_SCALE;
+    if (!(scale >= 0.1f && scale <= 1.0f))
+        scale = CAPTURE_DEFAULT_SCALE;
+    bool ok = true;
+    for (int i = 0; i < CAPTURE_STAGING && ok; i++)
+        ok = (c->staging[i] = scaled_target(NULL, WIN_WIDTH, WIN_HEIGHT, scale, SDL_BLENDMODE_NONE)) != NULL;
+    float w = 0.0f, h = 0.0f;
+    if (ok)
+        SDL_GetTextureSize(c->staging[0], &w, &h);
+    if (!ok || !capture_open(path, (int)w, (int)h, TARGET_FPS))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_VIDEO, "Capture %s unavailable", path);
+        for (int i = 0; i < CAPTURE_STAGING; i++)
+            SDL_DestroyTexture(c->staging[i]);
+        memset(c, 0, sizeof(CaptureState));
+        return;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Capture: %dx%d to %s, %d staging targets", (int)w & ~1, (int)h & ~1, path,
+                CAPTURE_STAGING);
+}
+
+/**
+ * @brief Début d'image : relit la texture que l'image va réutiliser, si l'encodeur peut la prendre.
+ *
+ * Elle a été remplie CAPTURE_STAGING images plus tôt : le GPU l'a finie et
+ * la relecture n'attend pas. Encodeur en retard : l'image est perdue sans
+ * être relue.
+ */
+static void capture_readback(void)
+{
+    CaptureState *c = &ctx.capture;
+    if (!c->staging[0] || !c->filled[c->next])
+        return;
+    c->filled[c->next] = false;
+    if (capture_ready())
+        capture_submit(read_target(c->staging[c->next]));
+    else
+        capture_drop();
+}
+
+/**
+ * @brief Fin d'image : copie l'image composée dans la texture courante de l'anneau (sans attente).
+ */
+static void capture_stage(void)
+{
+    CaptureState *c = &ctx.capture;
+    if (!c->staging[0] || !ctx.present.lowres)
+        return;
+    set_render_target(c->staging[c->next]);
+    render_texture(ctx.present.lowres, NULL, NULL);
+    c->filled[c->next] = true;
+    c->next = (c->next + 1) % CAPTURE_STAGING;
+    c->frames++;
+}
+
+/**
+ * @brief Suit les miniatures de la page de sauvegardes affichée dans les menus.
+ *
+ * Une autre page (ou une sauvegarde réécrite) abandonne les décodages pas
+ * encore commencés et redemande toutes les cases sans texture ; les cases
+ * dont le fichier n'a pas changé gardent la leur. Les surfaces prêtes sont
+ * relevées à chaque image, quelle que soit la sélection.
+ */
+static void thumbs_select(const GameModel *model)
+{
+    ThumbnailState *th = &ctx.thumbs;
+    int sel = -1; // Indice du fichier sélectionné dans save_files
+    if (model->sim.state == STATE_LOAD_MENU)
+        sel = model->ui.menu_selection;
+    else if (model->sim.state == STATE_SAVE_SELECT)
+        sel = model->ui.menu_selection - 1; // La ligne 0 est "Créer nouvelle"
+    th->selected = -1;
+
+    if (model->sim.state == STATE_LOAD_MENU || model->sim.state == STATE_SAVE_SELECT)
+    {
+        int first = ((sel > 0) ? sel : 0) / SAVE_MENU_PAGE_SIZE * SAVE_MENU_PAGE_SIZE;
+        bool changed = false;
+        for (int k = 0; k < SAVE_MENU_PAGE_SIZE; k++)
+        {
+            ThumbnailSlot *slot = &th->page[k];
+            char path[THUMBNAIL_PATH_LEN] = "";
+            int64_t stamp = 0;
+            const SaveIndexEntry *e = NULL;
+            if (first + k < model->ui.save_file_count)
+            {
+                e = &model->ui.save_files[first + k];
+                save_index_thumbnail("sauvegardes", e->name, path, sizeof(path));
+                stamp = e->timestamp;
+            }
+            if (strcmp(path, slot->path) != 0 || stamp != slot->stamp)
+            {
+                SDL_DestroyTexture(slot->texture);
+                slot->texture = NULL;
+                snprintf(slot->path, sizeof(slot->path), "%s", path);
+                slot->stamp = stamp;
+                changed = true;
+            }
+        }
+        if (changed)
+        {
+            thumbnail_cancel_loads();
+            for (int k = 0; k < SAVE_MENU_PAGE_SIZE; k++)
+                if (th->page[k].path[0] && !th->page[k].texture)
+                    thumbnail_request(th->page[k].path);
+        }
+        if (sel >= first && sel < first + SAVE_MENU_PAGE_SIZE && sel < model->ui.save_file_count)
+            th->selected = sel - first;
+    }
+
+    char path[THUMBNAIL_PATH_LEN];
+    SDL_Surface *surface;
+    while (thumbnail_take(path, sizeof(path), &surface))
+    {
+        ThumbnailSlot *slot = NULL;
+        for (int k = 0; k < SAVE_MENU_PAGE_SIZE && !slot; k++)
+            if (th->page[k].path[0] && !th->page[k].texture && strcmp(path, th->page[k].path) == 0)
+                slot = &th->page[k];
+        if (surface && slot)
+        {
+            slot->texture = texture_from_surface(surface);
+            ctx.perf.uploads++;
+        }
+        else
+            SDL_DestroySurface(surface); // Page déjà quittée
+    }
+}
+
+/**
+ * @brief Capture la miniature d'une sauvegarde qui commence, puis la relit à l'image suivante.
+ *
+ * La sauvegarde peut se terminer dans le tick même où elle est lancée : la
+ * capture part donc de la première image en STATE_SAVING ou STATE_SAVE_SUCCESS,
+ * qui portent encore la partie sauvegardée.
+ */
+static void thumbs_frame(const GameModel *model)
+{
+    ThumbnailState *th = &ctx.thumbs;
+    if (!th->target)
+        return;
+    if (th->pending[0])
+    {
+        if (!thumbnail_save(read_target(th->target), th->pending))
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Thumbnail %s dropped", th->pending);
+        th->pending[0] = '\0';
+    }
+
+    bool saving = model->sim.state == STATE_SAVING || model->sim.state == STATE_SAVE_SUCCESS;
+    if (saving && !th->saving_seen && model->ui.current_filename[0])
+    {
+        draw_offscreen(th->target, model, false);
+        save_index_thumbnail("sauvegardes", model->ui.current_filename, th->pending, sizeof(th->pending));
+    }
+    th->saving_seen = saving;
+    thumbs_select(model);
+}
+
+/**
+ * @brief Affiche, encadrée en haut à droite, la miniature de la sauvegarde sélectionnée.
+ */
+static void draw_thumbnail(void)
+{
+    if (ctx.thumbs.selected < 0 || !ctx.thumbs.page[ctx.thumbs.selected].texture)
+        return;
+    SDL_FRect r = {WIN_WIDTH - THUMBNAIL_WIDTH - 40, 30, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT};
+    SDL_FRect frame = {r.x - 2, r.y - 2, r.w + 4, r.h + 4};
+    SDL_SetRenderDrawColor(ctx.renderer, 200, 200, 200, 255);
+    SDL_RenderRect(ctx.renderer, &frame);
+    ctx.perf.draws++;
+    render_texture(ctx.thumbs.page[ctx.thumbs.selected].texture, NULL, &r);
+}
+
+/**
+ * @brief Libère une ressource rechargée (échangée ou jamais récupérée).
+ */
+static void hot_free(void *data, void *user)
+{
+    (void)user;
+    HotAsset *a = data;
+    SDL_DestroySurface(a->surface);
+    if (a->audio)
+        MIX_DestroyAudio(a->audio);
+    if (a->io)
+        SDL_CloseIO(a->io);
+    SDL_free(a);
+}
+
+/**
+ * @brief Décode un fichier modifié de HOT_RELOAD_ROOT (thread de rechargement).
+ *
+ * Un sprite de même taille est seulement teint, comme dans sprites_compose ;
+ * si sa taille change, toute la planche est recomposée (son rectangle et
+ * ceux de ses voisins bougent). Un son est décodé par le mixeur, qui
+ * l'accepte depuis n'importe quel thread ; la musique, lue en flux, n'est
+ * qu'ouverte.
+ *
+ * @return La ressource, ou NULL si le fichier n'est pas chargé par la Vue ou n'a pas pu être décodé.
+ */
+static void *hot_decode(const char *path, void *user)
+{
+    (void)user;
+    HotAsset *a = SDL_calloc(1, sizeof(HotAsset));
+    if (!a)
+        return NULL;
+
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        if (strcmp(SPRITE_DEFS[i].path, path) != 0)
+            continue;
+        SDL_Surface *img = load_surface(path);
+        if (!img)
+            break;
+        SDL_FRect *r = &ctx.hot_rects[i];
+        if ((int)r->w == img->w && (int)r->h == img->h && sprite_mip_count(img->w, img->h) == 1)
+        {
+            a->kind = HOT_SPRITE;
+            a->sprite = (SpriteId)i;
+            a->surface = SDL_CreateSurface(img->w, img->h, SDL_PIXELFORMAT_ARGB8888);
+            if (a->surface)
+            {
+                SDL_SetSurfaceBlendMode(img, SDL_BLENDMODE_NONE);
+                SDL_SetSurfaceColorMod(img, SPRITE_DEFS[i].tint.r, SPRITE_DEFS[i].tint.g, SPRITE_DEFS[i].tint.b);
+                SDL_BlitSurface(img, NULL, a->surface, NULL);
+            }
+        }
+        else
+        {
+            GameTextures layout;
+            a->kind = HOT_SHEET;
+            a->surface = sprites_compose(&layout);
+            memcpy(a->rects, layout.rects, sizeof(a->rects));
+            memcpy(a->mips, layout.mips, sizeof(a->mips));
+            if (a->surface)
+                memcpy(ctx.hot_rects, layout.rects, sizeof(ctx.hot_rects));
+        }
+        SDL_DestroySurface(img);
+        if (!a->surface)
+            break;
+        return a;
     }
 
-    SDL_RenderTexture(ctx.renderer, ctx.tex.bg_game, NULL, NULL);
-
-    if (model->player.active)
+    static const struct
     {
-        SDL_Texture *t = ctx.tex.player;
-        if (model->hit_timer > 0)
+        const char *path;
+        SDL_Texture **texture;
+    } backgrounds[] = {{IMG_BG_MENU, &ctx.tex.bg_menu}, {IMG_BG_MENU_1, &ctx.tex.bg_menu_1}, {IMG_BG_GAME, &ctx.tex.bg_game}};
+    for (size_t i = 0; i < SDL_arraysize(backgrounds); i++)
+        if (strcmp(backgrounds[i].path, path) == 0 && (a->surface = load_surface(path)) != NULL)
         {
-            t = ctx.tex.expl_player[(int)(model->hit_timer * 10) % 2];
-            SDL_SetTextureColorMod(t, 255, 100, 100);
+            a->kind = HOT_TEXTURE;
+            a->texture = backgrounds[i].texture;
+            return a;
         }
-        else
-            SDL_SetTextureColorMod(t, 0, 255, 0);
-        draw_entity_scaled(t, model->player.x, model->player.y, model->player.width, model->player.height, sx, sy);
-        SDL_SetTextureColorMod(t, 255, 255, 255);
-    }
 
-    for (int i = 0; i < MAX_ENEMIES; i++)
+    for (size_t i = 0; i < SDL_arraysize(SOUND_DEFS); i++)
     {
-        const Entity *e = &model->enemies[i];
-        if (!e->active)
+        if (strcmp(SOUND_DEFS[i].path, path) != 0 || !ctx.mixer)
             continue;
-        SDL_Texture *t = e->exploding ? ctx.tex.expl_enemy : NULL;
-        if (!t)
+        a->track = SOUND_DEFS[i].track ? *SOUND_DEFS[i].track : NULL;
+        if (!SOUND_DEFS[i].slot && a->track && (a->io = asset_io(path)) != NULL)
+        {
+            a->kind = HOT_STREAM;
+            return a;
+        }
+        if (SOUND_DEFS[i].slot && (a->audio = load_audio(path, SOUND_DEFS[i].predecode, NULL)) != NULL)
         {
-            int idx = e->type - ENTITY_ENEMY_TYPE_1;
-            if (idx < 0)
-                idx = 0;
-            if (idx > 2)
-                idx = 2;
-            t = ctx.tex.enemies[idx][model->animation_frame];
-            if (idx == 0)
-                SDL_SetTextureColorMod(t, 0, 255, 255);
-            if (idx == 1)
-                SDL_SetTextureColorMod(t, 255, 165, 0);
-            if (idx == 2)
-                SDL_SetTextureColorMod(t, 255, 50, 50);
+            a->kind = HOT_AUDIO;
+            a->slot = SOUND_DEFS[i].slot;
+            return a;
         }
-        draw_entity_scaled(t, e->x, e->y, e->width, e->height, sx, sy);
-        if (t)
-            SDL_SetTextureColorMod(t, 255, 255, 255);
     }
 
-    if (model->ufo.active)
+    hot_free(a, NULL);
+    return NULL;
+}
+
+/**
+ * @brief Réveille la boucle des menus (sdl_wait_input) : une ressource attend d'être échangée.
+ */
+static void hot_notify(void *user)
+{
+    (void)user;
+    SDL_Event e = {.type = SDL_EVENT_USER};
+    SDL_PushEvent(&e);
+}
+
+/**
+ * @brief Lance la surveillance, une fois les images et les sons du démarrage en place.
+ *
+ * Plus tôt, un fichier rechargé pourrait être écrasé par le chargement en
+ * fond qui le lit encore. Sans effet avec une archive : les ressources n'y
+ * sont pas lues depuis HOT_RELOAD_ROOT.
+ */
+static void hot_start(void)
+{
+    if (!ctx.hot_wanted || !ctx.world_loader.attached || !ctx.audio_loader.attached)
+        return;
+    ctx.hot_wanted = false;
+    if (ctx.pack.base)
     {
-        SDL_Texture *t = model->ufo.exploding ? ctx.tex.expl_ufo : ctx.tex.ufo;
-        if (!model->ufo.exploding)
-            SDL_SetTextureColorMod(t, 255, 0, 255);
-        draw_entity_scaled(t, model->ufo.x, model->ufo.y, model->ufo.width, model->ufo.height, sx, sy);
-        SDL_SetTextureColorMod(t, 255, 255, 255);
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Hot reload: disabled, assets are read from the pack");
+        return;
     }
+    memcpy(ctx.hot_rects, ctx.tex.rects, sizeof(ctx.hot_rects));
+    const HotReloadOps ops = {hot_decode, hot_free, hot_notify, NULL};
+    if (!hotreload_start(&ctx.hot, HOT_RELOAD_ROOT, &ops))
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Hot reload: cannot watch %s", HOT_RELOAD_ROOT);
+}
 
-    for (int i = 0; i < MAX_SHIELDS; i++)
+/**
+ * @brief Remplace l'atlas des sprites par une planche recomposée.
+ */
+static void hot_swap_sheet(HotAsset *a)
+{
+    SDL_Texture *old = ctx.tex.sprites;
+    StagedImage sheet = {.surface = a->surface};
+    a->surface = NULL; // Libérée par staged_upload
+    if (sprites_upload(&ctx.tex, &sheet))
     {
-        if (!model->shields[i].active)
-            continue;
-        int idx = 10 - model->shields[i].health;
-        if (idx < 0)
-            idx = 0;
-        if (idx > 9)
-            idx = 9;
-        SDL_Texture *t = ctx.tex.shields[idx];
-        SDL_SetTextureColorMod(t, 0, 255, 0);
-        draw_entity_scaled(t, model->shields[i].x, model->shields[i].y, model->shields[i].width, model->shields[i].height, sx, sy);
-        SDL_SetTextureColorMod(t, 255, 255, 255);
+        SDL_DestroyTexture(old);
+        memcpy(ctx.tex.rects, a->rects, sizeof(ctx.tex.rects));
+        memcpy(ctx.tex.mips, a->mips, sizeof(ctx.tex.mips));
+    }
+    else
+        ctx.tex.sprites = old;
+}
+
+/**
+ * @brief Réécrit un sprite dans son rectangle de l'atlas.
+ *
+ * Si le rectangle n'a plus la taille de l'image (une planche recomposée a
+ * été remplacée avant d'être échangée), la planche est recomposée ici.
+ */
+static void hot_swap_sprite(HotAsset *a)
+{
+    const SDL_FRect *r = &ctx.tex.rects[a->sprite];
+    if (!ctx.tex.sprites || (int)r->w != a->surface->w || (int)r->h != a->surface->h)
+    {
+        GameTextures layout;
+        SDL_DestroySurface(a->surface);
+        a->surface = sprites_compose(&layout);
+        memcpy(a->rects, layout.rects, sizeof(a->rects));
+        memcpy(a->mips, layout.mips, sizeof(a->mips));
+        if (a->surface)
+            hot_swap_sheet(a);
+        return;
     }
+    SDL_Rect dst = {(int)r->x, (int)r->y, a->surface->w, a->surface->h};
+    SDL_Surface *px = a->surface;
+    if (px->format != ctx.tex.sprites->format)
+        px = SDL_ConvertSurface(a->surface, ctx.tex.sprites->format);
+    if (px)
+        SDL_UpdateTexture(ctx.tex.sprites, &dst, px->pixels, px->pitch);
+    if (px != a->surface)
+        SDL_DestroySurface(px);
+}
 
-    for (int i = 0; i < MAX_BULLETS; i++)
+/**
+ * @brief Échange avec les ressources en place celles que le thread a décodées (entre deux images).
+ *
+ * Un sprite de même taille ne renvoie que son rectangle (SDL_UpdateTexture) ;
+ * les calques pré-composés (fond, HUD) sont redessinés à l'image suivante.
+ */
+static void hot_apply(void)
+{
+    HotReloadItem items[HOT_APPLY_MAX];
+    int n = hotreload_take(&ctx.hot, items, HOT_APPLY_MAX);
+    for (int i = 0; i < n; i++)
     {
-        const Entity *b = &model->bullets[i];
-        if (!b->active)
-            continue;
-        SDL_Texture *t = (b->type == ENTITY_BULLET_PLAYER) ? ctx.tex.missiles[b->anim_frame] : ctx.tex.projectiles[b->anim_frame];
-        draw_entity_scaled(t, b->x, b->y, 1.0f, 1.0f, sx, sy);
+        HotAsset *a = items[i].data;
+        double t0 = utils_get_time();
+        if (a->kind != HOT_AUDIO && a->kind != HOT_STREAM)
+            dirty_reset(a->kind == HOT_TEXTURE); // Image changée sans que la signature des éléments bouge
+        switch (a->kind)
+        {
+        case HOT_SPRITE:
+            hot_swap_sprite(a);
+            break;
+        case HOT_SHEET:
+            hot_swap_sheet(a);
+            break;
+        case HOT_TEXTURE:
+        {
+            SDL_Texture *t = texture_from_surface(a->surface);
+            a->surface = NULL;
+            if (t)
+            {
+                SDL_DestroyTexture(*a->texture);
+                *a->texture = t;
+            }
+            break;
+        }
+        case HOT_AUDIO:
+            MIX_DestroyAudio(*a->slot); // Compté par référence : une voix qui le joue encore le garde
+            *a->slot = a->audio;
+            a->audio = NULL;
+            if (a->track)
+            {
+                MIX_StopTrack(a->track, 0);
+                MIX_SetTrackAudio(a->track, *a->slot);
+                ctx.audio_applied.music = ctx.audio_applied.ufo = -1; // track_apply la relance si elle doit jouer
+            }
+            break;
+        case HOT_STREAM:
+            MIX_StopTrack(a->track, 0);
+            if (MIX_SetTrackIOStream(a->track, a->io, true)) // L'ancien flux est fermé par la piste
+                a->io = NULL;
+            else
+                SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Cannot stream %s: %s", items[i].path, SDL_GetError());
+            ctx.audio_applied.music = ctx.audio_applied.ufo = -1;
+            break;
+        }
+        ctx.layer.key = 0;
+        ctx.world.valid = false;
+        ctx.formation.valid = false;
+        ctx.hud.valid = false;
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Hot reload: %s swapped in %.2f ms", items[i].path,
+                    (utils_get_time() - t0) * 1000.0);
+        hot_free(a, NULL);
     }
 }
 
@@ -380,99 +3782,141 @@ static void draw_game_world(const GameModel *model)
 /**
  * @brief Initialise SDL et charge toutes les ressources graphiques et audio.
  *
- * Configure la fenêtre, le renderer, charge les textures (sprites, fonds,
- * explosions, boucliers), les polices et les sons.
+ * Configure la fenêtre, le renderer, charge le fond du menu et les polices ;
+ * les images du jeu (world_load_main) et les sons (audio_load_main) se
+ * chargent en fond. Chaque étape est chronométrée (journal "Startup:").
  *
  * @return true si l'initialisation a réussi, false sinon.
  */
 static bool sdl_init(void)
 {
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_AUDIO))
+    memtrack_install(); // Avant toute allocation de SDL
+    ctx.startup.begin = ctx.startup.last = utils_get_time();
+    membudget_init(&ctx.mem); // Plafonds lus avant les threads de chargement
+    const char *pack_env = getenv("SPACE_INVADERS_ASSETS");
+    if (asset_pack_open(&ctx.pack, pack_env ? pack_env : ASSET_PACK_PATH))
+        SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Startup: %s mapped, %u assets, %.0f KiB",
+                    pack_env ? pack_env : ASSET_PACK_PATH, ctx.pack.count, ctx.pack.size / 1024.0);
+    spsc_init(&ctx.audio_events, ctx.audio_storage, sizeof(AudioEvent), AUDIO_EVENT_RING);
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD))
         return false;
+    const char *deadzone = getenv("SPACE_INVADERS_PAD_DEADZONE");
+    for (int p = 0; p < PAD_PLAYERS; p++)
+        pad_init(&ctx.pad[p], deadzone ? atoi(deadzone) : PAD_DEADZONE);
+    attract_init(&ctx.attract, ctx.startup.begin);
+    frame_arena_init(&ctx.frame, FRAME_ARENA_BYTES); // Sans arène, les chaînes longues passent par le rendu de secours
+    const char *hot = getenv("SPACE_INVADERS_HOT_RELOAD");
+    ctx.hot_wanted = hot && strcmp(hot, "0") != 0;
     if (!TTF_Init())
         return false;
     if (!MIX_Init())
         SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Mix_Init");
+    startup_step("SDL_Init", STARTUP_SDL);
 
     ctx.window = SDL_CreateWindow("Space Invaders", WIN_WIDTH, WIN_HEIGHT, SDL_WINDOW_RESIZABLE);
-    ctx.renderer = SDL_CreateRenderer(ctx.window, NULL);
+    ctx.renderer = ctx.window ? SDL_CreateRenderer(ctx.window, render_driver) : NULL;
+    if (ctx.window && !ctx.renderer && render_driver)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Renderer \"%s\" unavailable (%s), using default", render_driver, SDL_GetError());
+        ctx.renderer = SDL_CreateRenderer(ctx.window, NULL);
+    }
     if (!ctx.window || !ctx.renderer)
         return false;
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Startup: renderer %s", SDL_GetRendererName(ctx.renderer));
+
+    // Enregistrement des commandes de rendu : ouvert avant la première texture
+    const char *rendercap_env = getenv("SPACE_INVADERS_RENDER_CAPTURE");
+    if (rendercap_env && rendercap_env[0] && !rendercap_open(rendercap_env, ctx.renderer))
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Render capture: cannot create %s", rendercap_env);
+
+    // Durée des images côté GPU (horodatages OpenGL ou barrières SDL_GPU), lue par le profileur
+    if (!gputime_open(ctx.renderer))
+        SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "GPU timing: not available with renderer %s", SDL_GetRendererName(ctx.renderer));
 
     SDL_SetRenderLogicalPresentation(ctx.renderer, WIN_WIDTH, WIN_HEIGHT, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+
+    // Rendu logiciel : l'écran affiché se reprend par rectangles (SPACE_INVADERS_DIRTY_RECTS=0 pour le désactiver)
+    const char *dirty_env = getenv("SPACE_INVADERS_DIRTY_RECTS");
+    ctx.dirty.enabled = strcmp(SDL_GetRendererName(ctx.renderer), SDL_SOFTWARE_RENDERER) == 0 &&
+                        !(dirty_env && strcmp(dirty_env, "0") == 0);
+    if (ctx.dirty.enabled)
+        SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Startup: dirty-rectangle presentation");
+
+    // Synchronisation verticale si le pilote la propose (SPACE_INVADERS_VSYNC=0 pour la désactiver).
+    // Le rendu logiciel ne la simule qu'en dormant dans SDL_RenderPresent, que les
+    // rectangles sales contournent : la cadence revient alors à la boucle de jeu
+    const char *vsync_env = getenv("SPACE_INVADERS_VSYNC");
+    if (!(vsync_env && strcmp(vsync_env, "0") == 0) && !ctx.dirty.enabled)
+        ctx.vsync = SDL_SetRenderVSync(ctx.renderer, 1);
     SCALE_X = (float)WIN_WIDTH / GAME_WIDTH;
     SCALE_Y = (float)WIN_HEIGHT / GAME_HEIGHT;
+    startup_step("window", STARTUP_SDL);
 
-    SDL_AudioSpec spec = {SDL_AUDIO_S16, 2, 44100};
-    ctx.mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    // Fond procédural : choisi avant le décodage, qui saute alors l'image du fond
+    const char *stars_env = getenv("SPACE_INVADERS_STARFIELD");
+    ctx.stars.enabled = stars_env && strcmp(stars_env, "1") == 0;
+    if (ctx.stars.enabled)
+        starfield_init(&ctx.stars.field, WIN_WIDTH, WIN_HEIGHT, 0x5EED5EEDu);
 
-    ctx.font = TTF_OpenFont(FONT_PATH, FONT_SIZE);
-    ctx.font_title = TTF_OpenFont(FONT_PATH, 64);
-
-    ctx.tex.player = load_texture("assets/aliens/space_player.bmp");
-    ctx.tex.heart_full = load_texture("assets/hearts/heart_full.bmp");
-    ctx.tex.heart_empty = load_texture("assets/hearts/heart_empty.bmp");
-    ctx.tex.bg_menu = load_texture("assets/backgrounds/bg_menu_1.bmp");
-    ctx.tex.bg_menu_1 = load_texture("assets/backgrounds/bg_menu.bmp");
-    ctx.tex.bg_game = load_texture("assets/backgrounds/background.bmp");
-    ctx.tex.ufo = load_texture("assets/aliens/space_UFO.bmp");
-    ctx.tex.expl_ufo = load_texture("assets/explosions/ufoExplosion.bmp");
-    ctx.tex.expl_enemy = load_texture("assets/explosions/enemyExplosion.bmp");
-    ctx.tex.expl_player[0] = load_texture("assets/explosions/playerExplosionA.bmp");
-    ctx.tex.expl_player[1] = load_texture("assets/explosions/playerExplosionB.bmp");
-
-    const char *ef[3][2] = {{"assets/aliens/alien_A1.bmp", "assets/aliens/alien_A2.bmp"}, {"assets/aliens/alien_B1.bmp", "assets/aliens/alien_B2.bmp"}, {"assets/aliens/alien_C1.bmp", "assets/aliens/alien_C2.bmp"}};
-    for (int t = 0; t < 3; t++)
-        for (int f = 0; f < 2; f++)
-            ctx.tex.enemies[t][f] = load_texture(ef[t][f]);
+    // Les images du jeu se décodent pendant l'ouverture des polices et le menu
+    ctx.world_loader.started = utils_get_time();
+    ctx.world_loader.thread = SDL_CreateThread(world_load_main, "world_load", NULL);
+    if (!ctx.world_loader.thread)
+        world_load_main(NULL);
 
-    for (int i = 0; i < 4; i++)
+    ctx.font = load_font(FONT_SIZE);
+    if (!fonts_build())
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Glyph atlas unavailable, falling back to per-call text rendering");
+    startup_step("fonts", STARTUP_FONTS);
+
+    StagedImage menu;
+    stage_image(&menu, IMG_BG_MENU);
+    ctx.tex.bg_menu = background_upload(&menu);
+    startup_step("menu", STARTUP_TEXTURES);
+    SDL_Texture *probe = SDL_CreateTexture(ctx.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, 4, 4);
+    if (!probe || !target_alpha_ok(probe))
     {
-        char p1[64], p2[64];
-        snprintf(p1, 64, "assets/missiles/missile_%d.bmp", i + 1);
-        snprintf(p2, 64, "assets/projectiles/projectileA_%d.bmp", i + 1);
-        ctx.tex.missiles[i] = load_texture(p1);
-        ctx.tex.projectiles[i] = load_texture(p2);
+        SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "Render targets lose alpha, HUD drawn directly");
+        ctx.present.hud_direct = true;
     }
-
-    ctx.tex.shields[0] = load_texture("assets/shelter/shelter_full.bmp");
-    for (int i = 1; i <= 9; i++)
+    SDL_DestroyTexture(probe);
+    const char *lowres_env = getenv("SPACE_INVADERS_LOWRES");
+    ctx.present.lowres_forced = lowres_env && strcmp(lowres_env, "1") == 0;
+    quality_init(&ctx.quality, quality_from_env());
+    const char *capture_env = getenv("SPACE_INVADERS_CAPTURE");
+    if (capture_env && capture_env[0])
+        capture_setup(capture_env);
+    lowres_update();
+    ctx.thumbs.target = scaled_target(NULL, WIN_WIDTH, WIN_HEIGHT, (float)THUMBNAIL_WIDTH / WIN_WIDTH, SDL_BLENDMODE_NONE);
+    present_update(); // Après les cibles de taille fixe : les calques prennent ce qu'elles laissent du plafond
+    ctx.batch.vertices = SDL_malloc((size_t)SPRITE_BATCH_MAX * 4 * sizeof(SDL_Vertex));
+    ctx.batch.indices = SDL_malloc((size_t)SPRITE_BATCH_MAX * 6 * sizeof(int));
+    if (!ctx.batch.vertices || !ctx.batch.indices)
+        return false;
+    for (int q = 0; q < SPRITE_BATCH_MAX; q++)
     {
-        char p[64];
-        snprintf(p, 64, "assets/shelter/shelterDamaged_%d.bmp", i);
-        ctx.tex.shields[i] = load_texture(p);
+        static const int quad[6] = {0, 1, 2, 0, 2, 3};
+        for (int k = 0; k < 6; k++)
+            ctx.batch.indices[q * 6 + k] = q * 4 + quad[k];
     }
+    const char *particles_env = getenv("SPACE_INVADERS_PARTICLES");
+    if (!(particles_env && strcmp(particles_env, "0") == 0))
+        particles_setup();
+    prime_render_commands();
+    startup_step("targets", STARTUP_TEXTURES);
 
-    if (ctx.mixer)
-    {
-        ctx.sfx.shoot = MIX_LoadAudio(ctx.mixer, "assets/audio/shootSound.wav", true);
-        ctx.sfx.killed = MIX_LoadAudio(ctx.mixer, "assets/audio/invaderKilledSound.wav", true);
-        ctx.sfx.explosion = MIX_LoadAudio(ctx.mixer, "assets/audio/explosionSound.wav", true);
-        ctx.sfx.ufo = MIX_LoadAudio(ctx.mixer, "assets/audio/ufoSound.wav", true);
-        ctx.sfx.game_over = MIX_LoadAudio(ctx.mixer, "assets/audio/gameOverSound.wav", true);
-        ctx.sfx.level_up = MIX_LoadAudio(ctx.mixer, "assets/audio/levelUpSound.wav", true);
-        ctx.sfx.select = MIX_LoadAudio(ctx.mixer, "assets/audio/selectSound.wav", true);
-        ctx.sfx.bg_music_data = MIX_LoadAudio(ctx.mixer, "assets/audio/menuSound.wav", true);
+    MemtrackStats mem;
+    memtrack_stats(&mem);
+    ctx.perf.allocs_seen = mem.allocs;
+    SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Startup: %llu SDL allocations, %.0f KiB live",
+                (unsigned long long)mem.allocs, mem.live_bytes / 1024.0);
+    mem_report("startup");
 
-        for (int i = 0; i < 4; i++)
-        {
-            char p[64];
-            snprintf(p, 64, "assets/audio/fastinvader%d.wav", i + 1);
-            ctx.sfx.beat[i] = MIX_LoadAudio(ctx.mixer, p, true);
-        }
-        if (ctx.sfx.bg_music_data)
-        {
-            ctx.sfx.bg_music_track = MIX_CreateTrack(ctx.mixer);
-            if (ctx.sfx.bg_music_track)
-                MIX_SetTrackAudio(ctx.sfx.bg_music_track, ctx.sfx.bg_music_data);
-        }
-        if (ctx.sfx.ufo)
-        {
-            ctx.sfx.ufo_track = MIX_CreateTrack(ctx.mixer);
-            if (ctx.sfx.ufo_track)
-                MIX_SetTrackAudio(ctx.sfx.ufo_track, ctx.sfx.ufo);
-        }
-    }
+    // L'audio (périphérique, décodage des sons) se prépare en fond : le menu répond déjà
+    ctx.audio_loader.started = utils_get_time();
+    ctx.audio_loader.thread = SDL_CreateThread(audio_load_main, "audio_load", NULL);
+    if (!ctx.audio_loader.thread)
+        audio_load_main(NULL);
     return true;
 }
 
@@ -484,6 +3928,36 @@ static bool sdl_init(void)
  */
 static void sdl_close(void)
 {
+    hotreload_stop(&ctx.hot); // Avant les textures et le mixeur qu'il alimente
+    attract_free(&ctx.attract);
+    if (ctx.frame.frames > 0)
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frame arena: peak %zu of %zu bytes, %llu overflow(s)",
+                    ctx.frame.peak, ctx.frame.capacity, (unsigned long long)ctx.frame.overflows);
+    frame_arena_free(&ctx.frame);
+    for (int p = 0; p < PAD_PLAYERS; p++)
+    {
+        if (ctx.gamepad[p])
+            SDL_CloseGamepad(ctx.gamepad[p]);
+        ctx.gamepad[p] = NULL;
+    }
+    if (ctx.audio_loader.thread)
+        SDL_WaitThread(ctx.audio_loader.thread, NULL); // Chargement encore en cours
+    ctx.audio_loader.thread = NULL;
+    if (ctx.world_loader.thread)
+        SDL_WaitThread(ctx.world_loader.thread, NULL);
+    ctx.world_loader.thread = NULL;
+    StagedImage *staged[] = {&ctx.world_loader.sheet, &ctx.world_loader.bg_menu_1, &ctx.world_loader.bg_game};
+    for (int i = 0; i < 3; i++) // Jamais converties (menu quitté directement)
+    {
+        SDL_DestroySurface(staged[i]->surface);
+        texcache_release(&staged[i]->cached);
+    }
+    if (ctx.voices.played > 0)
+        SDL_Log("Audio: %llu sounds played, %llu cut short (%d voices)",
+                (unsigned long long)ctx.voices.played, (unsigned long long)ctx.voices.stolen, ctx.voices.count);
+    for (int i = 0; i < ctx.voices.count; i++)
+        MIX_DestroyTrack(ctx.voices.voices[i].track);
+    ctx.voices.count = 0;
     if (ctx.sfx.ufo_track)
         MIX_DestroyTrack(ctx.sfx.ufo_track);
     if (ctx.sfx.bg_music_track)
@@ -502,51 +3976,120 @@ static void sdl_close(void)
         MIX_DestroyAudio(ctx.sfx.level_up);
     if (ctx.sfx.select)
         MIX_DestroyAudio(ctx.sfx.select);
-    if (ctx.sfx.bg_music_data)
-        MIX_DestroyAudio(ctx.sfx.bg_music_data);
     for (int i = 0; i < 4; i++)
         if (ctx.sfx.beat[i])
             MIX_DestroyAudio(ctx.sfx.beat[i]);
+    if (ctx.sfx.loop)
+        SDL_DestroyProperties(ctx.sfx.loop);
     if (ctx.mixer)
         MIX_DestroyMixer(ctx.mixer);
 
-    SDL_DestroyTexture(ctx.tex.player);
-    SDL_DestroyTexture(ctx.tex.bullet);
-    SDL_DestroyTexture(ctx.tex.ufo);
+    SDL_DestroyTexture(ctx.hud.texture);
+    SDL_DestroyTexture(ctx.layer.texture);
+    SDL_DestroyTexture(ctx.world.texture);
+    SDL_DestroyTexture(ctx.formation.texture);
+    if (ctx.dirty.frames > 0)
+        SDL_Log("Dirty rects: %llu partial frames (%.0f%% of the screen on average), %llu full frames",
+                (unsigned long long)ctx.dirty.frames, 100.0 * ctx.dirty.area / (double)ctx.dirty.frames,
+                (unsigned long long)ctx.dirty.full_frames);
+    SDL_DestroyTexture(ctx.dirty.background);
+    if (ctx.capture.staging[0])
+    {
+        for (int k = 0; k < CAPTURE_STAGING; k++)
+        {
+            capture_readback(); // Dernières images de l'anneau, de la plus ancienne à la plus récente
+            ctx.capture.next = (ctx.capture.next + 1) % CAPTURE_STAGING;
+        }
+        CaptureStats cs;
+        capture_close(&cs); // Images en attente encodées avant de quitter
+        SDL_Log("Capture: %llu frames staged, %llu written, %llu dropped, %.1f ms encoding per frame",
+                (unsigned long long)ctx.capture.frames, (unsigned long long)cs.written,
+                (unsigned long long)cs.dropped, cs.written ? cs.encode_s * 1000.0 / (double)cs.written : 0.0);
+        for (int i = 0; i < CAPTURE_STAGING; i++)
+            SDL_DestroyTexture(ctx.capture.staging[i]);
+        memset(&ctx.capture, 0, sizeof(ctx.capture));
+    }
+    SDL_DestroyTexture(ctx.present.lowres);
+    thumbnail_shutdown(); // Miniature en cours d'écriture terminée avant de quitter
+    SDL_DestroyTexture(ctx.thumbs.target);
+    for (int k = 0; k < SAVE_MENU_PAGE_SIZE; k++)
+        SDL_DestroyTexture(ctx.thumbs.page[k].texture);
+    memset(&ctx.thumbs, 0, sizeof(ctx.thumbs));
+    SDL_DestroyTexture(ctx.tex.sprites);
     SDL_DestroyTexture(ctx.tex.bg_menu);
     SDL_DestroyTexture(ctx.tex.bg_menu_1);
     SDL_DestroyTexture(ctx.tex.bg_game);
-    SDL_DestroyTexture(ctx.tex.heart_full);
-    SDL_DestroyTexture(ctx.tex.heart_empty);
     SDL_DestroyTexture(ctx.tex.blur);
-    SDL_DestroyTexture(ctx.tex.expl_enemy);
-    SDL_DestroyTexture(ctx.tex.expl_ufo);
-    SDL_DestroyTexture(ctx.tex.expl_player[0]);
-    SDL_DestroyTexture(ctx.tex.expl_player[1]);
-
-    for (int t = 0; t < 3; t++)
-        for (int f = 0; f < 2; f++)
-            SDL_DestroyTexture(ctx.tex.enemies[t][f]);
-    for (int i = 0; i < 4; i++)
-    {
-        SDL_DestroyTexture(ctx.tex.missiles[i]);
-        SDL_DestroyTexture(ctx.tex.projectiles[i]);
-    }
-    for (int i = 0; i < 10; i++)
-        SDL_DestroyTexture(ctx.tex.shields[i]);
+    for (int i = 0; i < MAX_SHIELDS; i++)
+        SDL_DestroyTexture(ctx.shields[i].texture);
+    if (ctx.particles.pool.spawned > 0)
+        SDL_Log("Particles: %llu spawned, %llu dropped", (unsigned long long)ctx.particles.pool.spawned,
+                (unsigned long long)ctx.particles.pool.dropped);
+    SDL_free(ctx.particles.vertices);
+    SDL_free(ctx.particles.indices);
+    particles_free(&ctx.particles.pool);
+    SDL_free(ctx.batch.vertices);
+    SDL_free(ctx.batch.indices);
+    ctx.batch.vertices = NULL;
+    ctx.batch.indices = NULL;
 
+    SDL_Log("Text cache: %llu hits, %llu misses (%d entries)",
+            (unsigned long long)ctx.text_cache.hits, (unsigned long long)ctx.text_cache.misses, TEXT_CACHE_SIZE);
+    text_cache_clear();
+    atlas_free(&ctx.atlas);
+    atlas_free(&ctx.atlas_title);
     if (ctx.font)
         TTF_CloseFont(ctx.font);
-    if (ctx.font_title)
-        TTF_CloseFont(ctx.font_title);
+    if (rendercap_active())
+    {
+        RendercapStats rs;
+        rendercap_close(&rs);
+        SDL_Log("Render capture: %llu frames, %llu commands, %llu textures, %.0f KiB",
+                (unsigned long long)rs.frames, (unsigned long long)rs.commands, (unsigned long long)rs.textures,
+                rs.bytes / 1024.0);
+    }
+    GpuTimeStats gs;
+    gputime_close(&gs);
+    if (gs.method)
+        SDL_Log("GPU timing (%s): %llu frames measured, %llu skipped", gs.method, (unsigned long long)gs.measured,
+                (unsigned long long)gs.skipped);
     if (ctx.renderer)
         SDL_DestroyRenderer(ctx.renderer);
     if (ctx.window)
         SDL_DestroyWindow(ctx.window);
+    asset_pack_close(&ctx.pack); // Après les polices et les sons, qui y lisaient
     TTF_Quit();
     SDL_Quit();
 }
 
+/**
+ * @brief Mémorise l'état du tick précédent pour le prochain rendu.
+ *
+ * @param prev État avant le dernier tick (NULL : positions brutes).
+ * @param alpha Fraction du pas fixe écoulée depuis le dernier tick.
+ */
+static void sdl_set_interpolation(const GameModel *prev, float alpha)
+{
+    ctx.prev = prev;
+    ctx.alpha = (alpha < 0.0f) ? 0.0f : (alpha > 1.0f) ? 1.0f : alpha;
+}
+
+/**
+ * @brief Indique si la présentation attend la synchronisation verticale.
+ */
+static bool sdl_has_vsync(void)
+{
+    return ctx.vsync;
+}
+
+/**
+ * @brief File des sons demandés par le Modèle, jouée à chaque rendu.
+ */
+static SpscRing *sdl_audio_events(void)
+{
+    return &ctx.audio_events;
+}
+
 /**
  * @brief Effectue le rendu complet d'une frame.
  *
@@ -564,196 +4107,323 @@ static void sdl_close(void)
  */
 static void sdl_render(const GameModel *model)
 {
-    update_audio_state(model, (GameModel *)model);
+    // Seul le menu principal se passe des images du jeu : au-delà, on les attend
+    world_attach(model->sim.state != STATE_MENU);
+    frame_arena_reset(&ctx.frame); // Mémoire passagère de l'image précédente rendue d'un coup
+    ctx.audio_latency.render_start = utils_get_time();
+    update_audio_state(model);
+    hot_start();
+    hot_apply();
+    strings_update();
+    if (ctx.present.dirty)
+        present_update();
+    // Mode d'énergie (power.h) : plus d'effets coûteux, frames mesurées contre la cadence abaissée
+    bool saving = power_saving(model->ui.power_mode);
+    bool constrained = quality_constrain(&ctx.quality, saving ? QUALITY_NO_BACKGROUND : QUALITY_FULL,
+                                         power_render_hz(model->ui.power_mode, TARGET_FPS));
+    if (quality_update(&ctx.quality, ctx.vsync) || constrained)
+        quality_apply();
+    gputime_frame_begin();
+    thumbs_frame(model);
+    capture_readback();
+    if (ctx.present.lowres)
+        set_render_target(ctx.present.lowres);
+    // Rectangles sales : l'écran affiché reste en place, seules ses parties changées sont reprises
+    bool dirty = dirty_possible(model), partial = dirty && ctx.dirty.valid;
     SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
-    SDL_RenderClear(ctx.renderer);
+    if (!partial)
+        SDL_RenderClear(ctx.renderer);
+    // Démo d'accueil : images du jeu déjà en place et calque du menu disponible
+    const GameModel *demo = NULL;
+    if (ctx.world_loader.attached && ctx.layer.texture)
+        demo = attract_frame(&ctx.attract, model, ctx.audio_latency.render_start);
+    if (demo)
+        draw_attract(demo, model);
+    else
+        draw_static_layer(model, 255);
+    if (!demo && ctx.attract_drawn)
+    {
+        // Textures des boucliers datées par les générations de la démo : à renvoyer
+        for (int i = 0; i < MAX_SHIELDS; i++)
+            ctx.shields[i].valid = false;
+        ctx.attract_drawn = false;
+    }
+    particles_frame(model);
+    if (dirty && !dirty_frame(model) && partial)
+    {
+        partial = false; // Trop de changements : image complète
+        SDL_RenderClear(ctx.renderer);
+    }
 
-    if (model->state == STATE_PLAYING)
+    if (partial)
+        dirty_draw(model);
+    else if (model->sim.state == STATE_PLAYING)
     {
         draw_game_world(model);
         draw_hud(model);
     }
-    else if (model->state == STATE_MENU)
+    else
     {
-        SDL_RenderTexture(ctx.renderer, ctx.tex.bg_menu, NULL, NULL);
-        draw_text_centered("SPACE INVADERS", WIN_HEIGHT / 4, COL_GREEN, ctx.font_title);
-        const char *opts[] = {"JOUER", "TUTORIEL", "CHARGER", "VOLUME", "QUITTER"};
-        for (int i = 0; i < 5; i++)
+        if (model->sim.state == STATE_OVERWRITE_CONFIRM)
         {
-            SDL_Color c = (i == model->menu_selection) ? COL_YELLOW : COL_GRAY;
-            char buf[64];
-            if (i == 3)
-            {
-                if (model->is_muted)
-                    snprintf(buf, 64, "VOLUME: [MUTE]");
-                else
-                {
-                    char b[11] = {0};
-                    int n = model->volume / 10;
-                    for (int k = 0; k < 10; k++)
-                        b[k] = (k < n) ? '|' : '-';
-                    snprintf(buf, 64, "VOLUME: [%s] %d%%", b, model->volume);
-                }
-            }
-            else
-                snprintf(buf, 64, (i == model->menu_selection) ? "> %s <" : "%s", opts[i]);
-            draw_text_centered(buf, WIN_HEIGHT / 2 + i * 50, c, ctx.font);
+            SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 200);
+            SDL_FRect overlay = {0, 0, WIN_WIDTH, WIN_HEIGHT};
+            SDL_RenderFillRect(ctx.renderer, &overlay);
+            ctx.perf.draws++;
         }
-    }
-    else if (model->state == STATE_PAUSED)
-    {
-        draw_game_world(model);
-        draw_overlay(180);
-        draw_text_centered("PAUSE", WIN_HEIGHT / 4, COL_WHITE, ctx.font_title);
-        const char *opts[] = {"REPRENDRE", "VOLUME", "SAUVEGARDER ET QUITTER", "QUITTER SANS SAUVEGARDER"};
-        for (int i = 0; i < 4; i++)
+        else if (model->sim.state == STATE_SAVING || model->sim.state == STATE_SAVE_SUCCESS)
         {
-            SDL_Color c = (i == model->menu_selection) ? COL_YELLOW : COL_GRAY;
-            char buf[128];
-            if (i == 1)
-                snprintf(buf, 64, model->is_muted ? "SON: OFF" : "SON: < %d%% >", model->volume);
-            else
-                snprintf(buf, 64, (i == model->menu_selection) ? "> %s <" : "%s", opts[i]);
-            draw_text_centered(buf, WIN_HEIGHT / 2 - 50 + i * 60, c, ctx.font);
+            SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+            SDL_RenderClear(ctx.renderer);
         }
+        draw_menu(model);
+        if ((model->sim.state == STATE_SAVE_SELECT && model->ui.menu_selection > 0) || model->sim.state == STATE_LOAD_MENU)
+            draw_thumbnail();
     }
-    else if (model->state == STATE_GAME_OVER)
+    float fade = timeline_fade(&model->sim.transition);
+    if (fade > 0.0f)
     {
-        if (ctx.tex.bg_menu_1)
-            SDL_RenderTexture(ctx.renderer, ctx.tex.bg_menu_1, NULL, NULL);
-        draw_overlay(200);
-        draw_text_centered("GAME OVER", WIN_HEIGHT / 4, COL_RED, ctx.font_title);
-        char s[32];
-        snprintf(s, 32, "Score Final: %d", model->score);
-        draw_text_centered(s, WIN_HEIGHT / 2 - 50, COL_WHITE, ctx.font);
-        const char *opts[] = {"SAUVEGARDER", "REJOUER", "QUITTER"};
-        for (int i = 0; i < 3; i++)
-        {
-            SDL_Color c = (i == model->menu_selection) ? COL_WHITE : COL_GRAY;
-            char b[64];
-            snprintf(b, 64, (i == model->menu_selection) ? "> %s <" : "%s", opts[i]);
-            draw_text_centered(b, WIN_HEIGHT / 2 + 30 + i * 60, c, ctx.font);
-        }
+        // Fondu d'une transition, par-dessus toute l'image
+        SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, (Uint8)(fade * 255.0f));
+        SDL_FRect veil = {0, 0, WIN_WIDTH, WIN_HEIGHT};
+        SDL_RenderFillRect(ctx.renderer, &veil);
+        ctx.perf.draws++;
     }
-    else if (model->state == STATE_CONFIRM_QUIT)
+    if (ctx.perf.visible)
+        draw_perf_overlay(model);
+    capture_stage();
+    if (ctx.present.lowres)
     {
-        if (model->previous_state == STATE_PLAYING || model->previous_state == STATE_PAUSED)
-        {
-            draw_game_world(model);
-            draw_overlay(230);
-        }
-        else
-        {
-            if (ctx.tex.bg_menu_1)
-                SDL_RenderTexture(ctx.renderer, ctx.tex.bg_menu_1, NULL, NULL);
-            draw_overlay(200);
-        }
-        draw_text_centered("ATTENTION !", WIN_HEIGHT / 3, COL_RED, ctx.font_title);
-        if (model->previous_state == STATE_PLAYING || model->previous_state == STATE_PAUSED)
-            draw_text_centered("Progression non sauvegardee !", WIN_HEIGHT / 3 + 60, COL_WHITE, ctx.font);
-        else
-            draw_text_centered("Voulez-vous quitter le jeu ?", WIN_HEIGHT / 3 + 60, COL_WHITE, ctx.font);
-        draw_text_centered("Confirmer ?", WIN_HEIGHT / 3 + 90, COL_GRAY, ctx.font);
-        const char *opts[] = {"OUI, QUITTER", "NON, RETOUR", "SAUVEGARDER ET QUITTER"};
-        for (int i = 0; i < 3; i++)
-        {
-            SDL_Color c = (i == model->menu_selection) ? COL_YELLOW : COL_GRAY;
-            char b[64];
-            snprintf(b, 64, (i == model->menu_selection) ? "> %s <" : "%s", opts[i]);
-            draw_text_centered(b, WIN_HEIGHT / 2 + 50 + i * 60, c, ctx.font);
-        }
+        // Agrandissement (au plus proche voisin en basse résolution), en letterbox sur la sortie
+        set_render_target(NULL);
+        SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+        SDL_RenderClear(ctx.renderer);
+        render_texture(ctx.present.lowres, NULL, NULL);
     }
-    else if (model->state == STATE_SAVE_SELECT || model->state == STATE_LOAD_MENU || model->state == STATE_SAVE_INPUT || model->state == STATE_OVERWRITE_CONFIRM)
+
+    // Le pilote peut allouer en recevant les commandes (ex: propriétés de la
+    // fenêtre en OpenGL) : compté à part, ce n'est pas le chemin de rendu de la Vue
+    MemtrackStats mem;
+    memtrack_stats(&mem);
+    uint64_t before_present = mem.allocs;
+    gputime_frame_end();
+    if (partial)
+        dirty_present();
+    else
+        SDL_RenderPresent(ctx.renderer);
+    gputime_presented();
+    memtrack_stats(&mem);
+    ctx.perf.driver_allocs += (uint32_t)(mem.allocs - before_present);
+    AudioLatency *lat = &ctx.audio_latency;
+    if (lat->after_present)
+        play_sfx();
+    double present_ms = (utils_get_time() - lat->render_start) * 1000.0;
+    lat->present_ms = lat->present_ms > 0.0 ? lat->present_ms + 0.1 * (present_ms - lat->present_ms) : present_ms;
+    if (!ctx.startup.first_frame)
     {
-        if (ctx.tex.bg_menu_1)
-            SDL_RenderTexture(ctx.renderer, ctx.tex.bg_menu_1, NULL, NULL);
-        draw_overlay(200);
-        if (model->state == STATE_SAVE_SELECT)
-        {
-            draw_text_centered("CHOISIR L'EMPLACEMENT", 80, COL_YELLOW, ctx.font_title);
-            draw_text_centered((model->menu_selection == 0) ? "> CREER NOUVELLE <" : " CREER NOUVELLE ", 180, (model->menu_selection == 0) ? COL_GREEN : COL_GRAY, ctx.font);
-            for (int i = 0; i < model->save_file_count; i++)
-            {
-                char b[256];
-                snprintf(b, 256, (i + 1 == model->menu_selection) ? "> %s <" : "%s", model->save_files[i]);
-                draw_text_centered(b, 230 + i * 45, (i + 1 == model->menu_selection) ? COL_WHITE : COL_GRAY, ctx.font);
-            }
-        }
-        else if (model->state == STATE_LOAD_MENU)
-        {
-            draw_text_centered("CHARGER UNE PARTIE", 100, COL_GREEN, ctx.font_title);
-            if (model->save_file_count == 0)
-                draw_text_centered("AUCUNE SAUVEGARDE TROUVE", WIN_HEIGHT / 2, COL_RED, ctx.font);
-            for (int i = 0; i < model->save_file_count; i++)
-            {
-                char b[256];
-                snprintf(b, 256, (i == model->menu_selection) ? "> %s <" : "%s", model->save_files[i]);
-                draw_text_centered(b, 200 + i * 40, (i == model->menu_selection) ? COL_WHITE : COL_GRAY, ctx.font);
-            }
-        }
-        else if (model->state == STATE_SAVE_INPUT)
-        {
-            draw_text_centered("NOM DE LA SAUVEGARDE :", WIN_HEIGHT / 2 + 20, COL_YELLOW, ctx.font_title);
-            char b[128];
-            snprintf(b, 128, "%s_", model->input_buffer);
-            draw_text_centered(b, WIN_HEIGHT / 2 + 100, COL_WHITE, ctx.font);
-            draw_text_centered("(Entree: Valider)", WIN_HEIGHT / 2 + 150, COL_GRAY, ctx.font);
-        }
-        else
-        {
-            SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 200);
-            SDL_FRect overlay = {0, 0, WIN_WIDTH, WIN_HEIGHT};
-            SDL_RenderFillRect(ctx.renderer, &overlay);
+        ctx.startup.first_frame = true;
+        SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Startup: first frame after %.0f ms", (utils_get_time() - ctx.startup.begin) * 1000.0);
+    }
+    if (!startup_playable())
+        startup_frame(ctx.world_loader.attached && ctx.audio_loader.attached);
+
+    profiler_count(PROF_COUNT_DRAW_CALLS, ctx.perf.draws);
+    profiler_count(PROF_COUNT_UPLOADS, ctx.perf.uploads);
+    profiler_count(PROF_COUNT_ALLOCS, (uint32_t)(mem.allocs - ctx.perf.allocs_seen) - ctx.perf.driver_allocs);
+    profiler_count(PROF_COUNT_DRIVER_ALLOCS, ctx.perf.driver_allocs);
+    profiler_count(PROF_COUNT_SHIELD_ROWS, ctx.perf.shield_rows);
+    profiler_count(PROF_COUNT_MIXER_CALLS, ctx.perf.mixer_calls);
+    ctx.perf.draws = ctx.perf.uploads = ctx.perf.driver_allocs = ctx.perf.shield_rows = ctx.perf.mixer_calls = 0;
+    ctx.perf.allocs_seen = mem.allocs;
+}
+
+/**
+ * @brief Attend un événement au repos des menus, sauf s'il reste quelque chose à afficher.
+ *
+ * Chargements en fond (images du jeu, sons, miniatures), panneau de
+ * performances ou sortie redimensionnée : la Vue a besoin des images
+ * suivantes et rend la main tout de suite. Sinon, SDL_WaitEventTimeout
+ * endort le thread jusqu'à un événement, laissé dans la file pour
+ * sdl_get_input.
+ */
+static bool sdl_wait_input(double timeout)
+{
+    if (!ctx.world_loader.attached || !ctx.audio_loader.attached || thumbnail_loading() || ctx.perf.visible ||
+        ctx.present.dirty || attract_active(&ctx.attract))
+        return false;
+    SDL_WaitEventTimeout(NULL, (Sint32)(timeout * 1000.0));
+    return true;
+}
 
-            draw_text_centered("CE FICHIER EXISTE DEJA !", WIN_HEIGHT / 2 - 100, (SDL_Color){255, 165, 0, 255}, ctx.font);
+/**
+ * @brief Date un événement SDL sur l'horloge de utils_get_time.
+ *
+ * Les horodatages SDL comptent depuis SDL_Init : seul l'écart à "maintenant" est repris.
+ */
+static double event_time(const SDL_Event *e, double now)
+{
+    Uint64 ticks = SDL_GetTicksNS();
+    if (e->common.timestamp == 0 || e->common.timestamp > ticks)
+        return now;
+    return now - (double)(ticks - e->common.timestamp) / 1e9;
+}
 
-            char buf[128];
-            snprintf(buf, sizeof(buf), "Fichier : '%s.dat'", model->input_buffer);
-            draw_text_centered(buf, WIN_HEIGHT / 2 - 50, COL_WHITE, ctx.font);
+/**
+ * @brief Touches de jeu tenues au clavier (masque INPUT_*).
+ */
+static unsigned keyboard_held(void)
+{
+    const bool *s = SDL_GetKeyboardState(NULL);
+    unsigned held = 0;
+    if (s[SDL_SCANCODE_LEFT])
+        held |= INPUT_LEFT;
+    if (s[SDL_SCANCODE_RIGHT])
+        held |= INPUT_RIGHT;
+    if (s[SDL_SCANCODE_SPACE])
+        held |= INPUT_FIRE;
+    return held;
+}
 
-            SDL_Color col0 = (model->menu_selection == 0) ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){128, 128, 128, 255};
-            const char *txt0 = (model->menu_selection == 0) ? "> ECRASER L'ANCIEN <" : "  ECRASER L'ANCIEN  ";
-            draw_text_centered(txt0, WIN_HEIGHT / 2 + 30, col0, ctx.font);
+/**
+ * @brief Touches de jeu maintenues au clavier par le second joueur (S, F et Maj gauche, par position).
+ *
+ * Des scancodes, pas des caractères : les mêmes touches sous les doigts en
+ * QWERTY comme en AZERTY, à l'écart des raccourcis (P, Q, F3...).
+ */
+static unsigned keyboard_held_p2(void)
+{
+    const bool *s = SDL_GetKeyboardState(NULL);
+    unsigned held = 0;
+    if (s[SDL_SCANCODE_S])
+        held |= INPUT_LEFT;
+    if (s[SDL_SCANCODE_F])
+        held |= INPUT_RIGHT;
+    if (s[SDL_SCANCODE_LSHIFT])
+        held |= INPUT_FIRE;
+    return held;
+}
 
-            SDL_Color col1 = (model->menu_selection == 1) ? (SDL_Color){0, 255, 0, 255} : (SDL_Color){128, 128, 128, 255};
-            const char *txt1 = (model->menu_selection == 1) ? "> CREER UNE COPIE (1..) <" : "  CREER UNE COPIE (1..)  ";
-            draw_text_centered(txt1, WIN_HEIGHT / 2 + 80, col1, ctx.font);
-        }
+/**
+ * @brief Dépose les touches maintenues de chaque vaisseau.
+ *
+ * En coopération, la seconde manette et les touches du second joueur
+ * mènent le second vaisseau (command_held_p2) ; en solo, les deux manettes
+ * mènent le seul vaisseau.
+ */
+static void push_held(const GameModel *model, CommandQueue *queue, double t)
+{
+    unsigned p1 = keyboard_held() | pad_held(&ctx.pad[0]), p2 = pad_held(&ctx.pad[1]);
+    if (!model->sim.coop)
+    {
+        command_queue_push(queue, command_held(p1 | p2), t);
+        return;
     }
-    else if (model->state == STATE_TUTORIAL)
+    command_queue_push(queue, command_held(p1), t);
+    command_queue_push(queue, command_held_p2(p2 | keyboard_held_p2()), t);
+}
+
+/**
+ * @brief Joueur d'une manette ouverte (-1 : pas ouverte).
+ */
+static int gamepad_player(SDL_JoystickID id)
+{
+    for (int p = 0; p < PAD_PLAYERS; p++)
+        if (ctx.gamepad[p] && SDL_GetGamepadID(ctx.gamepad[p]) == id)
+            return p;
+    return -1;
+}
+
+/**
+ * @brief Traduit un événement de manette : branchement, bouton ou stick.
+ *
+ * Une manette par joueur (PAD_PLAYERS), dans l'ordre des branchements. En
+ * partie, chaque changement des touches tenues dépose les touches tenues
+ * (push_held) à l'horodatage de l'événement ; en menu, la croix, A, B, Start
+ * et Back de chaque manette naviguent comme les flèches, Entrée et Échap.
+ * En coopération, la seconde manette ne mène que le second vaisseau : ses
+ * appuis ne deviennent pas des commandes ponctuelles du premier.
+ */
+static void gamepad_event(const GameModel *model, CommandQueue *queue, const SDL_Event *e, double t)
+{
+    bool playing = model->sim.state == STATE_PLAYING;
+    bool changed = false;
+    int p;
+    switch (e->type)
     {
-        if (ctx.tex.bg_menu_1)
-            SDL_RenderTexture(ctx.renderer, ctx.tex.bg_menu_1, NULL, NULL);
-        draw_overlay(200);
-        draw_text_centered("COMMENT JOUER ?", 50, (SDL_Color){0, 255, 255, 255}, ctx.font_title);
-        draw_text_centered("Fleches : Se Deplacer", 130, COL_WHITE, ctx.font);
-        draw_text_centered("Espace : Tirer", 180, COL_WHITE, ctx.font);
-        struct
-        {
-            SDL_Texture *t;
-            const char *d;
-            SDL_Color c;
-        } tuts[] = {{ctx.tex.enemies[0][0], "= 10 PTS", {0, 255, 255, 255}}, {ctx.tex.enemies[1][0], "= 20 PTS", {255, 165, 0, 255}}, {ctx.tex.enemies[2][0], "= 30 PTS", {255, 50, 50, 255}}, {ctx.tex.ufo, "= 100 PTS + ???", {255, 0, 255, 255}}};
-        for (int i = 0; i < 4; i++)
+    case SDL_EVENT_GAMEPAD_ADDED:
+        if (gamepad_player(e->gdevice.which) >= 0)
+            return;
+        for (p = 0; p < PAD_PLAYERS && ctx.gamepad[p]; p++)
+            ;
+        if (p < PAD_PLAYERS && (ctx.gamepad[p] = SDL_OpenGamepad(e->gdevice.which)) != NULL)
+            SDL_Log("Input: gamepad %d \"%s\"", p + 1, SDL_GetGamepadName(ctx.gamepad[p]));
+        return;
+    case SDL_EVENT_GAMEPAD_REMOVED:
+        if ((p = gamepad_player(e->gdevice.which)) >= 0)
         {
-            SDL_SetTextureColorMod(tuts[i].t, tuts[i].c.r, tuts[i].c.g, tuts[i].c.b);
-            SDL_FRect r = {WIN_WIDTH / 2 - 80, 325 + i * 60, 40, (i == 3) ? 20 : 40};
-            SDL_RenderTexture(ctx.renderer, tuts[i].t, NULL, &r);
-            SDL_SetTextureColorMod(tuts[i].t, 255, 255, 255);
-            char b[32];
-            snprintf(b, 32, "%s", tuts[i].d);
-            draw_text(b, WIN_WIDTH / 2 - 20, 320 + i * 60, tuts[i].c);
+            SDL_CloseGamepad(ctx.gamepad[p]);
+            ctx.gamepad[p] = NULL;
+            pad_init(&ctx.pad[p], ctx.pad[p].deadzone); // Plus rien n'est tenu
+            changed = true;
         }
-        draw_text_centered("(Appuyez sur Entree pour retour)", WIN_HEIGHT - 50, COL_GRAY, ctx.font);
-    }
-    else if (model->state == STATE_SAVE_SUCCESS)
+        break;
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        if (model->sim.state == STATE_SAVE_INPUT || (p = gamepad_player(e->gaxis.which)) < 0)
+            return; // Le nom se tape au clavier
+        if (e->gaxis.axis == SDL_GAMEPAD_AXIS_LEFTX)
+            changed = pad_axis(&ctx.pad[p], e->gaxis.value);
+        break;
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
     {
-        SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
-        SDL_RenderClear(ctx.renderer);
-        draw_text_centered("SAUVEGARDE REUSSIE !", WIN_HEIGHT / 2 - 40, COL_GREEN, ctx.font_title);
-        draw_text_centered("Le jeu va se fermer...", WIN_HEIGHT / 2 + 40, COL_WHITE, ctx.font);
+        if (model->sim.state == STATE_SAVE_INPUT || (p = gamepad_player(e->gbutton.which)) < 0)
+            return;
+        bool down = e->type == SDL_EVENT_GAMEPAD_BUTTON_DOWN;
+        bool second = playing && p > 0 && model->sim.coop; // Second vaisseau : touches tenues seulement
+        switch (e->gbutton.button)
+        {
+        case SDL_GAMEPAD_BUTTON_DPAD_LEFT:
+            changed = pad_button(&ctx.pad[p], INPUT_LEFT, down);
+            if (down && !second)
+                command_queue_push(queue, playing ? CMD_MOVE_LEFT : CMD_LEFT, t);
+            break;
+        case SDL_GAMEPAD_BUTTON_DPAD_RIGHT:
+            changed = pad_button(&ctx.pad[p], INPUT_RIGHT, down);
+            if (down && !second)
+                command_queue_push(queue, playing ? CMD_MOVE_RIGHT : CMD_RIGHT, t);
+            break;
+        case SDL_GAMEPAD_BUTTON_SOUTH:
+            changed = pad_button(&ctx.pad[p], INPUT_FIRE, down);
+            if (down && !second)
+                command_queue_push(queue, playing ? CMD_SHOOT : CMD_RETURN, t);
+            break;
+        case SDL_GAMEPAD_BUTTON_DPAD_UP:
+            if (down)
+                command_queue_push(queue, CMD_UP, t);
+            break;
+        case SDL_GAMEPAD_BUTTON_DPAD_DOWN:
+            if (down)
+                command_queue_push(queue, CMD_DOWN, t);
+            break;
+        case SDL_GAMEPAD_BUTTON_START:
+            if (down)
+                command_queue_push(queue, playing ? CMD_PAUSE : CMD_RETURN, t);
+            break;
+        case SDL_GAMEPAD_BUTTON_EAST:
+        case SDL_GAMEPAD_BUTTON_BACK:
+            if (down && !playing)
+                command_queue_push(queue, CMD_PAUSE, t);
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+    default:
+        return;
     }
-    SDL_RenderPresent(ctx.renderer);
+    if (changed && playing)
+        push_held(model, queue, t);
 }
 
 /**
@@ -761,35 +4431,71 @@ static void sdl_render(const GameModel *model)
  *
  * Gère plusieurs modes :
  * - Mode saisie (STATE_SAVE_INPUT) : capture les caractères alphanumériques
- * - Mode jeu : détection continue des touches pour le mouvement fluide
+ * - Mode jeu : état des touches maintenues (CMD_HELD) pour le mouvement fluide et le tir
  * - Mode menu : événements ponctuels pour la navigation
+ * - Manette : boutons et stick suivis événement par événement (gamepad_event)
  *
- * Supporte également le plein écran (F11) et la fermeture de fenêtre.
+ * Tous les événements en attente sont lus d'une traite (une rafale d'appuis
+ * n'est plus étalée sur plusieurs frames). Supporte également le plein écran
+ * (F11), le panneau de performances (F3), la capture de la trace (F12) et la
+ * fermeture de fenêtre.
  *
  * @param model Le modèle de jeu (pour connaître l'état et le buffer de saisie).
- * @return La commande GameCommand correspondant à l'entrée utilisateur.
+ * @param queue File où déposer les commandes lues.
  */
-static GameCommand sdl_get_input(GameModel *model)
+static void sdl_get_input(GameModel *model, CommandQueue *queue)
 {
+    double now = utils_get_time();
     SDL_Event e;
     while (SDL_PollEvent(&e))
     {
+        double t = event_time(&e, now);
+        if (e.type == SDL_EVENT_KEY_DOWN || e.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ||
+            e.type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+            attract_wake(&ctx.attract, t); // Le joueur est là : fin de la démo, attente relancée
         if (e.type == SDL_EVENT_QUIT)
-            return CMD_EXIT;
-        if (model->state == STATE_SAVE_INPUT && e.type == SDL_EVENT_KEY_DOWN)
+            command_queue_push(queue, CMD_EXIT, t);
+        if (e.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED)
+            ctx.present.dirty = true; // Calques recréés au prochain rendu
+        if (e.type == SDL_EVENT_WINDOW_EXPOSED)
+            dirty_reset(false); // Surface de la fenêtre à renvoyer entière
+        if (e.type == SDL_EVENT_RENDER_TARGETS_RESET || e.type == SDL_EVENT_RENDER_DEVICE_RESET)
+        {
+            // Contenu des render targets (et des textures, au pire) perdu
+            ctx.layer.key = 0;
+            ctx.world.valid = false;
+            ctx.formation.valid = false;
+            ctx.hud.valid = false;
+            for (int i = 0; i < MAX_SHIELDS; i++)
+                ctx.shields[i].valid = false;
+        }
+        if (e.type >= SDL_EVENT_GAMEPAD_AXIS_MOTION && e.type <= SDL_EVENT_GAMEPAD_REMAPPED)
+        {
+            gamepad_event(model, queue, &e, t);
+            continue;
+        }
+        if (model->sim.state == STATE_SAVE_INPUT && e.type == SDL_EVENT_KEY_DOWN)
         {
             SDL_Keycode k = e.key.key;
+            // Valider ou annuler quitte la saisie : la suite des événements attend
+            // la prochaine lecture, qui les interprétera dans le nouvel état
             if (k == SDLK_RETURN || k == SDLK_KP_ENTER)
-                return CMD_RETURN;
+            {
+                command_queue_push(queue, CMD_RETURN, t);
+                return;
+            }
             if (k == SDLK_ESCAPE)
-                return CMD_PAUSE;
+            {
+                command_queue_push(queue, CMD_PAUSE, t);
+                return;
+            }
             if (k == SDLK_BACKSPACE)
             {
-                int l = strlen(model->input_buffer);
+                int l = strlen(model->ui.input_buffer);
                 if (l > 0)
-                    model->input_buffer[l - 1] = '\0';
+                    model->ui.input_buffer[l - 1] = '\0';
             }
-            else if (strlen(model->input_buffer) < MAX_FILENAME_LEN - 1)
+            else if (strlen(model->ui.input_buffer) < MAX_FILENAME_LEN - 1)
             {
                 char c = 0;
                 if (k >= SDLK_A && k <= SDLK_Z)
@@ -802,54 +4508,114 @@ static GameCommand sdl_get_input(GameModel *model)
                     c = '_';
                 if (c)
                 {
-                    int l = strlen(model->input_buffer);
-                    model->input_buffer[l] = c;
-                    model->input_buffer[l + 1] = '\0';
+                    int l = strlen(model->ui.input_buffer);
+                    model->ui.input_buffer[l] = c;
+                    model->ui.input_buffer[l + 1] = '\0';
                 }
             }
-            return CMD_NONE;
+            continue;
         }
         if (e.type == SDL_EVENT_KEY_DOWN)
         {
             switch (e.key.key)
             {
             case SDLK_ESCAPE:
-                return CMD_PAUSE;
             case SDLK_P:
-                return CMD_PAUSE;
+                command_queue_push(queue, CMD_PAUSE, t);
+                break;
             case SDLK_Q:
-                return CMD_EXIT;
+                command_queue_push(queue, CMD_EXIT, t);
                 break;
             case SDLK_UP:
-                return CMD_UP;
+                command_queue_push(queue, CMD_UP, t);
+                break;
             case SDLK_DOWN:
-                return CMD_DOWN;
+                command_queue_push(queue, CMD_DOWN, t);
+                break;
             case SDLK_RETURN:
             case SDLK_KP_ENTER:
-                return CMD_RETURN;
+                command_queue_push(queue, CMD_RETURN, t);
+                break;
             case SDLK_SPACE:
-                return CMD_SHOOT;
+                command_queue_push(queue, CMD_SHOOT, t);
+                break;
             case SDLK_LEFT:
-                return (model->state == STATE_PLAYING) ? CMD_MOVE_LEFT : CMD_LEFT;
+                command_queue_push(queue, (model->sim.state == STATE_PLAYING) ? CMD_MOVE_LEFT : CMD_LEFT, t);
+                break;
             case SDLK_RIGHT:
-                return (model->state == STATE_PLAYING) ? CMD_MOVE_RIGHT : CMD_RIGHT;
+                command_queue_push(queue, (model->sim.state == STATE_PLAYING) ? CMD_MOVE_RIGHT : CMD_RIGHT, t);
+                break;
             case SDLK_F11:
                 SDL_SetWindowFullscreen(ctx.window, !(SDL_GetWindowFlags(ctx.window) & SDL_WINDOW_FULLSCREEN));
                 break;
+            case SDLK_F3:
+                ctx.perf.visible = !ctx.perf.visible;
+                break;
+            case SDLK_F9:
+                flight_request_dump(); // Vidage de l'enregistreur de vol (flightrec.h)
+                break;
+            case SDLK_F12:
+                profiler_trace_flush(); // Capture de la trace en cours (SPACE_INVADERS_TRACE)
+                break;
             }
         }
     }
-    if (model->state == STATE_PLAYING)
+    // En partie, les touches maintenues donnent le mouvement continu et le tir,
+    // toutes ensemble (se déplacer en tirant)
+    if (model->sim.state == STATE_PLAYING)
+        push_held(model, queue, now);
+    // Vaisseau touché : les manettes vibrent, vies partagées (celles d'une partie chargée ne comptent pas)
+    for (int p = 0; p < PAD_PLAYERS; p++)
     {
-        const bool *s = SDL_GetKeyboardState(NULL);
-        if (s[SDL_SCANCODE_LEFT])
-            return CMD_MOVE_LEFT;
-        if (s[SDL_SCANCODE_RIGHT])
-            return CMD_MOVE_RIGHT;
-        if (s[SDL_SCANCODE_SPACE])
-            return CMD_SHOOT;
+        if (model->sim.state == STATE_MENU || model->sim.state == STATE_LOAD_MENU)
+            ctx.pad[p].lives = -1;
+        else if (pad_hit(&ctx.pad[p], model->sim.lives) && ctx.gamepad[p])
+            SDL_RumbleGamepad(ctx.gamepad[p], 0x6000, 0xC000, PAD_RUMBLE_MS);
     }
-    return CMD_NONE;
 }
 
-const ViewInterface view_sdl = {.init = sdl_init, .close = sdl_close, .render = sdl_render, .get_input = sdl_get_input};
\ No newline at end of file
+const ViewInterface view_sdl = {.init = sdl_init, .close = sdl_close, .render = sdl_render, .get_input = sdl_get_input, .set_interpolation = sdl_set_interpolation, .has_vsync = sdl_has_vsync, .audio_events = sdl_audio_events, .wait_input = sdl_wait_input};
+
+/**
+ * @brief Initialise la Vue sur le pilote SDL_Renderer "gpu".
+ */
+static bool sdlgpu_init(void)
+{
+    render_driver = RENDER_DRIVER_GPU;
+    return sdl_init();
+}
+
+const ViewInterface view_sdlgpu = {.init = sdlgpu_init, .close = sdl_close, .render = sdl_render, .get_input = sdl_get_input, .set_interpolation = sdl_set_interpolation, .has_vsync = sdl_has_vsync, .audio_events = sdl_audio_events, .wait_input = sdl_wait_input};
+
+/**
+ * @brief Ouvre la Vue hors écran, dessine l'état dans une cible, l'écrit en PNG et referme la Vue.
+ */
+bool sdl_snapshot(const GameModel *model, const char *path, int width)
+{
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen"); // Les variables d'environnement restent prioritaires
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    if (!sdl_init())
+    {
+        sdl_close();
+        return false;
+    }
+    world_attach(true);
+    sdl_set_interpolation(NULL, 1.0f);
+    strings_update(); // HUD en compteurs, comme en jeu
+
+    float scale = (float)(width > 0 ? width : WIN_WIDTH) / WIN_WIDTH;
+    SDL_Texture *target = scaled_target(NULL, WIN_WIDTH, WIN_HEIGHT, scale, SDL_BLENDMODE_NONE);
+    bool ok = target != NULL;
+    if (ok)
+    {
+        draw_offscreen(target, model, true);
+        SDL_Surface *s = read_target(target);
+        if (s)
+            SDL_LogInfo(SDL_LOG_CATEGORY_VIDEO, "Snapshot: %dx%d -> %s", s->w, s->h, path);
+        ok = thumbnail_save(s, path);
+        ok = thumbnail_flush() && ok;
+        SDL_DestroyTexture(target);
+    }
+    sdl_close();
+    return ok;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file wave.c
+ * @brief Implémentation de la compilation des vagues scriptées.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour pthread_once).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "wave.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+//                          1. TABLE PAR DÉFAUT
+// ============================================================================
+
+/**
+ * @brief Vague classique (celle du jeu d'origine), rejouée à chaque niveau.
+ */
+static const char *const DEFAULT_SCRIPT =
+    "wave\n"
+    "row 33333333333\n"
+    "row 22222222222\n"
+    "row 22222222222\n"
+    "row 11111111111\n"
+    "row 11111111111\n"
+    "end\n";
+
+static WaveTable table;       ///< Table de toutes les parties (lecture seule en jeu).
+static bool table_ready = false; ///< Table chargée (wave_load) ou compilée par défaut.
+static pthread_once_t default_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Compile la table par défaut si aucun script n'a été chargé.
+ */
+static void compile_default(void)
+{
+    if (!table_ready)
+        table_ready = wave_compile(&table, DEFAULT_SCRIPT, NULL, 0);
+}
+
+// ============================================================================
+//                          2. COMPILATION
+// ============================================================================
+
+/**
+ * @brief Valeurs d'une vague avant ses directives (grille vide).
+ */
+static void wave_defaults(WaveSpec *w)
+{
+    memset(w, 0, sizeof(*w));
+    w->origin_x = FORMATION_START_X;
+    w->origin_y = FORMATION_START_Y;
+    w->step_x = FORMATION_STEP_X;
+    w->step_y = FORMATION_STEP_Y;
+    w->speed = 1.0f;
+    w->fire_per_level = 2;
+}
+
+/**
+ * @brief Vérifie une vague terminée (`end`) : non vide, jouable, dans l'écran.
+ */
+static const char *wave_check(const WaveSpec *w, int rows)
+{
+    // formation_hit ne teste qu'une case : une balle ne doit chevaucher qu'une colonne et une rangée
+    if (w->step_x < BULLET_WIDTH + ENEMY_WIDTH || w->step_y < BULLET_HEIGHT + ENEMY_HEIGHT)
+        return "espacement trop serré";
+    if (w->size == 0 && w->boss == 0)
+        return "vague vide";
+    int max_col = 0;
+    for (int i = 0; i < FORMATION_SIZE; i++)
+        if (((w->mask >> i) & 1) && i % FORMATION_COLS > max_col)
+            max_col = i % FORMATION_COLS;
+    if (w->origin_x < 0 || w->origin_x + max_col * w->step_x + ENEMY_WIDTH > GAME_WIDTH ||
+        w->origin_y < 0 || w->origin_y + (rows - 1) * w->step_y + ENEMY_HEIGHT > GAME_HEIGHT)
+        return "formation hors de l'écran";
+    if (w->speed <= 0 || w->speedup < 0 || w->fire_base < 0 || w->fire_per_level < 0)
+        return "vitesse ou cadence de tir négative";
+    return NULL;
+}
+
+/**
+ * @brief Ajoute une rangée à la vague en cours.
+ */
+static const char *wave_row(WaveSpec *w, int row, const char *cells)
+{
+    if (row >= FORMATION_ROWS)
+        return "trop de rangées";
+    if (strlen(cells) > FORMATION_COLS)
+        return "rangée trop longue";
+    for (int col = 0; cells[col]; col++)
+    {
+        int i = row * FORMATION_COLS + col;
+        if (cells[col] == '.')
+            continue;
+        if (cells[col] < '1' || cells[col] > '3')
+            return "case invalide (attendu '1', '2', '3' ou '.')";
+        w->mask |= 1ULL << i;
+        w->types[i] = (uint8_t)(ENTITY_ENEMY_TYPE_1 + (cells[col] - '1'));
+        w->size++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Compile un script ligne par ligne.
+ */
+bool wave_compile(WaveTable *out, const char *text, char *err, size_t err_cap)
+{
+    memset(out, 0, sizeof(*out));
+    WaveSpec *w = NULL; // Vague en cours (entre `wave` et `end`)
+    int rows = 0, line_no = 0;
+    const char *msg = NULL;
+
+    for (const char *p = text; *p && !msg;)
+    {
+        char line[128];
+        size_t len = strcspn(p, "\n");
+        line_no++;
+        if (len >= sizeof(line))
+        {
+            msg = "ligne trop longue";
+            break;
+        }
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p += len + (p[len] == '\n');
+        char *hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        char word[16], arg[64];
+        float a, b;
+        int i, j;
+        int n = sscanf(line, "%15s", word);
+        if (n != 1)
+            continue; // Ligne vide ou commentaire
+
+        if (strcmp(word, "wave") == 0)
+        {
+            if (w)
+                msg = "`wave` avant le `end` de la vague précédente";
+            else if (out->count == WAVE_MAX)
+                msg = "trop de vagues";
+            else
+            {
+                w = &out->waves[out->count];
+                wave_defaults(w);
+                rows = 0;
+            }
+        }
+        else if (!w)
+            msg = "directive hors d'une vague";
+        else if (strcmp(word, "end") == 0)
+        {
+            msg = wave_check(w, rows);
+            if (!msg)
+            {
+                out->count++;
+                w = NULL;
+            }
+        }
+        else if (strcmp(word, "row") == 0)
+            msg = (sscanf(line, "%*s %63s", arg) == 1) ? wave_row(w, rows++, arg) : "rangée vide";
+        else if (strcmp(word, "origin") == 0 && sscanf(line, "%*s %f %f", &a, &b) == 2)
+        {
+            w->origin_x = a;
+            w->origin_y = b;
+        }
+        else if (strcmp(word, "spacing") == 0 && sscanf(line, "%*s %f %f", &a, &b) == 2)
+        {
+            w->step_x = a;
+            w->step_y = b;
+        }
+        else if (strcmp(word, "speed") == 0 && sscanf(line, "%*s %f %f", &a, &b) == 2)
+        {
+            w->speed = a;
+            w->speedup = b;
+        }
+        else if (strcmp(word, "fire") == 0 && sscanf(line, "%*s %d %d", &i, &j) == 2)
+        {
+            w->fire_base = i;
+            w->fire_per_level = j;
+        }
+        else if (strcmp(word, "intercept") == 0 && sscanf(line, "%*s %d", &i) == 1 && (i == 0 || i == 1))
+            w->intercept = i == 1;
+        else if (strcmp(word, "drops") == 0 && sscanf(line, "%*s %d", &i) == 1 && i >= 0 && i <= 100)
+            w->drop_chance = i;
+        else if (strcmp(word, "boss") == 0 && sscanf(line, "%*s %d", &i) == 1 && i >= 0 && i <= BOSS_MAX_PARTS)
+            w->boss = i;
+        else
+            msg = "directive inconnue ou incomplète";
+    }
+    if (!msg && w)
+        msg = "`end` manquant";
+    if (!msg && out->count == 0)
+        msg = "aucune vague";
+
+    if (msg)
+    {
+        if (err && err_cap)
+            snprintf(err, err_cap, "ligne %d : %s", line_no, msg);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+//                          3. TABLE PARTAGÉE
+// ============================================================================
+
+/**
+ * @brief Lit le fichier en entier, puis le compile dans une table provisoire.
+ */
+bool wave_load(const char *path, char *err, size_t err_cap)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        snprintf(err, err_cap, "impossible d'ouvrir %s", path);
+        return false;
+    }
+    static char text[16384];
+    size_t n = fread(text, 1, sizeof(text) - 1, f);
+    bool truncated = fgetc(f) != EOF;
+    fclose(f);
+    if (truncated)
+    {
+        snprintf(err, err_cap, "%s dépasse %zu octets", path, sizeof(text) - 1);
+        return false;
+    }
+    text[n] = '\0';
+
+    static WaveTable next;
+    if (!wave_compile(&next, text, err, err_cap))
+        return false;
+    table = next;
+    table_ready = true;
+    return true;
+}
+
+/**
+ * @brief Remplace la table, comme wave_load après une compilation réussie.
+ */
+void wave_set_table(const WaveTable *t)
+{
+    table = *t;
+    table_ready = true;
+}
+
+/**
+ * @brief Vague d'un niveau ; compile la table par défaut au premier appel.
+ */
+const WaveSpec *wave_for_level(int level)
+{
+    pthread_once(&default_once, compile_default);
+    int i = (level < 1) ? 0 : level - 1;
+    return &table.waves[i < table.count ? i : table.count - 1];
+}
+
+// ============================================================================
+//                          4. ÉCRITURE
+// ============================================================================
+
+/**
+ * @brief Une directive par constante, puis les rangées jusqu'à la dernière occupée.
+ *
+ * Les réels sont écrits en "%.9g" : relus par sscanf, ils redonnent les mêmes floats.
+ */
+size_t wave_format(const WaveTable *t, char *buf, size_t cap)
+{
+    size_t len = 0;
+    for (int k = 0; k < t->count; k++)
+    {
+        const WaveSpec *w = &t->waves[k];
+        int rows = 0;
+        for (int i = 0; i < FORMATION_SIZE; i++)
+            if ((w->mask >> i) & 1)
+                rows = i / FORMATION_COLS + 1;
+
+        char text[512];
+        int n = snprintf(text, sizeof(text),
+                         "wave\norigin %.9g %.9g\nspacing %.9g %.9g\nspeed %.9g %.9g\nfire %d %d\n"
+                         "intercept %d\ndrops %d\n",
+                         w->origin_x, w->origin_y, w->step_x, w->step_y, w->speed, w->speedup,
+                         w->fire_base, w->fire_per_level, w->intercept ? 1 : 0, w->drop_chance);
+        for (int row = 0; row < rows; row++)
+        {
+            char cells[FORMATION_COLS + 1];
+            int last = 0;
+            for (int col = 0; col < FORMATION_COLS; col++)
+            {
+                int i = row * FORMATION_COLS + col;
+                cells[col] = ((w->mask >> i) & 1) ? (char)('1' + w->types[i] - ENTITY_ENEMY_TYPE_1) : '.';
+                if (cells[col] != '.')
+                    last = col + 1;
+            }
+            cells[last ? last : 1] = '\0';
+            n += snprintf(text + n, sizeof(text) - (size_t)n, "row %s\n", cells);
+        }
+        if (w->boss > 0)
+            n += snprintf(text + n, sizeof(text) - (size_t)n, "boss %d\n", w->boss);
+        n += snprintf(text + n, sizeof(text) - (size_t)n, "end\n");
+        if (len + (size_t)n + 1 > cap)
+            return 0;
+        memcpy(buf + len, text, (size_t)n);
+        len += (size_t)n;
+    }
+    buf[len] = '\0';
+    return len;
+}
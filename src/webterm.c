@@ -0,0 +1,481 @@
+/**
+ * @file webterm.c
+ * @brief Implémentation du terminal web (HTTP, poignée de main WebSocket, diffusion).
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour select et pthread).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "webterm.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 ///< Hors Linux : pas d'option pour taire SIGPIPE à l'envoi.
+#endif
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+#define WEBTERM_POLL_S 0.2     ///< Attente au plus du thread entre deux vérifications de l'arrêt.
+#define WEBTERM_REQUEST 2048   ///< Requête HTTP lue au plus.
+#define WEBTERM_WS_HEADER 10   ///< En-tête de trame WebSocket au plus (longueur sur 64 bits).
+
+/** @brief Suffixe de la clé de la poignée de main (RFC 6455, section 1.3). */
+static const char WS_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+/**
+ * @brief Page du spectateur : une ligne de texte par rangée, redessinée quand une de ses cases change.
+ */
+static const char PAGE[] =
+    "<!doctype html><html><head><meta charset=\"utf-8\"><title>Space Invaders</title>\n"
+    "<style>body{background:#000;color:#ccc;margin:0;padding:12px}"
+    "#s{font:16px/1.15 monospace;white-space:pre}#e{font:12px sans-serif;color:#777}</style></head>\n"
+    "<body><div id=\"s\"></div><div id=\"e\">Connexion...</div><script>\n"
+    "const P=['#000','#d33','#3c3','#dd3','#48f','#d3d','#3cc','#eee'];\n"
+    "const L={113:'\\u2500',120:'\\u2502',108:'\\u250c',107:'\\u2510',109:'\\u2514',106:'\\u2518'};\n"
+    "const S=document.getElementById('s'),E=document.getElementById('e'),D=new TextDecoder();\n"
+    "let R=0,C=0,ch,co,fl,rows=[],dirty=[],queued=false;\n"
+    "function esc(t){return t.replace(/&/g,'&amp;').replace(/</g,'&lt;').replace(/>/g,'&gt;');}\n"
+    "function reset(r,c){R=r;C=c;ch=new Uint8Array(r*c).fill(32);co=new Uint8Array(r*c).fill(255);"
+    "fl=new Uint8Array(r*c);S.textContent='';rows=[];dirty=[];"
+    "for(let y=0;y<r;y++){const d=document.createElement('div');S.appendChild(d);rows.push(d);dirty.push(1);}}\n"
+    "function span(a,f,b){let t=(f&2)?b.map(x=>L[x]||'+').join(''):D.decode(new Uint8Array(b));"
+    "const fg=a&15,bg=a>>4;let st='';if(fg<8)st+='color:'+P[fg]+';';if(bg<8)st+='background:'+P[bg]+';';"
+    "if(f&1)st+='font-weight:bold;';return st?'<span style=\"'+st+'\">'+esc(t)+'</span>':esc(t);}\n"
+    "function draw(){queued=false;for(let y=0;y<R;y++){if(!dirty[y])continue;dirty[y]=0;let h='',x=y*C;"
+    "const e=x+C;while(x<e){const a=co[x],f=fl[x],b=[];while(x<e&&co[x]==a&&fl[x]==f){b.push(ch[x]<32?32:ch[x]);x++;}"
+    "h+=span(a,f,b);}rows[y].innerHTML=h;}}\n"
+    "function connect(){const ws=new WebSocket((location.protocol=='https:'?'wss://':'ws://')+location.host+'/ws');"
+    "ws.binaryType='arraybuffer';ws.onopen=()=>E.textContent='En direct';\n"
+    "ws.onmessage=m=>{const d=new DataView(m.data),r=d.getUint16(1,true),c=d.getUint16(3,true);"
+    "if(d.getUint8(0)==1||r!=R||c!=C)reset(r,c);let p=5;\n"
+    "while(p+3<=d.byteLength){let i=d.getUint16(p,true),n=d.getUint8(p+2);p+=3;"
+    "for(;n>0&&p+3<=d.byteLength;n--,i++,p+=3){ch[i]=d.getUint8(p);co[i]=d.getUint8(p+1);fl[i]=d.getUint8(p+2);"
+    "dirty[(i/C)|0]=1;}}\n"
+    "if(!queued){queued=true;requestAnimationFrame(draw);}};\n"
+    "ws.onclose=()=>{E.textContent='Deconnecte, nouvel essai...';setTimeout(connect,1000);};}\n"
+    "connect();\n"
+    "</script></body></html>\n";
+
+/**
+ * @brief SHA-1 d'un message court (poignée de main uniquement).
+ */
+static void sha1(const uint8_t *msg, size_t len, uint8_t out[20])
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    uint64_t bits = (uint64_t)len * 8;
+    size_t total = ((len + 8) / 64 + 1) * 64;
+    for (size_t block = 0; block < total; block += 64)
+    {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++)
+        {
+            uint32_t v = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                size_t at = block + (size_t)i * 4 + (size_t)k;
+                uint8_t b;
+                if (at < len)
+                    b = msg[at];
+                else if (at == len)
+                    b = 0x80;
+                else if (at >= total - 8)
+                    b = (uint8_t)(bits >> (8 * (total - 1 - at)));
+                else
+                    b = 0;
+                v = (v << 8) | b;
+            }
+            w[i] = v;
+        }
+        for (int i = 16; i < 80; i++)
+        {
+            uint32_t v = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+            w[i] = (v << 1) | (v >> 31);
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++)
+        {
+            uint32_t f, k;
+            if (i < 20)
+            {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            }
+            else if (i < 40)
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            }
+            else if (i < 60)
+            {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t t = ((a << 5) | (a >> 27)) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = (b << 30) | (b >> 2);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    for (int i = 0; i < 20; i++)
+        out[i] = (uint8_t)(h[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+/**
+ * @brief Encode en base64 (`out` : 4 * ceil(len / 3) + 1 octets).
+ */
+static void base64(const uint8_t *in, size_t len, char *out)
+{
+    static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3)
+    {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len)
+            v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len)
+            v |= in[i + 2];
+        out[o++] = digits[(v >> 18) & 63];
+        out[o++] = digits[(v >> 12) & 63];
+        out[o++] = (i + 1 < len) ? digits[(v >> 6) & 63] : '=';
+        out[o++] = (i + 2 < len) ? digits[v & 63] : '=';
+    }
+    out[o] = '\0';
+}
+
+/**
+ * @brief Valeur d'un en-tête HTTP (nom sans casse), copiée sans espaces autour.
+ * @return false si l'en-tête est absent.
+ */
+static bool header_value(const char *request, const char *name, char *value, size_t cap)
+{
+    size_t n = strlen(name);
+    for (const char *line = strstr(request, "\r\n"); line; line = strstr(line, "\r\n"))
+    {
+        line += 2;
+        size_t i = 0;
+        while (i < n && line[i] && tolower((unsigned char)line[i]) == tolower((unsigned char)name[i]))
+            i++;
+        if (i < n || line[n] != ':')
+            continue;
+        const char *v = line + n + 1;
+        while (*v == ' ')
+            v++;
+        size_t len = 0;
+        while (v[len] && v[len] != '\r' && len + 1 < cap)
+            len++;
+        while (len > 0 && v[len - 1] == ' ')
+            len--;
+        memcpy(value, v, len);
+        value[len] = '\0';
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Envoie tout un tampon sur une connexion encore bloquante (réponses HTTP).
+ */
+static void send_all(int fd, const char *buf, size_t len)
+{
+    for (size_t sent = 0; sent < len;)
+    {
+        ssize_t w = send(fd, buf + sent, len - sent, MSG_NOSIGNAL);
+        if (w <= 0)
+            return;
+        sent += (size_t)w;
+    }
+}
+
+/**
+ * @brief Retire un spectateur (verrou tenu).
+ */
+static void drop_viewer(WebTerm *web, int slot)
+{
+    close(web->fds[slot]);
+    web->fds[slot] = -1;
+    if (!web->live[slot])
+        __atomic_sub_fetch(&web->waiting, 1, __ATOMIC_RELEASE);
+    web->live[slot] = false;
+}
+
+/**
+ * @brief Répond à une connexion : page, poignée de main WebSocket, ou 404.
+ *
+ * @return true si la connexion est devenue un spectateur (à garder ouverte).
+ */
+static bool serve_client(WebTerm *web, int fd)
+{
+    // Une requête lente n'occupe le serveur qu'une seconde au plus
+    struct timeval tv = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    char request[WEBTERM_REQUEST];
+    size_t got = 0;
+    while (got < sizeof(request) - 1)
+    {
+        ssize_t n = recv(fd, request + got, sizeof(request) - 1 - got, 0);
+        if (n <= 0)
+            return false;
+        got += (size_t)n;
+        request[got] = '\0';
+        if (strstr(request, "\r\n\r\n"))
+            break;
+    }
+
+    char key[64];
+    if (strncmp(request, "GET /ws", 7) == 0 && header_value(request, "Sec-WebSocket-Key", key, sizeof(key)))
+    {
+        char joined[sizeof(key) + sizeof(WS_GUID)];
+        int len = snprintf(joined, sizeof(joined), "%s%s", key, WS_GUID);
+        uint8_t digest[20];
+        sha1((const uint8_t *)joined, (size_t)len, digest);
+        char accept[32];
+        base64(digest, sizeof(digest), accept);
+        char reply[192];
+        int n = snprintf(reply, sizeof(reply),
+                         "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                         "Sec-WebSocket-Accept: %s\r\n\r\n",
+                         accept);
+        send_all(fd, reply, (size_t)n);
+
+        pthread_mutex_lock(&web->lock);
+        int slot = -1;
+        for (int i = 0; i < WEBTERM_MAX_VIEWERS && slot < 0; i++)
+            if (web->fds[i] < 0)
+                slot = i;
+        if (slot >= 0)
+        {
+            // Les envois de la Vue ne bloquent jamais : tampon large, socket non bloquant
+            int sndbuf = WEBTERM_SNDBUF;
+            setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            web->fds[slot] = fd;
+            web->live[slot] = false;
+            web->viewers++;
+            __atomic_add_fetch(&web->waiting, 1, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&web->lock);
+        return slot >= 0;
+    }
+
+    bool page = strncmp(request, "GET / ", 6) == 0 || strncmp(request, "GET /index.html", 15) == 0;
+    char header[160];
+    size_t body = page ? sizeof(PAGE) - 1 : 0;
+    int head = snprintf(header, sizeof(header),
+                        "HTTP/1.0 %s\r\nContent-Type: text/html; charset=utf-8\r\nContent-Length: %zu\r\n"
+                        "Connection: close\r\n\r\n",
+                        page ? "200 OK" : "404 Not Found", body);
+    send_all(fd, header, (size_t)head);
+    send_all(fd, PAGE, body);
+    return false;
+}
+
+/**
+ * @brief Lit ce qu'envoie un spectateur : seule la fermeture (ou la déconnexion) compte.
+ */
+static void read_viewer(WebTerm *web, int slot)
+{
+    uint8_t buf[256];
+    ssize_t n = recv(web->fds[slot], buf, sizeof(buf), 0);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        return;
+    if (n <= 0 || (buf[0] & 0x0F) == 0x8)
+        drop_viewer(web, slot);
+}
+
+/**
+ * @brief Thread du serveur : nouvelles connexions, fermetures des spectateurs.
+ */
+static void *server_main(void *arg)
+{
+    WebTerm *web = arg;
+    while (!__atomic_load_n(&web->stop, __ATOMIC_ACQUIRE))
+    {
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(web->listen_fd, &set);
+        int top = web->listen_fd;
+        pthread_mutex_lock(&web->lock);
+        for (int i = 0; i < WEBTERM_MAX_VIEWERS; i++)
+            if (web->fds[i] >= 0)
+            {
+                FD_SET(web->fds[i], &set);
+                if (web->fds[i] > top)
+                    top = web->fds[i];
+            }
+        pthread_mutex_unlock(&web->lock);
+
+        struct timeval tv = {0, (long)(WEBTERM_POLL_S * 1e6)};
+        if (select(top + 1, &set, NULL, NULL, &tv) <= 0)
+            continue;
+        if (FD_ISSET(web->listen_fd, &set))
+        {
+            int client = accept(web->listen_fd, NULL, NULL);
+            if (client >= 0 && !serve_client(web, client))
+                close(client);
+        }
+        pthread_mutex_lock(&web->lock);
+        for (int i = 0; i < WEBTERM_MAX_VIEWERS; i++)
+            if (web->fds[i] >= 0 && FD_ISSET(web->fds[i], &set))
+                read_viewer(web, i);
+        pthread_mutex_unlock(&web->lock);
+    }
+    return NULL;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Socket d'écoute sur toutes les interfaces, puis thread du serveur.
+ */
+bool webterm_start(WebTerm *web, int port)
+{
+    memset(web, 0, sizeof(*web));
+    for (int i = 0; i < WEBTERM_MAX_VIEWERS; i++)
+        web->fds[i] = -1;
+    web->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (web->listen_fd < 0)
+        return false;
+    int yes = 1;
+    setsockopt(web->listen_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(web->listen_fd, (const struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(web->listen_fd, 8) != 0 ||
+        pthread_mutex_init(&web->lock, NULL) != 0)
+    {
+        close(web->listen_fd);
+        return false;
+    }
+    if (pthread_create(&web->thread, NULL, server_main, web) != 0)
+    {
+        pthread_mutex_destroy(&web->lock);
+        close(web->listen_fd);
+        return false;
+    }
+    web->active = true;
+    return true;
+}
+
+/**
+ * @brief Un spectateur attend une image complète.
+ */
+bool webterm_wants_key(const WebTerm *web)
+{
+    return web->active && __atomic_load_n(&web->waiting, __ATOMIC_ACQUIRE) > 0;
+}
+
+/**
+ * @brief Une trame WebSocket binaire, encodée une fois, envoyée d'un seul send() à chaque spectateur.
+ *
+ * Un envoi partiel laisserait la connexion au milieu d'une trame : le
+ * spectateur est alors retiré (trop lent), sa page se reconnecte.
+ */
+void webterm_send(WebTerm *web, const uint8_t *msg, size_t len, bool key)
+{
+    if (!web->active)
+        return;
+    size_t need = len + WEBTERM_WS_HEADER;
+    if (need > web->frame_cap)
+    {
+        uint8_t *frame = realloc(web->frame, need); // Seulement quand les messages grandissent
+        if (!frame)
+            return;
+        web->frame = frame;
+        web->frame_cap = need;
+    }
+    size_t head = 0;
+    web->frame[head++] = 0x82; // FIN, message binaire
+    if (len < 126)
+        web->frame[head++] = (uint8_t)len;
+    else if (len <= 0xFFFF)
+    {
+        web->frame[head++] = 126;
+        web->frame[head++] = (uint8_t)(len >> 8);
+        web->frame[head++] = (uint8_t)len;
+    }
+    else
+    {
+        web->frame[head++] = 127;
+        for (int i = 7; i >= 0; i--)
+            web->frame[head++] = (uint8_t)((uint64_t)len >> (8 * i));
+    }
+    memcpy(web->frame + head, msg, len);
+    size_t total = head + len;
+
+    pthread_mutex_lock(&web->lock);
+    for (int i = 0; i < WEBTERM_MAX_VIEWERS; i++)
+    {
+        if (web->fds[i] < 0 || web->live[i] == key)
+            continue;
+        ssize_t w = send(web->fds[i], web->frame, total, MSG_NOSIGNAL);
+        if (w != (ssize_t)total)
+        {
+            if (w >= 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+                web->slow++;
+            drop_viewer(web, i);
+            continue;
+        }
+        web->messages++;
+        web->bytes += total;
+        if (key)
+        {
+            web->live[i] = true;
+            __atomic_sub_fetch(&web->waiting, 1, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&web->lock);
+}
+
+/**
+ * @brief Arrêt du thread (au plus WEBTERM_POLL_S), connexions fermées, bilan.
+ */
+void webterm_stop(WebTerm *web)
+{
+    if (!web->active)
+        return;
+    __atomic_store_n(&web->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(web->thread, NULL);
+    for (int i = 0; i < WEBTERM_MAX_VIEWERS; i++)
+        if (web->fds[i] >= 0)
+            drop_viewer(web, i);
+    close(web->listen_fd);
+    pthread_mutex_destroy(&web->lock);
+    web->active = false;
+    if (web->viewers > 0)
+        printf("Web : %llu spectateur(s), %llu message(s), %.1f Kio envoyes, %llu deconnecte(s) (trop lents)\n",
+               (unsigned long long)web->viewers, (unsigned long long)web->messages, web->bytes / 1024.0,
+               (unsigned long long)web->slow);
+    free(web->frame);
+    web->frame = NULL;
+    web->frame_cap = 0;
+}
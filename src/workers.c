@@ -0,0 +1,222 @@
+/**
+ * @file workers.c
+ * @brief Implémentation des threads de calcul partagés.
+ */
+
+/** @def _POSIX_C_SOURCE
+ *  @brief Active les fonctionnalités POSIX 2001 (requis pour sysconf).
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "workers.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. ÉTAT PARTAGÉ
+// ============================================================================
+
+static pthread_once_t config_once = PTHREAD_ONCE_INIT;
+static int thread_count = 1;   ///< Threads de calcul, appelant compris.
+static pthread_mutex_t run_lock = PTHREAD_MUTEX_INITIALIZER; ///< Un seul appelant à la fois.
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER; ///< Protège la passe publiée et `running`.
+static pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t threads[WORKERS_MAX];
+static int started = 0;        ///< Threads lancés (thread_count - 1, ou 0 en cas d'échec).
+static bool start_failed = false;
+static unsigned generation = 0; ///< Incrémenté à chaque passe publiée.
+static int running = 0;         ///< Threads encore occupés par la passe courante.
+
+static WorkerTask job_fn;      ///< Passe courante (fixée sous `lock`).
+static void *job_ctx;
+static int job_tasks;
+static int next_task;          ///< Prochaine tâche à prendre (incrément atomique).
+
+// ============================================================================
+//                          2. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief Lit SPACE_INVADERS_WORKERS (défaut : cœurs en ligne), borné à [1, WORKERS_MAX].
+ */
+static void read_config(void)
+{
+    const char *env = getenv("SPACE_INVADERS_WORKERS");
+    long n = (env && env[0]) ? strtol(env, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1)
+        n = 1;
+    thread_count = n < WORKERS_MAX ? (int)n : WORKERS_MAX;
+}
+
+/**
+ * @brief Prend des tâches de la passe courante jusqu'à épuisement.
+ */
+static void take_tasks(void)
+{
+    int t;
+    while ((t = __atomic_fetch_add(&next_task, 1, __ATOMIC_RELAXED)) < job_tasks)
+        job_fn(job_ctx, t);
+}
+
+/**
+ * @brief Boucle d'un thread : attend une passe, y prend des tâches, signale sa fin.
+ */
+static void *worker_main(void *arg)
+{
+    (void)arg;
+    unsigned seen = 0; // Threads lancés avant la première passe (start_threads)
+    pthread_mutex_lock(&lock);
+    for (;;)
+    {
+        while (generation == seen)
+            pthread_cond_wait(&start_cond, &lock);
+        seen = generation;
+        pthread_mutex_unlock(&lock);
+        take_tasks();
+        pthread_mutex_lock(&lock);
+        if (--running == 0)
+            pthread_cond_signal(&done_cond);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Lance les threads au premier besoin (sous `run_lock`).
+ */
+static bool start_threads(void)
+{
+    if (started || start_failed)
+        return started > 0;
+    for (int i = 0; i < thread_count - 1; i++)
+    {
+        if (pthread_create(&threads[i], NULL, worker_main, NULL) != 0)
+            break;
+        pthread_detach(threads[i]);
+        started++;
+    }
+    start_failed = started == 0;
+    return started > 0;
+}
+
+/**
+ * @brief Passes [first, last) d'un graphe, vues comme une seule suite de tâches.
+ */
+typedef struct
+{
+    const WorkerJob *jobs; ///< Première passe de l'étape.
+    int count;             ///< Passes de l'étape.
+} GraphStage;
+
+/**
+ * @brief Tâche `task` de l'étape : celle de la passe qui la contient.
+ */
+static void stage_task(void *ctx, int task)
+{
+    const GraphStage *stage = ctx;
+    int j = 0;
+    while (task >= stage->jobs[j].tasks)
+        task -= stage->jobs[j++].tasks;
+    stage->jobs[j].fn(stage->jobs[j].ctx, task);
+}
+
+/**
+ * @brief Vrai si la passe touche un domaine écrit par l'étape, ou écrit un domaine qu'elle touche.
+ */
+static bool job_conflicts(const WorkerJob *job, unsigned reads, unsigned writes)
+{
+    return (job->writes & (reads | writes)) || (job->reads & writes);
+}
+
+// ============================================================================
+//                          3. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief Nombre de threads de calcul, appelant compris.
+ */
+int workers_threads(void)
+{
+    pthread_once(&config_once, read_config);
+    return thread_count;
+}
+
+/**
+ * @brief Publie la passe, y participe, puis attend que chaque thread ait rendu la main.
+ */
+bool workers_run(WorkerTask fn, void *ctx, int tasks)
+{
+    if (workers_threads() < 2 || pthread_mutex_trylock(&run_lock) != 0)
+        return false;
+    if (!start_threads())
+    {
+        pthread_mutex_unlock(&run_lock);
+        return false;
+    }
+
+    pthread_mutex_lock(&lock);
+    job_fn = fn;
+    job_ctx = ctx;
+    job_tasks = tasks;
+    next_task = 0;
+    running = started;
+    generation++;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&lock);
+
+    take_tasks();
+
+    pthread_mutex_lock(&lock);
+    while (running > 0)
+        pthread_cond_wait(&done_cond, &lock);
+    pthread_mutex_unlock(&lock);
+    pthread_mutex_unlock(&run_lock);
+    return true;
+}
+
+/**
+ * @brief Vide un graphe.
+ */
+void workers_graph_clear(WorkerGraph *graph)
+{
+    graph->count = 0;
+}
+
+/**
+ * @brief Ajoute une passe à la fin du graphe.
+ */
+bool workers_graph_add(WorkerGraph *graph, WorkerTask fn, void *ctx, int tasks, unsigned reads, unsigned writes)
+{
+    if (graph->count == WORKERS_GRAPH_JOBS)
+        return false;
+    graph->jobs[graph->count++] = (WorkerJob){fn, ctx, tasks, reads, writes};
+    return true;
+}
+
+/**
+ * @brief Regroupe les passes consécutives sans conflit, puis répartit chaque étape.
+ */
+void workers_graph_run(const WorkerGraph *graph, bool parallel)
+{
+    for (int first = 0; first < graph->count;)
+    {
+        unsigned reads = graph->jobs[first].reads, writes = graph->jobs[first].writes;
+        int tasks = graph->jobs[first].tasks;
+        int last = first + 1;
+        for (; last < graph->count && !job_conflicts(&graph->jobs[last], reads, writes); last++)
+        {
+            reads |= graph->jobs[last].reads;
+            writes |= graph->jobs[last].writes;
+            tasks += graph->jobs[last].tasks;
+        }
+
+        GraphStage stage = {graph->jobs + first, last - first};
+        if (!parallel || tasks < 2 || !workers_run(stage_task, &stage, tasks))
+            for (int t = 0; t < tasks; t++)
+                stage_task(&stage, t);
+        first = last;
+    }
+}
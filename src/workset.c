@@ -0,0 +1,221 @@
+/**
+ * @file workset.c
+ * @brief Implémentation de la mémoire de la boucle de jeu (mmap, préremplissage, mlock, MADV_HUGEPAGE).
+ */
+
+/** @def _GNU_SOURCE
+ *  @brief Active MAP_ANONYMOUS et MADV_HUGEPAGE (extensions GNU).
+ */
+#define _GNU_SOURCE
+
+#include "workset.h"
+#include "logger.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ============================================================================
+//                          1. FONCTIONS INTERNES (HELPERS)
+// ============================================================================
+
+/**
+ * @brief En-tête d'un bloc de la zone, juste avant ses données (une ligne de cache).
+ */
+typedef struct WorksetBlock
+{
+    size_t size;               ///< Taille des données (arrondie à WORKSET_ALIGN).
+    struct WorksetBlock *next; ///< Bloc rendu suivant (liste des blocs libres).
+    uint8_t pad[WORKSET_ALIGN - sizeof(size_t) - sizeof(void *)];
+} WorksetBlock;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t *base = NULL;         ///< Début de la zone (NULL : pas de zone).
+static WorksetBlock *free_list = NULL; ///< Blocs rendus, repris par taille exacte.
+static int live = 0;                 ///< Blocs de la zone encore utilisés.
+static WorksetStats stats;
+
+/**
+ * @brief Le pointeur appartient à la zone.
+ */
+static bool owns(const void *ptr)
+{
+    return base && (const uint8_t *)ptr >= base && (const uint8_t *)ptr < base + stats.capacity;
+}
+
+/**
+ * @brief Écrit un octet par page (valeur inchangée) : chaque page est projetée maintenant.
+ */
+static void prefault(uint8_t *p, size_t bytes)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    for (size_t off = 0; off < bytes; off += page)
+        ((volatile uint8_t *)p)[off] = p[off];
+}
+
+/**
+ * @brief Variable d'environnement à "1".
+ */
+static bool env_on(const char *name)
+{
+    const char *env = getenv(name);
+    return env && strcmp(env, "1") == 0;
+}
+
+// ============================================================================
+//                          2. API PUBLIQUE
+// ============================================================================
+
+/**
+ * @brief mmap anonyme, grandes pages avant le premier accès, préremplissage, puis mlock.
+ */
+bool workset_init(size_t bytes)
+{
+    const char *env = getenv("SPACE_INVADERS_WORKSET");
+    if (base || (env && strcmp(env, "0") == 0))
+        return false;
+    size_t cap = (bytes + WORKSET_HUGE_PAGE - 1) / WORKSET_HUGE_PAGE * WORKSET_HUGE_PAGE;
+    void *map = mmap(NULL, cap, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+        return false;
+
+    pthread_mutex_lock(&lock);
+    size_t adopted = stats.adopted; // Zones adoptées avant la réservation : toujours préremplies
+    memset(&stats, 0, sizeof(stats));
+    stats.adopted = adopted;
+    stats.capacity = cap;
+    base = map;
+    free_list = NULL;
+    live = 0;
+#ifdef MADV_HUGEPAGE
+    if (env_on("SPACE_INVADERS_HUGEPAGES"))
+        stats.huge = madvise(base, cap, MADV_HUGEPAGE) == 0; // Avant le premier accès : pages de 2 Mo dès le préremplissage
+#endif
+    prefault(base, cap);
+    if (env_on("SPACE_INVADERS_MLOCK"))
+    {
+        stats.locked = mlock(base, cap) == 0;
+        if (!stats.locked)
+            logger_write(LOG_WARN, "[MEMOIRE] mlock refuse (RLIMIT_MEMLOCK ?) : zone de %zu Ko non verrouillee\n",
+                         cap / 1024);
+    }
+    pthread_mutex_unlock(&lock);
+    return true;
+}
+
+/**
+ * @brief Bloc rendu de même taille, sinon découpe à la suite, sinon calloc.
+ */
+void *workset_alloc(size_t bytes)
+{
+    size_t size = (bytes + WORKSET_ALIGN - 1) / WORKSET_ALIGN * WORKSET_ALIGN;
+    pthread_mutex_lock(&lock);
+    if (base)
+    {
+        for (WorksetBlock **link = &free_list; *link; link = &(*link)->next)
+        {
+            WorksetBlock *b = *link;
+            if (b->size != size)
+                continue;
+            *link = b->next;
+            stats.blocks++;
+            stats.reused++;
+            live++;
+            pthread_mutex_unlock(&lock);
+            memset(b + 1, 0, size);
+            return b + 1;
+        }
+        if (stats.used + sizeof(WorksetBlock) + size <= stats.capacity)
+        {
+            WorksetBlock *b = (WorksetBlock *)(base + stats.used);
+            stats.used += sizeof(WorksetBlock) + size;
+            b->size = size;
+            b->next = NULL;
+            stats.blocks++;
+            live++;
+            pthread_mutex_unlock(&lock);
+            return b + 1; // Jamais servi : encore à zéro depuis mmap
+        }
+        stats.overflow++;
+    }
+    pthread_mutex_unlock(&lock);
+    return calloc(1, bytes);
+}
+
+/**
+ * @brief Bloc de la zone en tête de la liste des blocs libres ; autre bloc à free.
+ */
+void workset_free(void *ptr)
+{
+    if (!ptr)
+        return;
+    pthread_mutex_lock(&lock);
+    if (owns(ptr))
+    {
+        WorksetBlock *b = (WorksetBlock *)ptr - 1;
+        b->next = free_list;
+        free_list = b;
+        live--;
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    pthread_mutex_unlock(&lock);
+    free(ptr);
+}
+
+/**
+ * @brief Préremplissage, et mlock si la zone est verrouillée.
+ */
+void workset_adopt(void *ptr, size_t bytes)
+{
+    prefault(ptr, bytes);
+    pthread_mutex_lock(&lock);
+    stats.adopted += bytes;
+    if (stats.locked)
+        mlock(ptr, bytes);
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @brief Copie du bilan, sous verrou.
+ */
+void workset_stats(WorksetStats *out)
+{
+    pthread_mutex_lock(&lock);
+    *out = stats;
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @brief Une ligne de bilan, comme utils_pacer_report.
+ */
+void workset_report(void)
+{
+    WorksetStats s;
+    workset_stats(&s);
+    if (s.capacity == 0)
+        return;
+    printf("Memoire de jeu : %zu Ko sur %zu Ko, %llu bloc(s) dont %llu repris, %llu hors zone%s%s\n", s.used / 1024,
+           s.capacity / 1024, (unsigned long long)s.blocks, (unsigned long long)s.reused,
+           (unsigned long long)s.overflow, s.locked ? ", verrouillee" : "", s.huge ? ", grandes pages" : "");
+}
+
+/**
+ * @brief munmap, sauf si un bloc est encore utilisé (la zone reste alors en place).
+ */
+void workset_close(void)
+{
+    pthread_mutex_lock(&lock);
+    if (base && live == 0)
+    {
+        munmap(base, stats.capacity); // Rend aussi le verrouillage
+        base = NULL;
+        free_list = NULL;
+        stats.capacity = stats.used = 0;
+        stats.locked = stats.huge = false;
+    }
+    pthread_mutex_unlock(&lock);
+}